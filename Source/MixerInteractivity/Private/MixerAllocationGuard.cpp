@@ -0,0 +1,79 @@
+//*********************************************************
+//
+// Copyright (c) Microsoft. All rights reserved.
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT.
+//
+//*********************************************************
+#include "MixerAllocationGuard.h"
+
+#if MIXER_ALLOCATION_COUNTING_ENABLED
+
+namespace
+{
+	/** Never instantiated; only here to read the counters FMalloc keeps for its subclasses. */
+	struct FMallocCallCounters : public FMalloc
+	{
+		static uint32 Get()
+		{
+			return FMalloc::TotalMallocCalls + FMalloc::TotalReallocCalls;
+		}
+	};
+}
+
+uint32 FMixerAllocationCounter::GetProcessTotal()
+{
+	return FMallocCallCounters::Get();
+}
+
+bool FMixerAllocationScopes::bEnabled = false;
+EMixerAllocationScope FMixerAllocationScopes::CurrentScope = EMixerAllocationScope::None;
+uint32 FMixerAllocationScopes::ScopeStart = 0;
+uint64 FMixerAllocationScopes::ScopeAllocations[static_cast<int32>(EMixerAllocationScope::Count)] = {};
+
+void FMixerAllocationScopes::SetEnabled(bool bInEnabled)
+{
+	check(IsInGameThread());
+	bEnabled = bInEnabled;
+	CurrentScope = EMixerAllocationScope::None;
+	ScopeStart = FMixerAllocationCounter::GetProcessTotal();
+	FMemory::Memzero(ScopeAllocations);
+}
+
+EMixerAllocationScope FMixerAllocationScopes::Enter(EMixerAllocationScope Scope)
+{
+	const EMixerAllocationScope Previous = CurrentScope;
+	SwitchTo(Scope);
+	return Previous;
+}
+
+void FMixerAllocationScopes::Exit(EMixerAllocationScope Previous)
+{
+	SwitchTo(Previous);
+}
+
+uint64 FMixerAllocationScopes::Consume(EMixerAllocationScope Scope)
+{
+	// Bring the scope we're in up to date, so that a frame's count doesn't spill into the next
+	SwitchTo(CurrentScope);
+
+	uint64& Allocations = ScopeAllocations[static_cast<int32>(Scope)];
+	const uint64 Consumed = Allocations;
+	Allocations = 0;
+	return Consumed;
+}
+
+void FMixerAllocationScopes::SwitchTo(EMixerAllocationScope Scope)
+{
+	const uint32 Now = FMixerAllocationCounter::GetProcessTotal();
+	if (CurrentScope != EMixerAllocationScope::None)
+	{
+		ScopeAllocations[static_cast<int32>(CurrentScope)] += Now - ScopeStart;
+	}
+	ScopeStart = Now;
+	CurrentScope = Scope;
+}
+
+#endif
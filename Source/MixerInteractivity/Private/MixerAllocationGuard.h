@@ -0,0 +1,127 @@
+//*********************************************************
+//
+// Copyright (c) Microsoft. All rights reserved.
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT.
+//
+//*********************************************************
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/MemoryBase.h"
+
+#ifndef MIXER_ALLOCATION_COUNTING_ENABLED
+#define MIXER_ALLOCATION_COUNTING_ENABLED !UE_BUILD_SHIPPING
+#endif
+
+// Per-frame allocation stats and the steady state budget.  Development builds only, as they put a little work on every scope change.
+#ifndef MIXER_ALLOCATION_GUARD_ENABLED
+#define MIXER_ALLOCATION_GUARD_ENABLED (MIXER_ALLOCATION_COUNTING_ENABLED && (UE_BUILD_DEBUG || UE_BUILD_DEVELOPMENT))
+#endif
+
+/** Part of the plugin's game thread work that allocations are counted against.  See UMixerInteractivitySettings::bGuardTickAllocations. */
+enum class EMixerAllocationScope : uint8
+{
+	None,
+	Tick,
+	Dispatch,
+	Broadcast,
+
+	Count
+};
+
+#if MIXER_ALLOCATION_COUNTING_ENABLED
+
+/**
+* Counts allocations made by every thread while it's alive, from the call counters FMalloc keeps for the
+* engine's memory stats, so nothing has to be put in front of GMalloc.  Those are only kept in STATS builds,
+* and only by allocators that maintain them (see FMalloc::IncrementTotalMallocCalls); others read as zero.
+*/
+class FMixerAllocationCounter
+{
+public:
+	FMixerAllocationCounter()
+		: Start(GetProcessTotal())
+	{
+	}
+
+	/** Allocations since construction or the last Restart. */
+	uint32 Get() const		{ return GetProcessTotal() - Start; }
+	void Restart()			{ Start = GetProcessTotal(); }
+
+	/** Mallocs and reallocs the process has made, wrapping at 2^32. */
+	static uint32 GetProcessTotal();
+
+private:
+	uint32 Start;
+};
+
+/**
+* Splits the game thread's frame into EMixerAllocationScope parts and counts allocations against each with
+* FMixerAllocationCounter, charging the scope that was current whenever it changes.  The counters are the
+* whole process's, so what other threads allocate meanwhile is counted too; treat scopes as upper bounds.
+* Game thread only.
+*/
+class FMixerAllocationScopes
+{
+public:
+	static bool IsEnabled()			{ return bEnabled; }
+	static void SetEnabled(bool bInEnabled);
+
+	/** Count allocations towards Scope until Exit is passed the scope returned. */
+	static EMixerAllocationScope Enter(EMixerAllocationScope Scope);
+	static void Exit(EMixerAllocationScope Previous);
+
+	/** Allocations counted against Scope since this was last called for it. */
+	static uint64 Consume(EMixerAllocationScope Scope);
+
+private:
+	/** Charge what has been allocated since the last change to the current scope, and make Scope current. */
+	static void SwitchTo(EMixerAllocationScope Scope);
+
+	static bool bEnabled;
+	static EMixerAllocationScope CurrentScope;
+	static uint32 ScopeStart;
+	static uint64 ScopeAllocations[static_cast<int32>(EMixerAllocationScope::Count)];
+};
+
+#endif
+
+#if MIXER_ALLOCATION_GUARD_ENABLED
+
+/** Counts the game thread's allocations against Scope for the lifetime of the guard, while FMixerAllocationScopes is enabled. */
+class FMixerAllocationScopeGuard
+{
+public:
+	explicit FMixerAllocationScopeGuard(EMixerAllocationScope Scope)
+		: bEntered(FMixerAllocationScopes::IsEnabled() && IsInGameThread())
+		, PreviousScope(EMixerAllocationScope::None)
+	{
+		if (bEntered)
+		{
+			PreviousScope = FMixerAllocationScopes::Enter(Scope);
+		}
+	}
+
+	~FMixerAllocationScopeGuard()
+	{
+		if (bEntered)
+		{
+			FMixerAllocationScopes::Exit(PreviousScope);
+		}
+	}
+
+private:
+	bool bEntered;
+	EMixerAllocationScope PreviousScope;
+};
+
+#define MIXER_ALLOCATION_SCOPE(Scope) FMixerAllocationScopeGuard PREPROCESSOR_JOIN(MixerAllocationScope, __LINE__)(EMixerAllocationScope::Scope)
+
+#else
+
+#define MIXER_ALLOCATION_SCOPE(Scope)
+
+#endif
@@ -0,0 +1,250 @@
+//*********************************************************
+//
+// Copyright (c) Microsoft. All rights reserved.
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT.
+//
+//*********************************************************
+#include "MixerAvatarCache.h"
+#include "MixerInteractivitySettings.h"
+#include "MixerInteractivityModulePrivate.h"
+#include "MixerRestClient.h"
+
+// Users without a fetchable avatar are asked about again after this long rather than on every request
+static const double FailedAvatarRetrySeconds = 300.0;
+
+namespace
+{
+	// Drops queue entries that no longer stand for a fetch waiting at this priority
+	template <typename IsWaitingPredicate>
+	bool PopQueued(TArray<int32>& Queue, IsWaitingPredicate IsWaiting, int32& OutUserId)
+	{
+		while (Queue.Num() > 0)
+		{
+			const int32 UserId = Queue[0];
+			Queue.RemoveAt(0, 1, false);
+			if (IsWaiting(UserId))
+			{
+				OutUserId = UserId;
+				return true;
+			}
+		}
+		return false;
+	}
+}
+
+FMixerAvatarCache& FMixerAvatarCache::Get()
+{
+	static FMixerAvatarCache Instance;
+	return Instance;
+}
+
+FMixerAvatarCache::FMixerAvatarCache()
+	: UseCounter(0)
+	, FetchTokens(static_cast<float>(FMath::Max(GetDefault<UMixerInteractivitySettings>()->MaxConcurrentAvatarFetches, 1)))
+	, NumInFlight(0)
+{
+}
+
+bool FMixerAvatarCache::FindAvatar(int32 UserId, FMixerImageRegion& OutRegion)
+{
+	if (!LoadedAvatars.Contains(UserId))
+	{
+		return false;
+	}
+
+	// The image cache may have evicted it to stay within its memory budget
+	if (!FMixerImageCache::Get().FindImage(GetAvatarUrl(UserId), FIntRect(), OutRegion))
+	{
+		LoadedAvatars.Remove(UserId);
+		return false;
+	}
+
+	TouchAvatar(UserId);
+	return true;
+}
+
+void FMixerAvatarCache::RequestAvatar(int32 UserId, EMixerAvatarPriority Priority, const FOnMixerImageLoaded& OnLoaded)
+{
+	check(IsInGameThread());
+
+	FMixerImageRegion Region;
+	if (FindAvatar(UserId, Region))
+	{
+		OnLoaded.ExecuteIfBound(Region);
+		return;
+	}
+
+	const double* RetryTime = FailedAvatars.Find(UserId);
+	if (RetryTime != nullptr)
+	{
+		if (FPlatformTime::Seconds() < *RetryTime)
+		{
+			OnLoaded.ExecuteIfBound(Region);
+			return;
+		}
+		FailedAvatars.Remove(UserId);
+	}
+
+	FAvatarRequest* Request = Requests.Find(UserId);
+	if (Request != nullptr)
+	{
+		// Pollers such as GetUserAvatar ask every frame without a callback; they mustn't pile up here
+		if (OnLoaded.IsBound())
+		{
+			Request->Waiters.Add(OnLoaded);
+		}
+		if (Priority > Request->Priority)
+		{
+			SetAvatarPriority(UserId, Priority);
+		}
+		return;
+	}
+
+	FAvatarRequest& NewRequest = Requests.Add(UserId);
+	if (OnLoaded.IsBound())
+	{
+		NewRequest.Waiters.Add(OnLoaded);
+	}
+	NewRequest.Priority = Priority;
+	NewRequest.bInFlight = false;
+	(Priority == EMixerAvatarPriority::Visible ? VisibleQueue : BackgroundQueue).Add(UserId);
+
+	// Queued fetches are released from the module tick
+	static_cast<FMixerInteractivityModule&>(IMixerInteractivityModule::Get()).WakeTicker();
+}
+
+void FMixerAvatarCache::SetAvatarPriority(int32 UserId, EMixerAvatarPriority Priority)
+{
+	FAvatarRequest* Request = Requests.Find(UserId);
+	if (Request != nullptr && !Request->bInFlight && Request->Priority != Priority)
+	{
+		// The entry in the old queue is skipped once its priority no longer matches
+		Request->Priority = Priority;
+		(Priority == EMixerAvatarPriority::Visible ? VisibleQueue : BackgroundQueue).Add(UserId);
+	}
+}
+
+void FMixerAvatarCache::CancelAvatarRequest(int32 UserId)
+{
+	const FAvatarRequest* Request = Requests.Find(UserId);
+	if (Request != nullptr && !Request->bInFlight)
+	{
+		Requests.Remove(UserId);
+	}
+}
+
+void FMixerAvatarCache::Tick(float DeltaTime)
+{
+	if (Requests.Num() == NumInFlight)
+	{
+		VisibleQueue.Reset();
+		BackgroundQueue.Reset();
+	}
+
+	const UMixerInteractivitySettings* Settings = GetDefault<UMixerInteractivitySettings>();
+	const int32 MaxInFlight = FMath::Max(Settings->MaxConcurrentAvatarFetches, 1);
+	FetchTokens = FMath::Min(FetchTokens + DeltaTime * FMath::Max(Settings->AvatarFetchesPerSecond, 0.1f), static_cast<float>(MaxInFlight));
+
+	auto IsWaitingAt = [this](EMixerAvatarPriority Priority)
+	{
+		return [this, Priority](int32 UserId)
+		{
+			const FAvatarRequest* Request = Requests.Find(UserId);
+			return Request != nullptr && !Request->bInFlight && Request->Priority == Priority;
+		};
+	};
+
+	while (NumInFlight < MaxInFlight && FetchTokens >= 1.0f)
+	{
+		int32 UserId = 0;
+		if (!PopQueued(VisibleQueue, IsWaitingAt(EMixerAvatarPriority::Visible), UserId) &&
+			!PopQueued(BackgroundQueue, IsWaitingAt(EMixerAvatarPriority::Background), UserId))
+		{
+			break;
+		}
+
+		FetchTokens -= 1.0f;
+		StartFetch(UserId);
+	}
+}
+
+void FMixerAvatarCache::Reset()
+{
+	Requests.Empty();
+	VisibleQueue.Empty();
+	BackgroundQueue.Empty();
+	LoadedAvatars.Empty();
+	FailedAvatars.Empty();
+	NumInFlight = 0;
+}
+
+void FMixerAvatarCache::StartFetch(int32 UserId)
+{
+	FAvatarRequest& Request = Requests.FindChecked(UserId);
+	Request.bInFlight = true;
+	++NumInFlight;
+
+	// May complete immediately if someone else already fetched the same image
+	FMixerImageCache::Get().LoadImage(GetAvatarUrl(UserId), FIntRect(), FOnMixerImageLoaded::CreateRaw(this, &FMixerAvatarCache::OnAvatarLoaded, UserId));
+}
+
+void FMixerAvatarCache::OnAvatarLoaded(const FMixerImageRegion& Region, int32 UserId)
+{
+	FAvatarRequest Request;
+	if (!Requests.RemoveAndCopyValue(UserId, Request))
+	{
+		return;
+	}
+	check(Request.bInFlight);
+	--NumInFlight;
+
+	if (Region.Texture != nullptr)
+	{
+		TouchAvatar(UserId);
+		TrimToCapacity();
+	}
+	else
+	{
+		FailedAvatars.Add(UserId, FPlatformTime::Seconds() + FailedAvatarRetrySeconds);
+	}
+
+	for (const FOnMixerImageLoaded& Waiter : Request.Waiters)
+	{
+		Waiter.ExecuteIfBound(Region);
+	}
+}
+
+void FMixerAvatarCache::TouchAvatar(int32 UserId)
+{
+	LoadedAvatars.Add(UserId, ++UseCounter);
+}
+
+void FMixerAvatarCache::TrimToCapacity()
+{
+	const int32 Capacity = GetDefault<UMixerInteractivitySettings>()->AvatarCacheCapacity;
+	while (Capacity > 0 && LoadedAvatars.Num() > Capacity)
+	{
+		int32 OldestUserId = 0;
+		uint64 OldestUse = MAX_uint64;
+		for (const TPair<int32, uint64>& Avatar : LoadedAvatars)
+		{
+			if (Avatar.Value < OldestUse)
+			{
+				OldestUserId = Avatar.Key;
+				OldestUse = Avatar.Value;
+			}
+		}
+		FMixerImageCache::Get().RemoveImage(GetAvatarUrl(OldestUserId));
+		LoadedAvatars.Remove(OldestUserId);
+	}
+}
+
+FString FMixerAvatarCache::GetAvatarUrl(int32 UserId)
+{
+	// The service redirects to the image, scaled to the requested size
+	const int32 Size = FMath::Max(GetDefault<UMixerInteractivitySettings>()->AvatarSize, 1);
+	return FMixerRestClient::GetApiUrl(FString::Printf(TEXT("users/%d/avatar?w=%d&h=%d"), UserId, Size, Size));
+}
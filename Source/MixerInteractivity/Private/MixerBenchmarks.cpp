@@ -0,0 +1,1309 @@
+//*********************************************************
+//
+// Copyright (c) Microsoft. All rights reserved.
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT.
+//
+//*********************************************************
+
+#include "MixerBenchmarks.h"
+
+#if MIXER_BENCHMARKS_ENABLED
+
+#include "MixerInteractivityModulePrivate.h"
+#include "MixerInteractivityLLM.h"
+#include "MixerAllocationGuard.h"
+#include "MixerTrafficRecorder.h"
+#include "MixerInteractivityLog.h"
+#include "MixerInteractivitySettings.h"
+#include "MixerInteractivityTypes.h"
+#include "MixerCustomControl.h"
+#include "MixerChatConnection.h"
+#include "OnlineChatMixerPrivate.h"
+#include "Dom/JsonObject.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+#include "Misc/Guid.h"
+#include "Engine/World.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Misc/AutomationTest.h"
+#include "UObject/UObjectIterator.h"
+
+static TAutoConsoleVariable<int32> CVarMixerBenchmarkIterations(
+	TEXT("Mixer.Benchmark.Iterations"),
+	10000,
+	TEXT("How much work each MixerInteractivity.Benchmark automation test does; benchmarks that cost more per op scale it down."));
+
+namespace
+{
+	/** Cycles and allocations accumulated over the timed parts of a benchmark. */
+	struct FBenchmarkSample
+	{
+		FBenchmarkSample()
+			: Cycles(0)
+			, Allocations(0)
+			, StartCycles(0)
+		{
+		}
+
+		void Start()
+		{
+			Counter.Restart();
+			StartCycles = FPlatformTime::Cycles64();
+		}
+
+		void Stop()
+		{
+			Cycles += FPlatformTime::Cycles64() - StartCycles;
+			Allocations += Counter.Get();
+		}
+
+		uint64 Cycles;
+		uint64 Allocations;
+
+	private:
+		FMixerAllocationCounter Counter;
+		uint64 StartCycles;
+	};
+
+	FString MakeSessionGuidString(FRandomStream& Random)
+	{
+		const uint32 A = Random.GetUnsignedInt();
+		const uint32 B = Random.GetUnsignedInt();
+		const uint32 C = Random.GetUnsignedInt();
+		const uint32 D = Random.GetUnsignedInt();
+		return FGuid(A, B, C, D).ToString(EGuidFormats::DigitsWithHyphens).ToLower();
+	}
+
+	FString MakeGiveInputFrame(const FString& SessionId, const TCHAR* ControlId, const FString& EventFields)
+	{
+		return FString::Printf(TEXT("{\"type\":\"method\",\"method\":\"giveInput\",\"params\":{\"participantID\":\"%s\",\"input\":{\"controlID\":\"%s\",%s}},\"discard\":true}"),
+			*SessionId, ControlId, *EventFields);
+	}
+
+	/** An onParticipantJoin or onParticipantLeave frame for Count participants starting at FirstUserId, and their session ids. */
+	FString MakeParticipantsFrame(const TCHAR* Method, FRandomStream& Random, uint32 FirstUserId, int32 Count, TArray<FString>* InOutSessionIds = nullptr)
+	{
+		FString ParticipantsJson;
+		for (int32 i = 0; i < Count; ++i)
+		{
+			const FString SessionId = InOutSessionIds != nullptr && InOutSessionIds->IsValidIndex(i) ? (*InOutSessionIds)[i] : MakeSessionGuidString(Random);
+			if (InOutSessionIds != nullptr && !InOutSessionIds->IsValidIndex(i))
+			{
+				InOutSessionIds->Add(SessionId);
+			}
+
+			if (i > 0)
+			{
+				ParticipantsJson += TEXT(',');
+			}
+			ParticipantsJson += FString::Printf(
+				TEXT("{\"sessionID\":\"%s\",\"userID\":%u,\"username\":\"BenchViewer%u\",\"level\":1,\"lastInputAt\":0,\"connectedAt\":0,\"groupID\":\"default\",\"disabled\":false}"),
+				*SessionId, FirstUserId + i, FirstUserId + i);
+		}
+		return FString::Printf(TEXT("{\"type\":\"method\",\"method\":\"%s\",\"params\":{\"participants\":[%s]},\"discard\":true}"), Method, *ParticipantsJson);
+	}
+
+	const TCHAR* BenchmarkScenesResult =
+		TEXT("{\"scenes\":[{\"sceneID\":\"default\",\"controls\":[")
+		TEXT("{\"controlID\":\"bench_button\",\"kind\":\"button\"},")
+		TEXT("{\"controlID\":\"bench_stick\",\"kind\":\"joystick\"}")
+		TEXT("],\"groups\":[{\"groupID\":\"default\"}]}]}");
+
+	/** Most frames the backends are handed between pumps, see interactive_loopback_receive */
+	const int32 MaxFramesPerPump = 1024;
+
+	/** Receive Frames, pumping as often as the backend needs.  Not pumped after the last frame. */
+	void ReceiveBenchmarkFrames(FMixerInteractivityModule& Module, TArrayView<const FString> Frames, int32 NumFrames)
+	{
+		for (int32 i = 0; i < NumFrames; ++i)
+		{
+			Module.ReceiveBenchmarkFrame(Frames[i % Frames.Num()]);
+			if ((i + 1) % MaxFramesPerPump == 0)
+			{
+				Module.PumpBenchmarkSession();
+			}
+		}
+	}
+}
+
+/**
+* Stands in for the far end of a connection.  Always connected (without announcing it, so owners
+* don't take it for a host worth remembering) and discards whatever is sent.  Frames are handed to
+* the owner with DecodeBenchmarkFrame instead.
+*/
+class FMixerBenchmarkSocket : public IWebSocket
+{
+public:
+	FMixerBenchmarkSocket()
+		: bConnected(false)
+	{
+	}
+
+	virtual void Connect() override
+	{
+		bConnected = true;
+	}
+
+	virtual void Close(int32 Code = 1000, const FString& Reason = FString()) override
+	{
+		// Not reported, so that owners don't try to reconnect
+		bConnected = false;
+	}
+
+	virtual bool IsConnected() override
+	{
+		return bConnected;
+	}
+
+	virtual void Send(const FString& Data) override
+	{
+	}
+
+	virtual void Send(const void* Utf8Data, SIZE_T Size, bool bIsBinary) override
+	{
+	}
+
+	virtual FWebSocketConnectedEvent& OnConnected() override { return ConnectedEvent; }
+	virtual FWebSocketConnectionErrorEvent& OnConnectionError() override { return ConnectionErrorEvent; }
+	virtual FWebSocketClosedEvent& OnClosed() override { return ClosedEvent; }
+	virtual FWebSocketMessageEvent& OnMessage() override { return MessageEvent; }
+	virtual FWebSocketRawMessageEvent& OnRawMessage() override { return RawMessageEvent; }
+
+private:
+	FWebSocketConnectedEvent ConnectedEvent;
+	FWebSocketConnectionErrorEvent ConnectionErrorEvent;
+	FWebSocketClosedEvent ClosedEvent;
+	FWebSocketMessageEvent MessageEvent;
+	FWebSocketRawMessageEvent RawMessageEvent;
+	bool bConnected;
+};
+
+struct FMixerBenchmarks::FContext
+{
+	FAutomationTestBase& Test;
+	int32 Iterations;
+
+	explicit FContext(FAutomationTestBase& InTest)
+		: Test(InTest)
+		, Iterations(FMath::Max(CVarMixerBenchmarkIterations.GetValueOnGameThread(), 1))
+	{
+	}
+
+	void Report(const FString& Name, const FBenchmarkSample& Sample, int64 NumOps) const
+	{
+		const double Ops = static_cast<double>(FMath::Max<int64>(NumOps, 1));
+		const double Nanoseconds = static_cast<double>(Sample.Cycles) * FPlatformTime::GetSecondsPerCycle64() * 1.0e9;
+		Test.AddInfo(FString::Printf(TEXT("%-40s %12.1f ns/op %10.2f allocs/op  (%lld ops)"), *Name, Nanoseconds / Ops, static_cast<double>(Sample.Allocations) / Ops, NumOps));
+	}
+
+	/** Start a benchmark session on the module, or say why there isn't one.  End it with EndBenchmarkSession. */
+	bool BeginSession(FMixerInteractivityModule& Module) const
+	{
+		if (!Module.BeginBenchmarkSession(BenchmarkScenesResult))
+		{
+			// The session is torn down through the usual path afterwards, which would sign a real user out
+			Test.AddWarning(TEXT("Skipped: this backend can't run a benchmark session, or a user is signed in."));
+			return false;
+		}
+		return true;
+	}
+};
+
+bool FMixerBenchmarks::IsBenchmarkEndpoint(const FString& Url)
+{
+	return Url.StartsWith(TEXT("bench://"));
+}
+
+TSharedRef<IWebSocket> FMixerBenchmarks::CreateSocket(const FString& Url)
+{
+	return MakeShared<FMixerBenchmarkSocket>();
+}
+
+bool FMixerBenchmarks::RunForTest(FAutomationTestBase& Test, void (*Benchmark)(FContext&))
+{
+	check(IsInGameThread());
+
+	// Nothing should be held back by rate limits
+	UMixerInteractivitySettings* Settings = GetMutableDefault<UMixerInteractivitySettings>();
+	TGuardValue<float> ControlUpdateIntervalGuard(Settings->ControlUpdateMinInterval, 0.0f);
+	TGuardValue<int32> ControlUpdateBytesGuard(Settings->ControlUpdateBytesPerSecond, 0);
+	// Benchmark scenes mustn't end up seeding the next real session
+	TGuardValue<bool> WarmStartGuard(Settings->bUseWarmStartCache, false);
+
+	FContext Context(Test);
+	Benchmark(Context);
+	return !Test.HasAnyErrors();
+}
+
+void FMixerBenchmarks::RunInteractiveBenchmarks(FContext& Context)
+{
+	FMixerInteractivityModule& Module = static_cast<FMixerInteractivityModule&>(IMixerInteractivityModule::Get());
+	if (!Context.BeginSession(Module))
+	{
+		return;
+	}
+
+	FRandomStream Random(0x4d495852);
+	TArray<FString> InputSessionIds;
+	Module.ReceiveBenchmarkFrame(MakeParticipantsFrame(TEXT("onParticipantJoin"), Random, 1, 1, &InputSessionIds));
+	Module.PumpBenchmarkSession();
+
+	{
+		const FString Frames[] =
+		{
+			MakeGiveInputFrame(InputSessionIds[0], TEXT("bench_button"), TEXT("\"event\":\"mousedown\",\"button\":0")),
+			MakeGiveInputFrame(InputSessionIds[0], TEXT("bench_button"), TEXT("\"event\":\"mouseup\",\"button\":0")),
+		};
+
+		FBenchmarkSample Sample;
+		Sample.Start();
+		ReceiveBenchmarkFrames(Module, Frames, Context.Iterations);
+		Module.PumpBenchmarkSession();
+		Sample.Stop();
+		Context.Report(TEXT("GiveInput.Button"), Sample, Context.Iterations);
+	}
+
+	{
+		TArray<FString> Frames;
+		for (int32 i = 0; i < 64; ++i)
+		{
+			const float Angle = static_cast<float>(i) * (2.0f * PI / 64.0f);
+			Frames.Add(MakeGiveInputFrame(InputSessionIds[0], TEXT("bench_stick"), FString::Printf(TEXT("\"event\":\"move\",\"x\":%.3f,\"y\":%.3f"), FMath::Cos(Angle), FMath::Sin(Angle))));
+		}
+
+		FBenchmarkSample Sample;
+		Sample.Start();
+		ReceiveBenchmarkFrames(Module, Frames, Context.Iterations);
+		Module.PumpBenchmarkSession();
+		Sample.Stop();
+		Context.Report(TEXT("GiveInput.Stick"), Sample, Context.Iterations);
+	}
+
+	{
+		const int32 BatchSize = 100;
+		TArray<FString> BatchSessionIds;
+		const FString JoinFrame = MakeParticipantsFrame(TEXT("onParticipantJoin"), Random, 1000, BatchSize, &BatchSessionIds);
+		const FString LeaveFrame = MakeParticipantsFrame(TEXT("onParticipantLeave"), Random, 1000, BatchSize, &BatchSessionIds);
+
+		const int32 NumBatches = FMath::Max(Context.Iterations / BatchSize, 1);
+		FBenchmarkSample JoinSample;
+		FBenchmarkSample LeaveSample;
+		for (int32 i = 0; i < NumBatches; ++i)
+		{
+			JoinSample.Start();
+			Module.ReceiveBenchmarkFrame(JoinFrame);
+			Module.PumpBenchmarkSession();
+			JoinSample.Stop();
+
+			LeaveSample.Start();
+			Module.ReceiveBenchmarkFrame(LeaveFrame);
+			Module.PumpBenchmarkSession();
+			LeaveSample.Stop();
+		}
+
+		// Per participant, since that's what scales with audience churn
+		Context.Report(TEXT("ParticipantJoin.Batch100"), JoinSample, static_cast<int64>(NumBatches) * BatchSize);
+		Context.Report(TEXT("ParticipantLeave.Batch100"), LeaveSample, static_cast<int64>(NumBatches) * BatchSize);
+	}
+
+	Module.EndBenchmarkSession();
+}
+
+void FMixerBenchmarks::RunParticipantQueryBenchmarks(FContext& Context)
+{
+	const int32 AudienceSizes[] = { 1000, 10000, 100000 };
+	FMixerInteractivityModule& Module = static_cast<FMixerInteractivityModule&>(IMixerInteractivityModule::Get());
+	for (int32 AudienceSize : AudienceSizes)
+	{
+		if (!Context.BeginSession(Module))
+		{
+			return;
+		}
+
+		// Built up through the usual join path so that group membership is just as a live session has it
+		FRandomStream Random(AudienceSize);
+		const int32 JoinBatchSize = 1000;
+		for (int32 Joined = 0; Joined < AudienceSize; Joined += JoinBatchSize)
+		{
+			Module.ReceiveBenchmarkFrame(MakeParticipantsFrame(TEXT("onParticipantJoin"), Random, 1 + Joined, FMath::Min(JoinBatchSize, AudienceSize - Joined)));
+			Module.PumpBenchmarkSession();
+		}
+
+		// Each call copies the whole group, so keep the total amount of work roughly constant
+		const FString Name = FString::Printf(TEXT("GetParticipantsInGroup.%d"), AudienceSize);
+		const int32 NumCalls = FMath::Max(static_cast<int32>(static_cast<int64>(Context.Iterations) * 100 / AudienceSize), 10);
+		int32 NumReturned = 0;
+		FBenchmarkSample Sample;
+		for (int32 i = 0; i < NumCalls; ++i)
+		{
+			TArray<TSharedPtr<const FMixerRemoteUser>> Participants;
+			Sample.Start();
+			Module.GetParticipantsInGroup(NAME_DefaultMixerParticipantGroup, Participants);
+			Sample.Stop();
+			NumReturned = Participants.Num();
+		}
+
+		Context.Test.TestEqual(*FString::Printf(TEXT("%s participants returned"), *Name), NumReturned, AudienceSize);
+		Context.Report(Name, Sample, NumCalls);
+
+		Module.EndBenchmarkSession();
+	}
+}
+
+void FMixerBenchmarks::RunControlUpdateBenchmarks(FContext& Context)
+{
+	FMixerInteractivityModule& Module = static_cast<FMixerInteractivityModule&>(IMixerInteractivityModule::Get());
+	if (!Context.BeginSession(Module))
+	{
+		return;
+	}
+
+	const int32 ControlCounts[] = { 10, 100, 1000 };
+	const FName SceneName = TEXT("MixerBenchmark");
+	for (int32 ControlCount : ControlCounts)
+	{
+		TArray<FName> ControlNames;
+		for (int32 i = 0; i < ControlCount; ++i)
+		{
+			ControlNames.Add(*FString::Printf(TEXT("bench_control_%d"), i));
+		}
+
+		// One op is a frame's worth: every control changed, then the flush and send
+		const int32 NumFrames = FMath::Max(Context.Iterations / ControlCount, 10);
+		TArray<TSharedRef<FJsonObject>> Properties;
+		FBenchmarkSample Sample;
+		for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+		{
+			Properties.Reset();
+			for (int32 i = 0; i < ControlCount; ++i)
+			{
+				TSharedRef<FJsonObject> ControlProperties = MakeShared<FJsonObject>();
+				ControlProperties->SetNumberField(TEXT("progress"), static_cast<double>((Frame + i) % 100) / 100.0);
+				Properties.Add(ControlProperties);
+			}
+
+			Sample.Start();
+			for (int32 i = 0; i < ControlCount; ++i)
+			{
+				Module.UpdateRemoteControl(SceneName, ControlNames[i], Properties[i]);
+			}
+			Module.PumpBenchmarkSession();
+			Sample.Stop();
+		}
+		Context.Report(FString::Printf(TEXT("ControlUpdates.%d"), ControlCount), Sample, NumFrames);
+	}
+
+	Module.EndBenchmarkSession();
+}
+
+void FMixerBenchmarks::RunChatBenchmarks(FContext& Context)
+{
+	FMixerInteractivityModule& Module = static_cast<FMixerInteractivityModule&>(IMixerInteractivityModule::Get());
+	TSharedPtr<FOnlineChatMixer> ChatInterface = StaticCastSharedPtr<FOnlineChatMixer>(Module.GetExtendedChatInterface());
+	if (!ChatInterface.IsValid())
+	{
+		Context.Test.AddWarning(TEXT("Skipped: no chat interface."));
+		return;
+	}
+
+	// A room of our own that nobody has joined, fed through the connection's usual dispatch.  Listeners
+	// for all rooms will still see the messages go by.
+	TSharedRef<FUniqueNetIdMixer> BenchmarkUser = MakeShared<FUniqueNetIdMixer>(0);
+	TSharedRef<FMixerChatConnection> Connection = MakeShared<FMixerChatConnection>(ChatInterface.Get(), *BenchmarkUser, TEXT("MixerBenchmark"), FChatRoomConfig());
+	Connection->InitBenchmarkConnection(TEXT("chat"));
+
+	// Message ids are unique so that history bookkeeping behaves as it would live; senders repeat.
+	const int32 NumSenders = 64;
+	FRandomStream Random(0x43484154);
+	TArray<FString> Frames;
+	Frames.Reserve(Context.Iterations);
+	for (int32 i = 0; i < Context.Iterations; ++i)
+	{
+		const uint32 SenderId = 1 + (i % NumSenders);
+		Frames.Add(FString::Printf(
+			TEXT("{\"type\":\"event\",\"event\":\"ChatMessage\",\"data\":{\"channel\":1,\"id\":\"%s\",\"user_name\":\"BenchChatter%u\",\"user_id\":%u,\"user_level\":1,\"user_roles\":[\"User\"],")
+			TEXT("\"message\":{\"message\":[{\"type\":\"text\",\"data\":\"benchmark message %d\",\"text\":\"benchmark message %d\"}],\"meta\":{}}}}"),
+			*MakeSessionGuidString(Random), SenderId, SenderId, i, i));
+	}
+
+	FBenchmarkSample Sample;
+	Sample.Start();
+	for (const FString& Frame : Frames)
+	{
+		Connection->DecodeBenchmarkFrame(Frame);
+	}
+	Connection->DispatchBenchmarkFrames();
+	Sample.Stop();
+	Context.Report(TEXT("ChatMessage"), Sample, Frames.Num());
+}
+
+void FMixerBenchmarks::RunCustomControlBenchmarks(FContext& Context)
+{
+	// There's no building a custom control outside of a game world, so this times the ones the game has
+	TArray<UMixerCustomControl*> Controls;
+	for (TObjectIterator<UMixerCustomControl> It; It; ++It)
+	{
+		UWorld* World = It->GetWorld();
+		if (!It->IsTemplate() && World != nullptr && World->IsGameWorld())
+		{
+			Controls.Add(*It);
+		}
+	}
+
+	if (Controls.Num() == 0)
+	{
+		Context.Test.AddWarning(TEXT("Skipped: no custom controls are live; run with a session that has some."));
+		return;
+	}
+
+	// Whatever the passes below queue holds the controls' current values, so it's left to be sent as usual
+	for (UMixerCustomControl* Control : Controls)
+	{
+		const FString ControlLabel = FString::Printf(TEXT("CustomControl.Tick.%s.%s"), *Control->GetClass()->GetName(), *Control->ControlName.ToString());
+
+		// Nothing changed: the cost every control pays on every pass
+		{
+			Control->Tick(0.0f);
+
+			FBenchmarkSample Sample;
+			Sample.Start();
+			for (int32 i = 0; i < Context.Iterations; ++i)
+			{
+				Control->Tick(0.0f);
+			}
+			Sample.Stop();
+			Context.Report(ControlLabel + TEXT(".Unchanged"), Sample, Context.Iterations);
+		}
+
+		// Everything changed
+		{
+			FBenchmarkSample Sample;
+			for (int32 i = 0; i < Context.Iterations; ++i)
+			{
+				Control->ResendAllProperties();
+				Sample.Start();
+				Control->Tick(0.0f);
+				Sample.Stop();
+			}
+			Context.Report(ControlLabel + TEXT(".AllChanged"), Sample, Context.Iterations);
+		}
+	}
+}
+
+void FMixerBenchmarks::RunStickFilterChecks(FContext& Context)
+{
+	// Filter settings are resolved as the stick is added, so they have to be in place before the session starts
+	UMixerInteractivitySettings* Settings = GetMutableDefault<UMixerInteractivitySettings>();
+	FMixerStickInputFilter Filter;
+	Filter.Deadzone = 0.2f;
+	Filter.MinimumDelta = 0.0f;
+	Filter.MaxEventsPerSecond = 0.0f;
+	TGuardValue<FMixerStickInputFilter> FilterGuard(Settings->StickInputFilter, Filter);
+	TGuardValue<TMap<FName, FMixerStickInputFilter>> FilterOverridesGuard(Settings->StickInputFilterOverrides, TMap<FName, FMixerStickInputFilter>());
+	TGuardValue<bool> PerParticipantGuard(Settings->bPerParticipantStateCaching, true);
+	TGuardValue<bool> AdaptivePerParticipantGuard(Settings->bAdaptivePerParticipantStateCaching, false);
+	TGuardValue<bool> CoalesceGuard(Settings->bCoalesceStickInput, false);
+
+	FMixerInteractivityModule& Module = static_cast<FMixerInteractivityModule&>(IMixerInteractivityModule::Get());
+	if (!Context.BeginSession(Module))
+	{
+		return;
+	}
+
+	FRandomStream Random(0x53544b46);
+	TArray<FString> SessionIds;
+	Module.ReceiveBenchmarkFrame(MakeParticipantsFrame(TEXT("onParticipantJoin"), Random, 1, 1, &SessionIds));
+	Module.PumpBenchmarkSession();
+
+	TArray<FVector2D> Delivered;
+	FDelegateHandle StickHandle = Module.OnStickEvent().AddLambda([&Delivered](FName StickId, TSharedPtr<const FMixerRemoteUser> Participant, FVector2D Value)
+	{
+		Delivered.Add(Value);
+	});
+
+	// The participant's release leaves nobody deflecting the stick, which resets its per-participant values
+	const TCHAR* Moves[] =
+	{
+		TEXT("\"event\":\"move\",\"x\":0.5,\"y\":0.5"),
+		TEXT("\"event\":\"move\",\"x\":0,\"y\":0"),
+		TEXT("\"event\":\"move\",\"x\":0.1,\"y\":0"),
+	};
+	for (const TCHAR* Move : Moves)
+	{
+		Module.ReceiveBenchmarkFrame(MakeGiveInputFrame(SessionIds[0], TEXT("bench_stick"), Move));
+		Module.PumpBenchmarkSession();
+	}
+
+	Module.OnStickEvent().Remove(StickHandle);
+	Module.EndBenchmarkSession();
+
+	// The move inside the deadzone reads as centred, which the game already has
+	Context.Test.TestEqual(TEXT("Stick moves delivered"), Delivered.Num(), 2);
+	if (Delivered.Num() >= 2)
+	{
+		Context.Test.TestTrue(TEXT("Release delivered as centred"), Delivered[1].IsZero());
+	}
+}
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMixerBenchmarkInteractiveTest, "MixerInteractivity.Benchmark.Interactive", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMixerBenchmarkParticipantQueryTest, "MixerInteractivity.Benchmark.GetParticipantsInGroup", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMixerBenchmarkControlUpdateTest, "MixerInteractivity.Benchmark.ControlUpdates", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMixerBenchmarkChatTest, "MixerInteractivity.Benchmark.ChatMessage", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMixerBenchmarkCustomControlTest, "MixerInteractivity.Benchmark.CustomControlTick", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FMixerBenchmarkInteractiveTest::RunTest(const FString& Parameters)
+{
+	return FMixerBenchmarks::RunForTest(*this, &FMixerBenchmarks::RunInteractiveBenchmarks);
+}
+
+bool FMixerBenchmarkParticipantQueryTest::RunTest(const FString& Parameters)
+{
+	return FMixerBenchmarks::RunForTest(*this, &FMixerBenchmarks::RunParticipantQueryBenchmarks);
+}
+
+bool FMixerBenchmarkControlUpdateTest::RunTest(const FString& Parameters)
+{
+	return FMixerBenchmarks::RunForTest(*this, &FMixerBenchmarks::RunControlUpdateBenchmarks);
+}
+
+bool FMixerBenchmarkChatTest::RunTest(const FString& Parameters)
+{
+	return FMixerBenchmarks::RunForTest(*this, &FMixerBenchmarks::RunChatBenchmarks);
+}
+
+bool FMixerBenchmarkCustomControlTest::RunTest(const FString& Parameters)
+{
+	return FMixerBenchmarks::RunForTest(*this, &FMixerBenchmarks::RunCustomControlBenchmarks);
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMixerStickFilterAfterReleaseTest, "MixerInteractivity.Input.StickFilterAfterRelease", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FMixerStickFilterAfterReleaseTest::RunTest(const FString& Parameters)
+{
+	return FMixerBenchmarks::RunForTest(*this, &FMixerBenchmarks::RunStickFilterChecks);
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMixerBenchmarkSteadyStateAllocationsTest, "MixerInteractivity.Benchmark.SteadyStateAllocations", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FMixerBenchmarkSteadyStateAllocationsTest::RunTest(const FString& Parameters)
+{
+	// The default synthetic workload, so that results line up with Mixer.Benchmark.Compare's
+	if (!FMixerBenchmarks::RunComparison(FMixerBenchmarks::FComparisonOptions(), this))
+	{
+		AddWarning(TEXT("Skipped: this backend can't run a benchmark session, or a user is signed in."));
+		return true;
+	}
+	return !HasAnyErrors();
+}
+
+#endif
+
+namespace
+{
+	const TCHAR* GetComparisonBackendName()
+	{
+#if MIXER_BACKEND_UE
+		return TEXT("UE");
+#elif MIXER_BACKEND_INTERACTIVE_CPP_2
+		return TEXT("InteractiveCpp2");
+#elif MIXER_BACKEND_INTERACTIVE_CPP
+		return TEXT("InteractiveCpp");
+#else
+		return TEXT("Null");
+#endif
+	}
+
+	FString GetComparisonDir()
+	{
+		return FPaths::ProjectSavedDir() / TEXT("Mixer") / TEXT("Compare");
+	}
+
+	const TCHAR* ComparisonSummaryFilename = TEXT("Comparison.csv");
+
+	/** Memory the plugin holds, by its LLM tags where LLM is on, otherwise the whole process */
+	int64 GetComparisonMemory(FString& OutSource)
+	{
+#if ENABLE_LOW_LEVEL_MEM_TRACKER && ENGINE_MINOR_VERSION >= 20
+		if (FLowLevelMemTracker::IsEnabled())
+		{
+			OutSource = TEXT("LLM");
+			int64 Total = 0;
+			for (int32 i = 0; i < static_cast<int32>(EMixerLLMTag::Count); ++i)
+			{
+				Total += FLowLevelMemTracker::Get().GetTagAmountForTracker(ELLMTracker::Default, MixerLLM::ToLLMTag(static_cast<EMixerLLMTag>(i)));
+			}
+			return Total;
+		}
+#endif
+		OutSource = TEXT("Process.UsedPhysical");
+		return static_cast<int64>(FPlatformMemory::GetStats().UsedPhysical);
+	}
+
+	template <typename T>
+	T GetPercentile(TArray<T> Values, float Percentile)
+	{
+		if (Values.Num() == 0)
+		{
+			return T(0);
+		}
+		Values.Sort();
+		return Values[FMath::Clamp(FMath::CeilToInt(Percentile * Values.Num()) - 1, 0, Values.Num() - 1)];
+	}
+}
+
+static FAutoConsoleCommand CmdMixerBenchmarkCompare(
+	TEXT("Mixer.Benchmark.Compare"),
+	TEXT("Drive this build's interactive backend with a fixed workload and write ms/frame (receive, parse and dispatch), allocs/frame, dispatch latency and memory to Saved/Mixer/Compare.  ")
+	TEXT("Takes frames, participants and inputs per frame, e.g. Mixer.Benchmark.Compare 600 1000 200, or a recording: Mixer.Benchmark.Compare replay=Capture.mxrc.  ")
+	TEXT("Run once in each backend's build on the same platform, then Mixer.Benchmark.CompareReport."),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		FMixerBenchmarks::FComparisonOptions Options;
+		int32 NumericArgs = 0;
+		for (const FString& Arg : Args)
+		{
+			if (Arg.StartsWith(TEXT("replay=")))
+			{
+				Options.Recording = Arg.Mid(7);
+			}
+			else if (Arg.IsNumeric())
+			{
+				const int32 Value = FMath::Max(FCString::Atoi(*Arg), 1);
+				switch (NumericArgs++)
+				{
+				case 0: Options.Frames = Value; break;
+				case 1: Options.Participants = Value; break;
+				case 2: Options.InputsPerFrame = Value; break;
+				default: break;
+				}
+			}
+		}
+		FMixerBenchmarks::RunComparison(Options);
+	}));
+
+static FAutoConsoleCommand CmdMixerBenchmarkCompareReport(
+	TEXT("Mixer.Benchmark.CompareReport"),
+	TEXT("Log the Mixer.Benchmark.Compare reports in Saved/Mixer/Compare side by side and write them to Comparison.csv."),
+	FConsoleCommandDelegate::CreateStatic(&FMixerBenchmarks::ReportComparison));
+
+/** Participants and input, independent of any backend's wire format. */
+struct FMixerBenchmarks::FComparisonWorkload
+{
+	enum class EEventKind : uint8
+	{
+		Join,
+		Leave,
+		ButtonDown,
+		ButtonUp,
+		Move,
+	};
+
+	struct FEvent
+	{
+		EEventKind Kind;
+		int32 Participant;
+		FVector2D Value;
+	};
+
+	/** One per participant; user ids are the index plus one */
+	TArray<FString> SessionIds;
+
+	/** Delivered before timing starts */
+	TArray<FEvent> Setup;
+
+	TArray<TArray<FEvent>> Frames;
+
+	FString Description;
+	int64 NumEvents;
+
+	FComparisonWorkload()
+		: NumEvents(0)
+	{
+	}
+
+	void AddEvent(TArray<FEvent>& To, EEventKind Kind, int32 Participant, FVector2D Value = FVector2D::ZeroVector)
+	{
+		FEvent& Event = To[To.AddUninitialized()];
+		Event.Kind = Kind;
+		Event.Participant = Participant;
+		Event.Value = Value;
+	}
+};
+
+struct FMixerBenchmarks::FComparisonResult
+{
+	/** Everything the backend did for the frame: receive and parse, then dispatch */
+	TArray<double> FrameMilliseconds;
+	TArray<double> ReceiveMilliseconds;
+	TArray<double> DispatchMilliseconds;
+	TArray<uint32> FrameAllocations;
+
+	/**
+	* From handing an event to the backend until the game's delegate fires for the event in the same position
+	* in its frame.  Events the backend drops (repeated moves, say) move later ones onto earlier receive times,
+	* so this is an upper bound.
+	*/
+	TArray<double> LatencyMicroseconds;
+
+	int64 MemoryBefore;
+	int64 MemoryAfter;
+	FString MemorySource;
+
+	TArray<double> ReceiveTimes;
+	int32 NextLatencyIndex;
+	int64 EventsDelivered;
+
+	FComparisonResult()
+		: MemoryBefore(0)
+		, MemoryAfter(0)
+		, NextLatencyIndex(0)
+		, EventsDelivered(0)
+	{
+	}
+
+	void Reserve(const FComparisonWorkload& Workload)
+	{
+		FrameMilliseconds.Reserve(Workload.Frames.Num());
+		ReceiveMilliseconds.Reserve(Workload.Frames.Num());
+		DispatchMilliseconds.Reserve(Workload.Frames.Num());
+		FrameAllocations.Reserve(Workload.Frames.Num());
+		LatencyMicroseconds.Reserve(Workload.NumEvents);
+		int32 MaxFrameEvents = 0;
+		for (const TArray<FComparisonWorkload::FEvent>& Frame : Workload.Frames)
+		{
+			MaxFrameEvents = FMath::Max(MaxFrameEvents, Frame.Num());
+		}
+		ReceiveTimes.Reserve(MaxFrameEvents);
+	}
+
+	/** Bound to the module's input and participant delegates for the length of the run */
+	void OnDelivered()
+	{
+		if (NextLatencyIndex < ReceiveTimes.Num())
+		{
+			LatencyMicroseconds.Add((FPlatformTime::Seconds() - ReceiveTimes[NextLatencyIndex++]) * 1.0e6);
+		}
+		++EventsDelivered;
+	}
+
+	/**
+	* Hand the backend each frame's events as they'd come off the wire, then pump it as a tick would.  The
+	* backend can only hold so much between pumps (see interactive_loopback_receive), so very busy frames are
+	* pumped part way through as well.
+	*/
+	void RunFrames(FMixerInteractivityModule& Module, const TArray<FString>& SetupFrames, const TArray<TArray<FString>>& Frames)
+	{
+		const int32 MaxEventsPerPump = 1024;
+		for (int32 i = 0; i < SetupFrames.Num(); ++i)
+		{
+			Module.ReceiveBenchmarkFrame(SetupFrames[i]);
+			if ((i + 1) % MaxEventsPerPump == 0)
+			{
+				Module.PumpBenchmarkSession();
+			}
+		}
+		Module.PumpBenchmarkSession();
+		EventsDelivered = 0;
+
+		const double MillisecondsPerCycle = FPlatformTime::GetSecondsPerCycle64() * 1000.0;
+		MemoryBefore = GetComparisonMemory(MemorySource);
+		for (const TArray<FString>& Frame : Frames)
+		{
+			ReceiveTimes.Reset();
+			NextLatencyIndex = 0;
+			uint64 ReceiveCycles = 0;
+			uint64 DispatchCycles = 0;
+			FMixerAllocationCounter Allocations;
+			for (int32 i = 0; i < Frame.Num(); ++i)
+			{
+				const uint64 ReceiveStart = FPlatformTime::Cycles64();
+				ReceiveTimes.Add(FPlatformTime::Seconds());
+				Module.ReceiveBenchmarkFrame(Frame[i]);
+				ReceiveCycles += FPlatformTime::Cycles64() - ReceiveStart;
+
+				if ((i + 1) % MaxEventsPerPump == 0)
+				{
+					const uint64 DispatchStart = FPlatformTime::Cycles64();
+					Module.PumpBenchmarkSession();
+					DispatchCycles += FPlatformTime::Cycles64() - DispatchStart;
+				}
+			}
+			const uint64 DispatchStart = FPlatformTime::Cycles64();
+			Module.PumpBenchmarkSession();
+			DispatchCycles += FPlatformTime::Cycles64() - DispatchStart;
+
+			FrameAllocations.Add(Allocations.Get());
+			ReceiveMilliseconds.Add(ReceiveCycles * MillisecondsPerCycle);
+			DispatchMilliseconds.Add(DispatchCycles * MillisecondsPerCycle);
+			FrameMilliseconds.Add((ReceiveCycles + DispatchCycles) * MillisecondsPerCycle);
+		}
+		ReceiveTimes.Reset();
+		MemoryAfter = GetComparisonMemory(MemorySource);
+	}
+};
+
+bool FMixerBenchmarks::BuildSyntheticWorkload(const FComparisonOptions& Options, FComparisonWorkload& OutWorkload)
+{
+	FRandomStream Random(Options.Seed);
+	for (int32 i = 0; i < Options.Participants; ++i)
+	{
+		OutWorkload.SessionIds.Add(MakeSessionGuidString(Random));
+		OutWorkload.AddEvent(OutWorkload.Setup, FComparisonWorkload::EEventKind::Join, i);
+	}
+
+	// Half button presses and releases, half joystick moves, from participants picked at random
+	TBitArray<> Holding(false, Options.Participants);
+	OutWorkload.Frames.SetNum(Options.Frames);
+	for (TArray<FComparisonWorkload::FEvent>& Frame : OutWorkload.Frames)
+	{
+		Frame.Reserve(Options.InputsPerFrame);
+		for (int32 i = 0; i < Options.InputsPerFrame; ++i)
+		{
+			const int32 Participant = Random.RandHelper(Options.Participants);
+			if (Random.GetFraction() < 0.5f)
+			{
+				const bool bWasHolding = Holding[Participant];
+				Holding[Participant] = !bWasHolding;
+				OutWorkload.AddEvent(Frame, bWasHolding ? FComparisonWorkload::EEventKind::ButtonUp : FComparisonWorkload::EEventKind::ButtonDown, Participant);
+			}
+			else
+			{
+				const float Angle = Random.FRandRange(0.0f, 2.0f * PI);
+				const float Radius = Random.GetFraction();
+				OutWorkload.AddEvent(Frame, FComparisonWorkload::EEventKind::Move, Participant, FVector2D(FMath::Cos(Angle), FMath::Sin(Angle)) * Radius);
+			}
+		}
+		OutWorkload.NumEvents += Frame.Num();
+	}
+
+	OutWorkload.Description = FString::Printf(TEXT("synthetic %d frames, %d participants, %d inputs/frame, seed %d"), Options.Frames, Options.Participants, Options.InputsPerFrame, Options.Seed);
+	return true;
+}
+
+bool FMixerBenchmarks::LoadRecordedWorkload(const FString& Recording, FComparisonWorkload& OutWorkload)
+{
+#if MIXER_TRAFFIC_RECORDER_ENABLED
+	const FString Path = FMixerTrafficRecorder::GetRecordingPath(Recording);
+	TArray<uint8> RecordingData;
+	if (!FFileHelper::LoadFileToArray(RecordingData, *Path))
+	{
+		UE_LOG(LogMixerInteractivity, Warning, TEXT("Mixer.Benchmark.Compare: couldn't read %s."), *Path);
+		return false;
+	}
+
+	FMemoryReader Reader(RecordingData);
+	uint32 Magic = 0;
+	uint32 Version = 0;
+	int64 StartTicks = 0;
+	Reader << Magic;
+	Reader << Version;
+	Reader << StartTicks;
+	if (Reader.IsError() || Magic != FMixerTrafficRecorder::FileMagic || Version != FMixerTrafficRecorder::FileVersion)
+	{
+		UE_LOG(LogMixerInteractivity, Warning, TEXT("Mixer.Benchmark.Compare: %s is not a Mixer recording this version can read."), *Path);
+		return false;
+	}
+
+	// Recorded frames are bucketed into 60Hz game frames.  Controls are mapped onto the benchmark scene's
+	// button and joystick by kind, since the recording's own scenes come from a reply no backend here asked for.
+	const uint8 InboundInteractiveTag = static_cast<uint8>(EMixerTrafficChannel::Interactive) << 1 | static_cast<uint8>(EMixerTrafficDirection::Inbound);
+	const double FrameSeconds = 1.0 / 60.0;
+	TMap<FString, int32> ParticipantsBySessionId;
+	double RecordedTime = 0.0;
+	double FirstFrameTime = -1.0;
+	while (!Reader.AtEnd())
+	{
+		uint8 Tag = 0;
+		uint32 DeltaMicroseconds = 0;
+		uint32 ByteCount = 0;
+		Reader << Tag;
+		Reader.SerializeIntPacked(DeltaMicroseconds);
+		Reader.SerializeIntPacked(ByteCount);
+		const int64 Offset = Reader.Tell();
+		if (Reader.IsError() || Offset + ByteCount > RecordingData.Num())
+		{
+			break;
+		}
+		Reader.Seek(Offset + ByteCount);
+		RecordedTime += DeltaMicroseconds / 1000000.0;
+		if (Tag != InboundInteractiveTag)
+		{
+			continue;
+		}
+
+		FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(RecordingData.GetData() + Offset), static_cast<int32>(ByteCount));
+		TSharedPtr<FJsonObject> Message;
+		TSharedRef<TJsonReader<>> JsonReader = TJsonReaderFactory<>::Create(FString(Converted.Length(), Converted.Get()));
+		const TSharedPtr<FJsonObject>* Params = nullptr;
+		FString Method;
+		if (!FJsonSerializer::Deserialize(JsonReader, Message) || !Message.IsValid()
+			|| !Message->TryGetStringField(TEXT("method"), Method) || !Message->TryGetObjectField(TEXT("params"), Params))
+		{
+			continue;
+		}
+
+		if (FirstFrameTime < 0.0)
+		{
+			FirstFrameTime = RecordedTime;
+		}
+		const int32 FrameIndex = FMath::FloorToInt((RecordedTime - FirstFrameTime) / FrameSeconds);
+		if (FrameIndex >= OutWorkload.Frames.Num())
+		{
+			OutWorkload.Frames.SetNum(FrameIndex + 1);
+		}
+		TArray<FComparisonWorkload::FEvent>& Frame = OutWorkload.Frames[FrameIndex];
+		const int32 NumBefore = Frame.Num();
+
+		auto FindOrAddParticipant = [&OutWorkload, &ParticipantsBySessionId](const FString& SessionId)
+		{
+			const int32* Existing = ParticipantsBySessionId.Find(SessionId);
+			return Existing != nullptr ? *Existing : ParticipantsBySessionId.Add(SessionId, OutWorkload.SessionIds.Add(SessionId));
+		};
+
+		if (Method == TEXT("onParticipantJoin") || Method == TEXT("onParticipantLeave"))
+		{
+			const bool bJoin = Method == TEXT("onParticipantJoin");
+			const TArray<TSharedPtr<FJsonValue>>* Participants = nullptr;
+			if ((*Params)->TryGetArrayField(TEXT("participants"), Participants))
+			{
+				for (const TSharedPtr<FJsonValue>& ParticipantValue : *Participants)
+				{
+					const TSharedPtr<FJsonObject>* Participant = nullptr;
+					FString SessionId;
+					if (ParticipantValue->TryGetObject(Participant) && (*Participant)->TryGetStringField(TEXT("sessionID"), SessionId))
+					{
+						OutWorkload.AddEvent(Frame, bJoin ? FComparisonWorkload::EEventKind::Join : FComparisonWorkload::EEventKind::Leave, FindOrAddParticipant(SessionId));
+					}
+				}
+			}
+		}
+		else if (Method == TEXT("giveInput"))
+		{
+			const TSharedPtr<FJsonObject>* Input = nullptr;
+			FString SessionId;
+			FString Event;
+			if ((*Params)->TryGetStringField(TEXT("participantID"), SessionId) && (*Params)->TryGetObjectField(TEXT("input"), Input) && (*Input)->TryGetStringField(TEXT("event"), Event))
+			{
+				const int32 Participant = FindOrAddParticipant(SessionId);
+				if (Event == TEXT("mousedown"))
+				{
+					OutWorkload.AddEvent(Frame, FComparisonWorkload::EEventKind::ButtonDown, Participant);
+				}
+				else if (Event == TEXT("mouseup"))
+				{
+					OutWorkload.AddEvent(Frame, FComparisonWorkload::EEventKind::ButtonUp, Participant);
+				}
+				else if (Event == TEXT("move"))
+				{
+					double X = 0.0;
+					double Y = 0.0;
+					(*Input)->TryGetNumberField(TEXT("x"), X);
+					(*Input)->TryGetNumberField(TEXT("y"), Y);
+					OutWorkload.AddEvent(Frame, FComparisonWorkload::EEventKind::Move, Participant, FVector2D(static_cast<float>(X), static_cast<float>(Y)));
+				}
+			}
+		}
+
+		OutWorkload.NumEvents += Frame.Num() - NumBefore;
+	}
+
+	if (OutWorkload.NumEvents == 0)
+	{
+		UE_LOG(LogMixerInteractivity, Warning, TEXT("Mixer.Benchmark.Compare: %s has no participant or input traffic."), *Path);
+		return false;
+	}
+
+	OutWorkload.Description = FString::Printf(TEXT("recording %s, %d frames, %d participants"), *FPaths::GetCleanFilename(Path), OutWorkload.Frames.Num(), OutWorkload.SessionIds.Num());
+	return true;
+#else
+	UE_LOG(LogMixerInteractivity, Warning, TEXT("Mixer.Benchmark.Compare: recordings can't be read in this build."));
+	return false;
+#endif
+}
+
+bool FMixerBenchmarks::RunComparison(const FComparisonOptions& Options, FAutomationTestBase* Test)
+{
+	check(IsInGameThread());
+
+	FComparisonWorkload Workload;
+	if (!(Options.Recording.IsEmpty() ? BuildSyntheticWorkload(Options, Workload) : LoadRecordedWorkload(Options.Recording, Workload)))
+	{
+		return false;
+	}
+
+	// Benchmark scenes mustn't end up seeding the next real session
+	UMixerInteractivitySettings* Settings = GetMutableDefault<UMixerInteractivitySettings>();
+	TGuardValue<bool> WarmStartGuard(Settings->bUseWarmStartCache, false);
+
+	UE_LOG(LogMixerInteractivity, Display, TEXT("Mixer.Benchmark.Compare: %s backend, %s."), GetComparisonBackendName(), *Workload.Description);
+
+	FComparisonResult Result;
+	Result.Reserve(Workload);
+
+	IMixerInteractivityModule& Module = IMixerInteractivityModule::Get();
+	FDelegateHandle ButtonHandle = Module.OnButtonEvent().AddLambda([&Result](FName, TSharedPtr<const FMixerRemoteUser>, const FMixerButtonEventDetails&) { Result.OnDelivered(); });
+	FDelegateHandle StickHandle = Module.OnStickEvent().AddLambda([&Result](FName, TSharedPtr<const FMixerRemoteUser>, FVector2D) { Result.OnDelivered(); });
+	FDelegateHandle ParticipantHandle = Module.OnParticipantStateChanged().AddLambda([&Result](TSharedPtr<const FMixerRemoteUser>, EMixerInteractivityParticipantState) { Result.OnDelivered(); });
+
+	const bool bRan = RunComparisonWorkload(Workload, Result);
+
+	Module.OnButtonEvent().Remove(ButtonHandle);
+	Module.OnStickEvent().Remove(StickHandle);
+	Module.OnParticipantStateChanged().Remove(ParticipantHandle);
+
+	if (!bRan)
+	{
+		UE_LOG(LogMixerInteractivity, Display, TEXT("Mixer.Benchmark.Compare: the %s backend can't run a benchmark session, or a user is signed in; nothing written."), GetComparisonBackendName());
+		return false;
+	}
+
+	WriteComparisonReport(Workload, Result);
+
+	// Hold steady state input processing to the same budget the module's tick is held to
+	if (Settings->SteadyStateAllocationBudget >= 0)
+	{
+		const uint32 Budget = static_cast<uint32>(Settings->SteadyStateAllocationBudget);
+		const int32 WarmupFrames = Result.FrameAllocations.Num() / 10;
+		int32 FramesOverBudget = 0;
+		uint32 WorstFrame = 0;
+		for (int32 i = WarmupFrames; i < Result.FrameAllocations.Num(); ++i)
+		{
+			if (Result.FrameAllocations[i] > Budget)
+			{
+				++FramesOverBudget;
+				WorstFrame = FMath::Max(WorstFrame, Result.FrameAllocations[i]);
+			}
+		}
+
+		if (FramesOverBudget > 0)
+		{
+			const FString Message = FString::Printf(TEXT("%d of %d steady state frames allocated more than the budget of %u (worst %u)."),
+				FramesOverBudget, Result.FrameAllocations.Num() - WarmupFrames, Budget, WorstFrame);
+			if (Test != nullptr)
+			{
+				Test->AddError(Message);
+			}
+			else
+			{
+				UE_LOG(LogMixerInteractivity, Warning, TEXT("Mixer.Benchmark.Compare: %s"), *Message);
+			}
+		}
+		else if (Test != nullptr && FMixerAllocationCounter::GetProcessTotal() == 0)
+		{
+			Test->AddWarning(TEXT("The allocator keeps no call counts in this build, so the allocation budget wasn't checked."));
+		}
+	}
+	else if (Test != nullptr)
+	{
+		Test->AddWarning(TEXT("SteadyStateAllocationBudget is -1, so there's no budget to check."));
+	}
+
+	return true;
+}
+
+bool FMixerBenchmarks::RunComparisonWorkload(const FComparisonWorkload& Workload, FComparisonResult& Result)
+{
+	// Rendered up front, and the same bytes whichever backend this is
+	FRandomStream UnusedRandom(0);
+	auto RenderFrame = [&Workload, &UnusedRandom](const FComparisonWorkload::FEvent& Event) -> FString
+	{
+		const FString& SessionId = Workload.SessionIds[Event.Participant];
+		switch (Event.Kind)
+		{
+		case FComparisonWorkload::EEventKind::Join:
+		case FComparisonWorkload::EEventKind::Leave:
+			{
+				TArray<FString> SessionIds;
+				SessionIds.Add(SessionId);
+				return MakeParticipantsFrame(Event.Kind == FComparisonWorkload::EEventKind::Join ? TEXT("onParticipantJoin") : TEXT("onParticipantLeave"), UnusedRandom, Event.Participant + 1, 1, &SessionIds);
+			}
+
+		case FComparisonWorkload::EEventKind::ButtonDown:
+			return MakeGiveInputFrame(SessionId, TEXT("bench_button"), TEXT("\"event\":\"mousedown\",\"button\":0"));
+
+		case FComparisonWorkload::EEventKind::ButtonUp:
+			return MakeGiveInputFrame(SessionId, TEXT("bench_button"), TEXT("\"event\":\"mouseup\",\"button\":0"));
+
+		case FComparisonWorkload::EEventKind::Move:
+		default:
+			return MakeGiveInputFrame(SessionId, TEXT("bench_stick"), FString::Printf(TEXT("\"event\":\"move\",\"x\":%.3f,\"y\":%.3f"), Event.Value.X, Event.Value.Y));
+		}
+	};
+
+	TArray<FString> SetupFrames;
+	for (const FComparisonWorkload::FEvent& Event : Workload.Setup)
+	{
+		SetupFrames.Add(RenderFrame(Event));
+	}
+	TArray<TArray<FString>> RenderedFrames;
+	RenderedFrames.SetNum(Workload.Frames.Num());
+	for (int32 FrameIndex = 0; FrameIndex < Workload.Frames.Num(); ++FrameIndex)
+	{
+		RenderedFrames[FrameIndex].Reserve(Workload.Frames[FrameIndex].Num());
+		for (const FComparisonWorkload::FEvent& Event : Workload.Frames[FrameIndex])
+		{
+			RenderedFrames[FrameIndex].Add(RenderFrame(Event));
+		}
+	}
+
+	FMixerInteractivityModule& Module = static_cast<FMixerInteractivityModule&>(IMixerInteractivityModule::Get());
+	if (!Module.BeginBenchmarkSession(BenchmarkScenesResult))
+	{
+		return false;
+	}
+
+	Result.RunFrames(Module, SetupFrames, RenderedFrames);
+
+	Module.EndBenchmarkSession();
+	return true;
+}
+
+bool FMixerBenchmarks::WriteComparisonReport(const FComparisonWorkload& Workload, const FComparisonResult& Result)
+{
+	double TotalMilliseconds = 0.0;
+	double MaxMilliseconds = 0.0;
+	for (double Milliseconds : Result.FrameMilliseconds)
+	{
+		TotalMilliseconds += Milliseconds;
+		MaxMilliseconds = FMath::Max(MaxMilliseconds, Milliseconds);
+	}
+	double TotalReceiveMilliseconds = 0.0;
+	for (double Milliseconds : Result.ReceiveMilliseconds)
+	{
+		TotalReceiveMilliseconds += Milliseconds;
+	}
+	double TotalDispatchMilliseconds = 0.0;
+	for (double Milliseconds : Result.DispatchMilliseconds)
+	{
+		TotalDispatchMilliseconds += Milliseconds;
+	}
+	uint64 TotalAllocations = 0;
+	for (uint32 Allocations : Result.FrameAllocations)
+	{
+		TotalAllocations += Allocations;
+	}
+	const double NumFrames = FMath::Max(Result.FrameMilliseconds.Num(), 1);
+	const double NumEvents = static_cast<double>(FMath::Max<int64>(Workload.NumEvents, 1));
+
+	TArray<TPair<FString, FString>> Rows;
+	auto AddRow = [&Rows](const TCHAR* Metric, const FString& Value)
+	{
+		Rows.Add(TPair<FString, FString>(Metric, Value));
+	};
+	AddRow(TEXT("Backend"), GetComparisonBackendName());
+	AddRow(TEXT("Platform"), FPlatformProperties::IniPlatformName());
+	AddRow(TEXT("Workload"), Workload.Description.Replace(TEXT(","), TEXT(";")));
+	AddRow(TEXT("Frames"), FString::FromInt(Result.FrameMilliseconds.Num()));
+	AddRow(TEXT("Events"), FString::Printf(TEXT("%lld"), Workload.NumEvents));
+	AddRow(TEXT("EventsDelivered"), FString::Printf(TEXT("%lld"), Result.EventsDelivered));
+	AddRow(TEXT("MsPerFrame.Mean"), FString::Printf(TEXT("%.4f"), TotalMilliseconds / NumFrames));
+	AddRow(TEXT("MsPerFrame.P95"), FString::Printf(TEXT("%.4f"), GetPercentile(Result.FrameMilliseconds, 0.95f)));
+	AddRow(TEXT("MsPerFrame.Max"), FString::Printf(TEXT("%.4f"), MaxMilliseconds));
+	AddRow(TEXT("ReceiveMsPerFrame.Mean"), FString::Printf(TEXT("%.4f"), TotalReceiveMilliseconds / NumFrames));
+	AddRow(TEXT("DispatchMsPerFrame.Mean"), FString::Printf(TEXT("%.4f"), TotalDispatchMilliseconds / NumFrames));
+	AddRow(TEXT("NsPerEvent"), FString::Printf(TEXT("%.1f"), TotalMilliseconds * 1.0e6 / NumEvents));
+	AddRow(TEXT("AllocsPerFrame.Mean"), FString::Printf(TEXT("%.2f"), TotalAllocations / NumFrames));
+	AddRow(TEXT("AllocsPerEvent"), FString::Printf(TEXT("%.3f"), TotalAllocations / NumEvents));
+	AddRow(TEXT("DispatchLatencyUs.P50"), FString::Printf(TEXT("%.2f"), GetPercentile(Result.LatencyMicroseconds, 0.5f)));
+	AddRow(TEXT("DispatchLatencyUs.P99"), FString::Printf(TEXT("%.2f"), GetPercentile(Result.LatencyMicroseconds, 0.99f)));
+	AddRow(TEXT("MemoryGrowthKB"), FString::Printf(TEXT("%.1f"), (Result.MemoryAfter - Result.MemoryBefore) / 1024.0));
+	AddRow(TEXT("MemorySource"), Result.MemorySource);
+
+	FString Csv = TEXT("Metric,Value\n");
+	for (const TPair<FString, FString>& Row : Rows)
+	{
+		UE_LOG(LogMixerInteractivity, Display, TEXT("Mixer.Benchmark.Compare %-28s %s"), *Row.Key, *Row.Value);
+		Csv += FString::Printf(TEXT("%s,%s\n"), *Row.Key, *Row.Value);
+	}
+
+	const FString Path = GetComparisonDir() / FString::Printf(TEXT("%s-%s.csv"), GetComparisonBackendName(), FPlatformProperties::IniPlatformName());
+	if (!FFileHelper::SaveStringToFile(Csv, *Path))
+	{
+		UE_LOG(LogMixerInteractivity, Warning, TEXT("Mixer.Benchmark.Compare: couldn't write %s."), *Path);
+		return false;
+	}
+	UE_LOG(LogMixerInteractivity, Display, TEXT("Mixer.Benchmark.Compare: wrote %s."), *Path);
+	return true;
+}
+
+void FMixerBenchmarks::ReportComparison()
+{
+	const FString Dir = GetComparisonDir();
+	TArray<FString> Filenames;
+	IFileManager::Get().FindFiles(Filenames, *(Dir / TEXT("*.csv")), true, false);
+	Filenames.Remove(ComparisonSummaryFilename);
+	Filenames.Sort();
+	if (Filenames.Num() == 0)
+	{
+		UE_LOG(LogMixerInteractivity, Display, TEXT("Mixer.Benchmark.CompareReport: no reports in %s; run Mixer.Benchmark.Compare first."), *Dir);
+		return;
+	}
+
+	// Metrics in the order the first report lists them, then each report's values
+	TArray<FString> Metrics;
+	TArray<TMap<FString, FString>> Reports;
+	for (const FString& Filename : Filenames)
+	{
+		TArray<FString> Lines;
+		FFileHelper::LoadFileToStringArray(Lines, *(Dir / Filename));
+		TMap<FString, FString>& Report = Reports[Reports.AddDefaulted()];
+		for (int32 i = 1; i < Lines.Num(); ++i)
+		{
+			FString Metric;
+			FString Value;
+			if (Lines[i].Split(TEXT(","), &Metric, &Value))
+			{
+				Report.Add(Metric, Value);
+				Metrics.AddUnique(Metric);
+			}
+		}
+	}
+
+	const FString* FirstWorkload = Reports[0].Find(TEXT("Workload"));
+	for (int32 i = 1; i < Reports.Num(); ++i)
+	{
+		const FString* Workload = Reports[i].Find(TEXT("Workload"));
+		if (FirstWorkload == nullptr || Workload == nullptr || *Workload != *FirstWorkload)
+		{
+			UE_LOG(LogMixerInteractivity, Warning, TEXT("Mixer.Benchmark.CompareReport: %s ran a different workload from %s, so their numbers aren't comparable."), *Filenames[i], *Filenames[0]);
+		}
+	}
+
+	FString Csv = TEXT("Metric");
+	for (const FString& Filename : Filenames)
+	{
+		Csv += TEXT(",") + FPaths::GetBaseFilename(Filename);
+	}
+	Csv += TEXT("\n");
+
+	for (const FString& Metric : Metrics)
+	{
+		FString Line = FString::Printf(TEXT("%-28s"), *Metric);
+		Csv += Metric;
+		for (const TMap<FString, FString>& Report : Reports)
+		{
+			const FString* Value = Report.Find(Metric);
+			Line += FString::Printf(TEXT(" %20s"), Value != nullptr ? **Value : TEXT("-"));
+			Csv += TEXT(",") + (Value != nullptr ? *Value : FString());
+		}
+		Csv += TEXT("\n");
+		UE_LOG(LogMixerInteractivity, Display, TEXT("Mixer.Benchmark.CompareReport %s"), *Line);
+	}
+
+	const FString Path = Dir / ComparisonSummaryFilename;
+	if (FFileHelper::SaveStringToFile(Csv, *Path))
+	{
+		UE_LOG(LogMixerInteractivity, Display, TEXT("Mixer.Benchmark.CompareReport: wrote %s."), *Path);
+	}
+}
+
+#endif
@@ -0,0 +1,101 @@
+//*********************************************************
+//
+// Copyright (c) Microsoft. All rights reserved.
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT.
+//
+//*********************************************************
+#pragma once
+
+#include "CoreMinimal.h"
+
+#ifndef MIXER_BENCHMARKS_ENABLED
+#define MIXER_BENCHMARKS_ENABLED !UE_BUILD_SHIPPING
+#endif
+
+#if MIXER_BENCHMARKS_ENABLED
+
+#include "IWebSocket.h"
+
+class FAutomationTestBase;
+
+/**
+* Timings for the plugin's hot paths, run as the MixerInteractivity.Benchmark automation tests and
+* reported as ns/op and allocs/op.  Frames go through the same receive, decode and dispatch path as
+* they would on a live connection, by way of bench:// sockets that are always connected and discard sends.
+*/
+class FMixerBenchmarks
+{
+public:
+	/** Whether the url names a benchmark socket rather than a real host. */
+	static bool IsBenchmarkEndpoint(const FString& Url);
+
+	static TSharedRef<IWebSocket> CreateSocket(const FString& Url);
+
+	/** What a benchmark reports to: the automation test running it, and how much work to do (Mixer.Benchmark.Iterations). */
+	struct FContext;
+
+	/** Run Benchmark for Test, with rate limits and the warm start cache out of the way.  @return	false if it failed. */
+	static bool RunForTest(FAutomationTestBase& Test, void (*Benchmark)(FContext&));
+
+	static void RunInteractiveBenchmarks(FContext& Context);
+	static void RunParticipantQueryBenchmarks(FContext& Context);
+	static void RunControlUpdateBenchmarks(FContext& Context);
+	static void RunChatBenchmarks(FContext& Context);
+	static void RunCustomControlBenchmarks(FContext& Context);
+
+	/** Checks of input handling that only show over a sequence of frames, run on a benchmark session like the timings. */
+	static void RunStickFilterChecks(FContext& Context);
+
+	struct FComparisonOptions
+	{
+		int32 Frames;
+		int32 Participants;
+		int32 InputsPerFrame;
+		int32 Seed;
+
+		/** Recording (see FMixerTrafficRecorder) whose participants and input to use instead of a synthetic audience */
+		FString Recording;
+
+		FComparisonOptions()
+			: Frames(600)
+			, Participants(1000)
+			, InputsPerFrame(200)
+			, Seed(0x4d495852)
+		{
+		}
+	};
+
+	/**
+	* Drive the backend this build was made with through a workload that is the same for every backend (a
+	* synthetic audience from a fixed seed, or the participants and input of a recording), one frame at a time,
+	* and write ms/frame, allocs/frame, input dispatch latency and memory growth to Saved/Mixer/Compare.  Every
+	* backend is handed the same wire frames and does all of its work on the calling thread (see
+	* FMixerInteractivityModule::BeginBenchmarkSession), so what it would do on its own threads is counted too.
+	* Backends are chosen at build time, so a comparison takes one run per backend build.
+	*
+	* Steady state frames are also held to UMixerInteractivitySettings::SteadyStateAllocationBudget: going over
+	* is an error on Test when given (see MixerInteractivity.Benchmark.SteadyStateAllocations), else a warning.
+	*
+	* @return	false if the workload couldn't be run.
+	*/
+	static bool RunComparison(const FComparisonOptions& Options, FAutomationTestBase* Test = nullptr);
+
+	/** Log the reports in Saved/Mixer/Compare side by side, and write them to Comparison.csv there. */
+	static void ReportComparison();
+
+private:
+	struct FComparisonWorkload;
+	struct FComparisonResult;
+
+	static bool BuildSyntheticWorkload(const FComparisonOptions& Options, FComparisonWorkload& OutWorkload);
+	static bool LoadRecordedWorkload(const FString& Recording, FComparisonWorkload& OutWorkload);
+
+	/** @return	false if this backend can't be driven by synthetic traffic. */
+	static bool RunComparisonWorkload(const FComparisonWorkload& Workload, FComparisonResult& Result);
+	static bool WriteComparisonReport(const FComparisonWorkload& Workload, const FComparisonResult& Result);
+};
+
+#endif
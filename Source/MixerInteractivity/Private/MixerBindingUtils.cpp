@@ -16,44 +16,523 @@
 #include "UObject/UObjectGlobals.h"
 #include "MixerInteractivityLog.h"
 
-namespace MixerBindingUtils
+namespace
 {
-	void ExtractCustomEventParamsFromMessage(const FJsonObject* JsonObject, UFunction* FunctionPrototype, void* ParamStorage, SIZE_T ParamStorageSize)
+	bool ReadBoolParam(const TSharedPtr<FJsonValue>& JsonValue, UProperty* Property, void* ParamStorage)
+	{
+		bool Value;
+		if (!JsonValue->TryGetBool(Value))
+		{
+			return false;
+		}
+		static_cast<UBoolProperty*>(Property)->SetPropertyValue(ParamStorage, Value);
+		return true;
+	}
+
+	bool ReadFloatingPointParam(const TSharedPtr<FJsonValue>& JsonValue, UProperty* Property, void* ParamStorage)
+	{
+		double Value;
+		if (!JsonValue->TryGetNumber(Value))
+		{
+			return false;
+		}
+		static_cast<UNumericProperty*>(Property)->SetFloatingPointPropertyValue(ParamStorage, Value);
+		return true;
+	}
+
+	bool ReadIntParam(const TSharedPtr<FJsonValue>& JsonValue, UProperty* Property, void* ParamStorage)
+	{
+		double Value;
+		if (!JsonValue->TryGetNumber(Value))
+		{
+			return false;
+		}
+
+		// Out of range values would otherwise wrap (a negative count into a uint8, say), so leave the parameter at its default
+		const int32 Bits = Property->ElementSize * 8;
+		const bool bUnsigned = Property->IsA<UByteProperty>() || Property->IsA<UUInt16Property>() || Property->IsA<UUInt32Property>();
+		const double MinValue = bUnsigned ? 0.0 : -FMath::Pow(2.0, Bits - 1);
+		const double MaxValue = bUnsigned ? FMath::Pow(2.0, Bits) - 1.0 : FMath::Pow(2.0, Bits - 1) - 1.0;
+		if (Value < MinValue || Value > MaxValue)
+		{
+			return false;
+		}
+
+		static_cast<UNumericProperty*>(Property)->SetIntPropertyValue(ParamStorage, static_cast<int64>(Value));
+		return true;
+	}
+
+	bool ReadStrParam(const TSharedPtr<FJsonValue>& JsonValue, UProperty* Property, void* ParamStorage)
+	{
+		return JsonValue->TryGetString(*static_cast<FString*>(ParamStorage));
+	}
+
+	bool ReadNameParam(const TSharedPtr<FJsonValue>& JsonValue, UProperty* Property, void* ParamStorage)
+	{
+		FString Value;
+		if (!JsonValue->TryGetString(Value))
+		{
+			return false;
+		}
+		*static_cast<FName*>(ParamStorage) = FName(*Value);
+		return true;
+	}
+
+	bool ReadGenericParam(const TSharedPtr<FJsonValue>& JsonValue, UProperty* Property, void* ParamStorage)
+	{
+		return FJsonObjectConverter::JsonValueToUProperty(JsonValue, Property, ParamStorage, 0, 0);
+	}
+
+	MixerBindingUtils::FCustomEventParamPlan::FParamReader SelectParamReader(const UProperty* Property)
 	{
-		check(ParamStorageSize == FunctionPrototype->ParmsSize);
+		// Anything with special handling in FJsonObjectConverter (enums, containers, structs, text...) goes through it
+		if (Property->ArrayDim != 1)
+		{
+			return &ReadGenericParam;
+		}
+		if (Property->IsA<UBoolProperty>())
+		{
+			return &ReadBoolParam;
+		}
+		if (const UNumericProperty* NumericProp = Cast<const UNumericProperty>(Property))
+		{
+			if (NumericProp->IsEnum())
+			{
+				return &ReadGenericParam;
+			}
+			if (NumericProp->IsFloatingPoint())
+			{
+				return &ReadFloatingPointParam;
+			}
+			// Unsigned 64 bit values don't round trip through the signed setter
+			if (!Property->IsA<UUInt64Property>())
+			{
+				return &ReadIntParam;
+			}
+			return &ReadGenericParam;
+		}
+		if (Property->IsA<UStrProperty>())
+		{
+			return &ReadStrParam;
+		}
+		if (Property->IsA<UNameProperty>())
+		{
+			return &ReadNameParam;
+		}
+		return &ReadGenericParam;
+	}
+
+	TSharedRef<const MixerBindingUtils::FCustomEventParamPlan> BuildCustomEventParamPlan(UFunction* FunctionPrototype)
+	{
+		using MixerBindingUtils::FCustomEventParamPlan;
+
+		TSharedRef<FCustomEventParamPlan> Plan = MakeShared<FCustomEventParamPlan>();
+		Plan->Function = FunctionPrototype;
+		Plan->bZeroConstructOnly = true;
+		Plan->bNeedsDestroy = false;
 		for (TFieldIterator<UProperty> PropIt(FunctionPrototype); PropIt && (PropIt->PropertyFlags & CPF_Parm); ++PropIt)
 		{
 			if (!PropIt->HasAnyPropertyFlags(CPF_OutParm) || PropIt->HasAnyPropertyFlags(CPF_ReferenceParm))
 			{
-				check(static_cast<SIZE_T>(PropIt->GetOffset_ForUFunction() + PropIt->GetSize()) <= ParamStorageSize);
-				void* ThisParamStorage = static_cast<uint8*>(ParamStorage) + PropIt->GetOffset_ForUFunction();
-				PropIt->InitializeValue(ThisParamStorage);
-				TSharedPtr<FJsonValue> F = JsonObject->TryGetField(PropIt->GetName());
-				if (F.IsValid())
+				check(PropIt->GetOffset_ForUFunction() + PropIt->GetSize() <= FunctionPrototype->ParmsSize);
+				FCustomEventParamPlan::FEntry& Entry = Plan->Entries[Plan->Entries.AddDefaulted()];
+				Entry.Property = *PropIt;
+				Entry.JsonKey = PropIt->GetName();
+				Entry.Offset = PropIt->GetOffset_ForUFunction();
+				Entry.Reader = SelectParamReader(*PropIt);
+
+				if (!PropIt->HasAnyPropertyFlags(CPF_ZeroConstructor))
 				{
-					if (!FJsonObjectConverter::JsonValueToUProperty(F, *PropIt, ThisParamStorage, 0, 0))
-					{
-						UE_LOG(LogMixerInteractivity, Error, TEXT("Custom event %s: failed to convert Json value %s for parameter %s"), *FunctionPrototype->GetName(), *F->AsString(), *PropIt->GetName());
-					}
+					Plan->bZeroConstructOnly = false;
 				}
-				else
+				if (!PropIt->HasAnyPropertyFlags(CPF_NoDestructor))
 				{
-					UE_LOG(LogMixerInteractivity, Error, TEXT("Custom event %s does not contain expected parameter %s"), *FunctionPrototype->GetName(), *PropIt->GetName());
+					Plan->bNeedsDestroy = true;
 				}
 			}
 		}
+		return Plan;
 	}
 
-	void DestroyCustomEventParams(UFunction* FunctionPrototype, void* ParamStorage, SIZE_T ParamStorageSize)
+	TMap<TWeakObjectPtr<UFunction>, TSharedPtr<const MixerBindingUtils::FCustomEventParamPlan>>& GetCustomEventParamPlans()
 	{
-		for (TFieldIterator<UProperty> PropIt(FunctionPrototype); PropIt && (PropIt->PropertyFlags & CPF_Parm); ++PropIt)
+		static TMap<TWeakObjectPtr<UFunction>, TSharedPtr<const MixerBindingUtils::FCustomEventParamPlan>> Plans;
+		return Plans;
+	}
+
+	typedef TJsonWriter<UTF8CHAR, FMixerUtf8CondensedJsonPrintPolicy> FParamsWriter;
+
+	// The writer has separate overloads for object fields and array elements; these pick by whether there's a name.
+	template <class ValueType>
+	void WriteJsonValue(FParamsWriter& Writer, const FString* Identifier, ValueType Value)
+	{
+		if (Identifier != nullptr)
 		{
-			if (!PropIt->HasAnyPropertyFlags(CPF_OutParm) || PropIt->HasAnyPropertyFlags(CPF_ReferenceParm))
+			Writer.WriteValue(*Identifier, Value);
+		}
+		else
+		{
+			Writer.WriteValue(Value);
+		}
+	}
+
+	void WriteJsonNull(FParamsWriter& Writer, const FString* Identifier)
+	{
+		if (Identifier != nullptr)
+		{
+			Writer.WriteNull(*Identifier);
+		}
+		else
+		{
+			Writer.WriteNull();
+		}
+	}
+
+	void WriteJsonObjectStart(FParamsWriter& Writer, const FString* Identifier)
+	{
+		if (Identifier != nullptr)
+		{
+			Writer.WriteObjectStart(*Identifier);
+		}
+		else
+		{
+			Writer.WriteObjectStart();
+		}
+	}
+
+	void WriteJsonArrayStart(FParamsWriter& Writer, const FString* Identifier)
+	{
+		if (Identifier != nullptr)
+		{
+			Writer.WriteArrayStart(*Identifier);
+		}
+		else
+		{
+			Writer.WriteArrayStart();
+		}
+	}
+
+	void WriteJsonDomValue(FParamsWriter& Writer, const FString* Identifier, const TSharedPtr<FJsonValue>& Value)
+	{
+		if (!Value.IsValid())
+		{
+			WriteJsonNull(Writer, Identifier);
+			return;
+		}
+
+		switch (Value->Type)
+		{
+		case EJson::Boolean:
+			WriteJsonValue(Writer, Identifier, Value->AsBool());
+			break;
+		case EJson::Number:
+			WriteJsonValue(Writer, Identifier, Value->AsNumber());
+			break;
+		case EJson::String:
+			WriteJsonValue(Writer, Identifier, Value->AsString());
+			break;
+		case EJson::Array:
+			WriteJsonArrayStart(Writer, Identifier);
+			for (const TSharedPtr<FJsonValue>& Element : Value->AsArray())
+			{
+				WriteJsonDomValue(Writer, nullptr, Element);
+			}
+			Writer.WriteArrayEnd();
+			break;
+		case EJson::Object:
+			WriteJsonObjectStart(Writer, Identifier);
+			for (const TPair<FString, TSharedPtr<FJsonValue>>& Field : Value->AsObject()->Values)
+			{
+				WriteJsonDomValue(Writer, &Field.Key, Field.Value);
+			}
+			Writer.WriteObjectEnd();
+			break;
+		default:
+			WriteJsonNull(Writer, Identifier);
+			break;
+		}
+	}
+
+	// Struct fields left out of custom method params, as for every other serialization of them
+	const uint64 CustomMethodParamsSkipFlags = CPF_Transient | CPF_Deprecated;
+
+	void WriteJsonProperty(FParamsWriter& Writer, const FString* Identifier, UProperty* Property, const void* Value);
+
+	void WriteJsonPropertyElement(FParamsWriter& Writer, const FString* Identifier, UProperty* Property, const void* Value)
+	{
+		// Mirrors SelectParamReader: the common flat types are written directly, and anything with special
+		// handling in FJsonObjectConverter (enums, maps, sets, objects...) goes through it.
+		if (const UBoolProperty* BoolProp = Cast<const UBoolProperty>(Property))
+		{
+			WriteJsonValue(Writer, Identifier, BoolProp->GetPropertyValue(Value));
+			return;
+		}
+		if (const UNumericProperty* NumericProp = Cast<const UNumericProperty>(Property))
+		{
+			if (NumericProp->IsFloatingPoint())
 			{
-				check(static_cast<SIZE_T>(PropIt->GetOffset_ForUFunction() + PropIt->GetSize()) <= ParamStorageSize);
-				void* ThisParamStorage = static_cast<uint8*>(ParamStorage) + PropIt->GetOffset_ForUFunction();
-				PropIt->DestroyValue(ThisParamStorage);
+				WriteJsonValue(Writer, Identifier, NumericProp->GetFloatingPointPropertyValue(Value));
+				return;
 			}
+			if (!NumericProp->IsEnum() && !Property->IsA<UUInt64Property>())
+			{
+				WriteJsonValue(Writer, Identifier, NumericProp->GetSignedIntPropertyValue(Value));
+				return;
+			}
+		}
+		else if (const UStrProperty* StrProp = Cast<const UStrProperty>(Property))
+		{
+			WriteJsonValue(Writer, Identifier, StrProp->GetPropertyValue(Value));
+			return;
+		}
+		else if (const UNameProperty* NameProp = Cast<const UNameProperty>(Property))
+		{
+			WriteJsonValue(Writer, Identifier, NameProp->GetPropertyValue(Value).ToString());
+			return;
+		}
+		else if (const UTextProperty* TextProp = Cast<const UTextProperty>(Property))
+		{
+			WriteJsonValue(Writer, Identifier, TextProp->GetPropertyValue(Value).ToString());
+			return;
+		}
+		else if (const UArrayProperty* ArrayProp = Cast<const UArrayProperty>(Property))
+		{
+			FScriptArrayHelper Helper(ArrayProp, Value);
+			WriteJsonArrayStart(Writer, Identifier);
+			for (int32 i = 0; i < Helper.Num(); ++i)
+			{
+				WriteJsonPropertyElement(Writer, nullptr, ArrayProp->Inner, Helper.GetRawPtr(i));
+			}
+			Writer.WriteArrayEnd();
+			return;
+		}
+		else if (const UStructProperty* StructProp = Cast<const UStructProperty>(Property))
+		{
+			WriteJsonObjectStart(Writer, Identifier);
+			for (TFieldIterator<UProperty> FieldIt(StructProp->Struct); FieldIt; ++FieldIt)
+			{
+				if (FieldIt->HasAnyPropertyFlags(CustomMethodParamsSkipFlags))
+				{
+					continue;
+				}
+				const FString FieldName = FJsonObjectConverter::StandardizeCase(FieldIt->GetName());
+				WriteJsonProperty(Writer, &FieldName, *FieldIt, FieldIt->ContainerPtrToValuePtr<const void>(Value));
+			}
+			Writer.WriteObjectEnd();
+			return;
+		}
+
+		WriteJsonDomValue(Writer, Identifier, FJsonObjectConverter::UPropertyToJsonValue(Property, Value, 0, CustomMethodParamsSkipFlags));
+	}
+
+	void WriteJsonProperty(FParamsWriter& Writer, const FString* Identifier, UProperty* Property, const void* Value)
+	{
+		if (Property->ArrayDim == 1)
+		{
+			WriteJsonPropertyElement(Writer, Identifier, Property, Value);
+			return;
+		}
+
+		WriteJsonArrayStart(Writer, Identifier);
+		for (int32 i = 0; i < Property->ArrayDim; ++i)
+		{
+			WriteJsonPropertyElement(Writer, nullptr, Property, static_cast<const uint8*>(Value) + i * Property->ElementSize);
+		}
+		Writer.WriteArrayEnd();
+	}
+}
+
+namespace MixerBindingUtils
+{
+	TSharedRef<const FCustomEventParamPlan> GetCustomEventParamPlan(UFunction* FunctionPrototype)
+	{
+		check(IsInGameThread());
+		TSharedPtr<const FCustomEventParamPlan>& CachedPlan = GetCustomEventParamPlans().FindOrAdd(FunctionPrototype);
+		if (!CachedPlan.IsValid())
+		{
+			CachedPlan = BuildCustomEventParamPlan(FunctionPrototype);
+		}
+		return CachedPlan.ToSharedRef();
+	}
+
+	void InvalidateCustomEventParamPlans(const UClass* ForClass)
+	{
+		// Also drops entries for functions that have since been garbage collected
+		for (TMap<TWeakObjectPtr<UFunction>, TSharedPtr<const FCustomEventParamPlan>>::TIterator It(GetCustomEventParamPlans()); It; ++It)
+		{
+			UFunction* Function = It->Key.Get();
+			if (Function == nullptr || Function->GetOwnerClass() == ForClass)
+			{
+				It.RemoveCurrent();
+			}
+		}
+	}
+
+	void ExtractCustomEventParams(const FJsonObject* JsonObject, const FCustomEventParamPlan& Plan, void* ParamStorage)
+	{
+		if (Plan.bZeroConstructOnly)
+		{
+			FMemory::Memzero(ParamStorage, Plan.Function->ParmsSize);
+		}
+
+		for (const FCustomEventParamPlan::FEntry& Entry : Plan.Entries)
+		{
+			void* ThisParamStorage = static_cast<uint8*>(ParamStorage) + Entry.Offset;
+			if (!Plan.bZeroConstructOnly)
+			{
+				Entry.Property->InitializeValue(ThisParamStorage);
+			}
+			TSharedPtr<FJsonValue> F = JsonObject->TryGetField(Entry.JsonKey);
+			if (F.IsValid())
+			{
+				if (!Entry.Reader(F, Entry.Property, ThisParamStorage))
+				{
+					UE_LOG(LogMixerInteractivity, Error, TEXT("Custom event %s: failed to convert Json value %s for parameter %s"), *Plan.Function->GetName(), *F->AsString(), *Entry.JsonKey);
+				}
+			}
+			else
+			{
+				UE_LOG(LogMixerInteractivity, Error, TEXT("Custom event %s does not contain expected parameter %s"), *Plan.Function->GetName(), *Entry.JsonKey);
+			}
+		}
+	}
+
+	void DestroyCustomEventParams(const FCustomEventParamPlan& Plan, void* ParamStorage)
+	{
+		if (!Plan.bNeedsDestroy)
+		{
+			return;
+		}
+
+		for (const FCustomEventParamPlan::FEntry& Entry : Plan.Entries)
+		{
+			Entry.Property->DestroyValue(static_cast<uint8*>(ParamStorage) + Entry.Offset);
+		}
+	}
+
+	FCustomMethodParamsWriter::FCustomMethodParamsWriter()
+		: Archive(Buffer)
+	{
+	}
+
+	FCustomMethodParamsWriter& FCustomMethodParamsWriter::Get()
+	{
+		check(IsInGameThread());
+		static FCustomMethodParamsWriter Singleton;
+		return Singleton;
+	}
+
+	void FCustomMethodParamsWriter::Begin()
+	{
+		Buffer.Reset();
+		Archive.Seek(0);
+		Writer = TJsonWriterFactory<UTF8CHAR, FMixerUtf8CondensedJsonPrintPolicy>::Create(&Archive);
+		Writer->WriteObjectStart();
+	}
+
+	void FCustomMethodParamsWriter::WriteParam(const FString& Name, UProperty* Property, const void* Value)
+	{
+		if (!Writer.IsValid())
+		{
+			Begin();
+		}
+		WriteJsonProperty(*Writer, &Name, Property, Value);
+	}
+
+	TArrayView<const uint8> FCustomMethodParamsWriter::Finish()
+	{
+		if (!Writer.IsValid())
+		{
+			Begin();
+		}
+		Writer->WriteObjectEnd();
+		Writer->Close();
+		Writer.Reset();
+		return TArrayView<const uint8>(Buffer);
+	}
+
+	FCustomControlPropertyCache::~FCustomControlPropertyCache()
+	{
+		for (TPair<FString, TArray<FSlot>>& PropertySlots : SlotsByProperty)
+		{
+			for (FSlot& Slot : PropertySlots.Value)
+			{
+				FreeSlot(Slot);
+			}
+		}
+	}
+
+	bool FCustomControlPropertyCache::Read(const FJsonObject* Control, const FString& PropertyName, UProperty* Property, void* Dest)
+	{
+		TArray<FSlot>& PropertySlots = SlotsByProperty.FindOrAdd(PropertyName);
+		FSlot* Slot = nullptr;
+		for (int32 i = PropertySlots.Num() - 1; i >= 0; --i)
+		{
+			UProperty* SlotProperty = PropertySlots[i].Property.Get();
+			if (SlotProperty == Property)
+			{
+				Slot = &PropertySlots[i];
+				break;
+			}
+			else if (SlotProperty == nullptr)
+			{
+				// The reading blueprint was recompiled
+				FreeSlot(PropertySlots[i]);
+				PropertySlots.RemoveAtSwap(i, 1, false);
+			}
+		}
+
+		if (Slot == nullptr)
+		{
+			Slot = &PropertySlots[PropertySlots.AddDefaulted()];
+			Slot->Property = Property;
+			Slot->Reader = SelectParamReader(Property);
+			Slot->Storage = FMemory::Malloc(Property->GetSize(), Property->GetMinAlignment());
+			Property->InitializeValue(Slot->Storage);
+			Slot->bHasValue = false;
+
+			TSharedPtr<FJsonValue> JsonValue = Control != nullptr ? Control->TryGetField(PropertyName) : nullptr;
+			if (JsonValue.IsValid())
+			{
+				Slot->bHasValue = Slot->Reader(JsonValue, Property, Slot->Storage);
+			}
+		}
+
+		if (Slot->bHasValue)
+		{
+			Property->CopyCompleteValue(Dest, Slot->Storage);
+		}
+		return Slot->bHasValue;
+	}
+
+	void FCustomControlPropertyCache::ApplyUpdate(const FJsonObject& UpdatedProperties)
+	{
+		for (const TPair<FString, TSharedPtr<FJsonValue>>& Updated : UpdatedProperties.Values)
+		{
+			TArray<FSlot>* PropertySlots = SlotsByProperty.Find(Updated.Key);
+			if (PropertySlots != nullptr && Updated.Value.IsValid())
+			{
+				for (FSlot& Slot : *PropertySlots)
+				{
+					UProperty* SlotProperty = Slot.Property.Get();
+					if (SlotProperty != nullptr && Slot.Reader(Updated.Value, SlotProperty, Slot.Storage))
+					{
+						Slot.bHasValue = true;
+					}
+				}
+			}
+		}
+	}
+
+	void FCustomControlPropertyCache::FreeSlot(FSlot& Slot)
+	{
+		UProperty* SlotProperty = Slot.Property.Get();
+		if (SlotProperty != nullptr)
+		{
+			SlotProperty->DestroyValue(Slot.Storage);
 		}
+		// Otherwise the type is gone and only the block itself can be released.  Editor iteration only.
+		FMemory::Free(Slot.Storage);
+		Slot.Storage = nullptr;
 	}
-}
\ No newline at end of file
+}
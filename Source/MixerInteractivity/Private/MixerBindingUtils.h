@@ -10,12 +10,108 @@
 #pragma once
 
 #include "HAL/Platform.h"
+#include "Containers/Array.h"
+#include "Containers/UnrealString.h"
+#include "Containers/Map.h"
+#include "Containers/ArrayView.h"
+#include "Templates/SharedPointer.h"
+#include "UObject/WeakObjectPtr.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/JsonWriter.h"
+#include "MixerJsonHelpers.h"
 
+class UClass;
 class UFunction;
+class UProperty;
 class FJsonObject;
+class FJsonValue;
 
 namespace MixerBindingUtils
 {
-	void ExtractCustomEventParamsFromMessage(const FJsonObject* JsonObject, UFunction* FunctionPrototype, void* ParamStorage, SIZE_T ParamStorageSize);
-	void DestroyCustomEventParams(UFunction* FunctionPrototype, void* ParamStorage, SIZE_T ParamStorageSize);
+	/** Flattened description of the parameters a UFunction expects to have unpacked from a Json message. */
+	struct FCustomEventParamPlan
+	{
+		typedef bool (*FParamReader)(const TSharedPtr<FJsonValue>& JsonValue, UProperty* Property, void* ParamStorage);
+
+		struct FEntry
+		{
+			UProperty* Property;
+			FString JsonKey;
+			int32 Offset;
+			FParamReader Reader;
+		};
+
+		UFunction* Function;
+		TArray<FEntry> Entries;
+
+		// When set every parameter can be initialized by zeroing the whole parameter block
+		bool bZeroConstructOnly;
+
+		// When clear the destroy pass can be skipped entirely
+		bool bNeedsDestroy;
+	};
+
+	/** Returns the cached plan for FunctionPrototype, building it on first use.  Game thread only. */
+	TSharedRef<const FCustomEventParamPlan> GetCustomEventParamPlan(UFunction* FunctionPrototype);
+	void InvalidateCustomEventParamPlans(const UClass* ForClass);
+
+	void ExtractCustomEventParams(const FJsonObject* JsonObject, const FCustomEventParamPlan& Plan, void* ParamStorage);
+	void DestroyCustomEventParams(const FCustomEventParamPlan& Plan, void* ParamStorage);
+
+	/**
+	* Outbound counterpart of ExtractCustomEventParams.  Writes the params object of a custom method call as
+	* UTF-8 Json straight from parameter values, without building an FJsonObject, for
+	* IMixerInteractivityModule::CallRemoteMethodSerialized.  Call Custom Method nodes expand into a Begin,
+	* a WriteParam per parameter pin and a Finish.  Game thread only.
+	*/
+	class FCustomMethodParamsWriter
+	{
+	public:
+		FCustomMethodParamsWriter();
+
+		static FCustomMethodParamsWriter& Get();
+
+		/** Start a new params object, discarding any unfinished one. */
+		void Begin();
+		void WriteParam(const FString& Name, UProperty* Property, const void* Value);
+
+		/** Close the params object.  The text is valid until the next Begin. */
+		TArrayView<const uint8> Finish();
+
+	private:
+		TArray<uint8> Buffer;
+		FMemoryWriter Archive;
+		TSharedPtr<TJsonWriter<UTF8CHAR, FMixerUtf8CondensedJsonPrintPolicy>> Writer;
+	};
+
+	/**
+	* Properties of an unmapped custom control, already converted to the types that Get Custom Control Property
+	* nodes read them as.  A slot is converted when first read and again only when an update touches it,
+	* so reads are a plain copy.  Game thread only.
+	*/
+	class FCustomControlPropertyCache
+	{
+	public:
+		~FCustomControlPropertyCache();
+
+		/** Copy the named property into Dest as Property's type.  Returns false, leaving Dest untouched, if the control doesn't have it. */
+		bool Read(const FJsonObject* Control, const FString& PropertyName, UProperty* Property, void* Dest);
+
+		/** Reconvert the slots of properties present in UpdatedProperties.  Call once the update has been merged into the control. */
+		void ApplyUpdate(const FJsonObject& UpdatedProperties);
+
+	private:
+		struct FSlot
+		{
+			// The reading node's output property.  Identifies the type, and is needed to destroy the value.
+			TWeakObjectPtr<UProperty> Property;
+			FCustomEventParamPlan::FParamReader Reader;
+			void* Storage;
+			bool bHasValue;
+		};
+
+		static void FreeSlot(FSlot& Slot);
+
+		TMap<FString, TArray<FSlot>> SlotsByProperty;
+	};
 }
@@ -8,13 +8,18 @@
 //
 //*********************************************************
 #include "MixerChatConnection.h"
+#include "MixerChatConnectionManager.h"
 
 #include "MixerInteractivityModule.h"
+#include "MixerInteractivitySettings.h"
 #include "MixerInteractivityTypes.h"
 #include "MixerInteractivityUserSettings.h"
 #include "OnlineChatMixer.h"
 #include "OnlineChatMixerPrivate.h"
 #include "MixerJsonHelpers.h"
+#include "MixerJsonSchema.h"
+#include "MixerInteractivityLLM.h"
+#include "MixerRestClient.h"
 
 #include "HttpModule.h"
 #include "PlatformHttp.h"
@@ -29,33 +34,145 @@
 
 DEFINE_LOG_CATEGORY(LogMixerChat);
 
+DECLARE_STATS_GROUP(TEXT("Mixer Chat"), STATGROUP_MixerChat, STATCAT_Advanced);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Cached chat users"), STAT_MixerChatCachedUsers, STATGROUP_MixerChat);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Chat users evicted"), STAT_MixerChatEvictedUsers, STATGROUP_MixerChat);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Queued chat sends"), STAT_MixerChatQueuedSends, STATGROUP_MixerChat);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Chat sends coalesced"), STAT_MixerChatCoalescedSends, STATGROUP_MixerChat);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Chat sends rejected (queue full)"), STAT_MixerChatRejectedSends, STATGROUP_MixerChat);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Chat send latency (ms)"), STAT_MixerChatSendLatency, STATGROUP_MixerChat);
+DECLARE_CYCLE_STAT(TEXT("Chat history maintenance"), STAT_MixerChatHistory, STATGROUP_MixerChat);
+
+namespace
+{
+	const int32 MaxPooledChatMessages = 32;
+
+	EChatMessageSegmentMixer ParseChatMessageSegmentType(const FString& Type)
+	{
+		if (Type == TEXT("text"))
+		{
+			return EChatMessageSegmentMixer::Text;
+		}
+		else if (Type == TEXT("emoticon"))
+		{
+			return EChatMessageSegmentMixer::Emoticon;
+		}
+		else if (Type == TEXT("link"))
+		{
+			return EChatMessageSegmentMixer::Link;
+		}
+		else if (Type == TEXT("tag"))
+		{
+			return EChatMessageSegmentMixer::Tag;
+		}
+		else if (Type == TEXT("image"))
+		{
+			return EChatMessageSegmentMixer::Image;
+		}
+		return EChatMessageSegmentMixer::Other;
+	}
+
+	// Emoticons name a pack and a cell of its sprite sheet.  Builtin packs are served by Mixer,
+	// while for external ones the pack is the sheet's URL.
+	FString GetEmoticonSheetUrl(const FString& Source, const FString& Pack)
+	{
+		if (Source == TEXT("external"))
+		{
+			return Pack;
+		}
+		return FMixerRestClient::GetSiteUrl(FString::Printf(TEXT("_latest/emoticons/%s.png"), *Pack));
+	}
+
+	bool DecodeEmoticonCoords(FMixerJsonCursor& Cursor, FIntRect& OutRect)
+	{
+		int32 X = 0;
+		int32 Y = 0;
+		int32 Width = 0;
+		int32 Height = 0;
+		Cursor.TryReadObject([&X, &Y, &Width, &Height](FMixerJsonCursor& CoordsCursor)
+		{
+			while (CoordsCursor.NextField())
+			{
+				if (CoordsCursor.IsField(MixerStringConstants::FieldNames::X))
+				{
+					CoordsCursor.TryGetNumber(X);
+				}
+				else if (CoordsCursor.IsField(MixerStringConstants::FieldNames::Y))
+				{
+					CoordsCursor.TryGetNumber(Y);
+				}
+				else if (CoordsCursor.IsField(MixerStringConstants::FieldNames::Width))
+				{
+					CoordsCursor.TryGetNumber(Width);
+				}
+				else if (CoordsCursor.IsField(MixerStringConstants::FieldNames::Height))
+				{
+					CoordsCursor.TryGetNumber(Height);
+				}
+			}
+		});
+		OutRect = FIntRect(X, Y, X + Width, Y + Height);
+		return Width > 0 && Height > 0;
+	}
+}
+
 FMixerChatConnection::FMixerChatConnection(FOnlineChatMixer* InChatInterface, const FUniqueNetId& UserId, const FChatRoomId& InRoomId, const FChatRoomConfig& Config)
 	: TMixerWebSocketOwnerBase<FMixerChatConnection>(MixerStringConstants::MessageTypes::Event, MixerStringConstants::FieldNames::Event, MixerStringConstants::FieldNames::Data)
 	, ChatInterface(InChatInterface)
 	, User(UserId.AsShared())
 	, RoomId(InRoomId)
+	, EndpointIndex(0)
 	, ChannelId(0)
+	, UserCacheClock(0)
+	, UserCacheCapacity(FMath::Max(GetDefault<UMixerInteractivitySettings>()->ChatUserCacheCapacity, 0))
+	, ChatHistoryNextSequence(0)
+	, OutboundTokens(static_cast<float>(FMath::Max(GetDefault<UMixerInteractivitySettings>()->ChatSendBurst, 1)))
+	, OutboundLastRefillTime(FPlatformTime::Seconds())
+	, MembershipWindowStartTime(0.0)
+	, MembershipCoalesceWindow(FMath::Max(GetDefault<UMixerInteractivitySettings>()->ChatMembershipCoalesceWindow, 0.0f))
+	, LastOutboundSendLatency(0.0f)
+	, BootstrapStartTime(0.0)
 	, ChatHistoryNum(0)
-	, ChatHistoryMax(10) // @TODO: pull from config once available
 	, bIsReady(false)
 	, bRejoinOnDisconnect(Config.bRejoinOnDisconnect)
+	, bResumingSession(false)
 {
 	FMemory::Memzero(Permissions);
+	ChatHistory.SetNum(FMath::Max(GetDefault<UMixerInteractivitySettings>()->ChatHistoryCapacity, 0));
 }
 
 FMixerChatConnection::~FMixerChatConnection()
 {
+	DEC_DWORD_STAT_BY(STAT_MixerChatCachedUsers, CachedUsers.Num());
+	DEC_DWORD_STAT_BY(STAT_MixerChatQueuedSends, OutboundQueue.Num());
 }
 
 bool FMixerChatConnection::Init()
 {
 #if WITH_WEBSOCKETS
-	TSharedRef<IHttpRequest> ChannelRequest = FHttpModule::Get().CreateRequest();
-	ChannelRequest->SetVerb(TEXT("GET"));
-	ChannelRequest->SetURL(FString::Printf(TEXT("https://mixer.com/api/v1/channels/%s"), *RoomId));
+	BootstrapStartTime = FPlatformTime::Seconds();
+	BootstrapTimings = FChatRoomBootstrapTimingsMixer();
 
-	ChannelRequest->OnProcessRequestComplete().BindSP(this, &FMixerChatConnection::OnGetChannelInfoForRoomIdComplete);
-	return ChannelRequest->ProcessRequest();
+	const UMixerInteractivitySettings* Settings = GetDefault<UMixerInteractivitySettings>();
+	if (!Settings->ChatEndpointOverride.IsEmpty())
+	{
+		// Test endpoints skip the channel and server lookups.  Auth is anonymous, but sending is allowed.
+		ChannelId = RoomId.IsNumeric() ? FCString::Atoi(*RoomId) : 1;
+		FMemory::Memzero(Permissions);
+		Permissions.bConnect = true;
+		Permissions.bChat = true;
+		Permissions.bWhisper = true;
+		UE_LOG(LogMixerChat, Log, TEXT("Connecting chat room %s to override endpoint %s."), *RoomId, *Settings->ChatEndpointOverride);
+
+		TArray<FString> OverrideEndpoints;
+		OverrideEndpoints.Add(Settings->ChatEndpointOverride);
+		OnChatEndpointsRanked(OverrideEndpoints);
+		return true;
+	}
+
+	// Shared with other rooms' connections, so joining several at once doesn't repeat lookups.
+	ChatInterface->GetConnectionManager().ResolveChannelId(RoomId, FMixerChatConnectionManager::FOnChannelIdResolved::CreateSP(this, &FMixerChatConnection::OnChannelIdResolved));
+	return true;
 #else
 	UE_LOG(LogMixerChat, Warning, TEXT("Mixer chat requires websockets which are not available on this platform."));
 	return false;
@@ -64,24 +181,18 @@ bool FMixerChatConnection::Init()
 
 void FMixerChatConnection::JoinDiscoveredChatChannel()
 {
-	TSharedRef<IHttpRequest> ChatRequest = FHttpModule::Get().CreateRequest();
-	ChatRequest->SetVerb(TEXT("GET"));
-	ChatRequest->SetURL(FString::Printf(TEXT("https://mixer.com/api/v1/chats/%d?fields=id"), ChannelId));
-
-	// Setting Authorization header to an empty string will just fail rather than perform anonymous auth.
+	// Setting Authorization header to an empty string will just fail rather than perform anonymous auth,
+	// so the REST client leaves it off in that case.
 	const UMixerInteractivityUserSettings* UserSettings = GetDefault<UMixerInteractivityUserSettings>();
 	FString AuthZHeaderValue = UserSettings->GetAuthZHeaderValue();
-	if (AuthZHeaderValue.Len() > 0)
-	{
-		ChatRequest->SetHeader(TEXT("Authorization"), AuthZHeaderValue);
-	}
-	else
+	TSharedRef<IHttpRequest> ChatRequest = FMixerRestClient::Get().CreateRequest(TEXT("GET"), FString::Printf(TEXT("chats/%d?fields=id"), ChannelId), AuthZHeaderValue);
+	if (AuthZHeaderValue.Len() == 0)
 	{
 		UE_LOG(LogMixerChat, Warning, TEXT("No auth token found.  Chat connection will be anonymous and will not allow sending messages.  Sign in to Mixer to enable."));
 	}
 
 	ChatRequest->OnProcessRequestComplete().BindSP(this, &FMixerChatConnection::OnDiscoverChatServersComplete);
-	if (!ChatRequest->ProcessRequest())
+	if (!FMixerRestClient::Get().ProcessRequest(ChatRequest))
 	{
 		ChatInterface->ConnectAttemptFinished(*User, RoomId, false, TEXT("Failed to send request for chat web socket connection info."));
 
@@ -89,25 +200,12 @@ void FMixerChatConnection::JoinDiscoveredChatChannel()
 	}
 }
 
-void FMixerChatConnection::OnGetChannelInfoForRoomIdComplete(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded)
+void FMixerChatConnection::OnChannelIdResolved(int32 InChannelId)
 {
-	if (bSucceeded && HttpResponse.IsValid())
-	{
-		if (EHttpResponseCodes::IsOk(HttpResponse->GetResponseCode()))
-		{
-			FString ResponseStr = HttpResponse->GetContentAsString();
-			TSharedRef<TJsonReader<>> JsonReader = TJsonReaderFactory<>::Create(ResponseStr);
-			TSharedPtr<FJsonObject> JsonObject;
-			if (FJsonSerializer::Deserialize(JsonReader, JsonObject) &&
-				JsonObject.IsValid())
-			{
-				JsonObject->TryGetNumberField(MixerStringConstants::FieldNames::Id, ChannelId);
-			}
-		}
-	}
-
+	ChannelId = InChannelId;
 	if (ChannelId != 0)
 	{
+		MarkBootstrapPhase(BootstrapTimings.ChannelResolved, TEXT("channel resolved"));
 		JoinDiscoveredChatChannel();
 	}
 	else
@@ -120,61 +218,120 @@ void FMixerChatConnection::OnGetChannelInfoForRoomIdComplete(FHttpRequestPtr Htt
 
 void FMixerChatConnection::OnDiscoverChatServersComplete(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded)
 {
-	FMemory::Memzero(Permissions);
-
-	if (bSucceeded && HttpResponse.IsValid())
+	if (!bSucceeded || !HttpResponse.IsValid() || !EHttpResponseCodes::IsOk(HttpResponse->GetResponseCode()))
 	{
-		if (EHttpResponseCodes::IsOk(HttpResponse->GetResponseCode()))
+		// A channel id remembered from an earlier launch may no longer belong to this room
+		if (bSucceeded && HttpResponse.IsValid() && ChatInterface->GetConnectionManager().ForgetWarmStartChannelId(RoomId))
 		{
-			FString ResponseStr = HttpResponse->GetContentAsString();
-			TSharedRef<TJsonReader<>> JsonReader = TJsonReaderFactory<>::Create(ResponseStr);
-			TSharedPtr<FJsonObject> JsonObject;
-			if (FJsonSerializer::Deserialize(JsonReader, JsonObject) &&
-				JsonObject.IsValid())
-			{
-				const TArray<TSharedPtr<FJsonValue>> *JsonEndpoints;
-				if (JsonObject->TryGetArrayField(MixerStringConstants::FieldNames::Endpoints, JsonEndpoints))
-				{
-					for (const TSharedPtr<FJsonValue>& Endpoint : *JsonEndpoints)
-					{
-						Endpoints.Add(Endpoint->AsString());
-					}
+			ChatInterface->GetConnectionManager().ResolveChannelId(RoomId, FMixerChatConnectionManager::FOnChannelIdResolved::CreateSP(this, &FMixerChatConnection::OnChannelIdResolved));
+			return;
+		}
 
-					JsonObject->TryGetStringField(MixerStringConstants::FieldNames::AuthKey, AuthKey);
-					const TArray<TSharedPtr<FJsonValue>>* JsonPermissions;
-					if (JsonObject->TryGetArrayField(MixerStringConstants::FieldNames::Permissions, JsonPermissions))
-					{
-						Permissions.bConnect = JsonPermissions->ContainsByPredicate([](const TSharedPtr<FJsonValue>& V) { return V->AsString() == MixerStringConstants::Permissions::Connect; });
-						Permissions.bChat = JsonPermissions->ContainsByPredicate([](const TSharedPtr<FJsonValue>& V) { return V->AsString() == MixerStringConstants::Permissions::Chat; });
-						Permissions.bWhisper = JsonPermissions->ContainsByPredicate([](const TSharedPtr<FJsonValue>& V) { return V->AsString() == MixerStringConstants::Permissions::Chat; });
-						Permissions.bPollStart = JsonPermissions->ContainsByPredicate([](const TSharedPtr<FJsonValue>& V) { return V->AsString() == MixerStringConstants::Permissions::PollStart; });
-						Permissions.bPollVote = JsonPermissions->ContainsByPredicate([](const TSharedPtr<FJsonValue>& V) { return V->AsString() == MixerStringConstants::Permissions::PollVote; });
-						Permissions.bClearMessages = JsonPermissions->ContainsByPredicate([](const TSharedPtr<FJsonValue>& V) { return V->AsString() == MixerStringConstants::Permissions::ClearMessages; });
-						Permissions.bPurge = JsonPermissions->ContainsByPredicate([](const TSharedPtr<FJsonValue>& V) { return V->AsString() == MixerStringConstants::Permissions::Purge; });
-						Permissions.bGiveawayStart = JsonPermissions->ContainsByPredicate([](const TSharedPtr<FJsonValue>& V) { return V->AsString() == MixerStringConstants::Permissions::GiveawayStart; });
-					}
-				}
-			}
+		OnChatServersParsed(FChatServersInfo());
+		return;
+	}
+
+	ChatInterface->GetConnectionManager().ConfirmChannelId(RoomId, ChannelId);
+
+	TWeakPtr<FMixerChatConnection> WeakThis = AsShared();
+	ParseHttpResponseAsync<FChatServersInfo>(HttpResponse, &FMixerChatConnection::ParseChatServersResponse, [WeakThis](bool bParsed, FChatServersInfo& Info)
+	{
+		// The room may have been left while we were parsing
+		TSharedPtr<FMixerChatConnection> StrongThis = WeakThis.Pin();
+		if (StrongThis.IsValid())
+		{
+			StrongThis->OnChatServersParsed(Info);
 		}
+	});
+}
+
+bool FMixerChatConnection::ParseChatServersResponse(const FString& Content, FChatServersInfo& OutInfo)
+{
+	TSharedRef<TJsonReader<>> JsonReader = TJsonReaderFactory<>::Create(Content);
+	TSharedPtr<FJsonObject> JsonObject;
+	if (!FJsonSerializer::Deserialize(JsonReader, JsonObject) || !JsonObject.IsValid())
+	{
+		return false;
 	}
 
-	// Should have a web socket going by now.
-	if (Permissions.bConnect)
+	const TArray<TSharedPtr<FJsonValue>> *JsonEndpoints;
+	if (!JsonObject->TryGetArrayField(MixerStringConstants::FieldNames::Endpoints, JsonEndpoints))
+	{
+		return false;
+	}
+
+	for (const TSharedPtr<FJsonValue>& Endpoint : *JsonEndpoints)
 	{
-		const FString& SelectedEndpoint = Endpoints[FMath::RandRange(0, Endpoints.Num() - 1)];
-		UE_LOG(LogMixerChat, Verbose, TEXT("Opening web socket to %s for chat room %s"), *SelectedEndpoint, *RoomId);
+		OutInfo.Endpoints.Add(Endpoint->AsString());
+	}
 
-		TMap<FString, FString> EmptyHeaders;
-		InitConnection(SelectedEndpoint, EmptyHeaders);
+	JsonObject->TryGetStringField(MixerStringConstants::FieldNames::AuthKey, OutInfo.AuthKey);
+	const TArray<TSharedPtr<FJsonValue>>* JsonPermissions;
+	if (JsonObject->TryGetArrayField(MixerStringConstants::FieldNames::Permissions, JsonPermissions))
+	{
+		FChatPermissions& Permissions = OutInfo.Permissions;
+		Permissions.bConnect = JsonPermissions->ContainsByPredicate([](const TSharedPtr<FJsonValue>& V) { return V->AsString() == MixerStringConstants::Permissions::Connect; });
+		Permissions.bChat = JsonPermissions->ContainsByPredicate([](const TSharedPtr<FJsonValue>& V) { return V->AsString() == MixerStringConstants::Permissions::Chat; });
+		Permissions.bWhisper = JsonPermissions->ContainsByPredicate([](const TSharedPtr<FJsonValue>& V) { return V->AsString() == MixerStringConstants::Permissions::Chat; });
+		Permissions.bPollStart = JsonPermissions->ContainsByPredicate([](const TSharedPtr<FJsonValue>& V) { return V->AsString() == MixerStringConstants::Permissions::PollStart; });
+		Permissions.bPollVote = JsonPermissions->ContainsByPredicate([](const TSharedPtr<FJsonValue>& V) { return V->AsString() == MixerStringConstants::Permissions::PollVote; });
+		Permissions.bClearMessages = JsonPermissions->ContainsByPredicate([](const TSharedPtr<FJsonValue>& V) { return V->AsString() == MixerStringConstants::Permissions::ClearMessages; });
+		Permissions.bPurge = JsonPermissions->ContainsByPredicate([](const TSharedPtr<FJsonValue>& V) { return V->AsString() == MixerStringConstants::Permissions::Purge; });
+		Permissions.bGiveawayStart = JsonPermissions->ContainsByPredicate([](const TSharedPtr<FJsonValue>& V) { return V->AsString() == MixerStringConstants::Permissions::GiveawayStart; });
+	}
+	return true;
+}
+
+void FMixerChatConnection::OnChatServersParsed(const FChatServersInfo& Info)
+{
+	Permissions = Info.Permissions;
+	Endpoints.Append(Info.Endpoints);
+	if (!Info.AuthKey.IsEmpty())
+	{
+		AuthKey = Info.AuthKey;
+	}
+
+	// Should have a web socket going by now.
+	if (Permissions.bConnect && Endpoints.Num() > 0)
+	{
+		MarkBootstrapPhase(BootstrapTimings.ServersDiscovered, TEXT("servers discovered"));
+		const UMixerInteractivityUserSettings* UserSettings = GetDefault<UMixerInteractivityUserSettings>();
+		ChatInterface->GetConnectionManager().RankEndpoints(Endpoints, UserSettings->PreferredChatEndpoint, FMixerEndpointSelector::FOnEndpointsRanked::CreateSP(this, &FMixerChatConnection::OnChatEndpointsRanked));
 	}
 	else
 	{
-		ChatInterface->ConnectAttemptFinished(*User, RoomId, false, TEXT("No permission to connect"));
+		ChatInterface->ConnectAttemptFinished(*User, RoomId, false, Permissions.bConnect ? TEXT("No chat servers available") : TEXT("No permission to connect"));
 	}
 }
 
+void FMixerChatConnection::OnChatEndpointsRanked(const TArray<FString>& RankedEndpoints)
+{
+	Endpoints = RankedEndpoints;
+	EndpointIndex = 0;
+	MarkBootstrapPhase(BootstrapTimings.EndpointsRanked, TEXT("endpoints ranked"));
+	OpenWebSocket();
+}
+
+void FMixerChatConnection::OpenWebSocket()
+{
+	const FString& SelectedEndpoint = Endpoints[EndpointIndex];
+	UE_LOG(LogMixerChat, Verbose, TEXT("Opening web socket to %s for chat room %s"), *SelectedEndpoint, *RoomId);
+
+	TMap<FString, FString> EmptyHeaders;
+	InitConnection(SelectedEndpoint, EmptyHeaders);
+}
+
 void FMixerChatConnection::HandleSocketConnected()
 {
+	UMixerInteractivityUserSettings* UserSettings = GetMutableDefault<UMixerInteractivityUserSettings>();
+	if (GetDefault<UMixerInteractivitySettings>()->ChatEndpointOverride.IsEmpty() && UserSettings->PreferredChatEndpoint != Endpoints[EndpointIndex])
+	{
+		UserSettings->PreferredChatEndpoint = Endpoints[EndpointIndex];
+		UserSettings->SaveConfigDeferred();
+	}
+
+	MarkBootstrapPhase(BootstrapTimings.SocketConnected, TEXT("socket connected"));
+
 	TSharedPtr<const FMixerLocalUser> CurrentUser = IMixerInteractivityModule::Get().GetCurrentUser();
 	if (CurrentUser.IsValid() && !AuthKey.IsEmpty())
 	{
@@ -188,8 +345,27 @@ void FMixerChatConnection::HandleSocketConnected()
 	}
 }
 
+void FMixerChatConnection::MarkBootstrapPhase(float& Phase, const TCHAR* PhaseName)
+{
+	// Only the first time through - reconnects don't restart the clock.
+	if (Phase < 0.0f)
+	{
+		Phase = static_cast<float>(FPlatformTime::Seconds() - BootstrapStartTime);
+		UE_LOG(LogMixerChat, Verbose, TEXT("Chat room %s bootstrap: %s after %.3fs"), *RoomId, PhaseName, Phase);
+	}
+}
+
 void FMixerChatConnection::HandleSocketConnectionError()
 {
+	// Fall back through the ranked list before giving up
+	if (EndpointIndex + 1 < Endpoints.Num())
+	{
+		++EndpointIndex;
+		UE_LOG(LogMixerChat, Warning, TEXT("Failed to connect to chat server; trying %s."), *Endpoints[EndpointIndex]);
+		OpenWebSocket();
+		return;
+	}
+
 	ChatInterface->ConnectAttemptFinished(*User, RoomId, false, TEXT("Failed to connect chat web socket"));
 
 	// Note: we have probably self-destructed at this point
@@ -203,10 +379,16 @@ void FMixerChatConnection::HandleSocketClosed(bool bWasClean)
 
 	if (bRejoinOnDisconnect)
 	{
+		// Channel, endpoints and auth key are all still good, so this goes straight back to the socket.
+		// Once it's up again only the messages missed in between are fetched; see HandleResumeHistoryReply.
 		UE_LOG(LogMixerChat, Warning, TEXT("Attempting automatic reconnect to %s."), *RoomId);
-		const FString& NewRandomEndpoint = Endpoints[FMath::RandRange(0, Endpoints.Num() - 1)];
-		TMap<FString, FString> EmptyHeaders;
-		InitConnection(NewRandomEndpoint, EmptyHeaders);
+		if (bWasReady && !bResumingSession)
+		{
+			RecordResumePoint();
+		}
+		bResumingSession = bResumingSession || bWasReady;
+		EndpointIndex = (EndpointIndex + 1) % Endpoints.Num();
+		OpenWebSocket();
 	}
 	else if (bWasReady)
 	{
@@ -222,6 +404,38 @@ void FMixerChatConnection::HandleSocketClosed(bool bWasClean)
 	}
 }
 
+FString FMixerChatConnection::GetHealthPingMethodName() const
+{
+	return MixerStringConstants::MethodNames::Ping;
+}
+
+void FMixerChatConnection::HandleConnectionDegraded()
+{
+	// Mid-bootstrap the usual connect attempt handling covers it, and with one endpoint there's nowhere to go.
+	if (!bIsReady || Endpoints.Num() < 2)
+	{
+		return;
+	}
+
+	UMixerInteractivityUserSettings* UserSettings = GetMutableDefault<UMixerInteractivityUserSettings>();
+	if (UserSettings->PreferredChatEndpoint == Endpoints[EndpointIndex])
+	{
+		UserSettings->PreferredChatEndpoint.Empty();
+		UserSettings->SaveConfigDeferred();
+	}
+
+	// Resumed just like an automatic reconnect, whether or not those are enabled, since we chose to leave.
+	EndpointIndex = (EndpointIndex + 1) % Endpoints.Num();
+	UE_LOG(LogMixerChat, Warning, TEXT("Chat connection for %s is degraded; failing over to %s."), *RoomId, *Endpoints[EndpointIndex]);
+	if (!bResumingSession)
+	{
+		RecordResumePoint();
+	}
+	bResumingSession = true;
+	CleanupConnection();
+	OpenWebSocket();
+}
+
 bool FMixerChatConnection::HandleWelcomeEvent(class FJsonObject* JsonObj)
 {
 	// Welcomed by the server.  We are now fully connected.
@@ -237,59 +451,229 @@ bool FMixerChatConnection::HandleWelcomeEvent(class FJsonObject* JsonObj)
 }
 
 
-bool FMixerChatConnection::HandleChatMessageEvent(FJsonObject* JsonObj)
+bool FMixerChatConnection::HandleChatMessageEvent(FMixerJsonCursor& Cursor)
 {
-	TSharedPtr<FChatMessageMixerImpl> ChatMessage;
-	bool bHandled = HandleChatMessageEventInternal(JsonObj, ChatMessage);
-
-	if (bHandled)
+	MIXER_LLM_SCOPE(ChatHistory);
+
+	// Decode straight from the frame into a pooled message - the body and its segments
+	// are built in place and the sender is attached once all fields have been seen.
+	TSharedPtr<FChatMessageMixerImpl> ChatMessage = AcquireChatMessage();
+	int32 FromUserIdRaw = 0;
+	int32 FromUserLevel = 0;
+	bool bHasUserId = false;
+	bool bHasUserLevel = false;
+	bool bHasUserName = false;
+	bool bHasId = false;
+	bool bHasMessage = false;
+	bool bIsWhisper = false;
+	bool bIsAction = false;
+	while (Cursor.NextField())
 	{
-		check(ChatMessage.IsValid());
-		if (ChatMessage->IsWhisper())
+		if (Cursor.IsField(MixerStringConstants::FieldNames::UserIdWithUnderscore))
 		{
-			UE_LOG(LogMixerChat, Verbose, TEXT("Private message from %s: %s"), *ChatMessage->GetNickname(), *ChatMessage->GetBody());
-			ChatInterface->TriggerOnChatPrivateMessageReceivedDelegates(*User, ChatMessage.ToSharedRef());
+			bHasUserId = Cursor.TryGetNumber(FromUserIdRaw);
 		}
-		else
+		else if (Cursor.IsField(MixerStringConstants::FieldNames::UserLevel))
 		{
-			UE_LOG(LogMixerChat, Verbose, TEXT("Chat message from %s in room %s: %s"), *ChatMessage->GetNickname(), *RoomId, *ChatMessage->GetBody());
-			AddMessageToChatHistory(ChatMessage.ToSharedRef());
-			ChatInterface->TriggerOnChatRoomMessageReceivedDelegates(*User, RoomId, ChatMessage.ToSharedRef());
+			bHasUserLevel = Cursor.TryGetNumber(FromUserLevel);
+		}
+		else if (Cursor.IsField(MixerStringConstants::FieldNames::UserNameWithUnderscore))
+		{
+			bHasUserName = Cursor.TryGetString(DecodeScratchUserName);
+		}
+		else if (Cursor.IsField(MixerStringConstants::FieldNames::Id))
+		{
+			bHasId = Cursor.TryGetString(DecodeScratchId);
+		}
+		else if (Cursor.IsField(MixerStringConstants::FieldNames::Message))
+		{
+			bHasMessage = Cursor.TryReadObject([this, &ChatMessage, &bIsWhisper, &bIsAction](FMixerJsonCursor& MessageCursor)
+			{
+				DecodeChatMessageObject(MessageCursor, *ChatMessage, bIsWhisper, bIsAction);
+			});
 		}
 	}
 
-	return bHandled;
-}
-
-bool FMixerChatConnection::HandleChatMessageEventInternal(FJsonObject* JsonObj, TSharedPtr<FChatMessageMixerImpl>& OutChatMessage)
-{
-	GET_JSON_INT_RETURN_FAILURE(UserIdWithUnderscore, FromUserIdRaw);
-	GET_JSON_OBJECT_RETURN_FAILURE(Message, MessageJson);
-	GET_JSON_STRING_RETURN_FAILURE(Id, IdString);
+	if (!bHasUserId || !bHasId || !bHasMessage)
+	{
+		UE_LOG(LogMixerChat, Error, TEXT("Missing required %s field in chat event payload"),
+			!bHasUserId ? *MixerStringConstants::FieldNames::UserIdWithUnderscore : !bHasId ? *MixerStringConstants::FieldNames::Id : *MixerStringConstants::FieldNames::Message);
+		ReleaseChatMessage(ChatMessage);
+		return false;
+	}
 
 	FGuid MessageGuid;
-	if (!FGuid::Parse(IdString, MessageGuid))
+	if (!FGuid::Parse(DecodeScratchId, MessageGuid))
 	{
-		UE_LOG(LogMixerChat, Error, TEXT("id field %s for chat event was not in the expected format (guid)"), *IdString);
+		UE_LOG(LogMixerChat, Error, TEXT("id field %s for chat event was not in the expected format (guid)"), *DecodeScratchId);
+		ReleaseChatMessage(ChatMessage);
 		return false;
 	}
 
+	TSharedPtr<FMixerChatUser> FromUser = ResolveChatMessageSender(FromUserIdRaw, bHasUserName ? &DecodeScratchUserName : nullptr, bHasUserLevel ? &FromUserLevel : nullptr);
+	if (!FromUser.IsValid())
+	{
+		ReleaseChatMessage(ChatMessage);
+		return false;
+	}
+
+	ChatMessage->FinishDecode(MessageGuid, FromUser.ToSharedRef());
+	if (BootstrapTimings.FirstMessage < 0.0f)
+	{
+		MarkBootstrapPhase(BootstrapTimings.FirstMessage, TEXT("first message"));
+		UE_LOG(LogMixerChat, Log, TEXT("Chat room %s first message after %.3fs (channel %.3fs, servers %.3fs, ranked %.3fs, connected %.3fs, authed %.3fs, history %.3fs)"),
+			*RoomId, BootstrapTimings.FirstMessage, BootstrapTimings.ChannelResolved, BootstrapTimings.ServersDiscovered, BootstrapTimings.EndpointsRanked,
+			BootstrapTimings.SocketConnected, BootstrapTimings.Authenticated, BootstrapTimings.HistoryReceived);
+	}
+	if (bIsWhisper)
+	{
+		ChatMessage->FlagAsWhisper();
+	}
+	if (bIsAction)
+	{
+		ChatMessage->FlagAsAction();
+	}
+
+	MIXER_CSV_COUNT(ChatMessages, 1);
+	if (ChatMessage->IsWhisper())
+	{
+		UE_LOG(LogMixerChat, Verbose, TEXT("Private message from %s: %s"), *ChatMessage->GetNickname(), *ChatMessage->GetBody());
+		ChatInterface->TriggerOnChatPrivateMessageReceivedDelegates(*User, ChatMessage.ToSharedRef());
+	}
+	else
+	{
+		UE_LOG(LogMixerChat, Verbose, TEXT("Chat message from %s in room %s: %s"), *ChatMessage->GetNickname(), *RoomId, *ChatMessage->GetBody());
+		AddMessageToChatHistory(ChatMessage.ToSharedRef());
+
+		// Listeners may leave the room, which would destroy us before triggers run.
+		TSharedRef<FMixerChatConnection> KeepAlive = AsShared();
+		ChatInterface->TriggerOnChatRoomMessageReceivedDelegates(*User, RoomId, ChatMessage.ToSharedRef());
+		ChatInterface->DispatchChatTriggers(RoomId, *ChatMessage);
+	}
+
+	return true;
+}
+
+void FMixerChatConnection::DecodeChatMessageObject(FMixerJsonCursor& Cursor, FChatMessageMixerImpl& ChatMessage, bool& bOutIsWhisper, bool& bOutIsAction)
+{
+	while (Cursor.NextField())
+	{
+		if (Cursor.IsField(MixerStringConstants::FieldNames::Message))
+		{
+			Cursor.TryReadObjectArray([this, &ChatMessage](FMixerJsonCursor& FragmentCursor)
+			{
+				// Text goes straight onto the end of the shared body; the type may come either side of it.
+				const int32 Start = ChatMessage.GetMutableBody().Len();
+				bool bHasText = false;
+				bool bHasCoords = false;
+				int32 TaggedUserId = 0;
+				FIntRect SourceRect;
+				DecodeScratchSegmentType.Reset();
+				DecodeScratchImageSource.Reset();
+				DecodeScratchImageUrl.Reset();
+				while (FragmentCursor.NextField())
+				{
+					if (FragmentCursor.IsField(MixerStringConstants::FieldNames::Text))
+					{
+						bHasText = FragmentCursor.TryAppendString(ChatMessage.GetMutableBody());
+					}
+					else if (FragmentCursor.IsField(MixerStringConstants::FieldNames::Type))
+					{
+						FragmentCursor.TryGetString(DecodeScratchSegmentType);
+					}
+					else if (FragmentCursor.IsField(MixerStringConstants::FieldNames::Source))
+					{
+						FragmentCursor.TryGetString(DecodeScratchImageSource);
+					}
+					else if (FragmentCursor.IsField(MixerStringConstants::FieldNames::Pack) || FragmentCursor.IsField(MixerStringConstants::FieldNames::Url))
+					{
+						FragmentCursor.TryGetString(DecodeScratchImageUrl);
+					}
+					else if (FragmentCursor.IsField(MixerStringConstants::FieldNames::Coords))
+					{
+						bHasCoords = DecodeEmoticonCoords(FragmentCursor, SourceRect);
+					}
+					else if (FragmentCursor.IsField(MixerStringConstants::FieldNames::Id))
+					{
+						FragmentCursor.TryGetNumber(TaggedUserId);
+					}
+				}
+
+				if (bHasText)
+				{
+					const EChatMessageSegmentMixer Type = ParseChatMessageSegmentType(DecodeScratchSegmentType);
+					int32 ImageIndex = INDEX_NONE;
+					const TCHAR* Target = nullptr;
+					if (!DecodeScratchImageUrl.IsEmpty())
+					{
+						if (Type == EChatMessageSegmentMixer::Emoticon && bHasCoords)
+						{
+							ImageIndex = ChatMessage.AddImage(GetEmoticonSheetUrl(DecodeScratchImageSource, DecodeScratchImageUrl), SourceRect);
+						}
+						else if (Type == EChatMessageSegmentMixer::Image)
+						{
+							ImageIndex = ChatMessage.AddImage(DecodeScratchImageUrl, FIntRect());
+						}
+						else if (Type == EChatMessageSegmentMixer::Link)
+						{
+							Target = *DecodeScratchImageUrl;
+						}
+					}
+					if (Type == EChatMessageSegmentMixer::Tag && TaggedUserId != 0)
+					{
+						DecodeScratchImageUrl = FString::FromInt(TaggedUserId);
+						Target = *DecodeScratchImageUrl;
+					}
+					ChatMessage.AddSegment(Type, Start, ImageIndex, Target);
+				}
+			});
+		}
+		else if (Cursor.IsField(MixerStringConstants::FieldNames::Meta))
+		{
+			Cursor.TryReadObject([&bOutIsWhisper, &bOutIsAction](FMixerJsonCursor& MetaCursor)
+			{
+				while (MetaCursor.NextField())
+				{
+					if (MetaCursor.IsField(MixerStringConstants::FieldNames::Whisper))
+					{
+						MetaCursor.TryGetBool(bOutIsWhisper);
+					}
+					else if (MetaCursor.IsField(MixerStringConstants::FieldNames::Me))
+					{
+						MetaCursor.TryGetBool(bOutIsAction);
+					}
+				}
+			});
+		}
+	}
+}
+
+TSharedPtr<FMixerChatUser> FMixerChatConnection::ResolveChatMessageSender(int32 FromUserIdRaw, const FString* FromUserName, const int32* FromUserLevel)
+{
 	FUniqueNetIdMixer FromNetIdLocal = FUniqueNetIdMixer(FromUserIdRaw);
-	TSharedPtr<FMixerChatUser>* FromUserObject = CachedUsers.Find(FromNetIdLocal);
+	TSharedPtr<FMixerChatUser>* FromUserObject = FindCachedUser(FromNetIdLocal);
 	bool bSendJoinEvent = false;
 	if (FromUserObject == nullptr)
 	{
-		GET_JSON_STRING_RETURN_FAILURE(UserNameWithUnderscore, FromUserName);
+		if (FromUserName == nullptr)
+		{
+			UE_LOG(LogMixerChat, Error, TEXT("Missing required %s field in json payload"), *MixerStringConstants::FieldNames::UserNameWithUnderscore);
+			return nullptr;
+		}
 
-		TSharedRef<FMixerChatUser> NewUser = MakeShared<FMixerChatUser>(FromUserName, FromUserIdRaw);
-		FromUserObject = &CachedUsers.Add(FromNetIdLocal, NewUser);
+		bool bWasEvicted = false;
+		FromUserObject = &AddCachedUser(*FromUserName, FromUserIdRaw, bWasEvicted);
 
-		// We haven't seen this user before - send a just-in-time join event,
+		// If we haven't seen this user before send a just-in-time join event,
 		// but wait until after we have resolved the user level
-		bSendJoinEvent = true;
+		bSendJoinEvent = !bWasEvicted;
 	}
 	check(FromUserObject);
-	if (!JsonObj->TryGetNumberField(MixerStringConstants::FieldNames::UserLevel, (*FromUserObject)->Level))
+	if (FromUserLevel != nullptr)
+	{
+		(*FromUserObject)->Level = *FromUserLevel;
+	}
+	else
 	{
 		// This one's less serious.
 		UE_LOG(LogMixerChat, Warning, TEXT("Missing user_level field for chat event"));
@@ -297,13 +681,173 @@ bool FMixerChatConnection::HandleChatMessageEventInternal(FJsonObject* JsonObj,
 
 	if (bSendJoinEvent)
 	{
-		UE_LOG(LogMixerChat, Log, TEXT("%s is joining %s's chat channel"), *(*FromUserObject)->Name, *RoomId);
+		NotifyMemberJoined(**FromUserObject);
+	}
+
+	return *FromUserObject;
+}
+
+TSharedPtr<FChatMessageMixerImpl> FMixerChatConnection::AcquireChatMessage()
+{
+	TSharedPtr<FChatMessageMixerImpl> ChatMessage;
+	if (ChatMessagePool.Num() > 0)
+	{
+		ChatMessage = ChatMessagePool.Pop(false);
+	}
+	else
+	{
+		ChatMessage = MakeShared<FChatMessageMixerImpl>();
+	}
+	return ChatMessage;
+}
+
+void FMixerChatConnection::ReleaseChatMessage(TSharedPtr<FChatMessageMixerImpl>& ChatMessage)
+{
+	// Only for messages that were never handed out.  Once delegate listeners or GetLastMessages callers
+	// have seen a message they may hold weak references, which IsUnique doesn't count, so published
+	// messages are just let go.
+	check(ChatMessage.IsUnique());
+	if (ChatMessagePool.Num() < MaxPooledChatMessages)
+	{
+		// Drop the sender now so that pooled messages don't keep evicted users alive
+		ChatMessage->ResetForDecode();
+		ChatMessagePool.Add(ChatMessage);
+	}
+	ChatMessage.Reset();
+}
+
+namespace
+{
+	struct FChatMessageEvent
+	{
+		FString FromUserName;
+		TSharedPtr<FJsonObject> Message;
+		FGuid Id;
+		int32 FromUserId;
+		int32 FromUserLevel;
+
+		FChatMessageEvent()
+			: FromUserId(0)
+			, FromUserLevel(INDEX_NONE)
+		{
+		}
+
+		BEGIN_MIXER_JSON_SCHEMA(FChatMessageEvent, TEXT("ChatMessage"))
+			MIXER_JSON_REQUIRED(UserIdWithUnderscore, FromUserId)
+			MIXER_JSON_REQUIRED(Message, Message)
+			MIXER_JSON_REQUIRED(Id, Id)
+			MIXER_JSON_OPTIONAL(UserNameWithUnderscore, FromUserName)
+			MIXER_JSON_OPTIONAL(UserLevel, FromUserLevel)
+		END_MIXER_JSON_SCHEMA()
+	};
+
+	struct FChatMessageFragment
+	{
+		FString Type;
+		FString Text;
+		FString Source;
+		FString Pack;
+		FString Url;
+		TSharedPtr<FJsonObject> Coords;
+		int32 Id;
+
+		FChatMessageFragment()
+			: Id(0)
+		{
+		}
+
+		BEGIN_MIXER_JSON_SCHEMA(FChatMessageFragment, TEXT("chat message fragment"))
+			MIXER_JSON_REQUIRED(Type, Type)
+			MIXER_JSON_REQUIRED(Text, Text)
+			MIXER_JSON_OPTIONAL(Source, Source)
+			MIXER_JSON_OPTIONAL(Pack, Pack)
+			MIXER_JSON_OPTIONAL(Url, Url)
+			MIXER_JSON_OPTIONAL(Coords, Coords)
+			MIXER_JSON_OPTIONAL(Id, Id)
+		END_MIXER_JSON_SCHEMA()
+	};
+
+	struct FEmoticonCoords
+	{
+		int32 X;
+		int32 Y;
+		int32 Width;
+		int32 Height;
+
+		FEmoticonCoords()
+			: X(0)
+			, Y(0)
+			, Width(0)
+			, Height(0)
+		{
+		}
+
+		BEGIN_MIXER_JSON_SCHEMA(FEmoticonCoords, TEXT("emoticon coords"))
+			MIXER_JSON_REQUIRED(X, X)
+			MIXER_JSON_REQUIRED(Y, Y)
+			MIXER_JSON_REQUIRED(Width, Width)
+			MIXER_JSON_REQUIRED(Height, Height)
+		END_MIXER_JSON_SCHEMA()
+	};
+
+	struct FPollEvent
+	{
+		const TArray<TSharedPtr<FJsonValue>>* ResponsesByIndex;
+		double EndsAt;
+
+		FPollEvent()
+			: ResponsesByIndex(nullptr)
+			, EndsAt(0.0)
+		{
+		}
+
+		// A poll event without tallies still moves the poll along, so they're checked separately
+		BEGIN_MIXER_JSON_SCHEMA(FPollEvent, TEXT("poll"))
+			MIXER_JSON_REQUIRED(EndsAt, EndsAt)
+			MIXER_JSON_OPTIONAL(ResponsesByIndex, ResponsesByIndex)
+		END_MIXER_JSON_SCHEMA()
+	};
+
+	/** The parts of a PollStart event only needed when the poll is new to us. */
+	struct FNewPollDetails
+	{
+		FString Question;
+		TSharedPtr<FJsonObject> Author;
+		const TArray<TSharedPtr<FJsonValue>>* Answers;
+
+		FNewPollDetails()
+			: Answers(nullptr)
+		{
+		}
+
+		BEGIN_MIXER_JSON_SCHEMA(FNewPollDetails, TEXT("PollStart"))
+			MIXER_JSON_REQUIRED(Q, Question)
+			MIXER_JSON_REQUIRED(Author, Author)
+			MIXER_JSON_REQUIRED(Answers, Answers)
+		END_MIXER_JSON_SCHEMA()
+	};
+}
 
-		ChatInterface->TriggerOnChatRoomMemberJoinDelegates(*User, RoomId, (*FromUserObject)->GetUniqueNetId());
+bool FMixerChatConnection::HandleChatMessageEventInternal(FJsonObject* JsonObj, TSharedPtr<FChatMessageMixerImpl>& OutChatMessage)
+{
+	FChatMessageEvent Event;
+	if (!Event.Decode(*JsonObj))
+	{
+		return false;
+	}
+
+	// Usernames are never empty, and levels never negative, so the defaults stand for absent fields
+	TSharedPtr<FMixerChatUser> FromUser = ResolveChatMessageSender(Event.FromUserId,
+		!Event.FromUserName.IsEmpty() ? &Event.FromUserName : nullptr,
+		Event.FromUserLevel != INDEX_NONE ? &Event.FromUserLevel : nullptr);
+	if (!FromUser.IsValid())
+	{
+		return false;
 	}
 
-	OutChatMessage = MakeShared<FChatMessageMixerImpl>(MessageGuid, FromUserObject->ToSharedRef());
-	return HandleChatMessageEventMessageObject(MessageJson->Get(), OutChatMessage.Get());
+	OutChatMessage = AcquireChatMessage();
+	OutChatMessage->FinishDecode(Event.Id, FromUser.ToSharedRef());
+	return HandleChatMessageEventMessageObject(Event.Message.Get(), OutChatMessage.Get());
 }
 
 bool FMixerChatConnection::HandleChatMessageEventMessageObject(FJsonObject* JsonObj, FChatMessageMixerImpl* ChatMessage)
@@ -344,41 +888,133 @@ bool FMixerChatConnection::HandleChatMessageEventMessageObject(FJsonObject* Json
 
 bool FMixerChatConnection::HandleChatMessageEventMessageArrayEntry(FJsonObject* JsonObj, FChatMessageMixerImpl* ChatMessage)
 {
-	GET_JSON_STRING_RETURN_FAILURE(Type, FragmentType);
-	GET_JSON_STRING_RETURN_FAILURE(Text, FragmentText);
+	FChatMessageFragment Fragment;
+	if (!Fragment.Decode(*JsonObj))
+	{
+		return false;
+	}
+
+	// The body is the concatenation of all fragments, with segments recording where each came from.
+	const EChatMessageSegmentMixer Type = ParseChatMessageSegmentType(Fragment.Type);
+	int32 ImageIndex = INDEX_NONE;
+	if (Type == EChatMessageSegmentMixer::Emoticon && !Fragment.Pack.IsEmpty())
+	{
+		FEmoticonCoords Coords;
+		if (Fragment.Coords.IsValid() && Coords.Decode(*Fragment.Coords) && Coords.Width > 0 && Coords.Height > 0)
+		{
+			ImageIndex = ChatMessage->AddImage(GetEmoticonSheetUrl(Fragment.Source, Fragment.Pack), FIntRect(Coords.X, Coords.Y, Coords.X + Coords.Width, Coords.Y + Coords.Height));
+		}
+	}
+	else if (Type == EChatMessageSegmentMixer::Image && !Fragment.Url.IsEmpty())
+	{
+		ImageIndex = ChatMessage->AddImage(Fragment.Url, FIntRect());
+	}
 
-	// For now just always append the fragment text no matter the type.
-	// In the future we could perhaps add markup?
-	ChatMessage->AppendBodyFragment(FragmentText);
+	// Links and mentions carry their target into the rich text
+	FString Target;
+	if (Type == EChatMessageSegmentMixer::Link)
+	{
+		Target = Fragment.Url;
+	}
+	else if (Type == EChatMessageSegmentMixer::Tag && Fragment.Id != 0)
+	{
+		Target = FString::FromInt(Fragment.Id);
+	}
+	ChatMessage->AppendBodyFragment(Fragment.Text, Type, ImageIndex, *Target);
 	return true;
 }
 
-bool FMixerChatConnection::HandleUserJoinEvent(FJsonObject* JsonObj)
+bool FMixerChatConnection::HandleUserJoinEvent(FMixerJsonCursor& Cursor)
+{
+	int32 JoiningUserIdRaw = 0;
+	FString JoiningUserName;
+	bool bHasId = false;
+	while (Cursor.NextField())
+	{
+		if (Cursor.IsField(MixerStringConstants::FieldNames::Id))
+		{
+			bHasId = Cursor.TryGetNumber(JoiningUserIdRaw);
+		}
+		else if (Cursor.IsField(MixerStringConstants::FieldNames::UserNameNoUnderscore))
+		{
+			Cursor.TryGetString(JoiningUserName);
+		}
+	}
+
+	if (!bHasId)
+	{
+		UE_LOG(LogMixerInteractivity, Error, TEXT("Missing required %s field in json payload"), *MixerStringConstants::FieldNames::Id);
+		return false;
+	}
+
+	if (MembershipCoalesceWindow > 0.0f)
+	{
+		QueueMembershipChange(JoiningUserIdRaw, JoiningUserName, true);
+		return true;
+	}
+
+	return ApplyUserJoin(JoiningUserIdRaw, JoiningUserName);
+}
+
+bool FMixerChatConnection::HandleUserLeaveEvent(FMixerJsonCursor& Cursor)
 {
-	GET_JSON_INT_RETURN_FAILURE(Id, JoiningUserIdRaw);
+	int32 LeavingUserIdRaw = 0;
+	bool bHasId = false;
+	while (Cursor.NextField())
+	{
+		if (Cursor.IsField(MixerStringConstants::FieldNames::Id))
+		{
+			bHasId = Cursor.TryGetNumber(LeavingUserIdRaw);
+		}
+	}
+
+	if (!bHasId)
+	{
+		UE_LOG(LogMixerInteractivity, Error, TEXT("Missing required %s field in json payload"), *MixerStringConstants::FieldNames::Id);
+		return false;
+	}
 
+	if (MembershipCoalesceWindow > 0.0f)
+	{
+		QueueMembershipChange(LeavingUserIdRaw, FString(), false);
+		return true;
+	}
+
+	ApplyUserLeave(LeavingUserIdRaw);
+	return true;
+}
+
+bool FMixerChatConnection::ApplyUserJoin(int32 JoiningUserIdRaw, const FString& JoiningUserName)
+{
 	FUniqueNetIdMixer JoiningNetId = FUniqueNetIdMixer(JoiningUserIdRaw);
-	TSharedPtr<FMixerChatUser>* CachedUser = CachedUsers.Find(JoiningNetId);
+	TSharedPtr<FMixerChatUser>* CachedUser = FindCachedUser(JoiningNetId);
 
 	// If the user was already in the cache then we triggered a join event at the
 	// point of addition (presumably a chat message reached us before join?).  Don't
 	// send another.
 	if (CachedUser == nullptr)
 	{
-		GET_JSON_STRING_RETURN_FAILURE(UserNameNoUnderscore, JoiningUserName);
-		CachedUser = &CachedUsers.Add(JoiningNetId, MakeShared<FMixerChatUser>(JoiningUserName, JoiningUserIdRaw));
+		if (JoiningUserName.IsEmpty())
+		{
+			UE_LOG(LogMixerInteractivity, Error, TEXT("Missing required %s field in json payload"), *MixerStringConstants::FieldNames::UserNameNoUnderscore);
+			return false;
+		}
+
+		bool bWasEvicted = false;
+		CachedUser = &AddCachedUser(JoiningUserName, JoiningUserIdRaw, bWasEvicted);
+		if (bWasEvicted)
+		{
+			return true;
+		}
 
-		UE_LOG(LogMixerChat, Log, TEXT("%s is joining %s's chat channel"), *(*CachedUser)->Name, *RoomId);
-		ChatInterface->TriggerOnChatRoomMemberJoinDelegates(*User, RoomId, (*CachedUser)->GetUniqueNetId());
+		NotifyMemberJoined(**CachedUser);
 	}
 
 	return true;
 }
 
-bool FMixerChatConnection::HandleUserLeaveEvent(FJsonObject* JsonObj)
+void FMixerChatConnection::ApplyUserLeave(int32 LeavingUserIdRaw)
 {
-	GET_JSON_INT_RETURN_FAILURE(Id, LeavingUserIdRaw);
-
 	FUniqueNetIdMixer LeavingNetId = FUniqueNetIdMixer(LeavingUserIdRaw);
 	TSharedPtr<FMixerChatUser> LeavingUser;
 
@@ -386,17 +1022,115 @@ bool FMixerChatConnection::HandleUserLeaveEvent(FJsonObject* JsonObj)
 	// case we shouldn't trigger leave either.
 	if (CachedUsers.RemoveAndCopyValue(LeavingNetId, LeavingUser))
 	{
-		UE_LOG(LogMixerChat, Log, TEXT("%s is exiting %s's chat channel"), *LeavingUser->Name, *RoomId);
+		DEC_DWORD_STAT(STAT_MixerChatCachedUsers);
+	}
+	else if (EvictedUserIds.Remove(LeavingUserIdRaw) > 0)
+	{
+		LeavingUser = FindEvictedUser(LeavingUserIdRaw);
+		if (!LeavingUser.IsValid())
+		{
+			LeavingUser = MakeShared<FMixerChatUser>(FString(), LeavingUserIdRaw);
+		}
+	}
 
-		ChatInterface->TriggerOnChatRoomMemberExitDelegates(*User, RoomId, LeavingUser->GetUniqueNetId());
+	if (LeavingUser.IsValid())
+	{
+		NotifyMemberExited(*LeavingUser);
 	}
+}
 
-	return true;
+void FMixerChatConnection::QueueMembershipChange(int32 UserIdRaw, const FString& UserName, bool bJoined)
+{
+	if (PendingMembershipChanges.Num() == 0)
+	{
+		MembershipWindowStartTime = FPlatformTime::Seconds();
+	}
+
+	// Only the last event in the window matters.  Applied against the cache at the end of it, a join
+	// followed by a leave of an unseen user, or a leave and rejoin of a known one, comes to nothing.
+	FPendingMembershipChange& Change = PendingMembershipChanges.FindOrAdd(UserIdRaw);
+	Change.bJoined = bJoined;
+	if (bJoined)
+	{
+		Change.UserName = UserName;
+	}
+}
+
+void FMixerChatConnection::GetContainerSizes(TFunctionRef<void(const TCHAR* Name, int64 Size)> Visit) const
+{
+	Visit(TEXT("Chat.CachedUsers"), CachedUsers.Num());
+	Visit(TEXT("Chat.EvictedUsers"), EvictedUserIds.Num());
+	Visit(TEXT("Chat.History"), ChatHistory.Num());
+	Visit(TEXT("Chat.HistoryById"), ChatHistorySlotsById.Num());
+	Visit(TEXT("Chat.HistoryBySender"), ChatHistorySlotsBySender.Num());
+	Visit(TEXT("Chat.OutboundQueue"), OutboundQueue.Num());
+	Visit(TEXT("Chat.PendingMembershipChanges"), PendingMembershipChanges.Num());
+	Visit(TEXT("Replies.Chat"), GetNumPendingReplies());
+}
+
+void FMixerChatConnection::TickMembershipChanges()
+{
+	if (PendingMembershipChanges.Num() > 0 && FPlatformTime::Seconds() - MembershipWindowStartTime >= MembershipCoalesceWindow)
+	{
+		TMap<int32, FPendingMembershipChange> Changes = MoveTemp(PendingMembershipChanges);
+		PendingMembershipChanges.Reset();
+		for (const TPair<int32, FPendingMembershipChange>& Change : Changes)
+		{
+			if (Change.Value.bJoined)
+			{
+				ApplyUserJoin(Change.Key, Change.Value.UserName);
+			}
+			else
+			{
+				ApplyUserLeave(Change.Key);
+			}
+		}
+	}
+
+	if (BatchedJoinedMembers.Num() > 0 || BatchedExitedMembers.Num() > 0)
+	{
+		TArray<TSharedRef<const FUniqueNetId>> Joined = MoveTemp(BatchedJoinedMembers);
+		TArray<TSharedRef<const FUniqueNetId>> Exited = MoveTemp(BatchedExitedMembers);
+		BatchedJoinedMembers.Reset();
+		BatchedExitedMembers.Reset();
+
+		// Listeners may leave the room, which would destroy us before the trigger returns.
+		TSharedRef<FMixerChatConnection> KeepAlive = AsShared();
+		ChatInterface->TriggerOnChatRoomMembersChangedDelegates(*User, RoomId, Joined, Exited);
+	}
 }
 
-bool FMixerChatConnection::HandleDeleteMessageEvent(FJsonObject* JsonObj)
+void FMixerChatConnection::NotifyMemberJoined(const FMixerChatUser& JoiningUser)
 {
-	GET_JSON_STRING_RETURN_FAILURE(Id, IdString);
+	UE_LOG(LogMixerChat, Log, TEXT("%s is joining %s's chat channel"), *JoiningUser.Name, *RoomId);
+	BatchedJoinedMembers.Add(JoiningUser.GetUserId());
+	ChatInterface->TriggerOnChatRoomMemberJoinDelegates(*User, RoomId, JoiningUser.GetUniqueNetId());
+}
+
+void FMixerChatConnection::NotifyMemberExited(const FMixerChatUser& LeavingUser)
+{
+	UE_LOG(LogMixerChat, Log, TEXT("%s is exiting %s's chat channel"), *LeavingUser.Name, *RoomId);
+	BatchedExitedMembers.Add(LeavingUser.GetUserId());
+	ChatInterface->TriggerOnChatRoomMemberExitDelegates(*User, RoomId, LeavingUser.GetUniqueNetId());
+}
+
+bool FMixerChatConnection::HandleDeleteMessageEvent(FMixerJsonCursor& Cursor)
+{
+	FString IdString;
+	bool bHasId = false;
+	while (Cursor.NextField())
+	{
+		if (Cursor.IsField(MixerStringConstants::FieldNames::Id))
+		{
+			bHasId = Cursor.TryGetString(IdString);
+		}
+	}
+
+	if (!bHasId)
+	{
+		UE_LOG(LogMixerInteractivity, Error, TEXT("Missing required %s field in json payload"), *MixerStringConstants::FieldNames::Id);
+		return false;
+	}
 
 	FGuid MessageGuid;
 	if (!FGuid::Parse(IdString, MessageGuid))
@@ -405,38 +1139,41 @@ bool FMixerChatConnection::HandleDeleteMessageEvent(FJsonObject* JsonObj)
 		return false;
 	}
 
-	DeleteFromChatHistoryIf([&MessageGuid](TSharedPtr<FChatMessageMixerImpl> ChatMessage)
-	{
-		return ChatMessage->GetMessageId() == MessageGuid;
-	});
+	DeleteChatHistoryMessage(MessageGuid);
 
 	return true;
 }
 
 bool FMixerChatConnection::HandleClearMessagesEvent(FJsonObject* JsonObj)
 {
-	DeleteFromChatHistoryIf([](TSharedPtr<FChatMessageMixerImpl>)
-	{
-		return true;
-	});
+	ClearChatHistory(true);
 
 	check(ChatHistoryNum == 0);
-	check(!ChatHistoryNewest.IsValid());
-	check(!ChatHistoryOldest.IsValid());
 
 	ChatInterface->TriggerOnChatRoomMessagesClearedDelegates(*User, RoomId);
 
 	return true;
 }
 
-bool FMixerChatConnection::HandlePurgeMessageEvent(FJsonObject* JsonObj)
+bool FMixerChatConnection::HandlePurgeMessageEvent(FMixerJsonCursor& Cursor)
 {
-	GET_JSON_INT_RETURN_FAILURE(UserIdWithUnderscore, UserId);
+	int32 UserId = 0;
+	bool bHasUserId = false;
+	while (Cursor.NextField())
+	{
+		if (Cursor.IsField(MixerStringConstants::FieldNames::UserIdWithUnderscore))
+		{
+			bHasUserId = Cursor.TryGetNumber(UserId);
+		}
+	}
 
-	DeleteFromChatHistoryIf([UserId](TSharedPtr<FChatMessageMixerImpl> ChatMessage)
+	if (!bHasUserId)
 	{
-		return ChatMessage->GetSender().Id == UserId;
-	});
+		UE_LOG(LogMixerInteractivity, Error, TEXT("Missing required %s field in json payload"), *MixerStringConstants::FieldNames::UserIdWithUnderscore);
+		return false;
+	}
+
+	DeleteChatHistoryMessagesFromSender(UserId);
 
 	ChatInterface->TriggerOnChatRoomUserPurgedDelegates(*User, RoomId, FUniqueNetIdMixer(UserId));
 
@@ -445,10 +1182,14 @@ bool FMixerChatConnection::HandlePurgeMessageEvent(FJsonObject* JsonObj)
 
 bool FMixerChatConnection::HandlePollStartEvent(FJsonObject* JsonObj)
 {
-	GET_JSON_DOUBLE_RETURN_FAILURE(EndsAt, EndsAtDouble);
+	FPollEvent Event;
+	if (!Event.Decode(*JsonObj))
+	{
+		return false;
+	}
 
 	// EndsAt is reported in ms since January 1 1970
-	FDateTime EndsAt = FDateTime::FromUnixTimestamp(static_cast<int64>(EndsAtDouble / 1000.0));
+	FDateTime EndsAt = FDateTime::FromUnixTimestamp(static_cast<int64>(Event.EndsAt / 1000.0));
 
 	bool bIsNewPoll = false;
 	if (ActivePoll.IsValid())
@@ -462,57 +1203,67 @@ bool FMixerChatConnection::HandlePollStartEvent(FJsonObject* JsonObj)
 	}
 	else
 	{
-		GET_JSON_STRING_RETURN_FAILURE(Q, Question);
-		GET_JSON_OBJECT_RETURN_FAILURE(Author, Author);
-		GET_JSON_ARRAY_RETURN_FAILURE(Answers, Answers);
+		FNewPollDetails Details;
+		if (!Details.Decode(*JsonObj))
+		{
+			return false;
+		}
+
+		const TSharedPtr<FJsonObject>& Author = Details.Author;
+		const TArray<TSharedPtr<FJsonValue>>& Answers = *Details.Answers;
 
 		int32 AskingUserIdRaw;
-		if (!(*Author)->TryGetNumberField(MixerStringConstants::FieldNames::UserIdWithUnderscore, AskingUserIdRaw))
+		if (!Author->TryGetNumberField(MixerStringConstants::FieldNames::UserIdWithUnderscore, AskingUserIdRaw))
 		{
 			UE_LOG(LogMixerChat, Error, TEXT("Missing required %s field in json payload"), *MixerStringConstants::FieldNames::UserIdWithUnderscore);
 			return false;
 		}
 
 		FUniqueNetIdMixer AskingUserId = FUniqueNetIdMixer(AskingUserIdRaw);
-		TSharedPtr<FMixerChatUser>* CachedUser = CachedUsers.Find(AskingUserId);
+		TSharedPtr<FMixerChatUser>* CachedUser = FindCachedUser(AskingUserId);
 
 		// If the user is not already in the cache then we'll inject a join event.
 		if (CachedUser == nullptr)
 		{
 			FString AskingUsername;
-			if (!(*Author)->TryGetStringField(MixerStringConstants::FieldNames::UserNameWithUnderscore, AskingUsername))
+			if (!Author->TryGetStringField(MixerStringConstants::FieldNames::UserNameWithUnderscore, AskingUsername))
 			{
 				UE_LOG(LogMixerChat, Error, TEXT("Missing required %s field in json payload"), *MixerStringConstants::FieldNames::UserNameWithUnderscore);
 				return false;
 			}
-			CachedUser = &CachedUsers.Add(AskingUserId, MakeShared<FMixerChatUser>(AskingUsername, AskingUserIdRaw));
 
-			UE_LOG(LogMixerChat, Log, TEXT("%s is joining %s's chat channel"), *(*CachedUser)->Name, *RoomId);
-			ChatInterface->TriggerOnChatRoomMemberJoinDelegates(*User, RoomId, (*CachedUser)->GetUniqueNetId());
+			bool bWasEvicted = false;
+			CachedUser = &AddCachedUser(AskingUsername, AskingUserIdRaw, bWasEvicted);
+			if (!bWasEvicted)
+			{
+				NotifyMemberJoined(**CachedUser);
+			}
 		}
 
-		(*Author)->TryGetNumberField(MixerStringConstants::FieldNames::UserLevel, (*CachedUser)->Level);
+		Author->TryGetNumberField(MixerStringConstants::FieldNames::UserLevel, (*CachedUser)->Level);
 
-		ActivePoll = MakeShared<FChatPollMixerImpl>(CachedUser->ToSharedRef(), Question, EndsAt);
+		ActivePoll = MakeShared<FChatPollMixerImpl>(CachedUser->ToSharedRef(), Details.Question, EndsAt);
 		bIsNewPoll = true;
 
-		ActivePoll->Answers.SetNum(Answers->Num());
-		for (int32 i = 0; i < Answers->Num(); ++i)
+		ActivePoll->AnswerNames.SetNum(Answers.Num());
+		ActivePoll->Tallies.SetNumZeroed(Answers.Num());
+		for (int32 i = 0; i < Answers.Num(); ++i)
 		{
-			(*Answers)[i]->TryGetString(ActivePoll->Answers[i].Name);
-			ActivePoll->Answers[i].Voters = 0;
+			Answers[i]->TryGetString(ActivePoll->AnswerNames[i]);
 		}
 	}
 
 	bool bAnythingChanged = false;
-	UpdateActivePollFromServer(JsonObj, bAnythingChanged);
+	UpdateActivePollFromServer(Event.ResponsesByIndex, bAnythingChanged);
 
 	if (bIsNewPoll)
 	{
+		PollTallyDeltas.Reset();
 		ChatInterface->TriggerOnChatRoomPollStartDelegates(*User, RoomId, ActivePoll.ToSharedRef());
 	}
 	else if (bAnythingChanged)
 	{
+		TriggerPollAnswerUpdates();
 		ChatInterface->TriggerOnChatRoomPollUpdateDelegates(*User, RoomId, ActivePoll.ToSharedRef());
 	}
 	else
@@ -548,10 +1299,14 @@ bool FMixerChatConnection::HandlePollEndEvent(FJsonObject* JsonObj)
 
 bool FMixerChatConnection::HandlePollEndEventInternal(FJsonObject* JsonObj)
 {
-	GET_JSON_DOUBLE_RETURN_FAILURE(EndsAt, EndsAtDouble);
+	FPollEvent Event;
+	if (!Event.Decode(*JsonObj))
+	{
+		return false;
+	}
 
 	// EndsAt is reported in ms since January 1 1970
-	FDateTime EndsAt = FDateTime::FromUnixTimestamp(static_cast<int64>(EndsAtDouble / 1000.0));
+	FDateTime EndsAt = FDateTime::FromUnixTimestamp(static_cast<int64>(Event.EndsAt / 1000.0));
 
 	// Sanity check that this message matches the ongoing poll in this channel.
 	if (ActivePoll->GetEndTime() != EndsAt)
@@ -561,33 +1316,54 @@ bool FMixerChatConnection::HandlePollEndEventInternal(FJsonObject* JsonObj)
 	}
 
 	bool bAnythingChanged = false;
-	return UpdateActivePollFromServer(JsonObj, bAnythingChanged);
+	const bool bUpdated = UpdateActivePollFromServer(Event.ResponsesByIndex, bAnythingChanged);
+	if (bAnythingChanged)
+	{
+		TriggerPollAnswerUpdates();
+	}
+	return bUpdated;
+}
+
+void FMixerChatConnection::TriggerPollAnswerUpdates()
+{
+	TSharedRef<FChatPollMixer> Poll = ActivePoll.ToSharedRef();
+	for (const FPollTallyDelta& Delta : PollTallyDeltas)
+	{
+		ChatInterface->TriggerOnChatRoomPollAnswerUpdateDelegates(*User, RoomId, Poll, Delta.AnswerIndex, Delta.Delta);
+	}
+	PollTallyDeltas.Reset();
 }
 
 
-bool FMixerChatConnection::UpdateActivePollFromServer(FJsonObject* JsonObj, bool& bOutAnythingChanged)
+bool FMixerChatConnection::UpdateActivePollFromServer(const TArray<TSharedPtr<FJsonValue>>* Responses, bool& bOutAnythingChanged)
 {
-	GET_JSON_ARRAY_RETURN_FAILURE(ResponsesByIndex, Responses);
+	if (Responses == nullptr)
+	{
+		UE_LOG(LogMixerChat, Error, TEXT("Missing required %s field in json payload"), *MixerStringConstants::FieldNames::ResponsesByIndex);
+		return false;
+	}
 
-	if (ActivePoll->Answers.Num() != Responses->Num())
+	if (ActivePoll->Tallies.Num() != Responses->Num())
 	{
-		UE_LOG(LogMixerChat, Error, TEXT("Unexpected change to number of possible answers for poll after creation (old value: %d, new value %d)"), ActivePoll->Answers.Num(), Responses->Num());
+		UE_LOG(LogMixerChat, Error, TEXT("Unexpected change to number of possible answers for poll after creation (old value: %d, new value %d)"), ActivePoll->Tallies.Num(), Responses->Num());
 		return false;
 	}
 
-	bOutAnythingChanged = false;
+	// Record only the answers that moved, so that listeners can update just those.
+	PollTallyDeltas.Reset();
+	int32* Tallies = ActivePoll->Tallies.GetData();
 	for (int32 i = 0; i < Responses->Num(); ++i)
 	{
 		int32 NewVoteCount;
-		if ((*Responses)[i]->TryGetNumber(NewVoteCount))
+		if ((*Responses)[i]->TryGetNumber(NewVoteCount) && NewVoteCount != Tallies[i])
 		{
-			if (NewVoteCount != ActivePoll->Answers[i].Voters)
-			{
-				ActivePoll->Answers[i].Voters = NewVoteCount;
-				bOutAnythingChanged = true;
-			}
+			FPollTallyDelta& Delta = PollTallyDeltas[PollTallyDeltas.AddUninitialized()];
+			Delta.AnswerIndex = i;
+			Delta.Delta = NewVoteCount - Tallies[i];
+			Tallies[i] = NewVoteCount;
 		}
 	}
+	bOutAnythingChanged = PollTallyDeltas.Num() > 0;
 
 	return true;
 }
@@ -612,9 +1388,7 @@ bool FMixerChatConnection::SendChatMessage(const FString& MessageBody)
 		return false;
 	}
 
-	SendMethodMessageArrayParams(MixerStringConstants::MethodNames::Msg, nullptr, MessageBody);
-
-	return true;
+	return EnqueueOutboundSend(EOutboundChatKind::Message, MessageBody, FString(), nullptr, 0.0);
 }
 
 bool FMixerChatConnection::SendWhisper(const FString& ToUser, const FString& MessageBody)
@@ -637,9 +1411,7 @@ bool FMixerChatConnection::SendWhisper(const FString& ToUser, const FString& Mes
 		return false;
 	}
 
-	SendMethodMessageArrayParams(MixerStringConstants::MethodNames::Whisper, nullptr, ToUser, MessageBody);
-
-	return true;
+	return EnqueueOutboundSend(EOutboundChatKind::Whisper, MessageBody, ToUser, nullptr, 0.0);
 }
 
 bool FMixerChatConnection::SendVoteStart(const FString& Question, const TArray<FString>& Answers, FTimespan Duration)
@@ -662,9 +1434,7 @@ bool FMixerChatConnection::SendVoteStart(const FString& Question, const TArray<F
 		return false;
 	}
 
-	SendMethodMessageArrayParams(MixerStringConstants::MethodNames::VoteStart, nullptr, Question, Answers, Duration.GetTotalSeconds());
-
-	return true;
+	return EnqueueOutboundSend(EOutboundChatKind::VoteStart, Question, FString(), &Answers, Duration.GetTotalSeconds());
 }
 
 bool FMixerChatConnection::SendVoteChoose(const FChatPollMixer& Poll, int32 AnswerIndex)
@@ -698,90 +1468,276 @@ bool FMixerChatConnection::SendVoteChoose(const FChatPollMixer& Poll, int32 Answ
 	return true;
 }
 
+bool FMixerChatConnection::EnqueueOutboundSend(EOutboundChatKind Kind, const FString& Body, const FString& Target, const TArray<FString>* Answers, double Duration)
+{
+	const UMixerInteractivitySettings* Settings = GetDefault<UMixerInteractivitySettings>();
+	const uint32 Hash = HashOutboundSend(Kind, Body, Target);
+	if (Settings->bQueueOutboundChat)
+	{
+		const int32* NumWithHash = OutboundQueueHashes.Find(Hash);
+		if (NumWithHash != nullptr)
+		{
+			for (const FOutboundChatSend& Pending : OutboundQueue)
+			{
+				if (Pending.Hash == Hash && Pending.Kind == Kind && Pending.Body == Body && Pending.Target == Target
+					&& (Answers == nullptr || Pending.Answers == *Answers))
+				{
+					// An identical send is already waiting - one copy is all the room needs to see.
+					INC_DWORD_STAT(STAT_MixerChatCoalescedSends);
+					return true;
+				}
+			}
+		}
+
+		if (OutboundQueue.Num() >= FMath::Max(Settings->MaxQueuedChatSends, 1))
+		{
+			UE_LOG(LogMixerChat, Warning, TEXT("Outbound chat queue for room %s is full (%d sends).  Dropping send."), *RoomId, OutboundQueue.Num());
+			INC_DWORD_STAT(STAT_MixerChatRejectedSends);
+			return false;
+		}
+	}
+
+	FOutboundChatSend& Send = OutboundQueue[OutboundQueue.AddDefaulted()];
+	Send.Kind = Kind;
+	Send.Body = Body;
+	Send.Target = Target;
+	if (Answers != nullptr)
+	{
+		Send.Answers = *Answers;
+	}
+	Send.Duration = Duration;
+	Send.EnqueueTime = FPlatformTime::Seconds();
+	Send.Hash = Hash;
+	++OutboundQueueHashes.FindOrAdd(Hash);
+	INC_DWORD_STAT(STAT_MixerChatQueuedSends);
+
+	// Don't add a tick of latency when the limit isn't biting.
+	TickOutboundQueue();
+	return true;
+}
+
+void FMixerChatConnection::TickOutboundQueue()
+{
+	if (OutboundQueue.Num() == 0 || !bIsReady)
+	{
+		return;
+	}
+
+	const UMixerInteractivitySettings* Settings = GetDefault<UMixerInteractivitySettings>();
+	const double TimeNow = FPlatformTime::Seconds();
+	const float Burst = static_cast<float>(FMath::Max(Settings->ChatSendBurst, 1));
+	OutboundTokens = FMath::Min(Burst, OutboundTokens + static_cast<float>(TimeNow - OutboundLastRefillTime) * FMath::Max(Settings->ChatSendsPerSecond, 0.1f));
+	OutboundLastRefillTime = TimeNow;
+
+	int32 NumSent = 0;
+	while (NumSent < OutboundQueue.Num() && (!Settings->bQueueOutboundChat || OutboundTokens >= 1.0f))
+	{
+		const FOutboundChatSend& Send = OutboundQueue[NumSent];
+		SendOutbound(Send);
+		LastOutboundSendLatency = static_cast<float>(TimeNow - Send.EnqueueTime);
+
+		int32& NumWithHash = OutboundQueueHashes.FindChecked(Send.Hash);
+		if (--NumWithHash == 0)
+		{
+			OutboundQueueHashes.Remove(Send.Hash);
+		}
+
+		OutboundTokens = FMath::Max(0.0f, OutboundTokens - 1.0f);
+		++NumSent;
+	}
+
+	if (NumSent > 0)
+	{
+		OutboundQueue.RemoveAt(0, NumSent, false);
+		DEC_DWORD_STAT_BY(STAT_MixerChatQueuedSends, NumSent);
+		SET_FLOAT_STAT(STAT_MixerChatSendLatency, LastOutboundSendLatency * 1000.0f);
+	}
+}
+
+void FMixerChatConnection::SendOutbound(const FOutboundChatSend& Send)
+{
+	switch (Send.Kind)
+	{
+	case EOutboundChatKind::Message:
+		SendMethodMessageArrayParams(MixerStringConstants::MethodNames::Msg, nullptr, Send.Body);
+		break;
+	case EOutboundChatKind::Whisper:
+		SendMethodMessageArrayParams(MixerStringConstants::MethodNames::Whisper, nullptr, Send.Target, Send.Body);
+		break;
+	case EOutboundChatKind::VoteStart:
+		SendMethodMessageArrayParams(MixerStringConstants::MethodNames::VoteStart, nullptr, Send.Body, Send.Answers, Send.Duration);
+		break;
+	default:
+		checkNoEntry();
+		break;
+	}
+}
+
+uint32 FMixerChatConnection::HashOutboundSend(EOutboundChatKind Kind, const FString& Body, const FString& Target)
+{
+	return HashCombine(HashCombine(GetTypeHash(static_cast<uint8>(Kind)), GetTypeHash(Body)), GetTypeHash(Target));
+}
+
 void FMixerChatConnection::GetMessageHistory(int32 NumMessages, TArray< TSharedRef<FChatMessage> >& OutMessages) const
 {
-	TSharedPtr<FChatMessageMixerImpl> ChatMessage = ChatHistoryNewest;
-	while (ChatMessage.IsValid() &&
-		(NumMessages == -1 || OutMessages.Num() < NumMessages))
+	OutMessages.Reserve(OutMessages.Num() + (NumMessages == -1 ? ChatHistoryNum : FMath::Min(NumMessages, ChatHistoryNum)));
+	int32 Added = 0;
+	ForEachChatHistoryMessage([&](const TSharedPtr<FChatMessageMixerImpl>& ChatMessage)
 	{
+		if (NumMessages != -1 && Added >= NumMessages)
+		{
+			return false;
+		}
 		OutMessages.Add(ChatMessage.ToSharedRef());
-		ChatMessage = ChatMessage->NextLink;
-	}
+		++Added;
+		return true;
+	});
+}
+
+void FMixerChatConnection::VisitMessageHistory(int32 NumMessages, TFunctionRef<bool(const FChatMessageMixer&)> Visitor) const
+{
+	int32 Visited = 0;
+	ForEachChatHistoryMessage([&](const TSharedPtr<FChatMessageMixerImpl>& ChatMessage)
+	{
+		if (NumMessages != -1 && Visited >= NumMessages)
+		{
+			return false;
+		}
+		++Visited;
+		return Visitor(*ChatMessage);
+	});
 }
 
 void FMixerChatConnection::RegisterAllServerMessageHandlers()
 {
 	RegisterServerMessageHandler(MixerStringConstants::EventTypes::Welcome, &FMixerChatConnection::HandleWelcomeEvent);
-	RegisterServerMessageHandler(MixerStringConstants::EventTypes::ChatMessage, &FMixerChatConnection::HandleChatMessageEvent);
-	RegisterServerMessageHandler(MixerStringConstants::EventTypes::UserJoin, &FMixerChatConnection::HandleUserJoinEvent);
-	RegisterServerMessageHandler(MixerStringConstants::EventTypes::UserLeave, &FMixerChatConnection::HandleUserLeaveEvent);
-	RegisterServerMessageHandler(MixerStringConstants::EventTypes::DeleteMessage, &FMixerChatConnection::HandleDeleteMessageEvent);
+	RegisterServerMessageStreamHandler(MixerStringConstants::EventTypes::ChatMessage, &FMixerChatConnection::HandleChatMessageEvent);
+	RegisterServerMessageStreamHandler(MixerStringConstants::EventTypes::UserJoin, &FMixerChatConnection::HandleUserJoinEvent);
+	RegisterServerMessageStreamHandler(MixerStringConstants::EventTypes::UserLeave, &FMixerChatConnection::HandleUserLeaveEvent);
+	RegisterServerMessageStreamHandler(MixerStringConstants::EventTypes::DeleteMessage, &FMixerChatConnection::HandleDeleteMessageEvent);
 	RegisterServerMessageHandler(MixerStringConstants::EventTypes::ClearMessages, &FMixerChatConnection::HandleClearMessagesEvent);
-	RegisterServerMessageHandler(MixerStringConstants::EventTypes::PurgeMessage, &FMixerChatConnection::HandlePurgeMessageEvent);
+	RegisterServerMessageStreamHandler(MixerStringConstants::EventTypes::PurgeMessage, &FMixerChatConnection::HandlePurgeMessageEvent);
 	RegisterServerMessageHandler(MixerStringConstants::EventTypes::PollStart, &FMixerChatConnection::HandlePollStartEvent);
 	RegisterServerMessageHandler(MixerStringConstants::EventTypes::PollEnd, &FMixerChatConnection::HandlePollEndEvent);
 }
 
 void FMixerChatConnection::AddMessageToChatHistory(TSharedRef<FChatMessageMixerImpl> ChatMessage)
 {
-	if (ChatHistoryMax > 0 && !ChatMessage->IsWhisper())
+	SCOPE_CYCLE_COUNTER(STAT_MixerChatHistory);
+	MIXER_LLM_SCOPE(ChatHistory);
+
+	if (ChatHistory.Num() > 0 && !ChatMessage->IsWhisper())
 	{
-		ChatMessage->NextLink = ChatHistoryNewest;
-		if (ChatHistoryNewest.IsValid())
+		ChatMessage->HistorySequence = ChatHistoryNextSequence++;
+		const int32 SlotIndex = static_cast<int32>(ChatMessage->HistorySequence % ChatHistory.Num());
+		if (ChatHistory[SlotIndex].IsValid())
 		{
-			ChatHistoryNewest->PrevLink = ChatMessage;
+			// Evicting the oldest message
+			RemoveChatHistorySlot(SlotIndex, false);
 		}
-		ChatHistoryNewest = ChatMessage;
+		ChatHistory[SlotIndex] = ChatMessage;
+		ChatHistorySlotsById.Add(ChatMessage->GetMessageId(), SlotIndex);
+		ChatHistorySlotsBySender.FindOrAdd(ChatMessage->GetSender().Id).Add(SlotIndex);
 		++ChatHistoryNum;
-		if (!ChatHistoryOldest.IsValid())
+	}
+}
+
+void FMixerChatConnection::DeleteChatHistoryMessage(const FGuid& MessageId)
+{
+	const int32* SlotIndex = ChatHistorySlotsById.Find(MessageId);
+	if (SlotIndex != nullptr)
+	{
+		RemoveChatHistorySlot(*SlotIndex, true);
+	}
+}
+
+void FMixerChatConnection::DeleteChatHistoryMessagesFromSender(int32 SenderId)
+{
+	TArray<int32, TInlineAllocator<4>> SenderSlots;
+	if (ChatHistorySlotsBySender.RemoveAndCopyValue(SenderId, SenderSlots))
+	{
+		for (int32 SlotIndex : SenderSlots)
 		{
-			ChatHistoryOldest = ChatMessage;
+			// @TODO - pass moderator here when available
+			TSharedPtr<FChatMessageMixerImpl>& ChatMessage = ChatHistory[SlotIndex];
+			check(ChatMessage.IsValid());
+			ChatMessage->FlagAsDeleted();
+			RemoveChatHistoryIdSlot(ChatMessage->GetMessageId(), SlotIndex);
+			ChatMessage.Reset();
+			--ChatHistoryNum;
 		}
-		else if (ChatHistoryNum > ChatHistoryMax)
+	}
+}
+
+void FMixerChatConnection::ClearChatHistory(bool bFlagAsDeleted)
+{
+	SCOPE_CYCLE_COUNTER(STAT_MixerChatHistory);
+
+	for (TSharedPtr<FChatMessageMixerImpl>& ChatMessage : ChatHistory)
+	{
+		if (ChatMessage.IsValid())
 		{
-			ChatHistoryOldest = ChatHistoryOldest->PrevLink;
-			if (ChatHistoryOldest.IsValid())
+			if (bFlagAsDeleted)
 			{
-				check(ChatHistoryOldest->NextLink.IsValid());
-				ChatHistoryOldest->NextLink->PrevLink.Reset();
-				ChatHistoryOldest->NextLink.Reset();
+				// @TODO - pass moderator here when available
+				ChatMessage->FlagAsDeleted();
 			}
-			--ChatHistoryNum;
+			ChatMessage.Reset();
 		}
 	}
+	ChatHistoryNum = 0;
+	ChatHistorySlotsById.Reset();
+	ChatHistorySlotsBySender.Reset();
 }
 
-void FMixerChatConnection::DeleteFromChatHistoryIf(TFunctionRef<bool(TSharedPtr<FChatMessageMixerImpl>)> Predicate)
+void FMixerChatConnection::RemoveChatHistorySlot(int32 SlotIndex, bool bFlagAsDeleted)
 {
-	// @TODO - pass moderator here when available
-	TSharedPtr<FChatMessageMixerImpl> ChatMessage = ChatHistoryNewest;
-	while (ChatMessage.IsValid())
+	TSharedPtr<FChatMessageMixerImpl>& ChatMessage = ChatHistory[SlotIndex];
+	check(ChatMessage.IsValid());
+	if (bFlagAsDeleted)
+	{
+		// @TODO - pass moderator here when available
+		ChatMessage->FlagAsDeleted();
+	}
+
+	RemoveChatHistoryIdSlot(ChatMessage->GetMessageId(), SlotIndex);
+	const int32 SenderId = ChatMessage->GetSender().Id;
+	TArray<int32, TInlineAllocator<4>>* SenderSlots = ChatHistorySlotsBySender.Find(SenderId);
+	if (SenderSlots != nullptr)
 	{
-		TSharedPtr<FChatMessageMixerImpl> NextMessage = ChatMessage->NextLink;
-		if (Predicate(ChatMessage))
+		// Evictions always hit the sender's oldest message, so this is usually the first entry
+		SenderSlots->RemoveSingle(SlotIndex);
+		if (SenderSlots->Num() == 0)
 		{
-			ChatMessage->FlagAsDeleted();
-			if (ChatMessage == ChatHistoryNewest)
-			{
-				ChatHistoryNewest = ChatMessage->NextLink;
-			}
-			if (ChatMessage == ChatHistoryOldest)
-			{
-				ChatHistoryOldest = ChatMessage->PrevLink;
-			}
-			if (ChatMessage->NextLink.IsValid())
-			{
-				ChatMessage->NextLink->PrevLink = ChatMessage->PrevLink;
-			}
-			if (ChatMessage->PrevLink.IsValid())
-			{
-				ChatMessage->PrevLink->NextLink = ChatMessage->NextLink;
-			}
-			ChatMessage->NextLink.Reset();
-			ChatMessage->PrevLink.Reset();
-			--ChatHistoryNum;
+			ChatHistorySlotsBySender.Remove(SenderId);
+		}
+	}
+
+	ChatMessage.Reset();
+	--ChatHistoryNum;
+}
+
+void FMixerChatConnection::RemoveChatHistoryIdSlot(const FGuid& MessageId, int32 SlotIndex)
+{
+	// Only drop the id mapping if it was added for this slot; a re-sent id may have claimed a newer one
+	const int32* IdSlot = ChatHistorySlotsById.Find(MessageId);
+	if (IdSlot != nullptr && *IdSlot == SlotIndex)
+	{
+		ChatHistorySlotsById.Remove(MessageId);
+	}
+}
+
+void FMixerChatConnection::ForEachChatHistoryMessage(TFunctionRef<bool(const TSharedPtr<FChatMessageMixerImpl>&)> Visitor) const
+{
+	const uint64 Capacity = ChatHistory.Num();
+	const uint64 OldestSequence = ChatHistoryNextSequence > Capacity ? ChatHistoryNextSequence - Capacity : 0;
+	for (uint64 Sequence = ChatHistoryNextSequence; Sequence > OldestSequence; --Sequence)
+	{
+		const TSharedPtr<FChatMessageMixerImpl>& ChatMessage = ChatHistory[(Sequence - 1) % Capacity];
+		if (ChatMessage.IsValid() && !Visitor(ChatMessage))
+		{
+			break;
 		}
-		ChatMessage = NextMessage;
 	}
 }
 
@@ -793,7 +1749,14 @@ bool FMixerChatConnection::HandleAuthReply(FJsonObject* JsonObj)
 	{
 		FString ErrorMessage;
 		(*Error)->TryGetStringField(MixerStringConstants::FieldNames::Message, ErrorMessage);
-		ChatInterface->ConnectAttemptFinished(*User, RoomId, false, ErrorMessage);
+		if (bResumingSession)
+		{
+			ChatInterface->ExitRoomWithReason(*User, RoomId, false, ErrorMessage);
+		}
+		else
+		{
+			ChatInterface->ConnectAttemptFinished(*User, RoomId, false, ErrorMessage);
+		}
 
 		// Note: we have probably self-destructed at this point
 		return false;
@@ -801,12 +1764,24 @@ bool FMixerChatConnection::HandleAuthReply(FJsonObject* JsonObj)
 	else
 	{
 		bIsReady = true;
-		if (ChatHistoryMax > 0)
+		MarkBootstrapPhase(BootstrapTimings.Authenticated, TEXT("authenticated"));
+		if (ChatHistory.Num() > 0)
 		{
-			SendMethodMessageArrayParams(MixerStringConstants::MethodNames::History, &FMixerChatConnection::HandleHistoryReply, FMath::Min(ChatHistoryMax, 100));
+			SendMethodMessageArrayParams(MixerStringConstants::MethodNames::History, &FMixerChatConnection::HandleHistoryReply, FMath::Min(ChatHistory.Num(), 100));
 		}
 		// Maybe we have some interest in roles?
 
+		if (bResumingSession)
+		{
+			// Already joined as far as listeners are concerned
+			UE_LOG(LogMixerChat, Log, TEXT("Reconnected to chat room %s"), *RoomId);
+			if (ChatHistory.Num() == 0)
+			{
+				bResumingSession = false;
+			}
+			return true;
+		}
+
 		ChatInterface->ConnectAttemptFinished(*User, RoomId, true, FString());
 
 		return true;
@@ -815,77 +1790,170 @@ bool FMixerChatConnection::HandleAuthReply(FJsonObject* JsonObj)
 
 bool FMixerChatConnection::HandleHistoryReply(FJsonObject* JsonObj)
 {
+	SCOPE_CYCLE_COUNTER(STAT_MixerChatHistory);
+	MIXER_LLM_SCOPE(ChatHistory);
+
 	GET_JSON_ARRAY_RETURN_FAILURE(Data, Data);
 
-	// Stash the current history and then clear member pointers.
-	// We'll splice what we have back on the front of the history
-	// reported by the server.
-	TSharedPtr<FChatMessageMixerImpl> LocalHistoryNewest = ChatHistoryNewest;
-	TSharedPtr<FChatMessageMixerImpl> LocalHistoryOldest = ChatHistoryOldest;
-	int32 LocalHistoryNum = ChatHistoryNum;
-	int32 LocalHistoryMax = ChatHistoryMax;
-	ChatHistoryNewest.Reset();
-	ChatHistoryOldest.Reset();
-	ChatHistoryNum = 0;
-	ChatHistoryMax = LocalHistoryMax - LocalHistoryNum;
+	if (bResumingSession)
+	{
+		HandleResumeHistoryReply(*Data);
+		return true;
+	}
+
+	MarkBootstrapPhase(BootstrapTimings.HistoryReceived, TEXT("history received"));
+
+	// Stash the current history and then clear the ring.
+	// We'll re-add what we have after the history reported
+	// by the server so that it stays newest.
+	TArray<TSharedPtr<FChatMessageMixerImpl>, TInlineAllocator<16>> LocalHistory;
+	LocalHistory.Reserve(ChatHistoryNum);
+	ForEachChatHistoryMessage([&LocalHistory](const TSharedPtr<FChatMessageMixerImpl>& ChatMessage)
+	{
+		LocalHistory.Add(ChatMessage);
+		return true;
+	});
+	ClearChatHistory(false);
+
+	// Possibly our history request crossed paths with some
+	// new messages and we could have some dupes?  Everything
+	// from the oldest message we already had onwards is one.
+	// Only the ids are needed to find it, so check those before
+	// doing any real decoding.
+	int32 NumServerEntries = Data->Num();
+	if (LocalHistory.Num() > 0)
+	{
+		const FString IdToCheckForDupes = LocalHistory.Last()->GetMessageId().ToString(EGuidFormats::DigitsWithHyphens);
+		for (int32 i = 0; i < Data->Num(); ++i)
+		{
+			const TSharedPtr<FJsonObject>* HistoryEntryObj;
+			FString EntryId;
+			if ((*Data)[i]->TryGetObject(HistoryEntryObj) &&
+				(*HistoryEntryObj)->TryGetStringField(MixerStringConstants::FieldNames::Id, EntryId) &&
+				EntryId.Equals(IdToCheckForDupes, ESearchCase::IgnoreCase))
+			{
+				NumServerEntries = i;
+				break;
+			}
+		}
+	}
 
-	// Oldest entry is at index 0 as reported by Mixer
-	// Whereas we keep the newest entry at the head of the list,
-	// which is where HandleChatMessagePacket pushes.
-	for (const TSharedPtr<FJsonValue> HistoryEntry : *Data)
+	// Oldest entry is at index 0 as reported by Mixer.  Anything the ring
+	// would immediately evict again is skipped rather than decoded.
+	const int32 NumToDecode = FMath::Clamp(ChatHistory.Num() - LocalHistory.Num(), 0, NumServerEntries);
+	TArray<TSharedPtr<FChatMessageMixerImpl>> ServerHistory;
+	ServerHistory.Reserve(NumToDecode);
+	for (int32 i = NumServerEntries - NumToDecode; i < NumServerEntries; ++i)
 	{
 		TSharedPtr<FChatMessageMixerImpl> ChatMessage;
-		if (HandleChatMessageEventInternal(HistoryEntry->AsObject().Get(), ChatMessage))
+		if (HandleChatMessageEventInternal((*Data)[i]->AsObject().Get(), ChatMessage))
 		{
 			check(!ChatMessage->IsWhisper());
-			AddMessageToChatHistory(ChatMessage.ToSharedRef());
+			ServerHistory.Add(ChatMessage);
+		}
+		else if (ChatMessage.IsValid())
+		{
+			ReleaseChatMessage(ChatMessage);
 		}
 	}
 
-	// Relink the history we'd already accumulated.
-	// Possibly our history request crossed paths with some
-	// new messages and we could have some dupes?
-	if (!ChatHistoryNewest.IsValid())
+	// Everything fits, so this is a straight insert with no eviction.
+	ChatHistorySlotsById.Reserve(ServerHistory.Num() + LocalHistory.Num());
+	for (const TSharedPtr<FChatMessageMixerImpl>& ChatMessage : ServerHistory)
+	{
+		AddMessageToChatHistory(ChatMessage.ToSharedRef());
+	}
+	for (int32 i = LocalHistory.Num() - 1; i >= 0; --i)
 	{
-		ChatHistoryNewest = LocalHistoryNewest;
-		ChatHistoryOldest = LocalHistoryOldest;
+		AddMessageToChatHistory(LocalHistory[i].ToSharedRef());
 	}
-	else if (LocalHistoryOldest.IsValid())
+
+	UE_LOG(LogMixerChat, Verbose, TEXT("Loaded %d history messages for room %s (%d returned by server)"), ServerHistory.Num(), *RoomId, Data->Num());
+	ChatInterface->TriggerOnChatRoomHistoryLoadedDelegates(*User, RoomId, ServerHistory.Num());
+
+	return true;
+}
+
+void FMixerChatConnection::RecordResumePoint()
+{
+	// Whispers never appear in room history, so they can't mark the spot
+	ResumeAfterMessageId.Invalidate();
+	ForEachChatHistoryMessage([this](const TSharedPtr<FChatMessageMixerImpl>& ChatMessage)
 	{
-		int32 DupeCount = 0;
-		FGuid IdToCheckForDupes = LocalHistoryOldest->GetMessageId();
-		TSharedPtr<FChatMessageMixerImpl> ServerHistoryMessage = ChatHistoryNewest;
-		while (ServerHistoryMessage.IsValid())
+		if (ChatMessage->IsWhisper())
 		{
-			++DupeCount;
-			if (ServerHistoryMessage->GetMessageId() == IdToCheckForDupes)
-			{
-				break;
-			}
-			ServerHistoryMessage = ServerHistoryMessage->NextLink;
+			return true;
 		}
+		ResumeAfterMessageId = ChatMessage->GetMessageId();
+		return false;
+	});
+}
+
+void FMixerChatConnection::HandleResumeHistoryReply(const TArray<TSharedPtr<FJsonValue>>& Data)
+{
+	bResumingSession = false;
+	const FGuid ResumeAfter = ResumeAfterMessageId;
+	ResumeAfterMessageId.Invalidate();
 
-		if (ServerHistoryMessage.IsValid())
+	// Only ids are needed to tell what we already hold, so check those against the ring's index before decoding anything.
+	auto IsKnownEntry = [this](const TSharedPtr<FJsonValue>& Entry)
+	{
+		const TSharedPtr<FJsonObject>* EntryObj;
+		FString EntryIdString;
+		FGuid EntryId;
+		return Entry->TryGetObject(EntryObj)
+			&& (*EntryObj)->TryGetStringField(MixerStringConstants::FieldNames::Id, EntryIdString)
+			&& FGuid::Parse(EntryIdString, EntryId)
+			&& ChatHistorySlotsById.Contains(EntryId);
+	};
+
+	// Oldest entry is at index 0.  Everything after the newest message we had before the disconnect arrived while
+	// we were away, apart from any that have since come in live.  Messages received live after reconnecting can't
+	// mark the spot, since they're newer than the gap.  If the reply doesn't reach back that far, the gap was longer.
+	int32 FirstMissed = 0;
+	if (ResumeAfter.IsValid())
+	{
+		for (int32 i = Data.Num() - 1; i >= 0; --i)
 		{
-			LocalHistoryOldest->NextLink = ServerHistoryMessage->NextLink;
-			if (ServerHistoryMessage->NextLink.IsValid())
+			const TSharedPtr<FJsonObject>* EntryObj;
+			FString EntryIdString;
+			FGuid EntryId;
+			if (Data[i]->TryGetObject(EntryObj)
+				&& (*EntryObj)->TryGetStringField(MixerStringConstants::FieldNames::Id, EntryIdString)
+				&& FGuid::Parse(EntryIdString, EntryId)
+				&& EntryId == ResumeAfter)
 			{
-				ServerHistoryMessage->NextLink->PrevLink = LocalHistoryOldest;
+				FirstMissed = i + 1;
+				break;
 			}
-			ChatHistoryNum -= DupeCount;
 		}
-		else
+	}
+
+	// Listeners may leave the room, which would destroy us before triggers run.
+	TSharedRef<FMixerChatConnection> KeepAlive = AsShared();
+	int32 NumDelivered = 0;
+	for (int32 i = FirstMissed; i < Data.Num(); ++i)
+	{
+		if (IsKnownEntry(Data[i]))
 		{
-			LocalHistoryOldest->NextLink = ChatHistoryNewest;
-			ChatHistoryNewest->PrevLink = LocalHistoryOldest;
+			continue;
 		}
 
-		ChatHistoryNewest = LocalHistoryNewest;
-		ChatHistoryNum += LocalHistoryNum;
-		ChatHistoryMax = LocalHistoryMax;
+		TSharedPtr<FChatMessageMixerImpl> ChatMessage;
+		if (HandleChatMessageEventInternal(Data[i]->AsObject().Get(), ChatMessage))
+		{
+			AddMessageToChatHistory(ChatMessage.ToSharedRef());
+			ChatInterface->TriggerOnChatRoomMessageReceivedDelegates(*User, RoomId, ChatMessage.ToSharedRef());
+			ChatInterface->DispatchChatTriggers(RoomId, *ChatMessage);
+			++NumDelivered;
+		}
+		else if (ChatMessage.IsValid())
+		{
+			ReleaseChatMessage(ChatMessage);
+		}
 	}
 
-	return true;
+	UE_LOG(LogMixerChat, Log, TEXT("Resumed chat room %s; delivered %d messages missed while disconnected"), *RoomId, NumDelivered);
 }
 
 void FMixerChatConnection::GetAllCachedUsers(TArray< TSharedRef<FChatRoomMember> >& OutUsers) const
@@ -898,7 +1966,104 @@ void FMixerChatConnection::GetAllCachedUsers(TArray< TSharedRef<FChatRoomMember>
 
 TSharedPtr<FMixerChatUser> FMixerChatConnection::FindUser(const FUniqueNetId& UserId) const
 {
-	const TSharedPtr<FMixerChatUser>* FoundUser = CachedUsers.Find(FUniqueNetIdMixer(UserId));
-	return FoundUser != nullptr ? *FoundUser : nullptr;
+	const FUniqueNetIdMixer MixerUserId = FUniqueNetIdMixer(UserId);
+	const TSharedPtr<FMixerChatUser>* FoundUser = CachedUsers.Find(MixerUserId);
+	if (FoundUser != nullptr)
+	{
+		return *FoundUser;
+	}
+
+	return EvictedUserIds.Contains(MixerUserId.GetMixerId()) ? FindEvictedUser(MixerUserId.GetMixerId()) : nullptr;
+}
+
+TSharedPtr<FMixerChatUser>* FMixerChatConnection::FindCachedUser(const FUniqueNetIdMixer& UserId)
+{
+	TSharedPtr<FMixerChatUser>* FoundUser = CachedUsers.Find(UserId);
+	if (FoundUser != nullptr)
+	{
+		(*FoundUser)->LastActiveStamp = ++UserCacheClock;
+	}
+	return FoundUser;
+}
+
+TSharedPtr<FMixerChatUser>& FMixerChatConnection::AddCachedUser(const FString& UserName, int32 UserIdRaw, bool& bOutWasEvicted)
+{
+	// Trim before adding so that the returned reference stays valid
+	TrimUserCache();
+
+	TSharedPtr<FMixerChatUser> NewUser;
+	bOutWasEvicted = EvictedUserIds.Remove(UserIdRaw) > 0;
+	if (bOutWasEvicted)
+	{
+		// Keep identity with whatever history and polls still reference
+		NewUser = FindEvictedUser(UserIdRaw);
+	}
+	if (!NewUser.IsValid())
+	{
+		NewUser = MakeShared<FMixerChatUser>(UserName, UserIdRaw);
+	}
+	NewUser->LastActiveStamp = ++UserCacheClock;
+	INC_DWORD_STAT(STAT_MixerChatCachedUsers);
+	return CachedUsers.Add(NewUser->GetUniqueNetId(), NewUser);
+}
+
+TSharedPtr<FMixerChatUser> FMixerChatConnection::FindEvictedUser(int32 UserIdRaw) const
+{
+	// Evicted users are only kept alive by the messages and poll that reference them
+	const TArray<int32, TInlineAllocator<4>>* SenderSlots = ChatHistorySlotsBySender.Find(UserIdRaw);
+	if (SenderSlots != nullptr && SenderSlots->Num() > 0)
+	{
+		return ConstCastSharedRef<FMixerChatUser>(ChatHistory[SenderSlots->Last()]->GetSenderRef());
+	}
+	else if (ActivePoll.IsValid() && ActivePoll->GetAskingMixerUser()->Id == UserIdRaw)
+	{
+		return ConstCastSharedRef<FMixerChatUser>(ActivePoll->GetAskingMixerUser());
+	}
+	return nullptr;
+}
+
+void FMixerChatConnection::TrimUserCache()
+{
+	if (UserCacheCapacity == 0 || CachedUsers.Num() < UserCacheCapacity)
+	{
+		return;
+	}
+
+	// Evict in batches so that the sort is amortized over many additions
+	const int32 NumToEvict = CachedUsers.Num() - UserCacheCapacity + FMath::Max(UserCacheCapacity / 8, 1);
+	TArray<TPair<uint64, int32>> ByAge;
+	ByAge.Reserve(CachedUsers.Num());
+	for (const TPair<FUniqueNetIdMixer, TSharedPtr<FMixerChatUser>>& CachedUser : CachedUsers)
+	{
+		ByAge.Add(TPair<uint64, int32>(CachedUser.Value->LastActiveStamp, CachedUser.Value->Id));
+	}
+	ByAge.Sort([](const TPair<uint64, int32>& A, const TPair<uint64, int32>& B)
+	{
+		return A.Key < B.Key;
+	});
+
+	for (int32 i = 0; i < NumToEvict && i < ByAge.Num(); ++i)
+	{
+		CachedUsers.Remove(FUniqueNetIdMixer(ByAge[i].Value));
+		EvictedUserIds.Add(ByAge[i].Value, ByAge[i].Key);
+	}
+
+	if (EvictedUserIds.Num() > UserCacheCapacity)
+	{
+		// Users idle this long have most likely left without us hearing; at worst they get a second join event
+		EvictedUserIds.ValueSort([](uint64 A, uint64 B) { return A < B; });
+		const int32 NumToForget = EvictedUserIds.Num() - UserCacheCapacity + FMath::Max(UserCacheCapacity / 8, 1);
+		int32 NumForgotten = 0;
+		for (auto It = EvictedUserIds.CreateIterator(); It && NumForgotten < NumToForget; ++It, ++NumForgotten)
+		{
+			It.RemoveCurrent();
+		}
+		EvictedUserIds.Compact();
+		UE_LOG(LogMixerChat, Verbose, TEXT("Forgot %d long idle evicted users from %s's chat user cache."), NumForgotten, *RoomId);
+	}
+
+	UE_LOG(LogMixerChat, Verbose, TEXT("Evicted %d least recently active users from %s's chat user cache (%d remain)."), NumToEvict, *RoomId, CachedUsers.Num());
+	DEC_DWORD_STAT_BY(STAT_MixerChatCachedUsers, NumToEvict);
+	INC_DWORD_STAT_BY(STAT_MixerChatEvictedUsers, NumToEvict);
 }
 
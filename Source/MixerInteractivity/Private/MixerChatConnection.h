@@ -40,10 +40,29 @@ public:
 
 	void GetMessageHistory(int32 NumMessages, TArray<TSharedRef<FChatMessage>>& OutMessages) const;
 
+	/** Walk the history newest first without copying it.  The visitor returns false to stop. */
+	void VisitMessageHistory(int32 NumMessages, TFunctionRef<bool(const FChatMessageMixer&)> Visitor) const;
+
 	void GetAllCachedUsers(TArray< TSharedRef<FChatRoomMember> >& OutUsers) const;
 
 	TSharedPtr<FMixerChatUser> FindUser(const FUniqueNetId& UserId) const;
 
+	/** Release queued sends that the rate limit now allows.  Called once per tick after the socket is pumped. */
+	void TickOutboundQueue();
+
+	/**
+	* Apply joins and leaves held back for UMixerInteractivitySettings::ChatMembershipCoalesceWindow once it has
+	* elapsed, and report everything that joined or left since the last tick in one OnChatRoomMembersChanged.
+	*/
+	void TickMembershipChanges();
+
+	int32 GetOutboundQueueDepth() const			{ return OutboundQueue.Num(); }
+	const FChatRoomBootstrapTimingsMixer& GetBootstrapTimings() const	{ return BootstrapTimings; }
+	float GetLastOutboundSendLatency() const	{ return LastOutboundSendLatency; }
+
+	/** Report how many entries each of the connection's caches and queues holds, see FMixerInteractivityModule::GetContainerSizes. */
+	void GetContainerSizes(TFunctionRef<void(const TCHAR* Name, int64 Size)> Visit) const;
+
 protected:
 	virtual void RegisterAllServerMessageHandlers();
 	virtual bool OnUnhandledServerMessage(const FString& MessageType, const TSharedPtr<FJsonObject> Params) { return false; }
@@ -51,36 +70,87 @@ protected:
 	virtual void HandleSocketConnected();
 	virtual void HandleSocketConnectionError();
 	virtual void HandleSocketClosed(bool bWasClean);
+	virtual FString GetHealthPingMethodName() const override;
+	virtual void HandleConnectionDegraded() override;
 
 private:
-
 	void JoinDiscoveredChatChannel();
 
-	void OnGetChannelInfoForRoomIdComplete(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded);
+	void OnChannelIdResolved(int32 InChannelId);
 	void OnDiscoverChatServersComplete(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded);
+	void OnChatEndpointsRanked(const TArray<FString>& RankedEndpoints);
+	void OpenWebSocket();
 
 	bool HandleWelcomeEvent(class FJsonObject* JsonObj);
-	bool HandleChatMessageEvent(class FJsonObject* JsonObj);
-	bool HandleUserJoinEvent(class FJsonObject* JsonObj);
-	bool HandleUserLeaveEvent(class FJsonObject* JsonObj);
-	bool HandleDeleteMessageEvent(class FJsonObject* JsonObj);
+	bool HandleChatMessageEvent(FMixerJsonCursor& Cursor);
+	bool HandleUserJoinEvent(FMixerJsonCursor& Cursor);
+	bool HandleUserLeaveEvent(FMixerJsonCursor& Cursor);
+	bool HandleDeleteMessageEvent(FMixerJsonCursor& Cursor);
+	bool ApplyUserJoin(int32 JoiningUserIdRaw, const FString& JoiningUserName);
+	void ApplyUserLeave(int32 LeavingUserIdRaw);
+	void QueueMembershipChange(int32 UserIdRaw, const FString& UserName, bool bJoined);
+	void NotifyMemberJoined(const FMixerChatUser& JoiningUser);
+	void NotifyMemberExited(const FMixerChatUser& LeavingUser);
 	bool HandleClearMessagesEvent(class FJsonObject* JsonObj);
-	bool HandlePurgeMessageEvent(class FJsonObject* JsonObj);
+	bool HandlePurgeMessageEvent(FMixerJsonCursor& Cursor);
 	bool HandlePollStartEvent(class FJsonObject* JsonObj);
 	bool HandlePollEndEvent(class FJsonObject* JsonObj);
 
 	bool HandleChatMessageEventInternal(class FJsonObject* JsonObj, TSharedPtr<FChatMessageMixerImpl>& OutMessage);
+	void DecodeChatMessageObject(FMixerJsonCursor& Cursor, FChatMessageMixerImpl& ChatMessage, bool& bOutIsWhisper, bool& bOutIsAction);
+	TSharedPtr<FMixerChatUser> ResolveChatMessageSender(int32 FromUserIdRaw, const FString* FromUserName, const int32* FromUserLevel);
+	TSharedPtr<FChatMessageMixerImpl> AcquireChatMessage();
+	void ReleaseChatMessage(TSharedPtr<FChatMessageMixerImpl>& ChatMessage);
 	bool HandleChatMessageEventMessageObject(class FJsonObject* JsonObj, FChatMessageMixerImpl* ChatMessage);
 	bool HandleChatMessageEventMessageArrayEntry(class FJsonObject* JsonObj, FChatMessageMixerImpl* ChatMessage);
 	bool HandlePollEndEventInternal(class FJsonObject* JsonObj);
-	bool UpdateActivePollFromServer(class FJsonObject* JsonObj, bool& bOutAnythingChanged);
+	bool UpdateActivePollFromServer(const TArray<TSharedPtr<class FJsonValue>>* Responses, bool& bOutAnythingChanged);
+	void TriggerPollAnswerUpdates();
 
 	void AddMessageToChatHistory(TSharedRef<struct FChatMessageMixerImpl> ChatMessage);
-	void DeleteFromChatHistoryIf(TFunctionRef<bool(TSharedPtr<FChatMessageMixerImpl>)> Predicate);
+	void DeleteChatHistoryMessage(const FGuid& MessageId);
+	void DeleteChatHistoryMessagesFromSender(int32 SenderId);
+	void ClearChatHistory(bool bFlagAsDeleted);
+	void RemoveChatHistorySlot(int32 SlotIndex, bool bFlagAsDeleted);
+	void RemoveChatHistoryIdSlot(const FGuid& MessageId, int32 SlotIndex);
+	void ForEachChatHistoryMessage(TFunctionRef<bool(const TSharedPtr<FChatMessageMixerImpl>&)> Visitor) const;
+
+	TSharedPtr<FMixerChatUser>* FindCachedUser(const FUniqueNetIdMixer& UserId);
+	TSharedPtr<FMixerChatUser>& AddCachedUser(const FString& UserName, int32 UserIdRaw, bool& bOutWasEvicted);
+	TSharedPtr<FMixerChatUser> FindEvictedUser(int32 UserIdRaw) const;
+	void TrimUserCache();
+
+	enum class EOutboundChatKind : uint8
+	{
+		Message,
+		Whisper,
+		VoteStart,
+	};
+
+	struct FOutboundChatSend
+	{
+		EOutboundChatKind Kind;
+		FString Body;
+		FString Target;
+		TArray<FString> Answers;
+		double Duration;
+		double EnqueueTime;
+		uint32 Hash;
+	};
+
+	void MarkBootstrapPhase(float& Phase, const TCHAR* PhaseName);
+
+	bool EnqueueOutboundSend(EOutboundChatKind Kind, const FString& Body, const FString& Target, const TArray<FString>* Answers, double Duration);
+	void SendOutbound(const FOutboundChatSend& Send);
+	static uint32 HashOutboundSend(EOutboundChatKind Kind, const FString& Body, const FString& Target);
 
 private:
 	bool HandleAuthReply(class FJsonObject* JsonObj);
 	bool HandleHistoryReply(class FJsonObject* JsonObj);
+	void HandleResumeHistoryReply(const TArray<TSharedPtr<class FJsonValue>>& Data);
+
+	/** Remember the newest room message seen before the socket went away, for HandleResumeHistoryReply to pick up after. */
+	void RecordResumePoint();
 
 private:
 	class FOnlineChatMixer* ChatInterface;
@@ -88,17 +158,66 @@ private:
 	FChatRoomId RoomId;
 	FString AuthKey;
 	TArray<FString> Endpoints;
+	int32 EndpointIndex;
 	TMap<FUniqueNetIdMixer, TSharedPtr<FMixerChatUser>> CachedUsers;
+	// Users dropped from CachedUsers without leaving, so that they don't get a second join event, by when they
+	// were last active.  Capped at UserCacheCapacity; past that, the longest idle are forgotten altogether.
+	TMap<int32, uint64> EvictedUserIds;
+	uint64 UserCacheClock;
+	int32 UserCacheCapacity;
 	TSharedPtr<struct FChatPollMixerImpl> ActivePoll;
-	TSharedPtr<struct FChatMessageMixerImpl> ChatHistoryNewest;
-	TSharedPtr<struct FChatMessageMixerImpl> ChatHistoryOldest;
+	struct FPollTallyDelta
+	{
+		int32 AnswerIndex;
+		int32 Delta;
+	};
+	// Answers changed by the most recent poll update from the server
+	TArray<FPollTallyDelta, TInlineAllocator<8>> PollTallyDeltas;
+	// Ring of recent messages.  A message's slot is its HistorySequence modulo the capacity, so the oldest
+	// is overwritten in place and deletes just empty their slot.
+	TArray<TSharedPtr<struct FChatMessageMixerImpl>> ChatHistory;
+	uint64 ChatHistoryNextSequence;
 	int32 ChatHistoryNum;
-	int32 ChatHistoryMax;
+	// Indices into ChatHistory for moderation events.  Per-sender slots are kept in arrival order.
+	TMap<FGuid, int32> ChatHistorySlotsById;
+	TMap<int32, TArray<int32, TInlineAllocator<4>>> ChatHistorySlotsBySender;
+	// Messages that failed to decode and so never left this connection, kept to decode the next ones into
+	TArray<TSharedPtr<struct FChatMessageMixerImpl>> ChatMessagePool;
+	// Reused across streamed chat message decodes
+	FString DecodeScratchId;
+	FString DecodeScratchUserName;
+	FString DecodeScratchSegmentType;
+	FString DecodeScratchImageSource;
+	FString DecodeScratchImageUrl;
+	// Pending sends in FIFO order, and a count per content hash for finding duplicates
+	TArray<FOutboundChatSend> OutboundQueue;
+	TMap<uint32, int32> OutboundQueueHashes;
+	float OutboundTokens;
+	double OutboundLastRefillTime;
+	float LastOutboundSendLatency;
+	struct FPendingMembershipChange
+	{
+		FString UserName;
+		bool bJoined;
+	};
+	// Latest join or leave per user in the current coalescing window
+	TMap<int32, FPendingMembershipChange> PendingMembershipChanges;
+	double MembershipWindowStartTime;
+	float MembershipCoalesceWindow;
+	// Members reported joined or exited individually since the last batched notification
+	TArray<TSharedRef<const FUniqueNetId>> BatchedJoinedMembers;
+	TArray<TSharedRef<const FUniqueNetId>> BatchedExitedMembers;
+	FChatRoomBootstrapTimingsMixer BootstrapTimings;
+	double BootstrapStartTime;
 	int32 ChannelId;
 	bool bIsReady;
 	bool bRejoinOnDisconnect;
+	// Reconnecting after having been ready.  Auth doesn't re-announce the join, and history only fills the gap.
+	bool bResumingSession;
+	// Newest room message received before the disconnect being resumed from; invalid if there was none.
+	FGuid ResumeAfterMessageId;
 
-	struct
+	struct FChatPermissions
 	{
 		bool bConnect;
 		bool bChat;
@@ -109,4 +228,20 @@ private:
 		bool bPurge;
 		bool bGiveawayStart;
 	} Permissions;
+
+	/** What chats/<channel> tells us about joining, parsed off the game thread. */
+	struct FChatServersInfo
+	{
+		TArray<FString> Endpoints;
+		FString AuthKey;
+		FChatPermissions Permissions;
+
+		FChatServersInfo()
+		{
+			FMemory::Memzero(Permissions);
+		}
+	};
+
+	static bool ParseChatServersResponse(const FString& Content, FChatServersInfo& OutInfo);
+	void OnChatServersParsed(const FChatServersInfo& Info);
 };
@@ -0,0 +1,259 @@
+//*********************************************************
+//
+// Copyright (c) Microsoft. All rights reserved.
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT.
+//
+//*********************************************************
+#include "MixerChatConnectionManager.h"
+#include "MixerChatConnection.h"
+#include "MixerJsonHelpers.h"
+#include "MixerRestClient.h"
+#include "MixerWarmStartCache.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+// Ranking is cheap to repeat but costs a round trip per endpoint; servers don't move much within a session.
+static const double RankedEndpointsLifetimeSeconds = 300.0;
+
+namespace
+{
+	bool ParseChannelIdResponse(const FString& Content, int32& OutChannelId)
+	{
+		TSharedRef<TJsonReader<>> JsonReader = TJsonReaderFactory<>::Create(Content);
+		TSharedPtr<FJsonObject> JsonObject;
+		return FJsonSerializer::Deserialize(JsonReader, JsonObject) &&
+			JsonObject.IsValid() &&
+			JsonObject->TryGetNumberField(MixerStringConstants::FieldNames::Id, OutChannelId);
+	}
+}
+
+FMixerChatConnectionManager::FMixerChatConnectionManager()
+	: EndpointSelector(MakeShared<FMixerEndpointSelector>())
+	, RankedEndpointsTime(0.0)
+	, bRankingInFlight(false)
+{
+}
+
+FMixerChatConnectionManager::~FMixerChatConnectionManager()
+{
+	Reset();
+}
+
+void FMixerChatConnectionManager::ResolveChannelId(const FString& RoomId, FOnChannelIdResolved Callback)
+{
+	const FString RoomKey = RoomId.ToLower();
+	const int32* KnownChannelId = ChannelIds.Find(RoomKey);
+	if (KnownChannelId != nullptr)
+	{
+		Callback.ExecuteIfBound(*KnownChannelId);
+		return;
+	}
+
+	// Channels don't move between launches, so a remembered id is as good as a lookup until the
+	// service says otherwise (see ForgetWarmStartChannelId).
+	const int32 WarmStartChannelId = FMixerWarmStartCache::Get().FindChannelId(RoomKey);
+	if (WarmStartChannelId != 0)
+	{
+		ChannelIds.Add(RoomKey, WarmStartChannelId);
+		WarmStartRoomKeys.Add(RoomKey);
+		Callback.ExecuteIfBound(WarmStartChannelId);
+		return;
+	}
+
+	TArray<FOnChannelIdResolved>* Waiters = PendingChannelLookups.Find(RoomKey);
+	if (Waiters != nullptr)
+	{
+		Waiters->Add(Callback);
+		return;
+	}
+
+	PendingChannelLookups.Add(RoomKey).Add(Callback);
+
+	TSharedRef<IHttpRequest> ChannelRequest = FMixerRestClient::Get().CreateRequest(TEXT("GET"), FString::Printf(TEXT("channels/%s?fields=id"), *RoomId));
+	ChannelRequest->OnProcessRequestComplete().BindSP(this, &FMixerChatConnectionManager::OnChannelInfoComplete, RoomKey);
+	ChannelRequests.Add(ChannelRequest);
+	if (!FMixerRestClient::Get().ProcessRequest(ChannelRequest))
+	{
+		ChannelRequests.Remove(ChannelRequest);
+		OnChannelInfoComplete(ChannelRequest, nullptr, false, RoomKey);
+	}
+}
+
+void FMixerChatConnectionManager::SeedChannelId(const FString& RoomId, int32 ChannelId)
+{
+	if (ChannelId != 0)
+	{
+		ConfirmChannelId(RoomId, ChannelId);
+		ChannelIds.Add(RoomId.ToLower(), ChannelId);
+	}
+}
+
+void FMixerChatConnectionManager::ConfirmChannelId(const FString& RoomId, int32 ChannelId)
+{
+	const FString RoomKey = RoomId.ToLower();
+	WarmStartRoomKeys.Remove(RoomKey);
+	FMixerWarmStartCache::Get().RecordChannelId(RoomKey, ChannelId);
+}
+
+bool FMixerChatConnectionManager::ForgetWarmStartChannelId(const FString& RoomId)
+{
+	const FString RoomKey = RoomId.ToLower();
+	if (WarmStartRoomKeys.Remove(RoomKey) == 0)
+	{
+		return false;
+	}
+
+	UE_LOG(LogMixerChat, Log, TEXT("Remembered channel id for chat room %s was rejected; looking it up again."), *RoomId);
+	ChannelIds.Remove(RoomKey);
+	FMixerWarmStartCache::Get().ForgetChannelId(RoomKey);
+	return true;
+}
+
+void FMixerChatConnectionManager::OnChannelInfoComplete(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, FString RoomKey)
+{
+	if (!bSucceeded || !HttpResponse.IsValid() || !EHttpResponseCodes::IsOk(HttpResponse->GetResponseCode()))
+	{
+		ChannelRequests.Remove(HttpRequest);
+		OnChannelIdParsed(RoomKey, 0);
+		return;
+	}
+
+	// The request stays listed until parsing is done, so that Reset can still abandon it
+	TWeakPtr<FMixerChatConnectionManager> WeakThis = AsShared();
+	ParseHttpResponseAsync<int32>(HttpResponse, &ParseChannelIdResponse, [WeakThis, HttpRequest, RoomKey](bool bParsed, int32& ChannelId)
+	{
+		TSharedPtr<FMixerChatConnectionManager> StrongThis = WeakThis.Pin();
+		if (StrongThis.IsValid() && StrongThis->ChannelRequests.Remove(HttpRequest) > 0)
+		{
+			StrongThis->OnChannelIdParsed(RoomKey, bParsed ? ChannelId : 0);
+		}
+	});
+}
+
+void FMixerChatConnectionManager::OnChannelIdParsed(const FString& RoomKey, int32 ChannelId)
+{
+	// Only successes are remembered so that a transient failure can be retried by the next join.
+	if (ChannelId != 0)
+	{
+		ChannelIds.Add(RoomKey, ChannelId);
+	}
+
+	TArray<FOnChannelIdResolved> Waiters;
+	if (PendingChannelLookups.RemoveAndCopyValue(RoomKey, Waiters))
+	{
+		for (FOnChannelIdResolved& Waiter : Waiters)
+		{
+			Waiter.ExecuteIfBound(ChannelId);
+		}
+	}
+}
+
+void FMixerChatConnectionManager::RankEndpoints(const TArray<FString>& Endpoints, const FString& PreferredEndpoint, FMixerEndpointSelector::FOnEndpointsRanked Callback)
+{
+	if (IsSameEndpointSet(Endpoints, RankingCandidates))
+	{
+		// Rankings in flight only have results to go on already when re-ranking a warm start ranking
+		if (RankedEndpoints.Num() > 0 && (bRankingInFlight || FPlatformTime::Seconds() - RankedEndpointsTime < RankedEndpointsLifetimeSeconds))
+		{
+			Callback.ExecuteIfBound(RankedEndpoints);
+			return;
+		}
+		else if (bRankingInFlight)
+		{
+			PendingRankingCallbacks.Add(Callback);
+			return;
+		}
+	}
+	else if (bRankingInFlight)
+	{
+		// A different server set mid-ranking is unusual enough not to be worth a second race - use discovery order.
+		Callback.ExecuteIfBound(Endpoints);
+		return;
+	}
+
+	// Last launch's ranking of the same servers is good enough to connect with; re-rank alongside so
+	// that the next launch starts from current measurements.
+	TArray<FString> WarmStartRanking;
+	if (FMixerWarmStartCache::Get().GetRankedChatEndpoints(Endpoints, WarmStartRanking))
+	{
+		RankingCandidates = Endpoints;
+		RankedEndpoints = WarmStartRanking;
+		RankedEndpointsTime = FPlatformTime::Seconds();
+		bRankingInFlight = true;
+		EndpointSelector->RankEndpoints(Endpoints, PreferredEndpoint, FMixerEndpointSelector::FOnEndpointsRanked::CreateSP(this, &FMixerChatConnectionManager::OnEndpointsRanked));
+		Callback.ExecuteIfBound(WarmStartRanking);
+		return;
+	}
+
+	RankingCandidates = Endpoints;
+	RankedEndpoints.Reset();
+	PendingRankingCallbacks.Add(Callback);
+	bRankingInFlight = true;
+	EndpointSelector->RankEndpoints(Endpoints, PreferredEndpoint, FMixerEndpointSelector::FOnEndpointsRanked::CreateSP(this, &FMixerChatConnectionManager::OnEndpointsRanked));
+}
+
+void FMixerChatConnectionManager::OnEndpointsRanked(const TArray<FString>& InRankedEndpoints)
+{
+	RankedEndpoints = InRankedEndpoints;
+	RankedEndpointsTime = FPlatformTime::Seconds();
+	bRankingInFlight = false;
+	FMixerWarmStartCache::Get().RecordRankedChatEndpoints(RankedEndpoints);
+
+	// Callbacks may join more rooms and come back in here.
+	TArray<FMixerEndpointSelector::FOnEndpointsRanked> Callbacks = MoveTemp(PendingRankingCallbacks);
+	PendingRankingCallbacks.Reset();
+	for (FMixerEndpointSelector::FOnEndpointsRanked& Callback : Callbacks)
+	{
+		Callback.ExecuteIfBound(RankedEndpoints);
+	}
+}
+
+void FMixerChatConnectionManager::Reset()
+{
+	for (FHttpRequestPtr& Request : ChannelRequests)
+	{
+		// Unbind first - cancelling completes the request synchronously on some platforms
+		Request->OnProcessRequestComplete().Unbind();
+		Request->CancelRequest();
+	}
+	ChannelRequests.Empty();
+	TMap<FString, TArray<FOnChannelIdResolved>> AbandonedLookups = MoveTemp(PendingChannelLookups);
+	PendingChannelLookups.Reset();
+	ChannelIds.Empty();
+	WarmStartRoomKeys.Empty();
+
+	EndpointSelector->Cancel();
+	RankingCandidates.Empty();
+	RankedEndpoints.Empty();
+	PendingRankingCallbacks.Empty();
+	bRankingInFlight = false;
+
+	// Waiters hear about the failure only once everything is reset, since they may start a new lookup
+	for (TPair<FString, TArray<FOnChannelIdResolved>>& Lookup : AbandonedLookups)
+	{
+		for (FOnChannelIdResolved& Waiter : Lookup.Value)
+		{
+			Waiter.ExecuteIfBound(0);
+		}
+	}
+}
+
+bool FMixerChatConnectionManager::IsSameEndpointSet(const TArray<FString>& A, const TArray<FString>& B)
+{
+	if (A.Num() != B.Num())
+	{
+		return false;
+	}
+
+	for (const FString& Endpoint : A)
+	{
+		if (!B.Contains(Endpoint))
+		{
+			return false;
+		}
+	}
+	return true;
+}
@@ -0,0 +1,76 @@
+//*********************************************************
+//
+// Copyright (c) Microsoft. All rights reserved.
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT.
+//
+//*********************************************************
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Interfaces/IHttpRequest.h"
+#include "Interfaces/IHttpResponse.h"
+#include "MixerEndpointSelector.h"
+
+/**
+* Discovery state shared by every chat connection of an FOnlineChatMixer.  Joining several rooms at
+* once issues one channel lookup per distinct room and a single endpoint ranking, with every other
+* caller waiting on (or reusing) those results instead of starting its own round trips.
+*/
+class FMixerChatConnectionManager : public TSharedFromThis<FMixerChatConnectionManager>
+{
+public:
+	DECLARE_DELEGATE_OneParam(FOnChannelIdResolved, int32 /* ChannelId, 0 on failure */);
+
+	FMixerChatConnectionManager();
+	~FMixerChatConnectionManager();
+
+	/** Look up the channel id for a room (owner user name).  Fires before returning if the id is already known. */
+	void ResolveChannelId(const FString& RoomId, FOnChannelIdResolved Callback);
+
+	/** Record a channel id learned elsewhere, e.g. the signed in user's own channel. */
+	void SeedChannelId(const FString& RoomId, int32 ChannelId);
+
+	/** Note that the service accepted the room's channel id, so that it's remembered for the next launch. */
+	void ConfirmChannelId(const FString& RoomId, int32 ChannelId);
+
+	/**
+	* Forget the room's channel id if it came from the warm start cache and hasn't been confirmed.
+	*
+	* @return	whether it did, in which case the next ResolveChannelId looks the room up afresh.
+	*/
+	bool ForgetWarmStartChannelId(const FString& RoomId);
+
+	/**
+	* Rank chat endpoints fastest first.  Concurrent requests for the same set share one ranking,
+	* and the result is reused for a while afterwards.  May fire before returning.
+	*/
+	void RankEndpoints(const TArray<FString>& Endpoints, const FString& PreferredEndpoint, FMixerEndpointSelector::FOnEndpointsRanked Callback);
+
+	/** Forget everything learned so far, e.g. on change of user. */
+	void Reset();
+
+private:
+	void OnChannelInfoComplete(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, FString RoomKey);
+	void OnChannelIdParsed(const FString& RoomKey, int32 ChannelId);
+	void OnEndpointsRanked(const TArray<FString>& InRankedEndpoints);
+
+	static bool IsSameEndpointSet(const TArray<FString>& A, const TArray<FString>& B);
+
+private:
+	// Keyed by lower case room id, since Mixer user names are case insensitive
+	TMap<FString, int32> ChannelIds;
+	TMap<FString, TArray<FOnChannelIdResolved>> PendingChannelLookups;
+	TArray<FHttpRequestPtr> ChannelRequests;
+	// Rooms whose channel id came from the warm start cache and is yet to be confirmed
+	TSet<FString> WarmStartRoomKeys;
+
+	TSharedRef<FMixerEndpointSelector> EndpointSelector;
+	TArray<FString> RankingCandidates;
+	TArray<FString> RankedEndpoints;
+	TArray<FMixerEndpointSelector::FOnEndpointsRanked> PendingRankingCallbacks;
+	double RankedEndpointsTime;
+	bool bRankingInFlight;
+};
@@ -0,0 +1,184 @@
+//*********************************************************
+//
+// Copyright (c) Microsoft. All rights reserved.
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT.
+//
+//*********************************************************
+#include "MixerChatTriggerMatcher.h"
+
+FMixerChatTriggerMatcher::FMixerChatTriggerMatcher()
+{
+	Reset();
+}
+
+void FMixerChatTriggerMatcher::Reset()
+{
+	Nodes.Reset();
+	Outputs.Reset();
+
+	FNode& Root = Nodes[Nodes.AddDefaulted()];
+	Root.Fail = 0;
+	Root.OutputLink = INDEX_NONE;
+	Root.FirstOutput = INDEX_NONE;
+}
+
+void FMixerChatTriggerMatcher::AddPattern(const FString& Pattern, EChatTriggerMatchMixer Match, int32 Key)
+{
+	if (Pattern.IsEmpty())
+	{
+		return;
+	}
+
+	int32 Node = 0;
+	for (TCHAR Char : Pattern)
+	{
+		const TCHAR Folded = FChar::ToLower(Char);
+		int32 Next = FindEdge(Node, Folded);
+		if (Next == INDEX_NONE)
+		{
+			Next = Nodes.AddDefaulted();
+			Nodes[Next].Fail = 0;
+			Nodes[Next].OutputLink = INDEX_NONE;
+			Nodes[Next].FirstOutput = INDEX_NONE;
+
+			FEdge& Edge = Nodes[Node].Edges[Nodes[Node].Edges.AddUninitialized()];
+			Edge.Char = Folded;
+			Edge.Target = Next;
+		}
+		Node = Next;
+	}
+
+	const int32 OutputIndex = Outputs.AddUninitialized();
+	FOutput& Output = Outputs[OutputIndex];
+	Output.Key = Key;
+	Output.Len = Pattern.Len();
+	Output.Match = Match;
+	Output.bBoundaryBefore = IsWordChar(Pattern[0]);
+	Output.bBoundaryAfter = IsWordChar(Pattern[Pattern.Len() - 1]);
+	Output.Next = Nodes[Node].FirstOutput;
+	Nodes[Node].FirstOutput = OutputIndex;
+}
+
+void FMixerChatTriggerMatcher::Compile()
+{
+	// Breadth first, so that every node's failure target is finished before its children need it.
+	TArray<int32> Queue;
+	Queue.Reserve(Nodes.Num());
+	for (const FEdge& Edge : Nodes[0].Edges)
+	{
+		Nodes[Edge.Target].Fail = 0;
+		Nodes[Edge.Target].OutputLink = Nodes[Edge.Target].FirstOutput != INDEX_NONE ? Edge.Target : INDEX_NONE;
+		Queue.Add(Edge.Target);
+	}
+
+	for (int32 QueueIndex = 0; QueueIndex < Queue.Num(); ++QueueIndex)
+	{
+		const int32 Node = Queue[QueueIndex];
+		for (const FEdge& Edge : Nodes[Node].Edges)
+		{
+			int32 Fail = Nodes[Node].Fail;
+			int32 FailNext = FindEdge(Fail, Edge.Char);
+			while (FailNext == INDEX_NONE && Fail != 0)
+			{
+				Fail = Nodes[Fail].Fail;
+				FailNext = FindEdge(Fail, Edge.Char);
+			}
+
+			FNode& Child = Nodes[Edge.Target];
+			Child.Fail = FailNext != INDEX_NONE ? FailNext : 0;
+			Child.OutputLink = Child.FirstOutput != INDEX_NONE ? Edge.Target : Nodes[Child.Fail].OutputLink;
+			Queue.Add(Edge.Target);
+		}
+	}
+}
+
+void FMixerChatTriggerMatcher::FindMatches(const FString& Body, TArray<FMatch, TInlineAllocator<4>>& OutMatches) const
+{
+	if (Outputs.Num() == 0)
+	{
+		return;
+	}
+
+	// Commands have to be the first thing in the message.
+	int32 FirstNonSpace = 0;
+	while (FirstNonSpace < Body.Len() && FChar::IsWhitespace(Body[FirstNonSpace]))
+	{
+		++FirstNonSpace;
+	}
+
+	const int32 BodyLen = Body.Len();
+	int32 Node = 0;
+	for (int32 i = 0; i < BodyLen; ++i)
+	{
+		const TCHAR Folded = FChar::ToLower(Body[i]);
+		int32 Next = FindEdge(Node, Folded);
+		while (Next == INDEX_NONE && Node != 0)
+		{
+			Node = Nodes[Node].Fail;
+			Next = FindEdge(Node, Folded);
+		}
+		Node = Next != INDEX_NONE ? Next : 0;
+
+		for (int32 OutputNode = Nodes[Node].OutputLink; OutputNode != INDEX_NONE; OutputNode = Nodes[Nodes[OutputNode].Fail].OutputLink)
+		{
+			for (int32 OutputIndex = Nodes[OutputNode].FirstOutput; OutputIndex != INDEX_NONE; OutputIndex = Outputs[OutputIndex].Next)
+			{
+				const FOutput& Output = Outputs[OutputIndex];
+				const int32 Start = i - Output.Len + 1;
+				const int32 End = i + 1;
+				if (Output.Match == EChatTriggerMatchMixer::Command && Start != FirstNonSpace)
+				{
+					continue;
+				}
+				if ((Output.bBoundaryBefore && Start > 0 && IsWordChar(Body[Start - 1]))
+					|| (Output.bBoundaryAfter && End < BodyLen && IsWordChar(Body[End])))
+				{
+					continue;
+				}
+				if (OutMatches.ContainsByPredicate([&Output](const FMatch& Existing) { return Existing.Key == Output.Key; }))
+				{
+					continue;
+				}
+
+				FMatch& Match = OutMatches[OutMatches.AddUninitialized()];
+				Match.Key = Output.Key;
+				Match.ArgumentsStart = End;
+				Match.ArgumentsLen = 0;
+				if (Output.Match == EChatTriggerMatchMixer::Command)
+				{
+					int32 ArgsEnd = BodyLen;
+					while (Match.ArgumentsStart < ArgsEnd && FChar::IsWhitespace(Body[Match.ArgumentsStart]))
+					{
+						++Match.ArgumentsStart;
+					}
+					while (ArgsEnd > Match.ArgumentsStart && FChar::IsWhitespace(Body[ArgsEnd - 1]))
+					{
+						--ArgsEnd;
+					}
+					Match.ArgumentsLen = ArgsEnd - Match.ArgumentsStart;
+				}
+			}
+		}
+	}
+}
+
+int32 FMixerChatTriggerMatcher::FindEdge(int32 Node, TCHAR Char) const
+{
+	// Fan-out is small for realistic trigger sets, so a linear scan beats hashing here.
+	for (const FEdge& Edge : Nodes[Node].Edges)
+	{
+		if (Edge.Char == Char)
+		{
+			return Edge.Target;
+		}
+	}
+	return INDEX_NONE;
+}
+
+bool FMixerChatTriggerMatcher::IsWordChar(TCHAR Char)
+{
+	return FChar::IsAlnum(Char) || Char == TEXT('_');
+}
@@ -0,0 +1,77 @@
+//*********************************************************
+//
+// Copyright (c) Microsoft. All rights reserved.
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT.
+//
+//*********************************************************
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OnlineChatMixer.h"
+
+/**
+* Aho-Corasick automaton over a set of case-folded trigger patterns, so that every registered
+* trigger can be found in one left-to-right pass over a message body.  Rebuilt wholesale when
+* the trigger set changes, which is rare compared to message arrival.
+*/
+class FMixerChatTriggerMatcher
+{
+public:
+	struct FMatch
+	{
+		/** Key passed to AddPattern. */
+		int32 Key;
+
+		/** Range of the body after the match, trimmed.  Only meaningful for command matches. */
+		int32 ArgumentsStart;
+		int32 ArgumentsLen;
+	};
+
+	FMixerChatTriggerMatcher();
+
+	void Reset();
+	void AddPattern(const FString& Pattern, EChatTriggerMatchMixer Match, int32 Key);
+
+	/** Compute failure links.  Must be called after the last AddPattern and before FindMatches. */
+	void Compile();
+
+	/** Append one match per key found in Body.  Keys that match more than once are reported once. */
+	void FindMatches(const FString& Body, TArray<FMatch, TInlineAllocator<4>>& OutMatches) const;
+
+private:
+	struct FEdge
+	{
+		TCHAR Char;
+		int32 Target;
+	};
+
+	struct FNode
+	{
+		TArray<FEdge, TInlineAllocator<2>> Edges;
+		int32 Fail;
+		// Nearest node along the failure chain (possibly this one) that ends a pattern, or INDEX_NONE
+		int32 OutputLink;
+		// Index into Outputs of the first pattern ending exactly here, or INDEX_NONE
+		int32 FirstOutput;
+	};
+
+	struct FOutput
+	{
+		int32 Key;
+		int32 Len;
+		EChatTriggerMatchMixer Match;
+		// Whether the pattern starts or ends with a word character, and so needs a word boundary there
+		bool bBoundaryBefore;
+		bool bBoundaryAfter;
+		int32 Next;
+	};
+
+	int32 FindEdge(int32 Node, TCHAR Char) const;
+	static bool IsWordChar(TCHAR Char);
+
+	TArray<FNode> Nodes;
+	TArray<FOutput> Outputs;
+};
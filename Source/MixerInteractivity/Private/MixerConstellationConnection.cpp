@@ -0,0 +1,133 @@
+//*********************************************************
+//
+// Copyright (c) Microsoft. All rights reserved.
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT.
+//
+//*********************************************************
+#include "MixerConstellationConnection.h"
+#include "MixerInteractivityLog.h"
+#include "MixerInteractivitySettings.h"
+#include "MixerInteractivityUserSettings.h"
+#include "MixerJsonHelpers.h"
+
+FMixerConstellationConnection::FMixerConstellationConnection(int32 InUserId, int32 InChannelId, FOnLiveEvent InOnLiveEvent)
+	: TMixerWebSocketOwnerBase<FMixerConstellationConnection>(MixerStringConstants::MessageTypes::Event, MixerStringConstants::FieldNames::Event, MixerStringConstants::FieldNames::Data)
+	, OnLiveEvent(InOnLiveEvent)
+	, NextReconnectTime(0.0)
+	, UserId(InUserId)
+	, ChannelId(InChannelId)
+	, ReconnectAttempts(0)
+	, bIsSubscribed(false)
+{
+}
+
+FMixerConstellationConnection::~FMixerConstellationConnection()
+{
+	CleanupConnection();
+}
+
+bool FMixerConstellationConnection::Init()
+{
+#if WITH_WEBSOCKETS
+	OpenWebSocket();
+	return true;
+#else
+	return false;
+#endif
+}
+
+void FMixerConstellationConnection::Tick()
+{
+	TickConnection();
+
+	if (NextReconnectTime > 0.0 && FPlatformTime::Seconds() >= NextReconnectTime)
+	{
+		NextReconnectTime = 0.0;
+		OpenWebSocket();
+	}
+}
+
+void FMixerConstellationConnection::OpenWebSocket()
+{
+	// Token is optional here, but read it fresh each time since it may have been refreshed in the background
+	TMap<FString, FString> UpgradeHeaders;
+	const FString AuthZHeader = GetDefault<UMixerInteractivityUserSettings>()->GetAuthZHeaderValue();
+	if (!AuthZHeader.IsEmpty())
+	{
+		UpgradeHeaders.Add(TEXT("Authorization"), AuthZHeader);
+	}
+
+	UE_LOG(LogMixerInteractivity, Verbose, TEXT("Opening web socket to live event service for user %d"), UserId);
+	InitConnection(TEXT("wss://constellation.mixer.com"), UpgradeHeaders);
+}
+
+void FMixerConstellationConnection::ScheduleReconnect()
+{
+	bIsSubscribed = false;
+
+	// Same backoff shape as the interactive connection.  Polling covers the gap.
+	const UMixerInteractivitySettings* Settings = GetDefault<UMixerInteractivitySettings>();
+	const float CappedDelay = FMath::Min(Settings->ReconnectMaxDelay, Settings->ReconnectBaseDelay * FMath::Pow(2.0f, static_cast<float>(ReconnectAttempts)));
+	const float Delay = CappedDelay * FMath::FRandRange(0.5f, 1.0f);
+	++ReconnectAttempts;
+
+	UE_LOG(LogMixerInteractivity, Log, TEXT("Live event connection lost; reconnect attempt %d in %.2f seconds."), ReconnectAttempts, Delay);
+	NextReconnectTime = FPlatformTime::Seconds() + Delay;
+}
+
+void FMixerConstellationConnection::HandleSocketConnected()
+{
+	TSharedRef<FJsonObject> Params = MakeShared<FJsonObject>();
+	TArray<TSharedPtr<FJsonValue>> Events;
+	Events.Add(MakeShared<FJsonValueString>(FString::Printf(TEXT("user:%d:update"), UserId)));
+	if (ChannelId != 0)
+	{
+		Events.Add(MakeShared<FJsonValueString>(FString::Printf(TEXT("channel:%d:update"), ChannelId)));
+	}
+	Params->SetArrayField(MixerStringConstants::FieldNames::Events, Events);
+	SendMethodMessageObjectParams(MixerStringConstants::MethodNames::LiveSubscribe, &FMixerConstellationConnection::HandleLiveSubscribeReply, Params);
+}
+
+void FMixerConstellationConnection::HandleSocketConnectionError()
+{
+	ScheduleReconnect();
+}
+
+void FMixerConstellationConnection::HandleSocketClosed(bool bWasClean)
+{
+	ScheduleReconnect();
+}
+
+void FMixerConstellationConnection::RegisterAllServerMessageHandlers()
+{
+	RegisterServerMessageHandler(MixerStringConstants::EventTypes::Live, &FMixerConstellationConnection::HandleLiveEvent);
+}
+
+bool FMixerConstellationConnection::HandleLiveSubscribeReply(FJsonObject* JsonObj)
+{
+	const TSharedPtr<FJsonObject>* Error;
+	if (JsonObj->TryGetObjectField(MixerStringConstants::FieldNames::Error, Error))
+	{
+		FString ErrorMessage;
+		(*Error)->TryGetStringField(MixerStringConstants::FieldNames::Message, ErrorMessage);
+		UE_LOG(LogMixerInteractivity, Warning, TEXT("Live event subscription failed: %s"), *ErrorMessage);
+		return false;
+	}
+
+	UE_LOG(LogMixerInteractivity, Log, TEXT("Subscribed to live events for user %d"), UserId);
+	bIsSubscribed = true;
+	ReconnectAttempts = 0;
+	return true;
+}
+
+bool FMixerConstellationConnection::HandleLiveEvent(FJsonObject* JsonObj)
+{
+	GET_JSON_STRING_RETURN_FAILURE(Channel, EventName);
+	GET_JSON_OBJECT_RETURN_FAILURE(Payload, Payload);
+
+	OnLiveEvent.ExecuteIfBound(EventName, *Payload->Get());
+	return true;
+}
@@ -0,0 +1,67 @@
+//*********************************************************
+//
+// Copyright (c) Microsoft. All rights reserved.
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT.
+//
+//*********************************************************
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MixerWebSocketOwnerBase.h"
+
+/**
+* Subscription to Mixer's live event service (constellation) for updates to the local
+* user and their channel, so that changes such as going live are pushed rather than polled.
+*/
+class FMixerConstellationConnection
+	: public TMixerWebSocketOwnerBase<FMixerConstellationConnection>
+	, public TSharedFromThis<FMixerConstellationConnection>
+{
+public:
+	/** Fired for each live event.  Payload holds only the fields that changed. */
+	DECLARE_DELEGATE_TwoParams(FOnLiveEvent, const FString& /* Event */, const FJsonObject& /* Payload */);
+
+	FMixerConstellationConnection(int32 InUserId, int32 InChannelId, FOnLiveEvent InOnLiveEvent);
+	virtual ~FMixerConstellationConnection();
+
+	bool Init();
+
+	/** Pump the socket and reconnect after losing it.  Call once per tick. */
+	void Tick();
+
+	/** True once the service has confirmed the subscription, until the socket is lost. */
+	bool IsSubscribed() const		{ return bIsSubscribed; }
+
+	int32 GetUserId() const			{ return UserId; }
+
+protected:
+	virtual void RegisterAllServerMessageHandlers();
+	virtual bool OnUnhandledServerMessage(const FString& MessageType, const TSharedPtr<FJsonObject> Params) { return false; }
+
+	virtual void HandleSocketConnected();
+	virtual void HandleSocketConnectionError();
+	virtual void HandleSocketClosed(bool bWasClean);
+
+#if MIXER_TRAFFIC_RECORDER_ENABLED
+	virtual EMixerTrafficChannel GetTrafficChannel() const override { return EMixerTrafficChannel::LiveEvents; }
+#endif
+	virtual EMixerFrameWorkSource GetFrameWorkSource() const override { return EMixerFrameWorkSource::LiveEvents; }
+
+private:
+	void OpenWebSocket();
+	void ScheduleReconnect();
+
+	bool HandleLiveSubscribeReply(FJsonObject* JsonObj);
+	bool HandleLiveEvent(FJsonObject* JsonObj);
+
+private:
+	FOnLiveEvent OnLiveEvent;
+	double NextReconnectTime;
+	int32 UserId;
+	int32 ChannelId;
+	int32 ReconnectAttempts;
+	bool bIsSubscribed;
+};
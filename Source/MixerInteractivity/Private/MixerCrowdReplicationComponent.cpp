@@ -0,0 +1,341 @@
+//*********************************************************
+//
+// Copyright (c) Microsoft. All rights reserved.
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT.
+//
+//*********************************************************
+#include "MixerCrowdReplicationComponent.h"
+#include "MixerInteractivityModule.h"
+#include "MixerInteractivityStats.h"
+#include "Engine/World.h"
+#include "GameFramework/GameStateBase.h"
+#include "Net/UnrealNetwork.h"
+
+DECLARE_CYCLE_STAT(TEXT("Crowd replication sample"), STAT_MixerCrowdReplicationSample, STATGROUP_MixerInteractivity);
+
+namespace
+{
+	/** Cooldown end times that move by less than this (e.g. from sampling jitter) are not resent. */
+	const float CooldownEndTolerance = 0.25f;
+
+	int8 QuantizeAxis(float Value)
+	{
+		return static_cast<int8>(FMath::RoundToInt(FMath::Clamp(Value, -1.0f, 1.0f) * 127.0f));
+	}
+
+	float DequantizeAxis(int8 Value)
+	{
+		return static_cast<float>(Value) / 127.0f;
+	}
+
+	uint16 SaturateCount(uint32 Value)
+	{
+		return static_cast<uint16>(FMath::Min<uint32>(Value, MAX_uint16));
+	}
+}
+
+UMixerCrowdReplicationComponent::UMixerCrowdReplicationComponent()
+	: bReplicatePolls(true)
+	, SampleInterval(0.1f)
+	, bStartInteractivityOnServer(true)
+	, TimeSinceSample(0.0f)
+{
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+	bReplicates = true;
+}
+
+void UMixerCrowdReplicationComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (GetOwnerRole() != ROLE_Authority || !IMixerInteractivityModule::IsAvailable())
+	{
+		return;
+	}
+
+	BuildReplicatedItems();
+
+	IMixerInteractivityModule& MixerModule = IMixerInteractivityModule::Get();
+	if (bStartInteractivityOnServer)
+	{
+		if (MixerModule.GetLoginState() == EMixerLoginState::Logged_In)
+		{
+			MixerModule.StartInteractivity();
+		}
+		else
+		{
+			LoginStateChangedHandle = MixerModule.OnLoginStateChanged().AddUObject(this, &UMixerCrowdReplicationComponent::OnLoginStateChanged);
+		}
+	}
+
+	if (bReplicatePolls)
+	{
+		TSharedPtr<IOnlineChatMixer> ChatInterface = MixerModule.GetExtendedChatInterface();
+		if (ChatInterface.IsValid())
+		{
+			PollStartHandle = ChatInterface->AddOnChatRoomPollStartDelegate_Handle(FOnChatRoomPollStartDelegate::CreateUObject(this, &UMixerCrowdReplicationComponent::OnPollChanged));
+			PollUpdateHandle = ChatInterface->AddOnChatRoomPollUpdateDelegate_Handle(FOnChatRoomPollUpdateDelegate::CreateUObject(this, &UMixerCrowdReplicationComponent::OnPollChanged));
+			PollEndHandle = ChatInterface->AddOnChatRoomPollEndDelegate_Handle(FOnChatRoomPollEndDelegate::CreateUObject(this, &UMixerCrowdReplicationComponent::OnPollEnd));
+		}
+	}
+
+	TimeSinceSample = SampleInterval;
+	SetComponentTickEnabled(Buttons.Num() > 0 || Sticks.Num() > 0 || Groups.Num() > 0);
+}
+
+void UMixerCrowdReplicationComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (IMixerInteractivityModule::IsAvailable())
+	{
+		IMixerInteractivityModule& MixerModule = IMixerInteractivityModule::Get();
+		if (LoginStateChangedHandle.IsValid())
+		{
+			MixerModule.OnLoginStateChanged().Remove(LoginStateChangedHandle);
+			LoginStateChangedHandle.Reset();
+		}
+
+		TSharedPtr<IOnlineChatMixer> ChatInterface = MixerModule.GetExtendedChatInterface();
+		if (ChatInterface.IsValid())
+		{
+			ChatInterface->ClearOnChatRoomPollStartDelegate_Handle(PollStartHandle);
+			ChatInterface->ClearOnChatRoomPollUpdateDelegate_Handle(PollUpdateHandle);
+			ChatInterface->ClearOnChatRoomPollEndDelegate_Handle(PollEndHandle);
+		}
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void UMixerCrowdReplicationComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	TimeSinceSample += DeltaTime;
+	if (TimeSinceSample >= SampleInterval)
+	{
+		TimeSinceSample = 0.0f;
+		SampleSession();
+	}
+}
+
+void UMixerCrowdReplicationComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	DOREPLIFETIME(UMixerCrowdReplicationComponent, ReplicatedButtons);
+	DOREPLIFETIME(UMixerCrowdReplicationComponent, ReplicatedSticks);
+	DOREPLIFETIME(UMixerCrowdReplicationComponent, ReplicatedGroups);
+	DOREPLIFETIME(UMixerCrowdReplicationComponent, ReplicatedPoll);
+}
+
+void UMixerCrowdReplicationComponent::BuildReplicatedItems()
+{
+	ReplicatedButtons.Items.SetNum(Buttons.Num());
+	for (int32 i = 0; i < Buttons.Num(); ++i)
+	{
+		ReplicatedButtons.Items[i].Button = Buttons[i].Name;
+		ReplicatedButtons.MarkItemDirty(ReplicatedButtons.Items[i]);
+	}
+	ReplicatedButtons.MarkArrayDirty();
+
+	ReplicatedSticks.Items.SetNum(Sticks.Num());
+	for (int32 i = 0; i < Sticks.Num(); ++i)
+	{
+		ReplicatedSticks.Items[i].Stick = Sticks[i].Name;
+		ReplicatedSticks.MarkItemDirty(ReplicatedSticks.Items[i]);
+	}
+	ReplicatedSticks.MarkArrayDirty();
+
+	ReplicatedGroups.Items.SetNum(Groups.Num());
+	for (int32 i = 0; i < Groups.Num(); ++i)
+	{
+		ReplicatedGroups.Items[i].Group = Groups[i].Name;
+		ReplicatedGroups.MarkItemDirty(ReplicatedGroups.Items[i]);
+	}
+	ReplicatedGroups.MarkArrayDirty();
+}
+
+void UMixerCrowdReplicationComponent::SampleSession()
+{
+	SCOPE_CYCLE_COUNTER(STAT_MixerCrowdReplicationSample);
+
+	IMixerInteractivityModule& MixerModule = IMixerInteractivityModule::Get();
+	if (MixerModule.GetInteractivityState() != EMixerInteractivityState::Interactive)
+	{
+		return;
+	}
+
+	const float Now = GetServerWorldTime();
+
+	// Buttons, Sticks and Groups are EditAnywhere, so they can be edited after BeginPlay (e.g. in the details panel during PIE)
+	if (!ensureMsgf(ReplicatedButtons.Items.Num() == Buttons.Num() && ReplicatedSticks.Items.Num() == Sticks.Num() && ReplicatedGroups.Items.Num() == Groups.Num(),
+		TEXT("%s: Buttons, Sticks or Groups changed after BeginPlay; rebuilding replicated crowd state"), *GetPathName()))
+	{
+		BuildReplicatedItems();
+	}
+
+	for (int32 i = 0; i < Buttons.Num(); ++i)
+	{
+		const FMixerButtonReference& Button = Buttons[i];
+		FMixerButtonState State;
+		if (!MixerModule.ResolveButton(Button.Name, Button.CachedHandle) || !MixerModule.GetButtonState(Button.CachedHandle, State))
+		{
+			continue;
+		}
+
+		FMixerReplicatedButton& Item = ReplicatedButtons.Items[i];
+		const float RemainingCooldown = static_cast<float>(State.RemainingCooldown.GetTotalSeconds());
+		float CooldownEndTime = Item.CooldownEndTime;
+		if (RemainingCooldown > 0.0f)
+		{
+			if (FMath::Abs(Now + RemainingCooldown - Item.CooldownEndTime) > CooldownEndTolerance)
+			{
+				CooldownEndTime = Now + RemainingCooldown;
+			}
+		}
+		else if (Item.CooldownEndTime > Now + CooldownEndTolerance)
+		{
+			// Cooldown was cleared early
+			CooldownEndTime = 0.0f;
+		}
+
+		const uint16 DownCount = SaturateCount(State.DownCount);
+		const uint16 PressCount = SaturateCount(State.PressCount);
+		if (Item.DownCount != DownCount || Item.PressCount != PressCount || Item.bEnabled != State.Enabled || Item.CooldownEndTime != CooldownEndTime)
+		{
+			Item.DownCount = DownCount;
+			Item.PressCount = PressCount;
+			Item.bEnabled = State.Enabled;
+			Item.CooldownEndTime = CooldownEndTime;
+			ReplicatedButtons.MarkItemDirty(Item);
+		}
+	}
+
+	for (int32 i = 0; i < Sticks.Num(); ++i)
+	{
+		const FMixerStickReference& Stick = Sticks[i];
+		FMixerStickState State;
+		if (!MixerModule.ResolveStick(Stick.Name, Stick.CachedHandle) || !MixerModule.GetStickState(Stick.CachedHandle, State))
+		{
+			continue;
+		}
+
+		FMixerReplicatedStick& Item = ReplicatedSticks.Items[i];
+		const int8 X = QuantizeAxis(State.Axes.X);
+		const int8 Y = QuantizeAxis(State.Axes.Y);
+		if (Item.X != X || Item.Y != Y)
+		{
+			Item.X = X;
+			Item.Y = Y;
+			ReplicatedSticks.MarkItemDirty(Item);
+		}
+	}
+
+	for (int32 i = 0; i < Groups.Num(); ++i)
+	{
+		FMixerReplicatedGroup& Item = ReplicatedGroups.Items[i];
+		const FName Scene = MixerModule.GetCurrentScene(Item.Group);
+		if (Item.Scene != Scene)
+		{
+			Item.Scene = Scene;
+			ReplicatedGroups.MarkItemDirty(Item);
+		}
+	}
+}
+
+float UMixerCrowdReplicationComponent::GetServerWorldTime() const
+{
+	const UWorld* World = GetWorld();
+	if (World == nullptr)
+	{
+		return 0.0f;
+	}
+
+	const AGameStateBase* GameState = World->GetGameState();
+	return GameState != nullptr ? GameState->GetServerWorldTimeSeconds() : World->GetTimeSeconds();
+}
+
+void UMixerCrowdReplicationComponent::OnLoginStateChanged(EMixerLoginState NewState)
+{
+	if (NewState == EMixerLoginState::Logged_In)
+	{
+		IMixerInteractivityModule& MixerModule = IMixerInteractivityModule::Get();
+		MixerModule.OnLoginStateChanged().Remove(LoginStateChangedHandle);
+		LoginStateChangedHandle.Reset();
+		MixerModule.StartInteractivity();
+	}
+}
+
+void UMixerCrowdReplicationComponent::OnPollChanged(const FUniqueNetId& UserId, const FChatRoomId& RoomId, const TSharedRef<FChatPollMixer>& ChatPoll)
+{
+	ReplicatedPoll.bActive = true;
+	ReplicatedPoll.Question = ChatPoll->GetQuestion();
+	ReplicatedPoll.Answers.SetNum(ChatPoll->GetNumAnswers());
+	for (int32 i = 0; i < ReplicatedPoll.Answers.Num(); ++i)
+	{
+		ReplicatedPoll.Answers[i] = ChatPoll->GetAnswer(i);
+	}
+
+	TArrayView<const int32> Tallies = ChatPoll->GetVoteTallies();
+	ReplicatedPoll.Tallies.Reset(Tallies.Num());
+	ReplicatedPoll.Tallies.Append(Tallies.GetData(), Tallies.Num());
+}
+
+void UMixerCrowdReplicationComponent::OnPollEnd(const FUniqueNetId& UserId, const FChatRoomId& RoomId, const TSharedRef<FChatPollMixer>& ChatPoll)
+{
+	// Keep the final tallies around for display
+	OnPollChanged(UserId, RoomId, ChatPoll);
+	ReplicatedPoll.bActive = false;
+}
+
+bool UMixerCrowdReplicationComponent::GetReplicatedButtonState(FMixerButtonReference Button, FTimespan& RemainingCooldown, int32& DownCount, int32& PressCount, bool& Enabled) const
+{
+	const FMixerReplicatedButton* Item = ReplicatedButtons.Items.FindByPredicate([&Button](const FMixerReplicatedButton& Candidate) { return Candidate.Button == Button.Name; });
+	if (Item == nullptr)
+	{
+		RemainingCooldown = FTimespan(0);
+		DownCount = 0;
+		PressCount = 0;
+		Enabled = false;
+		return false;
+	}
+
+	RemainingCooldown = FTimespan::FromSeconds(FMath::Max(Item->CooldownEndTime - GetServerWorldTime(), 0.0f));
+	DownCount = Item->DownCount;
+	PressCount = Item->PressCount;
+	Enabled = Item->bEnabled;
+	return true;
+}
+
+bool UMixerCrowdReplicationComponent::GetReplicatedStickState(FMixerStickReference Stick, float& XAxis, float& YAxis) const
+{
+	const FMixerReplicatedStick* Item = ReplicatedSticks.Items.FindByPredicate([&Stick](const FMixerReplicatedStick& Candidate) { return Candidate.Stick == Stick.Name; });
+	if (Item == nullptr)
+	{
+		XAxis = 0.0f;
+		YAxis = 0.0f;
+		return false;
+	}
+
+	XAxis = DequantizeAxis(Item->X);
+	YAxis = DequantizeAxis(Item->Y);
+	return true;
+}
+
+FName UMixerCrowdReplicationComponent::GetReplicatedCurrentScene(FMixerGroupReference Group) const
+{
+	const FMixerReplicatedGroup* Item = ReplicatedGroups.Items.FindByPredicate([&Group](const FMixerReplicatedGroup& Candidate) { return Candidate.Group == Group.Name; });
+	return Item != nullptr ? Item->Scene : NAME_None;
+}
+
+bool UMixerCrowdReplicationComponent::GetReplicatedPoll(FString& Question, TArray<FString>& Answers, TArray<int32>& Tallies) const
+{
+	Question = ReplicatedPoll.Question;
+	Answers = ReplicatedPoll.Answers;
+	Tallies = ReplicatedPoll.Tallies;
+	return ReplicatedPoll.bActive;
+}
@@ -0,0 +1,244 @@
+//*********************************************************
+//
+// Copyright (c) Microsoft. All rights reserved.
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT.
+//
+//*********************************************************
+
+#include "MixerCsvStats.h"
+
+#if MIXER_CSV_STATS_ENABLED
+
+#include "MixerInteractivityLog.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+CSV_DEFINE_CATEGORY(Mixer, true);
+
+volatile int32 MixerCsvStats::FrameCounters[static_cast<int32>(EMixerCsvCounter::Count)] = {};
+
+namespace
+{
+	// Log-spaced buckets from 1us, each 25% wider than the last, reaching beyond a minute at the top
+	const int32 NumDispatchBuckets = 80;
+	const double DispatchBucketBaseMs = 0.001;
+
+	struct FDispatchHistogram
+	{
+		FDispatchHistogram()
+			: NumSamples(0)
+			, TotalMs(0.0)
+			, MaxMs(0.0)
+		{
+			FMemory::Memzero(Buckets);
+		}
+
+		void Add(double Ms)
+		{
+			const int32 Bucket = Ms <= DispatchBucketBaseMs ? 0 : FMath::Min(NumDispatchBuckets - 1, FMath::CeilToInt(FMath::Loge(Ms / DispatchBucketBaseMs) / FMath::Loge(1.25)));
+			++Buckets[Bucket];
+			++NumSamples;
+			TotalMs += Ms;
+			MaxMs = FMath::Max(MaxMs, Ms);
+		}
+
+		double GetPercentile(double Fraction) const
+		{
+			uint64 Cumulative = 0;
+			for (int32 Bucket = 0; Bucket < NumDispatchBuckets; ++Bucket)
+			{
+				Cumulative += Buckets[Bucket];
+				if (Cumulative > 0 && Cumulative >= Fraction * NumSamples)
+				{
+					// Never report more than was actually seen
+					return FMath::Min(DispatchBucketBaseMs * FMath::Pow(1.25, static_cast<double>(Bucket)), MaxMs);
+				}
+			}
+			return MaxMs;
+		}
+
+		uint32 Buckets[NumDispatchBuckets];
+		uint64 NumSamples;
+		double TotalMs;
+		double MaxMs;
+	};
+
+	struct FBroadcastSummary
+	{
+		FBroadcastSummary()
+			: StartTime(0.0)
+			, NumFrames(0)
+			, PeakParticipants(0)
+			, PeakBacklog(0)
+			, bActive(false)
+			, bCaptured(false)
+		{
+			FMemory::Memzero(Totals);
+		}
+
+		FDateTime StartedAt;
+		double StartTime;
+		int64 Totals[static_cast<int32>(EMixerCsvCounter::Count)];
+		int32 NumFrames;
+		int32 PeakParticipants;
+		int32 PeakBacklog;
+		// Per message, and per frame that dispatched anything
+		FDispatchHistogram Dispatch;
+		FDispatchHistogram FrameDispatch;
+		bool bActive;
+		bool bCaptured;
+	};
+
+	FBroadcastSummary Summary;
+	volatile int32 Backlog = 0;
+	int32 ParticipantCount = 0;
+	// Game thread only, like dispatch itself
+	uint64 FrameDispatchCycles = 0;
+	FDelegateHandle EndFrameHandle;
+
+	double CyclesToMs(uint64 Cycles)
+	{
+		return static_cast<double>(Cycles) * FPlatformTime::GetSecondsPerCycle64() * 1000.0;
+	}
+
+	void OnEndFrame()
+	{
+		int32 Counts[static_cast<int32>(EMixerCsvCounter::Count)];
+		for (int32 i = 0; i < static_cast<int32>(EMixerCsvCounter::Count); ++i)
+		{
+			Counts[i] = FPlatformAtomics::InterlockedExchange(&MixerCsvStats::FrameCounters[i], 0);
+		}
+		const double DispatchMs = CyclesToMs(FrameDispatchCycles);
+		FrameDispatchCycles = 0;
+		const int32 CurrentBacklog = Backlog;
+
+		CSV_CUSTOM_STAT(Mixer, MessagesIn, Counts[static_cast<int32>(EMixerCsvCounter::MessagesIn)], ECsvCustomStatOp::Set);
+		CSV_CUSTOM_STAT(Mixer, MessagesOut, Counts[static_cast<int32>(EMixerCsvCounter::MessagesOut)], ECsvCustomStatOp::Set);
+		CSV_CUSTOM_STAT(Mixer, BytesIn, Counts[static_cast<int32>(EMixerCsvCounter::BytesIn)], ECsvCustomStatOp::Set);
+		CSV_CUSTOM_STAT(Mixer, BytesOut, Counts[static_cast<int32>(EMixerCsvCounter::BytesOut)], ECsvCustomStatOp::Set);
+		CSV_CUSTOM_STAT(Mixer, InputDispatched, Counts[static_cast<int32>(EMixerCsvCounter::InputDispatched)], ECsvCustomStatOp::Set);
+		CSV_CUSTOM_STAT(Mixer, InputDropped, Counts[static_cast<int32>(EMixerCsvCounter::InputDropped)], ECsvCustomStatOp::Set);
+		CSV_CUSTOM_STAT(Mixer, InputCoalesced, Counts[static_cast<int32>(EMixerCsvCounter::InputCoalesced)], ECsvCustomStatOp::Set);
+		CSV_CUSTOM_STAT(Mixer, ChatMessages, Counts[static_cast<int32>(EMixerCsvCounter::ChatMessages)], ECsvCustomStatOp::Set);
+		CSV_CUSTOM_STAT(Mixer, DispatchMs, static_cast<float>(DispatchMs), ECsvCustomStatOp::Set);
+		CSV_CUSTOM_STAT(Mixer, Backlog, CurrentBacklog, ECsvCustomStatOp::Set);
+		CSV_CUSTOM_STAT(Mixer, Participants, ParticipantCount, ECsvCustomStatOp::Set);
+
+		if (Summary.bActive)
+		{
+			for (int32 i = 0; i < static_cast<int32>(EMixerCsvCounter::Count); ++i)
+			{
+				Summary.Totals[i] += Counts[i];
+			}
+			if (DispatchMs > 0.0)
+			{
+				Summary.FrameDispatch.Add(DispatchMs);
+			}
+			Summary.PeakParticipants = FMath::Max(Summary.PeakParticipants, ParticipantCount);
+			Summary.PeakBacklog = FMath::Max(Summary.PeakBacklog, CurrentBacklog);
+			Summary.bCaptured |= FCsvProfiler::Get()->IsCapturing();
+			++Summary.NumFrames;
+		}
+	}
+
+	void WriteSummary(const FBroadcastSummary& Session)
+	{
+		const double Seconds = FMath::Max(FPlatformTime::Seconds() - Session.StartTime, 0.001);
+		const int64* Totals = Session.Totals;
+		const FString Header = TEXT("StartedAtUtc,DurationSeconds,Frames,PeakParticipants,PeakBacklog,")
+			TEXT("MessagesIn,MessagesOut,BytesIn,BytesOut,BytesInPerSecond,BytesOutPerSecond,")
+			TEXT("InputDispatched,InputDropped,InputCoalesced,ChatMessages,")
+			TEXT("DispatchP50Ms,DispatchP99Ms,DispatchMaxMs,FrameDispatchP99Ms,FrameDispatchMaxMs");
+		const FString Row = FString::Printf(TEXT("%s,%.1f,%d,%d,%d,%lld,%lld,%lld,%lld,%.0f,%.0f,%lld,%lld,%lld,%lld,%.3f,%.3f,%.3f,%.3f,%.3f"),
+			*Session.StartedAt.ToIso8601(), Seconds, Session.NumFrames, Session.PeakParticipants, Session.PeakBacklog,
+			Totals[static_cast<int32>(EMixerCsvCounter::MessagesIn)], Totals[static_cast<int32>(EMixerCsvCounter::MessagesOut)],
+			Totals[static_cast<int32>(EMixerCsvCounter::BytesIn)], Totals[static_cast<int32>(EMixerCsvCounter::BytesOut)],
+			Totals[static_cast<int32>(EMixerCsvCounter::BytesIn)] / Seconds, Totals[static_cast<int32>(EMixerCsvCounter::BytesOut)] / Seconds,
+			Totals[static_cast<int32>(EMixerCsvCounter::InputDispatched)], Totals[static_cast<int32>(EMixerCsvCounter::InputDropped)],
+			Totals[static_cast<int32>(EMixerCsvCounter::InputCoalesced)], Totals[static_cast<int32>(EMixerCsvCounter::ChatMessages)],
+			Session.Dispatch.GetPercentile(0.50), Session.Dispatch.GetPercentile(0.99), Session.Dispatch.MaxMs,
+			Session.FrameDispatch.GetPercentile(0.99), Session.FrameDispatch.MaxMs);
+
+		UE_LOG(LogMixerInteractivity, Log, TEXT("Mixer broadcast summary: %.0fs, peak audience %d, %lld bytes in / %lld out, dispatch p99 %.3fms (max %.3fms)."),
+			Seconds, Session.PeakParticipants, Totals[static_cast<int32>(EMixerCsvCounter::BytesIn)], Totals[static_cast<int32>(EMixerCsvCounter::BytesOut)],
+			Session.Dispatch.GetPercentile(0.99), Session.Dispatch.MaxMs);
+
+		// Alongside the captures themselves, named for when the broadcast started so it sorts in with them
+		const FString Filename = FPaths::ProfilingDir() / TEXT("CSV") / FString::Printf(TEXT("MixerBroadcast-%s.csv"), *Session.StartedAt.ToString());
+		if (!FFileHelper::SaveStringToFile(Header + LINE_TERMINATOR + Row + LINE_TERMINATOR, *Filename))
+		{
+			UE_LOG(LogMixerInteractivity, Warning, TEXT("Failed to write Mixer broadcast summary to %s."), *Filename);
+		}
+	}
+}
+
+void MixerCsvStats::AddBacklog(int32 Delta)
+{
+	FPlatformAtomics::InterlockedAdd(&Backlog, Delta);
+}
+
+void MixerCsvStats::RecordDispatch(uint64 Cycles)
+{
+	if (!IsInGameThread())
+	{
+		return;
+	}
+
+	FrameDispatchCycles += Cycles;
+	if (Summary.bActive)
+	{
+		Summary.Dispatch.Add(CyclesToMs(Cycles));
+	}
+}
+
+void MixerCsvStats::SetParticipantCount(int32 NumParticipants)
+{
+	ParticipantCount = NumParticipants;
+}
+
+void MixerCsvStats::Startup()
+{
+	if (!EndFrameHandle.IsValid())
+	{
+		EndFrameHandle = FCoreDelegates::OnEndFrame.AddStatic(&OnEndFrame);
+	}
+}
+
+void MixerCsvStats::Shutdown()
+{
+	EndSession();
+	FCoreDelegates::OnEndFrame.Remove(EndFrameHandle);
+	EndFrameHandle.Reset();
+}
+
+void MixerCsvStats::BeginSession()
+{
+	Summary = FBroadcastSummary();
+	Summary.StartedAt = FDateTime::UtcNow();
+	Summary.StartTime = FPlatformTime::Seconds();
+	Summary.bActive = true;
+	Summary.bCaptured = FCsvProfiler::Get()->IsCapturing();
+}
+
+void MixerCsvStats::EndSession()
+{
+	if (!Summary.bActive)
+	{
+		return;
+	}
+	Summary.bActive = false;
+	ParticipantCount = 0;
+
+	// Only broadcasts that overlapped a capture have anything to be correlated with
+	if (Summary.bCaptured)
+	{
+		WriteSummary(Summary);
+	}
+}
+
+#endif
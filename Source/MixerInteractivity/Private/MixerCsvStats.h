@@ -0,0 +1,106 @@
+//*********************************************************
+//
+// Copyright (c) Microsoft. All rights reserved.
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT.
+//
+//*********************************************************
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/PlatformAtomics.h"
+#include "HAL/PlatformTime.h"
+
+#if ENGINE_MINOR_VERSION >= 20
+#include "ProfilingDebugging/CsvProfiler.h"
+#endif
+
+/**
+* Per-frame Mixer values for FCsvProfiler captures, under the Mixer category: messages and bytes in
+* each direction, input dispatched, dropped and coalesced, time spent dispatching messages, inbound
+* backlog, audience size and chat messages.  When an interactive session that was captured ends, a
+* summary of the whole broadcast (peak audience, dispatch time percentiles, total bandwidth) is
+* written to Profiling/CSV alongside the capture.  Compiled in wherever the CSV profiler is.
+*/
+#ifndef MIXER_CSV_STATS_ENABLED
+#if defined(CSV_PROFILER) && CSV_PROFILER
+#define MIXER_CSV_STATS_ENABLED 1
+#else
+#define MIXER_CSV_STATS_ENABLED 0
+#endif
+#endif
+
+#if MIXER_CSV_STATS_ENABLED
+
+enum class EMixerCsvCounter : uint8
+{
+	MessagesIn,
+	MessagesOut,
+	BytesIn,
+	BytesOut,
+	InputDispatched,
+	InputDropped,
+	InputCoalesced,
+	ChatMessages,
+
+	Count
+};
+
+namespace MixerCsvStats
+{
+	/** Counts for the frame in progress.  Bumped from any thread, and collected once per engine frame. */
+	extern volatile int32 FrameCounters[static_cast<int32>(EMixerCsvCounter::Count)];
+
+	inline void Add(EMixerCsvCounter Counter, int32 Amount)
+	{
+		FPlatformAtomics::InterlockedAdd(&FrameCounters[static_cast<int32>(Counter)], Amount);
+	}
+
+	/** Messages received but not yet dispatched, across every connection. */
+	void AddBacklog(int32 Delta);
+
+	/** Time taken to dispatch one inbound message.  Only game thread dispatch is counted. */
+	void RecordDispatch(uint64 Cycles);
+
+	/** Participants in the interactive session, evicted from the cache or not. */
+	void SetParticipantCount(int32 NumParticipants);
+
+	/** Hook and unhook the end of frame collection.  Called at module startup and shutdown. */
+	void Startup();
+	void Shutdown();
+
+	/** Interactive session boundaries, which the broadcast summary covers. */
+	void BeginSession();
+	void EndSession();
+}
+
+class FMixerCsvDispatchScope
+{
+public:
+	FMixerCsvDispatchScope()
+		: StartCycles(FPlatformTime::Cycles64())
+	{
+	}
+
+	~FMixerCsvDispatchScope()
+	{
+		MixerCsvStats::RecordDispatch(FPlatformTime::Cycles64() - StartCycles);
+	}
+
+private:
+	uint64 StartCycles;
+};
+
+#define MIXER_CSV_COUNT(Counter, Amount) MixerCsvStats::Add(EMixerCsvCounter::Counter, Amount)
+#define MIXER_CSV_BACKLOG(Delta) MixerCsvStats::AddBacklog(Delta)
+#define MIXER_CSV_DISPATCH_SCOPE() FMixerCsvDispatchScope PREPROCESSOR_JOIN(MixerCsvDispatchScope, __LINE__)
+
+#else
+
+#define MIXER_CSV_COUNT(Counter, Amount)
+#define MIXER_CSV_BACKLOG(Delta)
+#define MIXER_CSV_DISPATCH_SCOPE()
+
+#endif
@@ -9,10 +9,281 @@
 //*********************************************************
 #include "MixerCustomControl.h"
 #include "MixerDynamicDelegateBinding.h"
-#include "Containers/Ticker.h"
+#include "MixerInteractivityModulePrivate.h"
+#include "MixerInteractivityStats.h"
+#include "MixerInteractivityLog.h"
+#include "MixerJsonHelpers.h"
 #include "JsonObjectConverter.h"
 #include "Engine/World.h"
 #include "Engine/BlueprintGeneratedClass.h"
+#include "UObject/UnrealType.h"
+
+DECLARE_CYCLE_STAT(TEXT("Custom control tick"), STAT_MixerCustomControlTick, STATGROUP_MixerInteractivity);
+
+/**
+* Everything about a custom control class's client-writable properties that can be worked out
+* once, rather than on every send: the JSON key for each property and a writer for its type.
+*/
+struct FMixerCustomControlSerializationPlan
+{
+	typedef TSharedPtr<FJsonValue> (*FPropertyWriter)(const UProperty* Property, const void* Value);
+
+	struct FEntry
+	{
+		UProperty* Property;
+		FString JsonKey;
+		FPropertyWriter Writer;
+
+		// Arrays and structs, which UMixerCustomControl::bSendElementDeltas can send piecemeal
+		bool bElementDiffable;
+
+		// Grid that values are snapped to under UMixerCustomControl::ClientPropertyPrecision, or 0
+		double QuantizationStep;
+
+		// For quantized structs, the float fields and their JSON keys
+		TArray<const UNumericProperty*> QuantizedFields;
+		TArray<FString> QuantizedFieldKeys;
+	};
+
+	TArray<FEntry> Entries;
+	TArray<UProperty*> Properties;
+	int32 CompactedSize;
+	bool bPlainOldDataOnly;
+
+	// Every property of the class, for applying server updates.  FString keys match case-insensitively, like FJsonObject.
+	TMap<FString, UProperty*> PropertiesByJsonKey;
+};
+
+namespace
+{
+	TSharedPtr<FJsonValue> WriteBoolProperty(const UProperty* Property, const void* Value)
+	{
+		return MakeShared<FJsonValueBoolean>(static_cast<const UBoolProperty*>(Property)->GetPropertyValue(Value));
+	}
+
+	TSharedPtr<FJsonValue> WriteFloatingPointProperty(const UProperty* Property, const void* Value)
+	{
+		return MakeShared<FJsonValueNumber>(static_cast<const UNumericProperty*>(Property)->GetFloatingPointPropertyValue(Value));
+	}
+
+	TSharedPtr<FJsonValue> WriteSignedIntProperty(const UProperty* Property, const void* Value)
+	{
+		return MakeShared<FJsonValueNumber>(static_cast<double>(static_cast<const UNumericProperty*>(Property)->GetSignedIntPropertyValue(Value)));
+	}
+
+	TSharedPtr<FJsonValue> WriteStrProperty(const UProperty* Property, const void* Value)
+	{
+		return MakeShared<FJsonValueString>(*static_cast<const FString*>(Value));
+	}
+
+	TSharedPtr<FJsonValue> WriteNameProperty(const UProperty* Property, const void* Value)
+	{
+		return MakeShared<FJsonValueString>(static_cast<const FName*>(Value)->ToString());
+	}
+
+	TSharedPtr<FJsonValue> WriteGenericProperty(const UProperty* Property, const void* Value)
+	{
+		return FJsonObjectConverter::UPropertyToJsonValue(const_cast<UProperty*>(Property), Value, 0, 0);
+	}
+
+	FMixerCustomControlSerializationPlan::FPropertyWriter SelectPropertyWriter(const UProperty* Property)
+	{
+		// Anything with special handling in FJsonObjectConverter (enums, containers, structs, text...) goes through it
+		if (Property->ArrayDim != 1)
+		{
+			return &WriteGenericProperty;
+		}
+		if (Property->IsA<UBoolProperty>())
+		{
+			return &WriteBoolProperty;
+		}
+		if (const UNumericProperty* NumericProp = Cast<const UNumericProperty>(Property))
+		{
+			if (NumericProp->IsEnum())
+			{
+				return &WriteGenericProperty;
+			}
+			if (NumericProp->IsFloatingPoint())
+			{
+				return &WriteFloatingPointProperty;
+			}
+			// Unsigned 32/64 bit values don't round trip through the signed getter
+			if (!Property->IsA<UUInt32Property>() && !Property->IsA<UUInt64Property>())
+			{
+				return &WriteSignedIntProperty;
+			}
+			return &WriteGenericProperty;
+		}
+		if (Property->IsA<UStrProperty>())
+		{
+			return &WriteStrProperty;
+		}
+		if (Property->IsA<UNameProperty>())
+		{
+			return &WriteNameProperty;
+		}
+		return &WriteGenericProperty;
+	}
+
+	/**
+	* Build the delta form of a changed array or struct property (see UMixerCustomControl::bSendElementDeltas).
+	* Returns null when most of the value changed, in which case sending it whole is no bigger.
+	*/
+	TSharedPtr<FJsonValue> WriteElementDelta(const UProperty* Property, const void* Value, const void* LastSentValue)
+	{
+		TSharedRef<FJsonObject> Delta = MakeShared<FJsonObject>();
+		if (const UArrayProperty* ArrayProp = Cast<const UArrayProperty>(Property))
+		{
+			FScriptArrayHelper Current(ArrayProp, Value);
+			FScriptArrayHelper LastSent(ArrayProp, LastSentValue);
+			const int32 CommonNum = FMath::Min(Current.Num(), LastSent.Num());
+			TSharedPtr<FJsonObject> Assignments = MakeShared<FJsonObject>();
+			for (int32 i = 0; i < CommonNum; ++i)
+			{
+				if (!ArrayProp->Inner->Identical(Current.GetRawPtr(i), LastSent.GetRawPtr(i)))
+				{
+					if (Assignments->Values.Num() * 2 >= CommonNum)
+					{
+						return nullptr;
+					}
+					Assignments->SetField(FString::FromInt(i), FJsonObjectConverter::UPropertyToJsonValue(ArrayProp->Inner, Current.GetRawPtr(i), 0, 0));
+				}
+			}
+
+			const int32 Appended = Current.Num() - CommonNum;
+			if (Appended > 0 && Appended >= CommonNum)
+			{
+				return nullptr;
+			}
+
+			if (Assignments->Values.Num() == 0 && Appended > 0)
+			{
+				// Append-only fast path: nothing before the old end changed
+				TArray<TSharedPtr<FJsonValue>> NewElements;
+				NewElements.Reserve(Appended);
+				for (int32 i = CommonNum; i < Current.Num(); ++i)
+				{
+					NewElements.Add(FJsonObjectConverter::UPropertyToJsonValue(ArrayProp->Inner, Current.GetRawPtr(i), 0, 0));
+				}
+				Delta->SetArrayField(TEXT("$append"), NewElements);
+				return MakeShared<FJsonValueObject>(Delta);
+			}
+
+			for (int32 i = CommonNum; i < Current.Num(); ++i)
+			{
+				Assignments->SetField(FString::FromInt(i), FJsonObjectConverter::UPropertyToJsonValue(ArrayProp->Inner, Current.GetRawPtr(i), 0, 0));
+			}
+			Delta->SetNumberField(TEXT("$length"), Current.Num());
+			Delta->SetObjectField(TEXT("$set"), Assignments);
+			return MakeShared<FJsonValueObject>(Delta);
+		}
+
+		const UStructProperty* StructProp = CastChecked<const UStructProperty>(Property);
+		TSharedPtr<FJsonObject> Assignments = MakeShared<FJsonObject>();
+		int32 NumFields = 0;
+		for (TFieldIterator<UProperty> It(StructProp->Struct); It; ++It)
+		{
+			++NumFields;
+			const void* FieldValue = It->ContainerPtrToValuePtr<void>(Value);
+			if (!It->Identical(FieldValue, It->ContainerPtrToValuePtr<void>(LastSentValue)))
+			{
+				Assignments->SetField(FJsonObjectConverter::StandardizeCase(It->GetName()), FJsonObjectConverter::UPropertyToJsonValue(*It, FieldValue, 0, 0));
+			}
+		}
+
+		if (Assignments->Values.Num() * 2 > NumFields)
+		{
+			return nullptr;
+		}
+		Delta->SetObjectField(TEXT("$set"), Assignments);
+		return MakeShared<FJsonValueObject>(Delta);
+	}
+
+	/** Set up quantization for an entry, if its type supports it.  Step is snapped to a power of two so that multiples of it print exactly. */
+	bool InitQuantization(FMixerCustomControlSerializationPlan::FEntry& Entry, float Precision)
+	{
+		const UProperty* Property = Entry.Property;
+		if (Property->ArrayDim != 1)
+		{
+			return false;
+		}
+
+		const UNumericProperty* NumericProp = Cast<const UNumericProperty>(Property);
+		if (NumericProp == nullptr || !NumericProp->IsFloatingPoint())
+		{
+			const UStructProperty* StructProp = Cast<const UStructProperty>(Property);
+			if (StructProp == nullptr)
+			{
+				return false;
+			}
+
+			for (TFieldIterator<UProperty> It(StructProp->Struct); It; ++It)
+			{
+				const UNumericProperty* Field = Cast<const UNumericProperty>(*It);
+				if (Field == nullptr || !Field->IsFloatingPoint() || Field->ArrayDim != 1)
+				{
+					Entry.QuantizedFields.Empty();
+					Entry.QuantizedFieldKeys.Empty();
+					return false;
+				}
+				Entry.QuantizedFields.Add(Field);
+				Entry.QuantizedFieldKeys.Add(FJsonObjectConverter::StandardizeCase(Field->GetName()));
+			}
+		}
+
+		Entry.QuantizationStep = FMath::Pow(2.0f, FMath::FloorToFloat(FMath::Log2(Precision)));
+		return true;
+	}
+
+	double Quantize(double Value, double Step)
+	{
+		return FMath::RoundToDouble(Value / Step) * Step;
+	}
+
+	bool QuantizedValuesDiffer(const FMixerCustomControlSerializationPlan::FEntry& Entry, const void* Value, const void* LastSentValue)
+	{
+		if (Entry.QuantizedFields.Num() == 0)
+		{
+			const UNumericProperty* NumericProp = static_cast<const UNumericProperty*>(Entry.Property);
+			return Quantize(NumericProp->GetFloatingPointPropertyValue(Value), Entry.QuantizationStep) != Quantize(NumericProp->GetFloatingPointPropertyValue(LastSentValue), Entry.QuantizationStep);
+		}
+
+		for (const UNumericProperty* Field : Entry.QuantizedFields)
+		{
+			const double Current = Field->GetFloatingPointPropertyValue(Field->ContainerPtrToValuePtr<void>(Value));
+			const double LastSent = Field->GetFloatingPointPropertyValue(Field->ContainerPtrToValuePtr<void>(LastSentValue));
+			if (Quantize(Current, Entry.QuantizationStep) != Quantize(LastSent, Entry.QuantizationStep))
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	TSharedPtr<FJsonValue> WriteQuantizedValue(const FMixerCustomControlSerializationPlan::FEntry& Entry, const void* Value)
+	{
+		if (Entry.QuantizedFields.Num() == 0)
+		{
+			const UNumericProperty* NumericProp = static_cast<const UNumericProperty*>(Entry.Property);
+			return MakeShared<FJsonValueNumber>(Quantize(NumericProp->GetFloatingPointPropertyValue(Value), Entry.QuantizationStep));
+		}
+
+		TSharedRef<FJsonObject> StructJson = MakeShared<FJsonObject>();
+		for (int32 i = 0; i < Entry.QuantizedFields.Num(); ++i)
+		{
+			const UNumericProperty* Field = Entry.QuantizedFields[i];
+			StructJson->SetNumberField(Entry.QuantizedFieldKeys[i], Quantize(Field->GetFloatingPointPropertyValue(Field->ContainerPtrToValuePtr<void>(Value)), Entry.QuantizationStep));
+		}
+		return MakeShared<FJsonValueObject>(StructJson);
+	}
+
+	// Game thread only
+	TMap<TWeakObjectPtr<const UClass>, TSharedPtr<const FMixerCustomControlSerializationPlan>>& GetSerializationPlans()
+	{
+		static TMap<TWeakObjectPtr<const UClass>, TSharedPtr<const FMixerCustomControlSerializationPlan>> Plans;
+		return Plans;
+	}
+}
 
 UMixerCustomControl::~UMixerCustomControl()
 {
@@ -34,17 +305,82 @@ void UMixerCustomControl::PostLoad()
 	}
 }
 
-void UMixerCustomControl::InitClientWrittenPropertyMaintenance()
+bool UMixerCustomControl::CanBeInCluster() const
 {
-	ClientWritableProperties.Empty();
-	GetClientWritableProperties(ClientWritableProperties);
+	const UClass* ControlClass = GetClass();
+	if (ControlClass->RefLink != nullptr)
+	{
+		return false;
+	}
 
-	int32 PropertyBlobRequiredSize = 0;
-	for (UProperty* ClientProp : ClientWritableProperties)
+	const UBlueprintGeneratedClass* GeneratedClass = Cast<UBlueprintGeneratedClass>(ControlClass);
+	if (GeneratedClass != nullptr && GeneratedClass->UberGraphFunction != nullptr)
 	{
-		PropertyBlobRequiredSize += ClientProp->GetSize();
+		return false;
+	}
+
+	return Super::CanBeInCluster();
+}
+
+TSharedRef<const FMixerCustomControlSerializationPlan> UMixerCustomControl::FindOrBuildSerializationPlan()
+{
+	TSharedPtr<const FMixerCustomControlSerializationPlan>& CachedPlan = GetSerializationPlans().FindOrAdd(GetClass());
+	if (!CachedPlan.IsValid())
+	{
+		TSharedRef<FMixerCustomControlSerializationPlan> NewPlan = MakeShared<FMixerCustomControlSerializationPlan>();
+		GetClientWritableProperties(NewPlan->Properties);
+		NewPlan->CompactedSize = 0;
+		NewPlan->bPlainOldDataOnly = true;
+		const UMixerCustomControl* ClassDefaults = GetClass()->GetDefaultObject<UMixerCustomControl>();
+		for (UProperty* ClientProp : NewPlan->Properties)
+		{
+			FMixerCustomControlSerializationPlan::FEntry& Entry = NewPlan->Entries[NewPlan->Entries.AddDefaulted()];
+			Entry.Property = ClientProp;
+			Entry.JsonKey = FJsonObjectConverter::StandardizeCase(ClientProp->GetName());
+			Entry.Writer = SelectPropertyWriter(ClientProp);
+			Entry.bElementDiffable = ClientProp->ArrayDim == 1 && (ClientProp->IsA<UArrayProperty>() || ClientProp->IsA<UStructProperty>());
+			Entry.QuantizationStep = 0.0;
+			const float* Precision = ClassDefaults->ClientPropertyPrecision.Find(ClientProp->GetFName());
+			if (Precision != nullptr && *Precision > 0.0f)
+			{
+				if (InitQuantization(Entry, *Precision))
+				{
+					Entry.bElementDiffable = false;
+				}
+				else
+				{
+					UE_LOG(LogMixerInteractivity, Warning, TEXT("Precision set for property %s of %s, which isn't a float or a struct of floats.  It will be sent unquantized."), *ClientProp->GetName(), *GetClass()->GetName());
+				}
+			}
+
+			NewPlan->CompactedSize += ClientProp->GetSize();
+
+			// Bitfield bools share their byte with other fields, so can't be compared bytewise
+			UBoolProperty* BoolProp = Cast<UBoolProperty>(ClientProp);
+			if (!ClientProp->HasAnyPropertyFlags(CPF_IsPlainOldData) || (BoolProp != nullptr && !BoolProp->IsNativeBool()))
+			{
+				NewPlan->bPlainOldDataOnly = false;
+			}
+		}
+
+		for (TFieldIterator<UProperty> It(GetClass()); It; ++It)
+		{
+			NewPlan->PropertiesByJsonKey.Add(It->GetName(), *It);
+		}
+
+		CachedPlan = NewPlan;
 	}
 
+	return CachedPlan.ToSharedRef();
+}
+
+void UMixerCustomControl::InitClientWrittenPropertyMaintenance()
+{
+	SerializationPlan = FindOrBuildSerializationPlan();
+	ClientWritableProperties = SerializationPlan->Properties;
+	bPlainOldDataOnly = SerializationPlan->bPlainOldDataOnly;
+
+	const int32 PropertyBlobRequiredSize = SerializationPlan->CompactedSize;
 	LastSentPropertyData.AddUninitialized(PropertyBlobRequiredSize);
 	uint8* CompactedPropertyLocation = LastSentPropertyData.GetData();
 	for (UProperty* ClientProp : ClientWritableProperties)
@@ -55,9 +391,16 @@ void UMixerCustomControl::InitClientWrittenPropertyMaintenance()
 		CompactedPropertyLocation += ClientProp->GetSize();
 	}
 
+	DirtyProperties.Init(false, ClientWritableProperties.Num());
+	GatheredPropertyData.Empty();
+	if (bPlainOldDataOnly)
+	{
+		GatheredPropertyData.AddUninitialized(PropertyBlobRequiredSize);
+	}
+
 	if (ClientWritableProperties.Num() > 0)
 	{
-		FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UMixerCustomControl::Tick), FMath::Max(ClientPropertyUpdateInterval, 0.0f));
+		static_cast<FMixerInteractivityModule&>(IMixerInteractivityModule::Get()).RegisterCustomControl(this);
 	}
 }
 
@@ -67,13 +410,15 @@ void UMixerCustomControl::GetClientWritableProperties(TArray<UProperty*>& OutPro
 	{
 		if ((Prop->HasAnyPropertyFlags(CPF_BlueprintVisible) && !Prop->HasAnyPropertyFlags(CPF_BlueprintReadOnly)))
 		{
-			ClientWritableProperties.Add(Prop);
+			OutProperties.Add(Prop);
 		}
 	}
 }
 
 bool UMixerCustomControl::Tick(float DeltaTime)
 {
+	SCOPE_CYCLE_COUNTER(STAT_MixerCustomControlTick);
+
 	UWorld* World = GetWorld();
 	check(World != nullptr);
 	if (!World->IsGameWorld())
@@ -81,31 +426,159 @@ bool UMixerCustomControl::Tick(float DeltaTime)
 		return false;
 	}
 
+	if (bResendAllProperties)
+	{
+		// Everything goes, so there's nothing to compare
+	}
+	else if (bOnlySendDirtyProperties)
+	{
+		if (DirtyProperties.Find(true) == INDEX_NONE)
+		{
+			return true;
+		}
+	}
+	else if (bPlainOldDataOnly)
+	{
+		// Cheap early out for the common case of nothing having changed
+		uint8* GatheredPropertyLocation = GatheredPropertyData.GetData();
+		for (UProperty* ClientProp : ClientWritableProperties)
+		{
+			FMemory::Memcpy(GatheredPropertyLocation, ClientProp->ContainerPtrToValuePtr<void>(this), ClientProp->GetSize());
+			GatheredPropertyLocation += ClientProp->GetSize();
+		}
+
+		if (FMemory::Memcmp(GatheredPropertyData.GetData(), LastSentPropertyData.GetData(), LastSentPropertyData.Num()) == 0)
+		{
+			return true;
+		}
+	}
+
 	TSharedPtr<FJsonObject> ControlJson;
+	TSharedPtr<FJsonObject> ElementDeltas;
 	uint8* CompactedPropertyLocation = LastSentPropertyData.GetData();
-	for (UProperty* ClientProp : ClientWritableProperties)
+	for (int32 PropertyIndex = 0; PropertyIndex < ClientWritableProperties.Num(); ++PropertyIndex)
 	{
+		UProperty* ClientProp = ClientWritableProperties[PropertyIndex];
 		void* SourcePropertyValue = ClientProp->ContainerPtrToValuePtr<void>(this);
-		if (!ClientProp->Identical(SourcePropertyValue, CompactedPropertyLocation))
+		const FMixerCustomControlSerializationPlan::FEntry& Entry = SerializationPlan->Entries[PropertyIndex];
+		bool bChanged;
+		if (bResendAllProperties)
+		{
+			bChanged = true;
+		}
+		else if (bOnlySendDirtyProperties)
+		{
+			bChanged = DirtyProperties[PropertyIndex];
+		}
+		else if (Entry.QuantizationStep > 0.0)
+		{
+			bChanged = QuantizedValuesDiffer(Entry, SourcePropertyValue, CompactedPropertyLocation);
+		}
+		else if (bPlainOldDataOnly)
+		{
+			bChanged = FMemory::Memcmp(SourcePropertyValue, CompactedPropertyLocation, ClientProp->GetSize()) != 0;
+		}
+		else
+		{
+			bChanged = !ClientProp->Identical(SourcePropertyValue, CompactedPropertyLocation);
+		}
+
+		if (bChanged)
 		{
 			if (!ControlJson.IsValid())
 			{
 				ControlJson = MakeShared<FJsonObject>();
 			}
-			ControlJson->SetField(FJsonObjectConverter::StandardizeCase(ClientProp->GetName()), FJsonObjectConverter::UPropertyToJsonValue(ClientProp, SourcePropertyValue, 0, 0));
+			TSharedPtr<FJsonValue> EncodedValue;
+			if (Entry.QuantizationStep > 0.0)
+			{
+				EncodedValue = WriteQuantizedValue(Entry, SourcePropertyValue);
+			}
+			else if (bSendElementDeltas && Entry.bElementDiffable && !bResendAllProperties)
+			{
+				// Beside the full value, never in place of it: the service stores what's sent as the property
+				TSharedPtr<FJsonValue> Delta = WriteElementDelta(ClientProp, SourcePropertyValue, CompactedPropertyLocation);
+				if (Delta.IsValid())
+				{
+					if (!ElementDeltas.IsValid())
+					{
+						ElementDeltas = MakeShared<FJsonObject>();
+					}
+					ElementDeltas->SetField(Entry.JsonKey, Delta);
+				}
+			}
+			ControlJson->SetField(Entry.JsonKey, EncodedValue.IsValid() ? EncodedValue : Entry.Writer(ClientProp, SourcePropertyValue));
 			ClientProp->CopyCompleteValue(CompactedPropertyLocation, SourcePropertyValue);
 		}
 		CompactedPropertyLocation += ClientProp->GetSize();
 	}
 
+	DirtyProperties.Init(false, ClientWritableProperties.Num());
+	bResendAllProperties = false;
+
 	if (ControlJson.IsValid())
 	{
+		if (ElementDeltas.IsValid())
+		{
+			ControlJson->SetObjectField(MixerStringConstants::FieldNames::ElementDeltas, ElementDeltas);
+		}
 		IMixerInteractivityModule::Get().UpdateRemoteControl(SceneName, ControlName, ControlJson.ToSharedRef());
 	}
 
 	return true;
 }
 
+void UMixerCustomControl::InvalidateSerializationPlan(const UClass* ForClass)
+{
+	GetSerializationPlans().Remove(ForClass);
+
+	// Drop entries for classes that have since been garbage collected
+	for (TMap<TWeakObjectPtr<const UClass>, TSharedPtr<const FMixerCustomControlSerializationPlan>>::TIterator It(GetSerializationPlans()); It; ++It)
+	{
+		if (!It->Key.IsValid())
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+void UMixerCustomControl::MarkPropertyDirty(FName PropertyName)
+{
+	for (int32 PropertyIndex = 0; PropertyIndex < ClientWritableProperties.Num(); ++PropertyIndex)
+	{
+		if (ClientWritableProperties[PropertyIndex]->GetFName() == PropertyName)
+		{
+			DirtyProperties[PropertyIndex] = true;
+			return;
+		}
+	}
+}
+
+void UMixerCustomControl::ApplyServerPropertyUpdate(const FJsonObject& UpdatedProperties)
+{
+	TSharedRef<const FMixerCustomControlSerializationPlan> Plan = FindOrBuildSerializationPlan();
+
+	TArray<UProperty*> ChangedProperties;
+	for (const TPair<FString, TSharedPtr<FJsonValue>>& UpdatedValue : UpdatedProperties.Values)
+	{
+		UProperty* const* Property = Plan->PropertiesByJsonKey.Find(UpdatedValue.Key);
+		if (Property != nullptr && UpdatedValue.Value.IsValid())
+		{
+			if (FJsonObjectConverter::JsonValueToUProperty(UpdatedValue.Value, *Property, (*Property)->ContainerPtrToValuePtr<void>(this), 0, 0))
+			{
+				ChangedProperties.Add(*Property);
+			}
+		}
+	}
+
+	NativeOnServerPropertiesUpdated(ChangedProperties);
+}
+
+void UMixerCustomControl::NativeOnServerPropertiesUpdated(const TArray<UProperty*>& ChangedProperties)
+{
+	NativeOnServerPropertiesUpdated();
+}
+
 void UMixerCustomControl::NativeOnServerPropertiesUpdated()
 {
 	OnServerPropertiesUpdated();
@@ -10,9 +10,14 @@
 
 #include "MixerDynamicDelegateBinding.h"
 #include "MixerInteractivityLog.h"
+#include "MixerInteractivityStats.h"
+#include "MixerTrace.h"
 #include "MixerBindingUtils.h"
+#include "MixerJsonArena.h"
+#include "MixerInteractivityModulePrivate.h"
 #include "MixerInteractivitySettings.h"
 #include "MixerInteractivityProjectAsset.h"
+#include "MixerProjectAssetPreloader.h"
 #include "Engine/World.h"
 #include "Dom/JsonValue.h"
 #include "Dom/JsonObject.h"
@@ -23,178 +28,936 @@
 #include "Logging/MessageLog.h"
 #include "Misc/UObjectToken.h"
 #include "Engine/BlueprintGeneratedClass.h"
+#include "Async/Async.h"
+#include "Containers/Ticker.h"
 
-TArray<TWeakObjectPtr<UMixerInteractivityBlueprintEventSource>> UMixerInteractivityBlueprintEventSource::BlueprintEventSources;
+DECLARE_CYCLE_STAT(TEXT("Blueprint event broadcast"), STAT_MixerBlueprintEvents, STATGROUP_MixerInteractivity);
+
+TMap<TWeakObjectPtr<UWorld>, TWeakObjectPtr<UMixerInteractivityBlueprintEventSource>> UMixerInteractivityBlueprintEventSource::BlueprintEventSources;
+FDelegateHandle UMixerInteractivityBlueprintEventSource::WorldCleanupHandle;
+TWeakObjectPtr<UMixerInteractivityBlueprintEventSource> UMixerInteractivityBlueprintEventSource::PersistentSource;
+
+namespace
+{
+	/** Resolved handler for one input event type on one custom control class.  A null plan records that the class has no handler. */
+	struct FCustomControlInputHandler
+	{
+		TSharedPtr<const MixerBindingUtils::FCustomEventParamPlan> ParamPlan;
+	};
+
+	typedef TMap<TWeakObjectPtr<const UClass>, TMap<FName, FCustomControlInputHandler>> FCustomControlInputHandlerCache;
+
+	FCustomControlInputHandlerCache& GetCustomControlInputHandlers()
+	{
+		static FCustomControlInputHandlerCache Handlers;
+		return Handlers;
+	}
+
+	const FCustomControlInputHandler& FindOrResolveCustomControlInputHandler(UMixerCustomControl* Control, FName EventType)
+	{
+		TMap<FName, FCustomControlInputHandler>& HandlersForClass = GetCustomControlInputHandlers().FindOrAdd(Control->GetClass());
+		FCustomControlInputHandler* Handler = HandlersForClass.Find(EventType);
+		if (Handler == nullptr)
+		{
+			Handler = &HandlersForClass.Add(EventType);
+			UFunction* HandlerMethod = Control->FindFunction(EventType);
+			if (HandlerMethod != nullptr)
+			{
+				Handler->ParamPlan = MixerBindingUtils::GetCustomEventParamPlan(HandlerMethod);
+			}
+		}
+		return *Handler;
+	}
+
+	// Parameters of the dynamic delegate signatures in MixerDynamicDelegateBinding.h, laid out as UHT lays out their UFunctions
+	struct FButtonEventParms
+	{
+		FMixerButtonReference Button;
+		int32 ParticipantId;
+		FMixerTransactionId TransactionId;
+		int32 SparkCost;
+	};
+
+	struct FButtonBatchEventParms
+	{
+		FMixerButtonReference Button;
+		TArray<int32> ParticipantIds;
+		int32 Count;
+	};
+
+	struct FParticipantEventParms
+	{
+		int32 ParticipantId;
+	};
+
+	struct FStickEventParms
+	{
+		FMixerStickReference Joystick;
+		int32 ParticipantIdOrCount;
+		float XAxis;
+		float YAxis;
+	};
+
+	struct FTextSubmittedEventParms
+	{
+		FMixerTextboxReference Textbox;
+		int32 ParticipantId;
+		FText SubmittedText;
+		FMixerTransactionId TransactionId;
+		int32 SparkCost;
+	};
+
+	struct FCustomControlInputParms
+	{
+		FMixerCustomControlReference Control;
+		FName Event;
+		int32 ParticipantId;
+	};
+
+	struct FCustomControlUpdateParms
+	{
+		FMixerCustomControlReference Control;
+	};
+
+	EMixerNativeEventCategory GetNativeEventCategory(EMixerBindingSlotType SlotType)
+	{
+		switch (SlotType)
+		{
+		case EMixerBindingSlotType::ButtonPressed:
+		case EMixerBindingSlotType::ButtonReleased:
+		case EMixerBindingSlotType::ButtonBatchedPressed:
+		case EMixerBindingSlotType::ButtonBatchedReleased:
+			return EMixerNativeEventCategory::Button;
+		case EMixerBindingSlotType::Stick:
+		case EMixerBindingSlotType::StickLatestPerParticipant:
+		case EMixerBindingSlotType::StickCrowdAverage:
+			return EMixerNativeEventCategory::Stick;
+		case EMixerBindingSlotType::TextSubmitted:
+			return EMixerNativeEventCategory::Textbox;
+		case EMixerBindingSlotType::CustomMethod:
+			return EMixerNativeEventCategory::CustomMethod;
+		case EMixerBindingSlotType::CustomControlInput:
+		case EMixerBindingSlotType::CustomControlUpdate:
+			return EMixerNativeEventCategory::CustomControl;
+		case EMixerBindingSlotType::ParticipantJoined:
+		case EMixerBindingSlotType::ParticipantLeft:
+		case EMixerBindingSlotType::ParticipantInputDisabled:
+			return EMixerNativeEventCategory::ParticipantState;
+		case EMixerBindingSlotType::BroadcastingStarted:
+		case EMixerBindingSlotType::BroadcastingStopped:
+		default:
+			return EMixerNativeEventCategory::Broadcasting;
+		}
+	}
+
+	/** Whether an event concerns a single participant, so that it can be routed to that participant's listeners. */
+	bool IsRoutable(EMixerBindingSlotType SlotType)
+	{
+		switch (SlotType)
+		{
+		case EMixerBindingSlotType::ButtonPressed:
+		case EMixerBindingSlotType::ButtonReleased:
+		case EMixerBindingSlotType::Stick:
+		case EMixerBindingSlotType::StickLatestPerParticipant:
+		case EMixerBindingSlotType::TextSubmitted:
+		case EMixerBindingSlotType::CustomControlInput:
+		case EMixerBindingSlotType::ParticipantJoined:
+		case EMixerBindingSlotType::ParticipantLeft:
+		case EMixerBindingSlotType::ParticipantInputDisabled:
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	void InvalidateCustomControlInputHandlers(const UClass* ForClass)
+	{
+		FCustomControlInputHandlerCache& Handlers = GetCustomControlInputHandlers();
+		Handlers.Remove(ForClass);
+
+		// Drop entries for classes that have since been garbage collected
+		for (FCustomControlInputHandlerCache::TIterator It(Handlers); It; ++It)
+		{
+			if (!It->Key.IsValid())
+			{
+				It.RemoveCurrent();
+			}
+		}
+	}
+}
+
+int32 FMixerBlueprintInstanceDelegates::Add(UObject* Instance, FName FunctionName)
+{
+	// A level saved with this instance bound already holds its binding; take it over rather than binding twice
+	for (int32 i = 0; i < SavedDelegates.Num(); ++i)
+	{
+		if (SavedDelegates[i].GetUObject() == Instance && SavedDelegates[i].GetFunctionName() == FunctionName)
+		{
+			SavedDelegates.RemoveAtSwap(i);
+			break;
+		}
+	}
+
+	if (Delegates.Num() == Delegates.GetMaxIndex() && Delegates.GetMaxIndex() >= CompactAtMaxIndex)
+	{
+		// No free slots: reclaim those of destroyed instances.  Their stale records can't remove a reused slot.
+		for (int32 Slot = 0; Slot < Delegates.GetMaxIndex(); ++Slot)
+		{
+			if (Delegates[Slot].GetUObject() == nullptr)
+			{
+				Delegates.RemoveAt(Slot);
+			}
+		}
+		CompactAtMaxIndex = FMath::Max(16, Delegates.Num() * 2);
+	}
+
+	FScriptDelegate Delegate;
+	Delegate.BindUFunction(Instance, FunctionName);
+	return Delegates.Add(Delegate);
+}
+
+void FMixerBlueprintInstanceDelegates::Remove(int32 Slot, const UObject* Instance)
+{
+	if (Delegates.IsValidIndex(Slot) && Delegates[Slot].GetUObject() == Instance)
+	{
+		Delegates.RemoveAt(Slot);
+	}
+}
+
+void FMixerBlueprintInstanceDelegates::Remove(const UObject* Instance, FName FunctionName)
+{
+	for (int32 i = 0; i < SavedDelegates.Num(); ++i)
+	{
+		if (SavedDelegates[i].GetUObject() == Instance && SavedDelegates[i].GetFunctionName() == FunctionName)
+		{
+			SavedDelegates.RemoveAtSwap(i);
+			break;
+		}
+	}
+}
+
+void FMixerBlueprintInstanceDelegates::AbsorbSaved(FMixerBlueprintInstanceDelegates& Other)
+{
+	SavedDelegates.Append(MoveTemp(Other.SavedDelegates));
+	Other.SavedDelegates.Reset();
+}
+
+void FMixerBlueprintInstanceDelegates::TrimDeadSaved()
+{
+	SavedDelegates.RemoveAllSwap([](const FScriptDelegate& Delegate) { return Delegate.GetUObject() == nullptr; });
+}
+
+bool FMixerBlueprintInstanceDelegates::HasLiveBindings() const
+{
+	for (const FScriptDelegate& Delegate : SavedDelegates)
+	{
+		if (Delegate.GetUObject() != nullptr)
+		{
+			return true;
+		}
+	}
+	for (const FScriptDelegate& Delegate : Delegates)
+	{
+		if (Delegate.GetUObject() != nullptr)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+void FMixerBlueprintInstanceDelegates::ProcessDelegates(void* Parms) const
+{
+	TArray<FScriptDelegate, TInlineAllocator<16>> Snapshot;
+	Snapshot.Reserve(SavedDelegates.Num() + Delegates.Num());
+	Snapshot.Append(SavedDelegates);
+	for (const FScriptDelegate& Delegate : Delegates)
+	{
+		Snapshot.Add(Delegate);
+	}
+
+	for (const FScriptDelegate& Delegate : Snapshot)
+	{
+		if (Delegate.IsBound())
+		{
+			Delegate.ProcessDelegate<UObject>(Parms);
+		}
+	}
+}
+
+bool FMixerBlueprintInstanceDelegates::Serialize(FArchive& Ar)
+{
+	// Slots don't outlive the session, so every binding is stored the same way and loads as saved
+	int32 NumDelegates = SavedDelegates.Num() + Delegates.Num();
+	Ar << NumDelegates;
+	if (Ar.IsLoading())
+	{
+		Delegates.Empty();
+		SavedDelegates.SetNum(NumDelegates);
+		for (FScriptDelegate& Delegate : SavedDelegates)
+		{
+			Ar << Delegate;
+		}
+	}
+	else
+	{
+		for (FScriptDelegate& Delegate : SavedDelegates)
+		{
+			Ar << Delegate;
+		}
+		for (FScriptDelegate& Delegate : Delegates)
+		{
+			Ar << Delegate;
+		}
+	}
+	return true;
+}
 
 UMixerInteractivityBlueprintEventSource::UMixerInteractivityBlueprintEventSource(const FObjectInitializer& Initializer)
 	: Super(Initializer)
+	, SavedBindingSubscriptions(0)
+	, WrapperGeneration(0)
+	, SweepBoundInstancesAt(64)
 {
+	FMemory::Memzero(NativeEventRefCounts);
+
 	UWorld* World = GetWorld();
 	if (World)
 	{
-		BlueprintEventSources.Add(TWeakObjectPtr<UMixerInteractivityBlueprintEventSource>(this));
-		World->ExtraReferencedObjects.Add(this);
+		// First source registered for a world wins, as with the per-world lookup below
+		TWeakObjectPtr<UMixerInteractivityBlueprintEventSource>& ExistingSource = BlueprintEventSources.FindOrAdd(World);
+		if (!ExistingSource.IsValid())
+		{
+			ExistingSource = this;
+
+			// Only the source in use needs pinning; a duplicate left in a saved level is free to go
+			World->ExtraReferencedObjects.AddUnique(this);
+		}
+
+		if (!WorldCleanupHandle.IsValid())
+		{
+			WorldCleanupHandle = FWorldDelegates::OnWorldCleanup.AddStatic(&UMixerInteractivityBlueprintEventSource::OnWorldCleanup);
+		}
 	}
 }
 
 void UMixerInteractivityBlueprintEventSource::RegisterForMixerEvents()
 {
-	// Use GetModuleChecked here to avoid unsafe non-game thread warning
-	IMixerInteractivityModule& InteractivityModule = FModuleManager::GetModuleChecked<IMixerInteractivityModule>("MixerInteractivity");
-	if (ButtonDelegates.Num() > 0)
+	// Bindings that were saved with the source hold their subscriptions for its lifetime
+	auto HoldForSavedBindings = [this](EMixerNativeEventCategory Category, bool bHaveBindings)
 	{
-		InteractivityModule.OnButtonEvent().AddUObject(this, &UMixerInteractivityBlueprintEventSource::OnButtonNativeEvent);
+		const uint32 CategoryBit = 1u << static_cast<uint32>(Category);
+		if (bHaveBindings && (SavedBindingSubscriptions & CategoryBit) == 0)
+		{
+			SavedBindingSubscriptions |= CategoryBit;
+			AcquireNativeEvent(Category);
+		}
+	};
+
+	HoldForSavedBindings(EMixerNativeEventCategory::Button, ButtonDelegates.Num() > 0);
+	HoldForSavedBindings(EMixerNativeEventCategory::Stick, StickDelegates.Num() > 0);
+	HoldForSavedBindings(EMixerNativeEventCategory::Textbox, TextboxDelegates.Num() > 0);
+	HoldForSavedBindings(EMixerNativeEventCategory::CustomControl, CustomControlDelegates.Num() > 0);
+	HoldForSavedBindings(EMixerNativeEventCategory::ParticipantState, ParticipantJoinedDelegate.IsBound() || ParticipantLeftDelegate.IsBound() || ParticipantInputDisabledDelegate.IsBound());
+	HoldForSavedBindings(EMixerNativeEventCategory::Broadcasting, BroadcastingStartedDelegate.IsBound() || BroadcastingStoppedDelegate.IsBound());
+	HoldForSavedBindings(EMixerNativeEventCategory::CustomMethod, CustomMethodDelegates.Num() > 0);
+}
+
+void UMixerInteractivityBlueprintEventSource::AcquireNativeEvent(EMixerNativeEventCategory Category)
+{
+	// Coalesced button and stick delivery needs the per-tick flush
+	if (Category == EMixerNativeEventCategory::Button || Category == EMixerNativeEventCategory::Stick)
+	{
+		AcquireNativeEvent(EMixerNativeEventCategory::CoalescedFlush);
 	}
-	if (StickDelegates.Num() > 0)
+
+	int32& RefCount = NativeEventRefCounts[static_cast<int32>(Category)];
+	if (RefCount++ == 0)
 	{
-		InteractivityModule.OnStickEvent().AddUObject(this, &UMixerInteractivityBlueprintEventSource::OnStickNativeEvent);
+		SubscribeNativeEvent(Category);
 	}
-	if (TextboxDelegates.Num() > 0)
+}
+
+void UMixerInteractivityBlueprintEventSource::ReleaseNativeEvent(EMixerNativeEventCategory Category)
+{
+	int32& RefCount = NativeEventRefCounts[static_cast<int32>(Category)];
+	if (RefCount > 0 && --RefCount == 0)
 	{
-		InteractivityModule.OnTextboxSubmitEvent().AddUObject(this, &UMixerInteractivityBlueprintEventSource::OnTextboxSubmitNativeEvent);
+		UnsubscribeNativeEvent(Category);
 	}
-	if (CustomControlDelegates.Num() > 0)
+
+	if (Category == EMixerNativeEventCategory::Button || Category == EMixerNativeEventCategory::Stick)
 	{
-		InteractivityModule.OnCustomControlInput().AddUObject(this, &UMixerInteractivityBlueprintEventSource::OnCustomControlInputNativeEvent);
-		InteractivityModule.OnCustomControlPropertyUpdate().AddUObject(this, &UMixerInteractivityBlueprintEventSource::OnCustomControlPropertyUpdateNativeEvent);
+		ReleaseNativeEvent(EMixerNativeEventCategory::CoalescedFlush);
 	}
-	if (ParticipantJoinedDelegate.IsBound() || ParticipantLeftDelegate.IsBound() || ParticipantInputDisabledDelegate.IsBound())
+}
+
+void UMixerInteractivityBlueprintEventSource::SubscribeNativeEvent(EMixerNativeEventCategory Category)
+{
+	// Use GetModuleChecked here to avoid unsafe non-game thread warning
+	IMixerInteractivityModule& InteractivityModule = FModuleManager::GetModuleChecked<IMixerInteractivityModule>("MixerInteractivity");
+	FDelegateHandle& Handle = NativeEventHandles[static_cast<int32>(Category)];
+	switch (Category)
 	{
-		InteractivityModule.OnParticipantStateChanged().AddUObject(this, &UMixerInteractivityBlueprintEventSource::OnParticipantStateChangedNativeEvent);
+	case EMixerNativeEventCategory::Button:
+		Handle = InteractivityModule.OnButtonEvent().AddUObject(this, &UMixerInteractivityBlueprintEventSource::OnButtonNativeEvent);
+		break;
+	case EMixerNativeEventCategory::Stick:
+		Handle = InteractivityModule.OnStickEvent().AddUObject(this, &UMixerInteractivityBlueprintEventSource::OnStickNativeEvent);
+		break;
+	case EMixerNativeEventCategory::Textbox:
+		Handle = InteractivityModule.OnTextboxSubmitEvent().AddUObject(this, &UMixerInteractivityBlueprintEventSource::OnTextboxSubmitNativeEvent);
+		break;
+	case EMixerNativeEventCategory::CustomControl:
+		Handle = InteractivityModule.OnCustomControlInput().AddUObject(this, &UMixerInteractivityBlueprintEventSource::OnCustomControlInputNativeEvent);
+		CustomControlPropertyUpdateHandle = InteractivityModule.OnCustomControlPropertyUpdate().AddUObject(this, &UMixerInteractivityBlueprintEventSource::OnCustomControlPropertyUpdateNativeEvent);
+		break;
+	case EMixerNativeEventCategory::ParticipantState:
+		Handle = InteractivityModule.OnParticipantStateChanged().AddUObject(this, &UMixerInteractivityBlueprintEventSource::OnParticipantStateChangedNativeEvent);
+		break;
+	case EMixerNativeEventCategory::Broadcasting:
+		Handle = InteractivityModule.OnBroadcastingStateChanged().AddUObject(this, &UMixerInteractivityBlueprintEventSource::OnBroadcastingStateChangedNativeEvent);
+		break;
+	case EMixerNativeEventCategory::CustomMethod:
+		Handle = InteractivityModule.OnCustomMethodCall().AddUObject(this, &UMixerInteractivityBlueprintEventSource::OnCustomMethodCallNativeEvent);
+		break;
+	case EMixerNativeEventCategory::CoalescedFlush:
+		Handle = static_cast<FMixerInteractivityModule&>(InteractivityModule).OnFlushCoalescedEvents().AddUObject(this, &UMixerInteractivityBlueprintEventSource::FlushCoalescedEvents);
+		break;
+	default:
+		checkNoEntry();
+		break;
 	}
-	if (BroadcastingStartedDelegate.IsBound() || BroadcastingStoppedDelegate.IsBound())
+}
+
+void UMixerInteractivityBlueprintEventSource::UnsubscribeNativeEvent(EMixerNativeEventCategory Category)
+{
+	FDelegateHandle& Handle = NativeEventHandles[static_cast<int32>(Category)];
+
+	// Nothing to do if the module has already gone away (e.g. during shutdown)
+	IMixerInteractivityModule* InteractivityModule = FModuleManager::GetModulePtr<IMixerInteractivityModule>("MixerInteractivity");
+	if (InteractivityModule != nullptr)
 	{
-		InteractivityModule.OnBroadcastingStateChanged().AddUObject(this, &UMixerInteractivityBlueprintEventSource::OnBroadcastingStateChangedNativeEvent);
+		switch (Category)
+		{
+		case EMixerNativeEventCategory::Button:
+			InteractivityModule->OnButtonEvent().Remove(Handle);
+			break;
+		case EMixerNativeEventCategory::Stick:
+			InteractivityModule->OnStickEvent().Remove(Handle);
+			break;
+		case EMixerNativeEventCategory::Textbox:
+			InteractivityModule->OnTextboxSubmitEvent().Remove(Handle);
+			break;
+		case EMixerNativeEventCategory::CustomControl:
+			InteractivityModule->OnCustomControlInput().Remove(Handle);
+			InteractivityModule->OnCustomControlPropertyUpdate().Remove(CustomControlPropertyUpdateHandle);
+			break;
+		case EMixerNativeEventCategory::ParticipantState:
+			InteractivityModule->OnParticipantStateChanged().Remove(Handle);
+			break;
+		case EMixerNativeEventCategory::Broadcasting:
+			InteractivityModule->OnBroadcastingStateChanged().Remove(Handle);
+			break;
+		case EMixerNativeEventCategory::CustomMethod:
+			InteractivityModule->OnCustomMethodCall().Remove(Handle);
+			break;
+		case EMixerNativeEventCategory::CoalescedFlush:
+			static_cast<FMixerInteractivityModule*>(InteractivityModule)->OnFlushCoalescedEvents().Remove(Handle);
+			break;
+		default:
+			checkNoEntry();
+			break;
+		}
 	}
-	if (CustomMethodDelegates.Num() > 0)
+
+	Handle.Reset();
+	if (Category == EMixerNativeEventCategory::CustomControl)
 	{
-		InteractivityModule.OnCustomMethodCall().AddUObject(this, &UMixerInteractivityBlueprintEventSource::OnCustomMethodCallNativeEvent);
+		CustomControlPropertyUpdateHandle.Reset();
 	}
 }
 
 
 UMixerInteractivityBlueprintEventSource* UMixerInteractivityBlueprintEventSource::GetBlueprintEventSource(UWorld* ForWorld)
 {
-	for (int32 i = 0; i < BlueprintEventSources.Num(); ++i)
+	const TWeakObjectPtr<UMixerInteractivityBlueprintEventSource>* ExistingSource = BlueprintEventSources.Find(ForWorld);
+	if (ExistingSource != nullptr && ExistingSource->IsValid())
+	{
+		return ExistingSource->Get();
+	}
+
+	UMixerInteractivityBlueprintEventSource* AdoptedSource = AdoptPersistentSource(ForWorld);
+	if (AdoptedSource != nullptr)
 	{
-		UMixerInteractivityBlueprintEventSource* ExistingSource = BlueprintEventSources[i].Get();
-		if (ExistingSource && ExistingSource->GetWorld() == ForWorld)
+		return AdoptedSource;
+	}
+
+	return NewObject<UMixerInteractivityBlueprintEventSource>(ForWorld);
+}
+
+void UMixerInteractivityBlueprintEventSource::ReleasePersistentSource()
+{
+	if (PersistentSource.IsValid())
+	{
+		PersistentSource->RemoveFromRoot();
+	}
+	PersistentSource.Reset();
+}
+
+void UMixerInteractivityBlueprintEventSource::OnWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources)
+{
+	TWeakObjectPtr<UMixerInteractivityBlueprintEventSource> CleanedUpSource;
+	BlueprintEventSources.RemoveAndCopyValue(World, CleanedUpSource);
+	if (CleanedUpSource.IsValid() && World->IsGameWorld() && GetDefault<UMixerInteractivitySettings>()->bPersistBlueprintEventSource)
+	{
+		CleanedUpSource->Persist(World);
+	}
+
+	// Also drop anything whose world or source was collected without a cleanup notification
+	for (TMap<TWeakObjectPtr<UWorld>, TWeakObjectPtr<UMixerInteractivityBlueprintEventSource>>::TIterator It(BlueprintEventSources); It; ++It)
+	{
+		if (!It->Key.IsValid() || !It->Value.IsValid())
 		{
-			return ExistingSource;
+			It.RemoveCurrent();
 		}
 	}
+}
 
-	return NewObject<UMixerInteractivityBlueprintEventSource>(ForWorld);
+FMixerBlueprintInstanceDelegates& UMixerInteractivityBlueprintEventSource::ResolveBindingSlot(const FMixerBindingSlot& Slot)
+{
+	// Adding a wrapper may reallocate its map, invalidating resolved pointers into it
+	auto FindOrAddWrapper = [this](auto& Wrappers, FName Name) -> auto&
+	{
+		const int32 NumBefore = Wrappers.Num();
+		auto& Wrapper = Wrappers.FindOrAdd(Name);
+		if (Wrappers.Num() != NumBefore)
+		{
+			++WrapperGeneration;
+		}
+		return Wrapper;
+	};
+
+	switch (Slot.Type)
+	{
+	case EMixerBindingSlotType::ButtonPressed:
+		return FindOrAddWrapper(ButtonDelegates, Slot.Name).PressedDelegate;
+	case EMixerBindingSlotType::ButtonReleased:
+		return FindOrAddWrapper(ButtonDelegates, Slot.Name).ReleasedDelegate;
+	case EMixerBindingSlotType::ButtonBatchedPressed:
+		return FindOrAddWrapper(ButtonDelegates, Slot.Name).BatchedPressedDelegate;
+	case EMixerBindingSlotType::ButtonBatchedReleased:
+		return FindOrAddWrapper(ButtonDelegates, Slot.Name).BatchedReleasedDelegate;
+	case EMixerBindingSlotType::Stick:
+		return FindOrAddWrapper(StickDelegates, Slot.Name).Delegate;
+	case EMixerBindingSlotType::StickLatestPerParticipant:
+		return FindOrAddWrapper(StickDelegates, Slot.Name).LatestPerParticipantDelegate;
+	case EMixerBindingSlotType::StickCrowdAverage:
+		return FindOrAddWrapper(StickDelegates, Slot.Name).CrowdDelegate;
+	case EMixerBindingSlotType::TextSubmitted:
+		return FindOrAddWrapper(TextboxDelegates, Slot.Name).SubmittedDelegate;
+	case EMixerBindingSlotType::CustomMethod:
+		return FindOrAddWrapper(CustomMethodDelegates, Slot.Name).Delegate;
+	case EMixerBindingSlotType::CustomControlInput:
+		return FindOrAddWrapper(CustomControlDelegates, Slot.Name).InputDelegate;
+	case EMixerBindingSlotType::CustomControlUpdate:
+		return FindOrAddWrapper(CustomControlDelegates, Slot.Name).UpdateDelegate;
+	case EMixerBindingSlotType::ParticipantJoined:
+		return ParticipantJoinedDelegate;
+	case EMixerBindingSlotType::ParticipantLeft:
+		return ParticipantLeftDelegate;
+	case EMixerBindingSlotType::ParticipantInputDisabled:
+		return ParticipantInputDisabledDelegate;
+	case EMixerBindingSlotType::BroadcastingStarted:
+		return BroadcastingStartedDelegate;
+	case EMixerBindingSlotType::BroadcastingStopped:
+	default:
+		return BroadcastingStoppedDelegate;
+	}
 }
 
-FMixerButtonEventDynamicDelegate* UMixerInteractivityBlueprintEventSource::GetButtonEvent(FName ButtonName, bool Pressed)
+const TArray<FMixerBlueprintInstanceDelegates*>& UMixerInteractivityBlueprintEventSource::GetResolvedPlan(const UMixerDelegateBinding* Binding, const TArray<FMixerBindingSlot>& Plan)
 {
-	FMixerButtonEventDynamicDelegateWrapper& DelegateWrapper = ButtonDelegates.FindOrAdd(ButtonName);
-	return Pressed ? &DelegateWrapper.PressedDelegate : &DelegateWrapper.ReleasedDelegate;
+	FResolvedPlan& Resolved = ResolvedPlans.FindOrAdd(Binding);
+	if (Resolved.Events.Num() != Plan.Num() || Resolved.Generation != WrapperGeneration)
+	{
+		// A second pass only finds wrappers that the first created, so this settles immediately
+		do
+		{
+			Resolved.Generation = WrapperGeneration;
+			Resolved.Events.Reset(Plan.Num());
+			for (const FMixerBindingSlot& Slot : Plan)
+			{
+				Resolved.Events.Add(&ResolveBindingSlot(Slot));
+			}
+		} while (Resolved.Generation != WrapperGeneration);
+	}
+	return Resolved.Events;
 }
 
-void UMixerInteractivityBlueprintEventSource::AddCustomMethodBinding(FName EventName, UObject* TargetObject, FName TargetFunctionName)
+void UMixerInteractivityBlueprintEventSource::SweepBoundInstances()
 {
-	FMixerCustomMethodStubDelegateWrapper& DelegateWrapper = CustomMethodDelegates.FindOrAdd(EventName);
-	FScriptDelegate SingleDelegate;
-	SingleDelegate.BindUFunction(TargetObject, TargetFunctionName);
-	DelegateWrapper.Delegate.AddUnique(SingleDelegate);
+	// Destroyed instances' slots are reclaimed by their events; only the records need dropping
+	for (TMap<FBoundInstanceKey, FBoundInstance>::TIterator It(BoundInstances); It; ++It)
+	{
+		if (!It->Key.Instance.IsValid() || !It->Key.Binding.IsValid())
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	// Routed events are per participant, so one whose instances have all gone won't be reused to reclaim its slots
+	TArray<FRoutedEventKey> DeadRoutedEvents;
+	for (const TPair<FRoutedEventKey, FMixerBlueprintInstanceDelegates>& Routed : RoutedEvents)
+	{
+		if (!Routed.Value.HasLiveBindings())
+		{
+			DeadRoutedEvents.Add(Routed.Key);
+		}
+	}
+	for (const FRoutedEventKey& Key : DeadRoutedEvents)
+	{
+		RemoveRoutedEvent(Key);
+	}
 
-	if (DelegateWrapper.FunctionPrototype == nullptr)
+	for (TMap<TWeakObjectPtr<const UMixerDelegateBinding>, FResolvedPlan>::TIterator It(ResolvedPlans); It; ++It)
 	{
-		DelegateWrapper.PrototypeReference.SetExternalMember(TargetFunctionName, TargetObject->GetClass());
-		DelegateWrapper.FunctionPrototype = DelegateWrapper.PrototypeReference.ResolveMember<UFunction>(static_cast<UClass*>(nullptr));
+		if (!It->Key.IsValid())
+		{
+			It.RemoveCurrent();
+		}
 	}
+	SweepBoundInstancesAt = FMath::Max(64, BoundInstances.Num() * 2);
 }
 
-void UMixerInteractivityBlueprintEventSource::RemoveCustomMethodBinding(FName EventName, UObject* TargetObject, FName TargetFunctionName)
+void UMixerInteractivityBlueprintEventSource::BindInstance(const UMixerDelegateBinding* Binding, const TArray<FMixerBindingSlot>& Plan, UObject* Instance)
 {
-	FMixerCustomMethodStubDelegateWrapper* DelegateWrapper = CustomMethodDelegates.Find(EventName);
-	if (DelegateWrapper != nullptr)
+	FBoundInstanceKey Key;
+	Key.Instance = Instance;
+	Key.Binding = Binding;
+	if (BoundInstances.Contains(Key))
+	{
+		return;
+	}
+
+	if (BoundInstances.Num() >= SweepBoundInstancesAt)
+	{
+		SweepBoundInstances();
+	}
+
+	const TArray<FMixerBlueprintInstanceDelegates*>& Events = GetResolvedPlan(Binding, Plan);
+	FBoundInstance& Record = BoundInstances.Add(Key);
+	Record.RoutedParticipantId = 0;
+	TArray<int32>& Slots = Record.Slots;
+	Slots.Reserve(Plan.Num());
+	for (int32 i = 0; i < Plan.Num(); ++i)
 	{
-		DelegateWrapper->Delegate.Remove(TargetObject, TargetFunctionName);
-		if (!DelegateWrapper->IsBound())
+		const FMixerBindingSlot& Slot = Plan[i];
+		AcquireNativeEvent(GetNativeEventCategory(Slot.Type));
+		Slots.Add(Events[i]->Add(Instance, Slot.TargetFunctionName));
+
+		if (Slot.Type == EMixerBindingSlotType::CustomMethod)
 		{
-			CustomMethodDelegates.Remove(EventName);
+			FMixerCustomMethodStubDelegateWrapper* DelegateWrapper = CustomMethodDelegates.Find(Slot.Name);
+			if (DelegateWrapper != nullptr && !DelegateWrapper->FunctionPrototype.IsValid())
+			{
+				DelegateWrapper->PrototypeReference.SetExternalMember(Slot.TargetFunctionName, Instance->GetClass());
+				DelegateWrapper->FunctionPrototype = DelegateWrapper->PrototypeReference.ResolveMember<UFunction>(static_cast<UClass*>(nullptr));
+			}
 		}
 	}
 }
 
-void UMixerInteractivityBlueprintEventSource::AddTextSubmittedBinding(FName TextboxName, UObject* TargetObject, FName TargetFunctionName)
+void UMixerInteractivityBlueprintEventSource::UnbindInstance(const UMixerDelegateBinding* Binding, const TArray<FMixerBindingSlot>& Plan, UObject* Instance)
 {
-	FMixerTextboxEventDynamicDelegateWrapper& DelegateWrapper = TextboxDelegates.FindOrAdd(TextboxName);
-	FScriptDelegate NewDelegate;
-	NewDelegate.BindUFunction(TargetObject, TargetFunctionName);
-	DelegateWrapper.SubmittedDelegate.AddUnique(NewDelegate);
+	FBoundInstanceKey Key;
+	Key.Instance = Instance;
+	Key.Binding = Binding;
+	FBoundInstance Record;
+	const bool bHasSlots = BoundInstances.RemoveAndCopyValue(Key, Record) && Record.Slots.Num() == Plan.Num();
+
+	const TArray<FMixerBlueprintInstanceDelegates*>& Events = GetResolvedPlan(Binding, Plan);
+	for (int32 i = 0; i < Plan.Num(); ++i)
+	{
+		if (bHasSlots && Record.RoutedParticipantId != 0 && IsRoutable(Plan[i].Type))
+		{
+			RemoveRoutedBinding(Plan[i], Instance, Record.Slots[i], Record.RoutedParticipantId);
+		}
+		else if (bHasSlots)
+		{
+			Events[i]->Remove(Record.Slots[i], Instance);
+		}
+		else
+		{
+			// Bound before the level was saved, so held by SavedBindingSubscriptions rather than by this instance
+			Events[i]->Remove(Instance, Plan[i].TargetFunctionName);
+			continue;
+		}
+
+		// Balances the acquire in BindInstance
+		ReleaseNativeEvent(GetNativeEventCategory(Plan[i].Type));
+	}
 }
 
-void UMixerInteractivityBlueprintEventSource::RemoveTextSubmittedBinding(FName TextboxName, UObject* TargetObject, FName TargetFunctionName)
+void UMixerInteractivityBlueprintEventSource::RouteInstance(const UMixerDelegateBinding* Binding, const TArray<FMixerBindingSlot>& Plan, UObject* Instance, uint32 ParticipantId)
 {
-	FMixerTextboxEventDynamicDelegateWrapper* DelegateWrapper = TextboxDelegates.Find(TextboxName);
-	if (DelegateWrapper != nullptr)
+	FBoundInstanceKey Key;
+	Key.Instance = Instance;
+	Key.Binding = Binding;
+	if (!BoundInstances.Contains(Key))
+	{
+		BindInstance(Binding, Plan, Instance);
+	}
+
+	FBoundInstance* Record = BoundInstances.Find(Key);
+	if (Record == nullptr || Record->RoutedParticipantId == ParticipantId || Record->Slots.Num() != Plan.Num())
+	{
+		return;
+	}
+
+	const TArray<FMixerBlueprintInstanceDelegates*>& Events = GetResolvedPlan(Binding, Plan);
+	for (int32 i = 0; i < Plan.Num(); ++i)
+	{
+		const FMixerBindingSlot& Slot = Plan[i];
+		if (!IsRoutable(Slot.Type))
+		{
+			continue;
+		}
+
+		if (Record->RoutedParticipantId != 0)
+		{
+			RemoveRoutedBinding(Slot, Instance, Record->Slots[i], Record->RoutedParticipantId);
+		}
+		else
+		{
+			Events[i]->Remove(Record->Slots[i], Instance);
+		}
+
+		Record->Slots[i] = ParticipantId != 0 ? AddRoutedBinding(Slot, Instance, ParticipantId) : Events[i]->Add(Instance, Slot.TargetFunctionName);
+	}
+	Record->RoutedParticipantId = ParticipantId;
+}
+
+int32 UMixerInteractivityBlueprintEventSource::AddRoutedBinding(const FMixerBindingSlot& Slot, UObject* Instance, uint32 ParticipantId)
+{
+	FRoutedEventKey Key;
+	Key.ParticipantId = ParticipantId;
+	Key.Type = Slot.Type;
+	Key.Name = Slot.Name;
+
+	FMixerBlueprintInstanceDelegates* Routed = RoutedEvents.Find(Key);
+	if (Routed == nullptr)
 	{
-		DelegateWrapper->SubmittedDelegate.Remove(TargetObject, TargetFunctionName);
-		if (!DelegateWrapper->IsBound())
+		Routed = &RoutedEvents.Add(Key);
+		// The plan was resolved before routing, so the stick's wrapper exists
+		FMixerStickEventDynamicDelegateWrapper* DelegateWrapper = Slot.Type == EMixerBindingSlotType::StickLatestPerParticipant ? StickDelegates.Find(Slot.Name) : nullptr;
+		if (DelegateWrapper != nullptr)
 		{
-			TextboxDelegates.Remove(TextboxName);
+			++DelegateWrapper->NumRoutedLatestPerParticipant;
 		}
 	}
+	return Routed->Add(Instance, Slot.TargetFunctionName);
 }
 
-FMixerStickEventDynamicDelegate* UMixerInteractivityBlueprintEventSource::GetStickEvent(FName StickName)
+void UMixerInteractivityBlueprintEventSource::RemoveRoutedBinding(const FMixerBindingSlot& Slot, UObject* Instance, int32 SlotIndex, uint32 ParticipantId)
 {
-	FMixerStickEventDynamicDelegateWrapper& DelegateWrapper = StickDelegates.FindOrAdd(StickName);
-	return &DelegateWrapper.Delegate;
+	FRoutedEventKey Key;
+	Key.ParticipantId = ParticipantId;
+	Key.Type = Slot.Type;
+	Key.Name = Slot.Name;
+
+	FMixerBlueprintInstanceDelegates* Routed = RoutedEvents.Find(Key);
+	if (Routed != nullptr)
+	{
+		Routed->Remove(SlotIndex, Instance);
+		if (!Routed->IsBound())
+		{
+			RemoveRoutedEvent(Key);
+		}
+	}
 }
 
-FMixerCustomControlInputDynamicDelegate& UMixerInteractivityBlueprintEventSource::GetCustomControlInputEvent(FName ControlName)
+void UMixerInteractivityBlueprintEventSource::RemoveRoutedEvent(const FRoutedEventKey& Key)
 {
-	return CustomControlDelegates.FindOrAdd(ControlName).InputDelegate;
+	RoutedEvents.Remove(Key);
+	if (Key.Type == EMixerBindingSlotType::StickLatestPerParticipant)
+	{
+		FMixerStickEventDynamicDelegateWrapper* DelegateWrapper = StickDelegates.Find(Key.Name);
+		if (DelegateWrapper != nullptr && DelegateWrapper->NumRoutedLatestPerParticipant > 0)
+		{
+			--DelegateWrapper->NumRoutedLatestPerParticipant;
+		}
+	}
 }
 
-FMixerCustomControlUpdateDynamicDelegate& UMixerInteractivityBlueprintEventSource::GetCustomControlUpdateEvent(FName ControlName)
+void UMixerInteractivityBlueprintEventSource::ProcessRoutedDelegates(EMixerBindingSlotType Type, FName Name, uint32 ParticipantId, void* Parms) const
 {
-	return CustomControlDelegates.FindOrAdd(ControlName).UpdateDelegate;
+	if (RoutedEvents.Num() > 0)
+	{
+		FRoutedEventKey Key;
+		Key.ParticipantId = ParticipantId;
+		Key.Type = Type;
+		Key.Name = Name;
+		const FMixerBlueprintInstanceDelegates* Routed = RoutedEvents.Find(Key);
+		if (Routed != nullptr)
+		{
+			Routed->ProcessDelegates(Parms);
+		}
+	}
 }
 
 void UMixerInteractivityBlueprintEventSource::OnButtonNativeEvent(FName ButtonName, TSharedPtr<const FMixerRemoteUser> Participant, const FMixerButtonEventDetails& Details)
 {
+	SCOPE_CYCLE_COUNTER(STAT_MixerBlueprintEvents);
+	MIXER_TRACE_SCOPE("Blueprint", ButtonName.ToString(), INDEX_NONE);
+
 	FMixerButtonEventDynamicDelegateWrapper* DelegateWrapper = ButtonDelegates.Find(ButtonName);
 	if (DelegateWrapper)
 	{
-		FMixerButtonReference ButtonRef;
-		ButtonRef.Name = ButtonName;
-		FMixerButtonEventDynamicDelegate& DelegateToFire = Details.Pressed ? DelegateWrapper->PressedDelegate : DelegateWrapper->ReleasedDelegate;
-		FMixerTransactionId TransactionId;
-		TransactionId.Id = Details.TransactionId;
-		DelegateToFire.Broadcast(ButtonRef, static_cast<int32>(Participant->Id), TransactionId, static_cast<int32>(Details.SparkCost));
+		// Gather for the batched event first, since handlers may bind events that move DelegateWrapper
+		if ((Details.Pressed ? DelegateWrapper->BatchedPressedDelegate : DelegateWrapper->BatchedReleasedDelegate).IsBound())
+		{
+			FMixerButtonEventDynamicDelegateWrapper::FPendingBatch& Batch = Details.Pressed ? DelegateWrapper->PendingPressed : DelegateWrapper->PendingReleased;
+			const int32 ParticipantId = static_cast<int32>(Participant->Id);
+			bool bAlreadySeen = false;
+			Batch.SeenParticipants.Add(ParticipantId, &bAlreadySeen);
+			if (!bAlreadySeen)
+			{
+				Batch.ParticipantIds.Add(ParticipantId);
+			}
+			++Batch.Count;
+		}
+
+		FButtonEventParms Parms;
+		Parms.Button.Name = ButtonName;
+		Parms.ParticipantId = static_cast<int32>(Participant->Id);
+		Parms.TransactionId.Id = Details.TransactionId;
+		Parms.SparkCost = static_cast<int32>(Details.SparkCost);
+		(Details.Pressed ? DelegateWrapper->PressedDelegate : DelegateWrapper->ReleasedDelegate).ProcessDelegates(&Parms);
+		ProcessRoutedDelegates(Details.Pressed ? EMixerBindingSlotType::ButtonPressed : EMixerBindingSlotType::ButtonReleased, ButtonName, Participant->Id, &Parms);
 	}
 }
 
 void UMixerInteractivityBlueprintEventSource::OnStickNativeEvent(FName StickName, TSharedPtr<const FMixerRemoteUser> Participant, FVector2D StickValue)
 {
+	SCOPE_CYCLE_COUNTER(STAT_MixerBlueprintEvents);
+	MIXER_TRACE_SCOPE("Blueprint", StickName.ToString(), INDEX_NONE);
+
 	FMixerStickEventDynamicDelegateWrapper* DelegateWrapper = StickDelegates.Find(StickName);
 	if (DelegateWrapper)
 	{
-		FMixerStickReference StickRef;
-		StickRef.Name = StickName;
-		DelegateWrapper->Delegate.Broadcast(StickRef, static_cast<int32>(Participant->Id), StickValue.X, StickValue.Y);
+		if (DelegateWrapper->IsCoalescedBound())
+		{
+			DelegateWrapper->PendingValues.Add(Participant->Id, StickValue);
+		}
+
+		FStickEventParms Parms;
+		Parms.Joystick.Name = StickName;
+		Parms.ParticipantIdOrCount = static_cast<int32>(Participant->Id);
+		Parms.XAxis = StickValue.X;
+		Parms.YAxis = StickValue.Y;
+		DelegateWrapper->Delegate.ProcessDelegates(&Parms);
+		ProcessRoutedDelegates(EMixerBindingSlotType::Stick, StickName, Participant->Id, &Parms);
+	}
+}
+
+void UMixerInteractivityBlueprintEventSource::FlushCoalescedEvents()
+{
+	SCOPE_CYCLE_COUNTER(STAT_MixerBlueprintEvents);
+	MIXER_TRACE_SCOPE("Blueprint", TEXT("coalesced sticks"), INDEX_NONE);
+
+	// Handlers may spawn actors that bind new events, so don't hold on to anything inside StickDelegates while broadcasting
+	TArray<FName, TInlineAllocator<8>> SticksToFlush;
+	for (TMap<FName, FMixerStickEventDynamicDelegateWrapper>::TConstIterator It(StickDelegates); It; ++It)
+	{
+		if (It->Value.PendingValues.Num() > 0)
+		{
+			SticksToFlush.Add(It->Key);
+		}
+	}
+
+	TArray<FName, TInlineAllocator<8>> ButtonsToFlush;
+	for (TMap<FName, FMixerButtonEventDynamicDelegateWrapper>::TConstIterator It(ButtonDelegates); It; ++It)
+	{
+		if (It->Value.PendingPressed.Count > 0 || It->Value.PendingReleased.Count > 0)
+		{
+			ButtonsToFlush.Add(It->Key);
+		}
+	}
+
+	for (FName ButtonName : ButtonsToFlush)
+	{
+		for (bool bPressed : { true, false })
+		{
+			FMixerButtonEventDynamicDelegateWrapper* DelegateWrapper = ButtonDelegates.Find(ButtonName);
+			check(DelegateWrapper != nullptr);
+
+			FMixerButtonEventDynamicDelegateWrapper::FPendingBatch& Batch = bPressed ? DelegateWrapper->PendingPressed : DelegateWrapper->PendingReleased;
+			if (Batch.Count > 0)
+			{
+				FButtonBatchEventParms Parms;
+				Parms.Button.Name = ButtonName;
+				Parms.ParticipantIds = MoveTemp(Batch.ParticipantIds);
+				Parms.Count = Batch.Count;
+				Batch.SeenParticipants.Reset();
+				Batch.Count = 0;
+
+				(bPressed ? DelegateWrapper->BatchedPressedDelegate : DelegateWrapper->BatchedReleasedDelegate).ProcessDelegates(&Parms);
+			}
+		}
+	}
+
+	for (FName StickName : SticksToFlush)
+	{
+		FMixerStickEventDynamicDelegateWrapper* DelegateWrapper = StickDelegates.Find(StickName);
+		check(DelegateWrapper != nullptr);
+
+		TMap<uint32, FVector2D> Values = MoveTemp(DelegateWrapper->PendingValues);
+		const FMixerBlueprintInstanceDelegates LatestPerParticipantDelegate = DelegateWrapper->LatestPerParticipantDelegate;
+		const FMixerBlueprintInstanceDelegates CrowdDelegate = DelegateWrapper->CrowdDelegate;
+
+		FStickEventParms Parms;
+		Parms.Joystick.Name = StickName;
+		FVector2D Sum = FVector2D::ZeroVector;
+		for (const TPair<uint32, FVector2D>& Value : Values)
+		{
+			Parms.ParticipantIdOrCount = static_cast<int32>(Value.Key);
+			Parms.XAxis = Value.Value.X;
+			Parms.YAxis = Value.Value.Y;
+			LatestPerParticipantDelegate.ProcessDelegates(&Parms);
+			ProcessRoutedDelegates(EMixerBindingSlotType::StickLatestPerParticipant, StickName, Value.Key, &Parms);
+			Sum += Value.Value;
+		}
+
+		const FVector2D Average = Sum / static_cast<float>(Values.Num());
+		Parms.ParticipantIdOrCount = Values.Num();
+		Parms.XAxis = Average.X;
+		Parms.YAxis = Average.Y;
+		CrowdDelegate.ProcessDelegates(&Parms);
 	}
 }
 
 void UMixerInteractivityBlueprintEventSource::OnParticipantStateChangedNativeEvent(TSharedPtr<const FMixerRemoteUser> Participant, EMixerInteractivityParticipantState NewState)
 {
+	SCOPE_CYCLE_COUNTER(STAT_MixerBlueprintEvents);
+	MIXER_TRACE_SCOPE("Blueprint", TEXT("participant"), INDEX_NONE);
+
 	check(Participant.IsValid());
+	FParticipantEventParms Parms;
+	Parms.ParticipantId = static_cast<int32>(Participant->Id);
 	switch (NewState)
 	{
 	case EMixerInteractivityParticipantState::Joined:
-		ParticipantJoinedDelegate.Broadcast(static_cast<int32>(Participant->Id));
+		ParticipantJoinedDelegate.ProcessDelegates(&Parms);
+		ProcessRoutedDelegates(EMixerBindingSlotType::ParticipantJoined, NAME_None, Participant->Id, &Parms);
 		break;
 	case EMixerInteractivityParticipantState::Left:
-		ParticipantLeftDelegate.Broadcast(static_cast<int32>(Participant->Id));
+		ParticipantLeftDelegate.ProcessDelegates(&Parms);
+		ProcessRoutedDelegates(EMixerBindingSlotType::ParticipantLeft, NAME_None, Participant->Id, &Parms);
 		break;
 	case EMixerInteractivityParticipantState::Input_Disabled:
-		ParticipantInputDisabledDelegate.Broadcast(static_cast<int32>(Participant->Id));
+		ParticipantInputDisabledDelegate.ProcessDelegates(&Parms);
+		ProcessRoutedDelegates(EMixerBindingSlotType::ParticipantInputDisabled, NAME_None, Participant->Id, &Parms);
 		break;
 	default:
 		UE_LOG(LogMixerInteractivity, Warning, TEXT("Received participant state changed event with unknown state %d"), static_cast<uint8>(NewState));
@@ -204,25 +967,30 @@ void UMixerInteractivityBlueprintEventSource::OnParticipantStateChangedNativeEve
 
 void UMixerInteractivityBlueprintEventSource::OnBroadcastingStateChangedNativeEvent(bool NewBroadcastingState)
 {
+	SCOPE_CYCLE_COUNTER(STAT_MixerBlueprintEvents);
+	MIXER_TRACE_SCOPE("Blueprint", TEXT("broadcasting"), INDEX_NONE);
+
 	if (NewBroadcastingState)
 	{
-		BroadcastingStartedDelegate.Broadcast();
+		BroadcastingStartedDelegate.ProcessDelegates(nullptr);
 	}
 	else
 	{
-		BroadcastingStoppedDelegate.Broadcast();
+		BroadcastingStoppedDelegate.ProcessDelegates(nullptr);
 	}
 }
 
 void UMixerInteractivityBlueprintEventSource::OnCustomMethodCallNativeEvent(FName MethodName, const TSharedPtr<FJsonObject> MethodParams)
 {
+	SCOPE_CYCLE_COUNTER(STAT_MixerBlueprintEvents);
+	MIXER_TRACE_SCOPE("Blueprint", MethodName.ToString(), INDEX_NONE);
+
 	UFunction* FunctionPrototype = nullptr;
-	const FMulticastScriptDelegate* BlueprintEvent = nullptr;
-	const FMulticastScriptDelegate* NativeEvent = nullptr;
+	const FMixerBlueprintInstanceDelegates* BlueprintEvent = nullptr;
 	FMixerCustomMethodStubDelegateWrapper* DelegateWrapper = CustomMethodDelegates.Find(MethodName);
 	if (DelegateWrapper != nullptr)
 	{
-		FunctionPrototype = DelegateWrapper->FunctionPrototype;
+		FunctionPrototype = DelegateWrapper->FunctionPrototype.Get();
 		BlueprintEvent = &DelegateWrapper->Delegate;
 	}
 
@@ -231,29 +999,35 @@ void UMixerInteractivityBlueprintEventSource::OnCustomMethodCallNativeEvent(FNam
 		void* ParamStorage = FMemory_Alloca(FunctionPrototype->ParmsSize);
 		if (ParamStorage != nullptr)
 		{
-			MixerBindingUtils::ExtractCustomEventParamsFromMessage(MethodParams.Get(), FunctionPrototype, ParamStorage, FunctionPrototype->ParmsSize);
-			BlueprintEvent->ProcessMulticastDelegate<UObject>(ParamStorage);
-			MixerBindingUtils::DestroyCustomEventParams(FunctionPrototype, ParamStorage, FunctionPrototype->ParmsSize);
+			TSharedRef<const MixerBindingUtils::FCustomEventParamPlan> ParamPlan = MixerBindingUtils::GetCustomEventParamPlan(FunctionPrototype);
+			MixerBindingUtils::ExtractCustomEventParams(MethodParams.Get(), *ParamPlan, ParamStorage);
+			BlueprintEvent->ProcessDelegates(ParamStorage);
+			MixerBindingUtils::DestroyCustomEventParams(*ParamPlan, ParamStorage);
 		}
 	}
 }
 
 void UMixerInteractivityBlueprintEventSource::OnCustomControlInputNativeEvent(FName ControlName, FName EventType, TSharedPtr<const FMixerRemoteUser> Participant, const TSharedRef<FJsonObject> EventPayload)
 {
+	SCOPE_CYCLE_COUNTER(STAT_MixerBlueprintEvents);
+	MIXER_TRACE_SCOPE("Blueprint", ControlName.ToString(), INDEX_NONE);
+
 	FMixerCustomControlDelegateWrapper* Wrapper = CustomControlDelegates.Find(ControlName);
 	if (Wrapper != nullptr)
 	{
 		if (Wrapper->MappedControl != nullptr)
 		{
-			UFunction* HandlerMethod = Wrapper->MappedControl->FindFunction(EventType);
-			if (HandlerMethod != nullptr)
+			// Hold our own reference since the handler may dispatch further events that grow the cache
+			TSharedPtr<const MixerBindingUtils::FCustomEventParamPlan> ParamPlanPtr = FindOrResolveCustomControlInputHandler(Wrapper->MappedControl, EventType).ParamPlan;
+			if (ParamPlanPtr.IsValid())
 			{
-				void* ParamStorage = FMemory_Alloca(HandlerMethod->ParmsSize);
+				const MixerBindingUtils::FCustomEventParamPlan& ParamPlan = *ParamPlanPtr;
+				void* ParamStorage = FMemory_Alloca(ParamPlan.Function->ParmsSize);
 				if (ParamStorage != nullptr)
 				{
-					MixerBindingUtils::ExtractCustomEventParamsFromMessage(&EventPayload.Get(), HandlerMethod, ParamStorage, HandlerMethod->ParmsSize);
-					Wrapper->MappedControl->ProcessEvent(HandlerMethod, ParamStorage);
-					MixerBindingUtils::DestroyCustomEventParams(HandlerMethod, ParamStorage, HandlerMethod->ParmsSize);
+					MixerBindingUtils::ExtractCustomEventParams(&EventPayload.Get(), ParamPlan, ParamStorage);
+					Wrapper->MappedControl->ProcessEvent(ParamPlan.Function, ParamStorage);
+					MixerBindingUtils::DestroyCustomEventParams(ParamPlan, ParamStorage);
 				}
 			}
 			else
@@ -261,24 +1035,32 @@ void UMixerInteractivityBlueprintEventSource::OnCustomControlInputNativeEvent(FN
 				UE_LOG(LogMixerInteractivity, Warning, TEXT("Received unknown input event %s for custom control %s.  Event will be ignored.  Provide a UFUNCTION matching the event name in order to handle this event."), *EventType.ToString(), *ControlName.ToString());
 			}
 		}
-		else if (Wrapper->InputDelegate.IsBound())
+		else if (Wrapper->InputDelegate.IsBound() || (RoutedEvents.Num() > 0 && Participant.IsValid()))
 		{
-			FMixerCustomControlReference ControlRef;
-			ControlRef.Name = ControlName;
-			Wrapper->InputDelegate.Broadcast(ControlRef, EventType, Participant.IsValid() ? static_cast<int32>(Participant->Id) : 0);
+			FCustomControlInputParms Parms;
+			Parms.Control.Name = ControlName;
+			Parms.Event = EventType;
+			Parms.ParticipantId = Participant.IsValid() ? static_cast<int32>(Participant->Id) : 0;
+			Wrapper->InputDelegate.ProcessDelegates(&Parms);
+			if (Participant.IsValid())
+			{
+				ProcessRoutedDelegates(EMixerBindingSlotType::CustomControlInput, ControlName, Participant->Id, &Parms);
+			}
 		}
 	}
 }
 
 void UMixerInteractivityBlueprintEventSource::OnCustomControlPropertyUpdateNativeEvent(FName ControlName, const TSharedRef<FJsonObject> UpdatedProperties)
 {
+	SCOPE_CYCLE_COUNTER(STAT_MixerBlueprintEvents);
+	MIXER_TRACE_SCOPE("Blueprint", ControlName.ToString(), INDEX_NONE);
+
 	FMixerCustomControlDelegateWrapper* Wrapper = CustomControlDelegates.Find(ControlName);
 	if (Wrapper != nullptr)
 	{
 		if (Wrapper->MappedControl != nullptr)
 		{
-			FJsonObjectConverter::JsonObjectToUStruct(UpdatedProperties, Wrapper->MappedControl->GetClass(), Wrapper->MappedControl);
-			Wrapper->MappedControl->NativeOnServerPropertiesUpdated();
+			Wrapper->MappedControl->ApplyServerPropertyUpdate(*UpdatedProperties);
 		}
 		else if (Wrapper->UpdateDelegate.IsBound())
 		{
@@ -287,34 +1069,62 @@ void UMixerInteractivityBlueprintEventSource::OnCustomControlPropertyUpdateNativ
 				Wrapper->UnmappedControl = MakeShared<FJsonObject>();;
 			}
 
-			Wrapper->UnmappedControl->Values.Append(UpdatedProperties->Values);
+			// The update's values belong to the message being dispatched, so copy rather than share them.
+			for (const TPair<FString, TSharedPtr<FJsonValue>>& Updated : UpdatedProperties->Values)
+			{
+				Wrapper->UnmappedControl->Values.Add(Updated.Key, MixerJsonArena::DeepCopy(Updated.Value));
+			}
+			if (Wrapper->UnmappedPropertyCache.IsValid())
+			{
+				Wrapper->UnmappedPropertyCache->ApplyUpdate(*UpdatedProperties);
+			}
 
-			FMixerCustomControlReference ControlRef;
-			ControlRef.Name = ControlName;
-			Wrapper->UpdateDelegate.Broadcast(ControlRef);
+			FCustomControlUpdateParms Parms;
+			Parms.Control.Name = ControlName;
+			Wrapper->UpdateDelegate.ProcessDelegates(&Parms);
 		}
 	}
 }
 
 void UMixerInteractivityBlueprintEventSource::OnTextboxSubmitNativeEvent(FName TextboxName, TSharedPtr<const FMixerRemoteUser> Participant, const FMixerTextboxEventDetails& Details)
 {
+	SCOPE_CYCLE_COUNTER(STAT_MixerBlueprintEvents);
+	MIXER_TRACE_SCOPE("Blueprint", TextboxName.ToString(), INDEX_NONE);
+
 	FMixerTextboxEventDynamicDelegateWrapper* DelegateWrapper = TextboxDelegates.Find(TextboxName);
 	if (DelegateWrapper)
 	{
-		FMixerTextboxReference TextboxRef;
-		TextboxRef.Name = TextboxName;
-		FMixerTransactionId TransactionId;
-		TransactionId.Id = Details.TransactionId;
-		DelegateWrapper->SubmittedDelegate.Broadcast(TextboxRef, static_cast<int32>(Participant->Id), Details.SubmittedText, TransactionId, Details.SparkCost);
+		FTextSubmittedEventParms Parms;
+		Parms.Textbox.Name = TextboxName;
+		Parms.ParticipantId = static_cast<int32>(Participant->Id);
+		Parms.SubmittedText = Details.SubmittedText;
+		Parms.TransactionId.Id = Details.TransactionId;
+		Parms.SparkCost = static_cast<int32>(Details.SparkCost);
+		DelegateWrapper->SubmittedDelegate.ProcessDelegates(&Parms);
+		ProcessRoutedDelegates(EMixerBindingSlotType::TextSubmitted, TextboxName, Participant->Id, &Parms);
 	}
 }
 
 #if WITH_EDITORONLY_DATA
 void UMixerInteractivityBlueprintEventSource::RefreshCustomControls()
 {
+	FMixerProjectAssetPreloader& Preloader = FMixerProjectAssetPreloader::Get();
+	if (!Preloader.IsComplete())
+	{
+		// Come back once the definition and mapped classes are in rather than loading them here
+		TWeakObjectPtr<UMixerInteractivityBlueprintEventSource> WeakThis = this;
+		Preloader.WhenComplete(FSimpleDelegate::CreateLambda([WeakThis]()
+		{
+			if (WeakThis.IsValid())
+			{
+				WeakThis->RefreshCustomControls();
+			}
+		}));
+		return;
+	}
+
 	bool bCustomControlsChanged = false;
-	const UMixerInteractivitySettings* Settings = GetDefault<UMixerInteractivitySettings>();
-	UMixerProjectAsset* ProjectAsset = Cast<UMixerProjectAsset>(Settings->ProjectDefinition.TryLoad());
+	UMixerProjectAsset* ProjectAsset = Preloader.GetProjectDefinition(true);
 	if (ProjectAsset != nullptr)
 	{
 		// Ensure map is populated.
@@ -329,7 +1139,12 @@ void UMixerInteractivityBlueprintEventSource::RefreshCustomControls()
 			const FMixerCustomControlMapping* ClassBinding = ProjectAsset->CustomControlMappings.Find(It->Key);
 			if (ClassBinding != nullptr)
 			{
-				UClass* ControlClass = ClassBinding->Class.TryLoadClass<UMixerCustomControl>();
+				// Preloaded unless the mapping was added since, which only happens while editing
+				UClass* ControlClass = ClassBinding->Class.ResolveClass();
+				if (ControlClass == nullptr || !ControlClass->IsChildOf(UMixerCustomControl::StaticClass()))
+				{
+					ControlClass = ClassBinding->Class.TryLoadClass<UMixerCustomControl>();
+				}
 				if (ControlClass != nullptr)
 				{
 					if (It->Value.MappedControl == nullptr || ControlClass != It->Value.MappedControl->GetClass())
@@ -369,6 +1184,9 @@ void UMixerInteractivityBlueprintEventSource::RefreshCustomControls()
 				}
 			}
 		}
+
+		// Wrappers may have been added or removed
+		++WrapperGeneration;
 	}
 
 #if WITH_EDITOR
@@ -389,6 +1207,9 @@ void UMixerInteractivityBlueprintEventSource::OnCustomControlCompiled(UBlueprint
 			UBlueprint* GeneratedByBP = Cast<UBlueprint>(ControlObj->GetClass()->ClassGeneratedBy);
 			if (GeneratedByBP == CompiledBP)
 			{
+				UMixerCustomControl::InvalidateSerializationPlan(ControlObj->GetClass());
+				InvalidateCustomControlInputHandlers(ControlObj->GetClass());
+				MixerBindingUtils::InvalidateCustomEventParamPlans(ControlObj->GetClass());
 				UBlueprintGeneratedClass::BindDynamicDelegates(ControlObj->GetClass(), ControlObj);
 			}
 		}
@@ -403,6 +1224,54 @@ UWorld* UMixerInteractivityBlueprintEventSource::GetWorld() const
 
 namespace
 {
+	/** Visit each FMixerBlueprintInstanceDelegates in Wrapper, along with the same member of OtherWrapper if given. */
+	template <class WrapperType, class VisitorType>
+	void ForEachInstanceDelegates(WrapperType& Wrapper, WrapperType* OtherWrapper, VisitorType Visit)
+	{
+		for (TFieldIterator<UStructProperty> It(WrapperType::StaticStruct()); It; ++It)
+		{
+			if (It->Struct == FMixerBlueprintInstanceDelegates::StaticStruct())
+			{
+				Visit(*It->ContainerPtrToValuePtr<FMixerBlueprintInstanceDelegates>(&Wrapper), OtherWrapper != nullptr ? It->ContainerPtrToValuePtr<FMixerBlueprintInstanceDelegates>(OtherWrapper) : nullptr);
+			}
+		}
+	}
+
+	template <class WrapperType, class VisitorType>
+	void ForEachWrapperDelegates(TMap<FName, WrapperType>& Wrappers, VisitorType Visit)
+	{
+		for (TPair<FName, WrapperType>& Wrapper : Wrappers)
+		{
+			ForEachInstanceDelegates(Wrapper.Value, static_cast<WrapperType*>(nullptr), Visit);
+		}
+	}
+
+	/** Move From's wrappers into Into, emptying From.  Returns whether any new names were added. */
+	template <class WrapperType>
+	bool AbsorbWrappers(TMap<FName, WrapperType>& Into, TMap<FName, WrapperType>& From)
+	{
+		bool bAdded = false;
+		for (TPair<FName, WrapperType>& Wrapper : From)
+		{
+			WrapperType* Existing = Into.Find(Wrapper.Key);
+			if (Existing == nullptr)
+			{
+				Into.Add(Wrapper.Key, MoveTemp(Wrapper.Value));
+				bAdded = true;
+			}
+			else
+			{
+				// Functions saved with the level are bound to its objects, so are wanted alongside those already here
+				ForEachInstanceDelegates(*Existing, &Wrapper.Value, [](FMixerBlueprintInstanceDelegates& Delegates, FMixerBlueprintInstanceDelegates* LoadedDelegates)
+				{
+					Delegates.AbsorbSaved(*LoadedDelegates);
+				});
+			}
+		}
+		From.Empty();
+		return bAdded;
+	}
+
 	template <class DELEGATE_WRAPPER>
 	bool TrimStaleDelegatesHelper(TMap<FName, DELEGATE_WRAPPER>& Delegates)
 	{
@@ -423,6 +1292,8 @@ void UMixerInteractivityBlueprintEventSource::PostLoad()
 {
 	Super::PostLoad();
 
+	++WrapperGeneration;
+
 #if WITH_EDITOR
 	bool bFoundOutOfDateEvents = TrimStaleDelegatesHelper(ButtonDelegates);
 	bFoundOutOfDateEvents |= TrimStaleDelegatesHelper(StickDelegates);
@@ -445,13 +1316,159 @@ void UMixerInteractivityBlueprintEventSource::PostLoad()
 		It->Value.FunctionPrototype = It->Value.PrototypeReference.ResolveMember<UFunction>(static_cast<UClass*>(nullptr));
 	}
 
+	if (IsInGameThread() && !IsAsyncLoading())
+	{
+		RegisterLoadedSource();
+		return;
+	}
+
+	// Adopting the persistent source renames objects, which mustn't happen under the async loader
+	TWeakObjectPtr<UMixerInteractivityBlueprintEventSource> WeakThis(this);
+	AsyncTask(ENamedThreads::GameThread, [WeakThis]()
+	{
+		FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([WeakThis](float)
+		{
+			if (IsAsyncLoading())
+			{
+				return true;
+			}
+			if (UMixerInteractivityBlueprintEventSource* This = WeakThis.Get())
+			{
+				This->RegisterLoadedSource();
+			}
+			return false;
+		}));
+	});
+}
+
+void UMixerInteractivityBlueprintEventSource::RegisterLoadedSource()
+{
 	UWorld* World = GetWorld();
 	if (World != nullptr && World->IsGameWorld())
 	{
+		// A source held over from the last world takes this level's bindings in rather than starting cold
+		const TWeakObjectPtr<UMixerInteractivityBlueprintEventSource>* RegisteredSource = BlueprintEventSources.Find(World);
+		if (PersistentSource.IsValid() && RegisteredSource != nullptr && RegisteredSource->Get() == this)
+		{
+			World->ExtraReferencedObjects.Remove(this);
+			BlueprintEventSources.Remove(World);
+			AdoptPersistentSource(World)->AbsorbSource(*this);
+			return;
+		}
+
 		RegisterForMixerEvents();
 	}
 }
 
+bool UMixerInteractivityBlueprintEventSource::CanBeClusterRoot() const
+{
+	// A source that outlives its world changes outer and takes in the controls of the levels it moves to
+	return !HasAnyFlags(RF_ClassDefaultObject) && GetWorld() != nullptr && !GetDefault<UMixerInteractivitySettings>()->bPersistBlueprintEventSource;
+}
+
+void UMixerInteractivityBlueprintEventSource::Persist(UWorld* World)
+{
+	// Only one world's worth is kept; travelling twice without the source being picked up shouldn't pile them up
+	ReleasePersistentSource();
+
+	World->ExtraReferencedObjects.Remove(this);
+	Rename(*MakeUniqueObjectName(GetTransientPackage(), StaticClass()).ToString(), GetTransientPackage(), REN_DontCreateRedirectors | REN_ForceNoResetLoaders | REN_NonTransactional | REN_DoNotDirty);
+	AddToRoot();
+	PersistentSource = this;
+}
+
+UMixerInteractivityBlueprintEventSource* UMixerInteractivityBlueprintEventSource::AdoptPersistentSource(UWorld* World)
+{
+	UMixerInteractivityBlueprintEventSource* Source = PersistentSource.Get();
+	if (Source == nullptr || World == nullptr || !World->IsGameWorld())
+	{
+		return nullptr;
+	}
+	PersistentSource.Reset();
+	Source->RemoveFromRoot();
+
+	// A level saved with its own source may already have claimed the name
+	Source->Rename(*MakeUniqueObjectName(World, StaticClass()).ToString(), World, REN_DontCreateRedirectors | REN_ForceNoResetLoaders | REN_NonTransactional | REN_DoNotDirty);
+	BlueprintEventSources.Add(World, Source);
+	World->ExtraReferencedObjects.AddUnique(Source);
+
+	// Native subscriptions, resolved plans and custom control instances all carry over.  Only bindings
+	// saved with the old level need dropping, and the old world's instances are swept out as usual.
+	Source->TrimDeadSavedBindings();
+	Source->SweepBoundInstances();
+	return Source;
+}
+
+void UMixerInteractivityBlueprintEventSource::TrimDeadSavedBindings()
+{
+	auto TrimDelegates = [](FMixerBlueprintInstanceDelegates& Delegates)
+	{
+		Delegates.TrimDeadSaved();
+		return Delegates.HasSaved();
+	};
+	auto TrimWrappers = [&TrimDelegates](auto& Wrappers)
+	{
+		bool bAnySaved = false;
+		ForEachWrapperDelegates(Wrappers, [&TrimDelegates, &bAnySaved](FMixerBlueprintInstanceDelegates& Delegates, FMixerBlueprintInstanceDelegates*) { bAnySaved |= TrimDelegates(Delegates); });
+		return bAnySaved;
+	};
+
+	// Subscriptions taken in RegisterForMixerEvents are only wanted while there are saved bindings to serve
+	auto ReleaseIfUnused = [this](EMixerNativeEventCategory Category, bool bStillHaveSaved)
+	{
+		const uint32 CategoryBit = 1u << static_cast<uint32>(Category);
+		if (!bStillHaveSaved && (SavedBindingSubscriptions & CategoryBit) != 0)
+		{
+			SavedBindingSubscriptions &= ~CategoryBit;
+			ReleaseNativeEvent(Category);
+		}
+	};
+
+	bool bParticipantStateSaved = TrimDelegates(ParticipantJoinedDelegate);
+	bParticipantStateSaved |= TrimDelegates(ParticipantLeftDelegate);
+	bParticipantStateSaved |= TrimDelegates(ParticipantInputDisabledDelegate);
+	bool bBroadcastingSaved = TrimDelegates(BroadcastingStartedDelegate);
+	bBroadcastingSaved |= TrimDelegates(BroadcastingStoppedDelegate);
+	ReleaseIfUnused(EMixerNativeEventCategory::ParticipantState, bParticipantStateSaved);
+	ReleaseIfUnused(EMixerNativeEventCategory::Broadcasting, bBroadcastingSaved);
+	ReleaseIfUnused(EMixerNativeEventCategory::Button, TrimWrappers(ButtonDelegates));
+	ReleaseIfUnused(EMixerNativeEventCategory::Stick, TrimWrappers(StickDelegates));
+	ReleaseIfUnused(EMixerNativeEventCategory::Textbox, TrimWrappers(TextboxDelegates));
+	ReleaseIfUnused(EMixerNativeEventCategory::CustomControl, TrimWrappers(CustomControlDelegates));
+	ReleaseIfUnused(EMixerNativeEventCategory::CustomMethod, TrimWrappers(CustomMethodDelegates));
+}
+
+void UMixerInteractivityBlueprintEventSource::AbsorbSource(UMixerInteractivityBlueprintEventSource& Loaded)
+{
+	ParticipantJoinedDelegate.AbsorbSaved(Loaded.ParticipantJoinedDelegate);
+	ParticipantLeftDelegate.AbsorbSaved(Loaded.ParticipantLeftDelegate);
+	ParticipantInputDisabledDelegate.AbsorbSaved(Loaded.ParticipantInputDisabledDelegate);
+	BroadcastingStartedDelegate.AbsorbSaved(Loaded.BroadcastingStartedDelegate);
+	BroadcastingStoppedDelegate.AbsorbSaved(Loaded.BroadcastingStoppedDelegate);
+
+	bool bWrappersAdded = AbsorbWrappers(ButtonDelegates, Loaded.ButtonDelegates);
+	bWrappersAdded |= AbsorbWrappers(StickDelegates, Loaded.StickDelegates);
+	bWrappersAdded |= AbsorbWrappers(TextboxDelegates, Loaded.TextboxDelegates);
+	bWrappersAdded |= AbsorbWrappers(CustomMethodDelegates, Loaded.CustomMethodDelegates);
+	bWrappersAdded |= AbsorbWrappers(CustomControlDelegates, Loaded.CustomControlDelegates);
+
+	// Controls this source already had keep their warm instances; new ones come along from the level
+	for (TPair<FName, FMixerCustomControlDelegateWrapper>& Wrapper : CustomControlDelegates)
+	{
+		UMixerCustomControl* MappedControl = Wrapper.Value.MappedControl;
+		if (MappedControl != nullptr && MappedControl->GetOuter() != this)
+		{
+			MappedControl->Rename(*MakeUniqueObjectName(this, MappedControl->GetClass()).ToString(), this, REN_DontCreateRedirectors | REN_ForceNoResetLoaders | REN_NonTransactional | REN_DoNotDirty);
+		}
+	}
+
+	if (bWrappersAdded)
+	{
+		++WrapperGeneration;
+	}
+	RegisterForMixerEvents();
+}
+
 UMixerCustomControl* UMixerInteractivityBlueprintEventSource::GetMappedCustomControl(FName ControlName)
 {
 	FMixerCustomControlDelegateWrapper* Wrapper = CustomControlDelegates.Find(ControlName);
@@ -464,40 +1481,67 @@ TSharedPtr<FJsonObject> UMixerInteractivityBlueprintEventSource::GetUnmappedCust
 	return Wrapper != nullptr ? Wrapper->UnmappedControl : nullptr;
 }
 
+bool UMixerInteractivityBlueprintEventSource::ReadUnmappedCustomControlProperty(FName ControlName, const FString& PropertyName, UProperty* Property, void* Dest)
+{
+	FMixerCustomControlDelegateWrapper* Wrapper = CustomControlDelegates.Find(ControlName);
+	if (Wrapper == nullptr || !Wrapper->UnmappedControl.IsValid())
+	{
+		return false;
+	}
+
+	if (!Wrapper->UnmappedPropertyCache.IsValid())
+	{
+		Wrapper->UnmappedPropertyCache = MakeShared<MixerBindingUtils::FCustomControlPropertyCache>();
+	}
+	return Wrapper->UnmappedPropertyCache->Read(Wrapper->UnmappedControl.Get(), PropertyName, Property, Dest);
+}
+
 void UMixerDelegateBinding::AddButtonBinding(const FMixerButtonEventBinding& BindingInfo)
 {
 	ButtonEventBindings.Add(BindingInfo);
+	bBindingPlanBuilt = false;
 }
 
 void UMixerDelegateBinding::AddCustomControlInputBinding(const FMixerCustomControlEventBinding& BindingInfo)
 {
 	CustomControlInputBindings.Add(BindingInfo);
+	bBindingPlanBuilt = false;
 }
 
 void UMixerDelegateBinding::AddCustomControlUpdateBinding(const FMixerCustomControlEventBinding& BindingInfo)
 {
 	CustomControlUpdateBindings.Add(BindingInfo);
+	bBindingPlanBuilt = false;
 }
 
 void UMixerDelegateBinding::AddGenericBinding(const FMixerGenericEventBinding& BindingInfo)
 {
 	GenericBindings.Add(BindingInfo);
+	bBindingPlanBuilt = false;
 }
 
-void UMixerDelegateBinding::BindDynamicDelegates(UObject* InInstance) const
+const TArray<FMixerBindingSlot>& UMixerDelegateBinding::GetBindingPlan() const
 {
-	UMixerInteractivityBlueprintEventSource* EventSource = UMixerInteractivityBlueprintEventSource::GetBlueprintEventSource(InInstance->GetWorld());
-	check(EventSource);
+	if (bBindingPlanBuilt)
+	{
+		return BindingPlan;
+	}
 
+	auto AddSlot = [this](EMixerBindingSlotType Type, FName Name, FName TargetFunctionName)
+	{
+		FMixerBindingSlot& Slot = BindingPlan[BindingPlan.AddUninitialized()];
+		Slot.Type = Type;
+		Slot.Name = Name;
+		Slot.TargetFunctionName = TargetFunctionName;
+	};
+
+	BindingPlan.Reset();
 	for (const FMixerButtonEventBinding& ButtonBinding : ButtonEventBindings)
 	{
-		FMixerButtonEventDynamicDelegate* Event = EventSource->GetButtonEvent(ButtonBinding.ButtonId, ButtonBinding.Pressed);
-		if (Event)
-		{
-			FScriptDelegate Delegate;
-			Delegate.BindUFunction(InInstance, ButtonBinding.TargetFunctionName);
-			Event->AddUnique(Delegate);
-		}
+		const EMixerBindingSlotType Type = ButtonBinding.bBatched
+			? (ButtonBinding.Pressed ? EMixerBindingSlotType::ButtonBatchedPressed : EMixerBindingSlotType::ButtonBatchedReleased)
+			: (ButtonBinding.Pressed ? EMixerBindingSlotType::ButtonPressed : EMixerBindingSlotType::ButtonReleased);
+		AddSlot(Type, ButtonBinding.ButtonId, ButtonBinding.TargetFunctionName);
 	}
 
 	for (const FMixerGenericEventBinding& GenericBinding : GenericBindings)
@@ -505,23 +1549,23 @@ void UMixerDelegateBinding::BindDynamicDelegates(UObject* InInstance) const
 		switch (GenericBinding.BindingType)
 		{
 		case EMixerGenericEventBindingType::Stick:
-			{
-				FMixerStickEventDynamicDelegate * Event = EventSource->GetStickEvent(GenericBinding.NameParam);
-				if (Event)
-				{
-					FScriptDelegate Delegate;
-					Delegate.BindUFunction(InInstance, GenericBinding.TargetFunctionName);
-					Event->AddUnique(Delegate);
-				}
-			}
+			AddSlot(EMixerBindingSlotType::Stick, GenericBinding.NameParam, GenericBinding.TargetFunctionName);
+			break;
+
+		case EMixerGenericEventBindingType::StickLatestPerParticipant:
+			AddSlot(EMixerBindingSlotType::StickLatestPerParticipant, GenericBinding.NameParam, GenericBinding.TargetFunctionName);
+			break;
+
+		case EMixerGenericEventBindingType::StickCrowdAverage:
+			AddSlot(EMixerBindingSlotType::StickCrowdAverage, GenericBinding.NameParam, GenericBinding.TargetFunctionName);
 			break;
 
 		case EMixerGenericEventBindingType::CustomMethod:
-			EventSource->AddCustomMethodBinding(GenericBinding.NameParam, InInstance, GenericBinding.TargetFunctionName);
+			AddSlot(EMixerBindingSlotType::CustomMethod, GenericBinding.NameParam, GenericBinding.TargetFunctionName);
 			break;
 
 		case EMixerGenericEventBindingType::TextSubmitted:
-			EventSource->AddTextSubmittedBinding(GenericBinding.NameParam, InInstance, GenericBinding.TargetFunctionName);
+			AddSlot(EMixerBindingSlotType::TextSubmitted, GenericBinding.NameParam, GenericBinding.TargetFunctionName);
 			break;
 
 		default:
@@ -532,132 +1576,60 @@ void UMixerDelegateBinding::BindDynamicDelegates(UObject* InInstance) const
 
 	for (const FMixerCustomControlEventBinding& CustomControlBinding : CustomControlInputBindings)
 	{
-		FMixerCustomControlInputDynamicDelegate& Event = EventSource->GetCustomControlInputEvent(CustomControlBinding.ControlId);
-		FScriptDelegate Delegate;
-		Delegate.BindUFunction(InInstance, CustomControlBinding.TargetFunctionName);
-		Event.AddUnique(Delegate);
+		AddSlot(EMixerBindingSlotType::CustomControlInput, CustomControlBinding.ControlId, CustomControlBinding.TargetFunctionName);
 	}
 
-
 	for (const FMixerCustomControlEventBinding& CustomControlBinding : CustomControlUpdateBindings)
 	{
-		FMixerCustomControlUpdateDynamicDelegate& Event = EventSource->GetCustomControlUpdateEvent(CustomControlBinding.ControlId);
-		FScriptDelegate Delegate;
-		Delegate.BindUFunction(InInstance, CustomControlBinding.TargetFunctionName);
-		Event.AddUnique(Delegate);
+		AddSlot(EMixerBindingSlotType::CustomControlUpdate, CustomControlBinding.ControlId, CustomControlBinding.TargetFunctionName);
 	}
 
 	if (ParticipantJoinedBinding != NAME_None)
 	{
-		FScriptDelegate Delegate;
-		Delegate.BindUFunction(InInstance, ParticipantJoinedBinding);
-		EventSource->ParticipantJoinedDelegate.AddUnique(Delegate);
+		AddSlot(EMixerBindingSlotType::ParticipantJoined, NAME_None, ParticipantJoinedBinding);
 	}
 
 	if (ParticipantLeftBinding != NAME_None)
 	{
-		FScriptDelegate Delegate;
-		Delegate.BindUFunction(InInstance, ParticipantLeftBinding);
-		EventSource->ParticipantLeftDelegate.AddUnique(Delegate);
+		AddSlot(EMixerBindingSlotType::ParticipantLeft, NAME_None, ParticipantLeftBinding);
 	}
 
 	if (ParticipantInputDisabledBinding != NAME_None)
 	{
-		FScriptDelegate Delegate;
-		Delegate.BindUFunction(InInstance, ParticipantInputDisabledBinding);
-		EventSource->ParticipantInputDisabledDelegate.AddUnique(Delegate);
+		AddSlot(EMixerBindingSlotType::ParticipantInputDisabled, NAME_None, ParticipantInputDisabledBinding);
 	}
 
 	if (BroadcastingStartedBinding != NAME_None)
 	{
-		FScriptDelegate Delegate;
-		Delegate.BindUFunction(InInstance, BroadcastingStartedBinding);
-		EventSource->BroadcastingStartedDelegate.AddUnique(Delegate);
+		AddSlot(EMixerBindingSlotType::BroadcastingStarted, NAME_None, BroadcastingStartedBinding);
 	}
 
 	if (BroadcastingStoppedBinding != NAME_None)
 	{
-		FScriptDelegate Delegate;
-		Delegate.BindUFunction(InInstance, BroadcastingStoppedBinding);
-		EventSource->BroadcastingStoppedDelegate.AddUnique(Delegate);
+		AddSlot(EMixerBindingSlotType::BroadcastingStopped, NAME_None, BroadcastingStoppedBinding);
 	}
+
+	bBindingPlanBuilt = true;
+	return BindingPlan;
 }
 
-void UMixerDelegateBinding::UnbindDynamicDelegates(UObject* InInstance) const
+void UMixerDelegateBinding::BindDynamicDelegates(UObject* InInstance) const
 {
 	UMixerInteractivityBlueprintEventSource* EventSource = UMixerInteractivityBlueprintEventSource::GetBlueprintEventSource(InInstance->GetWorld());
 	check(EventSource);
-	for (const FMixerButtonEventBinding& ButtonBinding : ButtonEventBindings)
-	{
-		FMixerButtonEventDynamicDelegate* Event = EventSource->GetButtonEvent(ButtonBinding.ButtonId, ButtonBinding.Pressed);
-		if (Event)
-		{
-			Event->Remove(InInstance, ButtonBinding.TargetFunctionName);
-		}
-	}
-
-	for (const FMixerCustomControlEventBinding& CustomControlBinding : CustomControlInputBindings)
-	{
-		FMixerCustomControlInputDynamicDelegate& Event = EventSource->GetCustomControlInputEvent(CustomControlBinding.ControlId);
-		Event.Remove(InInstance, CustomControlBinding.TargetFunctionName);
-	}
-
-	for (const FMixerCustomControlEventBinding& CustomControlBinding : CustomControlUpdateBindings)
-	{
-		FMixerCustomControlUpdateDynamicDelegate& Event = EventSource->GetCustomControlUpdateEvent(CustomControlBinding.ControlId);
-		Event.Remove(InInstance, CustomControlBinding.TargetFunctionName);
-	}
-
-	for (const FMixerGenericEventBinding& GenericBinding : GenericBindings)
-	{
-		switch (GenericBinding.BindingType)
-		{
-		case EMixerGenericEventBindingType::Stick:
-			{
-				FMixerStickEventDynamicDelegate* Event = EventSource->GetStickEvent(GenericBinding.NameParam);
-				if (Event)
-				{
-					Event->Remove(InInstance, GenericBinding.TargetFunctionName);
-				}
-			}
-			break;
-
-		case EMixerGenericEventBindingType::CustomMethod:
-			EventSource->RemoveCustomMethodBinding(GenericBinding.NameParam, InInstance, GenericBinding.TargetFunctionName);
-			break;
-
-		case EMixerGenericEventBindingType::TextSubmitted:
-			EventSource->RemoveTextSubmittedBinding(GenericBinding.NameParam, InInstance, GenericBinding.TargetFunctionName);
-			break;
-
-		default:
-			UE_LOG(LogMixerInteractivity, Error, TEXT("Failed to unbind blueprint delegates with unknown binding type %d, target %s, name param %s"), static_cast<int32>(GenericBinding.BindingType), *GenericBinding.TargetFunctionName.ToString(), *GenericBinding.NameParam.ToString());
-			break;
-		}
-	}
-
-	if (ParticipantJoinedBinding != NAME_None)
-	{
-		EventSource->ParticipantJoinedDelegate.Remove(InInstance, ParticipantJoinedBinding);
-	}
-
-	if (ParticipantLeftBinding != NAME_None)
-	{
-		EventSource->ParticipantLeftDelegate.Remove(InInstance, ParticipantLeftBinding);
-	}
-
-	if (ParticipantInputDisabledBinding != NAME_None)
-	{
-		EventSource->ParticipantInputDisabledDelegate.Remove(InInstance, ParticipantInputDisabledBinding);
-	}
+	EventSource->BindInstance(this, GetBindingPlan(), InInstance);
+}
 
-	if (BroadcastingStartedBinding != NAME_None)
-	{
-		EventSource->BroadcastingStartedDelegate.Remove(InInstance, BroadcastingStartedBinding);
-	}
+void UMixerDelegateBinding::UnbindDynamicDelegates(UObject* InInstance) const
+{
+	UMixerInteractivityBlueprintEventSource* EventSource = UMixerInteractivityBlueprintEventSource::GetBlueprintEventSource(InInstance->GetWorld());
+	check(EventSource);
+	EventSource->UnbindInstance(this, GetBindingPlan(), InInstance);
+}
 
-	if (BroadcastingStoppedBinding != NAME_None)
-	{
-		EventSource->BroadcastingStoppedDelegate.Remove(InInstance, BroadcastingStartedBinding);
-	}
+void UMixerDelegateBinding::RouteDynamicDelegates(UObject* InInstance, uint32 ParticipantId) const
+{
+	UMixerInteractivityBlueprintEventSource* EventSource = UMixerInteractivityBlueprintEventSource::GetBlueprintEventSource(InInstance->GetWorld());
+	check(EventSource);
+	EventSource->RouteInstance(this, GetBindingPlan(), InInstance, ParticipantId);
 }
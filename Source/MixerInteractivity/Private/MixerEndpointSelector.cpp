@@ -0,0 +1,143 @@
+//*********************************************************
+//
+// Copyright (c) Microsoft. All rights reserved.
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT.
+//
+//*********************************************************
+#include "MixerEndpointSelector.h"
+#include "MixerInteractivityLog.h"
+#include "HttpModule.h"
+#include "Containers/Ticker.h"
+
+// Past this point we stop waiting and fall back to the discovery order.
+static const float EndpointProbeTimeoutSeconds = 2.0f;
+
+FMixerEndpointSelector::FMixerEndpointSelector()
+	: NumOutstandingProbes(0)
+{
+}
+
+FMixerEndpointSelector::~FMixerEndpointSelector()
+{
+	Cancel();
+}
+
+void FMixerEndpointSelector::RankEndpoints(const TArray<FString>& InCandidates, const FString& PreferredEndpoint, FOnEndpointsRanked InCallback)
+{
+	Cancel();
+
+	Candidates = InCandidates;
+	Callback = InCallback;
+
+	const int32 PreferredIndex = !PreferredEndpoint.IsEmpty() ? Candidates.Find(PreferredEndpoint) : INDEX_NONE;
+	if (PreferredIndex != INDEX_NONE || Candidates.Num() <= 1)
+	{
+		Finish(PreferredIndex);
+		return;
+	}
+
+	for (int32 i = 0; i < Candidates.Num(); ++i)
+	{
+		TSharedRef<IHttpRequest> Probe = FHttpModule::Get().CreateRequest();
+		Probe->SetVerb(TEXT("GET"));
+		Probe->SetURL(GetProbeUrl(Candidates[i]));
+		Probe->OnProcessRequestComplete().BindSP(this, &FMixerEndpointSelector::OnProbeComplete, i);
+		if (Probe->ProcessRequest())
+		{
+			Probes.Add(Probe);
+			++NumOutstandingProbes;
+		}
+	}
+
+	if (NumOutstandingProbes == 0)
+	{
+		Finish(INDEX_NONE);
+		return;
+	}
+
+	TimeoutHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateSP(this, &FMixerEndpointSelector::OnProbeTimeout), EndpointProbeTimeoutSeconds);
+}
+
+void FMixerEndpointSelector::Cancel()
+{
+	if (TimeoutHandle.IsValid())
+	{
+		FTicker::GetCoreTicker().RemoveTicker(TimeoutHandle);
+		TimeoutHandle.Reset();
+	}
+
+	for (FHttpRequestPtr& Probe : Probes)
+	{
+		// Unbind first - cancelling completes the request synchronously on some platforms
+		Probe->OnProcessRequestComplete().Unbind();
+		Probe->CancelRequest();
+	}
+	Probes.Empty();
+	NumOutstandingProbes = 0;
+	Callback.Unbind();
+}
+
+void FMixerEndpointSelector::OnProbeComplete(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, int32 CandidateIndex)
+{
+	--NumOutstandingProbes;
+	Probes.Remove(HttpRequest);
+
+	// Any response at all (the service will reject a plain GET) means the host is reachable
+	if (bSucceeded && HttpResponse.IsValid())
+	{
+		UE_LOG(LogMixerInteractivity, Verbose, TEXT("Endpoint %s answered first (%d)"), *Candidates[CandidateIndex], HttpResponse->GetResponseCode());
+		Finish(CandidateIndex);
+	}
+	else if (NumOutstandingProbes == 0)
+	{
+		UE_LOG(LogMixerInteractivity, Warning, TEXT("No endpoint answered a latency probe; using discovery order."));
+		Finish(INDEX_NONE);
+	}
+}
+
+bool FMixerEndpointSelector::OnProbeTimeout(float DeltaTime)
+{
+	TimeoutHandle.Reset();
+	Finish(INDEX_NONE);
+
+	// One-shot
+	return false;
+}
+
+void FMixerEndpointSelector::Finish(int32 WinnerIndex)
+{
+	TArray<FString> Ranked;
+	Ranked.Reserve(Candidates.Num());
+	if (WinnerIndex != INDEX_NONE)
+	{
+		Ranked.Add(Candidates[WinnerIndex]);
+	}
+	for (int32 i = 0; i < Candidates.Num(); ++i)
+	{
+		if (i != WinnerIndex)
+		{
+			Ranked.Add(Candidates[i]);
+		}
+	}
+
+	// Tear down before calling out, the callback may well start another ranking
+	FOnEndpointsRanked LocalCallback = Callback;
+	Cancel();
+	LocalCallback.ExecuteIfBound(Ranked);
+}
+
+FString FMixerEndpointSelector::GetProbeUrl(const FString& Endpoint)
+{
+	if (Endpoint.StartsWith(TEXT("wss://")))
+	{
+		return TEXT("https://") + Endpoint.RightChop(6);
+	}
+	else if (Endpoint.StartsWith(TEXT("ws://")))
+	{
+		return TEXT("http://") + Endpoint.RightChop(5);
+	}
+	return Endpoint;
+}
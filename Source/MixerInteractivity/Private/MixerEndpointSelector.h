@@ -0,0 +1,51 @@
+//*********************************************************
+//
+// Copyright (c) Microsoft. All rights reserved.
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT.
+//
+//*********************************************************
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Interfaces/IHttpRequest.h"
+#include "Interfaces/IHttpResponse.h"
+
+/**
+* Orders a set of websocket endpoints fastest-first by racing a small https request against
+* each (which covers both the TCP and TLS handshakes) and taking the first to answer.
+*/
+class FMixerEndpointSelector : public TSharedFromThis<FMixerEndpointSelector>
+{
+public:
+	DECLARE_DELEGATE_OneParam(FOnEndpointsRanked, const TArray<FString>& /* RankedEndpoints */);
+
+	FMixerEndpointSelector();
+	~FMixerEndpointSelector();
+
+	/**
+	* Rank Candidates and call back with every candidate, best first.  If PreferredEndpoint (typically the
+	* winner from a previous session) is among the candidates it is used without probing, in which case
+	* the callback is fired before this returns.
+	*/
+	void RankEndpoints(const TArray<FString>& InCandidates, const FString& PreferredEndpoint, FOnEndpointsRanked InCallback);
+
+	/** Abandon any ranking in flight.  The callback will not be fired. */
+	void Cancel();
+
+private:
+	void OnProbeComplete(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, int32 CandidateIndex);
+	bool OnProbeTimeout(float DeltaTime);
+	void Finish(int32 WinnerIndex);
+
+	static FString GetProbeUrl(const FString& Endpoint);
+
+private:
+	TArray<FString> Candidates;
+	TArray<FHttpRequestPtr> Probes;
+	FOnEndpointsRanked Callback;
+	FDelegateHandle TimeoutHandle;
+	int32 NumOutstandingProbes;
+};
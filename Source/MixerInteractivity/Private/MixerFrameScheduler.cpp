@@ -0,0 +1,126 @@
+//*********************************************************
+//
+// Copyright (c) Microsoft. All rights reserved.
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT.
+//
+//*********************************************************
+#include "MixerFrameScheduler.h"
+#include "MixerInteractivitySettings.h"
+#include "MixerInteractivityLog.h"
+#include "MixerInteractivityStats.h"
+#include "HAL/PlatformTime.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Work deferred (frame budget)"), STAT_MixerFrameWorkDeferred, STATGROUP_MixerInteractivity);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Sources starved (frame budget)"), STAT_MixerFrameWorkStarved, STATGROUP_MixerInteractivity);
+
+namespace
+{
+	// Roughly a second at 60Hz of never catching up before it's worth a warning
+	const int32 StarvedFrameThreshold = 60;
+}
+
+FMixerFrameScheduler& FMixerFrameScheduler::Get()
+{
+	static FMixerFrameScheduler Instance;
+	return Instance;
+}
+
+FMixerFrameScheduler::FMixerFrameScheduler()
+	: FrameBudget(0.0)
+	, FrameTimeSpent(0.0)
+	, bFrameStarted(false)
+{
+}
+
+void FMixerFrameScheduler::BeginFrame()
+{
+	for (int32 i = 0; i < static_cast<int32>(EMixerFrameWorkSource::Count); ++i)
+	{
+		FSourceState& State = Sources[i];
+		if (bFrameStarted)
+		{
+			if (State.bDeferredThisFrame)
+			{
+				++State.FramesDeferred;
+				if (State.FramesDeferred >= StarvedFrameThreshold && !State.bStarvationReported)
+				{
+					UE_LOG(LogMixerInteractivity, Warning, TEXT("%s have been left over for the next frame %d frames in a row; their backlog is growing."),
+						GetSourceName(static_cast<EMixerFrameWorkSource>(i)), State.FramesDeferred);
+					State.bStarvationReported = true;
+					INC_DWORD_STAT(STAT_MixerFrameWorkStarved);
+				}
+			}
+			else if (State.FramesDeferred > 0)
+			{
+				if (State.bStarvationReported)
+				{
+					UE_LOG(LogMixerInteractivity, Log, TEXT("%s caught up after %d frames."), GetSourceName(static_cast<EMixerFrameWorkSource>(i)), State.FramesDeferred);
+				}
+				State.FramesDeferred = 0;
+				State.bStarvationReported = false;
+			}
+		}
+
+		State.bBusyLastFrame = State.bBusyThisFrame;
+		State.bBusyThisFrame = false;
+		State.bDeferredThisFrame = false;
+		State.bRanThisFrame = false;
+	}
+
+	FrameBudget = FMath::Max(GetDefault<UMixerInteractivitySettings>()->FrameBudgetMilliseconds, 0.0f) * 1.0e-3;
+	FrameTimeSpent = 0.0;
+	bFrameStarted = true;
+}
+
+double FMixerFrameScheduler::BeginWork(EMixerFrameWorkSource Source)
+{
+	FSourceState& State = Sources[static_cast<int32>(Source)];
+	State.WorkStartTime = FPlatformTime::Seconds();
+	State.bRanThisFrame = true;
+
+	if (!IsBudgeted())
+	{
+		return MAX_dbl;
+	}
+
+	int32 Sharers = 1;
+	for (const FSourceState& Other : Sources)
+	{
+		if (!Other.bRanThisFrame && Other.bBusyLastFrame)
+		{
+			++Sharers;
+		}
+	}
+
+	const double Remaining = FMath::Max(FrameBudget - FrameTimeSpent, 0.0);
+	return State.WorkStartTime + Remaining / Sharers;
+}
+
+void FMixerFrameScheduler::EndWork(EMixerFrameWorkSource Source, bool bDidWork, bool bWorkRemaining)
+{
+	FSourceState& State = Sources[static_cast<int32>(Source)];
+	FrameTimeSpent += FPlatformTime::Seconds() - State.WorkStartTime;
+	State.bBusyThisFrame |= bDidWork || bWorkRemaining;
+	if (bWorkRemaining && !State.bDeferredThisFrame)
+	{
+		State.bDeferredThisFrame = true;
+		INC_DWORD_STAT(STAT_MixerFrameWorkDeferred);
+	}
+}
+
+const TCHAR* FMixerFrameScheduler::GetSourceName(EMixerFrameWorkSource Source)
+{
+	switch (Source)
+	{
+	case EMixerFrameWorkSource::InteractiveEvents:	return TEXT("Interactive events");
+	case EMixerFrameWorkSource::ChatMessages:		return TEXT("Chat messages");
+	case EMixerFrameWorkSource::LiveEvents:			return TEXT("Live events");
+	case EMixerFrameWorkSource::HttpCompletions:	return TEXT("HTTP completions");
+	case EMixerFrameWorkSource::CustomControls:		return TEXT("Custom control ticks");
+	case EMixerFrameWorkSource::ControlUpdates:		return TEXT("Control updates");
+	default:										return TEXT("Unknown work");
+	}
+}
@@ -0,0 +1,96 @@
+//*********************************************************
+//
+// Copyright (c) Microsoft. All rights reserved.
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT.
+//
+//*********************************************************
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** Kinds of game thread work that share the plugin's per-frame time budget. */
+enum class EMixerFrameWorkSource : uint8
+{
+	/** Interactive socket messages (UE backend) or SDK events (interactive-cpp v2) */
+	InteractiveEvents,
+	ChatMessages,
+	LiveEvents,
+	HttpCompletions,
+	CustomControls,
+	ControlUpdates,
+
+	Count
+};
+
+/**
+* Divides UMixerInteractivitySettings::FrameBudgetMilliseconds between the sources of work above.
+* Each source asks for its slice just before it runs; the slice is an even share of what is left of
+* the frame among the sources still to run that were busy last frame, so a source with nothing to do
+* hands its time on.  Work that doesn't fit stays in the source's own queue for next frame, and a
+* source that keeps running out of time is reported as starved.  Game thread only.
+*/
+class FMixerFrameScheduler
+{
+public:
+	static FMixerFrameScheduler& Get();
+
+	/** Called at the start of the module tick. */
+	void BeginFrame();
+
+	/** Whether a budget is configured.  Without one every source runs to completion as before. */
+	bool IsBudgeted() const { return FrameBudget > 0.0; }
+
+	/**
+	* Start a slice of work for Source.
+	*
+	* @return	time (FPlatformTime::Seconds) by which it should stop; MAX_dbl without a budget.
+	*			Sources should still make some progress past an expired deadline.
+	*/
+	double BeginWork(EMixerFrameWorkSource Source);
+
+	/**
+	* End the slice started by BeginWork.
+	*
+	* @param bDidWork			whether anything was handled
+	* @param bWorkRemaining		whether work was left queued for a later frame
+	*/
+	void EndWork(EMixerFrameWorkSource Source, bool bDidWork, bool bWorkRemaining);
+
+	/** Consecutive frames in which Source has had to leave work behind. */
+	int32 GetFramesDeferred(EMixerFrameWorkSource Source) const { return Sources[static_cast<int32>(Source)].FramesDeferred; }
+
+private:
+	FMixerFrameScheduler();
+
+	static const TCHAR* GetSourceName(EMixerFrameWorkSource Source);
+
+	struct FSourceState
+	{
+		double WorkStartTime;
+		int32 FramesDeferred;
+		bool bBusyLastFrame;
+		bool bBusyThisFrame;
+		bool bDeferredThisFrame;
+		bool bRanThisFrame;
+		bool bStarvationReported;
+
+		FSourceState()
+			: WorkStartTime(0.0)
+			, FramesDeferred(0)
+			, bBusyLastFrame(false)
+			, bBusyThisFrame(false)
+			, bDeferredThisFrame(false)
+			, bRanThisFrame(false)
+			, bStarvationReported(false)
+		{
+		}
+	};
+
+	FSourceState Sources[static_cast<int32>(EMixerFrameWorkSource::Count)];
+	double FrameBudget;
+	double FrameTimeSpent;
+	bool bFrameStarted;
+};
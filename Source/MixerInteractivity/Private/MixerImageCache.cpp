@@ -0,0 +1,512 @@
+//*********************************************************
+//
+// Copyright (c) Microsoft. All rights reserved.
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT.
+//
+//*********************************************************
+#include "MixerImageCache.h"
+#include "MixerInteractivitySettings.h"
+#include "MixerInteractivityLog.h"
+#include "MixerInteractivityStats.h"
+#include "OnlineChatMixer.h"
+#include "HttpModule.h"
+#include "Engine/Texture2D.h"
+#include "IImageWrapper.h"
+#include "IImageWrapperModule.h"
+#include "Modules/ModuleManager.h"
+#include "Async/TaskGraphInterfaces.h"
+
+DECLARE_MEMORY_STAT(TEXT("Image cache"), STAT_MixerImageCacheMemory, STATGROUP_MixerInteractivity);
+DECLARE_CYCLE_STAT(TEXT("Image decode (worker)"), STAT_MixerImageDecode, STATGROUP_MixerInteractivity);
+
+namespace
+{
+	// Chat images are small; anything bigger than this is more likely a mistake than an emoticon sheet
+	const int32 MaxImageDimension = 4096;
+
+	const int32 AtlasPageSize = 1024;
+
+	// Transparent gap between atlas sprites so that bilinear filtering doesn't bleed neighbours in
+	const int32 AtlasPadding = 1;
+
+	const int64 BytesPerPixel = 4;
+
+	UTexture2D* CreateImageTexture(int32 Width, int32 Height, const uint8* Pixels)
+	{
+		UTexture2D* Texture = UTexture2D::CreateTransient(Width, Height, PF_B8G8R8A8);
+		if (Texture != nullptr)
+		{
+			FTexture2DMipMap& Mip = Texture->PlatformData->Mips[0];
+			void* MipData = Mip.BulkData.Lock(LOCK_READ_WRITE);
+			if (Pixels != nullptr)
+			{
+				FMemory::Memcpy(MipData, Pixels, Width * Height * BytesPerPixel);
+			}
+			else
+			{
+				FMemory::Memzero(MipData, Width * Height * BytesPerPixel);
+			}
+			Mip.BulkData.Unlock();
+			Texture->UpdateResource();
+		}
+		return Texture;
+	}
+
+	FMixerImageRegion MakeRegion(UTexture2D* Texture, const FIntPoint& TextureSize, const FIntRect& Rect)
+	{
+		FMixerImageRegion Region;
+		Region.Texture = Texture;
+		Region.UVMin = FVector2D(static_cast<float>(Rect.Min.X) / TextureSize.X, static_cast<float>(Rect.Min.Y) / TextureSize.Y);
+		Region.UVMax = FVector2D(static_cast<float>(Rect.Max.X) / TextureSize.X, static_cast<float>(Rect.Max.Y) / TextureSize.Y);
+		Region.Size = Rect.Size();
+		return Region;
+	}
+
+	bool IsAtlasEnabled()
+	{
+		return GetDefault<UMixerInteractivitySettings>()->bPackEmoticonsIntoAtlas;
+	}
+}
+
+FMixerImageCache* FMixerImageCache::Instance = nullptr;
+
+FMixerImageCache& FMixerImageCache::Get()
+{
+	check(Instance != nullptr);
+	return *Instance;
+}
+
+FMixerImageCache::FMixerImageCache()
+	: OpenAtlasPage(INDEX_NONE)
+	, MemoryUsed(0)
+	, UseCounter(0)
+	, Generation(0)
+{
+	check(Instance == nullptr);
+	Instance = this;
+}
+
+FMixerImageCache::~FMixerImageCache()
+{
+	Reset();
+	Instance = nullptr;
+}
+
+bool FMixerImageCache::FindImage(const FString& Url, const FIntRect& SourceRect, FMixerImageRegion& OutRegion)
+{
+	return ResolveRegion(Url, SourceRect, OutRegion) && OutRegion.Texture != nullptr;
+}
+
+bool FMixerImageCache::FindImage(const FChatMessageImageMixer& Image, FMixerImageRegion& OutRegion)
+{
+	return FindImage(Image.Url, Image.SourceRect, OutRegion);
+}
+
+void FMixerImageCache::LoadImage(const FString& Url, const FIntRect& SourceRect, const FOnMixerImageLoaded& OnLoaded)
+{
+	check(IsInGameThread());
+
+	FMixerImageRegion Region;
+	if (ResolveRegion(Url, SourceRect, Region))
+	{
+		TrimToBudget();
+		OnLoaded.ExecuteIfBound(Region);
+		return;
+	}
+
+	FPendingImage* Pending = PendingImages.Find(Url);
+	if (Pending != nullptr)
+	{
+		Pending->Waiters.Add({ SourceRect, OnLoaded });
+		return;
+	}
+
+	TSharedRef<IHttpRequest> Request = FHttpModule::Get().CreateRequest();
+	Request->SetVerb(TEXT("GET"));
+	Request->SetURL(Url);
+	Request->OnProcessRequestComplete().BindRaw(this, &FMixerImageCache::OnDownloadComplete, Url);
+
+	FPendingImage& NewPending = PendingImages.Add(Url);
+	NewPending.Request = Request;
+	NewPending.Waiters.Add({ SourceRect, OnLoaded });
+	if (!Request->ProcessRequest())
+	{
+		UE_LOG(LogMixerInteractivity, Warning, TEXT("Failed to start download of image %s"), *Url);
+		FailWaiters(Url);
+	}
+}
+
+void FMixerImageCache::LoadImage(const FChatMessageImageMixer& Image, const FOnMixerImageLoaded& OnLoaded)
+{
+	LoadImage(Image.Url, Image.SourceRect, OnLoaded);
+}
+
+void FMixerImageCache::RemoveImage(const FString& Url)
+{
+	const FCachedImage* Image = CachedImages.Find(Url);
+	if (Image != nullptr)
+	{
+		UpdateMemoryUsed(-GetImageBytes(*Image));
+		CachedImages.Remove(Url);
+	}
+}
+
+void FMixerImageCache::Reset()
+{
+	for (TPair<FString, FPendingImage>& Pending : PendingImages)
+	{
+		if (Pending.Value.Request.IsValid())
+		{
+			Pending.Value.Request->OnProcessRequestComplete().Unbind();
+			Pending.Value.Request->CancelRequest();
+		}
+	}
+	PendingImages.Empty();
+	CachedImages.Empty();
+	AtlasPages.Empty();
+	AtlasSprites.Empty();
+	OpenAtlasPage = INDEX_NONE;
+	++Generation;
+	UpdateMemoryUsed(-MemoryUsed);
+}
+
+void FMixerImageCache::AddReferencedObjects(FReferenceCollector& Collector)
+{
+	for (TPair<FString, FCachedImage>& Image : CachedImages)
+	{
+		Collector.AddReferencedObject(Image.Value.Texture);
+	}
+	for (FAtlasPage& Page : AtlasPages)
+	{
+		Collector.AddReferencedObject(Page.Texture);
+	}
+}
+
+void FMixerImageCache::OnDownloadComplete(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, FString Url)
+{
+	FPendingImage* Pending = PendingImages.Find(Url);
+	if (Pending == nullptr)
+	{
+		return;
+	}
+	Pending->Request.Reset();
+
+	if (!bSucceeded || !HttpResponse.IsValid() || !EHttpResponseCodes::IsOk(HttpResponse->GetResponseCode()))
+	{
+		UE_LOG(LogMixerInteractivity, Warning, TEXT("Failed to download image %s (%d)"), *Url, HttpResponse.IsValid() ? HttpResponse->GetResponseCode() : 0);
+		FailWaiters(Url);
+		return;
+	}
+
+	// The module must be loaded here, but creating and running wrappers is safe on any thread
+	IImageWrapperModule* ImageWrapperModule = &FModuleManager::LoadModuleChecked<IImageWrapperModule>(TEXT("ImageWrapper"));
+	const uint32 DecodeGeneration = Generation;
+	FFunctionGraphTask::CreateAndDispatchWhenReady([this, HttpResponse, ImageWrapperModule, Url, DecodeGeneration]()
+	{
+		TSharedRef<FDecodedImage, ESPMode::ThreadSafe> Decoded = MakeShared<FDecodedImage, ESPMode::ThreadSafe>();
+		DecodeImage(*ImageWrapperModule, HttpResponse->GetContent(), *Decoded);
+		FFunctionGraphTask::CreateAndDispatchWhenReady([this, Decoded, Url, DecodeGeneration]()
+		{
+			// The module may have shut down and destroyed the cache while this was decoding
+			if (Instance == this && DecodeGeneration == Generation)
+			{
+				OnDecoded(Url, *Decoded);
+			}
+		}, TStatId(), nullptr, ENamedThreads::GameThread);
+	}, TStatId(), nullptr, ENamedThreads::AnyThread);
+}
+
+bool FMixerImageCache::DecodeImage(IImageWrapperModule& ImageWrapperModule, const TArray<uint8>& Compressed, FDecodedImage& OutDecoded)
+{
+	SCOPE_CYCLE_COUNTER(STAT_MixerImageDecode);
+
+	const EImageFormat Format = ImageWrapperModule.DetectImageFormat(Compressed.GetData(), Compressed.Num());
+	if (Format == EImageFormat::Invalid)
+	{
+		return false;
+	}
+
+	TSharedPtr<IImageWrapper> ImageWrapper = ImageWrapperModule.CreateImageWrapper(Format);
+	if (!ImageWrapper.IsValid() || !ImageWrapper->SetCompressed(Compressed.GetData(), Compressed.Num()))
+	{
+		return false;
+	}
+
+	const int32 Width = ImageWrapper->GetWidth();
+	const int32 Height = ImageWrapper->GetHeight();
+	if (Width <= 0 || Height <= 0 || Width > MaxImageDimension || Height > MaxImageDimension)
+	{
+		return false;
+	}
+
+	const TArray<uint8>* RawData = nullptr;
+	if (!ImageWrapper->GetRaw(ERGBFormat::BGRA, 8, RawData) || RawData == nullptr || RawData->Num() != Width * Height * BytesPerPixel)
+	{
+		return false;
+	}
+
+	OutDecoded.Pixels = *RawData;
+	OutDecoded.Size = FIntPoint(Width, Height);
+	return true;
+}
+
+void FMixerImageCache::OnDecoded(const FString& Url, FDecodedImage& Decoded)
+{
+	FPendingImage Pending;
+	if (!PendingImages.RemoveAndCopyValue(Url, Pending))
+	{
+		return;
+	}
+
+	TArray<FMixerImageRegion> Regions;
+	Regions.SetNum(Pending.Waiters.Num());
+	if (Decoded.Pixels.Num() > 0)
+	{
+		FCachedImage& Image = CachedImages.Add(Url);
+		Image.Texture = nullptr;
+		Image.Pixels = MoveTemp(Decoded.Pixels);
+		Image.Size = Decoded.Size;
+		Image.LastUse = ++UseCounter;
+		UpdateMemoryUsed(Image.Pixels.Num());
+		if (!IsAtlasEnabled())
+		{
+			EnsureTexture(Image);
+		}
+
+		for (int32 i = 0; i < Pending.Waiters.Num(); ++i)
+		{
+			ResolveRegion(Url, Pending.Waiters[i].SourceRect, Regions[i]);
+		}
+		TrimToBudget();
+	}
+	else
+	{
+		UE_LOG(LogMixerInteractivity, Warning, TEXT("Failed to decode image %s"), *Url);
+	}
+
+	// Callers may come straight back in, so everything is resolved before any of them run
+	for (int32 i = 0; i < Pending.Waiters.Num(); ++i)
+	{
+		Pending.Waiters[i].OnLoaded.ExecuteIfBound(Regions[i]);
+	}
+}
+
+void FMixerImageCache::FailWaiters(const FString& Url)
+{
+	FPendingImage Pending;
+	if (PendingImages.RemoveAndCopyValue(Url, Pending))
+	{
+		const FMixerImageRegion NoImage;
+		for (const FWaiter& Waiter : Pending.Waiters)
+		{
+			Waiter.OnLoaded.ExecuteIfBound(NoImage);
+		}
+	}
+}
+
+bool FMixerImageCache::ResolveRegion(const FString& Url, const FIntRect& SourceRect, FMixerImageRegion& OutRegion)
+{
+	const bool bWholeImage = SourceRect.Area() == 0;
+	FString SpriteKey;
+	if (!bWholeImage)
+	{
+		// Packed sprites outlive the sheet they came from, so look for those first.
+		SpriteKey = GetSpriteKey(Url, SourceRect);
+		const FAtlasSprite* Sprite = AtlasSprites.Find(SpriteKey);
+		if (Sprite != nullptr)
+		{
+			FAtlasPage& Page = AtlasPages[Sprite->Page];
+			Page.LastUse = ++UseCounter;
+			OutRegion = MakeRegion(Page.Texture, FIntPoint(AtlasPageSize, AtlasPageSize), Sprite->Rect);
+			return true;
+		}
+	}
+
+	FCachedImage* Image = CachedImages.Find(Url);
+	if (Image == nullptr)
+	{
+		return false;
+	}
+	Image->LastUse = ++UseCounter;
+
+	if (bWholeImage)
+	{
+		EnsureTexture(*Image);
+		OutRegion = MakeRegion(Image->Texture, Image->Size, FIntRect(FIntPoint(0, 0), Image->Size));
+		return true;
+	}
+
+	if (SourceRect.Min.X < 0 || SourceRect.Min.Y < 0 || SourceRect.Max.X > Image->Size.X || SourceRect.Max.Y > Image->Size.Y)
+	{
+		UE_LOG(LogMixerInteractivity, Warning, TEXT("Region %s lies outside image %s (%dx%d)"), *SourceRect.ToString(), *Url, Image->Size.X, Image->Size.Y);
+		OutRegion = FMixerImageRegion();
+		return true;
+	}
+
+	FAtlasSprite Sprite;
+	if (IsAtlasEnabled() && Image->Pixels.Num() > 0 && PackSprite(SpriteKey, *Image, SourceRect, Sprite))
+	{
+		OutRegion = MakeRegion(AtlasPages[Sprite.Page].Texture, FIntPoint(AtlasPageSize, AtlasPageSize), Sprite.Rect);
+		return true;
+	}
+
+	EnsureTexture(*Image);
+	OutRegion = MakeRegion(Image->Texture, Image->Size, SourceRect);
+	return true;
+}
+
+bool FMixerImageCache::PackSprite(const FString& SpriteKey, const FCachedImage& Image, const FIntRect& SourceRect, FAtlasSprite& OutSprite)
+{
+	const int32 Width = SourceRect.Width();
+	const int32 Height = SourceRect.Height();
+	if (Width + AtlasPadding > AtlasPageSize || Height + AtlasPadding > AtlasPageSize)
+	{
+		return false;
+	}
+
+	// Shelf packing: sprites go left to right along a shelf as tall as the tallest of them so far,
+	// and a new shelf starts below once a sprite doesn't fit.  Emoticons are near enough uniform
+	// in size that little is wasted.
+	FAtlasPage* Page = OpenAtlasPage != INDEX_NONE ? &AtlasPages[OpenAtlasPage] : nullptr;
+	if (Page != nullptr && Page->ShelfCursor + Width + AtlasPadding > AtlasPageSize)
+	{
+		Page->ShelfTop += Page->ShelfHeight;
+		Page->ShelfHeight = 0;
+		Page->ShelfCursor = 0;
+	}
+	if (Page == nullptr || Page->ShelfTop + Height + AtlasPadding > AtlasPageSize)
+	{
+		UTexture2D* PageTexture = CreateImageTexture(AtlasPageSize, AtlasPageSize, nullptr);
+		if (PageTexture == nullptr)
+		{
+			return false;
+		}
+
+		OpenAtlasPage = AtlasPages.Add(FAtlasPage());
+		Page = &AtlasPages[OpenAtlasPage];
+		Page->Texture = PageTexture;
+		Page->ShelfTop = 0;
+		Page->ShelfHeight = 0;
+		Page->ShelfCursor = 0;
+		UpdateMemoryUsed(AtlasPageSize * AtlasPageSize * BytesPerPixel);
+	}
+
+	const FIntPoint Origin(Page->ShelfCursor, Page->ShelfTop);
+	Page->ShelfCursor += Width + AtlasPadding;
+	Page->ShelfHeight = FMath::Max(Page->ShelfHeight, Height + AtlasPadding);
+	Page->LastUse = ++UseCounter;
+
+	// The render thread reads the copy whenever it gets to it, then frees it
+	const int32 RowBytes = Width * BytesPerPixel;
+	uint8* RegionData = new uint8[RowBytes * Height];
+	for (int32 Row = 0; Row < Height; ++Row)
+	{
+		const int64 SourceOffset = ((SourceRect.Min.Y + Row) * static_cast<int64>(Image.Size.X) + SourceRect.Min.X) * BytesPerPixel;
+		FMemory::Memcpy(RegionData + Row * RowBytes, Image.Pixels.GetData() + SourceOffset, RowBytes);
+	}
+	FUpdateTextureRegion2D* Region = new FUpdateTextureRegion2D(Origin.X, Origin.Y, 0, 0, Width, Height);
+	Page->Texture->UpdateTextureRegions(0, 1, Region, RowBytes, BytesPerPixel, RegionData, [](uint8* SrcData, const FUpdateTextureRegion2D* Regions)
+	{
+		delete[] SrcData;
+		delete Regions;
+	});
+
+	OutSprite.Page = OpenAtlasPage;
+	OutSprite.Rect = FIntRect(Origin, Origin + FIntPoint(Width, Height));
+	AtlasSprites.Add(SpriteKey, OutSprite);
+	Page->SpriteKeys.Add(SpriteKey);
+	return true;
+}
+
+void FMixerImageCache::EnsureTexture(FCachedImage& Image)
+{
+	if (Image.Texture == nullptr && Image.Pixels.Num() > 0)
+	{
+		Image.Texture = CreateImageTexture(Image.Size.X, Image.Size.Y, Image.Pixels.GetData());
+		if (Image.Texture != nullptr)
+		{
+			UpdateMemoryUsed(Image.Size.X * Image.Size.Y * BytesPerPixel);
+		}
+	}
+
+	// Only the atlas needs the decoded pixels once there's a texture
+	if (Image.Texture != nullptr && Image.Pixels.Num() > 0 && !IsAtlasEnabled())
+	{
+		UpdateMemoryUsed(-Image.Pixels.Num());
+		Image.Pixels.Empty();
+	}
+}
+
+void FMixerImageCache::UpdateMemoryUsed(int64 Delta)
+{
+	MemoryUsed += Delta;
+	SET_MEMORY_STAT(STAT_MixerImageCacheMemory, MemoryUsed);
+}
+
+void FMixerImageCache::TrimToBudget()
+{
+	const int64 Budget = FMath::Max(GetDefault<UMixerInteractivitySettings>()->ImageCacheBudgetMegabytes, 1) * 1024LL * 1024LL;
+	while (MemoryUsed > Budget && EvictLeastRecentlyUsed())
+	{
+	}
+}
+
+bool FMixerImageCache::EvictLeastRecentlyUsed()
+{
+	// Few enough entries that a scan beats keeping a separate ordering up to date
+	const FString* OldestImage = nullptr;
+	uint64 OldestUse = UseCounter;
+	for (const TPair<FString, FCachedImage>& Image : CachedImages)
+	{
+		if (Image.Value.LastUse < OldestUse)
+		{
+			OldestImage = &Image.Key;
+			OldestUse = Image.Value.LastUse;
+		}
+	}
+	int32 OldestPage = INDEX_NONE;
+	for (TSparseArray<FAtlasPage>::TConstIterator It(AtlasPages); It; ++It)
+	{
+		if (It->LastUse < OldestUse)
+		{
+			OldestImage = nullptr;
+			OldestPage = It.GetIndex();
+			OldestUse = It->LastUse;
+		}
+	}
+
+	// Whatever was used last is what's being asked for right now, so it's never evicted.
+	if (OldestPage != INDEX_NONE)
+	{
+		for (const FString& SpriteKey : AtlasPages[OldestPage].SpriteKeys)
+		{
+			AtlasSprites.Remove(SpriteKey);
+		}
+		AtlasPages.RemoveAt(OldestPage);
+		if (OpenAtlasPage == OldestPage)
+		{
+			OpenAtlasPage = INDEX_NONE;
+		}
+		UpdateMemoryUsed(-AtlasPageSize * AtlasPageSize * BytesPerPixel);
+		return true;
+	}
+	else if (OldestImage != nullptr)
+	{
+		RemoveImage(FString(*OldestImage));
+		return true;
+	}
+	return false;
+}
+
+int64 FMixerImageCache::GetImageBytes(const FCachedImage& Image)
+{
+	return Image.Pixels.Num() + (Image.Texture != nullptr ? Image.Size.X * Image.Size.Y * BytesPerPixel : 0);
+}
+
+FString FMixerImageCache::GetSpriteKey(const FString& Url, const FIntRect& SourceRect)
+{
+	return FString::Printf(TEXT("%s#%d,%d,%d,%d"), *Url, SourceRect.Min.X, SourceRect.Min.Y, SourceRect.Width(), SourceRect.Height());
+}
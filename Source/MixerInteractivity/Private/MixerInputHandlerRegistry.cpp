@@ -0,0 +1,274 @@
+//*********************************************************
+//
+// Copyright (c) Microsoft. All rights reserved.
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT.
+//
+//*********************************************************
+#include "MixerInputHandlerRegistry.h"
+#include "MixerInteractivityModule.h"
+#include "MixerInteractivityTypes.h"
+#include "MixerInteractivityLog.h"
+#include "MixerInteractivityStats.h"
+
+DECLARE_CYCLE_STAT(TEXT("Native input handlers"), STAT_MixerNativeInputHandlers, STATGROUP_MixerInteractivity);
+
+namespace
+{
+	const EMixerInputHandlerEvents EventsForKind[] =
+	{
+		EMixerInputHandlerEvents::Button,
+		EMixerInputHandlerEvents::Stick,
+		EMixerInputHandlerEvents::Textbox,
+		EMixerInputHandlerEvents::CustomControl,
+	};
+}
+
+FMixerInputHandlerRegistry::FMixerInputHandlerRegistry()
+	: Module(nullptr)
+	, DispatchDepth(0)
+	, bNeedsCompaction(false)
+{
+	static_assert(ARRAY_COUNT(EventsForKind) == NumKinds, "Every handler list needs an event flag");
+}
+
+void FMixerInputHandlerRegistry::Register(IMixerInteractivityModule& InModule, UObject* Object, const FMixerInputHandlerFilter& Filter)
+{
+	IMixerInputHandler* Interface = Cast<IMixerInputHandler>(Object);
+	if (Interface == nullptr)
+	{
+		UE_LOG(LogMixerInteractivity, Error, TEXT("%s does not implement IMixerInputHandler."), Object != nullptr ? *Object->GetName() : TEXT("null"));
+		return;
+	}
+
+	Module = &InModule;
+	if (DispatchDepth > 0)
+	{
+		FPendingChange& Change = PendingChanges[PendingChanges.AddDefaulted()];
+		Change.Object = Object;
+		Change.Filter = Filter;
+		Change.bRemove = false;
+		return;
+	}
+
+	// Registering again replaces the filter
+	RemoveHandler(Object);
+	AddHandler(Object, Interface, Filter);
+	UpdateSubscriptions();
+}
+
+void FMixerInputHandlerRegistry::Unregister(UObject* Object)
+{
+	if (DispatchDepth > 0)
+	{
+		FPendingChange& Change = PendingChanges[PendingChanges.AddDefaulted()];
+		Change.Object = Object;
+		Change.bRemove = true;
+		return;
+	}
+
+	RemoveHandler(Object);
+	UpdateSubscriptions();
+}
+
+void FMixerInputHandlerRegistry::AddHandler(UObject* Object, IMixerInputHandler* Interface, const FMixerInputHandlerFilter& Filter)
+{
+	FHandler Handler;
+	Handler.Object = Object;
+	Handler.Interface = Interface;
+	for (int32 Kind = 0; Kind < NumKinds; ++Kind)
+	{
+		if (EnumHasAnyFlags(Filter.Events, EventsForKind[Kind]))
+		{
+			if (Filter.Controls.Num() == 0)
+			{
+				Lists[Kind].AllControls.Add(Handler);
+			}
+			else
+			{
+				for (FName Control : Filter.Controls)
+				{
+					Lists[Kind].ByControl.FindOrAdd(Control).Add(Handler);
+				}
+			}
+		}
+	}
+}
+
+void FMixerInputHandlerRegistry::RemoveHandler(UObject* Object)
+{
+	// Also sweeps out handlers that have been destroyed since the last change
+	auto ShouldRemove = [Object](const FHandler& Handler) { return !Handler.Object.IsValid() || Handler.Object.Get() == Object; };
+	for (FHandlerList& List : Lists)
+	{
+		List.AllControls.RemoveAllSwap(ShouldRemove);
+		for (TMap<FName, TArray<FHandler>>::TIterator It(List.ByControl); It; ++It)
+		{
+			It->Value.RemoveAllSwap(ShouldRemove);
+			if (It->Value.Num() == 0)
+			{
+				It.RemoveCurrent();
+			}
+		}
+	}
+	bNeedsCompaction = false;
+}
+
+void FMixerInputHandlerRegistry::UpdateSubscriptions()
+{
+	if (Module == nullptr)
+	{
+		return;
+	}
+
+	for (int32 Kind = 0; Kind < NumKinds; ++Kind)
+	{
+		FHandlerList& List = Lists[Kind];
+		const bool bWanted = List.AllControls.Num() > 0 || List.ByControl.Num() > 0;
+		if (bWanted == List.Subscription.IsValid())
+		{
+			continue;
+		}
+
+		switch (Kind)
+		{
+		case Button:
+			if (bWanted)
+			{
+				List.Subscription = Module->OnButtonEvent().AddRaw(this, &FMixerInputHandlerRegistry::OnButton);
+			}
+			else
+			{
+				Module->OnButtonEvent().Remove(List.Subscription);
+			}
+			break;
+		case Stick:
+			if (bWanted)
+			{
+				List.Subscription = Module->OnStickEvent().AddRaw(this, &FMixerInputHandlerRegistry::OnStick);
+			}
+			else
+			{
+				Module->OnStickEvent().Remove(List.Subscription);
+			}
+			break;
+		case Textbox:
+			if (bWanted)
+			{
+				List.Subscription = Module->OnTextboxSubmitEvent().AddRaw(this, &FMixerInputHandlerRegistry::OnTextboxSubmit);
+			}
+			else
+			{
+				Module->OnTextboxSubmitEvent().Remove(List.Subscription);
+			}
+			break;
+		case CustomControl:
+			if (bWanted)
+			{
+				List.Subscription = Module->OnCustomControlInput().AddRaw(this, &FMixerInputHandlerRegistry::OnCustomControlInput);
+			}
+			else
+			{
+				Module->OnCustomControlInput().Remove(List.Subscription);
+			}
+			break;
+		default:
+			checkNoEntry();
+			break;
+		}
+
+		if (!bWanted)
+		{
+			List.Subscription.Reset();
+		}
+	}
+}
+
+template <typename CallType>
+void FMixerInputHandlerRegistry::Dispatch(EKind Kind, FName ControlId, CallType Call)
+{
+	SCOPE_CYCLE_COUNTER(STAT_MixerNativeInputHandlers);
+
+	// Lists can't change underneath us; registration changes are queued until the outermost dispatch ends
+	++DispatchDepth;
+	FHandlerList& List = Lists[Kind];
+	for (const FHandler& Handler : List.AllControls)
+	{
+		if (Handler.Object.IsValid())
+		{
+			Call(*Handler.Interface);
+		}
+		else
+		{
+			bNeedsCompaction = true;
+		}
+	}
+
+	const TArray<FHandler>* ControlHandlers = List.ByControl.Find(ControlId);
+	if (ControlHandlers != nullptr)
+	{
+		for (const FHandler& Handler : *ControlHandlers)
+		{
+			if (Handler.Object.IsValid())
+			{
+				Call(*Handler.Interface);
+			}
+			else
+			{
+				bNeedsCompaction = true;
+			}
+		}
+	}
+	EndDispatch();
+}
+
+void FMixerInputHandlerRegistry::EndDispatch()
+{
+	if (--DispatchDepth > 0 || (PendingChanges.Num() == 0 && !bNeedsCompaction))
+	{
+		return;
+	}
+
+	TArray<FPendingChange> Changes = MoveTemp(PendingChanges);
+	PendingChanges.Reset();
+	if (bNeedsCompaction)
+	{
+		RemoveHandler(nullptr);
+	}
+
+	for (const FPendingChange& Change : Changes)
+	{
+		UObject* Object = Change.Object.Get();
+		if (Object != nullptr)
+		{
+			RemoveHandler(Object);
+			if (!Change.bRemove)
+			{
+				AddHandler(Object, Cast<IMixerInputHandler>(Object), Change.Filter);
+			}
+		}
+	}
+	UpdateSubscriptions();
+}
+
+void FMixerInputHandlerRegistry::OnButton(FName Button, TSharedPtr<const FMixerRemoteUser> Participant, const FMixerButtonEventDetails& Details)
+{
+	Dispatch(EKind::Button, Button, [&](IMixerInputHandler& Handler) { Handler.OnMixerButton(Button, Participant, Details); });
+}
+
+void FMixerInputHandlerRegistry::OnStick(FName Stick, TSharedPtr<const FMixerRemoteUser> Participant, FVector2D Value)
+{
+	Dispatch(EKind::Stick, Stick, [&](IMixerInputHandler& Handler) { Handler.OnMixerStick(Stick, Participant, Value); });
+}
+
+void FMixerInputHandlerRegistry::OnTextboxSubmit(FName Textbox, TSharedPtr<const FMixerRemoteUser> Participant, const FMixerTextboxEventDetails& Details)
+{
+	Dispatch(EKind::Textbox, Textbox, [&](IMixerInputHandler& Handler) { Handler.OnMixerTextboxSubmit(Textbox, Participant, Details); });
+}
+
+void FMixerInputHandlerRegistry::OnCustomControlInput(FName Control, FName EventType, TSharedPtr<const FMixerRemoteUser> Participant, const TSharedRef<FJsonObject> EventPayload)
+{
+	Dispatch(EKind::CustomControl, Control, [&](IMixerInputHandler& Handler) { Handler.OnMixerCustomControlInput(Control, EventType, Participant, EventPayload); });
+}
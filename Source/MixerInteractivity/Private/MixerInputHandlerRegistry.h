@@ -0,0 +1,82 @@
+//*********************************************************
+//
+// Copyright (c) Microsoft. All rights reserved.
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT.
+//
+//*********************************************************
+#pragma once
+
+#include "MixerInputHandler.h"
+#include "UObject/WeakObjectPtr.h"
+#include "Delegates/IDelegateInstance.h"
+
+class IMixerInteractivityModule;
+
+/**
+* Registered IMixerInputHandlers, indexed by input kind and control so that each event only visits the
+* handlers that asked for it.  The registry subscribes to a module event only while some handler wants it.
+* Registration changes made by handlers while input is being dispatched take effect once it finishes.
+*/
+class FMixerInputHandlerRegistry
+{
+public:
+	FMixerInputHandlerRegistry();
+
+	void Register(IMixerInteractivityModule& Module, UObject* Object, const FMixerInputHandlerFilter& Filter);
+	void Unregister(UObject* Object);
+
+private:
+	enum EKind
+	{
+		Button,
+		Stick,
+		Textbox,
+		CustomControl,
+
+		NumKinds
+	};
+
+	struct FHandler
+	{
+		TWeakObjectPtr<UObject> Object;
+		IMixerInputHandler* Interface;
+	};
+
+	struct FHandlerList
+	{
+		TArray<FHandler> AllControls;
+		TMap<FName, TArray<FHandler>> ByControl;
+		FDelegateHandle Subscription;
+	};
+
+	/** A Register (bRemove false) or Unregister made during dispatch */
+	struct FPendingChange
+	{
+		TWeakObjectPtr<UObject> Object;
+		FMixerInputHandlerFilter Filter;
+		bool bRemove;
+	};
+
+	void AddHandler(UObject* Object, IMixerInputHandler* Interface, const FMixerInputHandlerFilter& Filter);
+	void RemoveHandler(UObject* Object);
+	void UpdateSubscriptions();
+	void EndDispatch();
+
+	template <typename CallType>
+	void Dispatch(EKind Kind, FName ControlId, CallType Call);
+
+	void OnButton(FName Button, TSharedPtr<const FMixerRemoteUser> Participant, const FMixerButtonEventDetails& Details);
+	void OnStick(FName Stick, TSharedPtr<const FMixerRemoteUser> Participant, FVector2D Value);
+	void OnTextboxSubmit(FName Textbox, TSharedPtr<const FMixerRemoteUser> Participant, const FMixerTextboxEventDetails& Details);
+	void OnCustomControlInput(FName Control, FName EventType, TSharedPtr<const FMixerRemoteUser> Participant, const TSharedRef<FJsonObject> EventPayload);
+
+	FHandlerList Lists[NumKinds];
+	IMixerInteractivityModule* Module;
+
+	int32 DispatchDepth;
+	bool bNeedsCompaction;
+	TArray<FPendingChange> PendingChanges;
+};
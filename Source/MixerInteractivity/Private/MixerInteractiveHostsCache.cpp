@@ -0,0 +1,160 @@
+//*********************************************************
+//
+// Copyright (c) Microsoft. All rights reserved.
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT.
+//
+//*********************************************************
+#include "MixerInteractiveHostsCache.h"
+#include "MixerInteractivityLog.h"
+#include "MixerInteractivitySettings.h"
+#include "MixerInteractivityUserSettings.h"
+#include "MixerRestClient.h"
+#include "MixerJsonHelpers.h"
+#include "Misc/DateTime.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+namespace
+{
+	const TCHAR* HostsPath = TEXT("interactive/hosts");
+
+	bool ParseHostsResponse(const FString& Content, TArray<FString>& OutHosts)
+	{
+		TSharedRef<TJsonReader<>> JsonReader = TJsonReaderFactory<>::Create(Content);
+		TSharedPtr<FJsonValue> JsonPayload;
+		const TArray<TSharedPtr<FJsonValue>>* JsonArray;
+		if (FJsonSerializer::Deserialize(JsonReader, JsonPayload) && JsonPayload.IsValid() && JsonPayload->TryGetArray(JsonArray))
+		{
+			for (const TSharedPtr<FJsonValue>& HostElem : *JsonArray)
+			{
+				const TSharedPtr<FJsonObject> AddressObject = HostElem->AsObject();
+				FString Address;
+				if (AddressObject.IsValid() && AddressObject->TryGetStringField(TEXT("address"), Address))
+				{
+					OutHosts.Add(Address);
+				}
+			}
+		}
+		return OutHosts.Num() > 0;
+	}
+}
+
+FMixerInteractiveHostsCache::~FMixerInteractiveHostsCache()
+{
+	Cancel();
+}
+
+bool FMixerInteractiveHostsCache::GetCachedHosts(TArray<FString>& OutHosts, const FString& PreferredHost, bool bAllowStale)
+{
+	const UMixerInteractivitySettings* Settings = GetDefault<UMixerInteractivitySettings>();
+	const UMixerInteractivityUserSettings* UserSettings = GetDefault<UMixerInteractivityUserSettings>();
+	if (UserSettings->CachedInteractiveHosts.Num() == 0)
+	{
+		return false;
+	}
+
+	if (!bAllowStale)
+	{
+		const int64 Age = FDateTime::UtcNow().ToUnixTimestamp() - UserSettings->CachedInteractiveHostsTimestamp;
+		if (Age < 0 || Age > static_cast<int64>(Settings->InteractiveHostsCacheLifetime))
+		{
+			return false;
+		}
+	}
+
+	OutHosts = UserSettings->CachedInteractiveHosts;
+	const int32 PreferredIndex = !PreferredHost.IsEmpty() ? OutHosts.Find(PreferredHost) : INDEX_NONE;
+	if (PreferredIndex > 0)
+	{
+		OutHosts.RemoveAt(PreferredIndex);
+		OutHosts.Insert(PreferredHost, 0);
+	}
+	return true;
+}
+
+FString FMixerInteractiveHostsCache::GetHostsUrl()
+{
+	return FMixerRestClient::GetApiUrl(HostsPath);
+}
+
+bool FMixerInteractiveHostsCache::RequestHosts(FOnHostsReceived InCallback)
+{
+	if (HostsRequest.IsValid())
+	{
+		Callback = InCallback;
+		return true;
+	}
+
+	TSharedRef<IHttpRequest> Request = FMixerRestClient::Get().CreateRequest(TEXT("GET"), HostsPath);
+	Request->OnProcessRequestComplete().BindSP(this, &FMixerInteractiveHostsCache::OnHostsRequestComplete);
+	if (!FMixerRestClient::Get().ProcessRequest(Request))
+	{
+		return false;
+	}
+
+	HostsRequest = Request;
+	Callback = InCallback;
+	return true;
+}
+
+void FMixerInteractiveHostsCache::Cancel()
+{
+	Callback.Unbind();
+	if (HostsRequest.IsValid())
+	{
+		HostsRequest->OnProcessRequestComplete().Unbind();
+		HostsRequest->CancelRequest();
+		HostsRequest.Reset();
+	}
+}
+
+void FMixerInteractiveHostsCache::OnHostsRequestComplete(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded)
+{
+	if (!bSucceeded || !HttpResponse.IsValid() || !EHttpResponseCodes::IsOk(HttpResponse->GetResponseCode()))
+	{
+		TArray<FString> NoHosts;
+		OnHostsParsed(HttpRequest, NoHosts);
+		return;
+	}
+
+	// The request stays in flight until parsing is done, so that it can still be joined or cancelled
+	TWeakPtr<FMixerInteractiveHostsCache> WeakThis = AsShared();
+	ParseHttpResponseAsync<TArray<FString>>(HttpResponse, &ParseHostsResponse, [WeakThis, HttpRequest](bool bParsed, TArray<FString>& Hosts)
+	{
+		TSharedPtr<FMixerInteractiveHostsCache> StrongThis = WeakThis.Pin();
+		if (StrongThis.IsValid())
+		{
+			StrongThis->OnHostsParsed(HttpRequest, Hosts);
+		}
+	});
+}
+
+void FMixerInteractiveHostsCache::OnHostsParsed(FHttpRequestPtr HttpRequest, const TArray<FString>& Hosts)
+{
+	if (HostsRequest != HttpRequest)
+	{
+		// Cancelled while parsing
+		return;
+	}
+	HostsRequest.Reset();
+
+	if (Hosts.Num() > 0)
+	{
+		UMixerInteractivityUserSettings* UserSettings = GetMutableDefault<UMixerInteractivityUserSettings>();
+		UserSettings->CachedInteractiveHosts = Hosts;
+		UserSettings->CachedInteractiveHostsTimestamp = FDateTime::UtcNow().ToUnixTimestamp();
+		UserSettings->SaveConfigDeferred();
+	}
+	else
+	{
+		UE_LOG(LogMixerInteractivity, Warning, TEXT("Interactive host lookup failed."));
+	}
+
+	// Copy off in case the callback starts another request
+	FOnHostsReceived CallbackCopy = Callback;
+	Callback.Unbind();
+	CallbackCopy.ExecuteIfBound(Hosts);
+}
@@ -0,0 +1,55 @@
+//*********************************************************
+//
+// Copyright (c) Microsoft. All rights reserved.
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT.
+//
+//*********************************************************
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Interfaces/IHttpRequest.h"
+#include "Interfaces/IHttpResponse.h"
+
+/**
+* Looks up the interactive service hosts and remembers the answer in the user's config, so that a
+* later session can start connecting straight away and refresh the list alongside.
+*/
+class FMixerInteractiveHostsCache : public TSharedFromThis<FMixerInteractiveHostsCache>
+{
+public:
+	DECLARE_DELEGATE_OneParam(FOnHostsReceived, const TArray<FString>& /* Hosts */);
+
+	~FMixerInteractiveHostsCache();
+
+	/**
+	* Get the hosts from the last successful lookup.  Unless bAllowStale is set, fails once
+	* they're older than InteractiveHostsCacheLifetime.  PreferredHost is moved to the front if present.
+	*/
+	static bool GetCachedHosts(TArray<FString>& OutHosts, const FString& PreferredHost, bool bAllowStale);
+
+	/** Full url of the hosts lookup on the configured API root, for clients that make the request themselves. */
+	static FString GetHostsUrl();
+
+	/**
+	* Ask the service for the current hosts, storing them in the cache on success.  The callback
+	* receives an empty list if the lookup failed.  A request already in flight (e.g. a prefetch)
+	* is reused, with InCallback replacing its callback.
+	*/
+	bool RequestHosts(FOnHostsReceived InCallback);
+
+	/** Abandon the request in flight, if any.  The callback will not be fired. */
+	void Cancel();
+
+	bool IsRequestInFlight() const	{ return HostsRequest.IsValid(); }
+
+private:
+	void OnHostsRequestComplete(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded);
+	void OnHostsParsed(FHttpRequestPtr HttpRequest, const TArray<FString>& Hosts);
+
+private:
+	FHttpRequestPtr HostsRequest;
+	FOnHostsReceived Callback;
+};
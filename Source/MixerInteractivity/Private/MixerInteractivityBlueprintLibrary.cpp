@@ -10,10 +10,14 @@
 #include "MixerInteractivityBlueprintLibrary.h"
 #include "MixerInteractivityModule.h"
 #include "MixerCustomControl.h"
+#include "MixerDynamicDelegateBinding.h"
+#include "MixerAvatarCache.h"
+#include "MixerBindingUtils.h"
 #include "LatentActions.h"
 #include "Engine/Engine.h"
 #include "GameFramework/PlayerController.h"
 #include "GameFramework/PlayerState.h"
+#include "Engine/BlueprintGeneratedClass.h"
 #include "Logging/MessageLog.h"
 #include "JsonObjectConverter.h"
 
@@ -154,15 +158,25 @@ void UMixerInteractivityBlueprintLibrary::LoginSilently(UObject* WorldContextObj
 	}
 }
 
-void UMixerInteractivityBlueprintLibrary::TriggerButtonCooldown(FMixerButtonReference Button, FTimespan Cooldown)
+void UMixerInteractivityBlueprintLibrary::TriggerButtonCooldown(const FMixerButtonReference& Button, FTimespan Cooldown)
 {
+	// Backends such as interactive-cpp v2 only implement cooldowns for names, so this mustn't take the handle path
 	IMixerInteractivityModule::Get().TriggerButtonCooldown(Button.Name, Cooldown);
 }
 
-void UMixerInteractivityBlueprintLibrary::GetButtonDescription(FMixerButtonReference Button, FText& ButtonText, FText& HelpText, int32& SparkCost)
+bool UMixerInteractivityBlueprintLibrary::SetBandwidthThrottle(EMixerBandwidthThrottleType ThrottleType, int32 MaxBytes, int32 BytesPerSecond)
 {
+	return IMixerInteractivityModule::Get().SetBandwidthThrottle(ThrottleType, static_cast<uint32>(FMath::Max(MaxBytes, 0)), static_cast<uint32>(FMath::Max(BytesPerSecond, 0)));
+}
+
+void UMixerInteractivityBlueprintLibrary::GetButtonDescription(const FMixerButtonReference& Button, FText& ButtonText, FText& HelpText, int32& SparkCost)
+{
+	IMixerInteractivityModule& MixerModule = IMixerInteractivityModule::Get();
 	FMixerButtonDescription ButtonDesc;
-	if (IMixerInteractivityModule::Get().GetButtonDescription(Button.Name, ButtonDesc))
+	const bool bGotDesc = MixerModule.ResolveButton(Button.Name, Button.CachedHandle)
+		? MixerModule.GetButtonDescription(Button.CachedHandle, ButtonDesc)
+		: MixerModule.GetButtonDescription(Button.Name, ButtonDesc);
+	if (bGotDesc)
 	{
 		ButtonText = ButtonDesc.ButtonText;
 		HelpText = ButtonDesc.HelpText;
@@ -174,17 +188,24 @@ void UMixerInteractivityBlueprintLibrary::GetButtonDescription(FMixerButtonRefer
 	}
 }
 
-void UMixerInteractivityBlueprintLibrary::GetButtonState(FMixerButtonReference Button, FTimespan& RemainingCooldown, float& Progress, int32& DownCount, int32& PressCount, int32& UpCount, bool& Enabled, int32 ParticipantId)
+void UMixerInteractivityBlueprintLibrary::GetButtonState(const FMixerButtonReference& Button, FTimespan& RemainingCooldown, float& Progress, int32& DownCount, int32& PressCount, int32& UpCount, bool& Enabled, int32 ParticipantId)
 {
+	IMixerInteractivityModule& MixerModule = IMixerInteractivityModule::Get();
 	FMixerButtonState ButtonState;
 	bool GotState = false;
-	if (ParticipantId != 0)
+	if (MixerModule.ResolveButton(Button.Name, Button.CachedHandle))
+	{
+		GotState = ParticipantId != 0
+			? MixerModule.GetButtonState(Button.CachedHandle, ParticipantId, ButtonState)
+			: MixerModule.GetButtonState(Button.CachedHandle, ButtonState);
+	}
+	else if (ParticipantId != 0)
 	{
-		GotState = IMixerInteractivityModule::Get().GetButtonState(Button.Name, ParticipantId, ButtonState);
+		GotState = MixerModule.GetButtonState(Button.Name, ParticipantId, ButtonState);
 	}
 	else
 	{
-		GotState = IMixerInteractivityModule::Get().GetButtonState(Button.Name, ButtonState);
+		GotState = MixerModule.GetButtonState(Button.Name, ButtonState);
 	}
 
 	if (GotState)
@@ -216,17 +237,24 @@ void UMixerInteractivityBlueprintLibrary::GetStickDescription(FMixerStickReferen
 	}
 }
 
-void UMixerInteractivityBlueprintLibrary::GetStickState(FMixerStickReference Stick, float& XAxis, float& YAxis, bool& Enabled, int32 ParticipantId)
+void UMixerInteractivityBlueprintLibrary::GetStickState(const FMixerStickReference& Stick, float& XAxis, float& YAxis, bool& Enabled, int32 ParticipantId)
 {
+	IMixerInteractivityModule& MixerModule = IMixerInteractivityModule::Get();
 	FMixerStickState StickState;
 	bool GotState = false;
-	if (ParticipantId != 0)
+	if (MixerModule.ResolveStick(Stick.Name, Stick.CachedHandle))
 	{
-		GotState = IMixerInteractivityModule::Get().GetStickState(Stick.Name, ParticipantId, StickState);
+		GotState = ParticipantId != 0
+			? MixerModule.GetStickState(Stick.CachedHandle, ParticipantId, StickState)
+			: MixerModule.GetStickState(Stick.CachedHandle, StickState);
+	}
+	else if (ParticipantId != 0)
+	{
+		GotState = MixerModule.GetStickState(Stick.Name, ParticipantId, StickState);
 	}
 	else
 	{
-		GotState = IMixerInteractivityModule::Get().GetStickState(Stick.Name, StickState);
+		GotState = MixerModule.GetStickState(Stick.Name, StickState);
 	}
 
 	if (GotState)
@@ -243,6 +271,146 @@ void UMixerInteractivityBlueprintLibrary::GetStickState(FMixerStickReference Sti
 	}
 }
 
+void UMixerInteractivityBlueprintLibrary::GetStickAggregate(const FMixerStickReference& Stick, int32& ParticipantCount, FVector2D& Mean, FVector2D& WeightedMean, FVector2D& Variance, TArray<int32>& QuadrantVotes)
+{
+	IMixerInteractivityModule& MixerModule = IMixerInteractivityModule::Get();
+	FMixerStickAggregate Aggregate;
+	const bool bGotAggregate = MixerModule.ResolveStick(Stick.Name, Stick.CachedHandle)
+		? MixerModule.GetStickAggregate(Stick.CachedHandle, Aggregate)
+		: MixerModule.GetStickAggregate(Stick.Name, Aggregate);
+
+	if (bGotAggregate)
+	{
+		ParticipantCount = Aggregate.ParticipantCount;
+		Mean = Aggregate.Mean;
+		WeightedMean = Aggregate.WeightedMean;
+		Variance = Aggregate.Variance;
+		QuadrantVotes.SetNumUninitialized(ARRAY_COUNT(Aggregate.QuadrantVotes));
+		FMemory::Memcpy(QuadrantVotes.GetData(), Aggregate.QuadrantVotes, sizeof(Aggregate.QuadrantVotes));
+	}
+	else
+	{
+		ParticipantCount = 0;
+		Mean = FVector2D(0, 0);
+		WeightedMean = FVector2D(0, 0);
+		Variance = FVector2D(0, 0);
+		QuadrantVotes.Init(0, ARRAY_COUNT(Aggregate.QuadrantVotes));
+	}
+}
+
+bool UMixerInteractivityBlueprintLibrary::EnableCoordinateHeatmap(FName ControlName, int32 GridWidth, int32 GridHeight, FVector2D BoundsMin, FVector2D BoundsMax, float HalfLife)
+{
+	FMixerCoordinateHeatmapSettings Settings;
+	Settings.Width = GridWidth;
+	Settings.Height = GridHeight;
+	Settings.Bounds = FBox2D(BoundsMin, BoundsMax);
+	Settings.HalfLife = HalfLife;
+	return IMixerInteractivityModule::Get().EnableCoordinateHeatmap(ControlName, Settings);
+}
+
+bool UMixerInteractivityBlueprintLibrary::GetCoordinateHeatmap(FName ControlName, TArray<float>& Cells, int32& GridWidth, int32& GridHeight)
+{
+	TArrayView<const float> HeatmapCells;
+	if (IMixerInteractivityModule::Get().GetCoordinateHeatmap(ControlName, HeatmapCells, GridWidth, GridHeight))
+	{
+		Cells.Reset(HeatmapCells.Num());
+		Cells.Append(HeatmapCells.GetData(), HeatmapCells.Num());
+		return true;
+	}
+
+	Cells.Reset();
+	GridWidth = 0;
+	GridHeight = 0;
+	return false;
+}
+
+bool UMixerInteractivityBlueprintLibrary::EnableInputSketches(FName ControlName, float WindowSeconds, int32 TrackedParticipants)
+{
+	FMixerInputSketchSettings Settings;
+	Settings.WindowSeconds = WindowSeconds;
+	Settings.TrackedParticipants = TrackedParticipants;
+	return IMixerInteractivityModule::Get().EnableInputSketches(ControlName, Settings);
+}
+
+bool UMixerInteractivityBlueprintLibrary::GetMostActiveParticipants(FName ControlName, int32 MaxCount, TArray<int32>& ParticipantIds, TArray<int32>& InputCounts)
+{
+	TArray<FMixerActiveParticipant> Participants;
+	const bool bEnabled = IMixerInteractivityModule::Get().GetMostActiveParticipants(ControlName, MaxCount, Participants);
+	ParticipantIds.Reset(Participants.Num());
+	InputCounts.Reset(Participants.Num());
+	for (const FMixerActiveParticipant& Participant : Participants)
+	{
+		ParticipantIds.Add(static_cast<int32>(Participant.ParticipantId));
+		InputCounts.Add(Participant.InputCount);
+	}
+	return bEnabled;
+}
+
+bool UMixerInteractivityBlueprintLibrary::GetDistinctParticipantCount(FName ControlName, int32& DistinctParticipants)
+{
+	DistinctParticipants = 0;
+	return IMixerInteractivityModule::Get().GetDistinctParticipantCount(ControlName, DistinctParticipants);
+}
+
+bool UMixerInteractivityBlueprintLibrary::EnableActivityTimeSeries(FName ControlName, float BucketSeconds, float HistorySeconds)
+{
+	FMixerActivitySeriesSettings Settings;
+	Settings.BucketSeconds = BucketSeconds;
+	Settings.NumBuckets = BucketSeconds > 0.0f ? FMath::CeilToInt(HistorySeconds / BucketSeconds) : 0;
+	return IMixerInteractivityModule::Get().EnableActivityTimeSeries(ControlName, Settings);
+}
+
+bool UMixerInteractivityBlueprintLibrary::GetActivityTimeSeries(FName ControlName, TArray<float>& Samples, float& BucketSeconds)
+{
+	TArrayView<const float> SeriesSamples;
+	if (IMixerInteractivityModule::Get().GetActivityTimeSeries(ControlName, SeriesSamples, BucketSeconds))
+	{
+		Samples.Reset(SeriesSamples.Num());
+		Samples.Append(SeriesSamples.GetData(), SeriesSamples.Num());
+		return true;
+	}
+
+	Samples.Reset();
+	BucketSeconds = 0.0f;
+	return false;
+}
+
+int32 UMixerInteractivityBlueprintLibrary::StartVoteRound(const TArray<FMixerButtonReference>& Options, FTimespan Duration, bool WeightBySparks)
+{
+	FMixerVoteRoundSettings Settings;
+	Settings.OptionButtons.Reserve(Options.Num());
+	for (const FMixerButtonReference& Option : Options)
+	{
+		Settings.OptionButtons.Add(Option.Name);
+	}
+	Settings.Duration = Duration;
+	Settings.bWeightBySparks = WeightBySparks;
+	return IMixerInteractivityModule::Get().StartVoteRound(Settings);
+}
+
+bool UMixerInteractivityBlueprintLibrary::CloseVoteRound(int32 RoundId, int32& WinningOption, TArray<int32>& Tallies)
+{
+	FMixerVoteRoundResult Result;
+	const bool bWasOpen = IMixerInteractivityModule::Get().CloseVoteRound(RoundId, Result);
+	WinningOption = Result.WinningOption;
+	Tallies = MoveTemp(Result.Tallies);
+	return bWasOpen;
+}
+
+bool UMixerInteractivityBlueprintLibrary::GetVoteTallies(int32 RoundId, TArray<int32>& Tallies)
+{
+	TArrayView<const int32> RoundTallies;
+	if (IMixerInteractivityModule::Get().GetVoteTallies(RoundId, RoundTallies))
+	{
+		Tallies.Reset(RoundTallies.Num());
+		Tallies.Append(RoundTallies.GetData(), RoundTallies.Num());
+		return true;
+	}
+
+	Tallies.Reset();
+	return false;
+}
+
 void UMixerInteractivityBlueprintLibrary::SetLabelText(FMixerLabelReference Label, const FText& Text)
 {
 	IMixerInteractivityModule::Get().SetLabelText(Label.Name, Text);
@@ -293,6 +461,16 @@ void UMixerInteractivityBlueprintLibrary::SetCurrentScene(FMixerSceneReference S
 	IMixerInteractivityModule::Get().SetCurrentScene(Scene.Name, Group.Name);
 }
 
+void UMixerInteractivityBlueprintLibrary::BeginStagedSceneChange(FMixerSceneReference Scene, FMixerGroupReference Group)
+{
+	IMixerInteractivityModule::Get().BeginStagedSceneChange(Scene.Name, Group.Name);
+}
+
+void UMixerInteractivityBlueprintLibrary::CommitStagedSceneChange()
+{
+	IMixerInteractivityModule::Get().CommitStagedSceneChange();
+}
+
 void UMixerInteractivityBlueprintLibrary::GetLoggedInUserInfo(int32& UserId, bool& IsLoggedIn, FString& Name, int32& Level, int32& Experience, int32& Sparks)
 {
 	TSharedPtr<const FMixerLocalUser> User = IMixerInteractivityModule::Get().GetCurrentUser();
@@ -359,6 +537,26 @@ void UMixerInteractivityBlueprintLibrary::MoveParticipantToGroup(FMixerGroupRefe
 	}
 }
 
+void UMixerInteractivityBlueprintLibrary::MoveParticipantsToGroup(FMixerGroupReference Group, const TArray<int32>& ParticipantIds)
+{
+	TArray<uint32> Ids;
+	Ids.Reserve(ParticipantIds.Num());
+	for (int32 ParticipantId : ParticipantIds)
+	{
+		Ids.Add(static_cast<uint32>(ParticipantId));
+	}
+
+	if (Ids.Num() > 0 && !IMixerInteractivityModule::Get().MoveParticipantsToGroup(Group.Name, Ids))
+	{
+#if WITH_EDITOR
+		FMessageLog("PIE").Warning(FText::Format(
+			LOCTEXT("MoveManyToGroupError_NotFound", "MoveParticipantsToGroup failed: none of the participants could be moved to group {0}."),
+			FText::FromName(Group.Name)
+		));
+#endif
+	}
+}
+
 FName UMixerInteractivityBlueprintLibrary::GetName(const FMixerObjectReference& Obj)
 {
 	return Obj.Name;
@@ -369,6 +567,61 @@ void UMixerInteractivityBlueprintLibrary::CaptureSparkTransaction(FMixerTransact
 	IMixerInteractivityModule::Get().CaptureSparkTransaction(TransactionId.Id);
 }
 
+void UMixerInteractivityBlueprintLibrary::SetMixerEventsBound(UObject* Instance, bool bBound)
+{
+	if (Instance == nullptr || Instance->GetWorld() == nullptr)
+	{
+		return;
+	}
+
+	// Only the Mixer bindings, leaving component and input bindings alone
+	for (UBlueprintGeneratedClass* BPClass = Cast<UBlueprintGeneratedClass>(Instance->GetClass()); BPClass != nullptr; BPClass = Cast<UBlueprintGeneratedClass>(BPClass->GetSuperClass()))
+	{
+		UMixerDelegateBinding* Binding = Cast<UMixerDelegateBinding>(UBlueprintGeneratedClass::GetDynamicBindingObject(BPClass, UMixerDelegateBinding::StaticClass()));
+		if (Binding != nullptr)
+		{
+			if (bBound)
+			{
+				Binding->BindDynamicDelegates(Instance);
+			}
+			else
+			{
+				Binding->UnbindDynamicDelegates(Instance);
+			}
+		}
+	}
+}
+
+void UMixerInteractivityBlueprintLibrary::RouteMixerEventsToParticipant(UObject* Instance, int32 ParticipantId)
+{
+	if (Instance == nullptr || Instance->GetWorld() == nullptr)
+	{
+		return;
+	}
+
+	const uint32 RouteTo = ParticipantId > 0 ? static_cast<uint32>(ParticipantId) : 0;
+	for (UBlueprintGeneratedClass* BPClass = Cast<UBlueprintGeneratedClass>(Instance->GetClass()); BPClass != nullptr; BPClass = Cast<UBlueprintGeneratedClass>(BPClass->GetSuperClass()))
+	{
+		UMixerDelegateBinding* Binding = Cast<UMixerDelegateBinding>(UBlueprintGeneratedClass::GetDynamicBindingObject(BPClass, UMixerDelegateBinding::StaticClass()));
+		if (Binding != nullptr)
+		{
+			Binding->RouteDynamicDelegates(Instance, RouteTo);
+		}
+	}
+}
+
+UTexture2D* UMixerInteractivityBlueprintLibrary::GetUserAvatar(int32 UserId)
+{
+	FMixerImageRegion Region;
+	if (FMixerAvatarCache::Get().FindAvatar(UserId, Region))
+	{
+		return Region.Texture;
+	}
+
+	FMixerAvatarCache::Get().RequestAvatar(UserId, EMixerAvatarPriority::Visible, FOnMixerImageLoaded());
+	return nullptr;
+}
+
 #if defined(DEFINE_FUNCTION)
 DEFINE_FUNCTION(UMixerInteractivityBlueprintLibrary::execGetCustomControlProperty_Helper)
 #else
@@ -392,19 +645,44 @@ DECLARE_FUNCTION(UMixerInteractivityBlueprintLibrary::execGetCustomControlProper
 		{
 			if (Stack.MostRecentPropertyAddress != nullptr && Stack.MostRecentProperty != nullptr)
 			{
-				TSharedPtr<FJsonObject> ControlObject;
-				if (IMixerInteractivityModule::Get().GetCustomControl(ForWorld, Control.Name, ControlObject))
-				{
-					TSharedPtr<FJsonValue> LocatedProperty = ControlObject->TryGetField(PropertyName);
-					if (LocatedProperty.IsValid())
-					{
-						FJsonObjectConverter::JsonValueToUProperty(LocatedProperty, Stack.MostRecentProperty, Stack.MostRecentPropertyAddress, 0, 0);
-					}
-				}
+				// Typically read every tick, so go through the typed cache rather than converting from Json each time
+				UMixerInteractivityBlueprintEventSource::GetBlueprintEventSource(ForWorld)->ReadUnmappedCustomControlProperty(Control.Name, PropertyName, Stack.MostRecentProperty, Stack.MostRecentPropertyAddress);
 			}
 		}
 	}
 	P_NATIVE_END;
 }
 
+void UMixerInteractivityBlueprintLibrary::BeginCustomMethodCall_Helper()
+{
+	MixerBindingUtils::FCustomMethodParamsWriter::Get().Begin();
+}
+
+#if defined(DEFINE_FUNCTION)
+DEFINE_FUNCTION(UMixerInteractivityBlueprintLibrary::execWriteCustomMethodParam_Helper)
+#else
+DECLARE_FUNCTION(UMixerInteractivityBlueprintLibrary::execWriteCustomMethodParam_Helper)
+#endif
+{
+	P_GET_PROPERTY(UStrProperty, ParamName);
+
+	Stack.MostRecentPropertyAddress = nullptr;
+	Stack.MostRecentProperty = nullptr;
+	Stack.StepCompiledIn<UProperty>(nullptr);
+	P_FINISH;
+
+	P_NATIVE_BEGIN;
+	if (Stack.MostRecentPropertyAddress != nullptr && Stack.MostRecentProperty != nullptr)
+	{
+		MixerBindingUtils::FCustomMethodParamsWriter::Get().WriteParam(ParamName, Stack.MostRecentProperty, Stack.MostRecentPropertyAddress);
+	}
+	P_NATIVE_END;
+}
+
+void UMixerInteractivityBlueprintLibrary::FinishCustomMethodCall_Helper(FString MethodName)
+{
+	TArrayView<const uint8> Params = MixerBindingUtils::FCustomMethodParamsWriter::Get().Finish();
+	IMixerInteractivityModule::Get().CallRemoteMethodSerialized(MethodName, Params);
+}
+
 #undef LOCTEXT_NAMESPACE
\ No newline at end of file
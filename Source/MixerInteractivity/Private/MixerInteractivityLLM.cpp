@@ -0,0 +1,37 @@
+//*********************************************************
+//
+// Copyright (c) Microsoft. All rights reserved.
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT.
+//
+//*********************************************************
+
+#include "MixerInteractivityLLM.h"
+
+#if ENABLE_LOW_LEVEL_MEM_TRACKER
+
+DECLARE_LLM_MEMORY_STAT(TEXT("Mixer"), STAT_MixerLLMSummary, STATGROUP_LLM);
+DECLARE_LLM_MEMORY_STAT(TEXT("Mixer Participants"), STAT_MixerLLMParticipants, STATGROUP_LLMFULL);
+DECLARE_LLM_MEMORY_STAT(TEXT("Mixer Chat History"), STAT_MixerLLMChatHistory, STATGROUP_LLMFULL);
+DECLARE_LLM_MEMORY_STAT(TEXT("Mixer Messages"), STAT_MixerLLMMessages, STATGROUP_LLMFULL);
+DECLARE_LLM_MEMORY_STAT(TEXT("Mixer Control Updates"), STAT_MixerLLMControlUpdates, STATGROUP_LLMFULL);
+DECLARE_LLM_MEMORY_STAT(TEXT("Mixer Interactive SDK"), STAT_MixerLLMInteractiveSdk, STATGROUP_LLMFULL);
+
+void MixerLLM::RegisterTags()
+{
+	static_assert(MIXER_LLM_TAG_BASE >= static_cast<int32>(ELLMTag::ProjectTagStart) &&
+		MIXER_LLM_TAG_BASE + static_cast<int32>(EMixerLLMTag::Count) - 1 <= static_cast<int32>(ELLMTag::ProjectTagEnd),
+		"Mixer LLM tags must lie within the project tag range");
+
+	FLowLevelMemTracker& Tracker = FLowLevelMemTracker::Get();
+	const FName Summary = GET_STATFNAME(STAT_MixerLLMSummary);
+	Tracker.RegisterProjectTag(static_cast<int32>(ToLLMTag(EMixerLLMTag::Participants)), TEXT("MixerParticipants"), GET_STATFNAME(STAT_MixerLLMParticipants), Summary);
+	Tracker.RegisterProjectTag(static_cast<int32>(ToLLMTag(EMixerLLMTag::ChatHistory)), TEXT("MixerChatHistory"), GET_STATFNAME(STAT_MixerLLMChatHistory), Summary);
+	Tracker.RegisterProjectTag(static_cast<int32>(ToLLMTag(EMixerLLMTag::Messages)), TEXT("MixerMessages"), GET_STATFNAME(STAT_MixerLLMMessages), Summary);
+	Tracker.RegisterProjectTag(static_cast<int32>(ToLLMTag(EMixerLLMTag::ControlUpdates)), TEXT("MixerControlUpdates"), GET_STATFNAME(STAT_MixerLLMControlUpdates), Summary);
+	Tracker.RegisterProjectTag(static_cast<int32>(ToLLMTag(EMixerLLMTag::InteractiveSdk)), TEXT("MixerInteractiveSdk"), GET_STATFNAME(STAT_MixerLLMInteractiveSdk), Summary);
+}
+
+#endif
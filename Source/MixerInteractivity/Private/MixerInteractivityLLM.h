@@ -0,0 +1,63 @@
+//*********************************************************
+//
+// Copyright (c) Microsoft. All rights reserved.
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT.
+//
+//*********************************************************
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/LowLevelMemTracker.h"
+
+#if ENABLE_LOW_LEVEL_MEM_TRACKER
+
+/**
+* Project tags are shared with the game, so Mixer claims a block at the top of the range by default.
+* Define MIXER_LLM_TAG_BASE in the target rules if that collides with the project's own tags.
+*/
+#ifndef MIXER_LLM_TAG_BASE
+#define MIXER_LLM_TAG_BASE (static_cast<int32>(ELLMTag::ProjectTagEnd) - static_cast<int32>(EMixerLLMTag::Count) + 1)
+#endif
+
+enum class EMixerLLMTag : uint8
+{
+	/** Cached remote users, group indices and per-participant control state */
+	Participants,
+
+	/** Chat message history */
+	ChatHistory,
+
+	/** Frames and JSON documents for websocket traffic */
+	Messages,
+
+	/** Control updates queued to go out */
+	ControlUpdates,
+
+	/** Anything allocated by the interactive-cpp-v2 SDK while we're calling into it */
+	InteractiveSdk,
+
+	Count
+};
+
+namespace MixerLLM
+{
+	inline ELLMTag ToLLMTag(EMixerLLMTag Tag)
+	{
+		return static_cast<ELLMTag>(MIXER_LLM_TAG_BASE + static_cast<int32>(Tag));
+	}
+
+	/** Give the tags names in LLM reports.  Called once at module startup. */
+	void RegisterTags();
+}
+
+#define MIXER_LLM_SCOPE(Tag) LLM_SCOPE(MixerLLM::ToLLMTag(EMixerLLMTag::Tag))
+
+#else
+
+#define MIXER_LLM_SCOPE(Tag)
+
+#endif
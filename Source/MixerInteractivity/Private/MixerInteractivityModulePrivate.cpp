@@ -12,10 +12,26 @@
 #include "MixerInteractivityUserSettings.h"
 #include "MixerDynamicDelegateBinding.h"
 #include "MixerInteractivityLog.h"
+#include "MixerInteractivityStats.h"
+#include "MixerInteractivityLLM.h"
+#include "MixerCsvStats.h"
 #include "MixerBindingUtils.h"
 #include "MixerInteractivityProjectAsset.h"
 #include "OnlineChatMixerPrivate.h"
 #include "OnlineChatMixerPrivate.h"
+#include "MixerJsonHelpers.h"
+#include "MixerJsonArena.h"
+#include "MixerCustomControl.h"
+#include "MixerConstellationConnection.h"
+#include "MixerRestClient.h"
+#include "MixerImageCache.h"
+#include "MixerAvatarCache.h"
+#include "MixerFrameScheduler.h"
+#include "MixerMockService.h"
+#include "MixerSoakTest.h"
+#include "MixerTrafficRecorder.h"
+#include "MixerWarmStartCache.h"
+#include "MixerProjectAssetPreloader.h"
 
 #include "HttpModule.h"
 #include "PlatformHttp.h"
@@ -31,6 +47,7 @@
 #include "UObject/UObjectGlobals.h"
 #include "UObject/CoreOnline.h"
 #include "Engine/World.h"
+#include "Misc/CoreDelegates.h"
 #include "Async/Async.h"
 #include "Framework/Docking/TabManager.h"
 #include "Framework/Application/SlateApplication.h"
@@ -55,14 +72,253 @@
 
 DEFINE_LOG_CATEGORY(LogMixerInteractivity);
 
+DEFINE_STAT(STAT_MixerSocketReceive);
+DEFINE_STAT(STAT_MixerSocketParse);
+DEFINE_STAT(STAT_MixerSocketDispatch);
+DEFINE_STAT(STAT_MixerSocketFlush);
+DEFINE_STAT(STAT_MixerMessagesIn);
+DEFINE_STAT(STAT_MixerMessagesOut);
+DEFINE_STAT(STAT_MixerBytesIn);
+DEFINE_STAT(STAT_MixerBytesOut);
+DEFINE_STAT(STAT_MixerBulkMessagesHeldBack);
+DEFINE_STAT(STAT_MixerPendingReplies);
+DEFINE_STAT(STAT_MixerInteractiveRoundTrip);
+DEFINE_STAT(STAT_MixerInteractiveJitter);
+DEFINE_STAT(STAT_MixerChatRoundTrip);
+DEFINE_STAT(STAT_MixerChatJitter);
+DEFINE_STAT(STAT_MixerMissedPings);
+DEFINE_STAT(STAT_MixerConnectionFailovers);
+DEFINE_STAT(STAT_MixerTickAllocations);
+DEFINE_STAT(STAT_MixerDispatchAllocations);
+DEFINE_STAT(STAT_MixerBroadcastAllocations);
+
+DECLARE_CYCLE_STAT(TEXT("Module tick"), STAT_MixerModuleTick, STATGROUP_MixerInteractivity);
+DECLARE_CYCLE_STAT(TEXT("Flush control updates"), STAT_MixerFlushControlUpdates, STATGROUP_MixerInteractivity);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Button input latency p50 (ms)"), STAT_MixerButtonLatencyP50, STATGROUP_MixerInteractivity);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Button input latency p95 (ms)"), STAT_MixerButtonLatencyP95, STATGROUP_MixerInteractivity);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Button input latency p99 (ms)"), STAT_MixerButtonLatencyP99, STATGROUP_MixerInteractivity);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Stick input latency p50 (ms)"), STAT_MixerStickLatencyP50, STATGROUP_MixerInteractivity);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Stick input latency p95 (ms)"), STAT_MixerStickLatencyP95, STATGROUP_MixerInteractivity);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Stick input latency p99 (ms)"), STAT_MixerStickLatencyP99, STATGROUP_MixerInteractivity);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Textbox input latency p50 (ms)"), STAT_MixerTextboxLatencyP50, STATGROUP_MixerInteractivity);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Textbox input latency p95 (ms)"), STAT_MixerTextboxLatencyP95, STATGROUP_MixerInteractivity);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Textbox input latency p99 (ms)"), STAT_MixerTextboxLatencyP99, STATGROUP_MixerInteractivity);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Custom control input latency p50 (ms)"), STAT_MixerCustomLatencyP50, STATGROUP_MixerInteractivity);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Custom control input latency p95 (ms)"), STAT_MixerCustomLatencyP95, STATGROUP_MixerInteractivity);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Custom control input latency p99 (ms)"), STAT_MixerCustomLatencyP99, STATGROUP_MixerInteractivity);
+
+namespace
+{
+	bool IsControlPropertyUnchanged(const FString& FieldName, const FJsonValue& KnownValue, const FJsonValue& NewValue, float ProgressEpsilon)
+	{
+		if (KnownValue.Type != NewValue.Type)
+		{
+			return false;
+		}
+
+		switch (NewValue.Type)
+		{
+		case EJson::Null:
+			return true;
+		case EJson::Boolean:
+			return KnownValue.AsBool() == NewValue.AsBool();
+		case EJson::Number:
+			if (ProgressEpsilon > 0.0f && FieldName == MixerStringConstants::FieldNames::Progress)
+			{
+				return FMath::Abs(KnownValue.AsNumber() - NewValue.AsNumber()) < ProgressEpsilon;
+			}
+			return KnownValue.AsNumber() == NewValue.AsNumber();
+		case EJson::String:
+			return KnownValue.AsString().Equals(NewValue.AsString(), ESearchCase::CaseSensitive);
+		default:
+			// Not worth a deep compare - arrays and objects always go out.
+			return false;
+		}
+	}
+
+	bool IsUrgentControlUpdate(const FJsonObject& Properties)
+	{
+		return Properties.Values.Contains(MixerStringConstants::FieldNames::Cooldown) || Properties.Values.Contains(MixerStringConstants::FieldNames::Disabled);
+	}
+
+	int32 EstimateControlUpdateSize(const FJsonObject& Properties);
+
+	int32 EstimateJsonValueSize(const FJsonValue& Value)
+	{
+		switch (Value.Type)
+		{
+		case EJson::String:
+			return Value.AsString().Len() + 2;
+		case EJson::Number:
+			return 16;
+		case EJson::Array:
+			{
+				// Custom controls can carry whole lists and maps, which are what split messages up
+				int32 Size = 2;
+				for (const TSharedPtr<FJsonValue>& Element : Value.AsArray())
+				{
+					Size += (Element.IsValid() ? EstimateJsonValueSize(*Element) : 4) + 1;
+				}
+				return Size;
+			}
+		case EJson::Object:
+			return Value.AsObject().IsValid() ? EstimateControlUpdateSize(*Value.AsObject()) : 4;
+		default:
+			return 8;
+		}
+	}
+
+	// Rough wire size of a control update, without paying for serialization.
+	int32 EstimateControlUpdateSize(const FJsonObject& Properties)
+	{
+		int32 Size = 2;
+		for (const TPair<FString, TSharedPtr<FJsonValue>>& Property : Properties.Values)
+		{
+			// Quotes, colon, comma
+			Size += Property.Key.Len() + 4;
+			if (Property.Value.IsValid())
+			{
+				Size += EstimateJsonValueSize(*Property.Value);
+			}
+		}
+		return Size;
+	}
+
+	/** Controls headed for one scene's updateControls message */
+	struct FOutgoingControlUpdates
+	{
+		FOutgoingControlUpdates()
+			: SizeEstimate(0)
+			, bUrgent(false)
+		{
+		}
+
+		TArray<TSharedPtr<FJsonValue>> Controls;
+		int32 SizeEstimate;
+
+		/** Controls holds at least one urgent update, so the message mustn't wait behind bulk traffic. */
+		bool bUrgent;
+	};
+
+	struct FDeferrableControlUpdate
+	{
+		FName SceneName;
+		FName ControlName;
+		double LastSendTime;
+
+		bool operator<(const FDeferrableControlUpdate& Other) const
+		{
+			return LastSendTime < Other.LastSendTime;
+		}
+	};
+}
+
 void FMixerInteractivityModule::StartupModule()
 {
+#if ENABLE_LOW_LEVEL_MEM_TRACKER
+	MixerLLM::RegisterTags();
+#endif
+#if MIXER_CSV_STATS_ENABLED
+	MixerCsvStats::Startup();
+#endif
+
+	ImageCache.Reset(new FMixerImageCache());
+
 	RetryLoginWithUI = false;
 	UserAuthState = EMixerLoginState::Not_Logged_In;
 	InteractiveConnectionAuthState = EMixerLoginState::Not_Logged_In;
 	InteractivityState = EMixerInteractivityState::Not_Interactive;
+	ControlUpdateBudget = 0.0;
+	ControlUpdateBudgetTime = 0.0;
+	bSendingUrgentControlUpdates = false;
+	CustomControlsEverScheduled = 0;
+	StartupTimeBase = 0.0;
+	bInputLatencyChanged = false;
+	AccessTokenRefreshTime = 0.0;
+	AccessTokenExpiryTime = 0.0;
+	ShortCodeExpiryTime = 0.0;
+	ShortCodeNextCheckTime = 0.0;
+	UserPollInterval = 0.0;
+	bSceneChangeStaged = false;
+	bPlatformLoginDelegatesBound = false;
+	ProcessingPhase = 0.0;
+	ProcessingDeltaTime = 0.0f;
+	TimeSinceProcessingStep = 0.0f;
+	bProcessingStep = true;
+	bInputDispatchStep = true;
+	bHibernating = false;
+	bBroadcastingKeyedEvent = false;
+#if MIXER_ALLOCATION_GUARD_ENABLED
+	bAllocationGuardEnabled = false;
+	AllocationGuardSteadyTime = 0.0f;
+	AllocationGuardNextWarningTime = 0.0;
+	AllocationGuardWorstFrame = 0;
+	AllocationGuardFramesOver = 0;
+#endif
+
+	// Chat, platform login hooks and the ticker all wait until Mixer is first used.
+	// Assets are the exception, since the first use is exactly when loading them would hitch.
+	PostEngineInitHandle = FCoreDelegates::OnPostEngineInit.AddLambda([]()
+	{
+		FMixerProjectAssetPreloader::Get().Start();
+	});
+	PostWorldInitHandle = FWorldDelegates::OnPostWorldInitialization.AddLambda([](UWorld*, const UWorld::InitializationValues)
+	{
+		FMixerProjectAssetPreloader::Get().Start();
+	});
+}
+
+void FMixerInteractivityModule::ShutdownModule()
+{
+	LiveEvents.Reset();
+	FMixerRestClient::Get().Reset();
+	FMixerAvatarCache::Get().Reset();
+	ImageCache.Reset();
+	FCoreDelegates::OnPostEngineInit.Remove(PostEngineInitHandle);
+	FWorldDelegates::OnPostWorldInitialization.Remove(PostWorldInitHandle);
+	FMixerProjectAssetPreloader::Get().Reset();
+	UMixerInteractivityBlueprintEventSource::ReleasePersistentSource();
+#if MIXER_SOAK_TEST_ENABLED
+	FMixerSoakTest::Get().Reset();
+#endif
+#if MIXER_MOCK_SERVICE_ENABLED
+	FMixerMockService::Get().Reset();
+#endif
+#if MIXER_TRAFFIC_RECORDER_ENABLED
+	FMixerTrafficRecorder::Get().Stop();
+#endif
+#if MIXER_CSV_STATS_ENABLED
+	MixerCsvStats::Shutdown();
+#endif
+
+	UnbindPlatformLoginDelegates();
+
+	// Tokens and endpoint preferences from this session shouldn't be lost to the save delay
+	UMixerInteractivityUserSettings::FlushDeferredSave();
+	FMixerWarmStartCache::Get().Flush();
 
-	ChatInterface = MakeShared<FOnlineChatMixer>();
+	if (TickerHandle.IsValid())
+	{
+		FTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+		TickerHandle.Reset();
+	}
+
+#if MIXER_ALLOCATION_GUARD_ENABLED
+	if (bAllocationGuardEnabled)
+	{
+		FMixerAllocationScopes::SetEnabled(false);
+		bAllocationGuardEnabled = false;
+	}
+#endif
+}
+
+void FMixerInteractivityModule::BindPlatformLoginDelegates()
+{
+	if (bPlatformLoginDelegatesBound)
+	{
+		return;
+	}
+	bPlatformLoginDelegatesBound = true;
 
 #if PLATFORM_XBOXONE
 	check(FSlateApplication::IsInitialized());
@@ -80,8 +336,14 @@ void FMixerInteractivityModule::StartupModule()
 #endif
 }
 
-void FMixerInteractivityModule::ShutdownModule()
+void FMixerInteractivityModule::UnbindPlatformLoginDelegates()
 {
+	if (!bPlatformLoginDelegatesBound)
+	{
+		return;
+	}
+	bPlatformLoginDelegatesBound = false;
+
 #if PLATFORM_XBOXONE
 	check(FSlateApplication::IsInitialized());
 	static_cast<FXboxOneInputInterface*>(FSlateApplication::Get().GetInputInterface())->OnUserRemovedDelegates.RemoveAll(this);
@@ -94,12 +356,152 @@ void FMixerInteractivityModule::ShutdownModule()
 			if (LoginCompleteDelegateHandle[i].IsValid())
 			{
 				IdentityInterface->ClearOnLoginCompleteDelegate_Handle(i, LoginCompleteDelegateHandle[i]);
+				LoginCompleteDelegateHandle[i].Reset();
 			}
 		}
 	}
 #endif
 }
 
+void FMixerInteractivityModule::WakeTicker()
+{
+	// Most wakes are for a state change that also ends hibernation
+	if (bHibernating && !ShouldHibernate())
+	{
+		SetHibernating(false);
+	}
+
+	if (!TickerHandle.IsValid())
+	{
+		const float Delay = bHibernating ? GetDefault<UMixerInteractivitySettings>()->HibernationTickInterval : 0.0f;
+		TickerHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FMixerInteractivityModule::TickFromTicker), Delay);
+	}
+}
+
+bool FMixerInteractivityModule::TickFromTicker(float DeltaTime)
+{
+	{
+		MIXER_ALLOCATION_SCOPE(Tick);
+		Tick(DeltaTime);
+	}
+#if MIXER_ALLOCATION_GUARD_ENABLED
+	TickAllocationGuard(DeltaTime);
+#endif
+
+	// Whatever wakes us next adds a fresh ticker
+	if (IsIdle())
+	{
+		TickerHandle.Reset();
+		return false;
+	}
+
+	// Replaces this ticker with one at the new interval
+	SetHibernating(ShouldHibernate());
+	return true;
+}
+
+#if MIXER_ALLOCATION_GUARD_ENABLED
+void FMixerInteractivityModule::TickAllocationGuard(float DeltaTime)
+{
+	const UMixerInteractivitySettings* Settings = GetDefault<UMixerInteractivitySettings>();
+	if (Settings->bGuardTickAllocations != bAllocationGuardEnabled)
+	{
+		// Enabled after this tick, so the first frame is counted next time round
+		bAllocationGuardEnabled = Settings->bGuardTickAllocations;
+		FMixerAllocationScopes::SetEnabled(bAllocationGuardEnabled);
+		AllocationGuardSteadyTime = 0.0f;
+		return;
+	}
+
+	if (!bAllocationGuardEnabled)
+	{
+		return;
+	}
+
+	// Dispatch may also run from outside the tick (e.g. HTTP completions), but is still this frame's
+	const uint64 TickAllocations = FMixerAllocationScopes::Consume(EMixerAllocationScope::Tick);
+	const uint64 DispatchAllocations = FMixerAllocationScopes::Consume(EMixerAllocationScope::Dispatch);
+	const uint64 BroadcastAllocations = FMixerAllocationScopes::Consume(EMixerAllocationScope::Broadcast);
+	INC_DWORD_STAT_BY(STAT_MixerTickAllocations, TickAllocations);
+	INC_DWORD_STAT_BY(STAT_MixerDispatchAllocations, DispatchAllocations);
+	INC_DWORD_STAT_BY(STAT_MixerBroadcastAllocations, BroadcastAllocations);
+
+	// Joining, scene changes and the like are expected to allocate; the settled input path isn't
+	const bool bSteadyState = InteractivityState == EMixerInteractivityState::Interactive && !bSceneChangeStaged;
+	AllocationGuardSteadyTime = bSteadyState ? AllocationGuardSteadyTime + DeltaTime : 0.0f;
+	if (AllocationGuardSteadyTime < Settings->AllocationGuardWarmupTime || Settings->SteadyStateAllocationBudget < 0)
+	{
+		return;
+	}
+
+	const uint64 FrameAllocations = TickAllocations + DispatchAllocations;
+	if (FrameAllocations > static_cast<uint64>(Settings->SteadyStateAllocationBudget))
+	{
+		AllocationGuardWorstFrame = FMath::Max(AllocationGuardWorstFrame, FrameAllocations);
+		++AllocationGuardFramesOver;
+
+		// Once every so often, with the worst since the last warning, rather than every frame
+		const double Now = FPlatformTime::Seconds();
+		if (Now >= AllocationGuardNextWarningTime)
+		{
+			UE_LOG(LogMixerInteractivity, Warning, TEXT("%d steady state frames allocated more than the budget of %d (worst %llu).  See stat MixerInteractivity for the breakdown."),
+				AllocationGuardFramesOver, Settings->SteadyStateAllocationBudget, AllocationGuardWorstFrame);
+			AllocationGuardNextWarningTime = Now + 10.0;
+			AllocationGuardWorstFrame = 0;
+			AllocationGuardFramesOver = 0;
+		}
+	}
+}
+#endif
+
+bool FMixerInteractivityModule::ShouldHibernate() const
+{
+	return GetDefault<UMixerInteractivitySettings>()->bHibernateWhenNotBroadcasting
+		&& UserAuthState == EMixerLoginState::Logged_In
+		&& CurrentUser.IsValid() && !CurrentUser->Channel.IsBroadcasting
+		&& InteractivityState == EMixerInteractivityState::Not_Interactive
+		&& !bSceneChangeStaged
+		&& (!ChatInterface.IsValid() || !ChatInterface->HasConnections());
+}
+
+void FMixerInteractivityModule::SetHibernating(bool bHibernate)
+{
+	if (bHibernate == bHibernating)
+	{
+		return;
+	}
+
+	bHibernating = bHibernate;
+	UE_LOG(LogMixerInteractivity, Verbose, TEXT("%s hibernation."), bHibernating ? TEXT("Entering") : TEXT("Leaving"));
+	if (TickerHandle.IsValid())
+	{
+		// Safe from within the ticker's own callback; the ticker won't call it again
+		FTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+		const float Delay = bHibernating ? GetDefault<UMixerInteractivitySettings>()->HibernationTickInterval : 0.0f;
+		TickerHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FMixerInteractivityModule::TickFromTicker), Delay);
+	}
+
+	if (!bHibernating)
+	{
+		// The first tick back catches up on maintenance rather than waiting out the processing interval,
+		// and its delta covers only the time since waking rather than however long the plugin was asleep
+		const float ProcessingRate = GetDefault<UMixerInteractivitySettings>()->ProcessingRate;
+		ProcessingPhase = ProcessingRate > 0.0f ? 1.0 / ProcessingRate : 0.0;
+		TimeSinceProcessingStep = 0.0f;
+	}
+}
+
+bool FMixerInteractivityModule::IsIdle() const
+{
+	return UserAuthState == EMixerLoginState::Not_Logged_In
+		&& InteractiveConnectionAuthState == EMixerLoginState::Not_Logged_In
+		&& InteractivityState == EMixerInteractivityState::Not_Interactive
+		&& !IsShortCodeLoginInProgress()
+		&& (!ChatInterface.IsValid() || !ChatInterface->HasConnections())
+		&& !FMixerRestClient::Get().HasDeferredCompletions()
+		&& !FMixerAvatarCache::Get().HasQueuedFetches();
+}
+
 bool FMixerInteractivityModule::LoginSilently(TSharedPtr<const FUniqueNetId> UserId)
 {
 	if (GetLoginState() != EMixerLoginState::Not_Logged_In)
@@ -119,6 +521,7 @@ bool FMixerInteractivityModule::LoginSilently(TSharedPtr<const FUniqueNetId> Use
 		return false;
 	}
 
+	BeginStartupTiming();
 	return LoginSilentlyInternal(UserId);
 }
 
@@ -138,7 +541,25 @@ bool FMixerInteractivityModule::LoginSilentlyInternal(TSharedPtr<const FUniqueNe
 		return false;
 	}
 
+	// Now exchange the refresh token for an access token
+	TSharedRef<IHttpRequest> TokenRequest = CreateTokenRefreshRequest();
+	TokenRequest->OnProcessRequestComplete().BindRaw(this, &FMixerInteractivityModule::OnTokenRequestComplete);
+	if (!FMixerRestClient::Get().ProcessRequest(TokenRequest))
+	{
+		SetUserAuthState(EMixerLoginState::Not_Logged_In);
+		return false;
+	}
+
+	SetUserAuthState(EMixerLoginState::Logging_In);
+	NetId = UserId;
+
+	return true;
+}
+
+TSharedRef<IHttpRequest> FMixerInteractivityModule::CreateTokenRefreshRequest() const
+{
 	const UMixerInteractivitySettings* Settings = GetDefault<UMixerInteractivitySettings>();
+	const UMixerInteractivityUserSettings* UserSettings = GetDefault<UMixerInteractivityUserSettings>();
 
 	FString ContentString;
 	TSharedRef<TJsonWriter<>> JsonWriter = TJsonWriterFactory<>::Create(&ContentString);
@@ -150,23 +571,10 @@ bool FMixerInteractivityModule::LoginSilentlyInternal(TSharedPtr<const FUniqueNe
 	JsonWriter->WriteObjectEnd();
 	JsonWriter->Close();
 
-	// Now exchange the auth code for a token
-	TSharedRef<IHttpRequest> TokenRequest = FHttpModule::Get().CreateRequest();
-	TokenRequest->SetVerb(TEXT("POST"));
-	TokenRequest->SetURL(TEXT("https://mixer.com/api/v1/oauth/token"));
+	TSharedRef<IHttpRequest> TokenRequest = FMixerRestClient::Get().CreateRequest(TEXT("POST"), TEXT("oauth/token"));
 	TokenRequest->SetHeader(TEXT("content-type"), TEXT("application/json"));
 	TokenRequest->SetContentAsString(ContentString);
-	TokenRequest->OnProcessRequestComplete().BindRaw(this, &FMixerInteractivityModule::OnTokenRequestComplete);
-	if (!TokenRequest->ProcessRequest())
-	{
-		SetUserAuthState(EMixerLoginState::Not_Logged_In);
-		return false;
-	}
-
-	SetUserAuthState(EMixerLoginState::Logging_In);
-	NetId = UserId;
-
-	return true;
+	return TokenRequest;
 }
 #endif
 
@@ -294,384 +702,1722 @@ bool FMixerInteractivityModule::LoginWithAuthCode(const FString& AuthCode, TShar
 	return LoginWithAuthCodeInternal(AuthCode, UserId);
 }
 
-bool FMixerInteractivityModule::Logout()
+// How often to ask the service whether the user has approved a short code
+static const double ShortCodeCheckInterval = 2.0;
+
+bool FMixerInteractivityModule::LoginWithShortCode(TSharedPtr<const FUniqueNetId> UserId)
 {
-	switch (GetLoginState())
+	if (!PLATFORM_SUPPORTS_MIXER_OAUTH)
 	{
-	case EMixerLoginState::Logged_In:
-	case EMixerLoginState::Logging_In:
-		StopInteractivity();
-		SetUserAuthState(EMixerLoginState::Logging_Out);
-		StopInteractiveConnection();
-		SetUserAuthState(EMixerLoginState::Not_Logged_In);
-		return true;
+		UE_LOG(LogMixerInteractivity, Warning, TEXT("LoginWithShortCode is part of OAuth login flow which is not supported on this platform."));
+		return false;
+	}
 
-	default:
+	if (GetLoginState() != EMixerLoginState::Not_Logged_In)
+	{
 		return false;
 	}
+
+#if PLATFORM_SUPPORTS_MIXER_OAUTH
+	// Startup timing begins in LoginWithAuthCodeInternal once the code is approved, so the wait for the user isn't counted
+	const UMixerInteractivitySettings* Settings = GetDefault<UMixerInteractivitySettings>();
+	FString ContentString;
+	TSharedRef<TJsonWriter<>> JsonWriter = TJsonWriterFactory<>::Create(&ContentString);
+	JsonWriter->WriteObjectStart();
+	JsonWriter->WriteValue(TEXT("client_id"), Settings->ClientId);
+	JsonWriter->WriteValue(TEXT("scope"), Settings->GetOAuthScope());
+	JsonWriter->WriteObjectEnd();
+	JsonWriter->Close();
+
+	TSharedRef<IHttpRequest> CodeRequest = FMixerRestClient::Get().CreateRequest(TEXT("POST"), TEXT("oauth/shortcode"));
+	CodeRequest->SetHeader(TEXT("content-type"), TEXT("application/json"));
+	CodeRequest->SetContentAsString(ContentString);
+	CodeRequest->OnProcessRequestComplete().BindRaw(this, &FMixerInteractivityModule::OnShortCodeRequestComplete);
+	if (!FMixerRestClient::Get().ProcessRequest(CodeRequest))
+	{
+		return false;
+	}
+
+	ShortCodeRequest = CodeRequest;
+	NetId = UserId;
+	SetUserAuthState(EMixerLoginState::Logging_In);
+#endif
+	return true;
+}
+
+bool FMixerInteractivityModule::ParseShortCodeResponse(const FString& Content, FMixerShortCodeResponse& OutShortCodeResponse)
+{
+	TSharedRef<TJsonReader<>> JsonReader = TJsonReaderFactory<>::Create(Content);
+	TSharedPtr<FJsonObject> JsonObject;
+	if (FJsonSerializer::Deserialize(JsonReader, JsonObject) &&
+		JsonObject.IsValid())
+	{
+		// The initial response also carries a handle and lifetime; the check response only the auth code
+		JsonObject->TryGetStringField(TEXT("handle"), OutShortCodeResponse.Handle);
+		JsonObject->TryGetNumberField(TEXT("expires_in"), OutShortCodeResponse.ExpiresIn);
+		return JsonObject->TryGetStringField(TEXT("code"), OutShortCodeResponse.Code);
+	}
+	return false;
 }
 
-EMixerLoginState FMixerInteractivityModule::GetLoginState()
+void FMixerInteractivityModule::OnShortCodeRequestComplete(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded)
 {
-	EMixerLoginState UserState = GetUserAuthState();
-	switch (UserState)
+	// Still counts as in flight until parsed, so that CancelShortCodeLogin can abandon it
+	const bool bResponseOk = bSucceeded && HttpResponse.IsValid() && EHttpResponseCodes::IsOk(HttpResponse->GetResponseCode());
+	ParseHttpResponseAsync<FMixerShortCodeResponse>(HttpResponse, &FMixerInteractivityModule::ParseShortCodeResponse, [this, HttpRequest, bResponseOk](bool bParsed, FMixerShortCodeResponse& ShortCodeResponse)
 	{
-	case EMixerLoginState::Logged_In:
-		check(CurrentUser.IsValid());
-		return NeedsClientLibraryActive() ? GetInteractiveConnectionAuthState() : UserState;
+		if (ShortCodeRequest != HttpRequest)
+		{
+			return;
+		}
 
-	case EMixerLoginState::Logging_In:
-	case EMixerLoginState::Logging_Out:
-	case EMixerLoginState::Not_Logged_In:
-		return UserState;
+		ShortCodeRequest.Reset();
+		if (!bResponseOk || !bParsed || ShortCodeResponse.Handle.IsEmpty())
+		{
+			UE_LOG(LogMixerInteractivity, Warning, TEXT("Failed to obtain a Mixer short code."));
+			SetUserAuthState(EMixerLoginState::Not_Logged_In);
+			return;
+		}
 
-	default:
-		// Internal error in Mixer plugin state management
-		check(false);
-		return EMixerLoginState::Not_Logged_In;
+		const double Now = FPlatformTime::Seconds();
+		ShortCodeHandle = ShortCodeResponse.Handle;
+		ShortCodeExpiryTime = Now + ShortCodeResponse.ExpiresIn;
+		ShortCodeNextCheckTime = Now + ShortCodeCheckInterval;
+		OnShortCodeReceived().Broadcast(ShortCodeResponse.Code, FTimespan::FromSeconds(ShortCodeResponse.ExpiresIn));
+	});
+}
+
+void FMixerInteractivityModule::TickShortCodeLogin()
+{
+#if PLATFORM_SUPPORTS_MIXER_OAUTH
+	if (ShortCodeHandle.IsEmpty() || ShortCodeRequest.IsValid() || UserAuthState != EMixerLoginState::Logging_In)
+	{
+		return;
+	}
+
+	const double Now = FPlatformTime::Seconds();
+	if (Now >= ShortCodeExpiryTime)
+	{
+		UE_LOG(LogMixerInteractivity, Log, TEXT("Mixer short code expired before it was approved."));
+		CancelShortCodeLogin();
+		SetUserAuthState(EMixerLoginState::Not_Logged_In);
+	}
+	else if (Now >= ShortCodeNextCheckTime)
+	{
+		TSharedRef<IHttpRequest> CheckRequest = FMixerRestClient::Get().CreateRequest(TEXT("GET"), FString::Printf(TEXT("oauth/shortcode/check/%s"), *ShortCodeHandle));
+		CheckRequest->OnProcessRequestComplete().BindRaw(this, &FMixerInteractivityModule::OnShortCodeCheckComplete);
+		if (FMixerRestClient::Get().ProcessRequest(CheckRequest))
+		{
+			ShortCodeRequest = CheckRequest;
+		}
+		ShortCodeNextCheckTime = Now + ShortCodeCheckInterval;
+	}
+#endif
+}
+
+void FMixerInteractivityModule::OnShortCodeCheckComplete(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded)
+{
+	if (ShortCodeRequest != HttpRequest)
+	{
+		return;
+	}
+
+	const int32 ResponseCode = bSucceeded && HttpResponse.IsValid() ? HttpResponse->GetResponseCode() : EHttpResponseCodes::Unknown;
+	if (ResponseCode == EHttpResponseCodes::Ok)
+	{
+		ParseHttpResponseAsync<FMixerShortCodeResponse>(HttpResponse, &FMixerInteractivityModule::ParseShortCodeResponse, [this, HttpRequest](bool bParsed, FMixerShortCodeResponse& ShortCodeResponse)
+		{
+			if (ShortCodeRequest != HttpRequest)
+			{
+				return;
+			}
+
+			ShortCodeRequest.Reset();
+			CancelShortCodeLogin();
+			if (bParsed)
+			{
+				// Codes approved via mixer.com/go aren't bound to a redirect uri
+				LoginWithAuthCodeInternal(ShortCodeResponse.Code, NetId, false);
+			}
+			else
+			{
+				SetUserAuthState(EMixerLoginState::Not_Logged_In);
+			}
+		});
+	}
+	else if (ResponseCode == EHttpResponseCodes::Denied || ResponseCode == EHttpResponseCodes::NotFound)
+	{
+		// Denied by the user, or expired on the service side
+		UE_LOG(LogMixerInteractivity, Log, TEXT("Mixer short code was %s."), ResponseCode == EHttpResponseCodes::Denied ? TEXT("denied") : TEXT("not found"));
+		ShortCodeRequest.Reset();
+		CancelShortCodeLogin();
+		SetUserAuthState(EMixerLoginState::Not_Logged_In);
+	}
+	else
+	{
+		// 204 while the user has yet to act; transient failures are retried at the same pace until the code expires
+		ShortCodeRequest.Reset();
+	}
+}
+
+bool FMixerInteractivityModule::IsShortCodeLoginInProgress() const
+{
+	return ShortCodeRequest.IsValid() || !ShortCodeHandle.IsEmpty();
+}
+
+void FMixerInteractivityModule::CancelShortCodeLogin()
+{
+	ShortCodeHandle.Empty();
+	ShortCodeExpiryTime = 0.0;
+	ShortCodeNextCheckTime = 0.0;
+	if (ShortCodeRequest.IsValid())
+	{
+		ShortCodeRequest->OnProcessRequestComplete().Unbind();
+		ShortCodeRequest->CancelRequest();
+		ShortCodeRequest.Reset();
+	}
+}
+
+bool FMixerInteractivityModule::Logout()
+{
+	// Nothing is connected yet while waiting on a short code, so cancelling is all there is to do
+	if (IsShortCodeLoginInProgress())
+	{
+		CancelShortCodeLogin();
+		SetUserAuthState(EMixerLoginState::Not_Logged_In);
+		return true;
+	}
+
+	switch (GetLoginState())
+	{
+	case EMixerLoginState::Logged_In:
+	case EMixerLoginState::Logging_In:
+		StopInteractivity();
+		SetUserAuthState(EMixerLoginState::Logging_Out);
+		StopInteractiveConnection();
+		SetUserAuthState(EMixerLoginState::Not_Logged_In);
+		return true;
+
+	default:
+		return false;
+	}
+}
+
+EMixerLoginState FMixerInteractivityModule::GetLoginState()
+{
+	EMixerLoginState UserState = GetUserAuthState();
+	switch (UserState)
+	{
+	case EMixerLoginState::Logged_In:
+		check(CurrentUser.IsValid());
+		return NeedsClientLibraryActive() ? GetInteractiveConnectionAuthState() : UserState;
+
+	case EMixerLoginState::Logging_In:
+	case EMixerLoginState::Logging_Out:
+	case EMixerLoginState::Not_Logged_In:
+		return UserState;
+
+	default:
+		// Internal error in Mixer plugin state management
+		check(false);
+		return EMixerLoginState::Not_Logged_In;
+	}
+}
+
+bool FMixerInteractivityModule::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_MixerModuleTick);
+
+	// Backends tick after this, so everything below and in their ticks shares this frame's budget
+	FMixerFrameScheduler::Get().BeginFrame();
+	UpdateProcessingStep(DeltaTime);
+
+#if PLATFORM_XBOXONE
+	TickXboxLogin();
+#endif
+
+	TickLocalUserMaintenance();
+	TickAccessTokenRefresh();
+	TickShortCodeLogin();
+	FMixerRestClient::Get().DeliverDeferredCompletions();
+	FMixerAvatarCache::Get().Tick(DeltaTime);
+
+	// Backends dispatch input after this base tick, so this delivers what arrived over the previous frame
+	if (bInputDispatchStep)
+	{
+		MIXER_ALLOCATION_SCOPE(Broadcast);
+		FlushCoalescedEvents.Broadcast();
+	}
+
+	if (bProcessingStep)
+	{
+		TickCustomControls(ProcessingDeltaTime);
+		FlushControlUpdates();
+		FlushSparkCaptures();
+		UpdateInputLatencyStats();
+	}
+
+	if (ChatInterface.IsValid())
+	{
+		ChatInterface->Tick();
+	}
+
+	// Names are shared between the interactive and chat caches, so neither owns the cleanup
+	if (bProcessingStep)
+	{
+		FMixerUserName::TrimUnused();
+	}
+
+	if (!NeedsClientLibraryActive())
+	{
+		StopInteractivity();
+		StopInteractiveConnection();
+	}
+
+	return true;
+
+}
+
+void FMixerInteractivityModule::UpdateProcessingStep(float DeltaTime)
+{
+	const UMixerInteractivitySettings* Settings = GetDefault<UMixerInteractivitySettings>();
+	TimeSinceProcessingStep += DeltaTime;
+	if (bHibernating)
+	{
+		// Only the sockets and SDK pump run, which is enough for keepalives and to notice going live
+		bProcessingStep = false;
+		bInputDispatchStep = true;
+		return;
+	}
+
+	if (Settings->ProcessingRate > 0.0f)
+	{
+		// The remainder carries over so the rate holds on average, but a hitch doesn't queue up extra steps
+		const double Interval = 1.0 / Settings->ProcessingRate;
+		ProcessingPhase += DeltaTime;
+		bProcessingStep = ProcessingPhase >= Interval;
+		if (bProcessingStep)
+		{
+			ProcessingPhase = FMath::Min(ProcessingPhase - Interval, Interval);
+		}
+	}
+	else
+	{
+		ProcessingPhase = 0.0;
+		bProcessingStep = true;
+	}
+
+	if (bProcessingStep)
+	{
+		ProcessingDeltaTime = TimeSinceProcessingStep;
+		TimeSinceProcessingStep = 0.0f;
+	}
+	bInputDispatchStep = bProcessingStep || !Settings->bDispatchInputAtProcessingRate;
+}
+
+// Poll rates for the local user.  With live events subscribed, polling is only a safety net.
+static const double UserPollingMinInterval = 30.0;
+static const double UserPollingMaxInterval = 120.0;
+static const double UserPollingIntervalWithLiveEvents = 300.0;
+
+void FMixerInteractivityModule::TickLocalUserMaintenance()
+{
+	if (NeedsClientLibraryActive() && CurrentUser.IsValid())
+	{
+		TickLiveEvents();
+
+		// Polling relaxed on the strength of live events has to pick back up as soon as they stop
+		if (UserPollInterval == UserPollingIntervalWithLiveEvents && !(LiveEvents.IsValid() && LiveEvents->IsSubscribed()))
+		{
+			UserPollInterval = UserPollingMinInterval;
+			if (CurrentUser->RefreshAtAppTime != MAX_dbl)
+			{
+				// Otherwise a request is in flight, and its completion schedules the next one
+				CurrentUser->RefreshAtAppTime = FMath::Min(CurrentUser->RefreshAtAppTime, FApp::GetCurrentTime() + UserPollInterval);
+			}
+		}
+
+		if (FApp::GetCurrentTime() > CurrentUser->RefreshAtAppTime)
+		{
+			// Revalidated by ETag in the REST client, so an unchanged user costs little
+			TSharedRef<IHttpRequest> UserRequest = FMixerRestClient::Get().CreateRequest(TEXT("GET"), FString::Printf(TEXT("users/%d"), CurrentUser->Id));
+			UserRequest->OnProcessRequestComplete().BindRaw(this, &FMixerInteractivityModule::OnUserMaintenanceRequestComplete);
+			FMixerRestClient::Get().ProcessRequest(UserRequest);
+
+			// Prevent further polling while we have a request active
+			CurrentUser->RefreshAtAppTime = MAX_dbl;
+		}
+	}
+	else
+	{
+		LiveEvents.Reset();
+	}
+}
+
+void FMixerInteractivityModule::TickLiveEvents()
+{
+#if WITH_WEBSOCKETS
+	if (!GetDefault<UMixerInteractivitySettings>()->bUseLiveEventsForUserUpdates)
+	{
+		LiveEvents.Reset();
+		return;
+	}
+
+	if (LiveEvents.IsValid() && LiveEvents->GetUserId() == CurrentUser->Id)
+	{
+		LiveEvents->Tick();
+	}
+	else
+	{
+		LiveEvents = MakeShared<FMixerConstellationConnection>(CurrentUser->Id, CurrentUser->Channel.Id, FMixerConstellationConnection::FOnLiveEvent::CreateRaw(this, &FMixerInteractivityModule::OnLiveEvent));
+		LiveEvents->Init();
+	}
+#endif
+}
+
+void FMixerInteractivityModule::OnLiveEvent(const FString& EventName, const FJsonObject& Payload)
+{
+	if (!CurrentUser.IsValid())
+	{
+		return;
+	}
+
+	// Payloads are partial - only what changed is present
+	if (EventName.StartsWith(TEXT("channel:")))
+	{
+		Payload.TryGetNumberField(TEXT("viewersCurrent"), CurrentUser->Channel.CurrentViewers);
+		Payload.TryGetNumberField(TEXT("viewersTotal"), CurrentUser->Channel.LifetimeUniqueViewers);
+		Payload.TryGetNumberField(TEXT("numFollowers"), CurrentUser->Channel.Followers);
+
+		bool bIsBroadcasting = false;
+		if (Payload.TryGetBoolField(TEXT("online"), bIsBroadcasting))
+		{
+			UpdateBroadcastingState(bIsBroadcasting);
+		}
+	}
+	else if (EventName.StartsWith(TEXT("user:")))
+	{
+		Payload.TryGetNumberField(TEXT("sparks"), CurrentUser->Sparks);
+		Payload.TryGetNumberField(TEXT("experience"), CurrentUser->Experience);
+		Payload.TryGetNumberField(TEXT("level"), CurrentUser->Level);
+	}
+}
+
+void FMixerInteractivityModule::UpdateBroadcastingState(bool bIsBroadcasting)
+{
+	if (CurrentUser->Channel.IsBroadcasting != bIsBroadcasting)
+	{
+		CurrentUser->Channel.IsBroadcasting = bIsBroadcasting;
+		WakeTicker();
+		OnBroadcastingStateChanged().Broadcast(bIsBroadcasting);
+	}
+}
+
+bool FMixerInteractivityModule::ParseUserResponse(const FString& Content, FMixerLocalUserJsonSerializable& OutUser)
+{
+	return OutUser.FromJson(Content);
+}
+
+void FMixerInteractivityModule::OnUserMaintenanceRequestComplete(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded)
+{
+	if (!bSucceeded || !HttpResponse.IsValid() || !EHttpResponseCodes::IsOk(HttpResponse->GetResponseCode()))
+	{
+		FMixerLocalUserJsonSerializable NoUser;
+		OnUserMaintenanceResponseParsed(false, NoUser);
+		return;
+	}
+
+	ParseHttpResponseAsync<FMixerLocalUserJsonSerializable>(HttpResponse, &FMixerInteractivityModule::ParseUserResponse, [this](bool bParsed, FMixerLocalUserJsonSerializable& UpdatedUser)
+	{
+		OnUserMaintenanceResponseParsed(bParsed, UpdatedUser);
+	});
+}
+
+void FMixerInteractivityModule::OnUserMaintenanceResponseParsed(bool bParsed, FMixerLocalUserJsonSerializable& UpdatedUser)
+{
+	if (CurrentUser.IsValid())
+	{
+		bool bChanged = false;
+		// Make sure the user hasn't changed!
+		if (bParsed && CurrentUser->Id == UpdatedUser.Id)
+		{
+			bChanged = CurrentUser->Sparks != UpdatedUser.Sparks ||
+				CurrentUser->Experience != UpdatedUser.Experience ||
+				CurrentUser->Level != UpdatedUser.Level ||
+				CurrentUser->Channel.IsBroadcasting != UpdatedUser.Channel.IsBroadcasting;
+
+			CurrentUser->Sparks = UpdatedUser.Sparks;
+			CurrentUser->Experience = UpdatedUser.Experience;
+			CurrentUser->Level = UpdatedUser.Level;
+
+			const bool bIsBroadcasting = UpdatedUser.Channel.IsBroadcasting;
+			UpdatedUser.Channel.IsBroadcasting = CurrentUser->Channel.IsBroadcasting;
+			CurrentUser->Channel = UpdatedUser.Channel;
+			UpdateBroadcastingState(bIsBroadcasting);
+		}
+
+		// Note: so far, adjusting this interval in response to app lifecycle events (in case broadcasting
+		// was started by the user while app was in background) have not been terribly effective - when starting the
+		// state takes long enough to change on the service that it's not very different from just waiting for the next
+		// regularly schedule poll.  So instead back off while nothing changes, and lean on live events where available.
+		if (LiveEvents.IsValid() && LiveEvents->IsSubscribed())
+		{
+			UserPollInterval = UserPollingIntervalWithLiveEvents;
+		}
+		else
+		{
+			UserPollInterval = bChanged || UserPollInterval <= 0.0 ? UserPollingMinInterval : FMath::Min(UserPollInterval * 1.5, UserPollingMaxInterval);
+		}
+		CurrentUser->RefreshAtAppTime = FMath::Min(CurrentUser->RefreshAtAppTime, FApp::GetCurrentTime() + UserPollInterval);
+	}
+}
+
+bool FMixerInteractivityModule::LoginWithAuthCodeInternal(const FString& AuthCode, TSharedPtr<const FUniqueNetId> UserId, bool bIncludeRedirectUri)
+{
+	check(PLATFORM_SUPPORTS_MIXER_OAUTH);
+
+#if PLATFORM_SUPPORTS_MIXER_OAUTH
+	BeginStartupTiming();
+
+	const UMixerInteractivitySettings* Settings = GetDefault<UMixerInteractivitySettings>();
+	FString ContentString;
+	TSharedRef<TJsonWriter<>> JsonWriter = TJsonWriterFactory<>::Create(&ContentString);
+	JsonWriter->WriteObjectStart();
+	JsonWriter->WriteValue(TEXT("grant_type"), TEXT("authorization_code"));
+	if (bIncludeRedirectUri)
+	{
+		JsonWriter->WriteValue(TEXT("redirect_uri"), Settings->GetResolvedRedirectUri());
+	}
+	JsonWriter->WriteValue(TEXT("client_id"), Settings->ClientId);
+	JsonWriter->WriteValue(TEXT("code"), AuthCode);
+	JsonWriter->WriteObjectEnd();
+	JsonWriter->Close();
+
+	// Now exchange the auth code for a token
+	TSharedRef<IHttpRequest> TokenRequest = FMixerRestClient::Get().CreateRequest(TEXT("POST"), TEXT("oauth/token"));
+	TokenRequest->SetHeader(TEXT("content-type"), TEXT("application/json"));
+	TokenRequest->SetContentAsString(ContentString);
+	TokenRequest->OnProcessRequestComplete().BindRaw(this, &FMixerInteractivityModule::OnTokenRequestComplete);
+	if (!FMixerRestClient::Get().ProcessRequest(TokenRequest))
+	{
+		SetUserAuthState(EMixerLoginState::Not_Logged_In);
+		return false;
+	}
+
+	NetId = UserId;
+	SetUserAuthState(EMixerLoginState::Logging_In);
+#endif
+	return true;
+}
+
+void FMixerInteractivityModule::OnTokenRequestComplete(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded)
+{
+	check(PLATFORM_SUPPORTS_MIXER_OAUTH);
+
+#if PLATFORM_SUPPORTS_MIXER_OAUTH
+	const bool bResponseOk = bSucceeded && HttpResponse.IsValid() && EHttpResponseCodes::IsOk(HttpResponse->GetResponseCode());
+	ParseHttpResponseAsync<FMixerTokenResponse>(HttpResponse, &FMixerInteractivityModule::ParseTokenResponse, [this, bResponseOk](bool bParsed, FMixerTokenResponse& TokenResponse)
+	{
+		OnTokenResponseParsed(bResponseOk && bParsed, TokenResponse);
+	});
+#endif
+}
+
+void FMixerInteractivityModule::OnTokenResponseParsed(bool bGotAccessToken, const FMixerTokenResponse& TokenResponse)
+{
+	check(PLATFORM_SUPPORTS_MIXER_OAUTH);
+
+#if PLATFORM_SUPPORTS_MIXER_OAUTH
+	// The login may have been abandoned while the response was being parsed
+	if (UserAuthState != EMixerLoginState::Logging_In)
+	{
+		return;
+	}
+
+	if (bGotAccessToken)
+	{
+		ApplyTokenResponse(TokenResponse);
+
+		// Now get user info
+		const UMixerInteractivityUserSettings* UserSettings = GetDefault<UMixerInteractivityUserSettings>();
+		TSharedRef<IHttpRequest> UserRequest = FMixerRestClient::Get().CreateRequest(TEXT("GET"), TEXT("users/current"), UserSettings->GetAuthZHeaderValue());
+		UserRequest->OnProcessRequestComplete().BindRaw(this, &FMixerInteractivityModule::OnUserRequestComplete);
+		if (FMixerRestClient::Get().ProcessRequest(UserRequest))
+		{
+			OnAccessTokenAcquired();
+		}
+		else
+		{
+			SetUserAuthState(EMixerLoginState::Not_Logged_In);
+		}
+	}
+	else
+	{
+#if WITH_EDITOR
+		FText NotificationText;
+		if (!TokenResponse.ErrorDescription.IsEmpty())
+		{
+			NotificationText = FText::Format(NSLOCTEXT("MixerInteractivityEditor", "OnTokenRequestComplete_Failed_WithDescription", "Login failed with error: {0}"), FText::FromString(TokenResponse.ErrorDescription));
+		}
+		else
+		{
+			NotificationText = NSLOCTEXT("MixerInteractivityEditor", "OnTokenRequestComplete_Failed_Generic", "Login failed with unknown error.");
+		}
+		FNotificationInfo Info(NotificationText);
+		Info.ExpireDuration = 8.0f;
+		FSlateNotificationManager::Get().AddNotification(Info);
+#endif
+
+		SetUserAuthState(EMixerLoginState::Not_Logged_In);
+	}
+#endif
+}
+
+bool FMixerInteractivityModule::ParseTokenResponse(const FString& Content, FMixerTokenResponse& OutTokenResponse)
+{
+	bool bGotTokens = false;
+	TSharedRef<TJsonReader<>> JsonReader = TJsonReaderFactory<>::Create(Content);
+	TSharedPtr<FJsonObject> JsonObject;
+	if (FJsonSerializer::Deserialize(JsonReader, JsonObject) &&
+		JsonObject.IsValid())
+	{
+		bGotTokens = JsonObject->TryGetStringField(TEXT("access_token"), OutTokenResponse.AccessToken);
+		bGotTokens &= JsonObject->TryGetStringField(TEXT("refresh_token"), OutTokenResponse.RefreshToken);
+		JsonObject->TryGetNumberField(TEXT("expires_in"), OutTokenResponse.ExpiresIn);
+		JsonObject->TryGetStringField(TEXT("error_description"), OutTokenResponse.ErrorDescription);
+	}
+	return bGotTokens;
+}
+
+void FMixerInteractivityModule::ApplyTokenResponse(const FMixerTokenResponse& TokenResponse)
+{
+	check(PLATFORM_SUPPORTS_MIXER_OAUTH);
+
+#if PLATFORM_SUPPORTS_MIXER_OAUTH
+	UMixerInteractivityUserSettings* UserSettings = GetMutableDefault<UMixerInteractivityUserSettings>();
+	UserSettings->AccessToken = TokenResponse.AccessToken;
+	UserSettings->RefreshToken = TokenResponse.RefreshToken;
+	UserSettings->SaveConfigDeferred();
+
+	if (TokenResponse.ExpiresIn > 0.0)
+	{
+		ScheduleAccessTokenRefresh(TokenResponse.ExpiresIn);
+	}
+#endif
+}
+
+void FMixerInteractivityModule::ScheduleAccessTokenRefresh(double ExpiresIn)
+{
+	const double Now = FPlatformTime::Seconds();
+	const double LeadTime = GetDefault<UMixerInteractivitySettings>()->AccessTokenRefreshLeadTime;
+	AccessTokenExpiryTime = Now + ExpiresIn;
+
+	// Never closer to expiry than the lead time, but don't churn on very short-lived tokens either
+	AccessTokenRefreshTime = LeadTime > 0.0 ? Now + FMath::Max(ExpiresIn - LeadTime, ExpiresIn * 0.5) : 0.0;
+}
+
+void FMixerInteractivityModule::TickAccessTokenRefresh()
+{
+#if PLATFORM_SUPPORTS_MIXER_OAUTH
+	if (AccessTokenRefreshTime > 0.0 && FPlatformTime::Seconds() >= AccessTokenRefreshTime && UserAuthState == EMixerLoginState::Logged_In)
+	{
+		AccessTokenRefreshTime = 0.0;
+
+		TSharedRef<IHttpRequest> TokenRequest = CreateTokenRefreshRequest();
+		TokenRequest->OnProcessRequestComplete().BindRaw(this, &FMixerInteractivityModule::OnBackgroundTokenRefreshComplete);
+		if (FMixerRestClient::Get().ProcessRequest(TokenRequest))
+		{
+			UE_LOG(LogMixerInteractivity, Verbose, TEXT("Refreshing Mixer access token %.0fs ahead of expiry"), AccessTokenExpiryTime - FPlatformTime::Seconds());
+			BackgroundTokenRefreshRequest = TokenRequest;
+		}
+		else
+		{
+			// Try again shortly
+			AccessTokenRefreshTime = FPlatformTime::Seconds() + 30.0;
+		}
+	}
+#endif
+}
+
+void FMixerInteractivityModule::CancelAccessTokenRefresh()
+{
+	AccessTokenRefreshTime = 0.0;
+	AccessTokenExpiryTime = 0.0;
+	if (BackgroundTokenRefreshRequest.IsValid())
+	{
+		BackgroundTokenRefreshRequest->OnProcessRequestComplete().Unbind();
+		BackgroundTokenRefreshRequest->CancelRequest();
+		BackgroundTokenRefreshRequest.Reset();
+	}
+}
+
+void FMixerInteractivityModule::OnBackgroundTokenRefreshComplete(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded)
+{
+	// Still counts as in flight until parsed, so that CancelAccessTokenRefresh can abandon it
+	const bool bResponseOk = bSucceeded && HttpResponse.IsValid() && EHttpResponseCodes::IsOk(HttpResponse->GetResponseCode());
+	ParseHttpResponseAsync<FMixerTokenResponse>(HttpResponse, &FMixerInteractivityModule::ParseTokenResponse, [this, HttpRequest, bResponseOk](bool bParsed, FMixerTokenResponse& TokenResponse)
+	{
+		if (BackgroundTokenRefreshRequest == HttpRequest)
+		{
+			BackgroundTokenRefreshRequest.Reset();
+			OnBackgroundTokenResponseParsed(bResponseOk && bParsed, TokenResponse);
+		}
+	});
+}
+
+void FMixerInteractivityModule::OnBackgroundTokenResponseParsed(bool bGotAccessToken, const FMixerTokenResponse& TokenResponse)
+{
+	// On success the next refresh is scheduled here.  Backends read the new token from
+	// user settings the next time they open a socket, or take it directly if they hold a copy.
+	if (bGotAccessToken)
+	{
+		ApplyTokenResponse(TokenResponse);
+		OnAccessTokenRefreshed();
+	}
+	else
+	{
+		const double Remaining = AccessTokenExpiryTime - FPlatformTime::Seconds();
+		UE_LOG(LogMixerInteractivity, Warning, TEXT("Background refresh of Mixer access token failed (%s); %.0fs until expiry."),
+			TokenResponse.ErrorDescription.IsEmpty() ? TEXT("unknown error") : *TokenResponse.ErrorDescription, Remaining);
+
+		// Keep trying while the current token is still good
+		if (Remaining > 0.0)
+		{
+			AccessTokenRefreshTime = FPlatformTime::Seconds() + FMath::Min(30.0, Remaining * 0.5);
+		}
+	}
+}
+
+void FMixerInteractivityModule::OnUserRequestComplete(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded)
+{
+	if (!bSucceeded || !HttpResponse.IsValid() || !EHttpResponseCodes::IsOk(HttpResponse->GetResponseCode()))
+	{
+		FMixerLocalUserJsonSerializable NoUser;
+		OnUserResponseParsed(false, NoUser);
+		return;
+	}
+
+	ParseHttpResponseAsync<FMixerLocalUserJsonSerializable>(HttpResponse, &FMixerInteractivityModule::ParseUserResponse, [this](bool bParsed, FMixerLocalUserJsonSerializable& User)
+	{
+		OnUserResponseParsed(bParsed, User);
+	});
+}
+
+void FMixerInteractivityModule::OnUserResponseParsed(bool bParsed, FMixerLocalUserJsonSerializable& User)
+{
+	// A pipelined login may already have been abandoned because the interactive connection failed
+	if (UserAuthState != EMixerLoginState::Logging_In)
+	{
+		return;
+	}
+
+	if (bParsed)
+	{
+		CurrentUser = MakeShareable(new FMixerLocalUserJsonSerializable(MoveTemp(User)));
+		FMixerWarmStartCache::Get().ValidateUser(CurrentUser->Id);
+	}
+
+	if (CurrentUser.IsValid())
+	{
+		MarkStartupPhase(StartupTimings.UserFetched, TEXT("user fetched"));
+	}
+	else if (GetInteractiveConnectionAuthState() != EMixerLoginState::Not_Logged_In)
+	{
+		// Opened early by a pipelined login
+		StopInteractiveConnection();
+	}
+
+	SetUserAuthState(CurrentUser.IsValid() ? EMixerLoginState::Logged_In : EMixerLoginState::Not_Logged_In);
+}
+
+bool FMixerInteractivityModule::GetStartupTimings(FMixerStartupTimings& OutTimings)
+{
+	if (StartupTimeBase == 0.0)
+	{
+		return false;
+	}
+
+	OutTimings = StartupTimings;
+	return true;
+}
+
+void FMixerInteractivityModule::RecordInputLatency(EMixerInputLatencyClass LatencyClass, double ArrivedTime)
+{
+	if (ArrivedTime <= 0.0)
+	{
+		return;
+	}
+
+	const double LatencyMs = FMath::Max(0.0, (FPlatformTime::Seconds() - ArrivedTime) * 1000.0);
+	const int32 Bucket = LatencyMs <= 0.05 ? 0 : FMath::Min(NumInputLatencyBuckets - 1, FMath::CeilToInt(FMath::Loge(LatencyMs / 0.05) / FMath::Loge(1.25)));
+
+	FInputLatencyHistogram& Histogram = InputLatency[static_cast<int32>(LatencyClass)];
+	++Histogram.Buckets[Bucket];
+	++Histogram.NumSamples;
+	Histogram.TotalMs += LatencyMs;
+	Histogram.MaxMs = FMath::Max(Histogram.MaxMs, LatencyMs);
+	bInputLatencyChanged = true;
+}
+
+bool FMixerInteractivityModule::GetInputLatency(EMixerInputLatencyClass LatencyClass, FMixerInputLatencyStats& OutStats)
+{
+	const int32 ClassIndex = static_cast<int32>(LatencyClass);
+	if (ClassIndex < 0 || ClassIndex >= static_cast<int32>(EMixerInputLatencyClass::Count) || InputLatency[ClassIndex].NumSamples == 0)
+	{
+		return false;
+	}
+
+	const FInputLatencyHistogram& Histogram = InputLatency[ClassIndex];
+	const float Percentiles[] = { 0.50f, 0.95f, 0.99f };
+	float* Results[] = { &OutStats.P50Ms, &OutStats.P95Ms, &OutStats.P99Ms };
+	int32 NextPercentile = 0;
+	uint32 Cumulative = 0;
+	for (int32 Bucket = 0; Bucket < NumInputLatencyBuckets && NextPercentile < ARRAY_COUNT(Percentiles); ++Bucket)
+	{
+		Cumulative += Histogram.Buckets[Bucket];
+		while (NextPercentile < ARRAY_COUNT(Percentiles) && Cumulative >= Percentiles[NextPercentile] * Histogram.NumSamples)
+		{
+			// Never report more than was actually seen
+			*Results[NextPercentile++] = static_cast<float>(FMath::Min(0.05 * FMath::Pow(1.25, static_cast<double>(Bucket)), Histogram.MaxMs));
+		}
+	}
+
+	OutStats.NumSamples = Histogram.NumSamples;
+	OutStats.MeanMs = static_cast<float>(Histogram.TotalMs / Histogram.NumSamples);
+	OutStats.MaxMs = static_cast<float>(Histogram.MaxMs);
+	return true;
+}
+
+void FMixerInteractivityModule::ResetInputLatency()
+{
+	for (FInputLatencyHistogram& Histogram : InputLatency)
+	{
+		Histogram = FInputLatencyHistogram();
+	}
+	bInputLatencyChanged = true;
+}
+
+void FMixerInteractivityModule::UpdateInputLatencyStats()
+{
+#if STATS
+	if (!bInputLatencyChanged)
+	{
+		return;
+	}
+	bInputLatencyChanged = false;
+
+	FMixerInputLatencyStats Stats[static_cast<int32>(EMixerInputLatencyClass::Count)];
+	for (int32 i = 0; i < static_cast<int32>(EMixerInputLatencyClass::Count); ++i)
+	{
+		GetInputLatency(static_cast<EMixerInputLatencyClass>(i), Stats[i]);
+	}
+
+	const FMixerInputLatencyStats& Button = Stats[static_cast<int32>(EMixerInputLatencyClass::Button)];
+	SET_FLOAT_STAT(STAT_MixerButtonLatencyP50, Button.P50Ms);
+	SET_FLOAT_STAT(STAT_MixerButtonLatencyP95, Button.P95Ms);
+	SET_FLOAT_STAT(STAT_MixerButtonLatencyP99, Button.P99Ms);
+
+	const FMixerInputLatencyStats& Stick = Stats[static_cast<int32>(EMixerInputLatencyClass::Stick)];
+	SET_FLOAT_STAT(STAT_MixerStickLatencyP50, Stick.P50Ms);
+	SET_FLOAT_STAT(STAT_MixerStickLatencyP95, Stick.P95Ms);
+	SET_FLOAT_STAT(STAT_MixerStickLatencyP99, Stick.P99Ms);
+
+	const FMixerInputLatencyStats& Textbox = Stats[static_cast<int32>(EMixerInputLatencyClass::Textbox)];
+	SET_FLOAT_STAT(STAT_MixerTextboxLatencyP50, Textbox.P50Ms);
+	SET_FLOAT_STAT(STAT_MixerTextboxLatencyP95, Textbox.P95Ms);
+	SET_FLOAT_STAT(STAT_MixerTextboxLatencyP99, Textbox.P99Ms);
+
+	const FMixerInputLatencyStats& Custom = Stats[static_cast<int32>(EMixerInputLatencyClass::CustomControl)];
+	SET_FLOAT_STAT(STAT_MixerCustomLatencyP50, Custom.P50Ms);
+	SET_FLOAT_STAT(STAT_MixerCustomLatencyP95, Custom.P95Ms);
+	SET_FLOAT_STAT(STAT_MixerCustomLatencyP99, Custom.P99Ms);
+#endif
+}
+
+void FMixerInteractivityModule::BeginStartupTiming()
+{
+	StartupTimeBase = FPlatformTime::Seconds();
+	StartupTimings = FMixerStartupTimings();
+
+	// Read off the game thread while the token is acquired, so that it's ready by the time anything asks
+	FMixerWarmStartCache::Get().Prefetch();
+
+	// Host lookup doesn't depend on anything else, so it can overlap the whole login
+	if (GetDefault<UMixerInteractivitySettings>()->bPipelinedStartup && NeedsClientLibraryActive() &&
+		GetInteractiveConnectionAuthState() == EMixerLoginState::Not_Logged_In)
+	{
+		PrefetchInteractiveHosts();
+	}
+}
+
+void FMixerInteractivityModule::OnAccessTokenAcquired()
+{
+	MarkStartupPhase(StartupTimings.TokenAcquired, TEXT("token acquired"));
+
+	// The interactive socket only needs the token, so don't hold it up on the user fetch
+	if (GetDefault<UMixerInteractivitySettings>()->bPipelinedStartup && NeedsClientLibraryActive() &&
+		GetInteractiveConnectionAuthState() == EMixerLoginState::Not_Logged_In)
+	{
+		StartInteractiveConnection();
+	}
+}
+
+void FMixerInteractivityModule::MarkStartupPhase(float& Phase, const TCHAR* PhaseName)
+{
+	if (StartupTimeBase > 0.0 && Phase < 0.0f)
+	{
+		Phase = static_cast<float>(FPlatformTime::Seconds() - StartupTimeBase);
+		UE_LOG(LogMixerInteractivity, Verbose, TEXT("Mixer startup: %s after %.3fs"), PhaseName, Phase);
+	}
+}
+
+EMixerInteractivityState FMixerInteractivityModule::GetInteractivityState()
+{
+	return InteractivityState;
+}
+
+bool FMixerInteractivityModule::NeedsClientLibraryActive()
+{
+#if WITH_EDITOR
+	if (FApp::IsGame())
+	{
+		return true;
+	}
+
+	for (const FWorldContext& Context : GEngine->GetWorldContexts())
+	{
+		if (Context.World()->IsPlayInEditor())
+		{
+			return true;
+		}
+	}
+	return false;
+#else
+	return true;
+#endif
+}
+
+bool FMixerInteractivityModule::GetCustomControl(UWorld* ForWorld, FName ControlName, TSharedPtr<FJsonObject>& OutControlObj)
+{
+	OutControlObj = UMixerInteractivityBlueprintEventSource::GetBlueprintEventSource(ForWorld)->GetUnmappedCustomControl(ControlName);
+	return OutControlObj.IsValid();
+}
+
+bool FMixerInteractivityModule::GetCustomControl(UWorld* ForWorld, FName ControlName, UMixerCustomControl*& OutControlObj)
+{
+	OutControlObj = UMixerInteractivityBlueprintEventSource::GetBlueprintEventSource(ForWorld)->GetMappedCustomControl(ControlName);
+	return OutControlObj != nullptr;
+}
+
+void FMixerInteractivityModule::InitDesignTimeGroups()
+{
+	if (NeedsClientLibraryActive())
+	{
+		const UMixerInteractivitySettings* Settings = GetDefault<UMixerInteractivitySettings>();
+		for (const FMixerPredefinedGroup& PredefinedGroup : Settings->DesignTimeGroups)
+		{
+			if (!CreateGroup(PredefinedGroup.Name, PredefinedGroup.InitialScene))
+			{
+				// Already exists, try to just set the scene
+				SetCurrentScene(PredefinedGroup.InitialScene, PredefinedGroup.Name);
+			}
+		}
+	}
+}
+
+bool FMixerInteractivityModule::HandleControlUpdateMessage(FJsonObject* ParamsJson)
+{
+	FString SceneIdRaw;
+	ParamsJson->TryGetStringField(TEXT("sceneID"), SceneIdRaw);
+	const FName SceneId = *SceneIdRaw;
+
+	const TArray<TSharedPtr<FJsonValue>> *UpdatedControls;
+	if (ParamsJson->TryGetArrayField(TEXT("controls"), UpdatedControls))
+	{
+		for (const TSharedPtr<FJsonValue> Control : *UpdatedControls)
+		{
+			const TSharedPtr<FJsonObject> ControlObject = Control->AsObject();
+			if (ControlObject.IsValid())
+			{
+				FString ControlIdRaw;
+				if (ControlObject->TryGetStringField(TEXT("controlID"), ControlIdRaw))
+				{
+					FName ControlId = *ControlIdRaw;
+					const TSharedRef<FJsonObject> ControlJsonRef = ControlObject.ToSharedRef();
+					RecordKnownControlState(SceneId, ControlId, *ControlJsonRef);
+					if (!HandleSingleControlUpdate(ControlId, ControlJsonRef))
+					{
+						OnCustomControlPropertyUpdate().Broadcast(ControlId, ControlJsonRef);
+					}
+				}
+			}
+		}
+	}
+
+	return true;
+}
+
+void FMixerInteractivityModule::HandleCustomControlInputMessage(FJsonObject* ParamsJson)
+{
+	// @TODO - get participant and transaction (if any)
+
+	const TSharedPtr<FJsonObject> *InputObject;
+	if (ParamsJson->TryGetObjectField(TEXT("input"), InputObject))
+	{
+		FString ControlId;
+		if ((*InputObject)->TryGetStringField(TEXT("controlID"), ControlId))
+		{
+			FString EventType;
+			if ((*InputObject)->TryGetStringField(TEXT("event"), EventType))
+			{
+				OnCustomControlInput().Broadcast(*ControlId, *EventType, nullptr, InputObject->ToSharedRef());
+			}
+		}
+	}
+}
+
+void FMixerInteractivityModule::RegisterCustomControl(UMixerCustomControl* Control)
+{
+	for (const FScheduledCustomControl& Scheduled : ScheduledCustomControls)
+	{
+		if (Scheduled.Control.Get() == Control)
+		{
+			return;
+		}
+	}
+
+	// Golden ratio sequence gives every new control a phase well away from those already scheduled,
+	// so controls sharing an interval don't all come due on the same frame.
+	const double Interval = FMath::Max(Control->ClientPropertyUpdateInterval, 0.0f);
+	const double Phase = FMath::Frac(CustomControlsEverScheduled * 0.6180339887);
+	++CustomControlsEverScheduled;
+
+	FScheduledCustomControl& Scheduled = ScheduledCustomControls[ScheduledCustomControls.AddDefaulted()];
+	Scheduled.Control = Control;
+	Scheduled.NextUpdateTime = FPlatformTime::Seconds() + Interval * Phase;
+}
+
+void FMixerInteractivityModule::TickCustomControls(float DeltaTime)
+{
+	FMixerFrameScheduler& Scheduler = FMixerFrameScheduler::Get();
+	if (Scheduler.GetFramesDeferred(EMixerFrameWorkSource::CustomControls) > 0)
+	{
+		// Some were left out last frame.  Walking backwards from here, the longest waiting go first.
+		ScheduledCustomControls.Sort([](const FScheduledCustomControl& A, const FScheduledCustomControl& B) { return A.NextUpdateTime > B.NextUpdateTime; });
+	}
+
+	const double Deadline = Scheduler.BeginWork(EMixerFrameWorkSource::CustomControls);
+	const double Now = FPlatformTime::Seconds();
+	bool bTickedAny = false;
+	bool bOutOfTime = false;
+	for (int32 i = ScheduledCustomControls.Num() - 1; i >= 0; --i)
+	{
+		FScheduledCustomControl& Scheduled = ScheduledCustomControls[i];
+		UMixerCustomControl* Control = Scheduled.Control.Get();
+		if (Control == nullptr)
+		{
+			ScheduledCustomControls.RemoveAtSwap(i, 1, false);
+			continue;
+		}
+
+		if (Now < Scheduled.NextUpdateTime)
+		{
+			continue;
+		}
+
+		if (bTickedAny && FPlatformTime::Seconds() >= Deadline)
+		{
+			// Still due, so it goes next frame
+			bOutOfTime = true;
+			break;
+		}
+
+		bTickedAny = true;
+		if (!Control->Tick(DeltaTime))
+		{
+			ScheduledCustomControls.RemoveAtSwap(i, 1, false);
+			continue;
+		}
+
+		// Keep to the original phase unless we've fallen more than an interval behind
+		const double Interval = FMath::Max(Control->ClientPropertyUpdateInterval, 0.0f);
+		Scheduled.NextUpdateTime += Interval;
+		if (Scheduled.NextUpdateTime <= Now)
+		{
+			Scheduled.NextUpdateTime = Now + Interval;
+		}
+	}
+
+	Scheduler.EndWork(EMixerFrameWorkSource::CustomControls, bTickedAny, bOutOfTime);
+}
+
+void FMixerInteractivityModule::UpdateRemoteControl(FName SceneName, FName ControlName, TSharedRef<FJsonObject> PropertiesToUpdate)
+{
+	MIXER_LLM_SCOPE(ControlUpdates);
+	TMap<FName, TSharedRef<FJsonObject>>& ControlsForScene = GetPendingControlUpdatesForScene(SceneName);
+	TSharedRef<FJsonObject>* ExistingControlUpdate = ControlsForScene.Find(ControlName);
+	if (ExistingControlUpdate != nullptr)
+	{
+		TSharedPtr<FJsonObject> ExistingDeltas;
+		TSharedPtr<FJsonObject> NewDeltas;
+		const TSharedPtr<FJsonObject>* FoundDeltas;
+		if ((*ExistingControlUpdate)->TryGetObjectField(MixerStringConstants::FieldNames::ElementDeltas, FoundDeltas))
+		{
+			ExistingDeltas = *FoundDeltas;
+		}
+		if (PropertiesToUpdate->TryGetObjectField(MixerStringConstants::FieldNames::ElementDeltas, FoundDeltas))
+		{
+			NewDeltas = *FoundDeltas;
+		}
+
+		if (ExistingDeltas.IsValid() || NewDeltas.IsValid())
+		{
+			// A custom control's element deltas are relative to the property's previous value, so one only
+			// survives coalescing if the other update didn't touch that property.  The full values always do.
+			TSharedRef<FJsonObject> MergedDeltas = MakeShared<FJsonObject>();
+			if (ExistingDeltas.IsValid())
+			{
+				for (const TPair<FString, TSharedPtr<FJsonValue>>& Delta : ExistingDeltas->Values)
+				{
+					if (!PropertiesToUpdate->HasField(Delta.Key))
+					{
+						MergedDeltas->SetField(Delta.Key, Delta.Value);
+					}
+				}
+			}
+			if (NewDeltas.IsValid())
+			{
+				for (const TPair<FString, TSharedPtr<FJsonValue>>& Delta : NewDeltas->Values)
+				{
+					if (!(*ExistingControlUpdate)->HasField(Delta.Key))
+					{
+						MergedDeltas->SetField(Delta.Key, Delta.Value);
+					}
+				}
+			}
+
+			(*ExistingControlUpdate)->Values.Append(PropertiesToUpdate->Values);
+			if (MergedDeltas->Values.Num() > 0)
+			{
+				(*ExistingControlUpdate)->SetObjectField(MixerStringConstants::FieldNames::ElementDeltas, MergedDeltas);
+			}
+			else
+			{
+				(*ExistingControlUpdate)->RemoveField(MixerStringConstants::FieldNames::ElementDeltas);
+			}
+		}
+		else
+		{
+			(*ExistingControlUpdate)->Values.Append(PropertiesToUpdate->Values);
+		}
+	}
+	else
+	{
+		ControlsForScene.Add(ControlName, PropertiesToUpdate);
+	}
+}
+
+void FMixerInteractivityModule::SubmitRemoteControlUpdate(FName SceneName, FName ControlName, TSharedRef<FJsonObject> PropertiesToUpdate)
+{
+	MIXER_LLM_SCOPE(ControlUpdates);
+	FSubmittedControlUpdate Submitted;
+	Submitted.Kind = FSubmittedControlUpdate::EKind::Properties;
+	Submitted.SceneName = SceneName;
+	Submitted.ControlName = ControlName;
+	Submitted.Properties = MoveTemp(PropertiesToUpdate);
+	SubmittedControlUpdates.Enqueue(MoveTemp(Submitted));
+}
+
+void FMixerInteractivityModule::SubmitLabelText(FName Label, const FText& DisplayText)
+{
+	MIXER_LLM_SCOPE(ControlUpdates);
+	FSubmittedControlUpdate Submitted;
+	Submitted.Kind = FSubmittedControlUpdate::EKind::LabelText;
+	Submitted.ControlName = Label;
+	Submitted.Text = DisplayText;
+	SubmittedControlUpdates.Enqueue(MoveTemp(Submitted));
+}
+
+void FMixerInteractivityModule::SubmitButtonCooldown(FName Button, FTimespan CooldownTime)
+{
+	MIXER_LLM_SCOPE(ControlUpdates);
+	FSubmittedControlUpdate Submitted;
+	Submitted.Kind = FSubmittedControlUpdate::EKind::ButtonCooldown;
+	Submitted.ControlName = Button;
+	Submitted.Cooldown = CooldownTime;
+	SubmittedControlUpdates.Enqueue(MoveTemp(Submitted));
+}
+
+void FMixerInteractivityModule::DrainSubmittedControlUpdates()
+{
+	FSubmittedControlUpdate Submitted;
+	while (SubmittedControlUpdates.Dequeue(Submitted))
+	{
+		switch (Submitted.Kind)
+		{
+		case FSubmittedControlUpdate::EKind::Properties:
+			UpdateRemoteControl(Submitted.SceneName, Submitted.ControlName, Submitted.Properties.ToSharedRef());
+			break;
+
+		case FSubmittedControlUpdate::EKind::LabelText:
+			SetLabelText(Submitted.ControlName, Submitted.Text);
+			break;
+
+		case FSubmittedControlUpdate::EKind::ButtonCooldown:
+			TriggerButtonCooldown(Submitted.ControlName, Submitted.Cooldown);
+			break;
+		}
+	}
+
+	// Release the last Json object here rather than whenever the next submission overwrites it
+	Submitted.Properties.Reset();
+}
+
+IMixerInteractivityModule::FOnButtonEvent& FMixerInteractivityModule::OnButtonEvent(FName Button)
+{
+	TUniquePtr<FOnButtonEvent>& Event = ButtonEventsByControl.FindOrAdd(Button);
+	if (!Event.IsValid())
+	{
+		Event = MakeUnique<FOnButtonEvent>();
+	}
+	return *Event;
+}
+
+IMixerInteractivityModule::FOnStickEvent& FMixerInteractivityModule::OnStickEvent(FName Stick)
+{
+	TUniquePtr<FOnStickEvent>& Event = StickEventsByControl.FindOrAdd(Stick);
+	if (!Event.IsValid())
+	{
+		Event = MakeUnique<FOnStickEvent>();
+	}
+	return *Event;
+}
+
+IMixerInteractivityModule::FOnTextboxSubmitEvent& FMixerInteractivityModule::OnTextboxSubmitEvent(FName Textbox)
+{
+	TUniquePtr<FOnTextboxSubmitEvent>& Event = TextboxSubmitEventsByControl.FindOrAdd(Textbox);
+	if (!Event.IsValid())
+	{
+		Event = MakeUnique<FOnTextboxSubmitEvent>();
+	}
+	return *Event;
+}
+
+IMixerInteractivityModule::FOnButtonEvent* FMixerInteractivityModule::OnButtonEvent(FMixerControlHandle Button)
+{
+	const FName ButtonId = GetButtonId(Button);
+	return ButtonId != NAME_None ? &OnButtonEvent(ButtonId) : nullptr;
+}
+
+IMixerInteractivityModule::FOnStickEvent* FMixerInteractivityModule::OnStickEvent(FMixerControlHandle Stick)
+{
+	const FName StickId = GetStickId(Stick);
+	return StickId != NAME_None ? &OnStickEvent(StickId) : nullptr;
+}
+
+bool FMixerInteractivityModule::UnbindControlEvent(FName ControlId, FDelegateHandle Handle)
+{
+	return RemoveKeyedBinding(ButtonEventsByControl, ControlId, Handle)
+		|| RemoveKeyedBinding(StickEventsByControl, ControlId, Handle)
+		|| RemoveKeyedBinding(TextboxSubmitEventsByControl, ControlId, Handle);
+}
+
+template <class EventType>
+bool FMixerInteractivityModule::RemoveKeyedBinding(TMap<FName, TUniquePtr<EventType>>& Events, FName ControlId, FDelegateHandle Handle)
+{
+	TUniquePtr<EventType>* Event = Events.Find(ControlId);
+	if (Event == nullptr || !(*Event)->Remove(Handle))
+	{
+		return false;
+	}
+
+	if (!(*Event)->IsBound() && !bBroadcastingKeyedEvent)
+	{
+		Events.Remove(ControlId);
+	}
+	return true;
+}
+
+template <class EventType, class... ArgTypes>
+void FMixerInteractivityModule::BroadcastKeyedEvent(TMap<FName, TUniquePtr<EventType>>& Events, FName ControlId, const ArgTypes&... Args)
+{
+	if (Events.Num() == 0)
+	{
+		return;
+	}
+
+	const TUniquePtr<EventType>* Keyed = Events.Find(ControlId);
+	if (Keyed != nullptr)
+	{
+		// Handlers may subscribe to other controls, growing the map under us, so hold the event itself
+		EventType* Event = Keyed->Get();
+		{
+			TGuardValue<bool> BroadcastGuard(bBroadcastingKeyedEvent, true);
+			Event->Broadcast(ControlId, Args...);
+		}
+		if (!bBroadcastingKeyedEvent && !Event->IsBound())
+		{
+			// Unbound during the broadcast, so RemoveKeyedBinding had to leave it
+			Events.Remove(ControlId);
+		}
+	}
+}
+
+void FMixerInteractivityModule::BroadcastButtonEvent(FName ControlId, TSharedPtr<const FMixerRemoteUser> Participant, const FMixerButtonEventDetails& Details)
+{
+	MIXER_ALLOCATION_SCOPE(Broadcast);
+	ButtonEvent.Broadcast(ControlId, Participant, Details);
+	BroadcastKeyedEvent(ButtonEventsByControl, ControlId, Participant, Details);
+}
+
+void FMixerInteractivityModule::BroadcastStickEvent(FName ControlId, TSharedPtr<const FMixerRemoteUser> Participant, FVector2D Value)
+{
+	MIXER_ALLOCATION_SCOPE(Broadcast);
+	StickEvent.Broadcast(ControlId, Participant, Value);
+	BroadcastKeyedEvent(StickEventsByControl, ControlId, Participant, Value);
+}
+
+void FMixerInteractivityModule::BroadcastTextboxSubmitEvent(FName ControlId, TSharedPtr<const FMixerRemoteUser> Participant, const FMixerTextboxEventDetails& Details)
+{
+	MIXER_ALLOCATION_SCOPE(Broadcast);
+	TextboxSubmitEvent.Broadcast(ControlId, Participant, Details);
+	BroadcastKeyedEvent(TextboxSubmitEventsByControl, ControlId, Participant, Details);
+}
+
+TMap<FName, TSharedRef<FJsonObject>>& FMixerInteractivityModule::GetPendingControlUpdatesForScene(FName SceneName)
+{
+	return bSceneChangeStaged && SceneName == StagedScene ? StagedControlUpdates : PendingControlUpdates.FindOrAdd(SceneName);
+}
+
+void FMixerInteractivityModule::SetPendingControlProperty(TMap<FName, TSharedRef<FJsonObject>>& ControlsForScene, FName ControlName, const FString& PropertyName, const TSharedRef<FJsonValue>& Value)
+{
+	MIXER_LLM_SCOPE(ControlUpdates);
+	TSharedRef<FJsonObject>* ExistingControlUpdate = ControlsForScene.Find(ControlName);
+	if (ExistingControlUpdate != nullptr)
+	{
+		(*ExistingControlUpdate)->Values.Add(PropertyName, Value);
+	}
+	else
+	{
+		// Each control needs its own object since the flush adds the control id to it
+		TSharedRef<FJsonObject> Properties = MakeShared<FJsonObject>();
+		Properties->Values.Add(PropertyName, Value);
+		ControlsForScene.Add(ControlName, Properties);
 	}
 }
 
-bool FMixerInteractivityModule::Tick(float DeltaTime)
+void FMixerInteractivityModule::BeginStagedSceneChange(FName Scene, FName GroupName)
 {
-#if PLATFORM_XBOXONE
-	TickXboxLogin();
-#endif
+	if (bSceneChangeStaged)
+	{
+		CommitStagedSceneChange();
+	}
 
-	TickLocalUserMaintenance();
-	FlushControlUpdates();
+	StagedScene = Scene != NAME_None ? Scene : NAME_DefaultMixerParticipantGroup;
+	StagedSceneGroup = GroupName;
+	bSceneChangeStaged = true;
 
-	if (!NeedsClientLibraryActive())
+	// Anything already queued for the scene goes out with the change rather than ahead of it
+	TMap<FName, TSharedRef<FJsonObject>> AlreadyPending;
+	if (PendingControlUpdates.RemoveAndCopyValue(StagedScene, AlreadyPending))
 	{
-		StopInteractivity();
-		StopInteractiveConnection();
+		StagedControlUpdates = MoveTemp(AlreadyPending);
 	}
+}
 
-	return true;
-
+void FMixerInteractivityModule::DiscardStagedSceneChange()
+{
+	bSceneChangeStaged = false;
+	StagedScene = NAME_None;
+	StagedSceneGroup = NAME_None;
+	StagedControlUpdates.Empty();
 }
 
-void FMixerInteractivityModule::TickLocalUserMaintenance()
+void FMixerInteractivityModule::CommitStagedSceneChange()
 {
-	if (NeedsClientLibraryActive() && CurrentUser.IsValid())
+	if (!bSceneChangeStaged)
 	{
-		if (FApp::GetCurrentTime() > CurrentUser->RefreshAtAppTime)
-		{
-			TSharedRef<IHttpRequest> UserRequest = FHttpModule::Get().CreateRequest();
-			UserRequest->SetVerb(TEXT("GET"));
-			UserRequest->SetURL(FString::Printf(TEXT("https://mixer.com/api/v1/users/%d"), CurrentUser->Id));
-			UserRequest->OnProcessRequestComplete().BindRaw(this, &FMixerInteractivityModule::OnUserMaintenanceRequestComplete);
-			UserRequest->ProcessRequest();
+		return;
+	}
 
-			// Prevent further polling while we have a request active
-			CurrentUser->RefreshAtAppTime = MAX_dbl;
-		}
+	bSceneChangeStaged = false;
+	TMap<FName, TSharedRef<FJsonObject>> ControlUpdates = MoveTemp(StagedControlUpdates);
+	StagedControlUpdates.Reset();
+
+	if (GetInteractiveConnectionAuthState() != EMixerLoginState::Logged_In)
+	{
+		// No session to send to - leave the updates on the usual path
+		PendingControlUpdates.FindOrAdd(StagedScene).Append(MoveTemp(ControlUpdates));
+		SetCurrentScene(StagedScene, StagedSceneGroup);
+		return;
 	}
-}
 
-void FMixerInteractivityModule::OnUserMaintenanceRequestComplete(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded)
-{
-	if (CurrentUser.IsValid())
+	// Controls first, so the scene arrives in its intended state.  Bypasses the rate limit the
+	// same way urgent updates do; with outbound batching both messages share a single frame.
+	// Sent as urgent so that they can't be held back as bulk behind the updateGroups that follows.
+	TGuardValue<bool> UrgentSends(bSendingUrgentControlUpdates, true);
+	FOutgoingControlUpdates Outgoing;
+	TMap<FName, double>& LastSendForScene = ControlLastSendTime.FindOrAdd(StagedScene);
+	const double Now = FPlatformTime::Seconds();
+	for (TPair<FName, TSharedRef<FJsonObject>>& Update : ControlUpdates)
 	{
-		if (bSucceeded && HttpResponse.IsValid())
+		int32 SizeEstimate = 0;
+		if (PrepareControlUpdate(StagedScene, Update.Key, Update.Value, Outgoing.Controls, SizeEstimate))
 		{
-			if (EHttpResponseCodes::IsOk(HttpResponse->GetResponseCode()))
-			{
-				FMixerLocalUserJsonSerializable UpdatedUser;
-				if (UpdatedUser.FromJson(HttpResponse->GetContentAsString()))
-				{
-					// Make sure the user hasn't changed!
-					if (CurrentUser->Id == UpdatedUser.Id)
-					{
-						CurrentUser->Sparks = UpdatedUser.Sparks;
-						CurrentUser->Experience = UpdatedUser.Experience;
-						CurrentUser->Level = UpdatedUser.Level;
+			SplitOutgoingControlUpdates(StagedScene, Outgoing.Controls, Outgoing.SizeEstimate, SizeEstimate);
+			ControlUpdateBudget -= SizeEstimate;
+			LastSendForScene.Add(Update.Key, Now);
+		}
+	}
 
-						bool UserBroadcastStateChanged = CurrentUser->Channel.IsBroadcasting != UpdatedUser.Channel.IsBroadcasting;
-						CurrentUser->Channel = UpdatedUser.Channel;
+	if (Outgoing.Controls.Num() > 0)
+	{
+		SendControlUpdates(StagedScene, Outgoing.Controls);
+	}
 
-						if (UserBroadcastStateChanged)
-						{
-							OnBroadcastingStateChanged().Broadcast(CurrentUser->Channel.IsBroadcasting);
-						}
-					}
-				}
-			}
-		}
+	SetCurrentScene(StagedScene, StagedSceneGroup);
+	ApplySceneChangeLocally(StagedScene, StagedSceneGroup);
 
-		// Note: so far, adjusting this interval in response to app lifecycle events (in case broadcasting
-		// was started by the user while app was in background) have not been terribly effective - when starting the
-		// state takes long enough to change on the service that it's not very different from just waiting for the next
-		// regularly schedule poll.
-		static const double UserPollingInterval = 30.0;
-		CurrentUser->RefreshAtAppTime = FMath::Min(CurrentUser->RefreshAtAppTime, FApp::GetCurrentTime() + UserPollingInterval);
+	// As though the service had already echoed the updates back
+	for (TPair<FName, TSharedRef<FJsonObject>>& Update : ControlUpdates)
+	{
+		HandleSingleControlUpdate(Update.Key, Update.Value);
 	}
 }
 
-bool FMixerInteractivityModule::LoginWithAuthCodeInternal(const FString& AuthCode, TSharedPtr<const FUniqueNetId> UserId)
+#if MIXER_BENCHMARKS_ENABLED
+void FMixerInteractivityModule::PumpBenchmarkSession()
 {
-	check(PLATFORM_SUPPORTS_MIXER_OAUTH);
-
-#if PLATFORM_SUPPORTS_MIXER_OAUTH
-	const UMixerInteractivitySettings* Settings = GetDefault<UMixerInteractivitySettings>();
-	FString ContentString;
-	TSharedRef<TJsonWriter<>> JsonWriter = TJsonWriterFactory<>::Create(&ContentString);
-	JsonWriter->WriteObjectStart();
-	JsonWriter->WriteValue(TEXT("grant_type"), TEXT("authorization_code"));
-	JsonWriter->WriteValue(TEXT("redirect_uri"), Settings->GetResolvedRedirectUri());
-	JsonWriter->WriteValue(TEXT("client_id"), Settings->ClientId);
-	JsonWriter->WriteValue(TEXT("code"), AuthCode);
-	JsonWriter->WriteObjectEnd();
-	JsonWriter->Close();
+	FlushControlUpdates();
+}
+#endif
 
-	// Now exchange the auth code for a token
-	TSharedRef<IHttpRequest> TokenRequest = FHttpModule::Get().CreateRequest();
-	TokenRequest->SetVerb(TEXT("POST"));
-	TokenRequest->SetURL(TEXT("https://mixer.com/api/v1/oauth/token"));
-	TokenRequest->SetHeader(TEXT("content-type"), TEXT("application/json"));
-	TokenRequest->SetContentAsString(ContentString);
-	TokenRequest->OnProcessRequestComplete().BindRaw(this, &FMixerInteractivityModule::OnTokenRequestComplete);
-	if (!TokenRequest->ProcessRequest())
+void FMixerInteractivityModule::GetContainerSizes(TFunctionRef<void(const TCHAR* Name, int64 Size)> Visit) const
+{
+	int64 NumPendingUpdates = 0;
+	for (const TPair<FName, TMap<FName, TSharedRef<FJsonObject>>>& Scene : PendingControlUpdates)
 	{
-		SetUserAuthState(EMixerLoginState::Not_Logged_In);
-		return false;
+		NumPendingUpdates += Scene.Value.Num();
+	}
+	int64 NumKnownStates = 0;
+	for (const TPair<FName, TMap<FName, TSharedRef<FJsonObject>>>& Scene : KnownControlState)
+	{
+		NumKnownStates += Scene.Value.Num();
+	}
+	int64 NumLastSendTimes = 0;
+	for (const TPair<FName, TMap<FName, double>>& Scene : ControlLastSendTime)
+	{
+		NumLastSendTimes += Scene.Value.Num();
 	}
 
-	NetId = UserId;
-	SetUserAuthState(EMixerLoginState::Logging_In);
-#endif
-	return true;
+	Visit(TEXT("Controls.PendingUpdateScenes"), PendingControlUpdates.Num());
+	Visit(TEXT("Controls.PendingUpdates"), NumPendingUpdates);
+	Visit(TEXT("Controls.KnownState"), NumKnownStates);
+	Visit(TEXT("Controls.LastSendTime"), NumLastSendTimes);
+	Visit(TEXT("Controls.ScheduledCustomControls"), ScheduledCustomControls.Num());
+	Visit(TEXT("Replies.SparkCaptures"), PendingSparkCaptures.Num() + OutstandingSparkCaptures.Num());
 }
 
-void FMixerInteractivityModule::OnTokenRequestComplete(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded)
+void FMixerInteractivityModule::FlushControlUpdates()
 {
-	check(PLATFORM_SUPPORTS_MIXER_OAUTH);
+	SCOPE_CYCLE_COUNTER(STAT_MixerFlushControlUpdates);
 
-#if PLATFORM_SUPPORTS_MIXER_OAUTH
-	bool GotAccessToken = false;
-	FString ErrorDescription;
-	if (HttpResponse.IsValid())
+	DrainSubmittedControlUpdates();
+
+	FMixerFrameScheduler& Scheduler = FMixerFrameScheduler::Get();
+	const double Deadline = Scheduler.BeginWork(EMixerFrameWorkSource::ControlUpdates);
+
+	const UMixerInteractivitySettings* Settings = GetDefault<UMixerInteractivitySettings>();
+	const double Now = FPlatformTime::Seconds();
+	const double MinInterval = Settings->ControlUpdateMinInterval;
+	const double BytesPerSecond = Settings->ControlUpdateBytesPerSecond;
+
+	// Refill the bucket, allowing at most one second's worth of burst
+	if (BytesPerSecond > 0.0)
+	{
+		const double Elapsed = ControlUpdateBudgetTime > 0.0 ? Now - ControlUpdateBudgetTime : 1.0;
+		ControlUpdateBudget = FMath::Min(ControlUpdateBudget + Elapsed * BytesPerSecond, BytesPerSecond);
+	}
+	ControlUpdateBudgetTime = Now;
+
+	TMap<FName, FOutgoingControlUpdates> ControlsByScene;
+	TArray<FDeferrableControlUpdate> Deferrable;
+
+	// Urgent updates (cooldowns, enable/disable) always go out this frame.
+	for (TMap<FName, TMap<FName, TSharedRef<FJsonObject>>>::TIterator It(PendingControlUpdates); It; ++It)
 	{
-		FString ResponseStr = HttpResponse->GetContentAsString();
-		TSharedRef<TJsonReader<>> JsonReader = TJsonReaderFactory<>::Create(ResponseStr);
-		TSharedPtr<FJsonObject> JsonObject;
-		if (FJsonSerializer::Deserialize(JsonReader, JsonObject) &&
-			JsonObject.IsValid())
+		if (It->Value.Num() == 0)
 		{
-			UMixerInteractivityUserSettings* UserSettings = GetMutableDefault<UMixerInteractivityUserSettings>();
+			continue;
+		}
 
-			GotAccessToken = bSucceeded && EHttpResponseCodes::IsOk(HttpResponse->GetResponseCode());
-			GotAccessToken &= JsonObject->TryGetStringField(TEXT("access_token"), UserSettings->AccessToken);
-			GotAccessToken &= JsonObject->TryGetStringField(TEXT("refresh_token"), UserSettings->RefreshToken);
-			if (GotAccessToken)
+		TMap<FName, double>& LastSendForScene = ControlLastSendTime.FindOrAdd(It->Key);
+		for (TMap<FName, TSharedRef<FJsonObject>>::TIterator ControlIt(It->Value); ControlIt; ++ControlIt)
+		{
+			const double* LastSend = LastSendForScene.Find(ControlIt->Key);
+			if (IsUrgentControlUpdate(*ControlIt->Value))
 			{
-				UserSettings->SaveConfig();
+				int32 SizeEstimate = 0;
+				FOutgoingControlUpdates& Outgoing = ControlsByScene.FindOrAdd(It->Key);
+				if (PrepareControlUpdate(It->Key, ControlIt->Key, ControlIt->Value, Outgoing.Controls, SizeEstimate))
+				{
+					Outgoing.bUrgent = true;
+					TGuardValue<bool> UrgentSends(bSendingUrgentControlUpdates, true);
+					SplitOutgoingControlUpdates(It->Key, Outgoing.Controls, Outgoing.SizeEstimate, SizeEstimate);
+					ControlUpdateBudget -= SizeEstimate;
+					LastSendForScene.Add(ControlIt->Key, Now);
+				}
+				ControlIt.RemoveCurrent();
 			}
-			else
+			else if (LastSend == nullptr || Now - *LastSend >= MinInterval)
 			{
-				JsonObject->TryGetStringField(TEXT("error_description"), ErrorDescription);
+				FDeferrableControlUpdate& Candidate = Deferrable[Deferrable.AddUninitialized()];
+				Candidate.SceneName = It->Key;
+				Candidate.ControlName = ControlIt->Key;
+				Candidate.LastSendTime = LastSend != nullptr ? *LastSend : 0.0;
 			}
 		}
 	}
 
-	if (GotAccessToken)
+	// Everything else is sent longest-waiting first until the bandwidth or frame budget runs out.
+	// Whatever is left stays staged, so later changes to the same control merge into it.
+	Deferrable.Sort();
+	bool bOutOfTime = false;
+	for (const FDeferrableControlUpdate& Candidate : Deferrable)
 	{
-		// Now get user info
-		const UMixerInteractivityUserSettings* UserSettings = GetDefault<UMixerInteractivityUserSettings>();
-		TSharedRef<IHttpRequest> UserRequest = FHttpModule::Get().CreateRequest();
-		UserRequest->SetVerb(TEXT("GET"));
-		UserRequest->SetURL(TEXT("https://mixer.com/api/v1/users/current"));
-		UserRequest->SetHeader(TEXT("Authorization"), UserSettings->GetAuthZHeaderValue());
-		UserRequest->OnProcessRequestComplete().BindRaw(this, &FMixerInteractivityModule::OnUserRequestComplete);
-		if (!UserRequest->ProcessRequest())
+		if (BytesPerSecond > 0.0 && ControlUpdateBudget <= 0.0)
 		{
-			SetUserAuthState(EMixerLoginState::Not_Logged_In);
+			break;
 		}
-	}
-	else
-	{
-#if WITH_EDITOR
-		FText NotificationText;
-		if (!ErrorDescription.IsEmpty())
+
+		if (&Candidate != Deferrable.GetData() && FPlatformTime::Seconds() >= Deadline)
 		{
-			NotificationText = FText::Format(NSLOCTEXT("MixerInteractivityEditor", "OnTokenRequestComplete_Failed_WithDescription", "Login failed with error: {0}"), FText::FromString(ErrorDescription));
+			bOutOfTime = true;
+			break;
 		}
-		else
+
+		TMap<FName, TSharedRef<FJsonObject>>& ControlsForScene = PendingControlUpdates.FindChecked(Candidate.SceneName);
+		int32 SizeEstimate = 0;
+		FOutgoingControlUpdates& Outgoing = ControlsByScene.FindOrAdd(Candidate.SceneName);
+		if (PrepareControlUpdate(Candidate.SceneName, Candidate.ControlName, ControlsForScene.FindChecked(Candidate.ControlName), Outgoing.Controls, SizeEstimate))
 		{
-			NotificationText = NSLOCTEXT("MixerInteractivityEditor", "OnTokenRequestComplete_Failed_Generic", "Login failed with unknown error.");
+			TGuardValue<bool> UrgentSends(bSendingUrgentControlUpdates, Outgoing.bUrgent);
+			SplitOutgoingControlUpdates(Candidate.SceneName, Outgoing.Controls, Outgoing.SizeEstimate, SizeEstimate);
+			ControlUpdateBudget -= SizeEstimate;
+			ControlLastSendTime.FindChecked(Candidate.SceneName).Add(Candidate.ControlName, Now);
 		}
-		FNotificationInfo Info(NotificationText);
-		Info.ExpireDuration = 8.0f;
-		FSlateNotificationManager::Get().AddNotification(Info);
-#endif
+		ControlsForScene.Remove(Candidate.ControlName);
+	}
 
-		SetUserAuthState(EMixerLoginState::Not_Logged_In);
+	for (TMap<FName, FOutgoingControlUpdates>::TIterator It(ControlsByScene); It; ++It)
+	{
+		if (It->Value.Controls.Num() > 0)
+		{
+			TGuardValue<bool> UrgentSends(bSendingUrgentControlUpdates, It->Value.bUrgent);
+			SendControlUpdates(It->Key, It->Value.Controls);
+		}
 	}
-#endif
+
+	Scheduler.EndWork(EMixerFrameWorkSource::ControlUpdates, ControlsByScene.Num() > 0, bOutOfTime);
 }
 
-void FMixerInteractivityModule::OnUserRequestComplete(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded)
+bool FMixerInteractivityModule::PrepareControlUpdate(FName SceneName, FName ControlName, const TSharedRef<FJsonObject>& PendingProperties, TArray<TSharedPtr<FJsonValue>>& OutControls, int32& OutSizeEstimate)
 {
-	if (bSucceeded && HttpResponse.IsValid())
+	// @TODO - centralize field name constants
+	static const FString ControlIdField = TEXT("controlID");
+
+	const UMixerInteractivitySettings* Settings = GetDefault<UMixerInteractivitySettings>();
+
+	TSharedRef<FJsonObject> Outgoing = PendingProperties;
+	if (Settings->bSuppressUnchangedControlUpdates)
 	{
-		if (EHttpResponseCodes::IsOk(HttpResponse->GetResponseCode()))
+		const TMap<FName, TSharedRef<FJsonObject>>* KnownForScene = KnownControlState.Find(SceneName);
+		const TSharedRef<FJsonObject>* Known = KnownForScene != nullptr ? KnownForScene->Find(ControlName) : nullptr;
+		if (Known != nullptr)
 		{
-			CurrentUser = MakeShareable(new FMixerLocalUserJsonSerializable());
-			if (!CurrentUser->FromJson(HttpResponse->GetContentAsString()))
+			Outgoing = MakeShared<FJsonObject>();
+			for (const TPair<FString, TSharedPtr<FJsonValue>>& Property : PendingProperties->Values)
+			{
+				const TSharedPtr<FJsonValue>* KnownValue = (*Known)->Values.Find(Property.Key);
+				if (KnownValue == nullptr || !KnownValue->IsValid() || !Property.Value.IsValid() ||
+					!IsControlPropertyUnchanged(Property.Key, **KnownValue, *Property.Value, Settings->ControlProgressEpsilon))
+				{
+					Outgoing->Values.Add(Property.Key, Property.Value);
+				}
+			}
+
+			if (Outgoing->Values.Num() == 0)
 			{
-				CurrentUser.Reset();
+				return false;
 			}
 		}
 	}
 
-	SetUserAuthState(CurrentUser.IsValid() ? EMixerLoginState::Logged_In : EMixerLoginState::Not_Logged_In);
+	Outgoing->SetStringField(ControlIdField, ControlName.ToString());
+	OutSizeEstimate = EstimateControlUpdateSize(*Outgoing);
+	OutControls.Add(MakeShared<FJsonValueObject>(Outgoing));
+	return true;
 }
 
-EMixerInteractivityState FMixerInteractivityModule::GetInteractivityState()
+void FMixerInteractivityModule::SendControlUpdates(FName SceneName, const TArray<TSharedPtr<FJsonValue>>& Controls)
 {
-	return InteractivityState;
+	TSharedRef<FJsonObject> UpdateMethodParams = MakeShared<FJsonObject>();
+
+	// Special case - 'default' is used all over the place as a name, but with 'D'
+	UpdateMethodParams->SetStringField(TEXT("sceneID"), SceneName != NAME_DefaultMixerParticipantGroup ? SceneName.ToString() : TEXT("default"));
+	UpdateMethodParams->SetArrayField(TEXT("controls"), Controls);
+
+	// Values only count as held by the service once it has accepted them.  Backends without
+	// replies (interactive-cpp v1) get no suppression for our own sends.
+	if (!GetDefault<UMixerInteractivitySettings>()->bSuppressUnchangedControlUpdates ||
+		!CallRemoteMethodAsync(MixerStringConstants::MethodNames::UpdateControls, UpdateMethodParams,
+			FOnRemoteMethodReply::CreateRaw(this, &FMixerInteractivityModule::HandleControlUpdatesReply, SceneName, Controls)))
+	{
+		CallRemoteMethod(MixerStringConstants::MethodNames::UpdateControls, UpdateMethodParams);
+	}
 }
 
-bool FMixerInteractivityModule::NeedsClientLibraryActive()
+/**
+* Account for the control PrepareControlUpdate just added.  If it takes the message past
+* ControlUpdateMaxMessageSize, everything before it is sent now as a message of its own.
+*/
+void FMixerInteractivityModule::SplitOutgoingControlUpdates(FName SceneName, TArray<TSharedPtr<FJsonValue>>& Controls, int32& InOutSizeEstimate, int32 AddedSize)
 {
-#if WITH_EDITOR
-	if (FApp::IsGame())
+	const int32 MaxSize = GetDefault<UMixerInteractivitySettings>()->ControlUpdateMaxMessageSize;
+	if (MaxSize > 0 && Controls.Num() > 1 && InOutSizeEstimate + AddedSize > MaxSize)
 	{
-		return true;
+		TSharedPtr<FJsonValue> Added = Controls.Pop(false);
+		SendControlUpdates(SceneName, Controls);
+		Controls.Reset();
+		Controls.Add(Added);
+		InOutSizeEstimate = 0;
+	}
+	InOutSizeEstimate += AddedSize;
+}
+
+void FMixerInteractivityModule::HandleControlUpdatesReply(bool bSucceeded, TSharedPtr<FJsonObject> Result, const FString& ErrorMessage, FName SceneName, TArray<TSharedPtr<FJsonValue>> Controls)
+{
+	// @TODO - centralize field name constants
+	static const FString ControlIdField = TEXT("controlID");
+
+	// Failures resend next time the control changes.  KnownControlState is emptied when the
+	// connection drops, so late replies from a previous connection mustn't repopulate it.
+	if (!bSucceeded || GetInteractiveConnectionAuthState() != EMixerLoginState::Logged_In)
+	{
+		return;
 	}
 
-	for (const FWorldContext& Context : GEngine->GetWorldContexts())
+	for (const TSharedPtr<FJsonValue>& Control : Controls)
 	{
-		if (Context.World()->IsPlayInEditor())
+		const TSharedPtr<FJsonObject>* ControlObject = nullptr;
+		FString ControlIdRaw;
+		if (Control.IsValid() && Control->TryGetObject(ControlObject) && (*ControlObject)->TryGetStringField(ControlIdField, ControlIdRaw))
 		{
-			return true;
+			RecordKnownControlState(SceneName, *ControlIdRaw, **ControlObject);
 		}
 	}
-	return false;
-#else
-	return true;
-#endif
 }
 
-bool FMixerInteractivityModule::GetCustomControl(UWorld* ForWorld, FName ControlName, TSharedPtr<FJsonObject>& OutControlObj)
+void FMixerInteractivityModule::RecordKnownControlState(FName SceneName, FName ControlName, const FJsonObject& Properties)
 {
-	OutControlObj = UMixerInteractivityBlueprintEventSource::GetBlueprintEventSource(ForWorld)->GetUnmappedCustomControl(ControlName);
-	return OutControlObj.IsValid();
-}
+	// @TODO - centralize field name constants
+	static const FString ControlIdField = TEXT("controlID");
 
-bool FMixerInteractivityModule::GetCustomControl(UWorld* ForWorld, FName ControlName, UMixerCustomControl*& OutControlObj)
-{
-	OutControlObj = UMixerInteractivityBlueprintEventSource::GetBlueprintEventSource(ForWorld)->GetMappedCustomControl(ControlName);
-	return OutControlObj != nullptr;
-}
+	TMap<FName, TSharedRef<FJsonObject>>& KnownForScene = KnownControlState.FindOrAdd(SceneName);
+	TSharedRef<FJsonObject>* Known = KnownForScene.Find(ControlName);
+	if (Known == nullptr)
+	{
+		Known = &KnownForScene.Add(ControlName, MakeShared<FJsonObject>());
+	}
 
-void FMixerInteractivityModule::InitDesignTimeGroups()
-{
-	if (NeedsClientLibraryActive())
+	for (const TPair<FString, TSharedPtr<FJsonValue>>& Property : Properties.Values)
 	{
-		const UMixerInteractivitySettings* Settings = GetDefault<UMixerInteractivitySettings>();
-		for (const FMixerPredefinedGroup& PredefinedGroup : Settings->DesignTimeGroups)
+		if (Property.Key != ControlIdField)
 		{
-			if (!CreateGroup(PredefinedGroup.Name, PredefinedGroup.InitialScene))
-			{
-				// Already exists, try to just set the scene
-				SetCurrentScene(PredefinedGroup.InitialScene, PredefinedGroup.Name);
-			}
+			// May come straight from a server message, whose values live only as long as it does.
+			(*Known)->Values.Add(Property.Key, MixerJsonArena::DeepCopy(Property.Value));
 		}
 	}
 }
 
-bool FMixerInteractivityModule::HandleControlUpdateMessage(FJsonObject* ParamsJson)
+void FMixerInteractivityModule::CaptureSparkTransaction(const FString& TransactionId)
 {
-	const TArray<TSharedPtr<FJsonValue>> *UpdatedControls;
-	if (ParamsJson->TryGetArrayField(TEXT("controls"), UpdatedControls))
+	bool bAlreadyOutstanding = false;
+	OutstandingSparkCaptures.Add(TransactionId, &bAlreadyOutstanding);
+	if (!bAlreadyOutstanding)
 	{
-		for (const TSharedPtr<FJsonValue> Control : *UpdatedControls)
-		{
-			const TSharedPtr<FJsonObject> ControlObject = Control->AsObject();
-			if (ControlObject.IsValid())
-			{
-				FString ControlIdRaw;
-				if (ControlObject->TryGetStringField(TEXT("controlID"), ControlIdRaw))
-				{
-					FName ControlId = *ControlIdRaw;
-					const TSharedRef<FJsonObject> ControlJsonRef = ControlObject.ToSharedRef();
-					if (!HandleSingleControlUpdate(ControlId, ControlJsonRef))
-					{
-						OnCustomControlPropertyUpdate().Broadcast(ControlId, ControlJsonRef);
-					}
-				}
-			}
-		}
+		PendingSparkCaptures.Add(TransactionId);
 	}
-
-	return true;
 }
 
-void FMixerInteractivityModule::HandleCustomControlInputMessage(FJsonObject* ParamsJson)
+void FMixerInteractivityModule::FlushSparkCaptures()
 {
-	// @TODO - get participant and transaction (if any)
+	if (PendingSparkCaptures.Num() == 0)
+	{
+		return;
+	}
 
-	const TSharedPtr<FJsonObject> *InputObject;
-	if (ParamsJson->TryGetObjectField(TEXT("input"), InputObject))
+	if (GetInteractiveConnectionAuthState() != EMixerLoginState::Logged_In)
 	{
-		FString ControlId;
-		if ((*InputObject)->TryGetStringField(TEXT("controlID"), ControlId))
-		{
-			FString EventType;
-			if ((*InputObject)->TryGetStringField(TEXT("event"), EventType))
-			{
-				OnCustomControlInput().Broadcast(*ControlId, *EventType, nullptr, InputObject->ToSharedRef());
-			}
-		}
+		FailOutstandingSparkCaptures(TEXT("Not connected to the interactive service"));
+		return;
+	}
+
+	// Swap out first since backends may complete a capture synchronously
+	TArray<FString> ToSend = MoveTemp(PendingSparkCaptures);
+	PendingSparkCaptures.Reset();
+	for (const FString& TransactionId : ToSend)
+	{
+		SendSparkCapture(TransactionId);
 	}
 }
 
-void FMixerInteractivityModule::UpdateRemoteControl(FName SceneName, FName ControlName, TSharedRef<FJsonObject> PropertiesToUpdate)
+void FMixerInteractivityModule::CompleteSparkCapture(const FString& TransactionId, bool bSucceeded, const FString& ErrorMessage)
 {
-	// @TODO - centralize field name constants
-	static const FString ControlIdField = TEXT("controlID");
-
-	FString ControlNameString = ControlName.ToString();
-
-	TArray<TSharedPtr<FJsonValue>>& ControlsForScene = PendingControlUpdates.FindOrAdd(SceneName);
-	for (TSharedPtr<FJsonValue>& ExistingControlUpdate : ControlsForScene)
+	// Ignore results for captures we've already given up on
+	if (OutstandingSparkCaptures.Remove(TransactionId) > 0)
 	{
-		TSharedPtr<FJsonObject> UpdateObject = ExistingControlUpdate->AsObject();
-		if (UpdateObject->GetStringField(ControlIdField) == ControlNameString)
+		if (!bSucceeded)
 		{
-			UpdateObject->Values.Append(PropertiesToUpdate->Values);
-			return;
+			UE_LOG(LogMixerInteractivity, Warning, TEXT("Failed to capture spark transaction %s: %s"), *TransactionId, *ErrorMessage);
 		}
+		SparkTransactionComplete.Broadcast(TransactionId, bSucceeded, ErrorMessage);
 	}
-
-	PropertiesToUpdate->SetStringField(ControlIdField, ControlName.ToString());
-	ControlsForScene.Add(MakeShared<FJsonValueObject>(PropertiesToUpdate));
 }
 
-void FMixerInteractivityModule::FlushControlUpdates()
+void FMixerInteractivityModule::FailOutstandingSparkCaptures(const FString& ErrorMessage)
 {
-	for (TMap<FName, TArray<TSharedPtr<FJsonValue>>>::TIterator It(PendingControlUpdates); It; ++It)
+	if (OutstandingSparkCaptures.Num() == 0)
 	{
-		TSharedRef<FJsonObject> UpdateMethodParams = MakeShared<FJsonObject>();
-
-		// Special case - 'default' is used all over the place as a name, but with 'D'
-		UpdateMethodParams->SetStringField(TEXT("sceneID"), It->Key != NAME_DefaultMixerParticipantGroup ? It->Key.ToString() : TEXT("default"));
-		UpdateMethodParams->SetArrayField(TEXT("controls"), It->Value);
+		return;
+	}
 
-		CallRemoteMethod(TEXT("updateControls"), UpdateMethodParams);
+	TArray<FString> Failed = OutstandingSparkCaptures.Array();
+	OutstandingSparkCaptures.Empty();
+	PendingSparkCaptures.Empty();
+	for (const FString& TransactionId : Failed)
+	{
+		SparkTransactionComplete.Broadcast(TransactionId, false, ErrorMessage);
 	}
+}
 
-	PendingControlUpdates.Empty();
+void FMixerInteractivityModule::CreateChatInterfaceIfNeeded()
+{
+	if (!ChatInterface.IsValid())
+	{
+		ChatInterface = MakeShared<FOnlineChatMixer>();
+	}
 }
 
 TSharedPtr<IOnlineChat> FMixerInteractivityModule::GetChatInterface()
 {
+	CreateChatInterfaceIfNeeded();
 	return ChatInterface;
 }
 
 TSharedPtr<IOnlineChatMixer> FMixerInteractivityModule::GetExtendedChatInterface()
 {
+	CreateChatInterfaceIfNeeded();
 	return ChatInterface;
 }
 
@@ -703,12 +2449,42 @@ void FMixerInteractivityModule::SetInteractiveConnectionAuthState(EMixerLoginSta
 	{
 		if (InteractiveConnectionAuthState != EMixerLoginState::Not_Logged_In && InState == EMixerLoginState::Not_Logged_In)
 		{
-			Logout();
+			if (UserAuthState == EMixerLoginState::Logging_In)
+			{
+				// Pipelined login - the connection failed while the user fetch was still out
+				SetUserAuthState(EMixerLoginState::Not_Logged_In);
+			}
+			else
+			{
+				Logout();
+			}
 		}
 	}
 
+	// A new connection starts from whatever the service has, so stop trusting what we last sent,
+	// and don't hold this session's unsent updates over for it.
+	if (InState != EMixerLoginState::Logged_In)
+	{
+		KnownControlState.Empty();
+		ControlLastSendTime.Empty();
+		PendingControlUpdates.Empty();
+		DiscardSubmittedControlUpdates();
+		DiscardStagedSceneChange();
+		FailOutstandingSparkCaptures(TEXT("Interactive connection lost"));
+	}
+
+	if (InState == EMixerLoginState::Logging_In)
+	{
+		MarkStartupPhase(StartupTimings.ConnectionStarted, TEXT("interactive connection started"));
+	}
+	else if (InState == EMixerLoginState::Logged_In)
+	{
+		MarkStartupPhase(StartupTimings.InteractiveConnected, TEXT("interactive connection established"));
+	}
+
 	EMixerLoginState PreviousFullLoginState = GetLoginState();
 	InteractiveConnectionAuthState = InState;
+	WakeTicker();
 	HandleLoginStateChange(PreviousFullLoginState, GetLoginState());
 }
 
@@ -738,7 +2514,8 @@ void FMixerInteractivityModule::SetUserAuthState(EMixerLoginState InState)
 	// If we need an interactive connection then kick if off as soon as the user auth portion is completed.
 	if (NeedsClientLibraryActive())
 	{
-		if (UserAuthState == EMixerLoginState::Logging_In && InState == EMixerLoginState::Logged_In)
+		if (UserAuthState == EMixerLoginState::Logging_In && InState == EMixerLoginState::Logged_In &&
+			GetInteractiveConnectionAuthState() == EMixerLoginState::Not_Logged_In)
 		{
 			StartInteractiveConnection();
 		}
@@ -746,6 +2523,7 @@ void FMixerInteractivityModule::SetUserAuthState(EMixerLoginState InState)
 
 	EMixerLoginState PreviousFullLoginState = GetLoginState();
 	UserAuthState = InState;
+	WakeTicker();
 	HandleLoginStateChange(PreviousFullLoginState, GetLoginState());
 }
 
@@ -758,12 +2536,16 @@ void FMixerInteractivityModule::HandleLoginStateChange(EMixerLoginState OldState
 		{
 			CurrentUser.Reset();
 			NetId.Reset();
+			CancelAccessTokenRefresh();
+			CancelShortCodeLogin();
+			LiveEvents.Reset();
+			UserPollInterval = 0.0;
 
 #if PLATFORM_SUPPORTS_MIXER_OAUTH
 			UMixerInteractivityUserSettings* UserSettings = GetMutableDefault<UMixerInteractivityUserSettings>();
 			UserSettings->AccessToken = TEXT("");
 			UserSettings->RefreshToken = TEXT("");
-			UserSettings->SaveConfig();
+			UserSettings->SaveConfigDeferred();
 #endif
 #if PLATFORM_XBOXONE
 			XboxUserOperation = TFuture<Windows::Xbox::System::User^>();
@@ -783,6 +2565,11 @@ void FMixerInteractivityModule::HandleLoginStateChange(EMixerLoginState OldState
 			{
 				RetryLoginWithUI = false;
 
+				MarkStartupPhase(StartupTimings.LoggedIn, TEXT("logged in"));
+				UE_LOG(LogMixerInteractivity, Log, TEXT("Mixer login took %.3fs (token %.3fs, user %.3fs, hosts %.3fs, connection started %.3fs, connected %.3fs)"),
+					StartupTimings.LoggedIn, StartupTimings.TokenAcquired, StartupTimings.UserFetched, StartupTimings.HostsDiscovered,
+					StartupTimings.ConnectionStarted, StartupTimings.InteractiveConnected);
+
 				InitDesignTimeGroups();
 
 				OnLoginStateChanged().Broadcast(EMixerLoginState::Logged_In);
@@ -821,6 +2608,8 @@ void FMixerInteractivityModule::HandleLoginStateChange(EMixerLoginState OldState
 #if PLATFORM_XBOXONE
 bool FMixerInteractivityModule::LoginSilentlyInternal(TSharedPtr<const FUniqueNetId> UserId)
 {
+	BindPlatformLoginDelegates();
+
 	FString Xuid = UserId->ToString();
 
 	// Go async to avoid blocking the game thread on the cross-OS call
@@ -858,12 +2647,13 @@ void FMixerInteractivityModule::TickXboxLogin()
 					UMixerInteractivityUserSettings* UserSettings = GetMutableDefault<UMixerInteractivityUserSettings>();
 					UserSettings->AccessToken = GetXTokenOperation->GetResults()->Token->ToString()->Data();
 
-					TSharedRef<IHttpRequest> UserRequest = FHttpModule::Get().CreateRequest();
-					UserRequest->SetVerb(TEXT("GET"));
-					UserRequest->SetURL(TEXT("https://mixer.com/api/v1/users/current"));
-					UserRequest->SetHeader(TEXT("Authorization"), UserSettings->GetAuthZHeaderValue());
+					TSharedRef<IHttpRequest> UserRequest = FMixerRestClient::Get().CreateRequest(TEXT("GET"), TEXT("users/current"), UserSettings->GetAuthZHeaderValue());
 					UserRequest->OnProcessRequestComplete().BindRaw(this, &FMixerInteractivityModule::OnUserRequestComplete);
-					if (!UserRequest->ProcessRequest())
+					if (FMixerRestClient::Get().ProcessRequest(UserRequest))
+					{
+						OnAccessTokenAcquired();
+					}
+					else
 					{
 						LoginError = true;
 					}
@@ -918,6 +2708,8 @@ void FMixerInteractivityModule::OnXboxUserRemoved(Windows::Xbox::System::User^ R
 bool FMixerInteractivityModule::LoginSilentlyInternal(TSharedPtr<const FUniqueNetId> UserId)
 {
 	// Non-Xbox platform using XToken auth.  Requires custom version of OnlineSubsystemLive
+	// Bound before Login, which may complete synchronously.
+	BindPlatformLoginDelegates();
 	IOnlineIdentityPtr IdentityInterface = Online::GetIdentityInterface(nullptr, LIVE_SUBSYSTEM);
 	if (!IdentityInterface.IsValid())
 	{
@@ -965,12 +2757,13 @@ void FMixerInteractivityModule::OnXTokenRetrievalComplete(int32 LocalUserNum, bo
 					UMixerInteractivityUserSettings* UserSettings = GetMutableDefault<UMixerInteractivityUserSettings>();
 					UserSettings->AccessToken = *XToken;
 
-					TSharedRef<IHttpRequest> UserRequest = FHttpModule::Get().CreateRequest();
-					UserRequest->SetVerb(TEXT("GET"));
-					UserRequest->SetURL(TEXT("https://mixer.com/api/v1/users/current"));
-					UserRequest->SetHeader(TEXT("Authorization"), XToken);
+					TSharedRef<IHttpRequest> UserRequest = FMixerRestClient::Get().CreateRequest(TEXT("GET"), TEXT("users/current"), XToken);
 					UserRequest->OnProcessRequestComplete().BindRaw(this, &FMixerInteractivityModule::OnUserRequestComplete);
-					MovedToNextLoginPhase = UserRequest->ProcessRequest();
+					MovedToNextLoginPhase = FMixerRestClient::Get().ProcessRequest(UserRequest);
+					if (MovedToNextLoginPhase)
+					{
+						OnAccessTokenAcquired();
+					}
 				}
 			}
 		}
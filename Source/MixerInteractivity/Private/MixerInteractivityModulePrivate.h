@@ -12,7 +12,13 @@
 
 #include "MixerInteractivityModule.h"
 #include "MixerInteractivityTypes.h"
+#include "MixerInputHandlerRegistry.h"
+#include "MixerAllocationGuard.h"
+#include "MixerBenchmarks.h"
+#include "MixerSoakTest.h"
+#include "MixerImageCache.h"
 #include "Containers/Ticker.h"
+#include "Containers/Queue.h"
 #include "UObject/WeakObjectPtrTemplates.h"
 #include "Interfaces/IHttpRequest.h"
 #include "Interfaces/IHttpResponse.h"
@@ -56,7 +62,14 @@ public:
 	double RefreshAtAppTime;
 
 	BEGIN_JSON_SERIALIZER
-		JSON_SERIALIZE("username", Name);
+		{
+			FString UserName = Name;
+			JSON_SERIALIZE("username", UserName);
+			if (Serializer.IsLoading())
+			{
+				Name = UserName;
+			}
+		}
 		JSON_SERIALIZE("id", Id);
 		JSON_SERIALIZE("level", Level);
 		JSON_SERIALIZE("experience", Experience);
@@ -79,8 +92,7 @@ class IWebBrowserPopupFeatures;
 class UMixerInteractivityBlueprintEventSource;
 
 class FMixerInteractivityModule :
-	public IMixerInteractivityModule,
-	public FTickerObjectBase
+	public IMixerInteractivityModule
 {
 public:
 	virtual void StartupModule() override;
@@ -90,6 +102,7 @@ public:
 	virtual bool LoginSilently(TSharedPtr<const FUniqueNetId> UserId);
 	virtual bool LoginWithUI(TSharedPtr<const FUniqueNetId> UserId);
 	virtual bool LoginWithAuthCode(const FString& AuthCode, TSharedPtr<const FUniqueNetId> UserId);
+	virtual bool LoginWithShortCode(TSharedPtr<const FUniqueNetId> UserId);
 	virtual bool Logout();
 	virtual EMixerLoginState GetLoginState();
 
@@ -98,13 +111,24 @@ public:
 	virtual bool GetCustomControl(UWorld* ForWorld, FName ControlName, TSharedPtr<FJsonObject>& OutControlObject);
 	virtual bool GetCustomControl(UWorld* ForWorld, FName ControlName, class UMixerCustomControl*& OutControlObject);
 	virtual TSharedPtr<const FMixerLocalUser> GetCurrentUser()				{ return CurrentUser; }
+	virtual bool GetStartupTimings(FMixerStartupTimings& OutTimings);
+	virtual bool GetInputLatency(EMixerInputLatencyClass LatencyClass, FMixerInputLatencyStats& OutStats);
+	virtual void ResetInputLatency();
 
 	virtual TSharedPtr<class IOnlineChat> GetChatInterface();
 	virtual TSharedPtr<class IOnlineChatMixer> GetExtendedChatInterface();
 
+	virtual void RegisterInputHandler(UObject* Handler, const FMixerInputHandlerFilter& Filter)	{ InputHandlers.Register(*this, Handler, Filter); }
+	virtual void UnregisterInputHandler(UObject* Handler)						{ InputHandlers.Unregister(Handler); }
+
+	virtual void CaptureSparkTransaction(const FString& TransactionId);
+
 	virtual FOnLoginStateChanged& OnLoginStateChanged()							{ return LoginStateChanged; }
 	virtual FOnInteractivityStateChanged& OnInteractivityStateChanged()			{ return InteractivityStateChanged; }
 	virtual FOnParticipantStateChangedEvent& OnParticipantStateChanged()		{ return ParticipantStateChanged; }
+	virtual FOnParticipantsChangedEvent& OnParticipantsChanged()				{ return ParticipantsChanged; }
+	virtual FOnParticipantUpdatedEvent& OnParticipantUpdated()					{ return ParticipantUpdated; }
+	virtual FOnParticipantsEnrichedEvent& OnParticipantsEnriched()				{ return ParticipantsEnriched; }
 	virtual FOnButtonEvent& OnButtonEvent()										{ return ButtonEvent; }
 	virtual FOnStickEvent& OnStickEvent()										{ return StickEvent; }
 	virtual FOnBroadcastingStateChanged& OnBroadcastingStateChanged()			{ return BroadcastingStateChanged; }
@@ -112,20 +136,125 @@ public:
 	virtual FOnCustomControlPropertyUpdate& OnCustomControlPropertyUpdate()		{ return CustomControlPropertyUpdate; }
 	virtual FOnCustomMethodCall& OnCustomMethodCall()							{ return CustomMethodCall; }
 	virtual FOnTextboxSubmitEvent& OnTextboxSubmitEvent()						{ return TextboxSubmitEvent; }
+	virtual FOnButtonEvent& OnButtonEvent(FName Button);
+	virtual FOnButtonEvent* OnButtonEvent(FMixerControlHandle Button);
+	virtual FOnStickEvent& OnStickEvent(FName Stick);
+	virtual FOnStickEvent* OnStickEvent(FMixerControlHandle Stick);
+	virtual FOnTextboxSubmitEvent& OnTextboxSubmitEvent(FName Textbox);
+	virtual bool UnbindControlEvent(FName ControlId, FDelegateHandle Handle);
+	virtual FOnInputBatch& OnInputBatch()										{ return InputBatch; }
+	virtual FOnGroupInputBatch& OnGroupInputBatch()								{ return GroupInputBatch; }
+	virtual FOnSparkTransactionComplete& OnSparkTransactionComplete()			{ return SparkTransactionComplete; }
+	virtual FOnShortCodeReceived& OnShortCodeReceived()							{ return ShortCodeReceived; }
+	virtual FOnPerParticipantStateCachingChanged& OnPerParticipantStateCachingChanged()	{ return PerParticipantStateCachingChanged; }
+	virtual FOnVoteRoundClosed& OnVoteRoundClosed()								{ return VoteRoundClosed; }
 
 public:
 	virtual bool Tick(float DeltaTime);
 
+	/**
+	* Whether this tick runs state maintenance and flushes (see ProcessingRate).  Decided at the
+	* start of the base class tick, so backends can check it in theirs.
+	*/
+	bool IsProcessingStep() const { return bProcessingStep; }
+
+	/** Whether this tick delivers input, which is every tick unless bDispatchInputAtProcessingRate. */
+	bool IsInputDispatchStep() const { return bInputDispatchStep; }
+
+	/** Time since the previous processing step, for maintenance that decays or integrates over time. */
+	float GetProcessingDeltaTime() const { return ProcessingDeltaTime; }
+
+	/** Ticking slowly, without processing steps, while the user is neither broadcasting nor interactive (see bHibernateWhenNotBroadcasting). */
+	bool IsHibernating() const { return bHibernating; }
+
+	/**
+	* The module is only registered with the core ticker while it has something to do, so games
+	* that never touch Mixer pay nothing per frame.  Login and state changes wake it automatically;
+	* anything else that leaves work for the tick (chat rooms, avatar fetches, deferred HTTP
+	* completions) must call this.
+	*/
+	void WakeTicker();
+
+	virtual void BeginStagedSceneChange(FName Scene, FName GroupName = NAME_None);
+	virtual void CommitStagedSceneChange();
+
+protected:
+	/** Drop a scene change that was begun but not committed, along with the control updates held back for it. */
+	void DiscardStagedSceneChange();
+
+	/** Drop updates from SubmitRemoteControlUpdate and friends that haven't been drained yet, so they can't reach the next session. */
+	void DiscardSubmittedControlUpdates()								{ SubmittedControlUpdates.Empty(); }
+
 public:
 	void UpdateRemoteControl(FName SceneName, FName ControlName, TSharedRef<FJsonObject> PropertiesToUpdate);
 
+	virtual void SubmitRemoteControlUpdate(FName SceneName, FName ControlName, TSharedRef<FJsonObject> PropertiesToUpdate);
+	virtual void SubmitLabelText(FName Label, const FText& DisplayText);
+	virtual void SubmitButtonCooldown(FName Button, FTimespan CooldownTime);
+
+	/**
+	* Pending updates for one scene, for queueing many controls with SetPendingControlProperty without a
+	* scene lookup each.  Invalidated by the next call, or by anything else that queues control updates.
+	*/
+	TMap<FName, TSharedRef<FJsonObject>>& GetPendingControlUpdatesForScene(FName SceneName);
+
+	/** Queue a single property change.  JSON values are immutable, so one value may be shared by many controls. */
+	static void SetPendingControlProperty(TMap<FName, TSharedRef<FJsonObject>>& ControlsForScene, FName ControlName, const FString& PropertyName, const TSharedRef<FJsonValue>& Value);
+
+	/**
+	* Custom controls with client-writable properties are ticked from here rather than each owning a ticker,
+	* so that they can be spread across frames and their updates share a single flush.
+	*/
+	void RegisterCustomControl(class UMixerCustomControl* Control);
+
+	/** Fired once per tick so that blueprint event sources can deliver input they coalesce over a frame. */
+	DECLARE_EVENT(FMixerInteractivityModule, FOnFlushCoalescedEvents);
+	FOnFlushCoalescedEvents& OnFlushCoalescedEvents()					{ return FlushCoalescedEvents; }
+
+#if MIXER_BENCHMARKS_ENABLED
+	/**
+	* Run an interactive session with no service behind it, for FMixerBenchmarks.  Frames passed to
+	* ReceiveBenchmarkFrame go through the backend's own receive path, and PumpBenchmarkSession does the
+	* work its other threads and Tick would then do, all on the calling thread so that all of it is timed.
+	* Backends that override PumpBenchmarkSession call this one first, which sends queued control updates.
+	*
+	* @param ScenesResult	The result of a getScenes reply, for the session's scenes.
+	* @return	false if the backend can't be driven this way, or a user is signed in.
+	*/
+	virtual bool BeginBenchmarkSession(const FString& ScenesResult)		{ return false; }
+	virtual void ReceiveBenchmarkFrame(const FString& Frame)			{}
+	virtual void PumpBenchmarkSession();
+	virtual void EndBenchmarkSession()									{}
+#endif
+
+	/**
+	* Report how many entries each container the session keeps holds, for FMixerSoakTest's growth checks.
+	* Overrides report their own and call this one.  Containers counted together share a name.
+	*/
+	virtual void GetContainerSizes(TFunctionRef<void(const TCHAR* Name, int64 Size)> Visit) const;
+
+#if MIXER_SOAK_TEST_ENABLED
+	/** Connect with no signed in user, for FMixerSoakTest's sessions against the mock service. */
+	bool StartSoakConnection()											{ return StartInteractiveConnection(); }
+	void StopSoakConnection()											{ StopInteractiveConnection(); }
+#endif
+
 protected:
 	virtual bool StartInteractiveConnection() = 0;
 	virtual void StopInteractiveConnection() = 0;
+
+	/** Begin looking up interactive hosts ahead of StartInteractiveConnection (pipelined startup). */
+	virtual void PrefetchInteractiveHosts() {}
+
+	/** The access token in user settings was replaced by a background refresh; backends that hold their own copy update it here. */
+	virtual void OnAccessTokenRefreshed() {}
+
+	/** Record the time since login started against Phase, the first time it's reached. */
+	void MarkStartupPhase(float& Phase, const TCHAR* PhaseName);
 	EMixerLoginState GetInteractiveConnectionAuthState() const			{ return InteractiveConnectionAuthState; }
 	void SetInteractiveConnectionAuthState(EMixerLoginState InState);
 	EMixerInteractivityState GetInteractivityState() const				{ return InteractivityState; }
-	void SetInteractivityState(EMixerInteractivityState InState)		{ InteractivityState = InState; InteractivityStateChanged.Broadcast(InState); }
+	void SetInteractivityState(EMixerInteractivityState InState)		{ InteractivityState = InState; WakeTicker(); InteractivityStateChanged.Broadcast(InState); }
 #if PLATFORM_XBOXONE
 	Windows::Xbox::System::User^ GetXboxUser()							{ return XboxUserOperation.Get(); }
 #endif
@@ -135,18 +264,106 @@ protected:
 
 	virtual bool HandleSingleControlUpdate(FName ControlId, const TSharedRef<FJsonObject> ControlData) { return false; }
 
+	/** Name of the control a handle refers to, or NAME_None if it's stale or the backend has no handles. */
+	virtual FName GetButtonId(FMixerControlHandle Button) const { return NAME_None; }
+	virtual FName GetStickId(FMixerControlHandle Stick) const { return NAME_None; }
+
+	/** Fire the global input events, then the keyed ones for the control.  Backends should use these rather than broadcasting directly. */
+	void BroadcastButtonEvent(FName ControlId, TSharedPtr<const FMixerRemoteUser> Participant, const FMixerButtonEventDetails& Details);
+	void BroadcastStickEvent(FName ControlId, TSharedPtr<const FMixerRemoteUser> Participant, FVector2D Value);
+	void BroadcastTextboxSubmitEvent(FName ControlId, TSharedPtr<const FMixerRemoteUser> Participant, const FMixerTextboxEventDetails& Details);
+
+private:
+	template <class EventType, class... ArgTypes>
+	void BroadcastKeyedEvent(TMap<FName, TUniquePtr<EventType>>& Events, FName ControlId, const ArgTypes&... Args);
+
+	template <class EventType>
+	bool RemoveKeyedBinding(TMap<FName, TUniquePtr<EventType>>& Events, FName ControlId, FDelegateHandle Handle);
+
+protected:
+
+	/**
+	* True while the control updates being sent must reach the service ahead of anything queued after
+	* them (cooldowns, enable/disable, a staged scene's controls).  Backends that hold large messages
+	* back should send these immediately, along with whatever was already held back ahead of them.
+	*/
+	bool IsSendingUrgentControlUpdates() const { return bSendingUrgentControlUpdates; }
+
+	/** Note that input which arrived at ArrivedTime (FPlatformTime::Seconds()) is now being handed to gameplay. */
+	void RecordInputLatency(EMixerInputLatencyClass LatencyClass, double ArrivedTime);
+
+	/** Reflect a committed staged scene change in local state ahead of the service confirming it. */
+	virtual void ApplySceneChangeLocally(FName Scene, FName GroupName) {}
+
+	/** Send one queued capture to the service.  The backend reports the result via CompleteSparkCapture. */
+	virtual void SendSparkCapture(const FString& TransactionId) = 0;
+	void CompleteSparkCapture(const FString& TransactionId, bool bSucceeded, const FString& ErrorMessage);
+
 private:
 	EMixerLoginState GetUserAuthState() const { return UserAuthState; }
 	void SetUserAuthState(EMixerLoginState InState);
+
+	bool TickFromTicker(float DeltaTime);
+	bool IsIdle() const;
+
+	// Platform login hooks are only installed on the first login attempt
+	void BindPlatformLoginDelegates();
+	void UnbindPlatformLoginDelegates();
+	void CreateChatInterfaceIfNeeded();
 	void HandleLoginStateChange(EMixerLoginState OldState, EMixerLoginState NewState);
 
 	bool LoginSilentlyInternal(TSharedPtr<const FUniqueNetId> UserId);
 	void LoginWithUIInternal(TSharedPtr<const FUniqueNetId> UserId);
-	bool LoginWithAuthCodeInternal(const FString& AuthCode, TSharedPtr<const FUniqueNetId> UserId);
+	bool LoginWithAuthCodeInternal(const FString& AuthCode, TSharedPtr<const FUniqueNetId> UserId, bool bIncludeRedirectUri = true);
+
+	void BeginStartupTiming();
+	void OnAccessTokenAcquired();
+
+	void UpdateInputLatencyStats();
+
+	/** Fields of an oauth/token response, parsed off the game thread. */
+	struct FMixerTokenResponse
+	{
+		FString AccessToken;
+		FString RefreshToken;
+		FString ErrorDescription;
+		double ExpiresIn;
+
+		FMixerTokenResponse() : ExpiresIn(0.0) {}
+	};
 
 	void OnTokenRequestComplete(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded);
+	void OnTokenResponseParsed(bool bGotAccessToken, const FMixerTokenResponse& TokenResponse);
+	static bool ParseTokenResponse(const FString& Content, FMixerTokenResponse& OutTokenResponse);
+	void ApplyTokenResponse(const FMixerTokenResponse& TokenResponse);
+	TSharedRef<IHttpRequest> CreateTokenRefreshRequest() const;
+	void ScheduleAccessTokenRefresh(double ExpiresIn);
+	void TickAccessTokenRefresh();
+	void CancelAccessTokenRefresh();
+	void OnBackgroundTokenRefreshComplete(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded);
+	void OnBackgroundTokenResponseParsed(bool bGotAccessToken, const FMixerTokenResponse& TokenResponse);
+	static bool ParseUserResponse(const FString& Content, FMixerLocalUserJsonSerializable& OutUser);
 	void OnUserRequestComplete(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded);
+	void OnUserResponseParsed(bool bParsed, FMixerLocalUserJsonSerializable& User);
 	void OnUserMaintenanceRequestComplete(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded);
+	void OnUserMaintenanceResponseParsed(bool bParsed, FMixerLocalUserJsonSerializable& UpdatedUser);
+
+	/** Fields of an oauth/shortcode or oauth/shortcode/check response, parsed off the game thread. */
+	struct FMixerShortCodeResponse
+	{
+		FString Code;
+		FString Handle;
+		double ExpiresIn;
+
+		FMixerShortCodeResponse() : ExpiresIn(0.0) {}
+	};
+
+	void OnShortCodeRequestComplete(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded);
+	void OnShortCodeCheckComplete(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded);
+	static bool ParseShortCodeResponse(const FString& Content, FMixerShortCodeResponse& OutShortCodeResponse);
+	void TickShortCodeLogin();
+	bool IsShortCodeLoginInProgress() const;
+	void CancelShortCodeLogin();
 
 	FReply OnAuthCodeReady(const FString& AuthCode);
 	void OnLoginUIFlowFinished(bool WasSuccessful);
@@ -156,7 +373,19 @@ private:
 	void InitDesignTimeGroups();
 
 	void TickLocalUserMaintenance();
+	void TickLiveEvents();
+	void OnLiveEvent(const FString& EventName, const FJsonObject& Payload);
+	void UpdateBroadcastingState(bool bIsBroadcasting);
 	void FlushControlUpdates();
+	void DrainSubmittedControlUpdates();
+	void FlushSparkCaptures();
+	void TickCustomControls(float DeltaTime);
+	void FailOutstandingSparkCaptures(const FString& ErrorMessage);
+	void RecordKnownControlState(FName SceneName, FName ControlName, const FJsonObject& Properties);
+	void SendControlUpdates(FName SceneName, const TArray<TSharedPtr<FJsonValue>>& Controls);
+	void SplitOutgoingControlUpdates(FName SceneName, TArray<TSharedPtr<FJsonValue>>& Controls, int32& InOutSizeEstimate, int32 AddedSize);
+	void HandleControlUpdatesReply(bool bSucceeded, TSharedPtr<FJsonObject> Result, const FString& ErrorMessage, FName SceneName, TArray<TSharedPtr<FJsonValue>> Controls);
+	bool PrepareControlUpdate(FName SceneName, FName ControlName, const TSharedRef<FJsonObject>& PendingProperties, TArray<TSharedPtr<FJsonValue>>& OutControls, int32& OutSizeEstimate);
 
 private:
 
@@ -176,6 +405,50 @@ private:
 	TSharedPtr<const FUniqueNetId> NetId;
 	TSharedPtr<FMixerLocalUserJsonSerializable> CurrentUser;
 
+protected:
+	FMixerStartupTimings StartupTimings;
+
+private:
+	double StartupTimeBase;
+
+	// Log-spaced buckets from 0.05ms, each 25% wider than the last, reaching about a minute at the top
+	static const int32 NumInputLatencyBuckets = 64;
+	struct FInputLatencyHistogram
+	{
+		FInputLatencyHistogram()
+			: NumSamples(0)
+			, TotalMs(0.0)
+			, MaxMs(0.0)
+		{
+			FMemory::Memzero(Buckets);
+		}
+
+		uint32 Buckets[NumInputLatencyBuckets];
+		int32 NumSamples;
+		double TotalMs;
+		double MaxMs;
+	};
+	FInputLatencyHistogram InputLatency[static_cast<int32>(EMixerInputLatencyClass::Count)];
+	bool bInputLatencyChanged;
+
+	// Push updates for the local user, with polling (backing off while nothing changes) as a fallback
+	TSharedPtr<class FMixerConstellationConnection> LiveEvents;
+	double UserPollInterval;
+
+	// Shared chat image textures, served through FMixerImageCache::Get().  Owned here so they're released before UObjects shut down.
+	TUniquePtr<FMixerImageCache> ImageCache;
+
+	// Background OAuth token refresh.  Times are FPlatformTime::Seconds(), 0 when not scheduled.
+	FHttpRequestPtr BackgroundTokenRefreshRequest;
+	double AccessTokenRefreshTime;
+	double AccessTokenExpiryTime;
+
+	// Browserless shortcode login.  The handle is set from when the code is issued until it's approved, denied or expires.
+	FHttpRequestPtr ShortCodeRequest;
+	FString ShortCodeHandle;
+	double ShortCodeExpiryTime;
+	double ShortCodeNextCheckTime;
+
 	EMixerLoginState UserAuthState;
 	EMixerLoginState InteractiveConnectionAuthState;
 	EMixerInteractivityState InteractivityState;
@@ -183,6 +456,9 @@ private:
 	FOnLoginStateChanged LoginStateChanged;
 	FOnInteractivityStateChanged InteractivityStateChanged;
 	FOnParticipantStateChangedEvent ParticipantStateChanged;
+	FOnParticipantsChangedEvent ParticipantsChanged;
+	FOnParticipantUpdatedEvent ParticipantUpdated;
+	FOnParticipantsEnrichedEvent ParticipantsEnriched;
 	FOnButtonEvent ButtonEvent;
 	FOnStickEvent StickEvent;
 	FOnBroadcastingStateChanged BroadcastingStateChanged;
@@ -191,9 +467,111 @@ private:
 	FOnCustomMethodCall CustomMethodCall;
 	FOnTextboxSubmitEvent TextboxSubmitEvent;
 
+	// Keyed subscriptions.  Held by pointer so references handed out survive the maps growing.
+	TMap<FName, TUniquePtr<FOnButtonEvent>> ButtonEventsByControl;
+	TMap<FName, TUniquePtr<FOnStickEvent>> StickEventsByControl;
+	TMap<FName, TUniquePtr<FOnTextboxSubmitEvent>> TextboxSubmitEventsByControl;
+	// Events left without bindings are only released outside a keyed broadcast, which may still be using them
+	bool bBroadcastingKeyedEvent;
+	FOnInputBatch InputBatch;
+	FOnGroupInputBatch GroupInputBatch;
+	FOnSparkTransactionComplete SparkTransactionComplete;
+	FOnShortCodeReceived ShortCodeReceived;
+	FOnPerParticipantStateCachingChanged PerParticipantStateCachingChanged;
+	FOnVoteRoundClosed VoteRoundClosed;
+	FOnFlushCoalescedEvents FlushCoalescedEvents;
+
+	// Created on first request for a chat interface
 	TSharedPtr<class FOnlineChatMixer> ChatInterface;
 
-	TMap<FName, TArray<TSharedPtr<FJsonValue>>> PendingControlUpdates;
+	FDelegateHandle TickerHandle;
+	bool bPlatformLoginDelegatesBound;
+
+	// Kick off FMixerProjectAssetPreloader
+	FDelegateHandle PostEngineInitHandle;
+	FDelegateHandle PostWorldInitHandle;
+
+	void UpdateProcessingStep(float DeltaTime);
+	bool ShouldHibernate() const;
+	void SetHibernating(bool bHibernate);
+
+	// Phase towards the next processing step, and time actually elapsed since the last one
+	double ProcessingPhase;
+	float ProcessingDeltaTime;
+	float TimeSinceProcessingStep;
+	bool bProcessingStep;
+	bool bInputDispatchStep;
+	bool bHibernating;
+
+#if MIXER_ALLOCATION_GUARD_ENABLED
+	/** Report the frame's counted allocations, and hold steady state ticks to the budget */
+	void TickAllocationGuard(float DeltaTime);
+
+	bool bAllocationGuardEnabled;
+	float AllocationGuardSteadyTime;
+	double AllocationGuardNextWarningTime;
+	uint64 AllocationGuardWorstFrame;
+	int32 AllocationGuardFramesOver;
+#endif
+
+	FMixerInputHandlerRegistry InputHandlers;
+
+	struct FScheduledCustomControl
+	{
+		TWeakObjectPtr<class UMixerCustomControl> Control;
+		double NextUpdateTime;
+	};
+
+	TArray<FScheduledCustomControl> ScheduledCustomControls;
+	int32 CustomControlsEverScheduled;
+
+	// Captures requested since the last tick, and every transaction queued or awaiting a result (for dedupe)
+	TArray<FString> PendingSparkCaptures;
+	TSet<FString> OutstandingSparkCaptures;
+
+	struct FSubmittedControlUpdate
+	{
+		enum class EKind : uint8
+		{
+			Properties,
+			LabelText,
+			ButtonCooldown,
+		};
+
+		EKind Kind;
+		FName SceneName;
+		FName ControlName;
+		TSharedPtr<FJsonObject> Properties;
+		FText Text;
+		FTimespan Cooldown;
+	};
+
+	// Updates submitted from any thread since the last flush.  Only the game thread dequeues.
+	TQueue<FSubmittedControlUpdate, EQueueMode::Mpsc> SubmittedControlUpdates;
+
+	// Scene -> control -> merged properties.  Keyed so that repeated updates to the
+	// same control within a frame merge in constant time; JSON arrays are built at flush.
+	TMap<FName, TMap<FName, TSharedRef<FJsonObject>>> PendingControlUpdates;
+
+	// Scene change being prepared with BeginStagedSceneChange, and the control updates held back for it
+	FName StagedScene;
+	FName StagedSceneGroup;
+	bool bSceneChangeStaged;
+	TMap<FName, TSharedRef<FJsonObject>> StagedControlUpdates;
+
+	// Scene -> control -> property values the service is known to hold, either because it
+	// acknowledged our update or because it reported them.  Used to drop redundant updates at flush.
+	TMap<FName, TMap<FName, TSharedRef<FJsonObject>>> KnownControlState;
+
+	// Scene -> control -> FPlatformTime::Seconds() of the last update sent for it.
+	TMap<FName, TMap<FName, double>> ControlLastSendTime;
+
+	// Token bucket for ControlUpdateBytesPerSecond.  May go negative after urgent updates.
+	double ControlUpdateBudget;
+	double ControlUpdateBudgetTime;
+
+	// Set while sending urgent or staged-commit control updates; see IsSendingUrgentControlUpdates.
+	bool bSendingUrgentControlUpdates;
 
 	bool RetryLoginWithUI;
 };
\ No newline at end of file
@@ -16,6 +16,7 @@
 #include "MixerInteractivityUserSettings.h"
 #include "MixerInteractivityTypes.h"
 #include "MixerInteractivityBlueprintLibrary.h"
+#include "HAL/IConsoleManager.h"
 
 #if PLATFORM_WINDOWS
 #include "PreWindowsApi.h"
@@ -45,6 +46,18 @@
 
 IMPLEMENT_MODULE(FMixerInteractivityModule_InteractiveCpp, MixerInteractivity);
 
+static int32 GMixerParticipantCacheEntriesPerFrame = 64;
+static FAutoConsoleVariableRef CVarMixerParticipantCacheEntriesPerFrame(
+	TEXT("Mixer.ParticipantCache.EntriesPerFrame"),
+	GMixerParticipantCacheEntriesPerFrame,
+	TEXT("Number of cached participants checked for eviction each frame by the interactive-cpp backend.  The whole cache is visited round-robin over several frames."),
+	ECVF_Default);
+
+FMixerInteractivityModule_InteractiveCpp::FMixerInteractivityModule_InteractiveCpp()
+	: CacheMaintenanceCursor(0)
+{
+}
+
 bool FMixerInteractivityModule_InteractiveCpp::StartInteractiveConnection()
 {
 	using namespace Microsoft::mixer;
@@ -98,6 +111,11 @@ void FMixerInteractivityModule_InteractiveCpp::StopInteractiveConnection()
 	{
 		SetInteractiveConnectionAuthState(EMixerLoginState::Not_Logged_In);
 		RemoteParticipantCache.Empty();
+		ResetControlIndex();
+		ParticipantsById.Empty();
+		CacheMaintenanceQueue.Empty();
+		CacheMaintenanceCursor = 0;
+		SparkCapturesAwaitingWork.Empty();
 	}
 }
 
@@ -107,13 +125,27 @@ bool FMixerInteractivityModule_InteractiveCpp::Tick(float DeltaTime)
 
 	FMixerInteractivityModule::Tick(DeltaTime);
 
-	std::vector<interactive_event> EventsThisFrame = interactivity_manager::get_singleton_instance()->do_work();
+	// do_work is both the input pump and the SDK's own maintenance, so it can only follow input delivery
+	if (!IsInputDispatchStep())
+	{
+		return true;
+	}
+
+	// The vector and its events are built inside the prebuilt library, so its allocations aren't ours to recycle.
+	// What we can do is not add to them: args are read through the event's own pointer for the duration of the
+	// loop rather than copied into another shared_ptr, and an idle frame does no work past this call.
+	const std::vector<interactive_event> EventsThisFrame = interactivity_manager::get_singleton_instance()->do_work();
+
+	// Captures handed over before this do_work were sent by it
+	TArray<FString> SparkCapturesSent = MoveTemp(SparkCapturesAwaitingWork);
+	SparkCapturesAwaitingWork.Reset();
+	FString FirstErrorThisFrame;
 
 	// interactive-cpp doesn't support a true shutdown.  We'll approximate one to external code
 	// by ignoring events when we're not supposed to have an interactive connection.
-	if (GetInteractiveConnectionAuthState() != EMixerLoginState::Not_Logged_In)
+	if (!EventsThisFrame.empty() && GetInteractiveConnectionAuthState() != EMixerLoginState::Not_Logged_In)
 	{
-		for (auto& MixerEvent : EventsThisFrame)
+		for (const interactive_event& MixerEvent : EventsThisFrame)
 		{
 			switch (MixerEvent.event_type())
 			{
@@ -123,6 +155,10 @@ bool FMixerInteractivityModule_InteractiveCpp::Tick(float DeltaTime)
 				// transitions to not_initialized can occur during normal operation (e.g.
 				// Xbox user change) where we wouldn't want to abandon the regular state flow.
 				UE_LOG(LogMixerInteractivity, Warning, TEXT("%s"), MixerEvent.err_message().c_str());
+				if (FirstErrorThisFrame.IsEmpty())
+				{
+					FirstErrorThisFrame = MixerEvent.err_message().c_str();
+				}
 				if (interactivity_manager::get_singleton_instance()->interactivity_state() == interactivity_state::not_initialized)
 				{
 					SetInteractiveConnectionAuthState(EMixerLoginState::Not_Logged_In);
@@ -131,12 +167,13 @@ bool FMixerInteractivityModule_InteractiveCpp::Tick(float DeltaTime)
 
 			case interactive_event_type::interactivity_state_changed:
 			{
-				auto StateChangeArgs = std::static_pointer_cast<interactivity_state_change_event_args>(MixerEvent.event_args());
+				const interactivity_state_change_event_args* StateChangeArgs = static_cast<const interactivity_state_change_event_args*>(MixerEvent.event_args().get());
 				switch (StateChangeArgs->new_state())
 				{
 				case interactivity_state::not_initialized:
 					// Leave auth state alone - the auth path on Xbox can pop to this state.
 					SetInteractivityState(EMixerInteractivityState::Not_Interactive);
+					ResetControlIndex();
 					break;
 
 				case interactivity_state::initializing:
@@ -153,10 +190,13 @@ bool FMixerInteractivityModule_InteractiveCpp::Tick(float DeltaTime)
 				case interactivity_state::interactivity_disabled:
 					SetInteractiveConnectionAuthState(EMixerLoginState::Logged_In);
 					SetInteractivityState(EMixerInteractivityState::Not_Interactive);
+					ResetControlIndex();
 					break;
 
 				case interactivity_state::interactivity_enabled:
 					SetInteractiveConnectionAuthState(EMixerLoginState::Logged_In);
+					RebuildControlIndex();
+					RebuildParticipantIndex();
 					SetInteractivityState(EMixerInteractivityState::Interactive);
 					break;
 				}
@@ -165,7 +205,7 @@ bool FMixerInteractivityModule_InteractiveCpp::Tick(float DeltaTime)
 
 			case interactive_event_type::participant_state_changed:
 			{
-				auto ParticipantEventArgs = std::static_pointer_cast<interactive_participant_state_change_event_args>(MixerEvent.event_args());
+				const interactive_participant_state_change_event_args* ParticipantEventArgs = static_cast<const interactive_participant_state_change_event_args*>(MixerEvent.event_args().get());
 				TSharedPtr<const FMixerRemoteUser> RemoteParticipant = CreateOrUpdateCachedParticipant(ParticipantEventArgs->participant());
 				switch (ParticipantEventArgs->state())
 				{
@@ -174,6 +214,7 @@ bool FMixerInteractivityModule_InteractiveCpp::Tick(float DeltaTime)
 					break;
 
 				case interactive_participant_state::left:
+					ParticipantsById.Remove(RemoteParticipant->Id);
 					OnParticipantStateChanged().Broadcast(RemoteParticipant, EMixerInteractivityParticipantState::Left);
 					break;
 
@@ -189,21 +230,25 @@ bool FMixerInteractivityModule_InteractiveCpp::Tick(float DeltaTime)
 
 			case interactive_event_type::button:
 			{
-				auto OriginalButtonArgs = std::static_pointer_cast<interactive_button_event_args>(MixerEvent.event_args());
+				const interactive_button_event_args* OriginalButtonArgs = static_cast<const interactive_button_event_args*>(MixerEvent.event_args().get());
 				TSharedPtr<const FMixerRemoteUser> RemoteParticipant = CreateOrUpdateCachedParticipant(OriginalButtonArgs->participant());
 				FMixerButtonEventDetails Details;
 				Details.Pressed = OriginalButtonArgs->is_pressed();
-				Details.TransactionId = OriginalButtonArgs->transaction_id().c_str();
 				Details.SparkCost = OriginalButtonArgs->cost();
-				OnButtonEvent().Broadcast(FName(OriginalButtonArgs->control_id().c_str()), RemoteParticipant, Details);
+				if (Details.SparkCost > 0)
+				{
+					// Only paid inputs have a transaction worth capturing
+					Details.TransactionId = OriginalButtonArgs->transaction_id().c_str();
+				}
+				BroadcastButtonEvent(FindControlName(OriginalButtonArgs->control_id().c_str()), RemoteParticipant, Details);
 			}
 			break;
 
 			case interactive_event_type::joystick:
 			{
-				auto OriginalStickArgs = std::static_pointer_cast<interactive_joystick_event_args>(MixerEvent.event_args());
+				const interactive_joystick_event_args* OriginalStickArgs = static_cast<const interactive_joystick_event_args*>(MixerEvent.event_args().get());
 				TSharedPtr<const FMixerRemoteUser> RemoteParticipant = CreateOrUpdateCachedParticipant(OriginalStickArgs->participant());
-				OnStickEvent().Broadcast(FName(OriginalStickArgs->control_id().c_str()), RemoteParticipant, FVector2D(OriginalStickArgs->x(), OriginalStickArgs->y()));
+				BroadcastStickEvent(FindControlName(OriginalStickArgs->control_id().c_str()), RemoteParticipant, FVector2D(OriginalStickArgs->x(), OriginalStickArgs->y()));
 				break;
 			}
 
@@ -213,7 +258,17 @@ bool FMixerInteractivityModule_InteractiveCpp::Tick(float DeltaTime)
 		}
 	}
 
-	TickParticipantCacheMaintenance();
+	// The v1 interactivity_manager has no per-call replies.  The closest thing is whether the do_work
+	// that sent a capture raised an error, so that decides its outcome.
+	for (const FString& TransactionId : SparkCapturesSent)
+	{
+		CompleteSparkCapture(TransactionId, FirstErrorThisFrame.IsEmpty(), FirstErrorThisFrame);
+	}
+
+	if (IsProcessingStep())
+	{
+		TickParticipantCacheMaintenance();
+	}
 
 	return true;
 }
@@ -255,6 +310,9 @@ void FMixerInteractivityModule_InteractiveCpp::StopInteractivity()
 {
 	using namespace Microsoft::mixer;
 
+	// A scene change can't be committed into a session that's going away
+	DiscardStagedSceneChange();
+
 	switch (interactivity_manager::get_singleton_instance()->interactivity_state())
 	{
 	case interactivity_enabled:
@@ -300,6 +358,22 @@ void FMixerInteractivityModule_InteractiveCpp::SetCurrentScene(FName Scene, FNam
 	}
 }
 
+bool FMixerInteractivityModule_InteractiveCpp::SetScenesForGroups(TArrayView<const FMixerGroupSpec> Assignments, const FOnGroupBatchComplete& OnComplete)
+{
+	if (GetInteractivityState() != EMixerInteractivityState::Interactive || Assignments.Num() == 0)
+	{
+		return false;
+	}
+
+	for (const FMixerGroupSpec& Assignment : Assignments)
+	{
+		SetCurrentScene(Assignment.Scene, Assignment.Group);
+	}
+
+	OnComplete.ExecuteIfBound(true, FString());
+	return true;
+}
+
 FName FMixerInteractivityModule_InteractiveCpp::GetCurrentScene(FName GroupName)
 {
 	using namespace Microsoft::mixer;
@@ -326,6 +400,24 @@ void FMixerInteractivityModule_InteractiveCpp::TriggerButtonCooldown(FName Butto
 	}
 }
 
+void FMixerInteractivityModule_InteractiveCpp::TriggerCooldownForScene(FName Scene, FTimespan CooldownTime)
+{
+	using namespace Microsoft::mixer;
+
+	if (GetInteractivityState() == EMixerInteractivityState::Interactive)
+	{
+		std::shared_ptr<interactive_scene> TargetScene = interactivity_manager::get_singleton_instance()->scene(Scene != NAME_None ? *Scene.ToString() : TEXT("default"));
+		if (TargetScene != nullptr)
+		{
+			std::chrono::milliseconds CooldownTimeInMs = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::duration<double, std::milli>(CooldownTime.GetTotalMilliseconds()));
+			for (std::shared_ptr<interactive_button_control> Button : TargetScene->buttons())
+			{
+				Button->trigger_cooldown(CooldownTimeInMs);
+			}
+		}
+	}
+}
+
 bool FMixerInteractivityModule_InteractiveCpp::GetButtonDescription(FName Button, FMixerButtonDescription& OutDesc)
 {
 	using namespace Microsoft::mixer;
@@ -435,21 +527,12 @@ bool FMixerInteractivityModule_InteractiveCpp::GetTextboxDescription(FName Textb
 
 std::shared_ptr<Microsoft::mixer::interactive_button_control> FMixerInteractivityModule_InteractiveCpp::FindButton(FName Name)
 {
-	using namespace Microsoft::mixer;
-
 	if (GetInteractivityState() == EMixerInteractivityState::Interactive)
 	{
-		FString NameAsString = Name.ToString();
-		for (const std::shared_ptr<interactive_scene> SceneObject : interactivity_manager::get_singleton_instance()->scenes())
+		std::shared_ptr<Microsoft::mixer::interactive_button_control>* ButtonControl = ButtonsByName.Find(Name);
+		if (ButtonControl)
 		{
-			if (SceneObject)
-			{
-				std::shared_ptr<Microsoft::mixer::interactive_button_control> ButtonControl = SceneObject->button(*NameAsString);
-				if (ButtonControl)
-				{
-					return ButtonControl;
-				}
-			}
+			return *ButtonControl;
 		}
 	}
 
@@ -457,26 +540,101 @@ std::shared_ptr<Microsoft::mixer::interactive_button_control> FMixerInteractivit
 }
 
 std::shared_ptr<Microsoft::mixer::interactive_joystick_control> FMixerInteractivityModule_InteractiveCpp::FindStick(FName Name)
+{
+	if (GetInteractivityState() == EMixerInteractivityState::Interactive)
+	{
+		std::shared_ptr<Microsoft::mixer::interactive_joystick_control>* StickControl = SticksByName.Find(Name);
+		if (StickControl)
+		{
+			return *StickControl;
+		}
+	}
+
+	return nullptr;
+}
+
+void FMixerInteractivityModule_InteractiveCpp::RebuildControlIndex()
 {
 	using namespace Microsoft::mixer;
 
-	if (GetInteractivityState() == EMixerInteractivityState::Interactive)
+	// The v1 interactivity_manager loads every scene during initialization and doesn't
+	// change them afterwards, so entering interactivity_enabled is the only point at
+	// which the index can go out of date.
+	ResetControlIndex();
+	for (const std::shared_ptr<interactive_scene> SceneObject : interactivity_manager::get_singleton_instance()->scenes())
 	{
-		FString NameAsString = Name.ToString();
-		for (const std::shared_ptr<interactive_scene> SceneObject : interactivity_manager::get_singleton_instance()->scenes())
+		if (SceneObject)
 		{
-			if (SceneObject)
+			for (const std::shared_ptr<interactive_button_control>& ButtonControl : SceneObject->buttons())
+			{
+				// First scene to claim a name wins, matching the old per-query search order.
+				if (ButtonControl)
+				{
+					FName ButtonName = FindControlName(ButtonControl->control_id().c_str());
+					if (!ButtonsByName.Contains(ButtonName))
+					{
+						ButtonsByName.Add(ButtonName, ButtonControl);
+					}
+				}
+			}
+
+			for (const std::shared_ptr<interactive_joystick_control>& StickControl : SceneObject->joysticks())
 			{
-				std::shared_ptr<Microsoft::mixer::interactive_joystick_control> StickControl = SceneObject->joystick(*NameAsString);
 				if (StickControl)
 				{
-					return StickControl;
+					FName StickName = FindControlName(StickControl->control_id().c_str());
+					if (!SticksByName.Contains(StickName))
+					{
+						SticksByName.Add(StickName, StickControl);
+					}
 				}
 			}
 		}
 	}
+}
 
-	return nullptr;
+void FMixerInteractivityModule_InteractiveCpp::RebuildParticipantIndex()
+{
+	using namespace Microsoft::mixer;
+
+	// One full pass to pick up anyone already present; from here on the index follows
+	// participant events via CreateOrUpdateCachedParticipant and the left notification.
+	ParticipantsById.Empty();
+	for (std::shared_ptr<interactive_participant> Participant : interactivity_manager::get_singleton_instance()->participants())
+	{
+		check(Participant);
+		ParticipantsById.Add(Participant->mixer_id(), Participant);
+	}
+}
+
+void FMixerInteractivityModule_InteractiveCpp::ResetControlIndex()
+{
+	ButtonsByName.Empty();
+	SticksByName.Empty();
+	ControlNamesByHash.Empty();
+}
+
+FName FMixerInteractivityModule_InteractiveCpp::FindControlName(const TCHAR* ControlId)
+{
+	// Control ids arrive as fresh SDK strings on every event, so key on their hash and
+	// confirm with a plain compare rather than paying for an FName table lookup each time.
+	const uint32 ControlIdHash = FCrc::StrCrc32(ControlId);
+	FCachedControlName* Cached = ControlNamesByHash.Find(ControlIdHash);
+	if (Cached)
+	{
+		if (FCString::Strcmp(*Cached->ControlId, ControlId) == 0)
+		{
+			return Cached->Name;
+		}
+
+		// Hash collision - not worth chaining for, just convert directly.
+		return FName(ControlId);
+	}
+
+	FCachedControlName& NewEntry = ControlNamesByHash.Add(ControlIdHash);
+	NewEntry.ControlId = ControlId;
+	NewEntry.Name = FName(ControlId);
+	return NewEntry.Name;
 }
 
 TSharedPtr<const FMixerRemoteUser> FMixerInteractivityModule_InteractiveCpp::GetParticipant(uint32 ParticipantId)
@@ -491,13 +649,10 @@ TSharedPtr<const FMixerRemoteUser> FMixerInteractivityModule_InteractiveCpp::Get
 			return *CachedUser;
 		}
 
-		for (std::shared_ptr<interactive_participant> Participant : interactivity_manager::get_singleton_instance()->participants())
+		std::shared_ptr<interactive_participant>* Participant = ParticipantsById.Find(ParticipantId);
+		if (Participant)
 		{
-			check(Participant);
-			if (Participant->mixer_id() == ParticipantId)
-			{
-				return CreateOrUpdateCachedParticipant(Participant);
-			}
+			return CreateOrUpdateCachedParticipant(*Participant);
 		}
 	}
 
@@ -535,6 +690,25 @@ bool FMixerInteractivityModule_InteractiveCpp::CreateGroup(FName GroupName, FNam
 	return CanCreate;
 }
 
+bool FMixerInteractivityModule_InteractiveCpp::CreateGroups(TArrayView<const FMixerGroupSpec> Groups, const FOnGroupBatchComplete& OnComplete)
+{
+	if (Groups.Num() == 0)
+	{
+		return false;
+	}
+
+	// Groups are created locally and synchronously, so the batch is complete as soon as the loop is.
+	// Callers may be waiting on OnComplete, so it fires even when every group was refused.
+	bool bCreatedAll = true;
+	for (const FMixerGroupSpec& Group : Groups)
+	{
+		bCreatedAll &= CreateGroup(Group.Group, Group.Scene);
+	}
+
+	OnComplete.ExecuteIfBound(bCreatedAll, bCreatedAll ? FString() : TEXT("Some groups already existed or named an unknown scene"));
+	return true;
+}
+
 bool FMixerInteractivityModule_InteractiveCpp::GetParticipantsInGroup(FName GroupName, TArray<TSharedPtr<const FMixerRemoteUser>>& OutParticipants)
 {
 	using namespace Microsoft::mixer;
@@ -576,14 +750,10 @@ bool FMixerInteractivityModule_InteractiveCpp::MoveParticipantToGroup(FName Grou
 		}
 		else
 		{
-			for (std::shared_ptr<interactive_participant> PossibleParticipant : interactivity_manager::get_singleton_instance()->participants())
+			std::shared_ptr<interactive_participant>* IndexedParticipant = ParticipantsById.Find(ParticipantId);
+			if (IndexedParticipant)
 			{
-				check(PossibleParticipant);
-				if (PossibleParticipant->mixer_id() == ParticipantId)
-				{
-					Participant = PossibleParticipant;
-					break;
-				}
+				Participant = *IndexedParticipant;
 			}
 		}
 
@@ -597,32 +767,64 @@ bool FMixerInteractivityModule_InteractiveCpp::MoveParticipantToGroup(FName Grou
 	return FoundUser;
 }
 
-void FMixerInteractivityModule_InteractiveCpp::CaptureSparkTransaction(const FString& TransactionId)
+bool FMixerInteractivityModule_InteractiveCpp::MoveParticipantsToGroup(FName GroupName, TArrayView<const uint32> ParticipantIds)
+{
+	// No batch call in the v1 interactivity_manager
+	bool FoundAnyUser = false;
+	for (uint32 ParticipantId : ParticipantIds)
+	{
+		FoundAnyUser |= MoveParticipantToGroup(GroupName, ParticipantId);
+	}
+	return FoundAnyUser;
+}
+
+void FMixerInteractivityModule_InteractiveCpp::SendSparkCapture(const FString& TransactionId)
 {
 	Microsoft::mixer::interactivity_manager::get_singleton_instance()->capture_transaction(*TransactionId);
+
+	// Reported once the next do_work has had a chance to raise an error for it
+	SparkCapturesAwaitingWork.Add(TransactionId);
+}
+
+bool FMixerInteractivityModule_InteractiveCpp::SetBandwidthThrottle(EMixerBandwidthThrottleType ThrottleType, uint32 MaxBytes, uint32 BytesPerSecond)
+{
+	// Not exposed by the v1 interactivity_manager
+	return false;
 }
 
 void FMixerInteractivityModule_InteractiveCpp::TickParticipantCacheMaintenance()
 {
+	// Entries are refreshed by CreateOrUpdateCachedParticipant whenever the SDK raises an event
+	// for that participant, so all that's left here is evicting stale ones.  Walk a snapshot of
+	// the keys a slice at a time so frame cost doesn't scale with audience size.
 	static const FTimespan IntervalForCacheFreshness = FTimespan::FromSeconds(30.0);
+	if (CacheMaintenanceCursor >= CacheMaintenanceQueue.Num())
+	{
+		RemoteParticipantCache.GenerateKeyArray(CacheMaintenanceQueue);
+		CacheMaintenanceCursor = 0;
+	}
+
 	FDateTime TimeNow = FDateTime::Now();
-	for (TMap<uint32, TSharedPtr<FMixerRemoteUserCached>>::TIterator It(RemoteParticipantCache); It; ++It)
+	const int32 EndCursor = FMath::Min(CacheMaintenanceQueue.Num(), CacheMaintenanceCursor + FMath::Max(GMixerParticipantCacheEntriesPerFrame, 1));
+	for (; CacheMaintenanceCursor < EndCursor; ++CacheMaintenanceCursor)
 	{
-		FDateTime MostRecentInteraction = FMath::Max(It.Value()->ConnectedAt, It.Value()->InputAt);
-		if (!It.Value().IsUnique() || TimeNow - MostRecentInteraction < IntervalForCacheFreshness)
-		{
-			It.Value()->UpdateFromSourceParticipant();
-		}
-		else
+		const uint32 ParticipantId = CacheMaintenanceQueue[CacheMaintenanceCursor];
+		TSharedPtr<FMixerRemoteUserCached>* CachedUser = RemoteParticipantCache.Find(ParticipantId);
+		if (CachedUser && CachedUser->IsUnique())
 		{
-			It.RemoveCurrent();
+			FDateTime MostRecentInteraction = FMath::Max((*CachedUser)->ConnectedAt, (*CachedUser)->InputAt);
+			if (TimeNow - MostRecentInteraction >= IntervalForCacheFreshness)
+			{
+				RemoteParticipantCache.Remove(ParticipantId);
+			}
 		}
 	}
 }
 
-TSharedPtr<FMixerRemoteUserCached> FMixerInteractivityModule_InteractiveCpp::CreateOrUpdateCachedParticipant(std::shared_ptr<Microsoft::mixer::interactive_participant> Participant)
+TSharedPtr<FMixerRemoteUserCached> FMixerInteractivityModule_InteractiveCpp::CreateOrUpdateCachedParticipant(const std::shared_ptr<Microsoft::mixer::interactive_participant>& Participant)
 {
 	check(Participant);
+	ParticipantsById.FindOrAdd(Participant->mixer_id()) = Participant;
 	TSharedPtr<FMixerRemoteUserCached>& NewUser = RemoteParticipantCache.Add(Participant->mixer_id());
 	if (!NewUser.IsValid())
 	{
@@ -642,6 +844,12 @@ void FMixerInteractivityModule_InteractiveCpp::CallRemoteMethod(const FString& M
 	//Microsoft::mixer::interactivity_manager::get_singleton_instance()->send_rpc_message(*MethodName, *SerializedParams);
 }
 
+void FMixerInteractivityModule_InteractiveCpp::CallRemoteMethodSerialized(const FString& MethodName, TArrayView<const uint8> Utf8Params)
+{
+	// As above, there's nothing to send it with, so at least say so rather than dropping it silently
+	UE_LOG(LogMixerInteractivity, Warning, TEXT("Custom method %s was not sent: the interactive-cpp backend cannot call custom methods."), *MethodName);
+}
+
 FMixerRemoteUserCached::FMixerRemoteUserCached(std::shared_ptr<Microsoft::mixer::interactive_participant> InParticipant)
 	: SourceParticipant(InParticipant)
 {
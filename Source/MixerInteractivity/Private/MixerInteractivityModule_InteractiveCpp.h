@@ -40,26 +40,73 @@ private:
 class FMixerInteractivityModule_InteractiveCpp : public FMixerInteractivityModule
 {
 public:
+	FMixerInteractivityModule_InteractiveCpp();
+
 	virtual void StartInteractivity();
 	virtual void StopInteractivity();
 	virtual void SetCurrentScene(FName Scene, FName GroupName = NAME_None);
+	virtual bool SetScenesForGroups(TArrayView<const FMixerGroupSpec> Assignments, const FOnGroupBatchComplete& OnComplete = FOnGroupBatchComplete());
 	virtual FName GetCurrentScene(FName GroupName = NAME_None);
 	virtual void TriggerButtonCooldown(FName Button, FTimespan CooldownTime);
 	virtual bool GetButtonDescription(FName Button, FMixerButtonDescription& OutDesc);
 	virtual bool GetButtonState(FName Button, FMixerButtonState& OutState);
 	virtual bool GetButtonState(FName Button, uint32 ParticipantId, FMixerButtonState& OutState);
+	virtual bool GetButtonState(FName Button, FName GroupName, FMixerButtonState& OutState) { return false; }
 	virtual bool GetStickDescription(FName Stick, FMixerStickDescription& OutDesc);
 	virtual bool GetStickState(FName Stick, FMixerStickState& OutState);
 	virtual bool GetStickState(FName Stick, uint32 ParticipantId, FMixerStickState& OutState);
+	// Controls are owned by the SDK here, so there's nothing stable to hand out handles to.
+	virtual bool ResolveButton(FName Button, FMixerControlHandle& InOutHandle) { return false; }
+	virtual bool ResolveStick(FName Stick, FMixerControlHandle& InOutHandle) { return false; }
+	virtual void TriggerButtonCooldown(FMixerControlHandle Button, FTimespan CooldownTime) {}
+	virtual bool GetButtonDescription(FMixerControlHandle Button, FMixerButtonDescription& OutDesc) { return false; }
+	virtual bool GetButtonState(FMixerControlHandle Button, FMixerButtonState& OutState) { return false; }
+	virtual bool GetButtonState(FMixerControlHandle Button, uint32 ParticipantId, FMixerButtonState& OutState) { return false; }
+	virtual bool GetButtonState(FMixerControlHandle Button, FName GroupName, FMixerButtonState& OutState) { return false; }
+	virtual bool GetStickState(FMixerControlHandle Stick, FMixerStickState& OutState) { return false; }
+	virtual bool GetStickState(FMixerControlHandle Stick, uint32 ParticipantId, FMixerStickState& OutState) { return false; }
+	virtual void SetControlsEnabled(TArrayView<const FMixerControlHandle> Buttons, bool bEnabled) {}
+	virtual void TriggerCooldownForScene(FName Scene, FTimespan CooldownTime);
+	virtual void SetProgressForControls(TArrayView<const TPair<FMixerControlHandle, float>> Progress) {}
+	virtual bool GetStickAggregate(FName Stick, FMixerStickAggregate& OutAggregate) { return false; }
+	virtual bool GetStickAggregate(FMixerControlHandle Stick, FMixerStickAggregate& OutAggregate) { return false; }
+	virtual bool GetStickAggregate(FName Stick, FName GroupName, FMixerStickAggregate& OutAggregate) { return false; }
+	virtual bool GetStickAggregate(FMixerControlHandle Stick, FName GroupName, FMixerStickAggregate& OutAggregate) { return false; }
+	virtual bool EnableCoordinateHeatmap(FName ControlId, const FMixerCoordinateHeatmapSettings& Settings) { return false; }
+	virtual void DisableCoordinateHeatmap(FName ControlId) {}
+	virtual bool GetCoordinateHeatmap(FName ControlId, TArrayView<const float>& OutCells, int32& OutWidth, int32& OutHeight) { return false; }
+	virtual bool EnableInputSketches(FName ControlId, const FMixerInputSketchSettings& Settings) { return false; }
+	virtual void DisableInputSketches(FName ControlId) {}
+	virtual bool GetMostActiveParticipants(FName ControlId, int32 MaxCount, TArray<FMixerActiveParticipant>& OutParticipants) { return false; }
+	virtual bool GetDistinctParticipantCount(FName ControlId, int32& OutCount) { return false; }
+	virtual bool EnableActivityTimeSeries(FName ControlId, const FMixerActivitySeriesSettings& Settings) { return false; }
+	virtual void DisableActivityTimeSeries(FName ControlId) {}
+	virtual bool GetActivityTimeSeries(FName ControlId, TArrayView<const float>& OutSamples, float& OutBucketSeconds) { return false; }
+	virtual int32 StartVoteRound(const FMixerVoteRoundSettings& Settings) { return INDEX_NONE; }
+	virtual bool CloseVoteRound(int32 RoundId, FMixerVoteRoundResult& OutResult) { return false; }
+	virtual bool GetVoteTallies(int32 RoundId, TArrayView<const int32>& OutTallies) { return false; }
 	virtual void SetLabelText(FName Label, const FText& DisplayText);
 	virtual bool GetLabelDescription(FName Label, FMixerLabelDescription& OutDesc);
 	virtual bool GetTextboxDescription(FName Textbox, FMixerTextboxDescription& OutDesc);
 	virtual TSharedPtr<const FMixerRemoteUser> GetParticipant(uint32 ParticipantId);
 	virtual bool CreateGroup(FName GroupName, FName InitialScene = NAME_None);
+	// The v1 SDK sends group changes itself, one at a time, so these just apply each entry in turn.
+	virtual bool CreateGroups(TArrayView<const FMixerGroupSpec> Groups, const FOnGroupBatchComplete& OnComplete = FOnGroupBatchComplete());
 	virtual bool GetParticipantsInGroup(FName GroupName, TArray<TSharedPtr<const FMixerRemoteUser>>& OutParticipants);
+	// Group membership lives in the SDK here, so there's no cached roster to view.
+	virtual TArrayView<const TSharedPtr<const FMixerRemoteUser>> ViewParticipantsInGroup(FName GroupName) { return TArrayView<const TSharedPtr<const FMixerRemoteUser>>(); }
+	virtual int32 GetParticipantsPage(FName GroupName, EMixerParticipantSortKey SortKey, int32 Offset, int32 Count, TArray<TSharedPtr<const FMixerRemoteUser>>& OutParticipants, bool bDescending) { return 0; }
+	// Control state lives in the v1 interactivity_manager, which has no safe way to copy it out for other threads.
+	virtual bool ReadSessionSnapshot(TFunctionRef<void(const FMixerSessionSnapshot&)> Reader) { return false; }
+	virtual FMixerInputJournalCursor OpenInputJournalCursor(float RewindSeconds) { return FMixerInputJournalCursor(); }
+	virtual int32 ReadInputJournal(FMixerInputJournalCursor& Cursor, TArray<FMixerInputEvent>& OutEvents, int32 MaxEvents) { return 0; }
+	virtual bool GetInputSamplingState(FMixerInputSamplingState& OutState) { return false; }
 	virtual bool MoveParticipantToGroup(FName GroupName, uint32 ParticipantId);
-	virtual void CaptureSparkTransaction(const FString& TransactionId);
+	virtual bool MoveParticipantsToGroup(FName GroupName, TArrayView<const uint32> ParticipantIds);
+	virtual bool SetBandwidthThrottle(EMixerBandwidthThrottleType ThrottleType, uint32 MaxBytes, uint32 BytesPerSecond);
 	virtual void CallRemoteMethod(const FString& MethodName, const TSharedRef<FJsonObject> MethodParams);
+	virtual void CallRemoteMethodSerialized(const FString& MethodName, TArrayView<const uint8> Utf8Params);
+	virtual bool CallRemoteMethodAsync(const FString& MethodName, const TSharedRef<FJsonObject> MethodParams, const FOnRemoteMethodReply& OnReply) { return false; }
 
 public:
 	virtual bool Tick(float DeltaTime) override;
@@ -67,16 +114,44 @@ public:
 protected:
 	virtual bool StartInteractiveConnection();
 	virtual void StopInteractiveConnection();
+	virtual void SendSparkCapture(const FString& TransactionId);
 
 private:
 	std::shared_ptr<Microsoft::mixer::interactive_button_control> FindButton(FName Name);
 	std::shared_ptr<Microsoft::mixer::interactive_joystick_control> FindStick(FName Name);
-	TSharedPtr<FMixerRemoteUserCached> CreateOrUpdateCachedParticipant(std::shared_ptr<Microsoft::mixer::interactive_participant> Participant);
+	void RebuildControlIndex();
+	void ResetControlIndex();
+	void RebuildParticipantIndex();
+	FName FindControlName(const TCHAR* ControlId);
+	TSharedPtr<FMixerRemoteUserCached> CreateOrUpdateCachedParticipant(const std::shared_ptr<Microsoft::mixer::interactive_participant>& Participant);
 
 	void TickParticipantCacheMaintenance();
 
 private:
 	TMap<uint32, TSharedPtr<FMixerRemoteUserCached>> RemoteParticipantCache;
+
+	/** Controls from every scene, indexed when interactivity is enabled so polling state is a single lookup. */
+	TMap<FName, std::shared_ptr<Microsoft::mixer::interactive_button_control>> ButtonsByName;
+	TMap<FName, std::shared_ptr<Microsoft::mixer::interactive_joystick_control>> SticksByName;
+
+	struct FCachedControlName
+	{
+		FString ControlId;
+		FName Name;
+	};
+
+	/** Control id strings seen this session, keyed by FCrc::StrCrc32, so event conversion doesn't hit the FName table. */
+	TMap<uint32, FCachedControlName> ControlNamesByHash;
+
+	/** Every participant the SDK has told us about, so cache misses don't have to scan interactivity_manager::participants(). */
+	TMap<uint32, std::shared_ptr<Microsoft::mixer::interactive_participant>> ParticipantsById;
+
+	/** Snapshot of cache keys being visited round-robin by TickParticipantCacheMaintenance. */
+	TArray<uint32> CacheMaintenanceQueue;
+	int32 CacheMaintenanceCursor;
+
+	/** Transactions passed to capture_transaction since the last do_work, which decides their outcome. */
+	TArray<FString> SparkCapturesAwaitingWork;
 };
 
 #endif // MIXER_BACKEND_INTERACTIVE_CPP
\ No newline at end of file
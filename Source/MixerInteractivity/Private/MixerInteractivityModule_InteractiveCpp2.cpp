@@ -11,42 +11,152 @@
 
 #if MIXER_BACKEND_INTERACTIVE_CPP_2
 
+#include "MixerInteractivityBlueprintLibrary.h"
 #include "MixerInteractivitySettings.h"
 #include "MixerInteractivityUserSettings.h"
 #include "MixerInteractivityLog.h"
+#include "MixerInteractivityStats.h"
+#include "MixerInteractivityLLM.h"
 #include "MixerJsonHelpers.h"
+#include "MixerFrameScheduler.h"
 #include "Containers/StringConv.h"
-#include "Async/Async.h"
+#include "Serialization/MemoryWriter.h"
+#include "HAL/Runnable.h"
+#include "HAL/RunnableThread.h"
+#include "HAL/ThreadSafeBool.h"
+#include "HttpModule.h"
 
 IMPLEMENT_MODULE(FMixerInteractivityModule_InteractiveCpp2, MixerInteractivity);
 
+DECLARE_CYCLE_STAT(TEXT("Handle session input"), STAT_MixerHandleSessionInput, STATGROUP_MixerInteractivity);
+
 namespace
 {
-	bool GetControlPropertyHelper(interactive_session Session, const char* ControlName, const char *PropertyName, FString& Result)
+	// Events handed to us per interactive_run call while pumping.  Small so that the time budget is honored closely.
+	const uint32 EventsPerPumpStep = 4;
+
+	// The worker isn't bound by a frame budget, so it can take larger bites.  It naps when the SDK has nothing queued.
+	const uint32 EventsPerWorkerStep = 32;
+	const float WorkerIdleSleepSeconds = 0.002f;
+
+	// Consecutive frames of overload before halving the input rate, and of health before doubling it again
+	const int32 AdaptiveThrottleTightenFrames = 30;
+	const int32 AdaptiveThrottleRelaxFrames = 300;
+
+	// How long CallRemoteMethodAsync waits for a reply before failing the call
+	const double RemoteMethodReplyTimeout = 30.0;
+
+	interactive_throttle_type ToSdkThrottleType(EMixerBandwidthThrottleType ThrottleType)
 	{
-		size_t RequiredSize = 0;
-		TArray<char> Utf8String;
-		if (interactive_control_get_property_string(Session, ControlName, PropertyName, nullptr, &RequiredSize) != MIXER_ERROR_BUFFER_SIZE)
+		switch (ThrottleType)
 		{
-			return false;
+		case EMixerBandwidthThrottleType::Input:				return throttle_input;
+		case EMixerBandwidthThrottleType::Participant_Join:		return throttle_participant_join;
+		case EMixerBandwidthThrottleType::Participant_Leave:	return throttle_participant_leave;
+		default:												return throttle_global;
+		}
+	}
+}
+
+class FMixerInteractivityModule_InteractiveCpp2::FSessionWorker : public FRunnable
+{
+public:
+	FSessionWorker(interactive_session InSession)
+		: Session(InSession)
+	{
+	}
+
+	virtual uint32 Run() override
+	{
+		// The SDK's json documents are built and freed inside interactive_run
+		MIXER_LLM_SCOPE(InteractiveSdk);
+
+		while (!bStopRequested)
+		{
+			interactive_run(Session, EventsPerWorkerStep);
+
+			unsigned int PendingEvents = 0;
+			interactive_get_pending_event_count(Session, &PendingEvents);
+			if (PendingEvents == 0)
+			{
+				FPlatformProcess::Sleep(WorkerIdleSleepSeconds);
+			}
+		}
+		return 0;
+	}
+
+	virtual void Stop() override
+	{
+		bStopRequested = true;
+	}
+
+private:
+	interactive_session Session;
+	FThreadSafeBool bStopRequested;
+};
+
+FMixerInteractivityModule_InteractiveCpp2::FMixerInteractivityModule_InteractiveCpp2()
+	: InteractiveSession(nullptr)
+	, InputThrottleCapacity(0)
+	, InputThrottleCeiling(0)
+	, InputThrottleCurrent(0)
+	, OverloadedFrames(0)
+	, HealthyFrames(0)
+	, EventBacklog(0)
+	, bStagingSessionEvents(false)
+	, SessionWorker(nullptr)
+	, SessionWorkerThread(nullptr)
+	, bQueueSessionEvents(false)
+	, HostsCache(MakeShared<FMixerInteractiveHostsCache>())
+	, OpeningSession(nullptr)
+	, OpenStartTime(0.0)
+	, HostLookupMs(0.0)
+	, ScenesByGroupChangeCount(INDEX_NONE)
+	, EnumeratingScene(nullptr)
+	, NextGroupBatchId(0)
+	, NextRemoteMethodCallId(0)
+#if MIXER_TRAFFIC_RECORDER_ENABLED
+	, bSdkTrafficCaptureActive(false)
+#endif
+{
+}
+
+namespace
+{
+	const interactive_control_property* FindControlProperty(const interactive_control_property* Properties, size_t PropertyCount, const char* PropertyName, interactive_property_type Type)
+	{
+		const size_t NameLength = FCStringAnsi::Strlen(PropertyName);
+		for (size_t i = 0; i < PropertyCount; ++i)
+		{
+			const interactive_control_property& Property = Properties[i];
+			if (Property.type == Type && Property.nameLength == NameLength && FCStringAnsi::Strncmp(Property.name, PropertyName, NameLength) == 0)
+			{
+				return &Property;
+			}
 		}
+		return nullptr;
+	}
 
-		Utf8String.AddUninitialized(RequiredSize);
-		if (interactive_control_get_property_string(Session, ControlName, PropertyName, Utf8String.GetData(), &RequiredSize) != MIXER_OK)
+	bool GetControlPropertyHelper(const interactive_control_property* Properties, size_t PropertyCount, const char *PropertyName, FString& Result)
+	{
+		const interactive_control_property* Property = FindControlProperty(Properties, PropertyCount, PropertyName, interactive_string_t);
+		if (Property == nullptr)
 		{
 			return false;
 		}
 
-		Result = UTF8_TO_TCHAR(Utf8String.GetData());
+		// Views into the SDK's scene document aren't null terminated, so convert with an explicit length
+		FUTF8ToTCHAR Converted(Property->stringValue, static_cast<int32>(Property->stringValueLength));
+		Result = FString(Converted.Length(), Converted.Get());
 		return true;
 	}
 
-	bool GetControlPropertyHelper(interactive_session Session, const char* ControlName, const char *PropertyName, FText& Result)
+	bool GetControlPropertyHelper(const interactive_control_property* Properties, size_t PropertyCount, const char *PropertyName, FMixerLazyText& Result)
 	{
 		FString IntermediateResult;
-		if (GetControlPropertyHelper(Session, ControlName, PropertyName, IntermediateResult))
+		if (GetControlPropertyHelper(Properties, PropertyCount, PropertyName, IntermediateResult))
 		{
-			Result = FText::FromString(IntermediateResult);
+			Result = FMixerLazyText(MoveTemp(IntermediateResult));
 			return true;
 		}
 		else
@@ -55,30 +165,54 @@ namespace
 		}
 	}
 
-	bool GetControlPropertyHelper(interactive_session Session, const char* ControlName, const char *PropertyName, float& Result)
+	bool GetControlPropertyHelper(const interactive_control_property* Properties, size_t PropertyCount, const char *PropertyName, float& Result)
 	{
-		return interactive_control_get_property_float(Session, ControlName, PropertyName, &Result) == MIXER_OK;
+		if (const interactive_control_property* Property = FindControlProperty(Properties, PropertyCount, PropertyName, interactive_float_t))
+		{
+			Result = Property->floatValue;
+			return true;
+		}
+		else if (const interactive_control_property* IntProperty = FindControlProperty(Properties, PropertyCount, PropertyName, interactive_int_t))
+		{
+			Result = static_cast<float>(IntProperty->intValue);
+			return true;
+		}
+		return false;
 	}
 
-	bool GetControlPropertyHelper(interactive_session Session, const char* ControlName, const char *PropertyName, bool& Result)
+	bool GetControlPropertyHelper(const interactive_control_property* Properties, size_t PropertyCount, const char *PropertyName, bool& Result)
 	{
-		return interactive_control_get_property_bool(Session, ControlName, PropertyName, &Result) == MIXER_OK;
+		const interactive_control_property* Property = FindControlProperty(Properties, PropertyCount, PropertyName, interactive_bool_t);
+		if (Property == nullptr)
+		{
+			return false;
+		}
+
+		Result = Property->boolValue;
+		return true;
 	}
 
-	bool GetControlPropertyHelper(interactive_session Session, const char* ControlName, const char *PropertyName, int64& Result)
+	bool GetControlPropertyHelper(const interactive_control_property* Properties, size_t PropertyCount, const char *PropertyName, int64& Result)
 	{
-		return interactive_control_get_property_int64(Session, ControlName, PropertyName, &Result) == MIXER_OK;
+		const interactive_control_property* Property = FindControlProperty(Properties, PropertyCount, PropertyName, interactive_int_t);
+		if (Property == nullptr)
+		{
+			return false;
+		}
+
+		Result = Property->intValue;
+		return true;
 	}
 
-	bool GetControlPropertyHelper(interactive_session Session, const char* ControlName, const char *PropertyName, uint32& Result)
+	bool GetControlPropertyHelper(const interactive_control_property* Properties, size_t PropertyCount, const char *PropertyName, uint32& Result)
 	{
-		int SignedResult;
-		if (interactive_control_get_property_int(Session, ControlName, PropertyName, &SignedResult) != MIXER_OK)
+		const interactive_control_property* Property = FindControlProperty(Properties, PropertyCount, PropertyName, interactive_int_t);
+		if (Property == nullptr)
 		{
 			return false;
 		}
 
-		Result = static_cast<uint32>(SignedResult);
+		Result = static_cast<uint32>(Property->intValue);
 		return true;
 	}
 }
@@ -96,6 +230,9 @@ void FMixerInteractivityModule_InteractiveCpp2::StartInteractivity()
 
 void FMixerInteractivityModule_InteractiveCpp2::StopInteractivity()
 {
+	// A scene change can't be committed into a session that's going away
+	DiscardStagedSceneChange();
+
 	if (InteractiveSession != nullptr)
 	{
 		if (interactive_set_ready(InteractiveSession, false) == MIXER_OK)
@@ -112,22 +249,54 @@ void FMixerInteractivityModule_InteractiveCpp2::SetCurrentScene(FName Scene, FNa
 		// Special case - 'default' is used all over the place as a name, but with 'D'
 		const ANSICHAR* ActualGroupName = GroupName != NAME_None && GroupName != NAME_DefaultMixerParticipantGroup ? GroupName.GetPlainANSIString() : "default";
 		const ANSICHAR* ActualSceneName = Scene != NAME_None && Scene != NAME_DefaultMixerParticipantGroup ? Scene.GetPlainANSIString() : "default";
-		interactive_group_set_scene(InteractiveSession, ActualGroupName, ActualSceneName);
+		if (interactive_group_set_scene(InteractiveSession, ActualGroupName, ActualSceneName) == MIXER_OK)
+		{
+			// As the UE backend does, reflect our own change straight away rather than waiting for onGroupUpdate
+			RefreshScenesByGroup();
+			ScenesByGroup.Add(GroupName != NAME_None ? GroupName : NAME_DefaultMixerParticipantGroup, Scene != NAME_None ? Scene : NAME_DefaultMixerParticipantGroup);
+			InputFilter.Invalidate();
+		}
 	}
 }
 
+bool FMixerInteractivityModule_InteractiveCpp2::SetScenesForGroups(TArrayView<const FMixerGroupSpec> Assignments, const FOnGroupBatchComplete& OnComplete)
+{
+	return SendGroupBatch(&interactive_set_groups_scenes, Assignments, OnComplete);
+}
+
 FName FMixerInteractivityModule_InteractiveCpp2::GetCurrentScene(FName GroupName)
 {
-	FGetCurrentSceneEnumContext Context;
-	Context.GroupName = GroupName != NAME_None ? GroupName : NAME_DefaultMixerParticipantGroup;
-	Context.OutSceneName = NAME_None;
-	if (InteractiveSession != nullptr)
+	if (InteractiveSession == nullptr)
+	{
+		return NAME_None;
+	}
+
+	RefreshScenesByGroup();
+	const FName* Scene = ScenesByGroup.Find(GroupName != NAME_None ? GroupName : NAME_DefaultMixerParticipantGroup);
+	return Scene != nullptr ? *Scene : NAME_None;
+}
+
+void FMixerInteractivityModule_InteractiveCpp2::RefreshScenesByGroup()
+{
+	// Only walk the SDK's groups (under its scene lock) when they have changed since we last looked
+	const int32 ChangeCount = GroupsChangedCount.GetValue();
+	if (ChangeCount == ScenesByGroupChangeCount || InteractiveSession == nullptr)
+	{
+		return;
+	}
+
+	ScenesByGroupChangeCount = ChangeCount;
+	ScenesByGroup.Reset();
+	interactive_get_groups(InteractiveSession, &FMixerInteractivityModule_InteractiveCpp2::OnEnumerateForScenesByGroup);
+}
+
+void FMixerInteractivityModule_InteractiveCpp2::GetActiveScenes(TSet<FName>& OutScenes)
+{
+	RefreshScenesByGroup();
+	for (const TPair<FName, FName>& GroupScene : ScenesByGroup)
 	{
-		interactive_set_session_context(InteractiveSession, &Context);
-		interactive_get_groups(InteractiveSession, &FMixerInteractivityModule_InteractiveCpp2::OnEnumerateForGetCurrentScene);
-		interactive_set_session_context(InteractiveSession, nullptr);
+		OutScenes.Add(GroupScene.Value);
 	}
-	return Context.OutSceneName;
 }
 
 void FMixerInteractivityModule_InteractiveCpp2::TriggerButtonCooldown(FName Button, FTimespan CooldownTime)
@@ -153,460 +322,1628 @@ bool FMixerInteractivityModule_InteractiveCpp2::CreateGroup(FName GroupName, FNa
 
 	// Special case - 'default' is used all over the place as a name, but with 'D'
 	const ANSICHAR* ActualSceneName = InitialScene != NAME_None && InitialScene != NAME_DefaultMixerParticipantGroup ? InitialScene.GetPlainANSIString() : "default";
-	return interactive_create_group(InteractiveSession, GroupName.GetPlainANSIString(), ActualSceneName) == MIXER_OK;
+	if (interactive_create_group(InteractiveSession, GroupName.GetPlainANSIString(), ActualSceneName) != MIXER_OK)
+	{
+		return false;
+	}
+
+	RefreshScenesByGroup();
+	ScenesByGroup.Add(GroupName, InitialScene != NAME_None ? InitialScene : NAME_DefaultMixerParticipantGroup);
+	InputFilter.Invalidate();
+	return true;
 }
 
-bool FMixerInteractivityModule_InteractiveCpp2::MoveParticipantToGroup(FName GroupName, uint32 ParticipantId)
+bool FMixerInteractivityModule_InteractiveCpp2::CreateGroups(TArrayView<const FMixerGroupSpec> Groups, const FOnGroupBatchComplete& OnComplete)
 {
-	if (InteractiveSession == nullptr)
+	// Default group is created automatically, don't send this to the service.
+	TArray<FMixerGroupSpec, TInlineAllocator<16>> NewGroups;
+	for (const FMixerGroupSpec& Group : Groups)
+	{
+		if (Group.Group != NAME_None && Group.Group != NAME_DefaultMixerParticipantGroup)
+		{
+			NewGroups.Add(Group);
+		}
+	}
+
+	return SendGroupBatch(&interactive_create_groups, NewGroups, OnComplete);
+}
+
+bool FMixerInteractivityModule_InteractiveCpp2::SendGroupBatch(FSdkGroupBatchFunction SdkFunction, TArrayView<const FMixerGroupSpec> Groups, const FOnGroupBatchComplete& OnComplete)
+{
+	if (InteractiveSession == nullptr || Groups.Num() == 0)
 	{
 		return false;
 	}
 
-	TSharedPtr<FMixerRemoteUser> Participant = GetCachedUser(ParticipantId);
-	if (!Participant.IsValid())
+	// Special case - 'default' is used all over the place as a name, but with 'D'
+	TArray<interactive_group_scene, TInlineAllocator<16>> SdkGroups;
+	SdkGroups.Reserve(Groups.Num());
+	for (const FMixerGroupSpec& Group : Groups)
+	{
+		interactive_group_scene& SdkGroup = SdkGroups[SdkGroups.AddUninitialized()];
+		SdkGroup.groupId = Group.Group != NAME_None && Group.Group != NAME_DefaultMixerParticipantGroup ? Group.Group.GetPlainANSIString() : "default";
+		SdkGroup.sceneId = Group.Scene != NAME_None && Group.Scene != NAME_DefaultMixerParticipantGroup ? Group.Scene.GetPlainANSIString() : "default";
+	}
+
+	const uint32 BatchId = NextGroupBatchId++;
+	if (SdkFunction(InteractiveSession, SdkGroups.GetData(), SdkGroups.Num(), BatchId, OnComplete.IsBound() ? &FMixerInteractivityModule_InteractiveCpp2::OnGroupBatchComplete : nullptr) != MIXER_OK)
 	{
 		return false;
 	}
 
-	return interactive_set_participant_group(
-		InteractiveSession,
-		TCHAR_TO_UTF8(*Participant->SessionGuid.ToString(EGuidFormats::DigitsWithHyphens).ToLower()),
-		GroupName.GetPlainANSIString()) == MIXER_OK;
+	if (OnComplete.IsBound())
+	{
+		// The reply is only ever dispatched from the game thread, so there's no race with this
+		GroupBatchesInFlight.Add(BatchId, OnComplete);
+	}
+
+	// As for a single group, reflect our own change straight away rather than waiting for onGroupUpdate
+	RefreshScenesByGroup();
+	for (const FMixerGroupSpec& Group : Groups)
+	{
+		ScenesByGroup.Add(Group.Group != NAME_None ? Group.Group : NAME_DefaultMixerParticipantGroup, Group.Scene != NAME_None ? Group.Scene : NAME_DefaultMixerParticipantGroup);
+	}
+	InputFilter.Invalidate();
+	return true;
 }
 
-void FMixerInteractivityModule_InteractiveCpp2::CaptureSparkTransaction(const FString& TransactionId)
+void FMixerInteractivityModule_InteractiveCpp2::AbandonGroupBatches()
 {
-	if (InteractiveSession != nullptr)
+	// Callers may issue new requests from the callback, so detach the map first
+	TMap<uint32, FOnGroupBatchComplete> Abandoned = MoveTemp(GroupBatchesInFlight);
+	GroupBatchesInFlight.Reset();
+	for (const TPair<uint32, FOnGroupBatchComplete>& Pair : Abandoned)
 	{
-		interactive_capture_transaction(InteractiveSession, TCHAR_TO_UTF8(*TransactionId));
+		Pair.Value.ExecuteIfBound(false, TEXT("Interactive session ended"));
 	}
 }
 
-void FMixerInteractivityModule_InteractiveCpp2::CallRemoteMethod(const FString& MethodName, const TSharedRef<FJsonObject> MethodParams)
+bool FMixerInteractivityModule_InteractiveCpp2::MoveParticipantToGroup(FName GroupName, uint32 ParticipantId)
 {
-	if (InteractiveSession != nullptr)
+	if (InteractiveSession == nullptr)
 	{
-		FString SerializedParams;
-		TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&SerializedParams, 0);
-		FJsonSerializer::Serialize(MethodParams, Writer);
+		return false;
+	}
 
-		uint32 MessageId = 0;
-		interactive_send_method(InteractiveSession, TCHAR_TO_UTF8(*MethodName), TCHAR_TO_UTF8(*SerializedParams), true, &MessageId);
+	TSharedPtr<FMixerRemoteUser> Participant = GetCachedUser(ParticipantId);
+	if (!Participant.IsValid())
+	{
+		return false;
 	}
+
+	return interactive_set_participant_group(
+		InteractiveSession,
+		TCHAR_TO_UTF8(*Participant->SessionGuid.ToString(EGuidFormats::DigitsWithHyphens).ToLower()),
+		GroupName.GetPlainANSIString()) == MIXER_OK;
 }
 
-bool FMixerInteractivityModule_InteractiveCpp2::StartInteractiveConnection()
+bool FMixerInteractivityModule_InteractiveCpp2::MoveParticipantsToGroup(FName GroupName, TArrayView<const uint32> ParticipantIds)
 {
-	if (GetInteractiveConnectionAuthState() != EMixerLoginState::Not_Logged_In)
+	if (InteractiveSession == nullptr)
 	{
-		UE_LOG(LogMixerInteractivity, Warning, TEXT("StartInteractiveConnection failed - plugin state %d."),
-			static_cast<int32>(GetInteractiveConnectionAuthState()));
 		return false;
 	}
 
-	SetInteractiveConnectionAuthState(EMixerLoginState::Logging_In);
+	// Session ids are lowercase, hyphenated GUIDs - 36 ASCII characters plus terminator
+	static const int32 SessionIdLength = 37;
 
-	ConnectOperation = Async<interactive_session>(EAsyncExecution::ThreadPool,
-		[]() -> interactive_session
+	TArray<ANSICHAR> SessionIdBuffer;
+	TArray<const ANSICHAR*> SessionIds;
+	SessionIdBuffer.SetNumUninitialized(ParticipantIds.Num() * SessionIdLength);
+	SessionIds.Reserve(ParticipantIds.Num());
+	for (uint32 ParticipantId : ParticipantIds)
 	{
-		const UMixerInteractivitySettings* Settings = GetDefault<UMixerInteractivitySettings>();
-		const UMixerInteractivityUserSettings* UserSettings = GetDefault<UMixerInteractivityUserSettings>();
-
-		interactive_session Session;
-		int32 ConnectResult = interactive_open_session(
-			TCHAR_TO_UTF8(*UserSettings->GetAuthZHeaderValue()),
-			TCHAR_TO_UTF8(*FString::FromInt(Settings->GameVersionId)),
-			TCHAR_TO_UTF8(*Settings->ShareCode),
-			false,
-			&Session);
-		if (ConnectResult == MIXER_OK)
+		TSharedPtr<FMixerRemoteUser> Participant = GetCachedUser(ParticipantId);
+		if (Participant.IsValid())
 		{
-			return Session;
+			const FString SessionId = Participant->SessionGuid.ToString(EGuidFormats::DigitsWithHyphens).ToLower();
+			ANSICHAR* Dest = &SessionIdBuffer[SessionIds.Num() * SessionIdLength];
+			FCStringAnsi::Strncpy(Dest, TCHAR_TO_ANSI(*SessionId), SessionIdLength);
+			SessionIds.Add(Dest);
 		}
-		else
+	}
+
+	if (SessionIds.Num() == 0)
+	{
+		return false;
+	}
+
+	// Keep each updateParticipants within the configured frame size.  Per entry: both ids, both keys, punctuation.
+	const ANSICHAR* GroupId = GroupName.GetPlainANSIString();
+	const int32 EntrySize = SessionIdLength + FCStringAnsi::Strlen(GroupId) + 32;
+	const int32 MaxPerBatch = FMath::Max(1, (GetDefault<UMixerInteractivitySettings>()->MaxOutboundFrameSize - 128) / EntrySize);
+	bool bAllSent = true;
+	for (int32 Start = 0; Start < SessionIds.Num(); Start += MaxPerBatch)
+	{
+		const int32 Count = FMath::Min(MaxPerBatch, SessionIds.Num() - Start);
+		int32 Result = interactive_set_participants_group(InteractiveSession, SessionIds.GetData() + Start, Count, GroupId);
+		if (Result != MIXER_OK)
 		{
-			return nullptr;
+			UE_LOG(LogMixerInteractivity, Warning, TEXT("Failed to move %d participant(s) to group %s (error %d)."), Count, *GroupName.ToString(), Result);
+			bAllSent = false;
 		}
-	});
+	}
 
-	return true;
+	return bAllSent;
 }
 
-void FMixerInteractivityModule_InteractiveCpp2::StopInteractiveConnection()
+void FMixerInteractivityModule_InteractiveCpp2::SendSparkCapture(const FString& TransactionId)
 {
-	if (GetInteractiveConnectionAuthState() != EMixerLoginState::Not_Logged_In)
+	int32 Result = interactive_capture_transaction(InteractiveSession, TCHAR_TO_UTF8(*TransactionId));
+	if (Result != MIXER_OK)
 	{
-		SetInteractiveConnectionAuthState(EMixerLoginState::Not_Logged_In);
-		interactive_close_session(InteractiveSession);
-		EndSession();
-		InteractiveSession = nullptr;
+		CompleteSparkCapture(TransactionId, false, FString::Printf(TEXT("Failed to queue capture (error %d)"), Result));
 	}
 }
 
-bool FMixerInteractivityModule_InteractiveCpp2::Tick(float DeltaTime)
+bool FMixerInteractivityModule_InteractiveCpp2::SetBandwidthThrottle(EMixerBandwidthThrottleType ThrottleType, uint32 MaxBytes, uint32 BytesPerSecond)
 {
-	FMixerInteractivityModule_WithSessionState::Tick(DeltaTime);
-
-	if (InteractiveSession != nullptr)
+	if (InteractiveSession == nullptr)
 	{
-		interactive_run(InteractiveSession, 10);
+		return false;
 	}
-	else if (ConnectOperation.IsReady())
-	{
-		InteractiveSession = ConnectOperation.Get();
-		ConnectOperation = TFuture<interactive_session>();
-
-		if (InteractiveSession != nullptr)
-		{
-			const UMixerInteractivitySettings* Settings = GetDefault<UMixerInteractivitySettings>();
-
-			StartSession(Settings->bPerParticipantStateCaching);
-
-			interactive_register_error_handler(InteractiveSession, &FMixerInteractivityModule_InteractiveCpp2::OnSessionError);
-			interactive_register_state_changed_handler(InteractiveSession, &FMixerInteractivityModule_InteractiveCpp2::OnSessionStateChanged);
-			interactive_register_input_handler(InteractiveSession, &FMixerInteractivityModule_InteractiveCpp2::OnSessionInput);
-			interactive_register_participants_changed_handler(InteractiveSession, &FMixerInteractivityModule_InteractiveCpp2::OnSessionParticipantsChanged);
-			interactive_register_unhandled_method_handler(InteractiveSession, &FMixerInteractivityModule_InteractiveCpp2::OnUnhandledMethod);
-			interactive_register_transaction_complete_handler(InteractiveSession, &FMixerInteractivityModule_InteractiveCpp2::OnTransactionComplete);
 
-			interactive_get_scenes(InteractiveSession, &FMixerInteractivityModule_InteractiveCpp2::OnEnumerateScenesForInit);
-
-			SetInteractiveConnectionAuthState(EMixerLoginState::Logged_In);
-		}
-		else
-		{
-			SetInteractiveConnectionAuthState(EMixerLoginState::Not_Logged_In);
-		}
+	if (ThrottleType == EMixerBandwidthThrottleType::Input)
+	{
+		// An explicit setting becomes the new ceiling for adaptive control
+		InputThrottleCapacity = MaxBytes;
+		InputThrottleCeiling = BytesPerSecond;
+		InputThrottleCurrent = BytesPerSecond;
 	}
 
-	return true;
+	return interactive_set_bandwidth_throttle(InteractiveSession, ToSdkThrottleType(ThrottleType), MaxBytes, BytesPerSecond) == MIXER_OK;
 }
 
-void FMixerInteractivityModule_InteractiveCpp2::OnSessionStateChanged(void* Context, interactive_session Session, interactive_state PreviousState, interactive_state NewState)
+void FMixerInteractivityModule_InteractiveCpp2::ApplyConfiguredThrottles()
 {
-	FMixerInteractivityModule_InteractiveCpp2& InteractiveModule = static_cast<FMixerInteractivityModule_InteractiveCpp2&>(IMixerInteractivityModule::Get());
-	switch (NewState)
+	const UMixerInteractivitySettings* Settings = GetDefault<UMixerInteractivitySettings>();
+	const struct
 	{
-	case not_ready:
-		InteractiveModule.SetInteractivityState(EMixerInteractivityState::Not_Interactive);
-		break;
-
-	case ready:
-		InteractiveModule.SetInteractivityState(EMixerInteractivityState::Interactive);
-		break;
+		EMixerBandwidthThrottleType Type;
+		const FMixerBandwidthThrottle& Throttle;
+	} Throttles[] =
+	{
+		{ EMixerBandwidthThrottleType::Global, Settings->GlobalThrottle },
+		{ EMixerBandwidthThrottleType::Input, Settings->InputThrottle },
+		{ EMixerBandwidthThrottleType::Participant_Join, Settings->ParticipantJoinThrottle },
+		{ EMixerBandwidthThrottleType::Participant_Leave, Settings->ParticipantLeaveThrottle },
+	};
 
-	case disconnected:
-	default:
-		InteractiveModule.SetInteractivityState(EMixerInteractivityState::Not_Interactive);
-		InteractiveModule.SetInteractiveConnectionAuthState(EMixerLoginState::Not_Logged_In);
-		break;
+	for (const auto& Entry : Throttles)
+	{
+		if (Entry.Throttle.bEnabled)
+		{
+			SetBandwidthThrottle(Entry.Type, Entry.Throttle.Capacity, Entry.Throttle.DrainRate);
+		}
 	}
-}
 
-void FMixerInteractivityModule_InteractiveCpp2::OnSessionError(void* Context, interactive_session Session, int ErrorCode, const char* ErrorMessage, size_t ErrorMessageLength)
-{
-	UE_LOG(LogMixerInteractivity, Error, TEXT("Session error %d: %hs"), ErrorCode, ErrorMessage);
+	if (!Settings->InputThrottle.bEnabled)
+	{
+		// Adaptive control still needs somewhere to start from
+		InputThrottleCapacity = Settings->InputThrottle.Capacity;
+		InputThrottleCeiling = Settings->InputThrottle.DrainRate;
+		InputThrottleCurrent = InputThrottleCeiling;
+	}
+	OverloadedFrames = 0;
+	HealthyFrames = 0;
 }
 
-void FMixerInteractivityModule_InteractiveCpp2::OnSessionInput(void* Context, interactive_session Session, const interactive_input* Input)
+void FMixerInteractivityModule_InteractiveCpp2::UpdateAdaptiveInputThrottle(float DeltaTime)
 {
-	FMixerInteractivityModule_InteractiveCpp2& InteractiveModule = static_cast<FMixerInteractivityModule_InteractiveCpp2&>(IMixerInteractivityModule::Get());
-
-	FGuid ParticipantGuid;
-	if (!FGuid::Parse(Input->participantId, ParticipantGuid))
+	const UMixerInteractivitySettings* Settings = GetDefault<UMixerInteractivitySettings>();
+	if (!Settings->bAdaptiveInputThrottle)
 	{
-		UE_LOG(LogMixerInteractivity, Error, TEXT("Participant id %hs was not in the expected format (guid)"), Input->participantId);
 		return;
 	}
 
-	TSharedPtr<FMixerRemoteUser> ButtonUser = InteractiveModule.GetCachedUser(ParticipantGuid);
-
-	switch (Input->type)
+	const bool bOverloaded = DeltaTime * 1000.0f > Settings->AdaptiveThrottleFrameTimeThreshold || EventBacklog > 0;
+	if (bOverloaded)
 	{
-	case input_type_click:
-		InteractiveModule.OnSessionButtonInput(ButtonUser, Input);
-		break;
+		HealthyFrames = 0;
+		++OverloadedFrames;
+	}
+	else
+	{
+		OverloadedFrames = 0;
+		++HealthyFrames;
+	}
 
-	case input_type_move:
-		InteractiveModule.OnSessionCoordinateInput(ButtonUser, Input);
-		break;
+	uint32 NewRate = InputThrottleCurrent;
+	const uint32 MinRate = static_cast<uint32>(Settings->AdaptiveThrottleMinDrainRate);
+	if (OverloadedFrames >= AdaptiveThrottleTightenFrames && InputThrottleCurrent > MinRate)
+	{
+		NewRate = FMath::Max(MinRate, InputThrottleCurrent / 2);
+		OverloadedFrames = 0;
+	}
+	else if (HealthyFrames >= AdaptiveThrottleRelaxFrames && InputThrottleCurrent < InputThrottleCeiling)
+	{
+		NewRate = FMath::Min(InputThrottleCeiling, InputThrottleCurrent * 2);
+		HealthyFrames = 0;
+	}
 
-	case input_type_custom:
-	default:
-		InteractiveModule.OnSessionCustomInput(ButtonUser, Input);
-		break;
+	if (NewRate != InputThrottleCurrent)
+	{
+		UE_LOG(LogMixerInteractivity, Log, TEXT("Adjusting interactive input throttle from %u to %u bytes/s"), InputThrottleCurrent, NewRate);
+		InputThrottleCurrent = NewRate;
+		interactive_set_bandwidth_throttle(InteractiveSession, throttle_input, InputThrottleCapacity, NewRate);
 	}
 }
 
-void FMixerInteractivityModule_InteractiveCpp2::OnSessionButtonInput(TSharedPtr<const FMixerRemoteUser> User, const interactive_input* Input)
+void FMixerInteractivityModule_InteractiveCpp2::PumpEvents()
 {
-	FMixerButtonPropertiesCached* CachedProps = GetButton(FName(Input->control.id));
-	if (CachedProps != nullptr)
+	MIXER_LLM_SCOPE(InteractiveSdk);
+	const UMixerInteractivitySettings* Settings = GetDefault<UMixerInteractivitySettings>();
+	FMixerFrameScheduler& Scheduler = FMixerFrameScheduler::Get();
+	const double PumpDeadline = FMath::Min(FPlatformTime::Seconds() + Settings->EventPumpBudgetMicroseconds * 1.0e-6, Scheduler.BeginWork(EMixerFrameWorkSource::InteractiveEvents));
+
+	uint32 PendingEvents = GetPendingEventCount();
+	const bool bHadEvents = PendingEvents > 0;
+	SetCoalesceStickInput(Settings->bCoalesceStickInput || PendingEvents > static_cast<uint32>(Settings->StickCoalescingBacklogThreshold);
+
+	// Always make some progress, even if the budget is tiny
+	if (Settings->bPrioritizeInputUnderLoad && (EventBacklog > 0 || GetStagedEventCount() > 0))
 	{
-		FMixerButtonEventDetails ButtonEventDetails;
-		ButtonEventDetails.Pressed = Input->buttonData.action == interactive_button_action_down;
-		ButtonEventDetails.TransactionId = Input->transactionId;
-		ButtonEventDetails.SparkCost = CachedProps->Desc.SparkCost;
-		if (ButtonEventDetails.Pressed)
+		// Last frame's budget ran out.  Pull everything that's waiting so the most important input goes first.
+		if (bQueueSessionEvents)
 		{
-			CachedProps->State.DownCount += 1;
-			if (CachePerParticipantState())
+			FSessionEvent Event;
+			while (PendingSessionEvents.Dequeue(Event))
 			{
-				CachedProps->HoldingParticipants.Add(User->Id);
-				CachedProps->State.PressCount = CachedProps->HoldingParticipants.Num();
+				PendingSessionEventCount.Decrement();
+				StageSessionEvent(MoveTemp(Event));
 			}
 		}
 		else
 		{
-			CachedProps->State.UpCount += 1;
-			if (CachePerParticipantState())
+			// Staging only copies events, but leave at least half the budget for handing them over
+			const double StagingStart = FPlatformTime::Seconds();
+			const double StagingDeadline = StagingStart + FMath::Max(PumpDeadline - StagingStart, 0.0) * 0.5;
+			uint32 SdkPendingEvents = 0;
+			bStagingSessionEvents = true;
+			do
 			{
-				CachedProps->HoldingParticipants.Remove(User->Id);
-				CachedProps->State.PressCount = CachedProps->HoldingParticipants.Num();
-			}
+				interactive_run(InteractiveSession, EventsPerPumpStep);
+				interactive_get_pending_event_count(InteractiveSession, &SdkPendingEvents);
+			} while (SdkPendingEvents > 0 && FPlatformTime::Seconds() < StagingDeadline);
+			bStagingSessionEvents = false;
 		}
 
-		OnButtonEvent().Broadcast(Input->control.id, User, ButtonEventDetails);
+		DispatchStagedSessionEvents(PumpDeadline);
+		PendingEvents = InteractiveSession != nullptr ? GetPendingEventCount() : 0;
 	}
-}
-
-void FMixerInteractivityModule_InteractiveCpp2::OnSessionCoordinateInput(TSharedPtr<const FMixerRemoteUser> User, const interactive_input* Input)
-{
-	if (CachePerParticipantState())
+	else if (bQueueSessionEvents)
 	{
-		FMixerStickPropertiesCached* CachedProps = GetStick(FName(Input->control.id));
-		if (CachedProps != nullptr)
+		FSessionEvent Event;
+		while (PendingSessionEvents.Dequeue(Event))
 		{
-			if (Input->coordinateData.x != 0 || Input->coordinateData.y != 0)
-			{
-				CachedProps->State.Axes *= CachedProps->PerParticipantStickValue.Num();
-				FVector2D& PerUserStickValue = CachedProps->PerParticipantStickValue.FindOrAdd(User->Id);
-				CachedProps->State.Axes -= PerUserStickValue;
-				PerUserStickValue = FVector2D(Input->coordinateData.x, Input->coordinateData.y);
-				CachedProps->State.Axes += PerUserStickValue;
-				CachedProps->State.Axes /= CachedProps->PerParticipantStickValue.Num();
-			}
-			else
+			PendingSessionEventCount.Decrement();
+			DispatchSessionEvent(Event);
+			if (InteractiveSession == nullptr || FPlatformTime::Seconds() >= PumpDeadline)
 			{
-				FVector2D* OldPerUserStickValue = CachedProps->PerParticipantStickValue.Find(User->Id);
-				if (OldPerUserStickValue != nullptr)
-				{
-					CachedProps->State.Axes *= CachedProps->PerParticipantStickValue.Num();
-					CachedProps->State.Axes -= *OldPerUserStickValue;
-					CachedProps->PerParticipantStickValue.Remove(User->Id);
-					if (CachedProps->PerParticipantStickValue.Num() > 0)
-					{
-						CachedProps->State.Axes /= CachedProps->PerParticipantStickValue.Num();
-					}
-					else
-					{
-						CachedProps->State.Axes = FVector2D(0, 0);
-					}
-				}
+				break;
 			}
 		}
+		PendingEvents = InteractiveSession != nullptr ? GetPendingEventCount() : 0;
 	}
-
-	OnStickEvent().Broadcast(Input->control.id, User, FVector2D(Input->coordinateData.x, Input->coordinateData.y));
-}
-
-bool FMixerInteractivityModule_InteractiveCpp2::OnSessionCustomInput(TSharedPtr<const FMixerRemoteUser> User, const interactive_input* Input)
-{
-	TSharedRef<TJsonReader<>> JsonReader = TJsonReaderFactory<>::Create(FString(UTF8_TO_TCHAR(Input->jsonData)));
-	TSharedPtr<FJsonObject> FullParamsJson;
-	if (!FJsonSerializer::Deserialize(JsonReader, FullParamsJson) && FullParamsJson.IsValid())
-	{
-		return false;
-	}
-
-	// Alias so macros work
-	const FJsonObject* JsonObj = FullParamsJson.Get();
-	GET_JSON_OBJECT_RETURN_FAILURE(Input, InputObj);
-
-	JsonObj = InputObj->Get();
-
-	GET_JSON_STRING_RETURN_FAILURE(ControlId, ControlIdRaw);
-	GET_JSON_STRING_RETURN_FAILURE(Event, EventType);
-
-	FName ControlId = *ControlIdRaw;
-	bool bHandled = false;
-	if (EventType == MixerStringConstants::EventTypes::Submit)
+	else
 	{
-		FMixerTextboxPropertiesCached* Textbox = GetTextbox(ControlId);
-		if (Textbox != nullptr)
+		do
 		{
-			GET_JSON_STRING_RETURN_FAILURE(Value, Value);
+			interactive_run(InteractiveSession, EventsPerPumpStep);
 
-			FMixerTextboxEventDetails EventDetails;
-			EventDetails.SubmittedText = FText::FromString(Value);
-			if (Textbox->Desc.SparkCost > 0)
-			{
-				if (FullParamsJson->TryGetStringField(MixerStringConstants::FieldNames::TransactionId, EventDetails.TransactionId))
-				{
-					EventDetails.SparkCost = Textbox->Desc.SparkCost;
-				}
-			}
-			else
+			// A handler may have ended the session
+			if (InteractiveSession == nullptr)
 			{
-				EventDetails.SparkCost = 0;
+				PendingEvents = 0;
+				break;
 			}
 
-			OnTextboxSubmitEvent().Broadcast(ControlId, User, EventDetails);
-			bHandled = true;
-		}
+			PendingEvents = GetPendingEventCount();
+		} while (PendingEvents > 0 && FPlatformTime::Seconds() < PumpDeadline);
 	}
 
-	if (!bHandled)
+	FlushCoalescedStickInput();
+
+	if (PendingEvents > static_cast<uint32>(Settings->StickCoalescingBacklogThreshold) && EventBacklog <= static_cast<uint32>(Settings->StickCoalescingBacklogThreshold))
+	{
+		UE_LOG(LogMixerInteractivity, Warning, TEXT("Interactive event backlog has grown to %u events; coalescing joystick input until it clears"), PendingEvents);
+	}
+	else if (PendingEvents > 0)
 	{
-		OnCustomControlInput().Broadcast(ControlId, *EventType, User, InputObj->ToSharedRef());
+		UE_LOG(LogMixerInteractivity, Verbose, TEXT("Interactive event backlog: %u events"), PendingEvents);
 	}
+	EventBacklog = PendingEvents;
 
-	return true;
+	Scheduler.EndWork(EMixerFrameWorkSource::InteractiveEvents, bHadEvents, PendingEvents > 0);
 }
 
-void FMixerInteractivityModule_InteractiveCpp2::OnSessionParticipantsChanged(void* Context, interactive_session Session, interactive_participant_action Action, const interactive_participant* Participant)
+uint32 FMixerInteractivityModule_InteractiveCpp2::GetPendingEventCount() const
 {
-	FMixerInteractivityModule_InteractiveCpp2& InteractiveModule = static_cast<FMixerInteractivityModule_InteractiveCpp2&>(IMixerInteractivityModule::Get());
-
-	FGuid SessionGuid;
-	if (!FGuid::Parse(Participant->id, SessionGuid))
-	{
-		UE_LOG(LogMixerInteractivity, Error, TEXT("Participant session id %hs was not in the expected format (guid)"), Participant->id);
-		return;
-	}
+	uint32 PendingEvents = 0;
+	interactive_get_pending_event_count(InteractiveSession, &PendingEvents);
+	return PendingEvents + static_cast<uint32>(PendingSessionEventCount.GetValue()) + GetStagedEventCount();
+}
 
-	switch (Action)
+FMixerInteractivityModule_InteractiveCpp2::EStagedEventTier FMixerInteractivityModule_InteractiveCpp2::GetStagedEventTier(const FSessionEvent& Event)
+{
+	bool bPaid = false;
+	switch (Event.Kind)
 	{
-	case participant_join:
+	case ESessionEventKind::ButtonInput:
+		if (!Event.TransactionId.IsEmpty())
 		{
-			TSharedPtr<FMixerRemoteUser> CachedParticipant = MakeShared<FMixerRemoteUser>();
-			CachedParticipant->Id = Participant->userId;
-			CachedParticipant->SessionGuid = SessionGuid;
-			CachedParticipant->Name = UTF8_TO_TCHAR(Participant->userName);
-			CachedParticipant->Level = Participant->level;
-			CachedParticipant->Group = Participant->groupId;
-			CachedParticipant->InputEnabled = !Participant->disabled;
-			// Timestamps are in ms since January 1 1970
-			CachedParticipant->ConnectedAt = FDateTime::FromUnixTimestamp(static_cast<int64>(Participant->connectedAtMs / 1000.0));
-			CachedParticipant->InputAt = FDateTime::FromUnixTimestamp(static_cast<int64>(Participant->lastInputAtMs / 1000.0));
-
-			InteractiveModule.AddUser(CachedParticipant);
+			bPaid = true;
+		}
+		else
+		{
+			const int32 ButtonIndex = FindButton(Event.ControlId);
+			bPaid = ButtonIndex != INDEX_NONE && GetButtonPropertiesAt(ButtonIndex).Desc.SparkCost > 0;
+		}
+		break;
+
+	case ESessionEventKind::CustomInput:
+		// Charged textbox submits carry their transaction alongside the input
+		bPaid = !Event.TransactionId.IsEmpty();
+		if (!bPaid)
+		{
+			return EStagedEventTier::Other;
+		}
+		break;
+
+	case ESessionEventKind::CoordinateInput:
+		return EStagedEventTier::Move;
+
+	default:
+		return EStagedEventTier::Control;
+	}
+
+	return bPaid && !StagedParticipantChanges.Contains(Event.ParticipantSessionGuid) ? EStagedEventTier::Paid : EStagedEventTier::Control;
+}
+
+void FMixerInteractivityModule_InteractiveCpp2::StageSessionEvent(FSessionEvent&& Event)
+{
+	const EStagedEventTier Tier = GetStagedEventTier(Event);
+	TArray<FSessionEvent>& TierEvents = StagedSessionEvents[static_cast<int32>(Tier)];
+	if (Tier == EStagedEventTier::Move)
+	{
+		FStagedMoveKey Key;
+		Key.ControlId = Event.ControlId;
+		Key.ParticipantSessionGuid = Event.ParticipantSessionGuid;
+		const int32* ExistingIndex = StagedMoveIndex.Find(Key);
+		if (ExistingIndex != nullptr)
+		{
+			// Superseded.  Keep the earlier event so that any re-fetched participant details survive.
+			TierEvents[*ExistingIndex].Coordinates = Event.Coordinates;
+			return;
+		}
+		StagedMoveIndex.Add(Key, TierEvents.Num());
+	}
+	else if (Event.Kind == ESessionEventKind::ParticipantChanged)
+	{
+		StagedParticipantChanges.FindOrAdd(Event.ParticipantSessionGuid) += 1;
+	}
+
+	TierEvents.Add(MoveTemp(Event));
+}
+
+void FMixerInteractivityModule_InteractiveCpp2::DispatchStagedSessionEvents(double PumpDeadline)
+{
+	bool bOutOfTime = false;
+	for (int32 TierIndex = 0; TierIndex < static_cast<int32>(EStagedEventTier::Count) && !bOutOfTime; ++TierIndex)
+	{
+		TArray<FSessionEvent>& TierEvents = StagedSessionEvents[TierIndex];
+		const bool bMoveTier = TierIndex == static_cast<int32>(EStagedEventTier::Move);
+		int32 NumDispatched = 0;
+		while (NumDispatched < TierEvents.Num())
+		{
+			// Handlers may end the session, which resets staging, so don't hold on to the array
+			const FSessionEvent Event = MoveTemp(TierEvents[NumDispatched++]);
+			if (Event.Kind == ESessionEventKind::ParticipantChanged)
+			{
+				int32* ChangeCount = StagedParticipantChanges.Find(Event.ParticipantSessionGuid);
+				if (ChangeCount != nullptr && --*ChangeCount <= 0)
+				{
+					StagedParticipantChanges.Remove(Event.ParticipantSessionGuid);
+				}
+			}
+
+			// Moves are handed over last, by which time a leave that arrived after them may have been applied
+			if (!bMoveTier || Event.bParticipantRefetched || GetCachedUser(Event.ParticipantSessionGuid).IsValid())
+			{
+				DispatchSessionEvent(Event);
+				if (InteractiveSession == nullptr)
+				{
+					return;
+				}
+			}
+
+			if (FPlatformTime::Seconds() >= PumpDeadline)
+			{
+				bOutOfTime = true;
+				break;
+			}
+		}
+
+		TierEvents.RemoveAt(0, NumDispatched, false);
+		if (bMoveTier && NumDispatched > 0)
+		{
+			StagedMoveIndex.Reset();
+			for (int32 i = 0; i < TierEvents.Num(); ++i)
+			{
+				FStagedMoveKey Key;
+				Key.ControlId = TierEvents[i].ControlId;
+				Key.ParticipantSessionGuid = TierEvents[i].ParticipantSessionGuid;
+				StagedMoveIndex.Add(Key, i);
+			}
+		}
+	}
+}
+
+uint32 FMixerInteractivityModule_InteractiveCpp2::GetStagedEventCount() const
+{
+	int32 NumStaged = 0;
+	for (const TArray<FSessionEvent>& TierEvents : StagedSessionEvents)
+	{
+		NumStaged += TierEvents.Num();
+	}
+	return static_cast<uint32>(NumStaged);
+}
+
+void FMixerInteractivityModule_InteractiveCpp2::ResetStagedSessionEvents()
+{
+	for (TArray<FSessionEvent>& TierEvents : StagedSessionEvents)
+	{
+		TierEvents.Empty();
+	}
+	StagedMoveIndex.Empty();
+	StagedParticipantChanges.Empty();
+}
+
+void FMixerInteractivityModule_InteractiveCpp2::StartSessionWorker()
+{
+	check(!bQueueSessionEvents);
+
+	// Must be set before the thread exists so that its first callback already queues
+	bQueueSessionEvents = true;
+	SessionWorker = new FSessionWorker(InteractiveSession);
+	SessionWorkerThread = FRunnableThread::Create(SessionWorker, TEXT("MixerInteractiveSession"));
+	if (SessionWorkerThread == nullptr)
+	{
+		UE_LOG(LogMixerInteractivity, Warning, TEXT("Failed to start interactive session worker thread; processing events on the game thread"));
+		bQueueSessionEvents = false;
+		delete SessionWorker;
+		SessionWorker = nullptr;
+	}
+}
+
+void FMixerInteractivityModule_InteractiveCpp2::StopSessionWorker()
+{
+	if (SessionWorkerThread != nullptr)
+	{
+		SessionWorkerThread->Kill(true);
+		delete SessionWorkerThread;
+		SessionWorkerThread = nullptr;
+		delete SessionWorker;
+		SessionWorker = nullptr;
+	}
+
+	bQueueSessionEvents = false;
+
+	PendingSessionEvents.Empty();
+	PendingSessionEventCount.Reset();
+}
+
+void FMixerInteractivityModule_InteractiveCpp2::CallRemoteMethod(const FString& MethodName, const TSharedRef<FJsonObject> MethodParams)
+{
+	if (InteractiveSession != nullptr)
+	{
+		// Write straight to UTF-8 and have the SDK splice the text into the message as-is, rather than
+		// going via a TCHAR string that the SDK would parse back into a document and serialize again.
+		RemoteMethodParamsBuffer.Reset();
+		FMemoryWriter ParamsArchive(RemoteMethodParamsBuffer);
+		TSharedRef<TJsonWriter<UTF8CHAR, FMixerUtf8CondensedJsonPrintPolicy>> Writer = TJsonWriterFactory<UTF8CHAR, FMixerUtf8CondensedJsonPrintPolicy>::Create(&ParamsArchive);
+		FJsonSerializer::Serialize(MethodParams, Writer);
+
+		uint32 MessageId = 0;
+		interactive_send_method_raw(InteractiveSession, TCHAR_TO_UTF8(*MethodName), reinterpret_cast<const char*>(RemoteMethodParamsBuffer.GetData()), RemoteMethodParamsBuffer.Num(), true, &MessageId);
+	}
+}
+
+void FMixerInteractivityModule_InteractiveCpp2::CallRemoteMethodSerialized(const FString& MethodName, TArrayView<const uint8> Utf8Params)
+{
+	if (InteractiveSession != nullptr)
+	{
+		uint32 MessageId = 0;
+		interactive_send_method_raw(InteractiveSession, TCHAR_TO_UTF8(*MethodName), reinterpret_cast<const char*>(Utf8Params.GetData()), Utf8Params.Num(), true, &MessageId);
+	}
+}
+
+bool FMixerInteractivityModule_InteractiveCpp2::CallRemoteMethodAsync(const FString& MethodName, const TSharedRef<FJsonObject> MethodParams, const FOnRemoteMethodReply& OnReply)
+{
+	if (InteractiveSession == nullptr)
+	{
+		return false;
+	}
+
+	RemoteMethodParamsBuffer.Reset();
+	FMemoryWriter ParamsArchive(RemoteMethodParamsBuffer);
+	TSharedRef<TJsonWriter<UTF8CHAR, FMixerUtf8CondensedJsonPrintPolicy>> Writer = TJsonWriterFactory<UTF8CHAR, FMixerUtf8CondensedJsonPrintPolicy>::Create(&ParamsArchive);
+	FJsonSerializer::Serialize(MethodParams, Writer);
+
+	// Queued for the SDK's outgoing thread, with the reply routed back through interactive_run rather than waited on here
+	const uint32 CallId = NextRemoteMethodCallId++;
+	if (interactive_queue_method(InteractiveSession, TCHAR_TO_UTF8(*MethodName), reinterpret_cast<const char*>(RemoteMethodParamsBuffer.GetData()), RemoteMethodParamsBuffer.Num(), CallId, &FMixerInteractivityModule_InteractiveCpp2::OnRemoteMethodReply) != MIXER_OK)
+	{
+		return false;
+	}
+
+	// The reply is only ever dispatched from the game thread, so there's no race with this
+	FRemoteMethodCallInFlight& InFlight = RemoteMethodCallsInFlight.Add(CallId);
+	InFlight.OnReply = OnReply;
+	InFlight.SentAt = FPlatformTime::Seconds();
+	return true;
+}
+
+void FMixerInteractivityModule_InteractiveCpp2::ExpireRemoteMethodCalls(double Now)
+{
+	// The SDK never reports replies that don't arrive, so give up on these ourselves
+	TArray<FOnRemoteMethodReply> Expired;
+	for (TMap<uint32, FRemoteMethodCallInFlight>::TIterator It(RemoteMethodCallsInFlight); It; ++It)
+	{
+		if (Now - It->Value.SentAt > RemoteMethodReplyTimeout)
+		{
+			Expired.Add(It->Value.OnReply);
+			It.RemoveCurrent();
+		}
+	}
+
+	for (const FOnRemoteMethodReply& OnReply : Expired)
+	{
+		OnReply.ExecuteIfBound(false, nullptr, TEXT("Timed out waiting for method reply"));
+	}
+}
+
+void FMixerInteractivityModule_InteractiveCpp2::AbandonRemoteMethodCalls()
+{
+	// Callers may issue new requests from the callback, so detach the map first
+	TMap<uint32, FRemoteMethodCallInFlight> Abandoned = MoveTemp(RemoteMethodCallsInFlight);
+	RemoteMethodCallsInFlight.Reset();
+	for (const TPair<uint32, FRemoteMethodCallInFlight>& Pair : Abandoned)
+	{
+		Pair.Value.OnReply.ExecuteIfBound(false, nullptr, TEXT("Interactive session ended"));
+	}
+}
+
+bool FMixerInteractivityModule_InteractiveCpp2::StartInteractiveConnection()
+{
+	if (GetInteractiveConnectionAuthState() != EMixerLoginState::Not_Logged_In)
+	{
+		UE_LOG(LogMixerInteractivity, Warning, TEXT("StartInteractiveConnection failed - plugin state %d."),
+			static_cast<int32>(GetInteractiveConnectionAuthState()));
+		return false;
+	}
+
+	OpenStartTime = FPlatformTime::Seconds();
+
+	// A recent enough host list lets the SDK start connecting now.  The list is refreshed
+	// alongside purely to keep the cache current - the SDK already has its copy.
+	const UMixerInteractivityUserSettings* UserSettings = GetDefault<UMixerInteractivityUserSettings>();
+	TArray<FString> CachedHosts;
+	if (FMixerInteractiveHostsCache::GetCachedHosts(CachedHosts, UserSettings->PreferredInteractiveEndpoint, false))
+	{
+		HostsCache->RequestHosts(FMixerInteractiveHostsCache::FOnHostsReceived());
+		HostLookupMs = 0.0;
+		SetInteractiveConnectionAuthState(EMixerLoginState::Logging_In);
+		MarkStartupPhase(StartupTimings.HostsDiscovered, TEXT("interactive hosts discovered (cached)"));
+		OpenSession(CachedHosts);
+		return true;
+	}
+
+	// Look up hosts through the engine's http module so that no thread has to sit in the SDK's blocking request
+	if (!HostsCache->RequestHosts(FMixerInteractiveHostsCache::FOnHostsReceived::CreateRaw(this, &FMixerInteractivityModule_InteractiveCpp2::OnHostsReceived)))
+	{
+		return false;
+	}
+
+	SetInteractiveConnectionAuthState(EMixerLoginState::Logging_In);
+	return true;
+}
+
+void FMixerInteractivityModule_InteractiveCpp2::PrefetchInteractiveHosts()
+{
+	TArray<FString> CachedHosts;
+	if (!FMixerInteractiveHostsCache::GetCachedHosts(CachedHosts, FString(), false))
+	{
+		// Picked up by StartInteractiveConnection if still in flight
+		HostsCache->RequestHosts(FMixerInteractiveHostsCache::FOnHostsReceived());
+	}
+}
+
+void FMixerInteractivityModule_InteractiveCpp2::OnAccessTokenRefreshed()
+{
+	// The SDK keeps the authorization it was opened with, so hand it the replacement
+	interactive_session Session = InteractiveSession != nullptr ? InteractiveSession : OpeningSession;
+	if (Session != nullptr)
+	{
+		MIXER_LLM_SCOPE(InteractiveSdk);
+		int32 Result = interactive_set_session_authorization(Session, TCHAR_TO_UTF8(*GetDefault<UMixerInteractivityUserSettings>()->GetAuthZHeaderValue()));
+		if (Result != MIXER_OK)
+		{
+			UE_LOG(LogMixerInteractivity, Warning, TEXT("Failed to pass refreshed access token to interactive session (error %d)"), Result);
+		}
+	}
+}
+
+void FMixerInteractivityModule_InteractiveCpp2::OnHostsReceived(const TArray<FString>& LookedUpHosts)
+{
+	HostLookupMs = (FPlatformTime::Seconds() - OpenStartTime) * 1000.0;
+	MarkStartupPhase(StartupTimings.HostsDiscovered, TEXT("interactive hosts discovered"));
+
+	TArray<FString> Hosts = LookedUpHosts;
+	if (Hosts.Num() == 0)
+	{
+		// An outdated list is still a better bet than another blocking lookup
+		FMixerInteractiveHostsCache::GetCachedHosts(Hosts, FString(), true);
+	}
+
+	if (Hosts.Num() == 0)
+	{
+		// Let the SDK try the lookup itself, off the game thread
+		UE_LOG(LogMixerInteractivity, Warning, TEXT("Interactive host lookup failed after %.0f ms; falling back to SDK lookup"), HostLookupMs);
+	}
+
+	OpenSession(Hosts);
+}
+
+void FMixerInteractivityModule_InteractiveCpp2::OpenSession(const TArray<FString>& Hosts)
+{
+	MIXER_LLM_SCOPE(InteractiveSdk);
+
+	const UMixerInteractivitySettings* Settings = GetDefault<UMixerInteractivitySettings>();
+	const UMixerInteractivityUserSettings* UserSettings = GetDefault<UMixerInteractivityUserSettings>();
+
+	// The SDK copies these, so they only need to outlive the call
+	TArray<TArray<ANSICHAR>> Utf8Hosts;
+	TArray<const char*> HostPointers;
+	Utf8Hosts.SetNum(Hosts.Num());
+	for (int32 i = 0; i < Hosts.Num(); ++i)
+	{
+		FTCHARToUTF8 Converted(*Hosts[i]);
+		Utf8Hosts[i].Append(Converted.Get(), Converted.Length());
+		Utf8Hosts[i].Add('\0');
+		HostPointers.Add(Utf8Hosts[i].GetData());
+	}
+
+	OpenState.Completed.Reset();
+	OpenState.Result = MIXER_OK;
+	int32 OpenResult = interactive_open_session_async(
+		TCHAR_TO_UTF8(*UserSettings->GetAuthZHeaderValue()),
+		TCHAR_TO_UTF8(*FString::FromInt(Settings->GameVersionId)),
+		TCHAR_TO_UTF8(*Settings->ShareCode),
+		false,
+		HostPointers.GetData(),
+		HostPointers.Num(),
+		TCHAR_TO_UTF8(*FMixerInteractiveHostsCache::GetHostsUrl()),
+		&FMixerInteractivityModule_InteractiveCpp2::OnSessionOpened,
+		&OpenState,
+		&OpeningSession);
+	if (OpenResult != MIXER_OK)
+	{
+		UE_LOG(LogMixerInteractivity, Error, TEXT("Failed to start opening interactive session (error %d)"), OpenResult);
+		OpeningSession = nullptr;
+		SetInteractiveConnectionAuthState(EMixerLoginState::Not_Logged_In);
+	}
+}
+
+void FMixerInteractivityModule_InteractiveCpp2::OnSessionOpened(void* Context, interactive_session Session, int Result, const interactive_open_timing* Timing)
+{
+	// SDK connect thread.  Picked up by Tick once Completed is set.
+	FSessionOpenState* State = static_cast<FSessionOpenState*>(Context);
+	State->Result = Result;
+	State->Timing = *Timing;
+	State->Completed.Set(1);
+}
+
+void FMixerInteractivityModule_InteractiveCpp2::StopInteractiveConnection()
+{
+	if (GetInteractiveConnectionAuthState() != EMixerLoginState::Not_Logged_In)
+	{
+		SetInteractiveConnectionAuthState(EMixerLoginState::Not_Logged_In);
+		HostsCache->Cancel();
+		if (OpeningSession != nullptr)
+		{
+			// Cancels the open; returns once the SDK connect thread has finished
+			interactive_close_session(OpeningSession);
+			OpeningSession = nullptr;
+		}
+		StopSessionWorker();
+		interactive_close_session(InteractiveSession);
+		EndSession();
+		{
+			FScopeLock Lock(&EvictedSessionGuidsLock);
+			EvictedSessionGuids.Empty();
+			NumEvictedSessionGuids.Reset();
+		}
+		InteractiveSession = nullptr;
+		ScenesByGroup.Empty();
+		ScenesByGroupChangeCount = INDEX_NONE;
+		AbandonGroupBatches();
+		AbandonRemoteMethodCalls();
+		ResetStagedSessionEvents();
+		EventBacklog = 0;
+	}
+}
+
+void FMixerInteractivityModule_InteractiveCpp2::GetContainerSizes(TFunctionRef<void(const TCHAR* Name, int64 Size)> Visit) const
+{
+	FMixerInteractivityModule_WithSessionState::GetContainerSizes(Visit);
+
+	Visit(TEXT("Replies.GroupBatches"), GroupBatchesInFlight.Num());
+	Visit(TEXT("Replies.RemoteMethodCalls"), RemoteMethodCallsInFlight.Num());
+}
+
+bool FMixerInteractivityModule_InteractiveCpp2::Tick(float DeltaTime)
+{
+	FMixerInteractivityModule_WithSessionState::Tick(DeltaTime);
+
+#if MIXER_TRAFFIC_RECORDER_ENABLED
+	UpdateSdkTrafficCapture();
+#endif
+
+	if (InteractiveSession != nullptr)
+	{
+		// interactive_run is the input pump, so it follows input delivery rather than the processing rate
+		if (IsInputDispatchStep())
+		{
+			PumpEvents();
+		}
+		if (InteractiveSession != nullptr && IsProcessingStep())
+		{
+			UpdateAdaptiveInputThrottle(DeltaTime);
+		}
+		if (IsInputDispatchStep())
+		{
+			FlushInputBatch();
+		}
+
+		if (RemoteMethodCallsInFlight.Num() > 0 && IsProcessingStep())
+		{
+			ExpireRemoteMethodCalls(FPlatformTime::Seconds());
+		}
+	}
+	else if (OpeningSession != nullptr && OpenState.Completed.GetValue() != 0)
+	{
+		OnSessionOpenComplete();
+	}
+
+	return true;
+}
+
+#if MIXER_TRAFFIC_RECORDER_ENABLED
+void FMixerInteractivityModule_InteractiveCpp2::UpdateSdkTrafficCapture()
+{
+	const bool bRecording = FMixerTrafficRecorder::Get().IsRecording();
+	if (bRecording != bSdkTrafficCaptureActive)
+	{
+		bSdkTrafficCaptureActive = bRecording;
+		if (bRecording)
+		{
+			interactive_config_debug(interactive_debug_trace, &FMixerInteractivityModule_InteractiveCpp2::OnSdkDebugMessage);
+		}
+		else
+		{
+			interactive_config_debug(interactive_debug_none, nullptr);
+		}
+	}
+}
+
+void FMixerInteractivityModule_InteractiveCpp2::OnSdkDebugMessage(const interactive_debug_level Level, const char* Message, size_t MessageLength)
+{
+	// Called on whichever SDK thread sent or received the frame
+	static const char ReceivedPrefix[] = "Websocket message received: ";
+	static const char SentPrefix[] = "Sending websocket message: ";
+	if (Level != interactive_debug_trace)
+	{
+		return;
+	}
+
+	const int32 Length = static_cast<int32>(MessageLength);
+	const int32 ReceivedPrefixLength = ARRAY_COUNT(ReceivedPrefix) - 1;
+	const int32 SentPrefixLength = ARRAY_COUNT(SentPrefix) - 1;
+	if (Length > ReceivedPrefixLength && FCStringAnsi::Strncmp(Message, ReceivedPrefix, ReceivedPrefixLength) == 0)
+	{
+		FMixerTrafficRecorder::Get().Record(EMixerTrafficChannel::Interactive, EMixerTrafficDirection::Inbound, Message + ReceivedPrefixLength, Length - ReceivedPrefixLength);
+	}
+	else if (Length > SentPrefixLength && FCStringAnsi::Strncmp(Message, SentPrefix, SentPrefixLength) == 0)
+	{
+		FMixerTrafficRecorder::Get().Record(EMixerTrafficChannel::Interactive, EMixerTrafficDirection::Outbound, Message + SentPrefixLength, Length - SentPrefixLength);
+	}
+}
+#endif
+
+void FMixerInteractivityModule_InteractiveCpp2::OnSessionOpenComplete()
+{
+	const double TotalMs = (FPlatformTime::Seconds() - OpenStartTime) * 1000.0;
+	if (OpenState.Result == MIXER_OK)
+	{
+		UE_LOG(LogMixerInteractivity, Log, TEXT("Interactive session opened in %.0f ms (host lookup %.0f ms, SDK host lookup %u ms, socket %u ms, handshake %u ms)"),
+			TotalMs, HostLookupMs, OpenState.Timing.hostLookupMs, OpenState.Timing.socketOpenMs, OpenState.Timing.handshakeMs);
+		InteractiveSession = OpeningSession;
+		OpeningSession = nullptr;
+
+		BindOpenedSession();
+		ApplyConfiguredThrottles();
+
+		// Initial scene enumeration blocks on replies, so only hand interactive_run to another thread after it
+		if (GetDefault<UMixerInteractivitySettings>()->bProcessEventsOnWorkerThread)
+		{
+			StartSessionWorker();
+		}
+
+		SetInteractiveConnectionAuthState(EMixerLoginState::Logged_In);
+	}
+	else
+	{
+		UE_LOG(LogMixerInteractivity, Error, TEXT("Failed to open interactive session after %.0f ms (error %d)"), TotalMs, OpenState.Result);
+		interactive_close_session(OpeningSession);
+		OpeningSession = nullptr;
+		SetInteractiveConnectionAuthState(EMixerLoginState::Not_Logged_In);
+	}
+}
+
+void FMixerInteractivityModule_InteractiveCpp2::BindOpenedSession()
+{
+	const UMixerInteractivitySettings* Settings = GetDefault<UMixerInteractivitySettings>();
+
+	// Every callback finds its way back here through the context, so nothing depends on which module is registered
+	interactive_set_session_context(InteractiveSession, this);
+
+	StartSession(Settings->bPerParticipantStateCaching, Settings->ExpectedAudienceSize);
+
+	interactive_register_error_handler(InteractiveSession, &FMixerInteractivityModule_InteractiveCpp2::OnSessionError);
+	interactive_register_state_changed_handler(InteractiveSession, &FMixerInteractivityModule_InteractiveCpp2::OnSessionStateChanged);
+	interactive_register_input_handler(InteractiveSession, &FMixerInteractivityModule_InteractiveCpp2::OnSessionInput);
+	interactive_register_participants_changed_handler(InteractiveSession, &FMixerInteractivityModule_InteractiveCpp2::OnSessionParticipantsChanged);
+	interactive_register_unhandled_method_handler(InteractiveSession, &FMixerInteractivityModule_InteractiveCpp2::OnUnhandledMethod);
+	interactive_register_transaction_complete_handler(InteractiveSession, &FMixerInteractivityModule_InteractiveCpp2::OnTransactionComplete);
+	interactive_register_groups_changed_handler(InteractiveSession, &FMixerInteractivityModule_InteractiveCpp2::OnSessionGroupsChanged);
+
+	// The SDK cached the session's groups while opening; pick them up on first use
+	ScenesByGroupChangeCount = INDEX_NONE;
+
+	interactive_get_scenes(InteractiveSession, &FMixerInteractivityModule_InteractiveCpp2::OnEnumerateScenesForInit);
+	DropUnclaimedControlReservations([](FName) { return false; });
+}
+
+#if MIXER_BENCHMARKS_ENABLED
+bool FMixerInteractivityModule_InteractiveCpp2::BeginBenchmarkSession(const FString& ScenesResult)
+{
+	// The session is torn down through the usual path afterwards, which would sign a real user out
+	if (GetLoginState() != EMixerLoginState::Not_Logged_In || GetInteractiveConnectionAuthState() != EMixerLoginState::Not_Logged_In)
+	{
+		return false;
+	}
+
+	FTCHARToUTF8 Utf8Scenes(*ScenesResult);
+	interactive_session Session = nullptr;
+	const int Result = interactive_open_loopback_session(Utf8Scenes.Get(), Utf8Scenes.Length(), &Session);
+	if (Result != MIXER_OK)
+	{
+		UE_LOG(LogMixerInteractivity, Warning, TEXT("Failed to open loopback session (error %d)"), Result);
+		return false;
+	}
+
+	// As OnSessionOpenComplete, but interactive_run stays on the game thread so that PumpBenchmarkSession does all of the work
+	SetInteractiveConnectionAuthState(EMixerLoginState::Logging_In);
+	InteractiveSession = Session;
+	BindOpenedSession();
+	SetInteractiveConnectionAuthState(EMixerLoginState::Logged_In);
+	return true;
+}
+
+void FMixerInteractivityModule_InteractiveCpp2::ReceiveBenchmarkFrame(const FString& Frame)
+{
+	if (InteractiveSession != nullptr)
+	{
+		FTCHARToUTF8 Utf8Frame(*Frame);
+		interactive_loopback_receive(InteractiveSession, Utf8Frame.Get(), Utf8Frame.Length());
+	}
+}
+
+void FMixerInteractivityModule_InteractiveCpp2::PumpBenchmarkSession()
+{
+	FMixerInteractivityModule_WithSessionState::PumpBenchmarkSession();
+
+	// Unlike Tick, keep going past the pump budget until everything received has been handed over
+	while (InteractiveSession != nullptr && GetPendingEventCount() > 0)
+	{
+		PumpEvents();
+	}
+	if (InteractiveSession != nullptr)
+	{
+		FlushInputBatch();
+	}
+}
+
+void FMixerInteractivityModule_InteractiveCpp2::EndBenchmarkSession()
+{
+	StopInteractiveConnection();
+}
+#endif
+
+void FMixerInteractivityModule_InteractiveCpp2::OnSessionStateChanged(void* Context, interactive_session Session, interactive_state PreviousState, interactive_state NewState)
+{
+	FSessionEvent Event;
+	Event.Kind = ESessionEventKind::StateChanged;
+	Event.Action = static_cast<int32>(NewState);
+	FromSessionContext(Context).HandleSessionEvent(MoveTemp(Event));
+}
+
+void FMixerInteractivityModule_InteractiveCpp2::OnSessionError(void* Context, interactive_session Session, int ErrorCode, const char* ErrorMessage, size_t ErrorMessageLength)
+{
+	UE_LOG(LogMixerInteractivity, Error, TEXT("Session error %d: %hs"), ErrorCode, ErrorMessage);
+}
+
+void FMixerInteractivityModule_InteractiveCpp2::OnSessionInput(void* Context, interactive_session Session, const interactive_input* Input)
+{
+	FSessionEvent Event;
+	if (!ParseSessionId(Input->participantId, Event.ParticipantSessionGuid))
+	{
+		UE_LOG(LogMixerInteractivity, Error, TEXT("Participant id %hs was not in the expected format (guid)"), Input->participantId);
+		return;
+	}
+
+	FMixerInteractivityModule_InteractiveCpp2& InteractiveModule = FromSessionContext(Context);
+
+	// Drop input for controls no group is shown or that are disabled before anything else is decoded, then sample
+	// what's left.  Releases must always arrive so held state can't get stuck, and charged input must reach the
+	// game so it can be captured.
+	Event.ControlId = FName(Input->control.id);
+	const bool bRelease = Input->type == input_type_click && Input->buttonData.action != interactive_button_action_down;
+	if (!bRelease && (InteractiveModule.bQueueSessionEvents ? InteractiveModule.InputFilter.Rejects(Event.ControlId) : InteractiveModule.RejectsControlInput(Event.ControlId)))
+	{
+		return;
+	}
+
+	const bool bSampleExempt = Input->transactionId != nullptr && Input->transactionId[0] != '\0';
+	Event.SampleWeight = Input->type == input_type_click
+		? InteractiveModule.InputSampler.SampleButton(Event.ControlId, Event.ParticipantSessionGuid, !bRelease, bSampleExempt)
+		: InteractiveModule.InputSampler.Sample(Event.ControlId, bSampleExempt);
+	if (Event.SampleWeight == 0)
+	{
+		return;
+	}
+
+	InteractiveModule.RefetchEvictedParticipant(Session, Input->participantId, Event);
+
+	switch (Input->type)
+	{
+	case input_type_click:
+		Event.Kind = ESessionEventKind::ButtonInput;
+		Event.Action = static_cast<int32>(Input->buttonData.action);
+		Event.TransactionId = Input->transactionId;
+		break;
+
+	case input_type_move:
+		Event.Kind = ESessionEventKind::CoordinateInput;
+		Event.Coordinates = FVector2D(Input->coordinateData.x, Input->coordinateData.y);
+		break;
+
+	case input_type_custom:
+	default:
+		{
+			if (Input->jsonData == nullptr || Input->customData.eventType == nullptr)
+			{
+				return;
+			}
+
+			Event.Kind = ESessionEventKind::CustomInput;
+			Event.TransactionId = Input->transactionId;
+			FUTF8ToTCHAR ConvertedEvent(Input->customData.eventType, static_cast<int32>(Input->customData.eventTypeLength));
+			Event.InputEvent = FString(ConvertedEvent.Length(), ConvertedEvent.Get());
+			if (Input->customData.value != nullptr)
+			{
+				FUTF8ToTCHAR ConvertedValue(Input->customData.value, static_cast<int32>(Input->customData.valueLength));
+				Event.InputValue = FString(ConvertedValue.Length(), ConvertedValue.Get());
+			}
+
+			// Textbox submits are fully described by the fields above, so only keep the raw params in case
+			// the control turns out not to be a textbox.  Anything else is for custom control listeners that
+			// want the JSON, so parse it here, off the game thread when a session worker is running.
+			if (Event.InputEvent == MixerStringConstants::EventTypes::Submit)
+			{
+				Event.Utf8Params.Append(Input->jsonData, static_cast<int32>(Input->jsonDataLength));
+			}
+			else
+			{
+				FUTF8ToTCHAR ConvertedParams(Input->jsonData, static_cast<int32>(Input->jsonDataLength));
+				TSharedRef<TJsonReader<>> JsonReader = TJsonReaderFactory<>::Create(FString(ConvertedParams.Length(), ConvertedParams.Get()));
+				if (!FJsonSerializer::Deserialize(JsonReader, Event.Json) || !Event.Json.IsValid())
+				{
+					return;
+				}
+			}
 		}
 		break;
+	}
 
-	case participant_leave:
-		InteractiveModule.RemoveUser(SessionGuid);
-		break;
+	InteractiveModule.HandleSessionEvent(MoveTemp(Event));
+}
 
-	case participant_update:
+void FMixerInteractivityModule_InteractiveCpp2::OnSessionParticipantsChanged(void* Context, interactive_session Session, interactive_participant_action Action, const interactive_participant* Participant)
+{
+	FSessionEvent Event;
+	if (!FGuid::Parse(Participant->id, Event.ParticipantSessionGuid))
+	{
+		UE_LOG(LogMixerInteractivity, Error, TEXT("Participant session id %hs was not in the expected format (guid)"), Participant->id);
+		return;
+	}
+
+	Event.Kind = ESessionEventKind::ParticipantChanged;
+	Event.Action = static_cast<int32>(Action);
+	if (Action == participant_leave)
+	{
+		FromSessionContext(Context).ForgetEvictedSessionGuid(Event.ParticipantSessionGuid);
+	}
+	else
+	{
+		Event.Participant.Id = Participant->userId;
+		Event.Participant.SessionGuid = Event.ParticipantSessionGuid;
+		Event.Participant.Name = UTF8_TO_TCHAR(Participant->userName);
+		Event.Participant.Level = Participant->level;
+		Event.Participant.Group = Participant->groupId;
+		Event.Participant.InputEnabled = !Participant->disabled;
+		// Timestamps are in ms since January 1 1970
+		Event.Participant.ConnectedAt = FDateTime::FromUnixTimestamp(static_cast<int64>(Participant->connectedAtMs / 1000.0));
+		Event.Participant.InputAt = FDateTime::FromUnixTimestamp(static_cast<int64>(Participant->lastInputAtMs / 1000.0));
+	}
+
+	FromSessionContext(Context).HandleSessionEvent(MoveTemp(Event));
+}
+
+bool FMixerInteractivityModule_InteractiveCpp2::RefetchEvictedParticipant(interactive_session Session, const char* ParticipantId, FSessionEvent& Event)
+{
+	if (NumEvictedSessionGuids.GetValue() == 0)
+	{
+		return false;
+	}
+
+	{
+		FScopeLock Lock(&EvictedSessionGuidsLock);
+		if (EvictedSessionGuids.Remove(Event.ParticipantSessionGuid) == 0)
 		{
-			TSharedPtr<FMixerRemoteUser> CachedParticipant = InteractiveModule.GetCachedUser(SessionGuid);
-			check(CachedParticipant.IsValid());
-			check(CachedParticipant->Id == Participant->userId);
-			CachedParticipant->Name = UTF8_TO_TCHAR(Participant->userName);
-			CachedParticipant->Level = Participant->level;
-			CachedParticipant->Group = Participant->groupId;
-			CachedParticipant->InputAt = FDateTime::FromUnixTimestamp(static_cast<int64>(Participant->lastInputAtMs / 1000.0));
-			CachedParticipant->InputEnabled = !Participant->disabled;
+			return false;
+		}
+		NumEvictedSessionGuids.Decrement();
 	}
-		break;
 
-	default:
-		UE_LOG(LogMixerInteractivity, Error, TEXT("Unknown participant change type %d"), static_cast<int32>(Action));
-		break;
+	// The SDK keeps the full roster, and this is the thread that maintains it
+	interactive_participant Participant;
+	if (MIXER_OK != interactive_get_participant(Session, ParticipantId, &Participant))
+	{
+		return false;
+	}
+
+	Event.Participant.Id = Participant.userId;
+	Event.Participant.SessionGuid = Event.ParticipantSessionGuid;
+	Event.Participant.Name = UTF8_TO_TCHAR(Participant.userName);
+	Event.Participant.Level = Participant.level;
+	Event.Participant.Group = Participant.groupId;
+	Event.Participant.InputEnabled = !Participant.disabled;
+	Event.Participant.ConnectedAt = FDateTime::FromUnixTimestamp(static_cast<int64>(Participant.connectedAtMs / 1000.0));
+	Event.Participant.InputAt = FDateTime::UtcNow();
+	Event.bParticipantRefetched = true;
+	return true;
+}
+
+void FMixerInteractivityModule_InteractiveCpp2::ForgetEvictedSessionGuid(const FGuid& ParticipantSessionGuid)
+{
+	if (NumEvictedSessionGuids.GetValue() > 0)
+	{
+		FScopeLock Lock(&EvictedSessionGuidsLock);
+		if (EvictedSessionGuids.Remove(ParticipantSessionGuid) > 0)
+		{
+			NumEvictedSessionGuids.Decrement();
+		}
+	}
+}
+
+void FMixerInteractivityModule_InteractiveCpp2::OnUserEvicted(const FMixerRemoteUser& User)
+{
+	FScopeLock Lock(&EvictedSessionGuidsLock);
+	if (!EvictedSessionGuids.Contains(User.SessionGuid))
+	{
+		EvictedSessionGuids.Add(User.SessionGuid);
+		NumEvictedSessionGuids.Increment();
 	}
 }
 
 void FMixerInteractivityModule_InteractiveCpp2::OnUnhandledMethod(void* Context, interactive_session Session, const char* MethodJson, size_t MethodJsonLength)
 {
-	FMixerInteractivityModule_InteractiveCpp2& InteractiveModule = static_cast<FMixerInteractivityModule_InteractiveCpp2&>(IMixerInteractivityModule::Get());
 	TSharedRef<TJsonReader<>> JsonReader = TJsonReaderFactory<>::Create(FString(UTF8_TO_TCHAR(MethodJson)));
 	TSharedPtr<FJsonObject> JsonObject;
 	if (FJsonSerializer::Deserialize(JsonReader, JsonObject) && JsonObject.IsValid())
 	{
-		FString Method;
-		if (JsonObject->TryGetStringField(TEXT("method"), Method))
+		FSessionEvent Event;
+		if (JsonObject->TryGetStringField(TEXT("method"), Event.Method))
 		{
 			const TSharedPtr<FJsonObject> *ParamsObject;
 			if (JsonObject->TryGetObjectField(TEXT("params"), ParamsObject))
 			{
-				if (Method == TEXT("onControlUpdate"))
-				{
-					InteractiveModule.HandleControlUpdateMessage(ParamsObject->Get());
-				}
-				else
+				Event.Kind = ESessionEventKind::UnhandledMethod;
+				Event.Json = *ParamsObject;
+				JsonObject.Reset();
+				FromSessionContext(Context).HandleSessionEvent(MoveTemp(Event));
+			}
+		}
+	}
+}
+
+void FMixerInteractivityModule_InteractiveCpp2::HandleSessionEvent(FSessionEvent&& Event)
+{
+	Event.ReceivedTime = FPlatformTime::Seconds();
+
+#if MIXER_TRACE_ENABLED
+	if (MIXER_TRACE_IS_ACTIVE())
+	{
+		Event.TraceSequence = MixerTrace::NextSequence();
+		MixerTrace::Marker(TEXT("Receive"), GetSessionEventTraceName(Event), Event.TraceSequence);
+	}
+#endif
+
+	if (bQueueSessionEvents)
+	{
+		// On the worker thread.  Nothing in the event is referenced from here any more, so ownership passes cleanly.
+		PendingSessionEvents.Enqueue(MoveTemp(Event));
+		PendingSessionEventCount.Increment();
+	}
+	else if (bStagingSessionEvents)
+	{
+		StageSessionEvent(MoveTemp(Event));
+	}
+	else
+	{
+		DispatchSessionEvent(Event);
+	}
+}
+
+#if MIXER_TRACE_ENABLED
+FString FMixerInteractivityModule_InteractiveCpp2::GetSessionEventTraceName(const FSessionEvent& Event)
+{
+	switch (Event.Kind)
+	{
+	case ESessionEventKind::StateChanged:			return TEXT("state");
+	case ESessionEventKind::ButtonInput:			return FString::Printf(TEXT("button %s"), *Event.ControlId.ToString());
+	case ESessionEventKind::CoordinateInput:		return FString::Printf(TEXT("move %s"), *Event.ControlId.ToString());
+	case ESessionEventKind::CustomInput:			return TEXT("giveInput");
+	case ESessionEventKind::ParticipantChanged:		return TEXT("participant");
+	case ESessionEventKind::UnhandledMethod:		return Event.Method;
+	case ESessionEventKind::TransactionComplete:	return TEXT("capture");
+	case ESessionEventKind::GroupBatchComplete:		return TEXT("groups");
+	case ESessionEventKind::RemoteMethodReply:		return TEXT("reply");
+	default:										return TEXT("event");
+	}
+}
+#endif
+
+void FMixerInteractivityModule_InteractiveCpp2::DispatchSessionEvent(const FSessionEvent& Event)
+{
+	MIXER_TRACE_SCOPE("Dispatch", GetSessionEventTraceName(Event), Event.TraceSequence);
+	TGuardValue<double> ArrivalGuard(InputArrivalTime, Event.ReceivedTime);
+
+	switch (Event.Kind)
+	{
+	case ESessionEventKind::StateChanged:
+		switch (static_cast<interactive_state>(Event.Action))
+		{
+		case not_ready:
+			SetInteractivityState(EMixerInteractivityState::Not_Interactive);
+			break;
+
+		case ready:
+			SetInteractivityState(EMixerInteractivityState::Interactive);
+			break;
+
+		case disconnected:
+		default:
+			SetInteractivityState(EMixerInteractivityState::Not_Interactive);
+			SetInteractiveConnectionAuthState(EMixerLoginState::Not_Logged_In);
+			break;
+		}
+		break;
+
+	case ESessionEventKind::ButtonInput:
+	case ESessionEventKind::CoordinateInput:
+	case ESessionEventKind::CustomInput:
+		{
+			TSharedPtr<FMixerRemoteUser> User = GetCachedUser(Event.ParticipantSessionGuid);
+			if (!User.IsValid() && Event.bParticipantRefetched)
+			{
+				User = RestoreEvictedUser(Event.Participant);
+			}
+			if (User.IsValid())
+			{
+				NoteUserInput(*User);
+			}
+
+			if (Event.Kind == ESessionEventKind::ButtonInput)
+			{
+				OnSessionButtonInput(User, Event);
+			}
+			else if (Event.Kind == ESessionEventKind::CoordinateInput)
+			{
+				OnSessionCoordinateInput(User, Event.ControlId, Event.Coordinates);
+			}
+			else
+			{
+				OnSessionCustomInput(User, Event);
+			}
+		}
+		break;
+
+	case ESessionEventKind::ParticipantChanged:
+		OnSessionParticipantChanged(Event);
+		break;
+
+	case ESessionEventKind::UnhandledMethod:
+		if (Event.Method == TEXT("onControlUpdate"))
+		{
+			HandleControlUpdateMessage(Event.Json.Get());
+		}
+		else
+		{
+			OnCustomMethodCall().Broadcast(*Event.Method, Event.Json.ToSharedRef());
+		}
+		break;
+
+	case ESessionEventKind::TransactionComplete:
+		CompleteSparkCapture(Event.TransactionId, Event.Action == MIXER_OK, Event.ErrorMessage);
+		break;
+
+	case ESessionEventKind::GroupBatchComplete:
+		{
+			FOnGroupBatchComplete OnComplete;
+			if (GroupBatchesInFlight.RemoveAndCopyValue(Event.RequestId, OnComplete))
+			{
+				if (Event.Action != MIXER_OK)
 				{
-					InteractiveModule.OnCustomMethodCall().Broadcast(*Method, ParamsObject->ToSharedRef());
+					UE_LOG(LogMixerInteractivity, Warning, TEXT("Group request %u failed (error %d): %s"), Event.RequestId, Event.Action, *Event.ErrorMessage);
 				}
+				OnComplete.ExecuteIfBound(Event.Action == MIXER_OK, Event.ErrorMessage);
+			}
+		}
+		break;
+
+	case ESessionEventKind::RemoteMethodReply:
+		{
+			FRemoteMethodCallInFlight InFlight;
+			if (RemoteMethodCallsInFlight.RemoveAndCopyValue(Event.RequestId, InFlight))
+			{
+				InFlight.OnReply.ExecuteIfBound(Event.Action == MIXER_OK, Event.Json, Event.ErrorMessage);
+			}
+		}
+		break;
+
+	default:
+		break;
+	}
+}
+
+void FMixerInteractivityModule_InteractiveCpp2::OnSessionButtonInput(TSharedPtr<const FMixerRemoteUser> User, const FSessionEvent& Event)
+{
+	SCOPE_CYCLE_COUNTER(STAT_MixerHandleSessionInput);
+
+	const int32 ButtonIndex = FindButton(Event.ControlId);
+	if (ButtonIndex != INDEX_NONE)
+	{
+		FMixerButtonState& State = TouchButtonState(ButtonIndex);
+		const FMixerButtonPropertiesCached& CachedProps = GetButtonPropertiesAt(ButtonIndex);
+		FMixerButtonEventDetails ButtonEventDetails;
+		ButtonEventDetails.Pressed = Event.Action == interactive_button_action_down;
+		ButtonEventDetails.TransactionId = Event.TransactionId;
+		ButtonEventDetails.SparkCost = CachedProps.Desc.SparkCost;
+
+		if (!AdmitButtonInput(User.Get(), Event.ControlId, ButtonEventDetails.Pressed, ButtonEventDetails.SparkCost > 0))
+		{
+			return;
+		}
+
+		if (ButtonEventDetails.Pressed)
+		{
+			State.DownCount += Event.SampleWeight;
+			if (CachePerParticipantState())
+			{
+				SetButtonHeldByParticipant(ButtonIndex, User->Id, true);
+			}
+		}
+		else
+		{
+			State.UpCount += 1;
+			// Even without per-participant state, as holds from before an adaptive switch may still be draining
+			SetButtonHeldByParticipant(ButtonIndex, User->Id, false);
+		}
+
+		BroadcastButtonEvent(Event.ControlId, User, ButtonEventDetails);
+		RecordButtonInput(Event.ControlId, User.Get(), ButtonEventDetails);
+	}
+}
+
+void FMixerInteractivityModule_InteractiveCpp2::OnSessionCoordinateInput(TSharedPtr<const FMixerRemoteUser> User, FName ControlId, FVector2D StickValue)
+{
+	SCOPE_CYCLE_COUNTER(STAT_MixerHandleSessionInput);
+
+	const int32 StickIndex = FindStick(ControlId);
+	if (StickIndex != INDEX_NONE && !FilterStickInput(StickIndex, User.Get(), StickValue))
+	{
+		return;
+	}
+
+	if (!AdmitParticipantInput(User.Get(), EMixerInputRateClass::Stick))
+	{
+		return;
+	}
+
+	DeliverOrCoalesceStickInput(ControlId, User, StickValue);
+}
+
+void FMixerInteractivityModule_InteractiveCpp2::DeliverStickInput(FName ControlId, TSharedPtr<const FMixerRemoteUser> Participant, FVector2D Value)
+{
+	if (CachePerParticipantState() && Participant.IsValid())
+	{
+		const int32 StickIndex = FindStick(ControlId);
+		if (StickIndex != INDEX_NONE)
+		{
+			SetStickValueForParticipant(StickIndex, Participant->Id, Value);
+		}
+	}
+
+	FMixerInteractivityModule_WithSessionState::DeliverStickInput(ControlId, Participant, Value);
+}
+
+bool FMixerInteractivityModule_InteractiveCpp2::OnSessionCustomInput(TSharedPtr<const FMixerRemoteUser> User, const FSessionEvent& Event)
+{
+	SCOPE_CYCLE_COUNTER(STAT_MixerHandleSessionInput);
+
+	const FName ControlId = Event.ControlId;
+	bool bHandled = false;
+	if (Event.InputEvent == MixerStringConstants::EventTypes::Submit)
+	{
+		FMixerTextboxPropertiesCached* Textbox = GetTextbox(ControlId);
+		if (Textbox != nullptr)
+		{
+			FMixerTextboxEventDetails EventDetails;
+			EventDetails.SubmittedText = FMixerLazyText(Event.InputValue);
+			EventDetails.SparkCost = 0;
+			if (Textbox->Desc.SparkCost > 0 && !Event.TransactionId.IsEmpty())
+			{
+				EventDetails.TransactionId = Event.TransactionId;
+				EventDetails.SparkCost = Textbox->Desc.SparkCost;
+			}
+
+			if (AdmitParticipantInput(User.Get(), EMixerInputRateClass::Textbox, EventDetails.SparkCost > 0))
+			{
+				BroadcastTextboxSubmitEvent(ControlId, User, EventDetails);
+				RecordTextboxInput(ControlId, User.Get(), EventDetails);
+			}
+			bHandled = true;
+		}
+	}
+
+	if (!bHandled && AdmitParticipantInput(User.Get(), EMixerInputRateClass::CustomControl))
+	{
+		if (!OnCustomControlInput().IsBound() && !WantsCustomControlInputRecorded(ControlId))
+		{
+			return true;
+		}
+
+		TSharedPtr<FJsonObject> FullParamsJson = Event.Json;
+		if (!FullParamsJson.IsValid())
+		{
+			// A submit from something other than a textbox, so the params weren't parsed up front
+			FUTF8ToTCHAR ConvertedParams(Event.Utf8Params.GetData(), Event.Utf8Params.Num());
+			TSharedRef<TJsonReader<>> JsonReader = TJsonReaderFactory<>::Create(FString(ConvertedParams.Length(), ConvertedParams.Get()));
+			if (!FJsonSerializer::Deserialize(JsonReader, FullParamsJson) || !FullParamsJson.IsValid())
+			{
+				return false;
+			}
+		}
+
+		// Alias so macros work
+		const FJsonObject* JsonObj = FullParamsJson.Get();
+		GET_JSON_OBJECT_RETURN_FAILURE(Input, InputObj);
+
+		OnCustomControlInput().Broadcast(ControlId, *Event.InputEvent, User, InputObj->ToSharedRef());
+		RecordCustomControlInput(ControlId, User.Get(), *InputObj->Get());
+	}
+
+	return true;
+}
+
+void FMixerInteractivityModule_InteractiveCpp2::OnSessionParticipantChanged(const FSessionEvent& Event)
+{
+	const interactive_participant_action Action = static_cast<interactive_participant_action>(Event.Action);
+	switch (Action)
+	{
+	case participant_join:
+		{
+			TSharedPtr<FMixerRemoteUser> NewUser = AllocateUser();
+			*NewUser = Event.Participant;
+			AddUser(NewUser);
+		}
+		break;
+
+	case participant_leave:
+		RemoveUser(Event.ParticipantSessionGuid);
+		break;
+
+	case participant_update:
+		{
+			TSharedPtr<FMixerRemoteUser> CachedParticipant = GetCachedUser(Event.ParticipantSessionGuid);
+			check(CachedParticipant.IsValid());
+			check(CachedParticipant->Id == Event.Participant.Id);
+			EMixerParticipantChange Changes = EMixerParticipantChange::None;
+			if (!CachedParticipant->Name.Equals(Event.Participant.Name, ESearchCase::CaseSensitive))
+			{
+				CachedParticipant->Name = Event.Participant.Name;
+				Changes |= EMixerParticipantChange::Name;
+			}
+			if (CachedParticipant->Level != Event.Participant.Level)
+			{
+				CachedParticipant->Level = Event.Participant.Level;
+				Changes |= EMixerParticipantChange::Level;
+			}
+			// FName comparison ignores case, and group ids that differ only by case are different groups
+			if (!CachedParticipant->Group.ToString().Equals(Event.Participant.Group.ToString(), ESearchCase::CaseSensitive))
+			{
+				SetUserGroup(CachedParticipant, Event.Participant.Group);
+				Changes |= EMixerParticipantChange::Group;
+			}
+			if (CachedParticipant->InputEnabled != Event.Participant.InputEnabled)
+			{
+				CachedParticipant->InputEnabled = Event.Participant.InputEnabled;
+				Changes |= EMixerParticipantChange::InputEnabled;
+			}
+			CachedParticipant->InputAt = Event.Participant.InputAt;
+			UpdateParticipantOrder(*CachedParticipant);
+
+			if (Changes != EMixerParticipantChange::None)
+			{
+				OnParticipantUpdated().Broadcast(CachedParticipant, Changes);
 			}
 		}
+		break;
+
+	default:
+		UE_LOG(LogMixerInteractivity, Error, TEXT("Unknown participant change type %d"), static_cast<int32>(Action));
+		break;
 	}
 }
 
 void FMixerInteractivityModule_InteractiveCpp2::OnTransactionComplete(void *Context, interactive_session Session, const char* TransactionId, size_t TransactionIdLength, unsigned int ErrorCode, const char* ErrorMessage, size_t ErrorMessageLength)
 {
-	if (ErrorCode != MIXER_OK)
+	FSessionEvent Event;
+	Event.Kind = ESessionEventKind::TransactionComplete;
+	Event.Action = static_cast<int32>(ErrorCode);
+	Event.TransactionId = FString(UTF8_TO_TCHAR(TransactionId));
+	if (ErrorMessage != nullptr)
+	{
+		Event.ErrorMessage = FString(UTF8_TO_TCHAR(ErrorMessage));
+	}
+	FromSessionContext(Context).HandleSessionEvent(MoveTemp(Event));
+}
+
+void FMixerInteractivityModule_InteractiveCpp2::OnGroupBatchComplete(void* Context, interactive_session Session, unsigned int RequestId, unsigned int ErrorCode, const char* ErrorMessage, size_t ErrorMessageLength)
+{
+	FSessionEvent Event;
+	Event.Kind = ESessionEventKind::GroupBatchComplete;
+	Event.Action = static_cast<int32>(ErrorCode);
+	Event.RequestId = RequestId;
+	if (ErrorMessage != nullptr)
 	{
-		UE_LOG(LogMixerInteractivity, Error, TEXT("Transaction completion error %d: %hs"), ErrorCode, ErrorMessage);
+		Event.ErrorMessage = FString(UTF8_TO_TCHAR(ErrorMessage));
 	}
+	FromSessionContext(Context).HandleSessionEvent(MoveTemp(Event));
 }
 
-void FMixerInteractivityModule_InteractiveCpp2::OnEnumerateForGetCurrentScene(void* Context, interactive_session Session, interactive_group* Group)
+void FMixerInteractivityModule_InteractiveCpp2::OnRemoteMethodReply(void* Context, interactive_session Session, unsigned int RequestId, unsigned int ErrorCode, const char* ErrorMessage, size_t ErrorMessageLength, const char* ResultJson, size_t ResultJsonLength)
 {
-	FGetCurrentSceneEnumContext* GetSceneContext = static_cast<FGetCurrentSceneEnumContext*>(Context);
-	if (GetSceneContext->GroupName == Group->id)
+	FSessionEvent Event;
+	Event.Kind = ESessionEventKind::RemoteMethodReply;
+	Event.Action = static_cast<int32>(ErrorCode);
+	Event.RequestId = RequestId;
+	if (ErrorMessage != nullptr)
+	{
+		Event.ErrorMessage = FString(UTF8_TO_TCHAR(ErrorMessage));
+	}
+	if (Event.Action == MIXER_OK)
 	{
-		GetSceneContext->OutSceneName = Group->sceneId;
+		// Only an explicit null result (as for updateControls) succeeds without an object.  A reply
+		// with no result at all, or one that doesn't parse, must not be mistaken for success.
+		if (ResultJson == nullptr)
+		{
+			Event.Action = MIXER_ERROR_NO_REPLY;
+			Event.ErrorMessage = TEXT("Reply had no result");
+		}
+		else if (FCStringAnsi::Strcmp(ResultJson, "null") != 0)
+		{
+			// Parsed here rather than on the game thread, as for unhandled methods
+			TSharedRef<TJsonReader<>> JsonReader = TJsonReaderFactory<>::Create(FString(UTF8_TO_TCHAR(ResultJson)));
+			if (!FJsonSerializer::Deserialize(JsonReader, Event.Json) || !Event.Json.IsValid())
+			{
+				Event.Action = MIXER_ERROR_JSON_PARSE;
+				Event.ErrorMessage = TEXT("Reply result could not be parsed");
+			}
+		}
 	}
+	FromSessionContext(Context).HandleSessionEvent(MoveTemp(Event));
+}
+
+void FMixerInteractivityModule_InteractiveCpp2::OnEnumerateForScenesByGroup(void* Context, interactive_session Session, interactive_group* Group)
+{
+	FromSessionContext(Context).ScenesByGroup.Add(FName(Group->id), FName(Group->sceneId));
+}
+
+void FMixerInteractivityModule_InteractiveCpp2::OnSessionGroupsChanged(void* Context, interactive_session Session)
+{
+	FMixerInteractivityModule_InteractiveCpp2& InteractiveModule = FromSessionContext(Context);
+	InteractiveModule.GroupsChangedCount.Increment();
+
+	// May be the session worker, so the game thread rebuilds the filter; until then it lets everything through
+	InteractiveModule.InputFilter.Invalidate();
 }
 
 void FMixerInteractivityModule_InteractiveCpp2::OnEnumerateScenesForInit(void* Context, interactive_session Session, interactive_scene* Scene)
 {
-	interactive_set_session_context(Session, Scene);
-	interactive_scene_get_controls(Session, Scene->id, &FMixerInteractivityModule_InteractiveCpp2::OnEnumerateControlsForInit);
-	interactive_set_session_context(Session, nullptr);
+	// The context stays bound to the module, so the scene being walked is passed on beside it
+	FMixerInteractivityModule_InteractiveCpp2& InteractiveModule = FromSessionContext(Context);
+	InteractiveModule.EnumeratingScene = Scene;
+	interactive_scene_get_controls_with_properties(Session, Scene->id, &FMixerInteractivityModule_InteractiveCpp2::OnEnumerateControlsForInit);
+	InteractiveModule.EnumeratingScene = nullptr;
 }
 
-void FMixerInteractivityModule_InteractiveCpp2::OnEnumerateControlsForInit(void* Context, interactive_session Session, interactive_control* Control)
+void FMixerInteractivityModule_InteractiveCpp2::OnEnumerateControlsForInit(void* Context, interactive_session Session, interactive_control* Control, const interactive_control_property* Properties, size_t PropertyCount)
 {
-	FMixerInteractivityModule_InteractiveCpp2& InteractiveModule = static_cast<FMixerInteractivityModule_InteractiveCpp2&>(IMixerInteractivityModule::Get());
-	interactive_scene* Scene = static_cast<interactive_scene*>(Context);
+	FMixerInteractivityModule_InteractiveCpp2& InteractiveModule = FromSessionContext(Context);
+	const interactive_scene* Scene = InteractiveModule.EnumeratingScene;
+
+	InteractiveModule.NoteControlScene(FName(Control->id), FName(Scene->id));
 
 	if (FPlatformString::Strcmp(Control->kind, "button") == 0)
 	{
 		FMixerButtonPropertiesCached CachedProps;
 
-		GetControlPropertyHelper(Session, Control->id, "cost", CachedProps.Desc.SparkCost);
-		GetControlPropertyHelper(Session, Control->id, "text", CachedProps.Desc.ButtonText);
-		GetControlPropertyHelper(Session, Control->id, "tooltip", CachedProps.Desc.HelpText);
-
-		CachedProps.State.DownCount = 0;
-		CachedProps.State.UpCount = 0;
-		CachedProps.State.PressCount = 0;
-		CachedProps.State.Enabled = true;
-		CachedProps.State.RemainingCooldown = FTimespan::Zero();
-		CachedProps.State.Progress = 0.0f;
+		GetControlPropertyHelper(Properties, PropertyCount, "cost", CachedProps.Desc.SparkCost);
+		GetControlPropertyHelper(Properties, PropertyCount, "text", CachedProps.Desc.ButtonText);
+		GetControlPropertyHelper(Properties, PropertyCount, "tooltip", CachedProps.Desc.HelpText);
 
 		CachedProps.SceneId = Scene->id;
 
-		InteractiveModule.AddButton(FName(Control->id), CachedProps);
+		FMixerButtonState InitialState;
+		InitialState.DownCount = 0;
+		InitialState.UpCount = 0;
+		InitialState.PressCount = 0;
+		InitialState.Enabled = true;
+		InitialState.RemainingCooldown = FTimespan::Zero();
+		InitialState.Progress = 0.0f;
+
+		InteractiveModule.AddButton(FName(Control->id), CachedProps, InitialState);
 	}
 	else if (FPlatformString::Strcmp(Control->kind, "joystick") == 0)
 	{
-		FMixerStickPropertiesCached CachedProps;
-		CachedProps.State.Enabled = true;
+		FMixerStickState InitialState;
+		InitialState.Axes = FVector2D(0, 0);
+		InitialState.Enabled = true;
 
-		InteractiveModule.AddStick(FName(Control->id), CachedProps);
+		InteractiveModule.AddStick(FName(Control->id), FMixerStickPropertiesCached(), InitialState);
 	}
 	else if (FPlatformString::Strcmp(Control->kind, "label") == 0)
 	{
 		FMixerLabelPropertiesCached CachedProps;
-		GetControlPropertyHelper(Session, Control->id, "text", CachedProps.Desc.Text);
-		GetControlPropertyHelper(Session, Control->id, "textSize", CachedProps.Desc.TextSize);
-		GetControlPropertyHelper(Session, Control->id, "underline", CachedProps.Desc.Underline);
-		GetControlPropertyHelper(Session, Control->id, "bold", CachedProps.Desc.Bold);
-		GetControlPropertyHelper(Session, Control->id, "italic", CachedProps.Desc.Italic);
+		GetControlPropertyHelper(Properties, PropertyCount, "text", CachedProps.Desc.Text);
+		GetControlPropertyHelper(Properties, PropertyCount, "textSize", CachedProps.Desc.TextSize);
+		GetControlPropertyHelper(Properties, PropertyCount, "underline", CachedProps.Desc.Underline);
+		GetControlPropertyHelper(Properties, PropertyCount, "bold", CachedProps.Desc.Bold);
+		GetControlPropertyHelper(Properties, PropertyCount, "italic", CachedProps.Desc.Italic);
 
 		CachedProps.SceneId = Scene->id;
 
@@ -615,11 +1952,11 @@ void FMixerInteractivityModule_InteractiveCpp2::OnEnumerateControlsForInit(void*
 	else if (FPlatformString::Strcmp(Control->kind, "textbox") == 0)
 	{
 		FMixerTextboxPropertiesCached Textbox;
-		GetControlPropertyHelper(Session, Control->id, "placeholder", Textbox.Desc.Placeholder);
-		GetControlPropertyHelper(Session, Control->id, "cost", Textbox.Desc.SparkCost);
-		GetControlPropertyHelper(Session, Control->id, "hasSubmit", Textbox.Desc.HasSubmit);
-		GetControlPropertyHelper(Session, Control->id, "multiline", Textbox.Desc.Multiline);
-		GetControlPropertyHelper(Session, Control->id, "submitText", Textbox.Desc.SubmitText);
+		GetControlPropertyHelper(Properties, PropertyCount, "placeholder", Textbox.Desc.Placeholder);
+		GetControlPropertyHelper(Properties, PropertyCount, "cost", Textbox.Desc.SparkCost);
+		GetControlPropertyHelper(Properties, PropertyCount, "hasSubmit", Textbox.Desc.HasSubmit);
+		GetControlPropertyHelper(Properties, PropertyCount, "multiline", Textbox.Desc.Multiline);
+		GetControlPropertyHelper(Properties, PropertyCount, "submitText", Textbox.Desc.SubmitText);
 
 		InteractiveModule.AddTextbox(FName(Control->id), Textbox);
 	}
@@ -14,55 +14,298 @@
 #if MIXER_BACKEND_INTERACTIVE_CPP_2
 
 #include "MixerInteractivityTypes.h"
+#include "MixerInteractiveHostsCache.h"
+#include "MixerTrace.h"
+#include "MixerTrafficRecorder.h"
+#include "Containers/Queue.h"
+#include "HAL/ThreadSafeCounter.h"
+#include "Misc/ScopeLock.h"
 #include <interactive-cpp-v2/interactivity.h>
 
+class FRunnableThread;
+
 class FMixerInteractivityModule_InteractiveCpp2
 	: public FMixerInteractivityModule_WithSessionState
 {
+public:
+	FMixerInteractivityModule_InteractiveCpp2();
+
 public:
 	virtual void StartInteractivity();
 	virtual void StopInteractivity();
 	virtual void SetCurrentScene(FName Scene, FName GroupName = NAME_None);
+	virtual bool SetScenesForGroups(TArrayView<const FMixerGroupSpec> Assignments, const FOnGroupBatchComplete& OnComplete = FOnGroupBatchComplete());
 	virtual FName GetCurrentScene(FName GroupName = NAME_None);
 	virtual void TriggerButtonCooldown(FName Button, FTimespan CooldownTime) override;
 	virtual bool CreateGroup(FName GroupName, FName InitialScene = NAME_None);
+	virtual bool CreateGroups(TArrayView<const FMixerGroupSpec> Groups, const FOnGroupBatchComplete& OnComplete = FOnGroupBatchComplete());
 	virtual bool MoveParticipantToGroup(FName GroupName, uint32 ParticipantId);
-	virtual void CaptureSparkTransaction(const FString& TransactionId);
+	virtual bool MoveParticipantsToGroup(FName GroupName, TArrayView<const uint32> ParticipantIds);
+	virtual bool SetBandwidthThrottle(EMixerBandwidthThrottleType ThrottleType, uint32 MaxBytes, uint32 BytesPerSecond);
 	virtual void CallRemoteMethod(const FString& MethodName, const TSharedRef<FJsonObject> MethodParams);
+	virtual void CallRemoteMethodSerialized(const FString& MethodName, TArrayView<const uint8> Utf8Params);
+	virtual bool CallRemoteMethodAsync(const FString& MethodName, const TSharedRef<FJsonObject> MethodParams, const FOnRemoteMethodReply& OnReply);
 
 public:
 	virtual bool Tick(float DeltaTime) override;
+	virtual void GetContainerSizes(TFunctionRef<void(const TCHAR* Name, int64 Size)> Visit) const override;
+
+#if MIXER_BENCHMARKS_ENABLED
+	virtual bool BeginBenchmarkSession(const FString& ScenesResult) override;
+	virtual void ReceiveBenchmarkFrame(const FString& Frame) override;
+	virtual void PumpBenchmarkSession() override;
+	virtual void EndBenchmarkSession() override;
+#endif
 
 protected:
 	virtual bool StartInteractiveConnection();
 	virtual void StopInteractiveConnection();
+	virtual void PrefetchInteractiveHosts();
+	virtual void OnAccessTokenRefreshed() override;
+	virtual void SendSparkCapture(const FString& TransactionId);
 
-private:
+	virtual void OnUserEvicted(const FMixerRemoteUser& User) override;
+	virtual void DeliverStickInput(FName ControlId, TSharedPtr<const FMixerRemoteUser> Participant, FVector2D Value) override;
 
+private:
 	static void OnSessionStateChanged(void* Context, interactive_session Session, interactive_state PreviousState, interactive_state NewState);
 	static void OnSessionError(void* Context, interactive_session Session, int ErrorCode, const char* ErrorMessage, size_t ErrorMessageLength);
 	static void OnSessionInput(void* Context, interactive_session Session, const interactive_input* Input);
 	static void OnSessionParticipantsChanged(void* Context, interactive_session Session, interactive_participant_action Action, const interactive_participant* Participant);
 	static void OnUnhandledMethod(void* Context, interactive_session Session, const char* MethodJson, size_t MethodJsonLength);
 	static void OnTransactionComplete(void *Context, interactive_session Session, const char* TransactionId, size_t TransactionIdLength, unsigned int ErrorCode, const char* ErrorMessage, size_t ErrorMessageLength);
+	static void OnGroupBatchComplete(void* Context, interactive_session Session, unsigned int RequestId, unsigned int ErrorCode, const char* ErrorMessage, size_t ErrorMessageLength);
+	static void OnRemoteMethodReply(void* Context, interactive_session Session, unsigned int RequestId, unsigned int ErrorCode, const char* ErrorMessage, size_t ErrorMessageLength, const char* ResultJson, size_t ResultJsonLength);
+
+	enum class ESessionEventKind : uint8
+	{
+		StateChanged,
+		ButtonInput,
+		CoordinateInput,
+		CustomInput,
+		ParticipantChanged,
+		UnhandledMethod,
+		TransactionComplete,
+		GroupBatchComplete,
+		RemoteMethodReply,
+	};
+
+	/** Plugin-side copy of an SDK callback, holding nothing that points back into SDK memory */
+	struct FSessionEvent
+	{
+		ESessionEventKind Kind;
+
+		// interactive_state, interactive_button_action, interactive_participant_action or error code depending on Kind
+		int32 Action;
+
+		FName ControlId;
+		FGuid ParticipantSessionGuid;
+		FVector2D Coordinates;
+		FString TransactionId;
+		FString Method;
+		FString ErrorMessage;
+
+		// Full input params for CustomInput (unless the SDK's typed fields were enough, see OnSessionInput), method params for UnhandledMethod, result for RemoteMethodReply
+		TSharedPtr<FJsonObject> Json;
 
-	void OnSessionButtonInput(TSharedPtr<const FMixerRemoteUser> User, const interactive_input* Input);
-	void OnSessionCoordinateInput(TSharedPtr<const FMixerRemoteUser> User, const interactive_input* Input);
-	bool OnSessionCustomInput(TSharedPtr<const FMixerRemoteUser> User, const interactive_input* Input);
+		// CustomInput: event type and string value as read by the SDK, plus the raw UTF-8 params for when Json wasn't parsed
+		FString InputEvent;
+		FString InputValue;
+		TArray<ANSICHAR> Utf8Params;
 
-	struct FGetCurrentSceneEnumContext
+		// Populated for participant joins and updates, and for input from a participant evicted from the cache
+		FMixerRemoteUser Participant;
+		bool bParticipantRefetched;
+
+		// FPlatformTime::Seconds() when the SDK handed the event over
+		double ReceivedTime;
+
+		// Matches the dispatch trace event to the one emitted when the SDK handed the event over
+		int32 TraceSequence;
+
+		// GroupBatchComplete and RemoteMethodReply: the request id passed to the SDK, see GroupBatchesInFlight and RemoteMethodCallsInFlight
+		uint32 RequestId;
+
+		// ButtonInput: how many presses this one stands for under input sampling, see FMixerInputSampler
+		uint32 SampleWeight;
+
+		FSessionEvent()
+			: Kind(ESessionEventKind::StateChanged)
+			, Action(0)
+			, Coordinates(0, 0)
+			, bParticipantRefetched(false)
+			, ReceivedTime(0.0)
+			, TraceSequence(INDEX_NONE)
+			, RequestId(0)
+			, SampleWeight(1)
+		{
+		}
+	};
+
+	/** On the thread running interactive_run: copy an evicted participant's details from the SDK roster into an input event. */
+	bool RefetchEvictedParticipant(interactive_session Session, const char* ParticipantId, FSessionEvent& Event);
+	void ForgetEvictedSessionGuid(const FGuid& ParticipantSessionGuid);
+
+	/** Every session callback receives the owning module as its context; see interactive_set_session_context in StartSession. */
+	static FMixerInteractivityModule_InteractiveCpp2& FromSessionContext(void* Context)
 	{
-		FName GroupName;
-		FName OutSceneName;
+		check(Context != nullptr);
+		return *static_cast<FMixerInteractivityModule_InteractiveCpp2*>(Context);
+	}
+
+	void HandleSessionEvent(FSessionEvent&& Event);
+	void DispatchSessionEvent(const FSessionEvent& Event);
+#if MIXER_TRACE_ENABLED
+	static FString GetSessionEventTraceName(const FSessionEvent& Event);
+#endif
+#if MIXER_TRAFFIC_RECORDER_ENABLED
+	// The SDK only surfaces its frames as trace-level debug output, so that is switched on while recording
+	static void OnSdkDebugMessage(const interactive_debug_level Level, const char* Message, size_t MessageLength);
+	void UpdateSdkTrafficCapture();
+#endif
+
+	void OnSessionButtonInput(TSharedPtr<const FMixerRemoteUser> User, const FSessionEvent& Event);
+	void OnSessionCoordinateInput(TSharedPtr<const FMixerRemoteUser> User, FName ControlId, FVector2D StickValue);
+	bool OnSessionCustomInput(TSharedPtr<const FMixerRemoteUser> User, const FSessionEvent& Event);
+	void OnSessionParticipantChanged(const FSessionEvent& Event);
+
+	void PumpEvents();
+	uint32 GetPendingEventCount() const;
+
+	// Order in which staged events are handed to the game while the pump is overloaded
+	enum class EStagedEventTier : uint8
+	{
+		Paid,
+		Control,
+		Other,
+		Move,
+		Count
 	};
 
-	static void OnEnumerateForGetCurrentScene(void* Context, interactive_session Session, interactive_group* Group);
+	EStagedEventTier GetStagedEventTier(const FSessionEvent& Event);
+	void StageSessionEvent(FSessionEvent&& Event);
+	void DispatchStagedSessionEvents(double PumpDeadline);
+	uint32 GetStagedEventCount() const;
+	void ResetStagedSessionEvents();
+	void StartSessionWorker();
+	void StopSessionWorker();
+
+	void RefreshScenesByGroup();
+	virtual void GetActiveScenes(TSet<FName>& OutScenes) override;
+	static void OnEnumerateForScenesByGroup(void* Context, interactive_session Session, interactive_group* Group);
+	static void OnSessionGroupsChanged(void* Context, interactive_session Session);
 
 	static void OnEnumerateScenesForInit(void* Context, interactive_session Session, interactive_scene* Scene);
-	static void OnEnumerateControlsForInit(void* Context, interactive_session Session, interactive_control* Control);
+	static void OnEnumerateControlsForInit(void* Context, interactive_session Session, interactive_control* Control, const interactive_control_property* Properties, size_t PropertyCount);
+
+	typedef int (*FSdkGroupBatchFunction)(interactive_session, const interactive_group_scene*, size_t, unsigned int, on_groups_method_complete);
+	bool SendGroupBatch(FSdkGroupBatchFunction SdkFunction, TArrayView<const FMixerGroupSpec> Groups, const FOnGroupBatchComplete& OnComplete);
+	void AbandonGroupBatches();
+
+	void ExpireRemoteMethodCalls(double Now);
+	void AbandonRemoteMethodCalls();
+
+	void ApplyConfiguredThrottles();
+	void UpdateAdaptiveInputThrottle(float DeltaTime);
+
+	void OnHostsReceived(const TArray<FString>& Hosts);
+	void OpenSession(const TArray<FString>& Hosts);
+	void OnSessionOpenComplete();
+	/** Register for the session's callbacks and pick up its scenes, once InteractiveSession is open. */
+	void BindOpenedSession();
+	static void OnSessionOpened(void* Context, interactive_session Session, int Result, const interactive_open_timing* Timing);
 
 	interactive_session InteractiveSession;
-	TFuture<interactive_session> ConnectOperation;
+
+	// Open in progress.  The session handle is only promoted to InteractiveSession once the SDK reports it ready.
+	struct FSessionOpenState
+	{
+		FThreadSafeCounter Completed;
+		int32 Result;
+		interactive_open_timing Timing;
+	};
+
+	TSharedRef<FMixerInteractiveHostsCache> HostsCache;
+	interactive_session OpeningSession;
+	FSessionOpenState OpenState;
+	double OpenStartTime;
+	double HostLookupMs;
+
+	// Adaptive input throttle state.  Ceiling is the configured (or last explicitly set) rate.
+	uint32 InputThrottleCapacity;
+	uint32 InputThrottleCeiling;
+	uint32 InputThrottleCurrent;
+	int32 OverloadedFrames;
+	int32 HealthyFrames;
+
+	// Events left in the SDK queue (and the worker queue) after the last pump
+	uint32 EventBacklog;
+
+	struct FStagedMoveKey
+	{
+		FName ControlId;
+		FGuid ParticipantSessionGuid;
+
+		bool operator==(const FStagedMoveKey& Other) const
+		{
+			return ControlId == Other.ControlId && ParticipantSessionGuid == Other.ParticipantSessionGuid;
+		}
+
+		friend uint32 GetTypeHash(const FStagedMoveKey& Key)
+		{
+			return HashCombine(GetTypeHash(Key.ControlId), GetTypeHash(Key.ParticipantSessionGuid));
+		}
+	};
+
+	// Events pulled off the queues but not yet dispatched, while input is being prioritized.  Only the
+	// latest move per (stick, participant) is kept.  Participants with a join, leave or update still
+	// staged keep their paid input behind it so it isn't seen before the participant is.
+	TArray<FSessionEvent> StagedSessionEvents[static_cast<int32>(EStagedEventTier::Count)];
+	TMap<FStagedMoveKey, int32> StagedMoveIndex;
+	TMap<FGuid, int32> StagedParticipantChanges;
+	bool bStagingSessionEvents;
+
+	// Worker thread mode.  bQueueSessionEvents is set before the thread starts and cleared after it has been joined.
+	class FSessionWorker;
+	FSessionWorker* SessionWorker;
+	FRunnableThread* SessionWorkerThread;
+	bool bQueueSessionEvents;
+	TQueue<FSessionEvent, EQueueMode::Spsc> PendingSessionEvents;
+	FThreadSafeCounter PendingSessionEventCount;
+
+	// Local copy of the SDK's group to scene cache, refreshed when GroupsChangedCount moves past ScenesByGroupChangeCount
+	TMap<FName, FName> ScenesByGroup;
+	int32 ScenesByGroupChangeCount;
+	FThreadSafeCounter GroupsChangedCount;
+
+	// Scene whose controls are being walked by OnEnumerateControlsForInit
+	const interactive_scene* EnumeratingScene;
+
+	// CreateGroups/SetScenesForGroups requests awaiting a reply, by the request id given to the SDK
+	TMap<uint32, FOnGroupBatchComplete> GroupBatchesInFlight;
+	uint32 NextGroupBatchId;
+
+	struct FRemoteMethodCallInFlight
+	{
+		FOnRemoteMethodReply OnReply;
+		double SentAt;
+	};
+
+	// CallRemoteMethodAsync requests awaiting a reply, by the request id given to the SDK
+	TMap<uint32, FRemoteMethodCallInFlight> RemoteMethodCallsInFlight;
+	uint32 NextRemoteMethodCallId;
+
+	// UTF-8 params for CallRemoteMethod, kept to reuse the allocation
+	TArray<uint8> RemoteMethodParamsBuffer;
+
+	// Participants evicted on the game thread, for the SDK callbacks to re-fetch.  The count lets input skip the lock.
+	TSet<FGuid> EvictedSessionGuids;
+	FCriticalSection EvictedSessionGuidsLock;
+	FThreadSafeCounter NumEvictedSessionGuids;
+
+#if MIXER_TRAFFIC_RECORDER_ENABLED
+	bool bSdkTrafficCaptureActive;
+#endif
 };
 
 #endif
\ No newline at end of file
@@ -19,27 +19,71 @@ public:
 	virtual void StartInteractivity() {}
 	virtual void StopInteractivity() {}
 	virtual void SetCurrentScene(FName Scene, FName GroupName = NAME_None) {}
+	virtual bool SetScenesForGroups(TArrayView<const FMixerGroupSpec> Assignments, const FOnGroupBatchComplete& OnComplete = FOnGroupBatchComplete()) { return false; }
+	virtual void BeginStagedSceneChange(FName Scene, FName GroupName = NAME_None) {}
+	virtual void CommitStagedSceneChange() {}
 	virtual FName GetCurrentScene(FName GroupName = NAME_None) { return NAME_None; }
 	virtual void TriggerButtonCooldown(FName Button, FTimespan CooldownTime) {}
 	virtual bool GetButtonDescription(FName Button, FMixerButtonDescription& OutDesc) { return false; }
 	virtual bool GetButtonState(FName Button, FMixerButtonState& OutState) { return false; }
 	virtual bool GetButtonState(FName Button, uint32 ParticipantId, FMixerButtonState& OutState) { return false; }
+	virtual bool GetButtonState(FName Button, FName GroupName, FMixerButtonState& OutState) { return false; }
 	virtual bool GetStickDescription(FName Stick, FMixerStickDescription& OutDesc) { return false; }
 	virtual bool GetStickState(FName Stick, FMixerStickState& OutState) { return false; }
 	virtual bool GetStickState(FName Stick, uint32 ParticipantId, FMixerStickState& OutState) { return false; }
+	virtual bool ResolveButton(FName Button, FMixerControlHandle& InOutHandle) { return false; }
+	virtual bool ResolveStick(FName Stick, FMixerControlHandle& InOutHandle) { return false; }
+	virtual void TriggerButtonCooldown(FMixerControlHandle Button, FTimespan CooldownTime) {}
+	virtual bool GetButtonDescription(FMixerControlHandle Button, FMixerButtonDescription& OutDesc) { return false; }
+	virtual bool GetButtonState(FMixerControlHandle Button, FMixerButtonState& OutState) { return false; }
+	virtual bool GetButtonState(FMixerControlHandle Button, uint32 ParticipantId, FMixerButtonState& OutState) { return false; }
+	virtual bool GetButtonState(FMixerControlHandle Button, FName GroupName, FMixerButtonState& OutState) { return false; }
+	virtual bool GetStickState(FMixerControlHandle Stick, FMixerStickState& OutState) { return false; }
+	virtual bool GetStickState(FMixerControlHandle Stick, uint32 ParticipantId, FMixerStickState& OutState) { return false; }
+	virtual void SetControlsEnabled(TArrayView<const FMixerControlHandle> Buttons, bool bEnabled) {}
+	virtual void TriggerCooldownForScene(FName Scene, FTimespan CooldownTime) {}
+	virtual void SetProgressForControls(TArrayView<const TPair<FMixerControlHandle, float>> Progress) {}
+	virtual bool GetStickAggregate(FName Stick, FMixerStickAggregate& OutAggregate) { return false; }
+	virtual bool GetStickAggregate(FMixerControlHandle Stick, FMixerStickAggregate& OutAggregate) { return false; }
+	virtual bool GetStickAggregate(FName Stick, FName GroupName, FMixerStickAggregate& OutAggregate) { return false; }
+	virtual bool GetStickAggregate(FMixerControlHandle Stick, FName GroupName, FMixerStickAggregate& OutAggregate) { return false; }
+	virtual bool EnableCoordinateHeatmap(FName ControlId, const FMixerCoordinateHeatmapSettings& Settings) { return false; }
+	virtual void DisableCoordinateHeatmap(FName ControlId) {}
+	virtual bool GetCoordinateHeatmap(FName ControlId, TArrayView<const float>& OutCells, int32& OutWidth, int32& OutHeight) { return false; }
+	virtual bool EnableInputSketches(FName ControlId, const FMixerInputSketchSettings& Settings) { return false; }
+	virtual void DisableInputSketches(FName ControlId) {}
+	virtual bool GetMostActiveParticipants(FName ControlId, int32 MaxCount, TArray<FMixerActiveParticipant>& OutParticipants) { return false; }
+	virtual bool GetDistinctParticipantCount(FName ControlId, int32& OutCount) { return false; }
+	virtual bool EnableActivityTimeSeries(FName ControlId, const FMixerActivitySeriesSettings& Settings) { return false; }
+	virtual void DisableActivityTimeSeries(FName ControlId) {}
+	virtual bool GetActivityTimeSeries(FName ControlId, TArrayView<const float>& OutSamples, float& OutBucketSeconds) { return false; }
+	virtual int32 StartVoteRound(const FMixerVoteRoundSettings& Settings) { return INDEX_NONE; }
+	virtual bool CloseVoteRound(int32 RoundId, FMixerVoteRoundResult& OutResult) { return false; }
+	virtual bool GetVoteTallies(int32 RoundId, TArrayView<const int32>& OutTallies) { return false; }
 	virtual void SetLabelText(FName Label, const FText& DisplayText) {}
 	virtual bool GetLabelDescription(FName Label, FMixerLabelDescription& OutDesc) { return false; }
 	virtual bool GetTextboxDescription(FName Textbox, FMixerTextboxDescription& OutDesc) { return false; }
 	virtual TSharedPtr<const FMixerRemoteUser> GetParticipant(uint32 ParticipantId) { return nullptr; }
 	virtual bool CreateGroup(FName GroupName, FName InitialScene = NAME_None) { return false; }
+	virtual bool CreateGroups(TArrayView<const FMixerGroupSpec> Groups, const FOnGroupBatchComplete& OnComplete = FOnGroupBatchComplete()) { return false; }
 	virtual bool GetParticipantsInGroup(FName GroupName, TArray<TSharedPtr<const FMixerRemoteUser>>& OutParticipants) { return false; }
+	virtual TArrayView<const TSharedPtr<const FMixerRemoteUser>> ViewParticipantsInGroup(FName GroupName) { return TArrayView<const TSharedPtr<const FMixerRemoteUser>>(); }
+	virtual int32 GetParticipantsPage(FName GroupName, EMixerParticipantSortKey SortKey, int32 Offset, int32 Count, TArray<TSharedPtr<const FMixerRemoteUser>>& OutParticipants, bool bDescending) { return 0; }
+	virtual bool ReadSessionSnapshot(TFunctionRef<void(const FMixerSessionSnapshot&)> Reader) { return false; }
+	virtual FMixerInputJournalCursor OpenInputJournalCursor(float RewindSeconds) { return FMixerInputJournalCursor(); }
+	virtual int32 ReadInputJournal(FMixerInputJournalCursor& Cursor, TArray<FMixerInputEvent>& OutEvents, int32 MaxEvents) { return 0; }
+	virtual bool GetInputSamplingState(FMixerInputSamplingState& OutState) { return false; }
 	virtual bool MoveParticipantToGroup(FName GroupName, uint32 ParticipantId) { return false; }
-	virtual void CaptureSparkTransaction(const FString& TransactionId) {}
+	virtual bool MoveParticipantsToGroup(FName GroupName, TArrayView<const uint32> ParticipantIds) { return false; }
+	virtual bool SetBandwidthThrottle(EMixerBandwidthThrottleType ThrottleType, uint32 MaxBytes, uint32 BytesPerSecond) { return false; }
 	virtual void CallRemoteMethod(const FString& MethodName, const TSharedRef<FJsonObject> MethodParams) {}
+	virtual void CallRemoteMethodSerialized(const FString& MethodName, TArrayView<const uint8> Utf8Params) {}
+	virtual bool CallRemoteMethodAsync(const FString& MethodName, const TSharedRef<FJsonObject> MethodParams, const FOnRemoteMethodReply& OnReply) { return false; }
 
 protected:
 	virtual bool StartInteractiveConnection() { return false; }
 	virtual void StopInteractiveConnection() {}
+	virtual void SendSparkCapture(const FString& TransactionId) {}
 };
 
 #endif // MIXER_BACKEND_NULL
@@ -12,11 +12,17 @@
 
 #if MIXER_BACKEND_UE
 #include "MixerInteractivityLog.h"
+#include "MixerInteractivityStats.h"
 #include "MixerInteractivitySettings.h"
 #include "MixerInteractivityUserSettings.h"
 #include "MixerInteractivityBlueprintLibrary.h"
 #include "MixerJsonHelpers.h"
+#include "MixerJsonSchema.h"
+#include "MixerJsonArena.h"
 #include "MixerInteractivityJsonTypes.h"
+#include "MixerInteractivityProjectAsset.h"
+#include "MixerWarmStartCache.h"
+#include "MixerProjectAssetPreloader.h"
 #include "HttpModule.h"
 #include "PlatformHttp.h"
 #include "WebsocketsModule.h"
@@ -28,6 +34,12 @@
 
 IMPLEMENT_MODULE(FMixerInteractivityModule_UE, MixerInteractivity);
 
+DECLARE_CYCLE_STAT(TEXT("Handle giveInput"), STAT_MixerHandleGiveInput, STATGROUP_MixerInteractivity);
+DECLARE_CYCLE_STAT(TEXT("Handle participant changes"), STAT_MixerHandleParticipants, STATGROUP_MixerInteractivity);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Participants joined"), STAT_MixerParticipantsJoined, STATGROUP_MixerInteractivity);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Participants left"), STAT_MixerParticipantsLeft, STATGROUP_MixerInteractivity);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Participants updated"), STAT_MixerParticipantsUpdated, STATGROUP_MixerInteractivity);
+
 struct FMixerReadyMessageParams : public FJsonSerializable
 {
 public:
@@ -38,66 +50,167 @@ public:
 	END_JSON_SERIALIZER
 };
 
-struct FMixerUpdateGroupMessageParamsEntry : public FJsonSerializable
+struct FMixerCaptureTransactionParams : public FJsonSerializable
 {
 public:
-	FString GroupId;
-	FString SceneId;
+	FString TransactionId;
 public:
 	BEGIN_JSON_SERIALIZER
-		JSON_SERIALIZE("groupID", GroupId);
-		JSON_SERIALIZE("sceneID", SceneId);
+		JSON_SERIALIZE("transactionID", TransactionId);
 	END_JSON_SERIALIZER
 };
 
-struct FMixerUpdateGroupMessageParams : public FJsonSerializable
+
+FMixerInteractivityModule_UE::FMixerInteractivityModule_UE()
+	: TMixerWebSocketOwnerBase<FMixerInteractivityModule_UE>(MixerStringConstants::MessageTypes::Method, MixerStringConstants::FieldNames::Method, MixerStringConstants::FieldNames::Params)
+	, EndpointSelector(MakeShared<FMixerEndpointSelector>())
+	, HostsCache(MakeShared<FMixerInteractiveHostsCache>())
+	, bAwaitingHostsRefresh(false)
+	, bSessionSeeded(false)
+	, SeededScenesHash(0)
+	, bProjectDefinitionSeedPending(false)
+	, bUnparsedSceneIndexBuilt(false)
+	, NextReconnectTime(0.0)
+	, ParticipantReconcileTime(0.0)
+	, ReconnectAttempts(0)
+	, bResumingSession(false)
+	, bResumeInteractivity(false)
+	, EvictedParticipantRequestTime(0.0)
 {
-public:
-	TArray<FMixerUpdateGroupMessageParamsEntry> Groups;
-public:
-	BEGIN_JSON_SERIALIZER
-		JSON_SERIALIZE_ARRAY_SERIALIZABLE("groups", Groups, FMixerUpdateGroupMessageParamsEntry);
-	END_JSON_SERIALIZER
-};
+}
+
+// Time allowed after a resumed hello for the service to re-announce participants that are still present.
+static const double ResumedParticipantGraceSeconds = 5.0;
+
+// Input held for evicted participants while they're fetched again, and how long to wait for that fetch.
+static const int32 MaxInputAwaitingParticipants = 256;
+static const double EvictedParticipantRequestTimeout = 10.0;
+static const double SparkCaptureReplyTimeout = 30.0;
+static const double GroupBatchReplyTimeout = 30.0;
+static const double RemoteMethodReplyTimeout = 30.0;
 
-struct FMixerUpdateParticipantGroupParamsEntry : public FJsonSerializable
+void FMixerInteractivityModule_UE::GetContainerSizes(TFunctionRef<void(const TCHAR* Name, int64 Size)> Visit) const
 {
-public:
-	FString ParticipantSessionGuid;
-	FString GroupId;
-public:
-	BEGIN_JSON_SERIALIZER
-		JSON_SERIALIZE("sessionID", ParticipantSessionGuid);
-		JSON_SERIALIZE("groupID", GroupId);
-	END_JSON_SERIALIZER
-};
+	FMixerInteractivityModule_WithSessionState::GetContainerSizes(Visit);
+
+	Visit(TEXT("Participants.Unconfirmed"), UnconfirmedParticipants.Num());
+	Visit(TEXT("Participants.Parked"), ParkedParticipants.Num());
+	Visit(TEXT("Participants.InputAwaiting"), InputAwaitingParticipants.Num());
+	Visit(TEXT("Replies.Interactive"), GetNumPendingReplies());
+	Visit(TEXT("Replies.SparkCaptures"), SparkCapturesInFlight.Num());
+	Visit(TEXT("Replies.GroupBatches"), GroupBatchesInFlight.Num());
+	Visit(TEXT("Replies.RemoteMethodCalls"), RemoteMethodCallsInFlight.Num());
+}
 
-struct FMixerUpdateParticipantGroupParams : public FJsonSerializable
+bool FMixerInteractivityModule_UE::Tick(float DeltaTime)
 {
-public:
-	TArray<FMixerUpdateParticipantGroupParamsEntry> Participants;
-public:
-	BEGIN_JSON_SERIALIZER
-		JSON_SERIALIZE_ARRAY_SERIALIZABLE("participants", Participants, FMixerUpdateParticipantGroupParamsEntry);
-	END_JSON_SERIALIZER
-};
+	// Base tick resets per-frame input counters, so pump afterwards to keep
+	// messages parsed off the game thread visible for the coming frame.
+	FMixerInteractivityModule_WithSessionState::Tick(DeltaTime);
 
-struct FMixerCaptureTransactionParams : public FJsonSerializable
+	// Base tick has already queued this frame's control updates
+	if (IsInputDispatchStep())
+	{
+		TickConnection();
+		FlushCoalescedStickInput();
+		FlushInputBatch();
+	}
+
+	const double Now = FPlatformTime::Seconds();
+	if (NextReconnectTime > 0.0 && Now >= NextReconnectTime)
+	{
+		NextReconnectTime = 0.0;
+		OpenWebSocket();
+	}
+
+	if (!IsProcessingStep())
+	{
+		return true;
+	}
+
+	if (ParticipantReconcileTime > 0.0 && Now >= ParticipantReconcileTime)
+	{
+		ParticipantReconcileTime = 0.0;
+		ReconcileResumedParticipants();
+	}
+
+	if (ParkedParticipants.Num() > 0)
+	{
+		ExpireParkedParticipants(Now);
+	}
+
+	if (SparkCapturesInFlight.Num() > 0)
+	{
+		ExpireSparkCaptures(Now);
+	}
+
+	if (GroupBatchesInFlight.Num() > 0)
+	{
+		ExpireGroupBatches(Now);
+	}
+
+	if (RemoteMethodCallsInFlight.Num() > 0)
+	{
+		ExpireRemoteMethodCalls(Now);
+	}
+
+	return true;
+}
+
+#if MIXER_BENCHMARKS_ENABLED
+bool FMixerInteractivityModule_UE::BeginBenchmarkSession(const FString& ScenesResult)
 {
-public:
-	FString TransactionId;
-public:
-	BEGIN_JSON_SERIALIZER
-		JSON_SERIALIZE("transactionID", TransactionId);
-	END_JSON_SERIALIZER
-};
+	// The session is torn down through the usual path afterwards, which would sign a real user out
+	if (GetLoginState() != EMixerLoginState::Not_Logged_In || GetInteractiveConnectionAuthState() != EMixerLoginState::Not_Logged_In)
+	{
+		return false;
+	}
+
+	const UMixerInteractivitySettings* Settings = GetDefault<UMixerInteractivitySettings>();
+	SetInteractiveConnectionAuthState(EMixerLoginState::Logging_In);
+	StartSession(Settings->bPerParticipantStateCaching, Settings->ExpectedAudienceSize);
+	ResetUnparsedScenes();
+	bSessionSeeded = false;
+	SeededScenesHash = 0;
+	InitBenchmarkConnection(TEXT("interactive"));
+
+	// Same handshake as a live session: hello, then the answer to the getScenes that sends
+	ReceiveBenchmarkFrame(TEXT("{\"type\":\"method\",\"method\":\"hello\",\"params\":{},\"discard\":true}"));
+	PumpBenchmarkSession();
+	ReceiveBenchmarkFrame(FString::Printf(TEXT("{\"type\":\"reply\",\"id\":%d,\"result\":%s,\"error\":null}"), GetNextMessageId() - 1, *ScenesResult));
+	PumpBenchmarkSession();
+	if (GetInteractiveConnectionAuthState() != EMixerLoginState::Logged_In)
+	{
+		UE_LOG(LogMixerInteractivity, Warning, TEXT("Benchmark session failed to start."));
+		EndBenchmarkSession();
+		return false;
+	}
 
+	return true;
+}
 
-FMixerInteractivityModule_UE::FMixerInteractivityModule_UE()
-	: TMixerWebSocketOwnerBase<FMixerInteractivityModule_UE>(MixerStringConstants::MessageTypes::Method, MixerStringConstants::FieldNames::Method, MixerStringConstants::FieldNames::Params)
+void FMixerInteractivityModule_UE::ReceiveBenchmarkFrame(const FString& Frame)
+{
+	DecodeBenchmarkFrame(Frame);
+}
+
+void FMixerInteractivityModule_UE::PumpBenchmarkSession()
 {
+	FMixerInteractivityModule_WithSessionState::PumpBenchmarkSession();
+	DispatchBenchmarkFrames();
+	FlushCoalescedStickInput();
+	FlushInputBatch();
 }
 
+void FMixerInteractivityModule_UE::EndBenchmarkSession()
+{
+	StopInteractiveConnection();
+	ResetUnparsedScenes();
+	ScenesByGroup.Empty();
+	InputFilter.Invalidate();
+}
+#endif
+
 void FMixerInteractivityModule_UE::StartInteractivity()
 {
 	switch (GetInteractivityState())
@@ -120,6 +233,9 @@ void FMixerInteractivityModule_UE::StartInteractivity()
 
 void FMixerInteractivityModule_UE::StopInteractivity()
 {
+	// A scene change can't be committed into a session that's going away
+	DiscardStagedSceneChange();
+
 	switch (GetInteractivityState())
 	{
 	case EMixerInteractivityState::Interactivity_Starting:
@@ -143,6 +259,31 @@ void FMixerInteractivityModule_UE::SetCurrentScene(FName Scene, FName GroupName)
 	CreateOrUpdateGroup(MixerStringConstants::MethodNames::UpdateGroups, Scene, GroupName);
 }
 
+bool FMixerInteractivityModule_UE::SetScenesForGroups(TArrayView<const FMixerGroupSpec> Assignments, const FOnGroupBatchComplete& OnComplete)
+{
+	if (GetInteractiveConnectionAuthState() != EMixerLoginState::Logged_In)
+	{
+		return false;
+	}
+
+	TArray<TSharedPtr<FJsonObject>> Entries;
+	Entries.Reserve(Assignments.Num());
+	for (const FMixerGroupSpec& Assignment : Assignments)
+	{
+		Entries.Add(MakeGroupParamEntry(Assignment.Scene, Assignment.Group));
+	}
+
+	return SendGroupBatch(MixerStringConstants::MethodNames::UpdateGroups, Entries, OnComplete);
+}
+
+void FMixerInteractivityModule_UE::ApplySceneChangeLocally(FName Scene, FName GroupName)
+{
+	// onGroupUpdate will confirm this shortly.  Input for unparsed scenes is dropped, so parse it now.
+	ScenesByGroup.Add(GroupName != NAME_None ? GroupName : NAME_DefaultMixerParticipantGroup, Scene);
+	MaterializeScene(Scene);
+	InputFilter.Invalidate();
+}
+
 FName FMixerInteractivityModule_UE::GetCurrentScene(FName GroupName)
 {
 	FName FindGroup = GroupName != NAME_None ? GroupName : NAME_DefaultMixerParticipantGroup;
@@ -161,6 +302,27 @@ bool FMixerInteractivityModule_UE::CreateGroup(FName GroupName, FName InitialSce
 	return CreateOrUpdateGroup(MixerStringConstants::MethodNames::CreateGroups, InitialScene, GroupName);
 }
 
+bool FMixerInteractivityModule_UE::CreateGroups(TArrayView<const FMixerGroupSpec> Groups, const FOnGroupBatchComplete& OnComplete)
+{
+	if (GetInteractiveConnectionAuthState() != EMixerLoginState::Logged_In)
+	{
+		return false;
+	}
+
+	TArray<TSharedPtr<FJsonObject>> Entries;
+	Entries.Reserve(Groups.Num());
+	for (const FMixerGroupSpec& Group : Groups)
+	{
+		// Default group is created automatically, don't send this to the service.
+		if (Group.Group != NAME_None && Group.Group != NAME_DefaultMixerParticipantGroup)
+		{
+			Entries.Add(MakeGroupParamEntry(Group.Scene, Group.Group));
+		}
+	}
+
+	return SendGroupBatch(MixerStringConstants::MethodNames::CreateGroups, Entries, OnComplete);
+}
+
 bool FMixerInteractivityModule_UE::MoveParticipantToGroup(FName GroupName, uint32 ParticipantId)
 {
 	if (GetInteractiveConnectionAuthState() != EMixerLoginState::Logged_In)
@@ -174,26 +336,134 @@ bool FMixerInteractivityModule_UE::MoveParticipantToGroup(FName GroupName, uint3
 		return false;
 	}
 
-	FMixerUpdateParticipantGroupParamsEntry ParamEntry;
-	ParamEntry.ParticipantSessionGuid = ExistingUser->SessionGuid.ToString(EGuidFormats::DigitsWithHyphens).ToLower();
+	TSharedRef<FJsonObject> ParamEntry = MakeShared<FJsonObject>();
+	ParamEntry->SetStringField(MixerStringConstants::FieldNames::SessionId, ExistingUser->SessionGuid.ToString(EGuidFormats::DigitsWithHyphens).ToLower());
 	// Special case - 'default' is used all over the place as a name, but with 'D'
-	ParamEntry.GroupId = GroupName != NAME_DefaultMixerParticipantGroup ? GroupName.ToString() : TEXT("default");
+	ParamEntry->SetStringField(MixerStringConstants::FieldNames::GroupId, GroupName != NAME_DefaultMixerParticipantGroup ? GroupName.ToString() : TEXT("default"));
+
+	// Several moves in the same frame go out as a single updateParticipants
+	SendMethodMessageMergeableParams(MixerStringConstants::MethodNames::UpdateParticipants, MixerStringConstants::FieldNames::Participants, ParamEntry);
+
+	return true;
+}
+
+bool FMixerInteractivityModule_UE::MoveParticipantsToGroup(FName GroupName, TArrayView<const uint32> ParticipantIds)
+{
+	if (GetInteractiveConnectionAuthState() != EMixerLoginState::Logged_In)
+	{
+		return false;
+	}
+
+	// Special case - 'default' is used all over the place as a name, but with 'D'
+	const FString GroupId = GroupName != NAME_DefaultMixerParticipantGroup ? GroupName.ToString() : TEXT("default");
+
+	TArray<TSharedPtr<FJsonObject>> ParamEntries;
+	ParamEntries.Reserve(ParticipantIds.Num());
+	for (uint32 ParticipantId : ParticipantIds)
+	{
+		TSharedPtr<FMixerRemoteUser> ExistingUser = GetCachedUser(ParticipantId);
+		if (ExistingUser.IsValid())
+		{
+			TSharedRef<FJsonObject> ParamEntry = MakeShared<FJsonObject>();
+			ParamEntry->SetStringField(MixerStringConstants::FieldNames::SessionId, ExistingUser->SessionGuid.ToString(EGuidFormats::DigitsWithHyphens).ToLower());
+			ParamEntry->SetStringField(MixerStringConstants::FieldNames::GroupId, GroupId);
+			ParamEntries.Add(ParamEntry);
+		}
+	}
+
+	if (ParamEntries.Num() == 0)
+	{
+		return false;
+	}
+
+	SendMethodMessageMergeableParams(MixerStringConstants::MethodNames::UpdateParticipants, MixerStringConstants::FieldNames::Participants, ParamEntries);
+
+	return true;
+}
+
+void FMixerInteractivityModule_UE::SendSparkCapture(const FString& TransactionId)
+{
+	FMixerCaptureTransactionParams Params;
+	Params.TransactionId = TransactionId;
+	const int32 SentMessageId = SendMethodMessageObjectParams(MixerStringConstants::MethodNames::Capture, &FMixerInteractivityModule_UE::HandleCaptureReply, Params);
+
+	FSparkCaptureInFlight& InFlight = SparkCapturesInFlight.Add(SentMessageId);
+	InFlight.TransactionId = TransactionId;
+	InFlight.SentAt = FPlatformTime::Seconds();
+}
+
+bool FMixerInteractivityModule_UE::HandleCaptureReply(FJsonObject* JsonObj)
+{
+	int32 ReplyingToMessageId = INDEX_NONE;
+	FSparkCaptureInFlight InFlight;
+	if (!JsonObj->TryGetNumberField(MixerStringConstants::FieldNames::Id, ReplyingToMessageId) ||
+		!SparkCapturesInFlight.RemoveAndCopyValue(ReplyingToMessageId, InFlight))
+	{
+		return false;
+	}
 
-	FMixerUpdateParticipantGroupParams Params;
-	Params.Participants.Add(ParamEntry);
-	SendMethodMessageObjectParams(MixerStringConstants::MethodNames::UpdateParticipants, nullptr, Params);
+	const TSharedPtr<FJsonObject>* Error;
+	if (JsonObj->TryGetObjectField(MixerStringConstants::FieldNames::Error, Error) && Error->IsValid())
+	{
+		FString ErrorMessage;
+		(*Error)->TryGetStringField(MixerStringConstants::FieldNames::Message, ErrorMessage);
+		CompleteSparkCapture(InFlight.TransactionId, false, ErrorMessage);
+	}
+	else
+	{
+		CompleteSparkCapture(InFlight.TransactionId, true, FString());
+	}
 
 	return true;
 }
 
-void FMixerInteractivityModule_UE::CaptureSparkTransaction(const FString& TransactionId)
+void FMixerInteractivityModule_UE::ExpireSparkCaptures(double Now)
+{
+	// Reply timeouts never reach the handler, so give up on these ourselves
+	for (TMap<int32, FSparkCaptureInFlight>::TIterator It(SparkCapturesInFlight); It; ++It)
+	{
+		if (Now - It->Value.SentAt > SparkCaptureReplyTimeout)
+		{
+			CompleteSparkCapture(It->Value.TransactionId, false, TEXT("Timed out waiting for capture reply"));
+			It.RemoveCurrent();
+		}
+	}
+}
+
+namespace
+{
+	const TCHAR* GetThrottledMethodName(EMixerBandwidthThrottleType ThrottleType)
+	{
+		switch (ThrottleType)
+		{
+		case EMixerBandwidthThrottleType::Input:				return TEXT("giveInput");
+		case EMixerBandwidthThrottleType::Participant_Join:		return TEXT("onParticipantJoin");
+		case EMixerBandwidthThrottleType::Participant_Leave:	return TEXT("onParticipantLeave");
+		default:												return nullptr;
+		}
+	}
+
+	void AddThrottleParams(FJsonObject& Params, EMixerBandwidthThrottleType ThrottleType, uint32 MaxBytes, uint32 BytesPerSecond)
+	{
+		TSharedRef<FJsonObject> ThrottleObj = MakeShared<FJsonObject>();
+		ThrottleObj->SetNumberField(MixerStringConstants::FieldNames::Capacity, MaxBytes);
+		ThrottleObj->SetNumberField(MixerStringConstants::FieldNames::DrainRate, BytesPerSecond);
+		Params.SetObjectField(GetThrottledMethodName(ThrottleType), ThrottleObj);
+	}
+}
+
+bool FMixerInteractivityModule_UE::SetBandwidthThrottle(EMixerBandwidthThrottleType ThrottleType, uint32 MaxBytes, uint32 BytesPerSecond)
 {
-	if (GetInteractiveConnectionAuthState() == EMixerLoginState::Logged_In)
+	// The protocol throttles per method; there's no global bucket we can set
+	if (GetInteractiveConnectionAuthState() != EMixerLoginState::Logged_In || GetThrottledMethodName(ThrottleType) == nullptr)
 	{
-		FMixerCaptureTransactionParams Params;
-		Params.TransactionId = TransactionId;
-		SendMethodMessageObjectParams(MixerStringConstants::MethodNames::Capture, nullptr, Params);
+		return false;
 	}
+
+	TSharedRef<FJsonObject> Params = MakeShared<FJsonObject>();
+	AddThrottleParams(Params.Get(), ThrottleType, MaxBytes, BytesPerSecond);
+	SendMethodMessageObjectParams(MixerStringConstants::MethodNames::SetBandwidthThrottle, nullptr, Params);
+	return true;
 }
 
 void FMixerInteractivityModule_UE::CallRemoteMethod(const FString& MethodName, const TSharedRef<FJsonObject> MethodParams)
@@ -201,6 +471,25 @@ void FMixerInteractivityModule_UE::CallRemoteMethod(const FString& MethodName, c
 	SendMethodMessageObjectParams(MethodName, nullptr, MethodParams);
 }
 
+void FMixerInteractivityModule_UE::CallRemoteMethodSerialized(const FString& MethodName, TArrayView<const uint8> Utf8Params)
+{
+	SendMethodMessageSerializedParams(MethodName, nullptr, Utf8Params);
+}
+
+bool FMixerInteractivityModule_UE::CallRemoteMethodAsync(const FString& MethodName, const TSharedRef<FJsonObject> MethodParams, const FOnRemoteMethodReply& OnReply)
+{
+	if (GetInteractiveConnectionAuthState() != EMixerLoginState::Logged_In)
+	{
+		return false;
+	}
+
+	const int32 SentMessageId = SendMethodMessageObjectParams(MethodName, &FMixerInteractivityModule_UE::HandleRemoteMethodReply, MethodParams);
+	FRemoteMethodCallInFlight& InFlight = RemoteMethodCallsInFlight.Add(SentMessageId);
+	InFlight.OnReply = OnReply;
+	InFlight.SentAt = FPlatformTime::Seconds();
+	return true;
+}
+
 bool FMixerInteractivityModule_UE::StartInteractiveConnection()
 {
 	if (GetInteractiveConnectionAuthState() != EMixerLoginState::Not_Logged_In)
@@ -209,12 +498,46 @@ bool FMixerInteractivityModule_UE::StartInteractiveConnection()
 	}
 
 	Endpoints.Empty();
-	TSharedRef<IHttpRequest> HostsRequest = FHttpModule::Get().CreateRequest();
-	HostsRequest->SetVerb(TEXT("GET"));
-	HostsRequest->SetURL(TEXT("https://mixer.com/api/v1/interactive/hosts"));
+	bAwaitingHostsRefresh = false;
+
+	const UMixerInteractivitySettings* Settings = GetDefault<UMixerInteractivitySettings>();
+	if (!Settings->InteractiveEndpointOverride.IsEmpty())
+	{
+		// A test endpoint stands in for the whole host list
+		UE_LOG(LogMixerInteractivity, Log, TEXT("Connecting interactivity to override endpoint %s."), *Settings->InteractiveEndpointOverride);
+		SetInteractiveConnectionAuthState(EMixerLoginState::Logging_In);
+		Endpoints.Add(Settings->InteractiveEndpointOverride);
+		OpenWebSocket();
+		return true;
+	}
+
+	// With a recent enough host list there's no need to wait on the lookup - connect to
+	// the best host we know of and refresh the list alongside in case it has changed.
+	const UMixerInteractivityUserSettings* UserSettings = GetDefault<UMixerInteractivityUserSettings>();
+	TArray<FString> CachedHosts;
+	if (FMixerInteractiveHostsCache::GetCachedHosts(CachedHosts, UserSettings->PreferredInteractiveEndpoint, false))
+	{
+		HostsCache->RequestHosts(FMixerInteractiveHostsCache::FOnHostsReceived::CreateRaw(this, &FMixerInteractivityModule_UE::OnHostsRefreshed));
+		SetInteractiveConnectionAuthState(EMixerLoginState::Logging_In);
+		MarkStartupPhase(StartupTimings.HostsDiscovered, TEXT("interactive hosts discovered (cached)"));
+		Endpoints = CachedHosts;
+		OpenWebSocket();
+		return true;
+	}
+
+	// Once the list has gone stale, the host that last worked is still the likeliest to work now.
+	// Start there and let the lookup supply fallbacks, rather than holding everything up on it.
+	if (Settings->bUseWarmStartCache && !UserSettings->PreferredInteractiveEndpoint.IsEmpty())
+	{
+		HostsCache->RequestHosts(FMixerInteractiveHostsCache::FOnHostsReceived::CreateRaw(this, &FMixerInteractivityModule_UE::OnHostsRefreshed));
+		SetInteractiveConnectionAuthState(EMixerLoginState::Logging_In);
+		MarkStartupPhase(StartupTimings.HostsDiscovered, TEXT("interactive hosts discovered (warm start)"));
+		Endpoints.Add(UserSettings->PreferredInteractiveEndpoint);
+		OpenWebSocket();
+		return true;
+	}
 
-	HostsRequest->OnProcessRequestComplete().BindRaw(this, &FMixerInteractivityModule_UE::OnHostsRequestComplete);
-	if (!HostsRequest->ProcessRequest())
+	if (!HostsCache->RequestHosts(FMixerInteractiveHostsCache::FOnHostsReceived::CreateRaw(this, &FMixerInteractivityModule_UE::OnHostsReceived)))
 	{
 		return false;
 	}
@@ -231,38 +554,83 @@ void FMixerInteractivityModule_UE::StopInteractiveConnection()
 		SetInteractiveConnectionAuthState(EMixerLoginState::Not_Logged_In);
 		SetInteractivityState(EMixerInteractivityState::Not_Interactive);
 		CleanupConnection();
+		EndpointSelector->Cancel();
+		HostsCache->Cancel();
+		bAwaitingHostsRefresh = false;
 		Endpoints.Empty();
+		NextReconnectTime = 0.0;
+		ParticipantReconcileTime = 0.0;
+		ReconnectAttempts = 0;
+		bResumingSession = false;
+		UnconfirmedParticipants.Empty();
+		InputAwaitingParticipants.Empty();
+		EvictedParticipantRequestTime = 0.0;
+		SparkCapturesInFlight.Empty();
+		AbandonGroupBatches();
+		AbandonRemoteMethodCalls();
+		bProjectDefinitionSeedPending = false;
 		EndSession();
 	}
 }
 
-void FMixerInteractivityModule_UE::OnHostsRequestComplete(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded)
+void FMixerInteractivityModule_UE::PrefetchInteractiveHosts()
+{
+	TArray<FString> CachedHosts;
+	if (!FMixerInteractiveHostsCache::GetCachedHosts(CachedHosts, FString(), false))
+	{
+		// Picked up by StartInteractiveConnection if still in flight
+		HostsCache->RequestHosts(FMixerInteractiveHostsCache::FOnHostsReceived());
+	}
+}
+
+void FMixerInteractivityModule_UE::OnHostsReceived(const TArray<FString>& Hosts)
+{
+	MarkStartupPhase(StartupTimings.HostsDiscovered, TEXT("interactive hosts discovered"));
+	Endpoints = Hosts;
+	if (Endpoints.Num() == 0)
+	{
+		// An outdated list is still a better bet than giving up
+		FMixerInteractiveHostsCache::GetCachedHosts(Endpoints, FString(), true);
+	}
+
+	if (Endpoints.Num() > 1)
+	{
+		const UMixerInteractivityUserSettings* UserSettings = GetDefault<UMixerInteractivityUserSettings>();
+		EndpointSelector->RankEndpoints(Endpoints, UserSettings->PreferredInteractiveEndpoint, FMixerEndpointSelector::FOnEndpointsRanked::CreateRaw(this, &FMixerInteractivityModule_UE::OnEndpointsRanked));
+	}
+	else
+	{
+		OpenWebSocket();
+	}
+}
+
+void FMixerInteractivityModule_UE::OnHostsRefreshed(const TArray<FString>& Hosts)
 {
-	if (bSucceeded && HttpResponse.IsValid())
+	if (GetInteractiveConnectionAuthState() == EMixerLoginState::Not_Logged_In)
+	{
+		return;
+	}
+
+	// Anything new becomes a fallback behind the cached hosts we're already working through
+	for (const FString& Host : Hosts)
 	{
-		if (EHttpResponseCodes::IsOk(HttpResponse->GetResponseCode()))
+		if (Host != CurrentEndpoint)
 		{
-			FString ResponseStr = HttpResponse->GetContentAsString();
-			TSharedRef<TJsonReader<>> JsonReader = TJsonReaderFactory<>::Create(ResponseStr);
-			TSharedPtr<FJsonValue> JsonPayload;
-			if (FJsonSerializer::Deserialize(JsonReader, JsonPayload) && JsonPayload.IsValid())
-			{
-				const TArray<TSharedPtr<FJsonValue>>* JsonArray;
-				if (JsonPayload->TryGetArray(JsonArray))
-				{
-					for (const TSharedPtr<FJsonValue>& HostElem : *JsonArray)
-					{
-						const TSharedPtr<FJsonObject> AddressObject = HostElem->AsObject();
-						if (AddressObject.IsValid())
-						{
-							Endpoints.Add(AddressObject->GetStringField(TEXT("address")));
-						}
-					}
-				}
-			}
+			Endpoints.AddUnique(Host);
 		}
 	}
 
+	if (bAwaitingHostsRefresh)
+	{
+		bAwaitingHostsRefresh = false;
+		OpenWebSocket();
+	}
+}
+
+void FMixerInteractivityModule_UE::OnEndpointsRanked(const TArray<FString>& RankedEndpoints)
+{
+	// Remaining endpoints are kept in order as fallbacks should the best one fail
+	Endpoints = RankedEndpoints;
 	OpenWebSocket();
 }
 
@@ -270,6 +638,14 @@ void FMixerInteractivityModule_UE::OpenWebSocket()
 {
 	if (Endpoints.Num() == 0)
 	{
+		if (HostsCache->IsRequestInFlight())
+		{
+			// Ran through the cached hosts before the refreshed list arrived
+			UE_LOG(LogMixerInteractivity, Log, TEXT("Cached interactive hosts exhausted; waiting for host lookup."));
+			bAwaitingHostsRefresh = true;
+			return;
+		}
+
 		UE_LOG(LogMixerInteractivity, Warning, TEXT("Interactive connection failed - no more endpoints available."));
 		SetInteractiveConnectionAuthState(EMixerLoginState::Not_Logged_In);
 		return;
@@ -277,7 +653,22 @@ void FMixerInteractivityModule_UE::OpenWebSocket()
 
 	const UMixerInteractivitySettings* Settings = GetDefault<UMixerInteractivitySettings>();
 
-	StartSession(Settings->bPerParticipantStateCaching);
+	if (!bResumingSession)
+	{
+		StartSession(Settings->bPerParticipantStateCaching, Settings->ExpectedAudienceSize);
+
+		ResetUnparsedScenes();
+		bSessionSeeded = false;
+		SeededScenesHash = 0;
+		if (Settings->bSeedSessionFromProjectDefinition)
+		{
+			SeedSessionFromProjectDefinition();
+		}
+		if (!bSessionSeeded)
+		{
+			SeedSessionFromWarmStartCache();
+		}
+	}
 
 	const UMixerInteractivityUserSettings* UserSettings = GetDefault<UMixerInteractivityUserSettings>();
 	TMap<FString, FString> UpgradeHeaders;
@@ -290,45 +681,388 @@ void FMixerInteractivityModule_UE::OpenWebSocket()
 		UpgradeHeaders.Add(TEXT("X-Interactive-Sharecode"), Settings->ShareCode);
 	}
 
-	FString EndpointToUse = Endpoints[0];
-	UE_LOG(LogMixerInteractivity, Verbose, TEXT("Opening web socket to %s for interactivity"), *EndpointToUse);
+	CurrentEndpoint = Endpoints[0];
+	UE_LOG(LogMixerInteractivity, Verbose, TEXT("Opening web socket to %s for interactivity"), *CurrentEndpoint);
 
-	Endpoints.RemoveAtSwap(0);
-	InitConnection(EndpointToUse, UpgradeHeaders);
+	Endpoints.RemoveAt(0);
+	InitConnection(CurrentEndpoint, UpgradeHeaders);
 }
 
-bool FMixerInteractivityModule_UE::CreateOrUpdateGroup(const FString& MethodName, FName Scene, FName GroupName)
+bool FMixerInteractivityModule_UE::ShouldResumeSession() const
 {
-	if (GetInteractiveConnectionAuthState() != EMixerLoginState::Logged_In)
+	// Only sessions that got as far as receiving scenes are worth resuming
+	return bResumingSession
+		|| (GetInteractiveConnectionAuthState() == EMixerLoginState::Logged_In && GetDefault<UMixerInteractivitySettings>()->bAutoReconnect);
+}
+
+void FMixerInteractivityModule_UE::ScheduleReconnect()
+{
+	const UMixerInteractivitySettings* Settings = GetDefault<UMixerInteractivitySettings>();
+	if (ReconnectAttempts >= Settings->MaxReconnectAttempts)
 	{
-		return false;
+		UE_LOG(LogMixerInteractivity, Warning, TEXT("Giving up on interactive session after %d reconnect attempts."), ReconnectAttempts);
+		AbandonSession();
+		return;
 	}
 
-	FMixerUpdateGroupMessageParamsEntry ParamEntry;
-	ParamEntry.GroupId = GroupName != NAME_None && GroupName != NAME_DefaultMixerParticipantGroup ? GroupName.ToString() : TEXT("default");
-	ParamEntry.SceneId = Scene != NAME_None && Scene != NAME_DefaultMixerParticipantGroup ? Scene.ToString() : TEXT("default");
-	FMixerUpdateGroupMessageParams Params;
-	Params.Groups.Add(ParamEntry);
+	if (!bResumingSession)
+	{
+		bResumingSession = true;
+		bResumeInteractivity = GetInteractivityState() == EMixerInteractivityState::Interactive
+			|| GetInteractivityState() == EMixerInteractivityState::Interactivity_Starting;
+
+		// Participants that aren't re-announced after the resumed hello are treated as having left
+		UnconfirmedParticipants.Empty();
+		TArray<TSharedPtr<FMixerRemoteUser>> CachedUsers;
+		GetCachedUsers(CachedUsers);
+		for (const TSharedPtr<FMixerRemoteUser>& User : CachedUsers)
+		{
+			UnconfirmedParticipants.Add(User->Id);
+		}
+		ParticipantReconcileTime = 0.0;
 
-	SendMethodMessageObjectParams(MethodName, nullptr, Params);
-	return true;
+		SetInteractiveConnectionAuthState(EMixerLoginState::Logging_In);
+		SetInteractivityState(EMixerInteractivityState::Not_Interactive);
+	}
+
+	// Give the same host another chance, but after any others we know about
+	Endpoints.Remove(CurrentEndpoint);
+	Endpoints.Add(CurrentEndpoint);
+
+	// Exponential backoff with equal jitter so that a service-side blip doesn't produce a reconnect storm
+	const float CappedDelay = FMath::Min(Settings->ReconnectMaxDelay, Settings->ReconnectBaseDelay * FMath::Pow(2.0f, static_cast<float>(ReconnectAttempts)));
+	const float Delay = CappedDelay * FMath::FRandRange(0.5f, 1.0f);
+	++ReconnectAttempts;
+
+	UE_LOG(LogMixerInteractivity, Log, TEXT("Interactive connection lost; reconnect attempt %d in %.2f seconds."), ReconnectAttempts, Delay);
+	NextReconnectTime = FPlatformTime::Seconds() + Delay;
 }
 
-void FMixerInteractivityModule_UE::HandleSocketConnected()
+void FMixerInteractivityModule_UE::AbandonSession()
 {
-	// No real action here - we'll wait for a hello
+	NextReconnectTime = 0.0;
+	ParticipantReconcileTime = 0.0;
+	ReconnectAttempts = 0;
+	bResumingSession = false;
+	UnconfirmedParticipants.Empty();
+	ParkedParticipants.Empty();
+	Endpoints.Empty();
+	InputAwaitingParticipants.Empty();
+	EvictedParticipantRequestTime = 0.0;
+	bProjectDefinitionSeedPending = false;
+	SetInteractiveConnectionAuthState(EMixerLoginState::Not_Logged_In);
+	EndSession();
 }
 
-void FMixerInteractivityModule_UE::HandleSocketConnectionError()
+void FMixerInteractivityModule_UE::ReconcileResumedParticipants()
 {
-	// Retry if we still have endpoints available
-	OpenWebSocket();
+	for (uint32 ParticipantId : UnconfirmedParticipants)
+	{
+		TSharedPtr<FMixerRemoteUser> RemoteUser = GetCachedUser(ParticipantId);
+		if (RemoteUser.IsValid())
+		{
+			OnParticipantStateChanged().Broadcast(RemoteUser, EMixerInteractivityParticipantState::Left);
+			RemoveUser(RemoteUser);
+		}
+	}
+	UnconfirmedParticipants.Empty();
+}
+
+void FMixerInteractivityModule_UE::ExpireParkedParticipants(double Now)
+{
+	TArray<TSharedPtr<const FMixerRemoteUser>> LeftUsers;
+	for (TMap<uint32, double>::TIterator It(ParkedParticipants); It; ++It)
+	{
+		if (Now < It.Value())
+		{
+			continue;
+		}
+
+		// May have gone already, e.g. if a resumed session didn't re-announce them
+		TSharedPtr<FMixerRemoteUser> RemoteUser = GetCachedUser(It.Key());
+		It.RemoveCurrent();
+		if (RemoteUser.IsValid())
+		{
+			OnParticipantStateChanged().Broadcast(RemoteUser, EMixerInteractivityParticipantState::Left);
+			RemoveUser(RemoteUser);
+			LeftUsers.Add(RemoteUser);
+		}
+	}
+
+	if (LeftUsers.Num() > 0)
+	{
+		OnParticipantsChanged().Broadcast(LeftUsers, EMixerInteractivityParticipantState::Left);
+	}
+}
+
+bool FMixerInteractivityModule_UE::CreateOrUpdateGroup(const FString& MethodName, FName Scene, FName GroupName)
+{
+	if (GetInteractiveConnectionAuthState() != EMixerLoginState::Logged_In)
+	{
+		return false;
+	}
+
+	SendMethodMessageMergeableParams(MethodName, MixerStringConstants::FieldNames::Groups, MakeGroupParamEntry(Scene, GroupName));
+	return true;
+}
+
+TSharedRef<FJsonObject> FMixerInteractivityModule_UE::MakeGroupParamEntry(FName Scene, FName GroupName)
+{
+	TSharedRef<FJsonObject> ParamEntry = MakeShared<FJsonObject>();
+	ParamEntry->SetStringField(MixerStringConstants::FieldNames::GroupId, GroupName != NAME_None && GroupName != NAME_DefaultMixerParticipantGroup ? GroupName.ToString() : TEXT("default"));
+	ParamEntry->SetStringField(MixerStringConstants::FieldNames::SceneId, Scene != NAME_None && Scene != NAME_DefaultMixerParticipantGroup ? Scene.ToString() : TEXT("default"));
+	MaterializeScene(Scene != NAME_None ? Scene : NAME_DefaultMixerParticipantGroup);
+	return ParamEntry;
+}
+
+bool FMixerInteractivityModule_UE::SendGroupBatch(const FString& MethodName, const TArray<TSharedPtr<FJsonObject>>& Entries, const FOnGroupBatchComplete& OnComplete)
+{
+	if (Entries.Num() == 0)
+	{
+		return false;
+	}
+
+	// Sent as one message rather than through the mergeable path so that the whole batch has a single reply
+	TArray<TSharedPtr<FJsonValue>> GroupValues;
+	GroupValues.Reserve(Entries.Num());
+	for (const TSharedPtr<FJsonObject>& Entry : Entries)
+	{
+		GroupValues.Add(MakeShared<FJsonValueObject>(Entry));
+	}
+
+	TSharedRef<FJsonObject> Params = MakeShared<FJsonObject>();
+	Params->SetArrayField(MixerStringConstants::FieldNames::Groups, GroupValues);
+
+	const int32 SentMessageId = SendMethodMessageObjectParams(MethodName, &FMixerInteractivityModule_UE::HandleGroupBatchReply, Params);
+	FGroupBatchInFlight& InFlight = GroupBatchesInFlight.Add(SentMessageId);
+	InFlight.OnComplete = OnComplete;
+	InFlight.SentAt = FPlatformTime::Seconds();
+	return true;
+}
+
+bool FMixerInteractivityModule_UE::HandleGroupBatchReply(FJsonObject* JsonObj)
+{
+	int32 ReplyingToMessageId = INDEX_NONE;
+	FGroupBatchInFlight InFlight;
+	if (!JsonObj->TryGetNumberField(MixerStringConstants::FieldNames::Id, ReplyingToMessageId) ||
+		!GroupBatchesInFlight.RemoveAndCopyValue(ReplyingToMessageId, InFlight))
+	{
+		return false;
+	}
+
+	const TSharedPtr<FJsonObject>* Error;
+	if (JsonObj->TryGetObjectField(MixerStringConstants::FieldNames::Error, Error) && Error->IsValid())
+	{
+		FString ErrorMessage;
+		(*Error)->TryGetStringField(MixerStringConstants::FieldNames::Message, ErrorMessage);
+		UE_LOG(LogMixerInteractivity, Warning, TEXT("Group request (message id %d) failed: %s"), ReplyingToMessageId, *ErrorMessage);
+		InFlight.OnComplete.ExecuteIfBound(false, ErrorMessage);
+	}
+	else
+	{
+		InFlight.OnComplete.ExecuteIfBound(true, FString());
+	}
+
+	return true;
+}
+
+void FMixerInteractivityModule_UE::ExpireGroupBatches(double Now)
+{
+	// Reply timeouts never reach the handler, so give up on these ourselves
+	TArray<FOnGroupBatchComplete> Expired;
+	for (TMap<int32, FGroupBatchInFlight>::TIterator It(GroupBatchesInFlight); It; ++It)
+	{
+		if (Now - It->Value.SentAt > GroupBatchReplyTimeout)
+		{
+			Expired.Add(It->Value.OnComplete);
+			It.RemoveCurrent();
+		}
+	}
+
+	for (const FOnGroupBatchComplete& OnComplete : Expired)
+	{
+		OnComplete.ExecuteIfBound(false, TEXT("Timed out waiting for group reply"));
+	}
+}
+
+void FMixerInteractivityModule_UE::AbandonGroupBatches()
+{
+	// Callers may issue new requests from the callback, so detach the map first
+	TMap<int32, FGroupBatchInFlight> Abandoned = MoveTemp(GroupBatchesInFlight);
+	GroupBatchesInFlight.Reset();
+	for (const TPair<int32, FGroupBatchInFlight>& Pair : Abandoned)
+	{
+		Pair.Value.OnComplete.ExecuteIfBound(false, TEXT("Interactive session ended"));
+	}
+}
+
+bool FMixerInteractivityModule_UE::HandleRemoteMethodReply(FJsonObject* JsonObj)
+{
+	int32 ReplyingToMessageId = INDEX_NONE;
+	FRemoteMethodCallInFlight InFlight;
+	if (!JsonObj->TryGetNumberField(MixerStringConstants::FieldNames::Id, ReplyingToMessageId) ||
+		!RemoteMethodCallsInFlight.RemoveAndCopyValue(ReplyingToMessageId, InFlight))
+	{
+		return false;
+	}
+
+	const TSharedPtr<FJsonObject>* Error;
+	if (JsonObj->TryGetObjectField(MixerStringConstants::FieldNames::Error, Error) && Error->IsValid())
+	{
+		FString ErrorMessage;
+		(*Error)->TryGetStringField(MixerStringConstants::FieldNames::Message, ErrorMessage);
+		InFlight.OnReply.ExecuteIfBound(false, nullptr, ErrorMessage);
+	}
+	else
+	{
+		TSharedPtr<FJsonObject> ResultObj;
+		const TSharedPtr<FJsonObject>* Result;
+		if (JsonObj->TryGetObjectField(MixerStringConstants::FieldNames::Result, Result))
+		{
+			ResultObj = *Result;
+		}
+		InFlight.OnReply.ExecuteIfBound(true, ResultObj, FString());
+	}
+
+	return true;
+}
+
+void FMixerInteractivityModule_UE::ExpireRemoteMethodCalls(double Now)
+{
+	// Reply timeouts never reach the handler, so give up on these ourselves
+	TArray<FOnRemoteMethodReply> Expired;
+	for (TMap<int32, FRemoteMethodCallInFlight>::TIterator It(RemoteMethodCallsInFlight); It; ++It)
+	{
+		if (Now - It->Value.SentAt > RemoteMethodReplyTimeout)
+		{
+			Expired.Add(It->Value.OnReply);
+			It.RemoveCurrent();
+		}
+	}
+
+	for (const FOnRemoteMethodReply& OnReply : Expired)
+	{
+		OnReply.ExecuteIfBound(false, nullptr, TEXT("Timed out waiting for method reply"));
+	}
+}
+
+void FMixerInteractivityModule_UE::AbandonRemoteMethodCalls()
+{
+	// Callers may issue new requests from the callback, so detach the map first
+	TMap<int32, FRemoteMethodCallInFlight> Abandoned = MoveTemp(RemoteMethodCallsInFlight);
+	RemoteMethodCallsInFlight.Reset();
+	for (const TPair<int32, FRemoteMethodCallInFlight>& Pair : Abandoned)
+	{
+		Pair.Value.OnReply.ExecuteIfBound(false, nullptr, TEXT("Interactive session ended"));
+	}
+}
+
+void FMixerInteractivityModule_UE::HandleSocketConnected()
+{
+	// Otherwise no real action here - we'll wait for a hello
+	if (!GetDefault<UMixerInteractivitySettings>()->InteractiveEndpointOverride.IsEmpty())
+	{
+		// Test endpoints mustn't be remembered as the host to prefer once the override is cleared
+		return;
+	}
+
+	UMixerInteractivityUserSettings* UserSettings = GetMutableDefault<UMixerInteractivityUserSettings>();
+	if (UserSettings->PreferredInteractiveEndpoint != CurrentEndpoint)
+	{
+		UserSettings->PreferredInteractiveEndpoint = CurrentEndpoint;
+		UserSettings->SaveConfigDeferred();
+	}
+}
+
+void FMixerInteractivityModule_UE::HandleSocketConnectionError()
+{
+	// Don't keep steering future sessions towards a host we couldn't reach
+	UMixerInteractivityUserSettings* UserSettings = GetMutableDefault<UMixerInteractivityUserSettings>();
+	if (UserSettings->PreferredInteractiveEndpoint == CurrentEndpoint)
+	{
+		UserSettings->PreferredInteractiveEndpoint.Empty();
+		UserSettings->SaveConfigDeferred();
+	}
+
+	if (ShouldResumeSession())
+	{
+		ScheduleReconnect();
+	}
+	else
+	{
+		// Retry if we still have endpoints available
+		OpenWebSocket();
+	}
 }
 
 void FMixerInteractivityModule_UE::HandleSocketClosed( bool bWasClean)
 {
-	// Attempt to reconnect
-	OpenWebSocket();
+	if (ShouldResumeSession())
+	{
+		ScheduleReconnect();
+	}
+	else
+	{
+		// Attempt to reconnect
+		OpenWebSocket();
+	}
+}
+
+FString FMixerInteractivityModule_UE::GetHealthPingMethodName() const
+{
+	return MixerStringConstants::MethodNames::GetTime;
+}
+
+void FMixerInteractivityModule_UE::HandleHealthPingReply(FJsonObject* JsonObj, double RoundTrip)
+{
+	// getTime doubles as the clock sync: the server's time was read about halfway through the round trip
+	const TSharedPtr<FJsonObject>* Result;
+	double ServerTimeMs;
+	if (JsonObj->TryGetObjectField(MixerStringConstants::FieldNames::Result, Result) && (*Result)->TryGetNumberField(MixerStringConstants::FieldNames::Time, ServerTimeMs))
+	{
+		const double LocalTimeMs = static_cast<double>((FDateTime::UtcNow() - FDateTime(1970, 1, 1)).GetTotalMilliseconds()) - RoundTrip * 500.0;
+		SetServerTimeOffset(static_cast<int64>(ServerTimeMs - LocalTimeMs));
+	}
+}
+
+bool FMixerInteractivityModule_UE::IsBulkMethod(const FString& MethodName) const
+{
+	// Control properties are the only thing sent in quantity; anything else can go ahead of them
+	return MethodName.Equals(MixerStringConstants::MethodNames::UpdateControls, ESearchCase::CaseSensitive);
+}
+
+void FMixerInteractivityModule_UE::HandleConnectionDegraded()
+{
+	// Remaining endpoints are still in latency order, and don't include the current one
+	if (Endpoints.Num() == 0)
+	{
+		UE_LOG(LogMixerInteractivity, Warning, TEXT("Interactive connection to %s is degraded, but there is no other endpoint to fail over to."), *CurrentEndpoint);
+		return;
+	}
+
+	UE_LOG(LogMixerInteractivity, Warning, TEXT("Interactive connection to %s is degraded; failing over to %s."), *CurrentEndpoint, *Endpoints[0]);
+	UMixerInteractivityUserSettings* UserSettings = GetMutableDefault<UMixerInteractivityUserSettings>();
+	if (UserSettings->PreferredInteractiveEndpoint == CurrentEndpoint)
+	{
+		UserSettings->PreferredInteractiveEndpoint.Empty();
+		UserSettings->SaveConfigDeferred();
+	}
+
+	CleanupConnection();
+	if (ShouldResumeSession())
+	{
+		ScheduleReconnect();
+
+		// The service itself is fine, so there's no call for backing off
+		if (NextReconnectTime > 0.0)
+		{
+			NextReconnectTime = FPlatformTime::Seconds();
+		}
+	}
+	else
+	{
+		OpenWebSocket();
+	}
 }
 
 void FMixerInteractivityModule_UE::RegisterAllServerMessageHandlers()
@@ -353,16 +1087,48 @@ bool FMixerInteractivityModule_UE::OnUnhandledServerMessage(const FString& Messa
 
 bool FMixerInteractivityModule_UE::HandleHello(FJsonObject* JsonObj)
 {
+	if (bResumingSession)
+	{
+		// Same game version, so the cached scenes and controls are still good.  Participants
+		// are re-announced by the service and reconciled against the cache as they arrive.
+		UE_LOG(LogMixerInteractivity, Log, TEXT("Resumed interactive session after %d reconnect attempt(s)."), ReconnectAttempts);
+		bResumingSession = false;
+		ReconnectAttempts = 0;
+		ParticipantReconcileTime = FPlatformTime::Seconds() + ResumedParticipantGraceSeconds;
+		SetInteractiveConnectionAuthState(EMixerLoginState::Logged_In);
+		SendBandwidthThrottles();
+		if (bResumeInteractivity)
+		{
+			StartInteractivity();
+		}
+		return true;
+	}
+
+	if (bSessionSeeded)
+	{
+		// Scenes and controls are already in place - getScenes only has to confirm them
+		SetInteractiveConnectionAuthState(EMixerLoginState::Logged_In);
+		SendBandwidthThrottles();
+	}
+
 	SendMethodMessageNoParams(MixerStringConstants::MethodNames::GetScenes, &FMixerInteractivityModule_UE::HandleGetScenesReply);
 	return true;
 }
 
 bool FMixerInteractivityModule_UE::HandleGiveInput(FJsonObject* JsonObj)
 {
+	TGuardValue<double> ArrivalGuard(InputArrivalTime, GetDispatchingMessageReceivedTime());
+	return HandleGiveInput(JsonObj, true);
+}
+
+bool FMixerInteractivityModule_UE::HandleGiveInput(FJsonObject* JsonObj, bool bDeferForEvictedParticipant)
+{
+	SCOPE_CYCLE_COUNTER(STAT_MixerHandleGiveInput);
+
 	GET_JSON_STRING_RETURN_FAILURE(ParticipantId, ParticipantGuidString);
 
-	FGuid ParticipantGuid;
-	if (!FGuid::Parse(ParticipantGuidString, ParticipantGuid))
+	TSharedPtr<FMixerRemoteUser> RemoteUser;
+	if (!FindCachedUserBySessionId(*ParticipantGuidString, RemoteUser))
 	{
 		UE_LOG(LogMixerInteractivity, Error, TEXT("%s field %s for input event was not in the expected format (guid)"), *MixerStringConstants::FieldNames::ParticipantId, *ParticipantGuidString);
 		return false;
@@ -370,10 +1136,46 @@ bool FMixerInteractivityModule_UE::HandleGiveInput(FJsonObject* JsonObj)
 
 	GET_JSON_OBJECT_RETURN_FAILURE(Input, InputObj);
 
-	TSharedPtr<FMixerRemoteUser> RemoteUser = GetCachedUser(ParticipantGuid);
+	if (RemoteUser.IsValid())
+	{
+		NoteUserInput(*RemoteUser);
+	}
+	else if (bDeferForEvictedParticipant)
+	{
+		FGuid SessionGuid;
+		if (ParseSessionId(*ParticipantGuidString, SessionGuid) && WasUserEvicted(SessionGuid))
+		{
+			DeferInputForEvictedParticipant(*JsonObj);
+			return true;
+		}
+	}
+
 	return HandleGiveInput(RemoteUser, JsonObj, InputObj->ToSharedRef());
 }
 
+void FMixerInteractivityModule_UE::DeferInputForEvictedParticipant(const FJsonObject& FullParamsJson)
+{
+	if (InputAwaitingParticipants.Num() < MaxInputAwaitingParticipants)
+	{
+		InputAwaitingParticipants.Add(MixerJsonArena::DeepCopy(FullParamsJson));
+	}
+	else
+	{
+		UE_LOG(LogMixerInteractivity, Warning, TEXT("Dropping input from an evicted participant; too much input is already waiting for participants to be fetched."));
+	}
+
+	const double TimeNow = FPlatformTime::Seconds();
+	if (EvictedParticipantRequestTime == 0.0 || TimeNow - EvictedParticipantRequestTime > EvictedParticipantRequestTimeout)
+	{
+		// Anyone whose input we're holding has been active in the last moment.  Allow for clock skew against the service.
+		TSharedRef<FJsonObject> Params = MakeShared<FJsonObject>();
+		const FDateTime Threshold = FDateTime::UtcNow() - FTimespan::FromSeconds(30.0);
+		Params->SetNumberField(MixerStringConstants::FieldNames::Threshold, static_cast<double>(Threshold.ToUnixTimestamp()) * 1000.0);
+		SendMethodMessageObjectParams(MixerStringConstants::MethodNames::GetActiveParticipants, &FMixerInteractivityModule_UE::HandleGetActiveParticipantsReply, Params);
+		EvictedParticipantRequestTime = TimeNow;
+	}
+}
+
 bool FMixerInteractivityModule_UE::HandleParticipantJoin(FJsonObject* JsonObj)
 {
 	return HandleParticipantEvent(JsonObj, EMixerInteractivityParticipantState::Joined);
@@ -396,64 +1198,257 @@ bool FMixerInteractivityModule_UE::HandleReadyStateChange(FJsonObject* JsonObj)
 	return true;
 }
 
+namespace
+{
+	struct FGroupsMessage
+	{
+		const TArray<TSharedPtr<FJsonValue>>* Groups;
+
+		BEGIN_MIXER_JSON_SCHEMA(FGroupsMessage, TEXT("group change"))
+			MIXER_JSON_REQUIRED(Groups, Groups)
+		END_MIXER_JSON_SCHEMA()
+	};
+
+	struct FGroupRecord
+	{
+		FName GroupId;
+		FName SceneId;
+
+		BEGIN_MIXER_JSON_SCHEMA(FGroupRecord, TEXT("group"))
+			MIXER_JSON_REQUIRED(GroupId, GroupId)
+			MIXER_JSON_REQUIRED(SceneId, SceneId)
+		END_MIXER_JSON_SCHEMA()
+	};
+
+	struct FGroupDeleteMessage
+	{
+		FName GroupId;
+		FName ReassignGroupId;
+
+		BEGIN_MIXER_JSON_SCHEMA(FGroupDeleteMessage, TEXT("onGroupDelete"))
+			MIXER_JSON_REQUIRED(GroupId, GroupId)
+			MIXER_JSON_REQUIRED(ReassignGroupId, ReassignGroupId)
+		END_MIXER_JSON_SCHEMA()
+	};
+}
+
 bool FMixerInteractivityModule_UE::HandleGroupCreate(FJsonObject* JsonObj)
 {
-	GET_JSON_ARRAY_RETURN_FAILURE(Groups, Groups);
+	FGroupsMessage Message;
+	if (!Message.Decode(*JsonObj))
+	{
+		return false;
+	}
+
+	for (const TSharedPtr<FJsonValue>& Group : *Message.Groups)
+	{
+		FGroupRecord Record;
+		TSharedPtr<FJsonObject> GroupObj = Group->AsObject();
+		if (GroupObj.IsValid() && Record.Decode(*GroupObj))
+		{
+			ScenesByGroup.Add(Record.GroupId, Record.SceneId);
+			MaterializeScene(Record.SceneId);
+			InputFilter.Invalidate();
+		}
+	}
+
+	return true;
+}
+
+bool FMixerInteractivityModule_UE::HandleGroupUpdate(FJsonObject* JsonObj)
+{
+	FGroupsMessage Message;
+	if (!Message.Decode(*JsonObj))
+	{
+		return false;
+	}
+
+	for (const TSharedPtr<FJsonValue>& Group : *Message.Groups)
+	{
+		FGroupRecord Record;
+		TSharedPtr<FJsonObject> GroupObj = Group->AsObject();
+		if (GroupObj.IsValid() && Record.Decode(*GroupObj))
+		{
+			ScenesByGroup.FindChecked(Record.GroupId) = Record.SceneId;
+			MaterializeScene(Record.SceneId);
+			InputFilter.Invalidate();
+		}
+	}
+
+	return true;
+}
+
+bool FMixerInteractivityModule_UE::HandleGroupDelete(FJsonObject* JsonObj)
+{
+	FGroupDeleteMessage Message;
+	if (!Message.Decode(*JsonObj))
+	{
+		return false;
+	}
+
+	ScenesByGroup.Remove(Message.GroupId);
+	InputFilter.Invalidate();
+	ReassignUsers(Message.GroupId, Message.ReassignGroupId);
+	return true;
+}
+
+bool FMixerInteractivityModule_UE::HandleGetScenesReply(FJsonObject* JsonObj)
+{
+	if (!bSessionSeeded)
+	{
+		SetInteractiveConnectionAuthState(EMixerLoginState::Logged_In);
+		SendBandwidthThrottles();
+	}
+	GET_JSON_OBJECT_RETURN_FAILURE(Result, Result);
+
+	FString ScenesJson;
+	const UMixerInteractivitySettings* Settings = GetDefault<UMixerInteractivitySettings>();
+	const bool bUseWarmStart = Settings->bUseWarmStartCache && Settings->InteractiveEndpointOverride.IsEmpty();
+	const uint32 ScenesHash = bUseWarmStart ? FMixerWarmStartCache::SerializeScenes(*Result, ScenesJson) : 0;
+	if (SeededScenesHash != 0 && ScenesHash == SeededScenesHash)
+	{
+		// Exactly what the session was seeded with, so there's nothing to apply
+		UE_LOG(LogMixerInteractivity, Verbose, TEXT("Interactive scenes match the warm start cache."));
+	}
+	else
+	{
+		ParsePropertiesFromGetScenesResult(Result->Get());
+		if (bSessionSeeded)
+		{
+			ReconcileSeededScenes(Result->Get());
+		}
+	}
+	if (bUseWarmStart)
+	{
+		FMixerWarmStartCache::Get().RecordScenes(ScenesJson, ScenesHash);
+	}
+
+	// Controls in scenes left for on-demand parsing are still on their way
+	DropUnclaimedControlReservations([this](FName ControlId) { return FindUnparsedSceneForControl(ControlId) != nullptr; });
+
+	bSessionSeeded = false;
+	SeededScenesHash = 0;
+	bProjectDefinitionSeedPending = false;
+	return true;
+}
+
+void FMixerInteractivityModule_UE::ReconcileSeededScenes(FJsonObject* JsonObj)
+{
+	const TArray<TSharedPtr<FJsonValue>>* Scenes;
+	if (!JsonObj->TryGetArrayField(MixerStringConstants::FieldNames::Scenes, Scenes))
+	{
+		return;
+	}
+
+	// Only the ids are needed, so this is cheap next to parsing even for scenes left for later
+	TSet<FName> LiveScenes;
+	TSet<FName> LiveControls;
+	for (const TSharedPtr<FJsonValue>& Scene : *Scenes)
+	{
+		const TSharedPtr<FJsonObject>* SceneObj;
+		if (!Scene->TryGetObject(SceneObj))
+		{
+			continue;
+		}
+
+		FString SceneIdRaw;
+		if ((*SceneObj)->TryGetStringField(MixerStringConstants::FieldNames::SceneId, SceneIdRaw))
+		{
+			LiveScenes.Add(*SceneIdRaw);
+		}
+
+		const TArray<TSharedPtr<FJsonValue>>* Controls;
+		if ((*SceneObj)->TryGetArrayField(MixerStringConstants::FieldNames::Controls, Controls))
+		{
+			for (const TSharedPtr<FJsonValue>& Control : *Controls)
+			{
+				const TSharedPtr<FJsonObject>* ControlObj;
+				FString ControlIdRaw;
+				if (Control->TryGetObject(ControlObj) && (*ControlObj)->TryGetStringField(MixerStringConstants::FieldNames::ControlId, ControlIdRaw))
+				{
+					LiveControls.Add(*ControlIdRaw);
+				}
+			}
+		}
+	}
+
+	RetireSeededControls([&LiveControls](FName ControlId) { return LiveControls.Contains(ControlId); });
+	for (auto It = ParsedScenes.CreateIterator(); It; ++It)
+	{
+		if (!LiveScenes.Contains(*It))
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+void FMixerInteractivityModule_UE::SendBandwidthThrottles()
+{
+	const UMixerInteractivitySettings* Settings = GetDefault<UMixerInteractivitySettings>();
+	SetCoalesceStickInput(Settings->bCoalesceStickInput);
+
+	const struct
+	{
+		EMixerBandwidthThrottleType Type;
+		const FMixerBandwidthThrottle& Throttle;
+	} Throttles[] =
+	{
+		{ EMixerBandwidthThrottleType::Input, Settings->InputThrottle },
+		{ EMixerBandwidthThrottleType::Participant_Join, Settings->ParticipantJoinThrottle },
+		{ EMixerBandwidthThrottleType::Participant_Leave, Settings->ParticipantLeaveThrottle },
+	};
 
-	for (const TSharedPtr<FJsonValue>& Group : *Groups)
+	TSharedRef<FJsonObject> Params = MakeShared<FJsonObject>();
+	for (const auto& Entry : Throttles)
 	{
-		FString GroupId;
-		FString SceneId;
-		TSharedPtr<FJsonObject> GroupObj = Group->AsObject();
-		if (GroupObj.IsValid()
-			&& GroupObj->TryGetStringField(MixerStringConstants::FieldNames::GroupId, GroupId)
-			&& GroupObj->TryGetStringField(MixerStringConstants::FieldNames::SceneId, SceneId))
+		if (Entry.Throttle.bEnabled)
 		{
-			ScenesByGroup.Add(*GroupId, *SceneId);
+			AddThrottleParams(Params.Get(), Entry.Type, Entry.Throttle.Capacity, Entry.Throttle.DrainRate);
 		}
 	}
 
-	return true;
+	// Service defaults are unthrottled, so there's nothing to say if nothing is enabled
+	if (Params->Values.Num() > 0)
+	{
+		SendMethodMessageObjectParams(MixerStringConstants::MethodNames::SetBandwidthThrottle, nullptr, Params);
+	}
 }
 
-bool FMixerInteractivityModule_UE::HandleGroupUpdate(FJsonObject* JsonObj)
+namespace
 {
-	GET_JSON_ARRAY_RETURN_FAILURE(Groups, Groups);
-	for (const TSharedPtr<FJsonValue>& Group : *Groups)
+	enum class EMixerInputEvent : uint8
 	{
-		FString GroupId;
-		FString SceneId;
-		TSharedPtr<FJsonObject> GroupObj = Group->AsObject();
-		if (GroupObj.IsValid()
-			&& GroupObj->TryGetStringField(MixerStringConstants::FieldNames::GroupId, GroupId)
-			&& GroupObj->TryGetStringField(MixerStringConstants::FieldNames::SceneId, SceneId))
+		Unknown,
+		MouseDown,
+		MouseUp,
+		Move,
+		Submit,
+	};
+
+	EMixerInputEvent ParseInputEvent(const FString& EventType)
+	{
+		static const struct
+		{
+			const FString* Name;
+			EMixerInputEvent Event;
+		} EventTable[] =
 		{
-			ScenesByGroup.FindChecked(*GroupId) = *SceneId;
+			{ &MixerStringConstants::EventTypes::MouseDown, EMixerInputEvent::MouseDown },
+			{ &MixerStringConstants::EventTypes::MouseUp, EMixerInputEvent::MouseUp },
+			{ &MixerStringConstants::EventTypes::Move, EMixerInputEvent::Move },
+			{ &MixerStringConstants::EventTypes::Submit, EMixerInputEvent::Submit },
+		};
+
+		for (const auto& Entry : EventTable)
+		{
+			// Lengths all differ, so this rejects all but one candidate without touching characters
+			if (Entry.Name->Len() == EventType.Len() && Entry.Name->Equals(EventType, ESearchCase::CaseSensitive))
+			{
+				return Entry.Event;
+			}
 		}
+		return EMixerInputEvent::Unknown;
 	}
-
-	return true;
-}
-
-bool FMixerInteractivityModule_UE::HandleGroupDelete(FJsonObject* JsonObj)
-{
-	GET_JSON_STRING_RETURN_FAILURE(GroupId, GroupIdRaw);
-	GET_JSON_STRING_RETURN_FAILURE(ReassignGroupId, ReassignGroupIdRaw);
-
-	FName GroupId = *GroupIdRaw;
-	FName ReassignGroupId = *ReassignGroupIdRaw;
-
-	ScenesByGroup.Remove(GroupId);
-	ReassignUsers(GroupId, ReassignGroupId);
-	return true;
-}
-
-bool FMixerInteractivityModule_UE::HandleGetScenesReply(FJsonObject* JsonObj)
-{
-	SetInteractiveConnectionAuthState(EMixerLoginState::Logged_In);
-	GET_JSON_OBJECT_RETURN_FAILURE(Result, Result);
-	ParsePropertiesFromGetScenesResult(Result->Get());
-	return true;
 }
 
 bool FMixerInteractivityModule_UE::HandleGiveInput(TSharedPtr<FMixerRemoteUser> Participant, FJsonObject* FullParamsJson, const TSharedRef<FJsonObject> InputObjJson)
@@ -465,67 +1460,116 @@ bool FMixerInteractivityModule_UE::HandleGiveInput(TSharedPtr<FMixerRemoteUser>
 	GET_JSON_STRING_RETURN_FAILURE(Event, EventType);
 
 	bool bHandled = false;
-	FName ControlId = *ControlIdRaw;
-	if (EventType == MixerStringConstants::EventTypes::MouseDown)
+	const FMixerControlDirectoryEntry* Control = FindControl(ControlIdRaw);
+	if (Control == nullptr && UnparsedScenes.Num() > 0)
+	{
+		const FName UnparsedControlId(*ControlIdRaw, FNAME_Find);
+		if (FindUnparsedSceneForControl(UnparsedControlId) != nullptr)
+		{
+			// A group moving to a scene parses it, so this is a stale client still showing an old one.  Its
+			// releases still go through, though, so that a press that got in before can't be left held.
+			if (ParseInputEvent(EventType) != EMixerInputEvent::MouseUp || !MaterializeControl(UnparsedControlId))
+			{
+				return true;
+			}
+			Control = FindControl(ControlIdRaw);
+		}
+	}
+	const EMixerInputEvent InputEvent = Control != nullptr ? ParseInputEvent(EventType) : EMixerInputEvent::Unknown;
+
+	// Drop input for controls no group is shown or that are disabled before decoding any more of it.  Releases
+	// still go through so held state can't get stuck.  Custom controls aren't in the directory, hence the FName.
+	if (InputEvent != EMixerInputEvent::MouseUp && RejectsControlInput(Control != nullptr ? Control->ControlId : FName(*ControlIdRaw, FNAME_Find)))
+	{
+		return true;
+	}
+
+	// Charged input is never sampled out, and releases only go with their press, see FMixerInputSampler
+	if (Control != nullptr)
+	{
+		const bool bSampleExempt = FullParamsJson->HasField(MixerStringConstants::FieldNames::TransactionId);
+		const bool bButtonInput = InputEvent == EMixerInputEvent::MouseDown || InputEvent == EMixerInputEvent::MouseUp;
+		const uint32 SampleWeight = bButtonInput
+			? InputSampler.SampleButton(Control->ControlId, Participant.IsValid() ? Participant->SessionGuid : FGuid(), InputEvent == EMixerInputEvent::MouseDown, bSampleExempt)
+			: InputSampler.Sample(Control->ControlId, bSampleExempt);
+		if (SampleWeight == 0)
+		{
+			return true;
+		}
+	}
+
+	switch (InputEvent)
 	{
-		FMixerButtonPropertiesCached* ButtonProps = GetButton(ControlId);
-		if (ButtonProps != nullptr)
+	case EMixerInputEvent::MouseDown:
+		if (Control->Kind == EMixerCachedControlKind::Button)
 		{
+			const FMixerButtonPropertiesCached& ButtonProps = GetButtonPropertiesAt(Control->Index);
 			FMixerButtonEventDetails EventDetails;
 			EventDetails.Pressed = true;
-			if (ButtonProps->Desc.SparkCost > 0)
+			if (ButtonProps.Desc.SparkCost > 0)
 			{
 				FullParamsJson->TryGetStringField(MixerStringConstants::FieldNames::TransactionId, EventDetails.TransactionId);
-				EventDetails.SparkCost = ButtonProps->Desc.SparkCost;
+				EventDetails.SparkCost = ButtonProps.Desc.SparkCost;
 			}
 			else
 			{
 				EventDetails.SparkCost = 0;
 			}
-			OnButtonEvent().Broadcast(ControlId, Participant, EventDetails);
+			if (AdmitButtonInput(Participant.Get(), Control->ControlId, true, EventDetails.SparkCost > 0))
+			{
+				BroadcastButtonEvent(Control->ControlId, Participant, EventDetails);
+				RecordButtonInput(Control->ControlId, Participant.Get(), EventDetails);
+			}
 			bHandled = true;
 		}
-	}
-	else if (EventType == MixerStringConstants::EventTypes::MouseUp)
-	{
-		FMixerButtonPropertiesCached* ButtonProps = GetButton(ControlId);
-		if (ButtonProps != nullptr)
+		break;
+
+	case EMixerInputEvent::MouseUp:
+		if (Control->Kind == EMixerCachedControlKind::Button)
 		{
 			FMixerButtonEventDetails EventDetails;
 			EventDetails.Pressed = false;
 			// Button mouseup doesn't support charging
 			EventDetails.SparkCost = 0;
 
-			OnButtonEvent().Broadcast(ControlId, Participant, EventDetails);
+			if (AdmitButtonInput(Participant.Get(), Control->ControlId, false, false))
+			{
+				BroadcastButtonEvent(Control->ControlId, Participant, EventDetails);
+				RecordButtonInput(Control->ControlId, Participant.Get(), EventDetails);
+			}
 			bHandled = true;
 		}
-	}
-	else if (EventType == MixerStringConstants::EventTypes::Move)
-	{
-		FMixerStickPropertiesCached* Stick = GetStick(ControlId);
-		if (Stick != nullptr)
+		break;
+
+	case EMixerInputEvent::Move:
+		if (Control->Kind == EMixerCachedControlKind::Stick)
 		{
 			GET_JSON_DOUBLE_RETURN_FAILURE(X, X);
 			GET_JSON_DOUBLE_RETURN_FAILURE(Y, Y);
 
-			OnStickEvent().Broadcast(ControlId, Participant, FVector2D(static_cast<float>(X), static_cast<float>(Y)));
+			FVector2D StickValue(static_cast<float>(X), static_cast<float>(Y));
+			if (FilterStickInput(Control->Index, Participant.Get(), StickValue)
+				&& AdmitParticipantInput(Participant.Get(), EMixerInputRateClass::Stick))
+			{
+				DeliverOrCoalesceStickInput(Control->ControlId, Participant, StickValue);
+			}
 			bHandled = true;
 		}
-	}
-	else if (EventType == MixerStringConstants::EventTypes::Submit)
-	{
-		FMixerTextboxPropertiesCached* Textbox = GetTextbox(ControlId);
-		if (Textbox != nullptr)
+		break;
+
+	case EMixerInputEvent::Submit:
+		if (Control->Kind == EMixerCachedControlKind::Textbox)
 		{
+			const FMixerTextboxPropertiesCached& Textbox = GetTextboxPropertiesAt(Control->Index);
 			GET_JSON_STRING_RETURN_FAILURE(Value, Value);
 
 			FMixerTextboxEventDetails EventDetails;
-			EventDetails.SubmittedText = FText::FromString(Value);
-			if (Textbox->Desc.SparkCost > 0)
+			EventDetails.SubmittedText = FMixerLazyText(MoveTemp(Value));
+			if (Textbox.Desc.SparkCost > 0)
 			{
 				if (FullParamsJson->TryGetStringField(MixerStringConstants::FieldNames::TransactionId, EventDetails.TransactionId))
 				{
-					EventDetails.SparkCost = Textbox->Desc.SparkCost;
+					EventDetails.SparkCost = Textbox.Desc.SparkCost;
 				}
 			}
 			else
@@ -533,77 +1577,220 @@ bool FMixerInteractivityModule_UE::HandleGiveInput(TSharedPtr<FMixerRemoteUser>
 				EventDetails.SparkCost = 0;
 			}
 
-			OnTextboxSubmitEvent().Broadcast(ControlId, Participant, EventDetails);
+			if (AdmitParticipantInput(Participant.Get(), EMixerInputRateClass::Textbox, EventDetails.SparkCost > 0))
+			{
+				BroadcastTextboxSubmitEvent(Control->ControlId, Participant, EventDetails);
+				RecordTextboxInput(Control->ControlId, Participant.Get(), EventDetails);
+			}
 			bHandled = true;
 		}
+		break;
+
+	default:
+		break;
 	}
 
-	if (!bHandled)
+	if (!bHandled && AdmitParticipantInput(Participant.Get(), EMixerInputRateClass::CustomControl))
 	{
-		OnCustomControlInput().Broadcast(ControlId, *EventType, Participant, InputObjJson);
+		// Custom controls aren't in the directory, so this is the only place we need a new FName
+		const FName CustomControlId = Control != nullptr ? Control->ControlId : FName(*ControlIdRaw);
+		OnCustomControlInput().Broadcast(CustomControlId, *EventType, Participant, InputObjJson);
+		RecordCustomControlInput(CustomControlId, Participant.Get(), InputObjJson.Get());
 	}
 
 	return true;
 }
 
+struct FMixerInteractivityModule_UE::FParticipantRecord
+{
+	FString Username;
+	FGuid SessionGuid;
+	// Left as a string so that updates for someone who hasn't moved needn't look up an FName
+	FString GroupId;
+	double LastInputAt;
+	double ConnectedAt;
+	int32 UserId;
+	int32 UserLevel;
+
+	BEGIN_MIXER_JSON_SCHEMA(FParticipantRecord, TEXT("participant"))
+		MIXER_JSON_REQUIRED(UserNameNoUnderscore, Username)
+		MIXER_JSON_REQUIRED(UserIdNoUnderscore, UserId)
+		MIXER_JSON_REQUIRED(Level, UserLevel)
+		MIXER_JSON_REQUIRED(LastInputAt, LastInputAt)
+		MIXER_JSON_REQUIRED(ConnectedAt, ConnectedAt)
+		MIXER_JSON_REQUIRED(GroupId, GroupId)
+		MIXER_JSON_REQUIRED(SessionId, SessionGuid)
+	END_MIXER_JSON_SCHEMA()
+};
+
 bool FMixerInteractivityModule_UE::HandleParticipantEvent(FJsonObject* JsonObj, EMixerInteractivityParticipantState EventType)
 {
+	SCOPE_CYCLE_COUNTER(STAT_MixerHandleParticipants);
+
 	GET_JSON_ARRAY_RETURN_FAILURE(Participants, ChangingParticipants);
 
+	// Decode the whole batch first so the caches can be sized once for it
 	bool bHandled = true;
+	TArray<FParticipantRecord> Records;
+	Records.Reserve(ChangingParticipants->Num());
+	int32 NumNewUsers = 0;
 	for (const TSharedPtr<FJsonValue>& Participant : *ChangingParticipants)
 	{
-		bHandled &= HandleSingleParticipantChange(Participant->AsObject().Get(), EventType);
+		FParticipantRecord& Record = Records[Records.AddDefaulted()];
+		if (DecodeParticipant(Participant->AsObject().Get(), Record))
+		{
+			if (!GetCachedUser(Record.UserId).IsValid())
+			{
+				++NumNewUsers;
+			}
+		}
+		else
+		{
+			Records.Pop(false);
+			bHandled = false;
+		}
 	}
-	return bHandled;
-}
 
-bool FMixerInteractivityModule_UE::HandleSingleParticipantChange(const FJsonObject* JsonObj, EMixerInteractivityParticipantState EventType)
-{
-	GET_JSON_STRING_RETURN_FAILURE(UserNameNoUnderscore, Username);
-	GET_JSON_INT_RETURN_FAILURE(UserIdNoUnderscore, UserId);
-	GET_JSON_INT_RETURN_FAILURE(Level, UserLevel);
-	GET_JSON_DOUBLE_RETURN_FAILURE(LastInputAt, LastInputAtDouble);
-	GET_JSON_DOUBLE_RETURN_FAILURE(ConnectedAt, ConnectedAtDouble);
-	GET_JSON_STRING_RETURN_FAILURE(GroupId, GroupId);
-	GET_JSON_STRING_RETURN_FAILURE(SessionId, SessionGuidString);
+	// New users come from the participant pool.
+	// Unknown users that are leaving are only needed for the broadcast, so don't bother.
+	if (EventType == EMixerInteractivityParticipantState::Left)
+	{
+		NumNewUsers = 0;
+	}
+	else if (NumNewUsers > 0)
+	{
+		ReserveUsers(NumNewUsers);
+	}
 
-	FGuid SessionGuid;
-	if (!FGuid::Parse(SessionGuidString, SessionGuid))
+	TArray<TSharedPtr<const FMixerRemoteUser>> ChangedUsers;
+	ChangedUsers.Reserve(Records.Num());
+	int32 NextNewUser = 0;
+	for (const FParticipantRecord& Record : Records)
 	{
-		UE_LOG(LogMixerInteractivity, Error, TEXT("sessionID field %s for participant event was not in the expected format (guid)"), *SessionGuidString);
-		return false;
+		TSharedPtr<FMixerRemoteUser> NewUser;
+		if (NextNewUser < NumNewUsers && !GetCachedUser(Record.UserId).IsValid())
+		{
+			NewUser = AllocateUser();
+			++NextNewUser;
+		}
+
+		TSharedPtr<FMixerRemoteUser> ChangedUser = ApplyParticipantChange(Record, EventType, NewUser);
+		if (ChangedUser.IsValid())
+		{
+			ChangedUsers.Add(ChangedUser);
+		}
+	}
+
+	switch (EventType)
+	{
+	case EMixerInteractivityParticipantState::Joined:	INC_DWORD_STAT_BY(STAT_MixerParticipantsJoined, Records.Num()); break;
+	case EMixerInteractivityParticipantState::Left:		INC_DWORD_STAT_BY(STAT_MixerParticipantsLeft, Records.Num()); break;
+	default:											INC_DWORD_STAT_BY(STAT_MixerParticipantsUpdated, Records.Num()); break;
 	}
 
+	if (ChangedUsers.Num() > 0)
+	{
+		OnParticipantsChanged().Broadcast(ChangedUsers, EventType);
+	}
+
+	return bHandled;
+}
+
+bool FMixerInteractivityModule_UE::DecodeParticipant(const FJsonObject* JsonObj, FParticipantRecord& OutRecord)
+{
+	return JsonObj != nullptr && OutRecord.Decode(*JsonObj);
+}
+
+TSharedPtr<FMixerRemoteUser> FMixerInteractivityModule_UE::ApplyParticipantChange(const FParticipantRecord& Record, EMixerInteractivityParticipantState EventType, TSharedPtr<FMixerRemoteUser> NewUser)
+{
+	const uint32 UserId = static_cast<uint32>(Record.UserId);
 	TSharedPtr<FMixerRemoteUser> RemoteUser = GetCachedUser(UserId);
 	bool bOldInputEnabled = false;
 	bool bExistingUser = false;
+	// A join for someone we already knew about before a reconnect is not news to the game
+	const bool bRejoinAfterResume = UnconfirmedParticipants.Remove(UserId) > 0 && RemoteUser.IsValid();
+	// Nor is one for someone still parked after leaving
+	const bool bRejoinWhileParked = EventType == EMixerInteractivityParticipantState::Joined && ParkedParticipants.Remove(UserId) > 0 && RemoteUser.IsValid();
 	if (RemoteUser.IsValid())
 	{
 		bExistingUser = true;
 		bOldInputEnabled = RemoteUser->InputEnabled;
+
+		if (EventType == EMixerInteractivityParticipantState::Left)
+		{
+			const float GracePeriod = GetDefault<UMixerInteractivitySettings>()->ParticipantRejoinGracePeriod;
+			if (GracePeriod > 0.0f)
+			{
+				// The record stays as it is in case they come straight back; ExpireParkedParticipants reports the leave otherwise.
+				if (!ParkedParticipants.Contains(UserId))
+				{
+					ParkedParticipants.Add(UserId, FPlatformTime::Seconds() + GracePeriod);
+				}
+				return nullptr;
+			}
+		}
+		else if (bRejoinWhileParked)
+		{
+			SetUserSessionGuid(RemoteUser, Record.SessionGuid);
+		}
 	}
 	else
 	{
-		RemoteUser = MakeShared<FMixerRemoteUser>();
+		RemoteUser = NewUser.IsValid() ? NewUser : MakeShared<FMixerRemoteUser>();
 		RemoteUser->Id = UserId;
-		RemoteUser->SessionGuid = SessionGuid;
-		RemoteUser->ConnectedAt = FDateTime::FromUnixTimestamp(static_cast<int64>(ConnectedAtDouble / 1000.0));
+		RemoteUser->SessionGuid = Record.SessionGuid;
+		RemoteUser->ConnectedAt = FDateTime::FromUnixTimestamp(static_cast<int64>(Record.ConnectedAt / 1000.0));
 
 		if (EventType != EMixerInteractivityParticipantState::Left)
 		{
 			AddUser(RemoteUser);
 		}
+		else
+		{
+			ForgetEvictedUser(Record.SessionGuid);
+		}
+	}
+
+	// Updates repeat on every input, usually with nothing but lastInputAt different, so only touch what moved.
+	EMixerParticipantChange Changes = EMixerParticipantChange::None;
+	if (!RemoteUser->Name.Equals(Record.Username, ESearchCase::CaseSensitive))
+	{
+		RemoteUser->Name = Record.Username;
+		Changes |= EMixerParticipantChange::Name;
+	}
+	if (RemoteUser->Level != Record.UserLevel)
+	{
+		RemoteUser->Level = Record.UserLevel;
+		Changes |= EMixerParticipantChange::Level;
+	}
+	// Against the string form, since FName comparison ignores case and group ids don't
+	if (!bExistingUser || !RemoteUser->Group.ToString().Equals(Record.GroupId, ESearchCase::CaseSensitive))
+	{
+		SetUserGroup(RemoteUser, FName(*Record.GroupId));
+		Changes |= EMixerParticipantChange::Group;
+	}
+	RemoteUser->InputAt = FDateTime::FromUnixTimestamp(static_cast<int64>(Record.LastInputAt / 1000.0));
+	UpdateParticipantOrder(*RemoteUser);
+
+	if (bOldInputEnabled != RemoteUser->InputEnabled)
+	{
+		Changes |= EMixerParticipantChange::InputEnabled;
 	}
 
-	RemoteUser->Name = Username;
-	RemoteUser->Level = UserLevel;
-	RemoteUser->InputAt = FDateTime::FromUnixTimestamp(static_cast<int64>(LastInputAtDouble / 1000.0));
-	RemoteUser->Group = *GroupId;
+	if (bExistingUser && EventType == EMixerInteractivityParticipantState::Input_Disabled && Changes != EMixerParticipantChange::None)
+	{
+		OnParticipantUpdated().Broadcast(RemoteUser, Changes);
+	}
 
-	if (EventType != EMixerInteractivityParticipantState::Input_Disabled || bOldInputEnabled != RemoteUser->InputEnabled)
+	bool bChanged = false;
+	if ((bRejoinAfterResume || bRejoinWhileParked) && EventType == EMixerInteractivityParticipantState::Joined)
+	{
+		// Cache has been refreshed, nothing to broadcast
+	}
+	else if (EventType != EMixerInteractivityParticipantState::Input_Disabled || bOldInputEnabled != RemoteUser->InputEnabled)
 	{
 		OnParticipantStateChanged().Broadcast(RemoteUser, EventType);
+		bChanged = true;
 	}
 
 	if (bExistingUser && EventType == EMixerInteractivityParticipantState::Left)
@@ -611,26 +1798,263 @@ bool FMixerInteractivityModule_UE::HandleSingleParticipantChange(const FJsonObje
 		RemoveUser(RemoteUser);
 	}
 
+	return bChanged ? RemoteUser : nullptr;
+}
+
+bool FMixerInteractivityModule_UE::HandleGetActiveParticipantsReply(FJsonObject* JsonObj)
+{
+	EvictedParticipantRequestTime = 0.0;
+
+	const TSharedPtr<FJsonObject>* Result;
+	const TArray<TSharedPtr<FJsonValue>>* ActiveParticipants;
+	if (JsonObj->TryGetObjectField(MixerStringConstants::FieldNames::Result, Result)
+		&& (*Result)->TryGetArrayField(MixerStringConstants::FieldNames::Participants, ActiveParticipants))
+	{
+		for (const TSharedPtr<FJsonValue>& ParticipantValue : *ActiveParticipants)
+		{
+			const TSharedPtr<FJsonObject>* ParticipantObj;
+			FParticipantRecord Record;
+			if (ParticipantValue->TryGetObject(ParticipantObj)
+				&& DecodeParticipant(ParticipantObj->Get(), Record)
+				&& WasUserEvicted(Record.SessionGuid))
+			{
+				// Back into the cache without telling the game; as far as it knows they never left
+				FMixerRemoteUser Participant;
+				Participant.Id = Record.UserId;
+				Participant.SessionGuid = Record.SessionGuid;
+				Participant.Name = Record.Username;
+				Participant.Level = Record.UserLevel;
+				Participant.Group = *Record.GroupId;
+				Participant.ConnectedAt = FDateTime::FromUnixTimestamp(static_cast<int64>(Record.ConnectedAt / 1000.0));
+				Participant.InputAt = FDateTime::UtcNow();
+				RestoreEvictedUser(Participant);
+			}
+		}
+	}
+
+	// Anyone still missing gets their input delivered without participant information, as for any unknown sender
+	TArray<TSharedPtr<FJsonObject>> DeferredInput = MoveTemp(InputAwaitingParticipants);
+	for (const TSharedPtr<FJsonObject>& FullParamsJson : DeferredInput)
+	{
+		HandleGiveInput(FullParamsJson.Get(), false);
+	}
+
 	return true;
 }
 
+void FMixerInteractivityModule_UE::SeedSessionFromProjectDefinition()
+{
+	FMixerProjectAssetPreloader& Preloader = FMixerProjectAssetPreloader::Get();
+	if (!GetDefault<UMixerInteractivitySettings>()->bPreloadProjectAssets)
+	{
+		// Nothing is streaming it in, so this is the first use that loads it
+		SeedSessionFromLoadedProjectDefinition(Preloader.GetProjectDefinition(true));
+		return;
+	}
+
+	if (Preloader.IsComplete())
+	{
+		SeedSessionFromLoadedProjectDefinition(Preloader.GetProjectDefinition(false));
+		return;
+	}
+
+	// Still on its way.  Seed when it lands, provided the service's scenes haven't beaten it here.
+	bProjectDefinitionSeedPending = true;
+	Preloader.WhenComplete(FSimpleDelegate::CreateLambda([this]()
+	{
+		// The preloader forgets its callbacks before the module goes away
+		if (bProjectDefinitionSeedPending)
+		{
+			bProjectDefinitionSeedPending = false;
+			if (!bSessionSeeded)
+			{
+				SeedSessionFromLoadedProjectDefinition(FMixerProjectAssetPreloader::Get().GetProjectDefinition(false));
+			}
+		}
+	}));
+}
+
+void FMixerInteractivityModule_UE::SeedSessionFromLoadedProjectDefinition(const UMixerProjectAsset* ProjectAsset)
+{
+	const UMixerInteractivitySettings* Settings = GetDefault<UMixerInteractivitySettings>();
+	if (ProjectAsset == nullptr || ProjectAsset->ParsedProjectDefinition.Controls.Scenes.Num() == 0)
+	{
+		UE_LOG(LogMixerInteractivity, Warning, TEXT("No Project Definition to seed the interactive session from; waiting on the service for scenes."));
+		return;
+	}
+
+	const FMixerInteractiveGameVersion& Definition = ProjectAsset->ParsedProjectDefinition;
+	if (static_cast<int32>(Definition.Id) != Settings->GameVersionId)
+	{
+		UE_LOG(LogMixerInteractivity, Warning, TEXT("Project Definition is for game version %d, not %d; waiting on the service for scenes."), Definition.Id, Settings->GameVersionId);
+		return;
+	}
+
+	// Laid out like the getScenes result so that it goes through the same parsing (and deferral)
+	TArray<TSharedPtr<FJsonValue>> ScenesJson;
+	ScenesJson.Reserve(Definition.Controls.Scenes.Num());
+	for (const FMixerInteractiveScene& Scene : Definition.Controls.Scenes)
+	{
+		TArray<TSharedPtr<FJsonValue>> ControlsJson;
+		ControlsJson.Reserve(Scene.Controls.Num());
+		for (const FMixerInteractiveControl& Control : Scene.Controls)
+		{
+			TSharedRef<FJsonObject> ControlJson = MakeShared<FJsonObject>();
+			ControlJson->SetStringField(MixerStringConstants::FieldNames::ControlId, Control.Id);
+			ControlJson->SetStringField(MixerStringConstants::FieldNames::Kind, Control.Kind);
+			ControlsJson.Add(MakeShared<FJsonValueObject>(ControlJson));
+		}
+
+		TSharedRef<FJsonObject> SceneJson = MakeShared<FJsonObject>();
+		SceneJson->SetStringField(MixerStringConstants::FieldNames::SceneId, Scene.Id);
+		SceneJson->SetArrayField(MixerStringConstants::FieldNames::Controls, ControlsJson);
+		ScenesJson.Add(MakeShared<FJsonValueObject>(SceneJson));
+	}
+
+	FJsonObject ResultJson;
+	ResultJson.SetArrayField(MixerStringConstants::FieldNames::Scenes, ScenesJson);
+	if (ParsePropertiesFromGetScenesResult(&ResultJson))
+	{
+		bSessionSeeded = true;
+	}
+}
+
+void FMixerInteractivityModule_UE::SeedSessionFromWarmStartCache()
+{
+	// Test servers have scenes of their own
+	if (!GetDefault<UMixerInteractivitySettings>()->InteractiveEndpointOverride.IsEmpty())
+	{
+		return;
+	}
+
+	uint32 ScenesHash = 0;
+	TSharedPtr<FJsonObject> CachedScenes = FMixerWarmStartCache::Get().GetScenes(ScenesHash);
+	if (CachedScenes.IsValid() && ParsePropertiesFromGetScenesResult(CachedScenes.Get()))
+	{
+		UE_LOG(LogMixerInteractivity, Verbose, TEXT("Seeded interactive session from the warm start cache."));
+		bSessionSeeded = true;
+		SeededScenesHash = ScenesHash;
+	}
+}
+
 bool FMixerInteractivityModule_UE::ParsePropertiesFromGetScenesResult(FJsonObject *JsonObj)
 {
 	GET_JSON_ARRAY_RETURN_FAILURE(Scenes, Scenes);
+	const bool bParseScenesOnDemand = GetDefault<UMixerInteractivitySettings>()->bParseScenesOnDemand;
 	for (const TSharedPtr<FJsonValue>& Scene : *Scenes)
 	{
-		ParsePropertiesFromSingleScene(Scene->AsObject().Get());
+		TSharedPtr<FJsonObject> SceneObj = Scene->AsObject();
+		if (!SceneObj.IsValid())
+		{
+			continue;
+		}
+
+		if (bParseScenesOnDemand)
+		{
+			// Scenes a group is on (the service omits empty group lists) and scenes already in use are needed now
+			FString SceneIdRaw;
+			const TArray<TSharedPtr<FJsonValue>>* Groups;
+			SceneObj->TryGetStringField(MixerStringConstants::FieldNames::SceneId, SceneIdRaw);
+			const FName SceneId = *SceneIdRaw;
+			const bool bNeededNow = SceneId == NAME_DefaultMixerParticipantGroup
+				|| ParsedScenes.Contains(SceneId)
+				|| (SceneObj->TryGetArrayField(MixerStringConstants::FieldNames::Groups, Groups) && Groups->Num() > 0);
+			if (!bNeededNow)
+			{
+				UnparsedScenes.Add(SceneId, SceneObj);
+				UnparsedSceneByControl.Empty();
+				bUnparsedSceneIndexBuilt = false;
+				continue;
+			}
+
+			UnparsedScenes.Remove(SceneId);
+		}
+
+		ParsePropertiesFromSingleScene(SceneObj.Get());
+	}
+
+	if (UnparsedScenes.Num() > 0)
+	{
+		UE_LOG(LogMixerInteractivity, Verbose, TEXT("Deferred parsing %d of %d interactive scenes until first use."), UnparsedScenes.Num(), Scenes->Num());
+	}
+
+	return true;
+}
+
+bool FMixerInteractivityModule_UE::MaterializeControl(FName ControlId)
+{
+	const FName* SceneId = FindUnparsedSceneForControl(ControlId);
+	return SceneId != nullptr && MaterializeScene(*SceneId);
+}
+
+const FName* FMixerInteractivityModule_UE::FindUnparsedSceneForControl(FName ControlId)
+{
+	if (UnparsedScenes.Num() == 0)
+	{
+		return nullptr;
+	}
+
+	if (!bUnparsedSceneIndexBuilt)
+	{
+		// Reads only the ids - still far cheaper than fully parsing every control
+		for (const TPair<FName, TSharedPtr<FJsonObject>>& Scene : UnparsedScenes)
+		{
+			const TArray<TSharedPtr<FJsonValue>>* Controls;
+			if (Scene.Value->TryGetArrayField(MixerStringConstants::FieldNames::Controls, Controls))
+			{
+				for (const TSharedPtr<FJsonValue>& Control : *Controls)
+				{
+					const TSharedPtr<FJsonObject>* ControlObj;
+					FString ControlIdRaw;
+					if (Control->TryGetObject(ControlObj) && (*ControlObj)->TryGetStringField(MixerStringConstants::FieldNames::ControlId, ControlIdRaw))
+					{
+						UnparsedSceneByControl.Add(*ControlIdRaw, Scene.Key);
+					}
+				}
+			}
+		}
+		bUnparsedSceneIndexBuilt = true;
+	}
+
+	return UnparsedSceneByControl.Find(ControlId);
+}
+
+void FMixerInteractivityModule_UE::GetActiveScenes(TSet<FName>& OutScenes)
+{
+	for (const TPair<FName, FName>& GroupScene : ScenesByGroup)
+	{
+		OutScenes.Add(GroupScene.Value);
+	}
+}
+
+bool FMixerInteractivityModule_UE::MaterializeScene(FName SceneId)
+{
+	TSharedPtr<FJsonObject> SceneObj;
+	if (!UnparsedScenes.RemoveAndCopyValue(SceneId, SceneObj))
+	{
+		return false;
 	}
 
+	UE_LOG(LogMixerInteractivity, Verbose, TEXT("Parsing interactive scene %s on first use."), *SceneId.ToString());
+	ParsePropertiesFromSingleScene(SceneObj.Get());
 	return true;
 }
 
+void FMixerInteractivityModule_UE::ResetUnparsedScenes()
+{
+	UnparsedScenes.Empty();
+	ParsedScenes.Empty();
+	UnparsedSceneByControl.Empty();
+	bUnparsedSceneIndexBuilt = false;
+}
+
 bool FMixerInteractivityModule_UE::ParsePropertiesFromSingleScene(FJsonObject* JsonObj)
 {
 	GET_JSON_ARRAY_RETURN_FAILURE(Controls, Controls);
 	GET_JSON_STRING_RETURN_FAILURE(SceneId, SceneIdRaw);
 
 	FName SceneId = *SceneIdRaw;
+	ParsedScenes.Add(SceneId);
 	for (const TSharedPtr<FJsonValue>& Control : *Controls)
 	{
 		ParsePropertiesFromSingleControl(SceneId, Control->AsObject().ToSharedRef());
@@ -647,6 +2071,7 @@ bool FMixerInteractivityModule_UE::ParsePropertiesFromSingleScene(FJsonObject* J
 			if (GroupObj.IsValid() && GroupObj->TryGetStringField(MixerStringConstants::FieldNames::GroupId, GroupId))
 			{
 				ScenesByGroup.Add(*GroupId, SceneId);
+				InputFilter.Invalidate();
 			}
 		}
 	}
@@ -659,33 +2084,52 @@ bool FMixerInteractivityModule_UE::ParsePropertiesFromSingleControl(FName SceneI
 	GET_JSON_STRING_RETURN_FAILURE(Kind, ControlKind);
 	GET_JSON_STRING_RETURN_FAILURE(ControlId, ControlId);
 
+	NoteControlScene(*ControlId, SceneId);
+
 	if (ControlKind == FMixerInteractiveControl::ButtonKind)
 	{
 		FMixerButtonPropertiesCached Button;
 		FString FieldValueScratch;
 		JsonObj->TryGetStringField(MixerStringConstants::FieldNames::Text, FieldValueScratch);
-		Button.Desc.ButtonText = FText::FromString(FieldValueScratch);
+		Button.Desc.ButtonText = FMixerLazyText(MoveTemp(FieldValueScratch));
+		FieldValueScratch.Empty();
 		JsonObj->TryGetStringField(MixerStringConstants::FieldNames::Tooltip, FieldValueScratch);
-		Button.Desc.HelpText = FText::FromString(FieldValueScratch);
+		Button.Desc.HelpText = FMixerLazyText(MoveTemp(FieldValueScratch));
 		JsonObj->TryGetNumberField(MixerStringConstants::FieldNames::Cost, Button.Desc.SparkCost);
 
-		// Disabled and cooldown shouldn't be set initially
-
-		Button.State.DownCount = 0;
-		Button.State.UpCount = 0;
-		Button.State.PressCount = 0;
-		Button.State.Enabled = true;
-		Button.State.RemainingCooldown = FTimespan::Zero();
-		Button.State.Progress = 0.0f;
 		Button.SceneId = SceneId;
 
-		AddButton(*ControlId, Button);
+		// Disabled and cooldown shouldn't be set initially
+		FMixerButtonState InitialState;
+		InitialState.DownCount = 0;
+		InitialState.UpCount = 0;
+		InitialState.PressCount = 0;
+		InitialState.Enabled = true;
+		InitialState.RemainingCooldown = FTimespan::Zero();
+		InitialState.Progress = 0.0f;
+
+		const int32 SeededIndex = bSessionSeeded ? FindButton(*ControlId) : INDEX_NONE;
+		if (SeededIndex != INDEX_NONE)
+		{
+			// Keep whatever input has arrived since the session was seeded
+			FMixerButtonPropertiesCached& SeededButton = GetButtonPropertiesAt(SeededIndex);
+			SeededButton.Desc = Button.Desc;
+			SeededButton.SceneId = SceneId;
+		}
+		else
+		{
+			AddButton(*ControlId, Button, InitialState);
+		}
 	}
 	else if (ControlKind == FMixerInteractiveControl::JoystickKind)
 	{
-		FMixerStickPropertiesCached Stick;
-		Stick.State.Enabled = true;
-		AddStick(*ControlId, Stick);
+		if (!bSessionSeeded || FindStick(*ControlId) == INDEX_NONE)
+		{
+			FMixerStickState InitialState;
+			InitialState.Axes = FVector2D(0, 0);
+			InitialState.Enabled = true;
+			AddStick(*ControlId, FMixerStickPropertiesCached(), InitialState);
+		}
 	}
 	else if (ControlKind == FMixerInteractiveControl::LabelKind)
 	{
@@ -698,7 +2142,7 @@ bool FMixerInteractivityModule_UE::ParsePropertiesFromSingleControl(FName SceneI
 		FString FieldValueScratch;
 		if (JsonObj->TryGetStringField(MixerStringConstants::FieldNames::Text, FieldValueScratch))
 		{
-			Label.Desc.Text = FText::FromString(FieldValueScratch);
+			Label.Desc.Text = FMixerLazyText(MoveTemp(FieldValueScratch));
 		}
 
 		if (JsonObj->TryGetStringField(MixerStringConstants::FieldNames::TextColor, FieldValueScratch))
@@ -716,7 +2160,17 @@ bool FMixerInteractivityModule_UE::ParsePropertiesFromSingleControl(FName SceneI
 		JsonObj->TryGetBoolField(MixerStringConstants::FieldNames::Italic, Label.Desc.Italic);
 
 		Label.SceneId = SceneId;
-		AddLabel(*ControlId, Label);
+
+		FMixerLabelPropertiesCached* SeededLabel = bSessionSeeded ? GetLabel(*ControlId) : nullptr;
+		if (SeededLabel != nullptr)
+		{
+			// The game may already have changed the text since the session was seeded
+			SeededLabel->SceneId = SceneId;
+		}
+		else
+		{
+			AddLabel(*ControlId, Label);
+		}
 	}
 	else if (ControlKind == FMixerInteractiveControl::TextboxKind)
 	{
@@ -727,11 +2181,11 @@ bool FMixerInteractivityModule_UE::ParsePropertiesFromSingleControl(FName SceneI
 		FString FieldValueScratch;
 		if (JsonObj->TryGetStringField(MixerStringConstants::FieldNames::Placeholder, FieldValueScratch))
 		{
-			Textbox.Desc.Placeholder = FText::FromString(FieldValueScratch);
+			Textbox.Desc.Placeholder = FMixerLazyText(MoveTemp(FieldValueScratch));
 		}
 		if (JsonObj->TryGetStringField(MixerStringConstants::FieldNames::SubmitText, FieldValueScratch))
 		{
-			Textbox.Desc.SubmitText = FText::FromString(FieldValueScratch);
+			Textbox.Desc.SubmitText = FMixerLazyText(MoveTemp(FieldValueScratch));
 		}
 		AddTextbox(*ControlId, Textbox);
 	}
@@ -14,6 +14,8 @@
 #if MIXER_BACKEND_UE
 
 #include "MixerWebSocketOwnerBase.h"
+#include "MixerEndpointSelector.h"
+#include "MixerInteractiveHostsCache.h"
 
 class FMixerInteractivityModule_UE
 	: public FMixerInteractivityModule_WithSessionState
@@ -26,15 +28,33 @@ public:
 	virtual void StartInteractivity();
 	virtual void StopInteractivity();
 	virtual void SetCurrentScene(FName Scene, FName GroupName = NAME_None);
+	virtual bool SetScenesForGroups(TArrayView<const FMixerGroupSpec> Assignments, const FOnGroupBatchComplete& OnComplete = FOnGroupBatchComplete());
 	virtual FName GetCurrentScene(FName GroupName = NAME_None);
 	virtual bool CreateGroup(FName GroupName, FName InitialScene = NAME_None);
+	virtual bool CreateGroups(TArrayView<const FMixerGroupSpec> Groups, const FOnGroupBatchComplete& OnComplete = FOnGroupBatchComplete());
 	virtual bool MoveParticipantToGroup(FName GroupName, uint32 ParticipantId);
-	virtual void CaptureSparkTransaction(const FString& TransactionId);
+	virtual bool MoveParticipantsToGroup(FName GroupName, TArrayView<const uint32> ParticipantIds);
+	virtual bool SetBandwidthThrottle(EMixerBandwidthThrottleType ThrottleType, uint32 MaxBytes, uint32 BytesPerSecond);
 	virtual void CallRemoteMethod(const FString& MethodName, const TSharedRef<FJsonObject> MethodParams);
+	virtual void CallRemoteMethodSerialized(const FString& MethodName, TArrayView<const uint8> Utf8Params);
+	virtual bool CallRemoteMethodAsync(const FString& MethodName, const TSharedRef<FJsonObject> MethodParams, const FOnRemoteMethodReply& OnReply);
+
+public:
+	virtual bool Tick(float DeltaTime) override;
+	virtual void GetContainerSizes(TFunctionRef<void(const TCHAR* Name, int64 Size)> Visit) const override;
+
+#if MIXER_BENCHMARKS_ENABLED
+	virtual bool BeginBenchmarkSession(const FString& ScenesResult) override;
+	virtual void ReceiveBenchmarkFrame(const FString& Frame) override;
+	virtual void PumpBenchmarkSession() override;
+	virtual void EndBenchmarkSession() override;
+#endif
 
 protected:
 	virtual bool StartInteractiveConnection();
 	virtual void StopInteractiveConnection();
+	virtual void PrefetchInteractiveHosts();
+	virtual void SendSparkCapture(const FString& TransactionId);
 
 protected:
 	virtual void RegisterAllServerMessageHandlers();
@@ -43,13 +63,30 @@ protected:
 	virtual void HandleSocketConnected();
 	virtual void HandleSocketConnectionError();
 	virtual void HandleSocketClosed(bool bWasClean);
+	virtual FString GetHealthPingMethodName() const override;
+	virtual void HandleHealthPingReply(FJsonObject* JsonObj, double RoundTrip) override;
+	virtual bool IsBulkMethod(const FString& MethodName) const override;
+	virtual bool IsUrgentSend() const override { return IsSendingUrgentControlUpdates(); }
+	virtual void HandleConnectionDegraded() override;
+	virtual bool CanEvictUser(const FMixerRemoteUser& User) const override { return !ParkedParticipants.Contains(User.Id); }
 
 private:
-	void OnHostsRequestComplete(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded);
+	void OnHostsReceived(const TArray<FString>& Hosts);
+	void OnHostsRefreshed(const TArray<FString>& Hosts);
+	void OnEndpointsRanked(const TArray<FString>& RankedEndpoints);
 
 	void OpenWebSocket();
 
+	bool ShouldResumeSession() const;
+	void ScheduleReconnect();
+	void AbandonSession();
+	void ReconcileResumedParticipants();
+	void ExpireParkedParticipants(double Now);
+
 	bool CreateOrUpdateGroup(const FString& MethodName, FName Scene, FName GroupName);
+	TSharedRef<FJsonObject> MakeGroupParamEntry(FName Scene, FName GroupName);
+	bool SendGroupBatch(const FString& MethodName, const TArray<TSharedPtr<FJsonObject>>& Entries, const FOnGroupBatchComplete& OnComplete);
+	virtual void ApplySceneChangeLocally(FName Scene, FName GroupName) override;
 
 	bool HandleHello(FJsonObject* JsonObj);
 	bool HandleGiveInput(FJsonObject* JsonObj);
@@ -62,18 +99,104 @@ private:
 	bool HandleGroupDelete(FJsonObject* JsonObj);
 
 	bool HandleGetScenesReply(FJsonObject* JsonObj);
-
+	bool HandleGetActiveParticipantsReply(FJsonObject* JsonObj);
+	bool HandleCaptureReply(FJsonObject* JsonObj);
+	void ExpireSparkCaptures(double Now);
+	bool HandleGroupBatchReply(FJsonObject* JsonObj);
+	void ExpireGroupBatches(double Now);
+	void AbandonGroupBatches();
+	bool HandleRemoteMethodReply(FJsonObject* JsonObj);
+	void ExpireRemoteMethodCalls(double Now);
+	void AbandonRemoteMethodCalls();
+
+	void SendBandwidthThrottles();
+
+	bool HandleGiveInput(FJsonObject* JsonObj, bool bDeferForEvictedParticipant);
 	bool HandleGiveInput(TSharedPtr<FMixerRemoteUser> Participant, FJsonObject* FullParamsJson, const TSharedRef<FJsonObject> InputObjJson);
-	bool HandleParticipantEvent(FJsonObject* JsonObj, EMixerInteractivityParticipantState EventType);
-	bool HandleSingleParticipantChange(const FJsonObject* JsonObj, EMixerInteractivityParticipantState EventType);
+	void DeferInputForEvictedParticipant(const FJsonObject& FullParamsJson);
+	struct FParticipantRecord;
 
+	bool HandleParticipantEvent(FJsonObject* JsonObj, EMixerInteractivityParticipantState EventType);
+	bool DecodeParticipant(const FJsonObject* JsonObj, FParticipantRecord& OutRecord);
+	TSharedPtr<FMixerRemoteUser> ApplyParticipantChange(const FParticipantRecord& Record, EMixerInteractivityParticipantState EventType, TSharedPtr<FMixerRemoteUser> NewUser);
+
+	void SeedSessionFromProjectDefinition();
+	void SeedSessionFromLoadedProjectDefinition(const class UMixerProjectAsset* ProjectAsset);
+	void SeedSessionFromWarmStartCache();
+	virtual bool MaterializeControl(FName ControlId) override;
+	virtual bool MaterializeScene(FName SceneId) override;
+	virtual void GetActiveScenes(TSet<FName>& OutScenes) override;
+	const FName* FindUnparsedSceneForControl(FName ControlId);
+	void ResetUnparsedScenes();
 	bool ParsePropertiesFromGetScenesResult(FJsonObject *JsonObj);
+	/** Drop what a seeded session has that the service's scene list doesn't. */
+	void ReconcileSeededScenes(FJsonObject* JsonObj);
 	bool ParsePropertiesFromSingleScene(FJsonObject* JsonObj);
 	bool ParsePropertiesFromSingleControl(FName SceneId, TSharedRef<FJsonObject> JsonObj);
 
 private:
 	TArray<FString> Endpoints;
+	FString CurrentEndpoint;
+	TSharedRef<FMixerEndpointSelector> EndpointSelector;
+	TSharedRef<FMixerInteractiveHostsCache> HostsCache;
+	bool bAwaitingHostsRefresh;
 	TMap<FName, FName> ScenesByGroup;
+
+	// Controls came from the cooked Project Definition or the warm start cache; getScenes is applied over them rather than creating them
+	bool bSessionSeeded;
+	// Hash of the warm start scenes the session was seeded from, 0 if it wasn't
+	uint32 SeededScenesHash;
+	// Waiting on the preloader to seed from the Project Definition; cleared once getScenes has answered
+	bool bProjectDefinitionSeedPending;
+
+	// Scenes no group was showing, kept as received until first needed (bParseScenesOnDemand)
+	TMap<FName, TSharedPtr<FJsonObject>> UnparsedScenes;
+	TSet<FName> ParsedScenes;
+	// Which unparsed scene each control is in.  Only built once something asks for a control we don't have.
+	TMap<FName, FName> UnparsedSceneByControl;
+	bool bUnparsedSceneIndexBuilt;
+
+	// Reconnect/resume state.  Session caches are left intact while these are active.
+	TSet<uint32> UnconfirmedParticipants;
+	double NextReconnectTime;
+	double ParticipantReconcileTime;
+	int32 ReconnectAttempts;
+	bool bResumingSession;
+	bool bResumeInteractivity;
+
+	// Participants who have left but are kept in the cache for ParticipantRejoinGracePeriod, and when that ends
+	TMap<uint32, double> ParkedParticipants;
+
+	// Input from participants evicted from the cache, replayed once getActiveParticipants has brought them back
+	TArray<TSharedPtr<FJsonObject>> InputAwaitingParticipants;
+	double EvictedParticipantRequestTime;
+
+	struct FSparkCaptureInFlight
+	{
+		FString TransactionId;
+		double SentAt;
+	};
+
+	// Capture requests awaiting a reply, by message id
+	TMap<int32, FSparkCaptureInFlight> SparkCapturesInFlight;
+
+	struct FGroupBatchInFlight
+	{
+		FOnGroupBatchComplete OnComplete;
+		double SentAt;
+	};
+
+	// CreateGroups/SetScenesForGroups requests awaiting a reply, by message id
+	TMap<int32, FGroupBatchInFlight> GroupBatchesInFlight;
+
+	struct FRemoteMethodCallInFlight
+	{
+		FOnRemoteMethodReply OnReply;
+		double SentAt;
+	};
+
+	// CallRemoteMethodAsync requests awaiting a reply, by message id
+	TMap<int32, FRemoteMethodCallInFlight> RemoteMethodCallsInFlight;
 };
 
 #endif
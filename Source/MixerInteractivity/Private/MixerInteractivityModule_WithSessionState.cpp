@@ -11,66 +11,300 @@
 #include "MixerInteractivityModule_WithSessionState.h"
 #include "MixerJsonHelpers.h"
 #include "MixerInteractivityLog.h"
+#include "MixerInteractivitySettings.h"
+#include "MixerInteractivityStats.h"
+#include "MixerInteractivityLLM.h"
+#include "MixerCsvStats.h"
+#include "MixerFrameScheduler.h"
+#include "MixerAllocationGuard.h"
+#include "MixerInteractivityProjectAsset.h"
+#include "MixerProjectAssetPreloader.h"
+#include "Math/VectorRegister.h"
+#include "Async/ParallelFor.h"
+#include "Misc/ScopeLock.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Cached participants"), STAT_MixerCachedParticipants, STATGROUP_MixerInteractivity);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Evicted participants"), STAT_MixerEvictedParticipants, STATGROUP_MixerInteractivity);
+DECLARE_MEMORY_STAT(TEXT("Participant cache"), STAT_MixerParticipantCacheMemory, STATGROUP_MixerInteractivity);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Button input dropped (participant rate)"), STAT_MixerButtonInputRateDropped, STATGROUP_MixerInteractivity);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Stick input dropped (participant rate)"), STAT_MixerStickInputRateDropped, STATGROUP_MixerInteractivity);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Textbox input dropped (participant rate)"), STAT_MixerTextboxInputRateDropped, STATGROUP_MixerInteractivity);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Custom control input dropped (participant rate)"), STAT_MixerCustomInputRateDropped, STATGROUP_MixerInteractivity);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Stick input dropped (filter)"), STAT_MixerStickInputFiltered, STATGROUP_MixerInteractivity);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Input dropped (frame budget)"), STAT_MixerInputBudgetDropped, STATGROUP_MixerInteractivity);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Input skipped (sampling)"), STAT_MixerInputSampledOut, STATGROUP_MixerInteractivity);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Input dropped (inactive control)"), STAT_MixerInputInactiveDropped, STATGROUP_MixerInteractivity);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Input dropped total"), STAT_MixerInputDroppedTotal, STATGROUP_MixerInteractivity);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Button input"), STAT_MixerButtonInput, STATGROUP_MixerInteractivity);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Stick input"), STAT_MixerStickInput, STATGROUP_MixerInteractivity);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Textbox input"), STAT_MixerTextboxInput, STATGROUP_MixerInteractivity);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Custom control input"), STAT_MixerCustomInput, STATGROUP_MixerInteractivity);
+DECLARE_CYCLE_STAT(TEXT("Summarize group input"), STAT_MixerSummarizeGroupInput, STATGROUP_MixerInteractivity);
+
+namespace
+{
+	// The cache is only measured this often, since it means visiting every participant
+	const double ParticipantCacheMaintenanceInterval = 5.0;
+
+	// Below this much input per tick, handing groups to the task graph costs more than summarizing them in place
+	const int32 MinInputForParallelGroupSummary = 256;
+
+	// Blocks of a participant order split beyond this many entries, and fold into their successor below a quarter of it
+	const int32 MaxParticipantOrderBlockSize = 128;
+
+	int64 GetParticipantSortValue(const FMixerRemoteUser& User, EMixerParticipantSortKey SortKey)
+	{
+		switch (SortKey)
+		{
+		case EMixerParticipantSortKey::Level:
+			return User.Level;
+		case EMixerParticipantSortKey::ConnectedAt:
+			return User.ConnectedAt.GetTicks();
+		default:
+			return User.InputAt.GetTicks();
+		}
+	}
+}
+
+FMixerInteractivityModule_WithSessionState::FMixerInteractivityModule_WithSessionState()
+	: InputArrivalTime(0.0)
+	, NextParticipantCacheMaintenanceTime(0.0)
+	, NumParticipantSlots(0)
+	, ControlGeneration(1)
+	, ServerTimeOffsetMs(0)
+	, ReservedLayoutHash(0)
+	, PublishedSnapshot(INDEX_NONE)
+	, SnapshotVersion(0)
+	, MaxInputEventsPerFrame(0)
+	, InputFrameNumber(1)
+	, InputEventsThisFrame(0)
+	, ParticipantsWithInputThisFrame(0)
+	, FairInputShare(MAX_int32)
+	, SmoothedInputArrivals(0.0f)
+	, bPerParticipantState(false)
+	, bPerParticipantStateAllowed(false)
+	, NumHeldButtonSlots(0)
+	, bCoalesceStickInput(false)
+	, NextVoteRoundId(1)
+	, ParticipantEnrichment(MakeShared<FMixerParticipantEnrichment>())
+{
+	FMemory::Memzero(InputRateLimits);
+	ParticipantEnrichment->OnBatchResolved().BindRaw(this, &FMixerInteractivityModule_WithSessionState::OnParticipantEnrichmentResolved);
+}
 
 void FMixerInteractivityModule_WithSessionState::TriggerButtonCooldown(FName Button, FTimespan CooldownTime)
 {
-	FMixerButtonPropertiesCached* CachedButton = Buttons.Find(Button);
-	if (CachedButton != nullptr)
+	FMixerControlHandle Handle;
+	if (ResolveButton(Button, Handle))
 	{
-		double NewCooldownTime = static_cast<double>((FDateTime::UtcNow() + CooldownTime).ToUnixTimestamp() * 1000);
-		TSharedRef<FJsonObject> UpdatedProps = MakeShared<FJsonObject>();
-		UpdatedProps->SetNumberField(TEXT("cooldown"), NewCooldownTime);
-		UpdateRemoteControl(CachedButton->SceneId, Button, UpdatedProps);
+		TriggerButtonCooldown(Handle, CooldownTime);
 	}
 }
 
 bool FMixerInteractivityModule_WithSessionState::GetButtonDescription(FName Button, FMixerButtonDescription& OutDesc)
 {
-	FMixerButtonPropertiesCached* CachedProps = Buttons.Find(Button);
-	if (CachedProps != nullptr)
+	FMixerControlHandle Handle;
+	return ResolveButton(Button, Handle) && GetButtonDescription(Handle, OutDesc);
+}
+
+bool FMixerInteractivityModule_WithSessionState::GetButtonState(FName Button, FMixerButtonState& OutState)
+{
+	FMixerControlHandle Handle;
+	return ResolveButton(Button, Handle) && GetButtonState(Handle, OutState);
+}
+
+bool FMixerInteractivityModule_WithSessionState::GetButtonState(FName Button, uint32 ParticipantId, FMixerButtonState& OutState)
+{
+	FMixerControlHandle Handle;
+	ResolveButton(Button, Handle);
+	// Always forward so that the missing per-participant state error is reported either way
+	return GetButtonState(Handle, ParticipantId, OutState);
+}
+
+bool FMixerInteractivityModule_WithSessionState::GetButtonState(FName Button, FName GroupName, FMixerButtonState& OutState)
+{
+	FMixerControlHandle Handle;
+	ResolveButton(Button, Handle);
+	return GetButtonState(Handle, GroupName, OutState);
+}
+
+bool FMixerInteractivityModule_WithSessionState::GetStickDescription(FName Stick, FMixerStickDescription& OutDesc)
+{
+	// No supported properties
+	return false;
+}
+
+bool FMixerInteractivityModule_WithSessionState::GetStickState(FName Stick, FMixerStickState& OutState)
+{
+	FMixerControlHandle Handle;
+	ResolveStick(Stick, Handle);
+	return GetStickState(Handle, OutState);
+}
+
+bool FMixerInteractivityModule_WithSessionState::GetStickState(FName Stick, uint32 ParticipantId, FMixerStickState& OutState)
+{
+	FMixerControlHandle Handle;
+	ResolveStick(Stick, Handle);
+	return GetStickState(Handle, ParticipantId, OutState);
+}
+
+template <class PropertiesType>
+bool FMixerInteractivityModule_WithSessionState::ResolveControl(const TMixerControlTable<PropertiesType>& Controls, FName ControlId, FMixerControlHandle& InOutHandle) const
+{
+	// Cached handle still good - no hashing needed
+	if (IsHandleCurrent(Controls, InOutHandle) && Controls.Ids[InOutHandle.Index] == ControlId)
 	{
-		OutDesc = CachedProps->Desc;
 		return true;
 	}
-	else
+
+	InOutHandle.Index = Controls.Find(ControlId);
+	if (InOutHandle.Index == INDEX_NONE)
 	{
+		InOutHandle.Generation = 0;
 		return false;
 	}
+
+	InOutHandle.Generation = ControlGeneration;
+	return true;
+}
+
+bool FMixerInteractivityModule_WithSessionState::ResolveButton(FName Button, FMixerControlHandle& InOutHandle)
+{
+	return ResolveControl(Buttons, Button, InOutHandle) || (MaterializeControl(Button) && ResolveControl(Buttons, Button, InOutHandle));
+}
+
+bool FMixerInteractivityModule_WithSessionState::ResolveStick(FName Stick, FMixerControlHandle& InOutHandle)
+{
+	return ResolveControl(Sticks, Stick, InOutHandle) || (MaterializeControl(Stick) && ResolveControl(Sticks, Stick, InOutHandle));
+}
+
+namespace
+{
+	/** Mixer's cooldown property is the Unix time in milliseconds, by the service's clock, at which the cooldown ends */
+	TSharedRef<FJsonValue> MakeCooldownValue(int64 ServerTimeMs, FTimespan CooldownTime)
+	{
+		return MakeShared<FJsonValueNumber>(static_cast<double>(ServerTimeMs + static_cast<int64>(CooldownTime.GetTotalMilliseconds())));
+	}
 }
 
-bool FMixerInteractivityModule_WithSessionState::GetButtonState(FName Button, FMixerButtonState& OutState)
+int64 FMixerInteractivityModule_WithSessionState::GetServerTimeMs() const
 {
-	FMixerButtonPropertiesCached* CachedProps = Buttons.Find(Button);
-	if (CachedProps != nullptr)
+	return static_cast<int64>((FDateTime::UtcNow() - FDateTime(1970, 1, 1)).GetTotalMilliseconds()) + ServerTimeOffsetMs;
+}
+
+void FMixerInteractivityModule_WithSessionState::TriggerButtonCooldown(FMixerControlHandle Button, FTimespan CooldownTime)
+{
+	if (IsHandleCurrent(Buttons, Button))
 	{
-		OutState = CachedProps->State;
-		if (!bPerParticipantState)
+		SetPendingControlProperty(GetPendingControlUpdatesForScene(Buttons.Properties[Button.Index].SceneId), Buttons.Ids[Button.Index], MixerStringConstants::FieldNames::Cooldown, MakeCooldownValue(GetServerTimeMs(), CooldownTime));
+	}
+}
+
+void FMixerInteractivityModule_WithSessionState::SetControlsEnabled(TArrayView<const FMixerControlHandle> ButtonHandles, bool bEnabled)
+{
+	const TSharedRef<FJsonValue> Disabled = MakeShared<FJsonValueBoolean>(!bEnabled);
+	FName CurrentScene;
+	TMap<FName, TSharedRef<FJsonObject>>* ControlsForScene = nullptr;
+	for (const FMixerControlHandle& Button : ButtonHandles)
+	{
+		if (IsHandleCurrent(Buttons, Button))
+		{
+			// Callers usually pass a scene's buttons together, so only look the scene up when it changes
+			const FName SceneId = Buttons.Properties[Button.Index].SceneId;
+			if (ControlsForScene == nullptr || SceneId != CurrentScene)
+			{
+				ControlsForScene = &GetPendingControlUpdatesForScene(SceneId);
+				CurrentScene = SceneId;
+			}
+			SetPendingControlProperty(*ControlsForScene, Buttons.Ids[Button.Index], MixerStringConstants::FieldNames::Disabled, Disabled);
+		}
+	}
+}
+
+void FMixerInteractivityModule_WithSessionState::TriggerCooldownForScene(FName Scene, FTimespan CooldownTime)
+{
+	const FName SceneId = Scene != NAME_None ? Scene : NAME_DefaultMixerParticipantGroup;
+	MaterializeScene(SceneId);
+
+	const TSharedRef<FJsonValue> Cooldown = MakeCooldownValue(GetServerTimeMs(), CooldownTime);
+	TMap<FName, TSharedRef<FJsonObject>>& ControlsForScene = GetPendingControlUpdatesForScene(SceneId);
+	for (int32 ButtonIndex = 0; ButtonIndex < Buttons.Num(); ++ButtonIndex)
+	{
+		if (Buttons.Properties[ButtonIndex].SceneId == SceneId && !Buttons.IsReservedSlot(ButtonIndex))
+		{
+			SetPendingControlProperty(ControlsForScene, Buttons.Ids[ButtonIndex], MixerStringConstants::FieldNames::Cooldown, Cooldown);
+		}
+	}
+}
+
+void FMixerInteractivityModule_WithSessionState::SetProgressForControls(TArrayView<const TPair<FMixerControlHandle, float>> Progress)
+{
+	FName CurrentScene;
+	TMap<FName, TSharedRef<FJsonObject>>* ControlsForScene = nullptr;
+	for (const TPair<FMixerControlHandle, float>& ButtonProgress : Progress)
+	{
+		const FMixerControlHandle& Button = ButtonProgress.Key;
+		if (IsHandleCurrent(Buttons, Button))
 		{
-			OutState.PressCount = 0;
+			const FName SceneId = Buttons.Properties[Button.Index].SceneId;
+			if (ControlsForScene == nullptr || SceneId != CurrentScene)
+			{
+				ControlsForScene = &GetPendingControlUpdatesForScene(SceneId);
+				CurrentScene = SceneId;
+			}
+			SetPendingControlProperty(*ControlsForScene, Buttons.Ids[Button.Index], MixerStringConstants::FieldNames::Progress, MakeShared<FJsonValueNumber>(FMath::Clamp(ButtonProgress.Value, 0.0f, 1.0f)));
 		}
+	}
+}
+
+bool FMixerInteractivityModule_WithSessionState::GetButtonDescription(FMixerControlHandle Button, FMixerButtonDescription& OutDesc)
+{
+	if (IsHandleCurrent(Buttons, Button))
+	{
+		// Made here rather than in the copy so that the next caller gets the same FText
+		const FMixerButtonDescription& Desc = Buttons.Properties[Button.Index].Desc;
+		Desc.ButtonText.Get();
+		Desc.HelpText.Get();
+		OutDesc = Desc;
 		return true;
 	}
 	else
 	{
 		return false;
 	}
+}
 
-	return true;
+bool FMixerInteractivityModule_WithSessionState::GetButtonState(FMixerControlHandle Button, FMixerButtonState& OutState)
+{
+	if (IsHandleCurrent(Buttons, Button))
+	{
+		OutState = Buttons.States[Button.Index];
+		OutState.RemainingCooldown = GetRemainingCooldown(Buttons.States[Button.Index]);
+		// PressCount is only ever raised by per-participant tracking, so without it this reads 0, or the
+		// holds still draining after an adaptive switch to aggregate-only tracking.
+		return true;
+	}
+	else
+	{
+		return false;
+	}
 }
 
-bool FMixerInteractivityModule_WithSessionState::GetButtonState(FName Button, uint32 ParticipantId, FMixerButtonState& OutState)
+bool FMixerInteractivityModule_WithSessionState::GetButtonState(FMixerControlHandle Button, uint32 ParticipantId, FMixerButtonState& OutState)
 {
 	if (bPerParticipantState)
 	{
-		FMixerButtonPropertiesCached* CachedProps = Buttons.Find(Button);
-		if (CachedProps != nullptr)
+		if (IsHandleCurrent(Buttons, Button))
 		{
-			OutState = CachedProps->State;
+			OutState = Buttons.States[Button.Index];
+			OutState.RemainingCooldown = GetRemainingCooldown(Buttons.States[Button.Index]);
 
 			// Even with per-participant tracking on we don't maintain these.  
 			OutState.DownCount = 0;
 			OutState.UpCount = 0;
-			OutState.PressCount = CachedProps->HoldingParticipants.Contains(ParticipantId) ? 1 : 0;
+			const TBitArray<>& HoldingSlots = Buttons.Properties[Button.Index].HoldingParticipantSlots;
+			const int32* Slot = ParticipantSlots.Find(ParticipantId);
+			OutState.PressCount = (Slot != nullptr && *Slot < HoldingSlots.Num() && HoldingSlots[*Slot]) ? 1 : 0;
 
 			return true;
 		}
@@ -89,20 +323,40 @@ bool FMixerInteractivityModule_WithSessionState::GetButtonState(FName Button, ui
 	}
 }
 
-bool FMixerInteractivityModule_WithSessionState::GetStickDescription(FName Stick, FMixerStickDescription& OutDesc)
+bool FMixerInteractivityModule_WithSessionState::GetButtonState(FMixerControlHandle Button, FName GroupName, FMixerButtonState& OutState)
 {
-	// No supported properties
-	return false;
+	if (!bPerParticipantState)
+	{
+		if (GetInteractiveConnectionAuthState() != EMixerLoginState::Not_Logged_In)
+		{
+			UE_LOG(LogMixerInteractivity, Error, TEXT("Polling per-group button state requires that per-participant state caching is enabled."));
+		}
+		return false;
+	}
+
+	if (!IsHandleCurrent(Buttons, Button))
+	{
+		return false;
+	}
+
+	OutState = Buttons.States[Button.Index];
+	OutState.RemainingCooldown = GetRemainingCooldown(Buttons.States[Button.Index]);
+
+	// As for a single participant, only holds are tracked
+	OutState.DownCount = 0;
+	OutState.UpCount = 0;
+	const FMixerGroupControlState* GroupState = ControlStateByGroup.Find(GroupName);
+	OutState.PressCount = (GroupState != nullptr && GroupState->HeldButtonCounts.IsValidIndex(Button.Index)) ? GroupState->HeldButtonCounts[Button.Index] : 0;
+	return true;
 }
 
-bool FMixerInteractivityModule_WithSessionState::GetStickState(FName Stick, FMixerStickState& OutState)
+bool FMixerInteractivityModule_WithSessionState::GetStickState(FMixerControlHandle Stick, FMixerStickState& OutState)
 {
 	if (bPerParticipantState)
 	{
-		FMixerStickPropertiesCached* CachedProps = Sticks.Find(Stick);
-		if (CachedProps != nullptr)
+		if (IsHandleCurrent(Sticks, Stick))
 		{
-			OutState = CachedProps->State;
+			OutState = Sticks.States[Stick.Index];
 
 			return true;
 		}
@@ -121,17 +375,17 @@ bool FMixerInteractivityModule_WithSessionState::GetStickState(FName Stick, FMix
 	}
 }
 
-bool FMixerInteractivityModule_WithSessionState::GetStickState(FName Stick, uint32 ParticipantId, FMixerStickState& OutState)
+bool FMixerInteractivityModule_WithSessionState::GetStickState(FMixerControlHandle Stick, uint32 ParticipantId, FMixerStickState& OutState)
 {
 	if (bPerParticipantState)
 	{
-		FMixerStickPropertiesCached* CachedProps = Sticks.Find(Stick);
-		if (CachedProps != nullptr)
+		if (IsHandleCurrent(Sticks, Stick))
 		{
-			OutState.Enabled = CachedProps->State.Enabled;
+			OutState.Enabled = Sticks.States[Stick.Index].Enabled;
 
-			FVector2D* PerParticipantState = CachedProps->PerParticipantStickValue.Find(ParticipantId);
-			OutState.Axes = (PerParticipantState != nullptr) ? *PerParticipantState : FVector2D(0, 0);
+			const FMixerStickPropertiesCached& StickProps = Sticks.Properties[Stick.Index];
+			const int32* ValueIndex = StickProps.ValueIndexByParticipant.Find(ParticipantId);
+			OutState.Axes = (ValueIndex != nullptr) ? FVector2D(StickProps.ValuesX[*ValueIndex], StickProps.ValuesY[*ValueIndex]) : FVector2D(0, 0);
 			return true;
 		}
 		else
@@ -149,253 +403,3223 @@ bool FMixerInteractivityModule_WithSessionState::GetStickState(FName Stick, uint
 	}
 }
 
-
-void FMixerInteractivityModule_WithSessionState::SetLabelText(FName Label, const FText& DisplayText)
+bool FMixerInteractivityModule_WithSessionState::EnableCoordinateHeatmap(FName ControlId, const FMixerCoordinateHeatmapSettings& Settings)
 {
-	FMixerLabelPropertiesCached* CachedLabel = Labels.Find(Label);
-	if (CachedLabel != nullptr)
+	const FVector2D Range = Settings.Bounds.Max - Settings.Bounds.Min;
+	// The cell count must fit TArray's int32 size, so check the product before it can overflow
+	if (Settings.Width <= 0 || Settings.Height <= 0 || static_cast<int64>(Settings.Width) * Settings.Height > MAX_int32 ||
+		Range.X <= 0.0f || Range.Y <= 0.0f || Settings.HalfLife < 0.0f)
 	{
-		TSharedRef<FJsonObject> UpdateJson = MakeShared<FJsonObject>();
-		UpdateJson->SetStringField(MixerStringConstants::FieldNames::Text, DisplayText.ToString());
-		UpdateRemoteControl(CachedLabel->SceneId, Label, UpdateJson);
+		UE_LOG(LogMixerInteractivity, Error, TEXT("Invalid heatmap settings for control %s."), *ControlId.ToString());
+		return false;
 	}
+
+	FCoordinateHeatmap& Heatmap = CoordinateHeatmaps.FindOrAdd(ControlId);
+	Heatmap.Settings = Settings;
+	Heatmap.Cells.Reset();
+	Heatmap.Cells.SetNumZeroed(Settings.Width * Settings.Height);
+	Heatmap.PendingSamples.Reset();
+	return true;
 }
 
-bool FMixerInteractivityModule_WithSessionState::GetLabelDescription(FName Label, FMixerLabelDescription& OutDesc)
+void FMixerInteractivityModule_WithSessionState::DisableCoordinateHeatmap(FName ControlId)
 {
-	FMixerLabelPropertiesCached* CachedProps = Labels.Find(Label);
-	if (CachedProps != nullptr)
-	{
-		OutDesc = CachedProps->Desc;
-		return true;
-	}
-	else
-	{
-		return false;
-	}
+	CoordinateHeatmaps.Remove(ControlId);
 }
 
-bool FMixerInteractivityModule_WithSessionState::GetTextboxDescription(FName Textbox, FMixerTextboxDescription& OutDesc)
+bool FMixerInteractivityModule_WithSessionState::GetCoordinateHeatmap(FName ControlId, TArrayView<const float>& OutCells, int32& OutWidth, int32& OutHeight)
 {
-	FMixerTextboxPropertiesCached* CachedProps = Textboxes.Find(Textbox);
-	if (CachedProps != nullptr)
-	{
-		OutDesc = CachedProps->Desc;
-		return true;
-	}
-	else
+	FCoordinateHeatmap* Heatmap = CoordinateHeatmaps.Find(ControlId);
+	if (Heatmap == nullptr)
 	{
 		return false;
 	}
-}
 
-TSharedPtr<const FMixerRemoteUser> FMixerInteractivityModule_WithSessionState::GetParticipant(uint32 ParticipantId)
-{
-	TSharedPtr<FMixerRemoteUser>* FoundUser = RemoteParticipantCacheByUint.Find(ParticipantId);
-	return FoundUser ? *FoundUser : TSharedPtr<const FMixerRemoteUser>();
+	// Include anything that's arrived since the tick
+	BinHeatmapSamples(*Heatmap);
+	OutCells = Heatmap->Cells;
+	OutWidth = Heatmap->Settings.Width;
+	OutHeight = Heatmap->Settings.Height;
+	return true;
 }
 
-bool FMixerInteractivityModule_WithSessionState::GetParticipantsInGroup(FName GroupName, TArray<TSharedPtr<const FMixerRemoteUser>>& OutParticipants)
+bool FMixerInteractivityModule_WithSessionState::EnableInputSketches(FName ControlId, const FMixerInputSketchSettings& Settings)
 {
-	for (TMap<uint32, TSharedPtr<FMixerRemoteUser>>::TConstIterator It(RemoteParticipantCacheByUint); It; ++It)
+	if (Settings.WindowSeconds <= 0.0f || Settings.WindowBuckets <= 0 || Settings.TrackedParticipants <= 0 || Settings.TrackedParticipants > 1024
+		|| Settings.DistinctPrecision < 4 || Settings.DistinctPrecision > 16)
 	{
-		if (It->Value->Group == GroupName)
-		{
-			OutParticipants.Add(It->Value);
-		}
+		UE_LOG(LogMixerInteractivity, Error, TEXT("Invalid input sketch settings for control %s."), *ControlId.ToString());
+		return false;
 	}
 
+	FInputSketch& Sketch = InputSketches.FindOrAdd(ControlId);
+	Sketch.Settings = Settings;
+	Sketch.Registers.Reset();
+	Sketch.Registers.SetNumZeroed(Settings.WindowBuckets << Settings.DistinctPrecision);
+	Sketch.Counters.Reset();
+	Sketch.Counters.SetNumUninitialized(Settings.WindowBuckets * Settings.TrackedParticipants);
+	Sketch.CountersUsed.Reset();
+	Sketch.CountersUsed.SetNumZeroed(Settings.WindowBuckets);
+	Sketch.CurrentBucket = 0;
+	Sketch.BucketEndTime = FPlatformTime::Seconds() + Settings.WindowSeconds / Settings.WindowBuckets;
 	return true;
 }
 
-bool FMixerInteractivityModule_WithSessionState::Tick(float DeltaTime)
+void FMixerInteractivityModule_WithSessionState::DisableInputSketches(FName ControlId)
 {
-	FMixerInteractivityModule::Tick(DeltaTime);
+	InputSketches.Remove(ControlId);
+}
 
-	FTimespan CooldownDecrement = FTimespan::FromSeconds(DeltaTime);
-	for (TMap<FName, FMixerButtonPropertiesCached>::TIterator It(Buttons); It; ++It)
+bool FMixerInteractivityModule_WithSessionState::GetMostActiveParticipants(FName ControlId, int32 MaxCount, TArray<FMixerActiveParticipant>& OutParticipants)
+{
+	OutParticipants.Reset();
+	FInputSketch* Sketch = InputSketches.Find(ControlId);
+	if (Sketch == nullptr)
 	{
-		It->Value.State.RemainingCooldown = FMath::Max(It->Value.State.RemainingCooldown - CooldownDecrement, FTimespan::Zero());
-
-		It->Value.State.DownCount = 0;
-		It->Value.State.UpCount = 0;
-
-		// Leave PressCount alone
+		return false;
 	}
 
-	return true;
-}
-
-bool FMixerInteractivityModule_WithSessionState::HandleSingleControlUpdate(FName ControlId, const TSharedRef<FJsonObject> ControlData)
-{
-	FMixerButtonPropertiesCached* ButtonProps = Buttons.Find(ControlId);
-	if (ButtonProps != nullptr)
+	AdvanceSketch(*Sketch, FPlatformTime::Seconds());
+	const int32 NumBuckets = Sketch->Settings.WindowBuckets;
+	const int32 Capacity = Sketch->Settings.TrackedParticipants;
+	for (int32 Bucket = 0; Bucket < NumBuckets; ++Bucket)
 	{
-		double Cooldown = 0.0f;
-		if (ControlData->TryGetNumberField(MixerStringConstants::FieldNames::Cooldown, Cooldown))
+		const FInputSketchCounter* BucketCounters = &Sketch->Counters[Bucket * Capacity];
+		for (int32 i = 0; i < Sketch->CountersUsed[Bucket]; ++i)
 		{
-			uint64 TimeNowInMixerUnits = FDateTime::UtcNow().ToUnixTimestamp() * 1000;
-			if (Cooldown > TimeNowInMixerUnits)
-			{
-				ButtonProps->State.RemainingCooldown = FTimespan::FromMilliseconds(static_cast<double>(static_cast<uint64>(Cooldown) - TimeNowInMixerUnits));
-			}
-			else
+			FMixerActiveParticipant* Merged = OutParticipants.FindByPredicate([&](const FMixerActiveParticipant& P) { return P.ParticipantId == BucketCounters[i].ParticipantId; });
+			if (Merged == nullptr)
 			{
-				ButtonProps->State.RemainingCooldown = FTimespan::Zero();
+				Merged = &OutParticipants[OutParticipants.AddZeroed()];
+				Merged->ParticipantId = BucketCounters[i].ParticipantId;
 			}
+			Merged->InputCount += BucketCounters[i].Count;
+			Merged->MaxOvercount += BucketCounters[i].Overcount;
 		}
+	}
 
-		FString Text;
-		if (ControlData->TryGetStringField(MixerStringConstants::FieldNames::Text, Text))
+	// A participant missing from a full slice may still have sent up to that slice's smallest count there
+	for (int32 Bucket = 0; Bucket < NumBuckets; ++Bucket)
+	{
+		if (Sketch->CountersUsed[Bucket] < Capacity)
 		{
-			ButtonProps->Desc.ButtonText = FText::FromString(Text);
+			continue;
 		}
 
-		FString Tooltip;
-		if (ControlData->TryGetStringField(MixerStringConstants::FieldNames::Tooltip , Tooltip))
+		const FInputSketchCounter* BucketCounters = &Sketch->Counters[Bucket * Capacity];
+		uint32 MinCount = MAX_uint32;
+		for (int32 i = 0; i < Capacity; ++i)
 		{
-			ButtonProps->Desc.HelpText = FText::FromString(Tooltip);
+			MinCount = FMath::Min(MinCount, BucketCounters[i].Count);
 		}
-
-		uint32 Cost;
-		if (ControlData->TryGetNumberField(MixerStringConstants::FieldNames::Cost, Cost))
+		for (FMixerActiveParticipant& Merged : OutParticipants)
 		{
-			ButtonProps->Desc.SparkCost = Cost;
+			bool bInBucket = false;
+			for (int32 i = 0; i < Capacity && !bInBucket; ++i)
+			{
+				bInBucket = BucketCounters[i].ParticipantId == Merged.ParticipantId;
+			}
+			if (!bInBucket)
+			{
+				Merged.InputCount += MinCount;
+				Merged.MaxOvercount += MinCount;
+			}
 		}
+	}
 
-		bool bDisabled;
-		if (ControlData->TryGetBoolField(MixerStringConstants::FieldNames::Disabled, bDisabled))
-		{
-			ButtonProps->State.Enabled = !bDisabled;
-		}
+	OutParticipants.Sort([](const FMixerActiveParticipant& A, const FMixerActiveParticipant& B) { return A.InputCount > B.InputCount; });
+	if (OutParticipants.Num() > MaxCount)
+	{
+		OutParticipants.SetNum(FMath::Max(0, MaxCount), false);
+	}
+	return true;
+}
 
-		double Progress;
-		if (ControlData->TryGetNumberField(MixerStringConstants::FieldNames::Progress, Progress))
+bool FMixerInteractivityModule_WithSessionState::GetDistinctParticipantCount(FName ControlId, int32& OutCount)
+{
+	FInputSketch* Sketch = InputSketches.Find(ControlId);
+	if (Sketch == nullptr)
+	{
+		return false;
+	}
+
+	AdvanceSketch(*Sketch, FPlatformTime::Seconds());
+	const int32 NumRegisters = 1 << Sketch->Settings.DistinctPrecision;
+	int32 ZeroRegisters = 0;
+	double InverseSum = 0.0;
+	for (int32 Register = 0; Register < NumRegisters; ++Register)
+	{
+		// The window's registers are the union of its slices'
+		uint8 Rank = 0;
+		for (int32 Bucket = 0; Bucket < Sketch->Settings.WindowBuckets; ++Bucket)
 		{
-			ButtonProps->State.Progress = Progress;
+			Rank = FMath::Max(Rank, Sketch->Registers[(Bucket << Sketch->Settings.DistinctPrecision) + Register]);
 		}
+		ZeroRegisters += Rank == 0 ? 1 : 0;
+		InverseSum += FMath::Pow(2.0, -static_cast<double>(Rank));
+	}
 
-		return true;
+	const double M = NumRegisters;
+	const double Alpha = NumRegisters == 16 ? 0.673 : NumRegisters == 32 ? 0.697 : NumRegisters == 64 ? 0.709 : 0.7213 / (1.0 + 1.079 / M);
+	double Estimate = Alpha * M * M / InverseSum;
+	if (Estimate <= 2.5 * M && ZeroRegisters > 0)
+	{
+		// Small range correction: count empty registers instead
+		Estimate = M * FMath::Loge(M / ZeroRegisters);
 	}
+	OutCount = FMath::RoundToInt(static_cast<float>(Estimate));
+	return true;
+}
 
-	FMixerStickPropertiesCached* StickProps = Sticks.Find(ControlId);
-	if (StickProps != nullptr)
+void FMixerInteractivityModule_WithSessionState::RecordSketchInput(FName ControlId, const FMixerRemoteUser* Participant)
+{
+	if (InputSketches.Num() > 0 && Participant != nullptr)
 	{
-		bool bDisabled;
-		if (ControlData->TryGetBoolField(MixerStringConstants::FieldNames::Disabled, bDisabled))
+		FInputSketch* Sketch = InputSketches.Find(ControlId);
+		if (Sketch != nullptr)
 		{
-			StickProps->State.Enabled = !bDisabled;
+			AddToSketch(*Sketch, Participant->Id);
 		}
+	}
+}
 
-		return true;
+void FMixerInteractivityModule_WithSessionState::AddToSketch(FInputSketch& Sketch, uint32 ParticipantId)
+{
+	// Ids are sequential-ish, so mix them (MurmurHash3's 64 bit finalizer) before splitting into register and rank
+	uint64 Hash = ParticipantId;
+	Hash ^= Hash >> 33;
+	Hash *= 0xff51afd7ed558ccdull;
+	Hash ^= Hash >> 33;
+	Hash *= 0xc4ceb9fe1a85ec53ull;
+	Hash ^= Hash >> 33;
+
+	const int32 Precision = Sketch.Settings.DistinctPrecision;
+	const int32 Register = static_cast<int32>(Hash & ((1ull << Precision) - 1));
+	const uint8 Rank = static_cast<uint8>(FMath::CountLeadingZeros(static_cast<uint32>(Hash >> 32)) + 1);
+	uint8& Slot = Sketch.Registers[(Sketch.CurrentBucket << Precision) + Register];
+	Slot = FMath::Max(Slot, Rank);
+
+	const int32 Capacity = Sketch.Settings.TrackedParticipants;
+	FInputSketchCounter* BucketCounters = &Sketch.Counters[Sketch.CurrentBucket * Capacity];
+	int32& Used = Sketch.CountersUsed[Sketch.CurrentBucket];
+	int32 MinIndex = 0;
+	for (int32 i = 0; i < Used; ++i)
+	{
+		if (BucketCounters[i].ParticipantId == ParticipantId)
+		{
+			++BucketCounters[i].Count;
+			return;
+		}
+		if (BucketCounters[i].Count < BucketCounters[MinIndex].Count)
+		{
+			MinIndex = i;
+		}
 	}
 
-	return false;
+	if (Used < Capacity)
+	{
+		BucketCounters[Used++] = { ParticipantId, 1, 0 };
+	}
+	else
+	{
+		// Space-Saving: the newcomer takes over the smallest counter, inheriting its count as possible overcount
+		FInputSketchCounter& Replaced = BucketCounters[MinIndex];
+		Replaced.ParticipantId = ParticipantId;
+		Replaced.Overcount = Replaced.Count;
+		++Replaced.Count;
+	}
 }
 
-void FMixerInteractivityModule_WithSessionState::StartSession(bool bCachePerParticipantState)
+void FMixerInteractivityModule_WithSessionState::AdvanceSketch(FInputSketch& Sketch, double TimeNow)
 {
-	check(Buttons.Num() == 0);
-	check(Sticks.Num() == 0);
-	check(Labels.Num() == 0);
-	check(Textboxes.Num() == 0);
-	check(RemoteParticipantCacheByGuid.Num() == 0);
-	check(RemoteParticipantCacheByUint.Num() == 0);
-	bPerParticipantState = bCachePerParticipantState;
+	const double BucketSeconds = Sketch.Settings.WindowSeconds / Sketch.Settings.WindowBuckets;
+	for (int32 Advanced = 0; TimeNow >= Sketch.BucketEndTime; ++Advanced)
+	{
+		if (Advanced >= Sketch.Settings.WindowBuckets)
+		{
+			// Idle for the whole window; everything's been cleared already
+			Sketch.BucketEndTime = TimeNow + BucketSeconds;
+			break;
+		}
+		Sketch.CurrentBucket = (Sketch.CurrentBucket + 1) % Sketch.Settings.WindowBuckets;
+		ClearSketchBucket(Sketch, Sketch.CurrentBucket);
+		Sketch.BucketEndTime += BucketSeconds;
+	}
 }
 
-void FMixerInteractivityModule_WithSessionState::EndSession()
+void FMixerInteractivityModule_WithSessionState::ClearSketchBucket(FInputSketch& Sketch, int32 Bucket)
 {
-	Buttons.Empty();
-	Sticks.Empty();
-	Labels.Empty();
-	Textboxes.Empty();
-	RemoteParticipantCacheByGuid.Empty();
-	RemoteParticipantCacheByUint.Empty();
+	const int32 NumRegisters = 1 << Sketch.Settings.DistinctPrecision;
+	FMemory::Memzero(&Sketch.Registers[Bucket * NumRegisters], NumRegisters);
+	Sketch.CountersUsed[Bucket] = 0;
 }
 
-bool FMixerInteractivityModule_WithSessionState::CachePerParticipantState()
+bool FMixerInteractivityModule_WithSessionState::EnableActivityTimeSeries(FName ControlId, const FMixerActivitySeriesSettings& Settings)
 {
-	return bPerParticipantState;
+	if (Settings.BucketSeconds <= 0.0f || Settings.NumBuckets <= 0)
+	{
+		UE_LOG(LogMixerInteractivity, Error, TEXT("Invalid activity time series settings for control %s."), *ControlId.ToString());
+		return false;
+	}
+
+	FActivitySeries& Series = ActivitySeries.FindOrAdd(ControlId);
+	Series.Settings = Settings;
+	Series.Samples.Reset();
+	Series.Samples.SetNumZeroed(Settings.NumBuckets * 2);
+	Series.Head = 0;
+	Series.BucketEndTime = FPlatformTime::Seconds() + Settings.BucketSeconds;
+	return true;
 }
 
-void FMixerInteractivityModule_WithSessionState::AddButton(FName ControlId, const FMixerButtonPropertiesCached& Props)
+void FMixerInteractivityModule_WithSessionState::DisableActivityTimeSeries(FName ControlId)
 {
-	Buttons.Add(ControlId, Props);
+	ActivitySeries.Remove(ControlId);
 }
 
-FMixerButtonPropertiesCached* FMixerInteractivityModule_WithSessionState::GetButton(FName ControlId)
+bool FMixerInteractivityModule_WithSessionState::GetActivityTimeSeries(FName ControlId, TArrayView<const float>& OutSamples, float& OutBucketSeconds)
 {
-	return Buttons.Find(ControlId);
+	FActivitySeries* Series = ActivitySeries.Find(ControlId);
+	if (Series == nullptr)
+	{
+		return false;
+	}
+
+	AdvanceActivitySeries(*Series, FPlatformTime::Seconds());
+	OutSamples = TArrayView<const float>(Series->Samples.GetData() + Series->Head + 1, Series->Settings.NumBuckets);
+	OutBucketSeconds = Series->Settings.BucketSeconds;
+	return true;
+}
+
+void FMixerInteractivityModule_WithSessionState::RecordActivity(FName ControlId, float Amount)
+{
+	if (ActivitySeries.Num() > 0)
+	{
+		FActivitySeries* Series = ActivitySeries.Find(ControlId);
+		if (Series != nullptr)
+		{
+			Series->Samples[Series->Head] += Amount;
+			Series->Samples[Series->Head + Series->Settings.NumBuckets] += Amount;
+		}
+	}
+}
+
+void FMixerInteractivityModule_WithSessionState::AdvanceActivitySeries(FActivitySeries& Series, double TimeNow)
+{
+	const int32 NumBuckets = Series.Settings.NumBuckets;
+	for (int32 Advanced = 0; TimeNow >= Series.BucketEndTime; ++Advanced)
+	{
+		if (Advanced >= NumBuckets)
+		{
+			// Nothing's been read for longer than the history covers; it's all zeroes now
+			Series.BucketEndTime = TimeNow + Series.Settings.BucketSeconds;
+			break;
+		}
+		Series.Head = (Series.Head + 1) % NumBuckets;
+		Series.Samples[Series.Head] = 0.0f;
+		Series.Samples[Series.Head + NumBuckets] = 0.0f;
+		Series.BucketEndTime += Series.Settings.BucketSeconds;
+	}
+}
+
+int32 FMixerInteractivityModule_WithSessionState::StartVoteRound(const FMixerVoteRoundSettings& Settings)
+{
+	if (Settings.OptionButtons.Num() == 0 || Settings.Duration < FTimespan::Zero())
+	{
+		UE_LOG(LogMixerInteractivity, Error, TEXT("Invalid vote round settings."));
+		return INDEX_NONE;
+	}
+
+	for (int32 Option = 0; Option < Settings.OptionButtons.Num(); ++Option)
+	{
+		const FName Button = Settings.OptionButtons[Option];
+		if (VoteOptionsByButton.Contains(Button) || Settings.OptionButtons.Find(Button) != Option)
+		{
+			UE_LOG(LogMixerInteractivity, Error, TEXT("Button %s is already a vote option in an open round."), *Button.ToString());
+			return INDEX_NONE;
+		}
+	}
+
+	const int32 RoundId = NextVoteRoundId++;
+	FVoteRound& Round = VoteRounds.Add(RoundId);
+	Round.Result.RoundId = RoundId;
+	Round.Result.OptionButtons = Settings.OptionButtons;
+	Round.Result.Tallies.SetNumZeroed(Settings.OptionButtons.Num());
+	Round.EndTime = Settings.Duration > FTimespan::Zero() ? FPlatformTime::Seconds() + Settings.Duration.GetTotalSeconds() : 0.0;
+	Round.bWeightBySparks = Settings.bWeightBySparks;
+
+	for (int32 Option = 0; Option < Settings.OptionButtons.Num(); ++Option)
+	{
+		FVoteOption& OptionRef = VoteOptionsByButton.Add(Settings.OptionButtons[Option]);
+		OptionRef.RoundId = RoundId;
+		OptionRef.Option = Option;
+	}
+
+	return RoundId;
+}
+
+bool FMixerInteractivityModule_WithSessionState::CloseVoteRound(int32 RoundId, FMixerVoteRoundResult& OutResult)
+{
+	FVoteRound Round;
+	if (!VoteRounds.RemoveAndCopyValue(RoundId, Round))
+	{
+		return false;
+	}
+
+	for (FName Button : Round.Result.OptionButtons)
+	{
+		VoteOptionsByButton.Remove(Button);
+	}
+
+	int32 WinningTally = 0;
+	for (int32 Option = 0; Option < Round.Result.Tallies.Num(); ++Option)
+	{
+		if (Round.Result.Tallies[Option] > WinningTally)
+		{
+			WinningTally = Round.Result.Tallies[Option];
+			Round.Result.WinningOption = Option;
+		}
+	}
+
+	OutResult = MoveTemp(Round.Result);
+	OnVoteRoundClosed().Broadcast(OutResult);
+	return true;
+}
+
+bool FMixerInteractivityModule_WithSessionState::GetVoteTallies(int32 RoundId, TArrayView<const int32>& OutTallies)
+{
+	const FVoteRound* Round = VoteRounds.Find(RoundId);
+	if (Round == nullptr)
+	{
+		return false;
+	}
+
+	OutTallies = Round->Result.Tallies;
+	return true;
+}
+
+void FMixerInteractivityModule_WithSessionState::RecordVote(FName ControlId, const FMixerRemoteUser* Participant, const FMixerButtonEventDetails& Details)
+{
+	if (VoteOptionsByButton.Num() == 0 || Participant == nullptr)
+	{
+		return;
+	}
+
+	const FVoteOption* Option = VoteOptionsByButton.Find(ControlId);
+	if (Option == nullptr)
+	{
+		return;
+	}
+
+	FVoteRound& Round = VoteRounds.FindChecked(Option->RoundId);
+	bool bAlreadyVoted = false;
+	Round.VoterIds.Add(Participant->Id, &bAlreadyVoted);
+	if (!bAlreadyVoted)
+	{
+		Round.Result.Tallies[Option->Option] += Round.bWeightBySparks ? static_cast<int32>(FMath::Max<uint32>(1, Details.SparkCost)) : 1;
+		++Round.Result.VoterCount;
+	}
+}
+
+void FMixerInteractivityModule_WithSessionState::TickVoteRounds()
+{
+	if (VoteRounds.Num() == 0)
+	{
+		return;
+	}
+
+	const double TimeNow = FPlatformTime::Seconds();
+	TArray<int32, TInlineAllocator<4>> ExpiredRounds;
+	for (const TPair<int32, FVoteRound>& Round : VoteRounds)
+	{
+		if (Round.Value.EndTime > 0.0 && TimeNow >= Round.Value.EndTime)
+		{
+			ExpiredRounds.Add(Round.Key);
+		}
+	}
+
+	for (int32 RoundId : ExpiredRounds)
+	{
+		FMixerVoteRoundResult Result;
+		CloseVoteRound(RoundId, Result);
+	}
+}
+
+void FMixerInteractivityModule_WithSessionState::BinHeatmapSamples(FCoordinateHeatmap& Heatmap)
+{
+	const int32 NumSamples = Heatmap.PendingSamples.Num();
+	if (NumSamples == 0)
+	{
+		return;
+	}
+
+	const FMixerCoordinateHeatmapSettings& Settings = Heatmap.Settings;
+	const FVector2D Origin = Settings.Bounds.Min;
+	const FVector2D Scale(Settings.Width / (Settings.Bounds.Max.X - Origin.X), Settings.Height / (Settings.Bounds.Max.Y - Origin.Y));
+	const FVector2D Limit(Settings.Width - 1.0f, Settings.Height - 1.0f);
+	float* Cells = Heatmap.Cells.GetData();
+	const int32 Pitch = Settings.Width;
+
+	// Two samples per register, laid out x0 y0 x1 y1 as they are in the array.  Scale into grid space and clamp
+	// to the edge cells together; only the scatter into the grid is left scalar.
+	const VectorRegister OriginV = MakeVectorRegister(Origin.X, Origin.Y, Origin.X, Origin.Y);
+	const VectorRegister ScaleV = MakeVectorRegister(Scale.X, Scale.Y, Scale.X, Scale.Y);
+	const VectorRegister LimitV = MakeVectorRegister(Limit.X, Limit.Y, Limit.X, Limit.Y);
+	const float* Samples = reinterpret_cast<const float*>(Heatmap.PendingSamples.GetData());
+	MS_ALIGN(16) float GridCoords[4] GCC_ALIGN(16);
+
+	int32 SampleIndex = 0;
+	for (; SampleIndex + 2 <= NumSamples; SampleIndex += 2)
+	{
+		VectorRegister Position = VectorLoad(Samples + SampleIndex * 2);
+		Position = VectorMultiply(VectorSubtract(Position, OriginV), ScaleV);
+		Position = VectorMin(VectorMax(Position, VectorZero()), LimitV);
+		VectorStoreAligned(Position, GridCoords);
+		Cells[static_cast<int32>(GridCoords[1]) * Pitch + static_cast<int32>(GridCoords[0])] += 1.0f;
+		Cells[static_cast<int32>(GridCoords[3]) * Pitch + static_cast<int32>(GridCoords[2])] += 1.0f;
+	}
+
+	if (SampleIndex < NumSamples)
+	{
+		const FVector2D& Sample = Heatmap.PendingSamples[SampleIndex];
+		const int32 CellX = static_cast<int32>(FMath::Clamp((Sample.X - Origin.X) * Scale.X, 0.0f, Limit.X));
+		const int32 CellY = static_cast<int32>(FMath::Clamp((Sample.Y - Origin.Y) * Scale.Y, 0.0f, Limit.Y));
+		Cells[CellY * Pitch + CellX] += 1.0f;
+	}
+
+	Heatmap.PendingSamples.Reset();
+}
+
+void FMixerInteractivityModule_WithSessionState::DecayHeatmap(FCoordinateHeatmap& Heatmap, float DeltaTime)
+{
+	if (Heatmap.Settings.HalfLife <= 0.0f)
+	{
+		return;
+	}
+
+	const float Factor = FMath::Pow(0.5f, DeltaTime / Heatmap.Settings.HalfLife);
+	const VectorRegister FactorV = VectorSetFloat1(Factor);
+
+	// Flush cells that have decayed to nothing so they don't linger as denormals
+	const float Floor = 1.0e-4f;
+	const VectorRegister FloorV = VectorSetFloat1(Floor);
+
+	float* Cells = Heatmap.Cells.GetData();
+	const int32 NumCells = Heatmap.Cells.Num();
+	int32 CellIndex = 0;
+	for (; CellIndex + 4 <= NumCells; CellIndex += 4)
+	{
+		const VectorRegister Decayed = VectorMultiply(VectorLoad(Cells + CellIndex), FactorV);
+		VectorStore(VectorBitwiseAnd(Decayed, VectorCompareGT(Decayed, FloorV)), Cells + CellIndex);
+	}
+
+	for (; CellIndex < NumCells; ++CellIndex)
+	{
+		const float Decayed = Cells[CellIndex] * Factor;
+		Cells[CellIndex] = Decayed > Floor ? Decayed : 0.0f;
+	}
+}
+
+bool FMixerInteractivityModule_WithSessionState::GetStickAggregate(FName Stick, FMixerStickAggregate& OutAggregate)
+{
+	FMixerControlHandle Handle;
+	ResolveStick(Stick, Handle);
+	return GetStickAggregate(Handle, OutAggregate);
+}
+
+bool FMixerInteractivityModule_WithSessionState::GetStickAggregate(FMixerControlHandle Stick, FMixerStickAggregate& OutAggregate)
+{
+	if (!bPerParticipantState)
+	{
+		if (GetInteractiveConnectionAuthState() != EMixerLoginState::Not_Logged_In)
+		{
+			UE_LOG(LogMixerInteractivity, Error, TEXT("Polling aggregate stick statistics requires that per-participant state caching is enabled."));
+		}
+		return false;
+	}
+
+	if (!IsHandleCurrent(Sticks, Stick))
+	{
+		return false;
+	}
+
+	Sticks.Properties[Stick.Index].GetAggregate(OutAggregate);
+	return true;
+}
+
+bool FMixerInteractivityModule_WithSessionState::GetStickAggregate(FName Stick, FName GroupName, FMixerStickAggregate& OutAggregate)
+{
+	FMixerControlHandle Handle;
+	ResolveStick(Stick, Handle);
+	return GetStickAggregate(Handle, GroupName, OutAggregate);
+}
+
+bool FMixerInteractivityModule_WithSessionState::GetStickAggregate(FMixerControlHandle Stick, FName GroupName, FMixerStickAggregate& OutAggregate)
+{
+	if (!bPerParticipantState)
+	{
+		if (GetInteractiveConnectionAuthState() != EMixerLoginState::Not_Logged_In)
+		{
+			UE_LOG(LogMixerInteractivity, Error, TEXT("Polling per-group stick statistics requires that per-participant state caching is enabled."));
+		}
+		return false;
+	}
+
+	if (!IsHandleCurrent(Sticks, Stick))
+	{
+		return false;
+	}
+
+	const FMixerGroupControlState* GroupState = ControlStateByGroup.Find(GroupName);
+	if (GroupState != nullptr && GroupState->StickSums.IsValidIndex(Stick.Index))
+	{
+		GroupState->StickSums[Stick.Index].GetAggregate(OutAggregate);
+	}
+	else
+	{
+		FMixerStickSums().GetAggregate(OutAggregate);
+	}
+	return true;
+}
+
+void FMixerInteractivityModule_WithSessionState::SetLabelText(FName Label, const FText& DisplayText)
+{
+	FMixerLabelPropertiesCached* CachedLabel = GetLabel(Label);
+	if (CachedLabel == nullptr && MaterializeControl(Label))
+	{
+		CachedLabel = GetLabel(Label);
+	}
+
+	if (CachedLabel != nullptr)
+	{
+		TSharedRef<FJsonObject> UpdateJson = MakeShared<FJsonObject>();
+		UpdateJson->SetStringField(MixerStringConstants::FieldNames::Text, DisplayText.ToString());
+		UpdateRemoteControl(CachedLabel->SceneId, Label, UpdateJson);
+	}
+}
+
+bool FMixerInteractivityModule_WithSessionState::GetLabelDescription(FName Label, FMixerLabelDescription& OutDesc)
+{
+	FMixerLabelPropertiesCached* CachedProps = GetLabel(Label);
+	if (CachedProps == nullptr && MaterializeControl(Label))
+	{
+		CachedProps = GetLabel(Label);
+	}
+
+	if (CachedProps != nullptr)
+	{
+		CachedProps->Desc.Text.Get();
+		OutDesc = CachedProps->Desc;
+		return true;
+	}
+	else
+	{
+		return false;
+	}
+}
+
+bool FMixerInteractivityModule_WithSessionState::GetTextboxDescription(FName Textbox, FMixerTextboxDescription& OutDesc)
+{
+	FMixerTextboxPropertiesCached* CachedProps = GetTextbox(Textbox);
+	if (CachedProps == nullptr && MaterializeControl(Textbox))
+	{
+		CachedProps = GetTextbox(Textbox);
+	}
+
+	if (CachedProps != nullptr)
+	{
+		CachedProps->Desc.Placeholder.Get();
+		CachedProps->Desc.SubmitText.Get();
+		OutDesc = CachedProps->Desc;
+		return true;
+	}
+	else
+	{
+		return false;
+	}
+}
+
+TSharedPtr<const FMixerRemoteUser> FMixerInteractivityModule_WithSessionState::GetParticipant(uint32 ParticipantId)
+{
+	TSharedPtr<FMixerRemoteUser>* FoundUser = RemoteParticipantCacheByUint.Find(ParticipantId);
+	return FoundUser ? *FoundUser : TSharedPtr<const FMixerRemoteUser>();
+}
+
+bool FMixerInteractivityModule_WithSessionState::GetParticipantsInGroup(FName GroupName, TArray<TSharedPtr<const FMixerRemoteUser>>& OutParticipants)
+{
+	TArrayView<const TSharedPtr<const FMixerRemoteUser>> Members = ViewParticipantsInGroup(GroupName);
+	OutParticipants.Append(Members.GetData(), Members.Num());
+	return true;
+}
+
+TArrayView<const TSharedPtr<const FMixerRemoteUser>> FMixerInteractivityModule_WithSessionState::ViewParticipantsInGroup(FName GroupName)
+{
+	const TArray<TSharedPtr<const FMixerRemoteUser>>* Members = ParticipantsByGroup.Find(GroupName);
+	return Members != nullptr ? TArrayView<const TSharedPtr<const FMixerRemoteUser>>(*Members) : TArrayView<const TSharedPtr<const FMixerRemoteUser>>();
+}
+
+int32 FMixerInteractivityModule_WithSessionState::GetParticipantsPage(FName GroupName, EMixerParticipantSortKey SortKey, int32 Offset, int32 Count, TArray<TSharedPtr<const FMixerRemoteUser>>& OutParticipants, bool bDescending)
+{
+	const TArray<TSharedPtr<const FMixerRemoteUser>>* Members = ParticipantsByGroup.Find(GroupName);
+	if (Members == nullptr || SortKey >= EMixerParticipantSortKey::Count)
+	{
+		return 0;
+	}
+
+	TMap<FName, FMixerParticipantOrder>& Orders = ParticipantOrders[static_cast<int32>(SortKey)];
+	FMixerParticipantOrder* Order = Orders.Find(GroupName);
+	if (Order == nullptr)
+	{
+		// Sorted once here; from now on the order follows the group's members as they change
+		Order = &Orders.Add(GroupName);
+		for (const TSharedPtr<const FMixerRemoteUser>& Member : *Members)
+		{
+			Order->Add(Member->Id, GetParticipantSortValue(*Member, SortKey));
+		}
+	}
+
+	OutParticipants.Reserve(OutParticipants.Num() + FMath::Clamp(Count, 0, Order->Num()));
+	Order->ForEachInPage(Offset, Count, bDescending, [this, &OutParticipants](uint32 ParticipantId)
+	{
+		OutParticipants.Add(RemoteParticipantCacheByUint.FindChecked(ParticipantId));
+	});
+	return Order->Num();
+}
+
+void FMixerInteractivityModule_WithSessionState::GetContainerSizes(TFunctionRef<void(const TCHAR* Name, int64 Size)> Visit) const
+{
+	FMixerInteractivityModule::GetContainerSizes(Visit);
+
+	int64 NumGroupMembers = 0;
+	for (const TPair<FName, TArray<TSharedPtr<const FMixerRemoteUser>>>& Group : ParticipantsByGroup)
+	{
+		NumGroupMembers += Group.Value.Num();
+	}
+
+	Visit(TEXT("Participants.CacheByGuid"), RemoteParticipantCacheByGuid.Num());
+	Visit(TEXT("Participants.CacheByUint"), RemoteParticipantCacheByUint.Num());
+	Visit(TEXT("Participants.Evicted"), EvictedParticipants.Num());
+	Visit(TEXT("Participants.Groups"), ParticipantsByGroup.Num());
+	Visit(TEXT("Participants.GroupMembers"), NumGroupMembers);
+	Visit(TEXT("Participants.GroupMemberIndex"), GroupMemberIndex.Num());
+	Visit(TEXT("Participants.Slots"), ParticipantSlots.Num() + FreeParticipantSlots.Num());
+	Visit(TEXT("Participants.InputAllowances"), ParticipantInputAllowances.Num());
+	Visit(TEXT("Controls.SceneByControl"), SceneByControl.Num());
+	Visit(TEXT("Controls.CoalescedStickInput"), CoalescedStickInputIndex.Num());
+}
+
+bool FMixerInteractivityModule_WithSessionState::Tick(float DeltaTime)
+{
+	FMixerInteractivityModule::Tick(DeltaTime);
+
+	// Counters and per-frame input limits follow input delivery, whatever the processing rate
+	if (IsInputDispatchStep())
+	{
+		// Cooldowns are absolute, so only buttons that saw input need any work here.
+		for (int32 ButtonIndex : ButtonsWithDirtyCounters)
+		{
+			FMixerButtonStateCached& State = Buttons.States[ButtonIndex];
+			State.DownCount = 0;
+			State.UpCount = 0;
+			State.bCountersDirty = false;
+
+			// Leave PressCount alone
+		}
+		ButtonsWithDirtyCounters.Reset();
+
+		TickInputRateLimits();
+		TickInputSampling();
+		FlushTrailingStickInput();
+	}
+
+	if (!IsProcessingStep())
+	{
+		return true;
+	}
+
+	if (!InputFilter.IsCurrent())
+	{
+		RefreshInputFilter();
+	}
+	TickVoteRounds();
+
+	for (TPair<FName, FCoordinateHeatmap>& Heatmap : CoordinateHeatmaps)
+	{
+		DecayHeatmap(Heatmap.Value, GetProcessingDeltaTime());
+		BinHeatmapSamples(Heatmap.Value);
+	}
+
+	const double TimeNow = FPlatformTime::Seconds();
+	for (TPair<FName, FInputSketch>& Sketch : InputSketches)
+	{
+		AdvanceSketch(Sketch.Value, TimeNow);
+	}
+	for (TPair<FName, FActivitySeries>& Series : ActivitySeries)
+	{
+		AdvanceActivitySeries(Series.Value, TimeNow);
+	}
+
+	if (TimeNow >= NextParticipantCacheMaintenanceTime)
+	{
+		NextParticipantCacheMaintenanceTime = TimeNow + ParticipantCacheMaintenanceInterval;
+		TickParticipantCacheMaintenance();
+	}
+
+	TSharedPtr<const FMixerLocalUser> LocalUser = GetCurrentUser();
+	if (LocalUser.IsValid() && GetDefault<UMixerInteractivitySettings>()->bEnrichParticipants)
+	{
+		ParticipantEnrichment->Tick(LocalUser->GetChannel().Id);
+	}
+
+	UpdateAdaptivePerParticipantState();
+#if MIXER_CSV_STATS_ENABLED
+	MixerCsvStats::SetParticipantCount(RemoteParticipantCacheByUint.Num() + EvictedParticipants.Num());
+#endif
+
+	if (GetDefault<UMixerInteractivitySettings>()->bPublishSessionSnapshots)
+	{
+		PublishSessionSnapshot();
+	}
+
+	return true;
+}
+
+bool FMixerInteractivityModule_WithSessionState::ReadSessionSnapshot(TFunctionRef<void(const FMixerSessionSnapshot&)> Reader)
+{
+	for (;;)
+	{
+		const int32 Index = PublishedSnapshot.GetValue();
+		if (Index == INDEX_NONE)
+		{
+			return false;
+		}
+
+		// Announce ourselves, then make sure the buffer wasn't swapped out from under us meanwhile
+		SnapshotReaders[Index].Increment();
+		if (PublishedSnapshot.GetValue() == Index)
+		{
+			Reader(Snapshots[Index]);
+			SnapshotReaders[Index].Decrement();
+			return true;
+		}
+		SnapshotReaders[Index].Decrement();
+	}
+}
+
+FMixerInputJournalCursor FMixerInteractivityModule_WithSessionState::OpenInputJournalCursor(float RewindSeconds)
+{
+	return InputJournal.OpenCursor(RewindSeconds);
+}
+
+int32 FMixerInteractivityModule_WithSessionState::ReadInputJournal(FMixerInputJournalCursor& Cursor, TArray<FMixerInputEvent>& OutEvents, int32 MaxEvents)
+{
+	return InputJournal.Read(Cursor, OutEvents, MaxEvents);
+}
+
+void FMixerInteractivityModule_WithSessionState::PublishSessionSnapshot()
+{
+	const int32 BackIndex = PublishedSnapshot.GetValue() == 0 ? 1 : 0;
+	if (SnapshotReaders[BackIndex].GetValue() != 0)
+	{
+		// Someone is still reading last frame's snapshot.  Leave the current one up and try again next tick.
+		return;
+	}
+	FPlatformMisc::MemoryBarrier();
+
+	FMixerSessionSnapshot& Snapshot = Snapshots[BackIndex];
+	Snapshot.Version = ++SnapshotVersion;
+
+	// Slots reserved for controls that haven't arrived aren't controls yet
+	Snapshot.ButtonIds.Reset(Buttons.Num());
+	Snapshot.ButtonStates.Reset(Buttons.Num());
+	for (int32 ButtonIndex = 0; ButtonIndex < Buttons.Num(); ++ButtonIndex)
+	{
+		if (!Buttons.IsReservedSlot(ButtonIndex))
+		{
+			const FMixerButtonStateCached& CachedState = Buttons.States[ButtonIndex];
+			Snapshot.ButtonIds.Add(Buttons.Ids[ButtonIndex]);
+			FMixerButtonState& State = Snapshot.ButtonStates[Snapshot.ButtonStates.Add(CachedState)];
+			State.RemainingCooldown = GetRemainingCooldown(CachedState);
+		}
+	}
+
+	Snapshot.StickIds.Reset(Sticks.Num());
+	Snapshot.StickStates.Reset(Sticks.Num());
+	for (int32 StickIndex = 0; StickIndex < Sticks.Num(); ++StickIndex)
+	{
+		if (!Sticks.IsReservedSlot(StickIndex))
+		{
+			Snapshot.StickIds.Add(Sticks.Ids[StickIndex]);
+			Snapshot.StickStates.Add(Sticks.States[StickIndex]);
+		}
+	}
+
+	Snapshot.Participants.Reset(RemoteParticipantCacheByUint.Num());
+	Snapshot.Groups.Reset(ParticipantsByGroup.Num());
+	for (const TPair<FName, TArray<TSharedPtr<const FMixerRemoteUser>>>& Group : ParticipantsByGroup)
+	{
+		FMixerGroupSnapshot& GroupSnapshot = Snapshot.Groups[Snapshot.Groups.AddDefaulted()];
+		GroupSnapshot.Group = Group.Key;
+		GroupSnapshot.FirstParticipant = Snapshot.Participants.Num();
+		GroupSnapshot.NumParticipants = Group.Value.Num();
+		for (const TSharedPtr<const FMixerRemoteUser>& User : Group.Value)
+		{
+			FMixerParticipantSnapshot& ParticipantSnapshot = Snapshot.Participants[Snapshot.Participants.AddDefaulted()];
+			ParticipantSnapshot.Id = User->Id;
+			ParticipantSnapshot.Name = User->Name;
+			ParticipantSnapshot.Group = Group.Key;
+			ParticipantSnapshot.InputEnabled = User->InputEnabled;
+		}
+	}
+
+	// Full barrier, so the contents are visible before the index that points at them
+	PublishedSnapshot.Set(BackIndex);
+}
+
+void FMixerInteractivityModule_WithSessionState::TickParticipantCacheMaintenance()
+{
+	const UMixerInteractivitySettings* Settings = GetDefault<UMixerInteractivitySettings>();
+	const SIZE_T Budget = static_cast<SIZE_T>(FMath::Max(Settings->ParticipantCacheBudgetKB, 0)) * 1024;
+	if (Budget == 0)
+	{
+		// No limit, so there's nothing to measure against; don't walk the whole audience for it
+		SET_DWORD_STAT(STAT_MixerCachedParticipants, RemoteParticipantCacheByUint.Num());
+		return;
+	}
+
+	SIZE_T CacheSize = 0;
+	TArray<TSharedPtr<FMixerRemoteUser>> IdleUsers;
+	const FDateTime IdleBefore = FDateTime::UtcNow() - FTimespan::FromSeconds(Settings->ParticipantIdleEvictionTime);
+	for (const TPair<uint32, TSharedPtr<FMixerRemoteUser>>& CachedUser : RemoteParticipantCacheByUint)
+	{
+		const FMixerRemoteUser& User = *CachedUser.Value;
+		CacheSize += EstimateCachedUserSize(User);
+		if (FMath::Max(User.ConnectedAt, User.InputAt) < IdleBefore && CanEvictUser(User))
+		{
+			IdleUsers.Add(CachedUser.Value);
+		}
+	}
+
+	if (CacheSize > Budget)
+	{
+		// Least recently active first
+		IdleUsers.Sort([](const TSharedPtr<FMixerRemoteUser>& A, const TSharedPtr<FMixerRemoteUser>& B)
+		{
+			return FMath::Max(A->ConnectedAt, A->InputAt) < FMath::Max(B->ConnectedAt, B->InputAt);
+		});
+
+		int32 NumEvicted = 0;
+		for (const TSharedPtr<FMixerRemoteUser>& User : IdleUsers)
+		{
+			if (CacheSize <= Budget)
+			{
+				break;
+			}
+
+			// Recorded while the user is still cached: RemoveUser hands the record back to the pool
+			CacheSize -= EstimateCachedUserSize(*User);
+			EvictedParticipants.Add(User->SessionGuid);
+			OnUserEvicted(*User);
+			RemoveUser(User);
+			++NumEvicted;
+		}
+
+		UE_LOG(LogMixerInteractivity, Verbose, TEXT("Evicted %d idle participants to bring the participant cache within budget (%d remain)."), NumEvicted, RemoteParticipantCacheByUint.Num());
+		INC_DWORD_STAT_BY(STAT_MixerEvictedParticipants, NumEvicted);
+	}
+
+	SET_DWORD_STAT(STAT_MixerCachedParticipants, RemoteParticipantCacheByUint.Num());
+	SET_MEMORY_STAT(STAT_MixerParticipantCacheMemory, CacheSize);
+}
+
+SIZE_T FMixerInteractivityModule_WithSessionState::EstimateCachedUserSize(const FMixerRemoteUser& User)
+{
+	// The record and the reference count sharing its allocation, an entry in each cache map,
+	// the group index and participant slot, plus the name (counted in full even though it may be shared with chat)
+	return sizeof(FMixerRemoteUser) + 2 * sizeof(int32)
+		+ sizeof(TPair<FGuid, TSharedPtr<FMixerRemoteUser>>) + sizeof(TPair<uint32, TSharedPtr<FMixerRemoteUser>>)
+		+ sizeof(TSharedPtr<const FMixerRemoteUser>) + 2 * sizeof(TPair<uint32, int32>)
+		+ User.Name.ToString().GetAllocatedSize();
+}
+
+bool FMixerInteractivityModule_WithSessionState::HandleSingleControlUpdate(FName ControlId, const TSharedRef<FJsonObject> ControlData)
+{
+	// Apply the update on top of the scene's original definition if it hasn't been needed until now
+	MaterializeControl(ControlId);
+
+	const int32 ButtonIndex = Buttons.Find(ControlId);
+	if (ButtonIndex != INDEX_NONE)
+	{
+		FMixerButtonStateCached& ButtonState = Buttons.States[ButtonIndex];
+		FMixerButtonPropertiesCached& ButtonProps = Buttons.Properties[ButtonIndex];
+
+		double Cooldown = 0.0f;
+		if (ControlData->TryGetNumberField(MixerStringConstants::FieldNames::Cooldown, Cooldown))
+		{
+			const int64 TimeNowInMixerUnits = GetServerTimeMs();
+			if (Cooldown > TimeNowInMixerUnits)
+			{
+				ButtonState.CooldownEndTime = FPlatformTime::Seconds() + static_cast<double>(static_cast<int64>(Cooldown) - TimeNowInMixerUnits) / 1000.0;
+			}
+			else
+			{
+				ButtonState.CooldownEndTime = 0.0;
+			}
+		}
+
+		FString Text;
+		if (ControlData->TryGetStringField(MixerStringConstants::FieldNames::Text, Text))
+		{
+			ButtonProps.Desc.ButtonText = FMixerLazyText(MoveTemp(Text));
+		}
+
+		FString Tooltip;
+		if (ControlData->TryGetStringField(MixerStringConstants::FieldNames::Tooltip , Tooltip))
+		{
+			ButtonProps.Desc.HelpText = FMixerLazyText(MoveTemp(Tooltip));
+		}
+
+		uint32 Cost;
+		if (ControlData->TryGetNumberField(MixerStringConstants::FieldNames::Cost, Cost))
+		{
+			ButtonProps.Desc.SparkCost = Cost;
+		}
+
+		bool bDisabled;
+		if (ControlData->TryGetBoolField(MixerStringConstants::FieldNames::Disabled, bDisabled))
+		{
+			ButtonState.Enabled = !bDisabled;
+			InputFilter.Invalidate();
+		}
+
+		double Progress;
+		if (ControlData->TryGetNumberField(MixerStringConstants::FieldNames::Progress, Progress))
+		{
+			ButtonState.Progress = Progress;
+		}
+
+		return true;
+	}
+
+	const int32 StickIndex = Sticks.Find(ControlId);
+	if (StickIndex != INDEX_NONE)
+	{
+		bool bDisabled;
+		if (ControlData->TryGetBoolField(MixerStringConstants::FieldNames::Disabled, bDisabled))
+		{
+			Sticks.States[StickIndex].Enabled = !bDisabled;
+			InputFilter.Invalidate();
+		}
+
+		return true;
+	}
+
+	return false;
+}
+
+void FMixerInteractivityModule_WithSessionState::StartSession(bool bCachePerParticipantState, int32 ExpectedParticipants)
+{
+	check(Buttons.Num() == 0);
+	check(Sticks.Num() == 0);
+	check(Labels.Num() == 0);
+	check(Textboxes.Num() == 0);
+	check(RemoteParticipantCacheByGuid.Num() == 0);
+	check(RemoteParticipantCacheByUint.Num() == 0);
+	bPerParticipantState = bCachePerParticipantState;
+	bPerParticipantStateAllowed = bCachePerParticipantState;
+	NumHeldButtonSlots = 0;
+	UserPool.Reserve(ExpectedParticipants);
+	ReserveGeneratedControlHandles();
+	const int32 InputJournalCapacity = GetDefault<UMixerInteractivitySettings>()->InputJournalCapacity;
+	if (InputJournalCapacity > 0)
+	{
+		InputJournal.Allocate(InputJournalCapacity);
+	}
+	InputJournal.BeginSession();
+#if MIXER_CSV_STATS_ENABLED
+	MixerCsvStats::BeginSession();
+#endif
+}
+
+void FMixerInteractivityModule_WithSessionState::ReserveGeneratedControlHandles()
+{
+	if (!GetDefault<UMixerInteractivitySettings>()->bReserveGeneratedControlHandles)
+	{
+		return;
+	}
+
+	// Normally already streamed in by now, in which case this runs immediately
+	FMixerProjectAssetPreloader& Preloader = FMixerProjectAssetPreloader::Get();
+	Preloader.Start();
+	const uint32 SessionGeneration = ControlGeneration;
+	Preloader.WhenComplete(FSimpleDelegate::CreateLambda([this, SessionGeneration]()
+	{
+		// The preloader forgets its callbacks before the module goes away, so only the session can have ended
+		if (SessionGeneration == ControlGeneration)
+		{
+			ReserveGeneratedControlHandlesFromDefinition();
+		}
+	}));
+}
+
+void FMixerInteractivityModule_WithSessionState::ReserveGeneratedControlHandlesFromDefinition()
+{
+	// Indices have to start at zero, so controls that arrived first can't be moved aside
+	if (Buttons.Num() > 0 || Sticks.Num() > 0)
+	{
+		UE_LOG(LogMixerInteractivity, Warning, TEXT("Project Definition finished loading after the session's controls arrived; generated control handles won't resolve this session."));
+		return;
+	}
+
+	const UMixerProjectAsset* ProjectAsset = FMixerProjectAssetPreloader::Get().GetProjectDefinition(false);
+	if (ProjectAsset == nullptr || ProjectAsset->GetControlLayoutHash() == 0)
+	{
+		UE_LOG(LogMixerInteractivity, Warning, TEXT("No Project Definition to reserve generated control handles from; they won't resolve this session."));
+		return;
+	}
+
+	// Same order as the generated header: every button, then every joystick, as listed in the definition
+	for (const FString& ButtonId : ProjectAsset->GetControlsOfKind(FMixerInteractiveControl::ButtonKind))
+	{
+		Buttons.ReserveSlot(*ButtonId);
+	}
+	for (const FString& StickId : ProjectAsset->GetControlsOfKind(FMixerInteractiveControl::JoystickKind))
+	{
+		Sticks.ReserveSlot(*StickId);
+	}
+	ReservedLayoutHash = ProjectAsset->GetControlLayoutHash();
+}
+
+void FMixerInteractivityModule_WithSessionState::DropUnclaimedControlReservations(TFunctionRef<bool(FName)> KeepReservation)
+{
+	const int32 NumDropped = Buttons.DropReservations(KeepReservation) + Sticks.DropReservations(KeepReservation);
+	if (NumDropped > 0)
+	{
+		UE_LOG(LogMixerInteractivity, Warning, TEXT("%d controls in the Project Definition are missing from the interactive project; their generated handles won't resolve."), NumDropped);
+	}
+}
+
+void FMixerInteractivityModule_WithSessionState::RetireSeededControls(TFunctionRef<bool(FName)> IsLive)
+{
+	const int32 NumRetired = Buttons.RetireControls(IsLive) + Sticks.RetireControls(IsLive) + Labels.RetireControls(IsLive) + Textboxes.RetireControls(IsLive);
+	if (NumRetired == 0)
+	{
+		return;
+	}
+
+	for (auto It = ControlDirectory.CreateIterator(); It; ++It)
+	{
+		if (!IsLive(It->Value.ControlId))
+		{
+			It.RemoveCurrent();
+		}
+	}
+	for (auto It = SceneByControl.CreateIterator(); It; ++It)
+	{
+		if (!IsLive(It->Key))
+		{
+			It.RemoveCurrent();
+		}
+	}
+	InputFilter.Invalidate();
+	UE_LOG(LogMixerInteractivity, Log, TEXT("Retired %d seeded controls that the interactive project no longer has."), NumRetired);
+}
+
+void FMixerInteractivityModule_WithSessionState::EndSession()
+{
+#if MIXER_CSV_STATS_ENABLED
+	MixerCsvStats::EndSession();
+#endif
+
+	// Updates submitted from other threads were aimed at this session's controls
+	DiscardSubmittedControlUpdates();
+
+	// Votes can't outlive the participants who cast them
+	TArray<int32> OpenRounds;
+	VoteRounds.GetKeys(OpenRounds);
+	for (int32 RoundId : OpenRounds)
+	{
+		FMixerVoteRoundResult Result;
+		CloseVoteRound(RoundId, Result);
+	}
+
+	// Readers on other threads see no session rather than the last frame of this one.  Anyone still
+	// reading a buffer keeps it safe; the next publish waits for them as usual.
+	PublishedSnapshot.Set(INDEX_NONE);
+
+	Buttons.Empty();
+	Sticks.Empty();
+	Labels.Empty();
+	Textboxes.Empty();
+	ControlDirectory.Empty();
+	SceneByControl.Empty();
+	InputFilter.Invalidate();
+	ButtonsWithDirtyCounters.Empty();
+	SticksWithTrailingInput.Empty();
+	CoalescedStickInput.Empty();
+	CoalescedStickInputIndex.Empty();
+	if (++ControlGeneration == 0)
+	{
+		// 0 is reserved for never-resolved handles
+		ControlGeneration = 1;
+	}
+	ReservedLayoutHash = 0;
+	RemoteParticipantCacheByGuid.Empty();
+	RemoteParticipantCacheByUint.Empty();
+	ParticipantEnrichment->Reset(false);
+	ParticipantsByGroup.Empty();
+	GroupMemberIndex.Empty();
+	for (TMap<FName, FMixerParticipantOrder>& Orders : ParticipantOrders)
+	{
+		Orders.Empty();
+	}
+	EvictedParticipants.Empty();
+	ParticipantSlots.Empty();
+	FreeParticipantSlots.Empty();
+	NumParticipantSlots = 0;
+	NumHeldButtonSlots = 0;
+	ParticipantSlotGroups.Empty();
+	ControlStateByGroup.Empty();
+	ParticipantInputAllowances.Empty();
+	BatchedInput.Empty();
+	BatchedInputStrings.Empty();
+	BatchedInputGroups.Empty();
+	GroupIndexOfInput.Empty();
+	GroupedInput.Empty();
+	GroupInputBatches.Empty();
+	GroupControlSummaries.Empty();
+
+	// Heatmaps are configured by the game, so survive the session, but start the next one cold
+	for (TPair<FName, FCoordinateHeatmap>& Heatmap : CoordinateHeatmaps)
+	{
+		FMemory::Memzero(Heatmap.Value.Cells.GetData(), Heatmap.Value.Cells.Num() * sizeof(float));
+		Heatmap.Value.PendingSamples.Empty();
+	}
+	for (TPair<FName, FInputSketch>& Sketch : InputSketches)
+	{
+		for (int32 Bucket = 0; Bucket < Sketch.Value.Settings.WindowBuckets; ++Bucket)
+		{
+			ClearSketchBucket(Sketch.Value, Bucket);
+		}
+	}
+	for (TPair<FName, FActivitySeries>& Series : ActivitySeries)
+	{
+		FMemory::Memzero(Series.Value.Samples.GetData(), Series.Value.Samples.Num() * sizeof(float));
+	}
+}
+
+bool FMixerInteractivityModule_WithSessionState::CachePerParticipantState()
+{
+	return bPerParticipantState;
+}
+
+void FMixerInteractivityModule_WithSessionState::UpdateAdaptivePerParticipantState()
+{
+	const UMixerInteractivitySettings* Settings = GetDefault<UMixerInteractivitySettings>();
+	if (!bPerParticipantStateAllowed || !Settings->bAdaptivePerParticipantStateCaching)
+	{
+		if (bPerParticipantStateAllowed && !bPerParticipantState)
+		{
+			// Adaptive mode was turned off while tracking was suspended
+			SetPerParticipantState(true);
+		}
+		return;
+	}
+
+	// Evicted participants are still in the audience even though they cost nothing to track
+	const int32 AudienceSize = RemoteParticipantCacheByUint.Num() + EvictedParticipants.Num();
+	if (bPerParticipantState && AudienceSize > Settings->PerParticipantStateAudienceLimit)
+	{
+		SetPerParticipantState(false);
+	}
+	else if (!bPerParticipantState && AudienceSize <= FMath::Min(Settings->PerParticipantStateAudienceResume, Settings->PerParticipantStateAudienceLimit))
+	{
+		SetPerParticipantState(true);
+	}
+}
+
+void FMixerInteractivityModule_WithSessionState::SetPerParticipantState(bool bEnabled)
+{
+	bPerParticipantState = bEnabled;
+	UE_LOG(LogMixerInteractivity, Log, TEXT("%s per-participant control state with %d participants cached."),
+		bEnabled ? TEXT("Resuming") : TEXT("Suspending"), RemoteParticipantCacheByUint.Num());
+
+	if (!bEnabled)
+	{
+		// Button holds are left to drain as their releases arrive (see SetButtonHeldByParticipant) so PressCount
+		// doesn't jump.  Per-participant stick values have no such meaning outside this mode, so go now.
+		for (int32 StickIndex = 0; StickIndex < Sticks.Num(); ++StickIndex)
+		{
+			Sticks.Properties[StickIndex].ResetParticipantValues();
+			Sticks.States[StickIndex].Axes = FVector2D(0, 0);
+		}
+		for (TPair<FName, FMixerGroupControlState>& GroupState : ControlStateByGroup)
+		{
+			GroupState.Value.StickSums.Empty();
+		}
+
+		if (NumHeldButtonSlots == 0)
+		{
+			ReleaseHoldingParticipantSlots();
+		}
+	}
+
+	PerParticipantStateCachingChanged.Broadcast(bEnabled);
+}
+
+void FMixerInteractivityModule_WithSessionState::ReleaseHoldingParticipantSlots()
+{
+	MIXER_LLM_SCOPE(Participants);
+	for (FMixerButtonPropertiesCached& ButtonProps : Buttons.Properties)
+	{
+		ButtonProps.HoldingParticipantSlots.Empty();
+	}
+}
+
+void FMixerInteractivityModule_WithSessionState::AddButton(FName ControlId, const FMixerButtonPropertiesCached& Props, const FMixerButtonState& InitialState)
+{
+	FMixerButtonStateCached State;
+	static_cast<FMixerButtonState&>(State) = InitialState;
+	State.CooldownEndTime = InitialState.RemainingCooldown > FTimespan::Zero() ? FPlatformTime::Seconds() + InitialState.RemainingCooldown.GetTotalSeconds() : 0.0;
+	State.bCountersDirty = false;
+
+	AddToControlDirectory(ControlId, EMixerCachedControlKind::Button, Buttons.Add(ControlId, Props, State));
+}
+
+FMixerButtonState& FMixerInteractivityModule_WithSessionState::TouchButtonState(int32 Index)
+{
+	FMixerButtonStateCached& State = Buttons.States[Index];
+	if (!State.bCountersDirty)
+	{
+		State.bCountersDirty = true;
+		ButtonsWithDirtyCounters.Add(Index);
+	}
+	return State;
+}
+
+void FMixerInteractivityModule_WithSessionState::SetButtonHeldByParticipant(int32 ButtonIndex, uint32 ParticipantId, bool bHeld)
+{
+	MIXER_LLM_SCOPE(Participants);
+	if (bHeld && !bPerParticipantState)
+	{
+		return;
+	}
+
+	const int32* Slot = ParticipantSlots.Find(ParticipantId);
+	if (Slot == nullptr)
+	{
+		return;
+	}
+
+	TBitArray<>& HoldingSlots = Buttons.Properties[ButtonIndex].HoldingParticipantSlots;
+	if (*Slot >= HoldingSlots.Num())
+	{
+		if (!bHeld)
+		{
+			return;
+		}
+
+		while (HoldingSlots.Num() <= *Slot)
+		{
+			HoldingSlots.Add(false);
+		}
+	}
+
+	if (HoldingSlots[*Slot] != bHeld)
+	{
+		HoldingSlots[*Slot] = bHeld;
+		uint32& PressCount = Buttons.States[ButtonIndex].PressCount;
+		PressCount = bHeld ? PressCount + 1 : PressCount - 1;
+		AddGroupButtonHold(*Slot, ButtonIndex, bHeld);
+		NumHeldButtonSlots += bHeld ? 1 : -1;
+		if (NumHeldButtonSlots == 0 && !bPerParticipantState)
+		{
+			// The last hold from before the switch to aggregate-only tracking has ended
+			ReleaseHoldingParticipantSlots();
+		}
+	}
+}
+
+void FMixerStickSums::Accumulate(float X, float Y, double Sign)
+{
+	const double Weight = FMath::Sqrt(static_cast<double>(X) * X + static_cast<double>(Y) * Y);
+	SumX += Sign * X;
+	SumY += Sign * Y;
+	SumSquaresX += Sign * X * X;
+	SumSquaresY += Sign * Y * Y;
+	SumWeightedX += Sign * X * Weight;
+	SumWeightedY += Sign * Y * Weight;
+	SumWeights += Sign * Weight;
+
+	const int32 Quadrant = X >= 0.0f ? (Y >= 0.0f ? 0 : 3) : (Y >= 0.0f ? 1 : 2);
+	QuadrantVotes[Quadrant] += Sign > 0.0 ? 1 : -1;
+	NumValues += Sign > 0.0 ? 1 : -1;
+}
+
+void FMixerStickSums::GetAggregate(FMixerStickAggregate& OutAggregate) const
+{
+	const int32 Count = NumValues;
+	OutAggregate.ParticipantCount = Count;
+	FMemory::Memcpy(OutAggregate.QuadrantVotes, QuadrantVotes, sizeof(OutAggregate.QuadrantVotes));
+	if (Count > 0)
+	{
+		const double MeanX = SumX / Count;
+		const double MeanY = SumY / Count;
+		OutAggregate.Mean = FVector2D(static_cast<float>(MeanX), static_cast<float>(MeanY));
+		OutAggregate.Variance = FVector2D(
+			static_cast<float>(FMath::Max(SumSquaresX / Count - MeanX * MeanX, 0.0)),
+			static_cast<float>(FMath::Max(SumSquaresY / Count - MeanY * MeanY, 0.0)));
+		OutAggregate.WeightedMean = SumWeights > 0.0
+			? FVector2D(static_cast<float>(SumWeightedX / SumWeights), static_cast<float>(SumWeightedY / SumWeights))
+			: FVector2D(0, 0);
+		// Variance is the population variance of the kept input, so the unbiased estimate for the mean's error divides by Count - 1
+		OutAggregate.MeanStandardError = Count > 1
+			? FVector2D(FMath::Sqrt(OutAggregate.Variance.X / (Count - 1)), FMath::Sqrt(OutAggregate.Variance.Y / (Count - 1)))
+			: FVector2D(0, 0);
+	}
+	else
+	{
+		OutAggregate.Mean = FVector2D(0, 0);
+		OutAggregate.WeightedMean = FVector2D(0, 0);
+		OutAggregate.Variance = FVector2D(0, 0);
+		OutAggregate.MeanStandardError = FVector2D(0, 0);
+	}
+}
+
+void FMixerGroupControlState::Append(const FMixerGroupControlState& Other)
+{
+	if (HeldButtonCounts.Num() < Other.HeldButtonCounts.Num())
+	{
+		HeldButtonCounts.SetNumZeroed(Other.HeldButtonCounts.Num());
+	}
+	for (int32 ButtonIndex = 0; ButtonIndex < Other.HeldButtonCounts.Num(); ++ButtonIndex)
+	{
+		HeldButtonCounts[ButtonIndex] += Other.HeldButtonCounts[ButtonIndex];
+	}
+
+	if (StickSums.Num() < Other.StickSums.Num())
+	{
+		StickSums.SetNum(Other.StickSums.Num());
+	}
+	for (int32 StickIndex = 0; StickIndex < Other.StickSums.Num(); ++StickIndex)
+	{
+		FMixerStickSums& Sums = StickSums[StickIndex];
+		const FMixerStickSums& OtherSums = Other.StickSums[StickIndex];
+		Sums.SumX += OtherSums.SumX;
+		Sums.SumY += OtherSums.SumY;
+		Sums.SumSquaresX += OtherSums.SumSquaresX;
+		Sums.SumSquaresY += OtherSums.SumSquaresY;
+		Sums.SumWeightedX += OtherSums.SumWeightedX;
+		Sums.SumWeightedY += OtherSums.SumWeightedY;
+		Sums.SumWeights += OtherSums.SumWeights;
+		for (int32 Quadrant = 0; Quadrant < ARRAY_COUNT(Sums.QuadrantVotes); ++Quadrant)
+		{
+			Sums.QuadrantVotes[Quadrant] += OtherSums.QuadrantVotes[Quadrant];
+		}
+		Sums.NumValues += OtherSums.NumValues;
+	}
+}
+
+void FMixerInteractivityModule_WithSessionState::SetStickValueForParticipant(int32 StickIndex, uint32 ParticipantId, FVector2D Value)
+{
+	MIXER_LLM_SCOPE(Participants);
+	FMixerStickPropertiesCached& StickProps = Sticks.Properties[StickIndex];
+	const int32* ExistingIndex = StickProps.ValueIndexByParticipant.Find(ParticipantId);
+	if (Value.X != 0 || Value.Y != 0)
+	{
+		const int32* Slot = ParticipantSlots.Find(ParticipantId);
+		int32 ValueIndex;
+		if (ExistingIndex != nullptr)
+		{
+			ValueIndex = *ExistingIndex;
+			StickProps.Accumulate(StickProps.ValuesX[ValueIndex], StickProps.ValuesY[ValueIndex], -1.0);
+			if (Slot != nullptr)
+			{
+				AccumulateGroupStickValue(*Slot, StickIndex, StickProps.ValuesX[ValueIndex], StickProps.ValuesY[ValueIndex], -1.0);
+			}
+		}
+		else
+		{
+			ValueIndex = StickProps.ParticipantIds.Add(ParticipantId);
+			StickProps.ValuesX.AddUninitialized();
+			StickProps.ValuesY.AddUninitialized();
+			StickProps.ValueIndexByParticipant.Add(ParticipantId, ValueIndex);
+		}
+
+		StickProps.ValuesX[ValueIndex] = Value.X;
+		StickProps.ValuesY[ValueIndex] = Value.Y;
+		StickProps.Accumulate(Value.X, Value.Y, 1.0);
+		if (Slot != nullptr)
+		{
+			AccumulateGroupStickValue(*Slot, StickIndex, Value.X, Value.Y, 1.0);
+		}
+	}
+	else if (ExistingIndex != nullptr)
+	{
+		RemoveStickValue(StickIndex, *ExistingIndex);
+	}
+	else
+	{
+		return;
+	}
+
+	UpdateStickAxes(StickIndex);
+}
+
+void FMixerInteractivityModule_WithSessionState::RemoveStickValue(int32 StickIndex, int32 ValueIndex)
+{
+	FMixerStickPropertiesCached& StickProps = Sticks.Properties[StickIndex];
+	StickProps.Accumulate(StickProps.ValuesX[ValueIndex], StickProps.ValuesY[ValueIndex], -1.0);
+	const int32* Slot = ParticipantSlots.Find(StickProps.ParticipantIds[ValueIndex]);
+	if (Slot != nullptr)
+	{
+		AccumulateGroupStickValue(*Slot, StickIndex, StickProps.ValuesX[ValueIndex], StickProps.ValuesY[ValueIndex], -1.0);
+	}
+	StickProps.ValueIndexByParticipant.Remove(StickProps.ParticipantIds[ValueIndex]);
+
+	// Keep the arrays packed by moving the last value into the hole
+	const int32 LastIndex = StickProps.ParticipantIds.Num() - 1;
+	if (ValueIndex != LastIndex)
+	{
+		StickProps.ValueIndexByParticipant.Add(StickProps.ParticipantIds[LastIndex], ValueIndex);
+	}
+	StickProps.ParticipantIds.RemoveAtSwap(ValueIndex, 1, false);
+	StickProps.ValuesX.RemoveAtSwap(ValueIndex, 1, false);
+	StickProps.ValuesY.RemoveAtSwap(ValueIndex, 1, false);
+
+	if (StickProps.ParticipantIds.Num() == 0)
+	{
+		// Nobody left, so discard any rounding error accumulated in the sums
+		StickProps.ResetParticipantValues();
+	}
+}
+
+void FMixerInteractivityModule_WithSessionState::UpdateStickAxes(int32 StickIndex)
+{
+	const FMixerStickPropertiesCached& StickProps = Sticks.Properties[StickIndex];
+	const int32 Count = StickProps.ParticipantIds.Num();
+	Sticks.States[StickIndex].Axes = Count > 0
+		? FVector2D(static_cast<float>(StickProps.SumX / Count), static_cast<float>(StickProps.SumY / Count))
+		: FVector2D(0, 0);
+}
+
+FTimespan FMixerInteractivityModule_WithSessionState::GetRemainingCooldown(const FMixerButtonStateCached& State)
+{
+	const double Remaining = State.CooldownEndTime - FPlatformTime::Seconds();
+	return Remaining > 0.0 ? FTimespan::FromSeconds(Remaining) : FTimespan::Zero();
+}
+
+void FMixerInteractivityModule_WithSessionState::AddStick(FName ControlId, const FMixerStickPropertiesCached& Props, const FMixerStickState& InitialState)
+{
+	const int32 StickIndex = Sticks.Add(ControlId, Props, InitialState);
+
+	const UMixerInteractivitySettings* Settings = GetDefault<UMixerInteractivitySettings>();
+	const FMixerStickInputFilter* Filter = Settings->StickInputFilterOverrides.Find(ControlId);
+	if (Filter == nullptr)
+	{
+		Filter = &Settings->StickInputFilter;
+	}
+	FMixerStickPropertiesCached& AddedProps = Sticks.Properties[StickIndex];
+	AddedProps.FilterDeadzone = Filter->Deadzone;
+	AddedProps.FilterMinimumDelta = Filter->MinimumDelta;
+	AddedProps.FilterMinInterval = Filter->MaxEventsPerSecond > 0.0f ? 1.0 / Filter->MaxEventsPerSecond : 0.0;
+
+	AddToControlDirectory(ControlId, EMixerCachedControlKind::Stick, StickIndex);
+}
+
+bool FMixerInteractivityModule_WithSessionState::FilterStickInput(int32 StickIndex, const FMixerRemoteUser* Participant, FVector2D& InOutValue)
+{
+	FMixerStickPropertiesCached& StickProps = Sticks.Properties[StickIndex];
+	if (Participant == nullptr
+		|| (StickProps.FilterDeadzone <= 0.0f && StickProps.FilterMinimumDelta <= 0.0f && StickProps.FilterMinInterval <= 0.0))
+	{
+		return true;
+	}
+
+	const uint32 ParticipantId = Participant->Id;
+
+	if (InOutValue.SizeSquared() < FMath::Square(StickProps.FilterDeadzone))
+	{
+		InOutValue = FVector2D::ZeroVector;
+	}
+
+	const double TimeNow = FPlatformTime::Seconds();
+	FMixerStickPropertiesCached::FFilterState* LastDelivered = StickProps.FilterStateByParticipant.Find(ParticipantId);
+	if (LastDelivered == nullptr)
+	{
+		// Nothing delivered yet reads as centred
+		if (InOutValue.IsZero())
+		{
+			INC_DWORD_STAT(STAT_MixerStickInputFiltered);
+			return false;
+		}
+
+		MIXER_LLM_SCOPE(Participants);
+		LastDelivered = &StickProps.FilterStateByParticipant.Add(ParticipantId);
+	}
+	else if (InOutValue.IsZero())
+	{
+		if (LastDelivered->Value.IsZero())
+		{
+			ForgetTrailingStickValue(StickProps, *LastDelivered);
+			INC_DWORD_STAT(STAT_MixerStickInputFiltered);
+			return false;
+		}
+	}
+	else if (FVector2D::DistSquared(InOutValue, LastDelivered->Value) < FMath::Square(StickProps.FilterMinimumDelta))
+	{
+		// Back within reach of what the game already has, so anything held back is stale
+		ForgetTrailingStickValue(StickProps, *LastDelivered);
+		INC_DWORD_STAT(STAT_MixerStickInputFiltered);
+		return false;
+	}
+	else if (TimeNow - LastDelivered->Time < StickProps.FilterMinInterval)
+	{
+		// Keep the latest so the game isn't left on an old value once the participant stops moving
+		if (!LastDelivered->bTrailing)
+		{
+			LastDelivered->bTrailing = true;
+			if (StickProps.NumTrailingValues++ == 0)
+			{
+				SticksWithTrailingInput.Add(StickIndex);
+			}
+		}
+		LastDelivered->TrailingValue = InOutValue;
+		INC_DWORD_STAT(STAT_MixerStickInputFiltered);
+		return false;
+	}
+
+	ForgetTrailingStickValue(StickProps, *LastDelivered);
+	LastDelivered->Value = InOutValue;
+	LastDelivered->Time = TimeNow;
+	return true;
+}
+
+void FMixerInteractivityModule_WithSessionState::DeliverStickInput(FName ControlId, TSharedPtr<const FMixerRemoteUser> Participant, FVector2D Value)
+{
+	BroadcastStickEvent(ControlId, Participant, Value);
+	RecordStickInput(ControlId, Participant.Get(), Value);
+}
+
+void FMixerInteractivityModule_WithSessionState::DeliverOrCoalesceStickInput(FName ControlId, const TSharedPtr<const FMixerRemoteUser>& Participant, FVector2D Value)
+{
+	if (!bCoalesceStickInput)
+	{
+		DeliverStickInput(ControlId, Participant, Value);
+		return;
+	}
+
+	const uint64 Key = (static_cast<uint64>(ControlId.GetComparisonIndex()) << 32) | (Participant.IsValid() ? Participant->Id : 0);
+	const int32* ExistingIndex = CoalescedStickInputIndex.Find(Key);
+	int32 Index;
+	if (ExistingIndex != nullptr)
+	{
+		Index = *ExistingIndex;
+		MIXER_CSV_COUNT(InputCoalesced, 1);
+	}
+	else
+	{
+		Index = CoalescedStickInput.AddDefaulted();
+		CoalescedStickInput[Index].ControlId = ControlId;
+		CoalescedStickInput[Index].Participant = Participant;
+		CoalescedStickInput[Index].bFromKnownParticipant = Participant.IsValid();
+		CoalescedStickInputIndex.Add(Key, Index);
+	}
+	CoalescedStickInput[Index].Value = Value;
+}
+
+void FMixerInteractivityModule_WithSessionState::FlushCoalescedStickInput()
+{
+	for (int32 Index = 0; Index < CoalescedStickInput.Num(); ++Index)
+	{
+		const FCoalescedStickInput& Input = CoalescedStickInput[Index];
+		TSharedPtr<const FMixerRemoteUser> Participant = Input.Participant.Pin();
+		if (Participant.IsValid() || !Input.bFromKnownParticipant)
+		{
+			DeliverStickInput(Input.ControlId, Participant, Input.Value);
+		}
+	}
+	CoalescedStickInput.Reset();
+	CoalescedStickInputIndex.Reset();
+}
+
+void FMixerInteractivityModule_WithSessionState::FlushTrailingStickInput()
+{
+	if (SticksWithTrailingInput.Num() == 0)
+	{
+		return;
+	}
+
+	struct FTrailingMove
+	{
+		FName ControlId;
+		TSharedPtr<FMixerRemoteUser> Participant;
+		FVector2D Value;
+	};
+
+	// Collected first, as game code run by the delivery may change the participants or the sticks
+	TArray<FTrailingMove, TInlineAllocator<16>> Moves;
+	const double TimeNow = FPlatformTime::Seconds();
+	for (int32 ListIndex = SticksWithTrailingInput.Num() - 1; ListIndex >= 0; --ListIndex)
+	{
+		const int32 StickIndex = SticksWithTrailingInput[ListIndex];
+		if (!Sticks.Properties.IsValidIndex(StickIndex))
+		{
+			SticksWithTrailingInput.RemoveAtSwap(ListIndex);
+			continue;
+		}
+
+		FMixerStickPropertiesCached& StickProps = Sticks.Properties[StickIndex];
+		for (TPair<uint32, FMixerStickPropertiesCached::FFilterState>& State : StickProps.FilterStateByParticipant)
+		{
+			if (!State.Value.bTrailing || TimeNow - State.Value.Time < StickProps.FilterMinInterval)
+			{
+				continue;
+			}
+
+			ForgetTrailingStickValue(StickProps, State.Value);
+			TSharedPtr<FMixerRemoteUser> Participant = GetCachedUser(State.Key);
+			if (Participant.IsValid() && AdmitParticipantInput(Participant.Get(), EMixerInputRateClass::Stick))
+			{
+				State.Value.Value = State.Value.TrailingValue;
+				State.Value.Time = TimeNow;
+				FTrailingMove& Move = Moves.AddDefaulted_GetRef();
+				Move.ControlId = Sticks.Ids[StickIndex];
+				Move.Participant = Participant;
+				Move.Value = State.Value.TrailingValue;
+			}
+		}
+
+		if (StickProps.NumTrailingValues == 0)
+		{
+			SticksWithTrailingInput.RemoveAtSwap(ListIndex);
+		}
+	}
+
+	for (const FTrailingMove& Move : Moves)
+	{
+		DeliverStickInput(Move.ControlId, Move.Participant, Move.Value);
+	}
+}
+
+void FMixerInteractivityModule_WithSessionState::ForgetTrailingStickValue(FMixerStickPropertiesCached& StickProps, FMixerStickPropertiesCached::FFilterState& State)
+{
+	if (State.bTrailing)
+	{
+		State.bTrailing = false;
+		--StickProps.NumTrailingValues;
+	}
+}
+
+void FMixerInteractivityModule_WithSessionState::ForgetStickFilterState(FMixerStickPropertiesCached& StickProps, uint32 ParticipantId)
+{
+	FMixerStickPropertiesCached::FFilterState Removed;
+	if (StickProps.FilterStateByParticipant.RemoveAndCopyValue(ParticipantId, Removed))
+	{
+		ForgetTrailingStickValue(StickProps, Removed);
+	}
+}
+
+void FMixerInteractivityModule_WithSessionState::AddLabel(FName ControlId, const FMixerLabelPropertiesCached& Props)
+{
+	AddToControlDirectory(ControlId, EMixerCachedControlKind::Label, Labels.Add(ControlId, Props));
+}
+
+FMixerLabelPropertiesCached* FMixerInteractivityModule_WithSessionState::GetLabel(FName ControlId)
+{
+	const int32 Index = Labels.Find(ControlId);
+	return Index != INDEX_NONE ? &Labels.Properties[Index] : nullptr;
+}
+
+void FMixerInteractivityModule_WithSessionState::AddTextbox(FName ControlId, const FMixerTextboxPropertiesCached& Props)
+{
+	AddToControlDirectory(ControlId, EMixerCachedControlKind::Textbox, Textboxes.Add(ControlId, Props));
+}
+
+FMixerTextboxPropertiesCached* FMixerInteractivityModule_WithSessionState::GetTextbox(FName ControlId)
+{
+	const int32 Index = Textboxes.Find(ControlId);
+	return Index != INDEX_NONE ? &Textboxes.Properties[Index] : nullptr;
+}
+
+const FMixerControlDirectoryEntry* FMixerInteractivityModule_WithSessionState::FindControl(const FString& RawControlId)
+{
+	return ControlDirectory.Find(RawControlId);
+}
+
+void FMixerInteractivityModule_WithSessionState::AddToControlDirectory(FName ControlId, EMixerCachedControlKind Kind, int32 Index)
+{
+	// Table indices don't move when other controls are added, so entries can be written once up front.
+	FMixerControlDirectoryEntry& Entry = ControlDirectory.Add(ControlId.ToString());
+	Entry.ControlId = ControlId;
+	Entry.Kind = Kind;
+	Entry.Index = Index;
+	InputFilter.Invalidate();
+}
+
+void FMixerInteractivityModule_WithSessionState::NoteControlScene(FName ControlId, FName SceneId)
+{
+	SceneByControl.Add(ControlId, SceneId);
+	InputFilter.Invalidate();
+}
+
+bool FMixerInteractivityModule_WithSessionState::RejectsControlInput(FName ControlId)
+{
+	if (!InputFilter.IsCurrent())
+	{
+		RefreshInputFilter();
+	}
+	return InputFilter.Rejects(ControlId);
+}
+
+void FMixerInteractivityModule_WithSessionState::RefreshInputFilter()
+{
+	const int32 RebuildGeneration = InputFilter.BeginRebuild();
+
+	TSet<FName> Rejected;
+	TSet<FName> ActiveScenes;
+	GetActiveScenes(ActiveScenes);
+	if (ActiveScenes.Num() > 0)
+	{
+		for (const TPair<FName, FName>& Control : SceneByControl)
+		{
+			if (!ActiveScenes.Contains(Control.Value))
+			{
+				Rejected.Add(Control.Key);
+			}
+		}
+	}
+
+	for (int32 ButtonIndex = 0; ButtonIndex < Buttons.Num(); ++ButtonIndex)
+	{
+		if (!Buttons.States[ButtonIndex].Enabled && !Buttons.IsReservedSlot(ButtonIndex))
+		{
+			Rejected.Add(Buttons.Ids[ButtonIndex]);
+		}
+	}
+	for (int32 StickIndex = 0; StickIndex < Sticks.Num(); ++StickIndex)
+	{
+		if (!Sticks.States[StickIndex].Enabled && !Sticks.IsReservedSlot(StickIndex))
+		{
+			Rejected.Add(Sticks.Ids[StickIndex]);
+		}
+	}
+
+	InputFilter.FinishRebuild(MoveTemp(Rejected), RebuildGeneration);
+}
+
+void FMixerInteractivityModule_WithSessionState::AddUser(TSharedPtr<FMixerRemoteUser> User)
+{
+	MIXER_LLM_SCOPE(Participants);
+	TSharedPtr<FMixerRemoteUser>* ReplacedUser = RemoteParticipantCacheByUint.Find(User->Id);
+	if (ReplacedUser != nullptr)
+	{
+		RemoveFromGroupIndex(**ReplacedUser);
+	}
+
+	RemoteParticipantCacheByGuid.Add(User->SessionGuid, User);
+	RemoteParticipantCacheByUint.Add(User->Id, User);
+	AddToGroupIndex(User);
+	AssignParticipantSlot(User->Id);
+	// A rejoin keeps the slot, but may come back in another group
+	SetParticipantGroupTotals(User->Id, User->Group);
+	EvictedParticipants.Remove(User->SessionGuid);
+
+	if (!User->ChannelRelationshipKnown && GetDefault<UMixerInteractivitySettings>()->bEnrichParticipants)
+	{
+		// Rejoins within the cache lifetime are answered on the spot
+		if (ParticipantEnrichment->FindCached(User->Id, User->ChannelRelationship))
+		{
+			User->ChannelRelationshipKnown = true;
+		}
+		else
+		{
+			ParticipantEnrichment->Enqueue(User->Id);
+		}
+	}
+}
+
+void FMixerInteractivityModule_WithSessionState::OnParticipantEnrichmentResolved(const TArray<uint32>& UserIds)
+{
+	TArray<TSharedPtr<const FMixerRemoteUser>> EnrichedUsers;
+	EnrichedUsers.Reserve(UserIds.Num());
+	for (uint32 UserId : UserIds)
+	{
+		TSharedPtr<FMixerRemoteUser> User = GetCachedUser(UserId);
+		if (User.IsValid() && ParticipantEnrichment->FindCached(UserId, User->ChannelRelationship))
+		{
+			User->ChannelRelationshipKnown = true;
+			EnrichedUsers.Add(User);
+		}
+	}
+
+	if (EnrichedUsers.Num() > 0)
+	{
+		OnParticipantsEnriched().Broadcast(EnrichedUsers);
+	}
+}
+
+void FMixerInteractivityModule_WithSessionState::SetUserSessionGuid(const TSharedPtr<FMixerRemoteUser>& User, const FGuid& SessionGuid)
+{
+	if (User->SessionGuid != SessionGuid)
+	{
+		RemoteParticipantCacheByGuid.Remove(User->SessionGuid);
+		User->SessionGuid = SessionGuid;
+		RemoteParticipantCacheByGuid.Add(SessionGuid, User);
+	}
+}
+
+TSharedPtr<FMixerRemoteUser> FMixerInteractivityModule_WithSessionState::RestoreEvictedUser(const FMixerRemoteUser& Participant)
+{
+	MIXER_LLM_SCOPE(Participants);
+	TSharedPtr<FMixerRemoteUser> User = AllocateUser();
+	*User = Participant;
+	AddUser(User);
+	return User;
+}
+
+void FMixerInteractivityModule_WithSessionState::ReserveUsers(int32 NumAdditionalUsers)
+{
+	MIXER_LLM_SCOPE(Participants);
+	RemoteParticipantCacheByGuid.Reserve(RemoteParticipantCacheByGuid.Num() + NumAdditionalUsers);
+	RemoteParticipantCacheByUint.Reserve(RemoteParticipantCacheByUint.Num() + NumAdditionalUsers);
+}
+
+void FMixerInteractivityModule_WithSessionState::RemoveUser(TSharedPtr<FMixerRemoteUser> User)
+{
+	RemoteParticipantCacheByGuid.Remove(User->SessionGuid);
+	RemoteParticipantCacheByUint.Remove(User->Id);
+	RemoveFromGroupIndex(*User);
+	ReleaseParticipantSlot(User->Id);
+	ParticipantInputAllowances.Remove(User->Id);
+	for (FMixerStickPropertiesCached& StickProps : Sticks.Properties)
+	{
+		ForgetStickFilterState(StickProps, User->Id);
+	}
+}
+
+void FMixerInteractivityModule_WithSessionState::RemoveUser(FGuid ParticipantSessionId)
+{
+	TSharedPtr<FMixerRemoteUser> RemovedUser;
+	if (!RemoteParticipantCacheByGuid.RemoveAndCopyValue(ParticipantSessionId, RemovedUser))
+	{
+		// Only expected for participants that had been evicted
+		ensure(EvictedParticipants.Remove(ParticipantSessionId) > 0);
+		return;
+	}
+
+	RemoteParticipantCacheByUint.Remove(RemovedUser->Id);
+	RemoveFromGroupIndex(*RemovedUser);
+	ReleaseParticipantSlot(RemovedUser->Id);
+	ParticipantInputAllowances.Remove(RemovedUser->Id);
+	for (FMixerStickPropertiesCached& StickProps : Sticks.Properties)
+	{
+		ForgetStickFilterState(StickProps, RemovedUser->Id);
+	}
+}
+
+void FMixerInteractivityModule_WithSessionState::TickInputRateLimits()
+{
+	const UMixerInteractivitySettings* Settings = GetDefault<UMixerInteractivitySettings>();
+	const FMixerInputRateLimit* ConfiguredLimits[] =
+	{
+		&Settings->ButtonInputRateLimit,
+		&Settings->StickInputRateLimit,
+		&Settings->TextboxInputRateLimit,
+		&Settings->CustomControlInputRateLimit,
+	};
+	static_assert(ARRAY_COUNT(ConfiguredLimits) == static_cast<int32>(EMixerInputRateClass::Count), "Every input rate class needs a setting");
+
+	for (int32 i = 0; i < ARRAY_COUNT(ConfiguredLimits); ++i)
+	{
+		InputRateLimits[i].bEnabled = ConfiguredLimits[i]->bEnabled;
+		InputRateLimits[i].EventsPerSecond = ConfiguredLimits[i]->EventsPerSecond;
+		InputRateLimits[i].Burst = static_cast<float>(FMath::Max(1, ConfiguredLimits[i]->Burst));
+	}
+
+	MaxInputEventsPerFrame = Settings->MaxInputEventsPerFrame;
+	FairInputShare = MaxInputEventsPerFrame > 0 ? FMath::Max(1, MaxInputEventsPerFrame / FMath::Max(1, ParticipantsWithInputThisFrame)) : MAX_int32;
+	InputEventsThisFrame = 0;
+	ParticipantsWithInputThisFrame = 0;
+	++InputFrameNumber;
+}
+
+void FMixerInteractivityModule_WithSessionState::TickInputSampling()
+{
+	const UMixerInteractivitySettings* Settings = GetDefault<UMixerInteractivitySettings>();
+	const int32 Arrivals = InputSampler.ConsumeArrivals();
+	SmoothedInputArrivals += (Arrivals - SmoothedInputArrivals) * 0.2f;
+	if (!Settings->bSampleInputUnderLoad)
+	{
+		InputSampler.SetStride(1);
+		return;
+	}
+
+	float Rate = SmoothedInputArrivals > 0.0f ? Settings->InputSamplingTargetPerFrame / SmoothedInputArrivals : 1.0f;
+
+	// Events still queued from earlier frames mean even the target is more than the budget allows
+	Rate /= 1 + FMixerFrameScheduler::Get().GetFramesDeferred(EMixerFrameWorkSource::InteractiveEvents);
+
+	Rate = FMath::Clamp(Rate, FMath::Clamp(Settings->InputSamplingMinRate, KINDA_SMALL_NUMBER, 1.0f), 1.0f);
+	InputSampler.SetStride(FMath::Max(1, FMath::RoundToInt(1.0f / Rate)));
+}
+
+bool FMixerInteractivityModule_WithSessionState::GetInputSamplingState(FMixerInputSamplingState& OutState)
+{
+	OutState.Stride = InputSampler.GetStride();
+	OutState.ArrivalsPerFrame = SmoothedInputArrivals;
+	return true;
+}
+
+bool FMixerInteractivityModule_WithSessionState::AdmitButtonInput(const FMixerRemoteUser* Participant, FName ButtonId, bool bPressed, bool bCharged)
+{
+	if (bPressed)
+	{
+		const bool bAdmitted = AdmitParticipantInput(Participant, EMixerInputRateClass::Button, bCharged);
+		FParticipantInputAllowance* Allowance = Participant != nullptr ? ParticipantInputAllowances.Find(Participant->Id) : nullptr;
+		if (Allowance != nullptr)
+		{
+			if (bAdmitted)
+			{
+				Allowance->DroppedButtonPresses.Remove(ButtonId);
+			}
+			else
+			{
+				Allowance->DroppedButtonPresses.Add(ButtonId);
+			}
+		}
+		return bAdmitted;
+	}
+
+	FParticipantInputAllowance* Allowance = Participant != nullptr ? ParticipantInputAllowances.Find(Participant->Id) : nullptr;
+	if (Allowance != nullptr && Allowance->DroppedButtonPresses.Remove(ButtonId) > 0)
+	{
+		INC_DWORD_STAT(STAT_MixerButtonInput);
+		INC_DWORD_STAT(STAT_MixerInputDroppedTotal);
+		MIXER_CSV_COUNT(InputDropped, 1);
+		return false;
+	}
+
+	// Releases are otherwise never dropped, so held state can't get stuck
+	return AdmitParticipantInput(Participant, EMixerInputRateClass::Button, true);
+}
+
+bool FMixerInteractivityModule_WithSessionState::AdmitParticipantInput(const FMixerRemoteUser* Participant, EMixerInputRateClass RateClass, bool bExempt)
+{
+	switch (RateClass)
+	{
+	case EMixerInputRateClass::Button:			INC_DWORD_STAT(STAT_MixerButtonInput); break;
+	case EMixerInputRateClass::Stick:			INC_DWORD_STAT(STAT_MixerStickInput); break;
+	case EMixerInputRateClass::Textbox:			INC_DWORD_STAT(STAT_MixerTextboxInput); break;
+	default:									INC_DWORD_STAT(STAT_MixerCustomInput); break;
+	}
+
+	static_assert(static_cast<int32>(EMixerInputRateClass::Count) == static_cast<int32>(EMixerInputLatencyClass::Count), "Input rate and latency classes should map one to one");
+	const EMixerInputLatencyClass LatencyClass = static_cast<EMixerInputLatencyClass>(RateClass);
+
+	const FInputRateLimitCached& Limit = InputRateLimits[static_cast<int32>(RateClass)];
+	if (Participant == nullptr || (!Limit.bEnabled && MaxInputEventsPerFrame <= 0))
+	{
+		RecordInputLatency(LatencyClass, InputArrivalTime);
+		MIXER_CSV_COUNT(InputDispatched, 1);
+		return true;
+	}
+
+	const double TimeNow = FPlatformTime::Seconds();
+	FParticipantInputAllowance* Allowance = ParticipantInputAllowances.Find(Participant->Id);
+	if (Allowance == nullptr)
+	{
+		Allowance = &ParticipantInputAllowances.Add(Participant->Id);
+		for (int32 i = 0; i < static_cast<int32>(EMixerInputRateClass::Count); ++i)
+		{
+			Allowance->Tokens[i] = InputRateLimits[i].Burst;
+			Allowance->LastRefillTime[i] = TimeNow;
+		}
+		Allowance->FrameNumber = 0;
+		Allowance->EventsThisFrame = 0;
+	}
+
+	if (Allowance->FrameNumber != InputFrameNumber)
+	{
+		Allowance->FrameNumber = InputFrameNumber;
+		Allowance->EventsThisFrame = 0;
+		++ParticipantsWithInputThisFrame;
+	}
+
+	// Over the frame budget, only participants still below an even share get through
+	if (!bExempt && MaxInputEventsPerFrame > 0 && InputEventsThisFrame >= MaxInputEventsPerFrame && Allowance->EventsThisFrame >= FairInputShare)
+	{
+		INC_DWORD_STAT(STAT_MixerInputBudgetDropped);
+		INC_DWORD_STAT(STAT_MixerInputDroppedTotal);
+		MIXER_CSV_COUNT(InputDropped, 1);
+		return false;
+	}
+
+	if (Limit.bEnabled)
+	{
+		const int32 ClassIndex = static_cast<int32>(RateClass);
+		float& Tokens = Allowance->Tokens[ClassIndex];
+		Tokens = FMath::Min(Limit.Burst, Tokens + static_cast<float>(TimeNow - Allowance->LastRefillTime[ClassIndex]) * Limit.EventsPerSecond);
+		Allowance->LastRefillTime[ClassIndex] = TimeNow;
+		if (Tokens < 1.0f && !bExempt)
+		{
+			switch (RateClass)
+			{
+			case EMixerInputRateClass::Button:			INC_DWORD_STAT(STAT_MixerButtonInputRateDropped); break;
+			case EMixerInputRateClass::Stick:			INC_DWORD_STAT(STAT_MixerStickInputRateDropped); break;
+			case EMixerInputRateClass::Textbox:			INC_DWORD_STAT(STAT_MixerTextboxInputRateDropped); break;
+			default:									INC_DWORD_STAT(STAT_MixerCustomInputRateDropped); break;
+			}
+			INC_DWORD_STAT(STAT_MixerInputDroppedTotal);
+			MIXER_CSV_COUNT(InputDropped, 1);
+			return false;
+		}
+		Tokens = FMath::Max(0.0f, Tokens - 1.0f);
+	}
+
+	++Allowance->EventsThisFrame;
+	++InputEventsThisFrame;
+	RecordInputLatency(LatencyClass, InputArrivalTime);
+	MIXER_CSV_COUNT(InputDispatched, 1);
+	return true;
+}
+
+FMixerInputEvent& FMixerInteractivityModule_WithSessionState::AddBatchedInput(EMixerInputEventKind Kind, FName ControlId, int32 ControlIndex, const FMixerRemoteUser* Participant)
+{
+	FMixerInputEvent& Event = BatchedInput[BatchedInput.AddUninitialized()];
+	BatchedInputGroups.Add(Participant != nullptr && !Participant->Group.IsNone() ? Participant->Group : NAME_DefaultMixerParticipantGroup);
+	Event.ControlId = ControlId;
+	Event.Control.Index = ControlIndex;
+	Event.Control.Generation = ControlIndex != INDEX_NONE ? ControlGeneration : 0;
+	if (Participant != nullptr)
+	{
+		const int32* Slot = ParticipantSlots.Find(Participant->Id);
+		Event.ParticipantId = Participant->Id;
+		Event.ParticipantSlot = Slot != nullptr ? *Slot : INDEX_NONE;
+	}
+	else
+	{
+		Event.ParticipantId = 0;
+		Event.ParticipantSlot = INDEX_NONE;
+	}
+	Event.Timestamp = FPlatformTime::Seconds();
+	Event.Kind = Kind;
+	return Event;
+}
+
+int32 FMixerInteractivityModule_WithSessionState::AddBatchedInputString(const FString& String)
+{
+	return String.IsEmpty() ? INDEX_NONE : BatchedInputStrings.Add(String);
+}
+
+void FMixerInteractivityModule_WithSessionState::RecordButtonInput(FName ControlId, const FMixerRemoteUser* Participant, const FMixerButtonEventDetails& Details)
+{
+	if (IsRecordingInputBatch())
+	{
+		FMixerInputEvent& Event = AddBatchedInput(Details.Pressed ? EMixerInputEventKind::ButtonDown : EMixerInputEventKind::ButtonUp, ControlId, Buttons.Find(ControlId), Participant);
+		Event.Button.SparkCost = Details.SparkCost;
+		Event.Button.TransactionIdIndex = AddBatchedInputString(Details.TransactionId);
+	}
+
+	if (Details.Pressed)
+	{
+		RecordSketchInput(ControlId, Participant);
+		RecordActivity(ControlId, 1.0f);
+		RecordVote(ControlId, Participant, Details);
+	}
+}
+
+void FMixerInteractivityModule_WithSessionState::RecordStickInput(FName ControlId, const FMixerRemoteUser* Participant, FVector2D Value)
+{
+	if (IsRecordingInputBatch())
+	{
+		FMixerInputEvent& Event = AddBatchedInput(EMixerInputEventKind::StickMove, ControlId, Sticks.Find(ControlId), Participant);
+		Event.Stick.X = Value.X;
+		Event.Stick.Y = Value.Y;
+	}
+
+	if (CoordinateHeatmaps.Num() > 0)
+	{
+		FCoordinateHeatmap* Heatmap = CoordinateHeatmaps.Find(ControlId);
+		if (Heatmap != nullptr)
+		{
+			Heatmap->PendingSamples.Add(Value);
+		}
+	}
+
+	RecordSketchInput(ControlId, Participant);
+	RecordActivity(ControlId, Value.SizeSquared());
+}
+
+void FMixerInteractivityModule_WithSessionState::RecordTextboxInput(FName ControlId, const FMixerRemoteUser* Participant, const FMixerTextboxEventDetails& Details)
+{
+	if (IsRecordingInputBatch())
+	{
+		FMixerInputEvent& Event = AddBatchedInput(EMixerInputEventKind::TextboxSubmit, ControlId, Textboxes.Find(ControlId), Participant);
+		Event.Textbox.SparkCost = Details.SparkCost;
+		Event.Textbox.TransactionIdIndex = AddBatchedInputString(Details.TransactionId);
+		Event.Textbox.TextIndex = BatchedInputStrings.Add(Details.SubmittedText.ToString());
+	}
+
+	RecordSketchInput(ControlId, Participant);
+	RecordActivity(ControlId, 1.0f);
+}
+
+void FMixerInteractivityModule_WithSessionState::RecordCustomControlInput(FName ControlId, const FMixerRemoteUser* Participant, const FJsonObject& Input)
+{
+	RecordSketchInput(ControlId, Participant);
+	RecordActivity(ControlId, 1.0f);
+
+	if (CoordinateHeatmaps.Num() > 0)
+	{
+		FCoordinateHeatmap* Heatmap = CoordinateHeatmaps.Find(ControlId);
+		double X, Y;
+		if (Heatmap != nullptr && Input.TryGetNumberField(MixerStringConstants::FieldNames::X, X) && Input.TryGetNumberField(MixerStringConstants::FieldNames::Y, Y))
+		{
+			Heatmap->PendingSamples.Add(FVector2D(static_cast<float>(X), static_cast<float>(Y)));
+		}
+	}
+}
+
+void FMixerInteractivityModule_WithSessionState::FlushInputBatch()
+{
+	if (BatchedInput.Num() > 0)
+	{
+		if (InputJournal.IsAllocated())
+		{
+			InputJournal.Append(BatchedInput);
+		}
+
+		// Handed over as views, so listeners must not hold on to them.  Reset keeps the allocations for the next tick.
+		{
+			MIXER_ALLOCATION_SCOPE(Broadcast);
+			if (OnGroupInputBatch().IsBound())
+			{
+				PublishGroupInputBatch();
+			}
+			OnInputBatch().Broadcast(BatchedInput, BatchedInputStrings);
+		}
+		BatchedInput.Reset();
+		BatchedInputStrings.Reset();
+		BatchedInputGroups.Reset();
+	}
+}
+
+void FMixerInteractivityModule_WithSessionState::PublishGroupInputBatch()
+{
+	check(BatchedInputGroups.Num() == BatchedInput.Num());
+	const int32 NumInput = BatchedInput.Num();
+
+	// Counting sort by group, so that each group's input stays in arrival order and is contiguous
+	TMap<FName, int32, TInlineSetAllocator<16>> GroupIndices;
+	TArray<int32, TInlineAllocator<16>> GroupStarts;
+	GroupInputBatches.Reset();
+	GroupIndexOfInput.SetNumUninitialized(NumInput, false);
+	for (int32 InputIndex = 0; InputIndex < NumInput; ++InputIndex)
+	{
+		const FName Group = BatchedInputGroups[InputIndex];
+		int32* ExistingIndex = GroupIndices.Find(Group);
+		int32 GroupIndex;
+		if (ExistingIndex != nullptr)
+		{
+			GroupIndex = *ExistingIndex;
+		}
+		else
+		{
+			GroupIndex = GroupInputBatches.AddDefaulted();
+			GroupInputBatches[GroupIndex].Group = Group;
+			GroupIndices.Add(Group, GroupIndex);
+			GroupStarts.Add(0);
+		}
+		GroupIndexOfInput[InputIndex] = GroupIndex;
+		++GroupStarts[GroupIndex];
+	}
+
+	const int32 NumGroups = GroupInputBatches.Num();
+	int32 NextStart = 0;
+	for (int32 GroupIndex = 0; GroupIndex < NumGroups; ++GroupIndex)
+	{
+		const int32 Count = GroupStarts[GroupIndex];
+		GroupStarts[GroupIndex] = NextStart;
+		NextStart += Count;
+	}
+
+	TArray<int32, TInlineAllocator<16>> GroupEnds = GroupStarts;
+	GroupedInput.SetNumUninitialized(NumInput, false);
+	for (int32 InputIndex = 0; InputIndex < NumInput; ++InputIndex)
+	{
+		GroupedInput[GroupEnds[GroupIndexOfInput[InputIndex]]++] = BatchedInput[InputIndex];
+	}
+
+	for (int32 GroupIndex = 0; GroupIndex < NumGroups; ++GroupIndex)
+	{
+		GroupInputBatches[GroupIndex].Events = TArrayView<const FMixerInputEvent>(GroupedInput.GetData() + GroupStarts[GroupIndex], GroupEnds[GroupIndex] - GroupStarts[GroupIndex]);
+	}
+
+	// Groups share nothing, so each can be summarized on its own worker.  Sized up front so the tasks never reallocate it.
+	if (GroupControlSummaries.Num() < NumGroups)
+	{
+		GroupControlSummaries.SetNum(NumGroups);
+	}
+
+	{
+		SCOPE_CYCLE_COUNTER(STAT_MixerSummarizeGroupInput);
+		const bool bSingleThreaded = NumGroups < 2 || NumInput < MinInputForParallelGroupSummary;
+		ParallelFor(NumGroups, [this](int32 GroupIndex)
+		{
+			SummarizeGroupInput(GroupInputBatches[GroupIndex].Events, GroupControlSummaries[GroupIndex]);
+		}, bSingleThreaded);
+	}
+
+	for (int32 GroupIndex = 0; GroupIndex < NumGroups; ++GroupIndex)
+	{
+		GroupInputBatches[GroupIndex].Controls = GroupControlSummaries[GroupIndex];
+	}
+
+	OnGroupInputBatch().Broadcast(GroupInputBatches, BatchedInputStrings);
+}
+
+void FMixerInteractivityModule_WithSessionState::SummarizeGroupInput(TArrayView<const FMixerInputEvent> Events, TArray<FMixerGroupControlSummary>& OutControls)
+{
+	struct FParticipantControlInput
+	{
+		FVector2D LastStick;
+		bool bPressed;
+		bool bMoved;
+
+		FParticipantControlInput()
+			: LastStick(0, 0)
+			, bPressed(false)
+			, bMoved(false)
+		{
+		}
+	};
+
+	OutControls.Reset();
+	TMap<FName, int32, TInlineSetAllocator<16>> ControlIndices;
+	// Keyed by control index in the high word and participant id in the low
+	TMap<uint64, FParticipantControlInput> ParticipantInput;
+
+	for (const FMixerInputEvent& Event : Events)
+	{
+		int32 ControlIndex;
+		if (const int32* ExistingIndex = ControlIndices.Find(Event.ControlId))
+		{
+			ControlIndex = *ExistingIndex;
+		}
+		else
+		{
+			ControlIndex = OutControls.AddDefaulted();
+			OutControls[ControlIndex].ControlId = Event.ControlId;
+			OutControls[ControlIndex].Control = Event.Control;
+			ControlIndices.Add(Event.ControlId, ControlIndex);
+		}
+
+		FMixerGroupControlSummary& Summary = OutControls[ControlIndex];
+		const uint64 ParticipantKey = (static_cast<uint64>(ControlIndex) << 32) | Event.ParticipantId;
+		switch (Event.Kind)
+		{
+		case EMixerInputEventKind::ButtonDown:
+			++Summary.DownCount;
+			Summary.SparkCost += Event.Button.SparkCost;
+			if (Event.ParticipantId != 0)
+			{
+				FParticipantControlInput& Input = ParticipantInput.FindOrAdd(ParticipantKey);
+				if (!Input.bPressed)
+				{
+					Input.bPressed = true;
+					++Summary.Voters;
+				}
+			}
+			break;
+
+		case EMixerInputEventKind::ButtonUp:
+			++Summary.UpCount;
+			break;
+
+		case EMixerInputEventKind::StickMove:
+			if (Event.ParticipantId != 0)
+			{
+				FParticipantControlInput& Input = ParticipantInput.FindOrAdd(ParticipantKey);
+				if (!Input.bMoved)
+				{
+					Input.bMoved = true;
+					++Summary.StickParticipants;
+				}
+				Input.LastStick = FVector2D(Event.Stick.X, Event.Stick.Y);
+			}
+			break;
+
+		case EMixerInputEventKind::TextboxSubmit:
+			++Summary.Submissions;
+			Summary.SparkCost += Event.Textbox.SparkCost;
+			break;
+
+		default:
+			break;
+		}
+	}
+
+	for (const TPair<uint64, FParticipantControlInput>& Input : ParticipantInput)
+	{
+		if (Input.Value.bMoved)
+		{
+			OutControls[static_cast<int32>(Input.Key >> 32)].StickMean += Input.Value.LastStick;
+		}
+	}
+
+	for (FMixerGroupControlSummary& Summary : OutControls)
+	{
+		if (Summary.StickParticipants > 0)
+		{
+			Summary.StickMean /= static_cast<float>(Summary.StickParticipants);
+		}
+	}
+}
+
+void FMixerRemoteUserPool::Reserve(int32 InCapacity)
+{
+	Capacity = FMath::Max(Capacity, InCapacity);
+	Free.Reserve(Capacity);
+	for (int32 i = Free.Num(); i < Capacity; ++i)
+	{
+		Free.Add(MakeShared<FMixerRemoteUser>());
+	}
+}
+
+TSharedPtr<FMixerRemoteUser> FMixerRemoteUserPool::Acquire()
+{
+	if (Free.Num() == 0)
+	{
+		return MakeShared<FMixerRemoteUser>();
+	}
+
+	// Free records have never been handed out, so nothing else can be referencing them
+	return Free.Pop(false);
+}
+
+
+uint32 FMixerInputSampler::Sample(FName ControlId, bool bExempt)
+{
+	Arrivals.Increment();
+	const int32 CurrentStride = Stride.GetValue();
+	if (bExempt || CurrentStride <= 1)
+	{
+		return 1;
+	}
+
+	// Each event is kept with the same chance, so input that arrives in a regular rhythm can't line up with
+	// the stride.  The kept event still carries an exact count of the ones skipped since the last.
+	uint32& Skipped = SkippedByControl.FindOrAdd(ControlId);
+	++Skipped;
+	if (RandomStream.RandHelper(CurrentStride) != 0)
+	{
+		INC_DWORD_STAT(STAT_MixerInputSampledOut);
+		MIXER_CSV_COUNT(InputDropped, 1);
+		return 0;
+	}
+
+	const uint32 Weight = Skipped;
+	Skipped = 0;
+	return Weight;
+}
+
+uint32 FMixerInputSampler::SampleButton(FName ControlId, const FGuid& ParticipantSessionGuid, bool bPressed, bool bExempt)
+{
+	const TPair<FName, FGuid> Key(ControlId, ParticipantSessionGuid);
+	if (!bPressed)
+	{
+		// A release whose press was skipped is skipped with it, rather than reaching the game unpaired
+		Arrivals.Increment();
+		return SkippedPresses.Remove(Key) > 0 ? 0 : 1;
+	}
+
+	const uint32 Weight = Sample(ControlId, bExempt);
+	if (Weight == 0)
+	{
+		SkippedPresses.Add(Key);
+	}
+	else
+	{
+		SkippedPresses.Remove(Key);
+	}
+	return Weight;
+}
+
+void FMixerInputSampler::SetStride(int32 InStride)
+{
+	Stride.Set(FMath::Max(1, InStride));
+}
+
+bool FMixerInputFilter::Rejects(FName ControlId) const
+{
+	if (NumRejected.GetValue() == 0 || !IsCurrent())
+	{
+		return false;
+	}
+
+	FScopeLock ScopeLock(&Lock);
+	if (RejectedControls.Contains(ControlId))
+	{
+		INC_DWORD_STAT(STAT_MixerInputInactiveDropped);
+		MIXER_CSV_COUNT(InputDropped, 1);
+		return true;
+	}
+	return false;
+}
+
+void FMixerInputFilter::FinishRebuild(TSet<FName>&& Controls, int32 RebuildGeneration)
+{
+	FScopeLock ScopeLock(&Lock);
+	RejectedControls = MoveTemp(Controls);
+	NumRejected.Set(RejectedControls.Num());
+	BuiltGeneration.Set(RebuildGeneration);
+}
+
+void FMixerInputJournal::Allocate(int32 InCapacity)
+{
+	check(IsInGameThread());
+	if (IsAllocated())
+	{
+		return;
+	}
+
+	const int32 Capacity = FMath::RoundUpToPowerOfTwo(FMath::Max(InCapacity, 2));
+	Slots.SetNumZeroed(Capacity);
+	for (FSlot& Slot : Slots)
+	{
+		Slot.Sequence = -1;
+	}
+	Mask = Capacity - 1;
+
+	// Readers only look at the slots once this is set
+	FPlatformMisc::MemoryBarrier();
+	FPlatformAtomics::InterlockedExchange(&bAllocated, 1);
+}
+
+void FMixerInputJournal::Append(TArrayView<const FMixerInputEvent> Events)
+{
+	// Only this thread writes Published, so it needn't be read atomically here
+	int64 Sequence = Published;
+	for (const FMixerInputEvent& Event : Events)
+	{
+		FSlot& Slot = Slots[Sequence & Mask];
+		FPlatformAtomics::InterlockedExchange(&Slot.Sequence, -1);
+
+		Slot.Event = Event;
+		switch (Event.Kind)
+		{
+		case EMixerInputEventKind::ButtonDown:
+		case EMixerInputEventKind::ButtonUp:
+			Slot.Event.Button.TransactionIdIndex = INDEX_NONE;
+			break;
+		case EMixerInputEventKind::TextboxSubmit:
+			Slot.Event.Textbox.TransactionIdIndex = INDEX_NONE;
+			Slot.Event.Textbox.TextIndex = INDEX_NONE;
+			break;
+		default:
+			break;
+		}
+
+		FPlatformMisc::MemoryBarrier();
+		FPlatformAtomics::InterlockedExchange(&Slot.Sequence, Sequence);
+		++Sequence;
+	}
+	FPlatformAtomics::InterlockedExchange(&Published, Sequence);
+}
+
+bool FMixerInputJournal::TryCopy(int64 Sequence, FMixerInputEvent& OutEvent) const
+{
+	const FSlot& Slot = Slots[Sequence & Mask];
+	if (FPlatformAtomics::InterlockedCompareExchange(const_cast<volatile int64*>(&Slot.Sequence), 0, 0) != Sequence)
+	{
+		return false;
+	}
+
+	// May race with the writer; the second check discards the copy if it did
+	FMemory::Memcpy(&OutEvent, &Slot.Event, sizeof(FMixerInputEvent));
+	FPlatformMisc::MemoryBarrier();
+	return FPlatformAtomics::InterlockedCompareExchange(const_cast<volatile int64*>(&Slot.Sequence), 0, 0) == Sequence;
+}
+
+FMixerInputJournalCursor FMixerInputJournal::OpenCursor(double RewindSeconds) const
+{
+	FMixerInputJournalCursor Cursor;
+	if (!IsAllocated())
+	{
+		return Cursor;
+	}
+
+	const int64 Head = GetPublished();
+	Cursor.NextSequence = Head;
+	if (RewindSeconds > 0.0)
+	{
+		// Timestamps never decrease along the ring, so the first event recent enough can be searched for.
+		// Events overwritten during the search count as too old.
+		const double Since = FPlatformTime::Seconds() - RewindSeconds;
+		int64 Low = FMath::Max<int64>(GetSessionStart(), Head - (Mask + 1));
+		int64 High = Head;
+		while (Low < High)
+		{
+			const int64 Mid = Low + (High - Low) / 2;
+			FMixerInputEvent Event;
+			if (!TryCopy(Mid, Event) || Event.Timestamp < Since)
+			{
+				Low = Mid + 1;
+			}
+			else
+			{
+				High = Mid;
+			}
+		}
+		Cursor.NextSequence = Low;
+	}
+	return Cursor;
+}
+
+int32 FMixerInputJournal::Read(FMixerInputJournalCursor& Cursor, TArray<FMixerInputEvent>& OutEvents, int32 MaxEvents) const
+{
+	if (!IsAllocated())
+	{
+		return 0;
+	}
+
+	// Input from before the current session was dropped rather than missed
+	Cursor.NextSequence = FMath::Max(Cursor.NextSequence, GetSessionStart());
+
+	int64 Head = GetPublished();
+	const int64 Capacity = Mask + 1;
+	int32 NumRead = 0;
+	while (Cursor.NextSequence < Head && NumRead < MaxEvents)
+	{
+		const int64 Oldest = Head - Capacity;
+		if (Cursor.NextSequence < Oldest)
+		{
+			Cursor.MissedEvents += Oldest - Cursor.NextSequence;
+			Cursor.NextSequence = Oldest;
+		}
+
+		FMixerInputEvent Event;
+		if (TryCopy(Cursor.NextSequence, Event))
+		{
+			OutEvents.Add(Event);
+			++NumRead;
+		}
+		else
+		{
+			// Lapped by the writer mid-read.  Catch up with how far it has got.
+			++Cursor.MissedEvents;
+			Head = GetPublished();
+		}
+		++Cursor.NextSequence;
+	}
+	return NumRead;
+}
+
+void FMixerParticipantOrder::Add(uint32 ParticipantId, int64 Key)
+{
+	if (KeysByParticipant.Contains(ParticipantId))
+	{
+		Update(ParticipantId, Key);
+		return;
+	}
+	KeysByParticipant.Add(ParticipantId, Key);
+
+	const FEntry Entry = { Key, ParticipantId };
+	if (Blocks.Num() == 0)
+	{
+		Blocks.AddDefaulted();
+	}
+	const int32 BlockIndex = FindBlock(Entry);
+	TArray<FEntry>& Block = Blocks[BlockIndex];
+	Block.Insert(Entry, LowerBound(Block, Entry));
+
+	if (Block.Num() > MaxParticipantOrderBlockSize)
+	{
+		const int32 Half = Block.Num() / 2;
+		TArray<FEntry> UpperHalf;
+		UpperHalf.Append(Block.GetData() + Half, Block.Num() - Half);
+		Block.RemoveAt(Half, Block.Num() - Half, false);
+		Blocks.Insert(MoveTemp(UpperHalf), BlockIndex + 1);
+	}
+}
+
+void FMixerParticipantOrder::Remove(uint32 ParticipantId)
+{
+	int64 Key;
+	if (!KeysByParticipant.RemoveAndCopyValue(ParticipantId, Key))
+	{
+		return;
+	}
+
+	const FEntry Entry = { Key, ParticipantId };
+	const int32 BlockIndex = FindBlock(Entry);
+	TArray<FEntry>& Block = Blocks[BlockIndex];
+	const int32 EntryIndex = LowerBound(Block, Entry);
+	check(Block.IsValidIndex(EntryIndex) && Block[EntryIndex].ParticipantId == ParticipantId);
+	Block.RemoveAt(EntryIndex, 1, false);
+
+	if (Block.Num() == 0)
+	{
+		Blocks.RemoveAt(BlockIndex);
+	}
+	else if (Block.Num() < MaxParticipantOrderBlockSize / 4
+		&& Blocks.IsValidIndex(BlockIndex + 1)
+		&& Block.Num() + Blocks[BlockIndex + 1].Num() <= MaxParticipantOrderBlockSize)
+	{
+		// Keep blocks from thinning out, since finding a page walks them
+		Block.Append(Blocks[BlockIndex + 1]);
+		Blocks.RemoveAt(BlockIndex + 1);
+	}
+}
+
+void FMixerParticipantOrder::Update(uint32 ParticipantId, int64 Key)
+{
+	const int64* ExistingKey = KeysByParticipant.Find(ParticipantId);
+	if (ExistingKey != nullptr && *ExistingKey != Key)
+	{
+		Remove(ParticipantId);
+		Add(ParticipantId, Key);
+	}
+}
+
+void FMixerParticipantOrder::ForEachInPage(int32 Offset, int32 Count, bool bDescending, TFunctionRef<void(uint32)> Visitor) const
+{
+	Offset = FMath::Max(Offset, 0);
+	Count = FMath::Min(Count, Num() - Offset);
+	if (Count <= 0)
+	{
+		return;
+	}
+
+	if (bDescending)
+	{
+		int32 BlockIndex = Blocks.Num() - 1;
+		while (Offset >= Blocks[BlockIndex].Num())
+		{
+			Offset -= Blocks[BlockIndex].Num();
+			--BlockIndex;
+		}
+
+		int32 EntryIndex = Blocks[BlockIndex].Num() - 1 - Offset;
+		for (int32 Visited = 0; Visited < Count; ++Visited)
+		{
+			if (EntryIndex < 0)
+			{
+				--BlockIndex;
+				EntryIndex = Blocks[BlockIndex].Num() - 1;
+			}
+			Visitor(Blocks[BlockIndex][EntryIndex--].ParticipantId);
+		}
+	}
+	else
+	{
+		int32 BlockIndex = 0;
+		while (Offset >= Blocks[BlockIndex].Num())
+		{
+			Offset -= Blocks[BlockIndex].Num();
+			++BlockIndex;
+		}
+
+		int32 EntryIndex = Offset;
+		for (int32 Visited = 0; Visited < Count; ++Visited)
+		{
+			if (EntryIndex == Blocks[BlockIndex].Num())
+			{
+				++BlockIndex;
+				EntryIndex = 0;
+			}
+			Visitor(Blocks[BlockIndex][EntryIndex++].ParticipantId);
+		}
+	}
 }
 
-void FMixerInteractivityModule_WithSessionState::AddStick(FName ControlId, const FMixerStickPropertiesCached& Props)
+int32 FMixerParticipantOrder::FindBlock(const FEntry& Entry) const
 {
-	Sticks.Add(ControlId, Props);
+	// First block whose last entry isn't before Entry, or the last block if all of them are
+	int32 Low = 0;
+	int32 High = Blocks.Num() - 1;
+	while (Low < High)
+	{
+		const int32 Mid = (Low + High) / 2;
+		if (Blocks[Mid].Last() < Entry)
+		{
+			Low = Mid + 1;
+		}
+		else
+		{
+			High = Mid;
+		}
+	}
+	return Low;
 }
 
-FMixerStickPropertiesCached* FMixerInteractivityModule_WithSessionState::GetStick(FName ControlId)
+int32 FMixerParticipantOrder::LowerBound(const TArray<FEntry>& Block, const FEntry& Entry)
 {
-	return Sticks.Find(ControlId);
+	int32 Low = 0;
+	int32 High = Block.Num();
+	while (Low < High)
+	{
+		const int32 Mid = (Low + High) / 2;
+		if (Block[Mid] < Entry)
+		{
+			Low = Mid + 1;
+		}
+		else
+		{
+			High = Mid;
+		}
+	}
+	return Low;
 }
 
-void FMixerInteractivityModule_WithSessionState::AddLabel(FName ControlId, const FMixerLabelPropertiesCached& Props)
+int32 FMixerInteractivityModule_WithSessionState::AssignParticipantSlot(uint32 ParticipantId)
 {
-	Labels.Add(ControlId, Props);
+	MIXER_LLM_SCOPE(Participants);
+	const int32* ExistingSlot = ParticipantSlots.Find(ParticipantId);
+	if (ExistingSlot != nullptr)
+	{
+		return *ExistingSlot;
+	}
+
+	const int32 Slot = FreeParticipantSlots.Num() > 0 ? FreeParticipantSlots.Pop(false) : NumParticipantSlots++;
+	ParticipantSlots.Add(ParticipantId, Slot);
+	return Slot;
 }
 
-FMixerLabelPropertiesCached* FMixerInteractivityModule_WithSessionState::GetLabel(FName ControlId)
+void FMixerInteractivityModule_WithSessionState::ReleaseParticipantSlot(uint32 ParticipantId)
 {
-	return Labels.Find(ControlId);
+	// Out of the group totals first, while the slot can still be found
+	SetParticipantGroupTotals(ParticipantId, NAME_None);
+
+	int32 Slot;
+	if (!ParticipantSlots.RemoveAndCopyValue(ParticipantId, Slot))
+	{
+		return;
+	}
+
+	// Whoever gets this slot next must not inherit the departed participant's holds
+	const int32 PreviouslyHeldSlots = NumHeldButtonSlots;
+	for (int32 ButtonIndex = 0; ButtonIndex < Buttons.Num(); ++ButtonIndex)
+	{
+		if (Buttons.IsReservedSlot(ButtonIndex))
+		{
+			continue;
+		}
+
+		TBitArray<>& HoldingSlots = Buttons.Properties[ButtonIndex].HoldingParticipantSlots;
+		if (Slot < HoldingSlots.Num() && HoldingSlots[Slot])
+		{
+			HoldingSlots[Slot] = false;
+			Buttons.States[ButtonIndex].PressCount -= 1;
+			--NumHeldButtonSlots;
+		}
+	}
+
+	if (NumHeldButtonSlots == 0 && NumHeldButtonSlots != PreviouslyHeldSlots && !bPerParticipantState)
+	{
+		ReleaseHoldingParticipantSlots();
+	}
+
+	// Likewise a departed participant no longer steers any sticks
+	for (int32 StickIndex = 0; StickIndex < Sticks.Num(); ++StickIndex)
+	{
+		if (Sticks.IsReservedSlot(StickIndex))
+		{
+			continue;
+		}
+
+		const int32* ValueIndex = Sticks.Properties[StickIndex].ValueIndexByParticipant.Find(ParticipantId);
+		if (ValueIndex != nullptr)
+		{
+			RemoveStickValue(StickIndex, *ValueIndex);
+			UpdateStickAxes(StickIndex);
+		}
+	}
+
+	FreeParticipantSlots.Add(Slot);
 }
 
-void FMixerInteractivityModule_WithSessionState::AddTextbox(FName ControlId, const FMixerTextboxPropertiesCached& Props)
+TSharedPtr<FMixerRemoteUser> FMixerInteractivityModule_WithSessionState::GetCachedUser(uint32 ParticipantId)
+{
+	TSharedPtr<FMixerRemoteUser>* User = RemoteParticipantCacheByUint.Find(ParticipantId);
+	return User != nullptr ? *User : nullptr;
+}
+
+TSharedPtr<FMixerRemoteUser> FMixerInteractivityModule_WithSessionState::GetCachedUser(FGuid ParticipantSessionId)
 {
-	Textboxes.Add(ControlId, Props);
+	TSharedPtr<FMixerRemoteUser>* User = RemoteParticipantCacheByGuid.Find(ParticipantSessionId);
+	return User != nullptr ? *User : nullptr;
 }
 
-FMixerTextboxPropertiesCached* FMixerInteractivityModule_WithSessionState::GetTextbox(FName ControlId)
+namespace
 {
-	return Textboxes.Find(ControlId);
+	template <class CharType>
+	bool DecodeHyphenatedGuid(const CharType* Chars, FGuid& OutGuid)
+	{
+		// 8-4-4-4-12 layout, read into A/B/C/D in order just as FGuid::ParseExact does after removing the hyphens
+		uint32 Components[4] = { 0, 0, 0, 0 };
+		int32 Digit = 0;
+		for (int32 i = 0; i < 36; ++i)
+		{
+			const CharType Char = Chars[i];
+			if (i == 8 || i == 13 || i == 18 || i == 23)
+			{
+				if (Char != '-')
+				{
+					return false;
+				}
+				continue;
+			}
+
+			uint32 Nibble;
+			if (Char >= '0' && Char <= '9')
+			{
+				Nibble = Char - '0';
+			}
+			else if ((Char | 0x20) >= 'a' && (Char | 0x20) <= 'f')
+			{
+				Nibble = (Char | 0x20) - 'a' + 10;
+			}
+			else
+			{
+				// Includes an early terminator
+				return false;
+			}
+
+			Components[Digit >> 3] = (Components[Digit >> 3] << 4) | Nibble;
+			++Digit;
+		}
+
+		if (Chars[36] != 0)
+		{
+			return false;
+		}
+
+		OutGuid = FGuid(Components[0], Components[1], Components[2], Components[3]);
+		return true;
+	}
 }
 
-void FMixerInteractivityModule_WithSessionState::AddUser(TSharedPtr<FMixerRemoteUser> User)
+bool FMixerInteractivityModule_WithSessionState::ParseSessionId(const TCHAR* SessionIdString, FGuid& OutSessionGuid)
 {
-	RemoteParticipantCacheByGuid.Add(User->SessionGuid, User);
-	RemoteParticipantCacheByUint.Add(User->Id, User);
+	return DecodeHyphenatedGuid(SessionIdString, OutSessionGuid) || FGuid::Parse(SessionIdString, OutSessionGuid);
 }
 
-void FMixerInteractivityModule_WithSessionState::RemoveUser(TSharedPtr<FMixerRemoteUser> User)
+bool FMixerInteractivityModule_WithSessionState::ParseSessionId(const ANSICHAR* SessionIdString, FGuid& OutSessionGuid)
 {
-	RemoteParticipantCacheByGuid.Remove(User->SessionGuid);
-	RemoteParticipantCacheByUint.Remove(User->Id);
+	return DecodeHyphenatedGuid(SessionIdString, OutSessionGuid) || FGuid::Parse(ANSI_TO_TCHAR(SessionIdString), OutSessionGuid);
 }
 
-void FMixerInteractivityModule_WithSessionState::RemoveUser(FGuid ParticipantSessionId)
+bool FMixerInteractivityModule_WithSessionState::FindCachedUserBySessionId(const TCHAR* SessionIdString, TSharedPtr<FMixerRemoteUser>& OutUser)
 {
-	TSharedPtr<FMixerRemoteUser> RemovedUser = RemoteParticipantCacheByGuid.FindAndRemoveChecked(ParticipantSessionId);
-	RemoteParticipantCacheByUint.Remove(RemovedUser->Id);
+	FGuid SessionGuid;
+	if (!ParseSessionId(SessionIdString, SessionGuid))
+	{
+		return false;
+	}
+
+	OutUser = GetCachedUser(SessionGuid);
+	return true;
 }
 
-TSharedPtr<FMixerRemoteUser> FMixerInteractivityModule_WithSessionState::GetCachedUser(uint32 ParticipantId)
+bool FMixerInteractivityModule_WithSessionState::FindCachedUserBySessionId(const ANSICHAR* SessionIdString, TSharedPtr<FMixerRemoteUser>& OutUser)
 {
-	TSharedPtr<FMixerRemoteUser>* User = RemoteParticipantCacheByUint.Find(ParticipantId);
-	return User != nullptr ? *User : nullptr;
+	FGuid SessionGuid;
+	if (!ParseSessionId(SessionIdString, SessionGuid))
+	{
+		return false;
+	}
+
+	OutUser = GetCachedUser(SessionGuid);
+	return true;
 }
 
-TSharedPtr<FMixerRemoteUser> FMixerInteractivityModule_WithSessionState::GetCachedUser(FGuid ParticipantSessionId)
+void FMixerInteractivityModule_WithSessionState::GetCachedUsers(TArray<TSharedPtr<FMixerRemoteUser>>& OutUsers)
 {
-	TSharedPtr<FMixerRemoteUser>* User = RemoteParticipantCacheByGuid.Find(ParticipantSessionId);
-	return User != nullptr ? *User : nullptr;
+	RemoteParticipantCacheByUint.GenerateValueArray(OutUsers);
 }
 
 void FMixerInteractivityModule_WithSessionState::ReassignUsers(FName FromGroup, FName ToGroup)
 {
-	for (TMap<uint32, TSharedPtr<FMixerRemoteUser>>::TConstIterator It(RemoteParticipantCacheByUint); It; ++It)
+	TArray<TSharedPtr<const FMixerRemoteUser>> MovedMembers;
+	if (FromGroup == ToGroup || !ParticipantsByGroup.RemoveAndCopyValue(FromGroup, MovedMembers))
+	{
+		return;
+	}
+
+	for (const TSharedPtr<const FMixerRemoteUser>& Member : MovedMembers)
+	{
+		ConstCastSharedPtr<FMixerRemoteUser>(Member)->Group = ToGroup;
+		const int32* Slot = ParticipantSlots.Find(Member->Id);
+		if (Slot != nullptr)
+		{
+			ParticipantSlotGroups[*Slot] = ToGroup;
+		}
+	}
+
+	// Every member moves, so the group's control totals can follow them wholesale
+	FMixerGroupControlState MovedControlState;
+	if (ControlStateByGroup.RemoveAndCopyValue(FromGroup, MovedControlState))
+	{
+		FMixerGroupControlState* ToControlState = ControlStateByGroup.Find(ToGroup);
+		if (ToControlState != nullptr)
+		{
+			ToControlState->Append(MovedControlState);
+		}
+		else
+		{
+			ControlStateByGroup.Add(ToGroup, MoveTemp(MovedControlState));
+		}
+	}
+
+	TArray<TSharedPtr<const FMixerRemoteUser>>& ToMembers = ParticipantsByGroup.FindOrAdd(ToGroup);
+	const bool bWholesale = ToMembers.Num() == 0;
+
+	// Sort keys don't depend on the group, so orders follow their members
+	for (int32 KeyIndex = 0; KeyIndex < static_cast<int32>(EMixerParticipantSortKey::Count); ++KeyIndex)
+	{
+		TMap<FName, FMixerParticipantOrder>& Orders = ParticipantOrders[KeyIndex];
+		FMixerParticipantOrder* FromOrder = Orders.Find(FromGroup);
+		if (bWholesale)
+		{
+			if (FromOrder != nullptr)
+			{
+				FMixerParticipantOrder MovedOrder = MoveTemp(*FromOrder);
+				Orders.Remove(FromGroup);
+				Orders.Add(ToGroup, MoveTemp(MovedOrder));
+			}
+			continue;
+		}
+
+		Orders.Remove(FromGroup);
+		FMixerParticipantOrder* ToOrder = Orders.Find(ToGroup);
+		if (ToOrder != nullptr)
+		{
+			const EMixerParticipantSortKey SortKey = static_cast<EMixerParticipantSortKey>(KeyIndex);
+			for (const TSharedPtr<const FMixerRemoteUser>& Member : MovedMembers)
+			{
+				ToOrder->Add(Member->Id, GetParticipantSortValue(*Member, SortKey));
+			}
+		}
+	}
+
+	if (bWholesale)
+	{
+		// Positions are unchanged, so the whole array can simply change hands
+		ToMembers = MoveTemp(MovedMembers);
+	}
+	else
+	{
+		ToMembers.Reserve(ToMembers.Num() + MovedMembers.Num());
+		for (const TSharedPtr<const FMixerRemoteUser>& Member : MovedMembers)
+		{
+			GroupMemberIndex.Add(Member->Id, ToMembers.Add(Member));
+		}
+	}
+}
+
+void FMixerInteractivityModule_WithSessionState::SetUserGroup(const TSharedPtr<FMixerRemoteUser>& User, FName Group)
+{
+	if (User->Group == Group)
+	{
+		return;
+	}
+
+	const bool bIndexed = GroupMemberIndex.Contains(User->Id);
+	if (bIndexed)
+	{
+		RemoveFromGroupIndex(*User);
+	}
+
+	User->Group = Group;
+
+	if (bIndexed)
+	{
+		AddToGroupIndex(User);
+		SetParticipantGroupTotals(User->Id, Group);
+	}
+}
+
+void FMixerInteractivityModule_WithSessionState::SetParticipantGroupTotals(uint32 ParticipantId, FName Group)
+{
+	MIXER_LLM_SCOPE(Participants);
+	const int32* Slot = ParticipantSlots.Find(ParticipantId);
+	if (Slot == nullptr)
+	{
+		return;
+	}
+
+	if (*Slot >= ParticipantSlotGroups.Num())
+	{
+		ParticipantSlotGroups.SetNum(*Slot + 1);
+	}
+	if (ParticipantSlotGroups[*Slot] == Group)
+	{
+		return;
+	}
+
+	// Take the participant out of their old group's totals, then count them in the new one's
+	for (int32 Pass = 0; Pass < 2; ++Pass)
+	{
+		const bool bAdding = Pass == 1;
+		if (bAdding)
+		{
+			ParticipantSlotGroups[*Slot] = Group;
+			if (Group.IsNone())
+			{
+				break;
+			}
+			ControlStateByGroup.FindOrAdd(Group);
+		}
+
+		for (int32 ButtonIndex = 0; ButtonIndex < Buttons.Num(); ++ButtonIndex)
+		{
+			if (Buttons.IsReservedSlot(ButtonIndex))
+			{
+				continue;
+			}
+
+			const TBitArray<>& HoldingSlots = Buttons.Properties[ButtonIndex].HoldingParticipantSlots;
+			if (*Slot < HoldingSlots.Num() && HoldingSlots[*Slot])
+			{
+				AddGroupButtonHold(*Slot, ButtonIndex, bAdding);
+			}
+		}
+
+		for (int32 StickIndex = 0; StickIndex < Sticks.Num(); ++StickIndex)
+		{
+			if (Sticks.IsReservedSlot(StickIndex))
+			{
+				continue;
+			}
+
+			const FMixerStickPropertiesCached& StickProps = Sticks.Properties[StickIndex];
+			const int32* ValueIndex = StickProps.ValueIndexByParticipant.Find(ParticipantId);
+			if (ValueIndex != nullptr)
+			{
+				AccumulateGroupStickValue(*Slot, StickIndex, StickProps.ValuesX[*ValueIndex], StickProps.ValuesY[*ValueIndex], bAdding ? 1.0 : -1.0);
+			}
+		}
+	}
+}
+
+void FMixerInteractivityModule_WithSessionState::AddGroupButtonHold(int32 Slot, int32 ButtonIndex, bool bHeld)
+{
+	FMixerGroupControlState* GroupState = Slot < ParticipantSlotGroups.Num() ? ControlStateByGroup.Find(ParticipantSlotGroups[Slot]) : nullptr;
+	if (GroupState == nullptr)
+	{
+		return;
+	}
+
+	if (ButtonIndex >= GroupState->HeldButtonCounts.Num())
+	{
+		if (!bHeld)
+		{
+			return;
+		}
+		GroupState->HeldButtonCounts.SetNumZeroed(ButtonIndex + 1);
+	}
+
+	uint32& HeldCount = GroupState->HeldButtonCounts[ButtonIndex];
+	HeldCount = bHeld ? HeldCount + 1 : HeldCount - 1;
+}
+
+void FMixerInteractivityModule_WithSessionState::AccumulateGroupStickValue(int32 Slot, int32 StickIndex, float X, float Y, double Sign)
+{
+	FMixerGroupControlState* GroupState = Slot < ParticipantSlotGroups.Num() ? ControlStateByGroup.Find(ParticipantSlotGroups[Slot]) : nullptr;
+	if (GroupState == nullptr)
+	{
+		return;
+	}
+
+	if (StickIndex >= GroupState->StickSums.Num())
+	{
+		if (Sign < 0.0)
+		{
+			return;
+		}
+		GroupState->StickSums.SetNum(StickIndex + 1);
+	}
+
+	FMixerStickSums& Sums = GroupState->StickSums[StickIndex];
+	Sums.Accumulate(X, Y, Sign);
+	if (Sums.NumValues == 0)
+	{
+		// Nobody in the group left on the stick, so discard any rounding error
+		Sums = FMixerStickSums();
+	}
+}
+
+void FMixerInteractivityModule_WithSessionState::AddToGroupIndex(const TSharedPtr<FMixerRemoteUser>& User)
+{
+	GroupMemberIndex.Add(User->Id, ParticipantsByGroup.FindOrAdd(User->Group).Add(User));
+
+	for (int32 KeyIndex = 0; KeyIndex < static_cast<int32>(EMixerParticipantSortKey::Count); ++KeyIndex)
+	{
+		FMixerParticipantOrder* Order = ParticipantOrders[KeyIndex].Find(User->Group);
+		if (Order != nullptr)
+		{
+			Order->Add(User->Id, GetParticipantSortValue(*User, static_cast<EMixerParticipantSortKey>(KeyIndex)));
+		}
+	}
+}
+
+void FMixerInteractivityModule_WithSessionState::UpdateParticipantOrder(const FMixerRemoteUser& User)
+{
+	for (int32 KeyIndex = 0; KeyIndex < static_cast<int32>(EMixerParticipantSortKey::Count); ++KeyIndex)
+	{
+		FMixerParticipantOrder* Order = ParticipantOrders[KeyIndex].Find(User.Group);
+		if (Order != nullptr)
+		{
+			Order->Update(User.Id, GetParticipantSortValue(User, static_cast<EMixerParticipantSortKey>(KeyIndex)));
+		}
+	}
+}
+
+void FMixerInteractivityModule_WithSessionState::NoteUserInput(FMixerRemoteUser& User)
+{
+	User.InputAt = FDateTime::UtcNow();
+
+	// Input is frequent, so only the one order it affects is touched rather than going through UpdateParticipantOrder
+	FMixerParticipantOrder* Order = ParticipantOrders[static_cast<int32>(EMixerParticipantSortKey::InputAt)].Find(User.Group);
+	if (Order != nullptr)
 	{
-		if (It->Value->Group == FromGroup)
+		Order->Update(User.Id, GetParticipantSortValue(User, EMixerParticipantSortKey::InputAt));
+	}
+}
+
+void FMixerInteractivityModule_WithSessionState::RemoveFromGroupIndex(const FMixerRemoteUser& User)
+{
+	int32 MemberIndex;
+	if (!GroupMemberIndex.RemoveAndCopyValue(User.Id, MemberIndex))
+	{
+		return;
+	}
+
+	TArray<TSharedPtr<const FMixerRemoteUser>>& Members = ParticipantsByGroup.FindChecked(User.Group);
+	check(Members[MemberIndex]->Id == User.Id);
+	const int32 LastIndex = Members.Num() - 1;
+	if (MemberIndex != LastIndex)
+	{
+		GroupMemberIndex.Add(Members[LastIndex]->Id, MemberIndex);
+	}
+	Members.RemoveAtSwap(MemberIndex, 1, false);
+
+	const bool bGroupEmptied = Members.Num() == 0;
+	if (bGroupEmptied)
+	{
+		ParticipantsByGroup.Remove(User.Group);
+	}
+
+	for (TMap<FName, FMixerParticipantOrder>& Orders : ParticipantOrders)
+	{
+		if (bGroupEmptied)
+		{
+			Orders.Remove(User.Group);
+		}
+		else if (FMixerParticipantOrder* Order = Orders.Find(User.Group))
 		{
-			It->Value->Group = ToGroup;
+			Order->Remove(User.Id);
 		}
 	}
 }
\ No newline at end of file
@@ -10,20 +10,136 @@
 #pragma once
 
 #include "MixerInteractivityModulePrivate.h"
+#include "HAL/ThreadSafeCounter.h"
+#include "HAL/CriticalSection.h"
+#include "MixerInteractivityLLM.h"
+#include "MixerParticipantEnrichment.h"
 
+/**
+* Descriptive data for cached controls.  Per-frame state (FMixerButtonState, FMixerStickState) is stored
+* separately so polling many controls each frame only touches the dense state arrays.
+*/
 struct FMixerButtonPropertiesCached
 {
 	FMixerButtonDescription Desc;
-	FMixerButtonState State;
-	TSet<uint32> HoldingParticipants;
+	/** One bit per participant slot (see AssignParticipantSlot), set while that participant holds the button. */
+	TBitArray<> HoldingParticipantSlots;
 	FName SceneId;
 };
 
-struct FMixerStickPropertiesCached
+/**
+* Stored button state.  RemainingCooldown is not kept up to date here; it's derived on query from
+* CooldownEndTime so that idle buttons cost nothing per frame.
+*/
+struct FMixerButtonStateCached : public FMixerButtonState
+{
+	/** FPlatformTime::Seconds() at which the cooldown ends */
+	double CooldownEndTime;
+
+	/** Whether this button is in the list of counters to reset on the next tick */
+	bool bCountersDirty;
+};
+
+/** Running sums behind FMixerStickAggregate.  Doubles so that repeated add/remove doesn't drift. */
+struct FMixerStickSums
+{
+	double SumX;
+	double SumY;
+	double SumSquaresX;
+	double SumSquaresY;
+	double SumWeightedX;
+	double SumWeightedY;
+	double SumWeights;
+	int32 QuadrantVotes[4];
+	int32 NumValues;
+
+	FMixerStickSums()
+		: SumX(0.0)
+		, SumY(0.0)
+		, SumSquaresX(0.0)
+		, SumSquaresY(0.0)
+		, SumWeightedX(0.0)
+		, SumWeightedY(0.0)
+		, SumWeights(0.0)
+		, NumValues(0)
+	{
+		FMemory::Memzero(QuadrantVotes);
+	}
+
+	/** Add (Sign = 1) or remove (Sign = -1) one participant's value from the running sums. */
+	void Accumulate(float X, float Y, double Sign);
+
+	void GetAggregate(FMixerStickAggregate& OutAggregate) const;
+};
+
+struct FMixerStickPropertiesCached : public FMixerStickSums
 {
 	FMixerStickDescription Desc;
-	FMixerStickState State;
-	TMap<uint32, FVector2D> PerParticipantStickValue;
+
+	/** Values of participants currently deflecting the stick, packed so they're contiguous per axis. */
+	TArray<uint32> ParticipantIds;
+	TArray<float> ValuesX;
+	TArray<float> ValuesY;
+	TMap<uint32, int32> ValueIndexByParticipant;
+
+	/** From UMixerInteractivitySettings::StickInputFilter or its override for this stick, resolved when the stick is added. */
+	float FilterDeadzone;
+	float FilterMinimumDelta;
+	double FilterMinInterval;
+
+	struct FFilterState
+	{
+		FVector2D Value;
+		double Time;
+		/** Latest move held back by the rate, delivered once FilterMinInterval has passed (if bTrailing). */
+		FVector2D TrailingValue;
+		bool bTrailing;
+
+		FFilterState()
+			: Value(FVector2D::ZeroVector)
+			, Time(0.0)
+			, TrailingValue(FVector2D::ZeroVector)
+			, bTrailing(false)
+		{
+		}
+	};
+
+	/** Last value delivered to the game by each participant, for the filter.  Empty when the filter is off. */
+	TMap<uint32, FFilterState> FilterStateByParticipant;
+	/** Entries in FilterStateByParticipant with bTrailing set */
+	int32 NumTrailingValues;
+
+	FMixerStickPropertiesCached()
+		: FilterDeadzone(0.0f)
+		, FilterMinimumDelta(0.0f)
+		, FilterMinInterval(0.0)
+		, NumTrailingValues(0)
+	{
+	}
+
+	/** Drop every participant's value and the sums over them.  The description and filter are left alone. */
+	void ResetParticipantValues()
+	{
+		static_cast<FMixerStickSums&>(*this) = FMixerStickSums();
+		ParticipantIds.Reset();
+		ValuesX.Reset();
+		ValuesY.Reset();
+		ValueIndexByParticipant.Reset();
+	}
+};
+
+/**
+* Button holds and stick values summed over the members of one group, kept in step with the per-participant
+* state so team queries don't have to visit every member.  Indexed like the control tables, and only as long
+* as the highest control a member has touched.
+*/
+struct FMixerGroupControlState
+{
+	TArray<uint32> HeldButtonCounts;
+	TArray<FMixerStickSums> StickSums;
+
+	/** Fold another group's members into this one */
+	void Append(const FMixerGroupControlState& Other);
 };
 
 struct FMixerLabelPropertiesCached
@@ -37,61 +153,951 @@ struct FMixerTextboxPropertiesCached
 	FMixerTextboxDescription Desc;
 };
 
+/** Controls of one kind, stored densely.  Indices are stable until the table is emptied at the end of the session. */
+template <class PropertiesType>
+struct TMixerControlTable
+{
+	TArray<FName> Ids;
+	TArray<PropertiesType> Properties;
+	TMap<FName, int32> IndexById;
+
+	// Slots held for generated handles (see ReserveSlot) whose control hasn't been added yet.  Not found by name.
+	TMap<FName, int32> ReservedIndexById;
+	TBitArray<> ReservedSlots;
+
+	int32 Num() const
+	{
+		return Ids.Num();
+	}
+
+	int32 Find(FName ControlId) const
+	{
+		const int32* Index = IndexById.Find(ControlId);
+		return Index != nullptr ? *Index : INDEX_NONE;
+	}
+
+	int32 Add(FName ControlId, const PropertiesType& Props)
+	{
+		int32* ExistingIndex = IndexById.Find(ControlId);
+		if (ExistingIndex != nullptr)
+		{
+			Properties[*ExistingIndex] = Props;
+			return *ExistingIndex;
+		}
+
+		int32 Index;
+		if (ReservedIndexById.RemoveAndCopyValue(ControlId, Index))
+		{
+			Properties[Index] = Props;
+			ReservedSlots[Index] = false;
+		}
+		else
+		{
+			Index = Ids.Add(ControlId);
+			Properties.Add(Props);
+		}
+		IndexById.Add(ControlId, Index);
+		return Index;
+	}
+
+	/**
+	* Hold the next slot for a control that will be added later, so that it lands at a known index.
+	* The slot reads as empty (see IsReservedSlot) until Add is called for the control.
+	*/
+	int32 ReserveSlot(FName ControlId)
+	{
+		check(!IndexById.Contains(ControlId) && !ReservedIndexById.Contains(ControlId));
+		const int32 Index = Ids.Add(ControlId);
+		Properties.Add(PropertiesType());
+		ReservedIndexById.Add(ControlId, Index);
+		while (ReservedSlots.Num() < Index)
+		{
+			ReservedSlots.Add(false);
+		}
+		ReservedSlots.Add(true);
+		return Index;
+	}
+
+	bool IsReservedSlot(int32 Index) const
+	{
+		return ReservedSlots.IsValidIndex(Index) && ReservedSlots[Index];
+	}
+
+	/**
+	* Stop holding slots for controls that aren't coming, so a later Add of the name gets a slot of its own.
+	* The slots themselves stay reserved, and so empty, to keep every other index where it is.
+	* @return	the number of reservations dropped.
+	*/
+	int32 DropReservations(TFunctionRef<bool(FName)> KeepReservation)
+	{
+		int32 NumDropped = 0;
+		for (auto It = ReservedIndexById.CreateIterator(); It; ++It)
+		{
+			if (!KeepReservation(It->Key))
+			{
+				It.RemoveCurrent();
+				++NumDropped;
+			}
+		}
+		return NumDropped;
+	}
+
+	/**
+	* Take added controls back out, e.g. seeded ones the service turned out not to have.
+	* Their slots become reserved, and so empty, to keep every other index where it is.
+	* @return	the number of controls retired.
+	*/
+	int32 RetireControls(TFunctionRef<bool(FName)> KeepControl, TArray<int32>* OutIndices = nullptr)
+	{
+		int32 NumRetired = 0;
+		for (auto It = IndexById.CreateIterator(); It; ++It)
+		{
+			if (!KeepControl(It->Key))
+			{
+				const int32 Index = It->Value;
+				It.RemoveCurrent();
+				Properties[Index] = PropertiesType();
+				while (ReservedSlots.Num() <= Index)
+				{
+					ReservedSlots.Add(false);
+				}
+				ReservedSlots[Index] = true;
+				if (OutIndices != nullptr)
+				{
+					OutIndices->Add(Index);
+				}
+				++NumRetired;
+			}
+		}
+		return NumRetired;
+	}
+
+	void Empty()
+	{
+		Ids.Empty();
+		Properties.Empty();
+		IndexById.Empty();
+		ReservedIndexById.Empty();
+		ReservedSlots.Empty();
+	}
+};
+
+/** A control table that also carries per-frame state, in its own array parallel to the properties. */
+template <class StateType, class PropertiesType>
+struct TMixerStatefulControlTable : public TMixerControlTable<PropertiesType>
+{
+	TArray<StateType> States;
+
+	int32 ReserveSlot(FName ControlId)
+	{
+		const int32 Index = TMixerControlTable<PropertiesType>::ReserveSlot(ControlId);
+		// Value-initialized: some state types are plain aggregates, and reserved slots are read before they're added
+		States.Add(StateType());
+		return Index;
+	}
+
+	int32 Add(FName ControlId, const PropertiesType& Props, const StateType& State)
+	{
+		const int32 Index = TMixerControlTable<PropertiesType>::Add(ControlId, Props);
+		if (Index == States.Num())
+		{
+			States.Add(State);
+		}
+		else
+		{
+			States[Index] = State;
+		}
+		return Index;
+	}
+
+	int32 RetireControls(TFunctionRef<bool(FName)> KeepControl)
+	{
+		TArray<int32> Retired;
+		const int32 NumRetired = TMixerControlTable<PropertiesType>::RetireControls(KeepControl, &Retired);
+		for (int32 Index : Retired)
+		{
+			States[Index] = StateType();
+		}
+		return NumRetired;
+	}
+
+	void Empty()
+	{
+		TMixerControlTable<PropertiesType>::Empty();
+		States.Empty();
+	}
+};
+
+/**
+* Pre-allocates participant records so that a burst of joins doesn't allocate.  Each record comes
+* from MakeShared, so the reference count lives in the same allocation, and the pool is filled up
+* front from the expected audience size.  A departed participant's record is never reused: game code
+* may still hold a TWeakPtr to it, and reusing it would bring that pointer back to life as somebody else.
+*/
+struct FMixerRemoteUserPool
+{
+	/** Make sure at least Capacity records are allocated, and keep up to that many between sessions. */
+	void Reserve(int32 InCapacity);
+
+	/** A default-initialized record.  Only allocates once the pool is exhausted. */
+	TSharedPtr<FMixerRemoteUser> Acquire();
+
+private:
+	TArray<TSharedPtr<FMixerRemoteUser>> Free;
+	int32 Capacity;
+
+public:
+	FMixerRemoteUserPool()
+		: Capacity(0)
+	{
+	}
+};
+
+/**
+* Uniform per-control sampling of participant input for very large audiences.  While the stride is N, each
+* non-exempt event for a control is let through with chance 1 / N and stands for itself and the events dropped
+* since the last one kept; the rest are dropped before anything is done with them.  Partial counts carry over between sessions since
+* the sampling thread may outlive them; they're Stride - 1 events on average.  Only one thread may sample at a time, though it
+* needn't be the game thread; the stride and the arrival count may be used from any thread.
+*/
+struct FMixerInputSampler
+{
+	/**
+	* Count an arriving event and decide whether to keep it.
+	* @return	how many events the kept one stands for, or 0 if it should be dropped.  Always 1 for exempt events.
+	*/
+	uint32 Sample(FName ControlId, bool bExempt);
+
+	/**
+	* As Sample, for button presses and releases.  Releases are never sampled on their own account, but one is
+	* dropped along with the participant's press of the same button if that was dropped.
+	*/
+	uint32 SampleButton(FName ControlId, const FGuid& ParticipantSessionGuid, bool bPressed, bool bExempt);
+
+	void SetStride(int32 InStride);
+	int32 GetStride() const							{ return Stride.GetValue(); }
+
+	/** Events counted by Sample since the last call. */
+	int32 ConsumeArrivals()							{ return Arrivals.Set(0); }
+
+private:
+	TMap<FName, uint32> SkippedByControl;
+	TSet<TPair<FName, FGuid>> SkippedPresses;
+	FRandomStream RandomStream;
+	FThreadSafeCounter Stride;
+	FThreadSafeCounter Arrivals;
+
+public:
+	FMixerInputSampler()
+		: RandomStream(FPlatformTime::Cycles())
+		, Stride(1)
+	{
+	}
+};
+
+/**
+* Controls whose input can't currently be legitimate: those on scenes no group is on, and disabled buttons and
+* joysticks.  Built on the game thread and consulted by whichever thread first sees input, so input for them can
+* be dropped right after its control id is read.  Controls it doesn't know about (including the scenes of
+* controls it does know, while a rebuild is pending) are let through.
+*/
+struct FMixerInputFilter
+{
+	/** Whether input for the control should be dropped.  Any thread; always false while the filter is stale. */
+	bool Rejects(FName ControlId) const;
+
+	/** Mark the filter stale after scenes or enabled state change.  Any thread. */
+	void Invalidate()								{ Generation.Increment(); }
+	bool IsCurrent() const							{ return BuiltGeneration.GetValue() == Generation.GetValue(); }
+
+	/** Game thread.  Pass the value of BeginRebuild read before gathering Controls, so changes made meanwhile leave the filter stale. */
+	int32 BeginRebuild() const						{ return Generation.GetValue(); }
+	void FinishRebuild(TSet<FName>&& Controls, int32 RebuildGeneration);
+
+private:
+	mutable FCriticalSection Lock;
+	TSet<FName> RejectedControls;
+	FThreadSafeCounter NumRejected;
+	FThreadSafeCounter Generation;
+	FThreadSafeCounter BuiltGeneration;
+
+public:
+	FMixerInputFilter()
+		: Generation(1)
+		, BuiltGeneration(0)
+	{
+	}
+};
+
+/**
+* Fixed-capacity ring of recent input behind IMixerInteractivityModule::ReadInputJournal.  There is one writer,
+* the game thread, once per tick, and any number of readers on any thread, each with its own cursor.  The writer
+* never waits for readers; it overwrites the oldest input.  Each slot holds the sequence number of its event,
+* and the writer clears that number while rewriting the slot.  A reader that finds a different number
+* after copying the event knows the copy was overwritten.
+*/
+struct FMixerInputJournal
+{
+	/** Make room for at least InCapacity events.  Only the first call has any effect, since readers may be in the slots at any time. */
+	void Allocate(int32 InCapacity);
+	bool IsAllocated() const						{ return FPlatformAtomics::InterlockedCompareExchange(const_cast<volatile int32*>(&bAllocated), 0, 0) != 0; }
+
+	/** Game thread.  String indices only mean anything within their batch, so they're cleared. */
+	void Append(TArrayView<const FMixerInputEvent> Events);
+
+	/**
+	* Game thread.  Forget the input journaled so far, so that cursors only see input from the session now starting.
+	* Sequence numbers carry on from where they were, so cursors opened earlier stay valid and simply skip ahead.
+	*/
+	void BeginSession()								{ FPlatformAtomics::InterlockedExchange(&SessionStart, GetPublished()); }
+
+	/** Any thread. */
+	FMixerInputJournalCursor OpenCursor(double RewindSeconds) const;
+	int32 Read(FMixerInputJournalCursor& Cursor, TArray<FMixerInputEvent>& OutEvents, int32 MaxEvents) const;
+
+private:
+	struct FSlot
+	{
+		FMixerInputEvent Event;
+		volatile int64 Sequence;
+	};
+
+	/** Copy the event with the given sequence number.  False if it has been, or is being, overwritten. */
+	bool TryCopy(int64 Sequence, FMixerInputEvent& OutEvent) const;
+
+	// One past the newest event that has been completely written
+	int64 GetPublished() const						{ return FPlatformAtomics::InterlockedCompareExchange(const_cast<volatile int64*>(&Published), 0, 0); }
+
+	// Sequence number of the current session's first event
+	int64 GetSessionStart() const					{ return FPlatformAtomics::InterlockedCompareExchange(const_cast<volatile int64*>(&SessionStart), 0, 0); }
+
+	TArray<FSlot> Slots;
+	int64 Mask;
+	volatile int64 Published;
+	volatile int64 SessionStart;
+	volatile int32 bAllocated;
+
+public:
+	FMixerInputJournal()
+		: Mask(0)
+		, Published(0)
+		, SessionStart(0)
+		, bAllocated(0)
+	{
+	}
+};
+
+/**
+* The members of one group in order of one sort key, held as a run of small sorted blocks so that a participant
+* can be added, repositioned or removed in O(log n + block size) and a page found by skipping whole blocks.
+* Ties are broken by participant id so the order is total and pages don't reshuffle between refreshes.
+*/
+struct FMixerParticipantOrder
+{
+	void Add(uint32 ParticipantId, int64 Key);
+	void Remove(uint32 ParticipantId);
+
+	/** Reposition a participant whose key may have changed.  Does nothing for participants not in the order. */
+	void Update(uint32 ParticipantId, int64 Key);
+
+	/** Visit up to Count participants, Offset places from the lowest key (or from the highest if descending). */
+	void ForEachInPage(int32 Offset, int32 Count, bool bDescending, TFunctionRef<void(uint32)> Visitor) const;
+
+	int32 Num() const								{ return KeysByParticipant.Num(); }
+
+private:
+	struct FEntry
+	{
+		int64 Key;
+		uint32 ParticipantId;
+
+		bool operator<(const FEntry& Other) const
+		{
+			return Key != Other.Key ? Key < Other.Key : ParticipantId < Other.ParticipantId;
+		}
+	};
+
+	/** Block that holds Entry, or that it would be inserted into. */
+	int32 FindBlock(const FEntry& Entry) const;
+	static int32 LowerBound(const TArray<FEntry>& Block, const FEntry& Entry);
+
+	TArray<TArray<FEntry>> Blocks;
+	TMap<uint32, int64> KeysByParticipant;
+};
+
+enum class EMixerCachedControlKind : uint8
+{
+	Button,
+	Stick,
+	Label,
+	Textbox,
+};
+
+/** Kinds of participant input that are rate limited separately. */
+enum class EMixerInputRateClass : uint8
+{
+	Button,
+	Stick,
+	Textbox,
+	CustomControl,
+
+	Count
+};
+
+/** Kind and table index of a built-in control, so input can be routed with a single lookup. */
+struct FMixerControlDirectoryEntry
+{
+	FName ControlId;
+	EMixerCachedControlKind Kind;
+	int32 Index;
+};
+
 class FMixerInteractivityModule_WithSessionState : public FMixerInteractivityModule
 {
+public:
+	FMixerInteractivityModule_WithSessionState();
+
 public:
 	virtual void TriggerButtonCooldown(FName Button, FTimespan CooldownTime);
 	virtual bool GetButtonDescription(FName Button, FMixerButtonDescription& OutDesc);
 	virtual bool GetButtonState(FName Button, FMixerButtonState& OutState);
 	virtual bool GetButtonState(FName Button, uint32 ParticipantId, FMixerButtonState& OutState);
+	virtual bool GetButtonState(FName Button, FName GroupName, FMixerButtonState& OutState);
 	virtual bool GetStickDescription(FName Stick, FMixerStickDescription& OutDesc);
 	virtual bool GetStickState(FName Stick, FMixerStickState& OutState);
 	virtual bool GetStickState(FName Stick, uint32 ParticipantId, FMixerStickState& OutState);
+	virtual bool ResolveButton(FName Button, FMixerControlHandle& InOutHandle);
+	virtual bool ResolveStick(FName Stick, FMixerControlHandle& InOutHandle);
+	virtual void TriggerButtonCooldown(FMixerControlHandle Button, FTimespan CooldownTime);
+	virtual bool GetButtonDescription(FMixerControlHandle Button, FMixerButtonDescription& OutDesc);
+	virtual bool GetButtonState(FMixerControlHandle Button, FMixerButtonState& OutState);
+	virtual bool GetButtonState(FMixerControlHandle Button, uint32 ParticipantId, FMixerButtonState& OutState);
+	virtual bool GetButtonState(FMixerControlHandle Button, FName GroupName, FMixerButtonState& OutState);
+	virtual bool GetStickState(FMixerControlHandle Stick, FMixerStickState& OutState);
+	virtual bool GetStickState(FMixerControlHandle Stick, uint32 ParticipantId, FMixerStickState& OutState);
+	virtual void SetControlsEnabled(TArrayView<const FMixerControlHandle> ButtonHandles, bool bEnabled);
+	virtual void TriggerCooldownForScene(FName Scene, FTimespan CooldownTime);
+	virtual void SetProgressForControls(TArrayView<const TPair<FMixerControlHandle, float>> Progress);
+	virtual bool GetStickAggregate(FName Stick, FMixerStickAggregate& OutAggregate);
+	virtual bool GetStickAggregate(FMixerControlHandle Stick, FMixerStickAggregate& OutAggregate);
+	virtual bool GetStickAggregate(FName Stick, FName GroupName, FMixerStickAggregate& OutAggregate);
+	virtual bool GetStickAggregate(FMixerControlHandle Stick, FName GroupName, FMixerStickAggregate& OutAggregate);
+	virtual bool EnableCoordinateHeatmap(FName ControlId, const FMixerCoordinateHeatmapSettings& Settings);
+	virtual void DisableCoordinateHeatmap(FName ControlId);
+	virtual bool GetCoordinateHeatmap(FName ControlId, TArrayView<const float>& OutCells, int32& OutWidth, int32& OutHeight);
+	virtual bool EnableInputSketches(FName ControlId, const FMixerInputSketchSettings& Settings);
+	virtual void DisableInputSketches(FName ControlId);
+	virtual bool GetMostActiveParticipants(FName ControlId, int32 MaxCount, TArray<FMixerActiveParticipant>& OutParticipants);
+	virtual bool GetDistinctParticipantCount(FName ControlId, int32& OutCount);
+	virtual bool EnableActivityTimeSeries(FName ControlId, const FMixerActivitySeriesSettings& Settings);
+	virtual void DisableActivityTimeSeries(FName ControlId);
+	virtual bool GetActivityTimeSeries(FName ControlId, TArrayView<const float>& OutSamples, float& OutBucketSeconds);
+	virtual int32 StartVoteRound(const FMixerVoteRoundSettings& Settings);
+	virtual bool CloseVoteRound(int32 RoundId, FMixerVoteRoundResult& OutResult);
+	virtual bool GetVoteTallies(int32 RoundId, TArrayView<const int32>& OutTallies);
 	virtual void SetLabelText(FName Label, const FText& DisplayText);
 	virtual bool GetLabelDescription(FName Label, FMixerLabelDescription& OutDesc);
 	virtual bool GetTextboxDescription(FName Textbox, FMixerTextboxDescription& OutDesc);
 	virtual TSharedPtr<const FMixerRemoteUser> GetParticipant(uint32 ParticipantId);
 	virtual bool GetParticipantsInGroup(FName GroupName, TArray<TSharedPtr<const FMixerRemoteUser>>& OutParticipants);
+	virtual TArrayView<const TSharedPtr<const FMixerRemoteUser>> ViewParticipantsInGroup(FName GroupName);
+	virtual int32 GetParticipantsPage(FName GroupName, EMixerParticipantSortKey SortKey, int32 Offset, int32 Count, TArray<TSharedPtr<const FMixerRemoteUser>>& OutParticipants, bool bDescending);
+	virtual bool ReadSessionSnapshot(TFunctionRef<void(const FMixerSessionSnapshot&)> Reader);
+	virtual FMixerInputJournalCursor OpenInputJournalCursor(float RewindSeconds);
+	virtual int32 ReadInputJournal(FMixerInputJournalCursor& Cursor, TArray<FMixerInputEvent>& OutEvents, int32 MaxEvents);
+	virtual bool GetInputSamplingState(FMixerInputSamplingState& OutState);
 
 public:
 	virtual bool Tick(float DeltaTime) override;
+	virtual void GetContainerSizes(TFunctionRef<void(const TCHAR* Name, int64 Size)> Visit) const override;
 
 protected:
 	virtual bool HandleSingleControlUpdate(FName ControlId, const TSharedRef<FJsonObject> ControlData) override;
+	virtual FName GetButtonId(FMixerControlHandle Button) const override		{ return IsHandleCurrent(Buttons, Button) ? Buttons.Ids[Button.Index] : NAME_None; }
+	virtual FName GetStickId(FMixerControlHandle Stick) const override			{ return IsHandleCurrent(Sticks, Stick) ? Sticks.Ids[Stick.Index] : NAME_None; }
 
 protected:
-	void StartSession(bool bCachePerParticipantState);
+	void StartSession(bool bCachePerParticipantState, int32 ExpectedParticipants);
 	void EndSession();
 
+	/**
+	* Hold the Project Definition's buttons and joysticks at the dense indices a generated controls header
+	* assigns them.  Waits on the preloader if the definition is still streaming in.
+	*/
+	void ReserveGeneratedControlHandles();
+
+	/**
+	* Once the service's scene list has been parsed, give up the reservations for controls it didn't include.
+	* @param	KeepReservation	Whether a control may still be added later (e.g. its scene is parsed on demand).
+	*/
+	void DropUnclaimedControlReservations(TFunctionRef<bool(FName)> KeepReservation);
+
+	/**
+	* Once the service's scene list has arrived, take out the controls seeded (from the Project Definition
+	* or the warm start cache) that it doesn't include, so that they stop resolving and accepting input.
+	* @param	IsLive	Whether the service has (or may still deliver) a control.
+	*/
+	void RetireSeededControls(TFunctionRef<bool(FName)> IsLive);
+
+	/** Record how far the service's clock is ahead of ours, so that cooldowns end when the game asked them to. */
+	void SetServerTimeOffset(int64 OffsetMs) { ServerTimeOffsetMs = OffsetMs; }
+
+	/** Now, as Unix time in milliseconds by the service's clock. */
+	int64 GetServerTimeMs() const;
+
 	bool CachePerParticipantState();
 
-	void AddButton(FName ControlId, const FMixerButtonPropertiesCached& Props);
-	FMixerButtonPropertiesCached* GetButton(FName ControlId);
+	void AddButton(FName ControlId, const FMixerButtonPropertiesCached& Props, const FMixerButtonState& InitialState);
+	int32 FindButton(FName ControlId) const							{ return Buttons.Find(ControlId); }
+	/** Access a button's state to record input.  The per-interval counters will be reset on the next tick. */
+	FMixerButtonState& TouchButtonState(int32 Index);
+	FMixerButtonPropertiesCached& GetButtonPropertiesAt(int32 Index)	{ return Buttons.Properties[Index]; }
+
+	/**
+	* Record a participant pressing or releasing a button.  Keeps PressCount in step.  Presses are ignored unless
+	* per-participant state is cached, but releases should always be passed on so that holds from before an
+	* adaptive switch to aggregate-only tracking still end.
+	*/
+	void SetButtonHeldByParticipant(int32 ButtonIndex, uint32 ParticipantId, bool bHeld);
+
+	void AddStick(FName ControlId, const FMixerStickPropertiesCached& Props, const FMixerStickState& InitialState);
+	int32 FindStick(FName ControlId) const							{ return Sticks.Find(ControlId); }
+	FMixerStickState& GetStickStateAt(int32 Index)					{ return Sticks.States[Index]; }
+	FMixerStickPropertiesCached& GetStickPropertiesAt(int32 Index)	{ return Sticks.Properties[Index]; }
+
+	/**
+	* Apply the stick's deadzone, minimum delta and rate (see FMixerStickInputFilter) to a participant's move.
+	* Backends call this as they decode a move, before admitting or broadcasting it.  The latest move
+	* held back by the rate is delivered through DeliverStickInput once the interval is up.
+	* Moves from participants who aren't known aren't filtered.
+	*
+	* @return	false if the move should be discarded.  Otherwise InOutValue is the value to deliver.
+	*/
+	bool FilterStickInput(int32 StickIndex, const FMixerRemoteUser* Participant, FVector2D& InOutValue);
+
+	/**
+	* Hand the game a stick move that has been filtered and admitted.  Also used for moves held back by
+	* FilterStickInput for the rate, and by coalescing.
+	*/
+	virtual void DeliverStickInput(FName ControlId, TSharedPtr<const FMixerRemoteUser> Participant, FVector2D Value);
 
-	void AddStick(FName ControlId, const FMixerStickPropertiesCached& Props);
-	FMixerStickPropertiesCached* GetStick(FName ControlId);
+	/**
+	* Whether DeliverOrCoalesceStickInput holds moves until FlushCoalescedStickInput, keeping only the latest
+	* for each participant and stick, rather than delivering them straight away.
+	*/
+	void SetCoalesceStickInput(bool bCoalesce)							{ bCoalesceStickInput = bCoalesce; }
+
+	/**
+	* Deliver a filtered and admitted stick move, or hold it for FlushCoalescedStickInput while coalescing.
+	* A held move only keeps a weak reference to its participant, and is dropped if they leave before the flush.
+	*/
+	void DeliverOrCoalesceStickInput(FName ControlId, const TSharedPtr<const FMixerRemoteUser>& Participant, FVector2D Value);
+
+	/** Deliver the moves held by DeliverOrCoalesceStickInput. */
+	void FlushCoalescedStickInput();
+
+	/** Record a participant's latest value for a stick when per-participant state is cached.  A zero value means released. */
+	void SetStickValueForParticipant(int32 StickIndex, uint32 ParticipantId, FVector2D Value);
 
 	void AddLabel(FName ControlId, const FMixerLabelPropertiesCached& Props);
 	FMixerLabelPropertiesCached* GetLabel(FName ControlId);
 
 	void AddTextbox(FName ControlId, const FMixerTextboxPropertiesCached& Props);
 	FMixerTextboxPropertiesCached* GetTextbox(FName ControlId);
+	FMixerTextboxPropertiesCached& GetTextboxPropertiesAt(int32 Index)	{ return Textboxes.Properties[Index]; }
+
+	/** Find a built-in control by the id as it arrives on the wire, without going through the name table. */
+	const FMixerControlDirectoryEntry* FindControl(const FString& RawControlId);
 
+	/** A blank participant record for AddUser, recycled from participants who have left where possible. */
+	TSharedPtr<FMixerRemoteUser> AllocateUser()						{ MIXER_LLM_SCOPE(Participants); return UserPool.Acquire(); }
 	void AddUser(TSharedPtr<FMixerRemoteUser> User);
+	void ReserveUsers(int32 NumAdditionalUsers);
 	void RemoveUser(TSharedPtr<FMixerRemoteUser> User);
 	void RemoveUser(FGuid ParticipantSessionId);
 	TSharedPtr<FMixerRemoteUser> GetCachedUser(uint32 ParticipantId);
 	TSharedPtr<FMixerRemoteUser> GetCachedUser(FGuid ParticipantSessionId);
+
+	/**
+	* Look up a participant by session id exactly as the service sends it.  The usual hyphenated form is
+	* decoded in place, skipping FGuid::Parse and its temporary strings.  Returns false if the id isn't a guid.
+	*/
+	bool FindCachedUserBySessionId(const TCHAR* SessionIdString, TSharedPtr<FMixerRemoteUser>& OutUser);
+	bool FindCachedUserBySessionId(const ANSICHAR* SessionIdString, TSharedPtr<FMixerRemoteUser>& OutUser);
+
+	/** The parsing half of FindCachedUserBySessionId.  Touches no session state, so may be called from any thread. */
+	static bool ParseSessionId(const TCHAR* SessionIdString, FGuid& OutSessionGuid);
+	static bool ParseSessionId(const ANSICHAR* SessionIdString, FGuid& OutSessionGuid);
+	void GetCachedUsers(TArray<TSharedPtr<FMixerRemoteUser>>& OutUsers);
 	void ReassignUsers(FName FromGroup, FName ToGroup);
 
+	/** Change a participant's group.  Must be used instead of writing FMixerRemoteUser::Group so the group index stays correct. */
+	void SetUserGroup(const TSharedPtr<FMixerRemoteUser>& User, FName Group);
+
+	/** Move a cached participant to a new session id, e.g. when they rejoin.  Must be used instead of writing FMixerRemoteUser::SessionGuid. */
+	void SetUserSessionGuid(const TSharedPtr<FMixerRemoteUser>& User, const FGuid& SessionGuid);
+
+	/** Keep GetParticipantsPage orders current after writing a participant's Level, ConnectedAt or InputAt. */
+	void UpdateParticipantOrder(const FMixerRemoteUser& User);
+
+	/** Stamp a participant's InputAt on input, which keeps them from being evicted as idle, and keep the InputAt order current. */
+	void NoteUserInput(FMixerRemoteUser& User);
+
+	/**
+	* Participants still in the session may be evicted from the cache when it exceeds its memory budget.
+	* Backends re-fetch them when they next send input and put them back with RestoreEvictedUser.
+	*/
+	bool WasUserEvicted(FGuid ParticipantSessionId) const				{ return EvictedParticipants.Contains(ParticipantSessionId); }
+	void ForgetEvictedUser(FGuid ParticipantSessionId)				{ EvictedParticipants.Remove(ParticipantSessionId); }
+	TSharedPtr<FMixerRemoteUser> RestoreEvictedUser(const FMixerRemoteUser& Participant);
+
+	/** Called on the game thread after an idle participant has been evicted from the cache. */
+	virtual void OnUserEvicted(const FMixerRemoteUser& User) {}
+
+	/**
+	* Whether an idle participant may be evicted.  Backends that hold on to a participant after the
+	* service reports them gone (to absorb a quick rejoin) keep them, so that the Left they owe the game
+	* is still reported, and a rejoin is still recognized.
+	*/
+	virtual bool CanEvictUser(const FMixerRemoteUser& User) const { return true; }
+
+	/**
+	* Called when a control is looked up by name and isn't cached.  Backends that defer parsing
+	* scenes until they're needed create the control (and the rest of its scene) here.
+	* @return	true if the control's scene was parsed as a result.
+	*/
+	virtual bool MaterializeControl(FName ControlId) { return false; }
+
+	/** As MaterializeControl, but for every control in the named scene. */
+	virtual bool MaterializeScene(FName SceneId) { return false; }
+
+	/**
+	* Decide whether a participant's input may be broadcast, applying the per-participant rate limit for its
+	* class and each participant's fair share of MaxInputEventsPerFrame.  Exempt input (releases, charged
+	* events) is always admitted but still spends from the participant's allowance.
+	*/
+	bool AdmitParticipantInput(const FMixerRemoteUser* Participant, EMixerInputRateClass RateClass, bool bExempt = false);
+
+	/**
+	* AdmitParticipantInput for a button press or release.  Releases are exempt, except that one whose press
+	* was dropped is dropped too, so handlers never see a release without the press before it.
+	*/
+	bool AdmitButtonInput(const FMixerRemoteUser* Participant, FName ButtonId, bool bPressed, bool bCharged);
+
+	/**
+	* When the input now being handled arrived (FPlatformTime::Seconds()), for latency measured as it's admitted.
+	* Backends set this around input dispatch; 0 (e.g. for input replayed after a participant refetch) records nothing.
+	*/
+	double InputArrivalTime;
+
+	/** Add input to this tick's OnInputBatch, if anything is listening.  Call alongside the matching individual broadcast. */
+	void RecordButtonInput(FName ControlId, const FMixerRemoteUser* Participant, const FMixerButtonEventDetails& Details);
+	void RecordStickInput(FName ControlId, const FMixerRemoteUser* Participant, FVector2D Value);
+	void RecordTextboxInput(FName ControlId, const FMixerRemoteUser* Participant, const FMixerTextboxEventDetails& Details);
+	void RecordCustomControlInput(FName ControlId, const FMixerRemoteUser* Participant, const FJsonObject& Input);
+	/** Whether RecordCustomControlInput would use input for this control, so that callers can skip building the JSON. */
+	bool WantsCustomControlInputRecorded(FName ControlId) const { return CoordinateHeatmaps.Contains(ControlId) || InputSketches.Contains(ControlId) || ActivitySeries.Contains(ControlId); }
+
+	/** Broadcast OnInputBatch with the input recorded since the last flush.  Backends call this once per tick after pumping input. */
+	void FlushInputBatch();
+
+	/**
+	* Thins input ahead of dispatch when UMixerInteractivitySettings::bSampleInputUnderLoad is set.  Backends pass
+	* every input event through it before doing any work on it (button input via SampleButton); charged input must
+	* be marked exempt.
+	*/
+	FMixerInputSampler InputSampler;
+
+	/** See FMixerInputFilter.  Other threads may only call Rejects and Invalidate. */
+	FMixerInputFilter InputFilter;
+
+	/** Record which scene a control (built-in or custom) belongs to, for InputFilter. */
+	void NoteControlScene(FName ControlId, FName SceneId);
+
+	/** Game thread version of InputFilter.Rejects that brings the filter up to date first. */
+	bool RejectsControlInput(FName ControlId);
+
+	/** Scenes some group is on.  Leaving it empty means scenes aren't known, and input isn't filtered by scene. */
+	virtual void GetActiveScenes(TSet<FName>& OutScenes) {}
+
+private:
+	void RefreshInputFilter();
+
+	int32 AssignParticipantSlot(uint32 ParticipantId);
+	void ReleaseParticipantSlot(uint32 ParticipantId);
+
+	void PublishSessionSnapshot();
+
+	void TickParticipantCacheMaintenance();
+
+	/** Copy looked-up channel relationships onto the participants still cached and report them through OnParticipantsEnriched. */
+	void OnParticipantEnrichmentResolved(const TArray<uint32>& UserIds);
+
+	/** Switch between per-participant and aggregate-only tracking as the audience crosses the adaptive thresholds. */
+	void UpdateAdaptivePerParticipantState();
+	void SetPerParticipantState(bool bEnabled);
+	void ReleaseHoldingParticipantSlots();
+	static SIZE_T EstimateCachedUserSize(const FMixerRemoteUser& User);
+
+	void AddToGroupIndex(const TSharedPtr<FMixerRemoteUser>& User);
+	void RemoveFromGroupIndex(const FMixerRemoteUser& User);
+
+	/**
+	* Move a slotted participant's holds and stick values over to another group's totals, or out of them
+	* altogether for NAME_None.  Costs a visit to every control, so whole-group moves shouldn't go through here.
+	*/
+	void SetParticipantGroupTotals(uint32 ParticipantId, FName Group);
+	void AddGroupButtonHold(int32 Slot, int32 ButtonIndex, bool bHeld);
+	void AccumulateGroupStickValue(int32 Slot, int32 StickIndex, float X, float Y, double Sign);
+
+	void RemoveStickValue(int32 StickIndex, int32 ValueIndex);
+	void UpdateStickAxes(int32 StickIndex);
+
+	void AddToControlDirectory(FName ControlId, EMixerCachedControlKind Kind, int32 Index);
+
+	void TickInputRateLimits();
+	void TickInputSampling();
+	void FlushTrailingStickInput();
+	static void ForgetTrailingStickValue(FMixerStickPropertiesCached& StickProps, FMixerStickPropertiesCached::FFilterState& State);
+	static void ForgetStickFilterState(FMixerStickPropertiesCached& StickProps, uint32 ParticipantId);
+
+	bool IsRecordingInputBatch() { return OnInputBatch().IsBound() || OnGroupInputBatch().IsBound() || InputJournal.IsAllocated(); }
+	FMixerInputEvent& AddBatchedInput(EMixerInputEventKind Kind, FName ControlId, int32 ControlIndex, const FMixerRemoteUser* Participant);
+	int32 AddBatchedInputString(const FString& String);
+
+	/** Split BatchedInput by group and broadcast OnGroupInputBatch with a summary of each. */
+	void PublishGroupInputBatch();
+	/** Thread safe; only touches its arguments. */
+	static void SummarizeGroupInput(TArrayView<const FMixerInputEvent> Events, TArray<FMixerGroupControlSummary>& OutControls);
+
+	struct FCoordinateHeatmap
+	{
+		FMixerCoordinateHeatmapSettings Settings;
+		TArray<float> Cells;
+
+		// Coordinates received since the last binning, kept as raw pairs so they can be binned several at a time
+		TArray<FVector2D> PendingSamples;
+	};
+
+	static void BinHeatmapSamples(FCoordinateHeatmap& Heatmap);
+	static void DecayHeatmap(FCoordinateHeatmap& Heatmap, float DeltaTime);
+
+	struct FInputSketchCounter
+	{
+		uint32 ParticipantId;
+		uint32 Count;
+		uint32 Overcount;
+	};
+
+	/**
+	* Per-control activity over a sliding window kept as WindowBuckets slices, each with HyperLogLog registers
+	* for distinct participants and Space-Saving counters for the most active ones.  Slices are merged on query.
+	*/
+	struct FInputSketch
+	{
+		FMixerInputSketchSettings Settings;
+
+		// 2 ^ DistinctPrecision registers per slice
+		TArray<uint8> Registers;
+
+		// TrackedParticipants counters per slice, the first CountersUsed of each in use
+		TArray<FInputSketchCounter> Counters;
+		TArray<int32> CountersUsed;
+
+		int32 CurrentBucket;
+		double BucketEndTime;
+	};
+
+	void RecordSketchInput(FName ControlId, const FMixerRemoteUser* Participant);
+	static void AddToSketch(FInputSketch& Sketch, uint32 ParticipantId);
+	static void AdvanceSketch(FInputSketch& Sketch, double TimeNow);
+	static void ClearSketchBucket(FInputSketch& Sketch, int32 Bucket);
+
+	/**
+	* Ring of NumBuckets samples, each written twice (at i and i + NumBuckets) so that the latest NumBuckets
+	* are always contiguous, from Head + 1 to Head + NumBuckets, and can be handed out as a single view.
+	*/
+	struct FActivitySeries
+	{
+		FMixerActivitySeriesSettings Settings;
+		TArray<float> Samples;
+		int32 Head;
+		double BucketEndTime;
+	};
+
+	void RecordActivity(FName ControlId, float Amount);
+	static void AdvanceActivitySeries(FActivitySeries& Series, double TimeNow);
+
+	struct FVoteRound
+	{
+		FMixerVoteRoundResult Result;
+
+		// Participants who have voted in this round.  Keyed by id so leaving and rejoining doesn't earn a second vote.
+		TSet<uint32> VoterIds;
+
+		// FPlatformTime::Seconds() at which the round closes, or 0 if only CloseVoteRound closes it
+		double EndTime;
+
+		bool bWeightBySparks;
+	};
+
+	struct FVoteOption
+	{
+		int32 RoundId;
+		int32 Option;
+	};
+
+	void RecordVote(FName ControlId, const FMixerRemoteUser* Participant, const FMixerButtonEventDetails& Details);
+	void TickVoteRounds();
+
+	static FTimespan GetRemainingCooldown(const FMixerButtonStateCached& State);
+
+	/** Second half of ReserveGeneratedControlHandles, once the Project Definition is in memory. */
+	void ReserveGeneratedControlHandlesFromDefinition();
+
+	template <class PropertiesType>
+	bool ResolveControl(const TMixerControlTable<PropertiesType>& Controls, FName ControlId, FMixerControlHandle& InOutHandle) const;
+
+	template <class PropertiesType>
+	bool IsHandleCurrent(const TMixerControlTable<PropertiesType>& Controls, FMixerControlHandle Handle) const
+	{
+		return Controls.Ids.IsValidIndex(Handle.Index)
+			&& !Controls.IsReservedSlot(Handle.Index)
+			&& (Handle.Generation == ControlGeneration || Handle.Generation == ReservedLayoutHash);
+	}
+
 private:
 	TMap<FGuid, TSharedPtr<FMixerRemoteUser>> RemoteParticipantCacheByGuid;
 	TMap<uint32, TSharedPtr<FMixerRemoteUser>> RemoteParticipantCacheByUint;
 
-	TMap<FName, FMixerButtonPropertiesCached> Buttons;
-	TMap<FName, FMixerStickPropertiesCached> Sticks;
-	TMap<FName, FMixerLabelPropertiesCached> Labels;
-	TMap<FName, FMixerTextboxPropertiesCached> Textboxes;
+	FMixerRemoteUserPool UserPool;
+
+	// Participants evicted from the cache while still in the session
+	TSet<FGuid> EvictedParticipants;
+	double NextParticipantCacheMaintenanceTime;
+
+	// Cached participants by group, packed so a group can be handed out as a view.
+	TMap<FName, TArray<TSharedPtr<const FMixerRemoteUser>>> ParticipantsByGroup;
+	// Position of each cached participant within its group's array.
+	TMap<uint32, int32> GroupMemberIndex;
+
+	// Per sort key, the orders of groups that have been paged through GetParticipantsPage.  Only groups with members have one.
+	TMap<FName, FMixerParticipantOrder> ParticipantOrders[static_cast<int32>(EMixerParticipantSortKey::Count)];
 
+	// Dense slot per cached participant, indexing the per-button hold bits.  Slots of departed participants are reused.
+	TMap<uint32, int32> ParticipantSlots;
+	TArray<int32> FreeParticipantSlots;
+	int32 NumParticipantSlots;
+
+	// Group each participant slot's holds and stick values are counted under, and those counts per group
+	TArray<FName> ParticipantSlotGroups;
+	TMap<FName, FMixerGroupControlState> ControlStateByGroup;
+
+	TMixerStatefulControlTable<FMixerButtonStateCached, FMixerButtonPropertiesCached> Buttons;
+	TMixerStatefulControlTable<FMixerStickState, FMixerStickPropertiesCached> Sticks;
+	TMixerControlTable<FMixerLabelPropertiesCached> Labels;
+	TMixerControlTable<FMixerTextboxPropertiesCached> Textboxes;
+
+	// Indexes into the tables above by the id as it arrives on the wire.
+	TMap<FString, FMixerControlDirectoryEntry> ControlDirectory;
+
+	// Scene of every control seen in a scene definition, including custom controls that aren't in the tables
+	TMap<FName, FName> SceneByControl;
+
+	// Buttons whose DownCount/UpCount were changed since the last tick.
+	TArray<int32> ButtonsWithDirtyCounters;
+
+	// Sticks with a move held back by the filter's rate (FMixerStickPropertiesCached::NumTrailingValues > 0)
+	TArray<int32> SticksWithTrailingInput;
+
+	struct FCoalescedStickInput
+	{
+		FName ControlId;
+		TWeakPtr<const FMixerRemoteUser> Participant;
+		bool bFromKnownParticipant;
+		FVector2D Value;
+	};
+
+	// Latest stick position per (control, participant) since the last FlushCoalescedStickInput
+	TArray<FCoalescedStickInput> CoalescedStickInput;
+	TMap<uint64, int32> CoalescedStickInputIndex;
+	bool bCoalesceStickInput;
+
+	// Bumped whenever the tables are emptied so handles from an earlier session are recognized as stale.
+	uint32 ControlGeneration;
+
+	// Server clock minus ours, as measured by the backend.  Mixer's cooldowns are absolute server times.
+	int64 ServerTimeOffsetMs;
+
+	// Layout of the slots held by ReserveGeneratedControlHandles this session; handles carrying it are current too.  0 if none.
+	uint32 ReservedLayoutHash;
+
+	// Double-buffered snapshot for other threads.  The game thread only rewrites the unpublished buffer,
+	// and only once no reader is left on it; readers never wait.
+	FMixerSessionSnapshot Snapshots[2];
+	FThreadSafeCounter SnapshotReaders[2];
+	FThreadSafeCounter PublishedSnapshot;
+	uint64 SnapshotVersion;
+
+	FMixerInputJournal InputJournal;
+
+	struct FParticipantInputAllowance
+	{
+		float Tokens[static_cast<int32>(EMixerInputRateClass::Count)];
+		double LastRefillTime[static_cast<int32>(EMixerInputRateClass::Count)];
+		uint32 FrameNumber;
+		int32 EventsThisFrame;
+		// Buttons whose latest press was dropped; their release is dropped with it
+		TSet<FName> DroppedButtonPresses;
+	};
+
+	struct FInputRateLimitCached
+	{
+		bool bEnabled;
+		float EventsPerSecond;
+		float Burst;
+	};
+
+	TMap<uint32, FParticipantInputAllowance> ParticipantInputAllowances;
+	FInputRateLimitCached InputRateLimits[static_cast<int32>(EMixerInputRateClass::Count)];
+	int32 MaxInputEventsPerFrame;
+
+	// Frame accounting for MaxInputEventsPerFrame.  The fair share is worked out from the previous frame's participant count.
+	uint32 InputFrameNumber;
+	int32 InputEventsThisFrame;
+	int32 ParticipantsWithInputThisFrame;
+	int32 FairInputShare;
+
+	// Input events arriving per frame, smoothed, that the sampling stride is worked out from
+	float SmoothedInputArrivals;
+
+	TMap<FName, FCoordinateHeatmap> CoordinateHeatmaps;
+	TMap<FName, FInputSketch> InputSketches;
+	TMap<FName, FActivitySeries> ActivitySeries;
+
+	TMap<int32, FVoteRound> VoteRounds;
+	TMap<FName, FVoteOption> VoteOptionsByButton;
+	int32 NextVoteRoundId;
+
+	// Input recorded for the next OnInputBatch, and the strings it refers to
+	TArray<FMixerInputEvent> BatchedInput;
+	TArray<FString> BatchedInputStrings;
+	// Group of each event in BatchedInput
+	TArray<FName> BatchedInputGroups;
+
+	// Working storage for OnGroupInputBatch, kept between ticks for its allocations
+	TArray<int32> GroupIndexOfInput;
+	TArray<FMixerInputEvent> GroupedInput;
+	TArray<FMixerGroupInputBatch> GroupInputBatches;
+	TArray<TArray<FMixerGroupControlSummary>> GroupControlSummaries;
+
+	// Whether per-participant state is being tracked right now, and whether the session may track it at all
 	bool bPerParticipantState;
+	bool bPerParticipantStateAllowed;
+
+	// Set bits across every button's HoldingParticipantSlots, so aggregate-only mode knows when the last old hold has ended
+	int32 NumHeldButtonSlots;
+
+	// Gathers joining participants for batched channel relationship lookups.  Its cache outlives sessions, so reconnects needn't ask again.
+	TSharedRef<FMixerParticipantEnrichment> ParticipantEnrichment;
 };
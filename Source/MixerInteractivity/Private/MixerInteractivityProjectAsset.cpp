@@ -1,16 +1,140 @@
 #pragma once
 
 #include "MixerInteractivityProjectAsset.h"
+#include "MixerInteractivitySettings.h"
+#include "MixerInteractivityLog.h"
+#include "Serialization/CustomVersion.h"
+#include "Async/Async.h"
+
+namespace
+{
+	/** Versions of UMixerProjectAsset's native serialization.  Bump when operator<< for the definition types changes. */
+	struct FMixerProjectAssetCustomVersion
+	{
+		enum Type
+		{
+			BeforeCustomVersionWasAdded = 0,
+
+			// Cooked assets carry ParsedProjectDefinition in binary form instead of the JSON
+			CookedParsedDefinition,
+
+			VersionPlusOne,
+			LatestVersion = VersionPlusOne - 1
+		};
+
+		static const FGuid GUID;
+	};
+
+	const FGuid FMixerProjectAssetCustomVersion::GUID(0x6A3E1B27, 0x4C9D4F12, 0x9E5B8C0D, 0x27F1A64B);
+	FCustomVersionRegistration GRegisterMixerProjectAssetCustomVersion(FMixerProjectAssetCustomVersion::GUID, FMixerProjectAssetCustomVersion::LatestVersion, TEXT("MixerProjectAsset"));
+}
 
 void UMixerProjectAsset::PostLoad()
 {
 	Super::PostLoad();
 
 #if WITH_EDITORONLY_DATA
-	ParsedProjectDefinition.FromJson(ProjectDefinitionJson);
+	// Empty when this is cooked data, in which case Serialize has already filled in the parsed form
+	if (!ProjectDefinitionJson.IsEmpty())
+	{
+		ParsedProjectDefinition.FromJson(ProjectDefinitionJson);
+		RebuildControlIndex();
+	}
+#endif
+}
+
+void UMixerProjectAsset::Serialize(FArchive& Ar)
+{
+	Super::Serialize(Ar);
+
+	Ar.UsingCustomVersion(FMixerProjectAssetCustomVersion::GUID);
+
+	// Cooked data carries the definition already parsed, in place of the editor-only JSON
+	if (Ar.IsFilterEditorOnly())
+	{
+		if (Ar.IsLoading() && Ar.CustomVer(FMixerProjectAssetCustomVersion::GUID) < FMixerProjectAssetCustomVersion::CookedParsedDefinition)
+		{
+			UE_LOG(LogMixerInteractivity, Error, TEXT("Mixer project definition %s was cooked by an older version of the plugin and has no controls.  Please recook."), *GetPathName());
+			return;
+		}
+
+		Ar << ParsedProjectDefinition;
+		if (Ar.IsLoading())
+		{
+			RebuildControlIndex();
+		}
+	}
+}
+
+const TArray<FString>& UMixerProjectAsset::GetControlsOfKind(const FString& Kind) const
+{
+	static const TArray<FString> NoControls;
+	const TArray<FString>* Controls = ControlsByKind.Find(Kind);
+	return Controls != nullptr ? *Controls : NoControls;
+}
+
+void UMixerProjectAsset::RebuildControlIndex()
+{
+	ControlsByKind.Empty();
+	TSet<FString> SeenControls;
+	for (const FMixerInteractiveScene& Scene : ParsedProjectDefinition.Controls.Scenes)
+	{
+		for (const FMixerInteractiveControl& Control : Scene.Controls)
+		{
+			bool bAlreadySeen = false;
+			SeenControls.Add(Control.Id, &bAlreadySeen);
+			if (!bAlreadySeen)
+			{
+				ControlsByKind.FindOrAdd(Control.Kind).Add(Control.Id);
+			}
+		}
+	}
+
+	uint32 LayoutHash = 0;
+	auto HashControlsOfKind = [this, &LayoutHash](const FString& Kind)
+	{
+		LayoutHash = FCrc::StrCrc32(*Kind, LayoutHash);
+		for (const FString& ControlId : GetControlsOfKind(Kind))
+		{
+			LayoutHash = FCrc::StrCrc32(*ControlId, LayoutHash);
+		}
+	};
+	HashControlsOfKind(FMixerInteractiveControl::ButtonKind);
+	HashControlsOfKind(FMixerInteractiveControl::JoystickKind);
+	// Session generations count up from 1, so keeping the top bit set means the two can't be confused
+	ControlLayoutHash = LayoutHash | 0x80000000u;
+
+#if WITH_EDITORONLY_DATA
+	// Reached from PostLoad, which may be on the async loading thread; the index is only touched on the game thread
+	if (!IsTemplate())
+	{
+		if (IsInGameThread())
+		{
+			UMixerInteractivitySettings::InvalidateControlIndex();
+		}
+		else
+		{
+			AsyncTask(ENamedThreads::GameThread, []()
+			{
+				UMixerInteractivitySettings::InvalidateControlIndex();
+			});
+		}
+	}
 #endif
 }
 
+#if WITH_EDITOR
+
+void UMixerProjectAsset::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	// Custom control mappings decide which controls count as unmapped
+	UMixerInteractivitySettings::InvalidateControlIndex();
+}
+
+#endif
+
 #if WITH_EDITORONLY_DATA
 
 void UMixerProjectAsset::GetAllControls(TFunctionRef<bool(const FMixerInteractiveControl&)> Predicate, TArray<FString>& OutControls)
@@ -11,37 +11,195 @@
 #include "MixerInteractivitySettings.h"
 #include "MixerInteractivityProjectAsset.h"
 #include "MixerInteractivityJsonTypes.h"
+#include "MixerProjectAssetPreloader.h"
 
 UMixerInteractivitySettings::UMixerInteractivitySettings()
 	: bPerParticipantStateCaching(true)
+	, bAdaptivePerParticipantStateCaching(false)
+	, PerParticipantStateAudienceLimit(2000)
+	, PerParticipantStateAudienceResume(1500)
+	, ExpectedAudienceSize(256)
+	, ParticipantCacheBudgetKB(0)
+	, ParticipantIdleEvictionTime(60.0f)
+	, ParticipantRejoinGracePeriod(0.0f)
+	, bEnrichParticipants(false)
+	, ParticipantEnrichmentWindow(0.5f)
+	, ParticipantEnrichmentBatchSize(50)
+	, ParticipantEnrichmentCacheLifetime(600.0f)
+	, bPublishSessionSnapshots(false)
+	, InputJournalCapacity(0)
+	, bParseMessagesOffGameThread(false)
+	, bBatchOutboundMessages(true)
+	, MaxOutboundFrameSize(16 * 1024)
+	, OutboundBulkMessageSize(8 * 1024)
+	, OutboundBulkBytesPerTick(64 * 1024)
+	, bRequestMessageCompression(false)
+	, bCompressionContextTakeover(true)
+	, bAutoReconnect(true)
+	, ReconnectBaseDelay(0.5f)
+	, ReconnectMaxDelay(30.0f)
+	, MaxReconnectAttempts(8)
+	, ConnectionPingInterval(10.0f)
+	, ConnectionPingTimeout(5.0f)
+	, ConnectionFailoverRoundTripMs(750.0f)
+	, ConnectionFailoverPingCount(3)
+	, bSuppressUnchangedControlUpdates(true)
+	, ControlProgressEpsilon(0.0f)
+	, ControlUpdateMinInterval(0.0f)
+	, ControlUpdateBytesPerSecond(0)
+	, ControlUpdateMaxMessageSize(16 * 1024)
+	, bCoalesceStickInput(false)
+	, EventPumpBudgetMicroseconds(2000)
+	, FrameBudgetMilliseconds(0.0f)
+	, ProcessingRate(0.0f)
+	, bDispatchInputAtProcessingRate(false)
+	, bHibernateWhenNotBroadcasting(false)
+	, HibernationTickInterval(0.25f)
+	, bGuardTickAllocations(false)
+	, SteadyStateAllocationBudget(0)
+	, AllocationGuardWarmupTime(5.0f)
+	, bProcessEventsOnWorkerThread(false)
+	, StickCoalescingBacklogThreshold(200)
+	, bPrioritizeInputUnderLoad(true)
+	, bAdaptiveInputThrottle(false)
+	, AdaptiveThrottleFrameTimeThreshold(50.0f)
+	, AdaptiveThrottleMinDrainRate(64 * 1024)
+	, MaxInputEventsPerFrame(0)
+	, bSampleInputUnderLoad(false)
+	, InputSamplingTargetPerFrame(256)
+	, InputSamplingMinRate(0.01f)
+	, InteractiveHostsCacheLifetime(24.0f * 60.0f * 60.0f)
+	, bPipelinedStartup(false)
+	, bUseWarmStartCache(false)
+	, bUseLiveEventsForUserUpdates(true)
+	, bPreloadProjectAssets(true)
+	, bPersistBlueprintEventSource(false)
+	, bSeedSessionFromProjectDefinition(false)
+	, bReserveGeneratedControlHandles(false)
+	, bParseScenesOnDemand(false)
+	, ChatHistoryCapacity(10)
+	, ChatUserCacheCapacity(2000)
+	, ChatMembershipCoalesceWindow(1.0f)
+	, bQueueOutboundChat(true)
+	, ChatSendsPerSecond(1.0f)
+	, ChatSendBurst(5)
+	, MaxQueuedChatSends(100)
+	, ImageCacheBudgetMegabytes(32)
+	, bPackEmoticonsIntoAtlas(true)
+	, AvatarSize(64)
+	, AvatarFetchesPerSecond(10.0f)
+	, MaxConcurrentAvatarFetches(4)
+	, AvatarCacheCapacity(256)
+	, AccessTokenRefreshLeadTime(300.0f)
 {
 
 }
 
-#if WITH_EDITORONLY_DATA
+#if WITH_EDITOR
 
-void UMixerInteractivitySettings::GetAllControls(const FString& Kind, TArray<FString>& OutControls)
+void UMixerInteractivitySettings::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
 {
-	const UMixerInteractivitySettings* Settings = GetDefault<UMixerInteractivitySettings>();
-	UMixerProjectAsset* ProjectAsset = Cast<UMixerProjectAsset>(Settings->ProjectDefinition.TryLoad());
-	if (ProjectAsset != nullptr)
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	if (PropertyChangedEvent.GetPropertyName() == GET_MEMBER_NAME_CHECKED(UMixerInteractivitySettings, ProjectDefinition))
 	{
-		ProjectAsset->GetAllControls([Kind](const FMixerInteractiveControl& C) { return C.Kind == Kind; }, OutControls);
+		InvalidateControlIndex();
+		FMixerProjectAssetPreloader::Get().Start();
 	}
 }
 
-void UMixerInteractivitySettings::GetAllUnmappedCustomControls(TArray<FString>& OutCustomControls)
+#endif
+
+#if WITH_EDITORONLY_DATA
+
+namespace
 {
-	const UMixerInteractivitySettings* Settings = GetDefault<UMixerInteractivitySettings>();
-	UMixerProjectAsset* ProjectAsset = Cast<UMixerProjectAsset>(Settings->ProjectDefinition.TryLoad());
-	if (ProjectAsset != nullptr)
+	/**
+	 * Control ids from the configured project definition, grouped and sorted for display.
+	 * Blueprint nodes query this on every menu build and compile, so it is only
+	 * rebuilt when the definition is invalidated rather than walking the asset each time.
+	 */
+	struct FMixerControlNameIndex
+	{
+		TMap<FString, TArray<FString>> SortedIdsByKind;
+		TMap<FString, TSet<FString>> IdSetsByKind;
+		TArray<FString> SortedUnmappedCustomControls;
+		bool bValid = false;
+
+		void Rebuild()
+		{
+			SortedIdsByKind.Empty();
+			IdSetsByKind.Empty();
+			SortedUnmappedCustomControls.Empty();
+			bValid = true;
+
+			// Editor only, and the blueprint nodes asking for this can't wait for the preload
+			UMixerProjectAsset* ProjectAsset = FMixerProjectAssetPreloader::Get().GetProjectDefinition(true);
+			if (ProjectAsset == nullptr)
+			{
+				return;
+			}
+
+			for (const FMixerInteractiveScene& Scene : ProjectAsset->ParsedProjectDefinition.Controls.Scenes)
+			{
+				for (const FMixerInteractiveControl& Control : Scene.Controls)
+				{
+					bool bAlreadyIndexed = false;
+					IdSetsByKind.FindOrAdd(Control.Kind).Add(Control.Id, &bAlreadyIndexed);
+					if (!bAlreadyIndexed)
+					{
+						SortedIdsByKind.FindOrAdd(Control.Kind).Add(Control.Id);
+						if (Control.IsCustom() && !ProjectAsset->CustomControlMappings.Contains(*Control.Id))
+						{
+							SortedUnmappedCustomControls.Add(Control.Id);
+						}
+					}
+				}
+			}
+
+			for (TMap<FString, TArray<FString>>::TIterator It(SortedIdsByKind); It; ++It)
+			{
+				It->Value.Sort();
+			}
+			SortedUnmappedCustomControls.Sort();
+		}
+	};
+
+	FMixerControlNameIndex ControlNameIndex;
+
+	const FMixerControlNameIndex& GetControlNameIndex()
 	{
-		auto IsSimpleCustomControl = [ProjectAsset](const FMixerInteractiveControl& C)
+		if (!ControlNameIndex.bValid)
 		{
-			return C.IsCustom() && !ProjectAsset->CustomControlMappings.Contains(*C.Id);
-		};
-		ProjectAsset->GetAllControls(IsSimpleCustomControl, OutCustomControls);
+			ControlNameIndex.Rebuild();
+		}
+		return ControlNameIndex;
 	}
 }
 
+void UMixerInteractivitySettings::GetAllControls(const FString& Kind, TArray<FString>& OutControls)
+{
+	const TArray<FString>* Controls = GetControlNameIndex().SortedIdsByKind.Find(Kind);
+	if (Controls != nullptr)
+	{
+		OutControls.Append(*Controls);
+	}
+}
+
+void UMixerInteractivitySettings::GetAllUnmappedCustomControls(TArray<FString>& OutCustomControls)
+{
+	OutCustomControls.Append(GetControlNameIndex().SortedUnmappedCustomControls);
+}
+
+bool UMixerInteractivitySettings::HasControl(const FString& Kind, const FString& ControlId)
+{
+	const TSet<FString>* Controls = GetControlNameIndex().IdSetsByKind.Find(Kind);
+	return Controls != nullptr && Controls->Contains(ControlId);
+}
+
+void UMixerInteractivitySettings::InvalidateControlIndex()
+{
+	ControlNameIndex.bValid = false;
+}
+
 #endif
\ No newline at end of file
@@ -0,0 +1,42 @@
+//*********************************************************
+//
+// Copyright (c) Microsoft. All rights reserved.
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT.
+//
+//*********************************************************
+
+#pragma once
+
+#include "Stats/Stats.h"
+
+DECLARE_STATS_GROUP(TEXT("Mixer Interactivity"), STATGROUP_MixerInteractivity, STATCAT_Advanced);
+
+// Web socket traffic, across every Mixer connection (interactive, chat and constellation).
+// These live in the socket owner template, so they are defined once in MixerInteractivityModulePrivate.cpp.
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Socket message receive"), STAT_MixerSocketReceive, STATGROUP_MixerInteractivity, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Socket message parse (worker)"), STAT_MixerSocketParse, STATGROUP_MixerInteractivity, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Socket message dispatch"), STAT_MixerSocketDispatch, STATGROUP_MixerInteractivity, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Socket outbound flush"), STAT_MixerSocketFlush, STATGROUP_MixerInteractivity, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Messages in"), STAT_MixerMessagesIn, STATGROUP_MixerInteractivity, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Messages out"), STAT_MixerMessagesOut, STATGROUP_MixerInteractivity, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Bytes in"), STAT_MixerBytesIn, STATGROUP_MixerInteractivity, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Bytes out"), STAT_MixerBytesOut, STATGROUP_MixerInteractivity, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Bulk messages held back"), STAT_MixerBulkMessagesHeldBack, STATGROUP_MixerInteractivity, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Pending replies"), STAT_MixerPendingReplies, STATGROUP_MixerInteractivity, );
+
+// Connection health, from the pings sent by the socket owner.  Chat shows whichever room replied most recently.
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Interactive round trip (ms)"), STAT_MixerInteractiveRoundTrip, STATGROUP_MixerInteractivity, );
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Interactive jitter (ms)"), STAT_MixerInteractiveJitter, STATGROUP_MixerInteractivity, );
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Chat round trip (ms)"), STAT_MixerChatRoundTrip, STATGROUP_MixerInteractivity, );
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Chat jitter (ms)"), STAT_MixerChatJitter, STATGROUP_MixerInteractivity, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Missed pings"), STAT_MixerMissedPings, STATGROUP_MixerInteractivity, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Connection failovers"), STAT_MixerConnectionFailovers, STATGROUP_MixerInteractivity, );
+
+// Game thread heap allocations per frame, while UMixerInteractivitySettings::bGuardTickAllocations is on.
+// These are defined in MixerInteractivityModulePrivate.cpp.
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Tick allocations"), STAT_MixerTickAllocations, STATGROUP_MixerInteractivity, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Dispatch allocations"), STAT_MixerDispatchAllocations, STATGROUP_MixerInteractivity, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Broadcast allocations"), STAT_MixerBroadcastAllocations, STATGROUP_MixerInteractivity, );
@@ -9,6 +9,106 @@
 //*********************************************************
 
 #include "MixerInteractivityTypes.h"
+#include "Containers/Set.h"
+#include "Misc/ScopeLock.h"
+
+namespace
+{
+	typedef TSharedRef<const FString, ESPMode::ThreadSafe> FInternedUserName;
+
+	// Keyed by the string itself, so the table holds no copy of its own
+	struct FInternedUserNameKeyFuncs : BaseKeyFuncs<FInternedUserName, FString>
+	{
+		static const FString& GetSetKey(const FInternedUserName& Element)	{ return *Element; }
+		static bool Matches(const FString& A, const FString& B)				{ return A.Equals(B, ESearchCase::CaseSensitive); }
+		static uint32 GetKeyHash(const FString& Key)						{ return GetTypeHash(Key); }
+	};
+
+	// Names may be assigned off the game thread (the interactive-cpp v2 worker builds participant records), hence the lock
+	struct FUserNameTable
+	{
+		FCriticalSection Lock;
+		TSet<FInternedUserName, FInternedUserNameKeyFuncs> Names;
+		FInternedUserName Empty;
+		int32 NumAfterLastTrim;
+
+		FUserNameTable()
+			: Empty(MakeShared<const FString, ESPMode::ThreadSafe>())
+			, NumAfterLastTrim(0)
+		{
+		}
+
+		FInternedUserName Intern(const FString& Name)
+		{
+			if (Name.IsEmpty())
+			{
+				return Empty;
+			}
+
+			FScopeLock ScopeLock(&Lock);
+			if (const FInternedUserName* Existing = Names.Find(Name))
+			{
+				return *Existing;
+			}
+
+			FInternedUserName NewName = MakeShared<const FString, ESPMode::ThreadSafe>(Name);
+			Names.Add(NewName);
+			return NewName;
+		}
+
+		void TrimUnused()
+		{
+			FScopeLock ScopeLock(&Lock);
+
+			// Only sweep once the table has doubled, so that calling this every frame is cheap
+			if (Names.Num() <= 2 * NumAfterLastTrim + 64)
+			{
+				return;
+			}
+
+			for (TSet<FInternedUserName, FInternedUserNameKeyFuncs>::TIterator It(Names); It; ++It)
+			{
+				// Nothing but the table can hand out new references, and we hold its lock
+				if (It->IsUnique())
+				{
+					It.RemoveCurrent();
+				}
+			}
+			NumAfterLastTrim = Names.Num();
+		}
+	};
+
+	FUserNameTable& GetUserNameTable()
+	{
+		static FUserNameTable Table;
+		return Table;
+	}
+}
+
+FMixerUserName::FMixerUserName()
+	: Interned(GetUserNameTable().Empty)
+{
+}
+
+FMixerUserName::FMixerUserName(const FString& InName)
+	: Interned(GetUserNameTable().Intern(InName))
+{
+}
+
+FMixerUserName& FMixerUserName::operator=(const FString& InName)
+{
+	// Participant updates usually repeat the name we already have
+	if (!Interned->Equals(InName, ESearchCase::CaseSensitive))
+	{
+		Interned = GetUserNameTable().Intern(InName);
+	}
+	return *this;
+}
+
+void FMixerUserName::TrimUnused()
+{
+	GetUserNameTable().TrimUnused();
+}
 
 FMixerUser::FMixerUser()
 	: Id(0)
@@ -37,6 +137,8 @@ FMixerRemoteUser::FMixerRemoteUser()
 	: InputEnabled(false)
 	, ConnectedAt(FDateTime::MinValue())
 	, InputAt(FDateTime::MinValue())
+	, ChannelRelationship(EMixerChannelRelationship::None)
+	, ChannelRelationshipKnown(false)
 {
 
 }
\ No newline at end of file
@@ -0,0 +1,131 @@
+//*********************************************************
+//
+// Copyright (c) Microsoft. All rights reserved.
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT.
+//
+//*********************************************************
+
+#include "MixerInteractivityUserSettings.h"
+#include "MixerInteractivityLog.h"
+#include "Containers/Ticker.h"
+#include "Misc/ConfigCacheIni.h"
+#include "Async/TaskGraphInterfaces.h"
+
+namespace
+{
+	// Token refresh, login and endpoint changes tend to arrive in bursts; one write covers them all.
+	const float UserSettingsSaveDelaySeconds = 2.0f;
+	// Keeps a steady trickle of changes from putting the write off indefinitely.
+	const double UserSettingsMaxSaveDelaySeconds = 10.0;
+
+	class FMixerUserSettingsWriter
+	{
+	public:
+		static FMixerUserSettingsWriter& Get()
+		{
+			static FMixerUserSettingsWriter Instance;
+			return Instance;
+		}
+
+		void RequestSave()
+		{
+			check(IsInGameThread());
+			const double Now = FPlatformTime::Seconds();
+			if (DelayHandle.IsValid())
+			{
+				// Restart the delay from this write, up to the limit
+				FTicker::GetCoreTicker().RemoveTicker(DelayHandle);
+			}
+			else
+			{
+				FirstRequestTime = Now;
+			}
+			const float Delay = FMath::Max(static_cast<float>(FMath::Min<double>(UserSettingsSaveDelaySeconds, FirstRequestTime + UserSettingsMaxSaveDelaySeconds - Now)), 0.0f);
+			DelayHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FMixerUserSettingsWriter::OnDelayElapsed), Delay);
+		}
+
+		void Flush()
+		{
+			check(IsInGameThread());
+			if (DelayHandle.IsValid())
+			{
+				FTicker::GetCoreTicker().RemoveTicker(DelayHandle);
+				DelayHandle.Reset();
+				StartWrite();
+			}
+			WaitForWrite();
+		}
+
+	private:
+		bool OnDelayElapsed(float DeltaTime)
+		{
+			DelayHandle.Reset();
+			StartWrite();
+			return false;
+		}
+
+		void StartWrite()
+		{
+			UMixerInteractivityUserSettings* UserSettings = GetMutableDefault<UMixerInteractivityUserSettings>();
+			// globaluserconfig, so not the class's own config file
+			const FString Filename = UserSettings->GetGlobalUserConfigFilename();
+			FConfigFile* LiveFile = GConfig != nullptr ? GConfig->Find(Filename, false) : nullptr;
+			if (LiveFile == nullptr)
+			{
+				UserSettings->SaveConfig();
+				return;
+			}
+
+			// Only one write at a time, so that an older snapshot can never land on top of a newer one.
+			WaitForWrite();
+
+			// Properties are exported into a temporary cache, which never flushes, and the result
+			// adopted by GConfig.  Only the disk write is left for the worker.
+			FConfigCacheIni CaptureCache(EConfigCacheType::Temporary);
+			CaptureCache.Add(Filename, *LiveFile);
+			UserSettings->SaveConfig(CPF_Config, *Filename, &CaptureCache);
+			FConfigFile* Captured = CaptureCache.Find(Filename, false);
+			check(Captured != nullptr);
+
+			TSharedRef<FConfigFile> Snapshot = MakeShared<FConfigFile>(*Captured);
+			*LiveFile = *Captured;
+			// We're about to write it, so GConfig needn't do so again.
+			LiveFile->Dirty = false;
+
+			WriteTask = FFunctionGraphTask::CreateAndDispatchWhenReady([Snapshot, Filename]()
+			{
+				if (!Snapshot->Write(Filename))
+				{
+					UE_LOG(LogMixerInteractivity, Warning, TEXT("Failed to save Mixer user settings to %s."), *Filename);
+				}
+			}, TStatId(), nullptr, ENamedThreads::AnyThread);
+		}
+
+		void WaitForWrite()
+		{
+			if (WriteTask.IsValid())
+			{
+				FTaskGraphInterface::Get().WaitUntilTaskCompletes(WriteTask);
+				WriteTask.SafeRelease();
+			}
+		}
+
+		FDelegateHandle DelayHandle;
+		double FirstRequestTime = 0.0;
+		FGraphEventRef WriteTask;
+	};
+}
+
+void UMixerInteractivityUserSettings::SaveConfigDeferred()
+{
+	check(this == GetDefault<UMixerInteractivityUserSettings>());
+	FMixerUserSettingsWriter::Get().RequestSave();
+}
+
+void UMixerInteractivityUserSettings::FlushDeferredSave()
+{
+	FMixerUserSettingsWriter::Get().Flush();
+}
@@ -0,0 +1,301 @@
+//*********************************************************
+//
+// Copyright (c) Microsoft. All rights reserved.
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT.
+//
+//*********************************************************
+#include "MixerJsonArena.h"
+#include "Misc/ScopeLock.h"
+#include "MixerInteractivityLLM.h"
+
+namespace
+{
+	// Comfortably holds the DOM of a typical input or participant message.
+	const SIZE_T ArenaBlockSize = 4096;
+
+	// Enough to cover a burst of messages in flight at once without holding on to much at idle.
+	const int32 MaxPooledArenaBlocks = 32;
+
+	/** Arenas are created on the parse worker and usually released on the game thread, so the pool is shared. */
+	class FArenaBlockPool
+	{
+	public:
+		~FArenaBlockPool()
+		{
+			for (uint8* Block : FreeBlocks)
+			{
+				FMemory::Free(Block);
+			}
+		}
+
+		uint8* Acquire()
+		{
+			{
+				FScopeLock Lock(&FreeBlocksLock);
+				if (FreeBlocks.Num() > 0)
+				{
+					return FreeBlocks.Pop(false);
+				}
+			}
+
+			MIXER_LLM_SCOPE(Messages);
+			return static_cast<uint8*>(FMemory::Malloc(ArenaBlockSize));
+		}
+
+		void Release(uint8* Block)
+		{
+			{
+				FScopeLock Lock(&FreeBlocksLock);
+				if (FreeBlocks.Num() < MaxPooledArenaBlocks)
+				{
+					FreeBlocks.Add(Block);
+					return;
+				}
+			}
+
+			FMemory::Free(Block);
+		}
+
+	private:
+		FCriticalSection FreeBlocksLock;
+		TArray<uint8*, TInlineAllocator<MaxPooledArenaBlocks>> FreeBlocks;
+	};
+
+	FArenaBlockPool& GetArenaBlockPool()
+	{
+		static FArenaBlockPool Pool;
+		return Pool;
+	}
+
+	/** Lets the deserializer fill in an arena array in place rather than building a TArray and copying it. */
+	class FMixerJsonValueArray : public FJsonValueArray
+	{
+	public:
+		FMixerJsonValueArray()
+			: FJsonValueArray(TArray<TSharedPtr<FJsonValue>>())
+		{
+		}
+
+		void Add(TSharedPtr<FJsonValue>&& Element)
+		{
+			Value.Add(MoveTemp(Element));
+		}
+	};
+
+	/** Container still being read.  Exactly one of Object and Array is set. */
+	struct FOpenContainer
+	{
+		FOpenContainer()
+			: Array(nullptr)
+		{
+		}
+
+		FString Identifier;
+		TSharedPtr<FJsonObject> Object;
+		TSharedPtr<FJsonValue> ArrayValue;
+		FMixerJsonValueArray* Array;
+	};
+}
+
+TSharedRef<FMixerJsonArena, ESPMode::ThreadSafe> FMixerJsonArena::Create()
+{
+	return MakeShareable(new FMixerJsonArena());
+}
+
+FMixerJsonArena::FMixerJsonArena()
+	: Cursor(nullptr)
+	, End(nullptr)
+{
+}
+
+FMixerJsonArena::~FMixerJsonArena()
+{
+	FArenaBlockPool& Pool = GetArenaBlockPool();
+	for (uint8* Block : Blocks)
+	{
+		Pool.Release(Block);
+	}
+}
+
+void* FMixerJsonArena::Allocate(SIZE_T Size, SIZE_T Alignment)
+{
+	check(Size <= ArenaBlockSize);
+
+	uint8* Aligned = Align(Cursor, Alignment);
+	if (Cursor == nullptr || Aligned + Size > End)
+	{
+		uint8* Block = GetArenaBlockPool().Acquire();
+		Blocks.Add(Block);
+		End = Block + ArenaBlockSize;
+		Aligned = Align(Block, Alignment);
+	}
+
+	Cursor = Aligned + Size;
+	return Aligned;
+}
+
+bool FMixerJsonArena::Deserialize(const TSharedRef<TJsonReader<>>& Reader, TSharedPtr<FJsonObject>& OutObject)
+{
+	TArray<FOpenContainer, TInlineAllocator<16>> OpenContainers;
+	TSharedPtr<FJsonObject> Root;
+
+	EJsonNotation Notation;
+	while (Reader->ReadNext(Notation))
+	{
+		FString Identifier;
+		TSharedPtr<FJsonValue> NewValue;
+		switch (Notation)
+		{
+		case EJsonNotation::ObjectStart:
+		{
+			FOpenContainer& Opened = OpenContainers[OpenContainers.AddDefaulted()];
+			Opened.Identifier = Reader->GetIdentifier();
+			Opened.Object = New<FJsonObject>();
+			continue;
+		}
+
+		case EJsonNotation::ArrayStart:
+		{
+			FOpenContainer& Opened = OpenContainers[OpenContainers.AddDefaulted()];
+			Opened.Identifier = Reader->GetIdentifier();
+			TSharedRef<FMixerJsonValueArray> Array = New<FMixerJsonValueArray>();
+			Opened.Array = &Array.Get();
+			Opened.ArrayValue = Array;
+			continue;
+		}
+
+		case EJsonNotation::ObjectEnd:
+		case EJsonNotation::ArrayEnd:
+		{
+			if (OpenContainers.Num() == 0)
+			{
+				return false;
+			}
+
+			FOpenContainer Closed = MoveTemp(OpenContainers.Last());
+			OpenContainers.Pop(false);
+			if (OpenContainers.Num() == 0)
+			{
+				// Like FJsonSerializer, only an object is accepted at the top level.
+				Root = Closed.Object;
+				continue;
+			}
+
+			Identifier = MoveTemp(Closed.Identifier);
+			if (Closed.Object.IsValid())
+			{
+				NewValue = New<FJsonValueObject>(Closed.Object);
+			}
+			else
+			{
+				NewValue = MoveTemp(Closed.ArrayValue);
+			}
+			break;
+		}
+
+		case EJsonNotation::String:
+			Identifier = Reader->GetIdentifier();
+			NewValue = New<FJsonValueString>(Reader->GetValueAsString());
+			break;
+
+		case EJsonNotation::Number:
+			Identifier = Reader->GetIdentifier();
+			NewValue = New<FJsonValueNumber>(Reader->GetValueAsNumber());
+			break;
+
+		case EJsonNotation::Boolean:
+			Identifier = Reader->GetIdentifier();
+			NewValue = New<FJsonValueBoolean>(Reader->GetValueAsBoolean());
+			break;
+
+		case EJsonNotation::Null:
+			Identifier = Reader->GetIdentifier();
+			NewValue = New<FJsonValueNull>();
+			break;
+
+		default:
+			return false;
+		}
+
+		if (OpenContainers.Num() == 0)
+		{
+			return false;
+		}
+
+		FOpenContainer& Parent = OpenContainers.Last();
+		if (Parent.Object.IsValid())
+		{
+			Parent.Object->Values.Add(MoveTemp(Identifier), MoveTemp(NewValue));
+		}
+		else
+		{
+			Parent.Array->Add(MoveTemp(NewValue));
+		}
+	}
+
+	if (!Reader->GetErrorMessage().IsEmpty() || !Root.IsValid())
+	{
+		return false;
+	}
+
+	OutObject = MoveTemp(Root);
+	return true;
+}
+
+namespace MixerJsonArena
+{
+	TSharedPtr<FJsonValue> DeepCopy(const TSharedPtr<FJsonValue>& Value)
+	{
+		if (!Value.IsValid())
+		{
+			return nullptr;
+		}
+
+		switch (Value->Type)
+		{
+		case EJson::String:
+			return MakeShared<FJsonValueString>(Value->AsString());
+
+		case EJson::Number:
+			return MakeShared<FJsonValueNumber>(Value->AsNumber());
+
+		case EJson::Boolean:
+			return MakeShared<FJsonValueBoolean>(Value->AsBool());
+
+		case EJson::Array:
+		{
+			const TArray<TSharedPtr<FJsonValue>>& SourceArray = Value->AsArray();
+			TArray<TSharedPtr<FJsonValue>> CopiedArray;
+			CopiedArray.Reserve(SourceArray.Num());
+			for (const TSharedPtr<FJsonValue>& Element : SourceArray)
+			{
+				CopiedArray.Add(DeepCopy(Element));
+			}
+			return MakeShared<FJsonValueArray>(CopiedArray);
+		}
+
+		case EJson::Object:
+		{
+			const TSharedPtr<FJsonObject> SourceObject = Value->AsObject();
+			return MakeShared<FJsonValueObject>(SourceObject.IsValid() ? TSharedPtr<FJsonObject>(DeepCopy(*SourceObject)) : TSharedPtr<FJsonObject>());
+		}
+
+		default:
+			return MakeShared<FJsonValueNull>();
+		}
+	}
+
+	TSharedRef<FJsonObject> DeepCopy(const FJsonObject& Object)
+	{
+		TSharedRef<FJsonObject> Copy = MakeShared<FJsonObject>();
+		Copy->Values.Reserve(Object.Values.Num());
+		for (const TPair<FString, TSharedPtr<FJsonValue>>& Field : Object.Values)
+		{
+			Copy->Values.Add(Field.Key, DeepCopy(Field.Value));
+		}
+		return Copy;
+	}
+}
@@ -0,0 +1,75 @@
+//*********************************************************
+//
+// Copyright (c) Microsoft. All rights reserved.
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT.
+//
+//*********************************************************
+#pragma once
+
+#include "Dom/JsonValue.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Templates/SharedPointer.h"
+
+/**
+ * Linear allocator for the DOM of a single decoded message.  Objects and values are placed one after
+ * another in pooled blocks, and the blocks go back to the pool in one go once the last node of the
+ * message has been released, rather than each node being freed individually.
+ *
+ * Nodes are still ordinary TSharedPtrs and each keeps its arena alive, so holding on to part of a
+ * message is safe - but it pins the whole message's blocks.  Anything kept beyond the handler should
+ * be copied out with MixerJsonArena::DeepCopy.
+ */
+class FMixerJsonArena : public TSharedFromThis<FMixerJsonArena, ESPMode::ThreadSafe>
+{
+public:
+	static TSharedRef<FMixerJsonArena, ESPMode::ThreadSafe> Create();
+
+	~FMixerJsonArena();
+
+	/** Arena counterpart of FJsonSerializer::Deserialize for an object at the top level. */
+	bool Deserialize(const TSharedRef<TJsonReader<>>& Reader, TSharedPtr<FJsonObject>& OutObject);
+
+	template <typename NodeType, typename... ArgTypes>
+	TSharedRef<NodeType> New(ArgTypes&&... Args)
+	{
+		NodeType* Node = new (Allocate(sizeof(NodeType), alignof(NodeType))) NodeType(Forward<ArgTypes>(Args)...);
+		return MakeShareable(Node, FNodeDeleter(AsShared()));
+	}
+
+private:
+	FMixerJsonArena();
+
+	void* Allocate(SIZE_T Size, SIZE_T Alignment);
+
+	/** Runs the node's destructor only; the memory goes when the arena does. */
+	struct FNodeDeleter
+	{
+		explicit FNodeDeleter(TSharedRef<FMixerJsonArena, ESPMode::ThreadSafe>&& InArena)
+			: Arena(MoveTemp(InArena))
+		{
+		}
+
+		template <typename NodeType>
+		void operator()(NodeType* Node) const
+		{
+			Node->~NodeType();
+		}
+
+		TSharedRef<FMixerJsonArena, ESPMode::ThreadSafe> Arena;
+	};
+
+	TArray<uint8*, TInlineAllocator<4>> Blocks;
+	uint8* Cursor;
+	uint8* End;
+};
+
+namespace MixerJsonArena
+{
+	/** Heap copies, independent of any arena, for data that outlives the message it arrived in. */
+	TSharedPtr<FJsonValue> DeepCopy(const TSharedPtr<FJsonValue>& Value);
+	TSharedRef<FJsonObject> DeepCopy(const FJsonObject& Object);
+}
@@ -13,121 +13,325 @@ namespace MixerStringConstants
 {
 	namespace MessageTypes
 	{
-		const FString Method = TEXT("method");
-		const FString Reply = TEXT("reply");
-		const FString Event = TEXT("event");
+		const FMixerStringConstant Method(TEXT("method"));
+		const FMixerStringConstant Reply(TEXT("reply"));
+		const FMixerStringConstant Event(TEXT("event"));
 	}
 
 	namespace MethodNames
 	{
-		const FString Auth = TEXT("auth");
-		const FString Msg = TEXT("msg");
-		const FString Whisper = TEXT("whisper");
-		const FString History = TEXT("history");
-		const FString VoteStart = TEXT("vote:start");
-		const FString VoteChoose = TEXT("vote:choose");
+		const FMixerStringConstant Auth(TEXT("auth"));
+		const FMixerStringConstant Msg(TEXT("msg"));
+		const FMixerStringConstant Whisper(TEXT("whisper"));
+		const FMixerStringConstant History(TEXT("history"));
+		const FMixerStringConstant VoteStart(TEXT("vote:start"));
+		const FMixerStringConstant VoteChoose(TEXT("vote:choose"));
+		const FMixerStringConstant Ping(TEXT("ping"));
 
-		const FString Ready = TEXT("ready");
-		const FString UpdateGroups = TEXT("updateGroups");
-		const FString CreateGroups = TEXT("createGroups");
-		const FString UpdateParticipants = TEXT("updateParticipants");
-		const FString Capture = TEXT("capture");
-		const FString GetScenes = TEXT("getScenes");
+		const FMixerStringConstant Ready(TEXT("ready"));
+		const FMixerStringConstant UpdateGroups(TEXT("updateGroups"));
+		const FMixerStringConstant CreateGroups(TEXT("createGroups"));
+		const FMixerStringConstant UpdateParticipants(TEXT("updateParticipants"));
+		const FMixerStringConstant Capture(TEXT("capture"));
+		const FMixerStringConstant GetScenes(TEXT("getScenes"));
+		const FMixerStringConstant SetBandwidthThrottle(TEXT("setBandwidthThrottle"));
+		const FMixerStringConstant GetActiveParticipants(TEXT("getActiveParticipants"));
+		const FMixerStringConstant GetTime(TEXT("getTime"));
+		const FMixerStringConstant UpdateControls(TEXT("updateControls"));
+
+		const FMixerStringConstant LiveSubscribe(TEXT("livesubscribe"));
 	}
 
 	namespace EventTypes
 	{
-		const FString Welcome = TEXT("WelcomeEvent");
-		const FString ChatMessage = TEXT("ChatMessage");
-		const FString UserJoin = TEXT("UserJoin");
-		const FString UserLeave = TEXT("UserLeave");
-		const FString DeleteMessage = TEXT("DeleteMessage");
-		const FString ClearMessages = TEXT("ClearMessages");
-		const FString PurgeMessage = TEXT("PurgeMessage");
-		const FString PollStart = TEXT("PollStart");
-		const FString PollEnd = TEXT("PollEnd");
+		const FMixerStringConstant Welcome(TEXT("WelcomeEvent"));
+		const FMixerStringConstant ChatMessage(TEXT("ChatMessage"));
+		const FMixerStringConstant UserJoin(TEXT("UserJoin"));
+		const FMixerStringConstant UserLeave(TEXT("UserLeave"));
+		const FMixerStringConstant DeleteMessage(TEXT("DeleteMessage"));
+		const FMixerStringConstant ClearMessages(TEXT("ClearMessages"));
+		const FMixerStringConstant PurgeMessage(TEXT("PurgeMessage"));
+		const FMixerStringConstant PollStart(TEXT("PollStart"));
+		const FMixerStringConstant PollEnd(TEXT("PollEnd"));
+
+		const FMixerStringConstant Live(TEXT("live"));
 
-		const FString MouseDown = TEXT("mousedown");
-		const FString MouseUp = TEXT("mouseup");
-		const FString Move = TEXT("move");
-		const FString Submit = TEXT("submit");
+		const FMixerStringConstant MouseDown(TEXT("mousedown"));
+		const FMixerStringConstant MouseUp(TEXT("mouseup"));
+		const FMixerStringConstant Move(TEXT("move"));
+		const FMixerStringConstant Submit(TEXT("submit"));
 	}
 
 	namespace FieldNames
 	{
-		const FString Type = TEXT("type");
-		const FString Event = TEXT("event");
-		const FString Data = TEXT("data");
-		const FString Message = TEXT("message");
-		const FString UserNameNoUnderscore = TEXT("username");
-		const FString UserNameWithUnderscore = TEXT("user_name");
-		const FString Id = TEXT("id");
-		const FString Meta = TEXT("meta");
-		const FString Me = TEXT("me");
-		const FString Whisper = TEXT("whisper");
-		const FString Method = TEXT("method");
-		const FString Arguments = TEXT("arguments");
-		const FString Params = TEXT("params");
-		const FString Error = TEXT("error");
-		const FString Text = TEXT("text");
-		const FString Endpoints = TEXT("endpoints");
-		const FString AuthKey = TEXT("authkey");
-		const FString UserIdNoUnderscore = TEXT("userID");
-		const FString UserIdWithUnderscore = TEXT("user_id");
-		const FString UserLevel = TEXT("user_level");
-		const FString Q = TEXT("q");
-		const FString EndsAt = TEXT("endsAt");
-		const FString Voters = TEXT("voters");
-		const FString Answers = TEXT("answers");
-		const FString ResponsesByIndex = TEXT("responsesByIndex");
-		const FString Author = TEXT("author");
-		const FString Permissions = TEXT("permissions");
-		const FString Level = TEXT("level");
-		const FString LastInputAt = TEXT("lastInputAt");
-		const FString ConnectedAt = TEXT("connectedAt");
-		const FString GroupId = TEXT("groupID");
-		const FString SessionId = TEXT("sessionID");
-		const FString Participants = TEXT("participants");
-		const FString IsReady = TEXT("isReady");
-		const FString ParticipantId = TEXT("participantID");
-		const FString Input = TEXT("input");
-		const FString TransactionId = TEXT("transactionID");
-		const FString ControlId = TEXT("controlID");
-		const FString X = TEXT("x");
-		const FString Y = TEXT("y");
-		const FString SceneId = TEXT("sceneID");
-		const FString Scenes = TEXT("scenes");
-		const FString Controls = TEXT("controls");
-		const FString Kind = TEXT("kind");
-		const FString Cost = TEXT("cost");
-		const FString Cooldown = TEXT("cooldown");
-		const FString Disabled = TEXT("disabled");
-		const FString Tooltip = TEXT("tooltip");
-		const FString Progress = TEXT("progress");
-		const FString Result = TEXT("result");
-		const FString Value = TEXT("value");
-		const FString TextSize = TEXT("textSize");
-		const FString TextColor = TEXT("textColor");
-		const FString Underline = TEXT("underline");
-		const FString Bold = TEXT("bold");
-		const FString Italic = TEXT("italic");
-		const FString Placeholder = TEXT("placeholder");
-		const FString HasSubmit = TEXT("hasSubmit");
-		const FString Multiline = TEXT("multiline");
-		const FString SubmitText = TEXT("submitText");
-		const FString Groups = TEXT("groups");
-		const FString ReassignGroupId = TEXT("reassignGroupId");
+		const FMixerStringConstant Type(TEXT("type"));
+		const FMixerStringConstant Event(TEXT("event"));
+		const FMixerStringConstant Data(TEXT("data"));
+		const FMixerStringConstant Events(TEXT("events"));
+		const FMixerStringConstant Channel(TEXT("channel"));
+		const FMixerStringConstant Payload(TEXT("payload"));
+		const FMixerStringConstant Message(TEXT("message"));
+		const FMixerStringConstant UserNameNoUnderscore(TEXT("username"));
+		const FMixerStringConstant UserNameWithUnderscore(TEXT("user_name"));
+		const FMixerStringConstant Id(TEXT("id"));
+		const FMixerStringConstant Meta(TEXT("meta"));
+		const FMixerStringConstant Me(TEXT("me"));
+		const FMixerStringConstant Whisper(TEXT("whisper"));
+		const FMixerStringConstant Method(TEXT("method"));
+		const FMixerStringConstant Arguments(TEXT("arguments"));
+		const FMixerStringConstant Params(TEXT("params"));
+		const FMixerStringConstant Error(TEXT("error"));
+		const FMixerStringConstant Text(TEXT("text"));
+		const FMixerStringConstant Endpoints(TEXT("endpoints"));
+		const FMixerStringConstant AuthKey(TEXT("authkey"));
+		const FMixerStringConstant UserIdNoUnderscore(TEXT("userID"));
+		const FMixerStringConstant UserIdWithUnderscore(TEXT("user_id"));
+		const FMixerStringConstant UserLevel(TEXT("user_level"));
+		const FMixerStringConstant Q(TEXT("q"));
+		const FMixerStringConstant EndsAt(TEXT("endsAt"));
+		const FMixerStringConstant Voters(TEXT("voters"));
+		const FMixerStringConstant Answers(TEXT("answers"));
+		const FMixerStringConstant ResponsesByIndex(TEXT("responsesByIndex"));
+		const FMixerStringConstant Author(TEXT("author"));
+		const FMixerStringConstant Permissions(TEXT("permissions"));
+		const FMixerStringConstant Level(TEXT("level"));
+		const FMixerStringConstant LastInputAt(TEXT("lastInputAt"));
+		const FMixerStringConstant ConnectedAt(TEXT("connectedAt"));
+		const FMixerStringConstant GroupId(TEXT("groupID"));
+		const FMixerStringConstant SessionId(TEXT("sessionID"));
+		const FMixerStringConstant Participants(TEXT("participants"));
+		const FMixerStringConstant Threshold(TEXT("threshold"));
+		const FMixerStringConstant IsReady(TEXT("isReady"));
+		const FMixerStringConstant ParticipantId(TEXT("participantID"));
+		const FMixerStringConstant Input(TEXT("input"));
+		const FMixerStringConstant TransactionId(TEXT("transactionID"));
+		const FMixerStringConstant ControlId(TEXT("controlID"));
+		const FMixerStringConstant X(TEXT("x"));
+		const FMixerStringConstant Y(TEXT("y"));
+		const FMixerStringConstant SceneId(TEXT("sceneID"));
+		const FMixerStringConstant Scenes(TEXT("scenes"));
+		const FMixerStringConstant Controls(TEXT("controls"));
+		const FMixerStringConstant Kind(TEXT("kind"));
+		const FMixerStringConstant Cost(TEXT("cost"));
+		const FMixerStringConstant Cooldown(TEXT("cooldown"));
+		const FMixerStringConstant Disabled(TEXT("disabled"));
+		const FMixerStringConstant Tooltip(TEXT("tooltip"));
+		const FMixerStringConstant Progress(TEXT("progress"));
+		const FMixerStringConstant Result(TEXT("result"));
+		const FMixerStringConstant Time(TEXT("time"));
+		const FMixerStringConstant ElementDeltas(TEXT("$deltas"));
+		const FMixerStringConstant Value(TEXT("value"));
+		const FMixerStringConstant TextSize(TEXT("textSize"));
+		const FMixerStringConstant TextColor(TEXT("textColor"));
+		const FMixerStringConstant Underline(TEXT("underline"));
+		const FMixerStringConstant Bold(TEXT("bold"));
+		const FMixerStringConstant Italic(TEXT("italic"));
+		const FMixerStringConstant Placeholder(TEXT("placeholder"));
+		const FMixerStringConstant HasSubmit(TEXT("hasSubmit"));
+		const FMixerStringConstant Multiline(TEXT("multiline"));
+		const FMixerStringConstant SubmitText(TEXT("submitText"));
+		const FMixerStringConstant Groups(TEXT("groups"));
+		const FMixerStringConstant ReassignGroupId(TEXT("reassignGroupId"));
+		const FMixerStringConstant Capacity(TEXT("capacity"));
+		const FMixerStringConstant DrainRate(TEXT("drainRate"));
+		const FMixerStringConstant Source(TEXT("source"));
+		const FMixerStringConstant Pack(TEXT("pack"));
+		const FMixerStringConstant Coords(TEXT("coords"));
+		const FMixerStringConstant Width(TEXT("width"));
+		const FMixerStringConstant Height(TEXT("height"));
+		const FMixerStringConstant Url(TEXT("url"));
 	}
 
 	namespace Permissions
 	{
-		const FString Connect = TEXT("connect");
-		const FString Chat = TEXT("chat");
-		const FString Whisper = TEXT("whisper");
-		const FString PollStart = TEXT("poll_start");
-		const FString PollVote = TEXT("poll_vote");
-		const FString ClearMessages = TEXT("clear_messages");
-		const FString Purge = TEXT("purge");
-		const FString GiveawayStart = TEXT("giveaway_start");
+		const FMixerStringConstant Connect(TEXT("connect"));
+		const FMixerStringConstant Chat(TEXT("chat"));
+		const FMixerStringConstant Whisper(TEXT("whisper"));
+		const FMixerStringConstant PollStart(TEXT("poll_start"));
+		const FMixerStringConstant PollVote(TEXT("poll_vote"));
+		const FMixerStringConstant ClearMessages(TEXT("clear_messages"));
+		const FMixerStringConstant Purge(TEXT("purge"));
+		const FMixerStringConstant GiveawayStart(TEXT("giveaway_start"));
+	}
+}
+
+FMixerJsonCursor::FMixerJsonCursor(TJsonReader<TCHAR>& InReader)
+	: Reader(InReader)
+	, Notation(EJsonNotation::Null)
+	, FieldNameHash(0)
+	, bFieldNameHashed(false)
+	, bFinished(false)
+	, bError(false)
+{
+}
+
+bool FMixerJsonCursor::NextField()
+{
+	if (bFinished)
+	{
+		return false;
+	}
+
+	// Don't let the caller walk into nested values - skip over them wholesale.
+	if (Notation == EJsonNotation::ObjectStart)
+	{
+		bError = !Reader.SkipObject();
+	}
+	else if (Notation == EJsonNotation::ArrayStart)
+	{
+		bError = !Reader.SkipArray();
+	}
+
+	bFieldNameHashed = false;
+	if (bError || !Reader.ReadNext(Notation))
+	{
+		bError = true;
+		bFinished = true;
+		return false;
+	}
+
+	if (Notation == EJsonNotation::ObjectEnd)
+	{
+		bFinished = true;
+		return false;
+	}
+	else if (Notation == EJsonNotation::Error)
+	{
+		bError = true;
+		bFinished = true;
+		return false;
+	}
+
+	return true;
+}
+
+bool FMixerJsonCursor::IsField(const FMixerStringConstant& Name) const
+{
+	const FString& FieldName = Reader.GetIdentifier();
+	if (FieldName.Len() != Name.Len())
+	{
+		return false;
+	}
+
+	if (!bFieldNameHashed)
+	{
+		FieldNameHash = FCrc::StrCrc32(*FieldName);
+		bFieldNameHashed = true;
+	}
+	return Name.Matches(FieldName, FieldNameHash);
+}
+
+bool FMixerJsonCursor::TryGetString(FString& OutValue) const
+{
+	if (Notation != EJsonNotation::String)
+	{
+		return false;
+	}
+
+	OutValue = Reader.GetValueAsString();
+	return true;
+}
+
+bool FMixerJsonCursor::TryAppendString(FString& OutBuffer) const
+{
+	if (Notation != EJsonNotation::String)
+	{
+		return false;
+	}
+
+	OutBuffer.Append(Reader.GetValueAsString());
+	return true;
+}
+
+bool FMixerJsonCursor::TryGetNumber(double& OutValue) const
+{
+	if (Notation != EJsonNotation::Number)
+	{
+		return false;
+	}
+
+	OutValue = Reader.GetValueAsNumber();
+	return true;
+}
+
+bool FMixerJsonCursor::TryGetNumber(int32& OutValue) const
+{
+	double DoubleValue;
+	if (!TryGetNumber(DoubleValue))
+	{
+		return false;
+	}
+
+	OutValue = static_cast<int32>(DoubleValue);
+	return true;
+}
+
+bool FMixerJsonCursor::TryGetBool(bool& OutValue) const
+{
+	if (Notation != EJsonNotation::Boolean)
+	{
+		return false;
+	}
+
+	OutValue = Reader.GetValueAsBoolean();
+	return true;
+}
+
+bool FMixerJsonCursor::TryReadObject(TFunctionRef<void(FMixerJsonCursor&)> Visitor)
+{
+	if (Notation != EJsonNotation::ObjectStart)
+	{
+		return false;
+	}
+
+	FMixerJsonCursor Nested(Reader);
+	Visitor(Nested);
+
+	// Drain whatever the visitor left so that the reader ends up after the object.
+	while (Nested.NextField())
+	{
+	}
+
+	// Already consumed - don't skip again on the next advance.
+	Notation = EJsonNotation::Null;
+	bError = Nested.HasError();
+	return !bError;
+}
+
+bool FMixerJsonCursor::TryReadObjectArray(TFunctionRef<void(FMixerJsonCursor&)> Visitor)
+{
+	if (Notation != EJsonNotation::ArrayStart)
+	{
+		return false;
+	}
+
+	Notation = EJsonNotation::Null;
+	EJsonNotation ElementNotation = EJsonNotation::Null;
+	while (!bError && Reader.ReadNext(ElementNotation) && ElementNotation != EJsonNotation::ArrayEnd)
+	{
+		if (ElementNotation == EJsonNotation::ObjectStart)
+		{
+			FMixerJsonCursor Nested(Reader);
+			Visitor(Nested);
+			while (Nested.NextField())
+			{
+			}
+			bError = Nested.HasError();
+		}
+		else if (ElementNotation == EJsonNotation::ArrayStart)
+		{
+			bError = !Reader.SkipArray();
+		}
+		else if (ElementNotation == EJsonNotation::Error)
+		{
+			bError = true;
+		}
+	}
+
+	if (bError || ElementNotation != EJsonNotation::ArrayEnd)
+	{
+		bError = true;
+		bFinished = true;
 	}
-}
\ No newline at end of file
+	return !bError;
+}
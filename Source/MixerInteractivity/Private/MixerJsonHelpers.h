@@ -12,131 +12,272 @@
 #include "Containers/UnrealString.h"
 #include "Dom/JsonValue.h"
 #include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "Interfaces/IHttpResponse.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "Misc/Crc.h"
 #include "MixerInteractivityLog.h"
 
+/**
+ * A protocol key or name whose length and hash are computed once, when the constant is initialized.
+ * The hash is FCrc::StrCrc32, as keyed on by the websocket message router, so either side of a
+ * comparison can reject a mismatch without rescanning the string.  Still an FString, so it can be
+ * passed straight to FJsonObject accessors and json writers.
+ */
+class FMixerStringConstant : public FString
+{
+public:
+	template <int32 N>
+	explicit FMixerStringConstant(const TCHAR (&Literal)[N])
+		: FString(N - 1, Literal)
+		, Hash(FCrc::StrCrc32(Literal))
+	{
+	}
+
+	uint32 GetHash() const { return Hash; }
+
+	/** Case sensitive, as json keys are.  CandidateHash must be FCrc::StrCrc32 of Candidate. */
+	bool Matches(const FString& Candidate, uint32 CandidateHash) const
+	{
+		return Candidate.Len() == Len() && CandidateHash == Hash && Candidate.Equals(*this, ESearchCase::CaseSensitive);
+	}
+
+private:
+	uint32 Hash;
+};
+
 namespace MixerStringConstants
 {
 	namespace MessageTypes
 	{
-		extern const FString Method;
-		extern const FString Reply;
-		extern const FString Event;
+		extern const FMixerStringConstant Method;
+		extern const FMixerStringConstant Reply;
+		extern const FMixerStringConstant Event;
 	}
 
 	namespace MethodNames
 	{
-		extern const FString Auth;
-		extern const FString Msg;
-		extern const FString Whisper;
-		extern const FString History;
-		extern const FString VoteStart;
-		extern const FString VoteChoose;
-
-		extern const FString Ready;
-		extern const FString UpdateGroups;
-		extern const FString CreateGroups;
-		extern const FString UpdateParticipants;
-		extern const FString Capture;
-		extern const FString GetScenes;
+		extern const FMixerStringConstant Auth;
+		extern const FMixerStringConstant Msg;
+		extern const FMixerStringConstant Whisper;
+		extern const FMixerStringConstant History;
+		extern const FMixerStringConstant VoteStart;
+		extern const FMixerStringConstant VoteChoose;
+		extern const FMixerStringConstant Ping;
+
+		extern const FMixerStringConstant Ready;
+		extern const FMixerStringConstant UpdateGroups;
+		extern const FMixerStringConstant CreateGroups;
+		extern const FMixerStringConstant UpdateParticipants;
+		extern const FMixerStringConstant Capture;
+		extern const FMixerStringConstant GetScenes;
+		extern const FMixerStringConstant SetBandwidthThrottle;
+		extern const FMixerStringConstant GetActiveParticipants;
+		extern const FMixerStringConstant GetTime;
+		extern const FMixerStringConstant UpdateControls;
+
+		extern const FMixerStringConstant LiveSubscribe;
 	}
 
 	namespace EventTypes
 	{
 		// Chat events
-		extern const FString Welcome;
-		extern const FString ChatMessage;
-		extern const FString UserJoin;
-		extern const FString UserLeave;
-		extern const FString DeleteMessage;
-		extern const FString ClearMessages;
-		extern const FString PurgeMessage;
-		extern const FString PollStart;
-		extern const FString PollEnd;
+		extern const FMixerStringConstant Welcome;
+		extern const FMixerStringConstant ChatMessage;
+		extern const FMixerStringConstant UserJoin;
+		extern const FMixerStringConstant UserLeave;
+		extern const FMixerStringConstant DeleteMessage;
+		extern const FMixerStringConstant ClearMessages;
+		extern const FMixerStringConstant PurgeMessage;
+		extern const FMixerStringConstant PollStart;
+		extern const FMixerStringConstant PollEnd;
+
+		// Constellation events
+		extern const FMixerStringConstant Live;
 
 		// Input events
-		extern const FString MouseDown;
-		extern const FString MouseUp;
-		extern const FString Move;
-		extern const FString Submit;
+		extern const FMixerStringConstant MouseDown;
+		extern const FMixerStringConstant MouseUp;
+		extern const FMixerStringConstant Move;
+		extern const FMixerStringConstant Submit;
 	}
 
 	namespace FieldNames
 	{
-		extern const FString Type;
-		extern const FString Event;
-		extern const FString Data;
-		extern const FString Message;
-		extern const FString UserNameNoUnderscore;
-		extern const FString UserNameWithUnderscore;
-		extern const FString Id;
-		extern const FString Meta;
-		extern const FString Me;
-		extern const FString Whisper;
-		extern const FString Method;
-		extern const FString Arguments;
-		extern const FString Params;
-		extern const FString Error;
-		extern const FString Text;
-		extern const FString Endpoints;
-		extern const FString AuthKey;
-		extern const FString UserIdNoUnderscore;
-		extern const FString UserIdWithUnderscore;
-		extern const FString UserLevel;
-		extern const FString Q;
-		extern const FString EndsAt;
-		extern const FString Voters;
-		extern const FString Answers;
-		extern const FString ResponsesByIndex;
-		extern const FString Author;
-		extern const FString Permissions;
-		extern const FString Level;
-		extern const FString LastInputAt;
-		extern const FString ConnectedAt;
-		extern const FString GroupId;
-		extern const FString SessionId;
-		extern const FString Participants;
-		extern const FString IsReady;
-		extern const FString ParticipantId;
-		extern const FString Input;
-		extern const FString TransactionId;
-		extern const FString ControlId;
-		extern const FString X;
-		extern const FString Y;
-		extern const FString SceneId;
-		extern const FString Scenes;
-		extern const FString Controls;
-		extern const FString Kind;
-		extern const FString Cost;
-		extern const FString Cooldown;
-		extern const FString Disabled;
-		extern const FString Tooltip;
-		extern const FString Progress;
-		extern const FString Result;
-		extern const FString Value;
-		extern const FString TextSize;
-		extern const FString TextColor;
-		extern const FString Underline;
-		extern const FString Bold;
-		extern const FString Italic;
-		extern const FString Placeholder;
-		extern const FString HasSubmit;
-		extern const FString Multiline;
-		extern const FString SubmitText;
-		extern const FString Groups;
-		extern const FString ReassignGroupId;
+		extern const FMixerStringConstant Type;
+		extern const FMixerStringConstant Event;
+		extern const FMixerStringConstant Data;
+		extern const FMixerStringConstant Events;
+		extern const FMixerStringConstant Channel;
+		extern const FMixerStringConstant Payload;
+		extern const FMixerStringConstant Message;
+		extern const FMixerStringConstant UserNameNoUnderscore;
+		extern const FMixerStringConstant UserNameWithUnderscore;
+		extern const FMixerStringConstant Id;
+		extern const FMixerStringConstant Meta;
+		extern const FMixerStringConstant Me;
+		extern const FMixerStringConstant Whisper;
+		extern const FMixerStringConstant Method;
+		extern const FMixerStringConstant Arguments;
+		extern const FMixerStringConstant Params;
+		extern const FMixerStringConstant Error;
+		extern const FMixerStringConstant Text;
+		extern const FMixerStringConstant Endpoints;
+		extern const FMixerStringConstant AuthKey;
+		extern const FMixerStringConstant UserIdNoUnderscore;
+		extern const FMixerStringConstant UserIdWithUnderscore;
+		extern const FMixerStringConstant UserLevel;
+		extern const FMixerStringConstant Q;
+		extern const FMixerStringConstant EndsAt;
+		extern const FMixerStringConstant Voters;
+		extern const FMixerStringConstant Answers;
+		extern const FMixerStringConstant ResponsesByIndex;
+		extern const FMixerStringConstant Author;
+		extern const FMixerStringConstant Permissions;
+		extern const FMixerStringConstant Level;
+		extern const FMixerStringConstant LastInputAt;
+		extern const FMixerStringConstant ConnectedAt;
+		extern const FMixerStringConstant GroupId;
+		extern const FMixerStringConstant SessionId;
+		extern const FMixerStringConstant Participants;
+		extern const FMixerStringConstant Threshold;
+		extern const FMixerStringConstant IsReady;
+		extern const FMixerStringConstant ParticipantId;
+		extern const FMixerStringConstant Input;
+		extern const FMixerStringConstant TransactionId;
+		extern const FMixerStringConstant ControlId;
+		extern const FMixerStringConstant X;
+		extern const FMixerStringConstant Y;
+		extern const FMixerStringConstant SceneId;
+		extern const FMixerStringConstant Scenes;
+		extern const FMixerStringConstant Controls;
+		extern const FMixerStringConstant Kind;
+		extern const FMixerStringConstant Cost;
+		extern const FMixerStringConstant Cooldown;
+		extern const FMixerStringConstant Disabled;
+		extern const FMixerStringConstant Tooltip;
+		extern const FMixerStringConstant Progress;
+		extern const FMixerStringConstant Result;
+		extern const FMixerStringConstant Time;
+		extern const FMixerStringConstant ElementDeltas;
+		extern const FMixerStringConstant Value;
+		extern const FMixerStringConstant TextSize;
+		extern const FMixerStringConstant TextColor;
+		extern const FMixerStringConstant Underline;
+		extern const FMixerStringConstant Bold;
+		extern const FMixerStringConstant Italic;
+		extern const FMixerStringConstant Placeholder;
+		extern const FMixerStringConstant HasSubmit;
+		extern const FMixerStringConstant Multiline;
+		extern const FMixerStringConstant SubmitText;
+		extern const FMixerStringConstant Groups;
+		extern const FMixerStringConstant ReassignGroupId;
+		extern const FMixerStringConstant Capacity;
+		extern const FMixerStringConstant DrainRate;
+		extern const FMixerStringConstant Source;
+		extern const FMixerStringConstant Pack;
+		extern const FMixerStringConstant Coords;
+		extern const FMixerStringConstant Width;
+		extern const FMixerStringConstant Height;
+		extern const FMixerStringConstant Url;
 	}
 
 	namespace Permissions
 	{
-		extern const FString Connect;
-		extern const FString Chat;
-		extern const FString Whisper;
-		extern const FString PollStart;
-		extern const FString PollVote;
-		extern const FString ClearMessages;
-		extern const FString Purge;
-		extern const FString GiveawayStart;
+		extern const FMixerStringConstant Connect;
+		extern const FMixerStringConstant Chat;
+		extern const FMixerStringConstant Whisper;
+		extern const FMixerStringConstant PollStart;
+		extern const FMixerStringConstant PollVote;
+		extern const FMixerStringConstant ClearMessages;
+		extern const FMixerStringConstant Purge;
+		extern const FMixerStringConstant GiveawayStart;
+	}
+}
+
+/**
+ * Condensed print policy that emits real UTF-8.  The generic policy narrows each TCHAR
+ * to a single byte, which is fine for the structural characters but mangles text.
+ */
+struct FMixerUtf8CondensedJsonPrintPolicy : public TCondensedJsonPrintPolicy<UTF8CHAR>
+{
+	static inline void WriteString(FArchive* Stream, const FString& String)
+	{
+		FTCHARToUTF8 Converted(*String, String.Len());
+		Stream->Serialize(const_cast<ANSICHAR*>(reinterpret_cast<const ANSICHAR*>(Converted.Get())), Converted.Length());
 	}
+};
+
+/**
+ * Forward-only view over the fields of a single json object, backed by a pull parser.
+ * Used by streaming message handlers to read flat payloads without building an FJsonObject.
+ * Nested objects and arrays are skipped automatically when advancing past them, unless read
+ * through TryReadObject or TryReadObjectArray.
+ */
+class FMixerJsonCursor
+{
+public:
+	/** Reader must be positioned immediately after the ObjectStart of the object to iterate. */
+	explicit FMixerJsonCursor(TJsonReader<TCHAR>& InReader);
+
+	/** Advance to the next field of the object.  Returns false once the object is exhausted or on a parse error. */
+	bool NextField();
+
+	const FString& GetFieldName() const		{ return Reader.GetIdentifier(); }
+
+	/** Whether the current field is Name.  The field name is hashed at most once however many names it's tested against. */
+	bool IsField(const FMixerStringConstant& Name) const;
+	EJsonNotation GetNotation() const			{ return Notation; }
+	bool HasError() const						{ return bError; }
+
+	bool TryGetString(FString& OutValue) const;
+	bool TryGetNumber(double& OutValue) const;
+	bool TryGetNumber(int32& OutValue) const;
+	bool TryGetBool(bool& OutValue) const;
+
+	/** Append the current string value to OutBuffer, avoiding a temporary. */
+	bool TryAppendString(FString& OutBuffer) const;
+
+	/** If the current value is an object, iterate its fields with a nested cursor.  The value is consumed. */
+	bool TryReadObject(TFunctionRef<void(FMixerJsonCursor&)> Visitor);
+
+	/** If the current value is an array, iterate each object element with a nested cursor.  Other elements are skipped. */
+	bool TryReadObjectArray(TFunctionRef<void(FMixerJsonCursor&)> Visitor);
+
+private:
+	TJsonReader<TCHAR>& Reader;
+	EJsonNotation Notation;
+	mutable uint32 FieldNameHash;
+	mutable bool bFieldNameHashed;
+	bool bFinished;
+	bool bError;
+};
+
+/**
+ * Parses the body of an HTTP response on a worker thread and hands the typed result to OnParsed on
+ * the game thread, so that large payloads don't stall the frame.  Parse must only touch its arguments.
+ * OnParsed is only ever run and released on the game thread, so it may capture game thread state
+ * such as weak pointers, but it should check that whoever asked for the result still wants it.
+ * Parse is skipped, and OnParsed told of failure, for a missing response.
+ */
+template <typename ResultType>
+void ParseHttpResponseAsync(FHttpResponsePtr HttpResponse, TFunction<bool(const FString&, ResultType&)> Parse, TFunction<void(bool, ResultType&)> OnParsed)
+{
+	typedef TFunction<void(bool, ResultType&)> FOnParsed;
+	TSharedRef<ResultType, ESPMode::ThreadSafe> Result = MakeShared<ResultType, ESPMode::ThreadSafe>();
+	TSharedRef<FOnParsed, ESPMode::ThreadSafe> Continuation = MakeShared<FOnParsed, ESPMode::ThreadSafe>(MoveTemp(OnParsed));
+	FFunctionGraphTask::CreateAndDispatchWhenReady([HttpResponse, Parse, Result, Continuation]()
+	{
+		const bool bParsed = HttpResponse.IsValid() && Parse(HttpResponse->GetContentAsString(), *Result);
+		FFunctionGraphTask::CreateAndDispatchWhenReady([Result, Continuation, bParsed]()
+		{
+			// Released here rather than wherever the last task happens to finish
+			FOnParsed OnParsedLocal = MoveTemp(*Continuation);
+			*Continuation = FOnParsed();
+			OnParsedLocal(bParsed, *Result);
+		}, TStatId(), nullptr, ENamedThreads::GameThread);
+	}, TStatId(), nullptr, ENamedThreads::AnyThread);
 }
 
 #define GET_JSON_FIELD_RETURN_FAILURE(JsonType, JsonNameConstant, UEType, UEName) \
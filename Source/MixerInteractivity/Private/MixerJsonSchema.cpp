@@ -0,0 +1,138 @@
+//*********************************************************
+//
+// Copyright (c) Microsoft. All rights reserved.
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT.
+//
+//*********************************************************
+#include "MixerJsonSchema.h"
+
+FMixerJsonSchema::FMixerJsonSchema(const TCHAR* InMessageName, std::initializer_list<FMixerJsonSchemaField> InFields)
+	: MessageName(InMessageName)
+	, RequiredMask(0)
+{
+	check(InFields.size() <= 32);
+	Fields.Reserve(InFields.size());
+	for (const FMixerJsonSchemaField& Field : InFields)
+	{
+		if (Field.bRequired)
+		{
+			RequiredMask |= 1u << Fields.Num();
+		}
+		Fields.Add(Field);
+	}
+}
+
+bool FMixerJsonSchema::Decode(const FJsonObject& JsonObj, void* OutStruct) const
+{
+	uint32 FoundMask = 0;
+	for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : JsonObj.Values)
+	{
+		const FString& Key = Pair.Key;
+		const int32 KeyLen = Key.Len();
+		uint32 KeyHash = 0;
+		bool bKeyHashed = false;
+		for (int32 i = 0; i < Fields.Num(); ++i)
+		{
+			const FMixerJsonSchemaField& Field = Fields[i];
+			if (Field.Name->Len() != KeyLen)
+			{
+				continue;
+			}
+
+			if (!bKeyHashed)
+			{
+				KeyHash = FCrc::StrCrc32(*Key);
+				bKeyHashed = true;
+			}
+
+			if (Field.Name->Matches(Key, KeyHash))
+			{
+				if (Pair.Value.IsValid() && DecodeField(Field, *Pair.Value, OutStruct))
+				{
+					FoundMask |= 1u << i;
+				}
+				break;
+			}
+		}
+	}
+
+	const uint32 MissingMask = RequiredMask & ~FoundMask;
+	if (MissingMask != 0)
+	{
+		for (int32 i = 0; i < Fields.Num(); ++i)
+		{
+			if (MissingMask & (1u << i))
+			{
+				UE_LOG(LogMixerInteractivity, Warning, TEXT("Missing required %s field in %s payload"), **Fields[i].Name, MessageName);
+			}
+		}
+		return false;
+	}
+
+	return true;
+}
+
+bool FMixerJsonSchema::DecodeField(const FMixerJsonSchemaField& Field, const FJsonValue& Value, void* OutStruct)
+{
+	uint8* Dest = static_cast<uint8*>(OutStruct) + Field.Offset;
+	switch (Field.Type)
+	{
+	case EMixerJsonFieldType::String:
+		return Value.TryGetString(*reinterpret_cast<FString*>(Dest));
+
+	case EMixerJsonFieldType::Name:
+	{
+		FString NameString;
+		if (Value.TryGetString(NameString))
+		{
+			*reinterpret_cast<FName*>(Dest) = *NameString;
+			return true;
+		}
+		return false;
+	}
+
+	case EMixerJsonFieldType::Guid:
+	{
+		FString GuidString;
+		if (Value.TryGetString(GuidString))
+		{
+			if (FGuid::Parse(GuidString, *reinterpret_cast<FGuid*>(Dest)))
+			{
+				return true;
+			}
+			UE_LOG(LogMixerInteractivity, Warning, TEXT("%s field %s was not in the expected format (guid)"), **Field.Name, *GuidString);
+		}
+		return false;
+	}
+
+	case EMixerJsonFieldType::Int:
+		return Value.TryGetNumber(*reinterpret_cast<int32*>(Dest));
+
+	case EMixerJsonFieldType::Double:
+		return Value.TryGetNumber(*reinterpret_cast<double*>(Dest));
+
+	case EMixerJsonFieldType::Bool:
+		return Value.TryGetBool(*reinterpret_cast<bool*>(Dest));
+
+	case EMixerJsonFieldType::Object:
+	{
+		const TSharedPtr<FJsonObject>* Object;
+		if (Value.TryGetObject(Object))
+		{
+			*reinterpret_cast<TSharedPtr<FJsonObject>*>(Dest) = *Object;
+			return true;
+		}
+		return false;
+	}
+
+	case EMixerJsonFieldType::Array:
+		return Value.TryGetArray(*reinterpret_cast<const TArray<TSharedPtr<FJsonValue>>**>(Dest));
+
+	default:
+		checkNoEntry();
+		return false;
+	}
+}
@@ -0,0 +1,110 @@
+//*********************************************************
+//
+// Copyright (c) Microsoft. All rights reserved.
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT.
+//
+//*********************************************************
+#pragma once
+
+#include "MixerJsonHelpers.h"
+#include "Misc/Guid.h"
+#include "UObject/NameTypes.h"
+
+enum class EMixerJsonFieldType : uint8
+{
+	String,
+	Name,
+	Guid,
+	Int,
+	Double,
+	Bool,
+	Object,
+	Array,
+};
+
+struct FMixerJsonSchemaField
+{
+	const FMixerStringConstant* Name;
+	SIZE_T Offset;
+	EMixerJsonFieldType Type;
+	bool bRequired;
+};
+
+/**
+ * Read-optimized description of the fields of one protocol message.  Decoding makes a single pass over
+ * the fields actually present in the payload, matching each by length and precomputed hash, rather than
+ * looking every expected field up by name.  Declare with BEGIN_MIXER_JSON_SCHEMA on the target struct.
+ */
+class FMixerJsonSchema
+{
+public:
+	FMixerJsonSchema(const TCHAR* InMessageName, std::initializer_list<FMixerJsonSchemaField> InFields);
+
+	/**
+	* Fill OutStruct from the fields of JsonObj.  Fields that are absent or of the wrong type are left untouched.
+	*
+	* @return	false, after logging a warning, if any required field was missing.
+	*/
+	bool Decode(const FJsonObject& JsonObj, void* OutStruct) const;
+
+private:
+	static bool DecodeField(const FMixerJsonSchemaField& Field, const FJsonValue& Value, void* OutStruct);
+
+	const TCHAR* MessageName;
+	TArray<FMixerJsonSchemaField, TInlineAllocator<8>> Fields;
+	uint32 RequiredMask;
+};
+
+namespace MixerJsonSchema
+{
+	/** Field descriptors, with the value type deduced from the member. */
+	template <typename StructType> FMixerJsonSchemaField MakeField(const FMixerStringConstant& Name, SIZE_T Offset, FString StructType::*, bool bRequired)								{ return { &Name, Offset, EMixerJsonFieldType::String, bRequired }; }
+	template <typename StructType> FMixerJsonSchemaField MakeField(const FMixerStringConstant& Name, SIZE_T Offset, FName StructType::*, bool bRequired)								{ return { &Name, Offset, EMixerJsonFieldType::Name, bRequired }; }
+	template <typename StructType> FMixerJsonSchemaField MakeField(const FMixerStringConstant& Name, SIZE_T Offset, FGuid StructType::*, bool bRequired)								{ return { &Name, Offset, EMixerJsonFieldType::Guid, bRequired }; }
+	template <typename StructType> FMixerJsonSchemaField MakeField(const FMixerStringConstant& Name, SIZE_T Offset, int32 StructType::*, bool bRequired)								{ return { &Name, Offset, EMixerJsonFieldType::Int, bRequired }; }
+	template <typename StructType> FMixerJsonSchemaField MakeField(const FMixerStringConstant& Name, SIZE_T Offset, double StructType::*, bool bRequired)								{ return { &Name, Offset, EMixerJsonFieldType::Double, bRequired }; }
+	template <typename StructType> FMixerJsonSchemaField MakeField(const FMixerStringConstant& Name, SIZE_T Offset, bool StructType::*, bool bRequired)									{ return { &Name, Offset, EMixerJsonFieldType::Bool, bRequired }; }
+	template <typename StructType> FMixerJsonSchemaField MakeField(const FMixerStringConstant& Name, SIZE_T Offset, TSharedPtr<FJsonObject> StructType::*, bool bRequired)				{ return { &Name, Offset, EMixerJsonFieldType::Object, bRequired }; }
+	template <typename StructType> FMixerJsonSchemaField MakeField(const FMixerStringConstant& Name, SIZE_T Offset, const TArray<TSharedPtr<FJsonValue>>* StructType::*, bool bRequired)	{ return { &Name, Offset, EMixerJsonFieldType::Array, bRequired }; }
+}
+
+/**
+ * Declares a schema for the enclosing struct and a Decode(const FJsonObject&) member that applies it, e.g.
+ *
+ *	struct FGroupRecord
+ *	{
+ *		FName GroupId;
+ *		FName SceneId;
+ *
+ *		BEGIN_MIXER_JSON_SCHEMA(FGroupRecord, TEXT("group"))
+ *			MIXER_JSON_REQUIRED(GroupId, GroupId)
+ *			MIXER_JSON_REQUIRED(SceneId, SceneId)
+ *		END_MIXER_JSON_SCHEMA()
+ *	};
+ *
+ * Field names are MixerStringConstants::FieldNames.  Array members are pointers into the decoded
+ * FJsonObject, so are only valid for as long as it is.
+ */
+#define BEGIN_MIXER_JSON_SCHEMA(StructType, MessageName) \
+	bool Decode(const FJsonObject& JsonObj) \
+	{ \
+		return GetSchema().Decode(JsonObj, this); \
+	} \
+	static const FMixerJsonSchema& GetSchema() \
+	{ \
+		typedef StructType FSchemaStruct; \
+		static const FMixerJsonSchema Schema(MessageName, {
+
+#define MIXER_JSON_REQUIRED(JsonNameConstant, Member) \
+			MixerJsonSchema::MakeField(MixerStringConstants::FieldNames::JsonNameConstant, STRUCT_OFFSET(FSchemaStruct, Member), &FSchemaStruct::Member, true),
+
+#define MIXER_JSON_OPTIONAL(JsonNameConstant, Member) \
+			MixerJsonSchema::MakeField(MixerStringConstants::FieldNames::JsonNameConstant, STRUCT_OFFSET(FSchemaStruct, Member), &FSchemaStruct::Member, false),
+
+#define END_MIXER_JSON_SCHEMA() \
+		}); \
+		return Schema; \
+	}
@@ -25,6 +25,23 @@ void UMixerLoginPane::ReleaseSlateResources(bool bReleaseChildren)
 	Super::ReleaseSlateResources(bReleaseChildren);
 
 	MyLoginPane.Reset();
+	MyMixerLoginPane.Reset();
+}
+
+void UMixerLoginPane::StartLoginFlow()
+{
+	if (MyMixerLoginPane.IsValid())
+	{
+		MyMixerLoginPane->StartLoginFlow();
+	}
+}
+
+void UMixerLoginPane::PrewarmBrowser()
+{
+	if (MyMixerLoginPane.IsValid())
+	{
+		MyMixerLoginPane->PrewarmBrowser();
+	}
 }
 
 #if WITH_EDITOR
@@ -38,11 +55,12 @@ TSharedRef<SWidget> UMixerLoginPane::RebuildWidget()
 {
 	if (!IsDesignTime())
 	{
-		MyLoginPane = SNew(SMixerLoginPane)
+		MyLoginPane = SAssignNew(MyMixerLoginPane, SMixerLoginPane)
 			.UserId_UObject(this, &UMixerLoginPane::SlateGetUserId)
 			.OnAuthCodeReady_UObject(this, &UMixerLoginPane::SlateHandleAuthCodeReady)
 			.OnUIFlowFinished_UObject(this, &UMixerLoginPane::SlateHandleUIFlowFinished)
 			.AllowSilentLogin(AllowSilentLogin)
+			.DeferLoginFlow(DeferLoginFlow)
 			.BackgroundColor(BackgroundColor);
 	}
 	else
@@ -0,0 +1,841 @@
+//*********************************************************
+//
+// Copyright (c) Microsoft. All rights reserved.
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT.
+//
+//*********************************************************
+
+#include "MixerMockService.h"
+
+#if MIXER_MOCK_SERVICE_ENABLED
+
+#include "MixerInteractivitySettings.h"
+#include "MixerInteractivityProjectAsset.h"
+#include "MixerProjectAssetPreloader.h"
+#include "MixerInteractivityJsonTypes.h"
+#include "MixerInteractivityLog.h"
+#include "MixerJsonHelpers.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/Guid.h"
+#include "Misc/DateTime.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonWriter.h"
+#include "Serialization/JsonSerializer.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+
+static int32 GMixerMockParticipants = 100;
+static FAutoConsoleVariableRef CVarMixerMockParticipants(
+	TEXT("Mixer.Mock.Participants"),
+	GMixerMockParticipants,
+	TEXT("Number of participants the mock interactive service keeps joined.  Joins and leaves are ramped by Mixer.Mock.JoinBatchSize per frame."),
+	ECVF_Default);
+
+static float GMixerMockInputsPerSecond = 0.5f;
+static FAutoConsoleVariableRef CVarMixerMockInputsPerSecond(
+	TEXT("Mixer.Mock.InputsPerSecond"),
+	GMixerMockInputsPerSecond,
+	TEXT("Inputs per second sent by each participant of the mock interactive service, spread across the controls in its scenes."),
+	ECVF_Default);
+
+static float GMixerMockChurnPerSecond = 0.0f;
+static FAutoConsoleVariableRef CVarMixerMockChurnPerSecond(
+	TEXT("Mixer.Mock.ChurnPerSecond"),
+	GMixerMockChurnPerSecond,
+	TEXT("Participants per second that leave the mock interactive service and are replaced by a newcomer."),
+	ECVF_Default);
+
+static float GMixerMockChatMessagesPerSecond = 0.0f;
+static FAutoConsoleVariableRef CVarMixerMockChatMessagesPerSecond(
+	TEXT("Mixer.Mock.ChatMessagesPerSecond"),
+	GMixerMockChatMessagesPerSecond,
+	TEXT("Chat messages per second sent to each room connected to the mock chat service."),
+	ECVF_Default);
+
+static int32 GMixerMockJoinBatchSize = 100;
+static FAutoConsoleVariableRef CVarMixerMockJoinBatchSize(
+	TEXT("Mixer.Mock.JoinBatchSize"),
+	GMixerMockJoinBatchSize,
+	TEXT("Most participants announced by the mock interactive service in one onParticipantJoin or onParticipantLeave frame, and per frame."),
+	ECVF_Default);
+
+static float GMixerMockButtonWeight = 1.0f;
+static FAutoConsoleVariableRef CVarMixerMockButtonWeight(
+	TEXT("Mixer.Mock.ButtonWeight"),
+	GMixerMockButtonWeight,
+	TEXT("Relative share of mock input sent to each button.  A kind of control's share of Mixer.Mock.InputsPerSecond is its weight times the number of those controls."),
+	ECVF_Default);
+
+static float GMixerMockStickWeight = 1.0f;
+static FAutoConsoleVariableRef CVarMixerMockStickWeight(
+	TEXT("Mixer.Mock.StickWeight"),
+	GMixerMockStickWeight,
+	TEXT("Relative share of mock input sent to each joystick.  See Mixer.Mock.ButtonWeight."),
+	ECVF_Default);
+
+static float GMixerMockTextboxWeight = 1.0f;
+static FAutoConsoleVariableRef CVarMixerMockTextboxWeight(
+	TEXT("Mixer.Mock.TextboxWeight"),
+	GMixerMockTextboxWeight,
+	TEXT("Relative share of mock input sent to each textbox.  See Mixer.Mock.ButtonWeight."),
+	ECVF_Default);
+
+static float GMixerMockCustomWeight = 1.0f;
+static FAutoConsoleVariableRef CVarMixerMockCustomWeight(
+	TEXT("Mixer.Mock.CustomWeight"),
+	GMixerMockCustomWeight,
+	TEXT("Relative share of mock input sent to each control of a custom kind, as a 'mockinput' event.  See Mixer.Mock.ButtonWeight."),
+	ECVF_Default);
+
+static float GMixerMockStickSpread = 0.0f;
+static FAutoConsoleVariableRef CVarMixerMockStickSpread(
+	TEXT("Mixer.Mock.StickSpread"),
+	GMixerMockStickSpread,
+	TEXT("Standard deviation of mock joystick positions around Mixer.Mock.StickBiasX/Y, clamped to the unit square.  0 or less spreads them uniformly instead."),
+	ECVF_Default);
+
+static float GMixerMockStickBiasX = 0.0f;
+static FAutoConsoleVariableRef CVarMixerMockStickBiasX(
+	TEXT("Mixer.Mock.StickBiasX"),
+	GMixerMockStickBiasX,
+	TEXT("Horizontal position the mock audience favors on joysticks when Mixer.Mock.StickSpread is positive."),
+	ECVF_Default);
+
+static float GMixerMockStickBiasY = 0.0f;
+static FAutoConsoleVariableRef CVarMixerMockStickBiasY(
+	TEXT("Mixer.Mock.StickBiasY"),
+	GMixerMockStickBiasY,
+	TEXT("Vertical position the mock audience favors on joysticks when Mixer.Mock.StickSpread is positive."),
+	ECVF_Default);
+
+static float GMixerMockTimeScale = 1.0f;
+static FAutoConsoleVariableRef CVarMixerMockTimeScale(
+	TEXT("Mixer.Mock.TimeScale"),
+	GMixerMockTimeScale,
+	TEXT("Multiplier on every Mixer.Mock.* rate, so that the mock audience lives through that many seconds of a session per real second."),
+	ECVF_Default);
+
+static int32 GMixerMockSeed = 0;
+static FAutoConsoleVariableRef CVarMixerMockSeed(
+	TEXT("Mixer.Mock.Seed"),
+	GMixerMockSeed,
+	TEXT("Seed for the mock audience.  Each interactive connection restarts from it, so the same settings give the same participants and input."),
+	ECVF_Default);
+
+namespace
+{
+	const TCHAR* MockInteractiveEndpoint = TEXT("mock://interactive");
+	const TCHAR* MockChatEndpoint = TEXT("mock://chat");
+
+	// Anything beyond a quarter second's worth is dropped, so a hitch doesn't come back as a burst.
+	// Rates are in simulated seconds, which Mixer.Mock.TimeScale runs faster than real ones.
+	float AccrueBudget(float Budget, float PerSecond, float DeltaTime)
+	{
+		const float Rate = FMath::Max(PerSecond * FMath::Max(GMixerMockTimeScale, 0.0f), 0.0f);
+		return FMath::Min(Budget + Rate * DeltaTime, FMath::Max(Rate * 0.25f, 1.0f));
+	}
+
+	FString MakeSessionGuidString(FRandomStream& Random)
+	{
+		const uint32 A = Random.GetUnsignedInt();
+		const uint32 B = Random.GetUnsignedInt();
+		const uint32 C = Random.GetUnsignedInt();
+		const uint32 D = Random.GetUnsignedInt();
+		return FGuid(A, B, C, D).ToString(EGuidFormats::DigitsWithHyphens).ToLower();
+	}
+
+	FString MakeGiveInputFrame(const FString& SessionId, const FString& ControlId, const FString& EventFields)
+	{
+		return FString::Printf(TEXT("{\"type\":\"method\",\"method\":\"giveInput\",\"params\":{\"participantID\":\"%s\",\"input\":{\"controlID\":\"%s\",%s}},\"discard\":true}"),
+			*SessionId, *ControlId, *EventFields);
+	}
+}
+
+/**
+* IWebSocket whose far end is FMixerMockService.  Sends are handled synchronously; frames from
+* the service are held until its next tick so that they arrive on a later frame, as they would
+* from a real socket.
+*/
+class FMixerLoopbackWebSocket :
+	public IWebSocket,
+	public TSharedFromThis<FMixerLoopbackWebSocket>
+{
+public:
+	explicit FMixerLoopbackWebSocket(bool bInChat)
+		: ChatChannelId(0)
+		, bChat(bInChat)
+		, bConnected(false)
+		, bConnectPending(false)
+	{
+	}
+
+	virtual void Connect() override
+	{
+		if (!bConnected && !bConnectPending)
+		{
+			bConnectPending = true;
+			FMixerMockService::Get().HandleSocketConnect(AsShared());
+		}
+	}
+
+	virtual void Close(int32 Code = 1000, const FString& Reason = FString()) override
+	{
+		bConnectPending = false;
+		Inbound.Empty();
+		if (bConnected)
+		{
+			bConnected = false;
+			ClosedEvent.Broadcast(Code, Reason, true);
+		}
+	}
+
+	virtual bool IsConnected() override
+	{
+		return bConnected;
+	}
+
+	virtual void Send(const FString& Data) override
+	{
+		if (bConnected)
+		{
+			FMixerMockService::Get().HandleClientMessage(*this, Data);
+		}
+	}
+
+	virtual void Send(const void* Utf8Data, SIZE_T Size, bool bIsBinary) override
+	{
+		if (bConnected && !bIsBinary)
+		{
+			FUTF8ToTCHAR Converted(static_cast<const ANSICHAR*>(Utf8Data), static_cast<int32>(Size));
+			Send(FString(Converted.Length(), Converted.Get()));
+		}
+	}
+
+	virtual FWebSocketConnectedEvent& OnConnected() override { return ConnectedEvent; }
+	virtual FWebSocketConnectionErrorEvent& OnConnectionError() override { return ConnectionErrorEvent; }
+	virtual FWebSocketClosedEvent& OnClosed() override { return ClosedEvent; }
+	virtual FWebSocketMessageEvent& OnMessage() override { return MessageEvent; }
+	virtual FWebSocketRawMessageEvent& OnRawMessage() override { return RawMessageEvent; }
+
+public:
+	bool IsChat() const { return bChat; }
+	bool IsConnectPending() const { return bConnectPending; }
+
+	void FinishConnect()
+	{
+		bConnectPending = false;
+		bConnected = true;
+		ConnectedEvent.Broadcast();
+	}
+
+	void Deliver(FString&& Frame)
+	{
+		if (bConnected)
+		{
+			Inbound.Add(MoveTemp(Frame));
+		}
+	}
+
+	void Flush()
+	{
+		// Handlers may send (and so queue replies) or close while we're delivering
+		TArray<FString> Frames = MoveTemp(Inbound);
+		Inbound.Reset();
+		for (const FString& Frame : Frames)
+		{
+			if (!bConnected)
+			{
+				break;
+			}
+			MessageEvent.Broadcast(Frame);
+		}
+	}
+
+	int32 ChatChannelId;
+
+private:
+	TArray<FString> Inbound;
+
+	FWebSocketConnectedEvent ConnectedEvent;
+	FWebSocketConnectionErrorEvent ConnectionErrorEvent;
+	FWebSocketClosedEvent ClosedEvent;
+	FWebSocketMessageEvent MessageEvent;
+	FWebSocketRawMessageEvent RawMessageEvent;
+	bool bChat;
+	bool bConnected;
+	bool bConnectPending;
+};
+
+FMixerMockService& FMixerMockService::Get()
+{
+	static FMixerMockService Instance;
+	return Instance;
+}
+
+FMixerMockService::FMixerMockService()
+	: NextUserId(1)
+	, NextChatMessageId(1)
+	, InputBudget(0.0f)
+	, ChurnBudget(0.0f)
+	, ChatBudget(0.0f)
+	, bInteractiveReady(false)
+{
+}
+
+bool FMixerMockService::IsMockEndpoint(const FString& Url)
+{
+	return Url == MockInteractiveEndpoint || Url == MockChatEndpoint;
+}
+
+TSharedRef<IWebSocket> FMixerMockService::CreateSocket(const FString& Url)
+{
+	TSharedRef<FMixerLoopbackWebSocket> Socket = MakeShared<FMixerLoopbackWebSocket>(Url == MockChatEndpoint);
+	Sockets.Add(Socket);
+	if (!TickHandle.IsValid())
+	{
+		UE_LOG(LogMixerInteractivity, Log, TEXT("Starting mock Mixer service."));
+		TickHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FMixerMockService::Tick));
+	}
+	return Socket;
+}
+
+void FMixerMockService::Reset()
+{
+	if (TickHandle.IsValid())
+	{
+		FTicker::GetCoreTicker().RemoveTicker(TickHandle);
+		TickHandle.Reset();
+	}
+
+	for (const TWeakPtr<FMixerLoopbackWebSocket>& WeakSocket : Sockets)
+	{
+		TSharedPtr<FMixerLoopbackWebSocket> Socket = WeakSocket.Pin();
+		if (Socket.IsValid())
+		{
+			Socket->Close(1001, TEXT("Mock service shut down"));
+		}
+	}
+
+	Sockets.Empty();
+	PendingConnects.Empty();
+	Participants.Empty();
+	for (TArray<FString>& ControlIds : ControlIdsByKind)
+	{
+		ControlIds.Empty();
+	}
+	ScenesResult.Empty();
+	InputBudget = 0.0f;
+	ChurnBudget = 0.0f;
+	ChatBudget = 0.0f;
+	bInteractiveReady = false;
+}
+
+void FMixerMockService::HandleSocketConnect(const TSharedRef<FMixerLoopbackWebSocket>& Socket)
+{
+	PendingConnects.Add(Socket);
+}
+
+bool FMixerMockService::Tick(float DeltaTime)
+{
+	TArray<TSharedRef<FMixerLoopbackWebSocket>> Connecting = MoveTemp(PendingConnects);
+	PendingConnects.Reset();
+	for (const TSharedRef<FMixerLoopbackWebSocket>& Socket : Connecting)
+	{
+		if (!Socket->IsConnectPending())
+		{
+			continue;
+		}
+
+		Socket->FinishConnect();
+		if (Socket->IsChat())
+		{
+			Socket->Deliver(TEXT("{\"type\":\"event\",\"event\":\"WelcomeEvent\",\"data\":{\"server\":\"mock\"}}"));
+		}
+		else
+		{
+			// Every interactive connection replays the same audience for the same seed, which
+			// also means a resumed session sees its participants re-announced.
+			Random.Initialize(GMixerMockSeed);
+			NextUserId = 1;
+			Participants.Reset();
+			InputBudget = 0.0f;
+			ChurnBudget = 0.0f;
+			bInteractiveReady = false;
+			BuildScenes();
+			Socket->Deliver(TEXT("{\"type\":\"method\",\"method\":\"hello\",\"params\":{},\"discard\":true}"));
+		}
+	}
+
+	TArray<TSharedPtr<FMixerLoopbackWebSocket>> LiveSockets;
+	LiveSockets.Reserve(Sockets.Num());
+	TSharedPtr<FMixerLoopbackWebSocket> InteractiveSocket;
+	for (int32 i = 0; i < Sockets.Num();)
+	{
+		TSharedPtr<FMixerLoopbackWebSocket> Socket = Sockets[i].Pin();
+		if (!Socket.IsValid())
+		{
+			Sockets.RemoveAt(i);
+			continue;
+		}
+
+		if (Socket->IsConnected() && !Socket->IsChat())
+		{
+			InteractiveSocket = Socket;
+		}
+		LiveSockets.Add(MoveTemp(Socket));
+		++i;
+	}
+
+	if (InteractiveSocket.IsValid())
+	{
+		TickAudience(*InteractiveSocket, DeltaTime);
+		TickInput(*InteractiveSocket, DeltaTime);
+	}
+	TickChat(DeltaTime);
+
+	// Pinned above, so delivery can't destroy a socket out from under us
+	for (const TSharedPtr<FMixerLoopbackWebSocket>& Socket : LiveSockets)
+	{
+		Socket->Flush();
+	}
+
+	return true;
+}
+
+void FMixerMockService::HandleClientMessage(FMixerLoopbackWebSocket& Socket, const FString& Message)
+{
+	TSharedPtr<FJsonObject> JsonObject;
+	TSharedRef<TJsonReader<>> JsonReader = TJsonReaderFactory<>::Create(Message);
+	if (!FJsonSerializer::Deserialize(JsonReader, JsonObject) || !JsonObject.IsValid())
+	{
+		UE_LOG(LogMixerInteractivity, Warning, TEXT("Mock Mixer service could not parse message: %s"), *Message);
+		return;
+	}
+
+	FString MessageType;
+	FString Method;
+	if (!JsonObject->TryGetStringField(MixerStringConstants::FieldNames::Type, MessageType)
+		|| MessageType != MixerStringConstants::MessageTypes::Method
+		|| !JsonObject->TryGetStringField(MixerStringConstants::FieldNames::Method, Method))
+	{
+		return;
+	}
+
+	int32 MessageId = INDEX_NONE;
+	bool bDiscard = false;
+	if (!JsonObject->TryGetBoolField(TEXT("discard"), bDiscard) || !bDiscard)
+	{
+		JsonObject->TryGetNumberField(MixerStringConstants::FieldNames::Id, MessageId);
+	}
+
+	if (Socket.IsChat())
+	{
+		HandleChatMethod(Socket, Method, MessageId, *JsonObject);
+	}
+	else
+	{
+		const TSharedPtr<FJsonObject>* Params = nullptr;
+		JsonObject->TryGetObjectField(MixerStringConstants::FieldNames::Params, Params);
+		HandleInteractiveMethod(Socket, Method, MessageId, Params != nullptr ? Params->Get() : nullptr);
+	}
+}
+
+void FMixerMockService::HandleInteractiveMethod(FMixerLoopbackWebSocket& Socket, const FString& Method, int32 MessageId, const FJsonObject* Params)
+{
+	FString Result = TEXT("{}");
+	bool bReadyChanged = false;
+	if (Method == MixerStringConstants::MethodNames::GetScenes)
+	{
+		Result = ScenesResult;
+	}
+	else if (Method == MixerStringConstants::MethodNames::GetActiveParticipants)
+	{
+		// Everyone is active as far as the mock is concerned
+		const double Timestamp = static_cast<double>(FDateTime::UtcNow().ToUnixTimestamp()) * 1000.0;
+		FString ParticipantsJson;
+		for (const FSimulatedParticipant& Participant : Participants)
+		{
+			AppendParticipantJson(Participant, Timestamp, ParticipantsJson);
+		}
+		Result = FString::Printf(TEXT("{\"participants\":[%s]}"), *ParticipantsJson);
+	}
+	else if (Method == MixerStringConstants::MethodNames::Ready)
+	{
+		bool bIsReady = false;
+		if (Params != nullptr && Params->TryGetBoolField(MixerStringConstants::FieldNames::IsReady, bIsReady))
+		{
+			bReadyChanged = bIsReady != bInteractiveReady;
+			bInteractiveReady = bIsReady;
+		}
+	}
+
+	if (MessageId != INDEX_NONE)
+	{
+		Socket.Deliver(FString::Printf(TEXT("{\"type\":\"reply\",\"id\":%d,\"result\":%s,\"error\":null}"), MessageId, *Result));
+	}
+
+	if (bReadyChanged)
+	{
+		Socket.Deliver(FString::Printf(TEXT("{\"type\":\"method\",\"method\":\"onReady\",\"params\":{\"isReady\":%s},\"discard\":true}"), bInteractiveReady ? TEXT("true") : TEXT("false")));
+	}
+}
+
+void FMixerMockService::HandleChatMethod(FMixerLoopbackWebSocket& Socket, const FString& Method, int32 MessageId, const FJsonObject& Message)
+{
+	FString Data = TEXT("{}");
+	if (Method == MixerStringConstants::MethodNames::Auth)
+	{
+		// Arguments are channel id, then user id and auth key unless joining anonymously
+		const TArray<TSharedPtr<FJsonValue>>* Arguments;
+		const bool bHaveArguments = Message.TryGetArrayField(MixerStringConstants::FieldNames::Arguments, Arguments);
+		if (bHaveArguments && Arguments->Num() > 0)
+		{
+			Socket.ChatChannelId = static_cast<int32>((*Arguments)[0]->AsNumber());
+		}
+		Data = bHaveArguments && Arguments->Num() > 1 ?
+			TEXT("{\"authenticated\":true,\"roles\":[\"User\"]}") :
+			TEXT("{\"authenticated\":false,\"roles\":[]}");
+	}
+	else if (Method == MixerStringConstants::MethodNames::History)
+	{
+		Data = TEXT("[]");
+	}
+
+	if (MessageId != INDEX_NONE)
+	{
+		Socket.Deliver(FString::Printf(TEXT("{\"type\":\"reply\",\"error\":null,\"id\":%d,\"data\":%s}"), MessageId, *Data));
+	}
+}
+
+void FMixerMockService::BuildScenes()
+{
+	for (TArray<FString>& ControlIds : ControlIdsByKind)
+	{
+		ControlIds.Reset();
+	}
+
+	auto AddControl = [this](TArray<TSharedPtr<FJsonValue>>& ControlsJson, const FString& ControlId, const FString& Kind)
+	{
+		TSharedRef<FJsonObject> ControlJson = MakeShared<FJsonObject>();
+		ControlJson->SetStringField(MixerStringConstants::FieldNames::ControlId, ControlId);
+		ControlJson->SetStringField(MixerStringConstants::FieldNames::Kind, Kind);
+		ControlsJson.Add(MakeShared<FJsonValueObject>(ControlJson));
+
+		EControlKind ControlKind;
+		if (Kind == FMixerInteractiveControl::ButtonKind)
+		{
+			ControlKind = EControlKind::Button;
+		}
+		else if (Kind == FMixerInteractiveControl::JoystickKind)
+		{
+			ControlKind = EControlKind::Stick;
+		}
+		else if (Kind == FMixerInteractiveControl::TextboxKind)
+		{
+			ControlKind = EControlKind::Textbox;
+		}
+		else if (Kind != FMixerInteractiveControl::LabelKind)
+		{
+			// Anything the plugin doesn't model itself is delivered through OnCustomControlInput
+			ControlKind = EControlKind::Custom;
+		}
+		else
+		{
+			return;
+		}
+		ControlIdsByKind[static_cast<int32>(ControlKind)].Add(ControlId);
+	};
+
+	auto AddScene = [](TArray<TSharedPtr<FJsonValue>>& ScenesJson, const FString& SceneId, const TArray<TSharedPtr<FJsonValue>>& ControlsJson)
+	{
+		TSharedRef<FJsonObject> SceneJson = MakeShared<FJsonObject>();
+		SceneJson->SetStringField(MixerStringConstants::FieldNames::SceneId, SceneId);
+		SceneJson->SetArrayField(MixerStringConstants::FieldNames::Controls, ControlsJson);
+		if (SceneId == TEXT("default"))
+		{
+			// All simulated participants stay in the default group
+			TSharedRef<FJsonObject> GroupJson = MakeShared<FJsonObject>();
+			GroupJson->SetStringField(MixerStringConstants::FieldNames::GroupId, TEXT("default"));
+			TArray<TSharedPtr<FJsonValue>> GroupsJson;
+			GroupsJson.Add(MakeShared<FJsonValueObject>(GroupJson));
+			SceneJson->SetArrayField(MixerStringConstants::FieldNames::Groups, GroupsJson);
+		}
+		ScenesJson.Add(MakeShared<FJsonValueObject>(SceneJson));
+	};
+
+	// Same source as seeding the session, so the mock serves the scenes the game was built against
+	TArray<TSharedPtr<FJsonValue>> ScenesJson;
+	const UMixerProjectAsset* ProjectAsset = FMixerProjectAssetPreloader::Get().GetProjectDefinition(true);
+	if (ProjectAsset != nullptr)
+	{
+		for (const FMixerInteractiveScene& Scene : ProjectAsset->ParsedProjectDefinition.Controls.Scenes)
+		{
+			TArray<TSharedPtr<FJsonValue>> ControlsJson;
+			ControlsJson.Reserve(Scene.Controls.Num());
+			for (const FMixerInteractiveControl& Control : Scene.Controls)
+			{
+				AddControl(ControlsJson, Control.Id, Control.Kind);
+			}
+			AddScene(ScenesJson, Scene.Id, ControlsJson);
+		}
+	}
+
+	if (ScenesJson.Num() == 0)
+	{
+		UE_LOG(LogMixerInteractivity, Log, TEXT("No Project Definition for the mock Mixer service; serving a default scene with one button and one joystick."));
+		TArray<TSharedPtr<FJsonValue>> ControlsJson;
+		AddControl(ControlsJson, TEXT("mock_button"), FMixerInteractiveControl::ButtonKind);
+		AddControl(ControlsJson, TEXT("mock_joystick"), FMixerInteractiveControl::JoystickKind);
+		AddScene(ScenesJson, TEXT("default"), ControlsJson);
+	}
+
+	TSharedRef<FJsonObject> ResultJson = MakeShared<FJsonObject>();
+	ResultJson->SetArrayField(MixerStringConstants::FieldNames::Scenes, ScenesJson);
+
+	ScenesResult.Empty();
+	TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&ScenesResult);
+	FJsonSerializer::Serialize(ResultJson, Writer);
+}
+
+void FMixerMockService::TickAudience(FMixerLoopbackWebSocket& Socket, float DeltaTime)
+{
+	const int32 TargetParticipants = FMath::Max(GMixerMockParticipants, 0);
+	const int32 BatchSize = FMath::Max(GMixerMockJoinBatchSize, 1);
+
+	if (Participants.Num() < TargetParticipants)
+	{
+		FString Joining;
+		AddParticipants(FMath::Min(TargetParticipants - Participants.Num(), BatchSize), Joining);
+		SendParticipantEvent(Socket, TEXT("onParticipantJoin"), Joining);
+	}
+	else if (Participants.Num() > TargetParticipants)
+	{
+		FString Leaving;
+		const int32 NumLeaving = FMath::Min(Participants.Num() - TargetParticipants, BatchSize);
+		for (int32 i = 0; i < NumLeaving; ++i)
+		{
+			RemoveParticipant(Participants.Num() - 1, Leaving);
+		}
+		SendParticipantEvent(Socket, TEXT("onParticipantLeave"), Leaving);
+	}
+
+	// Churn swaps participants for newcomers one for one, so the audience size holds steady
+	ChurnBudget = FMath::Min(AccrueBudget(ChurnBudget, GMixerMockChurnPerSecond, DeltaTime), static_cast<float>(BatchSize));
+	const int32 NumChurned = FMath::Min(FMath::FloorToInt(ChurnBudget), Participants.Num());
+	if (NumChurned > 0)
+	{
+		ChurnBudget -= NumChurned;
+		FString Leaving;
+		FString Joining;
+		for (int32 i = 0; i < NumChurned; ++i)
+		{
+			RemoveParticipant(Random.RandHelper(Participants.Num()), Leaving);
+		}
+		AddParticipants(NumChurned, Joining);
+		SendParticipantEvent(Socket, TEXT("onParticipantLeave"), Leaving);
+		SendParticipantEvent(Socket, TEXT("onParticipantJoin"), Joining);
+	}
+}
+
+void FMixerMockService::TickInput(FMixerLoopbackWebSocket& Socket, float DeltaTime)
+{
+	if (!bInteractiveReady || Participants.Num() == 0)
+	{
+		InputBudget = 0.0f;
+		return;
+	}
+
+	InputBudget = AccrueBudget(InputBudget, GMixerMockInputsPerSecond * Participants.Num(), DeltaTime);
+	while (InputBudget >= 1.0f)
+	{
+		EControlKind Kind;
+		if (!ChooseControlKind(Kind))
+		{
+			// No controls, or every kind weighted out
+			InputBudget = 0.0f;
+			break;
+		}
+
+		InputBudget -= 1.0f;
+		const FSimulatedParticipant& Participant = Participants[Random.RandHelper(Participants.Num())];
+		const TArray<FString>& ControlIds = ControlIdsByKind[static_cast<int32>(Kind)];
+		const FString& ControlId = ControlIds[Random.RandHelper(ControlIds.Num())];
+		switch (Kind)
+		{
+		case EControlKind::Button:
+			// A press is counted as one input but, as on the service, arrives as two frames
+			Socket.Deliver(MakeGiveInputFrame(Participant.SessionId, ControlId, TEXT("\"event\":\"mousedown\",\"button\":0")));
+			Socket.Deliver(MakeGiveInputFrame(Participant.SessionId, ControlId, TEXT("\"event\":\"mouseup\",\"button\":0")));
+			break;
+
+		case EControlKind::Stick:
+		{
+			const FVector2D Position = ChooseStickPosition();
+			Socket.Deliver(MakeGiveInputFrame(Participant.SessionId, ControlId, FString::Printf(TEXT("\"event\":\"move\",\"x\":%.3f,\"y\":%.3f"), Position.X, Position.Y)));
+			break;
+		}
+
+		case EControlKind::Textbox:
+			Socket.Deliver(MakeGiveInputFrame(Participant.SessionId, ControlId, FString::Printf(TEXT("\"event\":\"submit\",\"value\":\"mock input from %s\""), *Participant.Username)));
+			break;
+
+		case EControlKind::Custom:
+			Socket.Deliver(MakeGiveInputFrame(Participant.SessionId, ControlId, FString::Printf(TEXT("\"event\":\"mockinput\",\"value\":%d"), Random.RandHelper(100))));
+			break;
+
+		default:
+			break;
+		}
+	}
+}
+
+bool FMixerMockService::ChooseControlKind(EControlKind& OutKind)
+{
+	const float WeightPerControl[] = { GMixerMockButtonWeight, GMixerMockStickWeight, GMixerMockTextboxWeight, GMixerMockCustomWeight };
+	static_assert(ARRAY_COUNT(WeightPerControl) == static_cast<int32>(EControlKind::Count), "Need a weight for every kind of control");
+
+	float KindWeights[ARRAY_COUNT(WeightPerControl)];
+	float TotalWeight = 0.0f;
+	for (int32 i = 0; i < ARRAY_COUNT(WeightPerControl); ++i)
+	{
+		KindWeights[i] = FMath::Max(WeightPerControl[i], 0.0f) * ControlIdsByKind[i].Num();
+		TotalWeight += KindWeights[i];
+	}
+
+	if (TotalWeight <= 0.0f)
+	{
+		return false;
+	}
+
+	float Pick = Random.FRand() * TotalWeight;
+	for (int32 i = 0; i < ARRAY_COUNT(KindWeights); ++i)
+	{
+		if (KindWeights[i] > 0.0f)
+		{
+			OutKind = static_cast<EControlKind>(i);
+			Pick -= KindWeights[i];
+			if (Pick < 0.0f)
+			{
+				break;
+			}
+		}
+	}
+	return true;
+}
+
+FVector2D FMixerMockService::ChooseStickPosition()
+{
+	if (GMixerMockStickSpread <= 0.0f)
+	{
+		return FVector2D(Random.FRandRange(-1.0f, 1.0f), Random.FRandRange(-1.0f, 1.0f));
+	}
+
+	// Box-Muller, which conveniently gives a pair of independent normals for the two axes
+	const float Radius = GMixerMockStickSpread * FMath::Sqrt(-2.0f * FMath::Loge(FMath::Max(1.0f - Random.FRand(), SMALL_NUMBER)));
+	const float Angle = 2.0f * PI * Random.FRand();
+	return FVector2D(
+		FMath::Clamp(GMixerMockStickBiasX + Radius * FMath::Cos(Angle), -1.0f, 1.0f),
+		FMath::Clamp(GMixerMockStickBiasY + Radius * FMath::Sin(Angle), -1.0f, 1.0f));
+}
+
+void FMixerMockService::TickChat(float DeltaTime)
+{
+	ChatBudget = AccrueBudget(ChatBudget, GMixerMockChatMessagesPerSecond, DeltaTime);
+	if (ChatBudget < 1.0f)
+	{
+		return;
+	}
+
+	TArray<TSharedPtr<FMixerLoopbackWebSocket>, TInlineAllocator<4>> ChatSockets;
+	for (const TWeakPtr<FMixerLoopbackWebSocket>& WeakSocket : Sockets)
+	{
+		TSharedPtr<FMixerLoopbackWebSocket> Socket = WeakSocket.Pin();
+		if (Socket.IsValid() && Socket->IsChat() && Socket->IsConnected())
+		{
+			ChatSockets.Add(MoveTemp(Socket));
+		}
+	}
+
+	if (ChatSockets.Num() == 0)
+	{
+		ChatBudget = 0.0f;
+		return;
+	}
+
+	while (ChatBudget >= 1.0f)
+	{
+		ChatBudget -= 1.0f;
+
+		// Chat comes from the interactive audience when there is one
+		uint32 SenderId;
+		FString SenderName;
+		if (Participants.Num() > 0)
+		{
+			const FSimulatedParticipant& Participant = Participants[Random.RandHelper(Participants.Num())];
+			SenderId = Participant.UserId;
+			SenderName = Participant.Username;
+		}
+		else
+		{
+			SenderId = 1 + Random.RandHelper(1000000);
+			SenderName = FString::Printf(TEXT("MockChatter%u"), SenderId);
+		}
+
+		const FString MessageGuid = MakeSessionGuidString(Random);
+		const FString Text = FString::Printf(TEXT("mock message %u"), NextChatMessageId++);
+		for (const TSharedPtr<FMixerLoopbackWebSocket>& Socket : ChatSockets)
+		{
+			Socket->Deliver(FString::Printf(
+				TEXT("{\"type\":\"event\",\"event\":\"ChatMessage\",\"data\":{\"channel\":%d,\"id\":\"%s\",\"user_name\":\"%s\",\"user_id\":%u,\"user_level\":1,\"user_roles\":[\"User\"],")
+				TEXT("\"message\":{\"message\":[{\"type\":\"text\",\"data\":\"%s\",\"text\":\"%s\"}],\"meta\":{}}}}"),
+				Socket->ChatChannelId, *MessageGuid, *SenderName, SenderId, *Text, *Text));
+		}
+	}
+}
+
+void FMixerMockService::AddParticipants(int32 Count, FString& OutParticipantsJson)
+{
+	const double Timestamp = static_cast<double>(FDateTime::UtcNow().ToUnixTimestamp()) * 1000.0;
+	Participants.Reserve(Participants.Num() + Count);
+	for (int32 i = 0; i < Count; ++i)
+	{
+		FSimulatedParticipant& Participant = Participants[Participants.AddDefaulted()];
+		Participant.UserId = NextUserId++;
+		Participant.SessionId = MakeSessionGuidString(Random);
+		Participant.Username = FString::Printf(TEXT("MockViewer%u"), Participant.UserId);
+		AppendParticipantJson(Participant, Timestamp, OutParticipantsJson);
+	}
+}
+
+void FMixerMockService::RemoveParticipant(int32 Index, FString& OutParticipantsJson)
+{
+	const double Timestamp = static_cast<double>(FDateTime::UtcNow().ToUnixTimestamp()) * 1000.0;
+	AppendParticipantJson(Participants[Index], Timestamp, OutParticipantsJson);
+	Participants.RemoveAtSwap(Index);
+}
+
+void FMixerMockService::AppendParticipantJson(const FSimulatedParticipant& Participant, double Timestamp, FString& OutParticipantsJson) const
+{
+	if (!OutParticipantsJson.IsEmpty())
+	{
+		OutParticipantsJson += TEXT(',');
+	}
+
+	OutParticipantsJson += FString::Printf(
+		TEXT("{\"sessionID\":\"%s\",\"userID\":%u,\"username\":\"%s\",\"level\":1,\"lastInputAt\":%.0f,\"connectedAt\":%.0f,\"groupID\":\"default\",\"disabled\":false}"),
+		*Participant.SessionId, Participant.UserId, *Participant.Username, Timestamp, Timestamp);
+}
+
+void FMixerMockService::SendParticipantEvent(FMixerLoopbackWebSocket& Socket, const TCHAR* Method, const FString& ParticipantsJson)
+{
+	if (!ParticipantsJson.IsEmpty())
+	{
+		Socket.Deliver(FString::Printf(TEXT("{\"type\":\"method\",\"method\":\"%s\",\"params\":{\"participants\":[%s]},\"discard\":true}"), Method, *ParticipantsJson));
+	}
+}
+
+#endif
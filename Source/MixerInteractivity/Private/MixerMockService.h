@@ -0,0 +1,106 @@
+//*********************************************************
+//
+// Copyright (c) Microsoft. All rights reserved.
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT.
+//
+//*********************************************************
+#pragma once
+
+#include "CoreMinimal.h"
+
+#ifndef MIXER_MOCK_SERVICE_ENABLED
+#define MIXER_MOCK_SERVICE_ENABLED !UE_BUILD_SHIPPING
+#endif
+
+#if MIXER_MOCK_SERVICE_ENABLED
+
+#include "Containers/Ticker.h"
+#include "Math/RandomStream.h"
+#include "IWebSocket.h"
+
+class FJsonObject;
+class FMixerLoopbackWebSocket;
+
+/**
+* In-process stand-in for the interactive and chat services, for load testing without a live channel.
+* Selected by setting InteractiveEndpointOverride or ChatEndpointOverride to mock://interactive or
+* mock://chat.  Frames are delivered on the game thread from the core ticker, and the simulated
+* audience is shaped by the Mixer.Mock.* console variables: its size and churn, how often each
+* participant sends input, how that input is split between kinds of control (custom controls
+* included), and where sticks are pushed.
+*/
+class FMixerMockService
+{
+public:
+	static FMixerMockService& Get();
+
+	/** Whether the url names the mock service rather than a real host. */
+	static bool IsMockEndpoint(const FString& Url);
+
+	TSharedRef<IWebSocket> CreateSocket(const FString& Url);
+
+	/** Drops all connections and the simulated audience. */
+	void Reset();
+
+private:
+	friend class FMixerLoopbackWebSocket;
+
+	struct FSimulatedParticipant
+	{
+		FString SessionId;
+		FString Username;
+		uint32 UserId;
+	};
+
+	enum class EControlKind : uint8
+	{
+		Button,
+		Stick,
+		Textbox,
+		Custom,
+
+		Count
+	};
+
+	FMixerMockService();
+
+	bool Tick(float DeltaTime);
+
+	void HandleSocketConnect(const TSharedRef<FMixerLoopbackWebSocket>& Socket);
+	void HandleClientMessage(FMixerLoopbackWebSocket& Socket, const FString& Message);
+	void HandleInteractiveMethod(FMixerLoopbackWebSocket& Socket, const FString& Method, int32 MessageId, const FJsonObject* Params);
+	void HandleChatMethod(FMixerLoopbackWebSocket& Socket, const FString& Method, int32 MessageId, const FJsonObject& Message);
+
+	void BuildScenes();
+	void TickAudience(FMixerLoopbackWebSocket& Socket, float DeltaTime);
+	void TickInput(FMixerLoopbackWebSocket& Socket, float DeltaTime);
+	void TickChat(float DeltaTime);
+
+	bool ChooseControlKind(EControlKind& OutKind);
+	FVector2D ChooseStickPosition();
+
+	void AddParticipants(int32 Count, FString& OutParticipantsJson);
+	void RemoveParticipant(int32 Index, FString& OutParticipantsJson);
+	void AppendParticipantJson(const FSimulatedParticipant& Participant, double Timestamp, FString& OutParticipantsJson) const;
+	void SendParticipantEvent(FMixerLoopbackWebSocket& Socket, const TCHAR* Method, const FString& ParticipantsJson);
+
+	TArray<TWeakPtr<FMixerLoopbackWebSocket>> Sockets;
+	TArray<TSharedRef<FMixerLoopbackWebSocket>> PendingConnects;
+	FDelegateHandle TickHandle;
+
+	FRandomStream Random;
+	TArray<FSimulatedParticipant> Participants;
+	TArray<FString> ControlIdsByKind[static_cast<int32>(EControlKind::Count)];
+	FString ScenesResult;
+	uint32 NextUserId;
+	uint32 NextChatMessageId;
+	float InputBudget;
+	float ChurnBudget;
+	float ChatBudget;
+	bool bInteractiveReady;
+};
+
+#endif
@@ -0,0 +1,311 @@
+//*********************************************************
+//
+// Copyright (c) Microsoft. All rights reserved.
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT.
+//
+//*********************************************************
+#include "MixerParticipantEnrichment.h"
+#include "MixerInteractivityLog.h"
+#include "MixerInteractivitySettings.h"
+#include "MixerRestClient.h"
+#include "MixerJsonHelpers.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+namespace
+{
+	// Rows of both queries carry the user id; the role list also names the user's groups.
+	bool ParseRelationships(const FString& Content, bool bFollowsQuery, TMap<uint32, EMixerChannelRelationship>& OutResults)
+	{
+		TSharedRef<TJsonReader<>> JsonReader = TJsonReaderFactory<>::Create(Content);
+		TSharedPtr<FJsonValue> JsonPayload;
+		const TArray<TSharedPtr<FJsonValue>>* Rows;
+		if (!FJsonSerializer::Deserialize(JsonReader, JsonPayload) || !JsonPayload.IsValid() || !JsonPayload->TryGetArray(Rows))
+		{
+			return false;
+		}
+
+		for (const TSharedPtr<FJsonValue>& Row : *Rows)
+		{
+			const TSharedPtr<FJsonObject>* RowObject;
+			int32 UserId;
+			if (!Row->TryGetObject(RowObject) || !(*RowObject)->TryGetNumberField(TEXT("id"), UserId))
+			{
+				continue;
+			}
+
+			EMixerChannelRelationship& Relationship = OutResults.FindOrAdd(static_cast<uint32>(UserId));
+			if (bFollowsQuery)
+			{
+				Relationship |= EMixerChannelRelationship::Follower;
+				continue;
+			}
+
+			const TArray<TSharedPtr<FJsonValue>>* Groups;
+			if ((*RowObject)->TryGetArrayField(TEXT("groups"), Groups))
+			{
+				for (const TSharedPtr<FJsonValue>& Group : *Groups)
+				{
+					const TSharedPtr<FJsonObject>* GroupObject;
+					FString GroupName;
+					if (Group->TryGetObject(GroupObject) && (*GroupObject)->TryGetStringField(TEXT("name"), GroupName))
+					{
+						// Other groups (Partner, Pro, Staff...) are the user's standing on the service, not with this channel
+						if (GroupName == TEXT("Subscriber"))
+						{
+							Relationship |= EMixerChannelRelationship::Subscriber;
+						}
+					}
+				}
+			}
+		}
+		return true;
+	}
+
+	void CancelQuery(FHttpRequestPtr& Request)
+	{
+		if (Request.IsValid())
+		{
+			Request->OnProcessRequestComplete().Unbind();
+			Request->CancelRequest();
+			Request.Reset();
+		}
+	}
+}
+
+FMixerParticipantEnrichment::FMixerParticipantEnrichment()
+	: FirstQueuedTime(0.0)
+	, NextBatchId(1)
+	, NextCacheTrimTime(0.0)
+{
+}
+
+FMixerParticipantEnrichment::~FMixerParticipantEnrichment()
+{
+	Reset(true);
+}
+
+void FMixerParticipantEnrichment::Enqueue(uint32 UserId)
+{
+	EMixerChannelRelationship Relationship;
+	if (QueuedOrInFlight.Contains(UserId) || FindCached(UserId, Relationship))
+	{
+		return;
+	}
+
+	if (QueuedUserIds.Num() == 0)
+	{
+		FirstQueuedTime = FPlatformTime::Seconds();
+	}
+	QueuedUserIds.Add(UserId);
+	QueuedOrInFlight.Add(UserId);
+}
+
+bool FMixerParticipantEnrichment::FindCached(uint32 UserId, EMixerChannelRelationship& OutRelationship) const
+{
+	const FCachedRelationship* Cached = Cache.Find(UserId);
+	if (Cached == nullptr || FPlatformTime::Seconds() - Cached->FetchedTime > GetDefault<UMixerInteractivitySettings>()->ParticipantEnrichmentCacheLifetime)
+	{
+		return false;
+	}
+
+	OutRelationship = Cached->Relationship;
+	return true;
+}
+
+void FMixerParticipantEnrichment::Tick(int32 ChannelId)
+{
+	const UMixerInteractivitySettings* Settings = GetDefault<UMixerInteractivitySettings>();
+	const double TimeNow = FPlatformTime::Seconds();
+	if (TimeNow >= NextCacheTrimTime)
+	{
+		TrimCache(TimeNow);
+	}
+
+	// Full batches go straight away; the window only holds back a partial one
+	const int32 BatchSize = FMath::Max(Settings->ParticipantEnrichmentBatchSize, 1);
+	const bool bWindowElapsed = TimeNow - FirstQueuedTime >= Settings->ParticipantEnrichmentWindow;
+	bool bSentBatch = false;
+	while (QueuedUserIds.Num() >= BatchSize || (bWindowElapsed && QueuedUserIds.Num() > 0))
+	{
+		bSentBatch = true;
+		const int32 NumInBatch = FMath::Min(QueuedUserIds.Num(), BatchSize);
+		TArray<uint32> UserIds(QueuedUserIds.GetData(), NumInBatch);
+		QueuedUserIds.RemoveAt(0, NumInBatch, false);
+		SendBatch(ChannelId, MoveTemp(UserIds));
+	}
+
+	// What's left arrived after the batches just sent went out, so its window starts now
+	if (bSentBatch && QueuedUserIds.Num() > 0)
+	{
+		FirstQueuedTime = TimeNow;
+	}
+}
+
+void FMixerParticipantEnrichment::Reset(bool bForgetCache)
+{
+	for (TPair<uint32, FBatch>& Batch : BatchesInFlight)
+	{
+		CancelQuery(Batch.Value.FollowsRequest);
+		CancelQuery(Batch.Value.RolesRequest);
+	}
+	BatchesInFlight.Empty();
+	QueuedUserIds.Empty();
+	QueuedOrInFlight.Empty();
+
+	if (bForgetCache)
+	{
+		Cache.Empty();
+	}
+}
+
+void FMixerParticipantEnrichment::SendBatch(int32 ChannelId, TArray<uint32>&& UserIds)
+{
+	FString IdList;
+	for (uint32 UserId : UserIds)
+	{
+		if (!IdList.IsEmpty())
+		{
+			IdList.AppendChar(TEXT(';'));
+		}
+		IdList.AppendInt(static_cast<int32>(UserId));
+	}
+
+	const uint32 BatchId = NextBatchId++;
+	const int32 Limit = UserIds.Num();
+	FBatch& Batch = BatchesInFlight.Add(BatchId);
+	Batch.UserIds = MoveTemp(UserIds);
+	Batch.bFailed = false;
+	Batch.FollowsRequest = SendQuery(BatchId, true, FString::Printf(TEXT("channels/%d/follow?fields=id&limit=%d&where=id:in:%s"), ChannelId, Limit, *IdList));
+	Batch.RolesRequest = SendQuery(BatchId, false, FString::Printf(TEXT("channels/%d/users?fields=id,groups&limit=%d&where=id:in:%s"), ChannelId, Limit, *IdList));
+	if (!Batch.FollowsRequest.IsValid() || !Batch.RolesRequest.IsValid())
+	{
+		CancelQuery(Batch.FollowsRequest);
+		CancelQuery(Batch.RolesRequest);
+		Batch.bFailed = true;
+		CompleteBatch(BatchId);
+	}
+}
+
+FHttpRequestPtr FMixerParticipantEnrichment::SendQuery(uint32 BatchId, bool bFollowsQuery, const FString& Path)
+{
+	TSharedRef<IHttpRequest> Request = FMixerRestClient::Get().CreateRequest(TEXT("GET"), Path);
+	Request->OnProcessRequestComplete().BindSP(this, &FMixerParticipantEnrichment::OnQueryComplete, BatchId, bFollowsQuery);
+	if (!FMixerRestClient::Get().ProcessRequest(Request))
+	{
+		Request->OnProcessRequestComplete().Unbind();
+		return nullptr;
+	}
+	return Request;
+}
+
+void FMixerParticipantEnrichment::OnQueryComplete(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, uint32 BatchId, bool bFollowsQuery)
+{
+	if (!bSucceeded || !HttpResponse.IsValid() || !EHttpResponseCodes::IsOk(HttpResponse->GetResponseCode()))
+	{
+		TMap<uint32, EMixerChannelRelationship> NoResults;
+		OnQueryParsed(HttpRequest, BatchId, false, NoResults);
+		return;
+	}
+
+	// The query stays in flight until parsing is done, so that Reset can still abandon it
+	TWeakPtr<FMixerParticipantEnrichment> WeakThis = AsShared();
+	ParseHttpResponseAsync<TMap<uint32, EMixerChannelRelationship>>(HttpResponse,
+		[bFollowsQuery](const FString& Content, TMap<uint32, EMixerChannelRelationship>& OutResults)
+		{
+			return ParseRelationships(Content, bFollowsQuery, OutResults);
+		},
+		[WeakThis, HttpRequest, BatchId](bool bParsed, TMap<uint32, EMixerChannelRelationship>& Results)
+		{
+			TSharedPtr<FMixerParticipantEnrichment> StrongThis = WeakThis.Pin();
+			if (StrongThis.IsValid())
+			{
+				StrongThis->OnQueryParsed(HttpRequest, BatchId, bParsed, Results);
+			}
+		});
+}
+
+void FMixerParticipantEnrichment::OnQueryParsed(FHttpRequestPtr HttpRequest, uint32 BatchId, bool bParsed, TMap<uint32, EMixerChannelRelationship>& Results)
+{
+	FBatch* Batch = BatchesInFlight.Find(BatchId);
+	if (Batch == nullptr)
+	{
+		// Abandoned by Reset while parsing
+		return;
+	}
+
+	if (Batch->FollowsRequest == HttpRequest)
+	{
+		Batch->FollowsRequest.Reset();
+	}
+	else if (Batch->RolesRequest == HttpRequest)
+	{
+		Batch->RolesRequest.Reset();
+	}
+	else
+	{
+		return;
+	}
+
+	if (bParsed)
+	{
+		for (const TPair<uint32, EMixerChannelRelationship>& Result : Results)
+		{
+			Batch->Results.FindOrAdd(Result.Key) |= Result.Value;
+		}
+	}
+	else
+	{
+		Batch->bFailed = true;
+	}
+
+	if (!Batch->FollowsRequest.IsValid() && !Batch->RolesRequest.IsValid())
+	{
+		CompleteBatch(BatchId);
+	}
+}
+
+void FMixerParticipantEnrichment::CompleteBatch(uint32 BatchId)
+{
+	FBatch Batch;
+	BatchesInFlight.RemoveAndCopyValue(BatchId, Batch);
+	for (uint32 UserId : Batch.UserIds)
+	{
+		QueuedOrInFlight.Remove(UserId);
+	}
+
+	if (Batch.bFailed)
+	{
+		// Not cached, so they're tried again if they rejoin
+		UE_LOG(LogMixerInteractivity, Warning, TEXT("Channel relationship lookup failed for %d participants."), Batch.UserIds.Num());
+		return;
+	}
+
+	const double TimeNow = FPlatformTime::Seconds();
+	for (uint32 UserId : Batch.UserIds)
+	{
+		// Absent from both lists means neither following nor holding any role
+		const EMixerChannelRelationship* Result = Batch.Results.Find(UserId);
+		FCachedRelationship& Cached = Cache.FindOrAdd(UserId);
+		Cached.Relationship = Result != nullptr ? *Result : EMixerChannelRelationship::None;
+		Cached.FetchedTime = TimeNow;
+	}
+
+	BatchResolved.ExecuteIfBound(Batch.UserIds);
+}
+
+void FMixerParticipantEnrichment::TrimCache(double TimeNow)
+{
+	const float Lifetime = GetDefault<UMixerInteractivitySettings>()->ParticipantEnrichmentCacheLifetime;
+	NextCacheTrimTime = TimeNow + FMath::Max(Lifetime, 1.0f);
+	for (TMap<uint32, FCachedRelationship>::TIterator It(Cache); It; ++It)
+	{
+		if (TimeNow - It.Value().FetchedTime > Lifetime)
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
@@ -0,0 +1,80 @@
+//*********************************************************
+//
+// Copyright (c) Microsoft. All rights reserved.
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT.
+//
+//*********************************************************
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MixerInteractivityTypes.h"
+#include "Interfaces/IHttpRequest.h"
+#include "Interfaces/IHttpResponse.h"
+
+/**
+* Looks up how remote participants relate to the broadcaster's channel.  Ids are gathered for
+* ParticipantEnrichmentWindow, so that a burst of joins costs a couple of batched REST queries
+* rather than one per participant, and answers are kept for ParticipantEnrichmentCacheLifetime.
+*/
+class FMixerParticipantEnrichment : public TSharedFromThis<FMixerParticipantEnrichment>
+{
+public:
+	/** Fired once per finished batch, with the ids whose answers are now cached. */
+	DECLARE_DELEGATE_OneParam(FOnBatchResolved, const TArray<uint32>& /* UserIds */);
+
+	FMixerParticipantEnrichment();
+	~FMixerParticipantEnrichment();
+
+	/** Queue a participant to be looked up, unless they already have a fresh answer or are queued. */
+	void Enqueue(uint32 UserId);
+
+	/** Get a participant's cached answer.  Fails if there isn't one or it has expired. */
+	bool FindCached(uint32 UserId, EMixerChannelRelationship& OutRelationship) const;
+
+	/** Send the queued ids off to the service once the gather window has passed or a batch is full. */
+	void Tick(int32 ChannelId);
+
+	/** Empty the queue and abandon lookups in flight, without firing OnBatchResolved.  The cache survives unless bForgetCache. */
+	void Reset(bool bForgetCache);
+
+	FOnBatchResolved& OnBatchResolved()		{ return BatchResolved; }
+
+private:
+	struct FBatch
+	{
+		TArray<uint32> UserIds;
+		FHttpRequestPtr FollowsRequest;
+		FHttpRequestPtr RolesRequest;
+		TMap<uint32, EMixerChannelRelationship> Results;
+		bool bFailed;
+	};
+
+	struct FCachedRelationship
+	{
+		EMixerChannelRelationship Relationship;
+		double FetchedTime;
+	};
+
+	void SendBatch(int32 ChannelId, TArray<uint32>&& UserIds);
+	FHttpRequestPtr SendQuery(uint32 BatchId, bool bFollowsQuery, const FString& Path);
+	void OnQueryComplete(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, uint32 BatchId, bool bFollowsQuery);
+	void OnQueryParsed(FHttpRequestPtr HttpRequest, uint32 BatchId, bool bParsed, TMap<uint32, EMixerChannelRelationship>& Results);
+	void CompleteBatch(uint32 BatchId);
+	void TrimCache(double TimeNow);
+
+private:
+	TArray<uint32> QueuedUserIds;
+	TSet<uint32> QueuedOrInFlight;
+	double FirstQueuedTime;
+
+	TMap<uint32, FBatch> BatchesInFlight;
+	uint32 NextBatchId;
+
+	TMap<uint32, FCachedRelationship> Cache;
+	double NextCacheTrimTime;
+
+	FOnBatchResolved BatchResolved;
+};
@@ -0,0 +1,139 @@
+//*********************************************************
+//
+// Copyright (c) Microsoft. All rights reserved.
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT.
+//
+//*********************************************************
+#include "MixerProjectAssetPreloader.h"
+#include "MixerInteractivitySettings.h"
+#include "MixerInteractivityProjectAsset.h"
+#include "MixerInteractivityLog.h"
+
+FMixerProjectAssetPreloader& FMixerProjectAssetPreloader::Get()
+{
+	static FMixerProjectAssetPreloader Instance;
+	return Instance;
+}
+
+void FMixerProjectAssetPreloader::Start()
+{
+	const UMixerInteractivitySettings* Settings = GetDefault<UMixerInteractivitySettings>();
+	if (!Settings->bPreloadProjectAssets || Settings->ProjectDefinition.IsNull())
+	{
+		return;
+	}
+
+	if (ProjectDefinitionHandle.IsValid())
+	{
+		if (RequestedProjectDefinition == Settings->ProjectDefinition)
+		{
+			return;
+		}
+
+		// Repointed in the editor since the last preload.  Anyone waiting waits for the new one.
+		CancelLoads();
+	}
+
+	RequestedProjectDefinition = Settings->ProjectDefinition;
+	ProjectDefinitionHandle = StreamableManager.RequestAsyncLoad(RequestedProjectDefinition,
+		FStreamableDelegate::CreateRaw(this, &FMixerProjectAssetPreloader::OnProjectDefinitionLoaded),
+		FStreamableManager::AsyncLoadHighPriority, true);
+	if (!ProjectDefinitionHandle.IsValid())
+	{
+		UE_LOG(LogMixerInteractivity, Warning, TEXT("Could not start loading Project Definition %s."), *RequestedProjectDefinition.ToString());
+		OnComplete();
+	}
+}
+
+void FMixerProjectAssetPreloader::WhenComplete(const FSimpleDelegate& Callback)
+{
+	if (IsComplete())
+	{
+		Callback.ExecuteIfBound();
+	}
+	else
+	{
+		CompletionCallbacks.Add(Callback);
+	}
+}
+
+UMixerProjectAsset* FMixerProjectAssetPreloader::GetProjectDefinition(bool bAllowBlockingLoad) const
+{
+	const FSoftObjectPath& ProjectDefinition = GetDefault<UMixerInteractivitySettings>()->ProjectDefinition;
+	UMixerProjectAsset* ProjectAsset = Cast<UMixerProjectAsset>(ProjectDefinition.ResolveObject());
+	if (ProjectAsset == nullptr && bAllowBlockingLoad)
+	{
+		ProjectAsset = Cast<UMixerProjectAsset>(ProjectDefinition.TryLoad());
+	}
+	return ProjectAsset;
+}
+
+void FMixerProjectAssetPreloader::Reset()
+{
+	CancelLoads();
+	CompletionCallbacks.Empty();
+}
+
+void FMixerProjectAssetPreloader::CancelLoads()
+{
+	if (ProjectDefinitionHandle.IsValid())
+	{
+		ProjectDefinitionHandle->CancelHandle();
+		ProjectDefinitionHandle.Reset();
+	}
+	if (ClassesHandle.IsValid())
+	{
+		ClassesHandle->CancelHandle();
+		ClassesHandle.Reset();
+	}
+	RequestedProjectDefinition.Reset();
+}
+
+void FMixerProjectAssetPreloader::OnProjectDefinitionLoaded()
+{
+	UMixerProjectAsset* ProjectAsset = Cast<UMixerProjectAsset>(RequestedProjectDefinition.ResolveObject());
+	if (ProjectAsset == nullptr)
+	{
+		UE_LOG(LogMixerInteractivity, Warning, TEXT("Project Definition %s failed to load."), *RequestedProjectDefinition.ToString());
+		OnComplete();
+		return;
+	}
+
+	// Cooked builds find the mapped classes through the custom control instances saved in each level instead
+	TArray<FSoftObjectPath> ControlClasses;
+#if WITH_EDITORONLY_DATA
+	for (const TPair<FName, FMixerCustomControlMapping>& Mapping : ProjectAsset->CustomControlMappings)
+	{
+		if (!Mapping.Value.Class.IsNull() && Mapping.Value.Class.ResolveObject() == nullptr)
+		{
+			ControlClasses.AddUnique(Mapping.Value.Class);
+		}
+	}
+#endif
+
+	if (ControlClasses.Num() > 0)
+	{
+		ClassesHandle = StreamableManager.RequestAsyncLoad(ControlClasses,
+			FStreamableDelegate::CreateRaw(this, &FMixerProjectAssetPreloader::OnComplete),
+			FStreamableManager::DefaultAsyncLoadPriority, true);
+	}
+
+	if (!ClassesHandle.IsValid())
+	{
+		OnComplete();
+	}
+}
+
+void FMixerProjectAssetPreloader::OnComplete()
+{
+	// Copied off in case a callback starts another preload
+	TArray<FSimpleDelegate> Callbacks = MoveTemp(CompletionCallbacks);
+	CompletionCallbacks.Reset();
+	for (const FSimpleDelegate& Callback : Callbacks)
+	{
+		Callback.ExecuteIfBound();
+	}
+}
@@ -0,0 +1,59 @@
+//*********************************************************
+//
+// Copyright (c) Microsoft. All rights reserved.
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT.
+//
+//*********************************************************
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/StreamableManager.h"
+
+class UMixerProjectAsset;
+
+/**
+* Streams in the Project Definition and the classes its custom controls are mapped to ahead of
+* use, so that binding Mixer events in a new world doesn't stall on disk.  Holds them for as long
+* as the module is loaded.  Started at engine init and again as worlds initialize, in case the
+* Project Definition has changed since.
+*/
+class FMixerProjectAssetPreloader
+{
+public:
+	static FMixerProjectAssetPreloader& Get();
+
+	/** Begin loading whatever is not already loaded or on its way.  Cheap to call repeatedly. */
+	void Start();
+
+	/** Whether everything asked for by the last Start has arrived (or failed to). */
+	bool IsComplete() const		{ return !ProjectDefinitionHandle.IsValid() || (ProjectDefinitionHandle->HasLoadCompleted() && (!ClassesHandle.IsValid() || ClassesHandle->HasLoadCompleted())); }
+
+	/** Run Callback once IsComplete, which may be immediately. */
+	void WhenComplete(const FSimpleDelegate& Callback);
+
+	/**
+	* The Project Definition, if it's in memory.  With bAllowBlockingLoad, which should be reserved for
+	* editor paths, it's loaded synchronously otherwise.
+	*/
+	UMixerProjectAsset* GetProjectDefinition(bool bAllowBlockingLoad) const;
+
+	/** Let go of everything and forget any WhenComplete callbacks.  Called on shutdown. */
+	void Reset();
+
+private:
+	FMixerProjectAssetPreloader() {}
+
+	void CancelLoads();
+	void OnProjectDefinitionLoaded();
+	void OnComplete();
+
+private:
+	FStreamableManager StreamableManager;
+	TSharedPtr<FStreamableHandle> ProjectDefinitionHandle;
+	TSharedPtr<FStreamableHandle> ClassesHandle;
+	FSoftObjectPath RequestedProjectDefinition;
+	TArray<FSimpleDelegate> CompletionCallbacks;
+};
@@ -0,0 +1,266 @@
+//*********************************************************
+//
+// Copyright (c) Microsoft. All rights reserved.
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT.
+//
+//*********************************************************
+#include "MixerRestClient.h"
+#include "MixerInteractivityLog.h"
+#include "MixerFrameScheduler.h"
+#include "MixerInteractivityModulePrivate.h"
+#include "HttpModule.h"
+#include "HAL/PlatformTime.h"
+
+namespace
+{
+	const TCHAR* MixerSiteRoot = TEXT("https://mixer.com/");
+	const FString MixerApiRoot = FString(MixerSiteRoot) + TEXT("api/v1/");
+
+	// Enough for every distinct GET a session normally makes, with room for a few channels
+	const int32 MaxCachedResponses = 64;
+}
+
+FMixerRestClient& FMixerRestClient::Get()
+{
+	static FMixerRestClient Instance;
+	return Instance;
+}
+
+TSharedRef<IHttpRequest> FMixerRestClient::CreateRequest(const FString& Verb, const FString& Path, const FString& AuthZHeaderValue) const
+{
+	TSharedRef<IHttpRequest> Request = FHttpModule::Get().CreateRequest();
+	Request->SetVerb(Verb);
+	Request->SetURL(GetApiUrl(Path));
+	Request->SetHeader(TEXT("Connection"), TEXT("keep-alive"));
+	if (!AuthZHeaderValue.IsEmpty())
+	{
+		Request->SetHeader(TEXT("Authorization"), AuthZHeaderValue);
+	}
+	return Request;
+}
+
+FString FMixerRestClient::GetApiUrl(const FString& Path)
+{
+	return MixerApiRoot + Path;
+}
+
+FString FMixerRestClient::GetSiteUrl(const FString& Path)
+{
+	return MixerSiteRoot + Path;
+}
+
+bool FMixerRestClient::ProcessRequest(TSharedRef<IHttpRequest> Request)
+{
+	const FString Verb = Request->GetVerb();
+	const bool bCacheable = Verb == TEXT("GET");
+	const FString Key = bCacheable ?
+		FString::Printf(TEXT("%s|%s"), *Request->GetURL(), *Request->GetHeader(TEXT("Authorization"))) :
+		FString::Printf(TEXT("#%u"), NextUniqueKey++);
+
+	FPendingRequest* Existing = PendingRequests.Find(Key);
+	if (Existing != nullptr)
+	{
+		Existing->Callers.Add(Request);
+		++EndpointStats.FindOrAdd(Existing->Endpoint).Coalesced;
+		return true;
+	}
+
+	// The caller's request is only a handle, so a caller cancelling doesn't take the response away from others
+	TSharedRef<IHttpRequest> WireRequest = FHttpModule::Get().CreateRequest();
+	WireRequest->SetVerb(Verb);
+	WireRequest->SetURL(Request->GetURL());
+	for (const FString& Header : Request->GetAllHeaders())
+	{
+		FString Name;
+		FString Value;
+		if (Header.Split(TEXT(": "), &Name, &Value))
+		{
+			WireRequest->SetHeader(Name, Value);
+		}
+	}
+	if (Request->GetContentLength() > 0)
+	{
+		WireRequest->SetContent(Request->GetContent());
+	}
+
+	const FCachedResponse* Cached = bCacheable ? CachedResponses.Find(Key) : nullptr;
+	if (Cached != nullptr)
+	{
+		WireRequest->SetHeader(TEXT("If-None-Match"), Cached->ETag);
+	}
+
+	WireRequest->OnProcessRequestComplete().BindRaw(this, &FMixerRestClient::OnWireRequestComplete, Key);
+	if (!WireRequest->ProcessRequest())
+	{
+		return false;
+	}
+
+	FPendingRequest& Pending = PendingRequests.Add(Key);
+	Pending.WireRequest = WireRequest;
+	Pending.Callers.Add(Request);
+	Pending.Endpoint = GetEndpointName(Verb, Request->GetURL());
+	Pending.StartTime = FPlatformTime::Seconds();
+	Pending.bCacheable = bCacheable;
+	return true;
+}
+
+void FMixerRestClient::Reset()
+{
+	for (TPair<FString, FPendingRequest>& Pending : PendingRequests)
+	{
+		// Unbind first - cancelling completes the request synchronously on some platforms
+		Pending.Value.WireRequest->OnProcessRequestComplete().Unbind();
+		Pending.Value.WireRequest->CancelRequest();
+	}
+	PendingRequests.Empty();
+	CachedResponses.Empty();
+	DeferredCompletions.Empty();
+}
+
+void FMixerRestClient::OnWireRequestComplete(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, FString Key)
+{
+	FPendingRequest Pending;
+	if (!PendingRequests.RemoveAndCopyValue(Key, Pending))
+	{
+		return;
+	}
+
+	const double Now = FPlatformTime::Seconds();
+	const double Latency = Now - Pending.StartTime;
+	FMixerRestEndpointStats& Stats = EndpointStats.FindOrAdd(Pending.Endpoint);
+	++Stats.Requests;
+	Stats.TotalLatency += Latency;
+	Stats.MaxLatency = FMath::Max(Stats.MaxLatency, Latency);
+	Stats.LastLatency = Latency;
+
+	FHttpResponsePtr Response = HttpResponse;
+	if (bSucceeded && HttpResponse.IsValid() && Pending.bCacheable)
+	{
+		const int32 ResponseCode = HttpResponse->GetResponseCode();
+		FCachedResponse* Cached = CachedResponses.Find(Key);
+		if (ResponseCode == EHttpResponseCodes::NotModified && Cached != nullptr)
+		{
+			Response = Cached->Response;
+			Cached->LastUsedTime = Now;
+			++Stats.CacheHits;
+		}
+		else if (EHttpResponseCodes::IsOk(ResponseCode))
+		{
+			const FString ETag = HttpResponse->GetHeader(TEXT("ETag"));
+			if (!ETag.IsEmpty())
+			{
+				StoreCachedResponse(Key, HttpRequest, HttpResponse, ETag);
+			}
+			else
+			{
+				CachedResponses.Remove(Key);
+			}
+		}
+	}
+
+	UE_LOG(LogMixerInteractivity, Verbose, TEXT("%s: %d in %.0fms (%d caller(s))"),
+		*Pending.Endpoint, HttpResponse.IsValid() ? HttpResponse->GetResponseCode() : 0, Latency * 1000.0, Pending.Callers.Num());
+
+	// Under a frame budget callers hear back from the module tick, in arrival order, rather than from the HTTP tick
+	const bool bDefer = FMixerFrameScheduler::Get().IsBudgeted() || DeferredCompletions.Num() > 0;
+	if (bDefer && Pending.Callers.Num() > 0)
+	{
+		static_cast<FMixerInteractivityModule&>(IMixerInteractivityModule::Get()).WakeTicker();
+	}
+	for (FHttpRequestPtr& Caller : Pending.Callers)
+	{
+		if (bDefer)
+		{
+			FDeferredCompletion& Deferred = DeferredCompletions[DeferredCompletions.AddDefaulted()];
+			Deferred.Caller = Caller;
+			Deferred.Response = Response;
+			Deferred.bSucceeded = bSucceeded;
+		}
+		else
+		{
+			CompleteCaller(Caller, Response, bSucceeded);
+		}
+	}
+}
+
+void FMixerRestClient::DeliverDeferredCompletions()
+{
+	if (DeferredCompletions.Num() == 0)
+	{
+		return;
+	}
+
+	FMixerFrameScheduler& Scheduler = FMixerFrameScheduler::Get();
+	const double Deadline = Scheduler.BeginWork(EMixerFrameWorkSource::HttpCompletions);
+	bool bDeliveredAny = false;
+	while (DeferredCompletions.Num() > 0 && (!bDeliveredAny || FPlatformTime::Seconds() < Deadline))
+	{
+		// Popped before running, since a caller may issue requests of its own or Reset
+		const FDeferredCompletion Completion = DeferredCompletions[0];
+		DeferredCompletions.RemoveAt(0, 1, false);
+		CompleteCaller(Completion.Caller, Completion.Response, Completion.bSucceeded);
+		bDeliveredAny = true;
+	}
+	Scheduler.EndWork(EMixerFrameWorkSource::HttpCompletions, bDeliveredAny, DeferredCompletions.Num() > 0);
+}
+
+void FMixerRestClient::CompleteCaller(const FHttpRequestPtr& Caller, const FHttpResponsePtr& Response, bool bSucceeded)
+{
+	// Callers that cancelled their handle have already been completed (or unbound)
+	if (Caller->GetStatus() == EHttpRequestStatus::NotStarted)
+	{
+		Caller->OnProcessRequestComplete().ExecuteIfBound(Caller, Response, bSucceeded);
+	}
+}
+
+void FMixerRestClient::StoreCachedResponse(const FString& Key, FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, const FString& ETag)
+{
+	if (!CachedResponses.Contains(Key) && CachedResponses.Num() >= MaxCachedResponses)
+	{
+		const FString* OldestKey = nullptr;
+		double OldestTime = MAX_dbl;
+		for (const TPair<FString, FCachedResponse>& Entry : CachedResponses)
+		{
+			if (Entry.Value.LastUsedTime < OldestTime)
+			{
+				OldestKey = &Entry.Key;
+				OldestTime = Entry.Value.LastUsedTime;
+			}
+		}
+		CachedResponses.Remove(FString(*OldestKey));
+	}
+
+	FCachedResponse& Cached = CachedResponses.FindOrAdd(Key);
+	Cached.Request = HttpRequest;
+	Cached.Response = HttpResponse;
+	Cached.ETag = ETag;
+	Cached.LastUsedTime = FPlatformTime::Seconds();
+}
+
+FString FMixerRestClient::GetEndpointName(const FString& Verb, const FString& Url)
+{
+	FString Path = Url;
+	Path.RemoveFromStart(MixerApiRoot);
+
+	int32 QueryStart;
+	if (Path.FindChar(TEXT('?'), QueryStart))
+	{
+		Path.LeftInline(QueryStart, false);
+	}
+
+	// Collapse ids so that e.g. every users/<id> lands in one bucket
+	TArray<FString> Segments;
+	Path.ParseIntoArray(Segments, TEXT("/"));
+	for (FString& Segment : Segments)
+	{
+		if (Segment.IsNumeric())
+		{
+			Segment = TEXT("{id}");
+		}
+	}
+
+	return Verb + TEXT(" ") + FString::Join(Segments, TEXT("/"));
+}
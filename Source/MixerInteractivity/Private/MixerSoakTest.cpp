@@ -0,0 +1,597 @@
+//*********************************************************
+//
+// Copyright (c) Microsoft. All rights reserved.
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT.
+//
+//*********************************************************
+
+#include "MixerSoakTest.h"
+
+#if MIXER_SOAK_TEST_ENABLED
+
+#include "MixerInteractivityModulePrivate.h"
+#include "MixerInteractivityLog.h"
+#include "MixerInteractivityLLM.h"
+#include "MixerInteractivitySettings.h"
+#include "MixerDynamicDelegateBinding.h"
+#include "OnlineChatMixerPrivate.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformMemory.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/AutomationTest.h"
+
+static TAutoConsoleVariable<float> CVarMixerSoakSimulatedHours(
+	TEXT("Mixer.Soak.SimulatedHours"),
+	8.0f,
+	TEXT("How much simulated time a MixerInteractivity.Soak run covers."));
+
+static TAutoConsoleVariable<float> CVarMixerSoakTimeScale(
+	TEXT("Mixer.Soak.TimeScale"),
+	60.0f,
+	TEXT("How many times faster than real time the mock service runs during MixerInteractivity.Soak."));
+
+static TAutoConsoleVariable<float> CVarMixerSoakSampleMinutes(
+	TEXT("Mixer.Soak.SampleMinutes"),
+	10.0f,
+	TEXT("Simulated minutes between MixerInteractivity.Soak samples."));
+
+static FAutoConsoleCommand CmdMixerSoak(
+	TEXT("Mixer.Soak"),
+	TEXT("Mixer.Soak Stop ends the MixerInteractivity.Soak run in progress early, Mixer.Soak Report logs the growth report so far."),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		const FString Verb = Args.Num() > 0 ? Args[0] : TEXT("Report");
+		if (Verb == TEXT("Stop"))
+		{
+			FMixerSoakTest::Get().Stop();
+		}
+		else if (Verb == TEXT("Report"))
+		{
+			FMixerSoakTest::Get().Report();
+		}
+		else
+		{
+			UE_LOG(LogMixerInteractivity, Warning, TEXT("Mixer.Soak: unknown command '%s'; expected Stop or Report.  Runs are started with the MixerInteractivity.Soak automation test."), *Verb);
+		}
+	}));
+
+namespace
+{
+	const TCHAR* SoakChatRoom = TEXT("MixerSoak");
+
+	// Churn and chat are what make the caches turn over, so a run always has some
+	const float MinSoakChurnPerSecond = 1.0f;
+	const float MinSoakChatMessagesPerSecond = 1.0f;
+
+	// Samples needed after warm-up for the halves to say anything
+	const int32 MinSamplesForVerdict = 8;
+
+	IConsoleVariable* FindMockVariable(const TCHAR* Name)
+	{
+		IConsoleVariable* Variable = IConsoleManager::Get().FindConsoleVariable(Name);
+		check(Variable != nullptr);
+		return Variable;
+	}
+
+	struct FGrowthVerdict
+	{
+		double SlopePerHour;
+		int64 EarlyMax;
+		int64 LateMin;
+		bool bConclusive;
+		bool bGrowing;
+	};
+
+	FGrowthVerdict JudgeGrowth(TArrayView<const double> Hours, TArrayView<const int64> Values, int64 Slack)
+	{
+		FGrowthVerdict Verdict;
+		FMemory::Memzero(Verdict);
+
+		const int32 First = Values.Num() / 4;
+		const int32 Num = Values.Num() - First;
+		if (Num < 2)
+		{
+			return Verdict;
+		}
+
+		// Least squares slope over everything past warm-up, for the report
+		double MeanHours = 0.0;
+		double MeanValue = 0.0;
+		for (int32 i = First; i < Values.Num(); ++i)
+		{
+			MeanHours += Hours[i];
+			MeanValue += static_cast<double>(Values[i]);
+		}
+		MeanHours /= Num;
+		MeanValue /= Num;
+
+		double Covariance = 0.0;
+		double Variance = 0.0;
+		for (int32 i = First; i < Values.Num(); ++i)
+		{
+			Covariance += (Hours[i] - MeanHours) * (static_cast<double>(Values[i]) - MeanValue);
+			Variance += FMath::Square(Hours[i] - MeanHours);
+		}
+		Verdict.SlopePerHour = Variance > 0.0 ? Covariance / Variance : 0.0;
+
+		// A bounded container levels off or cycles, so its late samples overlap its early ones.
+		// One that never gives anything back clears the early peak with every late sample.
+		const int32 Mid = First + Num / 2;
+		Verdict.EarlyMax = MIN_int64;
+		Verdict.LateMin = MAX_int64;
+		double EarlyMean = 0.0;
+		double LateMean = 0.0;
+		for (int32 i = First; i < Mid; ++i)
+		{
+			Verdict.EarlyMax = FMath::Max(Verdict.EarlyMax, Values[i]);
+			EarlyMean += static_cast<double>(Values[i]);
+		}
+		for (int32 i = Mid; i < Values.Num(); ++i)
+		{
+			Verdict.LateMin = FMath::Min(Verdict.LateMin, Values[i]);
+			LateMean += static_cast<double>(Values[i]);
+		}
+		EarlyMean /= Mid - First;
+		LateMean /= Values.Num() - Mid;
+
+		Verdict.bConclusive = Num >= MinSamplesForVerdict;
+		Verdict.bGrowing = Verdict.bConclusive && Verdict.LateMin > Verdict.EarlyMax && LateMean > EarlyMean * 1.1 + static_cast<double>(Slack);
+		return Verdict;
+	}
+
+	// Growth under this many entries is put down to noise
+	const int64 CountSlack = 4;
+
+	// Real seconds between attempts to reconnect a lost interactive connection
+	const double ReconnectIntervalSeconds = 5.0;
+}
+
+FMixerSoakTest& FMixerSoakTest::Get()
+{
+	static FMixerSoakTest Singleton;
+	return Singleton;
+}
+
+FMixerSoakTest::FMixerSoakTest()
+	: ElapsedSeconds(0.0)
+	, SimulatedSeconds(0.0)
+	, NextSampleSeconds(0.0)
+	, NextReconnectSeconds(0.0)
+	, NumReconnects(0)
+	, bReconnecting(false)
+	, SimulatedHours(0.0f)
+	, TimeScale(1.0f)
+	, SampleMinutes(0.0f)
+	, bStartedInteractivity(false)
+	, bRunning(false)
+	, bSavedUseWarmStartCache(false)
+	, SavedTimeScale(1.0f)
+	, SavedChurnPerSecond(0.0f)
+	, SavedChatMessagesPerSecond(0.0f)
+{
+}
+
+bool FMixerSoakTest::Start(float InSimulatedHours, float InTimeScale, float InSampleMinutes)
+{
+#if MIXER_BACKEND_UE
+	if (bRunning)
+	{
+		UE_LOG(LogMixerInteractivity, Warning, TEXT("Mixer.Soak: a run is already in progress; use Mixer.Soak Stop to end it."));
+		return false;
+	}
+
+	if (InSimulatedHours <= 0.0f || InTimeScale <= 0.0f || InSampleMinutes <= 0.0f)
+	{
+		UE_LOG(LogMixerInteractivity, Warning, TEXT("Mixer.Soak: duration, time scale and sample interval must all be positive."));
+		return false;
+	}
+
+	// The run is torn down through the usual path afterwards, which would sign a real user out.
+	FMixerInteractivityModule& Module = static_cast<FMixerInteractivityModule&>(IMixerInteractivityModule::Get());
+	if (Module.GetLoginState() != EMixerLoginState::Not_Logged_In || Module.GetInteractiveConnectionAuthState() != EMixerLoginState::Not_Logged_In)
+	{
+		UE_LOG(LogMixerInteractivity, Warning, TEXT("Mixer.Soak: can't run while a user is signed in or a session is active."));
+		return false;
+	}
+
+	SimulatedHours = InSimulatedHours;
+	TimeScale = InTimeScale;
+	SampleMinutes = InSampleMinutes;
+
+	UMixerInteractivitySettings* Settings = GetMutableDefault<UMixerInteractivitySettings>();
+	SavedInteractiveEndpoint = Settings->InteractiveEndpointOverride;
+	SavedChatEndpoint = Settings->ChatEndpointOverride;
+	bSavedUseWarmStartCache = Settings->bUseWarmStartCache;
+	Settings->InteractiveEndpointOverride = TEXT("mock://interactive");
+	Settings->ChatEndpointOverride = TEXT("mock://chat");
+	// Mock scenes mustn't end up seeding the next real session
+	Settings->bUseWarmStartCache = false;
+
+	IConsoleVariable* TimeScaleVariable = FindMockVariable(TEXT("Mixer.Mock.TimeScale"));
+	IConsoleVariable* ChurnVariable = FindMockVariable(TEXT("Mixer.Mock.ChurnPerSecond"));
+	IConsoleVariable* ChatVariable = FindMockVariable(TEXT("Mixer.Mock.ChatMessagesPerSecond"));
+	SavedTimeScale = TimeScaleVariable->GetFloat();
+	SavedChurnPerSecond = ChurnVariable->GetFloat();
+	SavedChatMessagesPerSecond = ChatVariable->GetFloat();
+	TimeScaleVariable->Set(TimeScale, ECVF_SetByCode);
+	ChurnVariable->Set(FMath::Max(SavedChurnPerSecond, MinSoakChurnPerSecond), ECVF_SetByCode);
+	ChatVariable->Set(FMath::Max(SavedChatMessagesPerSecond, MinSoakChatMessagesPerSecond), ECVF_SetByCode);
+
+	Metrics.Empty();
+	MetricIndicesByName.Empty();
+	SampleHours.Empty();
+	LastVerdict = FVerdict();
+	AddSampledMetrics();
+
+	if (!Module.StartSoakConnection())
+	{
+		UE_LOG(LogMixerInteractivity, Warning, TEXT("Mixer.Soak: failed to connect to the mock interactive service."));
+		EndSession();
+		return false;
+	}
+
+	TSharedPtr<IOnlineChatMixer> Chat = Module.GetExtendedChatInterface();
+	if (!Chat.IsValid() || !Chat->JoinPublicRoom(FUniqueNetIdMixer(0), SoakChatRoom, TEXT("MixerSoak"), FChatRoomConfig()))
+	{
+		UE_LOG(LogMixerInteractivity, Warning, TEXT("Mixer.Soak: couldn't join the mock chat service; chat containers will stay empty."));
+	}
+
+	bRunning = true;
+	bStartedInteractivity = false;
+	bReconnecting = false;
+	NumReconnects = 0;
+	ElapsedSeconds = 0.0;
+	SimulatedSeconds = 0.0;
+	NextSampleSeconds = 0.0;
+	NextReconnectSeconds = 0.0;
+	TickerHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FMixerSoakTest::Tick));
+
+	UE_LOG(LogMixerInteractivity, Display, TEXT("Mixer.Soak starting: %.1f simulated hours at %.0fx (about %.1f real minutes), sampling every %.1f simulated minutes."),
+		SimulatedHours, TimeScale, SimulatedHours * 60.0f / TimeScale, SampleMinutes);
+	return true;
+#else
+	UE_LOG(LogMixerInteractivity, Warning, TEXT("Mixer.Soak needs the UE backend to run against the mock service."));
+	return false;
+#endif
+}
+
+void FMixerSoakTest::Stop()
+{
+	if (!bRunning)
+	{
+		UE_LOG(LogMixerInteractivity, Display, TEXT("Mixer.Soak: no run in progress."));
+		return;
+	}
+
+	UE_LOG(LogMixerInteractivity, Display, TEXT("Mixer.Soak stopped after %.1f of %.1f simulated hours."), GetSimulatedHours(), SimulatedHours);
+	Finish();
+}
+
+void FMixerSoakTest::Reset()
+{
+	// The module is on its way down and closes its own connections
+	if (bRunning)
+	{
+		RestoreSettings();
+	}
+	Metrics.Empty();
+	MetricIndicesByName.Empty();
+	SampleHours.Empty();
+}
+
+double FMixerSoakTest::GetSimulatedHours() const
+{
+	return bRunning ? SimulatedSeconds / 3600.0 : (SampleHours.Num() > 0 ? SampleHours.Last() : 0.0);
+}
+
+bool FMixerSoakTest::Tick(float DeltaTime)
+{
+	// The mock service accrues its audience from the same delta, scaled by the same time scale
+	ElapsedSeconds += DeltaTime;
+	SimulatedSeconds += static_cast<double>(DeltaTime) * TimeScale;
+
+#if MIXER_BACKEND_UE
+	FMixerInteractivityModule& Module = static_cast<FMixerInteractivityModule&>(IMixerInteractivityModule::Get());
+	switch (Module.GetInteractiveConnectionAuthState())
+	{
+	case EMixerLoginState::Logged_In:
+		bReconnecting = false;
+		if (!bStartedInteractivity)
+		{
+			Module.StartInteractivity();
+			bStartedInteractivity = true;
+		}
+		break;
+
+	case EMixerLoginState::Not_Logged_In:
+		// The mock doesn't drop connections, but if something else did the run should carry on
+		bStartedInteractivity = false;
+		if (ElapsedSeconds >= NextReconnectSeconds)
+		{
+			if (!bReconnecting)
+			{
+				UE_LOG(LogMixerInteractivity, Warning, TEXT("Mixer.Soak: interactive connection lost at %.1f simulated hours; reconnecting every %.0f seconds until it's back."),
+					GetSimulatedHours(), ReconnectIntervalSeconds);
+				bReconnecting = true;
+				++NumReconnects;
+			}
+			Module.StartSoakConnection();
+			NextReconnectSeconds = ElapsedSeconds + ReconnectIntervalSeconds;
+		}
+		break;
+
+	default:
+		break;
+	}
+#endif
+
+	if (SimulatedSeconds >= NextSampleSeconds)
+	{
+		TakeSample();
+		NextSampleSeconds += SampleMinutes * 60.0;
+	}
+
+	if (GetSimulatedHours() >= SimulatedHours)
+	{
+		TakeSample();
+		Finish();
+		return false;
+	}
+
+	return true;
+}
+
+void FMixerSoakTest::AddMetric(const FString& Name, TFunction<int64()>&& Sample, int64 Slack, bool bCheckGrowth)
+{
+	FMetric& Metric = Metrics[Metrics.AddDefaulted()];
+	Metric.Name = Name;
+	Metric.Sample = MoveTemp(Sample);
+	Metric.Slack = Slack;
+	Metric.bCheckGrowth = bCheckGrowth;
+	MetricIndicesByName.Add(Name, Metrics.Num() - 1);
+}
+
+void FMixerSoakTest::AddSampledMetrics()
+{
+#if ENABLE_LOW_LEVEL_MEM_TRACKER && ENGINE_MINOR_VERSION >= 20
+	static const TCHAR* TagNames[] = { TEXT("Participants"), TEXT("ChatHistory"), TEXT("Messages"), TEXT("ControlUpdates"), TEXT("InteractiveSdk") };
+	static_assert(ARRAY_COUNT(TagNames) == static_cast<int32>(EMixerLLMTag::Count), "Every Mixer LLM tag needs a name");
+	for (int32 i = 0; i < static_cast<int32>(EMixerLLMTag::Count); ++i)
+	{
+		const ELLMTag Tag = MixerLLM::ToLLMTag(static_cast<EMixerLLMTag>(i));
+		AddMetric(FString(TEXT("LLM.")) + TagNames[i], [Tag]() -> int64 { return FLowLevelMemTracker::Get().GetTagAmountForTracker(ELLMTracker::Default, Tag); }, 256 * 1024);
+	}
+#endif
+
+	AddMetric(TEXT("Blueprint.EventSources"), []() -> int64 { return UMixerInteractivityBlueprintEventSource::GetNumBlueprintEventSources(); }, CountSlack);
+
+	// The rest of the engine shares the process, so this is for context rather than a verdict
+	AddMetric(TEXT("Process.UsedPhysical"), []() -> int64 { return static_cast<int64>(FPlatformMemory::GetStats().UsedPhysical); }, 0, false);
+}
+
+void FMixerSoakTest::RecordValue(const TCHAR* Name, int64 Value)
+{
+	const int32* ExistingIndex = MetricIndicesByName.Find(Name);
+	if (ExistingIndex == nullptr)
+	{
+		AddMetric(Name, TFunction<int64()>(), CountSlack);
+		ExistingIndex = &MetricIndicesByName.FindChecked(Name);
+	}
+
+	// Values first reported partway through count as empty until then
+	FMetric& Metric = Metrics[*ExistingIndex];
+	if (Metric.Values.Num() < SampleHours.Num())
+	{
+		Metric.Values.SetNumZeroed(SampleHours.Num());
+	}
+	Metric.Values.Last() += Value;
+}
+
+void FMixerSoakTest::TakeSample()
+{
+	SampleHours.Add(GetSimulatedHours());
+	for (FMetric& Metric : Metrics)
+	{
+		if (Metric.Sample)
+		{
+			Metric.Values.Add(Metric.Sample());
+		}
+	}
+
+	auto Record = [this](const TCHAR* Name, int64 Size) { RecordValue(Name, Size); };
+	FMixerInteractivityModule& Module = static_cast<FMixerInteractivityModule&>(IMixerInteractivityModule::Get());
+	Module.GetContainerSizes(Record);
+
+	// Looked up per sample, since the connection is replaced if it has to rejoin
+	TSharedPtr<FOnlineChatMixer> Chat = StaticCastSharedPtr<FOnlineChatMixer>(Module.GetExtendedChatInterface());
+	if (Chat.IsValid())
+	{
+		Chat->GetRoomContainerSizes(SoakChatRoom, Record);
+	}
+
+	// Anything not reported this time, e.g. while the chat room is rejoined, is empty
+	for (FMetric& Metric : Metrics)
+	{
+		Metric.Values.SetNumZeroed(SampleHours.Num());
+	}
+}
+
+void FMixerSoakTest::Finish()
+{
+	EndSession();
+
+	LastVerdict = Report();
+	const FString Filename = FPaths::ProjectSavedDir() / TEXT("Mixer") / TEXT("Soak") / FString::Printf(TEXT("Soak-%s.csv"), *FDateTime::Now().ToString());
+	if (WriteReport(Filename))
+	{
+		UE_LOG(LogMixerInteractivity, Display, TEXT("Mixer.Soak: samples written to %s."), *Filename);
+	}
+}
+
+void FMixerSoakTest::EndSession()
+{
+#if MIXER_BACKEND_UE
+	FMixerInteractivityModule& Module = static_cast<FMixerInteractivityModule&>(IMixerInteractivityModule::Get());
+	TSharedPtr<IOnlineChatMixer> Chat = Module.GetExtendedChatInterface();
+	if (Chat.IsValid())
+	{
+		Chat->ExitRoom(FUniqueNetIdMixer(0), SoakChatRoom);
+	}
+	Module.StopSoakConnection();
+#endif
+
+	RestoreSettings();
+}
+
+void FMixerSoakTest::RestoreSettings()
+{
+	if (TickerHandle.IsValid())
+	{
+		FTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+		TickerHandle.Reset();
+	}
+
+	UMixerInteractivitySettings* Settings = GetMutableDefault<UMixerInteractivitySettings>();
+	Settings->InteractiveEndpointOverride = SavedInteractiveEndpoint;
+	Settings->ChatEndpointOverride = SavedChatEndpoint;
+	Settings->bUseWarmStartCache = bSavedUseWarmStartCache;
+
+	FindMockVariable(TEXT("Mixer.Mock.TimeScale"))->Set(SavedTimeScale, ECVF_SetByCode);
+	FindMockVariable(TEXT("Mixer.Mock.ChurnPerSecond"))->Set(SavedChurnPerSecond, ECVF_SetByCode);
+	FindMockVariable(TEXT("Mixer.Mock.ChatMessagesPerSecond"))->Set(SavedChatMessagesPerSecond, ECVF_SetByCode);
+
+	bRunning = false;
+}
+
+FMixerSoakTest::FVerdict FMixerSoakTest::Report() const
+{
+	FVerdict Result;
+	if (SampleHours.Num() == 0)
+	{
+		UE_LOG(LogMixerInteractivity, Display, TEXT("Mixer.Soak: nothing sampled yet."));
+		Result.bConclusive = false;
+		return Result;
+	}
+
+	UE_LOG(LogMixerInteractivity, Display, TEXT("Mixer.Soak report: %d samples over %.1f simulated hours%s."),
+		SampleHours.Num(), SampleHours.Last(), bRunning ? TEXT(" (run in progress)") : TEXT(""));
+	UE_LOG(LogMixerInteractivity, Display, TEXT("  %-36s %14s %14s %14s %14s  %s"), TEXT("Value"), TEXT("First"), TEXT("Peak"), TEXT("Last"), TEXT("Per sim hour"), TEXT("Verdict"));
+
+	for (const FMetric& Metric : Metrics)
+	{
+		const FGrowthVerdict Verdict = JudgeGrowth(SampleHours, Metric.Values, Metric.Slack);
+		Result.bConclusive &= Verdict.bConclusive;
+
+		int64 Peak = Metric.Values[0];
+		for (int64 Value : Metric.Values)
+		{
+			Peak = FMath::Max(Peak, Value);
+		}
+
+		const TCHAR* VerdictText = !Metric.bCheckGrowth ? TEXT("info") : !Verdict.bConclusive ? TEXT("too few samples") : Verdict.bGrowing ? TEXT("GROWING") : TEXT("ok");
+		if (Metric.bCheckGrowth && Verdict.bGrowing)
+		{
+			Result.GrowingValues.Add(Metric.Name);
+			UE_LOG(LogMixerInteractivity, Error, TEXT("  %-36s %14lld %14lld %14lld %14.1f  %s"), *Metric.Name, Metric.Values[0], Peak, Metric.Values.Last(), Verdict.SlopePerHour, VerdictText);
+		}
+		else
+		{
+			UE_LOG(LogMixerInteractivity, Display, TEXT("  %-36s %14lld %14lld %14lld %14.1f  %s"), *Metric.Name, Metric.Values[0], Peak, Metric.Values.Last(), Verdict.SlopePerHour, VerdictText);
+		}
+	}
+
+	if (NumReconnects > 0)
+	{
+		UE_LOG(LogMixerInteractivity, Display, TEXT("Mixer.Soak: the interactive connection was lost %d time(s) during the run."), NumReconnects);
+	}
+
+	if (Result.GrowingValues.Num() > 0)
+	{
+		UE_LOG(LogMixerInteractivity, Error, TEXT("Mixer.Soak FAILED: %d value(s) grew throughout the run."), Result.GrowingValues.Num());
+	}
+	else if (!Result.bConclusive)
+	{
+		UE_LOG(LogMixerInteractivity, Warning, TEXT("Mixer.Soak inconclusive: at least %d samples past warm-up are needed; sample more often or run for longer."), MinSamplesForVerdict);
+	}
+	else
+	{
+		UE_LOG(LogMixerInteractivity, Display, TEXT("Mixer.Soak passed: no value grew throughout the run."));
+	}
+	return Result;
+}
+
+bool FMixerSoakTest::WriteReport(const FString& Filename) const
+{
+	// One row per sample, one column per value, for plotting
+	FString Csv = TEXT("SimulatedHours");
+	for (const FMetric& Metric : Metrics)
+	{
+		Csv += TEXT(",");
+		Csv += Metric.Name;
+	}
+	Csv += LINE_TERMINATOR;
+
+	for (int32 i = 0; i < SampleHours.Num(); ++i)
+	{
+		Csv += FString::Printf(TEXT("%.3f"), SampleHours[i]);
+		for (const FMetric& Metric : Metrics)
+		{
+			Csv += FString::Printf(TEXT(",%lld"), Metric.Values[i]);
+		}
+		Csv += LINE_TERMINATOR;
+	}
+
+	if (!FFileHelper::SaveStringToFile(Csv, *Filename))
+	{
+		UE_LOG(LogMixerInteractivity, Warning, TEXT("Mixer.Soak: failed to write %s."), *Filename);
+		return false;
+	}
+	return true;
+}
+
+#if WITH_DEV_AUTOMATION_TESTS && MIXER_BACKEND_UE
+
+DEFINE_LATENT_AUTOMATION_COMMAND_ONE_PARAMETER(FWaitForMixerSoakCommand, FAutomationTestBase*, Test);
+
+bool FWaitForMixerSoakCommand::Update()
+{
+	const FMixerSoakTest& Soak = FMixerSoakTest::Get();
+	if (Soak.IsRunning())
+	{
+		return false;
+	}
+
+	const FMixerSoakTest::FVerdict& Verdict = Soak.GetLastVerdict();
+	for (const FString& Value : Verdict.GrowingValues)
+	{
+		Test->AddError(FString::Printf(TEXT("%s grew throughout the run."), *Value));
+	}
+	if (!Verdict.bConclusive)
+	{
+		Test->AddWarning(FString::Printf(TEXT("Inconclusive: at least %d samples past warm-up are needed; raise Mixer.Soak.SimulatedHours or lower Mixer.Soak.SampleMinutes."), MinSamplesForVerdict));
+	}
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMixerSoakAutomationTest, "MixerInteractivity.Soak", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::StressFilter)
+
+bool FMixerSoakAutomationTest::RunTest(const FString& Parameters)
+{
+	if (!FMixerSoakTest::Get().Start(CVarMixerSoakSimulatedHours.GetValueOnGameThread(), CVarMixerSoakTimeScale.GetValueOnGameThread(), CVarMixerSoakSampleMinutes.GetValueOnGameThread()))
+	{
+		AddError(TEXT("The soak couldn't start; see the log for why."));
+		return false;
+	}
+
+	ADD_LATENT_AUTOMATION_COMMAND(FWaitForMixerSoakCommand(this));
+	return true;
+}
+
+#endif
+
+#endif
@@ -0,0 +1,133 @@
+//*********************************************************
+//
+// Copyright (c) Microsoft. All rights reserved.
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT.
+//
+//*********************************************************
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MixerMockService.h"
+
+#ifndef MIXER_SOAK_TEST_ENABLED
+#define MIXER_SOAK_TEST_ENABLED MIXER_MOCK_SERVICE_ENABLED
+#endif
+
+#if MIXER_SOAK_TEST_ENABLED
+
+#include "Containers/Ticker.h"
+
+/**
+* Long running check for the plugin's per-session containers growing without bound, run as the
+* MixerInteractivity.Soak automation test, e.g. with -ExecCmds="Automation RunTests MixerInteractivity.Soak; Quit".
+* It connects interactivity and a chat room to the mock service, runs its audience at Mixer.Soak.TimeScale
+* times real time with churn and chat switched on, and every Mixer.Soak.SampleMinutes of simulated time
+* samples every container the module and chat connection report (see FMixerInteractivityModule::GetContainerSizes),
+* the blueprint event sources and the Mixer LLM tags.  Simulated time follows the ticks the mock is driven
+* by, so a hitch slows both alike.
+*
+* At the end of the run a growth report is logged and written to Saved/Mixer/Soak.  A value fails
+* the test if, once the first quarter of the run has been set aside as warm-up, every sample from the
+* second half of what remains exceeds every sample from the first.
+*/
+class FMixerSoakTest
+{
+public:
+	/** What a run found. */
+	struct FVerdict
+	{
+		/** Values that grew throughout the run */
+		TArray<FString> GrowingValues;
+		/** Whether there were enough samples past warm-up to tell */
+		bool bConclusive;
+
+		FVerdict()
+			: bConclusive(true)
+		{
+		}
+	};
+
+	static FMixerSoakTest& Get();
+
+	/** Begin a run lasting SimulatedHours at TimeScale times real time, sampling every SampleMinutes of simulated time. */
+	bool Start(float InSimulatedHours, float InTimeScale, float InSampleMinutes);
+
+	/** End the run in progress early and report on what has been sampled. */
+	void Stop();
+
+	/** Log the growth report for the samples taken so far. */
+	FVerdict Report() const;
+
+	bool IsRunning() const { return bRunning; }
+
+	/** The verdict of the last run to finish. */
+	const FVerdict& GetLastVerdict() const { return LastVerdict; }
+
+	/** Ends any run in progress without reporting.  Called at module shutdown. */
+	void Reset();
+
+private:
+	struct FMetric
+	{
+		FString Name;
+		// Sampled here, or left unset for values reported by GetContainerSizes
+		TFunction<int64()> Sample;
+		TArray<int64> Values;
+		// Growth under this much is put down to noise rather than a leak
+		int64 Slack;
+		// Values outside the plugin's control are reported but never fail a run
+		bool bCheckGrowth;
+	};
+
+	FMixerSoakTest();
+
+	bool Tick(float DeltaTime);
+
+	void AddMetric(const FString& Name, TFunction<int64()>&& Sample, int64 Slack, bool bCheckGrowth = true);
+	void AddSampledMetrics();
+	void TakeSample();
+
+	/** Add Value to this sample of the named value, adding the value if it's new. */
+	void RecordValue(const TCHAR* Name, int64 Value);
+
+	void Finish();
+	void EndSession();
+	void RestoreSettings();
+	bool WriteReport(const FString& Filename) const;
+
+	double GetSimulatedHours() const;
+
+	TArray<FMetric> Metrics;
+	TMap<FString, int32> MetricIndicesByName;
+	TArray<double> SampleHours;
+	FVerdict LastVerdict;
+	FDelegateHandle TickerHandle;
+
+	// Accumulated from the ticks the mock service is driven by, rather than read off the clock
+	double ElapsedSeconds;
+	double SimulatedSeconds;
+	double NextSampleSeconds;
+	// Reconnects are retried on an interval, and the loss warned of once per outage
+	double NextReconnectSeconds;
+	int32 NumReconnects;
+	bool bReconnecting;
+
+	float SimulatedHours;
+	float TimeScale;
+	float SampleMinutes;
+	bool bStartedInteractivity;
+	bool bRunning;
+
+	// Settings and console variables as they were before the run, put back at the end
+	FString SavedInteractiveEndpoint;
+	FString SavedChatEndpoint;
+	bool bSavedUseWarmStartCache;
+	float SavedTimeScale;
+	float SavedChurnPerSecond;
+	float SavedChatMessagesPerSecond;
+};
+
+#endif
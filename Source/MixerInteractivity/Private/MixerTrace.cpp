@@ -0,0 +1,62 @@
+//*********************************************************
+//
+// Copyright (c) Microsoft. All rights reserved.
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT.
+//
+//*********************************************************
+
+#include "MixerTrace.h"
+
+#if MIXER_TRACE_ENABLED
+
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformMisc.h"
+#include "HAL/PlatformAtomics.h"
+
+int32 GMixerTraceMessages = 0;
+
+static FAutoConsoleVariableRef CVarMixerTraceMessages(
+	TEXT("Mixer.TraceMessages"),
+	GMixerTraceMessages,
+	TEXT("When non-zero, Mixer emits named events for the receive, parse, dispatch, broadcast, send and reply of each message."),
+	ECVF_Default);
+
+namespace
+{
+	const FColor MixerTraceColor(31, 186, 237);
+
+	volatile int32 TraceSequence = 0;
+
+	FString FormatEventName(const TCHAR* Phase, const FString& Name, int32 MessageId)
+	{
+		return MessageId != INDEX_NONE ?
+			FString::Printf(TEXT("Mixer %s: %s #%d"), Phase, *Name, MessageId) :
+			FString::Printf(TEXT("Mixer %s: %s"), Phase, *Name);
+	}
+}
+
+void MixerTrace::Marker(const TCHAR* Phase, const FString& Name, int32 MessageId)
+{
+	FPlatformMisc::BeginNamedEvent(MixerTraceColor, *FormatEventName(Phase, Name, MessageId));
+	FPlatformMisc::EndNamedEvent();
+}
+
+void MixerTrace::BeginScope(const TCHAR* Phase, const FString& Name, int32 MessageId)
+{
+	FPlatformMisc::BeginNamedEvent(MixerTraceColor, *FormatEventName(Phase, Name, MessageId));
+}
+
+void MixerTrace::EndScope()
+{
+	FPlatformMisc::EndNamedEvent();
+}
+
+int32 MixerTrace::NextSequence()
+{
+	return FPlatformAtomics::InterlockedIncrement(&TraceSequence);
+}
+
+#endif
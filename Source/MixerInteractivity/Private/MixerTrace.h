@@ -0,0 +1,87 @@
+//*********************************************************
+//
+// Copyright (c) Microsoft. All rights reserved.
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT.
+//
+//*********************************************************
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+* Per-message lifecycle events (receive, parse, dispatch, Blueprint broadcast, send, reply) for
+* timeline profilers.  Events are platform named events, so they appear on the CPU track of the
+* thread that emitted them in Unreal Insights, PIX or Razor.  Compiled out of shipping builds,
+* and a single branch per site while Mixer.TraceMessages is 0.
+*/
+#ifndef MIXER_TRACE_ENABLED
+#define MIXER_TRACE_ENABLED !UE_BUILD_SHIPPING
+#endif
+
+#if MIXER_TRACE_ENABLED
+
+/** Non-zero while the Mixer message trace channel is on. */
+extern int32 GMixerTraceMessages;
+
+namespace MixerTrace
+{
+	/** A zero length event marking a point in a message's life.  MessageId may be INDEX_NONE. */
+	void Marker(const TCHAR* Phase, const FString& Name, int32 MessageId);
+
+	void BeginScope(const TCHAR* Phase, const FString& Name, int32 MessageId);
+	void EndScope();
+
+	/** Correlates a trace event across threads for sources that don't carry their own message id. */
+	int32 NextSequence();
+}
+
+class FMixerTraceScope
+{
+public:
+	FMixerTraceScope()
+		: bBegun(false)
+	{
+	}
+
+	~FMixerTraceScope()
+	{
+		if (bBegun)
+		{
+			MixerTrace::EndScope();
+		}
+	}
+
+	static bool IsActive()
+	{
+		return GMixerTraceMessages != 0;
+	}
+
+	void Begin(const TCHAR* Phase, const FString& Name, int32 MessageId)
+	{
+		MixerTrace::BeginScope(Phase, Name, MessageId);
+		bBegun = true;
+	}
+
+private:
+	bool bBegun;
+};
+
+// Arguments are only evaluated while the channel is on
+#define MIXER_TRACE_IS_ACTIVE() (GMixerTraceMessages != 0)
+#define MIXER_TRACE_MARKER(Phase, Name, MessageId) \
+	do { if (GMixerTraceMessages != 0) { MixerTrace::Marker(TEXT(Phase), Name, MessageId); } } while (0)
+#define MIXER_TRACE_SCOPE(Phase, Name, MessageId) \
+	FMixerTraceScope PREPROCESSOR_JOIN(MixerTraceScope, __LINE__); \
+	if (FMixerTraceScope::IsActive()) { PREPROCESSOR_JOIN(MixerTraceScope, __LINE__).Begin(TEXT(Phase), Name, MessageId); }
+
+#else
+
+#define MIXER_TRACE_IS_ACTIVE() false
+#define MIXER_TRACE_MARKER(Phase, Name, MessageId)
+#define MIXER_TRACE_SCOPE(Phase, Name, MessageId)
+
+#endif
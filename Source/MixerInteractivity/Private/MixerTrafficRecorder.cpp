@@ -0,0 +1,365 @@
+//*********************************************************
+//
+// Copyright (c) Microsoft. All rights reserved.
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT.
+//
+//*********************************************************
+
+#include "MixerTrafficRecorder.h"
+
+#if MIXER_TRAFFIC_RECORDER_ENABLED
+
+#include "MixerInteractivityLog.h"
+#include "Containers/StringConv.h"
+#include "Containers/Ticker.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformAtomics.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "Serialization/MemoryReader.h"
+
+static float GMixerReplaySpeed = 1.0f;
+static FAutoConsoleVariableRef CVarMixerReplaySpeed(
+	TEXT("Mixer.Replay.Speed"),
+	GMixerReplaySpeed,
+	TEXT("Playback rate for replay:// endpoints.  1 is as recorded, 4 is four times as fast, and 0 delivers frames as fast as they can be taken."),
+	ECVF_Default);
+
+static FAutoConsoleCommand CmdMixerRecordStart(
+	TEXT("Mixer.Record.Start"),
+	TEXT("Start recording Mixer interactive and chat traffic.  Takes an optional filename; relative names go under Saved/Mixer/Recordings."),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		const FString Filename = Args.Num() > 0 ? Args[0] : FString::Printf(TEXT("Session-%s.mixrec"), *FDateTime::Now().ToString());
+		FMixerTrafficRecorder::Get().Start(Filename);
+	}));
+
+static FAutoConsoleCommand CmdMixerRecordStop(
+	TEXT("Mixer.Record.Stop"),
+	TEXT("Stop recording Mixer traffic."),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		FMixerTrafficRecorder::Get().Stop();
+	}));
+
+namespace
+{
+	const TCHAR* ReplayEndpointPrefix = TEXT("replay://");
+
+	// Frames handed over per tick when replaying unpaced, so a long recording doesn't stall a single frame
+	const int32 UnpacedFramesPerTick = 10000;
+
+	uint8 MakeFrameTag(EMixerTrafficChannel Channel, EMixerTrafficDirection Direction)
+	{
+		return static_cast<uint8>(static_cast<uint8>(Channel) << 1) | static_cast<uint8>(Direction);
+	}
+}
+
+FMixerTrafficRecorder& FMixerTrafficRecorder::Get()
+{
+	static FMixerTrafficRecorder Instance;
+	return Instance;
+}
+
+FMixerTrafficRecorder::FMixerTrafficRecorder()
+	: LastFrameTime(0.0)
+	, NumFrames(0)
+	, bRecording(0)
+{
+}
+
+FString FMixerTrafficRecorder::GetRecordingPath(const FString& Filename)
+{
+	return FPaths::IsRelative(Filename) ? FPaths::ProjectSavedDir() / TEXT("Mixer") / TEXT("Recordings") / Filename : Filename;
+}
+
+bool FMixerTrafficRecorder::Start(const FString& Filename)
+{
+	Stop();
+
+	const FString Path = GetRecordingPath(Filename);
+	FArchive* NewWriter = IFileManager::Get().CreateFileWriter(*Path);
+	if (NewWriter == nullptr)
+	{
+		UE_LOG(LogMixerInteractivity, Warning, TEXT("Could not open %s for recording Mixer traffic."), *Path);
+		return false;
+	}
+
+	uint32 Magic = FileMagic;
+	uint32 Version = FileVersion;
+	int64 StartTicks = FDateTime::UtcNow().GetTicks();
+	*NewWriter << Magic;
+	*NewWriter << Version;
+	*NewWriter << StartTicks;
+
+	FScopeLock Lock(&WriterLock);
+	Writer.Reset(NewWriter);
+	WriterPath = Path;
+	LastFrameTime = FPlatformTime::Seconds();
+	NumFrames = 0;
+	FPlatformAtomics::InterlockedExchange(&bRecording, 1);
+
+	UE_LOG(LogMixerInteractivity, Log, TEXT("Recording Mixer traffic to %s"), *Path);
+	return true;
+}
+
+void FMixerTrafficRecorder::Stop()
+{
+	FScopeLock Lock(&WriterLock);
+	if (Writer.IsValid())
+	{
+		FPlatformAtomics::InterlockedExchange(&bRecording, 0);
+		Writer->Close();
+		Writer.Reset();
+		UE_LOG(LogMixerInteractivity, Log, TEXT("Recorded %u Mixer frames to %s"), NumFrames, *WriterPath);
+	}
+}
+
+void FMixerTrafficRecorder::Record(EMixerTrafficChannel Channel, EMixerTrafficDirection Direction, const FString& Frame)
+{
+	FTCHARToUTF8 Converted(*Frame, Frame.Len());
+	Record(Channel, Direction, Converted.Get(), Converted.Length());
+}
+
+void FMixerTrafficRecorder::Record(EMixerTrafficChannel Channel, EMixerTrafficDirection Direction, const ANSICHAR* Utf8Frame, int32 Length)
+{
+	FScopeLock Lock(&WriterLock);
+	if (!Writer.IsValid())
+	{
+		return;
+	}
+
+	// Timed under the lock so deltas from different threads can't go negative
+	const double Now = FPlatformTime::Seconds();
+	uint32 DeltaMicroseconds = static_cast<uint32>(FMath::Clamp((Now - LastFrameTime) * 1000000.0, 0.0, static_cast<double>(MAX_uint32)));
+	uint32 ByteCount = static_cast<uint32>(Length);
+	uint8 Tag = MakeFrameTag(Channel, Direction);
+	LastFrameTime = Now;
+
+	*Writer << Tag;
+	Writer->SerializeIntPacked(DeltaMicroseconds);
+	Writer->SerializeIntPacked(ByteCount);
+	Writer->Serialize(const_cast<ANSICHAR*>(Utf8Frame), Length);
+	++NumFrames;
+}
+
+/**
+* Delivers the channel's inbound frames from a recording, paced by their recorded timing from the
+* first of them.  Whatever the game sends is dropped; replies come from the recording as they did
+* on the night, which lines up as long as the game sends the same sequence of methods.
+*/
+class FMixerReplayWebSocket :
+	public IWebSocket,
+	public FTickerObjectBase,
+	public TSharedFromThis<FMixerReplayWebSocket>
+{
+public:
+	FMixerReplayWebSocket(const FString& InPath, EMixerTrafficChannel InChannel)
+		: Path(InPath)
+		, Channel(InChannel)
+		, NextFrame(0)
+		, PlaybackTime(0.0)
+		, bConnected(false)
+		, bConnectPending(false)
+	{
+	}
+
+	virtual void Connect() override
+	{
+		if (!bConnected)
+		{
+			bConnectPending = true;
+		}
+	}
+
+	virtual void Close(int32 Code = 1000, const FString& Reason = FString()) override
+	{
+		bConnectPending = false;
+		if (bConnected)
+		{
+			bConnected = false;
+			ClosedEvent.Broadcast(Code, Reason, true);
+		}
+	}
+
+	virtual bool IsConnected() override
+	{
+		return bConnected;
+	}
+
+	virtual void Send(const FString& Data) override
+	{
+	}
+
+	virtual void Send(const void* Utf8Data, SIZE_T Size, bool bIsBinary) override
+	{
+	}
+
+	virtual FWebSocketConnectedEvent& OnConnected() override { return ConnectedEvent; }
+	virtual FWebSocketConnectionErrorEvent& OnConnectionError() override { return ConnectionErrorEvent; }
+	virtual FWebSocketClosedEvent& OnClosed() override { return ClosedEvent; }
+	virtual FWebSocketMessageEvent& OnMessage() override { return MessageEvent; }
+	virtual FWebSocketRawMessageEvent& OnRawMessage() override { return RawMessageEvent; }
+
+public:
+	virtual bool Tick(float DeltaTime) override;
+
+private:
+	bool LoadRecording();
+
+	struct FReplayFrame
+	{
+		double Time;
+		int32 Offset;
+		int32 Length;
+	};
+
+	FString Path;
+	EMixerTrafficChannel Channel;
+	TArray<uint8> RecordingData;
+	TArray<FReplayFrame> Frames;
+	int32 NextFrame;
+	double PlaybackTime;
+
+	FWebSocketConnectedEvent ConnectedEvent;
+	FWebSocketConnectionErrorEvent ConnectionErrorEvent;
+	FWebSocketClosedEvent ClosedEvent;
+	FWebSocketMessageEvent MessageEvent;
+	FWebSocketRawMessageEvent RawMessageEvent;
+	bool bConnected;
+	bool bConnectPending;
+};
+
+bool FMixerReplayWebSocket::LoadRecording()
+{
+	Frames.Reset();
+	NextFrame = 0;
+	PlaybackTime = 0.0;
+	if (!FFileHelper::LoadFileToArray(RecordingData, *Path))
+	{
+		return false;
+	}
+
+	FMemoryReader Reader(RecordingData);
+	uint32 Magic = 0;
+	uint32 Version = 0;
+	int64 StartTicks = 0;
+	Reader << Magic;
+	Reader << Version;
+	Reader << StartTicks;
+	if (Reader.IsError() || Magic != FMixerTrafficRecorder::FileMagic || Version != FMixerTrafficRecorder::FileVersion)
+	{
+		UE_LOG(LogMixerInteractivity, Warning, TEXT("%s is not a Mixer recording this version can replay."), *Path);
+		return false;
+	}
+
+	const uint8 WantedTag = MakeFrameTag(Channel, EMixerTrafficDirection::Inbound);
+	double FrameTime = 0.0;
+	double FirstFrameTime = -1.0;
+	while (!Reader.AtEnd())
+	{
+		uint8 Tag = 0;
+		uint32 DeltaMicroseconds = 0;
+		uint32 ByteCount = 0;
+		Reader << Tag;
+		Reader.SerializeIntPacked(DeltaMicroseconds);
+		Reader.SerializeIntPacked(ByteCount);
+		const int64 Offset = Reader.Tell();
+		if (Reader.IsError() || Offset + ByteCount > RecordingData.Num())
+		{
+			// Recordings cut short by a crash are still good up to here
+			UE_LOG(LogMixerInteractivity, Warning, TEXT("Mixer recording %s is truncated; replaying the first %d frames."), *Path, Frames.Num());
+			break;
+		}
+
+		Reader.Seek(Offset + ByteCount);
+		FrameTime += DeltaMicroseconds / 1000000.0;
+		if (Tag == WantedTag)
+		{
+			if (FirstFrameTime < 0.0)
+			{
+				FirstFrameTime = FrameTime;
+			}
+
+			FReplayFrame& Frame = Frames[Frames.AddUninitialized()];
+			Frame.Time = FrameTime - FirstFrameTime;
+			Frame.Offset = static_cast<int32>(Offset);
+			Frame.Length = static_cast<int32>(ByteCount);
+		}
+	}
+
+	UE_LOG(LogMixerInteractivity, Log, TEXT("Replaying %d %s frames (%.1f s) from %s"),
+		Frames.Num(), Channel == EMixerTrafficChannel::Chat ? TEXT("chat") : TEXT("interactive"), Frames.Num() > 0 ? Frames.Last().Time : 0.0, *Path);
+	return true;
+}
+
+bool FMixerReplayWebSocket::Tick(float DeltaTime)
+{
+	if (bConnectPending)
+	{
+		bConnectPending = false;
+		if (LoadRecording())
+		{
+			bConnected = true;
+			ConnectedEvent.Broadcast();
+		}
+		else
+		{
+			ConnectionErrorEvent.Broadcast(FString::Printf(TEXT("Could not read Mixer recording %s"), *Path));
+		}
+		return true;
+	}
+
+	if (!bConnected || NextFrame >= Frames.Num())
+	{
+		return true;
+	}
+
+	// A handler may close and release us part way through
+	TSharedRef<FMixerReplayWebSocket> KeepAlive = AsShared();
+
+	const bool bPaced = GMixerReplaySpeed > 0.0f;
+	const int32 LastFrame = bPaced ? Frames.Num() : FMath::Min(NextFrame + UnpacedFramesPerTick, Frames.Num());
+	if (bPaced)
+	{
+		PlaybackTime += DeltaTime * GMixerReplaySpeed;
+	}
+
+	while (bConnected && NextFrame < LastFrame && (!bPaced || Frames[NextFrame].Time <= PlaybackTime))
+	{
+		const FReplayFrame& Frame = Frames[NextFrame++];
+		FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(RecordingData.GetData() + Frame.Offset), Frame.Length);
+		if (!bPaced)
+		{
+			// Keeps timing continuous should pacing be turned back on
+			PlaybackTime = Frame.Time;
+		}
+		MessageEvent.Broadcast(FString(Converted.Length(), Converted.Get()));
+	}
+
+	if (NextFrame == Frames.Num())
+	{
+		UE_LOG(LogMixerInteractivity, Log, TEXT("Finished replaying %s"), *Path);
+	}
+
+	return true;
+}
+
+bool FMixerTrafficReplay::IsReplayEndpoint(const FString& Url)
+{
+	return Url.StartsWith(ReplayEndpointPrefix);
+}
+
+TSharedRef<IWebSocket> FMixerTrafficReplay::CreateSocket(const FString& Url, EMixerTrafficChannel Channel)
+{
+	const FString Filename = Url.RightChop(FCString::Strlen(ReplayEndpointPrefix));
+	return MakeShared<FMixerReplayWebSocket>(FMixerTrafficRecorder::GetRecordingPath(Filename), Channel);
+}
+
+#endif
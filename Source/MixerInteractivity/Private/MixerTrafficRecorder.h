@@ -0,0 +1,88 @@
+//*********************************************************
+//
+// Copyright (c) Microsoft. All rights reserved.
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT.
+//
+//*********************************************************
+#pragma once
+
+#include "CoreMinimal.h"
+
+#ifndef MIXER_TRAFFIC_RECORDER_ENABLED
+#define MIXER_TRAFFIC_RECORDER_ENABLED !UE_BUILD_SHIPPING
+#endif
+
+#if MIXER_TRAFFIC_RECORDER_ENABLED
+
+#include "HAL/CriticalSection.h"
+#include "IWebSocket.h"
+
+enum class EMixerTrafficChannel : uint8
+{
+	Interactive,
+	Chat,
+	LiveEvents,
+};
+
+enum class EMixerTrafficDirection : uint8
+{
+	Inbound,
+	Outbound,
+};
+
+/**
+* Captures interactive and chat frames as they cross the socket, with timestamps, to a compact
+* binary file that can be played back through a replay:// endpoint override.  Controlled by the
+* Mixer.Record.Start [file] and Mixer.Record.Stop console commands.  Safe to call from any thread.
+*
+* File layout: 'MXRC', version, start time (UTC ticks), then per frame a tag byte
+* (channel << 1 | direction), packed microseconds since the previous frame, packed byte count
+* and the UTF-8 frame itself.
+*/
+class FMixerTrafficRecorder
+{
+public:
+	static FMixerTrafficRecorder& Get();
+
+	/** Relative filenames go under Saved/Mixer/Recordings.  Ends any recording in progress. */
+	bool Start(const FString& Filename);
+	void Stop();
+
+	bool IsRecording() const { return bRecording != 0; }
+
+	void Record(EMixerTrafficChannel Channel, EMixerTrafficDirection Direction, const FString& Frame);
+	void Record(EMixerTrafficChannel Channel, EMixerTrafficDirection Direction, const ANSICHAR* Utf8Frame, int32 Length);
+
+	static FString GetRecordingPath(const FString& Filename);
+
+	static const uint32 FileMagic = 0x4352584D;
+	static const uint32 FileVersion = 1;
+
+private:
+	FMixerTrafficRecorder();
+
+	FCriticalSection WriterLock;
+	TUniquePtr<FArchive> Writer;
+	FString WriterPath;
+	double LastFrameTime;
+	uint32 NumFrames;
+	volatile int32 bRecording;
+};
+
+/**
+* Plays back the inbound frames of a recording made by FMixerTrafficRecorder, in place of a
+* connection to the service.  Selected by setting InteractiveEndpointOverride (or
+* ChatEndpointOverride) to replay://<file>; each connection replays the frames of its own channel.
+* Mixer.Replay.Speed scales the recorded timing, with 0 replaying as fast as frames can be taken.
+*/
+class FMixerTrafficReplay
+{
+public:
+	static bool IsReplayEndpoint(const FString& Url);
+	static TSharedRef<IWebSocket> CreateSocket(const FString& Url, EMixerTrafficChannel Channel);
+};
+
+#endif
@@ -0,0 +1,486 @@
+//*********************************************************
+//
+// Copyright (c) Microsoft. All rights reserved.
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT.
+//
+//*********************************************************
+#include "MixerWarmStartCache.h"
+#include "MixerInteractivityLog.h"
+#include "MixerInteractivitySettings.h"
+#include "Containers/Ticker.h"
+#include "HAL/FileManager.h"
+#include "Misc/Crc.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+
+namespace
+{
+	// Bumped whenever the layout changes; older files are ignored rather than migrated.
+	const int32 WarmStartCacheVersion = 1;
+
+	// Room names and scenes rarely change, and are confirmed by every session that uses them anyway.
+	const int64 WarmStartEntryLifetimeSeconds = 7 * 24 * 60 * 60;
+
+	// Network conditions move faster than that, though a stale ranking only costs a worse first pick.
+	const int64 WarmStartRankingLifetimeSeconds = 24 * 60 * 60;
+
+	const float WarmStartSaveDelaySeconds = 2.0f;
+
+	const TCHAR* VersionField = TEXT("version");
+	const TCHAR* UserIdField = TEXT("userId");
+	const TCHAR* GameVersionIdField = TEXT("gameVersionId");
+	const TCHAR* ShareCodeHashField = TEXT("shareCodeHash");
+	const TCHAR* ScenesHashField = TEXT("scenesHash");
+	const TCHAR* ScenesSavedAtField = TEXT("scenesSavedAt");
+	const TCHAR* ChatEndpointsField = TEXT("chatEndpoints");
+	const TCHAR* ChatEndpointsSavedAtField = TEXT("chatEndpointsSavedAt");
+	const TCHAR* ChannelsField = TEXT("channels");
+	const TCHAR* ChannelIdField = TEXT("id");
+	const TCHAR* SavedAtField = TEXT("savedAt");
+
+	int64 GetTimestamp()
+	{
+		return FDateTime::UtcNow().ToUnixTimestamp();
+	}
+
+	bool IsFresh(int64 SavedAt, int64 Lifetime)
+	{
+		const int64 Age = GetTimestamp() - SavedAt;
+		return Age >= 0 && Age <= Lifetime;
+	}
+
+	uint32 HashShareCode(const FString& ShareCode)
+	{
+		// The share code itself is a secret of sorts, so only its hash goes to disk
+		return ShareCode.IsEmpty() ? 0 : FCrc::StrCrc32(*ShareCode);
+	}
+}
+
+FMixerWarmStartCache::FCacheContents::FCacheContents()
+	: UserId(0)
+	, GameVersionId(0)
+	, ShareCodeHash(0)
+	, ScenesHash(0)
+	, ScenesSavedAt(0)
+	, RankedChatEndpointsSavedAt(0)
+{
+}
+
+FMixerWarmStartCache& FMixerWarmStartCache::Get()
+{
+	static FMixerWarmStartCache Instance;
+	return Instance;
+}
+
+FMixerWarmStartCache::FMixerWarmStartCache()
+	: bLoaded(false)
+	, bScenesDirty(false)
+{
+}
+
+bool FMixerWarmStartCache::IsEnabled() const
+{
+	return GetDefault<UMixerInteractivitySettings>()->bUseWarmStartCache;
+}
+
+void FMixerWarmStartCache::Prefetch()
+{
+	check(IsInGameThread());
+	if (bLoaded || LoadTask.IsValid() || !IsEnabled())
+	{
+		return;
+	}
+
+	TSharedPtr<FCacheContents, ESPMode::ThreadSafe> Loaded = MakeShared<FCacheContents, ESPMode::ThreadSafe>();
+	LoadedContents = Loaded;
+	const FString CacheFilename = GetCacheFilename();
+	const FString ScenesFilename = GetScenesFilename();
+	LoadTask = FFunctionGraphTask::CreateAndDispatchWhenReady([Loaded, CacheFilename, ScenesFilename]()
+	{
+		LoadContents(CacheFilename, ScenesFilename, *Loaded);
+	}, TStatId(), nullptr, ENamedThreads::AnyThread);
+}
+
+void FMixerWarmStartCache::WaitForLoad()
+{
+	check(IsInGameThread());
+	if (bLoaded)
+	{
+		return;
+	}
+
+	// Normally started with login, which leaves it plenty of time to finish before anything asks
+	Prefetch();
+	if (LoadTask.IsValid())
+	{
+		FTaskGraphInterface::Get().WaitUntilTaskCompletes(LoadTask);
+		LoadTask.SafeRelease();
+		Contents = MoveTemp(*LoadedContents);
+		LoadedContents.Reset();
+	}
+	bLoaded = true;
+}
+
+void FMixerWarmStartCache::LoadContents(const FString& CacheFilename, const FString& ScenesFilename, FCacheContents& OutContents)
+{
+	FString CacheJson;
+	if (!FFileHelper::LoadFileToString(CacheJson, *CacheFilename))
+	{
+		return;
+	}
+
+	TSharedRef<TJsonReader<>> JsonReader = TJsonReaderFactory<>::Create(CacheJson);
+	TSharedPtr<FJsonObject> JsonObject;
+	int32 Version = 0;
+	if (!FJsonSerializer::Deserialize(JsonReader, JsonObject) || !JsonObject.IsValid() ||
+		!JsonObject->TryGetNumberField(VersionField, Version) || Version != WarmStartCacheVersion)
+	{
+		UE_LOG(LogMixerInteractivity, Log, TEXT("Ignoring unreadable or outdated warm start cache %s."), *CacheFilename);
+		return;
+	}
+
+	double Number = 0.0;
+	JsonObject->TryGetNumberField(UserIdField, OutContents.UserId);
+	JsonObject->TryGetNumberField(GameVersionIdField, OutContents.GameVersionId);
+	if (JsonObject->TryGetNumberField(ShareCodeHashField, Number))
+	{
+		OutContents.ShareCodeHash = static_cast<uint32>(Number);
+	}
+	if (JsonObject->TryGetNumberField(ScenesHashField, Number))
+	{
+		OutContents.ScenesHash = static_cast<uint32>(Number);
+	}
+	if (JsonObject->TryGetNumberField(ScenesSavedAtField, Number))
+	{
+		OutContents.ScenesSavedAt = static_cast<int64>(Number);
+	}
+	if (JsonObject->TryGetNumberField(ChatEndpointsSavedAtField, Number))
+	{
+		OutContents.RankedChatEndpointsSavedAt = static_cast<int64>(Number);
+	}
+	JsonObject->TryGetStringArrayField(ChatEndpointsField, OutContents.RankedChatEndpoints);
+
+	const TSharedPtr<FJsonObject>* ChannelsObject;
+	if (JsonObject->TryGetObjectField(ChannelsField, ChannelsObject))
+	{
+		for (const TPair<FString, TSharedPtr<FJsonValue>>& Channel : (*ChannelsObject)->Values)
+		{
+			const TSharedPtr<FJsonObject>* ChannelObject;
+			FChannelEntry Entry;
+			if (Channel.Value->TryGetObject(ChannelObject) &&
+				(*ChannelObject)->TryGetNumberField(ChannelIdField, Entry.ChannelId) &&
+				(*ChannelObject)->TryGetNumberField(SavedAtField, Number) &&
+				Entry.ChannelId != 0)
+			{
+				Entry.SavedAt = static_cast<int64>(Number);
+				OutContents.Channels.Add(Channel.Key, Entry);
+			}
+		}
+	}
+
+	// Written separately since it's by far the largest part, and only changes with the Game Version.
+	// The hash catches a scenes file that doesn't belong with this one, e.g. after an interrupted save.
+	if (OutContents.ScenesHash != 0 &&
+		(!FFileHelper::LoadFileToString(OutContents.ScenesJson, *ScenesFilename) || FCrc::StrCrc32(*OutContents.ScenesJson) != OutContents.ScenesHash))
+	{
+		UE_LOG(LogMixerInteractivity, Log, TEXT("Warm start scenes are missing or don't match the cache; ignoring them."));
+		OutContents.ScenesJson.Empty();
+		OutContents.ScenesHash = 0;
+	}
+}
+
+void FMixerWarmStartCache::ValidateUser(int32 UserId)
+{
+	if (!IsEnabled() || UserId == 0)
+	{
+		return;
+	}
+
+	WaitForLoad();
+	if (Contents.UserId == UserId)
+	{
+		return;
+	}
+
+	if (Contents.UserId != 0)
+	{
+		UE_LOG(LogMixerInteractivity, Log, TEXT("Warm start cache was recorded for another user; discarding it."));
+		const bool bHadScenes = !Contents.ScenesJson.IsEmpty();
+		Contents = FCacheContents();
+		Scenes.Reset();
+		MarkDirty(bHadScenes);
+	}
+
+	Contents.UserId = UserId;
+	MarkDirty(false);
+}
+
+TSharedPtr<FJsonObject> FMixerWarmStartCache::GetScenes(uint32& OutHash)
+{
+	if (!IsEnabled())
+	{
+		return nullptr;
+	}
+
+	WaitForLoad();
+	const UMixerInteractivitySettings* Settings = GetDefault<UMixerInteractivitySettings>();
+	if (Contents.ScenesJson.IsEmpty() ||
+		Contents.GameVersionId != Settings->GameVersionId ||
+		Contents.ShareCodeHash != HashShareCode(Settings->ShareCode) ||
+		!IsFresh(Contents.ScenesSavedAt, WarmStartEntryLifetimeSeconds))
+	{
+		return nullptr;
+	}
+
+	if (!Scenes.IsValid())
+	{
+		TSharedRef<TJsonReader<>> JsonReader = TJsonReaderFactory<>::Create(Contents.ScenesJson);
+		if (!FJsonSerializer::Deserialize(JsonReader, Scenes) || !Scenes.IsValid())
+		{
+			Scenes.Reset();
+			return nullptr;
+		}
+	}
+
+	OutHash = Contents.ScenesHash;
+	return Scenes;
+}
+
+void FMixerWarmStartCache::RecordScenes(const FString& ScenesJson, uint32 Hash)
+{
+	if (!IsEnabled() || ScenesJson.IsEmpty())
+	{
+		return;
+	}
+
+	WaitForLoad();
+	const UMixerInteractivitySettings* Settings = GetDefault<UMixerInteractivitySettings>();
+	const bool bChanged = Hash != Contents.ScenesHash || Contents.GameVersionId != Settings->GameVersionId || Contents.ShareCodeHash != HashShareCode(Settings->ShareCode);
+	Contents.GameVersionId = Settings->GameVersionId;
+	Contents.ShareCodeHash = HashShareCode(Settings->ShareCode);
+	Contents.ScenesSavedAt = GetTimestamp();
+	if (bChanged)
+	{
+		Contents.ScenesHash = Hash;
+		Contents.ScenesJson = ScenesJson;
+		Scenes.Reset();
+	}
+
+	// Unchanged scenes still get their timestamp renewed, so that a version in steady use never expires
+	MarkDirty(bChanged);
+}
+
+uint32 FMixerWarmStartCache::SerializeScenes(const TSharedPtr<FJsonObject>& ScenesResult, FString& OutScenesJson)
+{
+	OutScenesJson.Empty();
+	TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> JsonWriter = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&OutScenesJson);
+	FJsonSerializer::Serialize(ScenesResult.ToSharedRef(), JsonWriter);
+	return FCrc::StrCrc32(*OutScenesJson);
+}
+
+int32 FMixerWarmStartCache::FindChannelId(const FString& RoomKey)
+{
+	if (!IsEnabled())
+	{
+		return 0;
+	}
+
+	WaitForLoad();
+	const FChannelEntry* Entry = Contents.Channels.Find(RoomKey);
+	return Entry != nullptr && IsFresh(Entry->SavedAt, WarmStartEntryLifetimeSeconds) ? Entry->ChannelId : 0;
+}
+
+void FMixerWarmStartCache::RecordChannelId(const FString& RoomKey, int32 ChannelId)
+{
+	if (!IsEnabled() || ChannelId == 0)
+	{
+		return;
+	}
+
+	WaitForLoad();
+	FChannelEntry& Entry = Contents.Channels.FindOrAdd(RoomKey);
+	Entry.ChannelId = ChannelId;
+	Entry.SavedAt = GetTimestamp();
+	MarkDirty(false);
+}
+
+void FMixerWarmStartCache::ForgetChannelId(const FString& RoomKey)
+{
+	if (!IsEnabled())
+	{
+		return;
+	}
+
+	WaitForLoad();
+	if (Contents.Channels.Remove(RoomKey) > 0)
+	{
+		MarkDirty(false);
+	}
+}
+
+bool FMixerWarmStartCache::GetRankedChatEndpoints(const TArray<FString>& Candidates, TArray<FString>& OutRankedEndpoints)
+{
+	if (!IsEnabled())
+	{
+		return false;
+	}
+
+	WaitForLoad();
+	if (Contents.RankedChatEndpoints.Num() != Candidates.Num() || !IsFresh(Contents.RankedChatEndpointsSavedAt, WarmStartRankingLifetimeSeconds))
+	{
+		return false;
+	}
+
+	for (const FString& Endpoint : Candidates)
+	{
+		if (!Contents.RankedChatEndpoints.Contains(Endpoint))
+		{
+			return false;
+		}
+	}
+
+	OutRankedEndpoints = Contents.RankedChatEndpoints;
+	return true;
+}
+
+void FMixerWarmStartCache::RecordRankedChatEndpoints(const TArray<FString>& RankedEndpoints)
+{
+	if (!IsEnabled() || RankedEndpoints.Num() == 0)
+	{
+		return;
+	}
+
+	WaitForLoad();
+	Contents.RankedChatEndpoints = RankedEndpoints;
+	Contents.RankedChatEndpointsSavedAt = GetTimestamp();
+	MarkDirty(false);
+}
+
+void FMixerWarmStartCache::MarkDirty(bool bScenesChanged)
+{
+	bScenesDirty |= bScenesChanged;
+	if (!SaveDelayHandle.IsValid())
+	{
+		SaveDelayHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FMixerWarmStartCache::OnSaveDelayElapsed), WarmStartSaveDelaySeconds);
+	}
+}
+
+bool FMixerWarmStartCache::OnSaveDelayElapsed(float DeltaTime)
+{
+	SaveDelayHandle.Reset();
+	StartSave();
+	return false;
+}
+
+void FMixerWarmStartCache::StartSave()
+{
+	// Only one write at a time, so that an older snapshot can never land on top of a newer one.
+	WaitForSave();
+
+	const FString CacheJson = SerializeContents(Contents);
+	const bool bWriteScenes = bScenesDirty;
+	const FString ScenesJson = bWriteScenes ? Contents.ScenesJson : FString();
+	bScenesDirty = false;
+
+	const FString CacheFilename = GetCacheFilename();
+	const FString ScenesFilename = GetScenesFilename();
+	SaveTask = FFunctionGraphTask::CreateAndDispatchWhenReady([CacheJson, ScenesJson, bWriteScenes, CacheFilename, ScenesFilename]()
+	{
+		// Scenes first: a cache file whose hash doesn't match the scenes on disk just ignores them
+		if (bWriteScenes)
+		{
+			if (ScenesJson.IsEmpty())
+			{
+				IFileManager::Get().Delete(*ScenesFilename, false, false, true);
+			}
+			else if (!FFileHelper::SaveStringToFile(ScenesJson, *ScenesFilename))
+			{
+				UE_LOG(LogMixerInteractivity, Warning, TEXT("Failed to save warm start scenes to %s."), *ScenesFilename);
+			}
+		}
+
+		if (!FFileHelper::SaveStringToFile(CacheJson, *CacheFilename))
+		{
+			UE_LOG(LogMixerInteractivity, Warning, TEXT("Failed to save warm start cache to %s."), *CacheFilename);
+		}
+	}, TStatId(), nullptr, ENamedThreads::AnyThread);
+}
+
+void FMixerWarmStartCache::WaitForSave()
+{
+	if (SaveTask.IsValid())
+	{
+		FTaskGraphInterface::Get().WaitUntilTaskCompletes(SaveTask);
+		SaveTask.SafeRelease();
+	}
+}
+
+void FMixerWarmStartCache::Flush()
+{
+	check(IsInGameThread());
+	if (SaveDelayHandle.IsValid())
+	{
+		FTicker::GetCoreTicker().RemoveTicker(SaveDelayHandle);
+		SaveDelayHandle.Reset();
+		StartSave();
+	}
+	WaitForSave();
+
+	if (LoadTask.IsValid())
+	{
+		FTaskGraphInterface::Get().WaitUntilTaskCompletes(LoadTask);
+		LoadTask.SafeRelease();
+		LoadedContents.Reset();
+	}
+}
+
+FString FMixerWarmStartCache::SerializeContents(const FCacheContents& Contents)
+{
+	TSharedRef<FJsonObject> JsonObject = MakeShared<FJsonObject>();
+	JsonObject->SetNumberField(VersionField, WarmStartCacheVersion);
+	JsonObject->SetNumberField(UserIdField, Contents.UserId);
+	JsonObject->SetNumberField(GameVersionIdField, Contents.GameVersionId);
+	JsonObject->SetNumberField(ShareCodeHashField, Contents.ShareCodeHash);
+	JsonObject->SetNumberField(ScenesHashField, Contents.ScenesHash);
+	JsonObject->SetNumberField(ScenesSavedAtField, static_cast<double>(Contents.ScenesSavedAt));
+	JsonObject->SetNumberField(ChatEndpointsSavedAtField, static_cast<double>(Contents.RankedChatEndpointsSavedAt));
+
+	TArray<TSharedPtr<FJsonValue>> EndpointsJson;
+	for (const FString& Endpoint : Contents.RankedChatEndpoints)
+	{
+		EndpointsJson.Add(MakeShared<FJsonValueString>(Endpoint));
+	}
+	JsonObject->SetArrayField(ChatEndpointsField, EndpointsJson);
+
+	TSharedRef<FJsonObject> ChannelsJson = MakeShared<FJsonObject>();
+	for (const TPair<FString, FChannelEntry>& Channel : Contents.Channels)
+	{
+		TSharedRef<FJsonObject> ChannelJson = MakeShared<FJsonObject>();
+		ChannelJson->SetNumberField(ChannelIdField, Channel.Value.ChannelId);
+		ChannelJson->SetNumberField(SavedAtField, static_cast<double>(Channel.Value.SavedAt));
+		ChannelsJson->SetObjectField(Channel.Key, ChannelJson);
+	}
+	JsonObject->SetObjectField(ChannelsField, ChannelsJson);
+
+	FString CacheJson;
+	TSharedRef<TJsonWriter<>> JsonWriter = TJsonWriterFactory<>::Create(&CacheJson);
+	FJsonSerializer::Serialize(JsonObject, JsonWriter);
+	return CacheJson;
+}
+
+FString FMixerWarmStartCache::GetCacheFilename()
+{
+	return FPaths::ProjectSavedDir() / TEXT("Mixer") / TEXT("WarmStart.json");
+}
+
+FString FMixerWarmStartCache::GetScenesFilename()
+{
+	return FPaths::ProjectSavedDir() / TEXT("Mixer") / TEXT("WarmStartScenes.json");
+}
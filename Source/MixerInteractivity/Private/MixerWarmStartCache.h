@@ -0,0 +1,114 @@
+//*********************************************************
+//
+// Copyright (c) Microsoft. All rights reserved.
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT.
+//
+//*********************************************************
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "Dom/JsonObject.h"
+
+/**
+* Discovery results remembered across launches (under Saved/Mixer), so that the next session can
+* start from them instead of waiting on the service: the interactive scenes for the configured
+* Game Version and share code, the channel id behind each chat room, and the latest chat endpoint
+* ranking.  Everything served from here is confirmed by the live lookup it stands in for, and is
+* replaced (or dropped) when that disagrees.  Belongs to the user it was recorded for; a different
+* user signing in discards it.
+*
+* The file is read on a worker as soon as login starts and written on a worker a little after the
+* last change.  Game thread only.  Does nothing unless bUseWarmStartCache is set.
+*/
+class FMixerWarmStartCache
+{
+public:
+	static FMixerWarmStartCache& Get();
+
+	/** Start reading the cache from disk if that hasn't happened yet. */
+	void Prefetch();
+
+	/** Discard the cache if it was recorded for someone else, and claim it for this user otherwise. */
+	void ValidateUser(int32 UserId);
+
+	/**
+	* Get the getScenes result recorded for the current Game Version and share code.
+	*
+	* @return	the result, or null if there isn't one or it has expired.  OutHash is set to its SerializeScenes hash.
+	*/
+	TSharedPtr<FJsonObject> GetScenes(uint32& OutHash);
+
+	/** Remember a getScenes result, as serialized by SerializeScenes. */
+	void RecordScenes(const FString& ScenesJson, uint32 Hash);
+
+	/** Serialize a getScenes result the way RecordScenes expects, returning its hash. */
+	static uint32 SerializeScenes(const TSharedPtr<FJsonObject>& ScenesResult, FString& OutScenesJson);
+
+	/** @return	the recorded channel id for a (lower case) room id, or 0 if unknown. */
+	int32 FindChannelId(const FString& RoomKey);
+	void RecordChannelId(const FString& RoomKey, int32 ChannelId);
+	void ForgetChannelId(const FString& RoomKey);
+
+	/**
+	* Get the recorded chat endpoint ranking, provided it covers exactly the endpoints in Candidates.
+	*/
+	bool GetRankedChatEndpoints(const TArray<FString>& Candidates, TArray<FString>& OutRankedEndpoints);
+	void RecordRankedChatEndpoints(const TArray<FString>& RankedEndpoints);
+
+	/** Write out any pending changes and wait for outstanding disk access to finish. */
+	void Flush();
+
+private:
+	struct FChannelEntry
+	{
+		int32 ChannelId;
+		int64 SavedAt;
+	};
+
+	struct FCacheContents
+	{
+		int32 UserId;
+		int32 GameVersionId;
+		uint32 ShareCodeHash;
+		uint32 ScenesHash;
+		int64 ScenesSavedAt;
+		FString ScenesJson;
+		TArray<FString> RankedChatEndpoints;
+		int64 RankedChatEndpointsSavedAt;
+		TMap<FString, FChannelEntry> Channels;
+
+		FCacheContents();
+	};
+
+	FMixerWarmStartCache();
+
+	bool IsEnabled() const;
+	void WaitForLoad();
+	void MarkDirty(bool bScenesChanged);
+	bool OnSaveDelayElapsed(float DeltaTime);
+	void StartSave();
+	void WaitForSave();
+
+	static void LoadContents(const FString& CacheFilename, const FString& ScenesFilename, FCacheContents& OutContents);
+	static FString SerializeContents(const FCacheContents& Contents);
+	static FString GetCacheFilename();
+	static FString GetScenesFilename();
+
+private:
+	FCacheContents Contents;
+
+	// Parsed on demand from Contents.ScenesJson
+	TSharedPtr<FJsonObject> Scenes;
+
+	FGraphEventRef LoadTask;
+	TSharedPtr<FCacheContents, ESPMode::ThreadSafe> LoadedContents;
+	bool bLoaded;
+
+	FDelegateHandle SaveDelayHandle;
+	FGraphEventRef SaveTask;
+	bool bScenesDirty;
+};
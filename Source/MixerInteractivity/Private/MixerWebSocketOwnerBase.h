@@ -1,13 +1,28 @@
 #pragma once
 
 #include "Dom/JsonObject.h"
+#include "Misc/Crc.h"
 #include "WebSocketsModule.h"
 #include "IWebSocket.h"
 #include "MixerInteractivityLog.h"
+#include "MixerInteractivityStats.h"
+#include "MixerTrace.h"
+#include "MixerCsvStats.h"
+#include "MixerInteractivityLLM.h"
+#include "MixerMockService.h"
+#include "MixerTrafficRecorder.h"
+#include "MixerBenchmarks.h"
 #include "MixerJsonHelpers.h"
+#include "MixerJsonArena.h"
+#include "MixerFrameScheduler.h"
+#include "MixerAllocationGuard.h"
 #include "Policies/JsonPrintPolicy.h"
 #include "Policies/CondensedJsonPrintPolicy.h"
 #include "Serialization/JsonSerializerMacros.h"
+#include "Serialization/MemoryWriter.h"
+#include "Containers/Queue.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "MixerInteractivitySettings.h"
 
 #if PLATFORM_XBOXONE
 #include "XboxOne/MixerXboxOneWebSocket.h"
@@ -16,8 +31,77 @@
 template <class T>
 class TMixerWebSocketOwnerBase
 {
+public:
+	/**
+	* Dispatch messages parsed off the game thread, expire stuck replies and send queued
+	* outbound messages.  Owners should call this once per tick.
+	*/
+	void TickConnection();
+
+	struct FReplyLatencyStats
+	{
+		FReplyLatencyStats()
+			: NumReplies(0)
+			, TotalSeconds(0.0)
+			, MaxSeconds(0.0)
+			, NumTimedOut(0)
+			, NumUnsent(0)
+		{
+		}
+
+		int32 NumReplies;
+		double TotalSeconds;
+		double MaxSeconds;
+		int32 NumTimedOut;
+		/** Still queued when the connection went, so never sent. */
+		int32 NumUnsent;
+	};
+
+	/** Round trip times for methods sent on this connection, keyed by method name. */
+	const TMap<FName, FReplyLatencyStats>& GetReplyLatencyStats() const { return ReplyLatencyStats; }
+
+	/** Methods sent on this connection whose reply has yet to arrive or time out. */
+	int32 GetNumPendingReplies() const { return NumPendingReplies; }
+
+	struct FConnectionHealthStats
+	{
+		FConnectionHealthStats()
+			: NumPings(0)
+			, NumMissedPings(0)
+			, LastRoundTripSeconds(0.0)
+			, SmoothedRoundTripSeconds(0.0)
+			, JitterSeconds(0.0)
+			, NumFailovers(0)
+		{
+		}
+
+		// Answered and missed pings on the current socket
+		int32 NumPings;
+		int32 NumMissedPings;
+		double LastRoundTripSeconds;
+		// Smoothed as for TCP's SRTT (RFC 6298), and jitter as for RTP (RFC 3550)
+		double SmoothedRoundTripSeconds;
+		double JitterSeconds;
+		// Across every socket this owner has opened
+		int32 NumFailovers;
+	};
+
+	/** Ping round trip times for the current socket.  All zero if health monitoring is off for this connection. */
+	const FConnectionHealthStats& GetConnectionHealthStats() const { return HealthStats; }
+
+#if MIXER_BENCHMARKS_ENABLED
+	/** Connect to a bench:// socket (see FMixerBenchmarks), which is always connected and discards sends. */
+	void InitBenchmarkConnection(const TCHAR* Name)		{ InitConnection(FString(TEXT("bench://")) + Name, TMap<FString, FString>()); }
+
+	/** Decode a frame on the calling thread, as the parse task would have, and leave it for DispatchBenchmarkFrames. */
+	void DecodeBenchmarkFrame(const FString& MessageJsonString);
+
+	/** Dispatch everything DecodeBenchmarkFrame has queued, whatever the frame budget, and send what that queues. */
+	void DispatchBenchmarkFrames();
+#endif
+
 protected:
-	TMixerWebSocketOwnerBase(const FString& InServerInitiatedMessageType, const FString& InServerInitiatedMessageSubtypeName, const FString& InServerInitiatedMessageParamsName);
+	TMixerWebSocketOwnerBase(const FMixerStringConstant& InServerInitiatedMessageType, const FMixerStringConstant& InServerInitiatedMessageSubtypeName, const FMixerStringConstant& InServerInitiatedMessageParamsName);
 	virtual ~TMixerWebSocketOwnerBase();
 
 	void InitConnection(const FString& Url, const TMap<FString,FString>& UpgradeHeaders);
@@ -25,15 +109,43 @@ protected:
 
 	typedef bool (T::*FServerMessageHandler)(FJsonObject*);
 
+	// Streaming handlers receive a cursor over the params object and avoid building a json DOM for the message.
+	// Suitable for flat payloads on hot paths; anything needing nested data should use FServerMessageHandler.
+	typedef bool (T::*FServerMessageStreamHandler)(FMixerJsonCursor&);
+
 	void RegisterServerMessageHandler(const FString& MessageType, FServerMessageHandler Handler);
+	void RegisterServerMessageStreamHandler(const FString& MessageType, FServerMessageStreamHandler Handler);
 	virtual bool OnUnhandledServerMessage(const FString& MessageType, const TSharedPtr<FJsonObject> Params) = 0;
 
-	void SendMethodMessageNoParams(const FString& MethodName, FServerMessageHandler Handler);
-	void SendMethodMessageObjectParams(const FString& MethodName, FServerMessageHandler Handler, const FJsonSerializable& ObjectStyleParams);
-	void SendMethodMessageObjectParams(const FString& MethodName, FServerMessageHandler Handler, const TSharedRef<FJsonObject> ObjectStyleParams);
+	// The SendMethodMessage* functions return the id the message was sent with, for matching up its reply.
+	int32 SendMethodMessageNoParams(const FString& MethodName, FServerMessageHandler Handler);
+	int32 SendMethodMessageObjectParams(const FString& MethodName, FServerMessageHandler Handler, const FJsonSerializable& ObjectStyleParams);
+	int32 SendMethodMessageObjectParams(const FString& MethodName, FServerMessageHandler Handler, const TSharedRef<FJsonObject> ObjectStyleParams);
+
+	/** Send a method whose params object has already been serialized to UTF-8 Json.  The text is copied into the message as-is. */
+	int32 SendMethodMessageSerializedParams(const FString& MethodName, FServerMessageHandler Handler, TArrayView<const uint8> Utf8ObjectParams);
 
 	template <class ... ArgTypes>
-	void SendMethodMessageArrayParams(const FString& MethodName, FServerMessageHandler Handler, ArgTypes... ArrayStyleParams);
+	int32 SendMethodMessageArrayParams(const FString& MethodName, FServerMessageHandler Handler, ArgTypes&&... ArrayStyleParams);
+
+	/**
+	* Send a method whose params are a single array field (e.g. updateParticipants).  When outbound batching
+	* is enabled, consecutive calls for the same method are merged into one message, subject to the max frame size.
+	* Merged methods can't have individual reply handlers.
+	*/
+	void SendMethodMessageMergeableParams(const FString& MethodName, const FString& ArrayFieldName, const TSharedRef<FJsonObject> Entry);
+
+	/**
+	* Send many entries for a mergeable method at once.  They are split into as few messages as the max
+	* frame size allows, whether or not outbound batching is enabled.
+	*/
+	void SendMethodMessageMergeableParams(const FString& MethodName, const FString& ArrayFieldName, const TArray<TSharedPtr<FJsonObject>>& Entries);
+
+	/** Id that will be assigned to the next method sent, for matching up replies. */
+	int32 GetNextMessageId() const { return MessageId; }
+
+	/** FPlatformTime::Seconds() at which the frame now being dispatched came off the socket, or 0 outside of dispatch. */
+	double GetDispatchingMessageReceivedTime() const { return DispatchingMessageReceivedTime; }
 
 	virtual void HandleSocketConnected() = 0;
 	virtual void HandleSocketConnectionError() = 0;
@@ -41,7 +153,47 @@ protected:
 
 	virtual void RegisterAllServerMessageHandlers() = 0;
 
+#if MIXER_TRAFFIC_RECORDER_ENABLED
+	/** Which stream of a recording this connection's frames belong to. */
+	virtual EMixerTrafficChannel GetTrafficChannel() const;
+#endif
+
+	/** Which share of the frame budget dispatching this connection's messages comes out of. */
+	virtual EMixerFrameWorkSource GetFrameWorkSource() const;
+
+	/** Method sent (without params) to measure round trip time.  Empty disables health monitoring. */
+	virtual FString GetHealthPingMethodName() const { return FString(); }
+
+	/** Called with the reply to each health ping, after the round trip has been recorded. */
+	virtual void HandleHealthPingReply(FJsonObject* JsonObj, double RoundTrip) {}
+
+	/**
+	* Whether queued messages for this method at least OutboundBulkMessageSize long may be sent after
+	* smaller messages queued later.  Bulk methods always stay in order with respect to each other.
+	*/
+	virtual bool IsBulkMethod(const FString& MethodName) const { return false; }
+
+	/**
+	* Whether the message being sent must not be held back as bulk.  Any bulk messages already waiting
+	* go out with it, ahead of it, so that it neither waits nor overtakes them.
+	*/
+	virtual bool IsUrgentSend() const { return false; }
+
+	/**
+	* Called from TickConnection once ConnectionFailoverPingCount pings in a row have been slow or
+	* unanswered.  Owners with somewhere better to go should close this socket and move on to it.
+	*/
+	virtual void HandleConnectionDegraded() {}
+
 private:
+	static FString GetCompressionExtensionOffer(bool bContextTakeover);
+
+	/** Size of the frame as it came off the wire, for the byte counters.  The socket hands it over already widened to TCHAR. */
+	static int32 GetWireLength(const FString& MessageJsonString)
+	{
+		return FTCHARToUTF8_Convert::ConvertedLength(*MessageJsonString, MessageJsonString.Len());
+	}
+
 	void OnSocketConnected();
 	void OnSocketConnectionError(const FString& ErrorMessage);
 	void OnSocketMessage(const FString& MessageJsonString);
@@ -49,68 +201,345 @@ private:
 
 	bool OnSocketMessage(FJsonObject* JsonObj);
 
-	typedef TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>> CondensedWriterType;
+#if PLATFORM_XBOXONE
+	/** Receive path for a socket that delivers on its own thread: the frame is decoded there and queued straight for dispatch. */
+	void OnSocketMessageOffThread(FString& MessageJsonString);
+#endif
+
+	struct FServerMessageRoute
+	{
+		FString Subtype;
+		uint32 SubtypeHash;
+		FServerMessageHandler Handler;
+		FServerMessageStreamHandler StreamHandler;
+	};
+
+	void AddServerMessageRoute(const FString& MessageType, FServerMessageHandler Handler, FServerMessageStreamHandler StreamHandler);
+	const FServerMessageRoute* FindServerMessageRoute(const FString& Subtype) const;
+	static bool MatchesInterned(const FString& Candidate, const FMixerStringConstant& Interned);
+
+	/** Finds the top level type and subtype fields.  Gives up as soon as the type turns out not to be RequiredType, when given. */
+	bool ReadMessageHeader(const FString& MessageJsonString, FString& OutMessageType, FString& OutSubtype, const FMixerStringConstant* RequiredType = nullptr) const;
+	bool TryDispatchToStreamHandler(const FString& MessageJsonString, FServerMessageStreamHandler Handler, bool& bOutHandled);
+
+	struct FInboundMessage
+	{
+		FInboundMessage()
+			: StreamHandler(nullptr)
+			, FrameNumber(INDEX_NONE)
+			, ReceivedTime(0.0)
+		{
+		}
+
+		FString RawMessage;
+		TSharedPtr<FJsonObject> JsonObj;
+		FServerMessageStreamHandler StreamHandler;
+
+		// Position in arrival order on this connection, for matching up trace events across threads
+		int32 FrameNumber;
+		double ReceivedTime;
+#if MIXER_TRACE_ENABLED
+		// Subtype (or message type) from the header, only filled in while tracing
+		FString TraceName;
+#endif
+	};
+
+	// Decoding must stay free of game thread state other than the route table (which is fixed for the life of a connection).
+	void DecodeMessage(FInboundMessage& Message) const;
+	void DispatchMessage(FInboundMessage& Message);
+
+	void ParseQueuedMessages();
+	void WaitForParseTasks();
+	/** Dispatch decoded messages until Deadline (FPlatformTime::Seconds), after at least one.  @return how many were dispatched. */
+	int32 PumpParsedMessages(double Deadline = MAX_dbl);
+	/** Bulk messages past OutboundBulkBytesPerTick are kept for next time unless bSendAllBulk. */
+	void FlushOutboundMessages(bool bSendAllBulk = false);
+
+	void AddPendingReply(const FString& MethodName, FServerMessageHandler Handler);
+	bool RemovePendingReply(int32 ReplyingToMessageId, FServerMessageHandler& OutHandler);
+	void ExpirePendingReplies();
+
+	void TickHealthMonitor();
+	void RecordPingReply(double RoundTrip);
+	void NotePoorPing();
+
+	// Payloads are written as UTF-8 directly into a pooled byte buffer and sent from there.
+	typedef TJsonWriter<UTF8CHAR, FMixerUtf8CondensedJsonPrintPolicy> CondensedWriterType;
 
-	TSharedRef<CondensedWriterType> StartMethodMessage(const FString& MethodName, FString& PayloadString);
-	void FinishMethodMessage(TSharedRef<CondensedWriterType> Writer);
-	void ActuallySendMethodMessage(FServerMessageHandler Handler, const FString& PayloadString);
+	int32 BeginPayload();
+	void SendPayload(int32 Offset, int32 Length, int32 SentMessageId);
+	void WriteMethodPrefix(const FString& MethodName, FArchive& PayloadArchive);
+	TSharedRef<CondensedWriterType> StartMethodMessage(const FString& MethodName, FArchive& PayloadArchive, const TArray<uint8>& ValueFieldPrefix);
+	void FinishMethodMessage(TSharedRef<CondensedWriterType> Writer, FArchive& PayloadArchive);
+	static void WritePayloadBytes(FArchive& PayloadArchive, const TArray<uint8>& Bytes);
+	static void BuildFieldPrefix(const FString& FieldName, TArray<uint8>& OutPrefix);
+	int32 ActuallySendMethodMessage(const FString& MethodName, FServerMessageHandler Handler, int32 PayloadOffset);
+	void ActuallySendMergedMethodMessage(const FString& MethodName, const FString& ArrayFieldName, const TArray<TSharedPtr<FJsonObject>>& Entries);
+	int32 MeasureMergeableEntry(const TSharedRef<FJsonObject>& Entry);
+	void QueueMergeableEntry(const FString& MethodName, const FString& ArrayFieldName, const TSharedRef<FJsonObject>& Entry, int32 EntrySize);
+
+	struct FOutboundMessage
+	{
+		FOutboundMessage()
+			: PayloadOffset(INDEX_NONE)
+			, PayloadLength(0)
+			, MessageId(INDEX_NONE)
+			, MergedSize(0)
+			, bBulk(false)
+		{
+		}
+
+		// Slice of PayloadBuffer holding the serialized form of regular methods
+		int32 PayloadOffset;
+		int32 PayloadLength;
+		int32 MessageId;
+
+		// Mergeable methods are serialized at flush time
+		FString MergeMethodName;
+		FString MergeArrayFieldName;
+		TArray<TSharedPtr<FJsonObject>> MergeEntries;
+		int32 MergedSize;
+
+		// Sent after the other messages, possibly on a later tick
+		bool bBulk;
+	};
 
 private:
 	template <class PARAM>
-	void WriteSingleRemoteMethodParam(CondensedWriterType& Writer, PARAM Param1);
+	static void WriteSingleRemoteMethodParam(CondensedWriterType& Writer, const PARAM& Param1);
 
 	template <class PARAM>
-	void WriteSingleRemoteMethodParam(CondensedWriterType& Writer, const TArray<PARAM>& Param1);
+	static void WriteSingleRemoteMethodParam(CondensedWriterType& Writer, const TArray<PARAM>& Param1);
 
-	template <class PARAM, class ...ArgTypes>
-	void WriteRemoteMethodParams(CondensedWriterType& Writer, PARAM Param1, ArgTypes... AdditionalArgs);
+	template <class ...ArgTypes>
+	static void WriteRemoteMethodParams(CondensedWriterType& Writer, ArgTypes&&... Args);
 
-	template <class PARAM>
-	void WriteRemoteMethodParams(CondensedWriterType& Writer, PARAM Param1);
+	// Method names compare case-sensitively on the wire, unlike FString's default key funcs.
+	struct FMethodPrefixKeyFuncs : TDefaultMapKeyFuncs<FString, TArray<uint8>, false>
+	{
+		static FORCEINLINE bool Matches(const FString& A, const FString& B)	{ return A.Equals(B, ESearchCase::CaseSensitive); }
+		static FORCEINLINE uint32 GetKeyHash(const FString& Key)			{ return FCrc::StrCrc32(*Key); }
+	};
 
 private:
 	TSharedPtr<IWebSocket> WebSocket;
-	FString ServerInitiatedMessageType;
-	FString ServerInitiatedMessageSubtypeName;
-	FString ServerInitiatedMessageParamsName;
-	TMap<int32, FServerMessageHandler> ReplyHandlers;
-	TMap<FString, FServerMessageHandler> ServerInitiatedMessageHandlers;
+	// Copies, so the precomputed hashes stay valid whatever the constructor was given
+	FMixerStringConstant ServerInitiatedMessageType;
+	FMixerStringConstant ServerInitiatedMessageSubtypeName;
+	FMixerStringConstant ServerInitiatedMessageParamsName;
+
+	struct FPendingReply
+	{
+		FPendingReply()
+			: MessageId(INDEX_NONE)
+			, Handler(nullptr)
+			, SentAt(0.0)
+		{
+		}
+
+		int32 MessageId;
+		FName MethodName;
+		FServerMessageHandler Handler;
+		double SentAt;
+	};
+
+	/** The outstanding reply for a message id, in the ring or moved aside to the overflow. */
+	FPendingReply* FindPendingReply(int32 ReplyingToMessageId);
+	/** Stop tracking the reply for a message id, moving it to OutReply.  @return	false if it wasn't outstanding. */
+	bool TakePendingReply(int32 ReplyingToMessageId, FPendingReply& OutReply);
+	/** Stop tracking replies for queued messages that will now never be sent. */
+	void TakeUnsentReplies(TArray<FPendingReply>& OutReplies);
+	/** Hand each unsent message's handler an error reply, as the server would have for a failed method. */
+	void FailUnsentReplies(const TArray<FPendingReply>& Replies);
+
+	// MessageId only ever increases, so outstanding replies live in a ring indexed by id.
+	// An unanswered entry still occupying a slot when it comes round again moves to the overflow map,
+	// so that bursts of more than PendingReplyRingSize requests don't cost anyone their handler.
+	static const int32 PendingReplyRingSize = 256;
+	static const double ReplyTimeoutSeconds;
+	FPendingReply PendingReplies[PendingReplyRingSize];
+	TMap<int32, FPendingReply> OverflowPendingReplies;
+	int32 NumPendingReplies;
+	TMap<FName, FReplyLatencyStats> ReplyLatencyStats;
+
+	// Small, fixed set of subtypes per connection, so a flat table probed by length and
+	// case-sensitive hash beats hashing the subtype case-insensitively through a TMap.
+	TArray<FServerMessageRoute> ServerInitiatedMessageRoutes;
+	int32 NumStreamRoutes;
+
+	// Game thread produces raw frames, the parse task consumes them and produces decoded messages for the game thread.
+	// A socket that receives off the game thread (Xbox One) produces decoded messages itself, bypassing UnparsedMessages.
+	TQueue<FInboundMessage, EQueueMode::Spsc> UnparsedMessages;
+	TQueue<FInboundMessage, EQueueMode::Spsc> ParsedMessages;
+	// Messages in either queue, so that what's dropped on cleanup comes off the CSV backlog
+	volatile int32 NumQueuedMessages;
+	FGraphEventArray ParseTasks;
+	volatile int32 bParseTaskActive;
+	bool bParseOnWorkerThread;
+	bool bSocketReceivesOffThread;
+
+	int32 ReceivedFrameCount;
+	double DispatchingMessageReceivedTime;
+
+	TArray<FOutboundMessage> OutboundMessages;
+	TArray<uint8> PayloadBuffer;
+	TArray<uint8> EntrySizingBuffer;
+
+	// UTF-8 for the fixed part of each method envelope - {"type":"method","method":"X" - built on first use.
+	TMap<FString, TArray<uint8>, FDefaultSetAllocator, FMethodPrefixKeyFuncs> MethodPrefixCache;
+	TArray<uint8> IdFieldPrefix;
+	TArray<uint8> ParamsFieldPrefix;
+	TArray<uint8> ArgumentsFieldPrefix;
+	int32 MaxOutboundFrameSize;
+	bool bBatchOutboundMessages;
+
+	// Bulk messages in OutboundMessages, including any held back from an earlier tick
+	int32 NumBulkOutboundMessages;
+	int32 OutboundBulkMessageSize;
+	int32 OutboundBulkBytesPerTick;
+
 	int32 MessageId;
 	int32 SequenceId;
+
+	// Health monitoring: at most one ping is outstanding at a time
+	FConnectionHealthStats HealthStats;
+	FString HealthPingMethodName;
+	int32 OutstandingPingId;
+	double PingSentAt;
+	double NextPingTime;
+	int32 NumConsecutivePoorPings;
+	bool bFailoverRequested;
 };
 
 template <class T>
-TMixerWebSocketOwnerBase<T>::TMixerWebSocketOwnerBase(const FString& InServerInitiatedMessageType, const FString& InServerInitiatedMessageSubtypeName, const FString& InServerInitiatedMessageParamsName)
+const double TMixerWebSocketOwnerBase<T>::ReplyTimeoutSeconds = 30.0;
+
+template <class T>
+TMixerWebSocketOwnerBase<T>::TMixerWebSocketOwnerBase(const FMixerStringConstant& InServerInitiatedMessageType, const FMixerStringConstant& InServerInitiatedMessageSubtypeName, const FMixerStringConstant& InServerInitiatedMessageParamsName)
 	: ServerInitiatedMessageType(InServerInitiatedMessageType)
 	, ServerInitiatedMessageSubtypeName(InServerInitiatedMessageSubtypeName)
 	, ServerInitiatedMessageParamsName(InServerInitiatedMessageParamsName)
+	, NumPendingReplies(0)
+	, NumStreamRoutes(0)
+	, NumQueuedMessages(0)
+	, bParseTaskActive(0)
+	, bParseOnWorkerThread(false)
+	, bSocketReceivesOffThread(false)
+	, ReceivedFrameCount(0)
+	, DispatchingMessageReceivedTime(0.0)
+	, MaxOutboundFrameSize(0)
+	, bBatchOutboundMessages(false)
+	, NumBulkOutboundMessages(0)
+	, OutboundBulkMessageSize(0)
+	, OutboundBulkBytesPerTick(0)
 	, MessageId(0)
 	, SequenceId(0)
+	, OutstandingPingId(INDEX_NONE)
+	, PingSentAt(0.0)
+	, NextPingTime(0.0)
+	, NumConsecutivePoorPings(0)
+	, bFailoverRequested(false)
 {
-
+	BuildFieldPrefix(MixerStringConstants::FieldNames::Id, IdFieldPrefix);
+	BuildFieldPrefix(MixerStringConstants::FieldNames::Params, ParamsFieldPrefix);
+	BuildFieldPrefix(MixerStringConstants::FieldNames::Arguments, ArgumentsFieldPrefix);
 }
 
 template <class T>
 TMixerWebSocketOwnerBase<T>::~TMixerWebSocketOwnerBase()
 {
 	CleanupConnection();
+	DEC_DWORD_STAT_BY(STAT_MixerPendingReplies, NumPendingReplies);
 }
 
 template <class T>
 void TMixerWebSocketOwnerBase<T>::InitConnection(const FString& Url, const TMap<FString, FString>& UpgradeHeaders)
 {
-	ServerInitiatedMessageHandlers.Empty();
+	ServerInitiatedMessageRoutes.Empty();
+	NumStreamRoutes = 0;
 	RegisterAllServerMessageHandlers();
 
+	const UMixerInteractivitySettings* Settings = GetDefault<UMixerInteractivitySettings>();
+	bParseOnWorkerThread = Settings->bParseMessagesOffGameThread;
+	bBatchOutboundMessages = Settings->bBatchOutboundMessages;
+	MaxOutboundFrameSize = Settings->MaxOutboundFrameSize;
+	OutboundBulkMessageSize = Settings->OutboundBulkMessageSize;
+	OutboundBulkBytesPerTick = Settings->OutboundBulkBytesPerTick;
+	OutboundMessages.Empty();
+	NumBulkOutboundMessages = 0;
+
+	for (FPendingReply& Slot : PendingReplies)
+	{
+		Slot = FPendingReply();
+	}
+	OverflowPendingReplies.Empty();
+	DEC_DWORD_STAT_BY(STAT_MixerPendingReplies, NumPendingReplies);
+	NumPendingReplies = 0;
+
+	const int32 NumFailovers = HealthStats.NumFailovers;
+	HealthStats = FConnectionHealthStats();
+	HealthStats.NumFailovers = NumFailovers;
+	HealthPingMethodName = Settings->ConnectionPingInterval > 0.0f ? GetHealthPingMethodName() : FString();
+	OutstandingPingId = INDEX_NONE;
+	NextPingTime = 0.0;
+	NumConsecutivePoorPings = 0;
+	bFailoverRequested = false;
+
 	// Explicitly list protocols for the benefit of Xbox
 	TArray<FString> Protocols;
 	Protocols.Add(TEXT("wss"));
 	Protocols.Add(TEXT("ws"));
+
+	TMap<FString, FString> ConnectionHeaders = UpgradeHeaders;
+	if (Settings->bRequestMessageCompression)
+	{
+#if PLATFORM_XBOXONE
+		// MessageWebSocket can't inflate frames, so accepting the extension would leave us with unreadable messages.
+		UE_LOG(LogMixerInteractivity, Log, TEXT("Message compression is not supported by the Xbox One websocket; connecting uncompressed."));
+#else
+		ConnectionHeaders.Add(TEXT("Sec-WebSocket-Extensions"), GetCompressionExtensionOffer(Settings->bCompressionContextTakeover));
+#endif
+	}
+
+#if MIXER_MOCK_SERVICE_ENABLED
+	if (FMixerMockService::IsMockEndpoint(Url))
+	{
+		WebSocket = FMixerMockService::Get().CreateSocket(Url);
+	}
+	else
+#endif
+#if MIXER_TRAFFIC_RECORDER_ENABLED
+	if (FMixerTrafficReplay::IsReplayEndpoint(Url))
+	{
+		// Replies come from the recording, which has none for our pings
+		HealthPingMethodName.Empty();
+		WebSocket = FMixerTrafficReplay::CreateSocket(Url, GetTrafficChannel());
+	}
+	else
+#endif
+#if MIXER_BENCHMARKS_ENABLED
+	if (FMixerBenchmarks::IsBenchmarkEndpoint(Url))
+	{
+		HealthPingMethodName.Empty();
+		WebSocket = FMixerBenchmarks::CreateSocket(Url);
+	}
+	else
+#endif
+	{
 #if PLATFORM_XBOXONE
-	WebSocket = MakeShared<FMixerXboxOneWebSocket>(Url, Protocols, UpgradeHeaders);
+		TSharedRef<FMixerXboxOneWebSocket> XboxWebSocket = MakeShared<FMixerXboxOneWebSocket>(Url, Protocols, ConnectionHeaders);
+		if (bParseOnWorkerThread)
+		{
+			// Frames already arrive on a thread pool thread, so decode them there rather than bouncing
+			// through the game thread to reach a parse task.
+			XboxWebSocket->SetOffThreadMessageHandler(FMixerXboxOneWebSocket::FOnMessageReceivedOffThread::CreateRaw(this, &TMixerWebSocketOwnerBase::OnSocketMessageOffThread));
+			bSocketReceivesOffThread = true;
+		}
+		WebSocket = XboxWebSocket;
 #else
-	WebSocket = FModuleManager::LoadModuleChecked<FWebSocketsModule>("WebSockets").CreateWebSocket(Url, Protocols, UpgradeHeaders);
+		WebSocket = FModuleManager::LoadModuleChecked<FWebSocketsModule>("WebSockets").CreateWebSocket(Url, Protocols, ConnectionHeaders);
 #endif
+	}
 
 	if (WebSocket.IsValid())
 	{
@@ -123,21 +552,71 @@ void TMixerWebSocketOwnerBase<T>::InitConnection(const FString& Url, const TMap<
 	}
 }
 
+#if MIXER_TRAFFIC_RECORDER_ENABLED
+template <class T>
+EMixerTrafficChannel TMixerWebSocketOwnerBase<T>::GetTrafficChannel() const
+{
+	return ServerInitiatedMessageType == MixerStringConstants::MessageTypes::Method ? EMixerTrafficChannel::Interactive : EMixerTrafficChannel::Chat;
+}
+#endif
+
+template <class T>
+EMixerFrameWorkSource TMixerWebSocketOwnerBase<T>::GetFrameWorkSource() const
+{
+	return ServerInitiatedMessageType == MixerStringConstants::MessageTypes::Method ? EMixerFrameWorkSource::InteractiveEvents : EMixerFrameWorkSource::ChatMessages;
+}
+
+template <class T>
+FString TMixerWebSocketOwnerBase<T>::GetCompressionExtensionOffer(bool bContextTakeover)
+{
+	// Without takeover each message is deflated independently in both directions, so neither end
+	// has to hold on to a window between frames.
+	FString Offer = TEXT("permessage-deflate; client_max_window_bits");
+	if (!bContextTakeover)
+	{
+		Offer += TEXT("; client_no_context_takeover; server_no_context_takeover");
+	}
+	return Offer;
+}
+
 template <class T>
 void TMixerWebSocketOwnerBase<T>::CleanupConnection()
 {
 	if (WebSocket.IsValid())
 	{
+#if PLATFORM_XBOXONE
+		if (bSocketReceivesOffThread)
+		{
+			StaticCastSharedPtr<FMixerXboxOneWebSocket>(WebSocket)->ClearOffThreadMessageHandler();
+			bSocketReceivesOffThread = false;
+		}
+#endif
 		WebSocket->OnConnected().RemoveAll(this);
 		WebSocket->OnConnectionError().RemoveAll(this);
 		WebSocket->OnMessage().RemoveAll(this);
 		WebSocket->OnClosed().RemoveAll(this);
 
+		WaitForParseTasks();
+		UnparsedMessages.Empty();
+		ParsedMessages.Empty();
+		MIXER_CSV_BACKLOG(-FPlatformAtomics::InterlockedExchange(&NumQueuedMessages, 0));
+		ReceivedFrameCount = 0;
+
 		if (WebSocket->IsConnected())
 		{
+			// Get any last words (e.g. ready=false) out before closing.
+			FlushOutboundMessages(true);
 			WebSocket->Close();
 		}
 
+		// Not handed to their handlers: this runs from the destructor too, and owners abandon
+		// their in-flight work themselves when the socket goes.
+		TArray<FPendingReply> Unsent;
+		TakeUnsentReplies(Unsent);
+		OutboundMessages.Empty();
+		NumBulkOutboundMessages = 0;
+		PayloadBuffer.Empty();
+
 		WebSocket.Reset();
 	}
 }
@@ -145,221 +624,1184 @@ void TMixerWebSocketOwnerBase<T>::CleanupConnection()
 template <class T>
 void TMixerWebSocketOwnerBase<T>::RegisterServerMessageHandler(const FString& MessageType, FServerMessageHandler Handler)
 {
-	ServerInitiatedMessageHandlers.Add(MessageType, Handler);
-}
-
-template <class T>
-TSharedRef<typename TMixerWebSocketOwnerBase<T>::CondensedWriterType> TMixerWebSocketOwnerBase<T>::StartMethodMessage(const FString& MethodName, FString& PayloadString)
-{
-	TSharedRef<CondensedWriterType> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&PayloadString);
-	Writer->WriteObjectStart();
-	Writer->WriteValue(MixerStringConstants::FieldNames::Type, MixerStringConstants::MessageTypes::Method);
-	Writer->WriteValue(MixerStringConstants::FieldNames::Method, MethodName);
-	Writer->WriteValue(MixerStringConstants::FieldNames::Id, MessageId);
-	return Writer;
+	AddServerMessageRoute(MessageType, Handler, nullptr);
 }
 
 template <class T>
-void TMixerWebSocketOwnerBase<T>::FinishMethodMessage(TSharedRef<CondensedWriterType> Writer)
+void TMixerWebSocketOwnerBase<T>::RegisterServerMessageStreamHandler(const FString& MessageType, FServerMessageStreamHandler Handler)
 {
-	Writer->WriteObjectEnd();
-	Writer->Close();
+	AddServerMessageRoute(MessageType, nullptr, Handler);
+	++NumStreamRoutes;
 }
 
 template <class T>
-void TMixerWebSocketOwnerBase<T>::ActuallySendMethodMessage(FServerMessageHandler Handler, const FString& PayloadString)
+void TMixerWebSocketOwnerBase<T>::AddServerMessageRoute(const FString& MessageType, FServerMessageHandler Handler, FServerMessageStreamHandler StreamHandler)
 {
-	check(!ReplyHandlers.Contains(MessageId));
-	ReplyHandlers.Add(MessageId, Handler);
-	++MessageId;
+	check(FindServerMessageRoute(MessageType) == nullptr);
 
-	WebSocket->Send(PayloadString);
+	FServerMessageRoute& Route = ServerInitiatedMessageRoutes[ServerInitiatedMessageRoutes.AddDefaulted()];
+	Route.Subtype = MessageType;
+	Route.SubtypeHash = FCrc::StrCrc32(*MessageType);
+	Route.Handler = Handler;
+	Route.StreamHandler = StreamHandler;
 }
 
 template <class T>
-void TMixerWebSocketOwnerBase<T>::SendMethodMessageNoParams(const FString& MethodName, FServerMessageHandler Handler)
+bool TMixerWebSocketOwnerBase<T>::MatchesInterned(const FString& Candidate, const FMixerStringConstant& Interned)
 {
-	FString PayloadString;
-	TSharedRef<CondensedWriterType> Writer = StartMethodMessage(MethodName, PayloadString);
-	FinishMethodMessage(Writer);
-	ActuallySendMethodMessage(Handler, PayloadString);
+	return Candidate.Len() == Interned.Len() && Interned.Matches(Candidate, FCrc::StrCrc32(*Candidate));
 }
 
 template <class T>
-void TMixerWebSocketOwnerBase<T>::SendMethodMessageObjectParams(const FString& MethodName, FServerMessageHandler Handler, const FJsonSerializable& ObjectStyleParams)
+const typename TMixerWebSocketOwnerBase<T>::FServerMessageRoute* TMixerWebSocketOwnerBase<T>::FindServerMessageRoute(const FString& Subtype) const
 {
-	FString PayloadString;
-	TSharedRef<CondensedWriterType> Writer = StartMethodMessage(MethodName, PayloadString);
-	Writer->WriteIdentifierPrefix(MixerStringConstants::FieldNames::Params);
-	ObjectStyleParams.ToJson(Writer, false);
-	FinishMethodMessage(Writer);
-	ActuallySendMethodMessage(Handler, PayloadString);
+	const int32 SubtypeLen = Subtype.Len();
+	uint32 SubtypeHash = 0;
+	bool bHashComputed = false;
+	for (const FServerMessageRoute& Route : ServerInitiatedMessageRoutes)
+	{
+		// Length rejects most candidates before we pay for the hash.
+		if (Route.Subtype.Len() != SubtypeLen)
+		{
+			continue;
+		}
+
+		if (!bHashComputed)
+		{
+			SubtypeHash = FCrc::StrCrc32(*Subtype);
+			bHashComputed = true;
+		}
+
+		if (Route.SubtypeHash == SubtypeHash && Route.Subtype.Equals(Subtype, ESearchCase::CaseSensitive))
+		{
+			return &Route;
+		}
+	}
+
+	return nullptr;
 }
 
 template <class T>
-void TMixerWebSocketOwnerBase<T>::SendMethodMessageObjectParams(const FString& MethodName, FServerMessageHandler Handler, const TSharedRef<FJsonObject> ObjectStyleParams)
+int32 TMixerWebSocketOwnerBase<T>::BeginPayload()
 {
-	FString PayloadString;
-	TSharedRef<CondensedWriterType> Writer = StartMethodMessage(MethodName, PayloadString);
-	Writer->WriteIdentifierPrefix(MixerStringConstants::FieldNames::Params);
-	FJsonSerializer::Serialize(ObjectStyleParams, Writer, false);
-	FinishMethodMessage(Writer);
-	ActuallySendMethodMessage(Handler, PayloadString);
+	// Batched payloads accumulate until the flush; otherwise each one reuses the buffer from the start.
+	if (!bBatchOutboundMessages)
+	{
+		PayloadBuffer.Reset();
+	}
+	return PayloadBuffer.Num();
 }
 
 template <class T>
-template <class ... ArgTypes>
-void TMixerWebSocketOwnerBase<T>::SendMethodMessageArrayParams(const FString& MethodName, typename TMixerWebSocketOwnerBase<T>::FServerMessageHandler Handler, ArgTypes... ArrayStyleParams)
+void TMixerWebSocketOwnerBase<T>::SendPayload(int32 Offset, int32 Length, int32 SentMessageId)
 {
-	FString PayloadString;
-	TSharedRef<CondensedWriterType> Writer = StartMethodMessage(MethodName, PayloadString);
-	Writer->WriteArrayStart(MixerStringConstants::FieldNames::Arguments);
-	WriteRemoteMethodParams(Writer.Get(), ArrayStyleParams...);
-	Writer->WriteArrayEnd();
-	FinishMethodMessage(Writer);
-	ActuallySendMethodMessage(Handler, PayloadString);
+	check(Offset >= 0 && Offset + Length <= PayloadBuffer.Num());
+	INC_DWORD_STAT(STAT_MixerMessagesOut);
+	INC_DWORD_STAT_BY(STAT_MixerBytesOut, Length);
+	MIXER_CSV_COUNT(MessagesOut, 1);
+	MIXER_CSV_COUNT(BytesOut, Length);
+#if MIXER_TRACE_ENABLED
+	if (MIXER_TRACE_IS_ACTIVE())
+	{
+		// The reply slot still holds the method name unless the reply has somehow beaten the send.
+		const FPendingReply* Reply = FindPendingReply(SentMessageId);
+		MixerTrace::Marker(TEXT("Wire"), Reply != nullptr ? Reply->MethodName.ToString() : FString(TEXT("method")), SentMessageId);
+	}
+#endif
+	// Queued messages only start their reply clock as they actually go out.
+	if (FPendingReply* Reply = FindPendingReply(SentMessageId))
+	{
+		Reply->SentAt = FPlatformTime::Seconds();
+	}
+#if MIXER_TRAFFIC_RECORDER_ENABLED
+	if (FMixerTrafficRecorder::Get().IsRecording())
+	{
+		FMixerTrafficRecorder::Get().Record(GetTrafficChannel(), EMixerTrafficDirection::Outbound, reinterpret_cast<const ANSICHAR*>(PayloadBuffer.GetData() + Offset), Length);
+	}
+#endif
+	WebSocket->Send(PayloadBuffer.GetData() + Offset, Length, false);
 }
 
 template <class T>
-void TMixerWebSocketOwnerBase<T>::OnSocketConnected()
+void TMixerWebSocketOwnerBase<T>::WritePayloadBytes(FArchive& PayloadArchive, const TArray<uint8>& Bytes)
 {
-	HandleSocketConnected();
+	PayloadArchive.Serialize(const_cast<uint8*>(Bytes.GetData()), Bytes.Num());
 }
 
 template <class T>
-void TMixerWebSocketOwnerBase<T>::OnSocketConnectionError(const FString& ErrorMessage)
+void TMixerWebSocketOwnerBase<T>::BuildFieldPrefix(const FString& FieldName, TArray<uint8>& OutPrefix)
 {
-	UE_LOG(LogMixerInteractivity, Warning, TEXT("Failed to connect web socket with error %s"), *ErrorMessage);
-	CleanupConnection();
-	HandleSocketConnectionError();
+	// Field names are our own constants, so no escaping is needed.
+	FTCHARToUTF8 Converted(*FString::Printf(TEXT(",\"%s\":"), *FieldName));
+	OutPrefix.Reset();
+	OutPrefix.Append(reinterpret_cast<const uint8*>(Converted.Get()), Converted.Length());
 }
 
 template <class T>
-void TMixerWebSocketOwnerBase<T>::OnSocketMessage(const FString& MessageJsonString)
+void TMixerWebSocketOwnerBase<T>::WriteMethodPrefix(const FString& MethodName, FArchive& PayloadArchive)
 {
-	UE_LOG(LogMixerInteractivity, Verbose, TEXT("WebSocket message %s"), *MessageJsonString);
-
-	bool bHandled = false;
-	TSharedRef<TJsonReader<>> JsonReader = TJsonReaderFactory<>::Create(MessageJsonString);
-	TSharedPtr<FJsonObject> JsonObj;
-	if (FJsonSerializer::Deserialize(JsonReader, JsonObj) && JsonObj.IsValid())
+	TArray<uint8>* Prefix = MethodPrefixCache.Find(MethodName);
+	if (Prefix == nullptr)
 	{
-		bHandled = OnSocketMessage(JsonObj.Get());
-	}
+		// Let the writer take care of escaping, then drop the closing brace.
+		TArray<uint8> PrefixBytes;
+		FMemoryWriter PrefixArchive(PrefixBytes);
+		TSharedRef<CondensedWriterType> PrefixWriter = TJsonWriterFactory<UTF8CHAR, FMixerUtf8CondensedJsonPrintPolicy>::Create(&PrefixArchive);
+		PrefixWriter->WriteObjectStart();
+		PrefixWriter->WriteValue(MixerStringConstants::FieldNames::Type, MixerStringConstants::MessageTypes::Method);
+		PrefixWriter->WriteValue(MixerStringConstants::FieldNames::Method, MethodName);
+		PrefixWriter->WriteObjectEnd();
+		PrefixWriter->Close();
+		check(PrefixBytes.Num() > 0 && PrefixBytes.Last() == '}');
+		PrefixBytes.Pop(false);
 
-	if (!bHandled)
-	{
-		UE_LOG(LogMixerInteractivity, Warning, TEXT("Failed to handle websocket message from server: %s"), *MessageJsonString);
+		Prefix = &MethodPrefixCache.Add(MethodName, MoveTemp(PrefixBytes));
 	}
+
+	WritePayloadBytes(PayloadArchive, *Prefix);
+	WritePayloadBytes(PayloadArchive, IdFieldPrefix);
+
+	ANSICHAR IdBuffer[16];
+	const int32 IdLength = FCStringAnsi::Sprintf(IdBuffer, "%d", MessageId);
+	PayloadArchive.Serialize(IdBuffer, IdLength);
 }
 
 template <class T>
-void TMixerWebSocketOwnerBase<T>::OnSocketClosed(int32 StatusCode, const FString& Reason, bool bWasClean)
+TSharedRef<typename TMixerWebSocketOwnerBase<T>::CondensedWriterType> TMixerWebSocketOwnerBase<T>::StartMethodMessage(const FString& MethodName, FArchive& PayloadArchive, const TArray<uint8>& ValueFieldPrefix)
 {
-	UE_LOG(LogMixerInteractivity, Warning, TEXT("WebSocket closed with reason '%s'."), *Reason);
+	WriteMethodPrefix(MethodName, PayloadArchive);
+	WritePayloadBytes(PayloadArchive, ValueFieldPrefix);
 
-	CleanupConnection();
+	// The writer only ever sees the params/arguments value, as a root object or array.
+	return TJsonWriterFactory<UTF8CHAR, FMixerUtf8CondensedJsonPrintPolicy>::Create(&PayloadArchive);
+}
 
-	HandleSocketClosed(bWasClean);
+template <class T>
+void TMixerWebSocketOwnerBase<T>::FinishMethodMessage(TSharedRef<CondensedWriterType> Writer, FArchive& PayloadArchive)
+{
+	Writer->Close();
+
+	ANSICHAR ObjectEnd = '}';
+	PayloadArchive.Serialize(&ObjectEnd, 1);
 }
 
 template <class T>
-bool TMixerWebSocketOwnerBase<T>::OnSocketMessage(FJsonObject* JsonObj)
+int32 TMixerWebSocketOwnerBase<T>::ActuallySendMethodMessage(const FString& MethodName, FServerMessageHandler Handler, int32 PayloadOffset)
 {
-	bool bHandled = false;
-	GET_JSON_STRING_RETURN_FAILURE(Type, MessageType);
-	if (MessageType == MixerStringConstants::MessageTypes::Reply)
+	MIXER_TRACE_MARKER("Enqueue", MethodName, MessageId);
+	const int32 SentMessageId = MessageId;
+	AddPendingReply(MethodName, Handler);
+	++MessageId;
+
+	const int32 PayloadLength = PayloadBuffer.Num() - PayloadOffset;
+	if (bBatchOutboundMessages)
 	{
-		GET_JSON_INT_RETURN_FAILURE(Id, ReplyingToMessageId);
+		FOutboundMessage& Outbound = OutboundMessages[OutboundMessages.AddDefaulted()];
+		Outbound.PayloadOffset = PayloadOffset;
+		Outbound.PayloadLength = PayloadLength;
+		Outbound.MessageId = SentMessageId;
 
-		FServerMessageHandler Handler;
-		if (ReplyHandlers.RemoveAndCopyValue(ReplyingToMessageId, Handler))
+		if (IsUrgentSend())
 		{
-			if (Handler != nullptr)
+			// Release everything held back to go out this flush, in queue order, ahead of this message
+			if (NumBulkOutboundMessages > 0)
 			{
-				(static_cast<T*>(this)->*Handler)(JsonObj);
+				for (FOutboundMessage& Waiting : OutboundMessages)
+				{
+					Waiting.bBulk = false;
+				}
+				NumBulkOutboundMessages = 0;
 			}
-			bHandled = true;
 		}
-		else
+		// Small ones follow any bulk messages already waiting, so a bulk method's messages can't overtake each other
+		else if (OutboundBulkMessageSize > 0 && (PayloadLength >= OutboundBulkMessageSize || NumBulkOutboundMessages > 0) && IsBulkMethod(MethodName))
 		{
-			UE_LOG(LogMixerInteractivity, Error, TEXT("Received unexpected reply for unknown message id %d"), ReplyingToMessageId);
+			Outbound.bBulk = true;
+			++NumBulkOutboundMessages;
 		}
 	}
-	else if (MessageType == ServerInitiatedMessageType)
+	else
 	{
-		FString Subtype;
-		if (!JsonObj->TryGetStringField(ServerInitiatedMessageSubtypeName, Subtype))
-		{
-			UE_LOG(LogMixerInteractivity, Error, TEXT("Missing message subtype (%s)"), *ServerInitiatedMessageSubtypeName);
-			return false;
-		}
+		SendPayload(PayloadOffset, PayloadLength, SentMessageId);
+	}
+	return SentMessageId;
+}
 
-		TSharedPtr<FJsonValue> RawParams = JsonObj->TryGetField(ServerInitiatedMessageParamsName);
-		if (!RawParams.IsValid())
-		{
-			UE_LOG(LogMixerInteractivity, Error, TEXT("Missing message params (%s)"), *ServerInitiatedMessageParamsName);
-			return false;
-		}
+template <class T>
+void TMixerWebSocketOwnerBase<T>::ActuallySendMergedMethodMessage(const FString& MethodName, const FString& ArrayFieldName, const TArray<TSharedPtr<FJsonObject>>& Entries)
+{
+	MIXER_LLM_SCOPE(Messages);
+	const int32 PayloadOffset = BeginPayload();
+	FMemoryWriter PayloadArchive(PayloadBuffer, false, true);
+	TSharedRef<CondensedWriterType> Writer = StartMethodMessage(MethodName, PayloadArchive, ParamsFieldPrefix);
+	Writer->WriteObjectStart();
+	Writer->WriteArrayStart(ArrayFieldName);
+	for (const TSharedPtr<FJsonObject>& Entry : Entries)
+	{
+		FJsonSerializer::Serialize(Entry.ToSharedRef(), Writer, false);
+	}
+	Writer->WriteArrayEnd();
+	Writer->WriteObjectEnd();
+	FinishMethodMessage(Writer, PayloadArchive);
 
-		const TSharedPtr<FJsonObject>* Params = nullptr;
-		if (!RawParams->IsNull())
-		{
-			if (!RawParams->TryGetObject(Params))
-			{
-				UE_LOG(LogMixerInteractivity, Error, TEXT("Unexpected value %s for message params (%s)"), *RawParams->AsString(), *ServerInitiatedMessageParamsName);
-				return false;
-			}
-		}
+	// No reply handler, but the reply is still tracked for latency.
+	MIXER_TRACE_MARKER("Enqueue", MethodName, MessageId);
+	const int32 SentMessageId = MessageId;
+	AddPendingReply(MethodName, nullptr);
+	++MessageId;
+	SendPayload(PayloadOffset, PayloadBuffer.Num() - PayloadOffset, SentMessageId);
+}
+
+template <class T>
+void TMixerWebSocketOwnerBase<T>::SendMethodMessageMergeableParams(const FString& MethodName, const FString& ArrayFieldName, const TSharedRef<FJsonObject> Entry)
+{
+	if (!bBatchOutboundMessages)
+	{
+		TArray<TSharedPtr<FJsonObject>> SingleEntry;
+		SingleEntry.Add(Entry);
+		ActuallySendMergedMethodMessage(MethodName, ArrayFieldName, SingleEntry);
+		return;
+	}
 
-		FServerMessageHandler* Handler = ServerInitiatedMessageHandlers.Find(Subtype);
-		if (Handler != nullptr)
+	QueueMergeableEntry(MethodName, ArrayFieldName, Entry, MeasureMergeableEntry(Entry));
+}
+
+template <class T>
+void TMixerWebSocketOwnerBase<T>::SendMethodMessageMergeableParams(const FString& MethodName, const FString& ArrayFieldName, const TArray<TSharedPtr<FJsonObject>>& Entries)
+{
+	if (bBatchOutboundMessages)
+	{
+		for (const TSharedPtr<FJsonObject>& Entry : Entries)
 		{
-			if (*Handler != nullptr)
-			{
-				(static_cast<T*>(this)->**Handler)(Params != nullptr ? Params->Get() : nullptr);
-			}
-			bHandled = true;
+			const TSharedRef<FJsonObject> EntryRef = Entry.ToSharedRef();
+			QueueMergeableEntry(MethodName, ArrayFieldName, EntryRef, MeasureMergeableEntry(EntryRef));
 		}
-		else
+		return;
+	}
+
+	// Not batching, so send each frame-sized chunk straight away
+	const int32 EnvelopeSize = 64 + MethodName.Len() + ArrayFieldName.Len();
+	TArray<TSharedPtr<FJsonObject>> Chunk;
+	int32 ChunkSize = EnvelopeSize;
+	for (const TSharedPtr<FJsonObject>& Entry : Entries)
+	{
+		const int32 EntrySize = MeasureMergeableEntry(Entry.ToSharedRef());
+		if (Chunk.Num() > 0 && MaxOutboundFrameSize > 0 && ChunkSize + EntrySize > MaxOutboundFrameSize)
 		{
-			bHandled = OnUnhandledServerMessage(Subtype, Params != nullptr ? *Params : nullptr);
+			ActuallySendMergedMethodMessage(MethodName, ArrayFieldName, Chunk);
+			Chunk.Reset();
+			ChunkSize = EnvelopeSize;
 		}
+		Chunk.Add(Entry);
+		ChunkSize += EntrySize;
 	}
 
-	return bHandled;
+	if (Chunk.Num() > 0)
+	{
+		ActuallySendMergedMethodMessage(MethodName, ArrayFieldName, Chunk);
+	}
 }
 
 template <class T>
-template <class PARAM>
-void TMixerWebSocketOwnerBase<T>::WriteSingleRemoteMethodParam(CondensedWriterType& Writer, PARAM Param1)
+int32 TMixerWebSocketOwnerBase<T>::MeasureMergeableEntry(const TSharedRef<FJsonObject>& Entry)
 {
-	Writer.WriteValue(Param1);
+	EntrySizingBuffer.Reset();
+	FMemoryWriter EntryArchive(EntrySizingBuffer);
+	TSharedRef<CondensedWriterType> EntryWriter = TJsonWriterFactory<UTF8CHAR, FMixerUtf8CondensedJsonPrintPolicy>::Create(&EntryArchive);
+	FJsonSerializer::Serialize(Entry, EntryWriter);
+	// Plus the separating comma
+	return EntrySizingBuffer.Num() + 1;
 }
 
 template <class T>
-template <class PARAM>
-void TMixerWebSocketOwnerBase<T>::WriteSingleRemoteMethodParam(CondensedWriterType& Writer, const TArray<PARAM>& Param1)
+void TMixerWebSocketOwnerBase<T>::QueueMergeableEntry(const FString& MethodName, const FString& ArrayFieldName, const TSharedRef<FJsonObject>& Entry, int32 EntrySize)
 {
-	Writer.WriteArrayStart();
-	for (const PARAM& Val : Param1)
+	MIXER_LLM_SCOPE(Messages);
+	// Only merge with the immediately preceding message so that ordering relative to
+	// other methods (e.g. createGroups followed by updateParticipants) is preserved.
+	FOutboundMessage* Previous = OutboundMessages.Num() > 0 ? &OutboundMessages.Last() : nullptr;
+	if (Previous != nullptr &&
+		Previous->PayloadOffset == INDEX_NONE &&
+		Previous->MergeMethodName == MethodName &&
+		Previous->MergeArrayFieldName == ArrayFieldName &&
+		Previous->MergedSize + EntrySize <= MaxOutboundFrameSize)
 	{
-		Writer.WriteValue(Val);
+		Previous->MergeEntries.Add(Entry);
+		Previous->MergedSize += EntrySize;
+	}
+	else
+	{
+		FOutboundMessage& Outbound = OutboundMessages[OutboundMessages.AddDefaulted()];
+		Outbound.MergeMethodName = MethodName;
+		Outbound.MergeArrayFieldName = ArrayFieldName;
+		Outbound.MergeEntries.Add(Entry);
+		// Rough allowance for the envelope
+		Outbound.MergedSize = 64 + MethodName.Len() + ArrayFieldName.Len() + EntrySize;
 	}
-	Writer.WriteArrayEnd();
 }
 
 template <class T>
-template <class PARAM, class ...ArgTypes>
-void TMixerWebSocketOwnerBase<T>::WriteRemoteMethodParams(CondensedWriterType& Writer, PARAM Param1, ArgTypes... AdditionalArgs)
+void TMixerWebSocketOwnerBase<T>::FlushOutboundMessages(bool bSendAllBulk)
 {
-	WriteSingleRemoteMethodParam(Writer, Param1);
-	WriteRemoteMethodParams(Writer, AdditionalArgs...);
+	if (OutboundMessages.Num() == 0)
+	{
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_MixerSocketFlush);
+
+	if (!WebSocket.IsValid() || !WebSocket->IsConnected())
+	{
+		UE_LOG(LogMixerInteractivity, Warning, TEXT("Dropping %d outbound messages since the web socket is not connected."), OutboundMessages.Num());
+		TArray<FPendingReply> Unsent;
+		TakeUnsentReplies(Unsent);
+		OutboundMessages.Reset();
+		PayloadBuffer.Reset();
+		NumBulkOutboundMessages = 0;
+
+		// After the reset, since handlers may well queue something else.
+		FailUnsentReplies(Unsent);
+		return;
+	}
+
+	// Merged messages are appended to the payload buffer as we go, which is fine since
+	// slices are addressed by offset and the socket copies what it's given.
+	for (const FOutboundMessage& Outbound : OutboundMessages)
+	{
+		if (Outbound.bBulk)
+		{
+			continue;
+		}
+
+		if (Outbound.PayloadOffset != INDEX_NONE)
+		{
+			SendPayload(Outbound.PayloadOffset, Outbound.PayloadLength, Outbound.MessageId);
+		}
+		else
+		{
+			ActuallySendMergedMethodMessage(Outbound.MergeMethodName, Outbound.MergeArrayFieldName, Outbound.MergeEntries);
+		}
+	}
+
+	if (NumBulkOutboundMessages == 0)
+	{
+		// Keep the allocations around for next tick
+		OutboundMessages.Reset();
+		PayloadBuffer.Reset();
+		return;
+	}
+
+	// Bulk messages go out oldest first within the tick's allowance.  Those left over keep their place
+	// at the front of the queue and buffer, ahead of (but still sent after) whatever is queued next.
+	int32 BulkBytesSent = 0;
+	int32 NumKept = 0;
+	int32 KeptBytes = 0;
+	for (FOutboundMessage& Outbound : OutboundMessages)
+	{
+		if (!Outbound.bBulk)
+		{
+			continue;
+		}
+
+		if (NumKept == 0 && (bSendAllBulk || OutboundBulkBytesPerTick <= 0 || BulkBytesSent == 0 || BulkBytesSent + Outbound.PayloadLength <= OutboundBulkBytesPerTick))
+		{
+			SendPayload(Outbound.PayloadOffset, Outbound.PayloadLength, Outbound.MessageId);
+			BulkBytesSent += Outbound.PayloadLength;
+			continue;
+		}
+
+		// Slices only ever move towards the start, so this never overwrites one still to be moved
+		FMemory::Memmove(PayloadBuffer.GetData() + KeptBytes, PayloadBuffer.GetData() + Outbound.PayloadOffset, Outbound.PayloadLength);
+		Outbound.PayloadOffset = KeptBytes;
+		KeptBytes += Outbound.PayloadLength;
+		if (&OutboundMessages[NumKept] != &Outbound)
+		{
+			OutboundMessages[NumKept] = MoveTemp(Outbound);
+		}
+		++NumKept;
+	}
+
+	INC_DWORD_STAT_BY(STAT_MixerBulkMessagesHeldBack, NumKept);
+	NumBulkOutboundMessages = NumKept;
+	OutboundMessages.SetNum(NumKept, false);
+	PayloadBuffer.SetNum(KeptBytes, false);
+}
+
+template <class T>
+int32 TMixerWebSocketOwnerBase<T>::SendMethodMessageNoParams(const FString& MethodName, FServerMessageHandler Handler)
+{
+	MIXER_LLM_SCOPE(Messages);
+	const int32 PayloadOffset = BeginPayload();
+	FMemoryWriter PayloadArchive(PayloadBuffer, false, true);
+	WriteMethodPrefix(MethodName, PayloadArchive);
+	ANSICHAR ObjectEnd = '}';
+	PayloadArchive.Serialize(&ObjectEnd, 1);
+	return ActuallySendMethodMessage(MethodName, Handler, PayloadOffset);
+}
+
+template <class T>
+int32 TMixerWebSocketOwnerBase<T>::SendMethodMessageObjectParams(const FString& MethodName, FServerMessageHandler Handler, const FJsonSerializable& ObjectStyleParams)
+{
+	MIXER_LLM_SCOPE(Messages);
+	const int32 PayloadOffset = BeginPayload();
+	FMemoryWriter PayloadArchive(PayloadBuffer, false, true);
+	TSharedRef<CondensedWriterType> Writer = StartMethodMessage(MethodName, PayloadArchive, ParamsFieldPrefix);
+	// FJsonSerializable::ToJson only knows about TCHAR writers, so drive the serializer directly.
+	FJsonSerializerWriter<UTF8CHAR, FMixerUtf8CondensedJsonPrintPolicy> Serializer(Writer);
+	const_cast<FJsonSerializable&>(ObjectStyleParams).Serialize(Serializer, false);
+	FinishMethodMessage(Writer, PayloadArchive);
+	return ActuallySendMethodMessage(MethodName, Handler, PayloadOffset);
+}
+
+template <class T>
+int32 TMixerWebSocketOwnerBase<T>::SendMethodMessageObjectParams(const FString& MethodName, FServerMessageHandler Handler, const TSharedRef<FJsonObject> ObjectStyleParams)
+{
+	MIXER_LLM_SCOPE(Messages);
+	const int32 PayloadOffset = BeginPayload();
+	FMemoryWriter PayloadArchive(PayloadBuffer, false, true);
+	TSharedRef<CondensedWriterType> Writer = StartMethodMessage(MethodName, PayloadArchive, ParamsFieldPrefix);
+	FJsonSerializer::Serialize(ObjectStyleParams, Writer, false);
+	FinishMethodMessage(Writer, PayloadArchive);
+	return ActuallySendMethodMessage(MethodName, Handler, PayloadOffset);
+}
+
+template <class T>
+int32 TMixerWebSocketOwnerBase<T>::SendMethodMessageSerializedParams(const FString& MethodName, FServerMessageHandler Handler, TArrayView<const uint8> Utf8ObjectParams)
+{
+	MIXER_LLM_SCOPE(Messages);
+	const int32 PayloadOffset = BeginPayload();
+	FMemoryWriter PayloadArchive(PayloadBuffer, false, true);
+	WriteMethodPrefix(MethodName, PayloadArchive);
+	WritePayloadBytes(PayloadArchive, ParamsFieldPrefix);
+	PayloadArchive.Serialize(const_cast<uint8*>(Utf8ObjectParams.GetData()), Utf8ObjectParams.Num());
+
+	ANSICHAR ObjectEnd = '}';
+	PayloadArchive.Serialize(&ObjectEnd, 1);
+	return ActuallySendMethodMessage(MethodName, Handler, PayloadOffset);
+}
+
+template <class T>
+template <class ... ArgTypes>
+int32 TMixerWebSocketOwnerBase<T>::SendMethodMessageArrayParams(const FString& MethodName, typename TMixerWebSocketOwnerBase<T>::FServerMessageHandler Handler, ArgTypes&&... ArrayStyleParams)
+{
+	MIXER_LLM_SCOPE(Messages);
+	const int32 PayloadOffset = BeginPayload();
+	FMemoryWriter PayloadArchive(PayloadBuffer, false, true);
+	TSharedRef<CondensedWriterType> Writer = StartMethodMessage(MethodName, PayloadArchive, ArgumentsFieldPrefix);
+	Writer->WriteArrayStart();
+	WriteRemoteMethodParams(Writer.Get(), Forward<ArgTypes>(ArrayStyleParams)...);
+	Writer->WriteArrayEnd();
+	FinishMethodMessage(Writer, PayloadArchive);
+	return ActuallySendMethodMessage(MethodName, Handler, PayloadOffset);
+}
+
+template <class T>
+void TMixerWebSocketOwnerBase<T>::OnSocketConnected()
+{
+	HandleSocketConnected();
+}
+
+template <class T>
+void TMixerWebSocketOwnerBase<T>::OnSocketConnectionError(const FString& ErrorMessage)
+{
+	UE_LOG(LogMixerInteractivity, Warning, TEXT("Failed to connect web socket with error %s"), *ErrorMessage);
+	CleanupConnection();
+	HandleSocketConnectionError();
+}
+
+template <class T>
+void TMixerWebSocketOwnerBase<T>::OnSocketMessage(const FString& MessageJsonString)
+{
+	SCOPE_CYCLE_COUNTER(STAT_MixerSocketReceive);
+	MIXER_LLM_SCOPE(Messages);
+	INC_DWORD_STAT(STAT_MixerMessagesIn);
+	INC_DWORD_STAT_BY(STAT_MixerBytesIn, GetWireLength(MessageJsonString));
+	MIXER_CSV_COUNT(MessagesIn, 1);
+	MIXER_CSV_COUNT(BytesIn, GetWireLength(MessageJsonString));
+
+	UE_LOG(LogMixerInteractivity, Verbose, TEXT("WebSocket message %s"), *MessageJsonString);
+
+#if MIXER_TRAFFIC_RECORDER_ENABLED
+	if (FMixerTrafficRecorder::Get().IsRecording())
+	{
+		FMixerTrafficRecorder::Get().Record(GetTrafficChannel(), EMixerTrafficDirection::Inbound, MessageJsonString);
+	}
+#endif
+
+	FInboundMessage Message;
+	Message.RawMessage = MessageJsonString;
+	Message.FrameNumber = ++ReceivedFrameCount;
+	Message.ReceivedTime = FPlatformTime::Seconds();
+	MIXER_TRACE_MARKER("Receive", TEXT("frame"), Message.FrameNumber);
+
+	if (bParseOnWorkerThread)
+	{
+		UnparsedMessages.Enqueue(MoveTemp(Message));
+		FPlatformAtomics::InterlockedIncrement(&NumQueuedMessages);
+		MIXER_CSV_BACKLOG(1);
+		if (FPlatformAtomics::InterlockedCompareExchange(&bParseTaskActive, 1, 0) == 0)
+		{
+			ParseTasks.RemoveAll([](const FGraphEventRef& Task) { return Task->IsComplete(); });
+			ParseTasks.Add(FFunctionGraphTask::CreateAndDispatchWhenReady([this]()
+			{
+				ParseQueuedMessages();
+			}, TStatId(), nullptr, ENamedThreads::AnyThread));
+		}
+	}
+	else if (FMixerFrameScheduler::Get().IsBudgeted() || !ParsedMessages.IsEmpty())
+	{
+		// Hold it for TickConnection so it comes out of the frame budget, behind anything already waiting
+		DecodeMessage(Message);
+		ParsedMessages.Enqueue(MoveTemp(Message));
+		FPlatformAtomics::InterlockedIncrement(&NumQueuedMessages);
+		MIXER_CSV_BACKLOG(1);
+	}
+	else
+	{
+		DecodeMessage(Message);
+		DispatchMessage(Message);
+	}
+}
+
+#if PLATFORM_XBOXONE
+template <class T>
+void TMixerWebSocketOwnerBase<T>::OnSocketMessageOffThread(FString& MessageJsonString)
+{
+	SCOPE_CYCLE_COUNTER(STAT_MixerSocketParse);
+	MIXER_LLM_SCOPE(Messages);
+	INC_DWORD_STAT(STAT_MixerMessagesIn);
+	INC_DWORD_STAT_BY(STAT_MixerBytesIn, GetWireLength(MessageJsonString));
+	MIXER_CSV_COUNT(MessagesIn, 1);
+	MIXER_CSV_COUNT(BytesIn, GetWireLength(MessageJsonString));
+
+	UE_LOG(LogMixerInteractivity, Verbose, TEXT("WebSocket message %s"), *MessageJsonString);
+
+#if MIXER_TRAFFIC_RECORDER_ENABLED
+	if (FMixerTrafficRecorder::Get().IsRecording())
+	{
+		FMixerTrafficRecorder::Get().Record(GetTrafficChannel(), EMixerTrafficDirection::Inbound, MessageJsonString);
+	}
+#endif
+
+	// The socket's handler lock keeps calls in order and one at a time, so this is still the only producer.
+	FInboundMessage Message;
+	Message.RawMessage = MoveTemp(MessageJsonString);
+	Message.FrameNumber = FPlatformAtomics::InterlockedIncrement(&ReceivedFrameCount);
+	Message.ReceivedTime = FPlatformTime::Seconds();
+	MIXER_TRACE_MARKER("Receive", TEXT("frame"), Message.FrameNumber);
+
+	DecodeMessage(Message);
+	ParsedMessages.Enqueue(MoveTemp(Message));
+	FPlatformAtomics::InterlockedIncrement(&NumQueuedMessages);
+	MIXER_CSV_BACKLOG(1);
+}
+#endif
+
+template <class T>
+void TMixerWebSocketOwnerBase<T>::DecodeMessage(FInboundMessage& Message) const
+{
+	MIXER_LLM_SCOPE(Messages);
+	MIXER_TRACE_SCOPE("Parse", TEXT("frame"), Message.FrameNumber);
+
+#if MIXER_TRACE_ENABLED
+	if (MIXER_TRACE_IS_ACTIVE())
+	{
+		FString TraceType;
+		FString TraceSubtype;
+		ReadMessageHeader(Message.RawMessage, TraceType, TraceSubtype);
+		Message.TraceName = TraceSubtype.IsEmpty() ? TraceType : TraceSubtype;
+	}
+#endif
+
+	if (NumStreamRoutes > 0)
+	{
+		// Cheap pass over the top level to find out whether this message has a streaming handler.
+		// Replies and events have no subtype, so stop at their type rather than reading them twice.
+		FString MessageType;
+		FString Subtype;
+		if (ReadMessageHeader(Message.RawMessage, MessageType, Subtype, &ServerInitiatedMessageType))
+		{
+			const FServerMessageRoute* Route = FindServerMessageRoute(Subtype);
+			if (Route != nullptr && Route->StreamHandler != nullptr)
+			{
+				Message.StreamHandler = Route->StreamHandler;
+				return;
+			}
+		}
+	}
+
+	// The whole DOM goes back to the pool in one go once the handler and anything it kept are done with it.
+	TSharedRef<TJsonReader<>> JsonReader = TJsonReaderFactory<>::Create(Message.RawMessage);
+	if (!FMixerJsonArena::Create()->Deserialize(JsonReader, Message.JsonObj))
+	{
+		Message.JsonObj.Reset();
+	}
+}
+
+template <class T>
+void TMixerWebSocketOwnerBase<T>::DispatchMessage(FInboundMessage& Message)
+{
+	SCOPE_CYCLE_COUNTER(STAT_MixerSocketDispatch);
+	MIXER_CSV_DISPATCH_SCOPE();
+	MIXER_ALLOCATION_SCOPE(Dispatch);
+	// Tracing may have been switched on between decode and dispatch, leaving the name empty.
+	MIXER_TRACE_SCOPE("Dispatch", Message.TraceName.IsEmpty() ? FString(TEXT("frame")) : Message.TraceName, Message.FrameNumber);
+
+	// Handlers may themselves pump messages (e.g. on close), so restore rather than clear.
+	TGuardValue<double> DispatchingTimeGuard(DispatchingMessageReceivedTime, Message.ReceivedTime);
+
+	// Handlers tag anything they keep (participants, chat history) more specifically.
+	MIXER_LLM_SCOPE(Messages);
+
+	bool bHandled = false;
+	bool bDispatched = false;
+	if (Message.StreamHandler != nullptr)
+	{
+		bDispatched = TryDispatchToStreamHandler(Message.RawMessage, Message.StreamHandler, bHandled);
+		if (!bDispatched)
+		{
+			// Streaming wasn't possible for this particular payload - fall back to the DOM.
+			TSharedRef<TJsonReader<>> JsonReader = TJsonReaderFactory<>::Create(Message.RawMessage);
+			FMixerJsonArena::Create()->Deserialize(JsonReader, Message.JsonObj);
+		}
+	}
+
+	if (!bDispatched && Message.JsonObj.IsValid())
+	{
+		bHandled = OnSocketMessage(Message.JsonObj.Get());
+	}
+
+	if (!bHandled)
+	{
+		UE_LOG(LogMixerInteractivity, Warning, TEXT("Failed to handle websocket message from server: %s"), *Message.RawMessage);
+	}
+}
+
+template <class T>
+void TMixerWebSocketOwnerBase<T>::ParseQueuedMessages()
+{
+	SCOPE_CYCLE_COUNTER(STAT_MixerSocketParse);
+
+	for (;;)
+	{
+		FInboundMessage Message;
+		while (UnparsedMessages.Dequeue(Message))
+		{
+			DecodeMessage(Message);
+			ParsedMessages.Enqueue(MoveTemp(Message));
+			Message = FInboundMessage();
+		}
+
+		FPlatformAtomics::InterlockedExchange(&bParseTaskActive, 0);
+
+		// A frame may have arrived between draining and clearing the flag.  If so, and nobody
+		// else has picked up the work, keep going rather than leaving it stranded.
+		if (UnparsedMessages.IsEmpty() || FPlatformAtomics::InterlockedCompareExchange(&bParseTaskActive, 1, 0) != 0)
+		{
+			break;
+		}
+	}
+}
+
+template <class T>
+void TMixerWebSocketOwnerBase<T>::WaitForParseTasks()
+{
+	if (ParseTasks.Num() > 0)
+	{
+		FTaskGraphInterface::Get().WaitUntilTasksComplete(ParseTasks);
+		ParseTasks.Empty();
+	}
+}
+
+#if MIXER_BENCHMARKS_ENABLED
+template <class T>
+void TMixerWebSocketOwnerBase<T>::DecodeBenchmarkFrame(const FString& MessageJsonString)
+{
+	FInboundMessage Message;
+	Message.RawMessage = MessageJsonString;
+	Message.FrameNumber = ++ReceivedFrameCount;
+	Message.ReceivedTime = FPlatformTime::Seconds();
+	DecodeMessage(Message);
+	ParsedMessages.Enqueue(MoveTemp(Message));
+	FPlatformAtomics::InterlockedIncrement(&NumQueuedMessages);
+}
+
+template <class T>
+void TMixerWebSocketOwnerBase<T>::DispatchBenchmarkFrames()
+{
+	PumpParsedMessages();
+	FlushOutboundMessages(true);
+}
+#endif
+
+template <class T>
+void TMixerWebSocketOwnerBase<T>::TickConnection()
+{
+	FMixerFrameScheduler& Scheduler = FMixerFrameScheduler::Get();
+	const EMixerFrameWorkSource Source = GetFrameWorkSource();
+	const int32 NumDispatched = PumpParsedMessages(Scheduler.BeginWork(Source));
+	Scheduler.EndWork(Source, NumDispatched > 0, !ParsedMessages.IsEmpty());
+
+	ExpirePendingReplies();
+	TickHealthMonitor();
+	FlushOutboundMessages();
+}
+
+template <class T>
+void TMixerWebSocketOwnerBase<T>::TickHealthMonitor()
+{
+	if (bFailoverRequested)
+	{
+		// Deferred out of dispatch, since the owner will most likely tear this socket down
+		bFailoverRequested = false;
+		++HealthStats.NumFailovers;
+		INC_DWORD_STAT(STAT_MixerConnectionFailovers);
+		HandleConnectionDegraded();
+		return;
+	}
+
+	if (HealthPingMethodName.IsEmpty() || !WebSocket.IsValid() || !WebSocket->IsConnected())
+	{
+		return;
+	}
+
+	const UMixerInteractivitySettings* Settings = GetDefault<UMixerInteractivitySettings>();
+	const double Now = FPlatformTime::Seconds();
+	if (OutstandingPingId != INDEX_NONE)
+	{
+		if (Now - PingSentAt < Settings->ConnectionPingTimeout)
+		{
+			return;
+		}
+
+		// A half-open socket looks just like this: sends succeed and nothing ever comes back.
+		// Should the reply turn up later its pending reply entry absorbs it.
+		UE_LOG(LogMixerInteractivity, Warning, TEXT("No reply to %s ping (message id %d) within %.1f seconds."), *HealthPingMethodName, OutstandingPingId, Settings->ConnectionPingTimeout);
+		++HealthStats.NumMissedPings;
+		INC_DWORD_STAT(STAT_MixerMissedPings);
+		OutstandingPingId = INDEX_NONE;
+		NotePoorPing();
+	}
+
+	if (Now >= NextPingTime)
+	{
+		NextPingTime = Now + Settings->ConnectionPingInterval;
+		OutstandingPingId = SendMethodMessageNoParams(HealthPingMethodName, nullptr);
+		PingSentAt = Now;
+	}
+}
+
+template <class T>
+void TMixerWebSocketOwnerBase<T>::RecordPingReply(double RoundTrip)
+{
+	if (HealthStats.NumPings == 0)
+	{
+		HealthStats.SmoothedRoundTripSeconds = RoundTrip;
+		HealthStats.JitterSeconds = 0.0;
+	}
+	else
+	{
+		HealthStats.SmoothedRoundTripSeconds += (RoundTrip - HealthStats.SmoothedRoundTripSeconds) / 8.0;
+		HealthStats.JitterSeconds += (FMath::Abs(RoundTrip - HealthStats.LastRoundTripSeconds) - HealthStats.JitterSeconds) / 16.0;
+	}
+	HealthStats.LastRoundTripSeconds = RoundTrip;
+	++HealthStats.NumPings;
+
+	switch (GetFrameWorkSource())
+	{
+	case EMixerFrameWorkSource::InteractiveEvents:
+		SET_FLOAT_STAT(STAT_MixerInteractiveRoundTrip, HealthStats.SmoothedRoundTripSeconds * 1000.0);
+		SET_FLOAT_STAT(STAT_MixerInteractiveJitter, HealthStats.JitterSeconds * 1000.0);
+		break;
+	case EMixerFrameWorkSource::ChatMessages:
+		SET_FLOAT_STAT(STAT_MixerChatRoundTrip, HealthStats.SmoothedRoundTripSeconds * 1000.0);
+		SET_FLOAT_STAT(STAT_MixerChatJitter, HealthStats.JitterSeconds * 1000.0);
+		break;
+	default:
+		break;
+	}
+
+	UE_LOG(LogMixerInteractivity, VeryVerbose, TEXT("%s ping took %.1fms (smoothed %.1fms, jitter %.1fms)"), *HealthPingMethodName, RoundTrip * 1000.0, HealthStats.SmoothedRoundTripSeconds * 1000.0, HealthStats.JitterSeconds * 1000.0);
+
+	const float ThresholdMs = GetDefault<UMixerInteractivitySettings>()->ConnectionFailoverRoundTripMs;
+	if (ThresholdMs > 0.0f && RoundTrip * 1000.0 > ThresholdMs)
+	{
+		NotePoorPing();
+	}
+	else
+	{
+		NumConsecutivePoorPings = 0;
+	}
+}
+
+template <class T>
+void TMixerWebSocketOwnerBase<T>::NotePoorPing()
+{
+	const int32 FailoverPingCount = GetDefault<UMixerInteractivitySettings>()->ConnectionFailoverPingCount;
+	++NumConsecutivePoorPings;
+	if (FailoverPingCount > 0 && NumConsecutivePoorPings >= FailoverPingCount)
+	{
+		UE_LOG(LogMixerInteractivity, Warning, TEXT("Connection degraded after %d slow or missed pings (smoothed round trip %.1fms)."), NumConsecutivePoorPings, HealthStats.SmoothedRoundTripSeconds * 1000.0);
+		NumConsecutivePoorPings = 0;
+		bFailoverRequested = true;
+	}
+}
+
+template <class T>
+void TMixerWebSocketOwnerBase<T>::AddPendingReply(const FString& MethodName, FServerMessageHandler Handler)
+{
+	FPendingReply& Slot = PendingReplies[static_cast<uint32>(MessageId) % PendingReplyRingSize];
+	if (Slot.MessageId != INDEX_NONE)
+	{
+		// Still waiting on that one, so move it aside rather than abandon it.  Replies are usually far quicker
+		// than a ring's worth of sends, so this only happens during bursts.
+		UE_LOG(LogMixerInteractivity, Verbose, TEXT("Reply slot for %s (message id %d) needed again before its reply arrived; keeping it in the overflow."), *Slot.MethodName.ToString(), Slot.MessageId);
+		OverflowPendingReplies.Add(Slot.MessageId, MoveTemp(Slot));
+	}
+
+	Slot.MessageId = MessageId;
+	Slot.MethodName = FName(*MethodName);
+	Slot.Handler = Handler;
+	// Stamped by SendPayload, so that time spent queued doesn't count against the reply.
+	Slot.SentAt = 0.0;
+	++NumPendingReplies;
+	INC_DWORD_STAT(STAT_MixerPendingReplies);
+}
+
+template <class T>
+bool TMixerWebSocketOwnerBase<T>::RemovePendingReply(int32 ReplyingToMessageId, FServerMessageHandler& OutHandler)
+{
+	FPendingReply Slot;
+	if (!TakePendingReply(ReplyingToMessageId, Slot))
+	{
+		return false;
+	}
+
+	const double RoundTrip = FPlatformTime::Seconds() - Slot.SentAt;
+	FReplyLatencyStats& Stats = ReplyLatencyStats.FindOrAdd(Slot.MethodName);
+	++Stats.NumReplies;
+	Stats.TotalSeconds += RoundTrip;
+	Stats.MaxSeconds = FMath::Max(Stats.MaxSeconds, RoundTrip);
+	UE_LOG(LogMixerInteractivity, VeryVerbose, TEXT("Reply to %s (message id %d) took %.1fms"), *Slot.MethodName.ToString(), ReplyingToMessageId, RoundTrip * 1000.0);
+	MIXER_TRACE_MARKER("Reply", FString::Printf(TEXT("%s %.1fms"), *Slot.MethodName.ToString(), RoundTrip * 1000.0), ReplyingToMessageId);
+
+	OutHandler = Slot.Handler;
+	return true;
+}
+
+template <class T>
+typename TMixerWebSocketOwnerBase<T>::FPendingReply* TMixerWebSocketOwnerBase<T>::FindPendingReply(int32 ReplyingToMessageId)
+{
+	if (ReplyingToMessageId == INDEX_NONE)
+	{
+		return nullptr;
+	}
+
+	FPendingReply& Slot = PendingReplies[static_cast<uint32>(ReplyingToMessageId) % PendingReplyRingSize];
+	if (Slot.MessageId == ReplyingToMessageId)
+	{
+		return &Slot;
+	}
+	return OverflowPendingReplies.Num() > 0 ? OverflowPendingReplies.Find(ReplyingToMessageId) : nullptr;
+}
+
+template <class T>
+bool TMixerWebSocketOwnerBase<T>::TakePendingReply(int32 ReplyingToMessageId, FPendingReply& OutReply)
+{
+	if (ReplyingToMessageId == INDEX_NONE)
+	{
+		return false;
+	}
+
+	FPendingReply& Slot = PendingReplies[static_cast<uint32>(ReplyingToMessageId) % PendingReplyRingSize];
+	if (Slot.MessageId == ReplyingToMessageId)
+	{
+		OutReply = MoveTemp(Slot);
+		Slot = FPendingReply();
+	}
+	else if (OverflowPendingReplies.Num() == 0 || !OverflowPendingReplies.RemoveAndCopyValue(ReplyingToMessageId, OutReply))
+	{
+		return false;
+	}
+
+	--NumPendingReplies;
+	DEC_DWORD_STAT(STAT_MixerPendingReplies);
+	return true;
+}
+
+template <class T>
+void TMixerWebSocketOwnerBase<T>::ExpirePendingReplies()
+{
+	if (NumPendingReplies == 0)
+	{
+		return;
+	}
+
+	const double ExpireBefore = FPlatformTime::Seconds() - ReplyTimeoutSeconds;
+	for (FPendingReply& Slot : PendingReplies)
+	{
+		if (Slot.MessageId != INDEX_NONE && Slot.SentAt != 0.0 && Slot.SentAt < ExpireBefore)
+		{
+			UE_LOG(LogMixerInteractivity, Warning, TEXT("Timed out waiting for reply to %s (message id %d)."), *Slot.MethodName.ToString(), Slot.MessageId);
+			++ReplyLatencyStats.FindOrAdd(Slot.MethodName).NumTimedOut;
+			Slot = FPendingReply();
+			--NumPendingReplies;
+			DEC_DWORD_STAT(STAT_MixerPendingReplies);
+		}
+	}
+	for (auto It = OverflowPendingReplies.CreateIterator(); It; ++It)
+	{
+		if (It.Value().SentAt != 0.0 && It.Value().SentAt < ExpireBefore)
+		{
+			UE_LOG(LogMixerInteractivity, Warning, TEXT("Timed out waiting for reply to %s (message id %d)."), *It.Value().MethodName.ToString(), It.Key());
+			++ReplyLatencyStats.FindOrAdd(It.Value().MethodName).NumTimedOut;
+			It.RemoveCurrent();
+			--NumPendingReplies;
+			DEC_DWORD_STAT(STAT_MixerPendingReplies);
+		}
+	}
+}
+
+template <class T>
+void TMixerWebSocketOwnerBase<T>::TakeUnsentReplies(TArray<FPendingReply>& OutReplies)
+{
+	for (const FOutboundMessage& Outbound : OutboundMessages)
+	{
+		// Merged messages don't take a reply slot until they're sent.
+		FPendingReply Reply;
+		if (Outbound.PayloadOffset != INDEX_NONE && TakePendingReply(Outbound.MessageId, Reply))
+		{
+			++ReplyLatencyStats.FindOrAdd(Reply.MethodName).NumUnsent;
+			OutReplies.Add(MoveTemp(Reply));
+		}
+	}
+
+	if (OutReplies.Num() > 0)
+	{
+		UE_LOG(LogMixerInteractivity, Log, TEXT("%d queued methods will get no reply since they were never sent."), OutReplies.Num());
+	}
+}
+
+template <class T>
+void TMixerWebSocketOwnerBase<T>::FailUnsentReplies(const TArray<FPendingReply>& Replies)
+{
+	for (const FPendingReply& Reply : Replies)
+	{
+		if (Reply.Handler == nullptr)
+		{
+			continue;
+		}
+
+		TSharedRef<FJsonObject> Error = MakeShared<FJsonObject>();
+		Error->SetStringField(MixerStringConstants::FieldNames::Message, FString::Printf(TEXT("%s was not sent since the web socket is not connected."), *Reply.MethodName.ToString()));
+
+		FJsonObject ErrorReply;
+		ErrorReply.SetStringField(MixerStringConstants::FieldNames::Type, MixerStringConstants::MessageTypes::Reply);
+		ErrorReply.SetNumberField(MixerStringConstants::FieldNames::Id, Reply.MessageId);
+		ErrorReply.SetObjectField(MixerStringConstants::FieldNames::Error, Error);
+		(static_cast<T*>(this)->*Reply.Handler)(&ErrorReply);
+	}
+}
+
+template <class T>
+int32 TMixerWebSocketOwnerBase<T>::PumpParsedMessages(double Deadline)
+{
+	int32 NumDispatched = 0;
+	FInboundMessage Message;
+	while ((NumDispatched == 0 || FPlatformTime::Seconds() < Deadline) && ParsedMessages.Dequeue(Message))
+	{
+		FPlatformAtomics::InterlockedDecrement(&NumQueuedMessages);
+		MIXER_CSV_BACKLOG(-1);
+		DispatchMessage(Message);
+		Message = FInboundMessage();
+		++NumDispatched;
+	}
+	return NumDispatched;
+}
+
+template <class T>
+void TMixerWebSocketOwnerBase<T>::OnSocketClosed(int32 StatusCode, const FString& Reason, bool bWasClean)
+{
+	UE_LOG(LogMixerInteractivity, Warning, TEXT("WebSocket closed with reason '%s'."), *Reason);
+
+	// Deliver anything that arrived ahead of the close before tearing down.
+	WaitForParseTasks();
+	PumpParsedMessages();
+
+	CleanupConnection();
+
+	HandleSocketClosed(bWasClean);
+}
+
+template <class T>
+bool TMixerWebSocketOwnerBase<T>::OnSocketMessage(FJsonObject* JsonObj)
+{
+	bool bHandled = false;
+	GET_JSON_STRING_RETURN_FAILURE(Type, MessageType);
+	if (MatchesInterned(MessageType, MixerStringConstants::MessageTypes::Reply))
+	{
+		GET_JSON_INT_RETURN_FAILURE(Id, ReplyingToMessageId);
+
+		FServerMessageHandler Handler;
+		if (RemovePendingReply(ReplyingToMessageId, Handler))
+		{
+			if (ReplyingToMessageId == OutstandingPingId)
+			{
+				// Measured to when the frame came off the socket, so time spent queued for dispatch doesn't count against the route.
+				const double ReceivedAt = DispatchingMessageReceivedTime > 0.0 ? DispatchingMessageReceivedTime : FPlatformTime::Seconds();
+				OutstandingPingId = INDEX_NONE;
+				RecordPingReply(ReceivedAt - PingSentAt);
+				HandleHealthPingReply(JsonObj, ReceivedAt - PingSentAt);
+			}
+
+			if (Handler != nullptr)
+			{
+				(static_cast<T*>(this)->*Handler)(JsonObj);
+			}
+			bHandled = true;
+		}
+		else
+		{
+			UE_LOG(LogMixerInteractivity, Error, TEXT("Received unexpected reply for unknown message id %d"), ReplyingToMessageId);
+		}
+	}
+	else if (MatchesInterned(MessageType, ServerInitiatedMessageType))
+	{
+		FString Subtype;
+		if (!JsonObj->TryGetStringField(ServerInitiatedMessageSubtypeName, Subtype))
+		{
+			UE_LOG(LogMixerInteractivity, Error, TEXT("Missing message subtype (%s)"), *ServerInitiatedMessageSubtypeName);
+			return false;
+		}
+
+		TSharedPtr<FJsonValue> RawParams = JsonObj->TryGetField(ServerInitiatedMessageParamsName);
+		if (!RawParams.IsValid())
+		{
+			UE_LOG(LogMixerInteractivity, Error, TEXT("Missing message params (%s)"), *ServerInitiatedMessageParamsName);
+			return false;
+		}
+
+		const TSharedPtr<FJsonObject>* Params = nullptr;
+		if (!RawParams->IsNull())
+		{
+			if (!RawParams->TryGetObject(Params))
+			{
+				UE_LOG(LogMixerInteractivity, Error, TEXT("Unexpected value %s for message params (%s)"), *RawParams->AsString(), *ServerInitiatedMessageParamsName);
+				return false;
+			}
+		}
+
+		const FServerMessageRoute* Route = FindServerMessageRoute(Subtype);
+		if (Route != nullptr)
+		{
+			// Streaming routes only land here when their params weren't an object, in which case there's nothing for them to read.
+			if (Route->Handler != nullptr)
+			{
+				(static_cast<T*>(this)->*Route->Handler)(Params != nullptr ? Params->Get() : nullptr);
+			}
+			bHandled = true;
+		}
+		else
+		{
+			bHandled = OnUnhandledServerMessage(Subtype, Params != nullptr ? *Params : nullptr);
+		}
+	}
+
+	return bHandled;
+}
+
+template <class T>
+bool TMixerWebSocketOwnerBase<T>::ReadMessageHeader(const FString& MessageJsonString, FString& OutMessageType, FString& OutSubtype, const FMixerStringConstant* RequiredType) const
+{
+	TSharedRef<TJsonReader<>> JsonReader = TJsonReaderFactory<>::Create(MessageJsonString);
+	EJsonNotation Notation;
+	if (!JsonReader->ReadNext(Notation) || Notation != EJsonNotation::ObjectStart)
+	{
+		return false;
+	}
+
+	FMixerJsonCursor Cursor(JsonReader.Get());
+	bool bHaveType = false;
+	bool bHaveSubtype = false;
+	while ((!bHaveType || !bHaveSubtype) && Cursor.NextField())
+	{
+		if (!bHaveType && Cursor.IsField(MixerStringConstants::FieldNames::Type))
+		{
+			bHaveType = Cursor.TryGetString(OutMessageType);
+			if (bHaveType && RequiredType != nullptr && !MatchesInterned(OutMessageType, *RequiredType))
+			{
+				return false;
+			}
+		}
+		else if (!bHaveSubtype && Cursor.IsField(ServerInitiatedMessageSubtypeName))
+		{
+			bHaveSubtype = Cursor.TryGetString(OutSubtype);
+		}
+	}
+
+	return bHaveType && bHaveSubtype;
+}
+
+template <class T>
+bool TMixerWebSocketOwnerBase<T>::TryDispatchToStreamHandler(const FString& MessageJsonString, FServerMessageStreamHandler Handler, bool& bOutHandled)
+{
+	// Json doesn't guarantee field order, so params may have preceded the header fields.  Rescan for them.
+	TSharedRef<TJsonReader<>> JsonReader = TJsonReaderFactory<>::Create(MessageJsonString);
+	EJsonNotation Notation;
+	if (!JsonReader->ReadNext(Notation) || Notation != EJsonNotation::ObjectStart)
+	{
+		return false;
+	}
+
+	FMixerJsonCursor MessageCursor(JsonReader.Get());
+	while (MessageCursor.NextField())
+	{
+		if (MessageCursor.IsField(ServerInitiatedMessageParamsName))
+		{
+			if (MessageCursor.GetNotation() != EJsonNotation::ObjectStart)
+			{
+				// Null or unexpected params - let the DOM path deal with (and report) it.
+				return false;
+			}
+
+			FMixerJsonCursor ParamsCursor(JsonReader.Get());
+			if (Handler != nullptr)
+			{
+				(static_cast<T*>(this)->*Handler)(ParamsCursor);
+			}
+			bOutHandled = true;
+			return true;
+		}
+	}
+
+	return false;
 }
 
 template <class T>
 template <class PARAM>
-void TMixerWebSocketOwnerBase<T>::WriteRemoteMethodParams(CondensedWriterType& Writer, PARAM Param1)
+void TMixerWebSocketOwnerBase<T>::WriteSingleRemoteMethodParam(CondensedWriterType& Writer, const PARAM& Param1)
 {
-	WriteSingleRemoteMethodParam(Writer, Param1);
-}
\ No newline at end of file
+	Writer.WriteValue(Param1);
+}
+
+template <class T>
+template <class PARAM>
+void TMixerWebSocketOwnerBase<T>::WriteSingleRemoteMethodParam(CondensedWriterType& Writer, const TArray<PARAM>& Param1)
+{
+	Writer.WriteArrayStart();
+	for (const PARAM& Val : Param1)
+	{
+		Writer.WriteValue(Val);
+	}
+	Writer.WriteArrayEnd();
+}
+
+template <class T>
+template <class ...ArgTypes>
+void TMixerWebSocketOwnerBase<T>::WriteRemoteMethodParams(CondensedWriterType& Writer, ArgTypes&&... Args)
+{
+	// Pack expansion inside a braced initializer is evaluated in order - a stand-in for a
+	// fold expression that avoids recursing (and copying arguments) once per parameter.
+	int32 Expander[] = { 0, (WriteSingleRemoteMethodParam(Writer, Args), 0)... };
+	(void)Expander;
+}
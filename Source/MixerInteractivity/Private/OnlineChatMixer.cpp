@@ -13,6 +13,21 @@
 #include "MixerInteractivityTypes.h"
 #include "MixerInteractivityUserSettings.h"
 #include "MixerChatConnection.h"
+#include "MixerChatConnectionManager.h"
+#include "MixerInteractivityModulePrivate.h"
+
+namespace
+{
+	// Per-user cooldown records older than this many entries get pruned of anything expired
+	const int32 ChatTriggerUserRecordPruneThreshold = 256;
+}
+
+FOnlineChatMixer::FOnlineChatMixer()
+	: ConnectionManager(MakeShared<FMixerChatConnectionManager>())
+	, NextChatTriggerHandle(1)
+	, bChatTriggerMatcherDirty(false)
+{
+}
 
 bool FOnlineChatMixer::CreateRoom(const FUniqueNetId& UserId, const FChatRoomId& RoomId, const FString& Nickname, const FChatRoomConfig& ChatRoomConfig)
 {
@@ -43,7 +58,10 @@ bool FOnlineChatMixer::JoinPublicRoom(const FUniqueNetId& UserId, const FChatRoo
 
 		TSharedPtr<const FMixerLocalUser> CurrentUser = IMixerInteractivityModule::Get().GetCurrentUser();
 		check(CurrentUser.IsValid());
-		NewConnection = DefaultChatConnection = MakeShared<FMixerChatConnection>(this, UserId, CurrentUser->Name, ChatRoomConfig);
+
+		// Login already told us our own channel id, so the connection needn't look it up.
+		ConnectionManager->SeedChannelId(CurrentUser->Name.ToString(), CurrentUser->GetChannel().Id);
+		NewConnection = DefaultChatConnection = MakeShared<FMixerChatConnection>(this, UserId, CurrentUser->Name.ToString(), ChatRoomConfig);
 	}
 	else
 	{
@@ -79,7 +97,11 @@ bool FOnlineChatMixer::JoinPublicRoom(const FUniqueNetId& UserId, const FChatRoo
 	}
 
 	bool bStartedConnection = NewConnection->Init();
-	if (!bStartedConnection)
+	if (bStartedConnection)
+	{
+		static_cast<FMixerInteractivityModule&>(IMixerInteractivityModule::Get()).WakeTicker();
+	}
+	else
 	{
 		UE_LOG(LogMixerChat, Warning, TEXT("Error initializing connection sequence for room %s."), *RoomId);
 		if (NewConnection == DefaultChatConnection)
@@ -187,6 +209,141 @@ bool FOnlineChatMixer::GetLastMessages(const FUniqueNetId& UserId, const FChatRo
 	}
 }
 
+bool FOnlineChatMixer::VisitLastMessages(const FUniqueNetId& UserId, const FChatRoomId& RoomId, int32 NumMessages, TFunctionRef<bool(const FChatMessageMixer&)> Visitor)
+{
+	TSharedPtr<FMixerChatConnection> Connection = FindConnectionForRoomId(RoomId);
+	if (Connection.IsValid())
+	{
+		Connection->VisitMessageHistory(NumMessages, Visitor);
+		return true;
+	}
+	else
+	{
+		return false;
+	}
+}
+
+bool FOnlineChatMixer::GetOutboundChatQueueState(const FUniqueNetId& UserId, const FChatRoomId& RoomId, int32& OutQueueDepth, float& OutSendLatency)
+{
+	TSharedPtr<FMixerChatConnection> Connection = FindConnectionForRoomId(RoomId);
+	if (Connection.IsValid())
+	{
+		OutQueueDepth = Connection->GetOutboundQueueDepth();
+		OutSendLatency = Connection->GetLastOutboundSendLatency();
+		return true;
+	}
+	else
+	{
+		return false;
+	}
+}
+
+int32 FOnlineChatMixer::AddChatTrigger(const FChatTriggerMixer& Trigger, const FOnChatTriggerMixer& Delegate)
+{
+	if (Trigger.Pattern.IsEmpty())
+	{
+		UE_LOG(LogMixerChat, Warning, TEXT("Ignoring chat trigger with an empty pattern."));
+		return 0;
+	}
+
+	const int32 Handle = NextChatTriggerHandle++;
+	FRegisteredChatTrigger& Registered = ChatTriggers.Add(Handle);
+	Registered.Trigger = Trigger;
+	Registered.Delegate = Delegate;
+	Registered.LastFiredTime = -DBL_MAX;
+	bChatTriggerMatcherDirty = true;
+	return Handle;
+}
+
+void FOnlineChatMixer::RemoveChatTrigger(int32 TriggerHandle)
+{
+	if (ChatTriggers.Remove(TriggerHandle) > 0)
+	{
+		bChatTriggerMatcherDirty = true;
+	}
+}
+
+void FOnlineChatMixer::DispatchChatTriggers(const FChatRoomId& RoomId, const FChatMessageMixerImpl& ChatMessage)
+{
+	if (ChatTriggers.Num() == 0)
+	{
+		return;
+	}
+
+	if (bChatTriggerMatcherDirty)
+	{
+		ChatTriggerMatcher.Reset();
+		for (const TPair<int32, FRegisteredChatTrigger>& Registered : ChatTriggers)
+		{
+			ChatTriggerMatcher.AddPattern(Registered.Value.Trigger.Pattern, Registered.Value.Trigger.Match, Registered.Key);
+		}
+		ChatTriggerMatcher.Compile();
+		bChatTriggerMatcherDirty = false;
+	}
+
+	const FString& Body = ChatMessage.GetBody();
+	TArray<FMixerChatTriggerMatcher::FMatch, TInlineAllocator<4>> Matches;
+	ChatTriggerMatcher.FindMatches(Body, Matches);
+
+	const double TimeNow = FPlatformTime::Seconds();
+	const int32 SenderId = ChatMessage.GetSender().Id;
+	for (const FMixerChatTriggerMatcher::FMatch& Match : Matches)
+	{
+		// Delegates may have removed triggers, including ones matched by this message.
+		FRegisteredChatTrigger* Registered = ChatTriggers.Find(Match.Key);
+		if (Registered == nullptr || !Registered->Delegate.IsBound())
+		{
+			continue;
+		}
+
+		if (TimeNow - Registered->LastFiredTime < Registered->Trigger.Cooldown.GetTotalSeconds())
+		{
+			continue;
+		}
+
+		const double PerUserCooldown = Registered->Trigger.PerUserCooldown.GetTotalSeconds();
+		if (PerUserCooldown > 0.0)
+		{
+			double* UserLastFired = Registered->LastFiredByUser.Find(SenderId);
+			if (UserLastFired != nullptr && TimeNow - *UserLastFired < PerUserCooldown)
+			{
+				continue;
+			}
+
+			if (UserLastFired == nullptr && Registered->LastFiredByUser.Num() >= ChatTriggerUserRecordPruneThreshold)
+			{
+				for (TMap<int32, double>::TIterator It(Registered->LastFiredByUser); It; ++It)
+				{
+					if (TimeNow - It->Value >= PerUserCooldown)
+					{
+						It.RemoveCurrent();
+					}
+				}
+			}
+			Registered->LastFiredByUser.Add(SenderId, TimeNow);
+		}
+		Registered->LastFiredTime = TimeNow;
+
+		// Copy out before calling, since the delegate may remove its own trigger.
+		FOnChatTriggerMixer Delegate = Registered->Delegate;
+		Delegate.Execute(RoomId, ChatMessage, Match.ArgumentsLen > 0 ? Body.Mid(Match.ArgumentsStart, Match.ArgumentsLen) : FString());
+	}
+}
+
+bool FOnlineChatMixer::GetRoomBootstrapTimings(const FUniqueNetId& UserId, const FChatRoomId& RoomId, FChatRoomBootstrapTimingsMixer& OutTimings)
+{
+	TSharedPtr<FMixerChatConnection> Connection = FindConnectionForRoomId(RoomId);
+	if (Connection.IsValid())
+	{
+		OutTimings = Connection->GetBootstrapTimings();
+		return true;
+	}
+	else
+	{
+		return false;
+	}
+}
+
 bool FOnlineChatMixer::IsMessageFromLocalUser(const FUniqueNetId& UserId, const FChatMessage& Message, const bool bIncludeExternalInstances)
 {
 	return UserId == *Message.GetUserId();
@@ -233,7 +390,7 @@ bool FOnlineChatMixer::IsDefaultChatRoom(const FChatRoomId& RoomId) const
 		return true;
 	}
 
-	return RoomId == CurrentUser->Name;
+	return RoomId == CurrentUser->Name.ToString();
 }
 
 bool FOnlineChatMixer::WillJoinAnonymously() const
@@ -242,6 +399,24 @@ bool FOnlineChatMixer::WillJoinAnonymously() const
 	return !CurrentUser.IsValid();
 }
 
+void FOnlineChatMixer::Tick()
+{
+	// Handlers may tear down connections, so work from a snapshot.  Sized for typical co-streaming room counts.
+	TArray<TSharedRef<FMixerChatConnection>, TInlineAllocator<8>> ConnectionsToPump;
+	ConnectionsToPump.Append(AdditionalChatConnections);
+	if (DefaultChatConnection.IsValid())
+	{
+		ConnectionsToPump.Add(DefaultChatConnection.ToSharedRef());
+	}
+
+	for (TSharedRef<FMixerChatConnection>& Connection : ConnectionsToPump)
+	{
+		Connection->TickConnection();
+		Connection->TickOutboundQueue();
+		Connection->TickMembershipChanges();
+	}
+}
+
 void FOnlineChatMixer::ConnectAttemptFinished(const FUniqueNetId& UserId, const FChatRoomId& RoomId, bool bSuccess, const FString& ErrorMessage)
 {
 	if (!bSuccess)
@@ -252,6 +427,18 @@ void FOnlineChatMixer::ConnectAttemptFinished(const FUniqueNetId& UserId, const
 	TriggerOnChatRoomJoinPublicDelegates(UserId, RoomId, bSuccess, ErrorMessage);
 }
 
+bool FOnlineChatMixer::GetRoomContainerSizes(const FChatRoomId& RoomId, TFunctionRef<void(const TCHAR* Name, int64 Size)> Visit)
+{
+	TSharedPtr<FMixerChatConnection> Connection = FindConnectionForRoomId(RoomId);
+	if (!Connection.IsValid())
+	{
+		return false;
+	}
+
+	Connection->GetContainerSizes(Visit);
+	return true;
+}
+
 bool FOnlineChatMixer::ExitRoomWithReason(const FUniqueNetId& UserId, const FChatRoomId& RoomId, bool bIsClean, const FString& Reason)
 {
 	bool bExited = RemoveConnectionForRoom(RoomId);
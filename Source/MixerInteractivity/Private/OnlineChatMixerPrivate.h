@@ -12,6 +12,7 @@
 #include "OnlineChatMixer.h"
 #include "MixerInteractivityTypes.h"
 #include "Misc/Guid.h"
+#include "MixerChatTriggerMatcher.h"
 
 class FUniqueNetIdMixer : public FUniqueNetId
 {
@@ -55,6 +56,11 @@ public:
 		return FString::Printf(TEXT("MixerId: %d"), MixerId);
 	}
 
+	int32 GetMixerId() const
+	{
+		return MixerId;
+	}
+
 	friend uint32 GetTypeHash(const FUniqueNetIdMixer& Unid)
 	{
 		return GetTypeHash(Unid.MixerId);
@@ -73,6 +79,7 @@ public:
 		Name = InName;
 		Id = InId;
 		Level = 0;
+		LastActiveStamp = 0;
 	}
 
 	// FChatRoomMember interface
@@ -81,6 +88,10 @@ public:
 
 	const FUniqueNetIdMixer& GetUniqueNetId() const						{ return static_cast<const FUniqueNetIdMixer&>(NetId.Get()); }
 
+public:
+	// Owning connection's user cache clock when this user was last seen, for LRU eviction
+	uint64 LastActiveStamp;
+
 private:
 	TSharedRef<const FUniqueNetId> NetId;
 };
@@ -95,6 +106,16 @@ public:
 		, bIsWhisper(false)
 		, bIsAction(false)
 		, bIsModerated(false)
+		, HistorySequence(0)
+	{
+	}
+
+	// For the connection's message pool.  Must be completed with FinishDecode before use.
+	FChatMessageMixerImpl()
+		: bIsWhisper(false)
+		, bIsAction(false)
+		, bIsModerated(false)
+		, HistorySequence(0)
 	{
 	}
 
@@ -108,19 +129,78 @@ public:
 	virtual bool IsWhisper()const override										{ return bIsWhisper; }
 	virtual bool IsAction() const override										{ return bIsAction; }
 	virtual bool IsModerated() const override									{ return bIsModerated; }
+	virtual TArrayView<const FChatMessageSegmentMixer> GetSegments() const override	{ return Segments; }
+	virtual TArrayView<const FChatMessageImageMixer> GetImages() const override		{ return Images; }
+	virtual const FString& GetRichText() const override							{ return RichText; }
 
-	const FMixerChatUser& GetSender()											{ return FromUser.Get(); }
-	const FGuid& GetMessageId()													{ return MessageId; }
+	const FMixerChatUser& GetSender() const										{ return *FromUser; }
+	TSharedRef<const FMixerChatUser> GetSenderRef() const						{ return FromUser.ToSharedRef(); }
+	const FGuid& GetMessageId() const											{ return MessageId; }
+
+	/** Clear a pooled message, keeping its allocations, ahead of decoding into it. */
+	void ResetForDecode()
+	{
+		FromUser.Reset();
+		Body.Reset();
+		RichText.Reset();
+		Segments.Reset();
+		Images.Reset();
+		bIsWhisper = false;
+		bIsAction = false;
+		bIsModerated = false;
+		HistorySequence = 0;
+	}
+
+	void FinishDecode(const FGuid& InMessageId, TSharedRef<const FMixerChatUser> InFromUser)
+	{
+		MessageId = InMessageId;
+		FromUser = InFromUser;
+		Timestamp = FDateTime::Now();
+	}
 
 	void FlagAsDeleted()
 	{
 		Body.Empty();
+		RichText.Empty();
+		Segments.Empty();
+		Images.Empty();
 		bIsModerated = true;
 	}
 
-	void AppendBodyFragment(const FString& InBodyFragment)
+	void AppendBodyFragment(const FString& InBodyFragment, EChatMessageSegmentMixer Type, int32 ImageIndex = INDEX_NONE, const TCHAR* Target = nullptr)
 	{
+		const int32 Start = Body.Len();
 		Body += InBodyFragment;
+		AddSegment(Type, Start, ImageIndex, Target);
+	}
+
+	/** Body for decoders to append a fragment to directly.  Follow with AddSegment. */
+	FString& GetMutableBody()
+	{
+		return Body;
+	}
+
+	/**
+	* Record everything appended to the body since Start as one segment.  Target is the URL of a link
+	* or the user id of a mention, for the rich text.
+	*/
+	void AddSegment(EChatMessageSegmentMixer Type, int32 Start, int32 ImageIndex = INDEX_NONE, const TCHAR* Target = nullptr)
+	{
+		FChatMessageSegmentMixer& Segment = Segments[Segments.AddUninitialized()];
+		Segment.Type = Type;
+		Segment.Start = Start;
+		Segment.Len = Body.Len() - Start;
+		Segment.ImageIndex = ImageIndex;
+		AppendRichTextRun(Segment, Target);
+	}
+
+	/** Record a picture for a segment about to be added.  Returns its index for AddSegment. */
+	int32 AddImage(const FString& Url, const FIntRect& SourceRect)
+	{
+		FChatMessageImageMixer& Image = Images[Images.AddDefaulted()];
+		Image.Url = Url;
+		Image.SourceRect = SourceRect;
+		return Images.Num() - 1;
 	}
 
 	void FlagAsWhisper()
@@ -133,26 +213,92 @@ public:
 		if (!bIsAction)
 		{
 			bIsAction = true;
-			Body = FromUser->Name + TEXT(" ") + Body;
+			const FString Prefix = FromUser->Name.ToString() + TEXT(" ");
+			Body = Prefix + Body;
+			FString RichPrefix;
+			AppendEscapedRichText(RichPrefix, *Prefix, Prefix.Len());
+			RichText = RichPrefix + RichText;
+			for (FChatMessageSegmentMixer& Segment : Segments)
+			{
+				Segment.Start += Prefix.Len();
+			}
+		}
+	}
+
+private:
+	void AppendRichTextRun(const FChatMessageSegmentMixer& Segment, const TCHAR* Target)
+	{
+		const TCHAR* TagName = nullptr;
+		const TCHAR* AttributeName = nullptr;
+		FString IndexString;
+		switch (Segment.Type)
+		{
+		case EChatMessageSegmentMixer::Emoticon:	TagName = TEXT("mixer.emote"); AttributeName = TEXT("image"); break;
+		case EChatMessageSegmentMixer::Image:		TagName = TEXT("mixer.image"); AttributeName = TEXT("image"); break;
+		case EChatMessageSegmentMixer::Link:		TagName = TEXT("mixer.link"); AttributeName = TEXT("href"); break;
+		case EChatMessageSegmentMixer::Tag:			TagName = TEXT("mixer.mention"); AttributeName = TEXT("id"); break;
+		default:									break;
+		}
+
+		if (Segment.ImageIndex != INDEX_NONE)
+		{
+			IndexString = FString::FromInt(Segment.ImageIndex);
+			Target = *IndexString;
+		}
+
+		if (TagName != nullptr)
+		{
+			RichText += TEXT("<");
+			RichText += TagName;
+			if (Target != nullptr && *Target != TEXT('\0'))
+			{
+				RichText += TEXT(" ");
+				RichText += AttributeName;
+				RichText += TEXT("=\"");
+				AppendEscapedRichText(RichText, Target, FCString::Strlen(Target));
+				RichText += TEXT("\"");
+			}
+			RichText += TEXT(">");
+		}
+		AppendEscapedRichText(RichText, *Body + Segment.Start, Segment.Len);
+		if (TagName != nullptr)
+		{
+			RichText += TEXT("</>");
+		}
+	}
+
+	// Matches the escapes undone by FDefaultRichTextMarkupParser
+	static void AppendEscapedRichText(FString& Out, const TCHAR* Text, int32 Len)
+	{
+		for (int32 i = 0; i < Len; ++i)
+		{
+			switch (Text[i])
+			{
+			case TEXT('&'):		Out += TEXT("&amp;"); break;
+			case TEXT('<'):		Out += TEXT("&lt;"); break;
+			case TEXT('>'):		Out += TEXT("&gt;"); break;
+			case TEXT('"'):		Out += TEXT("&quot;"); break;
+			default:			Out.AppendChar(Text[i]); break;
+			}
 		}
 	}
 
 private:
 	FGuid MessageId;
-	TSharedRef<const FMixerChatUser> FromUser;
+	TSharedPtr<const FMixerChatUser> FromUser;
 	FString Body;
+	// Body as rich text markup, kept in step with the segments
+	FString RichText;
+	TArray<FChatMessageSegmentMixer, TInlineAllocator<4>> Segments;
+	TArray<FChatMessageImageMixer, TInlineAllocator<2>> Images;
 	FDateTime Timestamp;
 	bool bIsWhisper;
 	bool bIsAction;
 	bool bIsModerated;
 
 public:
-	// Intrusive list to avoid double allocation for chat history
-	// Would be nice to use TIntrusiveList, but that doesn't support
-	// TSharedPtr as the link type, and IOnlineChat enforces that the
-	// lifetime is managed by TSharedPtr
-	TSharedPtr<FChatMessageMixerImpl> NextLink;
-	TSharedPtr<FChatMessageMixerImpl> PrevLink;
+	// Position in the owning connection's history ring, assigned when the message is added to it
+	uint64 HistorySequence;
 };
 
 struct FChatPollMixerImpl : public FChatPollMixer
@@ -168,19 +314,18 @@ public:
 
 	virtual TSharedRef<const FChatRoomMember> GetAskingUser() const	override		{ return AskingUser; }
 	virtual const FString& GetQuestion() const override								{ return Question; }
-	virtual int32 GetNumAnswers() const override									{ return Answers.Num(); }
-	virtual const FString& GetAnswer(int32 Index) const override					{ return Answers[Index].Name; }
-	virtual int32 GetNumVotersForAnswer(int32 Index) const override					{ return Answers[Index].Voters; }
+	virtual int32 GetNumAnswers() const override									{ return AnswerNames.Num(); }
+	virtual const FString& GetAnswer(int32 Index) const override					{ return AnswerNames[Index]; }
+	virtual int32 GetNumVotersForAnswer(int32 Index) const override					{ return Tallies[Index]; }
+	virtual TArrayView<const int32> GetVoteTallies() const override					{ return Tallies; }
 	virtual FDateTime GetEndTime() const override									{ return EndsAt; }
 
-public:
-	struct Answer
-	{
-		FString Name;
-		int32 Voters;
-	};
+	const TSharedRef<const FMixerChatUser>& GetAskingMixerUser() const				{ return AskingUser; }
 
-	TArray<Answer> Answers;
+public:
+	// Kept apart so that tally updates only touch a compact array of counts
+	TArray<FString> AnswerNames;
+	TArray<int32> Tallies;
 
 private:
 	TSharedRef<const FMixerChatUser> AskingUser;
@@ -197,6 +342,8 @@ private:
 class FOnlineChatMixer : public IOnlineChatMixer, public TSharedFromThis<FOnlineChatMixer>
 {
 public:
+	FOnlineChatMixer();
+
 	virtual bool CreateRoom(const FUniqueNetId& UserId, const FChatRoomId& RoomId, const FString& Nickname, const FChatRoomConfig& ChatRoomConfig) override;
 
 	virtual bool ConfigureRoom(const FUniqueNetId& UserId, const FChatRoomId& RoomId, const FChatRoomConfig& ChatRoomConfig) override { return false; }
@@ -230,13 +377,25 @@ public:
 	// IOnlineChatMixer
 	virtual bool StartPoll(const FUniqueNetId& UserId, const FChatRoomId& RoomId, const FString& Question, const TArray<FString>& Answers, FTimespan Duration) override;
 	virtual bool VoteInPoll(const FUniqueNetId& UserId, const FChatRoomId& RoomId, const FChatPollMixer& Poll, int32 AnswerIndex) override;
+	virtual bool VisitLastMessages(const FUniqueNetId& UserId, const FChatRoomId& RoomId, int32 NumMessages, TFunctionRef<bool(const FChatMessageMixer&)> Visitor) override;
+	virtual bool GetOutboundChatQueueState(const FUniqueNetId& UserId, const FChatRoomId& RoomId, int32& OutQueueDepth, float& OutSendLatency) override;
+	virtual bool GetRoomBootstrapTimings(const FUniqueNetId& UserId, const FChatRoomId& RoomId, FChatRoomBootstrapTimingsMixer& OutTimings) override;
+	virtual int32 AddChatTrigger(const FChatTriggerMixer& Trigger, const FOnChatTriggerMixer& Delegate) override;
+	virtual void RemoveChatTrigger(int32 TriggerHandle) override;
 
 public:
+	void Tick();
+	/** Whether any room is joined or being joined, i.e. whether Tick has anything to do. */
+	bool HasConnections() const { return DefaultChatConnection.IsValid() || AdditionalChatConnections.Num() > 0; }
+	class FMixerChatConnectionManager& GetConnectionManager() { return ConnectionManager.Get(); }
+	void DispatchChatTriggers(const FChatRoomId& RoomId, const FChatMessageMixerImpl& ChatMessage);
 	void ConnectAttemptFinished(const FUniqueNetId& UserId, const FChatRoomId& RoomId, bool bSuccess, const FString& ErrorMessage);
 	bool ExitRoomWithReason(const FUniqueNetId& UserId, const FChatRoomId& RoomId, bool bIsClean, const FString& Reason);
 
-private:
+	/** FMixerChatConnection::GetContainerSizes for the room's connection.  @return	false if the room isn't joined. */
+	bool GetRoomContainerSizes(const FChatRoomId& RoomId, TFunctionRef<void(const TCHAR* Name, int64 Size)> Visit);
 
+private:
 	bool IsDefaultChatRoom(const FChatRoomId& RoomId) const;
 	bool WillJoinAnonymously() const;
 	bool RemoveConnectionForRoom(const FChatRoomId& RoomId);
@@ -251,4 +410,21 @@ private:
 
 	/** Connection to additional chat channels that we may want to interact with. */
 	TArray<TSharedRef<class FMixerChatConnection>> AdditionalChatConnections;
+
+	/** Channel and endpoint discovery shared by all of the above. */
+	TSharedRef<class FMixerChatConnectionManager> ConnectionManager;
+
+	struct FRegisteredChatTrigger
+	{
+		FChatTriggerMixer Trigger;
+		FOnChatTriggerMixer Delegate;
+		double LastFiredTime;
+		TMap<int32, double> LastFiredByUser;
+	};
+
+	/** Triggers by handle, and the matcher built from them.  The matcher is rebuilt lazily after changes. */
+	TMap<int32, FRegisteredChatTrigger> ChatTriggers;
+	FMixerChatTriggerMatcher ChatTriggerMatcher;
+	int32 NextChatTriggerHandle;
+	bool bChatTriggerMatcherDirty;
 };
\ No newline at end of file
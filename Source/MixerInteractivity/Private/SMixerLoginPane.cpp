@@ -34,6 +34,8 @@ void SMixerLoginPane::Construct(const FArguments& InArgs)
 {
 	BoundUserId = InArgs._UserId;
 	bAllowSilentLogin = InArgs._AllowSilentLogin;
+	bDeferLoginFlow = InArgs._DeferLoginFlow;
+	bLoginFlowStarted = false;
 
 #if PLATFORM_SUPPORTS_MIXER_OAUTH
 	OnAuthCodeReady = InArgs._OnAuthCodeReady;
@@ -51,7 +53,7 @@ void SMixerLoginPane::Construct(const FArguments& InArgs)
 
 	InteractivityModule.OnLoginStateChanged().AddSP(this, &SMixerLoginPane::OnLoginStateChanged);
 
-	if (InteractivityModule.GetLoginState() == EMixerLoginState::Not_Logged_In)
+	if (!bDeferLoginFlow && InteractivityModule.GetLoginState() == EMixerLoginState::Not_Logged_In)
 	{
 		StartLoginFlow();
 	}
@@ -59,6 +61,8 @@ void SMixerLoginPane::Construct(const FArguments& InArgs)
 
 void SMixerLoginPane::StartLoginFlow()
 {
+	bLoginFlowStarted = true;
+
 	if (bAllowSilentLogin && !bAttemptedSilentLogin)
 	{
 		bAttemptedSilentLogin = true;
@@ -69,23 +73,7 @@ void SMixerLoginPane::StartLoginFlow()
 	}
 
 #if PLATFORM_SUPPORTS_MIXER_OAUTH
-	if (!BrowserWidget.IsValid())
-	{
-		SAssignNew(BrowserWidget, SWebBrowserView)
-			.ContentsToLoad(FString(TEXT("")))
-			.InitialURL(EmptyUrl)
-			.BackgroundColor(BackgroundColor)
-			.SupportsTransparency(true)
-			.OnBeforeNavigation(this, &SMixerLoginPane::OnBrowserBeforeNavigation)
-			.OnCreateWindow(this, &SMixerLoginPane::OnBrowserPopupWindow, false)
-			.OnCloseWindow(this, &SMixerLoginPane::OnBrowserRequestCloseBaseWindow);
-
-		OverlayWidget->AddSlot()
-		[
-			BrowserWidget.ToSharedRef()
-		];
-	}
-
+	CreateBrowserWidget();
 	BrowserWidget->LoadString(TEXT(""), TEXT(""));
 
 	TWeakPtr<SMixerLoginPane> WeakThisForCallback = SharedThis(this);
@@ -108,31 +96,62 @@ void SMixerLoginPane::StopLoginFlowAndHide()
 #if PLATFORM_SUPPORTS_MIXER_OAUTH
 	if (BrowserWidget.IsValid())
 	{
-		OnUIFlowFinished.ExecuteIfBound(false);
-		OverlayWidget->ClearChildren();
-		BrowserWidget.Reset();
+		if (bLoginFlowStarted)
+		{
+			OnUIFlowFinished.ExecuteIfBound(false);
+		}
+		ReleaseBrowserWidget();
 	}
 #endif
 	bAttemptedSilentLogin = false;
+	bLoginFlowStarted = false;
 }
 
+void SMixerLoginPane::PrewarmBrowser()
+{
 #if PLATFORM_SUPPORTS_MIXER_OAUTH
+	CreateBrowserWidget();
+#endif
+}
+
+#if PLATFORM_SUPPORTS_MIXER_OAUTH
+
+void SMixerLoginPane::CreateBrowserWidget()
+{
+	if (!BrowserWidget.IsValid())
+	{
+		SAssignNew(BrowserWidget, SWebBrowserView)
+			.ContentsToLoad(FString(TEXT("")))
+			.InitialURL(EmptyUrl)
+			.BackgroundColor(BackgroundColor)
+			.SupportsTransparency(true)
+			.OnBeforeNavigation(this, &SMixerLoginPane::OnBrowserBeforeNavigation)
+			.OnCreateWindow(this, &SMixerLoginPane::OnBrowserPopupWindow, false)
+			.OnCloseWindow(this, &SMixerLoginPane::OnBrowserRequestCloseBaseWindow);
+
+		OverlayWidget->AddSlot()
+		[
+			BrowserWidget.ToSharedRef()
+		];
+	}
+}
+
+void SMixerLoginPane::ReleaseBrowserWidget()
+{
+	// Dropping the last reference to the view (and any popups) shuts down its browser window
+	OverlayWidget->ClearChildren();
+	BrowserWidget.Reset();
+}
 
 void SMixerLoginPane::StartLoginFlowAfterCookiesDeleted()
 {
 	if (BrowserWidget.IsValid())
 	{
-#if WITH_EDITOR
-		static const FString OAuthScope = GIsEditor ? "interactive:manage:self interactive:robot:self chat:connect chat:chat chat:whisper" : "interactive:robot:self chat:connect chat:chat chat:whisper";
-#else
-		static const FString OAuthScope = "interactive:robot:self chat:connect chat:chat chat:whisper";
-#endif
-
 		const UMixerInteractivitySettings* Settings = GetDefault<UMixerInteractivitySettings>();
 		FString OAuthUrl = FString::Printf(TEXT("https://mixer.com/oauth/authorize?redirect_uri=%s&client_id=%s&scope=%s&response_type=code&sandbox=%s"),
 			*FPlatformHttp::UrlEncode(Settings->GetResolvedRedirectUri()), 
 			*FPlatformHttp::UrlEncode(Settings->ClientId), 
-			*FPlatformHttp::UrlEncode(OAuthScope), 
+			*FPlatformHttp::UrlEncode(Settings->GetOAuthScope()), 
 			*FPlatformHttp::UrlEncode(Settings->GetSandboxForOAuth()));
 		BrowserWidget->LoadURL(OAuthUrl);
 	}
@@ -205,8 +224,8 @@ bool SMixerLoginPane::OnBrowserBeforeNavigation(const FString& NewUrlString, con
 			OnUIFlowFinished.ExecuteIfBound(false);
 		}
 
-		OverlayWidget->ClearChildren();
-		BrowserWidget.Reset();
+		// Nothing more is needed from the browser once the auth code is captured
+		ReleaseBrowserWidget();
 	}
 
 	return false;
@@ -283,15 +302,22 @@ void SMixerLoginPane::OnLoginStateChanged(EMixerLoginState NewState)
 	switch (NewState)
 	{
 	case EMixerLoginState::Not_Logged_In:
-		StartLoginFlow();
+		if (!bDeferLoginFlow || bLoginFlowStarted)
+		{
+			StartLoginFlow();
+		}
 		break;
 
 	case EMixerLoginState::Logged_In:
 #if PLATFORM_SUPPORTS_MIXER_OAUTH
-		OverlayWidget->ClearChildren();
-		BrowserWidget.Reset();
+		ReleaseBrowserWidget();
 #endif
 		bAttemptedSilentLogin = false;
+		if (bDeferLoginFlow)
+		{
+			// Wait to be asked again rather than restarting on a later logout
+			bLoginFlowStarted = false;
+		}
 		break;
 
 	default:
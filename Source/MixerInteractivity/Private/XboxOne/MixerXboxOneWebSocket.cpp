@@ -8,6 +8,8 @@
 //
 //*********************************************************
 #include "MixerXboxOneWebSocket.h"
+#include "Misc/ScopeLock.h"
+#include "Containers/StringConv.h"
 
 FMixerXboxOneWebSocket::FMixerXboxOneWebSocket(const FString& InUri, const TArray<FString>& InProtocols, const TMap<FString, FString>& InHeaders)
 	: Uri(InUri)
@@ -38,8 +40,16 @@ void FMixerXboxOneWebSocket::Connect()
 			TSharedPtr<FMixerXboxOneWebSocket> PinnedThis = WeakThis.Pin();
 			if (PinnedThis.IsValid())
 			{
-				Windows::Storage::Streams::DataReader^ Reader = EventArgs->GetDataReader();
-				FString MessageText = FString(Reader->ReadString(Reader->UnconsumedBufferLength)->Data());
+				FString MessageText;
+				{
+					FScopeLock Lock(&PinnedThis->ReceiveLock);
+					MessageText = PinnedThis->ReadFrame(EventArgs->GetDataReader());
+					if (PinnedThis->OffThreadMessageHandler.IsBound())
+					{
+						PinnedThis->OffThreadMessageHandler.Execute(MessageText);
+						return;
+					}
+				}
 				PinnedThis->GameThreadWork.Enqueue(
 					[WeakThis, MessageText]()
 				{
@@ -100,6 +110,33 @@ void FMixerXboxOneWebSocket::Close(int32 Code, const FString& Reason)
 	}
 }
 
+void FMixerXboxOneWebSocket::ClearOffThreadMessageHandler()
+{
+	FScopeLock Lock(&ReceiveLock);
+	OffThreadMessageHandler.Unbind();
+}
+
+FString FMixerXboxOneWebSocket::ReadFrame(Windows::Storage::Streams::DataReader^ Reader)
+{
+	// ReadString would decode to a Platform::String first, only for it to be copied again into an
+	// FString.  Taking the bytes lets the UTF-8 be decoded once, straight into the string's storage.
+	const uint32 ByteLength = Reader->UnconsumedBufferLength;
+	FString MessageText;
+	if (ByteLength > 0)
+	{
+		ReceiveBuffer.SetNumUninitialized(ByteLength, false);
+		Reader->ReadBytes(Platform::ArrayReference<uint8>(ReceiveBuffer.GetData(), ByteLength));
+
+		const ANSICHAR* Utf8Data = reinterpret_cast<const ANSICHAR*>(ReceiveBuffer.GetData());
+		const int32 TextLength = FUTF8ToTCHAR_Convert::ConvertedLength(Utf8Data, ByteLength);
+		TArray<TCHAR>& Chars = MessageText.GetCharArray();
+		Chars.SetNumUninitialized(TextLength + 1);
+		FUTF8ToTCHAR_Convert::Convert(Chars.GetData(), TextLength, Utf8Data, ByteLength);
+		Chars[TextLength] = TEXT('\0');
+	}
+	return MessageText;
+}
+
 bool FMixerXboxOneWebSocket::IsConnected()
 {
 	return Writer != nullptr;
@@ -122,7 +159,18 @@ void FMixerXboxOneWebSocket::Send(const FString& Data)
 
 void FMixerXboxOneWebSocket::Send(const void* Utf8Data, SIZE_T Size, bool bIsBinary)
 {
-
+	// Message type is fixed when the socket is created, so bIsBinary can't be honored per call.
+	if (Writer != nullptr)
+	{
+		try
+		{
+			Writer->WriteBytes(Platform::ArrayReference<uint8>(static_cast<uint8*>(const_cast<void*>(Utf8Data)), static_cast<uint32>(Size)));
+			SendOperations.Add(Writer->StoreAsync());
+		}
+		catch (...)
+		{
+		}
+	}
 }
 
 bool FMixerXboxOneWebSocket::Tick(float DeltaTime)
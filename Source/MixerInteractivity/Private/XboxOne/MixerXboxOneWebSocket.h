@@ -12,6 +12,7 @@
 #include "CoreMinimal.h"
 #include "Containers/Ticker.h"
 #include "Containers/Queue.h"
+#include "HAL/CriticalSection.h"
 #include "IWebSocket.h"
 
 class FMixerXboxOneWebSocket :
@@ -37,11 +38,27 @@ public:
 public:
 	virtual bool Tick(float DeltaTime) override;
 
+	/**
+	* Frames are normally broadcast through OnMessage on the game thread.  With a handler bound here they
+	* are instead passed to it on the thread pool thread that received them, and OnMessage isn't raised.
+	* The handler may take the string.  Bind before Connect; clearing waits out any call in progress.
+	*/
+	DECLARE_DELEGATE_OneParam(FOnMessageReceivedOffThread, FString& /*Message*/);
+	void SetOffThreadMessageHandler(const FOnMessageReceivedOffThread& Handler)	{ OffThreadMessageHandler = Handler; }
+	void ClearOffThreadMessageHandler();
+
 private:
 	void FinishClose(int32 Code, const FString& Reason);
+	FString ReadFrame(Windows::Storage::Streams::DataReader^ Reader);
 
 	TQueue<TFunction<void()>, EQueueMode::Mpsc> GameThreadWork;
 
+	// Held while a frame is read and handed on, so the pooled buffer and the off-thread handler
+	// are only ever used by one callback at a time.
+	FCriticalSection ReceiveLock;
+	TArray<uint8> ReceiveBuffer;
+	FOnMessageReceivedOffThread OffThreadMessageHandler;
+
 	Windows::Networking::Sockets::MessageWebSocket^ Socket;
 	Windows::Storage::Streams::DataWriter^ Writer;
 
@@ -0,0 +1,98 @@
+//*********************************************************
+//
+// Copyright (c) Microsoft. All rights reserved.
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT.
+//
+//*********************************************************
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MixerImageCache.h"
+
+/** How soon a queued avatar fetch should go out */
+enum class EMixerAvatarPriority : uint8
+{
+	/** Not on screen yet, e.g. prefetching for a participant who just joined */
+	Background,
+
+	/** Being drawn right now; fetched ahead of everything in the background */
+	Visible,
+};
+
+/**
+* Avatars of Mixer users, keyed by user id (as in FMixerUser::Id, or a chat message sender's
+* FUniqueNetIdMixer).  Fetches are queued and released no faster than
+* UMixerInteractivitySettings::AvatarFetchesPerSecond, with no more than MaxConcurrentAvatarFetches
+* outstanding, visible ones first, so that a burst of joins doesn't turn into hundreds of
+* simultaneous requests.  Repeated requests for one user share a single fetch.
+*
+* Images are downloaded, decoded and held by FMixerImageCache, so they count against its memory
+* budget; on top of that no more than AvatarCacheCapacity avatars are kept, least recently used
+* going first.  Game thread only.
+*/
+class MIXERINTERACTIVITY_API FMixerAvatarCache
+{
+public:
+	static FMixerAvatarCache& Get();
+
+	/**
+	* Look up an avatar that is already loaded.  Counts as a use for eviction.
+	*
+	* @return	whether the avatar was ready, in which case OutRegion is filled in.
+	*/
+	bool FindAvatar(int32 UserId, FMixerImageRegion& OutRegion);
+
+	/**
+	* Fetch a user's avatar.  OnLoaded is called on the game thread, immediately if the avatar is
+	* already loaded, and with a null texture if it couldn't be fetched (or failed to recently).
+	* Requesting an avatar that's already queued joins that fetch, raising its priority if need be.
+	*/
+	void RequestAvatar(int32 UserId, EMixerAvatarPriority Priority, const FOnMixerImageLoaded& OnLoaded);
+
+	/** Change the priority of a fetch that is still queued, e.g. as a list entry scrolls into or out of view. */
+	void SetAvatarPriority(int32 UserId, EMixerAvatarPriority Priority);
+
+	/** Drop a fetch that hasn't gone out yet, without notifying its callers. */
+	void CancelAvatarRequest(int32 UserId);
+
+	/** Release queued fetches as the rate limit allows.  Called from the module tick. */
+	void Tick(float DeltaTime);
+
+	/** Whether any fetch is still waiting on the rate limit. */
+	bool HasQueuedFetches() const { return Requests.Num() > NumInFlight; }
+
+	/** Drop the queue without notifying callers, and forget loaded avatars. */
+	void Reset();
+
+private:
+	struct FAvatarRequest
+	{
+		TArray<FOnMixerImageLoaded> Waiters;
+		EMixerAvatarPriority Priority;
+		bool bInFlight;
+	};
+
+	void StartFetch(int32 UserId);
+	void OnAvatarLoaded(const FMixerImageRegion& Region, int32 UserId);
+	void TouchAvatar(int32 UserId);
+	void TrimToCapacity();
+	static FString GetAvatarUrl(int32 UserId);
+
+private:
+	TMap<int32, FAvatarRequest> Requests;
+	// FIFO per priority.  Entries whose request has since moved queue, gone out or been cancelled are skipped.
+	TArray<int32> VisibleQueue;
+	TArray<int32> BackgroundQueue;
+	// Loaded avatars and when each was last used
+	TMap<int32, uint64> LoadedAvatars;
+	// Avatars that failed to load, and when they may be fetched again
+	TMap<int32, double> FailedAvatars;
+	uint64 UseCounter;
+	float FetchTokens;
+	int32 NumInFlight;
+
+	FMixerAvatarCache();
+};
@@ -0,0 +1,282 @@
+//*********************************************************
+//
+// Copyright (c) Microsoft. All rights reserved.
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT.
+//
+//*********************************************************
+#pragma once
+
+#include "Components/ActorComponent.h"
+#include "Engine/NetSerialization.h"
+#include "MixerInteractivityBlueprintLibrary.h"
+#include "OnlineChatMixer.h"
+#include "MixerCrowdReplicationComponent.generated.h"
+
+/** Aggregate state of one button as replicated by UMixerCrowdReplicationComponent.  Counts saturate at 65535. */
+USTRUCT()
+struct MIXERINTERACTIVITY_API FMixerReplicatedButton : public FFastArraySerializerItem
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FName Button;
+
+	UPROPERTY()
+	uint16 DownCount;
+
+	UPROPERTY()
+	uint16 PressCount;
+
+	UPROPERTY()
+	bool bEnabled;
+
+	/** Server world time (see AGameStateBase::GetServerWorldTimeSeconds) at which the button's cooldown ends */
+	UPROPERTY()
+	float CooldownEndTime;
+
+	FMixerReplicatedButton()
+		: DownCount(0)
+		, PressCount(0)
+		, bEnabled(false)
+		, CooldownEndTime(0.0f)
+	{
+	}
+};
+
+USTRUCT()
+struct MIXERINTERACTIVITY_API FMixerReplicatedButtonArray : public FFastArraySerializer
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<FMixerReplicatedButton> Items;
+
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+	{
+		return FFastArraySerializer::FastArrayDeltaSerialize<FMixerReplicatedButton, FMixerReplicatedButtonArray>(Items, DeltaParms, *this);
+	}
+};
+
+template<>
+struct TStructOpsTypeTraits<FMixerReplicatedButtonArray> : public TStructOpsTypeTraitsBase2<FMixerReplicatedButtonArray>
+{
+	enum
+	{
+		WithNetDeltaSerializer = true,
+	};
+};
+
+/** Aggregate position of one joystick as replicated by UMixerCrowdReplicationComponent, each axis quantized to a signed byte. */
+USTRUCT()
+struct MIXERINTERACTIVITY_API FMixerReplicatedStick : public FFastArraySerializerItem
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FName Stick;
+
+	UPROPERTY()
+	int8 X;
+
+	UPROPERTY()
+	int8 Y;
+
+	FMixerReplicatedStick()
+		: X(0)
+		, Y(0)
+	{
+	}
+};
+
+USTRUCT()
+struct MIXERINTERACTIVITY_API FMixerReplicatedStickArray : public FFastArraySerializer
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<FMixerReplicatedStick> Items;
+
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+	{
+		return FFastArraySerializer::FastArrayDeltaSerialize<FMixerReplicatedStick, FMixerReplicatedStickArray>(Items, DeltaParms, *this);
+	}
+};
+
+template<>
+struct TStructOpsTypeTraits<FMixerReplicatedStickArray> : public TStructOpsTypeTraitsBase2<FMixerReplicatedStickArray>
+{
+	enum
+	{
+		WithNetDeltaSerializer = true,
+	};
+};
+
+/** Active scene of one participant group as replicated by UMixerCrowdReplicationComponent. */
+USTRUCT()
+struct MIXERINTERACTIVITY_API FMixerReplicatedGroup : public FFastArraySerializerItem
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FName Group;
+
+	UPROPERTY()
+	FName Scene;
+};
+
+USTRUCT()
+struct MIXERINTERACTIVITY_API FMixerReplicatedGroupArray : public FFastArraySerializer
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<FMixerReplicatedGroup> Items;
+
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+	{
+		return FFastArraySerializer::FastArrayDeltaSerialize<FMixerReplicatedGroup, FMixerReplicatedGroupArray>(Items, DeltaParms, *this);
+	}
+};
+
+template<>
+struct TStructOpsTypeTraits<FMixerReplicatedGroupArray> : public TStructOpsTypeTraitsBase2<FMixerReplicatedGroupArray>
+{
+	enum
+	{
+		WithNetDeltaSerializer = true,
+	};
+};
+
+/** Chat poll running in a channel the server's Mixer user has joined, as replicated by UMixerCrowdReplicationComponent. */
+USTRUCT()
+struct MIXERINTERACTIVITY_API FMixerReplicatedPoll
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	bool bActive;
+
+	UPROPERTY()
+	FString Question;
+
+	UPROPERTY()
+	TArray<FString> Answers;
+
+	UPROPERTY()
+	TArray<int32> Tallies;
+
+	FMixerReplicatedPoll()
+		: bActive(false)
+	{
+	}
+};
+
+/**
+* Runs the Mixer session on the server (or listen server host) only and replicates a compact view of
+* the crowd's state to game clients, so that clients need neither a Mixer login nor their own socket.
+* Only the buttons, joysticks and groups listed on the component are sent, and only when their
+* quantized values change.  Which clients receive the state follows the owning actor's relevancy,
+* so e.g. placing the component on a PlayerState or an actor with bOnlyRelevantToOwner limits it
+* to the matching connections.
+*
+* On clients the component never touches the Mixer module; read the replicated state via the
+* accessors below.  On the server they return the state as of the last sample.
+*/
+UCLASS(ClassGroup=Mixer, meta=(BlueprintSpawnableComponent))
+class MIXERINTERACTIVITY_API UMixerCrowdReplicationComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UMixerCrowdReplicationComponent();
+
+	/** Buttons whose aggregate state is replicated */
+	UPROPERTY(EditAnywhere, Category="Mixer|Replication")
+	TArray<FMixerButtonReference> Buttons;
+
+	/** Joysticks whose aggregate position is replicated */
+	UPROPERTY(EditAnywhere, Category="Mixer|Replication")
+	TArray<FMixerStickReference> Sticks;
+
+	/** Participant groups whose active scene is replicated */
+	UPROPERTY(EditAnywhere, Category="Mixer|Replication")
+	TArray<FMixerGroupReference> Groups;
+
+	/** Replicate the question, answers and tallies of chat polls in channels the server's Mixer user has joined */
+	UPROPERTY(EditAnywhere, Category="Mixer|Replication")
+	bool bReplicatePolls;
+
+	/** Seconds between samples of the Mixer session on the server.  0 samples every tick. */
+	UPROPERTY(EditAnywhere, Category="Mixer|Replication", meta=(UIMin=0, ClampMin=0))
+	float SampleInterval;
+
+	/** When set, the server starts interactivity at BeginPlay, or as soon as its Mixer user finishes logging in. */
+	UPROPERTY(EditAnywhere, Category="Mixer|Replication")
+	bool bStartInteractivityOnServer;
+
+	/**
+	* Replicated counterpart of UMixerInteractivityBlueprintLibrary::GetButtonState.
+	*
+	* @return	whether the button is one of those being replicated and state for it has arrived.
+	*/
+	UFUNCTION(BlueprintPure, Category="Mixer|Replication")
+	bool GetReplicatedButtonState(FMixerButtonReference Button, FTimespan& RemainingCooldown, int32& DownCount, int32& PressCount, bool& Enabled) const;
+
+	/**
+	* Replicated counterpart of UMixerInteractivityBlueprintLibrary::GetStickState.
+	*
+	* @return	whether the joystick is one of those being replicated and state for it has arrived.
+	*/
+	UFUNCTION(BlueprintPure, Category="Mixer|Replication")
+	bool GetReplicatedStickState(FMixerStickReference Stick, float& XAxis, float& YAxis) const;
+
+	/** Replicated counterpart of IMixerInteractivityModule::GetCurrentScene.  None if the group isn't being replicated. */
+	UFUNCTION(BlueprintPure, Category="Mixer|Replication")
+	FName GetReplicatedCurrentScene(FMixerGroupReference Group) const;
+
+	/**
+	* Retrieve the most recent chat poll.
+	*
+	* @return	whether a poll is currently running.
+	*/
+	UFUNCTION(BlueprintPure, Category="Mixer|Replication")
+	bool GetReplicatedPoll(FString& Question, TArray<FString>& Answers, TArray<int32>& Tallies) const;
+
+public:
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
+private:
+	/** Size the replicated arrays to match Buttons, Sticks and Groups, one item per entry in the same order. */
+	void BuildReplicatedItems();
+	void SampleSession();
+	float GetServerWorldTime() const;
+
+	void OnLoginStateChanged(EMixerLoginState NewState);
+	void OnPollChanged(const FUniqueNetId& UserId, const FChatRoomId& RoomId, const TSharedRef<FChatPollMixer>& ChatPoll);
+	void OnPollEnd(const FUniqueNetId& UserId, const FChatRoomId& RoomId, const TSharedRef<FChatPollMixer>& ChatPoll);
+
+	UPROPERTY(Replicated)
+	FMixerReplicatedButtonArray ReplicatedButtons;
+
+	UPROPERTY(Replicated)
+	FMixerReplicatedStickArray ReplicatedSticks;
+
+	UPROPERTY(Replicated)
+	FMixerReplicatedGroupArray ReplicatedGroups;
+
+	UPROPERTY(Replicated)
+	FMixerReplicatedPoll ReplicatedPoll;
+
+	FDelegateHandle LoginStateChangedHandle;
+	FDelegateHandle PollStartHandle;
+	FDelegateHandle PollUpdateHandle;
+	FDelegateHandle PollEndHandle;
+
+	float TimeSinceSample;
+};
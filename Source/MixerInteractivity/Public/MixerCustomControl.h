@@ -25,6 +25,63 @@ public:
 	UPROPERTY(EditAnywhere, Category="Property Replication", meta=(UIMin=0, ClampMin=0))
 	float ClientPropertyUpdateInterval;
 
+	/**
+	* When set, update passes only consider client-writable properties that have been
+	* flagged via MarkPropertyDirty (or SetClientProperty from C++) since the last pass,
+	* instead of comparing every property against its last sent value.
+	*/
+	UPROPERTY(EditAnywhere, Category="Property Replication")
+	bool bOnlySendDirtyProperties;
+
+	/**
+	* When set, an update that changes part of an array or struct property also describes the change,
+	* so the control's script can patch what it shows rather than rebuild it.  The property itself is
+	* still sent in full, since the service keeps it as the control's state for participants who join
+	* later.  The descriptions go in the update's "$deltas" object, keyed like the properties:
+	*   arrays:  { "$append": [ ...new trailing elements ] }, or
+	*            { "$length": N, "$set": { "index": element, ... } } (truncate or extend to N, then assign)
+	*   structs: { "$set": { "field": value, ... } }
+	* A property with no entry there changed too much to describe, or had more than one change coalesced
+	* into the same update; take its full value.
+	*/
+	UPROPERTY(EditAnywhere, Category="Property Replication")
+	bool bSendElementDeltas;
+
+	/**
+	* Per-property precision for float properties, and for structs made only of floats (FVector, FRotator,
+	* FVector2D, FLinearColor...).  Changes smaller than the precision aren't sent, and values are snapped to
+	* the largest power of two step no larger than it so that they're written exactly in few digits.
+	* Read from the class defaults when the first instance initializes.
+	*/
+	UPROPERTY(EditDefaultsOnly, Category="Property Replication", meta=(ClampMin=0))
+	TMap<FName, float> ClientPropertyPrecision;
+
+	/**
+	* Flag a client-writable property as changed so that it is sent on the next update pass.
+	* Required when bOnlySendDirtyProperties is set; harmless otherwise.
+	*
+	* @param	PropertyName		Name of the property that was modified.
+	*/
+	UFUNCTION(BlueprintCallable, Category="Mixer|Interactivity|Property Replication")
+	void MarkPropertyDirty(FName PropertyName);
+
+	/** Send every client-writable property on the next update pass, changed or not. */
+	void ResendAllProperties()			{ bResendAllProperties = true; }
+
+	/**
+	* Assign a client-writable property and flag it as changed in one step.
+	*
+	* @param	Field				Member of this control to assign.
+	* @param	Value				New value.
+	* @param	PropertyName		Name of the UPROPERTY backing Field.
+	*/
+	template <typename T>
+	void SetClientProperty(T& Field, const T& Value, FName PropertyName)
+	{
+		Field = Value;
+		MarkPropertyDirty(PropertyName);
+	}
+
 	/**
 	* Opportunity for C++ code to receive a notification when property updates
 	* have been received from the Mixer Interactive service.  At the point that
@@ -34,6 +91,22 @@ public:
 	*/
 	virtual void NativeOnServerPropertiesUpdated();
 
+	/**
+	* As above, but also told which properties the update actually wrote, so that
+	* controls can skip work tied to fields that didn't change.
+	* Default implementation calls the parameterless version.
+	*
+	* @param	ChangedProperties	Properties assigned from the update, in the order received.
+	*/
+	virtual void NativeOnServerPropertiesUpdated(const TArray<UProperty*>& ChangedProperties);
+
+	/**
+	* Apply properties received from the Mixer Interactive service to matching UPROPERTY
+	* fields, touching only the fields present in the update, then notify via
+	* NativeOnServerPropertiesUpdated.
+	*/
+	void ApplyServerPropertyUpdate(const class FJsonObject& UpdatedProperties);
+
 protected:
 
 	/**
@@ -41,6 +114,7 @@ protected:
 	* be transmitted to the server.  If this collection is non-empty the control
 	* instance will be ticked every ClientPropertyUpdateInterval seconds.
 	* Default implementation collects all properties that are BlueprintReadWrite.
+	* Called once per class; the result is shared by every instance of that class.
 	*
 	* @param	OutProperties		Out parameter to be filled with UProperty instances for which updates should be sent client->server
 	*/
@@ -59,16 +133,40 @@ public:
 
 	virtual void PostLoad() override;
 
+	/**
+	* References from cluster members are gathered once, when the cluster is created.  Controls whose
+	* properties or event graph may point at other objects stay out of the event source's cluster and
+	* are traced by GC as usual.
+	*/
+	virtual bool CanBeInCluster() const override;
+
 public:
 	bool Tick(float DeltaTime);
 
+	/** Discard the cached property serialization plan for a class, e.g. after a Blueprint recompile. */
+	static void InvalidateSerializationPlan(const UClass* ForClass);
+
 	UFUNCTION(BlueprintImplementableEvent)
 	void OnServerPropertiesUpdated();
 
 private:
 	void InitClientWrittenPropertyMaintenance();
+	TSharedRef<const struct FMixerCustomControlSerializationPlan> FindOrBuildSerializationPlan();
 
 private:
 	TArray<UProperty*> ClientWritableProperties;
 	TArray<uint8> LastSentPropertyData;
+
+	// Shared by all instances of the class; built the first time one of them initializes
+	TSharedPtr<const struct FMixerCustomControlSerializationPlan> SerializationPlan;
+
+	// Parallel to ClientWritableProperties
+	TBitArray<> DirtyProperties;
+
+	// Current values gathered in LastSentPropertyData's layout, so all-POD controls can compare with one memcmp
+	TArray<uint8> GatheredPropertyData;
+	bool bPlainOldDataOnly;
+
+	// Set by ResendAllProperties until the next update pass
+	bool bResendAllProperties;
 };
\ No newline at end of file
@@ -21,9 +21,16 @@
 
 #include "MixerDynamicDelegateBinding.generated.h"
 
+namespace MixerBindingUtils
+{
+	class FCustomControlPropertyCache;
+}
+
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_FourParams(FMixerButtonEventDynamicDelegate, FMixerButtonReference, Button, int32, ParticipantId, FMixerTransactionId, TransactionId, int32, SparkCost);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FMixerButtonBatchEventDynamicDelegate, FMixerButtonReference, Button, const TArray<int32>&, ParticipantIds, int32, Count);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FMixerParticipantEventDynamicDelegate, int32, ParticipantId);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_FourParams(FMixerStickEventDynamicDelegate, FMixerStickReference, Joystick, int32, ParticipantId, float, XAxis, float, YAxis);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_FourParams(FMixerStickCrowdEventDynamicDelegate, FMixerStickReference, Joystick, int32, ParticipantCount, float, XAxis, float, YAxis);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FMixerBroadcastingEventDynamicDelegate);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_FiveParams(FMixerTextSubmittedEventDynamicDelegate, FMixerTextboxReference, Textbox, int32, ParticipantId, FText, SubmittedText, FMixerTransactionId, TransactionId, int32, SparkCost);
 
@@ -33,34 +40,159 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FMixerCustomControlUpdateDynamicDele
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FMixerCustomMethodStubDelegate);
 
+/**
+* Blueprint functions bound to one Mixer event, across every instance that binds it.  The dynamic delegates
+* above describe the signatures; this replaces their invocation lists so that binding and unbinding don't
+* scan the existing entries.  Add returns a slot that Remove takes back, and freed slots are reused.
+* Functions bound before a level was saved have no slot and are matched by name instead.
+*/
+USTRUCT()
+struct MIXERINTERACTIVITY_API FMixerBlueprintInstanceDelegates
+{
+	GENERATED_BODY()
+
+public:
+	FMixerBlueprintInstanceDelegates()
+		: CompactAtMaxIndex(16)
+	{
+	}
+
+	int32 Add(UObject* Instance, FName FunctionName);
+
+	/** Remove the entry in Slot, provided it still belongs to Instance. */
+	void Remove(int32 Slot, const UObject* Instance);
+
+	/** Remove a function bound before the level was saved. */
+	void Remove(const UObject* Instance, FName FunctionName);
+
+	bool IsBound() const
+	{
+		return Delegates.Num() > 0 || SavedDelegates.Num() > 0;
+	}
+
+	/** Whether any bound instance still exists.  Unlike IsBound this visits every entry. */
+	bool HasLiveBindings() const;
+
+	/** Take over the functions Other had bound before its level was saved.  Entries added through Add stay with Other. */
+	void AbsorbSaved(FMixerBlueprintInstanceDelegates& Other);
+
+	/** Forget functions bound before the level was saved whose instances are gone, e.g. along with their world. */
+	void TrimDeadSaved();
+
+	/** Whether any functions bound before the level was saved remain. */
+	bool HasSaved() const
+	{
+		return SavedDelegates.Num() > 0;
+	}
+
+	/**
+	* Call every bound function with Parms, which must be laid out as the event signature's parameters.
+	* Calls go to a snapshot, so handlers may bind and unbind freely.
+	*/
+	void ProcessDelegates(void* Parms) const;
+
+	bool Serialize(FArchive& Ar);
+
+private:
+	TSparseArray<FScriptDelegate> Delegates;
+	TArray<FScriptDelegate> SavedDelegates;
+
+	/** Entries for destroyed instances are swept out whenever the array grows to this size */
+	int32 CompactAtMaxIndex;
+};
+
+template<>
+struct TStructOpsTypeTraits<FMixerBlueprintInstanceDelegates> : public TStructOpsTypeTraitsBase2<FMixerBlueprintInstanceDelegates>
+{
+	enum
+	{
+		WithSerializer = true,
+	};
+};
+
 USTRUCT()
 struct MIXERINTERACTIVITY_API FMixerButtonEventDynamicDelegateWrapper
 {
 	GENERATED_BODY()
 
+	/** FMixerButtonEventDynamicDelegate */
+	UPROPERTY()
+	FMixerBlueprintInstanceDelegates PressedDelegate;
+
+	/** FMixerButtonEventDynamicDelegate */
+	UPROPERTY()
+	FMixerBlueprintInstanceDelegates ReleasedDelegate;
+
+	/** FMixerButtonBatchEventDynamicDelegate */
 	UPROPERTY()
-	FMixerButtonEventDynamicDelegate PressedDelegate;
+	FMixerBlueprintInstanceDelegates BatchedPressedDelegate;
 
+	/** FMixerButtonBatchEventDynamicDelegate */
 	UPROPERTY()
-	FMixerButtonEventDynamicDelegate ReleasedDelegate;
+	FMixerBlueprintInstanceDelegates BatchedReleasedDelegate;
+
+	/** Events since the last flush, for the batched delegates.  Each participant is listed once; Count includes repeats. */
+	struct FPendingBatch
+	{
+		TArray<int32> ParticipantIds;
+		TSet<int32> SeenParticipants;
+		int32 Count = 0;
+	};
+
+	FPendingBatch PendingPressed;
+	FPendingBatch PendingReleased;
 
 	bool IsBound()
 	{
-		return PressedDelegate.IsBound() || ReleasedDelegate.IsBound();
+		return PressedDelegate.IsBound() || ReleasedDelegate.IsBound() || BatchedPressedDelegate.IsBound() || BatchedReleasedDelegate.IsBound();
 	}
 };
 
+/** How a blueprint stick event is delivered when many participants move the same stick within a frame. */
+UENUM()
+enum class EMixerStickEventCoalescing : uint8
+{
+	/** Fire for every move from every participant as it arrives. */
+	None,
+
+	/** Fire once per frame for each participant that moved, with their most recent value. */
+	LatestPerParticipant UMETA(DisplayName = "Latest Per Participant"),
+
+	/** Fire once per frame with the average of each moving participant's most recent value. */
+	CrowdAverage UMETA(DisplayName = "Crowd Average"),
+};
+
 USTRUCT()
 struct MIXERINTERACTIVITY_API FMixerStickEventDynamicDelegateWrapper
 {
 	GENERATED_BODY()
 
+	/** FMixerStickEventDynamicDelegate */
+	UPROPERTY()
+	FMixerBlueprintInstanceDelegates Delegate;
+
+	/** FMixerStickEventDynamicDelegate */
 	UPROPERTY()
-	FMixerStickEventDynamicDelegate Delegate;
+	FMixerBlueprintInstanceDelegates LatestPerParticipantDelegate;
+
+	/** FMixerStickCrowdEventDynamicDelegate */
+	UPROPERTY()
+	FMixerBlueprintInstanceDelegates CrowdDelegate;
+
+	/** Most recent value per participant since the last flush.  Only gathered while a coalesced delegate is bound. */
+	TMap<uint32, FVector2D> PendingValues;
+
+	/** Routed counterparts of LatestPerParticipantDelegate (one per participant), which also need values gathered */
+	int32 NumRoutedLatestPerParticipant = 0;
 
 	bool IsBound()
 	{
-		return Delegate.IsBound();
+		return Delegate.IsBound() || LatestPerParticipantDelegate.IsBound() || CrowdDelegate.IsBound();
+	}
+
+	bool IsCoalescedBound()
+	{
+		return LatestPerParticipantDelegate.IsBound() || CrowdDelegate.IsBound() || NumRoutedLatestPerParticipant > 0;
 	}
 };
 
@@ -69,8 +201,9 @@ struct MIXERINTERACTIVITY_API FMixerTextboxEventDynamicDelegateWrapper
 {
 	GENERATED_BODY()
 
+	/** FMixerTextSubmittedEventDynamicDelegate */
 	UPROPERTY()
-	FMixerTextSubmittedEventDynamicDelegate SubmittedDelegate;
+	FMixerBlueprintInstanceDelegates SubmittedDelegate;
 
 	bool IsBound()
 	{
@@ -86,14 +219,19 @@ struct MIXERINTERACTIVITY_API FMixerCustomControlDelegateWrapper
 	UPROPERTY()
 	UMixerCustomControl* MappedControl;
 
+	/** FMixerCustomControlUpdateDynamicDelegate */
 	UPROPERTY()
-	FMixerCustomControlUpdateDynamicDelegate UpdateDelegate;
+	FMixerBlueprintInstanceDelegates UpdateDelegate;
 
+	/** FMixerCustomControlInputDynamicDelegate */
 	UPROPERTY()
-	FMixerCustomControlInputDynamicDelegate InputDelegate;
+	FMixerBlueprintInstanceDelegates InputDelegate;
 
 	TSharedPtr<FJsonObject> UnmappedControl;
 
+	/** Typed copies of UnmappedControl's properties for Get Custom Control Property nodes, created on first read. */
+	TSharedPtr<MixerBindingUtils::FCustomControlPropertyCache> UnmappedPropertyCache;
+
 	bool IsBound()
 	{
 		return MappedControl != nullptr || UpdateDelegate.IsBound() || InputDelegate.IsBound();
@@ -108,11 +246,12 @@ struct MIXERINTERACTIVITY_API FMixerCustomMethodStubDelegateWrapper
 	UPROPERTY()
 	FMemberReference PrototypeReference;
 
-	UPROPERTY(transient)
-	UFunction* FunctionPrototype;
+	/** Weak so that the source's cluster doesn't keep the signature's class alive; re-resolved when a binding finds it gone. */
+	TWeakObjectPtr<UFunction> FunctionPrototype;
 
+	/** Signature given by FunctionPrototype */
 	UPROPERTY()
-	FMixerCustomMethodStubDelegate Delegate;
+	FMixerBlueprintInstanceDelegates Delegate;
 
 	bool IsBound()
 	{
@@ -120,6 +259,54 @@ struct MIXERINTERACTIVITY_API FMixerCustomMethodStubDelegateWrapper
 	}
 };
 
+/** Groups of native module events that the blueprint event source subscribes to on demand. */
+enum class EMixerNativeEventCategory : uint8
+{
+	Button,
+	Stick,
+	Textbox,
+	CustomControl,
+	ParticipantState,
+	Broadcasting,
+	CustomMethod,
+	CoalescedFlush,
+
+	Count
+};
+
+/** Event that one entry of a UMixerDelegateBinding binds to. */
+enum class EMixerBindingSlotType : uint8
+{
+	ButtonPressed,
+	ButtonReleased,
+	ButtonBatchedPressed,
+	ButtonBatchedReleased,
+	Stick,
+	StickLatestPerParticipant,
+	StickCrowdAverage,
+	TextSubmitted,
+	CustomMethod,
+	CustomControlInput,
+	CustomControlUpdate,
+	ParticipantJoined,
+	ParticipantLeft,
+	ParticipantInputDisabled,
+	BroadcastingStarted,
+	BroadcastingStopped,
+};
+
+/** One entry of a UMixerDelegateBinding's bindings, flattened for binding many instances. */
+struct FMixerBindingSlot
+{
+	EMixerBindingSlotType Type;
+
+	/** Control or method name.  None for participant and broadcasting events. */
+	FName Name;
+
+	FName TargetFunctionName;
+};
+
+class UMixerDelegateBinding;
 
 UCLASS()
 class MIXERINTERACTIVITY_API UMixerInteractivityBlueprintEventSource : public UObject
@@ -130,30 +317,43 @@ public:
 	UMixerInteractivityBlueprintEventSource(const FObjectInitializer& Initializer);
 
 public:
+	/** FMixerParticipantEventDynamicDelegate */
 	UPROPERTY()
-	FMixerParticipantEventDynamicDelegate ParticipantJoinedDelegate;
+	FMixerBlueprintInstanceDelegates ParticipantJoinedDelegate;
 
+	/** FMixerParticipantEventDynamicDelegate */
 	UPROPERTY()
-	FMixerParticipantEventDynamicDelegate ParticipantLeftDelegate;
+	FMixerBlueprintInstanceDelegates ParticipantLeftDelegate;
 
+	/** FMixerParticipantEventDynamicDelegate */
 	UPROPERTY()
-	FMixerParticipantEventDynamicDelegate ParticipantInputDisabledDelegate;
+	FMixerBlueprintInstanceDelegates ParticipantInputDisabledDelegate;
 
+	/** FMixerBroadcastingEventDynamicDelegate */
 	UPROPERTY()
-	FMixerBroadcastingEventDynamicDelegate BroadcastingStartedDelegate;
+	FMixerBlueprintInstanceDelegates BroadcastingStartedDelegate;
 
+	/** FMixerBroadcastingEventDynamicDelegate */
 	UPROPERTY()
-	FMixerBroadcastingEventDynamicDelegate BroadcastingStoppedDelegate;
+	FMixerBlueprintInstanceDelegates BroadcastingStoppedDelegate;
 
 public:
-	FMixerButtonEventDynamicDelegate* GetButtonEvent(FName ButtonName, bool Pressed);
-	FMixerStickEventDynamicDelegate* GetStickEvent(FName StickName);
-	FMixerCustomControlInputDynamicDelegate& GetCustomControlInputEvent(FName ControlName);
-	FMixerCustomControlUpdateDynamicDelegate& GetCustomControlUpdateEvent(FName ControlName);
-	void AddCustomMethodBinding(FName EventName, UObject* TargetObject, FName TargetFunctionName);
-	void RemoveCustomMethodBinding(FName EventName, UObject* TargetObject, FName TargetFunctionName);
-	void AddTextSubmittedBinding(FName TextboxName, UObject* TargetObject, FName TargetFunctionName);
-	void RemoveTextSubmittedBinding(FName TextboxName, UObject* TargetObject, FName TargetFunctionName);
+	/**
+	* Bind one instance to every entry of its class's binding plan, or unbind it again.  The plan's events are
+	* resolved once per class for this world and shared by all instances, and the slots each instance takes
+	* are recorded, so that unbinding (e.g. when an actor returns to a pool) and binding again cost constant
+	* time per entry.  Binding an instance that's already bound does nothing.
+	*/
+	void BindInstance(const UMixerDelegateBinding* Binding, const TArray<FMixerBindingSlot>& Plan, UObject* Instance);
+	void UnbindInstance(const UMixerDelegateBinding* Binding, const TArray<FMixerBindingSlot>& Plan, UObject* Instance);
+
+	/**
+	* Deliver an instance's events that concern a single participant (their input, joining and leaving) only
+	* for ParticipantId, or for everyone again when ParticipantId is 0.  Routed events are found through a
+	* per-participant map, so e.g. one avatar per viewer costs one call per input rather than one per avatar.
+	* Routing binds the instance if it isn't bound, and lasts until it's unbound.
+	*/
+	void RouteInstance(const UMixerDelegateBinding* Binding, const TArray<FMixerBindingSlot>& Plan, UObject* Instance, uint32 ParticipantId);
 
 	void OnButtonNativeEvent(FName ButtonName, TSharedPtr<const FMixerRemoteUser> Participant, const FMixerButtonEventDetails& Details);
 	void OnParticipantStateChangedNativeEvent(TSharedPtr<const FMixerRemoteUser> Participant, EMixerInteractivityParticipantState NewState);
@@ -164,6 +364,9 @@ public:
 	void OnCustomControlPropertyUpdateNativeEvent(FName ControlName, const TSharedRef<FJsonObject> UpdatedProperties);
 	void OnTextboxSubmitNativeEvent(FName TextboxName, TSharedPtr<const FMixerRemoteUser> Participant, const FMixerTextboxEventDetails& Details);
 
+	/** Deliver input that was coalesced over the last frame.  Called once per module tick. */
+	void FlushCoalescedEvents();
+
 #if WITH_EDITORONLY_DATA
 	void RefreshCustomControls();
 	void OnCustomControlCompiled(class UBlueprint* CompiledBP);
@@ -172,9 +375,22 @@ public:
 	virtual UWorld* GetWorld() const override;
 	virtual void PostLoad() override;
 
+	/**
+	* The source and its mapped custom controls are clustered when loaded from a cooked level, so that GC
+	* marks them as a unit rather than tracing each control.  Nothing in the cluster changes membership at
+	* runtime; mapping controls is editor only.
+	*/
+	virtual bool CanBeClusterRoot() const override;
+
 	UMixerCustomControl* GetMappedCustomControl(FName ControlName);
 	TSharedPtr<FJsonObject> GetUnmappedCustomControl(FName ControlName);
 
+	/**
+	* Copy a property of an unmapped custom control into Dest as Property's type.  The conversion from Json
+	* is cached per property and type, and redone only when an update changes the property.
+	*/
+	bool ReadUnmappedCustomControlProperty(FName ControlName, const FString& PropertyName, UProperty* Property, void* Dest);
+
 private:
 
 	UPROPERTY()
@@ -195,9 +411,131 @@ private:
 public:
 	static UMixerInteractivityBlueprintEventSource* GetBlueprintEventSource(UWorld* ForWorld);
 
+	/** Let go of a source held over from a world that has gone (see bPersistBlueprintEventSource), e.g. on shutdown. */
+	static void ReleasePersistentSource();
+
+	/** Subscribe for bindings saved with the source.  Only subscribes for categories not already held, so may be called again after more are added. */
 	void RegisterForMixerEvents();
+
+	/** Drop the bindings saved with a level that has gone, and the subscriptions held for those categories left without any. */
+	void TrimDeadSavedBindings();
+
+	/** The part of PostLoad that finds the world's source.  May rename objects, so only runs on the game thread outside async loading. */
+	void RegisterLoadedSource();
+
+	/**
+	* Reference counted subscription to native module events.  The first acquire for a category
+	* subscribes and the last release unsubscribes, so worlds with no bindings pay nothing per event.
+	*/
+	void AcquireNativeEvent(EMixerNativeEventCategory Category);
+	void ReleaseNativeEvent(EMixerNativeEventCategory Category);
+
+	/** How many worlds have a source, for leak checks. */
+	static int32 GetNumBlueprintEventSources()	{ return BlueprintEventSources.Num(); }
+
 private:
-	static TArray<TWeakObjectPtr<UMixerInteractivityBlueprintEventSource>> BlueprintEventSources;
+	void SubscribeNativeEvent(EMixerNativeEventCategory Category);
+	void UnsubscribeNativeEvent(EMixerNativeEventCategory Category);
+
+	int32 NativeEventRefCounts[static_cast<int32>(EMixerNativeEventCategory::Count)];
+	FDelegateHandle NativeEventHandles[static_cast<int32>(EMixerNativeEventCategory::Count)];
+	FDelegateHandle CustomControlPropertyUpdateHandle;
+
+	/** Categories acquired by RegisterForMixerEvents, one bit each */
+	uint32 SavedBindingSubscriptions;
+
+	static void OnWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources);
+
+	/** Detach from a world that is going away, keeping bindings, custom control instances and subscriptions, until AdoptPersistentSource. */
+	void Persist(UWorld* World);
+
+	/** Move the held-over source, if any, into World as its event source. */
+	static UMixerInteractivityBlueprintEventSource* AdoptPersistentSource(UWorld* World);
+
+	/** Merge in the bindings and custom controls of a source loaded with a level, keeping those already here. */
+	void AbsorbSource(UMixerInteractivityBlueprintEventSource& Loaded);
+
+	struct FRoutedEventKey;
+
+	/** Find or create the event a plan entry binds to.  Creating one may move others; see WrapperGeneration. */
+	FMixerBlueprintInstanceDelegates& ResolveBindingSlot(const FMixerBindingSlot& Slot);
+	const TArray<FMixerBlueprintInstanceDelegates*>& GetResolvedPlan(const UMixerDelegateBinding* Binding, const TArray<FMixerBindingSlot>& Plan);
+	void SweepBoundInstances();
+
+	/** Bind or unbind one plan entry for Instance in the event routed to ParticipantId. */
+	int32 AddRoutedBinding(const FMixerBindingSlot& Slot, UObject* Instance, uint32 ParticipantId);
+	void RemoveRoutedBinding(const FMixerBindingSlot& Slot, UObject* Instance, int32 SlotIndex, uint32 ParticipantId);
+	void RemoveRoutedEvent(const FRoutedEventKey& Key);
+
+	/** Call the instances routed to Participant for one event, after those bound for everyone. */
+	void ProcessRoutedDelegates(EMixerBindingSlotType Type, FName Name, uint32 ParticipantId, void* Parms) const;
+
+	struct FResolvedPlan
+	{
+		uint32 Generation;
+		TArray<FMixerBlueprintInstanceDelegates*> Events;
+	};
+
+	struct FBoundInstanceKey
+	{
+		TWeakObjectPtr<UObject> Instance;
+		TWeakObjectPtr<const UMixerDelegateBinding> Binding;
+
+		bool operator==(const FBoundInstanceKey& Other) const
+		{
+			return Instance == Other.Instance && Binding == Other.Binding;
+		}
+
+		friend uint32 GetTypeHash(const FBoundInstanceKey& Key)
+		{
+			return HashCombine(GetTypeHash(Key.Instance), GetTypeHash(Key.Binding));
+		}
+	};
+
+	/** Each binding class's plan resolved against the wrapper maps above */
+	TMap<TWeakObjectPtr<const UMixerDelegateBinding>, FResolvedPlan> ResolvedPlans;
+
+	/** Bumped whenever a wrapper is added to or removed from the maps above, which may move the others */
+	uint32 WrapperGeneration;
+
+	struct FBoundInstance
+	{
+		/** Slot taken for each entry of the class's plan, in the routed event for routable entries when routed */
+		TArray<int32> Slots;
+
+		/** 0 when not routed */
+		uint32 RoutedParticipantId;
+	};
+
+	TMap<FBoundInstanceKey, FBoundInstance> BoundInstances;
+	int32 SweepBoundInstancesAt;
+
+	struct FRoutedEventKey
+	{
+		uint32 ParticipantId;
+		EMixerBindingSlotType Type;
+		FName Name;
+
+		bool operator==(const FRoutedEventKey& Other) const
+		{
+			return ParticipantId == Other.ParticipantId && Type == Other.Type && Name == Other.Name;
+		}
+
+		friend uint32 GetTypeHash(const FRoutedEventKey& Key)
+		{
+			return HashCombine(HashCombine(Key.ParticipantId, static_cast<uint32>(Key.Type)), GetTypeHash(Key.Name));
+		}
+	};
+
+	/** Events of instances routed to a single participant.  Entries are removed once empty. */
+	TMap<FRoutedEventKey, FMixerBlueprintInstanceDelegates> RoutedEvents;
+
+	/** One event source per world.  Entries are dropped when their world is cleaned up. */
+	static TMap<TWeakObjectPtr<UWorld>, TWeakObjectPtr<UMixerInteractivityBlueprintEventSource>> BlueprintEventSources;
+	static FDelegateHandle WorldCleanupHandle;
+
+	/** Source of the last game world to be cleaned up, rooted and waiting for the next one.  See bPersistBlueprintEventSource. */
+	static TWeakObjectPtr<UMixerInteractivityBlueprintEventSource> PersistentSource;
 
 };
 
@@ -214,6 +552,10 @@ struct FMixerButtonEventBinding
 
 	UPROPERTY()
 	bool Pressed;
+
+	/** Bind to the once-per-frame batched event rather than the per-press one. */
+	UPROPERTY()
+	bool bBatched = false;
 };
 
 UENUM()
@@ -222,6 +564,8 @@ enum class EMixerGenericEventBindingType : uint8
 	Stick,
 	CustomMethod,
 	TextSubmitted,
+	StickLatestPerParticipant,
+	StickCrowdAverage,
 };
 
 USTRUCT()
@@ -281,7 +625,15 @@ public:
 	virtual void BindDynamicDelegates(UObject* InInstance) const;
 	virtual void UnbindDynamicDelegates(UObject* Instance) const;
 
+	/** See UMixerInteractivityBlueprintEventSource::RouteInstance. */
+	void RouteDynamicDelegates(UObject* InInstance, uint32 ParticipantId) const;
+
 private:
+	/** The bindings below flattened into one list, built on first use since they don't change after compile */
+	const TArray<FMixerBindingSlot>& GetBindingPlan() const;
+
+	mutable TArray<FMixerBindingSlot> BindingPlan;
+	mutable bool bBindingPlanBuilt = false;
 
 	UPROPERTY()
 	TArray<FMixerButtonEventBinding> ButtonEventBindings;
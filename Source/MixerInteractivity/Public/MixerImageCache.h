@@ -0,0 +1,171 @@
+//*********************************************************
+//
+// Copyright (c) Microsoft. All rights reserved.
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT.
+//
+//*********************************************************
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/GCObject.h"
+#include "Interfaces/IHttpRequest.h"
+#include "Interfaces/IHttpResponse.h"
+
+class UTexture2D;
+class IImageWrapperModule;
+struct FChatMessageImageMixer;
+
+/** Where to draw a picture fetched through FMixerImageCache from. */
+struct FMixerImageRegion
+{
+	/** Null if the image couldn't be downloaded or decoded */
+	UTexture2D* Texture;
+
+	/** Normalized texture coordinates of the picture within Texture */
+	FVector2D UVMin;
+	FVector2D UVMax;
+
+	/** Size of the picture in pixels */
+	FIntPoint Size;
+
+	FMixerImageRegion()
+		: Texture(nullptr)
+		, UVMin(0.0f, 0.0f)
+		, UVMax(1.0f, 1.0f)
+		, Size(0, 0)
+	{
+	}
+};
+
+DECLARE_DELEGATE_OneParam(FOnMixerImageLoaded, const FMixerImageRegion& /* Region */);
+
+/**
+* Shared cache of the images that Mixer chat messages refer to, so that every overlay drawing
+* emoticons and images draws them from the same textures instead of downloading its own copies.
+* Concurrent requests for one URL share a single download, decoding happens on a worker thread,
+* and textures are evicted least recently used first once UMixerInteractivitySettings::ImageCacheBudgetMegabytes
+* is exceeded.  With bPackEmoticonsIntoAtlas set, emoticons are copied out of their sprite sheets into
+* shared atlas pages, so a chat view showing many of them binds only a few textures.
+*
+* Textures are referenced by the cache until evicted; hold them in a UPROPERTY (or equivalent)
+* while drawing them across frames.  Game thread only.
+*
+* Owned by the MixerInteractivity module, so it is only available between the module's startup and shutdown.
+*/
+class MIXERINTERACTIVITY_API FMixerImageCache : public FGCObject
+{
+public:
+	static FMixerImageCache& Get();
+	static bool IsAvailable() { return Instance != nullptr; }
+
+	~FMixerImageCache();
+
+	/**
+	* Look up a picture that is already loaded.  Counts as a use for eviction.
+	*
+	* @param	Url				Image to look up.
+	* @param	SourceRect		Pixels of the image making up the picture.  Empty for the whole image.
+	* @return	whether the picture was ready, in which case OutRegion is filled in.
+	*/
+	bool FindImage(const FString& Url, const FIntRect& SourceRect, FMixerImageRegion& OutRegion);
+	bool FindImage(const FChatMessageImageMixer& Image, FMixerImageRegion& OutRegion);
+
+	/**
+	* Fetch a picture, downloading and decoding its image if it isn't cached yet.  OnLoaded is always
+	* called on the game thread, immediately if the picture is ready, and with a null texture on failure.
+	*/
+	void LoadImage(const FString& Url, const FIntRect& SourceRect, const FOnMixerImageLoaded& OnLoaded);
+	void LoadImage(const FChatMessageImageMixer& Image, const FOnMixerImageLoaded& OnLoaded);
+
+	/** Drop an image from the cache, e.g. because its owner has its own limit on how many it keeps.  Atlas sprites packed from it stay. */
+	void RemoveImage(const FString& Url);
+
+	/** Bytes currently held in decoded images, textures and atlas pages */
+	int64 GetMemoryUsed() const { return MemoryUsed; }
+
+	/** Cancel downloads without notifying callers and drop everything cached. */
+	void Reset();
+
+	// FGCObject methods
+	virtual void AddReferencedObjects(FReferenceCollector& Collector) override;
+
+private:
+	struct FWaiter
+	{
+		FIntRect SourceRect;
+		FOnMixerImageLoaded OnLoaded;
+	};
+
+	struct FPendingImage
+	{
+		FHttpRequestPtr Request;
+		TArray<FWaiter> Waiters;
+	};
+
+	struct FCachedImage
+	{
+		// Created on first use, since sheets whose emoticons all go into the atlas never need one
+		UTexture2D* Texture;
+		// BGRA8.  Only kept while emoticons may still be packed from it into the atlas.
+		TArray<uint8> Pixels;
+		FIntPoint Size;
+		uint64 LastUse;
+	};
+
+	struct FAtlasPage
+	{
+		UTexture2D* Texture;
+		TArray<FString> SpriteKeys;
+		int32 ShelfTop;
+		int32 ShelfHeight;
+		int32 ShelfCursor;
+		uint64 LastUse;
+	};
+
+	struct FAtlasSprite
+	{
+		int32 Page;
+		FIntRect Rect;
+	};
+
+	struct FDecodedImage
+	{
+		TArray<uint8> Pixels;
+		FIntPoint Size;
+	};
+
+	void OnDownloadComplete(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, FString Url);
+	void OnDecoded(const FString& Url, FDecodedImage& Decoded);
+	void FailWaiters(const FString& Url);
+	bool ResolveRegion(const FString& Url, const FIntRect& SourceRect, FMixerImageRegion& OutRegion);
+	bool PackSprite(const FString& SpriteKey, const FCachedImage& Image, const FIntRect& SourceRect, FAtlasSprite& OutSprite);
+	bool EvictLeastRecentlyUsed();
+	void EnsureTexture(FCachedImage& Image);
+	void UpdateMemoryUsed(int64 Delta);
+	void TrimToBudget();
+
+	static bool DecodeImage(IImageWrapperModule& ImageWrapperModule, const TArray<uint8>& Compressed, FDecodedImage& OutDecoded);
+	static int64 GetImageBytes(const FCachedImage& Image);
+	static FString GetSpriteKey(const FString& Url, const FIntRect& SourceRect);
+
+private:
+	TMap<FString, FPendingImage> PendingImages;
+	TMap<FString, FCachedImage> CachedImages;
+	TSparseArray<FAtlasPage> AtlasPages;
+	TMap<FString, FAtlasSprite> AtlasSprites;
+	// Page new sprites go onto, or INDEX_NONE
+	int32 OpenAtlasPage;
+	int64 MemoryUsed;
+	uint64 UseCounter;
+	// Bumped by Reset, so that decodes finishing afterwards are dropped
+	uint32 Generation;
+
+	// The one created by the module, or null outside its lifetime
+	static FMixerImageCache* Instance;
+
+	friend class FMixerInteractivityModule;
+	FMixerImageCache();
+};
@@ -0,0 +1,71 @@
+//*********************************************************
+//
+// Copyright (c) Microsoft. All rights reserved.
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT.
+//
+//*********************************************************
+#pragma once
+
+#include "UObject/Interface.h"
+#include "Templates/SharedPointer.h"
+#include "MixerInputHandler.generated.h"
+
+struct FMixerRemoteUser;
+struct FMixerButtonEventDetails;
+struct FMixerTextboxEventDetails;
+class FJsonObject;
+
+/** Kinds of input an IMixerInputHandler wants.  See FMixerInputHandlerFilter. */
+enum class EMixerInputHandlerEvents : uint8
+{
+	None			= 0,
+	Button			= 1 << 0,
+	Stick			= 1 << 1,
+	Textbox			= 1 << 2,
+	CustomControl	= 1 << 3,
+
+	All				= Button | Stick | Textbox | CustomControl,
+};
+ENUM_CLASS_FLAGS(EMixerInputHandlerEvents);
+
+/** Which input reaches a handler registered with IMixerInteractivityModule::RegisterInputHandler. */
+struct FMixerInputHandlerFilter
+{
+	/** Kinds of input to receive */
+	EMixerInputHandlerEvents Events;
+
+	/** Controls to receive input from.  Empty for every control. */
+	TArray<FName> Controls;
+
+	FMixerInputHandlerFilter()
+		: Events(EMixerInputHandlerEvents::All)
+	{
+	}
+};
+
+UINTERFACE(meta=(CannotImplementInterfaceInBlueprint))
+class MIXERINTERACTIVITY_API UMixerInputHandler : public UInterface
+{
+	GENERATED_BODY()
+};
+
+/**
+* Native receiver of interactive input.  Objects implementing this and registered through
+* IMixerInteractivityModule::RegisterInputHandler are called directly, with no dynamic delegate
+* dispatch or function lookup by name.  Calls arrive on the game thread, after rate limiting,
+* with the same arguments as the matching IMixerInteractivityModule events.  Registration is
+* weak: a destroyed handler simply stops receiving input.
+*/
+class MIXERINTERACTIVITY_API IMixerInputHandler
+{
+	GENERATED_BODY()
+
+public:
+	virtual void OnMixerButton(FName Button, TSharedPtr<const FMixerRemoteUser> Participant, const FMixerButtonEventDetails& Details) {}
+	virtual void OnMixerStick(FName Stick, TSharedPtr<const FMixerRemoteUser> Participant, FVector2D Value) {}
+	virtual void OnMixerTextboxSubmit(FName Textbox, TSharedPtr<const FMixerRemoteUser> Participant, const FMixerTextboxEventDetails& Details) {}
+	virtual void OnMixerCustomControlInput(FName Control, FName EventType, TSharedPtr<const FMixerRemoteUser> Participant, const TSharedRef<FJsonObject> EventPayload) {}
+};
@@ -17,6 +17,8 @@
 #include "UObject/TextProperty.h"
 #include "MixerInteractivityBlueprintLibrary.generated.h"
 
+class UTexture2D;
+
 extern MIXERINTERACTIVITY_API const FName MixerObjectKindMetadataTag;
 
 USTRUCT(BlueprintType)
@@ -50,6 +52,10 @@ struct MIXERINTERACTIVITY_API FMixerButtonReference : public FMixerObjectReferen
 {
 public:
 	GENERATED_BODY()
+
+public:
+	/** Filled in on first use so that repeated queries skip the name lookup.  Not serialized. */
+	mutable FMixerControlHandle CachedHandle;
 };
 
 template<>
@@ -84,6 +90,10 @@ struct MIXERINTERACTIVITY_API FMixerStickReference : public FMixerObjectReferenc
 {
 public:
 	GENERATED_BODY()
+
+public:
+	/** Filled in on first use so that repeated queries skip the name lookup.  Not serialized. */
+	mutable FMixerControlHandle CachedHandle;
 };
 
 template<>
@@ -212,6 +222,17 @@ enum class EMixerInteractivityParticipantState : uint8
 	Left,
 };
 
+UENUM(BlueprintType)
+enum class EMixerBandwidthThrottleType : uint8
+{
+	/** All messages from the service (not supported by every backend) */
+	Global,
+	/** Participant input */
+	Input,
+	Participant_Join,
+	Participant_Leave,
+};
+
 
 UCLASS()
 class MIXERINTERACTIVITY_API UMixerInteractivityBlueprintLibrary : public UBlueprintFunctionLibrary
@@ -258,7 +279,20 @@ public:
 	* @param	Cooldown		Duration for which the button should be non-interactive.
 	*/
 	UFUNCTION(BlueprintCallable, Category = "Mixer|Interactivity")
-	static void TriggerButtonCooldown(FMixerButtonReference Button, FTimespan Cooldown);
+	static void TriggerButtonCooldown(const FMixerButtonReference& Button, FTimespan Cooldown);
+
+	/**
+	* Limit the rate at which the Mixer service sends a category of messages to this client.
+	* Messages beyond the limit are dropped by the service.
+	*
+	* @param	ThrottleType	Category of messages to limit.
+	* @param	MaxBytes		Burst size in bytes.
+	* @param	BytesPerSecond	Sustained rate in bytes per second.
+	*
+	* @Return					True if the throttle was applied.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Mixer|Interactivity")
+	static bool SetBandwidthThrottle(EMixerBandwidthThrottleType ThrottleType, int32 MaxBytes, int32 BytesPerSecond);
 
 	/**
 	* Retrieve information about a button that is independent of its current state.
@@ -269,7 +303,7 @@ public:
 	* @param	SparkCost		Number of Sparks a remote user will be charged for pressing this button.
 	*/
 	UFUNCTION(BlueprintPure, Category = "Mixer|Interactivity")
-	static void GetButtonDescription(FMixerButtonReference Button, FText& ButtonText, FText& HelpText, int32& SparkCost);
+	static void GetButtonDescription(const FMixerButtonReference& Button, FText& ButtonText, FText& HelpText, int32& SparkCost);
 
 	/**
 	* Retrieve information about a button that is dependent on remote user and title interactions.
@@ -284,7 +318,7 @@ public:
 	* @param	ParticipantId	If provided, Mixer id of the remote user whose view of button state should be returned.  Otherwise state is aggregated over all participants.
 	*/
 	UFUNCTION(BlueprintPure, Category = "Mixer|Interactivity", Meta=(AdvancedDisplay = "7"))
-	static void GetButtonState(FMixerButtonReference Button, FTimespan& RemainingCooldown, float& Progress, int32& DownCount, int32& PressCount, int32& UpCount, bool& Enabled, int32 ParticipantId = 0);
+	static void GetButtonState(const FMixerButtonReference& Button, FTimespan& RemainingCooldown, float& Progress, int32& DownCount, int32& PressCount, int32& UpCount, bool& Enabled, int32 ParticipantId = 0);
 
 	/**
 	* Retrieve information about a joystick that is independent of its current state.
@@ -305,7 +339,143 @@ public:
 	* @param	ParticipantId	If provided, Mixer id of the remote user whose view of joystick state should be returned.  Otherwise state is aggregated over all participants.
 	*/
 	UFUNCTION(BlueprintPure, Category = "Mixer|Interactivity", Meta = (AdvancedDisplay = "4"))
-	static void GetStickState(FMixerStickReference Stick, float& XAxis, float& YAxis, bool& Enabled, int32 ParticipantId = 0);
+	static void GetStickState(const FMixerStickReference& Stick, float& XAxis, float& YAxis, bool& Enabled, int32 ParticipantId = 0);
+
+	/**
+	* Retrieve crowd statistics for a joystick.  Requires that per-participant state caching is enabled.
+	*
+	* @param	Stick				Reference to the joystick for which statistics should be returned.
+	* @param	ParticipantCount	Number of participants currently deflecting the joystick.
+	* @param	Mean				Mean of the participants' values.
+	* @param	WeightedMean		Mean of the participants' values, each weighted by how far it is from the center.
+	* @param	Variance			Per-axis variance of the participants' values.
+	* @param	QuadrantVotes		Number of participants deflecting toward each quadrant: (+X,+Y), (-X,+Y), (-X,-Y), (+X,-Y).
+	*/
+	UFUNCTION(BlueprintPure, Category = "Mixer|Interactivity")
+	static void GetStickAggregate(const FMixerStickReference& Stick, int32& ParticipantCount, FVector2D& Mean, FVector2D& WeightedMean, FVector2D& Variance, TArray<int32>& QuadrantVotes);
+
+	/**
+	* Start accumulating a decaying heatmap of input on a joystick, or on a custom control whose input carries x and y.
+	*
+	* @param	ControlName		Name of the joystick or custom control.
+	* @param	GridWidth		Number of cells across.
+	* @param	GridHeight		Number of cells down.
+	* @param	BoundsMin		Coordinate mapped to the first cell.  (-1, -1) for joysticks.
+	* @param	BoundsMax		Coordinate mapped to the last cell.  (1, 1) for joysticks.
+	* @param	HalfLife		Seconds for accumulated input to lose half its weight.  0 for no decay.
+	*
+	* @return					True if the heatmap was created.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Mixer|Interactivity")
+	static bool EnableCoordinateHeatmap(FName ControlName, int32 GridWidth, int32 GridHeight, FVector2D BoundsMin, FVector2D BoundsMax, float HalfLife = 2.0f);
+
+	/**
+	* Read the heatmap for a control as row-major cell weights.
+	*
+	* @param	ControlName		Name of the control passed to Enable Coordinate Heatmap.
+	* @param	Cells			GridWidth * GridHeight cell weights, row by row.
+	* @param	GridWidth		Number of cells across.
+	* @param	GridHeight		Number of cells down.
+	*
+	* @return					True if a heatmap is enabled for the control.
+	*/
+	UFUNCTION(BlueprintPure, Category = "Mixer|Interactivity")
+	static bool GetCoordinateHeatmap(FName ControlName, TArray<float>& Cells, int32& GridWidth, int32& GridHeight);
+
+	/**
+	* Start tracking the most active participants on a control, and how many distinct participants used it, over a sliding window.
+	*
+	* @param	ControlName				Name of the control.
+	* @param	WindowSeconds			Seconds of input covered.
+	* @param	TrackedParticipants		Participants counted individually.  Larger is more accurate but uses more memory.
+	*
+	* @return							True if tracking started.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Mixer|Interactivity")
+	static bool EnableInputSketches(FName ControlName, float WindowSeconds = 60.0f, int32 TrackedParticipants = 32);
+
+	/**
+	* Retrieve the participants who sent the most input to a control over the window, most active first.
+	*
+	* @param	ControlName		Name of the control passed to Enable Input Sketches.
+	* @param	MaxCount		Most participants to return.
+	* @param	ParticipantIds	Mixer ids of the participants.
+	* @param	InputCounts		Estimated input events from each participant, never less than the true count.
+	*
+	* @return					True if sketches are enabled for the control.
+	*/
+	UFUNCTION(BlueprintPure, Category = "Mixer|Interactivity")
+	static bool GetMostActiveParticipants(FName ControlName, int32 MaxCount, TArray<int32>& ParticipantIds, TArray<int32>& InputCounts);
+
+	/**
+	* Estimate how many distinct participants sent input to a control over the window.
+	*
+	* @param	ControlName				Name of the control passed to Enable Input Sketches.
+	* @param	DistinctParticipants	Estimated number of participants, typically within 3%.
+	*
+	* @return							True if sketches are enabled for the control.
+	*/
+	UFUNCTION(BlueprintPure, Category = "Mixer|Interactivity")
+	static bool GetDistinctParticipantCount(FName ControlName, int32& DistinctParticipants);
+
+	/**
+	* Start keeping a history of activity on a control for graphs: presses per bucket for buttons, movement energy for joysticks.
+	*
+	* @param	ControlName		Name of the control.
+	* @param	BucketSeconds	Seconds covered by each sample.
+	* @param	HistorySeconds	Seconds of history kept.
+	*
+	* @return					True if the history was created.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Mixer|Interactivity")
+	static bool EnableActivityTimeSeries(FName ControlName, float BucketSeconds = 0.1f, float HistorySeconds = 60.0f);
+
+	/**
+	* Read the activity history for a control, oldest sample first.  The last sample is still filling.
+	*
+	* @param	ControlName		Name of the control passed to Enable Activity Time Series.
+	* @param	Samples			Activity in each bucket.
+	* @param	BucketSeconds	Seconds covered by each sample.
+	*
+	* @return					True if a time series is enabled for the control.
+	*/
+	UFUNCTION(BlueprintPure, Category = "Mixer|Interactivity")
+	static bool GetActivityTimeSeries(FName ControlName, TArray<float>& Samples, float& BucketSeconds);
+
+	/**
+	* Open a crowd vote with one option per button.  Each participant's first press of an option counts; tallying happens natively.
+	*
+	* @param	Options			Button for each option.  A button may be an option in only one open round.
+	* @param	Duration		How long the round stays open.  Zero leaves it open until Close Vote Round.
+	* @param	WeightBySparks	Count each vote as the spark cost of the pressed button rather than 1.
+	*
+	* @return					Id of the new round, or -1 on failure.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Mixer|Interactivity")
+	static int32 StartVoteRound(const TArray<FMixerButtonReference>& Options, FTimespan Duration, bool WeightBySparks = false);
+
+	/**
+	* Close a vote round and read its result.
+	*
+	* @param	RoundId			Id returned by Start Vote Round.
+	* @param	WinningOption	Index of the option with the most votes, or -1 if nobody voted.
+	* @param	Tallies			Votes for each option.
+	*
+	* @return					True if the round was open.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Mixer|Interactivity")
+	static bool CloseVoteRound(int32 RoundId, int32& WinningOption, TArray<int32>& Tallies);
+
+	/**
+	* Read the running tallies of an open vote round.
+	*
+	* @param	RoundId			Id returned by Start Vote Round.
+	* @param	Tallies			Votes so far for each option.
+	*
+	* @return					True if the round is open.
+	*/
+	UFUNCTION(BlueprintPure, Category = "Mixer|Interactivity")
+	static bool GetVoteTallies(int32 RoundId, TArray<int32>& Tallies);
 
 	/**
 	* Change the text that will be displayed to remote users on a label.
@@ -354,6 +524,20 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Mixer|Interactivity")
 	static void SetCurrentScene(FMixerSceneReference Scene, FMixerGroupReference Group);
 
+	/**
+	* Start preparing a change in the interactive scene displayed to remote users.  Control
+	* updates for the scene are held back and sent together with the change on Commit Staged Scene Change.
+	*
+	* @param	Scene			Reference to the new interactive scene to display.
+	* @param	Group			Reference to the user group to which this scene should be displayed.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Mixer|Interactivity")
+	static void BeginStagedSceneChange(FMixerSceneReference Scene, FMixerGroupReference Group);
+
+	/** Send the scene change started by Begin Staged Scene Change, along with its control updates. */
+	UFUNCTION(BlueprintCallable, Category = "Mixer|Interactivity")
+	static void CommitStagedSceneChange();
+
 	/**
 	* Retrieve information describing the local user currently signed in to the Mixer service.
 	*
@@ -400,6 +584,16 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Mixer|Interactivity")
 	static void MoveParticipantToGroup(FMixerGroupReference Group, int32 ParticipantId);
 
+	/**
+	* Move several users to a new group in one go.  Much cheaper than moving them one at a time.
+	* The group must already exist.
+	*
+	* @param	Group			Reference to the group that the given users should be placed in.
+	* @param	ParticipantIds	Ids of the users to be moved into the given group.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Mixer|Interactivity")
+	static void MoveParticipantsToGroup(FMixerGroupReference Group, const TArray<int32>& ParticipantIds);
+
 	/**
 	* Convert a strongly typed reference to a design-time Mixer object to its FName representation.
 	*/
@@ -414,9 +608,52 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Mixer|Interactivity")
 	static void CaptureSparkTransaction(FMixerTransactionId TransactionId);
 
+	/**
+	* Stop or resume delivering Mixer events to the Mixer event nodes of a blueprint instance, e.g. as an actor
+	* is returned to or taken from a pool.  Each costs constant time per event node.
+	*
+	* @param	Instance		Object whose class (or a parent class) is a blueprint with Mixer event nodes.
+	* @param	bBound			Whether the instance's Mixer event nodes should fire.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Mixer|Interactivity")
+	static void SetMixerEventsBound(UObject* Instance, bool bBound);
+
+	/**
+	* Fire a blueprint instance's per-participant Mixer events (button, joystick, textbox and custom control
+	* input, and participant joined, left and input disabled) only for one participant, e.g. for an avatar
+	* representing a single viewer.  Events for other participants never reach the instance, rather than
+	* reaching it to be filtered out.  Other Mixer events are unaffected.
+	*
+	* @param	Instance		Object whose class (or a parent class) is a blueprint with Mixer event nodes.
+	* @param	ParticipantId	Participant whose events the instance receives, or 0 to receive everyone's again.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Mixer|Interactivity")
+	static void RouteMixerEventsToParticipant(UObject* Instance, int32 ParticipantId);
+
+	/**
+	* Get a Mixer user's avatar if it has been loaded, or queue it to be fetched ahead of background
+	* prefetches.  Suits polling from a widget binding; keep a reference to the texture while showing it.
+	*
+	* @param	UserId			Mixer id of the user, as for a participant or chat message sender.
+	* @return	the avatar, or null if it isn't loaded yet or couldn't be fetched.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Mixer")
+	static UTexture2D* GetUserAvatar(int32 UserId);
+
 	UFUNCTION(BlueprintPure, Category = "Mixer|Interactivity", CustomThunk, meta=(BlueprintInternalUseOnly = "true", WorldContext = "WorldContextObject"))
 	static void GetCustomControlProperty_Helper(UObject* WorldContextObject, FMixerCustomControlReference Control, FString PropertyName, int32 &OutProperty);
 
 	DECLARE_FUNCTION(execGetCustomControlProperty_Helper);
 
+	UFUNCTION(BlueprintCallable, Category = "Mixer|Interactivity", meta=(BlueprintInternalUseOnly = "true"))
+	static void BeginCustomMethodCall_Helper();
+
+	UFUNCTION(BlueprintCallable, Category = "Mixer|Interactivity", CustomThunk, meta=(BlueprintInternalUseOnly = "true"))
+	static void WriteCustomMethodParam_Helper(FString ParamName, const int32& Value);
+
+	DECLARE_FUNCTION(execWriteCustomMethodParam_Helper);
+
+	UFUNCTION(BlueprintCallable, Category = "Mixer|Interactivity", meta=(BlueprintInternalUseOnly = "true"))
+	static void FinishCustomMethodCall_Helper(FString MethodName);
+
 };
@@ -36,6 +36,11 @@ public:
 		JSON_SERIALIZE("controlID", Id);
 		JSON_SERIALIZE("kind", Kind);
 	END_JSON_SERIALIZER
+
+	friend FArchive& operator<<(FArchive& Ar, FMixerInteractiveControl& Control)
+	{
+		return Ar << Control.Id << Control.Kind;
+	}
 public:
 	bool operator==(const FMixerInteractiveControl& Rhs) const
 	{
@@ -58,6 +63,11 @@ public:
 		JSON_SERIALIZE("sceneID", Id);
 		JSON_SERIALIZE_ARRAY_SERIALIZABLE("controls", Controls, FMixerInteractiveControl);
 	END_JSON_SERIALIZER
+
+	friend FArchive& operator<<(FArchive& Ar, FMixerInteractiveScene& Scene)
+	{
+		return Ar << Scene.Id << Scene.Controls;
+	}
 public:
 	bool operator==(const FMixerInteractiveScene& Rhs) const
 	{
@@ -78,6 +88,11 @@ public:
 	BEGIN_JSON_SERIALIZER
 		JSON_SERIALIZE_ARRAY_SERIALIZABLE("scenes", Scenes, FMixerInteractiveScene);
 	END_JSON_SERIALIZER
+
+	friend FArchive& operator<<(FArchive& Ar, FMixerInteractiveControlsCollection& Collection)
+	{
+		return Ar << Collection.Scenes;
+	}
 public:
 	bool operator==(const FMixerInteractiveControlsCollection& Rhs) const
 	{
@@ -99,6 +114,12 @@ public:
 
 public:
 	void Serialize(FJsonSerializerBase& Serializer, bool bFlatObject);
+
+	/** Binary form is shallow, like the parent game of a version - Versions is not included. */
+	friend FArchive& operator<<(FArchive& Ar, FMixerInteractiveGame& Game)
+	{
+		return Ar << Game.Name << Game.Description << Game.Id;
+	}
 };
 
 struct MIXERINTERACTIVITY_API FMixerInteractiveGameVersion : public FJsonSerializable
@@ -118,6 +139,11 @@ public:
 		JSON_SERIALIZE_OBJECT_SERIALIZABLE("game", Game);
 	END_JSON_SERIALIZER
 
+	friend FArchive& operator<<(FArchive& Ar, FMixerInteractiveGameVersion& Version)
+	{
+		return Ar << Version.Name << Version.Id << Version.Controls << Version.Game;
+	}
+
 public:
 	// Ignore parent Game - Id should be enough to fully establish identity 
 	bool operator==(const FMixerInteractiveGameVersion& Rhs) const
@@ -11,6 +11,8 @@
 #pragma once
 
 #include "Modules/ModuleManager.h"
+#include "Containers/ArrayView.h"
+#include "Templates/Function.h"
 
 struct FMixerUser;
 struct FMixerLocalUser;
@@ -23,16 +25,36 @@ struct FMixerLabelDescription;
 struct FMixerTextboxDescription;
 struct FMixerButtonEventDetails;
 struct FMixerTextboxEventDetails;
+struct FMixerSessionSnapshot;
+struct FMixerGroupSpec;
+struct FMixerInputEvent;
+struct FMixerGroupInputBatch;
+struct FMixerCoordinateHeatmapSettings;
+struct FMixerInputSketchSettings;
+struct FMixerActivitySeriesSettings;
+struct FMixerVoteRoundSettings;
+struct FMixerVoteRoundResult;
+struct FMixerActiveParticipant;
+struct FMixerInputLatencyStats;
+struct FMixerInputSamplingState;
+struct FMixerInputHandlerFilter;
 class FUniqueNetId;
 class FJsonObject;
 
 enum class EMixerLoginState : uint8;
 enum class EMixerInteractivityParticipantState : uint8;
+enum class EMixerParticipantChange : uint8;
 enum class EMixerInteractivityState : uint8;
+enum class EMixerBandwidthThrottleType : uint8;
+enum class EMixerInputLatencyClass : uint8;
 
 /**
 * Interface for Mixer Interactivity features.
 * Exposes user auth, state control, and remote events for consumption by C++ game code.
+*
+* Unless stated otherwise, functions must be called on the game thread and events are raised there.
+* The exception is ReadSessionSnapshot, which may be called from any thread; the snapshot it reads
+* offers the same button, joystick and participant queries for code such as task graph workers.
 */
 class IMixerInteractivityModule : public IModuleInterface
 {
@@ -94,6 +116,19 @@ public:
 	*/
 	virtual bool LoginWithAuthCode(const FString& AuthCode, TSharedPtr<const FUniqueNetId> UserId = nullptr) = 0;
 
+	/**
+	* Sign a local user into the Mixer service using the Mixer shortcode auth flow, without any web browser.
+	* A short code is requested from the service and reported via OnShortCodeReceived for the title to display;
+	* the user then approves it at https://mixer.com/go.  The service is polled in the background until the code
+	* is approved, denied or expires, with changes reported via the OnLoginStateChanged event.  Call Logout to
+	* cancel while the code is outstanding.  Not supported on all platforms.
+	*
+	* @param	UserId			Network id for the local user whose identity will be used for Mixer login
+	*
+	* @return					True if a login attempt was started; results will be reported via OnLoginStateChanged.
+	*/
+	virtual bool LoginWithShortCode(TSharedPtr<const FUniqueNetId> UserId = nullptr) = 0;
+
 	/**
 	* Sign the current Mixer user, if any, out of the Mixer service
 	*
@@ -135,6 +170,20 @@ public:
 	*/
 	virtual void SetCurrentScene(FName Scene, FName GroupName = NAME_None) = 0;
 
+	/** Called once the service has answered a batched group request.  Error message is empty on success. */
+	DECLARE_DELEGATE_TwoParams(FOnGroupBatchComplete, bool /* bSucceeded */, const FString& /* ErrorMessage */);
+
+	/**
+	* Change the interactive scene shown to several groups with a single request to the service,
+	* rather than one per group as with SetCurrentScene.
+	*
+	* @param	Assignments		Groups to update, and the interactive scene each should now see.
+	* @param	OnComplete		Called once for the whole batch.  Not called if this returns false.
+	*
+	* @Return					True if the request was sent.  False if not connected or Assignments is empty.
+	*/
+	virtual bool SetScenesForGroups(TArrayView<const FMixerGroupSpec> Assignments, const FOnGroupBatchComplete& OnComplete = FOnGroupBatchComplete()) = 0;
+
 	/**
 	* Gets the name of the interactive scene currently displayed to remote users.
 	*
@@ -144,6 +193,24 @@ public:
 	*/
 	virtual FName GetCurrentScene(FName GroupName = NAME_None) = 0;
 
+	/**
+	* Start preparing a scene change.  Control updates for Scene are held back until
+	* CommitStagedSceneChange, then sent in the same flush as the scene change itself, so that
+	* remote users see the new scene already in its intended state.  Beginning a new staged change
+	* commits any outstanding one.
+	*
+	* @param	Scene			Name of the new interactive scene to display.
+	* @param	GroupName		Name of the group to whom the new scene should be shown.  Default group if empty.
+	*/
+	virtual void BeginStagedSceneChange(FName Scene, FName GroupName = NAME_None) = 0;
+
+	/**
+	* Send the scene change started by BeginStagedSceneChange along with the control updates made
+	* since.  Local state (the group's current scene, cached control properties) reflects the change
+	* immediately rather than once the service confirms it.
+	*/
+	virtual void CommitStagedSceneChange() = 0;
+
 	/**
 	* Request that the named button enter a cooldown state for the specified period.  While cooling down
 	* the button will be non-interactive.
@@ -189,6 +256,22 @@ public:
 	*/
 	virtual bool GetButtonState(FName Button, uint32 ParticipantId, FMixerButtonState& OutState) = 0;
 
+	/**
+	* Retrieve information about a named button that is dependent on remote user and title interactions.
+	* See FMixerButtonState for details.
+	* This overload reports the state of the button over the members of one group: PressCount is the number
+	* of members holding it.  DownCount and UpCount aren't kept per group and read 0.  Maintained as input
+	* arrives and participants change groups, so querying is constant time regardless of group size.
+	* Requires that per-participant state caching is enabled.
+	*
+	* @param	Button			Name of the button for which information should be returned.
+	* @param	GroupName		Group whose members' view of the button should be returned.
+	* @param	OutState		Out parameter filled in with information about the button upon success.
+	*
+	* @Return					True if button was found and OutState is valid.  An unknown or empty group counts as no one holding it.
+	*/
+	virtual bool GetButtonState(FName Button, FName GroupName, FMixerButtonState& OutState) = 0;
+
 	/**
 	* Retrieve information about a named joystick that is independent of its current state.
 	* See FMixerStickDescription for details.
@@ -225,6 +308,212 @@ public:
 	*/
 	virtual bool GetStickState(FName Stick, uint32 ParticipantId, FMixerStickState& OutState) = 0;
 
+	/**
+	* Resolve a named button to a handle for repeated queries without a name lookup.
+	* If InOutHandle already refers to this button in the current session it is left untouched,
+	* so callers can cache the handle and pass it back in each time.
+	*
+	* @param	Button			Name of the button to resolve.
+	* @param	InOutHandle		Previously cached handle, updated if it was stale.
+	*
+	* @Return					True if the button was found and InOutHandle is valid.  False if not found or the backend doesn't support handles.
+	*/
+	virtual bool ResolveButton(FName Button, FMixerControlHandle& InOutHandle) = 0;
+
+	/**
+	* Resolve a named joystick to a handle for repeated queries without a name lookup.  See ResolveButton.
+	*
+	* @param	Stick			Name of the joystick to resolve.
+	* @param	InOutHandle		Previously cached handle, updated if it was stale.
+	*
+	* @Return					True if the joystick was found and InOutHandle is valid.
+	*/
+	virtual bool ResolveStick(FName Stick, FMixerControlHandle& InOutHandle) = 0;
+
+	/** As the FName overloads above, but for a handle obtained from ResolveButton.  Fail if the handle is stale. */
+	virtual void TriggerButtonCooldown(FMixerControlHandle Button, FTimespan CooldownTime) = 0;
+	virtual bool GetButtonDescription(FMixerControlHandle Button, FMixerButtonDescription& OutDesc) = 0;
+	virtual bool GetButtonState(FMixerControlHandle Button, FMixerButtonState& OutState) = 0;
+	virtual bool GetButtonState(FMixerControlHandle Button, uint32 ParticipantId, FMixerButtonState& OutState) = 0;
+	virtual bool GetButtonState(FMixerControlHandle Button, FName GroupName, FMixerButtonState& OutState) = 0;
+
+	/** As the FName overloads above, but for a handle obtained from ResolveStick.  Fail if the handle is stale. */
+	virtual bool GetStickState(FMixerControlHandle Stick, FMixerStickState& OutState) = 0;
+	virtual bool GetStickState(FMixerControlHandle Stick, uint32 ParticipantId, FMixerStickState& OutState) = 0;
+
+	/**
+	* Enable or disable several buttons at once.  Cheaper than per-button updates for scene-wide changes,
+	* since the property value is built once and the changes go out as one updateControls per scene.
+	*
+	* @param	Buttons			Handles obtained from ResolveButton.  Stale handles are skipped.
+	* @param	bEnabled		Whether the buttons should accept input.
+	*/
+	virtual void SetControlsEnabled(TArrayView<const FMixerControlHandle> Buttons, bool bEnabled) = 0;
+
+	/**
+	* Put every button in a scene on cooldown for the same period, e.g. after a global event.
+	*
+	* @param	Scene			Scene whose buttons should be on cooldown.  Default scene if empty.
+	* @param	CooldownTime	Duration for which the buttons should be non-interactive.
+	*/
+	virtual void TriggerCooldownForScene(FName Scene, FTimespan CooldownTime) = 0;
+
+	/**
+	* Set the progress shown on several buttons at once.  As SetControlsEnabled, the changes go out
+	* as one updateControls per scene.
+	*
+	* @param	Progress		Button handles obtained from ResolveButton, each with a progress value between 0 and 1.
+	*/
+	virtual void SetProgressForControls(TArrayView<const TPair<FMixerControlHandle, float>> Progress) = 0;
+
+	/**
+	* Retrieve crowd statistics for a named joystick, such as the mean direction and per-quadrant votes.
+	* These are maintained as input arrives, so querying is constant time regardless of audience size.
+	* Requires that per-participant state caching is enabled.
+	*
+	* @param	Stick			Name of the joystick for which statistics should be returned.
+	* @param	OutAggregate	Out parameter filled in with the statistics upon success.
+	*
+	* @Return					True if joystick was found and OutAggregate is valid.
+	*/
+	virtual bool GetStickAggregate(FName Stick, FMixerStickAggregate& OutAggregate) = 0;
+	virtual bool GetStickAggregate(FMixerControlHandle Stick, FMixerStickAggregate& OutAggregate) = 0;
+
+	/**
+	* As above, but over the members of one group only, e.g. for a team's steering.  Kept up to date as
+	* participants change groups as well as when input arrives.
+	*
+	* @param	Stick			Name of the joystick for which statistics should be returned.
+	* @param	GroupName		Group whose members' values should be included.
+	* @param	OutAggregate	Out parameter filled in with the statistics upon success.
+	*
+	* @Return					True if joystick was found and OutAggregate is valid.  An unknown or empty group reports no participants.
+	*/
+	virtual bool GetStickAggregate(FName Stick, FName GroupName, FMixerStickAggregate& OutAggregate) = 0;
+	virtual bool GetStickAggregate(FMixerControlHandle Stick, FName GroupName, FMixerStickAggregate& OutAggregate) = 0;
+
+	/**
+	* Start accumulating a decaying heatmap of coordinate input on a control: joystick moves, or custom
+	* control input carrying numeric x and y fields (e.g. clicks on a map).  Each input adds 1 to its cell.
+	* Calling again for the same control replaces the heatmap.
+	*
+	* @param	ControlId		Name of the joystick or custom control.
+	* @param	Settings		Grid size, coordinate range and decay rate.
+	*
+	* @Return					True if the heatmap was created.  False if the settings are invalid or the backend doesn't support heatmaps.
+	*/
+	virtual bool EnableCoordinateHeatmap(FName ControlId, const FMixerCoordinateHeatmapSettings& Settings) = 0;
+
+	/** Stop accumulating the heatmap for a control and free it. */
+	virtual void DisableCoordinateHeatmap(FName ControlId) = 0;
+
+	/**
+	* Read the current heatmap for a control, as Width * Height row-major floats suitable for uploading
+	* to a float texture.  The view is only valid until the next tick or change to heatmap configuration.
+	*
+	* @param	ControlId		Name of the control passed to EnableCoordinateHeatmap.
+	* @param	OutCells		Out parameter pointed at the cells upon success.
+	* @param	OutWidth		Out parameter set to the number of cells across.
+	* @param	OutHeight		Out parameter set to the number of cells down.
+	*
+	* @Return					True if a heatmap is enabled for the control.
+	*/
+	virtual bool GetCoordinateHeatmap(FName ControlId, TArrayView<const float>& OutCells, int32& OutWidth, int32& OutHeight) = 0;
+
+	/**
+	* Start tracking who is using a control over a sliding window: the most active participants, and how many
+	* distinct participants sent input.  Both are estimated in memory fixed by the settings, however large the
+	* audience.  Every press, move, submit or custom input from a participant counts once; releases don't.
+	* Calling again for the same control restarts tracking with the new settings.
+	*
+	* @param	ControlId		Name of the control.
+	* @param	Settings		Window length and sketch sizes.
+	*
+	* @Return					True if tracking started.  False if the settings are invalid or the backend doesn't support sketches.
+	*/
+	virtual bool EnableInputSketches(FName ControlId, const FMixerInputSketchSettings& Settings) = 0;
+
+	/** Stop tracking participant activity on a control and free its sketches. */
+	virtual void DisableInputSketches(FName ControlId) = 0;
+
+	/**
+	* Retrieve the participants who sent the most input to a control over the window, most active first.
+	* A participant sending more than 1 / TrackedParticipants of the control's input is never missed.
+	*
+	* @param	ControlId		Name of the control passed to EnableInputSketches.
+	* @param	MaxCount		Most participants to return.
+	* @param	OutParticipants	Out parameter filled in with the participants and their estimated input counts.
+	*
+	* @Return					True if sketches are enabled for the control.
+	*/
+	virtual bool GetMostActiveParticipants(FName ControlId, int32 MaxCount, TArray<FMixerActiveParticipant>& OutParticipants) = 0;
+
+	/**
+	* Estimate how many distinct participants sent input to a control over the window.
+	*
+	* @param	ControlId		Name of the control passed to EnableInputSketches.
+	* @param	OutCount		Out parameter set to the estimate.  See FMixerInputSketchSettings::DistinctPrecision for its accuracy.
+	*
+	* @Return					True if sketches are enabled for the control.
+	*/
+	virtual bool GetDistinctParticipantCount(FName ControlId, int32& OutCount) = 0;
+
+	/**
+	* Start keeping a history of activity on a control in fixed time buckets, for graphs.  Each bucket holds the
+	* number of presses on a button, submits on a textbox or input events on a custom control, or for a joystick
+	* the movement energy: the sum of each move's squared deflection.  Calling again replaces the history.
+	*
+	* @param	ControlId		Name of the control.
+	* @param	Settings		Bucket length and count.
+	*
+	* @Return					True if the history was created.  False if the settings are invalid or the backend doesn't support it.
+	*/
+	virtual bool EnableActivityTimeSeries(FName ControlId, const FMixerActivitySeriesSettings& Settings) = 0;
+
+	/** Stop keeping activity history for a control and free it. */
+	virtual void DisableActivityTimeSeries(FName ControlId) = 0;
+
+	/**
+	* Read the activity history for a control, oldest bucket first.  The last bucket is the one still filling.
+	* The view is only valid until the next tick or change to time series configuration.
+	*
+	* @param	ControlId		Name of the control passed to EnableActivityTimeSeries.
+	* @param	OutSamples		Out parameter pointed at NumBuckets samples upon success.
+	* @param	OutBucketSeconds	Out parameter set to the length of each bucket.
+	*
+	* @Return					True if a time series is enabled for the control.
+	*/
+	virtual bool GetActivityTimeSeries(FName ControlId, TArrayView<const float>& OutSamples, float& OutBucketSeconds) = 0;
+
+	/**
+	* Open a crowd vote with one option per button.  The first press of any option's button by each participant
+	* counts as their vote; later presses in the same round are ignored.  Tallying happens natively as input is
+	* handled, so nothing runs per vote on the game side.  A button may be an option in only one open round.
+	*
+	* @param	Settings		Option buttons, duration and weighting.
+	*
+	* @Return					Id of the new round, or INDEX_NONE if the settings are invalid or the backend doesn't support votes.
+	*/
+	virtual int32 StartVoteRound(const FMixerVoteRoundSettings& Settings) = 0;
+
+	/**
+	* Close a vote round early.  OnVoteRoundClosed fires as it would have at the end of the round's duration.
+	*
+	* @param	RoundId			Id returned by StartVoteRound.
+	* @param	OutResult		Out parameter filled in with the final tallies upon success.
+	*
+	* @Return					True if the round was open.
+	*/
+	virtual bool CloseVoteRound(int32 RoundId, FMixerVoteRoundResult& OutResult) = 0;
+
+	/**
+	* Read the running tallies of an open round, in the order of FMixerVoteRoundSettings::OptionButtons.
+	* The view is only valid until the next input is handled or the round closes.
+	*
+	* @Return					True if the round is open.
+	*/
+	virtual bool GetVoteTallies(int32 RoundId, TArrayView<const int32>& OutTallies) = 0;
+
 	/**
 	* Change the text that will be displayed to remote users on the named label.
 	*
@@ -294,6 +583,38 @@ public:
 	*/
 	virtual TSharedPtr<const FMixerLocalUser> GetCurrentUser() = 0;
 
+	/**
+	* Retrieve how long each phase of the most recent login took, e.g. to track time to interactive.
+	*
+	* @param	OutTimings		Receives the phase timings.
+	*
+	* @Return					False if no login has been attempted.
+	*/
+	virtual bool GetStartupTimings(FMixerStartupTimings& OutTimings) = 0;
+
+	/**
+	* Retrieve how stale input of a given kind has been by the time gameplay sees it, since the session
+	* started or the last call to ResetInputLatency.
+	*
+	* @param	LatencyClass	Kind of control the input was for.
+	* @param	OutStats		Receives the latency distribution.
+	*
+	* @Return					False if no input of this kind has been measured.
+	*/
+	virtual bool GetInputLatency(EMixerInputLatencyClass LatencyClass, FMixerInputLatencyStats& OutStats) = 0;
+
+	/** Discard latency samples gathered so far, e.g. before measuring a change to the pump budget. */
+	virtual void ResetInputLatency() = 0;
+
+	/**
+	* Retrieve how heavily input is currently being sampled, to scale counts read from control state.
+	*
+	* @param	OutState		Receives the sampling stride and arrival rate.
+	*
+	* @Return					False if the backend doesn't support sampling.
+	*/
+	virtual bool GetInputSamplingState(FMixerInputSamplingState& OutState) = 0;
+
 	/**
 	* Retrieve a structure describing a remote user currently interacting with the title on the Mixer service.
 	*
@@ -313,6 +634,18 @@ public:
 	*/
 	virtual bool CreateGroup(FName GroupName, FName InitialScene) = 0;
 
+	/**
+	* Create several user groups with a single request to the service, which is much cheaper than one
+	* CreateGroup call per group when setting up many teams at once.  The default group always exists
+	* and is skipped.
+	*
+	* @param	Groups			Groups to create, and the interactive scene each should initially see.
+	* @param	OnComplete		Called once for the whole batch.  Not called if this returns false.
+	*
+	* @Return					True if the request was sent.  False if not connected or there were no groups to create.
+	*/
+	virtual bool CreateGroups(TArrayView<const FMixerGroupSpec> Groups, const FOnGroupBatchComplete& OnComplete = FOnGroupBatchComplete()) = 0;
+
 	/**
 	* Retrieve the collection of participants that belong to the named group.
 	*
@@ -323,6 +656,76 @@ public:
 	*/
 	virtual bool GetParticipantsInGroup(FName GroupName, TArray<TSharedPtr<const FMixerRemoteUser>>& OutParticipants) = 0;
 
+	/**
+	* Non-allocating variant of GetParticipantsInGroup for rosters that are polled frequently.
+	* The view is invalidated by any change to the participant cache, so it should not be held
+	* beyond the current frame.
+	*
+	* @param	GroupName		Name of the group for which to retrieve participants.
+	*
+	* @Return					Members of the named group.  Empty if the group has no cached members or the backend doesn't support views.
+	*/
+	virtual TArrayView<const TSharedPtr<const FMixerRemoteUser>> ViewParticipantsInGroup(FName GroupName) = 0;
+
+	/**
+	* Retrieve one page of the named group's members in order of the given field, e.g. for leaderboards
+	* or lists of recent viewers.  The ordering is kept up to date as participants come, go and change,
+	* starting from the first request for that group and field, so paging through a large audience
+	* doesn't sort it on every refresh.  Participants with equal values are ordered by id.
+	*
+	* @param	GroupName		Name of the group for which to retrieve participants.
+	* @param	SortKey			Field by which the members are ordered.
+	* @param	Offset			Number of members to skip from the start of the order.
+	* @param	Count			Maximum number of members to retrieve.
+	* @param	OutParticipants	Out parameter to which the page of members is appended.
+	* @param	bDescending		Whether the order starts from the highest value (highest level, most recent connection or input).
+	*
+	* @Return					Total number of members in the group, for paging.  0 if the group has no cached members or the backend doesn't support ordering.
+	*/
+	virtual int32 GetParticipantsPage(FName GroupName, EMixerParticipantSortKey SortKey, int32 Offset, int32 Count, TArray<TSharedPtr<const FMixerRemoteUser>>& OutParticipants, bool bDescending = true) = 0;
+
+	/**
+	* Read the most recently published session snapshot.  May be called from any thread, and never
+	* blocks or is blocked by the game thread.  Snapshots are only published when enabled in the
+	* Mixer Interactivity settings (Publish session snapshots).  Readers should finish with the module
+	* before it shuts down.
+	*
+	* @param	Reader			Called with the snapshot, which must not be referenced after it returns.
+	*
+	* @Return					False if no snapshot has been published (Reader is not called).
+	*/
+	virtual bool ReadSessionSnapshot(TFunctionRef<void(const FMixerSessionSnapshot&)> Reader) = 0;
+
+	/**
+	* Open a cursor on the input journal: a ring of the most recent button, joystick and textbox input,
+	* for consumers that read at their own pace or start late (such as analytics, or highlight capture
+	* that wants the last few seconds).  Each consumer keeps its own cursor, and reading through one
+	* doesn't affect any other.  The journal is only kept when Input journal capacity is set in the
+	* Mixer Interactivity settings, and only holds input from the current session.  May be called from any thread.
+	*
+	* @param	RewindSeconds	Start with input from this long ago, as far back as the journal reaches, rather than with the next to arrive.
+	*
+	* @Return					The cursor.  Reading from it finds nothing if no journal is kept.
+	*/
+	virtual FMixerInputJournalCursor OpenInputJournalCursor(float RewindSeconds = 0.0f) = 0;
+
+	/**
+	* Copy input from the journal, oldest first, and move the cursor past it.  May be called from any
+	* thread, and never blocks or is blocked by the game thread.  Input is added once per Mixer tick, in
+	* the order of OnInputBatch.  Spark costs are kept, but transaction ids and submitted text are not
+	* (their string indices are INDEX_NONE), so use the individual events for those.  The journal never
+	* waits for slow readers: a cursor that falls more than the capacity behind skips the input that was
+	* overwritten and counts it in MissedEvents.  When a new session starts, cursors skip ahead to it without
+	* counting the earlier session's unread input as missed.  Readers should finish with the module before it shuts down.
+	*
+	* @param	Cursor			Read position, as opened by OpenInputJournalCursor.
+	* @param	OutEvents		Out parameter to which the input is appended.
+	* @param	MaxEvents		Limit on the number of events to read in this call.
+	*
+	* @Return					Number of events appended to OutEvents.
+	*/
+	virtual int32 ReadInputJournal(FMixerInputJournalCursor& Cursor, TArray<FMixerInputEvent>& OutEvents, int32 MaxEvents = MAX_int32) = 0;
+
 	/**
 	* Move a single participant to the named group.
 	*
@@ -333,17 +736,81 @@ public:
 	*/
 	virtual bool MoveParticipantToGroup(FName GroupName, uint32 ParticipantId) = 0;
 
+	/**
+	* Move several participants to the named group.  The moves are sent in as few messages as the
+	* service's frame size allows, which is much cheaper than one call per participant for large groups.
+	*
+	* @param	GroupName		Name of the group to which the participants should be moved.
+	* @param	ParticipantIds	Ids of the users to be moved.  Ids not currently in the session are skipped.
+	*
+	* @Return					True if the moves were sent.  False otherwise.
+	*/
+	virtual bool MoveParticipantsToGroup(FName GroupName, TArrayView<const uint32> ParticipantIds) = 0;
+
 	/**
 	* Captures a given interactive event transaction, charging the sparks to the appropriate remote participant. 
+	* Captures are queued and sent together on the next tick; capturing a transaction that is already queued
+	* or awaiting a result does nothing.  The result is reported through OnSparkTransactionComplete.
 	*
 	* @param	TransactionId	Id of the transaction for which sparks should be charged (obtained from event)
 	*/
 	virtual void CaptureSparkTransaction(const FString& TransactionId) = 0;
 
+	/**
+	* Limit the rate at which the Mixer service sends a category of messages to this client.
+	* Messages beyond the limit are dropped by the service.  Replaces any configured throttle
+	* of the same type for the remainder of the session.
+	*
+	* @param	ThrottleType	Category of messages to limit.
+	* @param	MaxBytes		Burst size in bytes.
+	* @param	BytesPerSecond	Sustained rate in bytes per second.
+	*
+	* @Return					True if the throttle was applied.  False if there is no session or the backend doesn't support this type.
+	*/
+	virtual bool SetBandwidthThrottle(EMixerBandwidthThrottleType ThrottleType, uint32 MaxBytes, uint32 BytesPerSecond) = 0;
+
 	virtual void UpdateRemoteControl(FName SceneName, FName ControlName, TSharedRef<FJsonObject> PropertiesToUpdate) = 0;
 
+	/**
+	* Versions of UpdateRemoteControl, SetLabelText and TriggerButtonCooldown that may be called from any
+	* thread.  Submissions go into a lock-free queue that the game thread drains at the start of its next
+	* control update flush, after which they merge and send exactly as if made there, in submission order
+	* per calling thread.  The flush only runs while the module is ticking, i.e. while interactivity is in use.
+	*
+	* PropertiesToUpdate is handed over to the game thread: the caller must not keep any reference to it
+	* (or to values inside it), since Json objects aren't reference counted thread safely.
+	*/
+	virtual void SubmitRemoteControlUpdate(FName SceneName, FName ControlName, TSharedRef<FJsonObject> PropertiesToUpdate) = 0;
+	virtual void SubmitLabelText(FName Label, const FText& DisplayText) = 0;
+	virtual void SubmitButtonCooldown(FName Button, FTimespan CooldownTime) = 0;
+
 	virtual void CallRemoteMethod(const FString& MethodName, const TSharedRef<FJsonObject> MethodParams) = 0;
 
+	/**
+	* As CallRemoteMethod, but with the params object already serialized, so that callers that can write
+	* Json directly (such as Call Custom Method Blueprint nodes) needn't build an FJsonObject first.
+	* The text is copied into the outgoing message as-is, so it must be a valid Json object.
+	*
+	* @param	MethodName		Name of the interactive protocol method.
+	* @param	Utf8Params		Params object for the method, as UTF-8 Json text.
+	*/
+	virtual void CallRemoteMethodSerialized(const FString& MethodName, TArrayView<const uint8> Utf8Params) = 0;
+
+	DECLARE_DELEGATE_ThreeParams(FOnRemoteMethodReply, bool /* bSucceeded */, TSharedPtr<FJsonObject> /* Result */, const FString& /* ErrorMessage */);
+
+	/**
+	* As CallRemoteMethod, but OnReply is called on the game thread once the service replies.  Nothing
+	* blocks waiting for the round trip.  OnReply also fires, with bSucceeded false, if no reply arrives
+	* within 30 seconds or the interactive session ends first.
+	*
+	* @param	MethodName		Name of the interactive protocol method.
+	* @param	MethodParams	Params object for the method.
+	* @param	OnReply			Receives the reply's result object, which may be null for methods that reply without one.
+	*
+	* @Return					True if the method was sent.  OnReply is never called when this returns false.
+	*/
+	virtual bool CallRemoteMethodAsync(const FString& MethodName, const TSharedRef<FJsonObject> MethodParams, const FOnRemoteMethodReply& OnReply) = 0;
+
 	/**
 	* Get access to Mixer chat via UE's standard IOnlineChat interface.
 	* Sending messages requires a logged in user.
@@ -361,6 +828,21 @@ public:
 	*/
 	virtual TSharedPtr<class IOnlineChatMixer> GetExtendedChatInterface() = 0;
 
+	/**
+	* Deliver input straight to a native object implementing IMixerInputHandler, without a delegate per
+	* control.  Handlers are held weakly and skipped once destroyed.  Registering an object again replaces
+	* its filter.
+	*
+	* @param	Handler			Object implementing IMixerInputHandler.
+	* @param	Filter			Which kinds of input, and optionally which controls, the handler receives.
+	*/
+	virtual void RegisterInputHandler(UObject* Handler, const FMixerInputHandlerFilter& Filter) = 0;
+
+	/**
+	* Stop delivering input to a handler added with RegisterInputHandler.  Safe to call from within a handler.
+	*/
+	virtual void UnregisterInputHandler(UObject* Handler) = 0;
+
 	// Events
 	DECLARE_EVENT_OneParam(IMixerInteractivityModule, FOnLoginStateChanged, EMixerLoginState);
 	virtual FOnLoginStateChanged& OnLoginStateChanged() = 0;
@@ -371,6 +853,31 @@ public:
 	DECLARE_EVENT_TwoParams(IMixerInteractivityModule, FOnParticipantStateChangedEvent, TSharedPtr<const FMixerRemoteUser>, EMixerInteractivityParticipantState);
 	virtual FOnParticipantStateChangedEvent& OnParticipantStateChanged() = 0;
 
+	/**
+	* Fired once per service message for all participants whose state changed in it (e.g. the
+	* hundreds of joins that arrive when a popular stream goes interactive), after the
+	* individual OnParticipantStateChanged events.  Cheaper to consume for large audiences.
+	*/
+	DECLARE_EVENT_TwoParams(IMixerInteractivityModule, FOnParticipantsChangedEvent, TArrayView<const TSharedPtr<const FMixerRemoteUser>>, EMixerInteractivityParticipantState);
+	virtual FOnParticipantsChangedEvent& OnParticipantsChanged() = 0;
+
+	/**
+	* Fired when an update for a known participant changes one of their details as listed in
+	* EMixerParticipantChange.  The service sends an update with a new last input time whenever a
+	* participant gives input, so prefer this to OnParticipantStateChanged for tracking names, levels
+	* and groups.  Not supported by the interactive-cpp v1 backend.
+	*/
+	DECLARE_EVENT_TwoParams(IMixerInteractivityModule, FOnParticipantUpdatedEvent, TSharedPtr<const FMixerRemoteUser>, EMixerParticipantChange);
+	virtual FOnParticipantUpdatedEvent& OnParticipantUpdated() = 0;
+
+	/**
+	* Fired once for each batch of participants whose FMixerRemoteUser::ChannelRelationship has just been
+	* looked up, rather than once per participant.  Those who left before the answer came back are left
+	* out.  Requires UMixerInteractivitySettings::bEnrichParticipants.  Not supported by the interactive-cpp v1 backend.
+	*/
+	DECLARE_EVENT_OneParam(IMixerInteractivityModule, FOnParticipantsEnrichedEvent, TArrayView<const TSharedPtr<const FMixerRemoteUser>>);
+	virtual FOnParticipantsEnrichedEvent& OnParticipantsEnriched() = 0;
+
 	DECLARE_EVENT_ThreeParams(IMixerInteractivityModule, FOnButtonEvent, FName, TSharedPtr<const FMixerRemoteUser>, const FMixerButtonEventDetails&);
 	virtual FOnButtonEvent& OnButtonEvent() = 0;
 
@@ -380,6 +887,44 @@ public:
 	DECLARE_EVENT_ThreeParams(IMixerInteractivityModule, FOnTextboxSubmitEvent, FName, TSharedPtr<const FMixerRemoteUser>, const FMixerTextboxEventDetails&);
 	virtual FOnTextboxSubmitEvent& OnTextboxSubmitEvent() = 0;
 
+	/**
+	* As the events above, but fired only for input on one control, so that subscribers watching a few
+	* controls don't pay for everyone else's input.  Fired straight after the corresponding global event.
+	* Subscriptions are by name and carry over between sessions.  A stale handle, or one from a backend
+	* without handles, finds no control and returns null.  Add to the returned event right away rather
+	* than holding on to the reference, and unbind with UnbindControlEvent, which releases the event
+	* along with its last binding.
+	*/
+	virtual FOnButtonEvent& OnButtonEvent(FName Button) = 0;
+	virtual FOnButtonEvent* OnButtonEvent(FMixerControlHandle Button) = 0;
+	virtual FOnStickEvent& OnStickEvent(FName Stick) = 0;
+	virtual FOnStickEvent* OnStickEvent(FMixerControlHandle Stick) = 0;
+	virtual FOnTextboxSubmitEvent& OnTextboxSubmitEvent(FName Textbox) = 0;
+
+	/**
+	* Remove a binding made through one of the per-control events above.
+	* @return	false if no per-control event for the control holds the binding.
+	*/
+	virtual bool UnbindControlEvent(FName ControlId, FDelegateHandle Handle) = 0;
+
+	/**
+	* Fired once per tick with all button, joystick and textbox input delivered through the individual
+	* events above during it, in the same order.  Spark costs, transaction ids and submitted text are
+	* carried as indices into the string view, which (like the events) is only valid during the broadcast.
+	* Nothing is recorded while this event has no listeners.  Not supported by the interactive-cpp v1 backend.
+	*/
+	DECLARE_EVENT_TwoParams(IMixerInteractivityModule, FOnInputBatch, TArrayView<const FMixerInputEvent>, TArrayView<const FString>);
+	virtual FOnInputBatch& OnInputBatch() = 0;
+
+	/**
+	* Fired once per tick, before OnInputBatch, with the same input split by participant group and totalled
+	* per control for each group, e.g. for team modes that score each side separately.  Suits multi-team
+	* games best since groups are summarized in parallel.  Views are only valid during the broadcast.
+	* Nothing is recorded while this event has no listeners.  Not supported by the interactive-cpp v1 backend.
+	*/
+	DECLARE_EVENT_TwoParams(IMixerInteractivityModule, FOnGroupInputBatch, TArrayView<const FMixerGroupInputBatch>, TArrayView<const FString>);
+	virtual FOnGroupInputBatch& OnGroupInputBatch() = 0;
+
 	DECLARE_EVENT_OneParam(IMixerInteractivityModule, FOnBroadcastingStateChanged, bool);
 	virtual FOnBroadcastingStateChanged& OnBroadcastingStateChanged() = 0;
 
@@ -391,4 +936,34 @@ public:
 
 	DECLARE_EVENT_TwoParams(IMixerInteractivityModule, FOnCustomMethodCall, FName, const TSharedPtr<FJsonObject>);
 	virtual FOnCustomMethodCall& OnCustomMethodCall() = 0;
+
+	/**
+	* Fired once per call to CaptureSparkTransaction with the transaction id, whether the sparks were
+	* charged, and the service's error message if not.  Lets the game spend sparks optimistically and
+	* roll back on failure.
+	*/
+	DECLARE_EVENT_ThreeParams(IMixerInteractivityModule, FOnSparkTransactionComplete, const FString&, bool, const FString&);
+	virtual FOnSparkTransactionComplete& OnSparkTransactionComplete() = 0;
+
+	/**
+	* Fired during LoginWithShortCode with the code the user should enter at https://mixer.com/go,
+	* and how long it remains valid.
+	*/
+	DECLARE_EVENT_TwoParams(IMixerInteractivityModule, FOnShortCodeReceived, const FString&, FTimespan);
+	virtual FOnShortCodeReceived& OnShortCodeReceived() = 0;
+
+	/**
+	* Fired when adaptive per-participant state caching (see UMixerInteractivitySettings) switches
+	* tracking mode as the audience grows or shrinks.  True when per-participant button, joystick and
+	* aggregate stick queries are available again; false when they have been suspended.
+	*/
+	DECLARE_EVENT_OneParam(IMixerInteractivityModule, FOnPerParticipantStateCachingChanged, bool);
+	virtual FOnPerParticipantStateCachingChanged& OnPerParticipantStateCachingChanged() = 0;
+
+	/**
+	* Fired once when a vote round (see StartVoteRound) closes: when its duration runs out, when
+	* CloseVoteRound is called, or when the interactive session ends.
+	*/
+	DECLARE_EVENT_OneParam(IMixerInteractivityModule, FOnVoteRoundClosed, const FMixerVoteRoundResult&);
+	virtual FOnVoteRoundClosed& OnVoteRoundClosed() = 0;
 };
\ No newline at end of file
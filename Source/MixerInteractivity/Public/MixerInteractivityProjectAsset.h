@@ -24,6 +24,24 @@ class MIXERINTERACTIVITY_API UMixerProjectAsset : public UDataAsset
 
 public:
 	virtual void PostLoad() override;
+	virtual void Serialize(FArchive& Ar) override;
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+	/** Ids of the controls of the given kind (see FMixerInteractiveControl), in definition order. */
+	const TArray<FString>& GetControlsOfKind(const FString& Kind) const;
+
+	/**
+	* Identifies the order of the buttons and joysticks returned by GetControlsOfKind.  Generated control
+	* handles carry this as their generation, so they stop resolving as soon as the definition they
+	* were generated from is reordered.  0 until the definition has been parsed, and never a value
+	* a live session uses as its generation.
+	*/
+	uint32 GetControlLayoutHash() const { return ControlLayoutHash; }
+
+	/** Must be called after changing ParsedProjectDefinition so that GetControlsOfKind sees the change. */
+	void RebuildControlIndex();
 
 public:
 #if WITH_EDITORONLY_DATA
@@ -32,10 +50,17 @@ public:
 public:
 	UPROPERTY()
 	FString ProjectDefinitionJson;
+#endif
 
+	/** Parsed from ProjectDefinitionJson in the editor.  Cooked builds load it directly in binary form instead. */
 	FMixerInteractiveGameVersion ParsedProjectDefinition;
 
+#if WITH_EDITORONLY_DATA
 	UPROPERTY(EditAnywhere, Category="Scenes")
 	TMap<FName, FMixerCustomControlMapping> CustomControlMappings;
 #endif
+
+private:
+	TMap<FString, TArray<FString>> ControlsByKind;
+	uint32 ControlLayoutHash = 0;
 };
\ No newline at end of file
@@ -28,6 +28,92 @@ struct FMixerPredefinedGroup
 	FName InitialScene;
 };
 
+/**
+* Leaky bucket limit the Mixer service applies to one kind of message it sends us.
+* Messages that would overflow the bucket are dropped on the service side.
+*/
+USTRUCT()
+struct FMixerBandwidthThrottle
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, Category = "Networking")
+	bool bEnabled;
+
+	/** Burst size, in bytes. */
+	UPROPERTY(EditAnywhere, Category = "Networking", meta = (EditCondition = "bEnabled", ClampMin = 0))
+	int32 Capacity;
+
+	/** Sustained rate, in bytes per second. */
+	UPROPERTY(EditAnywhere, Category = "Networking", meta = (EditCondition = "bEnabled", ClampMin = 0))
+	int32 DrainRate;
+
+	FMixerBandwidthThrottle()
+		: bEnabled(false)
+		, Capacity(10 * 1024 * 1024)
+		, DrainRate(3 * 1024 * 1024)
+	{
+	}
+};
+
+/**
+* Client-side token bucket applied to each participant's input for one kind of control,
+* before it is handed to the game.  Input beyond the limit is dropped.
+*/
+USTRUCT()
+struct FMixerInputRateLimit
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, Category = "Networking")
+	bool bEnabled;
+
+	/** Sustained rate, in events per second per participant. */
+	UPROPERTY(EditAnywhere, Category = "Networking", meta = (EditCondition = "bEnabled", ClampMin = 0.0))
+	float EventsPerSecond;
+
+	/** Burst size, in events. */
+	UPROPERTY(EditAnywhere, Category = "Networking", meta = (EditCondition = "bEnabled", ClampMin = 1))
+	int32 Burst;
+
+	FMixerInputRateLimit()
+		: bEnabled(false)
+		, EventsPerSecond(10.0f)
+		, Burst(20)
+	{
+	}
+};
+
+/**
+* Discards joystick moves that carry no useful change before anything is broadcast.  Applied per
+* participant, against the last value from that participant that was handed to the game.
+* Moves back to the centre are always delivered, so a released stick never appears held.
+*/
+USTRUCT()
+struct FMixerStickInputFilter
+{
+	GENERATED_BODY()
+
+	/** Values whose length is below this are treated as centred. */
+	UPROPERTY(EditAnywhere, Category = "Networking", meta = (ClampMin = 0.0, ClampMax = 1.0))
+	float Deadzone;
+
+	/** Moves closer than this to the last delivered value are discarded. */
+	UPROPERTY(EditAnywhere, Category = "Networking", meta = (ClampMin = 0.0, ClampMax = 2.0))
+	float MinimumDelta;
+
+	/** Most moves delivered per second per participant.  0 means no limit. */
+	UPROPERTY(EditAnywhere, Category = "Networking", meta = (ClampMin = 0.0))
+	float MaxEventsPerSecond;
+
+	FMixerStickInputFilter()
+		: Deadzone(0.0f)
+		, MinimumDelta(0.0f)
+		, MaxEventsPerSecond(0.0f)
+	{
+	}
+};
+
 UCLASS(config=Game, defaultconfig)
 class MIXERINTERACTIVITY_API UMixerInteractivitySettings : public UObject
 {
@@ -59,6 +145,13 @@ public:
 	UPROPERTY(EditAnywhere, Config, Category = "Auth", AdvancedDisplay)
 	FString Sandbox;
 
+	/**
+	* Seconds ahead of an OAuth access token's expiry to refresh it in the background, so that
+	* long sessions and reconnects always have a valid token.  0 disables background refresh.
+	*/
+	UPROPERTY(EditAnywhere, Config, Category = "Auth", AdvancedDisplay, meta = (ClampMin = 0.0))
+	float AccessTokenRefreshLeadTime;
+
 	/** 
 	* The name of the Mixer Interactive Project that this title should be associated with.
 	* Available options are based on the set of games owned by the current logged in Mixer user.
@@ -88,7 +181,8 @@ public:
 	* Type defining (via Delegates/Event Dispatchers) a set of custom methods that
 	* the Mixer Interactive service may invoke on the client.  Provide a valid class
 	* here in order to enable handling of these methods in Blueprint with strongly
-	* typed parameters.
+	* typed parameters.  The same signatures are offered as Call nodes, for invoking
+	* game-defined methods on the service without building Json by hand.
 	*/
 	UPROPERTY(EditAnywhere, Config, Category = "Interactive Controls", AdvancedDisplay, meta=(MetaClass="MixerCustomMethods"))
 	FSoftClassPath CustomMethods;
@@ -101,6 +195,58 @@ public:
 	UPROPERTY(EditAnywhere, Config, Category = "Interactive Controls", meta = (AllowedClasses = "MixerProjectAsset"))
 	FSoftObjectPath ProjectDefinition;
 
+	/**
+	* Stream in the Project Definition, and the classes its custom controls are mapped to, in the
+	* background at startup and as worlds load, so that binding Mixer events never waits on disk.
+	* Without this they are loaded synchronously on first use.
+	*/
+	UPROPERTY(EditAnywhere, Config, Category = "Interactive Controls", AdvancedDisplay)
+	bool bPreloadProjectAssets;
+
+	/**
+	* Keep the Blueprint event source, with its subscriptions, resolved bindings and custom control
+	* instances, when a game world goes away (e.g. on seamless travel or a PIE restart), and hand it to
+	* the next game world instead of building a new one.  Bindings saved with the new level are merged
+	* in.  Sources aren't clustered for garbage collection with this enabled.
+	*/
+	UPROPERTY(EditAnywhere, Config, Category = "Interactive Controls", AdvancedDisplay)
+	bool bPersistBlueprintEventSource;
+
+	/**
+	* Populate scenes and controls from the Project Definition when an interactive session starts,
+	* rather than waiting on the service for them, so that the game is interactive as soon as the
+	* connection is established.  The service's copy is applied over the top when it arrives.
+	* Only effective while the Project Definition is in sync with the Game Version.
+	*/
+	UPROPERTY(EditAnywhere, Config, Category = "Interactive Controls", AdvancedDisplay, meta = (DisplayName = "Seed session from Project Definition"))
+	bool bSeedSessionFromProjectDefinition;
+
+	/**
+	* Hold a slot for every button and joystick in the Project Definition when an interactive session
+	* starts, in definition order, so that the handles in a header generated from the definition (see
+	* the Project Definition's details) are valid without resolving them by name.  Generated handles
+	* stop resolving if the definition has changed since the header was generated.
+	*/
+	UPROPERTY(EditAnywhere, Config, Category = "Interactive Controls", AdvancedDisplay)
+	bool bReserveGeneratedControlHandles;
+
+	/**
+	* Where the Project Definition's details write the generated controls header, relative to the
+	* project directory.  Defaults to Source/<Project>/MixerProjectControls.h if empty.
+	*/
+	UPROPERTY(EditAnywhere, Config, Category = "Interactive Controls", AdvancedDisplay, meta = (EditCondition = "bReserveGeneratedControlHandles"))
+	FString GeneratedControlsHeaderPath;
+
+	/**
+	* Keep scenes that no group is showing in their raw form when an interactive session starts, and
+	* only create their controls the first time the scene is set for a group or one of its controls
+	* is used.  Reduces connection cost for projects with many scenes.  Custom control properties
+	* for such scenes are likewise reported when the scene is first needed rather than on connect.
+	* Only supported by the UE backend.
+	*/
+	UPROPERTY(EditAnywhere, Config, Category = "Interactive Controls", AdvancedDisplay)
+	bool bParseScenesOnDemand;
+
 	/**
 	* Choose whether built-in controls such as buttons and joysticks maintain information
 	* about their state for each remote user in an interactive session.  Disabling this
@@ -110,6 +256,536 @@ public:
 	UPROPERTY(EditAnywhere, Config, Category = "Interactive Controls", AdvancedDisplay, meta = (DisplayName = "Track built-in control state per remote participant"))
 	bool bPerParticipantStateCaching;
 
+	/**
+	* Fall back to aggregate-only tracking of built-in controls while the audience is larger than
+	* PerParticipantStateAudienceLimit, and resume per-participant tracking once it shrinks to
+	* PerParticipantStateAudienceResume.  Buttons already held when tracking drops keep counting
+	* towards PressCount until they're released.  Each switch is announced through
+	* IMixerInteractivityModule::OnPerParticipantStateCachingChanged.
+	* Only applies when per-participant state caching is enabled.  Not used by the interactive-cpp v1 backend.
+	*/
+	UPROPERTY(EditAnywhere, Config, Category = "Interactive Controls", AdvancedDisplay, meta = (EditCondition = "bPerParticipantStateCaching"))
+	bool bAdaptivePerParticipantStateCaching;
+
+	/** Audience size above which adaptive caching drops to aggregate-only tracking. */
+	UPROPERTY(EditAnywhere, Config, Category = "Interactive Controls", AdvancedDisplay, meta = (EditCondition = "bAdaptivePerParticipantStateCaching", ClampMin = 1))
+	int32 PerParticipantStateAudienceLimit;
+
+	/** Audience size at or below which adaptive caching resumes per-participant tracking.  Keep this well under the limit so a hovering audience doesn't flip the mode back and forth. */
+	UPROPERTY(EditAnywhere, Config, Category = "Interactive Controls", AdvancedDisplay, meta = (EditCondition = "bAdaptivePerParticipantStateCaching", ClampMin = 0))
+	int32 PerParticipantStateAudienceResume;
+
+	/**
+	* Number of remote participants to allocate records for when an interactive session starts.
+	* Records of departed participants are not reused; audiences beyond this size still work
+	* but allocate as they join.  Not used by the interactive-cpp v1 backend.
+	*/
+	UPROPERTY(EditAnywhere, Config, Category = "Interactive Controls", AdvancedDisplay, meta = (ClampMin = 0))
+	int32 ExpectedAudienceSize;
+
+	/**
+	* Approximate memory, in kilobytes, that cached remote participant information may use before
+	* participants who have been idle are evicted, least recently active first.  Evicted participants
+	* are fetched again when they next send input.  0 means no limit.
+	* Not used by the interactive-cpp v1 backend.
+	*/
+	UPROPERTY(EditAnywhere, Config, Category = "Interactive Controls", AdvancedDisplay, meta = (ClampMin = 0))
+	int32 ParticipantCacheBudgetKB;
+
+	/** Time, in seconds, without input after which a participant may be evicted from the cache. */
+	UPROPERTY(EditAnywhere, Config, Category = "Interactive Controls", AdvancedDisplay, meta = (ClampMin = 0.0))
+	float ParticipantIdleEvictionTime;
+
+	/**
+	* Time, in seconds, that a participant who leaves is held on to before OnParticipantStateChanged
+	* reports them as having left.  If they rejoin in the meantime, as viewers on flaky connections
+	* often do, their record is picked up again and neither the leave nor the rejoin is reported.
+	* Until then they still appear among the session's participants.  0 reports leaves immediately.
+	*/
+	UPROPERTY(EditAnywhere, Config, Category = "Interactive Controls", AdvancedDisplay, meta = (ClampMin = 0.0))
+	float ParticipantRejoinGracePeriod;
+
+	/**
+	* Look up whether each participant follows or subscribes to the broadcaster's channel, and record
+	* it in FMixerRemoteUser::ChannelRelationship.  Joins are
+	* gathered into batched REST queries; see IMixerInteractivityModule::OnParticipantsEnriched.
+	* Not supported by the interactive-cpp v1 backend.
+	*/
+	UPROPERTY(EditAnywhere, Config, Category = "Interactive Controls", AdvancedDisplay)
+	bool bEnrichParticipants;
+
+	/** Time, in seconds, to gather joining participants before looking them up together. */
+	UPROPERTY(EditAnywhere, Config, Category = "Interactive Controls", AdvancedDisplay, meta = (ClampMin = 0.0, EditCondition = "bEnrichParticipants"))
+	float ParticipantEnrichmentWindow;
+
+	/** Most participants looked up by one query.  Bounded by the length of the query string as well as the service's page size. */
+	UPROPERTY(EditAnywhere, Config, Category = "Interactive Controls", AdvancedDisplay, meta = (ClampMin = 1, ClampMax = 100, EditCondition = "bEnrichParticipants"))
+	int32 ParticipantEnrichmentBatchSize;
+
+	/** Time, in seconds, that a participant's looked-up relationship is reused, e.g. when they rejoin, before being fetched again. */
+	UPROPERTY(EditAnywhere, Config, Category = "Interactive Controls", AdvancedDisplay, meta = (ClampMin = 0.0, EditCondition = "bEnrichParticipants"))
+	float ParticipantEnrichmentCacheLifetime;
+
+	/**
+	* At the end of each Mixer tick, publish a copy of built-in control state and the participant roster
+	* that other threads can read without synchronizing with the game thread.  Costs a copy of that state
+	* every frame.  See IMixerInteractivityModule::ReadSessionSnapshot.  Not supported by the interactive-cpp v1 backend.
+	*/
+	UPROPERTY(EditAnywhere, Config, Category = "Interactive Controls", AdvancedDisplay)
+	bool bPublishSessionSnapshots;
+
+	/**
+	* Number of recent button, joystick and textbox input events to keep in the input journal, which
+	* consumers on any thread read at their own pace, and may rewind, through IMixerInteractivityModule::ReadInputJournal.
+	* Rounded up to a power of two.  Allocated when the first interactive session starts and kept until
+	* shutdown, so changes take effect after a restart.  0 keeps no journal.  Not supported by the interactive-cpp v1 backend.
+	*/
+	UPROPERTY(EditAnywhere, Config, Category = "Interactive Controls", AdvancedDisplay, meta = (ClampMin = 0))
+	int32 InputJournalCapacity;
+
+	/**
+	* Parse incoming interactivity and chat messages on a worker thread rather than the
+	* game thread.  Handlers still run on the game thread during the Mixer tick, so events
+	* may be delivered up to a frame later than with this disabled.
+	*/
+	UPROPERTY(EditAnywhere, Config, Category = "Networking", AdvancedDisplay, meta = (DisplayName = "Parse messages off the game thread"))
+	bool bParseMessagesOffGameThread;
+
+	/**
+	* Queue outgoing messages to the Mixer service and send them once per tick, merging
+	* compatible requests (such as several participant group changes) where possible.
+	*/
+	UPROPERTY(EditAnywhere, Config, Category = "Networking", AdvancedDisplay, meta = (DisplayName = "Batch outgoing messages"))
+	bool bBatchOutboundMessages;
+
+	/**
+	* Upper bound (in characters) on the size of a message produced by merging requests.
+	* Requests that are individually larger than this are still sent whole.
+	*/
+	UPROPERTY(EditAnywhere, Config, Category = "Networking", AdvancedDisplay, meta = (EditCondition = "bBatchOutboundMessages", ClampMin = 1024))
+	int32 MaxOutboundFrameSize;
+
+	/**
+	* Queued control updates (updateControls) at least this large, in bytes, are sent after the
+	* rest of the frame's messages, so captures and other small requests don't wait behind them.
+	* 0 keeps every message in the order it was queued.
+	*/
+	UPROPERTY(EditAnywhere, Config, Category = "Networking", AdvancedDisplay, meta = (EditCondition = "bBatchOutboundMessages", ClampMin = 0))
+	int32 OutboundBulkMessageSize;
+
+	/**
+	* How many bytes of large control updates may be sent per tick.  The rest wait for the next
+	* tick, again behind that tick's smaller messages.  At least one is always sent.  0 means no limit.
+	*/
+	UPROPERTY(EditAnywhere, Config, Category = "Networking", AdvancedDisplay, meta = (EditCondition = "bBatchOutboundMessages", ClampMin = 0))
+	int32 OutboundBulkBytesPerTick;
+
+	/**
+	* Offer the permessage-deflate websocket extension when connecting to the interactivity
+	* and chat services.  Only takes effect where the platform websocket implementation can
+	* inflate frames itself (the engine's libwebsockets module); ignored on Xbox One.
+	*/
+	UPROPERTY(EditAnywhere, Config, Category = "Networking", AdvancedDisplay, meta = (DisplayName = "Request message compression"))
+	bool bRequestMessageCompression;
+
+	/**
+	* Allow the compression context to be carried between messages.  Compresses repetitive
+	* traffic much better, at the cost of keeping a deflate window per connection.
+	*/
+	UPROPERTY(EditAnywhere, Config, Category = "Networking", AdvancedDisplay, meta = (EditCondition = "bRequestMessageCompression"))
+	bool bCompressionContextTakeover;
+
+	/**
+	* When an established interactive connection drops, reconnect in the background and
+	* resume the existing session (controls, groups and participants) rather than starting over.
+	*/
+	UPROPERTY(EditAnywhere, Config, Category = "Networking", AdvancedDisplay, meta = (DisplayName = "Resume session after connection loss"))
+	bool bAutoReconnect;
+
+	/** Delay before the first reconnect attempt.  Doubles (with jitter) on each further attempt. */
+	UPROPERTY(EditAnywhere, Config, Category = "Networking", AdvancedDisplay, meta = (EditCondition = "bAutoReconnect", ClampMin = 0.0))
+	float ReconnectBaseDelay;
+
+	/** Upper bound on the delay between reconnect attempts. */
+	UPROPERTY(EditAnywhere, Config, Category = "Networking", AdvancedDisplay, meta = (EditCondition = "bAutoReconnect", ClampMin = 0.0))
+	float ReconnectMaxDelay;
+
+	/** Number of consecutive failed attempts after which the session is abandoned. */
+	UPROPERTY(EditAnywhere, Config, Category = "Networking", AdvancedDisplay, meta = (EditCondition = "bAutoReconnect", ClampMin = 1))
+	int32 MaxReconnectAttempts;
+
+	/**
+	* Seconds between lightweight pings on the interactive and chat connections, used to measure
+	* round trip time and jitter and to notice sockets that have stopped answering.  0 disables pinging.
+	*/
+	UPROPERTY(EditAnywhere, Config, Category = "Networking", AdvancedDisplay, meta = (ClampMin = 0.0))
+	float ConnectionPingInterval;
+
+	/** Seconds to wait for the reply to a ping before counting it as missed. */
+	UPROPERTY(EditAnywhere, Config, Category = "Networking", AdvancedDisplay, meta = (ClampMin = 0.1))
+	float ConnectionPingTimeout;
+
+	/** Round trip time (in milliseconds) above which a ping counts towards failing over.  0 only fails over on missed pings. */
+	UPROPERTY(EditAnywhere, Config, Category = "Networking", AdvancedDisplay, meta = (ClampMin = 0.0))
+	float ConnectionFailoverRoundTripMs;
+
+	/**
+	* Number of consecutive slow or missed pings after which the connection moves to the next
+	* endpoint, before the socket itself gives up.  0 never fails over.
+	*/
+	UPROPERTY(EditAnywhere, Config, Category = "Networking", AdvancedDisplay, meta = (ClampMin = 0))
+	int32 ConnectionFailoverPingCount;
+
+	/** Service-side limit on all messages delivered to this client.  Only supported by the interactive-cpp v2 backend. */
+	UPROPERTY(EditAnywhere, Config, Category = "Networking", AdvancedDisplay)
+	FMixerBandwidthThrottle GlobalThrottle;
+
+	/** Service-side limit on participant input (giveInput) delivered to this client. */
+	UPROPERTY(EditAnywhere, Config, Category = "Networking", AdvancedDisplay)
+	FMixerBandwidthThrottle InputThrottle;
+
+	/** Service-side limit on participant join notifications delivered to this client. */
+	UPROPERTY(EditAnywhere, Config, Category = "Networking", AdvancedDisplay)
+	FMixerBandwidthThrottle ParticipantJoinThrottle;
+
+	/** Service-side limit on participant leave notifications delivered to this client. */
+	UPROPERTY(EditAnywhere, Config, Category = "Networking", AdvancedDisplay)
+	FMixerBandwidthThrottle ParticipantLeaveThrottle;
+
+	/**
+	* Drop control properties from outgoing updateControls messages when they match the value
+	* the service last acknowledged (or reported) for that control.  Not available for our own
+	* updates on the interactive-cpp v1 backend, which has no per-call replies.
+	*/
+	UPROPERTY(EditAnywhere, Config, Category = "Networking", AdvancedDisplay)
+	bool bSuppressUnchangedControlUpdates;
+
+	/**
+	* Changes to a control's progress smaller than this are treated as unchanged and not sent.
+	* 0 sends every change.
+	*/
+	UPROPERTY(EditAnywhere, Config, Category = "Networking", AdvancedDisplay, meta = (EditCondition = "bSuppressUnchangedControlUpdates", ClampMin = 0.0, ClampMax = 1.0))
+	float ControlProgressEpsilon;
+
+	/**
+	* Minimum time, in seconds, between updates sent for any one control.  Changes made in between
+	* are merged and sent together.  Cooldown and disabled state changes are never held back.
+	*/
+	UPROPERTY(EditAnywhere, Config, Category = "Networking", AdvancedDisplay, meta = (ClampMin = 0.0))
+	float ControlUpdateMinInterval;
+
+	/**
+	* Approximate budget, in bytes per second, for outgoing control updates.  Once it is spent,
+	* lower priority updates (progress, labels, etc.) wait for a later frame rather than bursting.
+	* Cooldown and disabled state changes are always sent.  0 means no limit.
+	*/
+	UPROPERTY(EditAnywhere, Config, Category = "Networking", AdvancedDisplay, meta = (ClampMin = 0))
+	int32 ControlUpdateBytesPerSecond;
+
+	/**
+	* Approximate upper bound, in bytes, on a single updateControls message.  Larger batches are
+	* split into several messages for the same scene.  A single control larger than this is still
+	* sent whole.  0 sends each scene's updates as one message.
+	*/
+	UPROPERTY(EditAnywhere, Config, Category = "Networking", AdvancedDisplay, meta = (ClampMin = 0))
+	int32 ControlUpdateMaxMessageSize;
+
+	/**
+	* Deliver at most one joystick event per participant per stick each frame, carrying the
+	* latest position.  Intermediate moves received within the frame are discarded.
+	*/
+	UPROPERTY(EditAnywhere, Config, Category = "Networking", AdvancedDisplay, meta = (DisplayName = "Coalesce joystick input"))
+	bool bCoalesceStickInput;
+
+	/**
+	* Time, in microseconds, spent each frame handing queued interactive events to the game.
+	* Events still queued when the budget runs out wait for the next frame.
+	* Only supported by the interactive-cpp v2 backend.
+	*/
+	UPROPERTY(EditAnywhere, Config, Category = "Networking", AdvancedDisplay, meta = (ClampMin = 100))
+	int32 EventPumpBudgetMicroseconds;
+
+	/**
+	* Time, in milliseconds, the plugin may spend each frame on socket messages, interactive events, chat,
+	* REST completions, custom control ticks and control updates together.  Each gets an even share of
+	* what is left when its turn comes, with unused time passed on.  Work that doesn't fit waits for the
+	* next frame.  0 for no limit.
+	*/
+	UPROPERTY(EditAnywhere, Config, Category = "Networking", AdvancedDisplay, meta = (ClampMin = 0))
+	float FrameBudgetMilliseconds;
+
+	/**
+	* Times per second the plugin maintains session state, ticks custom controls and flushes control
+	* updates and captures.  At higher frame rates these are skipped on the frames in between, since
+	* the service can't observe changes any faster.  0 runs them every frame.
+	*/
+	UPROPERTY(EditAnywhere, Config, Category = "Networking", AdvancedDisplay, meta = (ClampMin = 0.0))
+	float ProcessingRate;
+
+	/**
+	* Deliver interactive input at the processing rate as well, rather than every frame.  Button
+	* counters then cover everything received since the previous delivery.
+	*/
+	UPROPERTY(EditAnywhere, Config, Category = "Networking", AdvancedDisplay)
+	bool bDispatchInputAtProcessingRate;
+
+	/**
+	* While the signed in user isn't broadcasting and interactivity is stopped, tick only every
+	* Hibernation tick interval, skipping state maintenance, custom control ticks and flushes.
+	* Connections stay open and answer keepalives.  Starting interactivity or going live wakes
+	* the plugin at once.  Not used while chat is connected.  Off by default, since anything
+	* else the game expects to tick (custom controls, say) stops too.
+	*/
+	UPROPERTY(EditAnywhere, Config, Category = "Networking", AdvancedDisplay)
+	bool bHibernateWhenNotBroadcasting;
+
+	/** Seconds between ticks while hibernating. */
+	UPROPERTY(EditAnywhere, Config, Category = "Networking", AdvancedDisplay, meta = (EditCondition = "bHibernateWhenNotBroadcasting", ClampMin = 0.0, ClampMax = 5.0))
+	float HibernationTickInterval;
+
+	/**
+	* Development builds only: count the heap allocations the plugin's tick, socket dispatch and
+	* delegate broadcasts make each frame, reporting them in stat MixerInteractivity.  Read from the
+	* allocator's own call counters, so needs a STATS build, and what other threads allocate at the
+	* same time is counted too.
+	*/
+	UPROPERTY(EditAnywhere, Config, Category = "Networking", AdvancedDisplay)
+	bool bGuardTickAllocations;
+
+	/**
+	* Allocations per frame tick and socket dispatch may make once interactive input is flowing.
+	* Going over logs a warning, and fails the MixerInteractivity.Benchmark.SteadyStateAllocations
+	* automation test.  Allocations made by the game's own delegates are reported but not held to it.
+	* -1 to only report.
+	*/
+	UPROPERTY(EditAnywhere, Config, Category = "Networking", AdvancedDisplay, meta = (EditCondition = "bGuardTickAllocations", ClampMin = -1))
+	int32 SteadyStateAllocationBudget;
+
+	/** Seconds after going interactive, or changing scenes, before the allocation budget applies. */
+	UPROPERTY(EditAnywhere, Config, Category = "Networking", AdvancedDisplay, meta = (EditCondition = "bGuardTickAllocations", ClampMin = 0.0))
+	float AllocationGuardWarmupTime;
+
+	/**
+	* Run the interactive-cpp v2 session on a plugin-owned worker thread.  Incoming events are
+	* parsed there and queued; the game thread only applies them, within the pump budget above.
+	*/
+	UPROPERTY(EditAnywhere, Config, Category = "Networking", AdvancedDisplay)
+	bool bProcessEventsOnWorkerThread;
+
+	/**
+	* Number of queued interactive events above which joystick input is coalesced as if
+	* Coalesce joystick input were set, until the backlog has been worked off.
+	* Only supported by the interactive-cpp v2 backend.
+	*/
+	UPROPERTY(EditAnywhere, Config, Category = "Networking", AdvancedDisplay, meta = (ClampMin = 0))
+	int32 StickCoalescingBacklogThreshold;
+
+	/**
+	* Once events are being left queued at the end of the pump budget, hand them to the game by
+	* priority rather than in arrival order: Spark-charged input first, then button presses and
+	* releases and other session changes, then remaining custom input, then joystick moves with
+	* superseded moves from the same participant dropped.
+	* Only supported by the interactive-cpp v2 backend.
+	*/
+	UPROPERTY(EditAnywhere, Config, Category = "Networking", AdvancedDisplay)
+	bool bPrioritizeInputUnderLoad;
+
+	/**
+	* Tighten the input throttle while the game is struggling to keep up (long frames, or events
+	* left queued every frame) and relax it back towards the configured rate once it recovers.
+	* Only supported by the interactive-cpp v2 backend.
+	*/
+	UPROPERTY(EditAnywhere, Config, Category = "Networking", AdvancedDisplay)
+	bool bAdaptiveInputThrottle;
+
+	/** Frame time, in milliseconds, above which the adaptive throttle considers the game overloaded. */
+	UPROPERTY(EditAnywhere, Config, Category = "Networking", AdvancedDisplay, meta = (EditCondition = "bAdaptiveInputThrottle", ClampMin = 1.0))
+	float AdaptiveThrottleFrameTimeThreshold;
+
+	/** Lowest input drain rate, in bytes per second, the adaptive throttle will apply. */
+	UPROPERTY(EditAnywhere, Config, Category = "Networking", AdvancedDisplay, meta = (EditCondition = "bAdaptiveInputThrottle", ClampMin = 1024))
+	int32 AdaptiveThrottleMinDrainRate;
+
+	/** Per-participant limit on button input.  Releases and charged presses are never dropped. */
+	UPROPERTY(EditAnywhere, Config, Category = "Networking", AdvancedDisplay)
+	FMixerInputRateLimit ButtonInputRateLimit;
+
+	/** Per-participant limit on joystick moves. */
+	UPROPERTY(EditAnywhere, Config, Category = "Networking", AdvancedDisplay)
+	FMixerInputRateLimit StickInputRateLimit;
+
+	/** Deadzone, minimum change and rate applied to every joystick's moves, unless overridden below. */
+	UPROPERTY(EditAnywhere, Config, Category = "Networking", AdvancedDisplay)
+	FMixerStickInputFilter StickInputFilter;
+
+	/** Filters for individual joysticks, by control id, used in place of the one above. */
+	UPROPERTY(EditAnywhere, Config, Category = "Networking", AdvancedDisplay)
+	TMap<FName, FMixerStickInputFilter> StickInputFilterOverrides;
+
+	/** Per-participant limit on textbox submissions.  Charged submissions are never dropped. */
+	UPROPERTY(EditAnywhere, Config, Category = "Networking", AdvancedDisplay)
+	FMixerInputRateLimit TextboxInputRateLimit;
+
+	/** Per-participant limit on custom control input. */
+	UPROPERTY(EditAnywhere, Config, Category = "Networking", AdvancedDisplay)
+	FMixerInputRateLimit CustomControlInputRateLimit;
+
+	/**
+	* Participant input events handed to the game per frame, across all participants.  Once the
+	* budget is spent, participants who have had less than an even share of it this frame are
+	* still served, so one noisy participant can't crowd out everyone else.  0 means no limit.
+	* Not supported by the interactive-cpp v1 backend.
+	*/
+	UPROPERTY(EditAnywhere, Config, Category = "Networking", AdvancedDisplay, meta = (ClampMin = 0))
+	int32 MaxInputEventsPerFrame;
+
+	/**
+	* Once more input arrives per frame than InputSamplingTargetPerFrame, pass only a share of each control's
+	* input events on to the game, scaling the share with the arrival rate, and sample harder while the
+	* frame budget is leaving interactive events for later frames.  Releases and charged input are never
+	* skipped.  Button DownCount still counts every press; see IMixerInteractivityModule::GetInputSamplingState
+	* for scaling other counts.  Not supported by the interactive-cpp v1 backend.
+	*/
+	UPROPERTY(EditAnywhere, Config, Category = "Networking", AdvancedDisplay)
+	bool bSampleInputUnderLoad;
+
+	/** Input events per frame that sampling aims to hand to the game. */
+	UPROPERTY(EditAnywhere, Config, Category = "Networking", AdvancedDisplay, meta = (EditCondition = "bSampleInputUnderLoad", ClampMin = 1))
+	int32 InputSamplingTargetPerFrame;
+
+	/** Smallest share of each control's input that sampling will keep. */
+	UPROPERTY(EditAnywhere, Config, Category = "Networking", AdvancedDisplay, meta = (EditCondition = "bSampleInputUnderLoad", ClampMin = 0.001, ClampMax = 1.0))
+	float InputSamplingMinRate;
+
+	/**
+	* Seconds a looked-up list of interactive hosts stays usable.  While it does, connecting starts
+	* immediately against the best-known host and the list is refreshed in parallel.  0 always waits
+	* for a fresh lookup.
+	*/
+	UPROPERTY(EditAnywhere, Config, Category = "Networking", AdvancedDisplay, meta = (ClampMin = 0.0))
+	float InteractiveHostsCacheLifetime;
+
+	/**
+	* Overlap the steps of logging in rather than running them strictly in turn.  Interactive hosts
+	* are looked up as soon as login starts, and the interactive connection opens as soon as an
+	* access token is available instead of waiting for the local user to be fetched.
+	*/
+	UPROPERTY(EditAnywhere, Config, Category = "Networking", AdvancedDisplay)
+	bool bPipelinedStartup;
+
+	/**
+	* Remember what session setup learns (interactive scenes, chat channel ids and the chat endpoint
+	* ranking) under Saved/Mixer, and start the next launch from it instead of waiting on the service.
+	* Each is confirmed or replaced by the live lookup as it completes, and seeded controls the service
+	* no longer has are removed.  Also lets the interactive connection start at the last good host once
+	* the host list has gone stale.  Off by default: until the lookup completes, the game sees
+	* whatever the cache recorded.
+	*/
+	UPROPERTY(EditAnywhere, Config, Category = "Networking", AdvancedDisplay)
+	bool bUseWarmStartCache;
+
+	/**
+	* Subscribe to Mixer's live event service for changes to the local user and their channel
+	* (e.g. going live), rather than relying on polling alone.  Polling continues at a much
+	* lower rate as a fallback, and at its normal rate whenever the subscription is down.
+	*/
+	UPROPERTY(EditAnywhere, Config, Category = "Networking", AdvancedDisplay)
+	bool bUseLiveEventsForUserUpdates;
+
+	/**
+	* Connect interactivity here instead of to the hosts Mixer hands out, e.g. a ws:// url for a
+	* local test server, mock://interactive for the built-in mock service, or replay://<file> to play
+	* back a recording made with Mixer.Record.Start (neither in shipping builds).  Login still goes to Mixer.  Only supported by the default backend.  Empty uses Mixer as normal.
+	*/
+	UPROPERTY(EditAnywhere, Config, Category = "Networking", AdvancedDisplay)
+	FString InteractiveEndpointOverride;
+
+	/**
+	* Connect chat rooms here instead of looking up Mixer's chat servers, e.g. a ws:// url for a
+	* local test server, mock://chat for the built-in mock service, or replay://<file> to play back
+	* the chat in a recording (neither in shipping builds).
+	* Numeric room ids are used as the channel id; anything else joins channel 1.
+	*/
+	UPROPERTY(EditAnywhere, Config, Category = "Networking", AdvancedDisplay)
+	FString ChatEndpointOverride;
+
+	/**
+	* Number of recent messages kept per joined chat room, returned by GetLastMessages.  Up to 100
+	* of them are fetched from the service on joining.  0 keeps no history.
+	*/
+	UPROPERTY(EditAnywhere, Config, Category = "Chat", meta = (ClampMin = 0))
+	int32 ChatHistoryCapacity;
+
+	/**
+	* Maximum number of chat users cached per joined room.  Beyond this the least recently active
+	* users are evicted; they are no longer returned by GetMembers but still resolve via GetMember
+	* while they have messages in the history.  0 means no limit.
+	*/
+	UPROPERTY(EditAnywhere, Config, Category = "Chat", AdvancedDisplay, meta = (ClampMin = 0))
+	int32 ChatUserCacheCapacity;
+
+	/**
+	* Seconds over which chat joins and leaves are held back and netted out, so that a raid arriving
+	* produces one batched OnChatRoomMembersChanged rather than thousands of individual updates, and
+	* users who join and leave again in between are never reported.  0 applies them as they arrive.
+	*/
+	UPROPERTY(EditAnywhere, Config, Category = "Chat", AdvancedDisplay, meta = (ClampMin = 0, UIMax = 10))
+	float ChatMembershipCoalesceWindow;
+
+	/**
+	* Queue outgoing chat messages, whispers and poll starts per room and release them no faster than
+	* ChatSendsPerSecond, so that bursts don't hit the service's throttle and get rejected.
+	* Identical sends still waiting in the queue are merged into one.
+	*/
+	UPROPERTY(EditAnywhere, Config, Category = "Chat")
+	bool bQueueOutboundChat;
+
+	/** Sustained rate at which queued chat sends are released, per room. */
+	UPROPERTY(EditAnywhere, Config, Category = "Chat", meta = (EditCondition = "bQueueOutboundChat", ClampMin = 0.1))
+	float ChatSendsPerSecond;
+
+	/** Number of chat sends that may be released back to back before ChatSendsPerSecond applies. */
+	UPROPERTY(EditAnywhere, Config, Category = "Chat", meta = (EditCondition = "bQueueOutboundChat", ClampMin = 1))
+	int32 ChatSendBurst;
+
+	/** Maximum number of chat sends waiting per room.  Sends beyond this fail immediately. */
+	UPROPERTY(EditAnywhere, Config, Category = "Chat", AdvancedDisplay, meta = (EditCondition = "bQueueOutboundChat", ClampMin = 1))
+	int32 MaxQueuedChatSends;
+
+	/**
+	* Memory that FMixerImageCache may hold in emoticon sheets, chat images and atlas pages before
+	* it starts evicting the least recently used.
+	*/
+	UPROPERTY(EditAnywhere, Config, Category = "Chat", AdvancedDisplay, meta = (ClampMin = 1))
+	int32 ImageCacheBudgetMegabytes;
+
+	/**
+	* Copy emoticons fetched through FMixerImageCache into shared atlas textures, so that a chat view
+	* showing many different emoticons draws them from a handful of textures.  The decoded sprite
+	* sheets are kept in memory to pack from, and count against ImageCacheBudgetMegabytes.
+	*/
+	UPROPERTY(EditAnywhere, Config, Category = "Chat", AdvancedDisplay)
+	bool bPackEmoticonsIntoAtlas;
+
+	/** Width and height, in pixels, that user avatars are requested at. */
+	UPROPERTY(EditAnywhere, Config, Category = "Avatars", meta = (ClampMin = 1, ClampMax = 1024))
+	int32 AvatarSize;
+
+	/** Sustained rate at which queued avatar fetches (see FMixerAvatarCache) are released. */
+	UPROPERTY(EditAnywhere, Config, Category = "Avatars", AdvancedDisplay, meta = (ClampMin = 0.1))
+	float AvatarFetchesPerSecond;
+
+	/** Maximum number of avatar fetches outstanding at once. */
+	UPROPERTY(EditAnywhere, Config, Category = "Avatars", AdvancedDisplay, meta = (ClampMin = 1))
+	int32 MaxConcurrentAvatarFetches;
+
+	/**
+	* Maximum number of avatars kept loaded.  Beyond this the least recently used are dropped.
+	* Avatars also count against ImageCacheBudgetMegabytes.  0 means no limit.
+	*/
+	UPROPERTY(EditAnywhere, Config, Category = "Avatars", AdvancedDisplay, meta = (ClampMin = 0))
+	int32 AvatarCacheCapacity;
+
 public:
 	FString GetResolvedRedirectUri() const
 	{
@@ -124,6 +800,15 @@ public:
 		return ResolvedRedirectUri;
 	}
 
+	FString GetOAuthScope() const
+	{
+#if WITH_EDITOR
+		return GIsEditor ? TEXT("interactive:manage:self interactive:robot:self chat:connect chat:chat chat:whisper") : TEXT("interactive:robot:self chat:connect chat:chat chat:whisper");
+#else
+		return TEXT("interactive:robot:self chat:connect chat:chat chat:whisper");
+#endif
+	}
+
 	FString GetSandboxForOAuth() const
 	{
 #if WITH_EDITOR
@@ -133,8 +818,24 @@ public:
 #endif
 	}
 
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
 #if WITH_EDITORONLY_DATA
+	/** Appends the ids of all controls of the given kind in the project definition, sorted by name. */
 	static void GetAllControls(const FString& Kind, TArray<FString>& OutControls);
+
+	/** Appends the ids of custom controls that have no class mapping in the project definition, sorted by name. */
 	static void GetAllUnmappedCustomControls(TArray<FString>& OutCustomControls);
+
+	/** Whether the project definition contains a control of the given kind with the given id. */
+	static bool HasControl(const FString& Kind, const FString& ControlId);
+
+	/**
+	 * The queries above are served from an index built once per project definition.
+	 * Call this whenever the definition's controls or custom control mappings change.
+	 */
+	static void InvalidateControlIndex();
 #endif
 };
\ No newline at end of file
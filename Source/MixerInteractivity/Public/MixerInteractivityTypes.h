@@ -15,14 +15,47 @@
 #include "Internationalization/Text.h"
 #include "Math/Vector2D.h"
 #include "Misc/Guid.h"
+#include "Misc/EnumClassFlags.h"
 #include "Math/Color.h"
+#include "Templates/SharedPointer.h"
+#include "Containers/ArrayView.h"
+
+/**
+* A user's display name.  Names are interned, so every record for the same viewer (interactive participant,
+* chat member) shares one copy of the string, and assigning an unchanged name costs a comparison.
+* Reads like a const FString.
+*/
+struct MIXERINTERACTIVITY_API FMixerUserName
+{
+public:
+	FMixerUserName();
+	FMixerUserName(const FString& InName);
+
+	FMixerUserName& operator=(const FString& InName);
+
+	const FString& ToString() const						{ return *Interned; }
+	operator const FString&() const						{ return *Interned; }
+	const TCHAR* operator*() const						{ return **Interned; }
+
+	bool IsEmpty() const								{ return Interned->IsEmpty(); }
+	int32 Len() const									{ return Interned->Len(); }
+
+	bool operator==(const FMixerUserName& Other) const	{ return Interned == Other.Interned; }
+	bool operator!=(const FMixerUserName& Other) const	{ return Interned != Other.Interned; }
+
+	/** Release interned names that no record refers to any more.  Cheap enough to call every frame; the module does. */
+	static void TrimUnused();
+
+private:
+	TSharedRef<const FString, ESPMode::ThreadSafe> Interned;
+};
 
 /** Base type for all Mixer users */
 struct FMixerUser
 {
 public:
 	/** Name for the user, suitable for display in game UI */
-	FString Name;
+	FMixerUserName Name;
 
 	/** Unique identifier, for internal use */
 	int32 Id;
@@ -113,6 +146,15 @@ public:
 	virtual ~FMixerLocalUser() {}
 };
 
+/** Relationship of a remote user to the broadcaster's channel.  See FMixerRemoteUser::ChannelRelationship. */
+enum class EMixerChannelRelationship : uint8
+{
+	None		= 0,
+	Follower	= 1 << 0,
+	Subscriber	= 1 << 1,
+};
+ENUM_CLASS_FLAGS(EMixerChannelRelationship);
+
 /** Represents a remote user participating in a Mixer interactive session */
 struct FMixerRemoteUser : public FMixerUser
 {
@@ -132,9 +174,257 @@ public:
 	/** Whether the user is currently able to submit interactive input */
 	bool InputEnabled;
 
+	/**
+	* How the user relates to the broadcaster's channel.  Only meaningful once ChannelRelationshipKnown
+	* is set, which happens shortly after joining when UMixerInteractivitySettings::bEnrichParticipants is enabled.
+	*/
+	EMixerChannelRelationship ChannelRelationship;
+
+	/** Whether ChannelRelationship has been looked up.  See IMixerInteractivityModule::OnParticipantsEnriched. */
+	bool ChannelRelationshipKnown;
+
 	FMixerRemoteUser();
 };
 
+/** Details of an FMixerRemoteUser that changed in a participant update.  See IMixerInteractivityModule::OnParticipantUpdated. */
+enum class EMixerParticipantChange : uint8
+{
+	None			= 0,
+	Name			= 1 << 0,
+	Level			= 1 << 1,
+	Group			= 1 << 2,
+	InputEnabled	= 1 << 3,
+};
+ENUM_CLASS_FLAGS(EMixerParticipantChange);
+
+/** Field by which IMixerInteractivityModule::GetParticipantsPage orders the members of a group. */
+enum class EMixerParticipantSortKey : uint8
+{
+	Level,
+	ConnectedAt,
+	InputAt,
+
+	Count
+};
+
+/**
+* Resolved reference to a button or joystick that can be queried without looking the control up by name.
+* Only valid for the interactive session during which it was resolved.  See IMixerInteractivityModule::ResolveButton.
+* Handles emitted into a generated controls header are valid instead in any session whose Project Definition
+* has the layout they were generated from; see UMixerInteractivitySettings::bReserveGeneratedControlHandles.
+*/
+struct FMixerControlHandle
+{
+	/** Position of the control in the backend's control table */
+	int32 Index;
+
+	/** Session in which Index was resolved; 0 if never resolved.  Generated handles carry UMixerProjectAsset::GetControlLayoutHash. */
+	uint32 Generation;
+
+	constexpr FMixerControlHandle()
+		: Index(INDEX_NONE)
+		, Generation(0)
+	{
+	}
+
+	constexpr FMixerControlHandle(int32 InIndex, uint32 InGeneration)
+		: Index(InIndex)
+		, Generation(InGeneration)
+	{
+	}
+};
+
+/** Kind of input carried by an FMixerInputEvent */
+enum class EMixerInputEventKind : uint8
+{
+	ButtonDown,
+	ButtonUp,
+	StickMove,
+	TextboxSubmit,
+};
+
+/**
+* Compact record of one piece of participant input, as delivered by IMixerInteractivityModule::OnInputBatch.
+* Plain data only, so a batch can be walked in one pass or split across a ParallelFor.
+*/
+struct FMixerInputEvent
+{
+	/** Name of the control the input was for */
+	FName ControlId;
+
+	/** Handle to the control, comparable with those from ResolveButton and ResolveStick.  Textbox handles can't be resolved by name. */
+	FMixerControlHandle Control;
+
+	/** Mixer id of the participant, or 0 if unknown */
+	uint32 ParticipantId;
+
+	/**
+	* Dense index of the participant among those currently cached, for indexing per-participant arrays.
+	* Reused once the participant leaves.  INDEX_NONE if unknown.
+	*/
+	int32 ParticipantSlot;
+
+	/** FPlatformTime::Seconds() at which the plugin handed the input to the game */
+	double Timestamp;
+
+	EMixerInputEventKind Kind;
+
+	/** Payload for Kind.  String indices refer to the batch's string view and are INDEX_NONE when absent. */
+	union
+	{
+		struct
+		{
+			uint32 SparkCost;
+			int32 TransactionIdIndex;
+		} Button;
+
+		struct
+		{
+			float X;
+			float Y;
+		} Stick;
+
+		struct
+		{
+			uint32 SparkCost;
+			int32 TransactionIdIndex;
+			int32 TextIndex;
+		} Textbox;
+	};
+};
+
+/**
+* A consumer's read position in the input journal.  See IMixerInteractivityModule::ReadInputJournal.
+* A default-constructed cursor starts from the first input of the current session, so any of that input the
+* journal has already overwritten is counted in MissedEvents on the first read.  Use OpenInputJournalCursor
+* to start from the latest input instead.
+*/
+struct FMixerInputJournalCursor
+{
+	/** Sequence number of the next event to read */
+	int64 NextSequence;
+
+	/** Events of the current session that were overwritten before this cursor reached them */
+	int64 MissedEvents;
+
+	FMixerInputJournalCursor()
+		: NextSequence(0)
+		, MissedEvents(0)
+	{
+	}
+};
+
+/** One control's share of a participant group's input over one tick.  See FMixerGroupInputBatch. */
+struct FMixerGroupControlSummary
+{
+	FName ControlId;
+
+	/** As in FMixerInputEvent::Control */
+	FMixerControlHandle Control;
+
+	/** Button presses and releases */
+	int32 DownCount;
+	int32 UpCount;
+
+	/** Distinct participants who pressed the button, i.e. the group's votes for it.  Unknown participants aren't counted. */
+	int32 Voters;
+
+	/** Sparks offered by charged presses and submissions, before capture */
+	uint32 SparkCost;
+
+	/** Mean of the last position reported by each known participant who moved the joystick, and how many did */
+	FVector2D StickMean;
+	int32 StickParticipants;
+
+	/** Textbox submissions */
+	int32 Submissions;
+
+	FMixerGroupControlSummary()
+		: DownCount(0)
+		, UpCount(0)
+		, Voters(0)
+		, SparkCost(0)
+		, StickMean(0, 0)
+		, StickParticipants(0)
+		, Submissions(0)
+	{
+	}
+};
+
+/**
+* One participant group's input over one tick, as delivered by IMixerInteractivityModule::OnGroupInputBatch.
+* Groups are summarized independently of one another (in parallel when there's enough input to make it worthwhile).
+*/
+struct FMixerGroupInputBatch
+{
+	/** Group the participants were in when their input arrived */
+	FName Group;
+
+	/** The group's input, in the order it arrived.  String indices refer to the string view delivered alongside. */
+	TArrayView<const FMixerInputEvent> Events;
+
+	/** Totals for each control the group used, in order of first use */
+	TArrayView<const FMixerGroupControlSummary> Controls;
+};
+
+/**
+* Text as received from the service, kept as a string until something reads it as FText.  Converts
+* implicitly, so it reads like the FText it stands in for; the FText is made on first use and kept.
+* Not thread safe, even for reading.
+*/
+struct FMixerLazyText
+{
+public:
+	FMixerLazyText()
+		: bMaterialized(true)
+	{
+	}
+
+	FMixerLazyText(const FText& InText)
+		: Text(InText)
+		, bMaterialized(true)
+	{
+	}
+
+	explicit FMixerLazyText(FString InString)
+		: Source(MoveTemp(InString))
+		, bMaterialized(false)
+	{
+	}
+
+	const FText& Get() const
+	{
+		if (!bMaterialized)
+		{
+			Text = FText::FromString(MoveTemp(Source));
+			Source.Empty();
+			bMaterialized = true;
+		}
+		return Text;
+	}
+
+	operator const FText&() const
+	{
+		return Get();
+	}
+
+	/** The text as a string.  Doesn't need the FText, so doesn't make one. */
+	const FString& ToString() const
+	{
+		return bMaterialized ? Text.ToString() : Source;
+	}
+
+	bool IsEmpty() const
+	{
+		return bMaterialized ? Text.IsEmpty() : Source.IsEmpty();
+	}
+
+private:
+	mutable FString Source;
+	mutable FText Text;
+	mutable bool bMaterialized;
+};
+
 /** 
 * Represents the Studio-configured properties of a button that
 * are immutable during an interactive session 
@@ -142,10 +432,10 @@ public:
 struct FMixerButtonDescription
 {
 	/** Text displayed on this button to remote users */
-	FText ButtonText;
+	FMixerLazyText ButtonText;
 
 	/** NOT IMPLEMENTED. Button help text that is displayed to remote users (e.g. as a tooltip). */
-	FText HelpText;
+	FMixerLazyText HelpText;
 
 	/** Number of Sparks a remote user will be charged for pressing this button */
 	uint32 SparkCost;
@@ -195,6 +485,364 @@ struct FMixerStickState
 	bool Enabled;
 };
 
+/**
+* Statistics over the current per-participant values of a joystick.
+* Participants with the joystick at rest are not included.
+*/
+struct FMixerStickAggregate
+{
+	/** Number of participants currently deflecting the joystick */
+	int32 ParticipantCount;
+
+	/** Mean of the participants' values */
+	FVector2D Mean;
+
+	/** Mean of the participants' values, each weighted by how far it is from the center */
+	FVector2D WeightedMean;
+
+	/** Per-axis variance of the participants' values */
+	FVector2D Variance;
+
+	/** Per-axis standard error of Mean, for when it's estimated from sampled input (see FMixerInputSamplingState) */
+	FVector2D MeanStandardError;
+
+	/** Number of participants deflecting toward each quadrant: (+X,+Y), (-X,+Y), (-X,-Y), (+X,-Y) */
+	int32 QuadrantVotes[4];
+};
+
+/** Layout of a heatmap accumulated from coordinate input.  See IMixerInteractivityModule::EnableCoordinateHeatmap. */
+struct FMixerCoordinateHeatmapSettings
+{
+	/** Number of cells across the grid */
+	int32 Width;
+
+	/** Number of cells down the grid */
+	int32 Height;
+
+	/** Coordinate range mapped onto the grid, Min in the first cell.  Coordinates outside it land in the edge cells. */
+	FBox2D Bounds;
+
+	/** Seconds for accumulated weight to halve.  0 accumulates without decay. */
+	float HalfLife;
+
+	FMixerCoordinateHeatmapSettings()
+		: Width(32)
+		, Height(32)
+		, Bounds(FVector2D(-1.0f, -1.0f), FVector2D(1.0f, 1.0f))
+		, HalfLife(2.0f)
+	{
+	}
+};
+
+/** Window and sizes for per-control activity sketches.  See IMixerInteractivityModule::EnableInputSketches. */
+struct FMixerInputSketchSettings
+{
+	/** Seconds of input covered */
+	float WindowSeconds;
+
+	/**
+	* Number of slices the window is kept in.  Input leaves the window a slice at a time, so queries cover
+	* between (WindowBuckets - 1) / WindowBuckets of the window and all of it.  Memory scales with this.
+	*/
+	int32 WindowBuckets;
+
+	/** Participants counted individually per slice for GetMostActiveParticipants.  At most 1024. */
+	int32 TrackedParticipants;
+
+	/**
+	* Log2 of the number of registers per slice for GetDistinctParticipantCount, between 4 and 16.  The estimate's
+	* standard error is about 1.04 / sqrt(2 ^ DistinctPrecision): 3% for the default of 10, at 1KB per slice.
+	*/
+	int32 DistinctPrecision;
+
+	FMixerInputSketchSettings()
+		: WindowSeconds(60.0f)
+		, WindowBuckets(6)
+		, TrackedParticipants(32)
+		, DistinctPrecision(10)
+	{
+	}
+};
+
+/** Resolution and length of a per-control activity history.  See IMixerInteractivityModule::EnableActivityTimeSeries. */
+struct FMixerActivitySeriesSettings
+{
+	/** Seconds covered by each sample */
+	float BucketSeconds;
+
+	/** Number of samples kept */
+	int32 NumBuckets;
+
+	FMixerActivitySeriesSettings()
+		: BucketSeconds(0.1f)
+		, NumBuckets(600)
+	{
+	}
+};
+
+/** One of the participants returned by IMixerInteractivityModule::GetMostActiveParticipants. */
+struct FMixerActiveParticipant
+{
+	/** Mixer id of the participant */
+	uint32 ParticipantId;
+
+	/** Estimated input events over the window.  Never less than the true count. */
+	int32 InputCount;
+
+	/** How far InputCount may overstate the true count */
+	int32 MaxOvercount;
+};
+
+/** Options and rules for a crowd vote.  See IMixerInteractivityModule::StartVoteRound. */
+struct FMixerVoteRoundSettings
+{
+	/** Button for each option */
+	TArray<FName> OptionButtons;
+
+	/** How long the round stays open.  Zero leaves it open until CloseVoteRound. */
+	FTimespan Duration;
+
+	/**
+	* Count each vote as the spark cost of the pressed button (or 1 if free) rather than 1.  Sparks are only
+	* charged if the game captures the transaction, so pair this with a CaptureSparkTransaction listener.
+	*/
+	bool bWeightBySparks;
+
+	FMixerVoteRoundSettings()
+		: Duration(0)
+		, bWeightBySparks(false)
+	{
+	}
+};
+
+/** Outcome of a crowd vote.  See IMixerInteractivityModule::OnVoteRoundClosed. */
+struct FMixerVoteRoundResult
+{
+	/** Id returned by StartVoteRound */
+	int32 RoundId;
+
+	/** Button for each option, as passed to StartVoteRound */
+	TArray<FName> OptionButtons;
+
+	/** Votes (or sparks) for each option */
+	TArray<int32> Tallies;
+
+	/** Index of the option with the highest tally, the earliest on a tie, or INDEX_NONE if nobody voted */
+	int32 WinningOption;
+
+	/** Number of participants who voted */
+	int32 VoterCount;
+
+	FMixerVoteRoundResult()
+		: RoundId(INDEX_NONE)
+		, WinningOption(INDEX_NONE)
+		, VoterCount(0)
+	{
+	}
+};
+
+/** A group and the interactive scene it should see.  See IMixerInteractivityModule::CreateGroups and SetScenesForGroups. */
+struct FMixerGroupSpec
+{
+	/** Name of the group.  Default group if empty. */
+	FName Group;
+
+	/** Interactive scene shown to the group.  Default scene if empty. */
+	FName Scene;
+
+	FMixerGroupSpec()
+	{
+	}
+
+	FMixerGroupSpec(FName InGroup, FName InScene)
+		: Group(InGroup)
+		, Scene(InScene)
+	{
+	}
+};
+
+/** A participant as captured in an FMixerSessionSnapshot */
+struct FMixerParticipantSnapshot
+{
+	uint32 Id;
+	FMixerUserName Name;
+	FName Group;
+	bool InputEnabled;
+};
+
+/** Participants of one group, stored contiguously in FMixerSessionSnapshot::Participants */
+struct FMixerGroupSnapshot
+{
+	FName Group;
+	int32 FirstParticipant;
+	int32 NumParticipants;
+};
+
+/**
+* Copy of the interactive session's built-in control state and participant roster, published at the end
+* of the Mixer tick when session snapshots are enabled.  Immutable once published, so may be read from
+* any thread.  See IMixerInteractivityModule::ReadSessionSnapshot.
+*/
+struct FMixerSessionSnapshot
+{
+	/** Increases by one with each snapshot published */
+	uint64 Version;
+
+	/** Buttons and their state, in parallel arrays */
+	TArray<FName> ButtonIds;
+	TArray<FMixerButtonState> ButtonStates;
+
+	/** Joysticks and their state, in parallel arrays */
+	TArray<FName> StickIds;
+	TArray<FMixerStickState> StickStates;
+
+	/** Every cached participant, ordered by group */
+	TArray<FMixerParticipantSnapshot> Participants;
+	TArray<FMixerGroupSnapshot> Groups;
+
+	FMixerSessionSnapshot()
+		: Version(0)
+	{
+	}
+
+	/** Snapshot counterpart of IMixerInteractivityModule::GetButtonState.  Null if there's no such button. */
+	const FMixerButtonState* FindButtonState(FName Button) const
+	{
+		const int32 Index = ButtonIds.Find(Button);
+		return ButtonStates.IsValidIndex(Index) ? &ButtonStates[Index] : nullptr;
+	}
+
+	/** Snapshot counterpart of IMixerInteractivityModule::GetStickState.  Null if there's no such joystick. */
+	const FMixerStickState* FindStickState(FName Stick) const
+	{
+		const int32 Index = StickIds.Find(Stick);
+		return StickStates.IsValidIndex(Index) ? &StickStates[Index] : nullptr;
+	}
+
+	/** Snapshot counterpart of IMixerInteractivityModule::ViewParticipantsInGroup.  Empty if the group has no members. */
+	TArrayView<const FMixerParticipantSnapshot> ViewParticipantsInGroup(FName GroupName) const
+	{
+		for (const FMixerGroupSnapshot& Group : Groups)
+		{
+			if (Group.Group == GroupName)
+			{
+				return TArrayView<const FMixerParticipantSnapshot>(Participants.GetData() + Group.FirstParticipant, Group.NumParticipants);
+			}
+		}
+		return TArrayView<const FMixerParticipantSnapshot>();
+	}
+
+	/**
+	* Snapshot counterpart of IMixerInteractivityModule::GetParticipant.  Null if the participant wasn't cached.
+	* Linear in audience size, so prefer walking groups when reading many participants.
+	*/
+	const FMixerParticipantSnapshot* FindParticipant(uint32 ParticipantId) const
+	{
+		return Participants.FindByPredicate([ParticipantId](const FMixerParticipantSnapshot& Participant) { return Participant.Id == ParticipantId; });
+	}
+};
+
+/**
+* How long each phase of the most recent login took, in seconds since the login was started.
+* Phases not reached yet are negative.  See IMixerInteractivityModule::GetStartupTimings.
+*/
+struct FMixerStartupTimings
+{
+	/** Access token obtained (OAuth token refresh/exchange, or XToken retrieval) */
+	float TokenAcquired;
+
+	/** Local user fetched from /users/current */
+	float UserFetched;
+
+	/** Interactive hosts known, either from the cache or a lookup */
+	float HostsDiscovered;
+
+	/** Interactive connection attempt begun */
+	float ConnectionStarted;
+
+	/** Interactive connection established */
+	float InteractiveConnected;
+
+	/** Fully logged in - see IMixerInteractivityModule::GetLoginState */
+	float LoggedIn;
+
+	FMixerStartupTimings()
+		: TokenAcquired(-1.0f)
+		, UserFetched(-1.0f)
+		, HostsDiscovered(-1.0f)
+		, ConnectionStarted(-1.0f)
+		, InteractiveConnected(-1.0f)
+		, LoggedIn(-1.0f)
+	{
+	}
+};
+
+/** Kinds of control input for which latency is tracked separately.  See IMixerInteractivityModule::GetInputLatency. */
+enum class EMixerInputLatencyClass : uint8
+{
+	Button,
+	Stick,
+	Textbox,
+	CustomControl,
+
+	Count
+};
+
+/**
+* Distribution of the time between input arriving at the plugin (the websocket frame for the UE backend,
+* the SDK callback for interactive-cpp-v2) and it reaching gameplay, in milliseconds.
+* Percentiles are read from a histogram with buckets about 25% apart, so they are upper bounds of that precision.
+*/
+struct FMixerInputLatencyStats
+{
+	int32 NumSamples;
+	float MeanMs;
+	float P50Ms;
+	float P95Ms;
+	float P99Ms;
+	float MaxMs;
+
+	FMixerInputLatencyStats()
+		: NumSamples(0)
+		, MeanMs(0.0f)
+		, P50Ms(0.0f)
+		, P95Ms(0.0f)
+		, P99Ms(0.0f)
+		, MaxMs(0.0f)
+	{
+	}
+};
+
+/**
+* State of input sampling (see UMixerInteractivitySettings::bSampleInputUnderLoad).  While the stride is above 1
+* the input delegates see only a share of each control's input.  DownCount includes the events that were skipped,
+* trailing the true count by the presses skipped since the last one kept (Stride - 1 per button on average).  PressCount and joystick aggregates only cover
+* participants whose input was kept, so use the helpers below to scale counts.  FMixerStickAggregate::MeanStandardError
+* bounds the sampled mean.
+*/
+struct FMixerInputSamplingState
+{
+	/** One event in this many, per control, is dispatched.  1 when sampling is off or idle. */
+	int32 Stride;
+
+	/** Input events arriving per frame, smoothed */
+	float ArrivalsPerFrame;
+
+	FMixerInputSamplingState()
+		: Stride(1)
+		, ArrivalsPerFrame(0.0f)
+	{
+	}
+
+	float GetRate() const										{ return 1.0f / Stride; }
+
+	/** Scale a count that only covers dispatched input, such as PressCount, to an estimate for the whole audience. */
+	float EstimateCount(int32 SampledCount) const				{ return static_cast<float>(SampledCount) * Stride; }
+
+	/** Standard error of EstimateCount, treating each participant's input as kept with probability 1 / Stride. */
+	float GetCountStandardError(int32 SampledCount) const		{ return FMath::Sqrt(static_cast<float>(SampledCount) * Stride * (Stride - 1)); }
+};
+
 /** Additional information about a button event */
 struct FMixerButtonEventDetails
 {
@@ -216,7 +864,7 @@ struct FMixerButtonEventDetails
 struct FMixerTextboxEventDetails
 {
 	/** Text that was submitted via the textbox */
-	FText SubmittedText;
+	FMixerLazyText SubmittedText;
 
 	/**
 	* Id for the Spark transaction associated with this textbox event (empty if none).
@@ -236,7 +884,7 @@ struct FMixerTextboxEventDetails
 struct FMixerLabelDescription
 {
 	/* Text shown on the label */
-	FText Text;
+	FMixerLazyText Text;
 
 	/* Size of text shown on the label - supports CSS font-size values */
 	FString TextSize;
@@ -261,10 +909,10 @@ struct FMixerLabelDescription
 struct FMixerTextboxDescription
 {
 	/* Hint text displayed inside an empty textbox to prompt for user text entry */
-	FText Placeholder;
+	FMixerLazyText Placeholder;
 
 	/* Text displayed on the associated submit button (if in use) */
-	FText SubmitText;
+	FMixerLazyText SubmitText;
 
 	/* Number of Sparks a remote user will be charged for submitting text via this box */
 	uint32 SparkCost;
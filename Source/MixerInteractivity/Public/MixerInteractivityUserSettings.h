@@ -25,6 +25,22 @@ public:
 	UPROPERTY(Transient)
 	FString AccessToken;
 
+	/** Interactive host that answered fastest last time we connected.  Tried first next time. */
+	UPROPERTY(Config)
+	FString PreferredInteractiveEndpoint;
+
+	/** Chat host that answered fastest last time we connected.  Tried first next time. */
+	UPROPERTY(Config)
+	FString PreferredChatEndpoint;
+
+	/** Interactive hosts returned by the last successful lookup. */
+	UPROPERTY(Config)
+	TArray<FString> CachedInteractiveHosts;
+
+	/** When CachedInteractiveHosts was looked up, in seconds since the Unix epoch (UTC). */
+	UPROPERTY(Config)
+	int64 CachedInteractiveHostsTimestamp;
+
 public:
 
 	FString GetAuthZHeaderValue() const
@@ -33,4 +49,15 @@ public:
 			? FString(TEXT("Bearer ")) + AccessToken
 			: AccessToken;
 	}
+
+	/**
+	* Save config without blocking the game thread on disk.  Calls made close together are
+	* coalesced into one write, which happens on a worker thread shortly after the last of them
+	* (or after a few seconds if they keep coming).
+	* Values are visible through GConfig straight away.
+	*/
+	void SaveConfigDeferred();
+
+	/** Perform any deferred save now and wait for it to reach disk.  Called at module shutdown. */
+	static void FlushDeferredSave();
 };
\ No newline at end of file
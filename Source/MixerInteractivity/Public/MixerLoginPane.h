@@ -36,6 +36,22 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Mixer")
 	bool AllowSilentLogin;
 
+	/**
+	* Whether to wait for StartLoginFlow to be called rather than starting login as soon as the pane is shown.
+	* No web browser is created until then (or until PrewarmBrowser is called).
+	*/
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Mixer")
+	bool DeferLoginFlow;
+
+public:
+	/** Begin login, creating the web browser if necessary.  Only needed when DeferLoginFlow is set. */
+	UFUNCTION(BlueprintCallable, Category = "Mixer")
+	void StartLoginFlow();
+
+	/** Hint that StartLoginFlow is likely to be called soon, so that the web browser can be created ahead of time. */
+	UFUNCTION(BlueprintCallable, Category = "Mixer")
+	void PrewarmBrowser();
+
 public:
 	/** Called when an OAuth authorization code has been obtained (note: full login is not yet complete). */
 	UPROPERTY(BlueprintAssignable, Category = "Mixer|Event")
@@ -71,4 +87,5 @@ private:
 
 private:
 	TSharedPtr<SWidget> MyLoginPane;
+	TSharedPtr<SMixerLoginPane> MyMixerLoginPane;
 };
\ No newline at end of file
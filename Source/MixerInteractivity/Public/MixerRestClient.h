@@ -0,0 +1,136 @@
+//*********************************************************
+//
+// Copyright (c) Microsoft. All rights reserved.
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT.
+//
+//*********************************************************
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Interfaces/IHttpRequest.h"
+#include "Interfaces/IHttpResponse.h"
+
+/** Running totals for one Mixer REST endpoint (verb plus path, with ids collapsed). */
+struct FMixerRestEndpointStats
+{
+public:
+	/** Requests that actually went out over the wire */
+	int32 Requests;
+
+	/** Requests that were satisfied by joining an identical GET already in flight */
+	int32 Coalesced;
+
+	/** Conditional GETs that came back 304 and were answered from the cache */
+	int32 CacheHits;
+
+	/** Wire time, in seconds */
+	double TotalLatency;
+	double MaxLatency;
+	double LastLatency;
+
+	FMixerRestEndpointStats()
+		: Requests(0)
+		, Coalesced(0)
+		, CacheHits(0)
+		, TotalLatency(0.0)
+		, MaxLatency(0.0)
+		, LastLatency(0.0)
+	{
+	}
+
+	double GetAverageLatency() const { return Requests > 0 ? TotalLatency / Requests : 0.0; }
+};
+
+/**
+* Single path for calls to the Mixer REST API.  Callers build a request with CreateRequest, bind
+* its completion delegate as usual, then hand it to ProcessRequest instead of calling
+* IHttpRequest::ProcessRequest directly.  Requests all carry the same host and keep-alive headers,
+* so the engine's HTTP layer can keep reusing a warm connection.  Concurrent identical
+* GETs are merged into one, responses carrying an ETag are revalidated with If-None-Match,
+* and wire time is recorded per endpoint.
+*
+* The request a caller holds is only a handle; cancelling it (after unbinding its delegate, as
+* usual) detaches that caller without disturbing anyone else waiting on the same response.
+*/
+class MIXERINTERACTIVITY_API FMixerRestClient
+{
+public:
+	static FMixerRestClient& Get();
+
+	/**
+	* Create a request for Path, relative to the API root (e.g. TEXT("users/current")).  The
+	* Authorization header is set when AuthZHeaderValue is non-empty.
+	*/
+	TSharedRef<IHttpRequest> CreateRequest(const FString& Verb, const FString& Path, const FString& AuthZHeaderValue = FString()) const;
+
+	/** Full URL for Path, relative to the API root, for resources fetched other than through CreateRequest (e.g. images). */
+	static FString GetApiUrl(const FString& Path);
+
+	/** Full URL for Path, relative to the root of the site the API is served from (e.g. for builtin emoticon sheets). */
+	static FString GetSiteUrl(const FString& Path);
+
+	/**
+	* Send a request created by CreateRequest.  Its completion delegate receives the handle it was
+	* bound on; for a 304 it receives the cached 200 response instead.
+	* @return	false if the request could not be sent, in which case the delegate is not called.
+	*/
+	bool ProcessRequest(TSharedRef<IHttpRequest> Request);
+
+	const TMap<FString, FMixerRestEndpointStats>& GetEndpointStats() const { return EndpointStats; }
+
+	/**
+	* Complete calls whose responses arrived while a frame time budget is set (see
+	* UMixerInteractivitySettings::FrameBudgetMilliseconds), as far as this frame's share allows.
+	* Called from the module tick.
+	*/
+	void DeliverDeferredCompletions();
+
+	/** Whether DeliverDeferredCompletions has anything to deliver. */
+	bool HasDeferredCompletions() const { return DeferredCompletions.Num() > 0; }
+
+	/** Cancel everything in flight without notifying callers, and forget cached responses. */
+	void Reset();
+
+private:
+	struct FPendingRequest
+	{
+		FHttpRequestPtr WireRequest;
+		TArray<FHttpRequestPtr> Callers;
+		FString Endpoint;
+		double StartTime;
+		bool bCacheable;
+	};
+
+	struct FCachedResponse
+	{
+		// The request is held too since some platforms' responses refer back to it
+		FHttpRequestPtr Request;
+		FHttpResponsePtr Response;
+		FString ETag;
+		double LastUsedTime;
+	};
+
+	struct FDeferredCompletion
+	{
+		FHttpRequestPtr Caller;
+		FHttpResponsePtr Response;
+		bool bSucceeded;
+	};
+
+	void OnWireRequestComplete(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, FString Key);
+	static void CompleteCaller(const FHttpRequestPtr& Caller, const FHttpResponsePtr& Response, bool bSucceeded);
+	void StoreCachedResponse(const FString& Key, FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, const FString& ETag);
+	static FString GetEndpointName(const FString& Verb, const FString& Url);
+
+private:
+	TMap<FString, FPendingRequest> PendingRequests;
+	TMap<FString, FCachedResponse> CachedResponses;
+	TMap<FString, FMixerRestEndpointStats> EndpointStats;
+	TArray<FDeferredCompletion> DeferredCompletions;
+	uint32 NextUniqueKey;
+
+	FMixerRestClient() : NextUniqueKey(0) {}
+};
@@ -11,6 +11,41 @@
 
 #include "Interfaces/OnlineChatInterface.h"
 
+/** Kind of content a run of a Mixer chat message body came from */
+enum class EChatMessageSegmentMixer : uint8
+{
+	Text,
+	Emoticon,
+	Link,
+	Tag,
+	Other,
+	Image,
+};
+
+/** A run of a Mixer chat message body, as a range into GetBody() */
+struct FChatMessageSegmentMixer
+{
+	EChatMessageSegmentMixer Type;
+	int32 Start;
+	int32 Len;
+
+	/** Index into FChatMessageMixer::GetImages() of the picture to show in place of the text, or INDEX_NONE */
+	int32 ImageIndex;
+};
+
+/**
+* Picture referenced by a Mixer chat message, such as an emoticon.  Fetch it through
+* FMixerImageCache rather than directly, so that every overlay shares one download and texture.
+*/
+struct FChatMessageImageMixer
+{
+	/** Image to fetch.  For emoticons this is the pack's whole sprite sheet. */
+	FString Url;
+
+	/** Pixels of the image making up the picture.  Empty for the whole image. */
+	FIntRect SourceRect;
+};
+
 /**
 * Implementation of FChatMessage for messages received via Mixer.
 * See FChatMessage for interface method details.
@@ -26,6 +61,24 @@ public:
 
 	/** Check whether a moderator has removed this message after it was originally sent */
 	virtual bool IsModerated() const = 0;
+
+	/** Get the runs of text, emoticons, links and tags that the body is made up of.  Empty once moderated. */
+	virtual TArrayView<const FChatMessageSegmentMixer> GetSegments() const = 0;
+
+	/** Get the pictures that segments refer to via ImageIndex.  Empty once moderated. */
+	virtual TArrayView<const FChatMessageImageMixer> GetImages() const = 0;
+
+	/**
+	* Get the body as rich text markup (as parsed by SRichTextBlock's default parser), built once as
+	* the message arrives so that chat widgets can rebuild without reparsing.  Text segments are
+	* escaped, and the others wrapped as
+	*	<mixer.emote image="N">text</>		N indexes GetImages(), and is left out if there's no picture
+	*	<mixer.image image="N">text</>
+	*	<mixer.link href="url">text</>
+	*	<mixer.mention id="userid">text</>
+	* Empty once moderated.
+	*/
+	virtual const FString& GetRichText() const = 0;
 };
 
 /** Represents a vote taking place in a Mixer channel*/
@@ -49,10 +102,78 @@ public:
 	/** Get the number of votes cast so far for a specific answer to the poll question */
 	virtual int32 GetNumVotersForAnswer(int32 Index) const = 0;
 
+	/** Get the vote counts for every answer, indexed as for GetAnswer */
+	virtual TArrayView<const int32> GetVoteTallies() const = 0;
+
 	/** Get the server time at which this poll will end. */
 	virtual FDateTime GetEndTime() const = 0;
 };
 
+/**
+* How long each phase of joining a Mixer chat room took, in seconds since the join was started.
+* Phases not reached yet are negative.
+*/
+struct FChatRoomBootstrapTimingsMixer
+{
+	float ChannelResolved;
+	float ServersDiscovered;
+	float EndpointsRanked;
+	float SocketConnected;
+	float Authenticated;
+	float HistoryReceived;
+	float FirstMessage;
+
+	FChatRoomBootstrapTimingsMixer()
+		: ChannelResolved(-1.0f)
+		, ServersDiscovered(-1.0f)
+		, EndpointsRanked(-1.0f)
+		, SocketConnected(-1.0f)
+		, Authenticated(-1.0f)
+		, HistoryReceived(-1.0f)
+		, FirstMessage(-1.0f)
+	{
+	}
+};
+
+/** How a chat trigger's pattern is matched against message bodies.  Matching is case insensitive. */
+enum class EChatTriggerMatchMixer : uint8
+{
+	/** The message starts with the pattern as a whole word, e.g. "!vote".  The rest of the message is passed as arguments. */
+	Command,
+
+	/** The pattern appears anywhere in the message as a whole word or phrase.  No arguments are passed. */
+	Keyword,
+};
+
+/** Description of a chat command or keyword to react to.  See IOnlineChatMixer::AddChatTrigger. */
+struct FChatTriggerMixer
+{
+	FString Pattern;
+	EChatTriggerMatchMixer Match;
+
+	/** Minimum time between firings of this trigger, across all users. */
+	FTimespan Cooldown;
+
+	/** Minimum time between firings of this trigger for any one user. */
+	FTimespan PerUserCooldown;
+
+	FChatTriggerMixer()
+		: Match(EChatTriggerMatchMixer::Command)
+		, Cooldown(0)
+		, PerUserCooldown(0)
+	{
+	}
+};
+
+/**
+* Delegate used when a room chat message matches a registered trigger
+*
+* @param RoomId room the message was sent in
+* @param Message the matching message
+* @param Arguments for command triggers, the remainder of the message after the command
+*/
+DECLARE_DELEGATE_ThreeParams(FOnChatTriggerMixer, const FChatRoomId& /*RoomId*/, const FChatMessageMixer& /*Message*/, const FString& /*Arguments*/);
+
 /**
 * Delegate used when all messages in a chat room are deleted
 *
@@ -62,6 +183,31 @@ public:
 DECLARE_MULTICAST_DELEGATE_TwoParams(FOnChatRoomMessagesCleared, const FUniqueNetId& /*UserId*/, const FChatRoomId& /*RoomId*/);
 typedef FOnChatRoomMessagesCleared::FDelegate FOnChatRoomMessagesClearedDelegate;
 
+/**
+* Delegate used when a chat room's message history has been loaded from the server, in a single batch
+*
+* @param UserId user currently in the room
+* @param RoomId room that member is in
+* @param NumMessages number of messages from the server that were added to the history
+*/
+DECLARE_MULTICAST_DELEGATE_ThreeParams(FOnChatRoomHistoryLoaded, const FUniqueNetId& /*UserId*/, const FChatRoomId& /*RoomId*/, int32 /*NumMessages*/);
+typedef FOnChatRoomHistoryLoaded::FDelegate FOnChatRoomHistoryLoadedDelegate;
+
+/**
+* Delegate used once per tick when members have joined or left a chat room, e.g. so that a member list
+* rebuilds once for a whole raid.  Joins and leaves are also reported individually through
+* OnChatRoomMemberJoin and OnChatRoomMemberExit.  With
+* UMixerInteractivitySettings::ChatMembershipCoalesceWindow set, a user who joins and leaves again
+* (or leaves and rejoins) within the window is in neither list, and isn't reported individually either.
+*
+* @param UserId user currently in the room
+* @param RoomId room that members joined or left
+* @param Joined members that joined
+* @param Exited members that left
+*/
+DECLARE_MULTICAST_DELEGATE_FourParams(FOnChatRoomMembersChanged, const FUniqueNetId& /*UserId*/, const FChatRoomId& /*RoomId*/, const TArray<TSharedRef<const FUniqueNetId>>& /*Joined*/, const TArray<TSharedRef<const FUniqueNetId>>& /*Exited*/);
+typedef FOnChatRoomMembersChanged::FDelegate FOnChatRoomMembersChangedDelegate;
+
 /**
 * Delegate used when a user is purged from a chat room (all messages deleted)
 *
@@ -92,6 +238,19 @@ typedef FOnChatRoomPollStart::FDelegate FOnChatRoomPollStartDelegate;
 DECLARE_MULTICAST_DELEGATE_ThreeParams(FOnChatRoomPollUpdate, const FUniqueNetId& /*UserId*/, const FChatRoomId& /*RoomId*/, const TSharedRef<FChatPollMixer>& /*ChatPoll*/);
 typedef FOnChatRoomPollUpdate::FDelegate FOnChatRoomPollUpdateDelegate;
 
+/**
+* Delegate used when the vote count for one answer of a poll in a Mixer chat channel changes.
+* Fired once per changed answer, before the OnChatRoomPollUpdate for the same server update.
+*
+* @param UserId user currently in the room
+* @param RoomId room that member is in
+* @param ChatPoll object representing the poll that has been updated
+* @param AnswerIndex index of the answer whose count moved
+* @param Delta change in the answer's vote count since the previous update
+*/
+DECLARE_MULTICAST_DELEGATE_FiveParams(FOnChatRoomPollAnswerUpdate, const FUniqueNetId& /*UserId*/, const FChatRoomId& /*RoomId*/, const TSharedRef<FChatPollMixer>& /*ChatPoll*/, int32 /*AnswerIndex*/, int32 /*Delta*/);
+typedef FOnChatRoomPollAnswerUpdate::FDelegate FOnChatRoomPollAnswerUpdateDelegate;
+
 /**
 * Delegate used when a poll ends in a Mixer chat channel
 *
@@ -138,10 +297,56 @@ public:
 	*/
 	virtual bool VoteInPoll(const FUniqueNetId& UserId, const FChatRoomId& RoomId, const FChatPollMixer& Poll, int32 AnswerIndex) = 0;
 
+	/**
+	* Walk the cached message history for a room, newest first, without copying it into an array.
+	* Messages are only valid for the duration of the visitor call.
+	*
+	* @param UserId			id of the user that joined the room
+	* @param RoomId			id of the room.  For Mixer chat this is the owning user name.
+	* @param NumMessages	maximum number of messages to visit, or -1 for all of them.
+	* @param Visitor		called once per message; return false to stop early.
+	*
+	* @return				whether or not the room was found.
+	*/
+	virtual bool VisitLastMessages(const FUniqueNetId& UserId, const FChatRoomId& RoomId, int32 NumMessages, TFunctionRef<bool(const FChatMessageMixer&)> Visitor) = 0;
+
+	/**
+	* Query the state of a room's outbound queue (see UMixerInteractivitySettings::bQueueOutboundChat).
+	*
+	* @param UserId				id of the user that joined the room
+	* @param RoomId				id of the room.  For Mixer chat this is the owning user name.
+	* @param OutQueueDepth		number of sends waiting for the rate limit.
+	* @param OutSendLatency		time the most recently released send spent waiting in the queue, in seconds.
+	*
+	* @return					whether or not the room was found.
+	*/
+	virtual bool GetOutboundChatQueueState(const FUniqueNetId& UserId, const FChatRoomId& RoomId, int32& OutQueueDepth, float& OutSendLatency) = 0;
+
+	/** Get the duration of each phase of joining a room, e.g. to track time to first chat message.  Returns false if the room was not found. */
+	virtual bool GetRoomBootstrapTimings(const FUniqueNetId& UserId, const FChatRoomId& RoomId, FChatRoomBootstrapTimingsMixer& OutTimings) = 0;
+
+	/**
+	* Register a command or keyword to react to in room chat.  All registered triggers are matched in a
+	* single pass over each incoming message, and only the matching ones are called.  A trigger fires at
+	* most once per message.
+	*
+	* @param Trigger	pattern to match and cooldowns to apply.
+	* @param Delegate	called for each matching message that isn't suppressed by a cooldown.
+	*
+	* @return			handle for RemoveChatTrigger, or 0 if the pattern was empty.
+	*/
+	virtual int32 AddChatTrigger(const FChatTriggerMixer& Trigger, const FOnChatTriggerMixer& Delegate) = 0;
+
+	/** Unregister a trigger previously returned by AddChatTrigger.  Safe to call from within its delegate. */
+	virtual void RemoveChatTrigger(int32 TriggerHandle) = 0;
+
 	DEFINE_ONLINE_DELEGATE_TWO_PARAM(OnChatRoomMessagesCleared, const FUniqueNetId&, const FChatRoomId&);
+	DEFINE_ONLINE_DELEGATE_THREE_PARAM(OnChatRoomHistoryLoaded, const FUniqueNetId&, const FChatRoomId&, int32);
 	DEFINE_ONLINE_DELEGATE_THREE_PARAM(OnChatRoomUserPurged, const FUniqueNetId&, const FChatRoomId&, const FUniqueNetId&);
+	DEFINE_ONLINE_DELEGATE_FOUR_PARAM(OnChatRoomMembersChanged, const FUniqueNetId&, const FChatRoomId&, const TArray<TSharedRef<const FUniqueNetId>>&, const TArray<TSharedRef<const FUniqueNetId>>&);
 	DEFINE_ONLINE_DELEGATE_THREE_PARAM(OnChatRoomPollStart, const FUniqueNetId&, const FChatRoomId&, const TSharedRef<FChatPollMixer>&);
 	DEFINE_ONLINE_DELEGATE_THREE_PARAM(OnChatRoomPollUpdate, const FUniqueNetId&, const FChatRoomId&, const TSharedRef<FChatPollMixer>&);
+	DEFINE_ONLINE_DELEGATE_FIVE_PARAM(OnChatRoomPollAnswerUpdate, const FUniqueNetId&, const FChatRoomId&, const TSharedRef<FChatPollMixer>&, int32, int32);
 	DEFINE_ONLINE_DELEGATE_THREE_PARAM(OnChatRoomPollEnd, const FUniqueNetId&, const FChatRoomId&, const TSharedRef<FChatPollMixer>&);
 
 };
\ No newline at end of file
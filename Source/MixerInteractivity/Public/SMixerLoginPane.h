@@ -35,12 +35,19 @@ public:
 		: _UserId()
 		, _BackgroundColor(0, 0, 0, 255)
 		, _AllowSilentLogin(false)
+		, _DeferLoginFlow(false)
 	{}
 		SLATE_ATTRIBUTE(TSharedPtr<const FUniqueNetId>, UserId)
 
 		/** Whether to attempt automatic signin before displaying UI. */
 		SLATE_ARGUMENT(bool, AllowSilentLogin)
 
+		/**
+		* Whether to wait for an explicit call to StartLoginFlow rather than starting as soon as the pane is
+		* constructed.  No web browser is created until then (or until PrewarmBrowser is called).
+		*/
+		SLATE_ARGUMENT(bool, DeferLoginFlow)
+
 		/** Background color for web browser control when no document color is specified. */
 		SLATE_ARGUMENT(FColor, BackgroundColor)
 
@@ -55,6 +62,12 @@ public:
 	void StartLoginFlow();
 	void StopLoginFlowAndHide();
 
+	/**
+	* Hint that StartLoginFlow is likely to be called soon.  Creates the web browser ahead of time
+	* so that its startup cost isn't paid when the login UI is actually shown.
+	*/
+	void PrewarmBrowser();
+
 	virtual FVector2D ComputeDesiredSize(float) const override;
 
 private:
@@ -72,6 +85,8 @@ private:
 	bool OnPopupBeforeNavigation(const FString& NewUrlString, const FWebNavigationRequest& Request, bool IsSecondaryPopup);
 
 	void StartLoginFlowAfterCookiesDeleted();
+	void CreateBrowserWidget();
+	void ReleaseBrowserWidget();
 
 	TSharedPtr<SOverlay> OverlayWidget;
 	TSharedPtr<SWebBrowserView> BrowserWidget;
@@ -83,4 +98,6 @@ private:
 
 	bool bAllowSilentLogin;
 	bool bAttemptedSilentLogin;
+	bool bDeferLoginFlow;
+	bool bLoginFlowStarted;
 };
\ No newline at end of file
@@ -0,0 +1,121 @@
+//*********************************************************
+//
+// Copyright (c) Microsoft. All rights reserved.
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT.
+//
+//*********************************************************
+
+#include "K2Node_MixerBatchedButtonEvent.h"
+#include "BlueprintActionDatabaseRegistrar.h"
+#include "BlueprintNodeSpawner.h"
+#include "EditorCategoryUtils.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "KismetCompiler.h"
+#include "MixerDynamicDelegateBinding.h"
+#include "MixerInteractivitySettings.h"
+#include "MixerInteractivityJsonTypes.h"
+
+#define LOCTEXT_NAMESPACE "MixerInteractivityEditor"
+
+void UK2Node_MixerBatchedButtonEvent::ValidateNodeDuringCompilation(class FCompilerResultsLog& MessageLog) const
+{
+	Super::ValidateNodeDuringCompilation(MessageLog);
+
+	if (!UMixerInteractivitySettings::HasControl(FMixerInteractiveControl::ButtonKind, ButtonId.ToString()))
+	{
+		MessageLog.Warning(*FText::Format(LOCTEXT("MixerBatchedButtonNode_UnknownButtonWarning", "Mixer Batched Button Event specifies invalid button id '{0}' for @@"), FText::FromName(ButtonId)).ToString(), this);
+	}
+}
+
+void UK2Node_MixerBatchedButtonEvent::GetMenuActions(FBlueprintActionDatabaseRegistrar& ActionRegistrar) const
+{
+	auto CustomizeMixerNodeLambda = [](UEdGraphNode* NewNode, bool bIsTemplateNode, FName ButtonName, bool bPressed)
+	{
+		UK2Node_MixerBatchedButtonEvent* MixerNode = CastChecked<UK2Node_MixerBatchedButtonEvent>(NewNode);
+		MixerNode->ButtonId = ButtonName;
+		MixerNode->Pressed = bPressed;
+		MixerNode->CustomFunctionName = FName(*FString::Printf(TEXT("MixerButtonBatchEvt_%s_%s"), *ButtonName.ToString(), bPressed ? TEXT("Pressed") : TEXT("Released")));
+		MixerNode->EventReference.SetExternalDelegateMember(FName(TEXT("MixerButtonBatchEventDynamicDelegate__DelegateSignature")));
+	};
+
+	UClass* ActionKey = GetClass();
+	if (ActionRegistrar.IsOpenForRegistration(ActionKey))
+	{
+		TArray<FString> Buttons;
+		UMixerInteractivitySettings::GetAllControls(FMixerInteractiveControl::ButtonKind, Buttons);
+		for (const FString& ButtonName : Buttons)
+		{
+			UBlueprintNodeSpawner* PressedSpawner = UBlueprintNodeSpawner::Create(GetClass());
+			PressedSpawner->CustomizeNodeDelegate = UBlueprintNodeSpawner::FCustomizeNodeDelegate::CreateStatic(CustomizeMixerNodeLambda, FName(*ButtonName), true);
+			ActionRegistrar.AddBlueprintAction(ActionKey, PressedSpawner);
+
+			UBlueprintNodeSpawner* ReleasedSpawner = UBlueprintNodeSpawner::Create(GetClass());
+			ReleasedSpawner->CustomizeNodeDelegate = UBlueprintNodeSpawner::FCustomizeNodeDelegate::CreateStatic(CustomizeMixerNodeLambda, FName(*ButtonName), false);
+			ActionRegistrar.AddBlueprintAction(ActionKey, ReleasedSpawner);
+		}
+	}
+}
+
+FText UK2Node_MixerBatchedButtonEvent::GetMenuCategory() const
+{
+	return LOCTEXT("MixerBatchedButtonNode_MenuCategory", "{MixerInteractivity}|Button Events");
+}
+
+FBlueprintNodeSignature UK2Node_MixerBatchedButtonEvent::GetSignature() const
+{
+	FBlueprintNodeSignature NodeSignature = Super::GetSignature();
+	NodeSignature.AddKeyValue(ButtonId.ToString());
+	NodeSignature.AddKeyValue(Pressed ? TEXT("Pressed") : TEXT("Released"));
+
+	return NodeSignature;
+}
+
+FText UK2Node_MixerBatchedButtonEvent::GetNodeTitle(ENodeTitleType::Type TitleType) const
+{
+	if (CachedNodeTitle.IsOutOfDate(this))
+	{
+		// FText::Format() is slow, so we cache this to save on performance
+		CachedNodeTitle.SetCachedText(Pressed
+			? FText::Format(LOCTEXT("MixerBatchedButtonNode_PressedTitle", "{0} Pressed (Mixer button, batched)"), FText::FromName(ButtonId))
+			: FText::Format(LOCTEXT("MixerBatchedButtonNode_ReleasedTitle", "{0} Released (Mixer button, batched)"), FText::FromName(ButtonId)), this);
+	}
+	return CachedNodeTitle;
+}
+
+FText UK2Node_MixerBatchedButtonEvent::GetTooltipText() const
+{
+	if (CachedTooltip.IsOutOfDate(this))
+	{
+		CachedTooltip.SetCachedText(Pressed
+			? FText::Format(LOCTEXT("MixerBatchedButtonNode_PressedTooltip", "Fires at most once per frame with every participant that pressed the {0} button on Mixer during that frame.  Count includes repeated presses."), FText::FromName(ButtonId))
+			: FText::Format(LOCTEXT("MixerBatchedButtonNode_ReleasedTooltip", "Fires at most once per frame with every participant that released the {0} button on Mixer during that frame.  Count includes repeated releases."), FText::FromName(ButtonId)), this);
+	}
+	return CachedTooltip;
+}
+
+FSlateIcon UK2Node_MixerBatchedButtonEvent::GetIconAndTint(FLinearColor& OutColor) const
+{
+	return FSlateIcon("EditorStyle", "GraphEditor.PadEvent_16x");
+}
+
+UClass* UK2Node_MixerBatchedButtonEvent::GetDynamicBindingClass() const
+{
+	return UMixerDelegateBinding::StaticClass();
+}
+
+void UK2Node_MixerBatchedButtonEvent::RegisterDynamicBinding(UDynamicBlueprintBinding* BindingObject) const
+{
+	FMixerButtonEventBinding BindingInfo;
+	BindingInfo.TargetFunctionName = CustomFunctionName;
+	BindingInfo.ButtonId = ButtonId;
+	BindingInfo.Pressed = Pressed;
+	BindingInfo.bBatched = true;
+
+	UMixerDelegateBinding* MixerBindingObject = CastChecked<UMixerDelegateBinding>(BindingObject);
+	MixerBindingObject->AddButtonBinding(BindingInfo);
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -29,9 +29,7 @@ void UK2Node_MixerButton::ValidateNodeDuringCompilation(class FCompilerResultsLo
 {
 	Super::ValidateNodeDuringCompilation(MessageLog);
 
-	TArray<FString> Buttons;
-	UMixerInteractivitySettings::GetAllControls(FMixerInteractiveControl::ButtonKind, Buttons);
-	if (!Buttons.Contains(ButtonId.ToString()))
+	if (!UMixerInteractivitySettings::HasControl(FMixerInteractiveControl::ButtonKind, ButtonId.ToString()))
 	{
 		MessageLog.Warning(*FText::Format(LOCTEXT("MixerButtonNode_UnknownButtonWarning", "Mixer Button Event specifies invalid button id '{0}' for @@"), FText::FromName(ButtonId)).ToString(), this);
 	}
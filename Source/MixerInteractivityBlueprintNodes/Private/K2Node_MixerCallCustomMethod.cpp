@@ -0,0 +1,186 @@
+//*********************************************************
+//
+// Copyright (c) Microsoft. All rights reserved.
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT.
+//
+//*********************************************************
+#include "K2Node_MixerCallCustomMethod.h"
+
+#include "MixerInteractivityBlueprintLibrary.h"
+#include "MixerInteractivitySettings.h"
+#include "BlueprintNodeSpawner.h"
+#include "BlueprintActionDatabaseRegistrar.h"
+#include "KismetCompiler.h"
+#include "K2Node_CallFunction.h"
+
+#define LOCTEXT_NAMESPACE "MixerInteractivityEditor"
+
+void UK2Node_MixerCallCustomMethod::AllocateDefaultPins()
+{
+#if ENGINE_MINOR_VERSION >= 19
+	typedef FName FPinSubCategoryParamType;
+#else
+	typedef FString FPinSubCategoryParamType;
+#endif
+
+	const UEdGraphSchema_K2* K2Schema = GetDefault<UEdGraphSchema_K2>();
+
+	CreatePin(EGPD_Input, K2Schema->PC_Exec, FPinSubCategoryParamType(), nullptr, K2Schema->PN_Execute);
+	CreatePin(EGPD_Output, K2Schema->PC_Exec, FPinSubCategoryParamType(), nullptr, K2Schema->PN_Then);
+
+	UFunction* Signature = GetSignature();
+	if (Signature != nullptr)
+	{
+		// Same set of parameters as the inbound node unpacks
+		for (TFieldIterator<UProperty> PropIt(Signature); PropIt && (PropIt->PropertyFlags & CPF_Parm); ++PropIt)
+		{
+			FEdGraphPinType ParamType;
+			if ((!PropIt->HasAnyPropertyFlags(CPF_OutParm) || PropIt->HasAnyPropertyFlags(CPF_ReferenceParm)) && K2Schema->ConvertPropertyToPinType(*PropIt, ParamType))
+			{
+				UEdGraphPin* ParamPin = CreatePin(EGPD_Input, ParamType.PinCategory, FPinSubCategoryParamType(), nullptr, *PropIt->GetName());
+				ParamPin->PinType = ParamType;
+				ParamPin->PinType.bIsReference = false;
+			}
+		}
+	}
+
+	Super::AllocateDefaultPins();
+}
+
+FText UK2Node_MixerCallCustomMethod::GetNodeTitle(ENodeTitleType::Type TitleType) const
+{
+	if (CachedNodeTitle.IsOutOfDate(this))
+	{
+		// FText::Format() is slow, so we cache this to save on performance
+		CachedNodeTitle.SetCachedText(FText::Format(LOCTEXT("MixerCallCustomMethodNode_Title", "Call {0} (Mixer custom method)"), FText::FromName(MethodName)), this);
+	}
+	return CachedNodeTitle;
+}
+
+FText UK2Node_MixerCallCustomMethod::GetTooltipText() const
+{
+	if (CachedTooltip.IsOutOfDate(this))
+	{
+		CachedTooltip.SetCachedText(FText::Format(LOCTEXT("MixerCallCustomMethodNode_Tooltip", "Invoke the game-defined {0} method on the Mixer service."), FText::FromName(MethodName)), this);
+	}
+	return CachedTooltip;
+}
+
+void UK2Node_MixerCallCustomMethod::ExpandNode(class FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph)
+{
+	Super::ExpandNode(CompilerContext, SourceGraph);
+
+	const UEdGraphSchema_K2* K2Schema = CompilerContext.GetSchema();
+	if (GetSignature() == nullptr)
+	{
+		CompilerContext.MessageLog.Error(*LOCTEXT("MixerCallCustomMethodNode_MissingSignatureError", "@@ refers to a custom method that is no longer in the Custom Methods class.").ToString(), this);
+		BreakAllNodeLinks();
+		return;
+	}
+
+	auto SpawnHelperCall = [&](FName FunctionName)
+	{
+		UK2Node_CallFunction* HelperCall = CompilerContext.SpawnIntermediateNode<UK2Node_CallFunction>(this, SourceGraph);
+		HelperCall->FunctionReference.SetExternalMember(FunctionName, UMixerInteractivityBlueprintLibrary::StaticClass());
+		HelperCall->AllocateDefaultPins();
+		return HelperCall;
+	};
+
+	// Begin, one write per parameter, then send: each write puts its value straight into the outgoing params text
+	UK2Node_CallFunction* BeginCall = SpawnHelperCall(GET_FUNCTION_NAME_CHECKED(UMixerInteractivityBlueprintLibrary, BeginCustomMethodCall_Helper));
+	CompilerContext.MovePinLinksToIntermediate(*FindPinChecked(K2Schema->PN_Execute), *BeginCall->GetExecPin());
+	UEdGraphPin* PreviousThenPin = BeginCall->GetThenPin();
+
+	for (UEdGraphPin* ParamPin : Pins)
+	{
+		if (ParamPin->Direction != EGPD_Input || ParamPin->PinType.PinCategory == K2Schema->PC_Exec)
+		{
+			continue;
+		}
+
+		UK2Node_CallFunction* WriteCall = SpawnHelperCall(GET_FUNCTION_NAME_CHECKED(UMixerInteractivityBlueprintLibrary, WriteCustomMethodParam_Helper));
+		WriteCall->FindPinChecked(TEXT("ParamName"), EGPD_Input)->DefaultValue = ParamPin->GetName();
+
+		UEdGraphPin* ValuePin = WriteCall->FindPinChecked(TEXT("Value"), EGPD_Input);
+		const bool bValueIsReference = ValuePin->PinType.bIsReference;
+		ValuePin->PinType = ParamPin->PinType;
+		ValuePin->PinType.bIsReference = bValueIsReference;
+		CompilerContext.MovePinLinksToIntermediate(*ParamPin, *ValuePin);
+
+		K2Schema->TryCreateConnection(PreviousThenPin, WriteCall->GetExecPin());
+		PreviousThenPin = WriteCall->GetThenPin();
+	}
+
+	UK2Node_CallFunction* FinishCall = SpawnHelperCall(GET_FUNCTION_NAME_CHECKED(UMixerInteractivityBlueprintLibrary, FinishCustomMethodCall_Helper));
+	FinishCall->FindPinChecked(TEXT("MethodName"), EGPD_Input)->DefaultValue = MethodName.ToString();
+	K2Schema->TryCreateConnection(PreviousThenPin, FinishCall->GetExecPin());
+	CompilerContext.MovePinLinksToIntermediate(*FindPinChecked(K2Schema->PN_Then), *FinishCall->GetThenPin());
+
+	BreakAllNodeLinks();
+}
+
+FSlateIcon UK2Node_MixerCallCustomMethod::GetIconAndTint(FLinearColor& OutColor) const
+{
+	OutColor = GetNodeTitleColor();
+	static FSlateIcon Icon("EditorStyle", "Kismet.AllClasses.FunctionIcon");
+	return Icon;
+}
+
+void UK2Node_MixerCallCustomMethod::ValidateNodeDuringCompilation(class FCompilerResultsLog& MessageLog) const
+{
+	Super::ValidateNodeDuringCompilation(MessageLog);
+
+	if (GetSignature() == nullptr)
+	{
+		MessageLog.Warning(*FText::Format(LOCTEXT("MixerCallCustomMethodNode_UnknownMethodWarning", "Mixer Call Custom Method specifies unknown method '{0}' for @@"), FText::FromName(MethodName)).ToString(), this);
+	}
+}
+
+FText UK2Node_MixerCallCustomMethod::GetMenuCategory() const
+{
+	return LOCTEXT("MixerCallCustomMethodNode_MenuCategory", "{MixerInteractivity}|Custom Methods");
+}
+
+void UK2Node_MixerCallCustomMethod::GetMenuActions(FBlueprintActionDatabaseRegistrar& ActionRegistrar) const
+{
+	auto CustomizeMixerNodeLambda = [](UEdGraphNode* NewNode, bool bIsTemplateNode, FName InMethodName, UFunction* DelegateSignatureFunc)
+	{
+		UK2Node_MixerCallCustomMethod* MixerNode = CastChecked<UK2Node_MixerCallCustomMethod>(NewNode);
+		MixerNode->MethodName = InMethodName;
+		MixerNode->SignatureReference.SetExternalMember(DelegateSignatureFunc->GetFName(), DelegateSignatureFunc->GetOuterUClass());
+	};
+
+	UClass* ActionKey = GetClass();
+	if (ActionRegistrar.IsOpenForRegistration(ActionKey))
+	{
+		const FSoftClassPath& CustomMethodsPath = GetDefault<UMixerInteractivitySettings>()->CustomMethods;
+		if (CustomMethodsPath.IsValid())
+		{
+			UClass* CustomMethodsDefinition = CustomMethodsPath.TryLoadClass<UObject>();
+			if (CustomMethodsDefinition != nullptr)
+			{
+				for (UProperty* Prop = CustomMethodsDefinition->PropertyLink; Prop; Prop = Prop->PropertyLinkNext)
+				{
+					UMulticastDelegateProperty* MulticastProp = Cast<UMulticastDelegateProperty>(Prop);
+					if (MulticastProp != nullptr && MulticastProp->SignatureFunction != nullptr)
+					{
+						UBlueprintNodeSpawner* NodeSpawner = UBlueprintNodeSpawner::Create(GetClass());
+						check(NodeSpawner != nullptr);
+						NodeSpawner->CustomizeNodeDelegate = UBlueprintNodeSpawner::FCustomizeNodeDelegate::CreateStatic(CustomizeMixerNodeLambda, Prop->GetFName(), MulticastProp->SignatureFunction);
+						ActionRegistrar.AddBlueprintAction(ActionKey, NodeSpawner);
+					}
+				}
+			}
+		}
+	}
+}
+
+UFunction* UK2Node_MixerCallCustomMethod::GetSignature() const
+{
+	return SignatureReference.ResolveMember<UFunction>(static_cast<UClass*>(nullptr));
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -26,9 +26,7 @@ void UK2Node_MixerStickEvent::ValidateNodeDuringCompilation(class FCompilerResul
 {
 	Super::ValidateNodeDuringCompilation(MessageLog);
 
-	TArray<FString> Sticks;
-	UMixerInteractivitySettings::GetAllControls(FMixerInteractiveControl::JoystickKind, Sticks);
-	if (!Sticks.Contains(StickId.ToString()))
+	if (!UMixerInteractivitySettings::HasControl(FMixerInteractiveControl::JoystickKind, StickId.ToString()))
 	{
 		MessageLog.Warning(*FText::Format(LOCTEXT("MixerStickNode_UnknownStickWarning", "Mixer Stick Event specifies invalid stick id '{0}' for @@"), FText::FromName(StickId)).ToString(), this);
 	}
@@ -41,7 +39,7 @@ void UK2Node_MixerStickEvent::GetMenuActions(FBlueprintActionDatabaseRegistrar&
 		UK2Node_MixerStickEvent* MixerNode = CastChecked<UK2Node_MixerStickEvent>(NewNode);
 		MixerNode->StickId = *StickName;
 		MixerNode->CustomFunctionName = FName(*FString::Printf(TEXT("MixerStickEvt_%s"), *StickName));
-		MixerNode->EventReference.SetExternalDelegateMember(FName(TEXT("MixerStickEventDynamicDelegate__DelegateSignature")));
+		MixerNode->EventReference.SetExternalDelegateMember(GetSignatureName(MixerNode->Coalescing));
 	};
 
 	UClass* ActionKey = GetClass();
@@ -58,6 +56,28 @@ void UK2Node_MixerStickEvent::GetMenuActions(FBlueprintActionDatabaseRegistrar&
 	}
 }
 
+void UK2Node_MixerStickEvent::PostEditChangeProperty(struct FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	if (PropertyChangedEvent.GetPropertyName() == GET_MEMBER_NAME_CHECKED(UK2Node_MixerStickEvent, Coalescing))
+	{
+		// Crowd events carry a participant count rather than an id, so the pins need rebuilding
+		EventReference.SetExternalDelegateMember(GetSignatureName(Coalescing));
+		CachedNodeTitle.MarkDirty();
+		CachedTooltip.MarkDirty();
+		ReconstructNode();
+		FBlueprintEditorUtils::MarkBlueprintAsModified(GetBlueprint());
+	}
+}
+
+FName UK2Node_MixerStickEvent::GetSignatureName(EMixerStickEventCoalescing Coalescing)
+{
+	return Coalescing == EMixerStickEventCoalescing::CrowdAverage
+		? FName(TEXT("MixerStickCrowdEventDynamicDelegate__DelegateSignature"))
+		: FName(TEXT("MixerStickEventDynamicDelegate__DelegateSignature"));
+}
+
 FText UK2Node_MixerStickEvent::GetMenuCategory() const
 {
 	return LOCTEXT("MixerStickNode_MenuCategory", "{MixerInteractivity}|Stick Events");
@@ -68,7 +88,18 @@ FText UK2Node_MixerStickEvent::GetNodeTitle(ENodeTitleType::Type TitleType) cons
 	if (CachedNodeTitle.IsOutOfDate(this))
 	{
 		// FText::Format() is slow, so we cache this to save on performance
-		CachedNodeTitle.SetCachedText(FText::Format(LOCTEXT("MixerStickNode_Title", "{0} (Mixer stick)"), FText::FromName(StickId)), this);
+		switch (Coalescing)
+		{
+		case EMixerStickEventCoalescing::LatestPerParticipant:
+			CachedNodeTitle.SetCachedText(FText::Format(LOCTEXT("MixerStickNode_LatestTitle", "{0} (Mixer stick, per frame)"), FText::FromName(StickId)), this);
+			break;
+		case EMixerStickEventCoalescing::CrowdAverage:
+			CachedNodeTitle.SetCachedText(FText::Format(LOCTEXT("MixerStickNode_CrowdTitle", "{0} (Mixer stick, crowd average)"), FText::FromName(StickId)), this);
+			break;
+		default:
+			CachedNodeTitle.SetCachedText(FText::Format(LOCTEXT("MixerStickNode_Title", "{0} (Mixer stick)"), FText::FromName(StickId)), this);
+			break;
+		}
 	}
 	return CachedNodeTitle;
 }
@@ -77,7 +108,7 @@ FText UK2Node_MixerStickEvent::GetTooltipText() const
 {
 	if (CachedTooltip.IsOutOfDate(this))
 	{
-		CachedTooltip.SetCachedText(FText::Format(LOCTEXT("MixerStickNode_Tooltip", "Events for when the {0} stick is moved on Mixer."), FText::FromName(StickId)), this);
+		CachedTooltip.SetCachedText(FText::Format(LOCTEXT("MixerStickNode_Tooltip", "Events for when the {0} stick is moved on Mixer.  Set Coalescing in the node details to receive at most one call per frame."), FText::FromName(StickId)), this);
 	}
 	return CachedTooltip;
 }
@@ -97,7 +128,18 @@ void UK2Node_MixerStickEvent::RegisterDynamicBinding(UDynamicBlueprintBinding* B
 	FMixerGenericEventBinding BindingInfo;
 	BindingInfo.TargetFunctionName = CustomFunctionName;
 	BindingInfo.NameParam = StickId;
-	BindingInfo.BindingType = EMixerGenericEventBindingType::Stick;
+	switch (Coalescing)
+	{
+	case EMixerStickEventCoalescing::LatestPerParticipant:
+		BindingInfo.BindingType = EMixerGenericEventBindingType::StickLatestPerParticipant;
+		break;
+	case EMixerStickEventCoalescing::CrowdAverage:
+		BindingInfo.BindingType = EMixerGenericEventBindingType::StickCrowdAverage;
+		break;
+	default:
+		BindingInfo.BindingType = EMixerGenericEventBindingType::Stick;
+		break;
+	}
 
 	UMixerDelegateBinding* MixerBindingObject = CastChecked<UMixerDelegateBinding>(BindingObject);
 	MixerBindingObject->AddGenericBinding(BindingInfo);
@@ -25,9 +25,7 @@ void UK2Node_MixerTextSubmittedEvent::ValidateNodeDuringCompilation(class FCompi
 {
 	Super::ValidateNodeDuringCompilation(MessageLog);
 
-	TArray<FString> Textboxes;
-	UMixerInteractivitySettings::GetAllControls(FMixerInteractiveControl::TextboxKind, Textboxes);
-	if (!Textboxes.Contains(TextboxId.ToString()))
+	if (!UMixerInteractivitySettings::HasControl(FMixerInteractiveControl::TextboxKind, TextboxId.ToString()))
 	{
 		MessageLog.Warning(*FText::Format(LOCTEXT("MixerTextSubmittedNode_UnknownTextboxWarning", "Mixer Text Submitted Event specifies invalid textbox id '{0}' for @@"), FText::FromName(TextboxId)).ToString(), this);
 	}
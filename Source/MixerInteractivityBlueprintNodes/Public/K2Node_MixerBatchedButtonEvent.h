@@ -0,0 +1,54 @@
+//*********************************************************
+//
+// Copyright (c) Microsoft. All rights reserved.
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT.
+//
+//*********************************************************
+
+#pragma once
+
+#include "K2Node_Event.h"
+#include "EdGraph/EdGraphNodeUtils.h"
+#include "K2Node_MixerBatchedButtonEvent.generated.h"
+
+/**
+* Fires at most once per frame for a button, with every participant that pressed (or released) it during
+* that frame.  Cheaper than the per-press button event when a popular button is being spammed.
+*/
+UCLASS(MinimalAPI)
+class UK2Node_MixerBatchedButtonEvent : public UK2Node_Event
+{
+public:
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FName ButtonId;
+
+	UPROPERTY()
+	bool Pressed;
+
+	//~ Begin UK2Node Interface.
+	virtual bool ShouldShowNodeProperties() const override { return false; }
+	virtual void ValidateNodeDuringCompilation(class FCompilerResultsLog& MessageLog) const override;
+	virtual void GetMenuActions(FBlueprintActionDatabaseRegistrar& ActionRegistrar) const override;
+	virtual FText GetMenuCategory() const override;
+	virtual FBlueprintNodeSignature GetSignature() const override;
+	//~ End UK2Node Interface
+
+	//~ Begin UEdGraphNode Interface.
+	virtual FText GetNodeTitle(ENodeTitleType::Type TitleType) const override;
+	virtual FText GetTooltipText() const override;
+	virtual FSlateIcon GetIconAndTint(FLinearColor& OutColor) const override;
+	//~ End UEdGraphNode Interface.
+
+	virtual UClass* GetDynamicBindingClass() const override;
+	virtual void RegisterDynamicBinding(UDynamicBlueprintBinding* BindingObject) const override;
+
+private:
+	/** Constructing FText strings can be costly, so we cache the node's title/tooltip */
+	FNodeTextCache CachedTooltip;
+	FNodeTextCache CachedNodeTitle;
+};
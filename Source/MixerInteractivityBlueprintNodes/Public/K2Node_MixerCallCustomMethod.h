@@ -0,0 +1,54 @@
+//*********************************************************
+//
+// Copyright (c) Microsoft. All rights reserved.
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT.
+//
+//*********************************************************
+#pragma once
+
+#include "K2Node.h"
+#include "EdGraph/EdGraphNodeUtils.h"
+#include "Engine/MemberReference.h"
+
+#include "K2Node_MixerCallCustomMethod.generated.h"
+
+/**
+* Outbound counterpart of UK2Node_MixerCustomMethod.  Calls a game-defined method on the Mixer service,
+* with a strongly typed input pin per parameter of the matching signature in the Custom Methods class.
+* Parameter values are written straight into the outgoing message rather than via an FJsonObject.
+*/
+UCLASS(MinimalAPI)
+class UK2Node_MixerCallCustomMethod : public UK2Node
+{
+public:
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FName MethodName;
+
+	/** Delegate signature in the Custom Methods class that defines the method's parameters */
+	UPROPERTY()
+	FMemberReference SignatureReference;
+
+	//~ Begin UEdGraphNode Interface.
+	virtual void AllocateDefaultPins() override;
+	virtual FText GetNodeTitle(ENodeTitleType::Type TitleType) const override;
+	virtual FText GetTooltipText() const override;
+	virtual void ExpandNode(class FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph) override;
+	virtual FSlateIcon GetIconAndTint(FLinearColor& OutColor) const override;
+	//~ End UEdGraphNode Interface.
+
+	virtual void ValidateNodeDuringCompilation(class FCompilerResultsLog& MessageLog) const override;
+	virtual FText GetMenuCategory() const override;
+	virtual void GetMenuActions(FBlueprintActionDatabaseRegistrar& ActionRegistrar) const override;
+
+private:
+	UFunction* GetSignature() const;
+
+	/** Constructing FText strings can be costly, so we cache the node's title/tooltip */
+	FNodeTextCache CachedTooltip;
+	FNodeTextCache CachedNodeTitle;
+};
@@ -11,6 +11,7 @@
 #pragma once
 
 #include "K2Node_Event.h"
+#include "MixerDynamicDelegateBinding.h"
 #include "K2Node_MixerStickEvent.generated.h"
 
 UCLASS(MinimalAPI)
@@ -22,8 +23,19 @@ public:
 	UPROPERTY()
 	FName StickId;
 
+	/**
+	* Whether to fire for every move as it arrives, or once per frame with moves coalesced.
+	* Coalescing keeps crowd-driven sticks from invoking the blueprint thousands of times per frame.
+	*/
+	UPROPERTY(EditAnywhere, Category = "Mixer")
+	EMixerStickEventCoalescing Coalescing;
+
+	//~ Begin UObject Interface
+	virtual void PostEditChangeProperty(struct FPropertyChangedEvent& PropertyChangedEvent) override;
+	//~ End UObject Interface
+
 	//~ Begin UK2Node Interface.
-	virtual bool ShouldShowNodeProperties() const override { return false; }
+	virtual bool ShouldShowNodeProperties() const override { return true; }
 	virtual void ValidateNodeDuringCompilation(class FCompilerResultsLog& MessageLog) const override;
 	virtual void GetMenuActions(FBlueprintActionDatabaseRegistrar& ActionRegistrar) const override;
 	virtual FText GetMenuCategory() const override;
@@ -39,6 +51,8 @@ public:
 	virtual void RegisterDynamicBinding(UDynamicBlueprintBinding* BindingObject) const override;
 
 private:
+	static FName GetSignatureName(EMixerStickEventCoalescing Coalescing);
+
 	/** Constructing FText strings can be costly, so we cache the node's title/tooltip */
 	FNodeTextCache CachedTooltip;
 	FNodeTextCache CachedNodeTitle;
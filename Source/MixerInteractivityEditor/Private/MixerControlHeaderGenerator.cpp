@@ -0,0 +1,188 @@
+//*********************************************************
+//
+// Copyright (c) Microsoft. All rights reserved.
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT.
+//
+//*********************************************************
+
+#include "MixerControlHeaderGenerator.h"
+#include "MixerInteractivityProjectAsset.h"
+#include "MixerInteractivitySettings.h"
+#include "MixerInteractivityJsonTypes.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/App.h"
+
+#define LOCTEXT_NAMESPACE "MixerInteractivityEditor"
+
+namespace
+{
+	/** Hands out C++ identifiers for one namespace of the generated header, keeping them unique. */
+	class FIdentifierScope
+	{
+	public:
+		FIdentifierScope()
+		{
+			// Every namespace also declares its count
+			Used.Add(TEXT("Num"));
+		}
+
+		/** PascalCase from the id's letters and digits, e.g. "fire-button" becomes FireButton.  Capitalized, so never a keyword. */
+		FString MakeIdentifier(const FString& Id)
+		{
+			FString Identifier;
+			Identifier.Reserve(Id.Len() + 1);
+			bool bWordStart = true;
+			for (TCHAR Char : Id)
+			{
+				if (Char < 128 && FChar::IsAlnum(Char))
+				{
+					Identifier.AppendChar(bWordStart ? FChar::ToUpper(Char) : Char);
+					bWordStart = false;
+				}
+				else
+				{
+					bWordStart = true;
+				}
+			}
+
+			if (Identifier.IsEmpty() || FChar::IsDigit(Identifier[0]))
+			{
+				Identifier.InsertAt(0, TEXT('_'));
+			}
+
+			FString Unique = Identifier;
+			for (int32 Suffix = 2; Used.Contains(Unique); ++Suffix)
+			{
+				Unique = FString::Printf(TEXT("%s_%d"), *Identifier, Suffix);
+			}
+			Used.Add(Unique);
+			return Unique;
+		}
+
+	private:
+		TSet<FString> Used;
+	};
+
+	FString MakeStringLiteral(const FString& Id)
+	{
+		return FString::Printf(TEXT("TEXT(\"%s\")"), *Id.ReplaceCharWithEscapedChar());
+	}
+
+	/** Appends a namespace holding the id of each object, and one holding its position in Ids. */
+	void AppendIdsAndIndices(FString& Out, const TCHAR* Namespace, const TArray<FString>& Ids)
+	{
+		TArray<FString> Identifiers;
+		FIdentifierScope Scope;
+		for (const FString& Id : Ids)
+		{
+			Identifiers.Add(Scope.MakeIdentifier(Id));
+		}
+
+		Out += FString::Printf(TEXT("\tnamespace %s\n\t{\n"), Namespace);
+		for (int32 i = 0; i < Ids.Num(); ++i)
+		{
+			Out += FString::Printf(TEXT("\t\tconstexpr const TCHAR* %s = %s;\n"), *Identifiers[i], *MakeStringLiteral(Ids[i]));
+		}
+		Out += FString::Printf(TEXT("\t}\n\n\tnamespace %sIndices\n\t{\n"), Namespace);
+		for (int32 i = 0; i < Ids.Num(); ++i)
+		{
+			Out += FString::Printf(TEXT("\t\tconstexpr int32 %s = %d;\n"), *Identifiers[i], i);
+		}
+		Out += FString::Printf(TEXT("\t\tconstexpr int32 Num = %d;\n\t}\n\n"), Ids.Num());
+	}
+
+	/** Appends a namespace holding a handle for each control, at the slot ReserveGeneratedControlHandles gives it. */
+	void AppendHandles(FString& Out, const TCHAR* Namespace, const TArray<FString>& ControlIds)
+	{
+		FIdentifierScope Scope;
+		Out += FString::Printf(TEXT("\tnamespace %s\n\t{\n"), Namespace);
+		for (int32 i = 0; i < ControlIds.Num(); ++i)
+		{
+			Out += FString::Printf(TEXT("\t\tconstexpr FMixerControlHandle %s(%d, LayoutHash);\n"), *Scope.MakeIdentifier(ControlIds[i]), i);
+		}
+		Out += FString::Printf(TEXT("\t\tconstexpr int32 Num = %d;\n\t}\n\n"), ControlIds.Num());
+	}
+}
+
+FString FMixerControlHeaderGenerator::Generate(const UMixerProjectAsset& ProjectAsset)
+{
+	TArray<FString> SceneIds;
+	TArray<FString> ControlIds;
+	for (const FMixerInteractiveScene& Scene : ProjectAsset.ParsedProjectDefinition.Controls.Scenes)
+	{
+		SceneIds.AddUnique(Scene.Id);
+		for (const FMixerInteractiveControl& Control : Scene.Controls)
+		{
+			ControlIds.AddUnique(Control.Id);
+		}
+	}
+
+	// Same list RefreshDesignTimeObjects offers Blueprints, default first
+	TArray<FString> GroupIds;
+	GroupIds.Add(TEXT("default"));
+	for (const FMixerPredefinedGroup& Group : GetDefault<UMixerInteractivitySettings>()->DesignTimeGroups)
+	{
+		GroupIds.AddUnique(Group.Name.ToString());
+	}
+
+	FString Out;
+	Out += FString::Printf(TEXT("// Generated from %s (%s).  Do not edit; regenerate it from the\n"), *ProjectAsset.GetPathName(), *ProjectAsset.ParsedProjectDefinition.Name);
+	Out += TEXT("// Project Definition's details whenever the definition or the design-time groups change.\n\n");
+	Out += TEXT("#pragma once\n\n");
+	Out += TEXT("#include \"MixerInteractivityTypes.h\"\n\n");
+	Out += TEXT("namespace MixerProjectControls\n{\n");
+	Out += TEXT("\t/** Generation of the handles below.  Must match UMixerProjectAsset::GetControlLayoutHash for them to resolve. */\n");
+	Out += FString::Printf(TEXT("\tconstexpr uint32 LayoutHash = 0x%08Xu;\n\n"), ProjectAsset.GetControlLayoutHash());
+
+	AppendIdsAndIndices(Out, TEXT("Scenes"), SceneIds);
+	AppendIdsAndIndices(Out, TEXT("Groups"), GroupIds);
+	AppendIdsAndIndices(Out, TEXT("Controls"), ControlIds);
+	AppendHandles(Out, TEXT("Buttons"), ProjectAsset.GetControlsOfKind(FMixerInteractiveControl::ButtonKind));
+	AppendHandles(Out, TEXT("Sticks"), ProjectAsset.GetControlsOfKind(FMixerInteractiveControl::JoystickKind));
+
+	Out.RemoveFromEnd(TEXT("\n"));
+	Out += TEXT("}\n");
+	return Out;
+}
+
+bool FMixerControlHeaderGenerator::WriteHeader(const UMixerProjectAsset& ProjectAsset, FText& OutError)
+{
+	if (ProjectAsset.GetControlLayoutHash() == 0)
+	{
+		OutError = LOCTEXT("GenerateControlsHeader_NoDefinition", "The Project Definition hasn't been downloaded yet.");
+		return false;
+	}
+
+	const FString HeaderPath = GetHeaderPath();
+	const FString HeaderText = Generate(ProjectAsset);
+
+	// Leave the timestamp alone when nothing changed, so it doesn't trigger a rebuild
+	FString ExistingText;
+	if (FFileHelper::LoadFileToString(ExistingText, *HeaderPath) && ExistingText == HeaderText)
+	{
+		return true;
+	}
+
+	if (!FFileHelper::SaveStringToFile(HeaderText, *HeaderPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+	{
+		OutError = FText::Format(LOCTEXT("GenerateControlsHeader_WriteFailed", "Couldn't write {0}."), FText::FromString(HeaderPath));
+		return false;
+	}
+
+	return true;
+}
+
+FString FMixerControlHeaderGenerator::GetHeaderPath()
+{
+	const FString& ConfiguredPath = GetDefault<UMixerInteractivitySettings>()->GeneratedControlsHeaderPath;
+	const FString RelativePath = !ConfiguredPath.IsEmpty()
+		? ConfiguredPath
+		: FPaths::Combine(TEXT("Source"), FApp::GetProjectName(), TEXT("MixerProjectControls.h"));
+	return FPaths::ConvertRelativePathToFull(FPaths::ProjectDir(), RelativePath);
+}
+
+#undef LOCTEXT_NAMESPACE
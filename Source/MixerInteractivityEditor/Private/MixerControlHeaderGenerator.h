@@ -0,0 +1,34 @@
+//*********************************************************
+//
+// Copyright (c) Microsoft. All rights reserved.
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT.
+//
+//*********************************************************
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UMixerProjectAsset;
+
+/**
+* Writes a C++ header naming every scene, control and design-time group in a Project Definition as a
+* constexpr identifier, with buttons and joysticks as FMixerControlHandles at the dense indices
+* UMixerInteractivitySettings::bReserveGeneratedControlHandles holds for them.  Game code using it
+* skips the by-name lookup, and a control renamed or removed in the definition fails to compile.
+*/
+class FMixerControlHeaderGenerator
+{
+public:
+	/** The text of the header for ProjectAsset, with the groups from UMixerInteractivitySettings::DesignTimeGroups. */
+	static FString Generate(const UMixerProjectAsset& ProjectAsset);
+
+	/** Generate the header and write it to GetHeaderPath, unless it's unchanged.  Returns false with a reason on failure. */
+	static bool WriteHeader(const UMixerProjectAsset& ProjectAsset, FText& OutError);
+
+	/** Absolute path given by UMixerInteractivitySettings::GeneratedControlsHeaderPath, or its default. */
+	static FString GetHeaderPath();
+};
@@ -24,13 +24,24 @@
 #include "MixerInteractivityProjectAsset.h"
 #include "MixerInteractivityBlueprintLibrary.h"
 #include "MixerEditorStyle.h"
+#include "MixerRestClient.h"
+#include "K2Node_MixerButton.h"
+#include "K2Node_MixerBatchedButtonEvent.h"
+#include "K2Node_MixerStickEvent.h"
+#include "K2Node_MixerTextSubmittedEvent.h"
+#include "K2Node_MixerSimpleCustomControlInput.h"
+#include "K2Node_MixerSimpleCustomControlUpdate.h"
+#include "BlueprintActionDatabase.h"
 #include "UObject/UObjectGlobals.h"
 #include "Interfaces/IHttpRequest.h"
 #include "Interfaces/IHttpResponse.h"
-#include "HttpModule.h"
 #include "Dom/JsonObject.h"
 #include "Serialization/JsonReader.h"
 #include "Serialization/JsonSerializer.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "HAL/FileManager.h"
 
 #define LOCTEXT_NAMESPACE "MixerInteractivityEditor"
 
@@ -46,14 +57,34 @@ public:
 	
 	virtual const TArray<TSharedPtr<FName>>& GetDesignTimeObjects(FString ObjectKind) { return DesignTimeObjects.FindChecked(ObjectKind); }
 
+	virtual TSharedPtr<FName> FindDesignTimeObject(FString ObjectKind, FName ObjectName);
+
+	virtual void FilterDesignTimeObjects(FString ObjectKind, const FString& Filter, TArray<TSharedPtr<FName>>& OutMatches);
+
 	virtual void RefreshDesignTimeObjects();
 
 	virtual FOnDesignTimeObjectsChanged& OnDesignTimeObjectsChanged() { return DesignTimeObjectsChanged; }
 
+private:
+	void RefreshNodeActionsIfChanged(UClass* NodeClass, const TArray<FString>& CurrentControls);
+
 private:
 
 	TMap<FString, TArray<TSharedPtr<FName>>> DesignTimeObjects;
 
+	/** Lookup structures for DesignTimeObjects, rebuilt alongside each kind's list. */
+	struct FDesignTimeObjectIndex
+	{
+		TMap<FName, TSharedPtr<FName>> ByName;
+
+		/** Lower case names, parallel to the kind's object list. */
+		TArray<FString> SearchKeys;
+	};
+	TMap<FString, FDesignTimeObjectIndex> DesignTimeObjectIndices;
+
+	/** The control ids each Mixer node class last built its Blueprint actions from. */
+	TMap<UClass*, TArray<FString>> NodeActionControls;
+
 	FOnDesignTimeObjectsChanged DesignTimeObjectsChanged;
 
 	TSharedPtr<FMixerEditorStyle> MixerStyle;
@@ -96,6 +127,41 @@ void FMixerInteractivityEditorModule::StartupModule()
 	RefreshDesignTimeObjects();
 }
 
+namespace
+{
+	/**
+	 * Parses the owned games list on a worker thread and hands it back on the game thread.
+	 * The callback is held in a thread safe wrapper so that it is only ever copied, run and released on the game thread.
+	 */
+	void ParseGameCollectionAsync(FString Json, FOnMixerInteractiveGamesRequestFinished OnFinished)
+	{
+		TSharedRef<FOnMixerInteractiveGamesRequestFinished, ESPMode::ThreadSafe> Callback = MakeShared<FOnMixerInteractiveGamesRequestFinished, ESPMode::ThreadSafe>(OnFinished);
+		FFunctionGraphTask::CreateAndDispatchWhenReady([Json, Callback]()
+		{
+			TSharedRef<TArray<FMixerInteractiveGame>, ESPMode::ThreadSafe> GameCollection = MakeShared<TArray<FMixerInteractiveGame>, ESPMode::ThreadSafe>();
+			TArray<TSharedPtr<FJsonValue>> GameCollectionJson;
+			TSharedRef<TJsonReader<> > JsonReader = TJsonReaderFactory<>::Create(Json);
+			const bool bParsed = FJsonSerializer::Deserialize(JsonReader, GameCollectionJson);
+			if (bParsed)
+			{
+				GameCollection->Reserve(GameCollectionJson.Num());
+				for (TSharedPtr<FJsonValue>& GameJson : GameCollectionJson)
+				{
+					FMixerInteractiveGame Game;
+					Game.FromJson(GameJson->AsObject());
+					GameCollection->Add(Game);
+				}
+			}
+
+			FFunctionGraphTask::CreateAndDispatchWhenReady([Callback, GameCollection, bParsed]()
+			{
+				Callback->ExecuteIfBound(bParsed, *GameCollection);
+				Callback->Unbind();
+			}, TStatId(), nullptr, ENamedThreads::GameThread);
+		}, TStatId(), nullptr, ENamedThreads::AnyThread);
+	}
+}
+
 bool FMixerInteractivityEditorModule::RequestAvailableInteractiveGames(FOnMixerInteractiveGamesRequestFinished OnFinished)
 {
 	IMixerInteractivityModule& MixerRuntimeModule = IMixerInteractivityModule::Get();
@@ -107,39 +173,22 @@ bool FMixerInteractivityEditorModule::RequestAvailableInteractiveGames(FOnMixerI
 	const UMixerInteractivityUserSettings* UserSettings = GetDefault<UMixerInteractivityUserSettings>();
 	TSharedPtr<const FMixerLocalUser> MixerUser = MixerRuntimeModule.GetCurrentUser();
 	check(MixerUser.IsValid());
-	FString GamesListUrl = FString::Printf(TEXT("https://mixer.com/api/v1/interactive/games/owned?user=%d"), MixerUser->Id);
+	FString GamesListPath = FString::Printf(TEXT("interactive/games/owned?user=%d"), MixerUser->Id);
 
-	TSharedRef<IHttpRequest> GamesRequest = FHttpModule::Get().CreateRequest();
-	GamesRequest->SetVerb(TEXT("GET"));
-	GamesRequest->SetURL(GamesListUrl);
-	GamesRequest->SetHeader(TEXT("Authorization"), UserSettings->GetAuthZHeaderValue());
+	TSharedRef<IHttpRequest> GamesRequest = FMixerRestClient::Get().CreateRequest(TEXT("GET"), GamesListPath, UserSettings->GetAuthZHeaderValue());
 	GamesRequest->OnProcessRequestComplete().BindLambda(
 		[OnFinished](FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded)
 	{
-		bool Success = false;
-		TArray<FMixerInteractiveGame> GameCollection;
-		if (bSucceeded && HttpResponse.IsValid())
+		if (bSucceeded && HttpResponse.IsValid() && EHttpResponseCodes::IsOk(HttpResponse->GetResponseCode()))
 		{
-			if (EHttpResponseCodes::IsOk(HttpResponse->GetResponseCode()))
-			{
-				TArray<TSharedPtr<FJsonValue>> GameCollectionJson;
-				TSharedRef<TJsonReader<> > JsonReader = TJsonReaderFactory<>::Create(HttpResponse->GetContentAsString());
-				if (FJsonSerializer::Deserialize(JsonReader, GameCollectionJson))
-				{
-					Success = true;
-					GameCollection.Reserve(GameCollectionJson.Num());
-					for (TSharedPtr<FJsonValue>& GameJson : GameCollectionJson)
-					{
-						FMixerInteractiveGame Game;
-						Game.FromJson(GameJson->AsObject());
-						GameCollection.Add(Game);
-					}
-				}
-			}
+			ParseGameCollectionAsync(HttpResponse->GetContentAsString(), OnFinished);
+		}
+		else
+		{
+			OnFinished.ExecuteIfBound(false, TArray<FMixerInteractiveGame>());
 		}
-		OnFinished.ExecuteIfBound(Success, GameCollection);
 	});
-	if (!GamesRequest->ProcessRequest())
+	if (!FMixerRestClient::Get().ProcessRequest(GamesRequest))
 	{
 		return false;
 	}
@@ -147,32 +196,207 @@ bool FMixerInteractivityEditorModule::RequestAvailableInteractiveGames(FOnMixerI
 	return true;
 }
 
+namespace
+{
+	FString GetVersionCachePath(int32 VersionId, const TCHAR* Extension)
+	{
+		return FPaths::ProjectSavedDir() / TEXT("Mixer") / TEXT("VersionCache") / FString::Printf(TEXT("%d.%s"), VersionId, Extension);
+	}
+
+	/**
+	 * Renames a fully written temporary file over a cache entry, so that a load running
+	 * alongside sees either the old entry or the new one and never a partial write.
+	 */
+	void MoveIntoVersionCache(const FString& TempPath, int32 VersionId, const TCHAR* Extension)
+	{
+		if (!IFileManager::Get().Move(*GetVersionCachePath(VersionId, Extension), *TempPath, true))
+		{
+			IFileManager::Get().Delete(*TempPath);
+		}
+	}
+
+	/**
+	 * Tracks the two ways a version definition can reach the caller: the copy on disk, which is
+	 * delivered as soon as it has been parsed, and the revalidated copy from the service.
+	 * Its members are only touched on the game thread, but references travel through the parse tasks.
+	 */
+	struct FVersionRequestState
+	{
+		FOnMixerInteractiveControlsRequestFinished OnFinished;
+		FString CachedETag;
+		bool bHasCachedCopy = false;
+		bool bCachedCopyDone = false;
+		bool bCachedCopyValid = false;
+		bool bNetworkDone = false;
+		bool bFinished = false;
+	};
+
+	void FinishVersionRequest(const TSharedRef<FVersionRequestState, ESPMode::ThreadSafe>& State, bool bSuccess, const FMixerInteractiveGameVersion& Version)
+	{
+		State->bFinished = State->bFinished || bSuccess;
+		State->OnFinished.ExecuteIfBound(bSuccess, Version);
+	}
+
+	/**
+	 * Parses a version definition on a worker thread and hands it back on the game thread.
+	 * Either Json holds a fresh download, or LoadFromPath names the cached copy to read first.
+	 * Fresh downloads with validators are written to the disk cache once they parse.
+	 */
+	void ParseGameVersionAsync(int32 VersionId, FString Json, const FString& LoadFromPath, const TArray<FString>& SaveValidators, TFunction<void(bool, const FMixerInteractiveGameVersion&)> OnParsed)
+	{
+		FFunctionGraphTask::CreateAndDispatchWhenReady([VersionId, Json, LoadFromPath, SaveValidators, OnParsed]() mutable
+		{
+			if (!LoadFromPath.IsEmpty())
+			{
+				FFileHelper::LoadFileToString(Json, *LoadFromPath);
+			}
+
+			TSharedRef<FMixerInteractiveGameVersion, ESPMode::ThreadSafe> Version = MakeShared<FMixerInteractiveGameVersion, ESPMode::ThreadSafe>();
+			const bool bParsed = !Json.IsEmpty() && Version->FromJson(Json);
+			if (bParsed && SaveValidators.Num() > 0)
+			{
+				// The validators go last since they are what marks the entry as usable.
+				const FString CacheDir = FPaths::GetPath(GetVersionCachePath(VersionId, TEXT("json")));
+				const FString JsonTempPath = FPaths::CreateTempFilename(*CacheDir, *FString::Printf(TEXT("%d.json."), VersionId));
+				const FString ValidatorsTempPath = FPaths::CreateTempFilename(*CacheDir, *FString::Printf(TEXT("%d.validators."), VersionId));
+				if (FFileHelper::SaveStringToFile(Json, *JsonTempPath))
+				{
+					MoveIntoVersionCache(JsonTempPath, VersionId, TEXT("json"));
+					if (FFileHelper::SaveStringArrayToFile(SaveValidators, *ValidatorsTempPath))
+					{
+						MoveIntoVersionCache(ValidatorsTempPath, VersionId, TEXT("validators"));
+					}
+				}
+			}
+			else if (!bParsed && !LoadFromPath.IsEmpty())
+			{
+				// Damaged cache entry; drop it so the next request downloads the definition in full
+				IFileManager::Get().Delete(*GetVersionCachePath(VersionId, TEXT("validators")));
+			}
+
+			FFunctionGraphTask::CreateAndDispatchWhenReady([Version, bParsed, OnParsed]()
+			{
+				OnParsed(bParsed, *Version);
+			}, TStatId(), nullptr, ENamedThreads::GameThread);
+		}, TStatId(), nullptr, ENamedThreads::AnyThread);
+	}
+}
+
 bool FMixerInteractivityEditorModule::RequestInteractiveControlsForGameVersion(const FMixerInteractiveGameVersion& Version, FOnMixerInteractiveControlsRequestFinished OnFinished)
 {
-	FString ControlsForVersionUrl = FString::Printf(TEXT("https://mixer.com/api/v1/interactive/versions/%d"), Version.Id);
+	const int32 VersionId = Version.Id;
+	FString ControlsForVersionPath = FString::Printf(TEXT("interactive/versions/%d"), VersionId);
+
+	TSharedRef<FVersionRequestState, ESPMode::ThreadSafe> State = MakeShared<FVersionRequestState, ESPMode::ThreadSafe>();
+	State->OnFinished = OnFinished;
+
+	TSharedRef<IHttpRequest> ControlsRequest = FMixerRestClient::Get().CreateRequest(TEXT("GET"), ControlsForVersionPath);
+
+	// Validators are stored as the response header lines they came from.  The definition itself is only read on a worker.
+	TArray<FString> CachedValidators;
+	if (FFileHelper::LoadFileToStringArray(CachedValidators, *GetVersionCachePath(VersionId, TEXT("validators"))))
+	{
+		for (const FString& Validator : CachedValidators)
+		{
+			FString Name;
+			FString Value;
+			if (Validator.Split(TEXT(": "), &Name, &Value))
+			{
+				if (Name == TEXT("ETag"))
+				{
+					State->CachedETag = Value;
+					ControlsRequest->SetHeader(TEXT("If-None-Match"), Value);
+					State->bHasCachedCopy = true;
+				}
+				else if (Name == TEXT("Last-Modified"))
+				{
+					ControlsRequest->SetHeader(TEXT("If-Modified-Since"), Value);
+					State->bHasCachedCopy = true;
+				}
+			}
+		}
+	}
 
-	TSharedRef<IHttpRequest> ControlsRequest = FHttpModule::Get().CreateRequest();
-	ControlsRequest->SetVerb(TEXT("GET"));
-	ControlsRequest->SetURL(ControlsForVersionUrl);
 	ControlsRequest->OnProcessRequestComplete().BindLambda(
-		[OnFinished](FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded)
+		[State, VersionId](FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded)
 	{
-		bool Success = false;
-		FMixerInteractiveGameVersion VersionWithControls;
 		if (bSucceeded && HttpResponse.IsValid())
 		{
-			if (EHttpResponseCodes::IsOk(HttpResponse->GetResponseCode()))
+			const int32 ResponseCode = HttpResponse->GetResponseCode();
+			const FString ETag = HttpResponse->GetHeader(TEXT("ETag"));
+			const bool bMatchesCachedCopy = State->bHasCachedCopy &&
+				(ResponseCode == EHttpResponseCodes::NotModified || (EHttpResponseCodes::IsOk(ResponseCode) && !ETag.IsEmpty() && ETag == State->CachedETag));
+			if (bMatchesCachedCopy)
+			{
+				State->bNetworkDone = true;
+				if (State->bCachedCopyDone && !State->bCachedCopyValid)
+				{
+					FinishVersionRequest(State, false, FMixerInteractiveGameVersion());
+				}
+				return;
+			}
+			else if (EHttpResponseCodes::IsOk(ResponseCode))
 			{
-				Success = VersionWithControls.FromJson(HttpResponse->GetContentAsString());
+				TArray<FString> Validators;
+				const FString LastModified = HttpResponse->GetHeader(TEXT("Last-Modified"));
+				if (!ETag.IsEmpty())
+				{
+					Validators.Add(FString(TEXT("ETag: ")) + ETag);
+				}
+				if (!LastModified.IsEmpty())
+				{
+					Validators.Add(FString(TEXT("Last-Modified: ")) + LastModified);
+				}
+				ParseGameVersionAsync(VersionId, HttpResponse->GetContentAsString(), FString(), Validators,
+					[State](bool bParsed, const FMixerInteractiveGameVersion& VersionWithControls)
+				{
+					// Keep the cached copy the caller already has rather than replacing it with a failure
+					if (bParsed || !State->bFinished)
+					{
+						FinishVersionRequest(State, bParsed, VersionWithControls);
+					}
+				});
+				return;
 			}
 		}
 
-		OnFinished.ExecuteIfBound(Success, VersionWithControls);
+		// Network trouble is not worth reporting if the caller already has a usable copy
+		if (!State->bFinished && !(State->bHasCachedCopy && !State->bCachedCopyDone))
+		{
+			FinishVersionRequest(State, false, FMixerInteractiveGameVersion());
+		}
+		State->bNetworkDone = true;
 	});
 
-	if (!ControlsRequest->ProcessRequest())
+	if (!FMixerRestClient::Get().ProcessRequest(ControlsRequest))
 	{
-		return false;
+		if (!State->bHasCachedCopy)
+		{
+			return false;
+		}
+		State->bNetworkDone = true;
+	}
+
+	if (State->bHasCachedCopy)
+	{
+		ParseGameVersionAsync(VersionId, FString(), GetVersionCachePath(VersionId, TEXT("json")), TArray<FString>(),
+			[State](bool bParsed, const FMixerInteractiveGameVersion& CachedVersion)
+		{
+			State->bCachedCopyDone = true;
+			State->bCachedCopyValid = bParsed;
+			if (bParsed)
+			{
+				// A fresh download that has already landed takes precedence
+				if (!State->bFinished)
+				{
+					FinishVersionRequest(State, true, CachedVersion);
+				}
+			}
+			else if (State->bNetworkDone && !State->bFinished)
+			{
+				FinishVersionRequest(State, false, FMixerInteractiveGameVersion());
+			}
+		});
 	}
 
 	return true;
@@ -186,19 +410,19 @@ const FString& GetMixerKind()
 
 void FMixerInteractivityEditorModule::RefreshDesignTimeObjects()
 {
-	DesignTimeObjects.FindOrAdd(GetMixerKind<FMixerSceneReference>()).Empty();
+	TMap<FString, TArray<TSharedPtr<FName>>> NewObjects;
+	NewObjects.Add(GetMixerKind<FMixerSceneReference>());
 
 	// Known control types
-	DesignTimeObjects.FindOrAdd(GetMixerKind<FMixerButtonReference>()).Empty();
-	DesignTimeObjects.FindOrAdd(GetMixerKind<FMixerStickReference>()).Empty();
-	DesignTimeObjects.FindOrAdd(GetMixerKind<FMixerLabelReference>()).Empty();
-
-	DesignTimeObjects.FindOrAdd(GetMixerKind<FMixerCustomControlReference>()).Empty();
+	NewObjects.Add(GetMixerKind<FMixerButtonReference>());
+	NewObjects.Add(GetMixerKind<FMixerStickReference>());
+	NewObjects.Add(GetMixerKind<FMixerLabelReference>());
 
 	// Custom controls
-	TArray<TSharedPtr<FName>>& DesignTimeScenes = DesignTimeObjects.FindChecked(GetMixerKind<FMixerSceneReference>());
-	TArray<TSharedPtr<FName>>& DesignTimeUnmappedCustomControls = DesignTimeObjects.FindChecked(GetMixerKind<FMixerCustomControlReference>());
-	DesignTimeUnmappedCustomControls.Empty();
+	NewObjects.Add(GetMixerKind<FMixerCustomControlReference>());
+
+	TArray<TSharedPtr<FName>>& DesignTimeScenes = NewObjects.FindChecked(GetMixerKind<FMixerSceneReference>());
+	TArray<TSharedPtr<FName>>& DesignTimeUnmappedCustomControls = NewObjects.FindChecked(GetMixerKind<FMixerCustomControlReference>());
 
 	const UMixerInteractivitySettings* Settings = GetDefault<UMixerInteractivitySettings>();
 	UMixerProjectAsset* ProjectAsset = Cast<UMixerProjectAsset>(Settings->ProjectDefinition.TryLoad());
@@ -210,7 +434,7 @@ void FMixerInteractivityEditorModule::RefreshDesignTimeObjects()
 			for (const FMixerInteractiveControl& Control : Scene.Controls)
 			{
 				FName ControlName = *Control.Id;
-				TArray<TSharedPtr<FName>>* DesignTimeKnownControlType = DesignTimeObjects.Find(Control.Kind);
+				TArray<TSharedPtr<FName>>* DesignTimeKnownControlType = NewObjects.Find(Control.Kind);
 				if (DesignTimeKnownControlType != nullptr)
 				{
 					DesignTimeKnownControlType->Add(MakeShared<FName>(ControlName));
@@ -223,15 +447,123 @@ void FMixerInteractivityEditorModule::RefreshDesignTimeObjects()
 		}
 	}
 
-	TArray<TSharedPtr<FName>>& DesignTimeGroups = DesignTimeObjects.FindOrAdd(GetMixerKind<FMixerGroupReference>());
-	DesignTimeGroups.Empty(Settings->DesignTimeGroups.Num() + 1);
+	TArray<TSharedPtr<FName>>& DesignTimeGroups = NewObjects.Add(GetMixerKind<FMixerGroupReference>());
+	DesignTimeGroups.Reserve(Settings->DesignTimeGroups.Num() + 1);
 	DesignTimeGroups.Add(MakeShared<FName>("default"));
 	for (const FMixerPredefinedGroup& Group : Settings->DesignTimeGroups)
 	{
 		DesignTimeGroups.Add(MakeShared<FName>(Group.Name));
 	}
 
-	DesignTimeObjectsChanged.Broadcast();
+	// Widgets hold on to these arrays as their options source, so update them in place,
+	// and leave unchanged kinds alone so that existing selections stay valid.
+	bool bAnyObjectsChanged = false;
+	for (TMap<FString, TArray<TSharedPtr<FName>>>::TIterator It(NewObjects); It; ++It)
+	{
+		TArray<TSharedPtr<FName>>& ExistingObjects = DesignTimeObjects.FindOrAdd(It->Key);
+		bool bKindChanged = ExistingObjects.Num() != It->Value.Num();
+		for (int32 i = 0; !bKindChanged && i < ExistingObjects.Num(); ++i)
+		{
+			bKindChanged = *ExistingObjects[i] != *It->Value[i];
+		}
+
+		if (bKindChanged)
+		{
+			ExistingObjects = MoveTemp(It->Value);
+			bAnyObjectsChanged = true;
+
+			FDesignTimeObjectIndex& Index = DesignTimeObjectIndices.FindOrAdd(It->Key);
+			Index.ByName.Empty(ExistingObjects.Num());
+			Index.SearchKeys.Empty(ExistingObjects.Num());
+			for (const TSharedPtr<FName>& Object : ExistingObjects)
+			{
+				Index.ByName.Add(*Object, Object);
+				Index.SearchKeys.Add(Object->ToString().ToLower());
+			}
+		}
+	}
+
+	if (bAnyObjectsChanged)
+	{
+		DesignTimeObjectsChanged.Broadcast();
+	}
+
+	// Rebuilding a node class's actions is expensive on large projects, so only
+	// do it for the classes whose spawners would actually come out differently.
+	UMixerInteractivitySettings::InvalidateControlIndex();
+
+	TArray<FString> NodeControls;
+	UMixerInteractivitySettings::GetAllControls(FMixerInteractiveControl::ButtonKind, NodeControls);
+	RefreshNodeActionsIfChanged(UK2Node_MixerButton::StaticClass(), NodeControls);
+	RefreshNodeActionsIfChanged(UK2Node_MixerBatchedButtonEvent::StaticClass(), NodeControls);
+
+	NodeControls.Reset();
+	UMixerInteractivitySettings::GetAllControls(FMixerInteractiveControl::JoystickKind, NodeControls);
+	RefreshNodeActionsIfChanged(UK2Node_MixerStickEvent::StaticClass(), NodeControls);
+
+	NodeControls.Reset();
+	UMixerInteractivitySettings::GetAllControls(FMixerInteractiveControl::TextboxKind, NodeControls);
+	RefreshNodeActionsIfChanged(UK2Node_MixerTextSubmittedEvent::StaticClass(), NodeControls);
+
+	NodeControls.Reset();
+	UMixerInteractivitySettings::GetAllUnmappedCustomControls(NodeControls);
+	RefreshNodeActionsIfChanged(UK2Node_MixerSimpleCustomControlInput::StaticClass(), NodeControls);
+	RefreshNodeActionsIfChanged(UK2Node_MixerSimpleCustomControlUpdate::StaticClass(), NodeControls);
+}
+
+TSharedPtr<FName> FMixerInteractivityEditorModule::FindDesignTimeObject(FString ObjectKind, FName ObjectName)
+{
+	const FDesignTimeObjectIndex* Index = DesignTimeObjectIndices.Find(ObjectKind);
+	const TSharedPtr<FName>* Object = Index != nullptr ? Index->ByName.Find(ObjectName) : nullptr;
+	return Object != nullptr ? *Object : TSharedPtr<FName>();
+}
+
+void FMixerInteractivityEditorModule::FilterDesignTimeObjects(FString ObjectKind, const FString& Filter, TArray<TSharedPtr<FName>>& OutMatches)
+{
+	const TArray<TSharedPtr<FName>>* ObjectsPtr = DesignTimeObjects.Find(ObjectKind);
+	if (ObjectsPtr == nullptr)
+	{
+		return;
+	}
+
+	const TArray<TSharedPtr<FName>>& Objects = *ObjectsPtr;
+	const FDesignTimeObjectIndex* Index = DesignTimeObjectIndices.Find(ObjectKind);
+	if (Filter.IsEmpty() || Index == nullptr)
+	{
+		OutMatches.Append(Objects);
+		return;
+	}
+
+	const FString LowerFilter = Filter.ToLower();
+	TArray<TSharedPtr<FName>> SubstringMatches;
+	for (int32 i = 0; i < Objects.Num(); ++i)
+	{
+		const int32 MatchPosition = Index->SearchKeys[i].Find(LowerFilter, ESearchCase::CaseSensitive);
+		if (MatchPosition == 0)
+		{
+			OutMatches.Add(Objects[i]);
+		}
+		else if (MatchPosition != INDEX_NONE)
+		{
+			SubstringMatches.Add(Objects[i]);
+		}
+	}
+	OutMatches.Append(SubstringMatches);
+}
+
+void FMixerInteractivityEditorModule::RefreshNodeActionsIfChanged(UClass* NodeClass, const TArray<FString>& CurrentControls)
+{
+	TArray<FString>* PreviousControls = NodeActionControls.Find(NodeClass);
+	if (PreviousControls == nullptr)
+	{
+		// First time through the action database has not been built from these yet
+		NodeActionControls.Add(NodeClass, CurrentControls);
+	}
+	else if (*PreviousControls != CurrentControls)
+	{
+		*PreviousControls = CurrentControls;
+		FBlueprintActionDatabase::Get().RefreshClassActions(NodeClass);
+	}
 }
 
 #undef LOCTEXT_NAMESPACE
\ No newline at end of file
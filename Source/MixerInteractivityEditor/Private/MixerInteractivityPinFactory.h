@@ -26,21 +26,15 @@ class FMixerInteractivityPinFactory : public FGraphPanelPinFactory
 		TSharedPtr<SGraphPinMixerObjectNameList> PinWidget;
 		if (InPin->PinType.PinCategory == K2Schema->PC_Struct)
 		{
-			SGraphPinMixerObjectNameList::FGetMixerObjectNames ItemsSource;
 			UStruct* PinTypeStruct = Cast<UStruct>(InPin->PinType.PinSubCategoryObject.Get());
 			if (PinTypeStruct != nullptr)
 			{
 				FString MixerObjectKind = PinTypeStruct->GetMetaData(MixerObjectKindMetadataTag);
 				if (!MixerObjectKind.IsEmpty())
 				{
-					ItemsSource = SGraphPinMixerObjectNameList::FGetMixerObjectNames::CreateRaw(&IMixerInteractivityEditorModule::Get(), &IMixerInteractivityEditorModule::GetDesignTimeObjects, MixerObjectKind);
+					return SNew(SGraphPinMixerObjectNameList, InPin, MixerObjectKind);
 				}
 			}
-
-			if (ItemsSource.IsBound())
-			{
-				return SNew(SGraphPinMixerObjectNameList, InPin, ItemsSource);
-			}
 		}
 
 		return nullptr;
@@ -16,6 +16,7 @@
 #include "MixerInteractivityEditorModule.h"
 #include "MixerInteractivityProjectAsset.h"
 #include "K2Node_MixerCustomMethod.h"
+#include "K2Node_MixerCallCustomMethod.h"
 #include "DetailLayoutBuilder.h"
 #include "DetailCategoryBuilder.h"
 #include "DetailWidgetRow.h"
@@ -26,10 +27,6 @@
 #include "Widgets/Images/SThrobber.h"
 #include "Factories/DataAssetFactory.h"
 #include "ContentBrowserModule.h"
-#include "K2Node_MixerButton.h"
-#include "K2Node_MixerStickEvent.h"
-#include "K2Node_MixerSimpleCustomControlInput.h"
-#include "K2Node_MixerSimpleCustomControlUpdate.h"
 #include "BlueprintActionDatabase.h"
 #include "PropertyCustomizationHelpers.h"
 #include "IDetailChildrenBuilder.h"
@@ -543,15 +540,12 @@ FReply FMixerInteractivitySettingsCustomization::UpdateControlSheetFromOnline()
 
 	CurrentDefinition->ParsedProjectDefinition = DownloadedProjectDefinition;
 	CurrentDefinition->ProjectDefinitionJson = DownloadedProjectDefinition.ToJson(false);
+	CurrentDefinition->RebuildControlIndex();
 	CurrentDefinition->MarkPackageDirty();
 
+	// Also refreshes the Blueprint actions of any node classes whose controls changed
 	IMixerInteractivityEditorModule::Get().RefreshDesignTimeObjects();
 
-	FBlueprintActionDatabase::Get().RefreshClassActions(UK2Node_MixerButton::StaticClass());
-	FBlueprintActionDatabase::Get().RefreshClassActions(UK2Node_MixerStickEvent::StaticClass());
-	FBlueprintActionDatabase::Get().RefreshClassActions(UK2Node_MixerSimpleCustomControlInput::StaticClass());
-	FBlueprintActionDatabase::Get().RefreshClassActions(UK2Node_MixerSimpleCustomControlUpdate::StaticClass());
-
 	return FReply::Handled();
 }
 
@@ -736,6 +730,7 @@ void FMixerInteractivitySettingsCustomization::OnCustomMethodsPreChange()
 void FMixerInteractivitySettingsCustomization::OnCustomMethodsPostChange()
 {
 	FBlueprintActionDatabase::Get().RefreshClassActions(UK2Node_MixerCustomMethod::StaticClass());
+	FBlueprintActionDatabase::Get().RefreshClassActions(UK2Node_MixerCallCustomMethod::StaticClass());
 
 	const FSoftClassPath& CustomMethodsPath = GetDefault<UMixerInteractivitySettings>()->CustomMethods;
 	if (CustomMethodsPath.IsValid())
@@ -750,6 +745,7 @@ void FMixerInteractivitySettingsCustomization::OnCustomMethodsPostChange()
 					[](UBlueprint*)
 				{
 					FBlueprintActionDatabase::Get().RefreshClassActions(UK2Node_MixerCustomMethod::StaticClass());
+					FBlueprintActionDatabase::Get().RefreshClassActions(UK2Node_MixerCallCustomMethod::StaticClass());
 				});
 			}
 		}
@@ -6,6 +6,7 @@
 #include "MixerInteractivityJsonTypes.h"
 #include "MixerCustomControl.h"
 #include "MixerDynamicDelegateBinding.h"
+#include "MixerControlHeaderGenerator.h"
 #include "DetailLayoutBuilder.h"
 #include "DetailCategoryBuilder.h"
 #include "DetailWidgetRow.h"
@@ -14,10 +15,10 @@
 #include "Widgets/Text/STextBlock.h"
 #include "Widgets/Text/SRichTextBlock.h"
 #include "Widgets/Layout/SBorder.h"
+#include "Widgets/Input/SButton.h"
+#include "Widgets/Notifications/SNotificationList.h"
+#include "Framework/Notifications/NotificationManager.h"
 #include "Components/HorizontalBox.h"
-#include "K2Node_MixerSimpleCustomControlInput.h"
-#include "K2Node_MixerSimpleCustomControlUpdate.h"
-#include "BlueprintActionDatabase.h"
 #include "Kismet2/KismetEditorUtilities.h"
 #include "Toolkits/AssetEditorManager.h"
 #include "Editor.h"
@@ -82,6 +83,23 @@ void FMixerProjectDefinitionCustomization::CustomizeDetails(IDetailLayoutBuilder
 		}))
 	];
 
+	ProjectInfoCategoryBuilder.AddCustomRow(LOCTEXT("ProjectDefinition_ControlsHeader", "Controls Header"))
+	.NameContent()
+	[
+		SNew(STextBlock)
+		.Text(LOCTEXT("ProjectDefinition_ControlsHeaderLabel", "C++ Controls Header"))
+		.Font(IDetailLayoutBuilder::GetDetailFont())
+	]
+	.ValueContent()
+	[
+		SNew(SButton)
+		.Text(LOCTEXT("ProjectDefinition_GenerateControlsHeader", "Generate"))
+		.ToolTipText(FText::Format(
+			LOCTEXT("ProjectDefinition_GenerateControlsHeaderTooltip", "Write constexpr ids for the scenes, controls and groups, and handles for the buttons and joysticks, to {0}"),
+			FText::FromString(FMixerControlHeaderGenerator::GetHeaderPath())))
+		.OnClicked(this, &FMixerProjectDefinitionCustomization::OnGenerateControlsHeaderClicked, TWeakObjectPtr<UMixerProjectAsset>(ProjectAsset))
+	];
+
 	IDetailCategoryBuilder& ScenesCategoryBuilder = DetailBuilder.EditCategory("Scenes");
 	for (const FMixerInteractiveScene& Scene : ProjectAsset->ParsedProjectDefinition.Controls.Scenes)
 	{
@@ -219,9 +237,6 @@ void FMixerProjectDefinitionCustomization::SetClassForCustomControl(const UClass
 
 	IMixerInteractivityEditorModule::Get().RefreshDesignTimeObjects();
 
-	FBlueprintActionDatabase::Get().RefreshClassActions(UK2Node_MixerSimpleCustomControlInput::StaticClass());
-	FBlueprintActionDatabase::Get().RefreshClassActions(UK2Node_MixerSimpleCustomControlUpdate::StaticClass());
-
 	UMixerInteractivityBlueprintEventSource::GetBlueprintEventSource(GEditor->GetEditorWorldContext().World())->RefreshCustomControls();
 }
 
@@ -268,4 +283,20 @@ void FMixerProjectDefinitionCustomization::OnClearClicked(TSharedRef<IPropertyHa
 	SetClassForCustomControl(nullptr, ControlMappingProperty, ControlName, SceneName);
 }
 
+FReply FMixerProjectDefinitionCustomization::OnGenerateControlsHeaderClicked(TWeakObjectPtr<UMixerProjectAsset> ProjectAsset) const
+{
+	if (ProjectAsset.IsValid())
+	{
+		FText Error;
+		const bool bWritten = FMixerControlHeaderGenerator::WriteHeader(*ProjectAsset, Error);
+		FNotificationInfo Info(bWritten
+			? FText::Format(LOCTEXT("GenerateControlsHeader_Succeeded", "Wrote Mixer controls header {0}"), FText::FromString(FMixerControlHeaderGenerator::GetHeaderPath()))
+			: FText::Format(LOCTEXT("GenerateControlsHeader_Failed", "Failed to generate Mixer controls header: {0}"), Error));
+		Info.ExpireDuration = 8.0f;
+		FSlateNotificationManager::Get().AddNotification(Info);
+	}
+
+	return FReply::Handled();
+}
+
 #undef LOCTEXT_NAMESPACE
@@ -32,4 +32,5 @@ private:
 	void OnBrowseClicked(TSharedRef<IPropertyHandle> ControlBindingProperty, FName ControlName, FName SceneName) const;
 	void OnMakeNewClicked(TSharedRef<IPropertyHandle> ControlBindingProperty, FName ControlName, FName SceneName) const;
 	void OnClearClicked(TSharedRef<IPropertyHandle> ControlBindingProperty, FName ControlName, FName SceneName) const;
+	FReply OnGenerateControlsHeaderClicked(TWeakObjectPtr<class UMixerProjectAsset> ProjectAsset) const;
 };
\ No newline at end of file
@@ -12,56 +12,31 @@
 #include "Editor/UnrealEd/Public/ScopedTransaction.h"
 #include "Widgets/Text/STextBlock.h"
 #include "Widgets/Notifications/SErrorHint.h"
+#include "Widgets/Views/STableRow.h"
 #include "MixerInteractivityEditorModule.h"
 
 #define LOCTEXT_NAMESPACE "MixerInteractivityEditor"
 
-void SGraphPinMixerObjectNameList::Construct(const FArguments& InArgs, UEdGraphPin* InGraphPinObj, FGetMixerObjectNames InItemsSource)
+void SGraphPinMixerObjectNameList::Construct(const FArguments& InArgs, UEdGraphPin* InGraphPinObj, const FString& InObjectKind)
 {
-	ItemsSource = InItemsSource;
+	ObjectKind = InObjectKind;
 	SGraphPin::Construct(SGraphPin::FArguments(), InGraphPinObj);
 }
 
 TSharedRef<SWidget>	SGraphPinMixerObjectNameList::GetDefaultValueWidget()
 {
-	TSharedPtr<FName> CurrentlySelectedName;
-
-	const TArray<TSharedPtr<FName>>* NameList = &ItemsSource.Execute();
-	if (GraphPinObj)
-	{
-		// Preserve previous selection, or set to first in list
-		FName PreviousSelection = FName(*GraphPinObj->GetDefaultAsString());
-		if (NameList)
-		{
-			for (TSharedPtr<FName> ListNamePtr : *NameList)
-			{
-				if (PreviousSelection == *ListNamePtr.Get())
-				{
-					CurrentlySelectedName = ListNamePtr;
-					break;
-				}
-			}
-		}
-
-		if (!CurrentlySelectedName.IsValid())
-		{
-			CurrentlySelectedName = MakeShareable(new FName(PreviousSelection));
-		}
-	}
-
 	// Create widget
 	TSharedRef<SWidget> ValueWidget =
 		SNew(SHorizontalBox)
 		+SHorizontalBox::Slot()
 		.AutoWidth()
 		[
-			SAssignNew(ComboBox, SComboBox<TSharedPtr<FName>>)
+			SAssignNew(ComboButton, SComboButton)
 			.ContentPadding(FMargin(6.0f, 2.0f))
-			.OptionsSource(NameList)
-			.InitiallySelectedItem(CurrentlySelectedName)
-			.OnSelectionChanged(this, &SGraphPinMixerObjectNameList::ComboBoxSelectionChanged)
 			.Visibility(this, &SGraphPin::GetDefaultValueVisibility)
-			.OnGenerateWidget(this, &SGraphPinMixerObjectNameList::GenerateWidgetForComboItem)
+			.OnGetMenuContent(this, &SGraphPinMixerObjectNameList::GetMenuContent)
+			.OnMenuOpenChanged(this, &SGraphPinMixerObjectNameList::OnMenuOpenChanged)
+			.ButtonContent()
 			[
 				SNew(STextBlock)
 				.Text(this, &SGraphPinMixerObjectNameList::GetTextForSelectedItem)
@@ -80,7 +55,72 @@ TSharedRef<SWidget>	SGraphPinMixerObjectNameList::GetDefaultValueWidget()
 	return ValueWidget;
 }
 
-void SGraphPinMixerObjectNameList::ComboBoxSelectionChanged(TSharedPtr<FName> NameItem, ESelectInfo::Type SelectInfo)
+TSharedRef<SWidget> SGraphPinMixerObjectNameList::GetMenuContent()
+{
+	// The list only generates rows for the names in view, so large projects stay cheap to open
+	TSharedRef<SWidget> MenuContent =
+		SNew(SVerticalBox)
+		+ SVerticalBox::Slot()
+		.AutoHeight()
+		.Padding(2.0f)
+		[
+			SAssignNew(SearchBox, SSearchBox)
+			.OnTextChanged(this, &SGraphPinMixerObjectNameList::OnFilterTextChanged)
+			.OnTextCommitted(this, &SGraphPinMixerObjectNameList::OnFilterTextCommitted)
+		]
+		+ SVerticalBox::Slot()
+		.MaxHeight(400.0f)
+		[
+			SAssignNew(NameListView, SListView<TSharedPtr<FName>>)
+			.ListItemsSource(&FilteredNames)
+			.SelectionMode(ESelectionMode::Single)
+			.OnGenerateRow(this, &SGraphPinMixerObjectNameList::GenerateRowForName)
+			.OnMouseButtonClick(this, &SGraphPinMixerObjectNameList::OnNameClicked)
+		];
+
+	ComboButton->SetMenuContentWidgetToFocus(SearchBox);
+	return MenuContent;
+}
+
+void SGraphPinMixerObjectNameList::OnMenuOpenChanged(bool bOpen)
+{
+	if (bOpen)
+	{
+		FilterText.Empty();
+		RefreshOptions();
+	}
+	else
+	{
+		// Nothing refers to the filtered list while closed
+		FilteredNames.Empty();
+		NameListView.Reset();
+		SearchBox.Reset();
+	}
+}
+
+void SGraphPinMixerObjectNameList::OnFilterTextChanged(const FText& NewText)
+{
+	FilterText = NewText.ToString();
+	RefreshOptions();
+}
+
+void SGraphPinMixerObjectNameList::OnFilterTextCommitted(const FText& NewText, ETextCommit::Type CommitType)
+{
+	if (CommitType == ETextCommit::OnEnter && FilteredNames.Num() > 0)
+	{
+		SetSelectedName(FilteredNames[0]);
+	}
+}
+
+void SGraphPinMixerObjectNameList::OnNameClicked(TSharedPtr<FName> NameItem)
+{
+	if (NameItem.IsValid())
+	{
+		SetSelectedName(NameItem);
+	}
+}
+
+void SGraphPinMixerObjectNameList::SetSelectedName(TSharedPtr<FName> NameItem)
 {
 	FName Name = NameItem.IsValid() ? *NameItem : NAME_None;
 	if (auto Schema = (GraphPinObj ? GraphPinObj->GetSchema() : NULL))
@@ -94,13 +134,22 @@ void SGraphPinMixerObjectNameList::ComboBoxSelectionChanged(TSharedPtr<FName> Na
 			Schema->TrySetDefaultValue(*GraphPinObj, NameAsString);
 		}
 	}
+
+	if (ComboButton.IsValid())
+	{
+		ComboButton->SetIsOpen(false);
+	}
 }
 
-TSharedRef<SWidget> SGraphPinMixerObjectNameList::GenerateWidgetForComboItem(TSharedPtr<FName> Name)
+TSharedRef<ITableRow> SGraphPinMixerObjectNameList::GenerateRowForName(TSharedPtr<FName> Name, const TSharedRef<STableViewBase>& OwnerTable)
 {
 	return
-		SNew(STextBlock)
-		.Text(FText::FromName(*Name));
+		SNew(STableRow<TSharedPtr<FName>>, OwnerTable)
+		[
+			SNew(STextBlock)
+			.Text(FText::FromName(*Name))
+			.HighlightText(FText::FromString(FilterText))
+		];
 }
 
 FText SGraphPinMixerObjectNameList::GetTextForSelectedItem() const
@@ -115,17 +164,10 @@ EVisibility SGraphPinMixerObjectNameList::GetErrorVisibility() const
 		return EVisibility::Collapsed;
 	}
 
-	const TArray<TSharedPtr<FName>>* NameList = &ItemsSource.Execute();
-	if (GraphPinObj && NameList)
+	// Evaluated every frame for every visible pin, so this must not scan the name list
+	if (GraphPinObj && IMixerInteractivityEditorModule::Get().FindDesignTimeObject(ObjectKind, FName(*GraphPinObj->GetDefaultAsString())).IsValid())
 	{
-		FName PreviousSelection = FName(*GraphPinObj->GetDefaultAsString());
-		for (TSharedPtr<FName> ListNamePtr : *NameList)
-		{
-			if (PreviousSelection == *ListNamePtr.Get())
-			{
-				return EVisibility::Collapsed;
-			}
-		}
+		return EVisibility::Collapsed;
 	}
 
 	return EVisibility::Visible;
@@ -133,10 +175,23 @@ EVisibility SGraphPinMixerObjectNameList::GetErrorVisibility() const
 
 void SGraphPinMixerObjectNameList::RefreshOptions()
 {
-	if (ComboBox.IsValid())
+	if (NameListView.IsValid())
 	{
-		ComboBox->RefreshOptions();
+		FilteredNames.Reset();
+		IMixerInteractivityEditorModule::Get().FilterDesignTimeObjects(ObjectKind, FilterText, FilteredNames);
+		NameListView->RequestListRefresh();
+
+		TSharedPtr<FName> CurrentSelection;
+		if (GraphPinObj)
+		{
+			CurrentSelection = IMixerInteractivityEditorModule::Get().FindDesignTimeObject(ObjectKind, FName(*GraphPinObj->GetDefaultAsString()));
+		}
+		if (CurrentSelection.IsValid() && FilteredNames.Contains(CurrentSelection))
+		{
+			NameListView->SetSelection(CurrentSelection, ESelectInfo::OnNavigation);
+			NameListView->RequestScrollIntoView(CurrentSelection);
+		}
 	}
 }
 
-#undef LOCTEXT_NAMESPACE
\ No newline at end of file
+#undef LOCTEXT_NAMESPACE
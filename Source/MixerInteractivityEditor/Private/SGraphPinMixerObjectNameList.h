@@ -11,30 +11,41 @@
 #pragma once
 
 #include "SGraphPin.h"
-#include "Widgets/Input/SComboBox.h"
+#include "Widgets/Input/SComboButton.h"
+#include "Widgets/Input/SSearchBox.h"
+#include "Widgets/Views/SListView.h"
 
-// Based on SGraphPinNameList, but with additions to allow refreshing the list
 class SGraphPinMixerObjectNameList : public SGraphPin
 {
 public:
 	SLATE_BEGIN_ARGS(SGraphPinMixerObjectNameList) {}
 	SLATE_END_ARGS()
 
-	DECLARE_DELEGATE_RetVal(const TArray<TSharedPtr<FName>>&, FGetMixerObjectNames);
-	void Construct(const FArguments& InArgs, UEdGraphPin* InGraphPinObj, FGetMixerObjectNames InItemsSource);
+	void Construct(const FArguments& InArgs, UEdGraphPin* InGraphPinObj, const FString& InObjectKind);
 
 protected:
 
 	virtual TSharedRef<SWidget>	GetDefaultValueWidget() override;
 
-	void ComboBoxSelectionChanged(TSharedPtr<FName> StringItem, ESelectInfo::Type SelectInfo);
-	TSharedRef<SWidget> GenerateWidgetForComboItem(TSharedPtr<FName> Name);
+	TSharedRef<SWidget> GetMenuContent();
+	void OnMenuOpenChanged(bool bOpen);
+	void OnFilterTextChanged(const FText& NewText);
+	void OnFilterTextCommitted(const FText& NewText, ETextCommit::Type CommitType);
+	void OnNameClicked(TSharedPtr<FName> NameItem);
+	TSharedRef<ITableRow> GenerateRowForName(TSharedPtr<FName> Name, const TSharedRef<STableViewBase>& OwnerTable);
+	void SetSelectedName(TSharedPtr<FName> NameItem);
 	FText GetTextForSelectedItem() const;
 	EVisibility GetErrorVisibility() const;
 	void RefreshOptions();
 
-	TSharedPtr<SComboBox<TSharedPtr<FName>>> ComboBox;
-	TWeakObjectPtr<UObject> ObjectType;
+	TSharedPtr<SComboButton> ComboButton;
+	TSharedPtr<SSearchBox> SearchBox;
+	TSharedPtr<SListView<TSharedPtr<FName>>> NameListView;
 
-	FGetMixerObjectNames ItemsSource;
-};
\ No newline at end of file
+	/** Kind of design-time object this pin names; the full list is owned by the editor module and shared by every pin of the kind. */
+	FString ObjectKind;
+
+	/** The subset of the shared list that matches FilterText.  Only this pin's dropdown (when open) looks at it. */
+	TArray<TSharedPtr<FName>> FilteredNames;
+	FString FilterText;
+};
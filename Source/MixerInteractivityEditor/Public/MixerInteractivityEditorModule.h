@@ -35,10 +35,27 @@ public:
 
 	virtual bool RequestAvailableInteractiveGames(FOnMixerInteractiveGamesRequestFinished OnFinished) = 0;
 
+	/**
+	 * Fetches the scenes and controls for a game version.  A copy cached on disk by an earlier request is
+	 * delivered first, in which case OnFinished runs a second time only if the service has a newer definition.
+	 */
 	virtual bool RequestInteractiveControlsForGameVersion(const FMixerInteractiveGameVersion& Version, FOnMixerInteractiveControlsRequestFinished OnFinished) = 0;
 
 	virtual const TArray<TSharedPtr<FName>>& GetDesignTimeObjects(FString ObjectKind) = 0;
 
+	/** Returns the shared entry for the named design-time object, or null if there is no such object of that kind. */
+	virtual TSharedPtr<FName> FindDesignTimeObject(FString ObjectKind, FName ObjectName) = 0;
+
+	/**
+	 * Appends the design-time objects of a kind whose names contain Filter (case insensitive),
+	 * names that start with the filter first.  An empty filter matches everything.
+	 */
+	virtual void FilterDesignTimeObjects(FString ObjectKind, const FString& Filter, TArray<TSharedPtr<FName>>& OutMatches) = 0;
+
+	/**
+	 * Rebuilds the design-time scenes, controls and groups from the current settings.
+	 * Listeners and Blueprint node actions are only refreshed for the parts that actually changed.
+	 */
 	virtual void RefreshDesignTimeObjects() = 0;
 
 	DECLARE_EVENT(IMixerInteractivityEditorModule, FOnDesignTimeObjectsChanged);
@@ -120,6 +120,7 @@ extern "C" {
 		interactive_input_type type;
 		const char* participantId;
 		size_t participantIdLength;
+		// Full <c>giveInput</c> params as JSON text. Only set for input_type_key and input_type_custom.
 		const char* jsonData;
 		size_t jsonDataLength;
 		const char* transactionId;
@@ -133,6 +134,15 @@ extern "C" {
 			float x;
 			float y;
 		} coordinateData;
+		// Fields of input_type_key and input_type_custom input already read from the parsed message, e.g. a textbox submit. Not null terminated.
+		struct customData
+		{
+			const char* eventType;
+			size_t eventTypeLength;
+			// Set only when the input's value is a string
+			const char* value;
+			size_t valueLength;
+		} customData;
 	};
 
 	struct interactive_group : public interactive_object
@@ -196,6 +206,47 @@ extern "C" {
 	/// </remarks>
 	int interactive_open_session(const char* auth, const char* versionId, const char* shareCode, bool setReady, interactive_session* session);
 
+	/// <summary>
+	/// Time spent, in milliseconds, in each phase of opening a session.
+	/// </summary>
+	struct interactive_open_timing
+	{
+		unsigned int hostLookupMs;
+		unsigned int socketOpenMs;
+		unsigned int handshakeMs;
+	};
+
+	typedef void(*on_session_opened)(void* context, interactive_session session, int result, const interactive_open_timing* timing);
+
+	/// <summary>
+	/// Open an interactive session without blocking the caller. The handle is returned immediately and <c>onOpened</c> is called from an SDK thread once the session is ready for use or has failed to open.
+	/// </summary>
+	/// <param name="hosts">Optional websocket addresses, in retry order, already retrieved by the caller. If <c>hostCount</c> is 0 the SDK looks them up itself.</param>
+	/// <param name="hostsUri">Optional address of the hosts lookup used when <c>hostCount</c> is 0. Defaults to the public Mixer API.</param>
+	/// <param name="onOpened">Called exactly once, at the latest before <c>interactive_close_session</c> returns. Closing a session that is still opening cancels the open and reports <c>MIXER_ERROR_CANCELLED</c>.</param>
+	/// <param name="context">Passed through to <c>onOpened</c>.</param>
+	/// <remarks>
+	/// The session must not be used, other than to close it, until <c>onOpened</c> has reported <c>MIXER_OK</c>. A session that failed to open must still be closed.
+	/// </remarks>
+	int interactive_open_session_async(const char* auth, const char* versionId, const char* shareCode, bool setReady, const char* const* hosts, size_t hostCount, const char* hostsUri, on_session_opened onOpened, void* context, interactive_session* session);
+
+	/// <summary>
+	/// Open a session with no service behind it, for measuring how the SDK handles traffic. Frames passed to <c>interactive_loopback_receive</c> are parsed and queued exactly as frames from the websocket are, and <c>interactive_run</c> hands them to the registered handlers. Anything the session sends is discarded.
+	/// </summary>
+	/// <param name="scenesResult">The <c>result</c> object of a <c>getScenes</c> reply, cached as though the service had sent it while the session opened.</param>
+	/// <remarks>
+	/// No replies ever arrive, so functions that wait on one block until they time out. A loopback session must still be closed with <c>interactive_close_session</c>.
+	/// </remarks>
+	int interactive_open_loopback_session(const char* scenesResult, size_t scenesResultLength, interactive_session* session);
+
+	/// <summary>
+	/// Hand a loopback session a websocket frame as though it had arrived from the service. Only one thread may do so at a time, as with the websocket's own receive thread.
+	/// </summary>
+	/// <remarks>
+	/// Like that thread, this blocks while 4096 methods are already waiting for <c>interactive_run</c>, so a caller that runs the session itself must do so before that many have been received.
+	/// </remarks>
+	int interactive_loopback_receive(interactive_session session, const char* frame, size_t frameLength);
+
 	// Interactive events
 	typedef void(*on_error)(void* context, interactive_session session, int errorCode, const char* errorMessage, size_t errorMessageLength);
 	typedef void(*on_state_changed)(void* context, interactive_session session, interactive_state previousState, interactive_state newState);
@@ -203,6 +254,8 @@ extern "C" {
 	typedef void(*on_participants_changed)(void* context, interactive_session session, interactive_participant_action action, const interactive_participant* participant);
 	typedef void(*on_transaction_complete)(void* context, interactive_session session, const char* transactionId, size_t transactionIdLength, unsigned int error, const char* errorMessage, size_t errorMessageLength);
 	typedef void(*on_unhandled_method)(void* context, interactive_session session, const char* methodJson, size_t methodJsonLength);
+	/// Called after the session's group cache has been refreshed from the service, e.g. on onGroupCreate or onGroupUpdate. Enumerate with <c>interactive_get_groups</c>.
+	typedef void(*on_groups_changed)(void* context, interactive_session session);
 
 	int interactive_register_error_handler(interactive_session session, on_error onError);
 	int interactive_register_state_changed_handler(interactive_session session, on_state_changed onStateChanged);
@@ -210,6 +263,7 @@ extern "C" {
 	int interactive_register_participants_changed_handler(interactive_session session, on_participants_changed onParticipantsChanged);
 	int interactive_register_transaction_complete_handler(interactive_session session, on_transaction_complete onTransactionComplete);
 	int interactive_register_unhandled_method_handler(interactive_session session, on_unhandled_method onUnhandledMethod);
+	int interactive_register_groups_changed_handler(interactive_session session, on_groups_changed onGroupsChanged);
 
 	/// <summary>
 	/// Disconnect from an interactive session and clean up memory.
@@ -239,6 +293,15 @@ extern "C" {
 	/// </summary>
 	int interactive_set_session_context(interactive_session session, void* context);
 
+	/// <summary>
+	/// Replace the authorization header for the specified session, e.g. after the OAuth token has been refreshed.
+	/// </summary>
+	/// <remarks>
+	/// The header is sent when the websocket is opened, so this affects a session that is still connecting. A session that is
+	/// already open keeps its connection; the new value is used if that session connects again.
+	/// </remarks>
+	int interactive_set_session_authorization(interactive_session session, const char* auth);
+
 	/// <summary>
 	/// Get the previously set session context. Context will be nullptr on return if no context has been set.
 	/// </summary>
@@ -268,6 +331,11 @@ extern "C" {
 	/// </remarks>
 	int interactive_run(interactive_session session, unsigned int maxEventsToProcess);
 
+	/// <summary>
+	/// Get the number of errors and incoming methods that have been received from the interactive service but not yet processed by <c>interactive_run</c>.
+	/// </summary>
+	int interactive_get_pending_event_count(interactive_session session, unsigned int* count);
+
 	/// <summary>
 	/// Send a method to the interactive session. This may be used to interface with the interactive protocol directly and implement functionality 
 	/// that this SDK does not provide out of the box.
@@ -277,6 +345,15 @@ extern "C" {
 	/// </remarks>
 	int interactive_send_method(interactive_session session, const char* method, const char* paramsJson, bool discardReply, unsigned int* id);
 
+	/// <summary>
+	/// As <c>interactive_send_method</c>, but <c>paramsJson</c> is copied into the message unchanged instead of being parsed and re-serialized.
+	/// The caller must pass a single well formed JSON object; it is not validated.
+	/// </summary>
+	/// <remarks>
+	/// This is a blocking function that waits on network IO.
+	/// </remarks>
+	int interactive_send_method_raw(interactive_session session, const char* method, const char* paramsJson, size_t paramsJsonLength, bool discardReply, unsigned int* id);
+
 	/// <summary>
 	/// Recieve a reply for a method with the specified id. This may be used to interface with the interactive protocol directly and implement functionality
 	/// that this SDK does not provide out of the box.
@@ -286,6 +363,18 @@ extern "C" {
 	/// </remarks>
 	int interactive_receive_reply(interactive_session session, unsigned int id, unsigned int timeoutMs, char* replyJson, size_t* replyJsonLength);
 
+	typedef void(*on_method_reply)(void* context, interactive_session session, unsigned int requestId, unsigned int error, const char* errorMessage, size_t errorMessageLength, const char* resultJson, size_t resultJsonLength);
+
+	/// <summary>
+	/// Queue a method for the interactive session without waiting on network IO. This is the non-blocking counterpart to <c>interactive_send_method</c>
+	/// and <c>interactive_receive_reply</c>.
+	/// </summary>
+	/// <remarks>
+	/// If onReply is not null it is called with requestId from <c>interactive_run</c> once the service replies. resultJson is the reply's result
+	/// serialized as JSON ("null" for an explicit null result), or nullptr if the reply had no result member. Replies that never arrive are not reported; the caller is responsible for any timeout.
+	/// </remarks>
+	int interactive_queue_method(interactive_session session, const char* method, const char* paramsJson, size_t paramsJsonLength, unsigned int requestId, on_method_reply onReply);
+
 	/// <summary>
 	/// Capture a transaction to charge a participant the input's spark cost. This should be called before
 	/// taking further action on input as the participant may not have enough sparks or the transaction may have expired.
@@ -315,6 +404,35 @@ extern "C" {
 	/// </summary>
 	int interactive_group_set_scene(interactive_session session, const char* groupId, const char* sceneId);
 
+	/// <summary>
+	/// A group and its scene, as passed to <c>interactive_create_groups</c> and <c>interactive_set_groups_scenes</c>.
+	/// </summary>
+	struct interactive_group_scene
+	{
+		const char* groupId;
+		const char* sceneId;
+	};
+
+	typedef void(*on_groups_method_complete)(void* context, interactive_session session, unsigned int requestId, unsigned int error, const char* errorMessage, size_t errorMessageLength);
+
+	/// <summary>
+	/// Create several groups with a single <c>createGroups</c> call. Groups with a null sceneId are set to the default scene.
+	/// </summary>
+	/// <remarks>
+	/// If onComplete is not null it is called with requestId once the service has replied to the whole batch.
+	/// The caller is responsible for keeping the batch within the service's message size limits.
+	/// </remarks>
+	int interactive_create_groups(interactive_session session, const interactive_group_scene* groups, size_t groupCount, unsigned int requestId, on_groups_method_complete onComplete);
+
+	/// <summary>
+	/// Set the scenes of several groups with a single <c>updateGroups</c> call.
+	/// </summary>
+	/// <remarks>
+	/// If onComplete is not null it is called with requestId once the service has replied to the whole batch.
+	/// The caller is responsible for keeping the batch within the service's message size limits.
+	/// </remarks>
+	int interactive_set_groups_scenes(interactive_session session, const interactive_group_scene* groups, size_t groupCount, unsigned int requestId, on_groups_method_complete onComplete);
+
 	/// <summary>
 	/// Get all scenes for the specified session.
 	/// </summary>
@@ -364,6 +482,33 @@ extern "C" {
 	int interactive_control_get_meta_property_float(interactive_session session, const char* controlId, const char* key, float* property);
 	int interactive_control_get_meta_property_string(interactive_session session, const char* controlId, const char* key, char* property, size_t* propertyLength);
 
+	/// <summary>
+	/// One top level property of a control, as seen by <c>interactive_scene_get_controls_with_properties</c>.
+	/// Only the value member matching <c>type</c> is set. Array and object properties carry no value.
+	/// </summary>
+	struct interactive_control_property
+	{
+		const char* name;
+		size_t nameLength;
+		interactive_property_type type;
+		long long intValue;
+		bool boolValue;
+		float floatValue;
+		const char* stringValue;
+		size_t stringValueLength;
+	};
+
+	typedef void(*on_control_properties_enumerate)(void* context, interactive_session session, interactive_control* control, const interactive_control_property* properties, size_t propertyCount);
+
+	/// <summary>
+	/// Get a scene's controls along with all of their top level properties, reading the cached scene document once under a single lock.
+	/// </summary>
+	/// <remarks>
+	/// Names and string values point into the cached scene document and are only valid for the duration of the callback. They are not null terminated.
+	/// The callback must not modify scenes or controls.
+	/// </remarks>
+	int interactive_scene_get_controls_with_properties(interactive_session session, const char* sceneId, on_control_properties_enumerate onControl);
+
 	/// <summary>
 	/// Get all participants for the specified session.
 	/// </summary>
@@ -377,6 +522,23 @@ extern "C" {
 	/// </remarks>
 	int interactive_set_participant_group(interactive_session session, const char* participantId, const char* groupId);
 
+	/// <summary>
+	/// Move several participants to the same group with a single <c>updateParticipants</c> call.
+	/// </summary>
+	/// <remarks>
+	/// The caller is responsible for keeping the batch within the service's message size limits.
+	/// </remarks>
+	int interactive_set_participants_group(interactive_session session, const char* const* participantIds, size_t participantCount, const char* groupId);
+
+	/// <summary>
+	/// Read all of a participant's cached fields with a single roster lookup.
+	/// </summary>
+	/// <remarks>
+	/// The strings point into the session's roster, so they are only valid until the next participant change, and the call
+	/// should be made from the thread running <c>interactive_run</c>.
+	/// </remarks>
+	int interactive_get_participant(interactive_session session, const char* participantId, interactive_participant* participant);
+
 	int interactive_get_participant_user_id(interactive_session session, const char* participantId, unsigned int* userId);
 	int interactive_get_participant_user_name(interactive_session session, const char* participantId, char* userName, size_t* userNameLength);
 	int interactive_get_participant_level(interactive_session session, const char* participantId, unsigned int* level);
@@ -118,6 +118,52 @@ int get_scene_object_prop_data(interactive_session_internal& session, const char
 	return MIXER_OK;
 }
 
+void get_control_properties(const rapidjson::Value& control, std::vector<interactive_control_property>& properties)
+{
+	properties.clear();
+	properties.reserve(control.MemberCount());
+	for (auto itr = control.MemberBegin(); itr != control.MemberEnd(); ++itr)
+	{
+		interactive_control_property property = {};
+		property.name = itr->name.GetString();
+		property.nameLength = itr->name.GetStringLength();
+		property.type = interactive_property_type::interactive_unknown_t;
+
+		const rapidjson::Value& value = itr->value;
+		if (value.IsString())
+		{
+			property.type = interactive_property_type::interactive_string_t;
+			property.stringValue = value.GetString();
+			property.stringValueLength = value.GetStringLength();
+		}
+		else if (value.IsInt64())
+		{
+			property.type = interactive_property_type::interactive_int_t;
+			property.intValue = value.GetInt64();
+		}
+		else if (value.IsBool())
+		{
+			property.type = interactive_property_type::interactive_bool_t;
+			property.boolValue = value.GetBool();
+		}
+		else if (value.IsNumber())
+		{
+			property.type = interactive_property_type::interactive_float_t;
+			property.floatValue = value.GetFloat();
+		}
+		else if (value.IsArray())
+		{
+			property.type = interactive_property_type::interactive_array_t;
+		}
+		else if (value.IsObject())
+		{
+			property.type = interactive_property_type::interactive_object_t;
+		}
+
+		properties.push_back(property);
+	}
+}
+
 int verify_get_property_args_and_get_control_value(interactive_session session, const char* controlId, const char* key, void* property, rapidjson::Value** controlValue)
 {
 	if (nullptr == session || nullptr == property || nullptr == controlValue)
@@ -30,6 +30,59 @@ int cache_groups(interactive_session_internal& session)
 	return MIXER_OK;
 }
 
+int queue_groups_method(interactive_session_internal& session, const std::string& method, const interactive_group_scene* groups, size_t groupCount, unsigned int requestId, on_groups_method_complete onComplete)
+{
+	for (size_t i = 0; i < groupCount; ++i)
+	{
+		if (nullptr == groups[i].groupId)
+		{
+			return MIXER_ERROR_INVALID_POINTER;
+		}
+	}
+
+	method_handler onReply = nullptr;
+	if (nullptr != onComplete)
+	{
+		onReply = [requestId, onComplete](interactive_session_internal& replySession, rapidjson::Document& replyDoc)
+		{
+			unsigned int err = 0;
+			std::string errMessage;
+			if (replyDoc.HasMember(RPC_ERROR) && replyDoc[RPC_ERROR].IsObject())
+			{
+				// Any error object fails the batch, even one without a code
+				err = MIXER_ERROR;
+				if (replyDoc[RPC_ERROR].HasMember(RPC_ERROR_CODE))
+				{
+					err = replyDoc[RPC_ERROR][RPC_ERROR_CODE].GetUint();
+				}
+				if (replyDoc[RPC_ERROR].HasMember(RPC_ERROR_MESSAGE))
+				{
+					errMessage = replyDoc[RPC_ERROR][RPC_ERROR_MESSAGE].GetString();
+				}
+			}
+
+			onComplete(replySession.callerContext, &replySession, requestId, err, errMessage.c_str(), errMessage.length());
+			return MIXER_OK;
+		};
+	}
+
+	RETURN_IF_FAILED(queue_method(session, method, [&](rapidjson::Document::AllocatorType& allocator, rapidjson::Value& params)
+	{
+		rapidjson::Value groupsArray(rapidjson::kArrayType);
+		groupsArray.Reserve(static_cast<rapidjson::SizeType>(groupCount), allocator);
+		for (size_t i = 0; i < groupCount; ++i)
+		{
+			rapidjson::Value group(rapidjson::kObjectType);
+			group.AddMember(RPC_GROUP_ID, std::string(groups[i].groupId), allocator);
+			group.AddMember(RPC_SCENE_ID, std::string(nullptr != groups[i].sceneId ? groups[i].sceneId : RPC_SCENE_DEFAULT), allocator);
+			groupsArray.PushBack(group, allocator);
+		}
+		params.AddMember(RPC_PARAM_GROUPS, groupsArray, allocator);
+	}, onReply));
+
+	return MIXER_OK;
+}
+
 }
 
 using namespace mixer_internal;
@@ -108,4 +161,36 @@ int interactive_group_set_scene(interactive_session session, const char* groupId
 	}, nullptr));
 
 	return MIXER_OK;
+}
+
+int interactive_create_groups(interactive_session session, const interactive_group_scene* groups, size_t groupCount, unsigned int requestId, on_groups_method_complete onComplete)
+{
+	if (nullptr == session || nullptr == groups)
+	{
+		return MIXER_ERROR_INVALID_POINTER;
+	}
+
+	if (0 == groupCount)
+	{
+		return MIXER_OK;
+	}
+
+	interactive_session_internal* sessionInternal = reinterpret_cast<interactive_session_internal*>(session);
+	return queue_groups_method(*sessionInternal, RPC_METHOD_CREATE_GROUPS, groups, groupCount, requestId, onComplete);
+}
+
+int interactive_set_groups_scenes(interactive_session session, const interactive_group_scene* groups, size_t groupCount, unsigned int requestId, on_groups_method_complete onComplete)
+{
+	if (nullptr == session || nullptr == groups)
+	{
+		return MIXER_ERROR_INVALID_POINTER;
+	}
+
+	if (0 == groupCount)
+	{
+		return MIXER_OK;
+	}
+
+	interactive_session_internal* sessionInternal = reinterpret_cast<interactive_session_internal*>(session);
+	return queue_groups_method(*sessionInternal, RPC_METHOD_UPDATE_GROUPS, groups, groupCount, requestId, onComplete);
 }
\ No newline at end of file
@@ -19,6 +19,32 @@ void parse_participant(rapidjson::Value& participantJson, interactive_participan
 	participant.groupIdLength = participantJson[RPC_GROUP_ID].GetStringLength();
 }
 
+void store_participant(const interactive_participant& participant, participant_record& record)
+{
+	record.userId = participant.userId;
+	record.level = participant.level;
+	record.lastInputAtMs = participant.lastInputAtMs;
+	record.connectedAtMs = participant.connectedAtMs;
+	record.disabled = participant.disabled;
+	record.userName.assign(participant.userName, participant.usernameLength);
+	record.groupId.assign(participant.groupId, participant.groupIdLength);
+}
+
+void read_participant(const std::string& participantId, const participant_record& record, interactive_participant& participant)
+{
+	participant.id = participantId.c_str();
+	participant.idLength = participantId.length();
+	participant.userId = record.userId;
+	participant.userName = record.userName.c_str();
+	participant.usernameLength = record.userName.length();
+	participant.level = record.level;
+	participant.lastInputAtMs = record.lastInputAtMs;
+	participant.connectedAtMs = record.connectedAtMs;
+	participant.disabled = record.disabled;
+	participant.groupId = record.groupId.c_str();
+	participant.groupIdLength = record.groupId.length();
+}
+
 }
 
 using namespace mixer_internal;
@@ -34,7 +60,7 @@ int interactive_get_participants(interactive_session session, on_participant_enu
 	for (auto& participantById : sessionInternal->participants)
 	{
 		interactive_participant participant;
-		parse_participant(*participantById.second, participant);
+		read_participant(participantById.first, participantById.second, participant);
 		onParticipant(sessionInternal->callerContext, sessionInternal, &participant);
 	}
 
@@ -64,6 +90,64 @@ int interactive_set_participant_group(interactive_session session, const char* p
 	return MIXER_OK;
 }
 
+int interactive_set_participants_group(interactive_session session, const char* const* participantIds, size_t participantCount, const char* groupId)
+{
+	if (nullptr == session || nullptr == participantIds || nullptr == groupId)
+	{
+		return MIXER_ERROR_INVALID_POINTER;
+	}
+
+	if (0 == participantCount)
+	{
+		return MIXER_OK;
+	}
+
+	for (size_t i = 0; i < participantCount; ++i)
+	{
+		if (nullptr == participantIds[i])
+		{
+			return MIXER_ERROR_INVALID_POINTER;
+		}
+	}
+
+	interactive_session_internal* sessionInternal = reinterpret_cast<interactive_session_internal*>(session);
+
+	RETURN_IF_FAILED(queue_method(*sessionInternal, RPC_METHOD_UPDATE_PARTICIPANTS, [&](rapidjson::Document::AllocatorType& allocator, rapidjson::Value& params)
+	{
+		rapidjson::Value participants(rapidjson::kArrayType);
+		participants.Reserve(static_cast<rapidjson::SizeType>(participantCount), allocator);
+		for (size_t i = 0; i < participantCount; ++i)
+		{
+			rapidjson::Value participant(rapidjson::kObjectType);
+			participant.AddMember(RPC_SESSION_ID, std::string(participantIds[i]), allocator);
+			participant.AddMember(RPC_GROUP_ID, std::string(groupId), allocator);
+			participants.PushBack(participant, allocator);
+		}
+		params.AddMember(RPC_PARAM_PARTICIPANTS, participants, allocator);
+		params.AddMember("priority", 0, allocator);
+	}, nullptr));
+
+	return MIXER_OK;
+}
+
+int interactive_get_participant(interactive_session session, const char* participantId, interactive_participant* participant)
+{
+	if (nullptr == session || nullptr == participantId || nullptr == participant)
+	{
+		return MIXER_ERROR_INVALID_POINTER;
+	}
+
+	interactive_session_internal* sessionInternal = reinterpret_cast<interactive_session_internal*>(session);
+	auto participantItr = sessionInternal->participants.find(std::string(participantId));
+	if (sessionInternal->participants.end() == participantItr)
+	{
+		return MIXER_ERROR_OBJECT_NOT_FOUND;
+	}
+
+	read_participant(participantItr->first, participantItr->second, *participant);
+	return MIXER_OK;
+}
+
 int interactive_get_participant_user_id(interactive_session session, const char* participantId, unsigned int* userId)
 {
 	if (nullptr == session || nullptr == participantId || nullptr == userId)
@@ -78,8 +162,7 @@ int interactive_get_participant_user_id(interactive_session session, const char*
 		return MIXER_ERROR_OBJECT_NOT_FOUND;
 	}
 
-	std::shared_ptr<rapidjson::Document> participantDoc = participantItr->second;
-	*userId = (*participantDoc)[RPC_USER_ID].GetUint();
+	*userId = participantItr->second.userId;
 	return MIXER_OK;
 }
 
@@ -97,16 +180,15 @@ int interactive_get_participant_user_name(interactive_session session, const cha
 		return MIXER_ERROR_OBJECT_NOT_FOUND;
 	}
 
-	std::shared_ptr<rapidjson::Document> participantDoc = participantItr->second;
-
-	size_t actualLength = (*participantDoc)[RPC_USERNAME].GetStringLength();
+	const std::string& participantUserName = participantItr->second.userName;
+	size_t actualLength = participantUserName.length();
 	if (nullptr == userName || *userNameLength < actualLength + 1)
 	{
 		*userNameLength = actualLength + 1;
 		return MIXER_ERROR_BUFFER_SIZE;
 	}
 
-	memcpy(userName, (*participantDoc)[RPC_USERNAME].GetString(), actualLength);
+	memcpy(userName, participantUserName.c_str(), actualLength);
 	userName[actualLength] = 0;
 	*userNameLength = actualLength + 1;
 	return MIXER_OK;
@@ -126,8 +208,7 @@ int interactive_get_participant_level(interactive_session session, const char* p
 		return MIXER_ERROR_OBJECT_NOT_FOUND;
 	}
 
-	std::shared_ptr<rapidjson::Document> participantDoc = participantItr->second;
-	*level = (*participantDoc)[RPC_LEVEL].GetUint();
+	*level = participantItr->second.level;
 	return MIXER_OK;
 }
 
@@ -145,8 +226,7 @@ int interactive_get_participant_last_input_at(interactive_session session, const
 		return MIXER_ERROR_OBJECT_NOT_FOUND;
 	}
 
-	std::shared_ptr<rapidjson::Document> participantDoc = participantItr->second;
-	*lastInputAt = (*participantDoc)[RPC_PART_LAST_INPUT].GetUint64();
+	*lastInputAt = participantItr->second.lastInputAtMs;
 	return MIXER_OK;
 }
 
@@ -164,8 +244,7 @@ int interactive_get_participant_connected_at(interactive_session session, const
 		return MIXER_ERROR_OBJECT_NOT_FOUND;
 	}
 
-	std::shared_ptr<rapidjson::Document> participantDoc = participantItr->second;
-	*connectedAt = (*participantDoc)[RPC_PART_CONNECTED].GetUint64();
+	*connectedAt = participantItr->second.connectedAtMs;
 	return MIXER_OK;
 }
 
@@ -183,8 +262,7 @@ int interactive_get_participant_is_disabled(interactive_session session, const c
 		return MIXER_ERROR_OBJECT_NOT_FOUND;
 	}
 
-	std::shared_ptr<rapidjson::Document> participantDoc = participantItr->second;
-	*isDisabled = (*participantDoc)[RPC_DISABLED].GetBool();
+	*isDisabled = participantItr->second.disabled;
 	return MIXER_OK;
 }
 
@@ -202,15 +280,15 @@ int interactive_get_participant_group(interactive_session session, const char* p
 		return MIXER_ERROR_OBJECT_NOT_FOUND;
 	}
 
-	std::shared_ptr<rapidjson::Document> participantDoc = participantItr->second;
-	size_t actualLength = (*participantDoc)[RPC_GROUP_ID].GetStringLength();
+	const std::string& participantGroupId = participantItr->second.groupId;
+	size_t actualLength = participantGroupId.length();
 	if (nullptr == group || *groupLength < actualLength + 1)
 	{
 		*groupLength = actualLength + 1;
 		return MIXER_ERROR_BUFFER_SIZE;
 	}
 
-	memcpy(group, (*participantDoc)[RPC_GROUP_ID].GetString(), actualLength);
+	memcpy(group, participantGroupId.c_str(), actualLength);
 	group[actualLength] = 0;
 	*groupLength = actualLength + 1;
 	return MIXER_OK;
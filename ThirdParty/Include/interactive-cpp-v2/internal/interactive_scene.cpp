@@ -12,6 +12,11 @@ int cache_scenes(interactive_session_internal& session)
 	std::shared_ptr<rapidjson::Document> reply;
 	RETURN_IF_FAILED(receive_reply(session, id, reply));
 
+	return store_scenes(session, (*reply)[RPC_RESULT]);
+}
+
+int store_scenes(interactive_session_internal& session, rapidjson::Value& result)
+{
 	// Get the scenes array from the result and set up pointers to scenes and controls.
 	std::unique_lock<std::shared_mutex> l(session.scenesMutex);
 	session.controls.clear();
@@ -20,7 +25,7 @@ int cache_scenes(interactive_session_internal& session)
 
 	// Copy just the scenes array portion of the reply into the cached scenes root.
 	rapidjson::Value scenesArray(rapidjson::kArrayType);
-	rapidjson::Value replyScenesArray = (*reply)[RPC_RESULT][RPC_PARAM_SCENES].GetArray();
+	rapidjson::Value replyScenesArray = result[RPC_PARAM_SCENES].GetArray();
 	scenesArray.CopyFrom(replyScenesArray, session.scenesRoot.GetAllocator());
 	session.scenesRoot.AddMember(RPC_PARAM_SCENES, scenesArray, session.scenesRoot.GetAllocator());
 
@@ -138,5 +143,42 @@ int interactive_scene_get_controls(interactive_session session, const char* scen
 		}
 	}
 
+	return MIXER_OK;
+}
+
+int interactive_scene_get_controls_with_properties(interactive_session session, const char* sceneId, on_control_properties_enumerate onControl)
+{
+	if (nullptr == session || nullptr == onControl)
+	{
+		return MIXER_ERROR_INVALID_POINTER;
+	}
+
+	interactive_session_internal* sessionInternal = reinterpret_cast<interactive_session_internal*>(session);
+
+	// One lock for the whole scene rather than one per property lookup.
+	std::shared_lock<std::shared_mutex> l(sessionInternal->scenesMutex);
+	auto sceneItr = sessionInternal->scenes.find(sceneId);
+	if (sessionInternal->scenes.end() == sceneItr)
+	{
+		return MIXER_ERROR_OBJECT_NOT_FOUND;
+	}
+
+	rapidjson::Value* sceneVal = rapidjson::Pointer(sceneItr->second.c_str()).Get(sessionInternal->scenesRoot);
+	if (sceneVal->HasMember(RPC_PARAM_CONTROLS) && (*sceneVal)[RPC_PARAM_CONTROLS].IsArray() && !(*sceneVal)[RPC_PARAM_CONTROLS].Empty())
+	{
+		// Reused across controls so that enumeration allocates at most a handful of times per scene.
+		std::vector<interactive_control_property> properties;
+		for (auto& controlObj : (*sceneVal)[RPC_PARAM_CONTROLS].GetArray())
+		{
+			interactive_control control;
+			control.id = controlObj[RPC_CONTROL_ID].GetString();
+			control.idLength = controlObj[RPC_CONTROL_ID].GetStringLength();
+			control.kind = controlObj[RPC_CONTROL_KIND].GetString();
+			control.kindLength = controlObj[RPC_CONTROL_KIND].GetStringLength();
+			get_control_properties(controlObj, properties);
+			onControl(sessionInternal->callerContext, sessionInternal, &control, properties.data(), properties.size());
+		}
+	}
+
 	return MIXER_OK;
 }
\ No newline at end of file
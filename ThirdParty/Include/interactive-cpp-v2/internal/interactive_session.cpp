@@ -2,6 +2,7 @@
 #include "common.h"
 
 #include <functional>
+#include <chrono>
 
 namespace mixer_internal
 {
@@ -10,7 +11,7 @@ typedef std::function<void(rapidjson::Document::AllocatorType& allocator, rapidj
 
 int create_method_json(interactive_session_internal& session, const std::string& method, on_get_params getParams, bool discard, unsigned int* id, std::shared_ptr<rapidjson::Document>& methodDoc)
 {
-	std::shared_ptr<rapidjson::Document> doc(std::make_shared<rapidjson::Document>());
+	std::shared_ptr<rapidjson::Document> doc(session.documentPool->acquire());
 	doc->SetObject();
 	rapidjson::Document::AllocatorType& allocator = doc->GetAllocator();
 
@@ -57,13 +58,23 @@ int queue_method(interactive_session_internal& session, const std::string& metho
 	DEBUG_TRACE(std::string("Queueing method: ") + jsonStringify(*methodDoc));
 	if (onReply)
 	{
-		session.replyHandlersById[packetId] = onReply;
+		// interactive_run reads and erases these on whichever thread is running the session
+		std::lock_guard<std::mutex> repliesLock(session.repliesMutex);
+		session.replyHandlersById[packetId] = pending_reply_handler{ onReply, std::chrono::steady_clock::now() };
 	}
 
-	// Synchronize write access to the queue.
-	std::unique_lock<std::mutex> queueLock(session.outgoingMutex);
-	session.outgoingMethods.emplace(methodDoc);
-	session.outgoingCV.notify_one();
+	// The outgoing thread drains the queue continuously, so a full queue only needs a short wait.
+	while (!session.outgoingMethods.try_push(std::move(methodDoc)))
+	{
+		if (session.shutdownRequested)
+		{
+			return MIXER_ERROR_CANCELLED;
+		}
+
+		std::this_thread::yield();
+	}
+
+	session.outgoingEvents.notify_all();
 
 	return MIXER_OK;
 }
@@ -88,13 +99,19 @@ int queue_request(interactive_session_internal& session, const std::string uri,
 		session.httpResponseHandlers[httpRequest.packetId] = onResponse;
 	}
 
-	// Queue the request, synchronizing access.
+	// Queue the request and wake the http thread.
+	while (!session.outgoingRequests.try_push(std::move(httpRequest)))
 	{
-		std::unique_lock<std::mutex> lock(session.outgoingMutex);
-		session.outgoingRequests.emplace(httpRequest);
-		session.outgoingCV.notify_one();
+		if (session.shutdownRequested)
+		{
+			return MIXER_ERROR_CANCELLED;
+		}
+
+		std::this_thread::yield();
 	}
 
+	session.httpEvents.notify_all();
+
 	return MIXER_OK;
 }
 
@@ -124,7 +141,7 @@ int receive_reply(interactive_session_internal& session, unsigned int id, std::s
 {
 	if (session.shutdownRequested)
 	{
-		return MIXER_OK;
+		return MIXER_ERROR_CANCELLED;
 	}
 
 	// Wait for a reply
@@ -153,7 +170,7 @@ int receive_reply(interactive_session_internal& session, unsigned int id, std::s
 			return MIXER_ERROR_TIMED_OUT;
 		}
 
-		spReply = (*replyItr).second;
+		spReply = (*replyItr).second.doc;
 		session.replies.erase(replyItr);
 	}
 
@@ -200,9 +217,8 @@ int handle_input(interactive_session_internal& session, rapidjson::Document& doc
 
 	interactive_input inputData;
 	memset(&inputData, 0, sizeof(inputData));
-	std::string inputJson = jsonStringify(doc[RPC_PARAMS]);
-	inputData.jsonData = inputJson.c_str();
-	inputData.jsonDataLength = inputJson.length();
+	// Only key and custom input carry the params as text; click and move input is fully described by the typed fields.
+	std::string inputJson;
 	rapidjson::Value& input = doc[RPC_PARAMS][RPC_PARAM_INPUT];
 	inputData.control.id = input[RPC_CONTROL_ID].GetString();
 	inputData.control.idLength = input[RPC_CONTROL_ID].GetStringLength();
@@ -291,6 +307,20 @@ int handle_input(interactive_session_internal& session, rapidjson::Document& doc
 	else
 	{
 		inputData.type = input_type_custom;
+		if (input.HasMember(RPC_VALUE) && input[RPC_VALUE].IsString())
+		{
+			inputData.customData.value = input[RPC_VALUE].GetString();
+			inputData.customData.valueLength = input[RPC_VALUE].GetStringLength();
+		}
+	}
+
+	if (input_type_key == inputData.type || input_type_custom == inputData.type)
+	{
+		inputData.customData.eventType = input[RPC_PARAM_INPUT_EVENT].GetString();
+		inputData.customData.eventTypeLength = input[RPC_PARAM_INPUT_EVENT].GetStringLength();
+		inputJson = jsonStringify(doc[RPC_PARAMS]);
+		inputData.jsonData = inputJson.c_str();
+		inputData.jsonDataLength = inputJson.length();
 	}
 
 	session.onInput(session.callerContext, &session, &inputData);
@@ -322,15 +352,14 @@ int handle_participants_change(interactive_session_internal& session, rapidjson:
 		case participant_join:
 		case participant_update:
 		{
-			std::shared_ptr<rapidjson::Document> participantDoc(std::make_shared<rapidjson::Document>());
-			participantDoc->CopyFrom(*itr, participantDoc->GetAllocator());
-			session.participants[participant.id] = participantDoc;
+			// Updates overwrite the existing record in place, reusing its string storage
+			store_participant(participant, session.participants[std::string(participant.id, participant.idLength)]);
 			break;
 		}
 		case participant_leave:
 		default:
 		{
-			session.participants.erase(participant.id);
+			session.participants.erase(std::string(participant.id, participant.idLength));
 			break;
 		}
 		}
@@ -381,7 +410,13 @@ int handle_ready(interactive_session_internal& session, rapidjson::Document& doc
 int handle_group_changed(interactive_session_internal& session, rapidjson::Document& doc)
 {
 	(doc);
-	return cache_groups(session);
+	RETURN_IF_FAILED(cache_groups(session));
+	if (session.onGroupsChanged)
+	{
+		session.onGroupsChanged(session.callerContext, &session);
+	}
+
+	return MIXER_OK;
 }
 
 int handle_scene_changed(interactive_session_internal& session, rapidjson::Document& doc)
@@ -428,8 +463,9 @@ int get_hosts(interactive_session_internal& session)
 {
 	DEBUG_INFO("Retrieving hosts.");
 	http_response response;
-	static std::string hosts = "https://mixer.com/api/v1/interactive/hosts";
-	RETURN_IF_FAILED(session.http->make_request(hosts, "GET", nullptr, "", response));
+	static std::string defaultHostsUri = "https://mixer.com/api/v1/interactive/hosts";
+	const std::string& hostsUri = session.hostsUri.empty() ? defaultHostsUri : session.hostsUri;
+	RETURN_IF_FAILED(session.http->make_request(hostsUri, "GET", nullptr, "", response));
 
 	if (200 != response.statusCode)
 	{
@@ -490,7 +526,15 @@ int update_server_time_offset(interactive_session_internal& session)
 	return MIXER_OK;
 }
 
-int do_connect(interactive_session_internal& session, bool isReady)
+unsigned int elapsed_ms(std::chrono::steady_clock::time_point& phaseStart)
+{
+	auto now = std::chrono::steady_clock::now();
+	unsigned int elapsed = static_cast<unsigned int>(std::chrono::duration_cast<std::chrono::milliseconds>(now - phaseStart).count());
+	phaseStart = now;
+	return elapsed;
+}
+
+int do_connect(interactive_session_internal& session, bool isReady, interactive_open_timing* timing = nullptr)
 {
 	session.isReady = isReady;
 
@@ -500,17 +544,36 @@ int do_connect(interactive_session_internal& session, bool isReady)
 		return MIXER_OK;
 	}
 
-	err = get_hosts(session);
-	if (err && session.onError)
+	interactive_open_timing unusedTiming;
+	if (nullptr == timing)
 	{
-		std::string errorMessage = "Failed to acquire interactive host servers.";
-		session.onError(session.callerContext, &session, err, errorMessage.c_str(), errorMessage.length());
-		return err;
+		timing = &unusedTiming;
 	}
+	auto phaseStart = std::chrono::steady_clock::now();
+
+	// Hosts may have been supplied by the caller.
+	if (session.hosts.empty())
+	{
+		err = get_hosts(session);
+		if (err)
+		{
+			if (session.onError)
+			{
+				std::string errorMessage = "Failed to acquire interactive host servers.";
+				session.onError(session.callerContext, &session, err, errorMessage.c_str(), errorMessage.length());
+			}
+			return err;
+		}
+	}
+	timing->hostLookupMs = elapsed_ms(phaseStart);
 
 	// Connect long running websocket.
 	session.ws->add_header("X-Protocol-Version", "2.0");
-	session.ws->add_header("Authorization", session.authorization);
+	{
+		// May be replaced from the caller's thread by interactive_set_session_authorization.
+		std::lock_guard<std::mutex> authorizationLock(session.authorizationMutex);
+		session.ws->add_header("Authorization", session.authorization);
+	}
 	session.ws->add_header("X-Interactive-Version", session.versionId);
 	if (!session.shareCode.empty())
 	{
@@ -520,20 +583,28 @@ int do_connect(interactive_session_internal& session, bool isReady)
 	// Create thread to open websocket and receive messages.
 	session.incomingThread = std::thread(std::bind(&interactive_session_internal::run_incoming_thread, &session));
 
-	std::unique_lock<std::mutex> wsOpenLock(session.wsOpenMutex);
-	if (!session.wsOpen)
 	{
-		session.wsOpenCV.wait(wsOpenLock);
+		std::unique_lock<std::mutex> wsOpenLock(session.wsOpenMutex);
+		session.wsOpenCV.wait(wsOpenLock, [&session]() { return session.wsOpen || session.wsOpenFailed || session.shutdownRequested; });
+	}
+
+	if (session.shutdownRequested)
+	{
+		return MIXER_ERROR_CANCELLED;
 	}
 
 	if (!session.wsOpen)
 	{
 		return MIXER_ERROR_WS_CONNECT_FAILED;
 	}
+	timing->socketOpenMs = elapsed_ms(phaseStart);
 
 	// Create thread to send messages over the open websocket.
 	session.outgoingThread = std::thread(std::bind(&interactive_session_internal::run_outgoing_thread, &session));
 
+	// Http requests get their own thread so they never queue behind, or hold up, websocket sends.
+	session.httpThread = std::thread(std::bind(&interactive_session_internal::run_http_thread, &session));
+
 	// Get the server time offset.
 	err = update_server_time_offset(session);
 	if (err)
@@ -542,14 +613,49 @@ int do_connect(interactive_session_internal& session, bool isReady)
 		DEBUG_WARNING("Failed to update server time offset: " + std::to_string(err));
 	}
 
+	if (session.shutdownRequested)
+	{
+		return MIXER_ERROR_CANCELLED;
+	}
+
 	// Cache scene and group data.
 	RETURN_IF_FAILED(cache_scenes(session));
 	DEBUG_TRACE("Cached scene data: " + jsonStringify(session.scenesRoot));
 	RETURN_IF_FAILED(cache_groups(session));
+	timing->handshakeMs = elapsed_ms(phaseStart);
 
 	return MIXER_OK;
 }
 
+// Stands in for the websocket of a loopback session. It never connects and discards whatever it is asked to send.
+class loopback_websocket : public websocket
+{
+public:
+	int add_header(const std::string& key, const std::string& value)
+	{
+		return MIXER_OK;
+	}
+
+	int open(const std::string& uri, const on_ws_connect onConnect, const on_ws_message onMessage, const on_ws_error onError, const on_ws_close onClose)
+	{
+		return MIXER_ERROR_WS_CONNECT_FAILED;
+	}
+
+	int send(const std::string& message)
+	{
+		return MIXER_OK;
+	}
+
+	int read(std::string& message)
+	{
+		return MIXER_ERROR_WS_READ_FAILED;
+	}
+
+	void close()
+	{
+	}
+};
+
 }
 
 using namespace mixer_internal;
@@ -587,6 +693,118 @@ int interactive_open_session(const char* auth, const char* versionId, const char
 	return MIXER_OK;
 }
 
+int interactive_open_session_async(const char* auth, const char* versionId, const char* shareCode, bool setReady, const char* const* hosts, size_t hostCount, const char* hostsUri, on_session_opened onOpened, void* context, interactive_session* sessionPtr)
+{
+	if (nullptr == auth || nullptr == versionId || nullptr == sessionPtr || (nullptr == hosts && 0 != hostCount))
+	{
+		return MIXER_ERROR_INVALID_POINTER;
+	}
+
+	if (nullptr == onOpened)
+	{
+		return MIXER_ERROR_INVALID_CALLBACK;
+	}
+
+	// Validate parameters
+	if (0 == strlen(auth) || 0 == strlen(versionId))
+	{
+		return MIXER_ERROR_INVALID_VERSION_ID;
+	}
+
+	std::auto_ptr<interactive_session_internal> session(new interactive_session_internal());
+	session->authorization = auth;
+	session->versionId = versionId;
+	if (nullptr != shareCode)
+	{
+		session->shareCode = shareCode;
+	}
+
+	for (size_t i = 0; i < hostCount; ++i)
+	{
+		if (nullptr != hosts[i])
+		{
+			session->hosts.push_back(hosts[i]);
+		}
+	}
+
+	if (nullptr != hostsUri)
+	{
+		session->hostsUri = hostsUri;
+	}
+
+	// Register method handlers
+	register_method_handlers(*session);
+
+	// Initialize Http and Websocket clients
+	session->http = http_factory::make_http_client();
+	session->ws = websocket_factory::make_websocket();
+
+	interactive_session_internal* sessionInternal = session.release();
+	sessionInternal->connectThread = std::thread([sessionInternal, setReady, onOpened, context]()
+	{
+		interactive_open_timing timing = { 0, 0, 0 };
+		int err = do_connect(*sessionInternal, setReady, &timing);
+		if (MIXER_OK == err && sessionInternal->shutdownRequested)
+		{
+			err = MIXER_ERROR_CANCELLED;
+		}
+
+		onOpened(context, sessionInternal, err, &timing);
+	});
+
+	*sessionPtr = sessionInternal;
+	return MIXER_OK;
+}
+
+int interactive_open_loopback_session(const char* scenesResult, size_t scenesResultLength, interactive_session* sessionPtr)
+{
+	if (nullptr == scenesResult || nullptr == sessionPtr)
+	{
+		return MIXER_ERROR_INVALID_POINTER;
+	}
+
+	rapidjson::Document result;
+	if (result.Parse(scenesResult, scenesResultLength).HasParseError())
+	{
+		return MIXER_ERROR_JSON_PARSE;
+	}
+	if (!result.IsObject() || !result.HasMember(RPC_PARAM_SCENES) || !result[RPC_PARAM_SCENES].IsArray())
+	{
+		return MIXER_ERROR_UNRECOGNIZED_DATA_FORMAT;
+	}
+
+	std::auto_ptr<interactive_session_internal> session(new interactive_session_internal());
+	session->isLoopback = true;
+	session->wsOpen = true;
+	register_method_handlers(*session);
+	session->http = http_factory::make_http_client();
+	session->ws.reset(new loopback_websocket());
+	RETURN_IF_FAILED(store_scenes(*session, result));
+
+	// Sends are drained as usual, so a session that sends a lot doesn't fill its queue and stall the caller.
+	session->outgoingThread = std::thread(std::bind(&interactive_session_internal::run_outgoing_thread, session.get()));
+
+	*sessionPtr = session.release();
+	return MIXER_OK;
+}
+
+int interactive_loopback_receive(interactive_session session, const char* frame, size_t frameLength)
+{
+	if (nullptr == session || nullptr == frame)
+	{
+		return MIXER_ERROR_INVALID_POINTER;
+	}
+
+	interactive_session_internal* sessionInternal = reinterpret_cast<interactive_session_internal*>(session);
+	if (!sessionInternal->isLoopback)
+	{
+		return MIXER_ERROR_INVALID_OPERATION;
+	}
+
+	sessionInternal->handle_ws_message(*sessionInternal->ws, std::string(frame, frameLength));
+	return MIXER_OK;
+}
+
 int interactive_set_session_context(interactive_session session, void* context)
 {
 	if (nullptr == session)
@@ -600,6 +818,25 @@ int interactive_set_session_context(interactive_session session, void* context)
 	return MIXER_OK;
 }
 
+int interactive_set_session_authorization(interactive_session session, const char* auth)
+{
+	if (nullptr == session || nullptr == auth)
+	{
+		return MIXER_ERROR_INVALID_POINTER;
+	}
+
+	if (0 == strlen(auth))
+	{
+		return MIXER_ERROR_INVALID_VERSION_ID;
+	}
+
+	interactive_session_internal* sessionInternal = reinterpret_cast<interactive_session_internal*>(session);
+	std::lock_guard<std::mutex> authorizationLock(sessionInternal->authorizationMutex);
+	sessionInternal->authorization = auth;
+
+	return MIXER_OK;
+}
+
 int interactive_get_session_context(interactive_session session, void** context)
 {
 	if (nullptr == session || nullptr == context)
@@ -677,22 +914,12 @@ int interactive_run(interactive_session session, unsigned int maxEventsToProcess
 	// Check for any errors first.
 	if (!sessionInternal->errors.empty() && processed < maxEventsToProcess)
 	{
-		std::queue<protocol_error> errors;
+		protocol_error error;
+		while (processed < maxEventsToProcess && sessionInternal->errors.try_pop(error))
 		{
-			std::lock_guard<std::mutex> l(sessionInternal->errorsMutex);
-			while (!sessionInternal->errors.empty() && processed++ < maxEventsToProcess)
+			++processed;
+			if (sessionInternal->onError)
 			{
-				errors.emplace(sessionInternal->errors.front());
-				sessionInternal->errors.pop();
-			}
-		}
-
-		if (sessionInternal->onError)
-		{
-			while (!errors.empty())
-			{
-				protocol_error error = errors.front();
-				errors.pop();
 				sessionInternal->onError(sessionInternal->callerContext, &sessionInternal, error.first, error.second.c_str(), error.second.length());
 
 				if (sessionInternal->shutdownRequested)
@@ -704,23 +931,57 @@ int interactive_run(interactive_session session, unsigned int maxEventsToProcess
 	}
 
 	// Process any websocket replies.
-	if (!sessionInternal->replies.empty() && processed < maxEventsToProcess)
+	if ((!sessionInternal->replies.empty() || !sessionInternal->replyHandlersById.empty()) && processed < maxEventsToProcess)
 	{
-		std::unique_lock<std::mutex> repliesLock(sessionInternal->repliesMutex);
-
-		for (auto replyByIdItr = sessionInternal->replies.begin(); replyByIdItr != sessionInternal->replies.end() && processed++ < maxEventsToProcess; /* No increment */)
+		// Handlers run outside the lock, since they may queue further methods
+		std::vector<std::pair<method_handler, std::shared_ptr<rapidjson::Document>>> claimedReplies;
 		{
-			auto replyHandlerItr = sessionInternal->replyHandlersById.find(replyByIdItr->first);
-			if (replyHandlerItr != sessionInternal->replyHandlersById.end())
+			std::unique_lock<std::mutex> repliesLock(sessionInternal->repliesMutex);
+			const auto expiredBefore = std::chrono::steady_clock::now() - std::chrono::milliseconds(REPLY_EXPIRY_MS);
+
+			for (auto replyByIdItr = sessionInternal->replies.begin(); replyByIdItr != sessionInternal->replies.end() && processed < maxEventsToProcess; /* No increment */)
 			{
-				// Call the registered handler for this reply
-				std::shared_ptr<rapidjson::Document> replyDoc = replyByIdItr->second;
-				replyHandlerItr->second(*sessionInternal, *replyDoc);
+				auto replyHandlerItr = sessionInternal->replyHandlersById.find(replyByIdItr->first);
+				if (replyHandlerItr == sessionInternal->replyHandlersById.end())
+				{
+					// Nobody registered for this reply, so a blocking call on another thread may be waiting on it in receive_reply.
+					// Once that has had every chance to collect it, nothing else will.
+					if (replyByIdItr->second.receivedAt < expiredBefore)
+					{
+						DEBUG_WARNING("Dropping unclaimed reply to message " + std::to_string(replyByIdItr->first));
+						sessionInternal->replies.erase(replyByIdItr++);
+					}
+					else
+					{
+						++replyByIdItr;
+					}
+					continue;
+				}
+
+				++processed;
+				claimedReplies.emplace_back(std::move(replyHandlerItr->second.handler), replyByIdItr->second.doc);
+				sessionInternal->replyHandlersById.erase(replyHandlerItr);
+				sessionInternal->replies.erase(replyByIdItr++);
 			}
 
-			// This reply was processed, clear it.
-			sessionInternal->replies.erase(replyByIdItr++);
+			// The service never answered these, and their callers have given up on them
+			for (auto handlerItr = sessionInternal->replyHandlersById.begin(); handlerItr != sessionInternal->replyHandlersById.end(); /* No increment */)
+			{
+				if (handlerItr->second.queuedAt < expiredBefore)
+				{
+					DEBUG_WARNING("No reply to message " + std::to_string(handlerItr->first) + " within " + std::to_string(REPLY_EXPIRY_MS) + "ms.");
+					sessionInternal->replyHandlersById.erase(handlerItr++);
+				}
+				else
+				{
+					++handlerItr;
+				}
+			}
+		}
 
+		for (auto& claimedReply : claimedReplies)
+		{
+			claimedReply.first(*sessionInternal, *claimedReply.second);
 			if (sessionInternal->shutdownRequested)
 			{
 				break;
@@ -758,21 +1019,12 @@ int interactive_run(interactive_session session, unsigned int maxEventsToProcess
 	// Process any incoming methods last.
 	if (processed < maxEventsToProcess)
 	{
-		std::queue<std::shared_ptr<rapidjson::Document>> methods;
+		std::shared_ptr<rapidjson::Document> method;
+		while (processed < maxEventsToProcess && sessionInternal->incomingMethods.try_pop(method))
 		{
-			std::lock_guard<std::mutex> l(sessionInternal->methodsMutex);
-			while (!sessionInternal->incomingMethods.empty() && processed++ < maxEventsToProcess)
-			{
-				methods.emplace(sessionInternal->incomingMethods.front());
-				sessionInternal->incomingMethods.pop();
-			}
-		}
-
-		while (!methods.empty())
-		{
-			std::shared_ptr<rapidjson::Document> method = methods.front();
-			methods.pop();
-
+			// Cheap unless the receive thread is waiting for room
+			sessionInternal->incomingSpace.notify_all();
+			++processed;
 			if (method->HasMember(RPC_SEQUENCE))
 			{
 				sessionInternal->sequenceId = (*method)[RPC_SEQUENCE].GetInt();
@@ -789,6 +1041,22 @@ int interactive_run(interactive_session session, unsigned int maxEventsToProcess
 	return MIXER_OK;
 }
 
+int interactive_get_pending_event_count(interactive_session session, unsigned int* count)
+{
+	if (nullptr == session || nullptr == count)
+	{
+		return MIXER_ERROR_INVALID_POINTER;
+	}
+
+	interactive_session_internal* sessionInternal = reinterpret_cast<interactive_session_internal*>(session);
+
+	// Replies are not counted since some of them belong to blocking calls rather than to interactive_run.
+	size_t pending = sessionInternal->errors.size() + sessionInternal->incomingMethods.size();
+
+	*count = static_cast<unsigned int>(pending);
+	return MIXER_OK;
+}
+
 int interactive_get_state(interactive_session session, interactive_state* state)
 {
 	if (nullptr == session || nullptr == state)
@@ -876,6 +1144,94 @@ int interactive_send_method(interactive_session session, const char* method, con
 	return MIXER_OK;
 }
 
+int interactive_send_method_raw(interactive_session session, const char* method, const char* paramsJson, size_t paramsJsonLength, bool discardReply, unsigned int* id)
+{
+	if (nullptr == session || nullptr == method || nullptr == paramsJson)
+	{
+		return MIXER_ERROR_INVALID_POINTER;
+	}
+
+	interactive_session_internal* sessionInternal = reinterpret_cast<interactive_session_internal*>(session);
+
+	// Build the envelope with empty params, which are always the last member, then swap the caller's text in for them.
+	std::shared_ptr<rapidjson::Document> methodDoc;
+	RETURN_IF_FAILED(create_method_json(*sessionInternal, method, nullptr, discardReply, id, methodDoc));
+	std::string methodJson = jsonStringify(*methodDoc);
+	methodDoc.reset();
+
+	static const char emptyParamsTail[] = "{}}";
+	const size_t emptyParamsTailLength = sizeof(emptyParamsTail) - 1;
+	if (methodJson.length() < emptyParamsTailLength || 0 != methodJson.compare(methodJson.length() - emptyParamsTailLength, emptyParamsTailLength, emptyParamsTail))
+	{
+		return MIXER_ERROR_JSON_PARSE;
+	}
+
+	methodJson.resize(methodJson.length() - emptyParamsTailLength);
+	methodJson.append(paramsJson, paramsJsonLength);
+	methodJson.push_back('}');
+
+	// Synchronize access to the websocket.
+	std::lock_guard<std::mutex> sendLock(sessionInternal->sendMutex);
+	DEBUG_TRACE("Sending websocket message: " + methodJson);
+	return sessionInternal->ws->send(methodJson);
+}
+
+int interactive_queue_method(interactive_session session, const char* method, const char* paramsJson, size_t paramsJsonLength, unsigned int requestId, on_method_reply onReply)
+{
+	if (nullptr == session || nullptr == method || nullptr == paramsJson)
+	{
+		return MIXER_ERROR_INVALID_POINTER;
+	}
+
+	interactive_session_internal* sessionInternal = reinterpret_cast<interactive_session_internal*>(session);
+
+	rapidjson::Document paramsDoc;
+	if (paramsDoc.Parse(paramsJson, paramsJsonLength).HasParseError())
+	{
+		return MIXER_ERROR_JSON_PARSE;
+	}
+
+	method_handler onMethodReply = nullptr;
+	if (nullptr != onReply)
+	{
+		onMethodReply = [requestId, onReply](interactive_session_internal& replySession, rapidjson::Document& replyDoc)
+		{
+			unsigned int err = 0;
+			std::string errMessage;
+			if (replyDoc.HasMember(RPC_ERROR) && replyDoc[RPC_ERROR].IsObject())
+			{
+				err = MIXER_ERROR;
+				if (replyDoc[RPC_ERROR].HasMember(RPC_ERROR_CODE) && replyDoc[RPC_ERROR][RPC_ERROR_CODE].IsUint() && 0 != replyDoc[RPC_ERROR][RPC_ERROR_CODE].GetUint())
+				{
+					err = replyDoc[RPC_ERROR][RPC_ERROR_CODE].GetUint();
+				}
+				if (replyDoc[RPC_ERROR].HasMember(RPC_ERROR_MESSAGE))
+				{
+					errMessage = replyDoc[RPC_ERROR][RPC_ERROR_MESSAGE].GetString();
+				}
+			}
+
+			// An explicit null result is passed through as "null"; a reply without one gets nullptr.
+			const bool hasResult = replyDoc.HasMember(RPC_RESULT);
+			std::string resultJson;
+			if (hasResult)
+			{
+				resultJson = jsonStringify(replyDoc[RPC_RESULT]);
+			}
+
+			onReply(replySession.callerContext, &replySession, requestId, err, errMessage.c_str(), errMessage.length(), hasResult ? resultJson.c_str() : nullptr, resultJson.length());
+			return MIXER_OK;
+		};
+	}
+
+	RETURN_IF_FAILED(queue_method(*sessionInternal, method, [&](rapidjson::Document::AllocatorType& allocator, rapidjson::Value& params)
+	{
+		params.CopyFrom(paramsDoc, allocator);
+	}, onMethodReply));
+
+	return MIXER_OK;
+}
+
 int interactive_receive_reply(interactive_session session, unsigned int id, unsigned int timeoutMs, char* replyJson, size_t* replyJsonLength)
 {
 	if (nullptr == session || nullptr == replyJsonLength)
@@ -894,7 +1250,7 @@ int interactive_receive_reply(interactive_session session, unsigned int id, unsi
 		*replyJsonLength = replyJsonStr.length() + 1;
 		// Put the reply back
 		std::lock_guard<std::mutex> l(sessionInternal->repliesMutex);
-		sessionInternal->replies[id] = replyDoc;
+		sessionInternal->replies[id] = pending_reply{ replyDoc, std::chrono::steady_clock::now() };
 		return MIXER_ERROR_BUFFER_SIZE;
 	}
 
@@ -912,20 +1268,45 @@ void interactive_close_session(interactive_session session)
 
 		// Mark the session as inactive and close the websocket. This will notify any functions in flight to exit at their earliest convenience.
 		sessionInternal->shutdownRequested = true;
+		sessionInternal->incomingSpace.notify_all();
 		if (nullptr != sessionInternal->ws.get())
 		{
 			sessionInternal->ws->close();
 		}
 
-		// Notify the outgoing websocket thread to shutdown.
+		// Wake an asynchronous open that is waiting on the websocket or a handshake reply.
+		{
+			std::unique_lock<std::mutex> wsOpenLock(sessionInternal->wsOpenMutex);
+			sessionInternal->wsOpenCV.notify_all();
+		}
+		{
+			std::unique_lock<std::mutex> repliesLock(sessionInternal->repliesMutex);
+			sessionInternal->repliesCV.notify_all();
+		}
+
+		// The connect thread may still be starting the others, so it goes first.
+		if (sessionInternal->connectThread.joinable())
 		{
-			std::unique_lock<std::mutex> outgoingLock(sessionInternal->outgoingMutex);
-			sessionInternal->outgoingCV.notify_all();
+			sessionInternal->connectThread.join();
 		}
 
-		// Wait for both threads to terminate.
-		sessionInternal->incomingThread.join();
-		sessionInternal->outgoingThread.join();
+		// Notify the outgoing websocket and http threads to shutdown.
+		sessionInternal->outgoingEvents.notify_all();
+		sessionInternal->httpEvents.notify_all();
+
+		// Wait for the worker threads to terminate. Any may never have been started if connecting failed.
+		if (sessionInternal->incomingThread.joinable())
+		{
+			sessionInternal->incomingThread.join();
+		}
+		if (sessionInternal->outgoingThread.joinable())
+		{
+			sessionInternal->outgoingThread.join();
+		}
+		if (sessionInternal->httpThread.joinable())
+		{
+			sessionInternal->httpThread.join();
+		}
 
 		// Clean up the session memory.
 		delete sessionInternal;
@@ -1011,6 +1392,19 @@ int interactive_register_unhandled_method_handler(interactive_session session, o
 	return MIXER_OK;
 }
 
+int interactive_register_groups_changed_handler(interactive_session session, on_groups_changed onGroupsChanged)
+{
+	if (nullptr == session)
+	{
+		return MIXER_ERROR_INVALID_POINTER;
+	}
+
+	interactive_session_internal* sessionInternal = reinterpret_cast<interactive_session_internal*>(session);
+	sessionInternal->onGroupsChanged = onGroupsChanged;
+
+	return MIXER_OK;
+}
+
 // Debugging
 
 void interactive_config_debug_level(const interactive_debug_level dbgLevel)
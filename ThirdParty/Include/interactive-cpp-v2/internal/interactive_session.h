@@ -2,31 +2,95 @@
 #include "interactivity.h"
 #include "http_client.h"
 #include "websocket.h"
+#include "lockfree_queue.h"
 #include "rapidjson\document.h"
 #include "rapidjson\pointer.h"
 
 #include <map>
+#include <unordered_map>
 #include <vector>
 #include <queue>
 #include <thread>
 #include <mutex>
 #include <shared_mutex>
 #include <atomic>
+#include <memory>
+#include <chrono>
+#include <condition_variable>
 
 namespace mixer_internal
 {
 
 struct interactive_session_internal;
 
+// How long a reply may wait for its handler or a receive_reply, and a handler for its reply, before being dropped.
+#define REPLY_EXPIRY_MS 30000
+
+struct pending_reply
+{
+	std::shared_ptr<rapidjson::Document> doc;
+	std::chrono::steady_clock::time_point receivedAt;
+};
+
 typedef std::pair<unsigned int, std::string> protocol_error;
 typedef std::map<std::string, std::string> scenes_by_id;
 typedef std::map<std::string, std::string> scenes_by_group;
 typedef std::map<std::string, std::string> controls_by_id;
-typedef std::map<std::string, std::shared_ptr<rapidjson::Document>> participants_by_id;
+
+// Roster entry for one participant, keyed by session id in participants_by_id.  Only the fields
+// interactive_participant exposes are kept, rather than a copy of the whole participant document.
+struct participant_record
+{
+	unsigned int userId;
+	unsigned int level;
+	unsigned long long lastInputAtMs;
+	unsigned long long connectedAtMs;
+	bool disabled;
+	std::string userName;
+	std::string groupId;
+
+	participant_record() : userId(0), level(0), lastInputAtMs(0), connectedAtMs(0), disabled(false) {}
+};
+
+typedef std::unordered_map<std::string, participant_record> participants_by_id;
 typedef std::function<int(interactive_session_internal&, rapidjson::Document&)> method_handler;
 typedef std::map<std::string, method_handler> method_handlers_by_method;
+
+struct pending_reply_handler
+{
+	method_handler handler;
+	std::chrono::steady_clock::time_point queuedAt;
+};
 typedef std::function<int(unsigned int statusCode, const std::string& body)> http_response_handler;
 
+// Recycles documents, and the arena each one parses into, across messages on a session.
+// Documents are handed out as shared_ptrs that return to the free list when the last reference goes.
+// As with any MemoryPoolAllocator document, values must be copied rather than moved into longer-lived documents.
+class document_pool : public std::enable_shared_from_this<document_pool>
+{
+public:
+	std::shared_ptr<rapidjson::Document> acquire();
+
+private:
+	// Most protocol messages fit in the inline arena, so parsing them never reaches the heap.
+	static const size_t arenaSize = 4096;
+	static const size_t maxFreeDocuments = 64;
+
+	struct pooled_document
+	{
+		uint64_t arena[arenaSize / sizeof(uint64_t)];
+		rapidjson::MemoryPoolAllocator<> allocator;
+		rapidjson::Document document;
+
+		pooled_document() : allocator(arena, sizeof(arena)), document(&allocator) {}
+	};
+
+	void release(pooled_document* entry);
+
+	std::mutex freeMutex;
+	std::vector<std::unique_ptr<pooled_document>> freeDocuments;
+};
+
 struct http_request_data
 {
 	uint32_t packetId;
@@ -43,7 +107,11 @@ struct interactive_session_internal
 	// Configuration
 	bool isReady;
 
+	// Opened by interactive_open_loopback_session, so fed by interactive_loopback_receive rather than a websocket
+	bool isLoopback;
+
 	// State
+	std::mutex authorizationMutex;
 	std::string authorization;
 	std::string versionId;
 	std::string shareCode;
@@ -64,6 +132,8 @@ struct interactive_session_internal
 
 	// Interactive hosts in retry order.
 	std::vector<std::string> hosts;
+	// Where to look the hosts up if none were supplied.  Empty for the default.
+	std::string hostsUri;
 
 	// Event handlers
 	on_input onInput;
@@ -72,6 +142,7 @@ struct interactive_session_internal
 	on_participants_changed onParticipantsChanged;
 	on_transaction_complete onTransactionComplete;
 	on_unhandled_method onUnhandledMethod;
+	on_groups_changed onGroupsChanged;
 
 	// Transactions that have been completed.
 	std::map<std::string, protocol_error> completedTransactions;
@@ -83,39 +154,54 @@ struct interactive_session_internal
 	std::unique_ptr<websocket> ws;
 	std::mutex sendMutex;
 
-	// Outgoing data
+	// Pooled documents for incoming and outgoing messages
+	std::shared_ptr<document_pool> documentPool;
+
+	// Outgoing websocket methods, produced by any thread and drained by the outgoing thread
 	std::thread outgoingThread;
-	std::mutex outgoingMutex;
-	std::condition_variable outgoingCV;
-	std::queue<std::shared_ptr<rapidjson::Document>> outgoingMethods;
-	std::queue<http_request_data> outgoingRequests;
+	event_count outgoingEvents;
+	mpsc_ring<std::shared_ptr<rapidjson::Document>> outgoingMethods;
+
+	// Outgoing http requests, produced by any thread and drained by the http thread so a slow request never delays websocket sends
+	std::thread httpThread;
+	event_count httpEvents;
+	mpsc_ring<http_request_data> outgoingRequests;
 	std::mutex httpResponsesMutex;
 	std::map<unsigned int, http_response_handler> httpResponseHandlers;
 	std::map<unsigned int, http_response> httpResponsesById;
 
 	// Incoming data
+	// Methods are produced by the websocket receive thread and drained by interactive_run.
 	std::thread incomingThread;
-	std::mutex methodsMutex;
-	std::queue<std::shared_ptr<rapidjson::Document>> incomingMethods;
+	spsc_ring<std::shared_ptr<rapidjson::Document>> incomingMethods;
+	// Signalled by interactive_run as it frees space in incomingMethods, for the receive thread to wait on when it's full
+	event_count incomingSpace;
+	// Replies and their handlers stay behind a lock since they are looked up by id, registered by any
+	// thread queueing a method, and waited on by receive_reply.  Entries nobody claims within
+	// REPLY_EXPIRY_MS are dropped by interactive_run.
 	std::mutex repliesMutex;
 	std::condition_variable repliesCV;
-	std::map<unsigned int, std::shared_ptr<rapidjson::Document>> replies;
-	std::map<unsigned int, method_handler> replyHandlersById;
+	std::map<unsigned int, pending_reply> replies;
+	std::map<unsigned int, pending_reply_handler> replyHandlersById;
 
-	// Network errors
-	std::mutex errorsMutex;
-	std::queue<protocol_error> errors;
+	// Network errors, produced by the incoming, outgoing and http threads
+	mpsc_ring<protocol_error> errors;
 
 	// Websocket handlers
 	std::mutex wsOpenMutex;
 	std::condition_variable wsOpenCV;
 	bool wsOpen;
+	bool wsOpenFailed;
+
+	// Connect thread for interactive_open_session_async
+	std::thread connectThread;
 	void handle_ws_open(const websocket& socket, const std::string& message);
 	void handle_ws_message(const websocket& socket, const std::string& message);
 	void handle_ws_error(const websocket& socket, unsigned short code, const std::string& message);
 	void handle_ws_close(const websocket& socket, unsigned short code, const std::string& message);
 	void run_incoming_thread();
 	void run_outgoing_thread();
+	void run_http_thread();
 
 	// Method handlers
 	method_handlers_by_method methodHandlers;
@@ -130,7 +216,10 @@ int receive_reply(interactive_session_internal& session, unsigned int id, std::s
 
 int cache_groups(interactive_session_internal& session);
 int cache_scenes(interactive_session_internal& session);
+int store_scenes(interactive_session_internal& session, rapidjson::Value& result);
 void parse_participant(rapidjson::Value& participantJson, interactive_participant& participant);
+void store_participant(const interactive_participant& participant, participant_record& record);
+void read_participant(const std::string& participantId, const participant_record& record, interactive_participant& participant);
 
 // Common reply handler that checks a reply for errors and calls the session's error handler if it exists.
 int check_reply_errors(interactive_session_internal& session, rapidjson::Document& reply);
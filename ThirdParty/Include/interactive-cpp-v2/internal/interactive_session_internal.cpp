@@ -5,12 +5,54 @@ namespace mixer_internal
 {
 
 interactive_session_internal::interactive_session_internal()
-	: callerContext(nullptr), isReady(false), state(interactive_state::disconnected), shutdownRequested(false), packetId(0), sequenceId(0), wsOpen(false),
-	onInput(nullptr), onError(nullptr), onStateChanged(nullptr), onParticipantsChanged(nullptr), onUnhandledMethod(nullptr)
+	: callerContext(nullptr), isReady(false), isLoopback(false), state(interactive_state::disconnected), shutdownRequested(false), packetId(0), sequenceId(0), wsOpen(false), wsOpenFailed(false),
+	onInput(nullptr), onError(nullptr), onStateChanged(nullptr), onParticipantsChanged(nullptr), onUnhandledMethod(nullptr), onGroupsChanged(nullptr),
+	documentPool(std::make_shared<document_pool>()), outgoingMethods(1024), outgoingRequests(64), incomingMethods(4096), errors(256)
 {
 	scenesRoot.SetObject();
 }
 
+std::shared_ptr<rapidjson::Document> document_pool::acquire()
+{
+	std::unique_ptr<pooled_document> entry;
+	{
+		std::lock_guard<std::mutex> l(this->freeMutex);
+		if (!this->freeDocuments.empty())
+		{
+			entry = std::move(this->freeDocuments.back());
+			this->freeDocuments.pop_back();
+		}
+	}
+
+	if (!entry)
+	{
+		entry.reset(new pooled_document());
+	}
+
+	// The deleter keeps the pool alive for documents that outlast their session.
+	pooled_document* rawEntry = entry.release();
+	std::shared_ptr<document_pool> self = shared_from_this();
+	return std::shared_ptr<rapidjson::Document>(&rawEntry->document, [self, rawEntry](rapidjson::Document*)
+	{
+		self->release(rawEntry);
+	});
+}
+
+void document_pool::release(pooled_document* entry)
+{
+	std::unique_ptr<pooled_document> owned(entry);
+
+	// Drop the contents and any overflow chunks; the inline arena is kept for the next message.
+	owned->document.SetNull();
+	owned->allocator.Clear();
+
+	std::lock_guard<std::mutex> l(this->freeMutex);
+	if (this->freeDocuments.size() < maxFreeDocuments)
+	{
+		this->freeDocuments.push_back(std::move(owned));
+	}
+}
+
 void interactive_session_internal::handle_ws_open(const websocket& socket, const std::string& message)
 {
 	(socket);
@@ -34,7 +76,7 @@ void interactive_session_internal::handle_ws_message(const websocket& socket, co
 	}
 
 	// Parse the message to determine packet type.
-	std::shared_ptr<rapidjson::Document> doc = std::make_shared<rapidjson::Document>();
+	std::shared_ptr<rapidjson::Document> doc = this->documentPool->acquire();
 	if (!doc->Parse(message.c_str(), message.length()).HasParseError())
 	{
 		if (!doc->HasMember(RPC_TYPE))
@@ -47,14 +89,31 @@ void interactive_session_internal::handle_ws_message(const websocket& socket, co
 		std::string type = (*doc)[RPC_TYPE].GetString();
 		if (0 == type.compare(RPC_METHOD))
 		{
-			std::lock_guard<std::mutex> l(this->methodsMutex);
-			this->incomingMethods.emplace(doc);
+			// Apply backpressure to the socket rather than dropping methods when interactive_run falls behind.
+			// The receive thread sleeps until interactive_run makes room, or the session closes.
+			while (!this->incomingMethods.try_push(std::move(doc)))
+			{
+				const unsigned int key = this->incomingSpace.prepare_wait();
+				if (this->incomingMethods.try_push(std::move(doc)))
+				{
+					this->incomingSpace.cancel_wait();
+					break;
+				}
+				if (this->shutdownRequested)
+				{
+					this->incomingSpace.cancel_wait();
+					return;
+				}
+
+				DEBUG_WARNING("Incoming method queue is full, waiting for interactive_run.");
+				this->incomingSpace.wait(key);
+			}
 		}
 		else if (0 == type.compare(RPC_REPLY))
 		{
 			unsigned int id = (*doc)[RPC_ID].GetUint();
 			std::lock_guard<std::mutex> l(this->repliesMutex);
-			this->replies.emplace(id, doc);
+			this->replies.emplace(id, pending_reply{ doc, std::chrono::steady_clock::now() });
 			this->repliesCV.notify_all();
 		}
 	}
@@ -78,8 +137,10 @@ void interactive_session_internal::handle_ws_error(const websocket& socket, cons
 		this->onError(this->callerContext, this, code, message.c_str(), message.length());
 	}
 
-	std::lock_guard<std::mutex> l(this->errorsMutex);
-	this->errors.emplace(std::pair<unsigned short, std::string>(code, message));
+	if (!this->errors.try_push(protocol_error(code, message)))
+	{
+		DEBUG_WARNING("Error queue full, dropping error: " + message);
+	}
 }
 
 void interactive_session_internal::handle_ws_close(const websocket& socket, const unsigned short code, const std::string& message)
@@ -91,8 +152,10 @@ void interactive_session_internal::handle_ws_close(const websocket& socket, cons
 		return;
 	}
 
-	std::lock_guard<std::mutex> l(this->errorsMutex);
-	this->errors.emplace(std::pair<unsigned short, std::string>(code, message));
+	if (!this->errors.try_push(protocol_error(code, message)))
+	{
+		DEBUG_WARNING("Error queue full, dropping error: " + message);
+	}
 }
 
 void interactive_session_internal::run_incoming_thread()
@@ -128,43 +191,66 @@ void interactive_session_internal::run_incoming_thread()
 	if (!this->wsOpen)
 	{
 		// No connections were made, unblock the connect thread.
+		std::lock_guard<std::mutex> l(this->wsOpenMutex);
+		this->wsOpenFailed = true;
 		this->wsOpenCV.notify_one();
 	}
 }
 
 void interactive_session_internal::run_outgoing_thread()
 {
-	std::queue<std::shared_ptr<rapidjson::Document>> methodsToProcess;
-	std::queue<http_request_data> requestsToProcess;
 	while (!shutdownRequested)
-	{	
+	{
+		// Sleep until something is queued. The key is taken before checking so a push in between is not missed.
+		unsigned int key = outgoingEvents.prepare_wait();
+		if (outgoingMethods.empty() && !shutdownRequested)
 		{
-			// Critical section: Check if there are any queued methods that need to be sent.
-			std::unique_lock<std::mutex> lock(outgoingMutex);
-			if (outgoingMethods.empty())
-			{
-				outgoingCV.wait(lock);
-			}
+			outgoingEvents.wait(key);
+		}
+		else
+		{
+			outgoingEvents.cancel_wait();
+		}
 
-			if (shutdownRequested)
-			{
-				break;
-			}
-			
-			if (!outgoingRequests.empty())
-			{
-				requestsToProcess.swap(outgoingRequests);
-			}
-			if (!outgoingMethods.empty())
-			{
-				methodsToProcess.swap(outgoingMethods);
-			}
+		if (shutdownRequested)
+		{
+			break;
+		}
+
+		std::shared_ptr<rapidjson::Document> method;
+		while (!shutdownRequested && outgoingMethods.try_pop(method))
+		{
+			std::string packet = jsonStringify(*method);
+			method.reset();
+			std::unique_lock<std::mutex> sendLock(sendMutex);
+			DEBUG_TRACE("Sending websocket message: " + packet);
+			ws->send(packet);
 		}
+	}
+}
 
-		while (!requestsToProcess.empty() && !shutdownRequested)
+void interactive_session_internal::run_http_thread()
+{
+	while (!shutdownRequested)
+	{
+		unsigned int key = httpEvents.prepare_wait();
+		if (outgoingRequests.empty() && !shutdownRequested)
+		{
+			httpEvents.wait(key);
+		}
+		else
+		{
+			httpEvents.cancel_wait();
+		}
+
+		if (shutdownRequested)
+		{
+			break;
+		}
+
+		http_request_data request;
+		while (!shutdownRequested && outgoingRequests.try_pop(request))
 		{
-			http_request_data request = requestsToProcess.front();
-			requestsToProcess.pop();
 			http_response response;
 			DEBUG_TRACE(request.verb + " to " + request.uri + ". Body: " + request.body);
 			int err = http->make_request(request.uri, request.verb, request.headers.empty() ? nullptr : &request.headers, request.body, response);
@@ -172,9 +258,10 @@ void interactive_session_internal::run_outgoing_thread()
 			{
 				std::string errorMessage = "Failed to '" + request.verb + "' to " + request.uri;
 				DEBUG_ERROR(errorMessage);
-				// Synchronize access to errors.
-				std::unique_lock<std::mutex> errorsLock(errorsMutex);
-				errors.emplace(err, errorMessage);
+				if (!errors.try_push(protocol_error(err, errorMessage)))
+				{
+					DEBUG_WARNING("Error queue full, dropping error: " + errorMessage);
+				}
 				continue;
 			}
 
@@ -185,17 +272,7 @@ void interactive_session_internal::run_outgoing_thread()
 				httpResponsesById[request.packetId] = response;
 			}
 		}
-
-		while (!methodsToProcess.empty() && !shutdownRequested)
-		{
-			std::shared_ptr<rapidjson::Document> method = methodsToProcess.front();
-			methodsToProcess.pop();
-			std::string packet = jsonStringify(*method);
-			std::unique_lock<std::mutex> sendLock(sendMutex);
-			DEBUG_TRACE("Sending websocket message: " + packet);
-			ws->send(packet);
-		}
 	}
 }
 
-}
\ No newline at end of file
+}
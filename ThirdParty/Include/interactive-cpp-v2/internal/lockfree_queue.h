@@ -0,0 +1,225 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+namespace mixer_internal
+{
+
+// Padding between the indices of the rings below, so the producer and consumer don't share a cache line.
+// Padded by hand rather than with alignas, which heap allocations before C++17 don't honor (C4316 on MSVC).
+#define MIXER_CACHE_LINE_SIZE 64
+
+inline size_t round_up_to_power_of_two(size_t value)
+{
+	size_t result = 1;
+	while (result < value)
+	{
+		result <<= 1;
+	}
+	return result;
+}
+
+// Bounded ring for exactly one producer thread and one consumer thread.
+template <typename T>
+class spsc_ring
+{
+public:
+	explicit spsc_ring(size_t capacity)
+		: capacity(round_up_to_power_of_two(capacity)), mask(this->capacity - 1), slots(new T[this->capacity]), head(0), tail(0)
+	{
+	}
+
+	// Producer only. The value is left untouched if the ring is full.
+	bool try_push(T&& value)
+	{
+		const size_t t = tail.load(std::memory_order_relaxed);
+		if (t - head.load(std::memory_order_acquire) == capacity)
+		{
+			return false;
+		}
+
+		slots[t & mask] = std::move(value);
+		tail.store(t + 1, std::memory_order_release);
+		return true;
+	}
+
+	// Consumer only.
+	bool try_pop(T& value)
+	{
+		const size_t h = head.load(std::memory_order_relaxed);
+		if (h == tail.load(std::memory_order_acquire))
+		{
+			return false;
+		}
+
+		value = std::move(slots[h & mask]);
+		head.store(h + 1, std::memory_order_release);
+		return true;
+	}
+
+	// Approximate when called from a thread other than the producer or consumer.
+	size_t size() const
+	{
+		const size_t h = head.load(std::memory_order_acquire);
+		return tail.load(std::memory_order_acquire) - h;
+	}
+
+	bool empty() const
+	{
+		return 0 == size();
+	}
+
+private:
+	const size_t capacity;
+	const size_t mask;
+	std::unique_ptr<T[]> slots;
+	char headPadding[MIXER_CACHE_LINE_SIZE];
+	std::atomic<size_t> head;
+	char tailPadding[MIXER_CACHE_LINE_SIZE - sizeof(std::atomic<size_t>)];
+	std::atomic<size_t> tail;
+	char endPadding[MIXER_CACHE_LINE_SIZE - sizeof(std::atomic<size_t>)];
+};
+
+// Bounded ring for any number of producer threads and one consumer thread.
+// Each cell carries a sequence number that tells producers and the consumer whose turn it is.
+template <typename T>
+class mpsc_ring
+{
+public:
+	explicit mpsc_ring(size_t capacity)
+		: capacity(round_up_to_power_of_two(capacity)), mask(this->capacity - 1), cells(new cell[this->capacity]), enqueuePos(0), dequeuePos(0)
+	{
+		for (size_t i = 0; i < this->capacity; ++i)
+		{
+			cells[i].sequence.store(i, std::memory_order_relaxed);
+		}
+	}
+
+	// Any thread. The value is left untouched if the ring is full.
+	bool try_push(T&& value)
+	{
+		size_t pos = enqueuePos.load(std::memory_order_relaxed);
+		for (;;)
+		{
+			cell& c = cells[pos & mask];
+			const size_t seq = c.sequence.load(std::memory_order_acquire);
+			const intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+			if (0 == diff)
+			{
+				if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+				{
+					c.value = std::move(value);
+					c.sequence.store(pos + 1, std::memory_order_release);
+					return true;
+				}
+			}
+			else if (diff < 0)
+			{
+				return false;
+			}
+			else
+			{
+				pos = enqueuePos.load(std::memory_order_relaxed);
+			}
+		}
+	}
+
+	// Consumer only.
+	bool try_pop(T& value)
+	{
+		const size_t pos = dequeuePos.load(std::memory_order_relaxed);
+		cell& c = cells[pos & mask];
+		const size_t seq = c.sequence.load(std::memory_order_acquire);
+		if (static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1) < 0)
+		{
+			return false;
+		}
+
+		value = std::move(c.value);
+		c.sequence.store(pos + capacity, std::memory_order_release);
+		dequeuePos.store(pos + 1, std::memory_order_relaxed);
+		return true;
+	}
+
+	// Approximate; includes pushes that have claimed a cell but not yet published it.
+	size_t size() const
+	{
+		const size_t d = dequeuePos.load(std::memory_order_acquire);
+		return enqueuePos.load(std::memory_order_acquire) - d;
+	}
+
+	bool empty() const
+	{
+		return 0 == size();
+	}
+
+private:
+	struct cell
+	{
+		std::atomic<size_t> sequence;
+		T value;
+	};
+
+	const size_t capacity;
+	const size_t mask;
+	std::unique_ptr<cell[]> cells;
+	char enqueuePadding[MIXER_CACHE_LINE_SIZE];
+	std::atomic<size_t> enqueuePos;
+	char dequeuePadding[MIXER_CACHE_LINE_SIZE - sizeof(std::atomic<size_t>)];
+	std::atomic<size_t> dequeuePos;
+	char endPadding[MIXER_CACHE_LINE_SIZE - sizeof(std::atomic<size_t>)];
+};
+
+// Lets one side of a ring sleep until the other signals, without the signaller taking a lock when nobody is asleep.
+// Usage: key = prepare_wait(); re-check the condition; then either cancel_wait() or wait(key).
+class event_count
+{
+public:
+	event_count() : epoch(0), waiters(0) {}
+
+	unsigned int prepare_wait()
+	{
+		waiters.fetch_add(1);
+		return epoch.load();
+	}
+
+	void cancel_wait()
+	{
+		waiters.fetch_sub(1);
+	}
+
+	void wait(unsigned int key)
+	{
+		{
+			std::unique_lock<std::mutex> l(mutex);
+			while (epoch.load() == key)
+			{
+				cv.wait(l);
+			}
+		}
+		waiters.fetch_sub(1);
+	}
+
+	void notify_all()
+	{
+		epoch.fetch_add(1);
+		if (0 != waiters.load())
+		{
+			std::lock_guard<std::mutex> l(mutex);
+			cv.notify_all();
+		}
+	}
+
+private:
+	std::atomic<unsigned int> epoch;
+	std::atomic<unsigned int> waiters;
+	std::mutex mutex;
+	std::condition_variable cv;
+};
+
+}